@@ -0,0 +1,194 @@
+#pragma once
+
+#include "../src/IRenderer.h"
+#include "../src/Tilemap.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Shared setup for the engine benchmarks. Nothing here creates a window or
+/// GL context: textures stay CPU-side and draws go to NullRenderer.
+namespace bench
+{
+/// First overworld tileset, relative to the directory holding assets/.
+inline const char *TILESET_PATH = "assets/overworld/cb5fa6a6-f88d-47ca-95d6-c73cc79f879d.png";
+
+/// NPC sprite used by the map loading benchmarks.
+inline const char *NPC_TYPE = "f8cb6fd1-b8a5-44df-b017-c6cc9834353f";
+
+/**
+ * Make the directory that holds assets/ current (the working directory or
+ * one of its parents), like the game does when run from build/.
+ * NPC sprites are loaded from paths relative to it.
+ */
+inline bool EnterAssetRoot()
+{
+    std::error_code ec;
+    std::filesystem::path dir = std::filesystem::current_path(ec);
+    for (int depth = 0; depth < 3 && !ec; ++depth)
+    {
+        if (std::filesystem::exists(dir / TILESET_PATH, ec))
+        {
+            std::filesystem::current_path(dir, ec);
+            return !ec;
+        }
+        if (!dir.has_parent_path() || dir.parent_path() == dir)
+            break;
+        dir = dir.parent_path();
+    }
+    return false;
+}
+
+/// Silences std::cout for its lifetime (map loading logs every call).
+class QuietStdout
+{
+public:
+    QuietStdout() : m_Saved(std::cout.rdbuf(nullptr)) {}
+    ~QuietStdout()
+    {
+        std::cout.rdbuf(m_Saved);
+        std::cout.clear();
+    }
+    QuietStdout(const QuietStdout &) = delete;
+    QuietStdout &operator=(const QuietStdout &) = delete;
+
+private:
+    std::streambuf *m_Saved;
+};
+
+/**
+ * IRenderer that only counts calls, so backend-independent submission code
+ * (tilemap loops, chunk culling) can be timed on its own.
+ *
+ * With static meshes enabled CreateStaticMesh() hands out handles, so the
+ * tilemap takes its cached chunk path; otherwise it falls back to
+ * per-tile draws like a backend without mesh support.
+ */
+class NullRenderer : public IRenderer
+{
+public:
+    explicit NullRenderer(bool staticMeshes = true) : m_StaticMeshes(staticMeshes) {}
+
+    void Init() override {}
+    void Shutdown() override {}
+    void BeginFrame() override { m_Draws = 0; }
+    void EndFrame() override {}
+
+    void DrawSprite(const Texture &, glm::vec2, glm::vec2, float, glm::vec3) override { ++m_Draws; }
+    void DrawSpriteAlpha(const Texture &, glm::vec2, glm::vec2, float, glm::vec4, bool) override { ++m_Draws; }
+    void DrawSpriteRegion(const Texture &, glm::vec2, glm::vec2, glm::vec2, glm::vec2, float, glm::vec3,
+                          bool) override
+    {
+        ++m_Draws;
+    }
+    void DrawSpriteAtlas(const Texture &, glm::vec2, glm::vec2, glm::vec2, glm::vec2, float, glm::vec4,
+                         bool) override
+    {
+        ++m_Draws;
+    }
+    void DrawColoredRect(glm::vec2, glm::vec2, glm::vec4, bool) override { ++m_Draws; }
+    void DrawWarpedQuad(const Texture &, const glm::vec2[4], glm::vec2, glm::vec2, glm::vec3, bool) override
+    {
+        ++m_Draws;
+    }
+
+    int CreateStaticMesh(const Texture &, const StaticQuad *, size_t count, bool) override
+    {
+        return (m_StaticMeshes && count > 0) ? m_NextMesh++ : INVALID_STATIC_MESH;
+    }
+    void DrawStaticMesh(int mesh, glm::vec2) override
+    {
+        if (mesh != INVALID_STATIC_MESH)
+            ++m_Draws;
+    }
+
+    void SetProjection(glm::mat4) override {}
+    void SetViewport(int, int, int, int) override {}
+    void Clear(float, float, float, float) override {}
+    void UploadTexture(const Texture &) override {}
+    void DrawText(std::string_view, glm::vec2, float, glm::vec3, float, float) override { ++m_Draws; }
+    float GetTextAscent(float scale) const override { return 12.0f * scale; }
+    float GetTextWidth(std::string_view text, float scale) const override
+    {
+        return static_cast<float>(text.size()) * 8.0f * scale;
+    }
+    bool RequiresYFlip() const override { return true; }
+    void SetAmbientColor(const glm::vec3 &) override {}
+    int GetDrawCallCount() const override { return m_Draws; }
+
+private:
+    bool m_StaticMeshes;
+    int m_NextMesh = 0;
+    int m_Draws = 0;
+};
+
+/**
+ * Fill @p tilemap with a deterministic size x size world: ground everywhere,
+ * details on a third of the cells, Y-sorted objects on @p ySortPercent of
+ * them, foreground on a tenth, collision on 20% and everything else
+ * walkable for patrol routes.
+ *
+ * @return false if the tileset is not found (see EnterAssetRoot()).
+ */
+inline bool BuildTilemap(Tilemap &tilemap, int size, int ySortPercent = 5)
+{
+    QuietStdout quiet;
+    if (!EnterAssetRoot() || !tilemap.LoadCombinedTilesets({TILESET_PATH}, 16, 16))
+        return false;
+    tilemap.SetTilemapSize(size, size, false);
+
+    // Tiles with visible pixels, so no draw is skipped as transparent
+    std::vector<int> tiles;
+    const int tileCount = (tilemap.GetTilesetDataWidth() / tilemap.GetTileWidth()) *
+                          (tilemap.GetTilesetDataHeight() / tilemap.GetTileHeight());
+    for (int id = 0; id < tileCount; ++id)
+    {
+        if (!tilemap.IsTileTransparent(id))
+            tiles.push_back(id);
+    }
+    if (tiles.empty())
+        return false;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, tiles.size() - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            tilemap.SetLayerTile(x, y, 0, tiles[pick(rng)]);
+            if (percent(rng) < 33)
+                tilemap.SetLayerTile(x, y, 1, tiles[pick(rng)]);
+            if (percent(rng) < ySortPercent)
+            {
+                tilemap.SetLayerTile(x, y, 2, tiles[pick(rng)]);
+                tilemap.SetLayerYSortPlus(x, y, 2, true);
+            }
+            if (percent(rng) < 10)
+                tilemap.SetLayerTile(x, y, 5, tiles[pick(rng)]);
+
+            const bool solid = percent(rng) < 20;
+            tilemap.SetTileCollision(x, y, solid);
+            tilemap.SetNavigation(x, y, !solid);
+        }
+    }
+    return true;
+}
+
+/// Report the map edge in tiles and skip when the fixture could not be built.
+inline bool RequireTilemap(benchmark::State &state, Tilemap &tilemap, int size, int ySortPercent = 5)
+{
+    if (!BuildTilemap(tilemap, size, ySortPercent))
+    {
+        state.SkipWithError("assets/ not found; run from the repository or build directory");
+        return false;
+    }
+    state.counters["mapTiles"] = static_cast<double>(size) * size;
+    return true;
+}
+}  // namespace bench
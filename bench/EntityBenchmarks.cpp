@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "../src/PatrolRoute.h"
+#include "../src/YSortQueue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+// range(0) = map edge in tiles, range(1) = maxRouteLength
+void BM_PatrolRouteInitialize(benchmark::State &state)
+{
+    Tilemap tilemap;
+    const int size = static_cast<int>(state.range(0));
+    if (!bench::RequireTilemap(state, tilemap, size))
+        return;
+    const int maxLength = static_cast<int>(state.range(1));
+
+    // Walkable start tiles near the middle, cycled so each call builds a new route
+    std::vector<glm::ivec2> starts;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> coord(size / 4, size * 3 / 4);
+    while (starts.size() < 64)
+    {
+        const glm::ivec2 tile(coord(rng), coord(rng));
+        if (tilemap.GetNavigation(tile.x, tile.y))
+            starts.push_back(tile);
+    }
+
+    size_t next = 0;
+    size_t waypoints = 0;
+    for (auto _ : state)
+    {
+        // The route cache drops a route with its last user, so every call generates
+        PatrolRoute route;
+        const glm::ivec2 start = starts[next++ % starts.size()];
+        benchmark::DoNotOptimize(route.Initialize(start.x, start.y, &tilemap, maxLength));
+        waypoints = route.GetWaypointCount();
+    }
+    state.counters["waypoints"] = static_cast<double>(waypoints);
+}
+
+struct SortItem
+{
+    float sortY;
+    std::uint8_t rank;
+};
+
+std::vector<SortItem> MakeSortItems(size_t count)
+{
+    // Characters and Y-sorted tiles on one screen: many equal Y values
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> row(0, 40);
+    std::uniform_real_distribution<float> offset(0.0f, 16.0f);
+    std::uniform_int_distribution<int> rank(0, 2);
+    std::vector<SortItem> items(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const bool tile = (i % 4) != 0;
+        items[i].sortY = static_cast<float>(row(rng) * 16) + (tile ? 0.0f : offset(rng));
+        items[i].rank = static_cast<std::uint8_t>(rank(rng));
+    }
+    return items;
+}
+
+// The comparator sort the render list used before YSortQueue
+void BM_YSortStableSort(benchmark::State &state)
+{
+    const std::vector<SortItem> items = MakeSortItems(static_cast<size_t>(state.range(0)));
+    std::vector<SortItem> sorted;
+    for (auto _ : state)
+    {
+        sorted = items;
+        std::stable_sort(sorted.begin(), sorted.end(), [](const SortItem &a, const SortItem &b)
+                         { return a.sortY != b.sortY ? a.sortY < b.sortY : a.rank < b.rank; });
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_YSortQueue(benchmark::State &state)
+{
+    const std::vector<SortItem> items = MakeSortItems(static_cast<size_t>(state.range(0)));
+    YSortQueue queue;
+    queue.Reserve(items.size());
+    for (auto _ : state)
+    {
+        queue.Clear();
+        for (const SortItem &item : items)
+            queue.Add(item.sortY, item.rank);
+        queue.Sort();
+        benchmark::DoNotOptimize(queue.IndexAt(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_PatrolRouteInitialize)->ArgsProduct({{64, 256, 1024}, {25, 100, 400}});
+BENCHMARK(BM_YSortStableSort)->Arg(64)->Arg(512)->Arg(4096)->Arg(32768);
+BENCHMARK(BM_YSortQueue)->Arg(64)->Arg(512)->Arg(4096)->Arg(32768);
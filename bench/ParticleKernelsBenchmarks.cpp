@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+#include "../src/ParticleKernels.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+struct BenchData
+{
+    std::vector<float> lifetime, positionX, positionY, velocityX, velocityY, size;
+    std::vector<uint8_t> visible;
+
+    explicit BenchData(size_t count)
+        : lifetime(count), positionX(count), positionY(count), velocityX(count), velocityY(count), size(count),
+          visible(count)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 1500.0f);
+        std::uniform_real_distribution<float> velocity(-80.0f, 80.0f);
+        std::uniform_real_distribution<float> unit(0.5f, 8.0f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            lifetime[i] = unit(rng) * 100.0f;
+            positionX[i] = position(rng);
+            positionY[i] = position(rng);
+            velocityX[i] = velocity(rng);
+            velocityY[i] = velocity(rng);
+            size[i] = unit(rng);
+        }
+    }
+};
+
+// Runs the benchmark on one path, or skips it if the CPU lacks that path
+bool SelectIsa(benchmark::State &state, ParticleKernels::Isa isa)
+{
+    if (!ParticleKernels::IsSupported(isa))
+    {
+        state.SkipWithError("instruction set not supported on this CPU");
+        return false;
+    }
+    ParticleKernels::SetIsa(isa);
+    state.SetLabel(ParticleKernels::GetIsaName(isa));
+    return true;
+}
+
+void BM_ParticleIntegrate(benchmark::State &state, ParticleKernels::Isa isa)
+{
+    if (!SelectIsa(state, isa))
+        return;
+    const size_t count = static_cast<size_t>(state.range(0));
+    BenchData data(count);
+    for (auto _ : state)
+    {
+        ParticleKernels::Integrate(data.lifetime.data(), data.positionX.data(), data.positionY.data(),
+                                   data.velocityX.data(), data.velocityY.data(), count, 1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    ParticleKernels::SetIsa(ParticleKernels::GetBestIsa());
+}
+
+void BM_ParticleCull(benchmark::State &state, ParticleKernels::Isa isa)
+{
+    if (!SelectIsa(state, isa))
+        return;
+    const size_t count = static_cast<size_t>(state.range(0));
+    BenchData data(count);
+    for (auto _ : state)
+    {
+        ParticleKernels::Cull(data.positionX.data(), data.positionY.data(), data.size.data(), count,
+                              glm::vec2(0.0f), glm::vec2(960.0f, 540.0f), 2.0f, 50.0f, data.visible.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    ParticleKernels::SetIsa(ParticleKernels::GetBestIsa());
+}
+}  // namespace
+
+#define WILD_PARTICLE_BENCH(fn, isa) \
+    BENCHMARK_CAPTURE(fn, isa, ParticleKernels::Isa::isa)->Arg(10'000)->Arg(100'000)->Arg(1'000'000)
+
+WILD_PARTICLE_BENCH(BM_ParticleIntegrate, Scalar);
+WILD_PARTICLE_BENCH(BM_ParticleIntegrate, SSE2);
+WILD_PARTICLE_BENCH(BM_ParticleIntegrate, AVX2);
+WILD_PARTICLE_BENCH(BM_ParticleIntegrate, NEON);
+WILD_PARTICLE_BENCH(BM_ParticleCull, Scalar);
+WILD_PARTICLE_BENCH(BM_ParticleCull, SSE2);
+WILD_PARTICLE_BENCH(BM_ParticleCull, AVX2);
+WILD_PARTICLE_BENCH(BM_ParticleCull, NEON);
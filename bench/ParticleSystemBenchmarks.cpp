@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+#include "../src/ParticleSystem.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+constexpr float ZONE_SIZE = 160.0f;
+constexpr float STEP = 1.0f / 60.0f;
+
+// range(0) = zones, range(1) = particle cap per zone. Zones sit on a grid
+// inside one view and cycle through the CPU-simulated types.
+void BM_ParticleSystemUpdate(benchmark::State &state)
+{
+    const int zoneCount = static_cast<int>(state.range(0));
+    const size_t perZone = static_cast<size_t>(state.range(1));
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(zoneCount))));
+
+    const ParticleType types[] = {ParticleType::Firefly, ParticleType::Rain,     ParticleType::Snow,
+                                  ParticleType::Fog,     ParticleType::Sparkles, ParticleType::Wisp,
+                                  ParticleType::Lantern};
+    std::vector<ParticleZone> zones;
+    for (int i = 0; i < zoneCount; ++i)
+    {
+        const glm::vec2 position(static_cast<float>(i % columns) * ZONE_SIZE,
+                                 static_cast<float>(i / columns) * ZONE_SIZE);
+        zones.emplace_back(position, glm::vec2(ZONE_SIZE), types[i % std::size(types)]);
+    }
+    const glm::vec2 viewSize(static_cast<float>(columns) * ZONE_SIZE);
+
+    ParticleSystem particles;
+    particles.SetSeed(1);
+    particles.SetZones(&zones);
+    particles.SetTileSize(16, 16);
+    particles.SetMaxParticlesPerZone(perZone);
+    particles.SetMaxParticles(perZone * static_cast<size_t>(zoneCount));
+    particles.SetNightFactor(1.0f);
+
+    // Ten simulated seconds fill every zone to its steady state
+    for (int i = 0; i < 600; ++i)
+        particles.Update(STEP, glm::vec2(0.0f), viewSize);
+
+    for (auto _ : state)
+        particles.Update(STEP, glm::vec2(0.0f), viewSize);
+
+    state.counters["particles"] = static_cast<double>(particles.GetParticles().Size());
+}
+}  // namespace
+
+BENCHMARK(BM_ParticleSystemUpdate)->ArgsProduct({{4, 16, 64}, {50, 500}});
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include "../src/PerspectiveKernels.h"
+#include "../src/PerspectiveTransform.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr double VIEW_WIDTH = 480.0;
+constexpr double VIEW_HEIGHT = 270.0;
+
+enum class Mode
+{
+    Vanishing,
+    Globe,
+    Fisheye
+};
+
+perspectiveTransform::Params MakeParams(Mode mode)
+{
+    perspectiveTransform::Params params{};
+    params.applyGlobe = mode != Mode::Vanishing;
+    params.applyVanishing = mode != Mode::Globe;
+    params.centerX = VIEW_WIDTH * 0.5;
+    params.centerY = VIEW_HEIGHT * 0.5;
+    params.horizonY = -VIEW_HEIGHT * 0.5;
+    params.screenHeight = VIEW_HEIGHT;
+    params.horizonScale = 0.6;
+    params.sphereRadius = 900.0;
+    return params;
+}
+
+// Quads laid out like one screen of 16 px tiles, repeated up to the count
+void BM_TransformCorners(benchmark::State &state, Mode mode)
+{
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<glm::vec2> source(count * 4);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    const int columns = static_cast<int>(VIEW_WIDTH / 16.0);
+    const int rows = static_cast<int>(VIEW_HEIGHT / 16.0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float x = static_cast<float>(static_cast<int>(i) % columns) * 16.0f + jitter(rng);
+        const float y = static_cast<float>((static_cast<int>(i) / columns) % rows) * 16.0f + jitter(rng);
+        source[i * 4 + 0] = glm::vec2(x, y);
+        source[i * 4 + 1] = glm::vec2(x + 16.0f, y);
+        source[i * 4 + 2] = glm::vec2(x + 16.0f, y + 16.0f);
+        source[i * 4 + 3] = glm::vec2(x, y + 16.0f);
+    }
+
+    const perspectiveTransform::Params params = MakeParams(mode);
+    std::vector<glm::vec2> corners(source.size());
+    for (auto _ : state)
+    {
+        corners = source;
+        for (size_t i = 0; i < count; ++i)
+            perspectiveTransform::TransformCorners(&corners[i * 4], params);
+        benchmark::DoNotOptimize(corners.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Same points as BM_TransformCorners, in SoA arrays through the float kernels
+void BM_TransformPoints(benchmark::State &state, Mode mode, PerspectiveKernels::Isa isa)
+{
+    if (!ParticleKernels::IsSupported(isa))
+    {
+        state.SkipWithError("instruction set not supported on this CPU");
+        return;
+    }
+    PerspectiveKernels::SetIsa(isa);
+    state.SetLabel(ParticleKernels::GetIsaName(isa));
+
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<float> sourceX(count * 4), sourceY(count * 4);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    const int columns = static_cast<int>(VIEW_WIDTH / 16.0);
+    const int rows = static_cast<int>(VIEW_HEIGHT / 16.0);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float x = static_cast<float>(static_cast<int>(i) % columns) * 16.0f + jitter(rng);
+        const float y = static_cast<float>((static_cast<int>(i) / columns) % rows) * 16.0f + jitter(rng);
+        const float cornerX[4] = {x, x + 16.0f, x + 16.0f, x};
+        const float cornerY[4] = {y, y, y + 16.0f, y + 16.0f};
+        for (int c = 0; c < 4; ++c)
+        {
+            sourceX[i * 4 + c] = cornerX[c];
+            sourceY[i * 4 + c] = cornerY[c];
+        }
+    }
+
+    const perspectiveTransform::Params params = MakeParams(mode);
+    std::vector<float> x(sourceX.size()), y(sourceY.size());
+    for (auto _ : state)
+    {
+        x = sourceX;
+        y = sourceY;
+        PerspectiveKernels::TransformPoints(x.data(), y.data(), x.size(), params);
+        benchmark::DoNotOptimize(x.data());
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    PerspectiveKernels::SetIsa(ParticleKernels::GetBestIsa());
+}
+}  // namespace
+
+#define WILD_PERSPECTIVE_BENCH(mode) \
+    BENCHMARK_CAPTURE(BM_TransformCorners, mode, Mode::mode)->Arg(1'000)->Arg(10'000)->Arg(100'000)
+
+#define WILD_PERSPECTIVE_KERNEL_BENCH(mode, isa)                                                      \
+    BENCHMARK_CAPTURE(BM_TransformPoints, mode##_##isa, Mode::mode, PerspectiveKernels::Isa::isa) \
+        ->Arg(1'000)                                                                              \
+        ->Arg(10'000)                                                                             \
+        ->Arg(100'000)
+
+WILD_PERSPECTIVE_BENCH(Vanishing);
+WILD_PERSPECTIVE_BENCH(Globe);
+WILD_PERSPECTIVE_BENCH(Fisheye);
+
+WILD_PERSPECTIVE_KERNEL_BENCH(Fisheye, Scalar);
+WILD_PERSPECTIVE_KERNEL_BENCH(Fisheye, SSE2);
+WILD_PERSPECTIVE_KERNEL_BENCH(Fisheye, AVX2);
+WILD_PERSPECTIVE_KERNEL_BENCH(Fisheye, NEON);
+WILD_PERSPECTIVE_KERNEL_BENCH(Vanishing, AVX2);
+WILD_PERSPECTIVE_KERNEL_BENCH(Globe, AVX2);
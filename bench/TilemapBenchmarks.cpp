@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "../src/NonPlayerCharacter.h"
+
+#include <json.hpp>
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// Camera over the map center showing @p viewTiles tiles across at 16:9.
+struct View
+{
+    glm::vec2 position;
+    glm::vec2 size;
+};
+
+View CenterView(const Tilemap &tilemap, int viewTiles)
+{
+    const glm::vec2 tile(static_cast<float>(tilemap.GetTileWidth()), static_cast<float>(tilemap.GetTileHeight()));
+    View view;
+    view.size = glm::vec2(static_cast<float>(viewTiles), static_cast<float>(viewTiles) * 9.0f / 16.0f) * tile;
+    const glm::vec2 center =
+        glm::vec2(static_cast<float>(tilemap.GetMapWidth()), static_cast<float>(tilemap.GetMapHeight())) * tile * 0.5f;
+    view.position = center - view.size * 0.5f;
+    return view;
+}
+
+// range(0) = map edge in tiles, range(1) = view width in tiles
+void BM_VisibleYSortPlusTiles(benchmark::State &state)
+{
+    Tilemap tilemap;
+    if (!bench::RequireTilemap(state, tilemap, static_cast<int>(state.range(0))))
+        return;
+    const View view = CenterView(tilemap, static_cast<int>(state.range(1)));
+
+    size_t tiles = 0;
+    int frame = 0;
+    for (auto _ : state)
+    {
+        // Pan a pixel per call, as a moving camera would
+        const float offset = static_cast<float>(frame++ % 16);
+        const auto &visible = tilemap.GetVisibleYSortPlusTiles(view.position + glm::vec2(offset, 0.0f), view.size);
+        tiles = visible.size();
+        benchmark::DoNotOptimize(visible.data());
+    }
+    state.counters["ySortTiles"] = static_cast<double>(tiles);
+}
+
+// Background and foreground layer passes for one frame
+void BM_RenderLayers(benchmark::State &state, bool perspective)
+{
+    Tilemap tilemap;
+    if (!bench::RequireTilemap(state, tilemap, static_cast<int>(state.range(0))))
+        return;
+    const View view = CenterView(tilemap, static_cast<int>(state.range(1)));
+
+    bench::NullRenderer renderer;
+    if (perspective)
+    {
+        // CPU projection: the tilemap falls back to its per-tile loop
+        renderer.SetVanishingPointPerspective(true, -view.size.y * 0.5f, 0.6f, view.size.x, view.size.y);
+    }
+
+    for (auto _ : state)
+    {
+        FrameArena::ThisThread().Reset();
+        renderer.BeginFrame();
+        tilemap.ResetDrawnTileCount();
+        tilemap.RenderBackgroundLayers(renderer, view.position, view.size, view.position, view.size);
+        tilemap.RenderForegroundLayers(renderer, view.position, view.size, view.position, view.size);
+        benchmark::DoNotOptimize(renderer.GetDrawCallCount());
+    }
+    state.counters["draws"] = renderer.GetDrawCallCount();
+    state.counters["tiles"] = static_cast<double>(tilemap.GetDrawnTileCount());
+}
+
+// Point and rectangle queries at random spots; range(0) = map edge, range(1) = rect edge
+void BM_CollisionQueries(benchmark::State &state)
+{
+    Tilemap tilemap;
+    const int size = static_cast<int>(state.range(0));
+    if (!bench::RequireTilemap(state, tilemap, size))
+        return;
+    const CollisionMap<BitVector> &collision = tilemap.GetCollisionMap();
+    const int rect = static_cast<int>(state.range(1));
+
+    constexpr size_t QUERIES = 4096;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> coord(0, size - rect);
+    std::vector<glm::ivec2> points(QUERIES);
+    for (glm::ivec2 &point : points)
+        point = glm::ivec2(coord(rng), coord(rng));
+
+    for (auto _ : state)
+    {
+        int hits = 0;
+        for (const glm::ivec2 &p : points)
+        {
+            hits += collision.HasCollision(p.x, p.y) ? 1 : 0;
+            hits += collision.AnyCollisionInRect(p.x, p.y, p.x + rect - 1, p.y + rect - 1) ? 1 : 0;
+            hits += collision.CountCollisionsInRect(p.x, p.y, p.x + rect - 1, p.y + rect - 1);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(QUERIES));
+}
+
+// range(0) = map edge in tiles, range(1) = NPCs in the map file
+void BM_LoadMapFromJSON(benchmark::State &state)
+{
+    Tilemap tilemap;
+    const int size = static_cast<int>(state.range(0));
+    const int npcCount = static_cast<int>(state.range(1));
+    if (!bench::RequireTilemap(state, tilemap, size))
+        return;
+
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("wild_bench_map_" + std::to_string(size) + "_" + std::to_string(npcCount) + ".json"))
+                                 .string();
+    {
+        bench::QuietStdout quiet;
+        if (!tilemap.SaveMapToJSON(path))
+        {
+            state.SkipWithError("could not write the map file");
+            return;
+        }
+    }
+
+    // NPCs are added to the saved file directly, spread over walkable tiles
+    if (npcCount > 0)
+    {
+        std::ifstream in(path);
+        nlohmann::json map = nlohmann::json::parse(in);
+        in.close();
+        nlohmann::json npcs = nlohmann::json::array();
+        std::mt19937 rng(5);
+        std::uniform_int_distribution<int> coord(0, size - 1);
+        while (static_cast<int>(npcs.size()) < npcCount)
+        {
+            const int x = coord(rng);
+            const int y = coord(rng);
+            if (tilemap.GetNavigation(x, y))
+                npcs.push_back({{"type", bench::NPC_TYPE}, {"tileX", x}, {"tileY", y}});
+        }
+        map["npcs"] = npcs;
+        std::ofstream out(path);
+        out << map.dump();
+    }
+
+    std::vector<NonPlayerCharacter> loaded;
+    for (auto _ : state)
+    {
+        bench::QuietStdout quiet;
+        if (!tilemap.LoadMapFromJSON(path, &loaded))
+        {
+            state.SkipWithError("LoadMapFromJSON failed");
+            break;
+        }
+        benchmark::DoNotOptimize(loaded.data());
+    }
+    state.counters["npcs"] = static_cast<double>(loaded.size());
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+}  // namespace
+
+BENCHMARK(BM_VisibleYSortPlusTiles)->ArgsProduct({{128, 512, 1024}, {30, 120}});
+BENCHMARK_CAPTURE(BM_RenderLayers, Flat, false)->ArgsProduct({{128, 1024}, {30, 120}});
+BENCHMARK_CAPTURE(BM_RenderLayers, Perspective, true)->ArgsProduct({{128, 1024}, {30, 120}});
+BENCHMARK(BM_CollisionQueries)->ArgsProduct({{128, 1024}, {1, 4, 16}});
+BENCHMARK(BM_LoadMapFromJSON)->ArgsProduct({{64, 256}, {0, 100}})->Unit(benchmark::kMillisecond);
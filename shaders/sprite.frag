@@ -28,9 +28,33 @@ layout (location = 1) in vec4 VertexColor;
 // ---------------------------
 // Texture sampler
 // ---------------------------
+#ifdef USE_VULKAN
 // The sprite texture to sample from.
 // "binding = 0" indicates which descriptor/texture unit it is expected to be bound to.
 layout (binding = 0) uniform sampler2D sprite;
+#else
+// Texture slot of this quad, set by the sprite batch (0 for everything else).
+layout (location = 2) flat in float TexIndex;
+
+// One sprite batch may sample up to 8 textures, bound to units 0..7
+// (OpenGLRenderer::MAX_BATCH_TEXTURE_SLOTS). Single-texture draws use unit 0.
+layout (binding = 0) uniform sampler2D spriteSlots[8];
+
+// Samplers may only be indexed with dynamically uniform values, so the
+// per-quad slot selects a constant index instead.
+vec4 sampleSprite(vec2 uv) {
+    switch (int(TexIndex + 0.5)) {
+        case 1: return texture(spriteSlots[1], uv);
+        case 2: return texture(spriteSlots[2], uv);
+        case 3: return texture(spriteSlots[3], uv);
+        case 4: return texture(spriteSlots[4], uv);
+        case 5: return texture(spriteSlots[5], uv);
+        case 6: return texture(spriteSlots[6], uv);
+        case 7: return texture(spriteSlots[7], uv);
+        default: return texture(spriteSlots[0], uv);
+    }
+}
+#endif
 
 // -----------------------------------------------------------------------------
 // Uniform data (two alternatives depending on USE_VULKAN)
@@ -65,6 +89,12 @@ uniform vec4 colorOnly;
 uniform float spriteAlpha;  // alpha multiplier for texture mode (default 1.0)
 uniform vec3 ambientColor;  // global ambient light color for day/night cycle
 
+// Light map (OpenGLRenderer::SetLightMap): ambient plus splatted lights at low
+// resolution, laid over the viewport. Replaces ambientColor while enabled.
+uniform int  lightMapEnabled;
+uniform vec4 lightMapRect;  // viewport origin (xy) and 1 / viewport size (zw)
+layout (binding = 8) uniform sampler2D lightMap;  // LIGHT_MAP_TEXTURE_UNIT
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -120,7 +150,7 @@ void main() {
     if (useColorOnly == 3) {
         // Textured particle mode:
         // Sample texture and multiply by per-vertex color (for batched particles).
-        vec4 texColor = texture(sprite, TexCoord);
+        vec4 texColor = sampleSprite(TexCoord);
         if (texColor.a < 0.1)
             discard;
         FragColor = texColor * VertexColor;
@@ -139,16 +169,24 @@ void main() {
     } else {
         // Texture mode (useColorOnly == 0):
         // Sample sprite texture using UVs.
-        vec4 texColor = texture(sprite, TexCoord);
+        vec4 texColor = sampleSprite(TexCoord);
 
         // Alpha cutout (same idea as Vulkan branch):
         // Discard fragments with very low alpha to avoid drawing invisible pixels.
         if (texColor.a < 0.1)
             discard;
 
-        // Tint the texture with spriteColor and ambientColor (for day/night cycle).
+        // Light is the flat ambient color, or one filtered light map sample.
+        // textureLod: implicit derivatives are undefined after the discard.
+        vec3 light = ambientColor;
+        if (lightMapEnabled != 0) {
+            vec2 lightUV = (gl_FragCoord.xy - lightMapRect.xy) * lightMapRect.zw;
+            light = min(textureLod(lightMap, lightUV, 0.0).rgb, vec3(1.0));
+        }
+
+        // Tint the texture with spriteColor and the light (for day/night cycle).
         // Multiply RGB by both colors, multiply alpha by spriteAlpha.
-        FragColor = vec4(spriteColor * ambientColor * texColor.rgb, spriteAlpha * texColor.a);
+        FragColor = vec4(spriteColor * light * texColor.rgb, spriteAlpha * texColor.a);
     }
 
 #endif
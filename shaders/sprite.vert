@@ -20,13 +20,23 @@ layout (location = 0) in vec2 aPos;
 // Texture coordinates (UVs) for this vertex (0..1 range typically).
 layout (location = 1) in vec2 aTexCoord;
 
-// Optional per-vertex color. Useful for:
-//  - batching colored rectangles (no texture)
-//  - gradients
-//  - per-vertex tinting effects
-layout (location = 2) in vec4 aColor;  // RGBA
-// Texture index within bound array (OpenGL batching)
-layout (location = 3) in float aTexIndex;
+// Optional per-vertex color. Useful for:
+//  - batching colored rectangles (no texture)
+//  - gradients
+//  - per-vertex tinting effects
+layout (location = 2) in vec4 aColor;  // RGBA
+// Texture slot within the batch's bound textures (OpenGL multi-texture batching).
+// Left disabled by VAOs that sample a single texture, which reads as 0.
+layout (location = 3) in float aTexIndex;
+
+#ifndef USE_VULKAN
+// Per-instance attributes for IRenderer::SpriteInstance (OpenGL instanced path).
+// Only the instance VAO enables these, with a divisor of 1.
+layout (location = 4) in vec4 iPosSize;    // position xy, size zw
+layout (location = 5) in vec4 iUvRect;     // uvMin xy, uvMax zw
+layout (location = 6) in uvec2 iRotFlags;  // rotation (65536 per turn), flags
+layout (location = 7) in vec4 iColor;      // RGBA
+#endif
 
 // ---------------------------
 // Varyings (outputs to fragment shader)
@@ -37,10 +47,10 @@ layout (location = 3) in float aTexIndex;
 // UV coordinates forwarded to the fragment shader for texture sampling.
 layout (location = 0) out vec2 TexCoord;
 
-// Per-vertex color forwarded to fragment shader (interpolated across the face).
-layout (location = 1) out vec4 VertexColor;
-// Texture index forwarded to fragment shader
-layout (location = 2) out float TexIndex;
+// Per-vertex color forwarded to fragment shader (interpolated across the face).
+layout (location = 1) out vec4 VertexColor;
+// Texture slot forwarded to fragment shader (constant per quad, so not interpolated)
+layout (location = 2) flat out float TexIndex;
 
 // -----------------------------------------------------------------------------
 // Uniform / per-draw data
@@ -59,6 +69,8 @@ layout(push_constant) uniform PushConstants {
     layout(offset = 128) vec3 spriteColor;    // (not used here) tint for fragment shader
     layout(offset = 140) float useColorOnly;  // (not used here) mode switch for fragment shader
     layout(offset = 144) vec4 colorOnly;      // (not used here) uniform solid color
+    layout(offset = 192) vec4 perspParams0;   // centerX, centerY, horizonY, screenHeight
+    layout(offset = 208) vec4 perspParams1;   // horizonScale, sphereRadius, applyGlobe, applyVanishing
 } pc;
 
 #else
@@ -69,6 +81,83 @@ layout(push_constant) uniform PushConstants {
 uniform mat4 projection;
 uniform mat4 model;
 
+// GPU perspective parameters (see IRenderer::GetShaderPerspective).
+// Left at zero when the CPU already projected the vertices.
+uniform vec4 perspParams0;  // centerX, centerY, horizonY, screenHeight
+uniform vec4 perspParams1;  // horizonScale, sphereRadius, applyGlobe, applyVanishing
+
+// Non-zero while drawing SpriteInstance records: the quad is built from
+// gl_VertexID and the instance attributes instead of aPos/aTexCoord.
+uniform int instanced;
+
+#endif
+
+// -----------------------------------------------------------------------------
+// Perspective projection (mirror of perspectiveTransform::TransformPoint)
+// -----------------------------------------------------------------------------
+// Operates on screen-space positions before the orthographic projection:
+//   1) Globe: push the point onto a sphere of radius R, d' = R * sin(d / R)
+//   2) Vanishing point: scale toward the horizon line based on depth
+// Either step is skipped when its flag in params1 is zero, so all-zero
+// parameters leave the position untouched.
+// -----------------------------------------------------------------------------
+vec2 applyPerspective(vec2 p, vec4 params0, vec4 params1) {
+    vec2 center = params0.xy;
+    float horizonY = params0.z;
+    float screenHeight = params0.w;
+    float horizonScale = params1.x;
+    float sphereRadius = params1.y;
+
+    if (params1.z > 0.5) {
+        vec2 delta = p - center;
+        float d = length(delta);
+        if (d > 0.001) {
+            float projectedD = sphereRadius * sin(d / sphereRadius);
+            p = center + delta * (projectedD / d);
+        }
+    }
+
+    if (params1.w > 0.5) {
+        float denom = screenHeight - horizonY;
+        if (denom >= 1e-5) {
+            float depthNorm = clamp((p.y - horizonY) / denom, 0.0, 1.0);
+            float scaleFactor = horizonScale + (1.0 - horizonScale) * depthNorm;
+            p.x = center.x + (p.x - center.x) * scaleFactor;
+            p.y = horizonY + (p.y - horizonY) * scaleFactor;
+        }
+    }
+
+    return p;
+}
+
+#ifndef USE_VULKAN
+// -----------------------------------------------------------------------------
+// Instanced sprite expansion (mirror of IRenderer::DrawSpriteInstances fallback)
+// -----------------------------------------------------------------------------
+// Six vertices per instance in the batcher's order TL, BR, BL, TL, TR, BR.
+// Corners rotate around the quad center like IRenderer::RotateCorners and
+// take UVs the same way DrawSpriteAtlas assigns them.
+// -----------------------------------------------------------------------------
+const vec2 INSTANCE_CORNERS[6] = vec2[6](
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0));
+
+void expandInstance(out vec2 pos, out vec2 uv) {
+    vec2 corner = INSTANCE_CORNERS[gl_VertexID % 6];
+    vec2 size = iPosSize.zw;
+
+    vec2 p = corner * size - size * 0.5;
+    float angle = float(iRotFlags.x) * (6.28318530718 / 65536.0);
+    float c = cos(angle);
+    float s = sin(angle);
+    pos = iPosSize.xy + size * 0.5 + vec2(p.x * c - p.y * s, p.x * s + p.y * c);
+
+    vec4 rect = iUvRect;
+    if ((iRotFlags.y & 1u) != 0u) rect = rect.zyxw;  // SPRITE_INSTANCE_FLIP_X
+    if ((iRotFlags.y & 2u) != 0u) rect = rect.xwzy;  // SPRITE_INSTANCE_FLIP_Y
+    // Top row of the quad samples uvMax.y (OpenGL flipped V)
+    uv = vec2(mix(rect.x, rect.z, corner.x), mix(rect.w, rect.y, corner.y));
+}
 #endif
 
 // -----------------------------------------------------------------------------
@@ -89,20 +178,39 @@ void main() {
     //   model      moves/scales/rotates the sprite in the world
     //   projection maps it into clip space (for rasterization)
     //
-    // Order matters: projection * model * position
-    // (Right-most is applied first.)
+    // Order matters: projection * perspective(model * position)
+    // (Right-most is applied first.) The perspective step runs in screen
+    // space, between model and projection, exactly where the CPU batcher
+    // applies it.
     // -------------------------------------------------------------------------
 #ifdef USE_VULKAN
-    gl_Position = pc.projection * pc.model * vec4(aPos, 0.0, 1.0);
+    vec4 screenPos = pc.model * vec4(aPos, 0.0, 1.0);
+    screenPos.xy = applyPerspective(screenPos.xy, pc.perspParams0, pc.perspParams1);
+    gl_Position = pc.projection * screenPos;
 #else
-    gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
+    if (instanced != 0) {
+        vec2 pos;
+        vec2 uv;
+        expandInstance(pos, uv);
+        vec4 screenPos = model * vec4(pos, 0.0, 1.0);
+        screenPos.xy = applyPerspective(screenPos.xy, perspParams0, perspParams1);
+        gl_Position = projection * screenPos;
+        TexCoord = uv;
+        VertexColor = iColor;
+        TexIndex = 0.0;
+        return;
+    }
+
+    vec4 screenPos = model * vec4(aPos, 0.0, 1.0);
+    screenPos.xy = applyPerspective(screenPos.xy, perspParams0, perspParams1);
+    gl_Position = projection * screenPos;
 #endif
 
     // -------------------------------------------------------------------------
     // Pass through per-vertex attributes to the fragment shader
     // -------------------------------------------------------------------------
     // These will be interpolated automatically across the triangle surface.
-    TexCoord = aTexCoord;
-    VertexColor = aColor;
-    TexIndex = aTexIndex;
-}
+    TexCoord = aTexCoord;
+    VertexColor = aColor;
+    TexIndex = aTexIndex;
+}
@@ -0,0 +1,37 @@
+#version 450
+
+// -----------------------------------------------------------------------------
+// Star Field Fragment Shader ("frag")
+// Runs once per pixel of every visible star quad (OpenGL only).
+// Its job is to:
+//   1) Sample the star sprite and, when the star sparkles, its glow sprite
+//   2) Output their premultiplied sum; the draw blends with ONE, ONE, which
+//      equals drawing both sprites additively (SRC_ALPHA, ONE)
+// -----------------------------------------------------------------------------
+
+layout (location = 0) in vec2 StarCoord;
+layout (location = 1) in vec2 GlowCoord;
+layout (location = 2) in vec3 StarColor;
+layout (location = 3) in vec3 GlowColor;
+
+layout (location = 0) out vec4 FragColor;
+
+uniform sampler2D starTexture;  // SkyRenderer::m_StarTexture
+uniform sampler2D glowTexture;  // SkyRenderer::m_StarGlowTexture
+
+bool inside(vec2 uv) {
+    return all(greaterThanEqual(uv, vec2(0.0))) && all(lessThanEqual(uv, vec2(1.0)));
+}
+
+void main() {
+    vec3 color = vec3(0.0);
+    if (inside(StarCoord)) {
+        vec4 texel = texture(starTexture, StarCoord);
+        color += texel.rgb * texel.a * StarColor;
+    }
+    if (inside(GlowCoord)) {
+        vec4 texel = texture(glowTexture, GlowCoord);
+        color += texel.rgb * texel.a * GlowColor;
+    }
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,106 @@
+#version 450
+
+// -----------------------------------------------------------------------------
+// Star Field Vertex Shader ("vert")
+// Runs once per corner of every star quad (OpenGL only).
+// Its job is to:
+//   1) Evaluate twinkle, visibility gating and glow (mirror of SkyRenderer's
+//      RenderBackgroundStars/RenderForegroundStars)
+//   2) Expand one quad per star, sized to fit the star and its glow
+//   3) Move hidden stars outside the clip volume so they produce no fragments
+// The quad corners come from gl_VertexID; there is no vertex buffer.
+// -----------------------------------------------------------------------------
+
+// Per-instance attributes for IRenderer::StarFieldStar (divisor 1)
+layout (location = 0) in vec2 iPosition;     // Normalized sky position (0-1)
+layout (location = 1) in vec4 iParams;       // baseBrightness, twinklePhase, twinkleSpeed, size
+layout (location = 2) in vec4 iColor;        // RGB tint (alpha unused)
+layout (location = 3) in uint iFlagsIndex;   // STAR_FIELD_BACKGROUND | index within its layer << 1
+
+layout (location = 0) out vec2 StarCoord;    // Star texture UV, outside 0-1 = no star
+layout (location = 1) out vec2 GlowCoord;    // Glow texture UV, outside 0-1 = no glow
+layout (location = 2) out vec3 StarColor;    // Premultiplied star color
+layout (location = 3) out vec3 GlowColor;    // Premultiplied glow color
+
+uniform mat4 projection;
+uniform vec2 screenSize;
+uniform float time;
+uniform float intensity;       // SkyRenderer::GetStarIntensity()
+uniform uint backgroundCount;  // Stars in each layer, for the count caps
+uniform uint foregroundCount;
+
+const uint FLAG_BACKGROUND = 1u;  // IRenderer::STAR_FIELD_BACKGROUND
+
+const vec2 CORNERS[6] = vec2[](
+    vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(0.0, 1.0),
+    vec2(0.0, 0.0), vec2(1.0, 0.0), vec2(1.0, 1.0));
+
+void main() {
+    float baseBrightness = iParams.x;
+    float phase = iParams.y;
+    float speed = iParams.z;
+    float starScale = iParams.w;
+    bool background = (iFlagsIndex & FLAG_BACKGROUND) != 0u;
+    uint index = iFlagsIndex >> 1;
+
+    // Brightest stars appear first as night falls
+    float appearThreshold = 1.0 - intensity * 2.0;
+
+    bool visible;
+    float brightness;
+    float starSize;
+    float starAlpha;
+    float glowSize = 0.0;
+    float glowAlpha = 0.0;
+
+    if (background) {
+        uint maxStars = uint(float(backgroundCount) * intensity * 0.4);
+        visible = baseBrightness >= appearThreshold && index < maxStars;
+
+        float twinkle = 0.6 + 0.4 * sin(time * speed * 1.5 + phase);
+        brightness = baseBrightness * twinkle * intensity * 0.3;
+        starSize = 1.0 + starScale * 1.2;
+        starAlpha = brightness;
+    } else {
+        uint maxStars = uint(float(foregroundCount) * intensity * 0.6);
+        visible = baseBrightness >= appearThreshold * 0.8 && index < maxStars;
+
+        // Sparkly twinkle - more variation, sharper peaks
+        float twinkle1 = sin(time * speed * 1.2 + phase);
+        float twinkle2 = sin(time * speed * 2.7 + phase * 1.3);
+        float twinkle3 = sin(time * speed * 0.5 + phase * 2.1);
+        float sparkle = max(0.0, twinkle1 * twinkle2);
+        float twinkle = 0.4 + 0.35 * twinkle1 + 0.15 * twinkle3 + 0.25 * sparkle;
+
+        brightness = baseBrightness * twinkle * intensity;
+        starSize = (1.5 + starScale * 3.0) * (0.5 + brightness * 0.5);
+        starAlpha = brightness * 0.7;
+
+        // Subtle glow on bright sparkle moments
+        if (brightness > 0.25 && sparkle > 0.3) {
+            glowSize = 6.0 + starScale * 8.0;
+            glowAlpha = (brightness - 0.25) * 0.1;
+        }
+    }
+
+    if (!visible || brightness < 0.01) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        StarCoord = vec2(-1.0);
+        GlowCoord = vec2(-1.0);
+        StarColor = vec3(0.0);
+        GlowColor = vec3(0.0);
+        return;
+    }
+
+    // One quad covers both sprites, each maps its own UV range onto it
+    float quadSize = max(starSize, glowSize);
+    vec2 corner = CORNERS[gl_VertexID];
+    vec2 offset = (corner - 0.5) * quadSize;
+    vec2 screenPos = iPosition * screenSize + offset;
+    gl_Position = projection * vec4(screenPos, 0.0, 1.0);
+
+    StarCoord = offset / starSize + 0.5;
+    GlowCoord = glowSize > 0.0 ? offset / glowSize + 0.5 : vec2(-1.0);
+    StarColor = iColor.rgb * starAlpha;
+    GlowColor = iColor.rgb * glowAlpha;
+}
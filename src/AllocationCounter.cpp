@@ -0,0 +1,133 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#if defined(WILD_ENABLE_PROFILER)
+
+namespace
+{
+// Plain atomics are constant-initialized, so they are usable before any
+// static constructor runs
+std::atomic<std::uint64_t> s_Allocations{0};
+std::atomic<std::uint64_t> s_Bytes{0};
+
+void *Allocate(std::size_t size)
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    s_Bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void *AllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    s_Allocations.fetch_add(1, std::memory_order_relaxed);
+    s_Bytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    const std::size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+#endif
+}
+
+void FreeAligned(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void *AllocateOrThrow(std::size_t size)
+{
+    for (;;)
+    {
+        if (void *ptr = Allocate(size))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void *AllocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+{
+    for (;;)
+    {
+        if (void *ptr = AllocateAligned(size, alignment))
+            return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+}
+
+void *operator new(std::size_t size) { return AllocateOrThrow(size); }
+void *operator new[](std::size_t size) { return AllocateOrThrow(size); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return Allocate(size); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAlignedOrThrow(size, alignment); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return AllocateAligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return AllocateAligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { FreeAligned(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { FreeAligned(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { FreeAligned(ptr); }
+
+bool AllocationCounter::IsEnabled()
+{
+    return true;
+}
+
+AllocationCounter::Totals AllocationCounter::GetTotals()
+{
+    Totals totals;
+    totals.allocations = s_Allocations.load(std::memory_order_relaxed);
+    totals.bytes = s_Bytes.load(std::memory_order_relaxed);
+    return totals;
+}
+
+#else
+
+bool AllocationCounter::IsEnabled()
+{
+    return false;
+}
+
+AllocationCounter::Totals AllocationCounter::GetTotals()
+{
+    return {};
+}
+
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @class AllocationCounter
+ * @brief Counts heap allocations made through global operator new.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * With ENABLE_PROFILER on (CMake), AllocationCounter.cpp replaces the
+ * global operator new/delete family with thin wrappers around malloc/free
+ * that bump two relaxed atomic counters. Callers that want per-frame
+ * numbers sample GetTotals() once per frame and subtract:
+ *
+ * @code
+ * AllocationCounter::Totals now = AllocationCounter::GetTotals();
+ * uint64_t frameAllocs = now.allocations - m_LastAllocs.allocations;
+ * m_LastAllocs = now;
+ * @endcode
+ *
+ * Allocations that bypass operator new (malloc in C libraries, driver
+ * memory) are not seen. With the profiler compiled out the standard
+ * operators are used and IsEnabled() returns false.
+ *
+ * @par Thread Safety
+ * Counters are updated from every allocating thread; GetTotals() may be
+ * called from any thread. The two fields are read separately, so they may
+ * be off by the allocations in flight.
+ */
+class AllocationCounter
+{
+public:
+    struct Totals
+    {
+        std::uint64_t allocations = 0;  ///< operator new calls since startup
+        std::uint64_t bytes = 0;        ///< Bytes requested by those calls
+    };
+
+    /// @brief Whether operator new is instrumented in this build.
+    [[nodiscard]] static bool IsEnabled();
+
+    /// @brief Cumulative counts since startup (zeros when disabled).
+    [[nodiscard]] static Totals GetTotals();
+};
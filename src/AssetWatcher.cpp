@@ -0,0 +1,123 @@
+#include "AssetWatcher.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <system_error>
+
+AssetWatcher::~AssetWatcher()
+{
+    Stop();
+}
+
+void AssetWatcher::Start(std::vector<std::string> roots, std::chrono::milliseconds interval)
+{
+    Stop();
+    SetRoots(std::move(roots));
+
+    m_StopWorker = false;
+    m_Worker = std::thread(&AssetWatcher::WorkerMain, this, interval);
+}
+
+void AssetWatcher::Stop()
+{
+    if (m_Worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopWorker = true;
+        }
+        m_WakeWorker.notify_all();
+        m_Worker.join();
+    }
+}
+
+void AssetWatcher::SetRoots(std::vector<std::string> roots)
+{
+    m_Roots = std::move(roots);
+    m_Files.clear();
+    m_Primed = false;
+}
+
+std::vector<std::string> AssetWatcher::TakeChanges()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<std::string> changes;
+    changes.swap(m_Changes);
+    return changes;
+}
+
+void AssetWatcher::Poll()
+{
+    WILD_PROFILE_ZONE("Scan Assets");
+    namespace fs = std::filesystem;
+
+    for (auto &[path, entry] : m_Files)
+        entry.seen = false;
+
+    std::vector<std::string> settled;
+    for (const std::string &root : m_Roots)
+    {
+        // A file vanishing mid-scan is just skipped; the next scan sees the result
+        std::error_code error;
+        fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, error);
+        for (; !error && it != fs::recursive_directory_iterator(); it.increment(error))
+        {
+            std::error_code statError;
+            if (!it->is_regular_file(statError))
+                continue;
+            Stamp stamp{it->last_write_time(statError), it->file_size(statError)};
+            if (statError)
+                continue;
+
+            const std::string path = it->path().generic_string();
+            auto [found, added] = m_Files.try_emplace(path);
+            Entry &entry = found->second;
+            entry.seen = true;
+            if (added)
+            {
+                entry.stamp = stamp;
+                entry.settling = m_Primed;  // New files after the baseline count as changes
+                continue;
+            }
+            if (entry.stamp != stamp)
+            {
+                entry.stamp = stamp;
+                entry.settling = true;
+            }
+            else if (entry.settling)
+            {
+                entry.settling = false;
+                settled.push_back(path);
+            }
+        }
+    }
+
+    std::erase_if(m_Files, [](const auto &file) { return !file.second.seen; });
+    m_Primed = true;
+
+    if (settled.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (std::string &path : settled)
+    {
+        if (std::find(m_Changes.begin(), m_Changes.end(), path) == m_Changes.end())
+            m_Changes.push_back(std::move(path));
+    }
+}
+
+void AssetWatcher::WorkerMain(std::chrono::milliseconds interval)
+{
+    WILD_PROFILE_THREAD("Asset Watcher");
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;)
+    {
+        // Scanning runs unlocked; only the change list is shared
+        lock.unlock();
+        Poll();
+        lock.lock();
+
+        if (m_WakeWorker.wait_for(lock, interval, [this] { return m_StopWorker; }))
+            return;
+    }
+}
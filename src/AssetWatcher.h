@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class AssetWatcher
+ * @brief Polls asset directories on a worker thread and reports changed files.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Drives hot reload: the worker rescans its roots every interval and
+ * compares each file's modification time and size with the last scan. The
+ * main thread collects changed paths with TakeChanges() and reloads only
+ * those assets, so nothing is ever stat'ed on the frame:
+ *
+ * @code
+ *   worker: every interval --> Poll() --> [changes]
+ *                                             |
+ *   main:   TakeChanges() <-------------------+
+ *             tileset?  --> Tilemap::PatchTileset()
+ *             sheet?    --> SpriteSheetRegistry::Reload()
+ *             shader?   --> IRenderer::ReloadShaders()
+ * @endcode
+ *
+ * @par Settling
+ * Editors and exporters often write a file in several steps. A changed
+ * file is reported only once a later scan finds it unchanged, so a reload
+ * never sees half a PNG. The first scan records the baseline and reports
+ * nothing; deleted files are forgotten silently.
+ *
+ * @par Thread Safety
+ * Start(), Stop() and TakeChanges() are main-thread calls. Poll() scans on
+ * the calling thread and is meant for tests; do not call it while started.
+ */
+class AssetWatcher
+{
+public:
+    /// @brief Time between scans started by Start() by default.
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{500};
+
+    AssetWatcher() = default;
+    ~AssetWatcher();
+
+    AssetWatcher(const AssetWatcher &) = delete;
+    AssetWatcher &operator=(const AssetWatcher &) = delete;
+
+    /**
+     * @brief Watch @p roots recursively from a worker thread.
+     *
+     * Roots that do not exist are skipped on every scan. Restarting
+     * replaces the roots and records a fresh baseline.
+     */
+    void Start(std::vector<std::string> roots, std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+    /// @brief Stop the worker. Changes not yet taken are kept.
+    void Stop();
+
+    /// @brief True between Start() and Stop().
+    bool IsRunning() const { return m_Worker.joinable(); }
+
+    /// @brief Scan once on the calling thread (without Start(), uses the roots of SetRoots()).
+    void Poll();
+
+    /// @brief Set the roots Poll() scans, dropping the baseline.
+    void SetRoots(std::vector<std::string> roots);
+
+    /// @brief Changed files since the last call, in generic form ("assets/a/b.png"), each once.
+    std::vector<std::string> TakeChanges();
+
+private:
+    struct Stamp
+    {
+        std::filesystem::file_time_type time{};
+        std::uintmax_t size = 0;
+
+        bool operator==(const Stamp &) const = default;
+    };
+
+    struct Entry
+    {
+        Stamp stamp;
+        bool settling = false;  ///< Changed on the last scan, reported once stable
+        bool seen = false;      ///< Found by the current scan
+    };
+
+    void WorkerMain(std::chrono::milliseconds interval);
+
+    /// @name Scan State
+    /// Touched only by the thread that polls.
+    /// @{
+    std::vector<std::string> m_Roots;
+    std::unordered_map<std::string, Entry> m_Files;
+    bool m_Primed = false;  ///< The baseline scan has run
+    /// @}
+
+    /// @name Worker Thread
+    /// @{
+    std::thread m_Worker;
+    std::mutex m_Mutex;                   ///< Guards everything in this group
+    std::condition_variable m_WakeWorker;
+    std::vector<std::string> m_Changes;   ///< Settled changes waiting for TakeChanges()
+    bool m_StopWorker = false;
+    /// @}
+};
@@ -0,0 +1,219 @@
+#include "AsyncTextureLoader.h"
+#include "IRenderer.h"
+#include "Profiler.h"
+#include "Texture.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+// Transparent, so anything drawn with the texture before it is filled shows nothing
+void MakePlaceholder(Texture &texture)
+{
+    unsigned char clear[4] = {0, 0, 0, 0};
+    texture.LoadFromData(clear, 1, 1, 4, false);
+}
+}  // namespace
+
+AsyncTextureLoader::AsyncTextureLoader(unsigned workerCount)
+{
+    const unsigned count = std::max(1u, workerCount);
+    m_Workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        m_Workers.emplace_back(&AsyncTextureLoader::WorkerMain, this);
+    }
+}
+
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WakeWorkers.notify_all();
+    for (std::thread &worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+void AsyncTextureLoader::Load(std::shared_ptr<Texture> texture, std::string path, Callback onReady)
+{
+    MakePlaceholder(*texture);
+    Reload(std::move(texture), std::move(path), std::move(onReady));
+}
+
+void AsyncTextureLoader::Reload(std::shared_ptr<Texture> texture, std::string path, Callback onReady)
+{
+    Pending pending{std::move(texture), std::move(path), {}, {}};
+    if (onReady)
+    {
+        pending.callbacks.push_back(std::move(onReady));
+    }
+    Queue(std::move(pending), true);
+}
+
+void AsyncTextureLoader::Decode(std::string path, bool flipY, DecodeCallback onDecoded)
+{
+    Queue({nullptr, std::move(path), {}, std::move(onDecoded)}, flipY);
+}
+
+void AsyncTextureLoader::Queue(Pending pending, bool flipY)
+{
+    const std::uint64_t id = m_NextId++;
+    std::string path = pending.path;
+    m_Pending.emplace_back(id, std::move(pending));
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requests.push_back({id, std::move(path), flipY});
+    }
+    m_WakeWorkers.notify_one();
+}
+
+bool AsyncTextureLoader::OnReady(const Texture &texture, Callback onReady)
+{
+    for (auto &[id, pending] : m_Pending)
+    {
+        if (pending.texture.get() == &texture)
+        {
+            pending.callbacks.push_back(std::move(onReady));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AsyncTextureLoader::IsPending(const Texture &texture) const
+{
+    return std::any_of(m_Pending.begin(), m_Pending.end(),
+                       [&texture](const auto &entry) { return entry.second.texture.get() == &texture; });
+}
+
+int AsyncTextureLoader::Update(IRenderer *renderer, size_t budgetBytes)
+{
+    if (m_Pending.empty())
+        return 0;
+
+    WILD_PROFILE_ZONE("Texture Uploads");
+    int completed = 0;
+    size_t uploaded = 0;
+    for (;;)
+    {
+        Decoded decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (m_Completed.empty())
+                break;
+            // The first image always goes, however large
+            const size_t bytes = m_Completed.front().image.pixels.size();
+            if (completed > 0 && uploaded + bytes > budgetBytes)
+                break;
+            decoded = std::move(m_Completed.front());
+            m_Completed.pop_front();
+        }
+        uploaded += decoded.image.pixels.size();
+        Complete(renderer, decoded);
+        ++completed;
+    }
+    return completed;
+}
+
+void AsyncTextureLoader::Finish(IRenderer *renderer)
+{
+    while (!m_Pending.empty())
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Decoded.wait(lock, [this] { return !m_Completed.empty(); });
+        }
+        Update(renderer, std::numeric_limits<size_t>::max());
+    }
+}
+
+void AsyncTextureLoader::Clear()
+{
+    // Decodes already running finish into m_Completed and are discarded there
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requests.clear();
+    }
+    m_Pending.clear();
+}
+
+void AsyncTextureLoader::WorkerMain()
+{
+    WILD_PROFILE_THREAD("Texture Loader");
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;)
+    {
+        m_WakeWorkers.wait(lock, [this] { return m_Stop || !m_Requests.empty(); });
+        if (m_Stop)
+            return;
+
+        Request request = std::move(m_Requests.front());
+        m_Requests.pop_front();
+
+        // Decoding runs unlocked; only the queues are shared
+        lock.unlock();
+        Decoded decoded{request.id, false, {}};
+        {
+            WILD_PROFILE_ZONE("Decode Texture");
+            decoded.ok = ImageCache::Load(request.path, request.flipY, decoded.image);
+        }
+        lock.lock();
+
+        m_Completed.push_back(std::move(decoded));
+        m_Decoded.notify_all();
+    }
+}
+
+void AsyncTextureLoader::Complete(IRenderer *renderer, Decoded &decoded)
+{
+    auto it = std::find_if(m_Pending.begin(), m_Pending.end(),
+                           [&decoded](const auto &entry) { return entry.first == decoded.id; });
+    if (it == m_Pending.end())
+        return;  // Cleared while decoding
+
+    Pending pending = std::move(it->second);
+    m_Pending.erase(it);
+
+    if (pending.onDecoded)
+    {
+        if (!decoded.ok)
+        {
+            std::cerr << "Failed to decode image: " << pending.path << std::endl;
+            decoded.image = {};
+        }
+        pending.onDecoded(decoded.ok, decoded.image);
+        return;
+    }
+
+    Texture &texture = *pending.texture;
+    bool loaded = decoded.ok && !decoded.image.pixels.empty();
+    if (loaded)
+    {
+        // Waits for a frame in flight that may still sample the placeholder,
+        // and may take the texture's GPU handles along with it
+        if (renderer)
+            renderer->ReleaseTexture(texture);
+        loaded = texture.AdoptPixels(std::move(decoded.image.pixels), decoded.image.width,
+                                     decoded.image.height, decoded.image.channels);
+        if (!loaded)
+            MakePlaceholder(texture);
+        if (renderer)
+            renderer->UploadTexture(texture);
+    }
+    if (!loaded)
+    {
+        std::cerr << "Failed to load texture: " << pending.path << std::endl;
+    }
+
+    for (Callback &callback : pending.callbacks)
+    {
+        callback(loaded);
+    }
+}
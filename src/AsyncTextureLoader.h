@@ -0,0 +1,177 @@
+#pragma once
+
+#include "ImageCache.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class IRenderer;
+class Texture;
+
+/**
+ * @class AsyncTextureLoader
+ * @brief Decodes image files on worker threads and uploads them a few per frame.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Load() returns at once and leaves the texture as a 1x1 transparent
+ * placeholder, so it can be drawn, uploaded and shared right away without
+ * showing anything. The file goes through ImageCache::Load() on a worker;
+ * Update() on the main thread moves finished pixels into their textures
+ * and uploads them, stopping once the frame's byte budget is spent:
+ *
+ * @code
+ *   Load() --> [requests] --worker: ImageCache::Load()--> [decoded]
+ *                                                            |
+ *   Update(budget) <-----------------------------------------+
+ *     ReleaseTexture(placeholder), AdoptPixels(), UploadTexture(), callbacks
+ * @endcode
+ *
+ * @par Callbacks
+ * Code that must not use a sheet before it is ready passes a callback to
+ * Load() or OnReady(). It runs on the main thread inside Update() with
+ * @c true once the texture has its pixels, or @c false if the file could
+ * not be decoded (the placeholder stays). Callbacks still pending when the
+ * loader is cleared or destroyed are dropped without being called.
+ *
+ * @par Reloading
+ * Reload() decodes a new version of a file into a texture that keeps its
+ * current pixels until the new ones are swapped in, which is how edited
+ * sheets are hot-reloaded. Decode() hands the raw image to a callback
+ * instead, for callers that patch pixels themselves (Tilemap::PatchTileset()).
+ *
+ * @par Budget
+ * At least one texture is uploaded per Update(), so an image larger than
+ * the budget still arrives. Finish() ignores the budget and waits for
+ * every queued file.
+ *
+ * @par Thread Safety
+ * Load(), OnReady(), Update(), Finish() and Clear() are main-thread only.
+ * Workers only touch the request and result queues, never a Texture.
+ *
+ * @see SpriteSheetRegistry::SetLoader(), Texture::AdoptPixels()
+ */
+class AsyncTextureLoader
+{
+public:
+    /// @brief Pixel bytes Update() uploads per call by default.
+    static constexpr size_t DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+    /// @brief Called once the texture is ready (@c true) or failed to decode (@c false).
+    using Callback = std::function<void(bool loaded)>;
+
+    /// @brief Receives a decoded image; @p ok is false (and @p image empty) if decoding failed.
+    using DecodeCallback = std::function<void(bool ok, ImageCache::Image &image)>;
+
+    /// @brief Start @p workerCount decode threads (at least one).
+    explicit AsyncTextureLoader(unsigned workerCount = 2);
+    ~AsyncTextureLoader();
+
+    AsyncTextureLoader(const AsyncTextureLoader &) = delete;
+    AsyncTextureLoader &operator=(const AsyncTextureLoader &) = delete;
+
+    /**
+     * @brief Make @p texture a placeholder and queue @p path to fill it.
+     *
+     * @param texture Texture to fill; kept alive until the load finishes.
+     * @param path    Image file, decoded with rows flipped like Texture::LoadFromFile().
+     * @param onReady Optional completion callback.
+     */
+    void Load(std::shared_ptr<Texture> texture, std::string path, Callback onReady = {});
+
+    /**
+     * @brief Queue @p path to replace @p texture's pixels, keeping the old ones meanwhile.
+     *
+     * If the file cannot be decoded the texture is left as it was.
+     */
+    void Reload(std::shared_ptr<Texture> texture, std::string path, Callback onReady = {});
+
+    /**
+     * @brief Decode @p path on a worker and pass the pixels to @p onDecoded.
+     *
+     * The callback runs on the main thread inside Update() and counts
+     * against its budget like a texture upload.
+     *
+     * @param flipY Flip rows like Texture::LoadFromFile(); false keeps the top row first.
+     */
+    void Decode(std::string path, bool flipY, DecodeCallback onDecoded);
+
+    /**
+     * @brief Add a completion callback to a texture that is still loading.
+     * @return false if @p texture is not pending; @p onReady is not kept then.
+     */
+    bool OnReady(const Texture &texture, Callback onReady);
+
+    /// @brief True while @p texture waits for its pixels.
+    bool IsPending(const Texture &texture) const;
+
+    /**
+     * @brief Upload decoded textures, up to @p budgetBytes of pixel data.
+     *
+     * @param renderer Renderer to upload to; nullptr only fills the CPU copy
+     *                 (the next UploadTexture() creates the GPU texture).
+     * @param budgetBytes Pixel bytes to upload in this call.
+     * @return Number of loads completed (including failed ones).
+     */
+    int Update(IRenderer *renderer, size_t budgetBytes = DEFAULT_UPLOAD_BUDGET);
+
+    /// @brief Block until every queued load has completed.
+    void Finish(IRenderer *renderer);
+
+    /// @brief Drop queued loads and their callbacks; their textures stay placeholders.
+    void Clear();
+
+    /// @brief Loads queued or decoded but not yet uploaded.
+    size_t GetPendingCount() const { return m_Pending.size(); }
+
+private:
+    struct Request
+    {
+        std::uint64_t id;
+        std::string path;
+        bool flipY;
+    };
+
+    struct Decoded
+    {
+        std::uint64_t id;
+        bool ok;
+        ImageCache::Image image;
+    };
+
+    /// Main-thread side of one load
+    struct Pending
+    {
+        std::shared_ptr<Texture> texture;  ///< Null for Decode()
+        std::string path;
+        std::vector<Callback> callbacks;
+        DecodeCallback onDecoded;          ///< Set for Decode() only
+    };
+
+    /// Register @p pending and hand its file to the workers
+    void Queue(Pending pending, bool flipY);
+    void WorkerMain();
+    void Complete(IRenderer *renderer, Decoded &decoded);
+
+    std::uint64_t m_NextId = 1;
+    std::vector<std::pair<std::uint64_t, Pending>> m_Pending;  ///< In request order
+
+    /// @name Worker Threads
+    /// @{
+    std::vector<std::thread> m_Workers;
+    std::mutex m_Mutex;                  ///< Guards everything in this group
+    std::condition_variable m_WakeWorkers;
+    std::condition_variable m_Decoded;   ///< Signalled for Finish() when a result arrives
+    std::deque<Request> m_Requests;      ///< Files waiting to be decoded
+    std::deque<Decoded> m_Completed;     ///< Decoded images waiting for Update()
+    bool m_Stop = false;
+    /// @}
+};
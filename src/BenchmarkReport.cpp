@@ -0,0 +1,148 @@
+#include "BenchmarkReport.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+using json = nlohmann::ordered_json;
+
+namespace
+{
+json SummaryToJson(const BenchmarkReport::Summary &summary)
+{
+    if (summary.count == 0)
+        return nullptr;
+    return json{{"min", summary.min}, {"avg", summary.avg}, {"p99", summary.p99}, {"max", summary.max}};
+}
+
+template <typename Getter>
+double Average(const std::vector<PerfHud::FrameSample> &frames, Getter get)
+{
+    if (frames.empty())
+        return 0.0;
+    double sum = 0.0;
+    for (const PerfHud::FrameSample &frame : frames)
+        sum += static_cast<double>(get(frame));
+    return sum / static_cast<double>(frames.size());
+}
+}
+
+BenchmarkReport::Summary BenchmarkReport::Summarize(std::vector<double> values)
+{
+    Summary summary;
+    summary.count = values.size();
+    if (values.empty())
+        return summary;
+
+    std::sort(values.begin(), values.end());
+    summary.min = values.front();
+    summary.max = values.back();
+    summary.avg = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+
+    // Nearest rank: ceil(0.99 * n), 1-based
+    const auto rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(values.size())));
+    summary.p99 = values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+    return summary;
+}
+
+BenchmarkReport::Summary BenchmarkReport::GetCpuSummary() const
+{
+    std::vector<double> values;
+    values.reserve(m_Frames.size());
+    for (const PerfHud::FrameSample &frame : m_Frames)
+        values.push_back(frame.cpuMs);
+    return Summarize(std::move(values));
+}
+
+BenchmarkReport::Summary BenchmarkReport::GetGpuSummary() const
+{
+    std::vector<double> values;
+    values.reserve(m_Frames.size());
+    for (const PerfHud::FrameSample &frame : m_Frames)
+    {
+        if (frame.gpuMs > 0.0f)
+            values.push_back(frame.gpuMs);
+    }
+    return Summarize(std::move(values));
+}
+
+BenchmarkReport::Summary BenchmarkReport::GetDrawCallSummary() const
+{
+    std::vector<double> values;
+    values.reserve(m_Frames.size());
+    for (const PerfHud::FrameSample &frame : m_Frames)
+        values.push_back(frame.drawCalls);
+    return Summarize(std::move(values));
+}
+
+void BenchmarkReport::WriteJson(std::ostream &out, const RunInfo &info) const
+{
+    std::vector<double> vertices;
+    std::vector<double> arenaBytes;
+    vertices.reserve(m_Frames.size());
+    arenaBytes.reserve(m_Frames.size());
+    std::uint64_t maxAllocations = 0;
+    for (const PerfHud::FrameSample &frame : m_Frames)
+    {
+        vertices.push_back(static_cast<double>(frame.renderStats.vertices));
+        arenaBytes.push_back(static_cast<double>(frame.frameArenaBytes));
+        maxAllocations = std::max(maxAllocations, frame.allocations);
+    }
+
+    json flushes = json::object();
+    for (std::size_t r = 0; r < RenderStats::REASON_COUNT; ++r)
+    {
+        const auto reason = static_cast<RenderStats::FlushReason>(r);
+        flushes[RenderStats::GetReasonName(reason)] = Average(
+            m_Frames, [reason](const PerfHud::FrameSample &frame) { return frame.renderStats.GetFlushes(reason); });
+    }
+
+    const bool allocationsCounted = !m_Frames.empty() && m_Frames.front().allocationsCounted;
+
+    json report;
+    report["map"] = info.map;
+    report["script"] = info.script;
+    report["renderer"] = info.renderer;
+    report["resolution"] = {info.width, info.height};
+    report["hiddenWindow"] = info.hiddenWindow;
+    report["warmupFrames"] = info.warmupFrames;
+    report["frames"] = m_Frames.size();
+    report["cpuMs"] = SummaryToJson(GetCpuSummary());
+    report["gpuMs"] = SummaryToJson(GetGpuSummary());
+    report["drawCalls"] = SummaryToJson(GetDrawCallSummary());
+    report["vertices"] = SummaryToJson(Summarize(std::move(vertices)));
+    report["flushesPerFrame"] = flushes;
+    report["tiles"] = Average(m_Frames, [](const PerfHud::FrameSample &frame) { return frame.tiles; });
+    report["npcs"] = Average(m_Frames, [](const PerfHud::FrameSample &frame) { return frame.npcs; });
+    report["particles"] = Average(m_Frames, [](const PerfHud::FrameSample &frame) { return frame.particles; });
+    if (allocationsCounted)
+    {
+        report["allocationsPerFrame"] =
+            Average(m_Frames, [](const PerfHud::FrameSample &frame) { return frame.allocations; });
+        report["maxAllocationsPerFrame"] = maxAllocations;
+    }
+    else
+    {
+        report["allocationsPerFrame"] = nullptr;
+        report["maxAllocationsPerFrame"] = nullptr;
+    }
+    report["frameArenaBytes"] = SummaryToJson(Summarize(std::move(arenaBytes)));
+
+    out << report.dump(2) << '\n';
+}
+
+bool BenchmarkReport::SaveJson(const std::string &path, const RunInfo &info) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to write benchmark report: " << path << std::endl;
+        return false;
+    }
+    WriteJson(file, info);
+    return file.good();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "PerfHud.h"
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @class BenchmarkReport
+ * @brief Collects the frames of a benchmark run and writes their statistics as JSON.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Game::RunBenchmark() adds the same PerfHud::FrameSample the HUD gets
+ * for every measured frame. WriteJson() then reports, per run:
+ *
+ * | Key                    | Contents                                        |
+ * |------------------------|-------------------------------------------------|
+ * | cpuMs, gpuMs           | min, avg, p99, max frame time                   |
+ * | drawCalls, vertices    | min, avg, p99, max per frame                    |
+ * | flushesPerFrame        | average batch flushes per RenderStats reason    |
+ * | tiles, npcs, particles | average drawn per frame                         |
+ * | allocationsPerFrame    | average operator new calls                      |
+ * | maxAllocationsPerFrame | most operator new calls in one frame            |
+ * | frameArenaBytes        | min, avg, p99, max FrameArena use per frame     |
+ *
+ * gpuMs is null when the backend has no GPU timers, allocationsPerFrame
+ * and maxAllocationsPerFrame when the build has ENABLE_PROFILER off. A
+ * steady-state scene should report a maxAllocationsPerFrame of 0.
+ *
+ * p99 is the nearest-rank percentile: the smallest value that at least
+ * 99% of the frames do not exceed. GPU times lag the CPU by a few frames
+ * and frames without a result yet are left out of gpuMs.
+ *
+ * @par Thread Safety
+ * Not thread-safe.
+ *
+ * @see BenchmarkScript, PerfHud
+ */
+class BenchmarkReport
+{
+public:
+    /// @brief Order statistics of one per-frame value.
+    struct Summary
+    {
+        std::size_t count = 0;
+        double min = 0.0;
+        double avg = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /// @brief Run description copied into the report.
+    struct RunInfo
+    {
+        std::string map;
+        std::string script;
+        std::string renderer;
+        int width = 0;
+        int height = 0;
+        bool hiddenWindow = false;
+        int warmupFrames = 0;
+    };
+
+    /// @brief Drop all frames.
+    void Clear() { m_Frames.clear(); }
+
+    /// @brief Add one measured frame.
+    void AddFrame(const PerfHud::FrameSample &sample) { m_Frames.push_back(sample); }
+
+    [[nodiscard]] std::size_t GetFrameCount() const { return m_Frames.size(); }
+
+    /// @brief Statistics of @p values (all zeros when empty).
+    [[nodiscard]] static Summary Summarize(std::vector<double> values);
+
+    [[nodiscard]] Summary GetCpuSummary() const;
+
+    /// @brief GPU frame times; frames without a GPU measurement are skipped.
+    [[nodiscard]] Summary GetGpuSummary() const;
+
+    [[nodiscard]] Summary GetDrawCallSummary() const;
+
+    /// @brief Write the report as a JSON object.
+    void WriteJson(std::ostream &out, const RunInfo &info) const;
+
+    /**
+     * @brief Write the report to a file.
+     * @return false (with a message on stderr) if the file can't be written.
+     */
+    bool SaveJson(const std::string &path, const RunInfo &info) const;
+
+private:
+    std::vector<PerfHud::FrameSample> m_Frames;
+};
@@ -0,0 +1,144 @@
+#include "BenchmarkScript.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using json = nlohmann::json;
+
+bool BenchmarkScript::LoadFromFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open benchmark script: " << path << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return Parse(buffer.str(), path);
+}
+
+bool BenchmarkScript::Parse(const std::string &text, const std::string &source)
+{
+    json data;
+    try
+    {
+        data = json::parse(text, nullptr, true, true);
+    }
+    catch (const json::exception &e)
+    {
+        std::cerr << "Invalid benchmark script " << source << ": " << e.what() << std::endl;
+        return false;
+    }
+    if (!data.is_object())
+    {
+        std::cerr << "Invalid benchmark script " << source << ": expected an object" << std::endl;
+        return false;
+    }
+
+    BenchmarkScript script;
+    std::vector<Waypoint> &path = script.m_Waypoints;
+    try
+    {
+        script.m_Frames = data.value("frames", script.m_Frames);
+        script.m_WarmupFrames = data.value("warmup", script.m_WarmupFrames);
+        script.m_Step = data.value("step", script.m_Step);
+        script.m_Seed = data.value("seed", script.m_Seed);
+        script.m_TimeOfDay = data.value("timeOfDay", script.m_TimeOfDay);
+        script.m_Loop = data.value("loop", script.m_Loop);
+
+        float zoom = 1.0f;
+        for (const json &point : data.at("path"))
+        {
+            Waypoint waypoint;
+            waypoint.time = point.at("time").get<float>();
+            const json &tile = point.at("tile");
+            waypoint.tile = glm::vec2(tile.at(0).get<float>(), tile.at(1).get<float>());
+            zoom = point.value("zoom", zoom);
+            waypoint.zoom = zoom;
+            path.push_back(waypoint);
+        }
+    }
+    catch (const json::exception &e)
+    {
+        std::cerr << "Invalid benchmark script " << source << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (path.empty())
+    {
+        std::cerr << "Invalid benchmark script " << source << ": path has no waypoints" << std::endl;
+        return false;
+    }
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+        if (path[i].time < path[i - 1].time)
+        {
+            std::cerr << "Invalid benchmark script " << source << ": waypoint " << i
+                      << " is earlier than the one before it" << std::endl;
+            return false;
+        }
+    }
+    for (const Waypoint &waypoint : path)
+    {
+        if (waypoint.zoom <= 0.0f)
+        {
+            std::cerr << "Invalid benchmark script " << source << ": zoom must be positive" << std::endl;
+            return false;
+        }
+    }
+    if (script.m_Frames <= 0 || script.m_WarmupFrames < 0 || script.m_Step <= 0.0f)
+    {
+        std::cerr << "Invalid benchmark script " << source << ": frames and step must be positive" << std::endl;
+        return false;
+    }
+
+    *this = std::move(script);
+    return true;
+}
+
+BenchmarkScript::Pose BenchmarkScript::Sample(float time) const
+{
+    Pose pose;
+    if (m_Waypoints.empty())
+        return pose;
+
+    const float duration = GetDuration();
+    if (m_Loop && duration > 0.0f)
+        time = std::fmod(std::max(time, 0.0f), duration);
+
+    if (time <= m_Waypoints.front().time)
+    {
+        pose.tile = m_Waypoints.front().tile;
+        pose.zoom = m_Waypoints.front().zoom;
+        return pose;
+    }
+    if (time >= m_Waypoints.back().time)
+    {
+        pose.tile = m_Waypoints.back().tile;
+        pose.zoom = m_Waypoints.back().zoom;
+        return pose;
+    }
+
+    // First waypoint after time; the one before it starts the segment
+    auto next = std::upper_bound(m_Waypoints.begin(), m_Waypoints.end(), time,
+                                 [](float t, const Waypoint &waypoint) { return t < waypoint.time; });
+    const Waypoint &b = *next;
+    const Waypoint &a = *(next - 1);
+
+    const float span = b.time - a.time;
+    const float t = span > 0.0f ? (time - a.time) / span : 1.0f;
+    pose.tile = a.tile + (b.tile - a.tile) * t;
+    pose.zoom = a.zoom + (b.zoom - a.zoom) * t;
+
+    const glm::vec2 delta = b.tile - a.tile;
+    const float length = glm::length(delta);
+    if (length > 0.0f)
+        pose.direction = delta / length;
+    return pose;
+}
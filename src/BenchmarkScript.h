@@ -0,0 +1,109 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class BenchmarkScript
+ * @brief Camera and player path, seeds and run length for a benchmark run.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Loaded from the JSON file given to `wild --benchmark <map> <script>`:
+ *
+ * @code
+ * {
+ *     "frames": 1200,        // measured frames (default 600)
+ *     "warmup": 60,          // frames run before measuring (default 60)
+ *     "step": 0.0166667,     // simulated seconds per frame (default 1/60)
+ *     "seed": 1,             // particle and NPC RNG seed (default 1)
+ *     "timeOfDay": 21.5,     // frozen clock in hours (default 12)
+ *     "loop": true,          // restart the path when it ends (default false)
+ *     "path": [
+ *         { "time": 0,  "tile": [20, 20], "zoom": 1.0 },
+ *         { "time": 10, "tile": [80, 20] },
+ *         { "time": 20, "tile": [80, 70], "zoom": 0.5 }
+ *     ]
+ * }
+ * @endcode
+ *
+ * Waypoints give the player's tile (as in PlayerCharacter::SetTilePosition(),
+ * fractions allowed) at a path time in seconds; the camera centers on the
+ * player. A waypoint without "zoom" keeps the previous one's. Path time
+ * advances by "step" each frame, so the same script shows the same frames
+ * on any machine.
+ *
+ * @par Thread Safety
+ * Immutable after loading; Sample() is safe from any thread.
+ *
+ * @see BenchmarkReport
+ */
+class BenchmarkScript
+{
+public:
+    /// @brief One point of the path.
+    struct Waypoint
+    {
+        float time = 0.0f;        ///< Path time in seconds, ascending
+        glm::vec2 tile{0.0f};     ///< Player tile
+        float zoom = 1.0f;        ///< Camera zoom multiplier
+    };
+
+    /// @brief Interpolated path state at one point in time.
+    struct Pose
+    {
+        glm::vec2 tile{0.0f};          ///< Player tile
+        float zoom = 1.0f;             ///< Camera zoom multiplier
+        glm::vec2 direction{0.0f};     ///< Unit heading along the path, zero when standing
+    };
+
+    /**
+     * @brief Read and parse a script file.
+     * @param path JSON file.
+     * @return false (with a message on stderr) if it is missing or invalid.
+     */
+    bool LoadFromFile(const std::string &path);
+
+    /**
+     * @brief Parse a script from JSON text.
+     * @param text   JSON document.
+     * @param source Name used in error messages.
+     * @return false (with a message on stderr) if the script is invalid.
+     */
+    bool Parse(const std::string &text, const std::string &source = "script");
+
+    /**
+     * @brief Path state at @p time.
+     *
+     * Linear between waypoints. Before the first waypoint the first one is
+     * held; past the last one the path restarts with "loop" and holds the
+     * last waypoint otherwise.
+     */
+    [[nodiscard]] Pose Sample(float time) const;
+
+    [[nodiscard]] int GetFrames() const { return m_Frames; }
+    [[nodiscard]] int GetWarmupFrames() const { return m_WarmupFrames; }
+    [[nodiscard]] float GetStep() const { return m_Step; }
+    [[nodiscard]] std::uint32_t GetSeed() const { return m_Seed; }
+    [[nodiscard]] float GetTimeOfDay() const { return m_TimeOfDay; }
+    [[nodiscard]] bool IsLooping() const { return m_Loop; }
+    [[nodiscard]] const std::vector<Waypoint> &GetWaypoints() const { return m_Waypoints; }
+
+    /// @brief Time of the last waypoint in seconds.
+    [[nodiscard]] float GetDuration() const { return m_Waypoints.empty() ? 0.0f : m_Waypoints.back().time; }
+
+    /// @brief Override the measured frame count (--frames).
+    void SetFrames(int frames) { m_Frames = frames; }
+
+private:
+    int m_Frames = 600;
+    int m_WarmupFrames = 60;
+    float m_Step = 1.0f / 60.0f;
+    std::uint32_t m_Seed = 1;
+    float m_TimeOfDay = 12.0f;
+    bool m_Loop = false;
+    std::vector<Waypoint> m_Waypoints;
+};
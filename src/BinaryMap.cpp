@@ -0,0 +1,162 @@
+#include "BinaryMap.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static uint64_t AlignUp(uint64_t value)
+{
+    return (value + BINARY_MAP_ALIGNMENT - 1) & ~static_cast<uint64_t>(BINARY_MAP_ALIGNMENT - 1);
+}
+
+bool BinaryMapView::Open(const std::string &path)
+{
+    Close();
+
+    if (!m_File.Open(path))
+    {
+        std::cerr << "ERROR: Could not open file for reading: " << path << std::endl;
+        return false;
+    }
+
+    const uint8_t *data = m_File.GetData();
+    const size_t size = m_File.GetSize();
+    if (size < sizeof(BinaryMapHeader))
+    {
+        std::cerr << "ERROR: Binary map too small: " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const BinaryMapHeader *>(data);
+    if (header->magic != BINARY_MAP_MAGIC)
+    {
+        std::cerr << "ERROR: Not a binary map: " << path << std::endl;
+        Close();
+        return false;
+    }
+    if (header->version != BINARY_MAP_VERSION)
+    {
+        std::cerr << "ERROR: Unsupported binary map version " << header->version << " in " << path
+                  << " (expected " << BINARY_MAP_VERSION << ")" << std::endl;
+        Close();
+        return false;
+    }
+    if (header->width <= 0 || header->height <= 0 || header->width > BINARY_MAP_MAX_DIMENSION ||
+        header->height > BINARY_MAP_MAX_DIMENSION || header->tileWidth <= 0 || header->tileHeight <= 0)
+    {
+        std::cerr << "ERROR: Invalid map dimensions in " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    const uint64_t tableEnd = sizeof(BinaryMapHeader) + uint64_t(header->sectionCount) * sizeof(BinaryMapSection);
+    if (tableEnd > size)
+    {
+        std::cerr << "ERROR: Truncated section table in " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    // Check every bound once so accessors can hand out spans without checks
+    auto sections = std::span<const BinaryMapSection>(
+        reinterpret_cast<const BinaryMapSection *>(data + sizeof(BinaryMapHeader)), header->sectionCount);
+    for (const BinaryMapSection &section : sections)
+    {
+        if (section.offset % BINARY_MAP_ALIGNMENT != 0 || section.offset < tableEnd ||
+            section.size > size || section.offset > size - section.size)
+        {
+            std::cerr << "ERROR: Section " << static_cast<uint32_t>(section.type) << " out of bounds in "
+                      << path << std::endl;
+            Close();
+            return false;
+        }
+    }
+
+    m_Header = header;
+    m_Sections = sections;
+    return true;
+}
+
+void BinaryMapView::Close()
+{
+    m_File.Close();
+    m_Header = nullptr;
+    m_Sections = {};
+}
+
+std::string_view BinaryMapView::GetString(uint32_t offset, uint32_t length) const
+{
+    auto strings = GetSection<char>(BinaryMapSectionType::Strings);
+    if (uint64_t(offset) + length > strings.size())
+        return {};
+    return {strings.data() + offset, length};
+}
+
+const BinaryMapSection *BinaryMapView::FindSection(BinaryMapSectionType type, uint32_t index) const
+{
+    for (const BinaryMapSection &section : m_Sections)
+    {
+        if (section.type == type && section.index == index)
+            return &section;
+    }
+    return nullptr;
+}
+
+void BinaryMapWriter::AddBytes(BinaryMapSectionType type, uint32_t index, const void *data, size_t size)
+{
+    PendingSection section{type, index, std::vector<uint8_t>(size)};
+    if (size > 0)
+        std::memcpy(section.bytes.data(), data, size);
+    m_Sections.push_back(std::move(section));
+}
+
+uint32_t BinaryMapWriter::AddString(std::string_view text)
+{
+    const auto offset = static_cast<uint32_t>(m_Strings.size());
+    m_Strings.append(text);
+    return offset;
+}
+
+bool BinaryMapWriter::Write(const std::string &path, BinaryMapHeader header) const
+{
+    std::vector<const PendingSection *> sections;
+    for (const PendingSection &section : m_Sections)
+        sections.push_back(&section);
+    PendingSection strings{BinaryMapSectionType::Strings, 0,
+                           std::vector<uint8_t>(m_Strings.begin(), m_Strings.end())};
+    sections.push_back(&strings);
+
+    header.magic = BINARY_MAP_MAGIC;
+    header.version = BINARY_MAP_VERSION;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+
+    std::vector<BinaryMapSection> table;
+    uint64_t offset = AlignUp(sizeof(BinaryMapHeader) + sections.size() * sizeof(BinaryMapSection));
+    for (const PendingSection *section : sections)
+    {
+        table.push_back({section->type, section->index, offset, section->bytes.size()});
+        offset = AlignUp(offset + section->bytes.size());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR: Could not open file for writing: " << path << std::endl;
+        return false;
+    }
+
+    static const char padding[BINARY_MAP_ALIGNMENT] = {};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(table.data()),
+               static_cast<std::streamsize>(table.size() * sizeof(BinaryMapSection)));
+    uint64_t written = sizeof(header) + table.size() * sizeof(BinaryMapSection);
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        file.write(padding, static_cast<std::streamsize>(table[i].offset - written));
+        file.write(reinterpret_cast<const char *>(sections[i]->bytes.data()),
+                   static_cast<std::streamsize>(sections[i]->bytes.size()));
+        written = table[i].offset + sections[i]->bytes.size();
+    }
+    return file.good();
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static_assert(std::endian::native == std::endian::little, "Binary maps are stored little-endian");
+
+/**
+ * @name Binary Map Format
+ * @brief On-disk structures of `.wmap` files (see BinaryMapView).
+ * @ingroup World
+ *
+ * A file is a BinaryMapHeader, a table of BinaryMapSection entries and the
+ * section payloads, each starting on a BINARY_MAP_ALIGNMENT boundary. All
+ * payloads are plain arrays of the records below, so a mapped file can be
+ * read in place without parsing.
+ *
+ * | Section            | Index  | Payload                                          |
+ * |--------------------|--------|--------------------------------------------------|
+ * | Layers             | 0      | BinaryMapLayer per tile layer                    |
+ * | LayerChunkIndex    | layer  | uint32 chunk index per stored cell chunk         |
+ * | LayerChunkCells    | layer  | 1024 PackedTile bits per stored chunk            |
+ * | StructureChunkIndex| layer  | uint32 chunk index per stored structure chunk    |
+ * | StructureChunkIds  | layer  | 1024 int32 structure IDs per stored chunk        |
+ * | Collision          | 0      | uint64 bit words, row-major                      |
+ * | Navigation         | 0      | uint64 bit words, row-major                      |
+ * | CornerCutBlocked   | 0      | uint8 mask per tile                              |
+ * | Elevation          | 0      | int32 per tile                                   |
+ * | ParticleZones      | 0      | BinaryMapZone per zone                           |
+ * | Structures         | 0      | BinaryMapStructure per no-projection structure   |
+ * | Animations         | 0      | BinaryMapAnimation per animated tile definition  |
+ * | AnimationFrames    | 0      | int32 tile IDs referenced by Animations          |
+ * | Npcs               | 0      | UTF-8 JSON array, same objects as save.json      |
+ * | Strings            | 0      | UTF-8 bytes referenced by name offsets           |
+ *
+ * Chunks use the ChunkedGrid layout (32x32 cells, row-major, chunk index
+ * `chunkY * chunksX + chunkX`); only non-empty chunks are stored.
+ * @{
+ */
+
+/// @brief File magic, "WMAP".
+inline constexpr uint32_t BINARY_MAP_MAGIC = 0x50414D57u;
+
+/// @brief Current format version; readers reject other versions.
+inline constexpr uint32_t BINARY_MAP_VERSION = 1;
+
+/// @brief Payload alignment in bytes.
+inline constexpr uint32_t BINARY_MAP_ALIGNMENT = 16;
+
+/// @brief Cells per stored chunk.
+inline constexpr uint32_t BINARY_MAP_CHUNK_CELLS = 32 * 32;
+
+/// @brief Largest accepted width or height in tiles; loading allocates dense per-tile arrays.
+inline constexpr int32_t BINARY_MAP_MAX_DIMENSION = 16384;
+
+enum class BinaryMapSectionType : uint32_t
+{
+    Layers = 1,
+    LayerChunkIndex,
+    LayerChunkCells,
+    StructureChunkIndex,
+    StructureChunkIds,
+    Collision,
+    Navigation,
+    CornerCutBlocked,
+    Elevation,
+    ParticleZones,
+    Structures,
+    Animations,
+    AnimationFrames,
+    Npcs,
+    Strings
+};
+
+struct BinaryMapHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sectionCount;
+    int32_t width;
+    int32_t height;
+    int32_t tileWidth;
+    int32_t tileHeight;
+    int32_t playerTileX;    ///< -1 if no spawn was saved
+    int32_t playerTileY;
+    int32_t characterType;  ///< -1 if not saved
+    uint32_t reserved[2];
+};
+
+struct BinaryMapSection
+{
+    BinaryMapSectionType type;
+    uint32_t index;   ///< Layer index for per-layer sections, else 0
+    uint64_t offset;  ///< From the start of the file
+    uint64_t size;    ///< Payload bytes
+};
+
+struct BinaryMapLayer
+{
+    uint32_t nameOffset;  ///< Into the Strings section
+    uint32_t nameLength;
+    int32_t renderOrder;
+    uint32_t isBackground;
+};
+
+struct BinaryMapZone
+{
+    float x, y, width, height;
+    uint32_t type;
+    uint8_t enabled;
+    uint8_t noProjection;
+    uint8_t padding[2];
+};
+
+struct BinaryMapStructure
+{
+    int32_t id;
+    float leftX, leftY, rightX, rightY;
+    uint32_t nameOffset;  ///< Into the Strings section
+    uint32_t nameLength;
+};
+
+struct BinaryMapAnimation
+{
+    float frameDuration;
+    uint32_t firstFrame;  ///< Into the AnimationFrames section
+    uint32_t frameCount;
+};
+
+static_assert(sizeof(BinaryMapHeader) == 48);
+static_assert(sizeof(BinaryMapSection) == 24);
+static_assert(sizeof(BinaryMapLayer) == 16);
+static_assert(sizeof(BinaryMapZone) == 24);
+static_assert(sizeof(BinaryMapStructure) == 28);
+static_assert(sizeof(BinaryMapAnimation) == 12);
+
+/// @}
+
+/**
+ * @class BinaryMapView
+ * @brief Zero-copy, validated read access to a mapped `.wmap` file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * Open() maps the file and checks the header and every section bound once;
+ * afterwards all accessors return spans straight into the mapping. Nothing
+ * is decoded or allocated, so tools can inspect huge maps cheaply and
+ * Tilemap::LoadMapFromBinary() only copies the chunks it keeps.
+ *
+ * @par Example
+ * @code{.cpp}
+ * BinaryMapView view;
+ * if (view.Open("save.wmap"))
+ * {
+ *     auto cells = view.GetSection<uint32_t>(BinaryMapSectionType::LayerChunkCells, 0);
+ * }
+ * @endcode
+ *
+ * @see Tilemap::SaveMapToBinary(), BinaryMapWriter
+ */
+class BinaryMapView
+{
+public:
+    /**
+     * @brief Map and validate a binary map file.
+     *
+     * Rejects files with the wrong magic or version, map or tile sizes that
+     * are not positive, maps wider or taller than BINARY_MAP_MAX_DIMENSION,
+     * and section tables or payloads that are truncated, misaligned or run
+     * past the end of the file.
+     *
+     * @return `true` if the file is a well-formed map of a supported version.
+     */
+    bool Open(const std::string &path);
+
+    /// @brief Release the mapping; spans obtained earlier become invalid.
+    void Close();
+
+    /// @brief Header of the open file.
+    const BinaryMapHeader &GetHeader() const { return *m_Header; }
+
+    /**
+     * @brief Payload of a section as an array of @p T.
+     *
+     * @return Empty span if the section is absent.
+     */
+    template<typename T>
+    std::span<const T> GetSection(BinaryMapSectionType type, uint32_t index = 0) const
+    {
+        const BinaryMapSection *section = FindSection(type, index);
+        if (!section)
+            return {};
+        return {reinterpret_cast<const T *>(m_File.GetData() + section->offset),
+                static_cast<size_t>(section->size / sizeof(T))};
+    }
+
+    /// @brief Text from the Strings section (empty if out of range).
+    std::string_view GetString(uint32_t offset, uint32_t length) const;
+
+private:
+    const BinaryMapSection *FindSection(BinaryMapSectionType type, uint32_t index) const;
+
+    MappedFile m_File;
+    const BinaryMapHeader *m_Header = nullptr;
+    std::span<const BinaryMapSection> m_Sections;
+};
+
+/**
+ * @class BinaryMapWriter
+ * @brief Collects sections in memory and writes them as one `.wmap` file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ */
+class BinaryMapWriter
+{
+public:
+    /// @brief Append a section holding a copy of @p data.
+    template<typename T>
+    void AddSection(BinaryMapSectionType type, uint32_t index, std::span<const T> data)
+    {
+        AddBytes(type, index, data.data(), data.size_bytes());
+    }
+
+    /// @brief Append a section holding a copy of @p size bytes at @p data.
+    void AddBytes(BinaryMapSectionType type, uint32_t index, const void *data, size_t size);
+
+    /// @brief Store @p text in the Strings section and return its offset.
+    uint32_t AddString(std::string_view text);
+
+    /**
+     * @brief Write the header, section table and payloads.
+     *
+     * The Strings section is appended automatically. The header's magic,
+     * version and sectionCount are filled in.
+     */
+    bool Write(const std::string &path, BinaryMapHeader header) const;
+
+private:
+    struct PendingSection
+    {
+        BinaryMapSectionType type;
+        uint32_t index;
+        std::vector<uint8_t> bytes;
+    };
+
+    std::vector<PendingSection> m_Sections;
+    std::string m_Strings;
+};
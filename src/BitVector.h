@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+/**
+ * @class BitVector
+ * @brief Flat bit container backed by 64-bit words, with word-wise range queries.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * Drop-in storage for CollisionMap and NavigationMap. Element access works
+ * like `std::vector<bool>` (a proxy reference per bit), so BitVector
+ * satisfies RandomAccessContainerOf<BitVector<bool>, bool>. Unlike
+ * `std::vector<bool>`, the word array is exposed, which is what makes the
+ * range queries below run 64 cells per step instead of one.
+ *
+ * @tparam T Element type, must be `bool` (kept as a parameter so the class
+ *           fits the maps' `template<typename...> class Container` slot).
+ *
+ * @par Bit Order
+ * Bit `i` lives in word `i / 64` at bit position `i % 64`. This matches the
+ * Collision and Navigation sections of binary maps, so Words() can be
+ * written and read back without repacking.
+ *
+ * @par Range Queries
+ * | Method          | Cost for n bits          |
+ * |-----------------|--------------------------|
+ * | AnyInRange()    | n / 64 word tests        |
+ * | CountInRange()  | n / 64 popcounts         |
+ * | ForEachSet()    | one step per zero word or set bit |
+ * | ForEachSetInRange() | same, limited to the range |
+ *
+ * @par Invariant
+ * Bits at and past size() in the last word are always zero, so whole-word
+ * popcounts never need masking at the tail.
+ *
+ * @par Thread Safety
+ * Not thread-safe. Concurrent reads are safe; writes require synchronization.
+ *
+ * @see CollisionMap, NavigationMap
+ */
+template<typename T = bool>
+    requires std::same_as<T, bool>
+class BitVector
+{
+public:
+    using value_type = bool;
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+
+    /// @brief Bits per storage word.
+    static constexpr size_type WORD_BITS = 64;
+
+    /// @brief Proxy for one mutable bit, as returned by `operator[]`.
+    class reference
+    {
+    public:
+        constexpr reference(word_type *word, word_type mask) noexcept
+            : m_Word(word), m_Mask(mask) {}
+
+        constexpr reference &operator=(bool value) noexcept
+        {
+            if (value)
+                *m_Word |= m_Mask;
+            else
+                *m_Word &= ~m_Mask;
+            return *this;
+        }
+
+        constexpr reference &operator=(const reference &other) noexcept
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        [[nodiscard]] constexpr operator bool() const noexcept { return (*m_Word & m_Mask) != 0; }
+
+    private:
+        word_type *m_Word;
+        word_type m_Mask;
+    };
+
+    /// @brief Read-only forward iterator over the bits.
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr const_iterator() noexcept = default;
+        constexpr const_iterator(const word_type *words, size_type index) noexcept
+            : m_Words(words), m_Index(index) {}
+
+        [[nodiscard]] constexpr bool operator*() const noexcept
+        {
+            return (m_Words[m_Index / WORD_BITS] >> (m_Index % WORD_BITS)) & 1u;
+        }
+
+        constexpr const_iterator &operator++() noexcept
+        {
+            ++m_Index;
+            return *this;
+        }
+
+        constexpr const_iterator operator++(int) noexcept
+        {
+            const_iterator old = *this;
+            ++m_Index;
+            return old;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const const_iterator &other) const noexcept
+        {
+            return m_Index == other.m_Index;
+        }
+
+    private:
+        const word_type *m_Words = nullptr;
+        size_type m_Index = 0;
+    };
+
+    using iterator = const_iterator;
+
+    BitVector() = default;
+
+    /// @brief @p count bits, all set to @p value.
+    explicit BitVector(size_type count, bool value = false) { resize(count, value); }
+
+    /// @brief Number of bits.
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_Size; }
+
+    /// @brief `true` if size() is zero.
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_Size == 0; }
+
+    /**
+     * @brief Change the bit count; new bits are set to @p value.
+     *
+     * Existing bits are kept, like `std::vector<bool>::resize()`.
+     */
+    void resize(size_type count, bool value = false)
+    {
+        const size_type oldSize = m_Size;
+        m_Words.resize(WordCount(count), value ? ~word_type(0) : word_type(0));
+        m_Size = count;
+        if (value && count > oldSize && oldSize % WORD_BITS != 0)
+            m_Words[oldSize / WORD_BITS] |= ~word_type(0) << (oldSize % WORD_BITS);
+        ClearTail();
+    }
+
+    /// @brief Remove all bits.
+    void clear() noexcept
+    {
+        m_Words.clear();
+        m_Size = 0;
+    }
+
+    /// @brief Mutable bit access (no bounds check).
+    [[nodiscard]] constexpr reference operator[](size_type index) noexcept
+    {
+        return reference(&m_Words[index / WORD_BITS], word_type(1) << (index % WORD_BITS));
+    }
+
+    /// @brief Bit value (no bounds check).
+    [[nodiscard]] constexpr bool operator[](size_type index) const noexcept
+    {
+        return (m_Words[index / WORD_BITS] >> (index % WORD_BITS)) & 1u;
+    }
+
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return {m_Words.data(), 0}; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return {m_Words.data(), m_Size}; }
+
+    /// @brief Set every bit to @p value.
+    void Fill(bool value) noexcept
+    {
+        std::ranges::fill(m_Words, value ? ~word_type(0) : word_type(0));
+        ClearTail();
+    }
+
+    /// @brief Number of set bits.
+    [[nodiscard]] size_type Count() const noexcept
+    {
+        size_type count = 0;
+        for (word_type word : m_Words)
+            count += static_cast<size_type>(std::popcount(word));
+        return count;
+    }
+
+    /**
+     * @brief `true` if any bit in [@p first, @p last) is set.
+     *
+     * The range is clamped to size().
+     */
+    [[nodiscard]] bool AnyInRange(size_type first, size_type last) const noexcept
+    {
+        bool any = false;
+        ForEachWordInRange(first, last, [&](word_type bits) {
+            any = bits != 0;
+            return !any;
+        });
+        return any;
+    }
+
+    /**
+     * @brief Number of set bits in [@p first, @p last).
+     *
+     * The range is clamped to size().
+     */
+    [[nodiscard]] size_type CountInRange(size_type first, size_type last) const noexcept
+    {
+        size_type count = 0;
+        ForEachWordInRange(first, last, [&](word_type bits) {
+            count += static_cast<size_type>(std::popcount(bits));
+            return true;
+        });
+        return count;
+    }
+
+    /**
+     * @brief Call @p fn(index) for every set bit, in ascending order.
+     *
+     * Zero words are skipped whole.
+     */
+    template<typename Fn>
+    void ForEachSet(Fn &&fn) const
+    {
+        for (size_type w = 0; w < m_Words.size(); ++w)
+        {
+            for (word_type bits = m_Words[w]; bits != 0; bits &= bits - 1)
+                fn(w * WORD_BITS + static_cast<size_type>(std::countr_zero(bits)));
+        }
+    }
+
+    /**
+     * @brief Call @p fn(index) for every set bit in [@p first, @p last), in ascending order.
+     *
+     * The range is clamped to size().
+     */
+    template<typename Fn>
+    void ForEachSetInRange(size_type first, size_type last, Fn &&fn) const
+    {
+        size_type base = first - first % WORD_BITS;
+        ForEachWordInRange(first, last, [&](word_type bits) {
+            for (; bits != 0; bits &= bits - 1)
+                fn(base + static_cast<size_type>(std::countr_zero(bits)));
+            base += WORD_BITS;
+            return true;
+        });
+    }
+
+    /// @brief Storage words (bit order described above).
+    [[nodiscard]] std::span<const word_type> Words() const noexcept { return m_Words; }
+
+    /**
+     * @brief Replace the contents with @p count bits taken from @p words.
+     *
+     * Missing words read as zero; extra words and bits past @p count are dropped.
+     */
+    void AssignWords(std::span<const word_type> words, size_type count)
+    {
+        m_Words.assign(WordCount(count), 0);
+        std::copy_n(words.begin(), std::min(words.size(), m_Words.size()), m_Words.begin());
+        m_Size = count;
+        ClearTail();
+    }
+
+    [[nodiscard]] bool operator==(const BitVector &other) const noexcept = default;
+
+private:
+    [[nodiscard]] static constexpr size_type WordCount(size_type bits) noexcept
+    {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    void ClearTail() noexcept
+    {
+        if (m_Size % WORD_BITS != 0)
+            m_Words.back() &= ~(~word_type(0) << (m_Size % WORD_BITS));
+    }
+
+    /// Calls @p fn(maskedWord) for each word overlapping the range; stops when it returns false.
+    template<typename Fn>
+    void ForEachWordInRange(size_type first, size_type last, Fn &&fn) const noexcept
+    {
+        last = std::min(last, m_Size);
+        if (first >= last)
+            return;
+
+        const size_type firstWord = first / WORD_BITS;
+        const size_type lastWord = (last - 1) / WORD_BITS;
+        const word_type headMask = ~word_type(0) << (first % WORD_BITS);
+        const word_type tailMask = ~word_type(0) >> (WORD_BITS - 1 - (last - 1) % WORD_BITS);
+
+        if (firstWord == lastWord)
+        {
+            fn(m_Words[firstWord] & headMask & tailMask);
+            return;
+        }
+        if (!fn(m_Words[firstWord] & headMask))
+            return;
+        for (size_type w = firstWord + 1; w < lastWord; ++w)
+        {
+            if (!fn(m_Words[w]))
+                return;
+        }
+        fn(m_Words[lastWord] & tailMask);
+    }
+
+    std::vector<word_type> m_Words;
+    size_type m_Size = 0;
+};
+
+/**
+ * @concept BitRangeQueryable
+ * @brief Containers offering BitVector's word-wise range queries.
+ *
+ * CollisionMap and NavigationMap use these when available and fall back to
+ * per-element loops for other containers.
+ */
+template<typename C>
+concept BitRangeQueryable = requires(const C &c, std::size_t i) {
+    { c.AnyInRange(i, i) } -> std::convertible_to<bool>;
+    { c.CountInRange(i, i) } -> std::convertible_to<std::size_t>;
+    { c.Count() } -> std::convertible_to<std::size_t>;
+    c.ForEachSet([](std::size_t) {});
+    c.ForEachSetInRange(i, i, [](std::size_t) {});
+};
@@ -0,0 +1,167 @@
+#include "CharacterStore.h"
+#include "GameCharacter.h"
+#include "MemoryTracker.h"
+
+namespace
+{
+/// Call @p f on every per-slot array, so adding a field cannot miss a resize
+template<typename Store, typename F>
+void ForEachArray(Store &store, F &&f)
+{
+    f(store.m_PositionX);
+    f(store.m_PositionY);
+    f(store.m_PreviousX);
+    f(store.m_PreviousY);
+    f(store.m_SimulatedX);
+    f(store.m_SimulatedY);
+    f(store.m_TileX);
+    f(store.m_TileY);
+    f(store.m_TargetTileX);
+    f(store.m_TargetTileY);
+    f(store.m_Direction);
+    f(store.m_Frame);
+    f(store.m_WalkSequenceIndex);
+    f(store.m_AnimationTime);
+    f(store.m_WaitTimer);
+    f(store.m_LookAroundTimer);
+    f(store.m_StandStillTimer);
+    f(store.m_StandStillCheckTimer);
+    f(store.m_Stopped);
+    f(store.m_StandingStill);
+    f(store.m_Speed);
+    f(store.m_ElevationOffset);
+    f(store.m_TargetElevation);
+    f(store.m_ElevationStart);
+    f(store.m_ElevationProgress);
+    f(store.m_SimLod);
+    f(store.m_DeferredSimTime);
+}
+}  // namespace
+
+CharacterStore &CharacterStore::Npcs()
+{
+    // Never destroyed: NPCs held by statics may still be released during exit
+    static CharacterStore *store = new CharacterStore();
+    return *store;
+}
+
+CharacterStore::Slot CharacterStore::Allocate(NonPlayerCharacter *owner)
+{
+    Slot slot;
+    if (!m_FreeSlots.empty())
+    {
+        slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<Slot>(m_Live.size());
+        const std::size_t count = m_Live.size() + 1;
+        ForEachArray(*this, [count](auto &array) { array.resize(count); });
+        m_Live.resize(count);
+        m_Owner.resize(count);
+    }
+    ResetRow(slot);
+    m_Live[slot] = 1;
+    m_Owner[slot] = owner;
+    return slot;
+}
+
+void CharacterStore::Release(Slot slot)
+{
+    m_Live[slot] = 0;
+    m_Owner[slot] = nullptr;
+    m_FreeSlots.push_back(slot);
+}
+
+std::size_t CharacterStore::GetMemoryBytes() const
+{
+    std::size_t bytes = MemoryTracker::CapacityBytes(m_Live, m_Owner, m_FreeSlots);
+    ForEachArray(*this, [&bytes](const auto &array) { bytes += MemoryTracker::CapacityBytes(array); });
+    return bytes;
+}
+
+void CharacterStore::ResetRow(Slot slot)
+{
+    m_PositionX[slot] = m_PositionY[slot] = 0.0f;
+    m_PreviousX[slot] = m_PreviousY[slot] = 0.0f;
+    m_SimulatedX[slot] = m_SimulatedY[slot] = 0.0f;
+    m_TileX[slot] = m_TileY[slot] = 0;
+    m_TargetTileX[slot] = m_TargetTileY[slot] = 0;
+    m_Direction[slot] = CharacterDirection::DOWN;
+    ResetAnimation(slot);
+    m_WaitTimer[slot] = 0.0f;
+    m_LookAroundTimer[slot] = 0.0f;
+    m_StandStillTimer[slot] = 0.0f;
+    m_StandStillCheckTimer[slot] = 0.0f;
+    m_Stopped[slot] = 0;
+    m_StandingStill[slot] = 0;
+    m_Speed[slot] = DEFAULT_SPEED;
+    m_ElevationOffset[slot] = m_TargetElevation[slot] = m_ElevationStart[slot] = 0.0f;
+    m_ElevationProgress[slot] = 1.0f;
+    m_SimLod[slot] = SimLod::Full;
+    m_DeferredSimTime[slot] = 0.0f;
+}
+
+void CharacterStore::AdvanceWalkAnimation(Slot slot)
+{
+    int index = m_WalkSequenceIndex[slot];
+    m_Frame[slot] = GameCharacter::StepWalkSequence(index);
+    m_WalkSequenceIndex[slot] = index;
+}
+
+void CharacterStore::SetElevationOffset(Slot slot, float offset)
+{
+    GameCharacter::BeginElevationTransition(offset, m_ElevationOffset[slot], m_TargetElevation[slot],
+                                            m_ElevationStart[slot], m_ElevationProgress[slot]);
+}
+
+void CharacterStore::UpdateElevation(Slot slot, float deltaTime)
+{
+    GameCharacter::StepElevation(deltaTime, m_ElevationOffset[slot], m_TargetElevation[slot], m_ElevationStart[slot],
+                                 m_ElevationProgress[slot]);
+}
+
+void CharacterStore::StorePreviousPositions()
+{
+    // Free rows are copied too; they are reset when handed out again
+    m_PreviousX = m_PositionX;
+    m_PreviousY = m_PositionY;
+}
+
+void CharacterStore::BeginInterpolatedRender(float alpha)
+{
+    m_SimulatedX = m_PositionX;
+    m_SimulatedY = m_PositionY;
+    const std::size_t count = m_Live.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const glm::vec2 blended = GameCharacter::Interpolate({m_PreviousX[i], m_PreviousY[i]},
+                                                             {m_PositionX[i], m_PositionY[i]}, alpha);
+        m_PositionX[i] = blended.x;
+        m_PositionY[i] = blended.y;
+    }
+}
+
+void CharacterStore::EndInterpolatedRender()
+{
+    m_PositionX = m_SimulatedX;
+    m_PositionY = m_SimulatedY;
+}
+
+void CharacterStore::StopOverlapping(glm::vec2 boxMin, glm::vec2 boxMax, float halfWidth, float height)
+{
+    const std::size_t count = m_Live.size();
+
+    // Branch-free over plain arrays so the compiler can vectorize it; free
+    // rows get a flag too, which Allocate() overwrites
+    const float *x = m_PositionX.data();
+    const float *y = m_PositionY.data();
+    std::uint8_t *stopped = m_Stopped.data();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool overlapX = (boxMin.x < x[i] + halfWidth) & (boxMax.x > x[i] - halfWidth);
+        const bool overlapY = (boxMin.y < y[i]) & (boxMax.y > y[i] - height);
+        stopped[i] = static_cast<std::uint8_t>(overlapX & overlapY);
+    }
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "IGameCharacter.h"
+#include "SimulationLod.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class NonPlayerCharacter;
+
+/**
+ * @class CharacterStore
+ * @brief Structure-of-arrays storage for the per-frame state of every NPC.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Entities
+ *
+ * A NonPlayerCharacter used to carry its position, timers and animation
+ * between several hundred bytes of route, path and profile data, so every
+ * per-frame pass pulled all of it through the cache. The hot fields now live
+ * here, one array per field, and each NPC holds only the index (slot) of its
+ * row. The NPC update, player collision, render interpolation and render
+ * list passes walk the slots and read exactly the arrays they need; the NPC
+ * object itself is only visited for cold work such as choosing the next
+ * waypoint.
+ *
+ * @par Layout
+ * | Array                          | Type               | Contents                                  |
+ * |--------------------------------|--------------------|-------------------------------------------|
+ * | PositionX/Y                    | float              | Feet anchor in world pixels               |
+ * | PreviousX/Y, SimulatedX/Y      | float              | Render interpolation (see GameCharacter)  |
+ * | TileX/Y, TargetTileX/Y         | int32_t            | Current tile and the tile walked to       |
+ * | Direction                      | CharacterDirection | Facing                                    |
+ * | Frame, WalkSequenceIndex       | int32_t            | Walk cycle                                |
+ * | AnimationTime                  | float              | Time toward the next walk frame           |
+ * | WaitTimer                      | float              | Pause after a blocked step or a goal      |
+ * | LookAroundTimer                | float              | Time to the next look-around turn         |
+ * | StandStillTimer                | float              | Remaining random pause (0 = no route)     |
+ * | StandStillCheckTimer           | float              | Time to the next random pause roll        |
+ * | Stopped, StandingStill         | uint8_t            | Held by the player; paused in place       |
+ * | Speed                          | float              | Pixels per second                         |
+ * | Elevation*                     | float              | Elevation transition (see GameCharacter)  |
+ * | SimLod, DeferredSimTime        | SimLod, float      | Level of the last step; time not yet run  |
+ *
+ * @par Slots
+ * Allocate() hands out a free slot, reusing released ones before growing
+ * the arrays, so the arrays stay about as long as the number of live NPCs.
+ * Slot order is creation order, not the order of Game's NPC vector; passes
+ * that walk the store iterate [0, GetSlotCount()) and skip rows where
+ * IsLive() is false. GetOwner() leads back to the NPC for cold work; the NPC
+ * keeps it current when it is moved.
+ *
+ * @par Thread Safety
+ * Allocate(), Release() and SetOwner() are main-thread only (NPCs are
+ * created, moved and destroyed there). Different slots may be read and
+ * written concurrently, which is what the parallel NPC update does.
+ *
+ * @see NonPlayerCharacter, Game::UpdateNPC(), ParticlePool
+ */
+class CharacterStore
+{
+public:
+    using Slot = std::uint32_t;
+
+    /// @brief Slot of an NPC that holds no row (moved from).
+    static constexpr Slot INVALID_SLOT = UINT32_MAX;
+
+    /// @brief Walking speed of a new row in pixels per second.
+    static constexpr float DEFAULT_SPEED = 25.0f;
+
+    /// @brief Store every NonPlayerCharacter keeps its row in.
+    static CharacterStore &Npcs();
+
+    /**
+     * @brief Reserve a row with the default NPC state.
+     * @param owner NPC the row belongs to (may be null in tests).
+     */
+    Slot Allocate(NonPlayerCharacter *owner = nullptr);
+
+    /// @brief Return @p slot to the free list.
+    void Release(Slot slot);
+
+    [[nodiscard]] bool IsLive(Slot slot) const { return m_Live[slot] != 0; }
+    [[nodiscard]] NonPlayerCharacter *GetOwner(Slot slot) const { return m_Owner[slot]; }
+    void SetOwner(Slot slot, NonPlayerCharacter *owner) { m_Owner[slot] = owner; }
+
+    /// @brief Rows ever allocated, live or free; iterate slots below this.
+    [[nodiscard]] std::size_t GetSlotCount() const { return m_Live.size(); }
+
+    /// @brief Rows currently allocated.
+    [[nodiscard]] std::size_t GetLiveCount() const { return m_Live.size() - m_FreeSlots.size(); }
+
+    /// @brief Heap bytes of the field arrays and the free list.
+    [[nodiscard]] std::size_t GetMemoryBytes() const;
+
+    /// @name Row Helpers
+    /// @{
+
+    [[nodiscard]] glm::vec2 GetPosition(Slot slot) const { return {m_PositionX[slot], m_PositionY[slot]}; }
+    void SetPosition(Slot slot, glm::vec2 position)
+    {
+        m_PositionX[slot] = position.x;
+        m_PositionY[slot] = position.y;
+    }
+
+    /// @brief Idle pose, as GameCharacter::ResetAnimation().
+    void ResetAnimation(Slot slot)
+    {
+        m_Frame[slot] = 0;
+        m_WalkSequenceIndex[slot] = 0;
+        m_AnimationTime[slot] = 0.0f;
+    }
+
+    /// @brief Next walk frame, as GameCharacter::AdvanceWalkAnimation().
+    void AdvanceWalkAnimation(Slot slot);
+
+    /// @brief Elevation target, as GameCharacter::SetElevationOffset().
+    void SetElevationOffset(Slot slot, float offset);
+
+    /// @brief Elevation transition step, as GameCharacter::UpdateElevation().
+    void UpdateElevation(Slot slot, float deltaTime);
+
+    /// @}
+
+    /// @name Bulk Passes
+    /// Over every live row.
+    /// @{
+
+    /// @brief Remember each position as the start of the next simulation step.
+    void StorePreviousPositions();
+
+    /// @brief Swap blended positions in for drawing; pair with EndInterpolatedRender().
+    void BeginInterpolatedRender(float alpha);
+
+    /// @brief Restore the positions saved by BeginInterpolatedRender().
+    void EndInterpolatedRender();
+
+    /**
+     * @brief Stop every NPC whose hitbox overlaps a box and release the rest.
+     *
+     * Hitboxes are anchored at the feet: @p halfWidth either side of X and
+     * @p height above Y. Edges that only touch do not overlap.
+     *
+     * @param boxMin    Top-left of the box to test.
+     * @param boxMax    Bottom-right of the box to test.
+     * @param halfWidth Half the hitbox width.
+     * @param height    Hitbox height.
+     */
+    void StopOverlapping(glm::vec2 boxMin, glm::vec2 boxMax, float halfWidth, float height);
+
+    /// @}
+
+    /// @name Field Arrays
+    /// Indexed by slot, all GetSlotCount() long. Do not resize.
+    /// @{
+
+    std::vector<float> m_PositionX;
+    std::vector<float> m_PositionY;
+    std::vector<float> m_PreviousX;
+    std::vector<float> m_PreviousY;
+    std::vector<float> m_SimulatedX;
+    std::vector<float> m_SimulatedY;
+    std::vector<std::int32_t> m_TileX;
+    std::vector<std::int32_t> m_TileY;
+    std::vector<std::int32_t> m_TargetTileX;
+    std::vector<std::int32_t> m_TargetTileY;
+    std::vector<CharacterDirection> m_Direction;
+    std::vector<std::int32_t> m_Frame;
+    std::vector<std::int32_t> m_WalkSequenceIndex;
+    std::vector<float> m_AnimationTime;
+    std::vector<float> m_WaitTimer;
+    std::vector<float> m_LookAroundTimer;
+    std::vector<float> m_StandStillTimer;
+    std::vector<float> m_StandStillCheckTimer;
+    std::vector<std::uint8_t> m_Stopped;
+    std::vector<std::uint8_t> m_StandingStill;
+    std::vector<float> m_Speed;
+    std::vector<float> m_ElevationOffset;
+    std::vector<float> m_TargetElevation;
+    std::vector<float> m_ElevationStart;
+    std::vector<float> m_ElevationProgress;
+    std::vector<SimLod> m_SimLod;
+    std::vector<float> m_DeferredSimTime;
+
+    /// @}
+
+private:
+    /// Write the default NPC state into @p slot
+    void ResetRow(Slot slot);
+
+    std::vector<std::uint8_t> m_Live;
+    std::vector<NonPlayerCharacter *> m_Owner;
+    std::vector<Slot> m_FreeSlots;
+};
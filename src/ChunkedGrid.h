@@ -0,0 +1,412 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class ChunkedGrid
+ * @brief Sparse 2D grid stored as fixed-size square chunks.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * The grid is split into CHUNK_SIZE x CHUNK_SIZE blocks that are allocated
+ * on the first write of a non-empty value and freed again when their last
+ * non-empty cell is cleared. Memory therefore follows map content instead of
+ * map bounds: an empty 2048x2048 layer costs one pointer per chunk (32 KB).
+ *
+ * @tparam T          Cell type (trivially copyable, comparable with ==).
+ * @tparam EmptyValue Value of cells in unallocated chunks.
+ *
+ * @par Memory Layout
+ * Chunks are kept in a row-major chunk grid; cells inside a chunk are
+ * row-major too, so a chunk row is one contiguous run of CHUNK_SIZE cells:
+ * @code
+ *   chunk = (y / CHUNK_SIZE) * chunksX + (x / CHUNK_SIZE)
+ *   cell  = (y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE)
+ * @endcode
+ *
+ * @par Hot Loops
+ * GetChunk() returns nullptr for empty chunks, letting loops over a tile
+ * range skip whole 32x32 blocks and read the rest without per-cell lookups.
+ *
+ * @par Bounds Handling
+ * - **Read**: Out-of-bounds returns EmptyValue
+ * - **Write**: Out-of-bounds silently ignored
+ *
+ * @par Row Spans
+ * FillSpan(), ReadSpan() and WriteSpan() work on [x0, x1) of one row and
+ * touch each chunk once, copying its part of the row in one go. Bulk edits
+ * (Tilemap::FillLayerRect()) use them instead of per-cell Set() calls.
+ *
+ * @par Thread Safety
+ * Not thread-safe. Concurrent reads are safe; writes require synchronization.
+ * The chunk table only changes size in Resize(), so writes to different
+ * chunks (e.g. bands of CHUNK_SIZE aligned rows) may run concurrently.
+ *
+ * @see TileLayer
+ */
+template<typename T, T EmptyValue = T{}>
+class ChunkedGrid
+{
+public:
+    /// @brief log2 of the chunk edge length.
+    static constexpr int CHUNK_SHIFT = 5;
+
+    /// @brief Chunk edge length in cells.
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_SHIFT;
+
+    /// @brief Cells per chunk.
+    static constexpr int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+    /// @brief Cell storage of one allocated chunk.
+    using ChunkCells = std::array<T, CHUNK_CELLS>;
+
+    ChunkedGrid() = default;
+    ~ChunkedGrid() = default;
+
+    ChunkedGrid(ChunkedGrid &&) noexcept = default;
+    ChunkedGrid &operator=(ChunkedGrid &&) noexcept = default;
+
+    /// @brief Deep copy (allocated chunks are cloned).
+    ChunkedGrid(const ChunkedGrid &other)
+        : m_Width(other.m_Width)
+        , m_Height(other.m_Height)
+        , m_ChunksX(other.m_ChunksX)
+        , m_ChunksY(other.m_ChunksY)
+        , m_Chunks(other.m_Chunks.size())
+    {
+        for (size_t i = 0; i < other.m_Chunks.size(); ++i)
+        {
+            if (other.m_Chunks[i])
+                m_Chunks[i] = std::make_unique<Chunk>(*other.m_Chunks[i]);
+        }
+    }
+
+    ChunkedGrid &operator=(const ChunkedGrid &other)
+    {
+        if (this != &other)
+            *this = ChunkedGrid(other);
+        return *this;
+    }
+
+    /**
+     * @brief Resize to new dimensions, resetting every cell to EmptyValue.
+     *
+     * @param width  New width in cells.
+     * @param height New height in cells.
+     */
+    void Resize(int width, int height)
+    {
+        m_Width = std::max(0, width);
+        m_Height = std::max(0, height);
+        m_ChunksX = (m_Width + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        m_ChunksY = (m_Height + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        m_Chunks.clear();
+        m_Chunks.resize(static_cast<size_t>(m_ChunksX) * static_cast<size_t>(m_ChunksY));
+    }
+
+    /// @brief Reset every cell to EmptyValue and free all chunks.
+    void Clear()
+    {
+        for (auto &chunk : m_Chunks)
+            chunk.reset();
+    }
+
+    /// @brief Cell value, or EmptyValue if out of bounds or never written.
+    [[nodiscard]] T Get(int x, int y) const noexcept
+    {
+        if (x < 0 || x >= m_Width || y < 0 || y >= m_Height)
+            return EmptyValue;
+        const Chunk *chunk = m_Chunks[ChunkIndex(x, y)].get();
+        return chunk ? chunk->cells[CellIndex(x, y)] : EmptyValue;
+    }
+
+    /**
+     * @brief Write a cell, allocating or freeing its chunk as needed.
+     *
+     * @param x     Column (out-of-bounds ignored).
+     * @param y     Row (out-of-bounds ignored).
+     * @param value New value.
+     */
+    void Set(int x, int y, T value)
+    {
+        if (x < 0 || x >= m_Width || y < 0 || y >= m_Height)
+            return;
+
+        std::unique_ptr<Chunk> &chunk = m_Chunks[ChunkIndex(x, y)];
+        const bool empty = (value == EmptyValue);
+        if (!chunk)
+        {
+            if (empty)
+                return;
+            chunk = std::make_unique<Chunk>();
+            chunk->cells.fill(EmptyValue);
+        }
+
+        T &cell = chunk->cells[CellIndex(x, y)];
+        const bool wasEmpty = (cell == EmptyValue);
+        cell = value;
+        if (wasEmpty && !empty)
+        {
+            ++chunk->used;
+        }
+        else if (!wasEmpty && empty && --chunk->used == 0)
+        {
+            chunk.reset();
+        }
+    }
+
+    /**
+     * @brief Set cells [@p x0, @p x1) of row @p y to @p value.
+     *
+     * Out-of-bounds cells are ignored. Chunks are allocated or freed as in Set().
+     */
+    void FillSpan(int y, int x0, int x1, T value)
+    {
+        if (y < 0 || y >= m_Height)
+            return;
+        x0 = std::max(x0, 0);
+        x1 = std::min(x1, m_Width);
+
+        const bool empty = (value == EmptyValue);
+        while (x0 < x1)
+        {
+            const int end = std::min(x1, ((x0 >> CHUNK_SHIFT) + 1) << CHUNK_SHIFT);
+            std::unique_ptr<Chunk> &chunk = m_Chunks[ChunkIndex(x0, y)];
+            if (!chunk && !empty)
+            {
+                chunk = std::make_unique<Chunk>();
+                chunk->cells.fill(EmptyValue);
+            }
+            if (chunk)
+            {
+                T *cells = &chunk->cells[CellIndex(x0, y)];
+                const auto count = static_cast<uint32_t>(end - x0);
+                const auto wasUsed = static_cast<uint32_t>(
+                    std::count_if(cells, cells + count, [](const T &cell) { return !(cell == EmptyValue); }));
+                std::fill(cells, cells + count, value);
+                chunk->used = chunk->used - wasUsed + (empty ? 0u : count);
+                if (chunk->used == 0)
+                    chunk.reset();
+            }
+            x0 = end;
+        }
+    }
+
+    /**
+     * @brief Copy cells [@p x0, @p x1) of row @p y into @p out.
+     *
+     * @p out receives x1 - x0 values; out-of-bounds cells read as EmptyValue.
+     */
+    void ReadSpan(int y, int x0, int x1, T *out) const
+    {
+        for (int x = x0; x < x1;)
+        {
+            const int end = std::min(x1, ((x >> CHUNK_SHIFT) + 1) << CHUNK_SHIFT);
+            const Chunk *chunk = (y < 0 || y >= m_Height || x < 0 || x >= m_Width)
+                                     ? nullptr
+                                     : m_Chunks[ChunkIndex(x, y)].get();
+            for (int i = x; i < end; ++i)
+                *out++ = (chunk && i < m_Width) ? chunk->cells[CellIndex(i, y)] : EmptyValue;
+            x = end;
+        }
+    }
+
+    /**
+     * @brief Write @p values into cells [@p x0, @p x1) of row @p y.
+     *
+     * @p values holds x1 - x0 cells; out-of-bounds ones are skipped.
+     */
+    void WriteSpan(int y, int x0, int x1, const T *values)
+    {
+        if (y < 0 || y >= m_Height)
+            return;
+        if (x0 < 0)
+        {
+            values += -x0;
+            x0 = 0;
+        }
+        x1 = std::min(x1, m_Width);
+
+        while (x0 < x1)
+        {
+            const int end = std::min(x1, ((x0 >> CHUNK_SHIFT) + 1) << CHUNK_SHIFT);
+            const auto count = static_cast<uint32_t>(end - x0);
+            std::unique_ptr<Chunk> &chunk = m_Chunks[ChunkIndex(x0, y)];
+            const auto used = static_cast<uint32_t>(
+                std::count_if(values, values + count, [](const T &cell) { return !(cell == EmptyValue); }));
+            if (!chunk && used != 0)
+            {
+                chunk = std::make_unique<Chunk>();
+                chunk->cells.fill(EmptyValue);
+            }
+            if (chunk)
+            {
+                T *cells = &chunk->cells[CellIndex(x0, y)];
+                const auto wasUsed = static_cast<uint32_t>(
+                    std::count_if(cells, cells + count, [](const T &cell) { return !(cell == EmptyValue); }));
+                std::copy(values, values + count, cells);
+                chunk->used = chunk->used - wasUsed + used;
+                if (chunk->used == 0)
+                    chunk.reset();
+            }
+            values += count;
+            x0 = end;
+        }
+    }
+
+    /// @brief Width in cells.
+    [[nodiscard]] int GetWidth() const noexcept { return m_Width; }
+
+    /// @brief Height in cells.
+    [[nodiscard]] int GetHeight() const noexcept { return m_Height; }
+
+    /// @brief Chunk grid width.
+    [[nodiscard]] int GetChunksX() const noexcept { return m_ChunksX; }
+
+    /// @brief Chunk grid height.
+    [[nodiscard]] int GetChunksY() const noexcept { return m_ChunksY; }
+
+    /**
+     * @brief Cells of chunk (@p chunkX, @p chunkY), or nullptr if it is empty.
+     *
+     * Index the result with `(y & (CHUNK_SIZE - 1)) * CHUNK_SIZE + (x & (CHUNK_SIZE - 1))`.
+     * Cells past the grid edge in border chunks are EmptyValue.
+     */
+    [[nodiscard]] const ChunkCells *GetChunk(int chunkX, int chunkY) const noexcept
+    {
+        if (chunkX < 0 || chunkX >= m_ChunksX || chunkY < 0 || chunkY >= m_ChunksY)
+            return nullptr;
+        const Chunk *chunk = m_Chunks[static_cast<size_t>(chunkY) * m_ChunksX + chunkX].get();
+        return chunk ? &chunk->cells : nullptr;
+    }
+
+    /**
+     * @brief Overwrite a whole chunk from CHUNK_CELLS values in GetChunk() layout.
+     *
+     * Used for bulk loads: one copy per chunk instead of per-cell Set() calls.
+     * Source cells past the grid edge are ignored; an all-empty source frees
+     * the chunk.
+     */
+    void SetChunk(int chunkX, int chunkY, const T *cells)
+    {
+        if (chunkX < 0 || chunkX >= m_ChunksX || chunkY < 0 || chunkY >= m_ChunksY)
+            return;
+
+        std::unique_ptr<Chunk> &chunk = m_Chunks[static_cast<size_t>(chunkY) * m_ChunksX + chunkX];
+        if (!chunk)
+            chunk = std::make_unique<Chunk>();
+        std::copy(cells, cells + CHUNK_CELLS, chunk->cells.begin());
+
+        // Keep border chunks clean so ForEachNonEmpty() never reports cells outside the grid
+        const int validX = std::min(CHUNK_SIZE, m_Width - (chunkX << CHUNK_SHIFT));
+        const int validY = std::min(CHUNK_SIZE, m_Height - (chunkY << CHUNK_SHIFT));
+        uint32_t used = 0;
+        for (int i = 0; i < CHUNK_CELLS; ++i)
+        {
+            T &cell = chunk->cells[i];
+            if ((i & (CHUNK_SIZE - 1)) >= validX || (i >> CHUNK_SHIFT) >= validY)
+                cell = EmptyValue;
+            else if (!(cell == EmptyValue))
+                ++used;
+        }
+
+        chunk->used = used;
+        if (used == 0)
+            chunk.reset();
+    }
+
+    /**
+     * @brief Call @p fn(x, y, value) for every non-empty cell.
+     *
+     * Visits chunks in row-major order, cells row-major within each chunk.
+     */
+    template<typename Fn>
+    void ForEachNonEmpty(Fn &&fn) const
+    {
+        for (int cy = 0; cy < m_ChunksY; ++cy)
+        {
+            for (int cx = 0; cx < m_ChunksX; ++cx)
+            {
+                const Chunk *chunk = m_Chunks[static_cast<size_t>(cy) * m_ChunksX + cx].get();
+                if (!chunk)
+                    continue;
+                for (int i = 0; i < CHUNK_CELLS; ++i)
+                {
+                    if (!(chunk->cells[i] == EmptyValue))
+                    {
+                        fn((cx << CHUNK_SHIFT) + (i & (CHUNK_SIZE - 1)),
+                           (cy << CHUNK_SHIFT) + (i >> CHUNK_SHIFT),
+                           chunk->cells[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Apply @p fn(value) -> T to every non-empty cell in place.
+     *
+     * Cells @p fn maps to EmptyValue are released like in Set().
+     */
+    template<typename Fn>
+    void TransformNonEmpty(Fn &&fn)
+    {
+        for (auto &chunk : m_Chunks)
+        {
+            if (!chunk)
+                continue;
+            for (T &cell : chunk->cells)
+            {
+                if (cell == EmptyValue)
+                    continue;
+                cell = fn(cell);
+                if (cell == EmptyValue)
+                    --chunk->used;
+            }
+            if (chunk->used == 0)
+                chunk.reset();
+        }
+    }
+
+    /// @brief Chunks currently holding at least one non-empty cell.
+    [[nodiscard]] size_t GetAllocatedChunkCount() const noexcept
+    {
+        return static_cast<size_t>(std::count_if(m_Chunks.begin(), m_Chunks.end(),
+                                                 [](const auto &chunk) { return chunk != nullptr; }));
+    }
+
+    /// @brief Heap bytes used by the chunk table and allocated chunks.
+    [[nodiscard]] size_t GetMemoryBytes() const noexcept
+    {
+        return m_Chunks.capacity() * sizeof(std::unique_ptr<Chunk>) + GetAllocatedChunkCount() * sizeof(Chunk);
+    }
+
+private:
+    struct Chunk
+    {
+        ChunkCells cells;
+        uint32_t used = 0;  ///< Non-empty cells; the chunk is freed at zero.
+    };
+
+    [[nodiscard]] size_t ChunkIndex(int x, int y) const noexcept
+    {
+        return static_cast<size_t>(y >> CHUNK_SHIFT) * static_cast<size_t>(m_ChunksX) +
+               static_cast<size_t>(x >> CHUNK_SHIFT);
+    }
+
+    [[nodiscard]] static size_t CellIndex(int x, int y) noexcept
+    {
+        return static_cast<size_t>(((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1)));
+    }
+
+    int m_Width = 0;
+    int m_Height = 0;
+    int m_ChunksX = 0;
+    int m_ChunksY = 0;
+    std::vector<std::unique_ptr<Chunk>> m_Chunks;  ///< Row-major chunk grid, nullptr = all EmptyValue.
+};
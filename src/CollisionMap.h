@@ -1,5 +1,6 @@
 #pragma once
 
+#include "BitVector.h"
 #include "ColumnProxy.h"
 
 #include <algorithm>
@@ -31,7 +32,8 @@
  * @par Storage Options
  * | Container        | Memory      | Access Speed | Notes                    |
  * |------------------|-------------|--------------|--------------------------|
- * | `std::vector`    | Bit-packed  | Good         | Default, mem efficient   |
+ * | `BitVector`      | Bit-packed  | Best         | Word-wise rect queries   |
+ * | `std::vector`    | Bit-packed  | Good         | Generic, per-bit access  |
  * | `std::deque`     | Chunked     | Good         | Better for huge maps     |
  *
  * @par Memory Layout
@@ -144,9 +146,17 @@ public:
     [[nodiscard]] std::vector<int> GetCollisionIndices() const
     {
         std::vector<int> indices;
-        indices.reserve(m_Collision.size());
-        for (auto [i, val] : std::views::enumerate(m_Collision))
-            if (val) indices.push_back(static_cast<int>(i));
+        if constexpr (BitRangeQueryable<container_type>)
+        {
+            indices.reserve(m_Collision.Count());
+            m_Collision.ForEachSet([&](std::size_t i) { indices.push_back(static_cast<int>(i)); });
+        }
+        else
+        {
+            indices.reserve(m_Collision.size());
+            for (auto [i, val] : std::views::enumerate(m_Collision))
+                if (val) indices.push_back(static_cast<int>(i));
+        }
         return indices;
     }
 
@@ -155,7 +165,10 @@ public:
      */
     void Clear()
     {
-        std::ranges::fill(m_Collision, false);
+        if constexpr (BitRangeQueryable<container_type>)
+            m_Collision.Fill(false);
+        else
+            std::ranges::fill(m_Collision, false);
     }
 
     /// @brief Get width in tiles.
@@ -170,7 +183,70 @@ public:
      */
     [[nodiscard]] int GetCollisionCount() const
     {
-        return static_cast<int>(std::ranges::count(m_Collision, true));
+        if constexpr (BitRangeQueryable<container_type>)
+            return static_cast<int>(m_Collision.Count());
+        else
+            return static_cast<int>(std::ranges::count(m_Collision, true));
+    }
+
+    /**
+     * @brief Query if any tile in a rectangle is blocking.
+     *
+     * Bounds are inclusive and clamped to the map; tiles outside it count as
+     * passable, like HasCollision(). With a BitVector each row costs one masked
+     * word test per 64 tiles.
+     *
+     * @param x0 First column.
+     * @param y0 First row.
+     * @param x1 Last column.
+     * @param y1 Last row.
+     * @return `true` if at least one tile in the rectangle is blocking.
+     */
+    [[nodiscard]] bool AnyCollisionInRect(int x0, int y0, int x1, int y1) const
+    {
+        bool any = false;
+        ForEachRowRange(x0, y0, x1, y1, [&](std::size_t first, std::size_t last) {
+            if constexpr (BitRangeQueryable<container_type>)
+            {
+                any = m_Collision.AnyInRange(first, last);
+            }
+            else
+            {
+                for (std::size_t i = first; i < last && !any; ++i)
+                    any = static_cast<bool>(m_Collision[i]);
+            }
+            return !any;
+        });
+        return any;
+    }
+
+    /**
+     * @brief Count blocking tiles in a rectangle.
+     *
+     * Same bounds handling as AnyCollisionInRect(); uses popcount per word with a BitVector.
+     *
+     * @param x0 First column.
+     * @param y0 First row.
+     * @param x1 Last column.
+     * @param y1 Last row.
+     * @return Number of blocking tiles inside the clamped rectangle.
+     */
+    [[nodiscard]] int CountCollisionsInRect(int x0, int y0, int x1, int y1) const
+    {
+        std::size_t count = 0;
+        ForEachRowRange(x0, y0, x1, y1, [&](std::size_t first, std::size_t last) {
+            if constexpr (BitRangeQueryable<container_type>)
+            {
+                count += m_Collision.CountInRange(first, last);
+            }
+            else
+            {
+                for (std::size_t i = first; i < last; ++i)
+                    count += static_cast<bool>(m_Collision[i]) ? 1 : 0;
+            }
+            return true;
+        });
+        return static_cast<int>(count);
     }
 
     /// @brief Get read-only access to underlying data.
@@ -206,7 +282,51 @@ public:
         return CollisionColumn(&m_Collision, &m_Width, &m_Height, x);
     }
 
+    /**
+     * @brief Call @p fn(x, y) for every blocking tile in a rectangle, row by row.
+     *
+     * Same bounds handling as the rectangle queries above. With a BitVector
+     * empty stretches are skipped a word at a time, which keeps overlays of
+     * mostly open maps cheap.
+     */
+    template<typename Fn>
+    void ForEachCollisionInRect(int x0, int y0, int x1, int y1, Fn&& fn) const
+    {
+        const auto width = static_cast<std::size_t>(m_Width);
+        ForEachRowRange(x0, y0, x1, y1, [&](std::size_t first, std::size_t last) {
+            auto visit = [&](std::size_t i) { fn(static_cast<int>(i % width), static_cast<int>(i / width)); };
+            if constexpr (BitRangeQueryable<container_type>)
+            {
+                m_Collision.ForEachSetInRange(first, last, visit);
+            }
+            else
+            {
+                for (std::size_t i = first; i < last; ++i)
+                    if (static_cast<bool>(m_Collision[i])) visit(i);
+            }
+            return true;
+        });
+    }
+
 private:
+    /// Calls @p fn(first, last) with the flat index range of each clamped row; stops when it returns false.
+    template<typename Fn>
+    void ForEachRowRange(int x0, int y0, int x1, int y1, Fn&& fn) const
+    {
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, m_Width - 1);
+        y1 = std::min(y1, m_Height - 1);
+        if (x0 > x1)
+            return;
+        for (int y = y0; y <= y1; ++y)
+        {
+            const std::size_t row = static_cast<std::size_t>(y) * static_cast<std::size_t>(m_Width);
+            if (!fn(row + static_cast<std::size_t>(x0), row + static_cast<std::size_t>(x1) + 1))
+                return;
+        }
+    }
+
     container_type m_Collision{};
     int m_Width{0};
     int m_Height{0};
@@ -0,0 +1,164 @@
+#include "CollisionSweep.h"
+#include "Tilemap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+/// Per-tilemap state shared by every sweep of a batch.
+struct SweepGrid
+{
+    const CollisionMap<BitVector> &collision;
+    float tileW;
+    float tileH;
+};
+}  // namespace
+
+/// Entry/exit times of [boxMin, boxMax] moving by d against [tileMin, tileMax] on one axis.
+static bool AxisTimes(float boxMin, float boxMax, float d, float tileMin, float tileMax, float &entry, float &exit)
+{
+    if (d > 0.0f)
+    {
+        entry = (tileMin - boxMax) / d;
+        exit = (tileMax - boxMin) / d;
+    }
+    else if (d < 0.0f)
+    {
+        entry = (tileMax - boxMin) / d;
+        exit = (tileMin - boxMax) / d;
+    }
+    else
+    {
+        // Not moving on this axis: either always overlapping or never
+        if (boxMin >= tileMax || boxMax <= tileMin)
+            return false;
+        entry = -std::numeric_limits<float>::infinity();
+        exit = std::numeric_limits<float>::infinity();
+    }
+    return true;
+}
+
+static SweepContact SweepAgainstGrid(const SweepGrid &grid, const Tilemap &tilemap, const SweepBox &box,
+                                     glm::vec2 delta)
+{
+    SweepContact contact;
+    if (grid.tileW <= 0.0f || grid.tileH <= 0.0f)
+        return contact;
+
+    // Broadphase: tiles touched anywhere along the move
+    const glm::vec2 lo = glm::min(box.min, box.min + delta);
+    const glm::vec2 hi = glm::max(box.max, box.max + delta);
+    const int x0 = static_cast<int>(std::floor(lo.x / grid.tileW));
+    const int y0 = static_cast<int>(std::floor(lo.y / grid.tileH));
+    const int x1 = static_cast<int>(std::ceil(hi.x / grid.tileW)) - 1;
+    const int y1 = static_cast<int>(std::ceil(hi.y / grid.tileH)) - 1;
+    if (!grid.collision.AnyCollisionInRect(x0, y0, x1, y1))
+        return contact;
+
+    auto blocked = [&](int x, int y) { return grid.collision.HasCollision(x, y); };
+
+    float bestTime = std::numeric_limits<float>::infinity();
+    grid.collision.ForEachCollisionInRect(x0, y0, x1, y1, [&](int tx, int ty)
+    {
+        if (contact.startSolid)
+            return;
+
+        const float tMinX = tx * grid.tileW, tMaxX = tMinX + grid.tileW;
+        const float tMinY = ty * grid.tileH, tMaxY = tMinY + grid.tileH;
+
+        // Already overlapping: report the shallowest exit through an open face
+        if (box.min.x < tMaxX && box.max.x > tMinX && box.min.y < tMaxY && box.max.y > tMinY)
+        {
+            const struct { float depth; glm::vec2 normal; bool open; } exits[4] = {
+                {box.max.x - tMinX, {-1.0f, 0.0f}, !blocked(tx - 1, ty)},
+                {tMaxX - box.min.x, {1.0f, 0.0f}, !blocked(tx + 1, ty)},
+                {box.max.y - tMinY, {0.0f, -1.0f}, !blocked(tx, ty - 1)},
+                {tMaxY - box.min.y, {0.0f, 1.0f}, !blocked(tx, ty + 1)},
+            };
+            float bestDepth = std::numeric_limits<float>::infinity();
+            for (const auto &e : exits)
+            {
+                if (e.open && e.depth < bestDepth)
+                {
+                    bestDepth = e.depth;
+                    contact.normal = e.normal;
+                }
+            }
+            contact.hit = true;
+            contact.startSolid = true;
+            contact.corner = false;
+            contact.time = 0.0f;
+            contact.tileX = tx;
+            contact.tileY = ty;
+            return;
+        }
+
+        float entryX, exitX, entryY, exitY;
+        if (!AxisTimes(box.min.x, box.max.x, delta.x, tMinX, tMaxX, entryX, exitX) ||
+            !AxisTimes(box.min.y, box.max.y, delta.y, tMinY, tMaxY, entryY, exitY))
+            return;
+
+        const float entry = std::max(entryX, entryY);
+        const float exit = std::min(exitX, exitY);
+        if (entry >= exit || entry < 0.0f || entry > 1.0f || entry >= bestTime)
+            return;
+
+        // Faces shared with another blocked tile are internal; the neighbour is hit instead
+        const glm::vec2 normalX(delta.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+        const glm::vec2 normalY(0.0f, delta.y > 0.0f ? -1.0f : 1.0f);
+        const bool openX = delta.x != 0.0f && !blocked(tx + static_cast<int>(normalX.x), ty);
+        const bool openY = delta.y != 0.0f && !blocked(tx, ty + static_cast<int>(normalY.y));
+        const bool corner = std::abs(entryX - entryY) <= 1e-6f;
+
+        glm::vec2 normal;
+        if (corner)
+        {
+            if (!openX && !openY)
+                return;
+            normal = openX ? normalX : normalY;
+        }
+        else if (entryX > entryY)
+        {
+            if (!openX)
+                return;
+            normal = normalX;
+        }
+        else
+        {
+            if (!openY)
+                return;
+            normal = normalY;
+        }
+
+        bestTime = entry;
+        contact.hit = true;
+        contact.corner = corner && openX && openY;
+        contact.time = entry;
+        contact.normal = normal;
+        contact.tileX = tx;
+        contact.tileY = ty;
+    });
+
+    if (contact.hit)
+        contact.cornerCutMask = tilemap.GetCornerCutMask(contact.tileX, contact.tileY);
+    return contact;
+}
+
+SweepContact SweepAABB(const Tilemap &tilemap, const SweepBox &box, glm::vec2 delta)
+{
+    const SweepGrid grid{tilemap.GetCollisionMap(), static_cast<float>(tilemap.GetTileWidth()),
+                         static_cast<float>(tilemap.GetTileHeight())};
+    return SweepAgainstGrid(grid, tilemap, box, delta);
+}
+
+void SweepAABBBatch(const Tilemap &tilemap, std::span<const SweepRequest> requests,
+                    std::span<SweepContact> results)
+{
+    const SweepGrid grid{tilemap.GetCollisionMap(), static_cast<float>(tilemap.GetTileWidth()),
+                         static_cast<float>(tilemap.GetTileHeight())};
+    const size_t count = std::min(requests.size(), results.size());
+    for (size_t i = 0; i < count; ++i)
+        results[i] = SweepAgainstGrid(grid, tilemap, requests[i].box, requests[i].delta);
+}
@@ -0,0 +1,149 @@
+#include "CompiledDialogue.h"
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace
+{
+// Never destroyed: NPC profiles held by statics may release trees during exit
+std::unordered_map<std::string, std::weak_ptr<const CompiledDialogue>> &SharedTrees()
+{
+    static auto *trees = new std::unordered_map<std::string, std::weak_ptr<const CompiledDialogue>>();
+    return *trees;
+}
+
+bool GivesQuest(const DialogueConsequence &cons)
+{
+    return (cons.type == DialogueConsequence::Type::SET_FLAG ||
+            cons.type == DialogueConsequence::Type::SET_FLAG_VALUE) &&
+           cons.key.starts_with("accepted_") && cons.key.find("_quest") != std::string::npos;
+}
+}  // namespace
+
+std::shared_ptr<const CompiledDialogue> CompiledDialogue::Compile(const DialogueTree &tree)
+{
+    std::shared_ptr<CompiledDialogue> compiled(new CompiledDialogue());
+    compiled->m_Source = tree;
+
+    // Start node first, the rest by id, so indices do not depend on hash order
+    std::vector<const DialogueNode *> order;
+    order.reserve(tree.nodes.size());
+    for (const auto &[id, node] : tree.nodes)
+        order.push_back(&node);
+    std::sort(order.begin(), order.end(), [&](const DialogueNode *a, const DialogueNode *b)
+              {
+                  const bool aStart = a->id == tree.startNodeId;
+                  const bool bStart = b->id == tree.startNodeId;
+                  return aStart != bStart ? aStart : a->id < b->id;
+              });
+
+    std::unordered_map<std::string_view, Index> nodeIndex;
+    for (const DialogueNode *node : order)
+        nodeIndex.emplace(node->id, static_cast<Index>(nodeIndex.size()));
+    if (auto it = nodeIndex.find(tree.startNodeId); it != nodeIndex.end())
+        compiled->m_Start = it->second;
+
+    std::unordered_map<std::string_view, Index> flagIndex;
+    auto flagSlot = [&](const std::string &key)
+    {
+        auto [it, inserted] = flagIndex.emplace(key, static_cast<Index>(compiled->m_FlagKeys.size()));
+        if (inserted)
+            compiled->m_FlagKeys.push_back(key);
+        return it->second;
+    };
+
+    compiled->m_Nodes.reserve(order.size());
+    for (const DialogueNode *source : order)
+    {
+        Node &node = compiled->m_Nodes.emplace_back();
+        node.id = source->id;
+        node.speaker = source->speaker;
+        node.text = source->text;
+        node.firstOption = static_cast<Index>(compiled->m_Options.size());
+        node.optionCount = static_cast<Index>(source->options.size());
+
+        for (const DialogueOption &sourceOption : source->options)
+        {
+            Option &option = compiled->m_Options.emplace_back();
+            option.text = sourceOption.text;
+            if (!sourceOption.nextNodeId.empty())
+            {
+                auto it = nodeIndex.find(sourceOption.nextNodeId);
+                if (it != nodeIndex.end())
+                    option.next = it->second;
+                else
+                    std::cerr << "CompiledDialogue: '" << tree.id << "' node '" << source->id
+                              << "' links to missing node '" << sourceOption.nextNodeId << "'" << std::endl;
+            }
+
+            option.firstCondition = static_cast<Index>(compiled->m_Conditions.size());
+            option.conditionCount = static_cast<Index>(sourceOption.conditions.size());
+            for (const DialogueCondition &cond : sourceOption.conditions)
+                compiled->m_Conditions.push_back(Condition{cond.type, flagSlot(cond.key), cond.value});
+
+            option.firstConsequence = static_cast<Index>(compiled->m_Consequences.size());
+            option.consequenceCount = static_cast<Index>(sourceOption.consequences.size());
+            for (const DialogueConsequence &cons : sourceOption.consequences)
+            {
+                compiled->m_Consequences.push_back(Consequence{cons.type, flagSlot(cons.key), cons.value});
+                option.givesQuest = option.givesQuest || GivesQuest(cons);
+            }
+        }
+    }
+    return compiled;
+}
+
+std::shared_ptr<const CompiledDialogue> CompiledDialogue::Share(const DialogueTree &tree)
+{
+    if (tree.nodes.empty())
+        return nullptr;
+
+    auto &trees = SharedTrees();
+    std::erase_if(trees, [](const auto &entry) { return entry.second.expired(); });
+
+    auto &slot = trees[tree.id];
+    if (auto existing = slot.lock(); existing && existing->m_Source == tree)
+        return existing;
+
+    // A different tree under the same id replaces the entry; earlier holders keep theirs
+    auto compiled = Compile(tree);
+    slot = compiled;
+    return compiled;
+}
+
+std::vector<GameStateManager::FlagId> CompiledDialogue::BindFlags(GameStateManager &state) const
+{
+    std::vector<GameStateManager::FlagId> flags;
+    flags.reserve(m_FlagKeys.size());
+    for (const std::string &key : m_FlagKeys)
+        flags.push_back(state.Intern(key));
+    return flags;
+}
+
+bool CompiledDialogue::IsVisible(const Option &option, const GameStateManager &state,
+                                 std::span<const GameStateManager::FlagId> flags) const
+{
+    for (const Condition &cond : GetConditions(option))
+    {
+        const GameStateManager::FlagId id = flags[cond.flag];
+        switch (cond.type)
+        {
+            case DialogueCondition::Type::FLAG_SET:
+                if (!state.HasFlag(id))
+                    return false;
+                break;
+
+            case DialogueCondition::Type::FLAG_NOT_SET:
+                if (state.HasFlag(id))
+                    return false;
+                break;
+
+            case DialogueCondition::Type::FLAG_EQUALS:
+                if (!state.FlagEquals(id, cond.value))
+                    return false;
+                break;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "DialogueSystem.h"
+#include "GameStateManager.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class CompiledDialogue
+ * @brief Immutable, index-linked form of a DialogueTree.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Dialogue
+ *
+ * DialogueTree is the editable form: nodes keyed by string id, options
+ * naming their target node and flags by string. Running a conversation from
+ * it means a map lookup per transition and a flag-name hash per condition
+ * every time options are filtered. Compiling once when the tree is loaded
+ * turns it into four flat arrays:
+ *
+ * | Array          | Element                                             |
+ * |----------------|-----------------------------------------------------|
+ * | nodes          | speaker, text, range of options                     |
+ * | options        | text, next node index, condition/consequence ranges |
+ * | conditions     | type, flag slot, expected value                     |
+ * | consequences   | type, flag slot, new value                          |
+ *
+ * Flag names are collected into GetFlagKeys(); conditions and consequences
+ * refer to a slot in that list. BindFlags() interns the list into a
+ * GameStateManager once per conversation, after which every check is an
+ * array index.
+ *
+ * @code{.cpp}
+ * auto dialogue = CompiledDialogue::Share(tree);
+ * std::vector<GameStateManager::FlagId> flags = dialogue->BindFlags(state);
+ * const CompiledDialogue::Node *node = dialogue->GetStartNode();
+ * for (const CompiledDialogue::Option &option : dialogue->GetOptions(*node))
+ *     if (dialogue->IsVisible(option, state, flags))
+ *         Show(option.text);
+ * @endcode
+ *
+ * @par Sharing
+ * Share() hands out one compiled tree per distinct DialogueTree, keyed by
+ * tree id and checked for equality, so NPCs of one type with the same
+ * conversation hold a single copy. DialogueManager keeps a reference for
+ * the length of a conversation, so the NPC may be removed mid-dialogue.
+ *
+ * @par Broken Links
+ * A choice whose goto names a missing node is reported once at compile time
+ * and ends the conversation, as it did when looked up at runtime.
+ *
+ * @par Thread Safety
+ * A compiled tree is immutable and may be read from any thread. Share()
+ * is main thread only.
+ *
+ * @see DialogueTree, DialogueManager, GameStateManager::Intern()
+ */
+class CompiledDialogue
+{
+public:
+    using Index = std::uint32_t;
+    static constexpr Index NO_NODE = UINT32_MAX;  ///< Option target that ends the conversation
+
+    struct Condition
+    {
+        DialogueCondition::Type type;
+        Index flag;         ///< Slot in GetFlagKeys()
+        std::string value;  ///< Expected value (FLAG_EQUALS)
+    };
+
+    struct Consequence
+    {
+        DialogueConsequence::Type type;
+        Index flag;         ///< Slot in GetFlagKeys()
+        std::string value;  ///< New value (SET_FLAG_VALUE)
+    };
+
+    struct Option
+    {
+        std::string text;
+        Index next = NO_NODE;
+        Index firstCondition = 0;
+        Index conditionCount = 0;
+        Index firstConsequence = 0;
+        Index consequenceCount = 0;
+        bool givesQuest = false;  ///< Sets an accepted_*_quest flag
+    };
+
+    struct Node
+    {
+        std::string id;
+        std::string speaker;
+        std::string text;
+        Index firstOption = 0;
+        Index optionCount = 0;
+    };
+
+    /// @brief Compile @p tree into a new, unshared instance.
+    static std::shared_ptr<const CompiledDialogue> Compile(const DialogueTree &tree);
+
+    /**
+     * @brief Compiled form of @p tree, reusing a live one with equal content.
+     * @return nullptr for a tree without nodes.
+     */
+    static std::shared_ptr<const CompiledDialogue> Share(const DialogueTree &tree);
+
+    /// @brief The tree this was compiled from (for saving and editing).
+    [[nodiscard]] const DialogueTree &GetSource() const { return m_Source; }
+
+    /// @brief Entry node, or nullptr if the start id names no node.
+    [[nodiscard]] const Node *GetStartNode() const { return m_Start != NO_NODE ? &m_Nodes[m_Start] : nullptr; }
+
+    /// @brief Target of @p option, or nullptr if it ends the conversation.
+    [[nodiscard]] const Node *GetNext(const Option &option) const
+    {
+        return option.next != NO_NODE ? &m_Nodes[option.next] : nullptr;
+    }
+
+    [[nodiscard]] std::span<const Option> GetOptions(const Node &node) const
+    {
+        return std::span<const Option>(m_Options).subspan(node.firstOption, node.optionCount);
+    }
+
+    [[nodiscard]] std::span<const Condition> GetConditions(const Option &option) const
+    {
+        return std::span<const Condition>(m_Conditions).subspan(option.firstCondition, option.conditionCount);
+    }
+
+    [[nodiscard]] std::span<const Consequence> GetConsequences(const Option &option) const
+    {
+        return std::span<const Consequence>(m_Consequences).subspan(option.firstConsequence, option.consequenceCount);
+    }
+
+    /// @brief Distinct flag names; Condition::flag and Consequence::flag index this.
+    [[nodiscard]] const std::vector<std::string> &GetFlagKeys() const { return m_FlagKeys; }
+
+    [[nodiscard]] std::size_t GetNodeCount() const { return m_Nodes.size(); }
+
+    /// @brief Intern every flag name, in GetFlagKeys() order.
+    [[nodiscard]] std::vector<GameStateManager::FlagId> BindFlags(GameStateManager &state) const;
+
+    /**
+     * @brief Whether every condition of @p option holds.
+     * @param flags Result of BindFlags() for @p state.
+     */
+    [[nodiscard]] bool IsVisible(const Option &option, const GameStateManager &state,
+                                 std::span<const GameStateManager::FlagId> flags) const;
+
+private:
+    CompiledDialogue() = default;
+
+    DialogueTree m_Source;
+    std::vector<Node> m_Nodes;
+    std::vector<Option> m_Options;
+    std::vector<Condition> m_Conditions;
+    std::vector<Consequence> m_Consequences;
+    std::vector<std::string> m_FlagKeys;
+    Index m_Start = NO_NODE;
+};
@@ -2,16 +2,16 @@
 #include "GameStateManager.h"
 #include "NonPlayerCharacter.h"
 #include "Game.h"
+#include "Profiler.h"
 
 #include <iostream>
 
-// Invariants: when active, m_CurrentTree points at m_ActiveTree and
-// m_VisibleOptions stores pointers into that owned copy.
+// Invariants: when active, m_CurrentTree holds the NPC's compiled tree and
+// m_CurrentNode and m_VisibleOptions point into it.
 DialogueManager::DialogueManager()
     : m_Game(nullptr)               // Set by Initialize() - provides NPC access
     , m_StateManager(nullptr)       // Set by Initialize() - evaluates conditions and stores flags
     , m_Active(false)               // No conversation in progress until StartDialogue()
-    , m_CurrentTree(nullptr)        // Points to m_ActiveTree when dialogue is active
     , m_CurrentNode(nullptr)        // Current position in the dialogue tree
     , m_SelectedOption(0)           // UI cursor position in the options list
 {
@@ -25,6 +25,7 @@ void DialogueManager::Initialize(Game *game, GameStateManager *stateManager)
 
 bool DialogueManager::StartDialogue(NonPlayerCharacter *npc)
 {
+    WILD_PROFILE_ZONE("Dialogue Start");
     // Respect contract do not start if a conversation is already active
     if (m_Active)
     {
@@ -43,26 +44,20 @@ bool DialogueManager::StartDialogue(NonPlayerCharacter *npc)
     }
 
     // Get the starting point for this conversation
-    const DialogueTree &tree = npc->GetDialogueTree();
-    const DialogueNode *startNode = tree.GetStartNode();
+    const std::shared_ptr<const CompiledDialogue> &tree = npc->GetCompiledDialogue();
+    const CompiledDialogue::Node *startNode = tree->GetStartNode();
     if (!startNode)
     {
         std::cerr << "DialogueManager: Start node not found in NPC tree" << std::endl;
         return false;
     }
 
-    // Copy the tree locally so pointers remain valid even if the NPC is removed
-    m_ActiveTree = tree;
-    startNode = m_ActiveTree.GetStartNode();
-    if (!startNode)
-    {
-        std::cerr << "DialogueManager: Start node missing after tree copy" << std::endl;
-        return false;
-    }
+    // Holding a reference keeps the tree alive even if the NPC is removed
+    m_CurrentTree = tree;
+    m_Flags = m_CurrentTree->BindFlags(*m_StateManager);
 
     // Initialize dialogue state
     m_Active = true;
-    m_CurrentTree = &m_ActiveTree;
     m_CurrentNode = startNode;
     m_SelectedOption = 0;
 
@@ -77,10 +72,10 @@ bool DialogueManager::StartDialogue(NonPlayerCharacter *npc)
 void DialogueManager::EndDialogue()
 {
     m_Active = false;
-    m_CurrentTree = nullptr;
     m_CurrentNode = nullptr;
-    m_ActiveTree = DialogueTree{};
     m_VisibleOptions.clear();
+    m_Flags.clear();
+    m_CurrentTree.reset();
     m_SelectedOption = 0;
 
     std::cout << "DialogueManager: Dialogue ended" << std::endl;
@@ -94,29 +89,21 @@ void DialogueManager::SelectOption(int optionIndex)
     if (optionIndex < 0 || optionIndex >= static_cast<int>(m_VisibleOptions.size()))
         return;
 
-    const DialogueOption *option = m_VisibleOptions[optionIndex];
+    const CompiledDialogue::Option *option = m_VisibleOptions[optionIndex];
 
     // Apply any game state changes from this choice
-    ExecuteConsequences(option->consequences);
+    ExecuteConsequences(*option);
 
     // Move to the next part of the conversation (or end it)
-    TransitionToNode(option->nextNodeId);
+    TransitionToNode(*option);
 }
 
-void DialogueManager::TransitionToNode(const std::string &nodeId)
+void DialogueManager::TransitionToNode(const CompiledDialogue::Option &option)
 {
-    // Empty nodeId means "end dialogue" (terminal option)
-    if (nodeId.empty() || !m_CurrentTree)
-    {
-        EndDialogue();
-        return;
-    }
-
-    // Look up the next node in the tree
-    const DialogueNode *nextNode = m_CurrentTree->GetNode(nodeId);
+    // Terminal options and links to missing nodes (reported when compiled) end the dialogue
+    const CompiledDialogue::Node *nextNode = m_CurrentTree ? m_CurrentTree->GetNext(option) : nullptr;
     if (!nextNode)
     {
-        std::cerr << "DialogueManager: Node not found: " << nodeId << std::endl;
         EndDialogue();
         return;
     }
@@ -155,6 +142,7 @@ void DialogueManager::SelectNext()
 
 void DialogueManager::ConfirmSelection()
 {
+    WILD_PROFILE_ZONE("Dialogue Confirm");
     if (m_VisibleOptions.empty())
     {
         // No options available treat as end of dialogue
@@ -168,31 +156,33 @@ void DialogueManager::ConfirmSelection()
     }
 }
 
-void DialogueManager::ExecuteConsequences(const std::vector<DialogueConsequence> &consequences)
+void DialogueManager::ExecuteConsequences(const CompiledDialogue::Option &option)
 {
-    if (!m_StateManager)
+    if (!m_StateManager || !m_CurrentTree)
         return;
 
-    for (const auto &cons : consequences)
+    for (const auto &cons : m_CurrentTree->GetConsequences(option))
     {
+        const GameStateManager::FlagId flag = m_Flags[cons.flag];
+        const std::string &key = m_CurrentTree->GetFlagKeys()[cons.flag];
         switch (cons.type)
         {
         case DialogueConsequence::Type::SET_FLAG:
             // Mark a boolean flag as true (e.g., "quest_accepted")
-            m_StateManager->SetFlag(cons.key, true);
-            std::cout << "DialogueManager: Set flag '" << cons.key << "' = true" << std::endl;
+            m_StateManager->SetFlag(flag, true);
+            std::cout << "DialogueManager: Set flag '" << key << "' = true" << std::endl;
             break;
 
         case DialogueConsequence::Type::CLEAR_FLAG:
             // Mark a boolean flag as false (e.g., "has_item")
-            m_StateManager->ClearFlag(cons.key);
-            std::cout << "DialogueManager: Cleared flag '" << cons.key << "'" << std::endl;
+            m_StateManager->ClearFlag(flag);
+            std::cout << "DialogueManager: Cleared flag '" << key << "'" << std::endl;
             break;
 
         case DialogueConsequence::Type::SET_FLAG_VALUE:
             // Set a flag to a specific string value (e.g., "reputation" = "friendly")
-            m_StateManager->SetFlagValue(cons.key, cons.value);
-            std::cout << "DialogueManager: Set flag '" << cons.key << "' = '" << cons.value << "'" << std::endl;
+            m_StateManager->SetFlagValue(flag, cons.value);
+            std::cout << "DialogueManager: Set flag '" << key << "' = '" << cons.value << "'" << std::endl;
             break;
         }
         // TODO: extend consequences to support scripted actions or item grants; log unhandled types when the enum grows.
@@ -203,14 +193,14 @@ void DialogueManager::RefreshVisibleOptions()
 {
     m_VisibleOptions.clear();
 
-    if (!m_CurrentNode || !m_StateManager)
+    if (!m_CurrentNode || !m_StateManager || !m_CurrentTree)
         return;
 
     // Filter options based on their conditions
-    for (const auto &option : m_CurrentNode->options)
+    for (const auto &option : m_CurrentTree->GetOptions(*m_CurrentNode))
     {
         // Only show options where all conditions are satisfied
-        if (m_StateManager->EvaluateConditions(option.conditions))
+        if (m_CurrentTree->IsVisible(option, *m_StateManager, m_Flags))
         {
             m_VisibleOptions.push_back(&option);
         }
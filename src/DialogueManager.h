@@ -1,13 +1,12 @@
 #pragma once
 
-#include "DialogueSystem.h"
+#include "CompiledDialogue.h"
 
-#include <string>
+#include <memory>
 #include <vector>
 
 // Forward declarations
 class Game;
-class GameStateManager;
 class NonPlayerCharacter;
 
 /**
@@ -19,7 +18,9 @@ class NonPlayerCharacter;
  * DialogueManager orchestrates dialogue interactions between the player
  * and NPCs. It maintains conversation state, filters available options based
  * on game conditions, and executes consequences when choices are made.
- * Dialogue trees are stored directly on NPCs rather than loaded centrally.
+ * Dialogue trees are stored directly on NPCs rather than loaded centrally,
+ * already compiled (see CompiledDialogue), so filtering options and moving
+ * between nodes index arrays instead of looking up strings.
  *
  * @par Key Responsibilities
  * - Managing active conversation state (current tree, node, options)
@@ -128,19 +129,19 @@ public:
      *
      * @return Pointer to current node, or nullptr if inactive
      */
-    [[nodiscard]] const DialogueNode* GetCurrentNode() const { return m_CurrentNode; }
+    [[nodiscard]] const CompiledDialogue::Node* GetCurrentNode() const { return m_CurrentNode; }
 
     /**
      * @brief Get visible options (filtered by conditions).
      *
      * Returns only the options whose conditions are currently met.
      * This list is refreshed whenever the current node changes. Pointers
-     * remain valid until the next refresh because the dialogue tree is
-     * stored locally while a conversation is active.
+     * remain valid until the next refresh because the manager holds a
+     * reference to the compiled tree while a conversation is active.
      *
      * @return Vector of pointers to visible options
      */
-    [[nodiscard]] const std::vector<const DialogueOption*>& GetVisibleOptions() const { return m_VisibleOptions; }
+    [[nodiscard]] const std::vector<const CompiledDialogue::Option*>& GetVisibleOptions() const { return m_VisibleOptions; }
 
     /**
      * @brief Get currently selected option index.
@@ -178,8 +179,8 @@ private:
      * @brief Select a dialogue option by index.
      *
      * Triggers the selected option's consequences and transitions
-     * to the next node. If the option's nextNodeId is empty,
-     * the dialogue ends.
+     * to the next node. If the option has no next node, the
+     * dialogue ends.
      *
      * @param optionIndex Index in the visible options list (0-based)
      */
@@ -190,9 +191,9 @@ private:
      *
      * Processes each consequence in order, modifying game state flags.
      *
-     * @param consequences List of consequences to execute
+     * @param option Selected option whose consequences to execute
      */
-    void ExecuteConsequences(const std::vector<DialogueConsequence>& consequences);
+    void ExecuteConsequences(const CompiledDialogue::Option& option);
 
     /**
      * @brief Refresh the visible options list based on current conditions.
@@ -203,11 +204,11 @@ private:
     void RefreshVisibleOptions();
 
     /**
-     * @brief Transition to a specific node.
+     * @brief Transition to the node an option leads to.
      *
-     * @param nodeId ID of node to transition to (empty string ends dialogue)
+     * @param option Selected option (one without a next node ends dialogue)
      */
-    void TransitionToNode(const std::string& nodeId);
+    void TransitionToNode(const CompiledDialogue::Option& option);
 
     /// @name Game System References
     /// @{
@@ -220,17 +221,17 @@ private:
     /// @name Active Dialogue State
     /// @{
 
-    DialogueTree m_ActiveTree;                    ///< Owned copy of active dialogue tree (avoids dangling NPC pointers)
+    std::shared_ptr<const CompiledDialogue> m_CurrentTree;  ///< Keeps the tree alive if the NPC is removed
+    std::vector<GameStateManager::FlagId> m_Flags;         ///< Tree's flag keys interned into m_StateManager
     bool m_Active = false;
-    const DialogueTree* m_CurrentTree = nullptr;
-    const DialogueNode* m_CurrentNode = nullptr;
+    const CompiledDialogue::Node* m_CurrentNode = nullptr;
 
     /// @}
 
     /// @name UI State
     /// @{
 
-    std::vector<const DialogueOption*> m_VisibleOptions;  ///< Pointers into m_ActiveTree nodes; rebuilt on node change
+    std::vector<const CompiledDialogue::Option*> m_VisibleOptions;  ///< Pointers into m_CurrentTree; rebuilt on node change
     int m_SelectedOption = 0;
 
     /// @}
@@ -46,6 +46,8 @@ struct DialogueCondition
      */
     DialogueCondition(Type t, const std::string& k, const std::string& v = "")
         : type(t), key(k), value(v) {}
+
+    bool operator==(const DialogueCondition&) const = default;
 };
 
 /**
@@ -91,6 +93,8 @@ struct DialogueConsequence
      */
     DialogueConsequence(Type t, const std::string& k, const std::string& v = "")
         : type(t), key(k), value(v) {}
+
+    bool operator==(const DialogueConsequence&) const = default;
 };
 
 /**
@@ -126,6 +130,8 @@ struct DialogueOption
      */
     DialogueOption(const std::string& t, const std::string& next = "")
         : text(t), nextNodeId(next) {}
+
+    bool operator==(const DialogueOption&) const = default;
 };
 
 /**
@@ -180,6 +186,8 @@ struct DialogueNode
         }
         return true;
     }
+
+    bool operator==(const DialogueNode&) const = default;
 };
 
 /**
@@ -304,4 +312,6 @@ struct DialogueTree
     {
         nodes[node.id] = node;
     }
+
+    bool operator==(const DialogueTree&) const = default;
 };
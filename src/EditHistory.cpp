@@ -0,0 +1,162 @@
+#include "EditHistory.h"
+
+#include <algorithm>
+#include <tuple>
+
+void EditHistory::Record(Field field, int layer, std::uint32_t cell, std::int32_t before, std::int32_t after)
+{
+    m_Pending.push_back(Delta{cell, before, after, field, static_cast<std::uint8_t>(layer)});
+}
+
+void EditHistory::RecordStructure(const StructureChange &change)
+{
+    m_PendingStructures.push_back(change);
+}
+
+bool EditHistory::Commit()
+{
+    if (!HasPendingEdits())
+        return false;
+
+    // Stable, so the deltas of one cell stay in the order they were written
+    std::stable_sort(m_Pending.begin(), m_Pending.end(), [](const Delta &a, const Delta &b)
+                     { return std::tie(a.field, a.layer, a.cell) < std::tie(b.field, b.layer, b.cell); });
+
+    Stroke stroke;
+    for (std::size_t i = 0; i < m_Pending.size();)
+    {
+        // Collapse repeated writes to one cell: first before, last after
+        Delta delta = m_Pending[i];
+        std::size_t j = i + 1;
+        while (j < m_Pending.size() && m_Pending[j].field == delta.field && m_Pending[j].layer == delta.layer &&
+               m_Pending[j].cell == delta.cell)
+        {
+            delta.after = m_Pending[j].after;
+            ++j;
+        }
+        i = j;
+        if (delta.before == delta.after)
+            continue;
+
+        if (!stroke.runs.empty())
+        {
+            Run &run = stroke.runs.back();
+            if (run.field == delta.field && run.layer == delta.layer && run.first + run.count == delta.cell &&
+                run.before == delta.before && run.after == delta.after)
+            {
+                ++run.count;
+                continue;
+            }
+        }
+        stroke.runs.push_back(Run{delta.cell, 1, delta.before, delta.after, delta.field, delta.layer});
+    }
+    stroke.structures = std::move(m_PendingStructures);
+    m_Pending.clear();
+    m_PendingStructures.clear();
+
+    if (stroke.runs.empty() && stroke.structures.empty())
+        return false;
+
+    stroke.runs.shrink_to_fit();
+    stroke.bytes = MeasureBytes(stroke);
+    for (const Stroke &undone : m_Redo)
+        m_Bytes -= undone.bytes;
+    m_Redo.clear();
+    m_Bytes += stroke.bytes;
+    m_Undo.push_back(std::move(stroke));
+    Trim();
+    return true;
+}
+
+bool EditHistory::Undo(Target &target)
+{
+    Commit();
+    if (m_Undo.empty())
+        return false;
+
+    Apply(m_Undo.back(), target, true);
+    m_Redo.push_back(std::move(m_Undo.back()));
+    m_Undo.pop_back();
+    return true;
+}
+
+bool EditHistory::Redo(Target &target)
+{
+    // New edits since the last undo would have cleared the redo stack on commit
+    if (Commit() || m_Redo.empty())
+        return false;
+
+    Apply(m_Redo.back(), target, false);
+    m_Undo.push_back(std::move(m_Redo.back()));
+    m_Redo.pop_back();
+    return true;
+}
+
+void EditHistory::Clear()
+{
+    m_Pending.clear();
+    m_PendingStructures.clear();
+    m_Undo.clear();
+    m_Redo.clear();
+    m_Bytes = 0;
+}
+
+void EditHistory::SetBudget(std::size_t bytes)
+{
+    m_Budget = bytes;
+    Trim();
+}
+
+std::size_t EditHistory::MeasureBytes(const Stroke &stroke)
+{
+    std::size_t bytes = sizeof(Stroke) + stroke.runs.capacity() * sizeof(Run);
+    for (const StructureChange &change : stroke.structures)
+        bytes += sizeof(StructureChange) + change.name.capacity();
+    return bytes;
+}
+
+void EditHistory::Apply(const Stroke &stroke, Target &target, bool undo)
+{
+    if (undo)
+    {
+        for (auto it = stroke.structures.rbegin(); it != stroke.structures.rend(); ++it)
+        {
+            if (it->added)
+                target.RemoveStructure(it->id);
+            else
+                target.InsertStructure(*it);
+        }
+    }
+    else
+    {
+        for (const StructureChange &change : stroke.structures)
+        {
+            if (change.added)
+                target.InsertStructure(change);
+            else
+                target.RemoveStructure(change.id);
+        }
+    }
+
+    for (const Run &run : stroke.runs)
+    {
+        const std::int32_t value = undo ? run.before : run.after;
+        for (std::uint32_t i = 0; i < run.count; ++i)
+            target.SetCell(run.field, run.layer, run.first + i, value);
+    }
+}
+
+void EditHistory::Trim()
+{
+    // Oldest undo steps go first, then the redo steps furthest from the present
+    while (m_Bytes > m_Budget && !m_Undo.empty())
+    {
+        m_Bytes -= m_Undo.front().bytes;
+        m_Undo.pop_front();
+    }
+    while (m_Bytes > m_Budget && !m_Redo.empty())
+    {
+        m_Bytes -= m_Redo.front().bytes;
+        m_Redo.pop_front();
+    }
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @class EditHistory
+ * @brief Undo/redo stack of map edits stored as run-length-encoded cell deltas.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Editor
+ *
+ * Snapshotting the map per edit would copy every tile layer plus the
+ * collision, navigation and elevation grids. EditHistory instead records
+ * what each edit changed: one (field, layer, cell, before, after) delta per
+ * cell written. Record() collects deltas for the stroke in progress and
+ * Commit() closes it, usually when the mouse button is released:
+ *
+ * -# Repeated writes to one cell collapse to its first `before` and last
+ *    `after`; cells that end where they started are dropped.
+ * -# The rest are sorted by field, layer and cell, and consecutive cells
+ *    with the same before/after pair merge into one Run.
+ *
+ * A flood fill over a uniform region therefore costs one Run per row
+ * segment, and undoing it writes the cells back without searching.
+ *
+ * @par Structures
+ * Adding or removing a no-projection structure changes the structure list
+ * as well as cells; RecordStructure() stores the structure itself. Undo
+ * reverts structure changes before cells, redo replays them before cells,
+ * so cell deltas always see the structure IDs they were recorded against.
+ *
+ * @par Field Order
+ * Fields are applied in declaration order in both directions. Animation
+ * comes before Tile because setting an animation also writes its first
+ * frame as the tile.
+ *
+ * @par Memory
+ * Committed strokes are kept within a byte budget (see SetBudget()); the
+ * oldest are forgotten first. A stroke larger than the whole budget cannot
+ * be undone.
+ *
+ * @par Thread Safety
+ * Not thread-safe; used from the main thread by Editor.
+ *
+ * @see Editor
+ */
+class EditHistory
+{
+public:
+    static constexpr std::size_t DEFAULT_BUDGET = 16u * 1024u * 1024u;
+
+    /// @brief Per-cell map property a delta applies to.
+    enum class Field : std::uint8_t
+    {
+        Animation,
+        Tile,
+        Rotation,
+        NoProjection,
+        YSortPlus,
+        YSortMinus,
+        StructureId,
+        Collision,
+        Navigation,
+        Elevation,
+    };
+
+    /// @brief @c count consecutive cells that all went from @c before to @c after.
+    struct Run
+    {
+        std::uint32_t first;
+        std::uint32_t count;
+        std::int32_t before;
+        std::int32_t after;
+        Field field;
+        std::uint8_t layer;
+    };
+
+    /// @brief A no-projection structure that was added or removed.
+    struct StructureChange
+    {
+        bool added;        ///< false: removed
+        std::int32_t id;   ///< Index in the structure list
+        float leftAnchor[2];
+        float rightAnchor[2];
+        std::string name;
+    };
+
+    /// @brief Receives deltas while undoing or redoing.
+    class Target
+    {
+    public:
+        virtual ~Target() = default;
+        virtual void SetCell(Field field, int layer, std::uint32_t cell, std::int32_t value) = 0;
+        /// Insert @p structure at @p structure.id, shifting later IDs up
+        virtual void InsertStructure(const StructureChange &structure) = 0;
+        virtual void RemoveStructure(std::int32_t id) = 0;
+    };
+
+    /// @brief Note that @p cell's @p field changes from @p before to @p after in the open stroke.
+    void Record(Field field, int layer, std::uint32_t cell, std::int32_t before, std::int32_t after);
+
+    void RecordStructure(const StructureChange &change);
+
+    /**
+     * @brief Close the open stroke and push it onto the undo stack.
+     * @return `true` if the stroke changed anything; the redo stack is then cleared.
+     */
+    bool Commit();
+
+    /// @brief Commit, then revert the newest stroke. @return `false` if there is none.
+    bool Undo(Target &target);
+
+    /// @brief Reapply the newest undone stroke. @return `false` if there is none.
+    bool Redo(Target &target);
+
+    /// @brief Forget everything, including the open stroke (map load or resize).
+    void Clear();
+
+    /**
+     * @brief Limit on bytes held by committed strokes.
+     *
+     * Trims the oldest strokes right away if the history is already larger.
+     */
+    void SetBudget(std::size_t bytes);
+
+    [[nodiscard]] std::size_t GetUndoCount() const { return m_Undo.size(); }
+    [[nodiscard]] std::size_t GetRedoCount() const { return m_Redo.size(); }
+    [[nodiscard]] std::size_t GetMemoryBytes() const { return m_Bytes; }
+    [[nodiscard]] bool HasPendingEdits() const { return !m_Pending.empty() || !m_PendingStructures.empty(); }
+
+private:
+    struct Delta
+    {
+        std::uint32_t cell;
+        std::int32_t before;
+        std::int32_t after;
+        Field field;
+        std::uint8_t layer;
+    };
+
+    struct Stroke
+    {
+        std::vector<Run> runs;
+        std::vector<StructureChange> structures;
+        std::size_t bytes = 0;
+    };
+
+    static std::size_t MeasureBytes(const Stroke &stroke);
+    static void Apply(const Stroke &stroke, Target &target, bool undo);
+    void Trim();
+
+    std::vector<Delta> m_Pending;
+    std::vector<StructureChange> m_PendingStructures;
+    std::deque<Stroke> m_Undo;
+    std::deque<Stroke> m_Redo;
+    std::size_t m_Bytes = 0;     ///< Committed strokes on both stacks
+    std::size_t m_Budget = DEFAULT_BUDGET;
+};
@@ -4,19 +4,6 @@
 #include <cmath>
 #include <iostream>
 
-static constexpr glm::vec4 kLayerColors[] = {
-    {0.0f, 0.0f, 0.0f, 0.0f}, // layer 0 (ground, unused)
-    {0.2f, 0.5f, 1.0f, 0.4f}, // layer 1 -- blue (Ground Detail)
-    {0.2f, 1.0f, 0.2f, 0.4f}, // layer 2 -- green (Objects)
-    {1.0f, 0.2f, 0.8f, 0.4f}, // layer 3 -- magenta (Objects2)
-    {1.0f, 0.5f, 0.0f, 0.4f}, // layer 4 -- orange (Objects3)
-    {1.0f, 1.0f, 0.2f, 0.4f}, // layer 5 -- yellow (Foreground)
-    {0.2f, 1.0f, 1.0f, 0.4f}, // layer 6 -- cyan (Foreground2)
-    {1.0f, 0.3f, 0.3f, 0.4f}, // layer 7 -- red (Overlay)
-    {1.0f, 0.3f, 1.0f, 0.4f}, // layer 8 -- magenta (Overlay2)
-    {1.0f, 1.0f, 1.0f, 0.4f}, // layer 9 -- white (Overlay3)
-};
-
 Editor::Editor()
     : m_EditorMode(false)
     , m_ShowTilePicker(false)
@@ -29,6 +16,11 @@ Editor::Editor()
     , m_ParticleZoneEditMode(false)
     , m_StructureEditMode(false)
     , m_AnimationEditMode(false)
+    , m_SavingEnabled(true)
+    , m_Rng(std::random_device{}())
+    , m_HistoryMapWidth(0)
+    , m_HistoryMapHeight(0)
+    , m_OverlayPaletteLayers(0)
     , m_CurrentParticleType(ParticleType::Firefly)
     , m_ParticleNoProjection(false)
     , m_PlacingParticleZone(false)
@@ -56,6 +48,7 @@ Editor::Editor()
     , m_LastNavigationTileX(-1)
     , m_LastNavigationTileY(-1)
     , m_NavigationDragState(false)
+    , m_PatrolRoutesStale(false)
     , m_LastCollisionTileX(-1)
     , m_LastCollisionTileY(-1)
     , m_CollisionDragState(false)
@@ -66,6 +59,12 @@ Editor::Editor()
     , m_TilePickerOffsetY(0.0f)
     , m_TilePickerTargetOffsetX(0.0f)
     , m_TilePickerTargetOffsetY(0.0f)
+    , m_PickerTarget(-1)
+    , m_PickerTargetWidth(0)
+    , m_PickerTargetHeight(0)
+    , m_PickerCacheEnabled(true)
+    , m_PickerCacheValid(false)
+    , m_PickerRenderer(nullptr)
     , m_MultiTileSelectionMode(false)
     , m_SelectedTileStartID(0)
     , m_SelectedTileWidth(1)
@@ -194,7 +193,7 @@ void Editor::Render(EditorContext ctx)
     if (m_EditorMode && !m_ShowTilePicker)
     {
         if (m_CurrentLayer >= 1 && m_CurrentLayer <= 9)
-            RenderLayerOverlay(ctx, m_CurrentLayer, kLayerColors[m_CurrentLayer]);
+            RenderLayerOverlay(ctx, m_CurrentLayer);
 
         RenderPlacementPreview(ctx);
     }
@@ -214,7 +213,7 @@ void Editor::Render(EditorContext ctx)
         RenderNPCDebugInfo(ctx);
 
         for (int i = 1; i <= 9; ++i)
-            RenderLayerOverlay(ctx, i, kLayerColors[i]);
+            RenderLayerOverlay(ctx, i);
     }
 }
 
@@ -1,13 +1,18 @@
 #pragma once
 
+#include "EditHistory.h"
+#include "EditorOverlayCache.h"
 #include "Tilemap.h"
 #include "PlayerCharacter.h"
 #include "NonPlayerCharacter.h"
 #include "ParticleSystem.h"
+#include "WorldStreamer.h"
 #include "IRenderer.h"
+#include "InputState.h"
 
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -21,6 +26,8 @@
  * by value to every Editor method. Value members are snapshots (window size,
  * visible tiles); reference members allow the editor to mutate shared state
  * (camera position, zoom, free-camera flag) without a back-pointer to Game.
+ * Keys and mouse are read from @c input, never from the window, so recorded
+ * editor sessions replay like gameplay.
  *
  * @par Usage
  * @code{.cpp}
@@ -40,6 +47,7 @@
 struct EditorContext
 {
     GLFWwindow* window;
+    const InputState& input;
     int screenWidth;
     int screenHeight;
     int tilesVisibleWidth;
@@ -57,6 +65,7 @@ struct EditorContext
     std::vector<NonPlayerCharacter>& npcs;
     IRenderer& renderer;
     ParticleSystem& particles;
+    WorldStreamer& worldStreamer;
 };
 
 /**
@@ -91,13 +100,21 @@ struct EditorContext
  * |   O | Y-Sort-Minus Edit  | Set Y-sort-minus flag            | Clear Y-sort-minus flag      |
  * |   - | Default            | Place selected tile (drag)       | Toggle collision (drag)      |
  *
+ * @par Undo
+ * Ctrl+Z undoes and Ctrl+Y (or Ctrl+Shift+Z) redoes map edits. Every write
+ * goes through EditCell(), which records a cell delta in an EditHistory;
+ * everything painted while a mouse button or Delete is held becomes one
+ * step. Tiles, animations, rotation, layer flags, structure assignments and
+ * structures, collision, navigation and elevation are covered. NPCs and
+ * particle zones are not.
+ *
  * @par Per-Frame Pipeline
  * @code
  * Game::ProcessInput   -->  Editor::ProcessInput       (keyboard)
  *                      -->  Editor::ProcessMouseInput  (mouse)
  * Game::Update         -->  Editor::Update          (tile picker smoothing)
  * Game::Render         -->  Editor::Render          (overlays + tile picker)
- * Game::ScrollCallback -->  Editor::HandleScroll    (elevation / tile picker)
+ * Game::ProcessInput   -->  Editor::HandleScroll    (queued wheel events: elevation / tile picker)
  * @endcode
  *
  * @par Debug Overlays (F3)
@@ -106,6 +123,10 @@ struct EditorContext
  * cutting, no-projection, structures, Y-sort flags, particle zones, and
  * NPC patrol info.
  *
+ * Per-tile overlays (collision, navigation, elevation, corner cutting,
+ * Y-sort flags, layer highlights) are drawn from an EditorOverlayCache and
+ * only rebuilt for blocks of the map that changed.
+ *
  * @see EditorContext, Game::MakeEditorContext()
  */
 class Editor
@@ -158,8 +179,23 @@ public:
      */
     void ResetTilePickerState();
 
+    /// @brief Reseed the RNG behind random NPC dialogue and NPC behavior (input replay).
+    void SetSeed(std::uint32_t seed) { m_Rng.seed(seed); }
+
+    /// @brief Allow the S key to write save files; replays turn this off.
+    void SetSavingEnabled(bool enabled) { m_SavingEnabled = enabled; }
+
+    /// @brief Destroy cached overlay meshes and the baked tile picker; call before the renderer is destroyed.
+    void ReleaseOverlayMeshes();
+
+    /// @brief Bytes held by the undo/redo history.
+    std::size_t GetHistoryMemoryBytes() const { return m_History.GetMemoryBytes(); }
+
 private:
     void RenderEditorUI(EditorContext ctx);
+    void DrawTilePickerTiles(EditorContext ctx, float tileSizePixels, float worldWidth, float worldHeight);
+    /// Re-bake the tile picker target if its inputs changed; false if it cannot be used
+    bool UpdateTilePickerCache(EditorContext ctx, float tileSizePixels, float worldWidth, float worldHeight);
     void RenderCollisionOverlays(EditorContext ctx);
     void RenderNavigationOverlays(EditorContext ctx);
     void RenderElevationOverlays(EditorContext ctx);
@@ -168,22 +204,38 @@ private:
     void RenderStructureOverlays(EditorContext ctx);
     void RenderLayerFlagOverlays(EditorContext ctx, bool editMode,
                                   bool (Tilemap::*getter)(int, int, size_t) const,
-                                  const glm::vec3& color);
+                                  int overlay, int colorBase);
     void RenderYSortPlusOverlays(EditorContext ctx);
     void RenderYSortMinusOverlays(EditorContext ctx);
     void RenderParticleZoneOverlays(EditorContext ctx);
     void RenderNPCDebugInfo(EditorContext ctx);
     void RenderCornerCuttingOverlays(EditorContext ctx);
-    void RenderLayerOverlay(EditorContext ctx, int layerIndex, const glm::vec4& color);
+    void RenderLayerOverlay(EditorContext ctx, int layerIndex);
     void RenderPlacementPreview(EditorContext ctx);
 
+    /// Draw one cached overlay over the visible tiles (see EditorOverlayCache::Draw())
+    void DrawCachedOverlay(EditorContext ctx, int overlay, uint64_t key, int reach,
+                           const EditorOverlayCache::Builder& build);
+
     void RecalculateNPCPatrolRoutes(EditorContext ctx);
 
     void CalculateRotatedSourceTile(int dx, int dy, int& sourceDx, int& sourceDy) const;
     float GetCompensatedTileRotation() const;
     void SetLayerFlagAtTile(EditorContext ctx, int tileX, int tileY,
-                            void (Tilemap::*setter)(int, int, size_t, bool),
-                            const std::string& flagName);
+                            EditHistory::Field field, const std::string& flagName);
+
+    /// @name Edit History (EditorHistory.cpp)
+    /// @{
+    /// Set one cell property through the history; @p layer is 0-based for every field.
+    void EditCell(EditorContext ctx, EditHistory::Field field, int x, int y, int layer, int value);
+    int AddStructure(EditorContext ctx, glm::vec2 leftAnchor, glm::vec2 rightAnchor);
+    void RemoveStructure(EditorContext ctx, int id);
+    void UndoEdit(EditorContext ctx);
+    void RedoEdit(EditorContext ctx);
+    void OnHistoryApplied(EditorContext ctx, bool navigationChanged);
+    /// Forget the history if the map was resized or replaced since it was recorded
+    void SyncHistoryToMap(EditorContext ctx);
+    /// @}
 
     struct TileZoneRect { float x, y, w, h; };
     TileZoneRect CalculateParticleZoneRect(float worldX, float worldY,
@@ -202,6 +254,22 @@ private:
     bool m_ParticleZoneEditMode;
     bool m_StructureEditMode;
     bool m_AnimationEditMode;
+    bool m_SavingEnabled;
+    /// @}
+
+    std::mt19937 m_Rng;  ///< Placed NPCs' dialogue and RNG seeds
+
+    /// @name Undo/Redo
+    /// @{
+    EditHistory m_History;
+    int m_HistoryMapWidth;   ///< Map size the history's cell indices refer to
+    int m_HistoryMapHeight;
+    /// @}
+
+    /// @name Overlay Cache
+    /// @{
+    EditorOverlayCache m_OverlayCache;
+    size_t m_OverlayPaletteLayers;  ///< Layer count the palette's shades were computed for
     /// @}
 
     /// @name Particle Zone Editing
@@ -259,6 +327,7 @@ private:
     int m_LastNavigationTileX;
     int m_LastNavigationTileY;
     bool m_NavigationDragState;
+    bool m_PatrolRoutesStale;  ///< Navigation changed this stroke; recomputed when it ends
     int m_LastCollisionTileX;
     int m_LastCollisionTileY;
     bool m_CollisionDragState;
@@ -275,6 +344,31 @@ private:
     float m_TilePickerTargetOffsetY;
     /// @}
 
+    /// @name Tile Picker Cache
+    /// @{
+    /// Inputs the baked tile picker was drawn with
+    struct TilePickerBake
+    {
+        float zoom = 0.0f;
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+        int screenWidth = 0;
+        int screenHeight = 0;
+        int tilesVisibleWidth = 0;
+        int tilesVisibleHeight = 0;
+        uint64_t tilesetRevision = 0;
+
+        bool operator==(const TilePickerBake&) const = default;
+    };
+    int m_PickerTarget;              ///< Render target with the background and tiles, -1 if none
+    int m_PickerTargetWidth;
+    int m_PickerTargetHeight;
+    bool m_PickerCacheEnabled;       ///< Cleared when the backend has no render targets
+    bool m_PickerCacheValid;
+    TilePickerBake m_PickerBake;
+    IRenderer* m_PickerRenderer;     ///< Renderer owning m_PickerTarget
+    /// @}
+
     /// @name Multi-Tile Selection
     /// @{
     bool m_MultiTileSelectionMode;
@@ -0,0 +1,198 @@
+#include "Editor.h"
+
+#include <iostream>
+
+namespace {
+
+using Field = EditHistory::Field;
+
+int GetCellValue(const Tilemap& tilemap, Field field, int x, int y, int layer)
+{
+    const size_t li = static_cast<size_t>(layer);
+    switch (field)
+    {
+        case Field::Animation:    return tilemap.GetTileAnimation(x, y, layer);
+        case Field::Tile:         return tilemap.GetLayerTile(x, y, li);
+        case Field::Rotation:     return static_cast<int>(tilemap.GetLayerRotation(x, y, li));
+        case Field::NoProjection: return tilemap.GetLayerNoProjection(x, y, li) ? 1 : 0;
+        case Field::YSortPlus:    return tilemap.GetLayerYSortPlus(x, y, li) ? 1 : 0;
+        case Field::YSortMinus:   return tilemap.GetLayerYSortMinus(x, y, li) ? 1 : 0;
+        case Field::StructureId:  return tilemap.GetTileStructureId(x, y, layer + 1);
+        case Field::Collision:    return tilemap.GetTileCollision(x, y) ? 1 : 0;
+        case Field::Navigation:   return tilemap.GetNavigation(x, y) ? 1 : 0;
+        case Field::Elevation:    return tilemap.GetElevation(x, y);
+    }
+    return 0;
+}
+
+void SetCellValue(Tilemap& tilemap, Field field, int x, int y, int layer, int value)
+{
+    const size_t li = static_cast<size_t>(layer);
+    switch (field)
+    {
+        case Field::Animation:    tilemap.SetTileAnimation(x, y, layer, value); break;
+        case Field::Tile:         tilemap.SetLayerTile(x, y, li, value); break;
+        case Field::Rotation:     tilemap.SetLayerRotation(x, y, li, static_cast<float>(value)); break;
+        case Field::NoProjection: tilemap.SetLayerNoProjection(x, y, li, value != 0); break;
+        case Field::YSortPlus:    tilemap.SetLayerYSortPlus(x, y, li, value != 0); break;
+        case Field::YSortMinus:   tilemap.SetLayerYSortMinus(x, y, li, value != 0); break;
+        case Field::StructureId:  tilemap.SetTileStructureId(x, y, layer + 1, value); break;
+        case Field::Collision:    tilemap.SetTileCollision(x, y, value != 0); break;
+        case Field::Navigation:   tilemap.SetNavigation(x, y, value != 0); break;
+        case Field::Elevation:    tilemap.SetElevation(x, y, value); break;
+    }
+}
+
+/// Writes undo/redo deltas back into the map
+class TilemapTarget : public EditHistory::Target
+{
+public:
+    explicit TilemapTarget(Tilemap& tilemap) : m_Tilemap(tilemap), m_Width(tilemap.GetMapWidth()) {}
+
+    void SetCell(Field field, int layer, std::uint32_t cell, std::int32_t value) override
+    {
+        const int x = static_cast<int>(cell % static_cast<std::uint32_t>(m_Width));
+        const int y = static_cast<int>(cell / static_cast<std::uint32_t>(m_Width));
+        SetCellValue(m_Tilemap, field, x, y, layer, value);
+        m_NavigationChanged = m_NavigationChanged || field == Field::Navigation;
+    }
+
+    void InsertStructure(const EditHistory::StructureChange& change) override
+    {
+        m_Tilemap.InsertNoProjectionStructure(NoProjectionStructure(
+            change.id, glm::vec2(change.leftAnchor[0], change.leftAnchor[1]),
+            glm::vec2(change.rightAnchor[0], change.rightAnchor[1]), change.name));
+    }
+
+    void RemoveStructure(std::int32_t id) override { m_Tilemap.RemoveNoProjectionStructure(id); }
+
+    bool NavigationChanged() const { return m_NavigationChanged; }
+
+private:
+    Tilemap& m_Tilemap;
+    int m_Width;
+    bool m_NavigationChanged = false;
+};
+
+} // namespace
+
+void Editor::SyncHistoryToMap(EditorContext ctx)
+{
+    // Cell indices are only meaningful for the map size they were recorded at
+    const int width = ctx.tilemap.GetMapWidth();
+    const int height = ctx.tilemap.GetMapHeight();
+    if (width != m_HistoryMapWidth || height != m_HistoryMapHeight)
+    {
+        m_History.Clear();
+        m_HistoryMapWidth = width;
+        m_HistoryMapHeight = height;
+    }
+}
+
+void Editor::EditCell(EditorContext ctx, EditHistory::Field field, int x, int y, int layer, int value)
+{
+    if (x < 0 || x >= ctx.tilemap.GetMapWidth() || y < 0 || y >= ctx.tilemap.GetMapHeight())
+        return;
+    SyncHistoryToMap(ctx);
+
+    const std::uint32_t cell = static_cast<std::uint32_t>(y * ctx.tilemap.GetMapWidth() + x);
+    const int before = GetCellValue(ctx.tilemap, field, x, y, layer);
+
+    // Applying an animation also writes its first frame as the tile
+    const int tileBefore = field == Field::Animation ? ctx.tilemap.GetLayerTile(x, y, static_cast<size_t>(layer)) : 0;
+
+    SetCellValue(ctx.tilemap, field, x, y, layer, value);
+    m_History.Record(field, layer, cell, before, GetCellValue(ctx.tilemap, field, x, y, layer));
+    if (field == Field::Animation)
+        m_History.Record(Field::Tile, layer, cell, tileBefore, ctx.tilemap.GetLayerTile(x, y, static_cast<size_t>(layer)));
+}
+
+int Editor::AddStructure(EditorContext ctx, glm::vec2 leftAnchor, glm::vec2 rightAnchor)
+{
+    SyncHistoryToMap(ctx);
+    const int id = ctx.tilemap.AddNoProjectionStructure(leftAnchor, rightAnchor);
+    m_History.RecordStructure({true, id, {leftAnchor.x, leftAnchor.y}, {rightAnchor.x, rightAnchor.y}, ""});
+    return id;
+}
+
+void Editor::RemoveStructure(EditorContext ctx, int id)
+{
+    const NoProjectionStructure* structure = ctx.tilemap.GetNoProjectionStructure(id);
+    if (!structure)
+        return;
+    SyncHistoryToMap(ctx);
+
+    // Its own step, so the cell deltas below are replayed against this structure list
+    m_History.Commit();
+    m_History.RecordStructure({false, id,
+                               {structure->leftAnchor.x, structure->leftAnchor.y},
+                               {structure->rightAnchor.x, structure->rightAnchor.y},
+                               structure->name});
+
+    // Removal clears this structure's cells and renumbers the ones above it
+    const int width = ctx.tilemap.GetMapWidth();
+    const int height = ctx.tilemap.GetMapHeight();
+    const int layerCount = static_cast<int>(ctx.tilemap.GetLayerCount());
+    for (int layer = 0; layer < layerCount; ++layer)
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const int structId = ctx.tilemap.GetTileStructureId(x, y, layer + 1);
+                if (structId < id)
+                    continue;
+                const std::uint32_t cell = static_cast<std::uint32_t>(y * width + x);
+                m_History.Record(Field::StructureId, layer, cell, structId, structId == id ? -1 : structId - 1);
+            }
+        }
+    }
+
+    ctx.tilemap.RemoveNoProjectionStructure(id);
+    m_History.Commit();
+}
+
+void Editor::UndoEdit(EditorContext ctx)
+{
+    SyncHistoryToMap(ctx);
+    TilemapTarget target(ctx.tilemap);
+    bool undone;
+    {
+        Tilemap::BulkEditScope bulk(ctx.tilemap);
+        undone = m_History.Undo(target);
+    }
+    if (!undone)
+    {
+        std::cout << "Nothing to undo" << std::endl;
+        return;
+    }
+    OnHistoryApplied(ctx, target.NavigationChanged());
+    std::cout << "Undo (" << m_History.GetUndoCount() << " left, "
+              << m_History.GetMemoryBytes() / 1024 << " KB history)" << std::endl;
+}
+
+void Editor::RedoEdit(EditorContext ctx)
+{
+    SyncHistoryToMap(ctx);
+    TilemapTarget target(ctx.tilemap);
+    bool redone;
+    {
+        Tilemap::BulkEditScope bulk(ctx.tilemap);
+        redone = m_History.Redo(target);
+    }
+    if (!redone)
+    {
+        std::cout << "Nothing to redo" << std::endl;
+        return;
+    }
+    OnHistoryApplied(ctx, target.NavigationChanged());
+    std::cout << "Redo (" << m_History.GetRedoCount() << " left)" << std::endl;
+}
+
+void Editor::OnHistoryApplied(EditorContext ctx, bool navigationChanged)
+{
+    if (m_CurrentStructureId >= static_cast<int>(ctx.tilemap.GetNoProjectionStructureCount()))
+        m_CurrentStructureId = -1;
+    if (navigationChanged)
+        RecalculateNPCPatrolRoutes(ctx);
+}
@@ -1,4 +1,5 @@
 #include "Editor.h"
+#include "SpanFill.h"
 
 #include <algorithm>
 #include <cmath>
@@ -12,29 +13,16 @@ template <typename ConditionFn, typename ActionFn>
 int FloodFill(Tilemap& tilemap, int startX, int startY,
               ConditionFn shouldProcess, ActionFn applyAction)
 {
-    int mapWidth = tilemap.GetMapWidth();
-    int mapHeight = tilemap.GetMapHeight();
-    std::vector<bool> visited(static_cast<size_t>(mapWidth * mapHeight), false);
-    std::vector<std::pair<int, int>> stack;
-    stack.push_back({startX, startY});
-    int count = 0;
-    while (!stack.empty())
-    {
-        auto [cx, cy] = stack.back();
-        stack.pop_back();
-        if (cx < 0 || cx >= mapWidth || cy < 0 || cy >= mapHeight) continue;
-        size_t idx = static_cast<size_t>(cy * mapWidth + cx);
-        if (visited[idx]) continue;
-        if (!shouldProcess(cx, cy)) continue;
-        visited[idx] = true;
-        applyAction(cx, cy);
-        count++;
-        stack.push_back({cx - 1, cy});
-        stack.push_back({cx + 1, cy});
-        stack.push_back({cx, cy - 1});
-        stack.push_back({cx, cy + 1});
-    }
-    return count;
+    // Find the whole region before editing it, then apply it row by row as one bulk edit
+    const std::vector<CellSpan> spans = ScanlineFloodFill(tilemap.GetMapWidth(), tilemap.GetMapHeight(),
+                                                          startX, startY, shouldProcess);
+    Tilemap::BulkEditScope bulk(tilemap);
+    for (const CellSpan& span : spans)
+    {
+        for (int x = span.x0; x < span.x1; ++x)
+            applyAction(x, span.y);
+    }
+    return static_cast<int>(CountSpanCells(spans));
 }
 
 struct ScreenToTile
@@ -203,8 +191,27 @@ void BuildMysteryDialogueTree(DialogueTree& tree, std::string& outNpcName, const
 
 void Editor::ProcessInput(float deltaTime, EditorContext ctx)
 {
+    // Ctrl+Z undoes the last edit step; Ctrl+Y or Ctrl+Shift+Z redoes it
+    static bool undoKeyPressed = false;
+    bool ctrlDown = ctx.input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || ctx.input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL);
+    bool shiftDown = ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) || ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT);
+    bool zDown = ctx.input.IsKeyDown(GLFW_KEY_Z);
+    bool yDown = ctx.input.IsKeyDown(GLFW_KEY_Y);
+    if (m_EditorMode && ctrlDown && (zDown || yDown) && !undoKeyPressed)
+    {
+        if (zDown && !shiftDown)
+            UndoEdit(ctx);
+        else
+            RedoEdit(ctx);
+        undoKeyPressed = true;
+    }
+    if (!zDown && !yDown)
+    {
+        undoKeyPressed = false;
+    }
+
     static bool tKeyPressed = false;
-    if (glfwGetKey(ctx.window, GLFW_KEY_T) == GLFW_PRESS && !tKeyPressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_T) && !tKeyPressed && m_EditorMode)
     {
         m_ShowTilePicker = !m_ShowTilePicker;
         tKeyPressed = true;
@@ -220,7 +227,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             std::cout << "Currently selected tile ID: " << m_SelectedTileID << std::endl;
         }
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_T) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_T))
     {
         tKeyPressed = false;
     }
@@ -228,13 +235,13 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     // Rotates the selected tile(s) by 90 increments (0 -> 90 -> 180 -> 270).
     // Works for both single tiles and multi-tile selections when tile picker is closed.
     static bool tileRotateKeyPressed = false;
-    if (glfwGetKey(ctx.window, GLFW_KEY_R) == GLFW_PRESS && !tileRotateKeyPressed && m_EditorMode && !m_ShowTilePicker)
+    if (ctx.input.IsKeyDown(GLFW_KEY_R) && !tileRotateKeyPressed && m_EditorMode && !m_ShowTilePicker)
     {
         m_MultiTileRotation = (m_MultiTileRotation + 90) % 360;
         tileRotateKeyPressed = true;
         std::cout << "Tile rotation: " << m_MultiTileRotation << " degrees" << std::endl;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_R) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_R))
     {
         tileRotateKeyPressed = false;
     }
@@ -246,26 +253,26 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         float scrollSpeed = 1000.0f * deltaTime;
 
         // Shift modifier for faster navigation (2.5x speed)
-        if (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-            glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
+        if (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+            ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT))
         {
             scrollSpeed *= 2.5f;
         }
 
         // Arrow key input
-        if (glfwGetKey(ctx.window, GLFW_KEY_UP) == GLFW_PRESS)
+        if (ctx.input.IsKeyDown(GLFW_KEY_UP))
         {
             m_TilePickerTargetOffsetY += scrollSpeed; // Scroll down (view up)
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_DOWN) == GLFW_PRESS)
+        if (ctx.input.IsKeyDown(GLFW_KEY_DOWN))
         {
             m_TilePickerTargetOffsetY -= scrollSpeed; // Scroll up (view down)
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_LEFT) == GLFW_PRESS)
+        if (ctx.input.IsKeyDown(GLFW_KEY_LEFT))
         {
             m_TilePickerTargetOffsetX += scrollSpeed; // Scroll right (view left)
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+        if (ctx.input.IsKeyDown(GLFW_KEY_RIGHT))
         {
             m_TilePickerTargetOffsetX -= scrollSpeed; // Scroll left (view right)
         }
@@ -300,7 +307,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //
     // Navigation tiles determine where NPCs can walk for pathfinding.
     static bool mKeyPressed = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_M) == GLFW_PRESS && !mKeyPressed)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_M) && !mKeyPressed)
     {
         m_EditNavigationMode = !m_EditNavigationMode;
         if (m_EditNavigationMode)
@@ -317,7 +324,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         std::cout << "Navigation edit mode: " << (m_EditNavigationMode ? "ON" : "OFF") << std::endl;
         mKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_M) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_M))
     {
         mKeyPressed = false;
     }
@@ -327,7 +334,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Navigation edit mode is disabled (mutually exclusive)
     //   - Use , and . keys to cycle through available NPC types
     static bool nKeyPressed = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_N) == GLFW_PRESS && !nKeyPressed)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_N) && !nKeyPressed)
     {
         m_NPCPlacementMode = !m_NPCPlacementMode;
         if (m_NPCPlacementMode)
@@ -352,7 +359,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         nKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_N) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_N))
     {
         nKeyPressed = false;
     }
@@ -362,7 +369,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click removes elevation (sets to 0)
     //   - Use scroll to adjust elevation value
     static bool hKeyPressed = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_H) == GLFW_PRESS && !hKeyPressed)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_H) && !hKeyPressed)
     {
         m_ElevationEditMode = !m_ElevationEditMode;
         if (m_ElevationEditMode)
@@ -384,7 +391,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         hKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_H) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_H))
     {
         hKeyPressed = false;
     }
@@ -394,7 +401,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click clears no-projection flag
     //   - Used for buildings that should appear to have height in 3D mode
     static bool bKeyPressedNoProj = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_B) == GLFW_PRESS && !bKeyPressedNoProj)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_B) && !bKeyPressedNoProj)
     {
         m_NoProjectionEditMode = !m_NoProjectionEditMode;
         if (m_NoProjectionEditMode)
@@ -416,7 +423,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         bKeyPressedNoProj = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_B) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_B))
     {
         bKeyPressedNoProj = false;
     }
@@ -426,7 +433,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click clears Y-sort-plus flag
     //   - Used for tiles that should appear in front/behind player based on Y
     static bool yKeyPressedYSort = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_Y) == GLFW_PRESS && !yKeyPressedYSort)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_Y) && !ctrlDown && !yKeyPressedYSort)
     {
         m_YSortPlusEditMode = !m_YSortPlusEditMode;
         if (m_YSortPlusEditMode)
@@ -448,7 +455,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         yKeyPressedYSort = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_Y) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_Y))
     {
         yKeyPressedYSort = false;
     }
@@ -458,7 +465,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click clears Y-sort-minus flag
     //   - Only affects tiles that are already Y-sort-plus
     static bool oKeyPressedYSortMinus = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_O) == GLFW_PRESS && !oKeyPressedYSortMinus)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_O) && !oKeyPressedYSortMinus)
     {
         m_YSortMinusEditMode = !m_YSortMinusEditMode;
         if (m_YSortMinusEditMode)
@@ -483,7 +490,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         oKeyPressedYSortMinus = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_O) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_O))
     {
         oKeyPressedYSortMinus = false;
     }
@@ -493,7 +500,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click to remove zone under cursor
     //   - Use , and . keys to cycle particle type
     static bool jKeyPressedParticle = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_J) == GLFW_PRESS && !jKeyPressedParticle)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_J) && !jKeyPressedParticle)
     {
         m_ParticleZoneEditMode = !m_ParticleZoneEditMode;
         if (m_ParticleZoneEditMode)
@@ -516,7 +523,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         jKeyPressedParticle = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_J) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_J))
     {
         jKeyPressedParticle = false;
     }
@@ -527,7 +534,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         static bool commaParticle = false;
         static bool periodParticle = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_PRESS && !commaParticle)
+        if (ctx.input.IsKeyDown(GLFW_KEY_COMMA) && !commaParticle)
         {
             int type = static_cast<int>(m_CurrentParticleType);
             type = (type + 7) % 8; // Decrement with wrap-around
@@ -536,10 +543,10 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             std::cout << "Particle type: " << typeNames[type] << std::endl;
             commaParticle = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_COMMA))
             commaParticle = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_PRESS && !periodParticle)
+        if (ctx.input.IsKeyDown(GLFW_KEY_PERIOD) && !periodParticle)
         {
             int type = static_cast<int>(m_CurrentParticleType);
             type = (type + 1) % 8; // Next with wrap-around
@@ -548,19 +555,19 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             std::cout << "Particle type: " << typeNames[type] << std::endl;
             periodParticle = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_PERIOD))
             periodParticle = false;
 
         // Toggles manual noProjection override for new particle zones
         // Auto-detection from tiles is always active, this is for forcing noProjection on/off
         static bool nKeyParticle = false;
-        if (glfwGetKey(ctx.window, GLFW_KEY_N) == GLFW_PRESS && !nKeyParticle)
+        if (ctx.input.IsKeyDown(GLFW_KEY_N) && !nKeyParticle)
         {
             m_ParticleNoProjection = !m_ParticleNoProjection;
             std::cout << "Particle noProjection override: " << (m_ParticleNoProjection ? "ON (forced)" : "OFF (auto-detect)") << std::endl;
             nKeyParticle = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_N) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_N))
             nKeyParticle = false;
     }
 
@@ -572,7 +579,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Right-click to clear structure assignment from tiles
     //   - Delete to remove current structure
     static bool gKeyPressedStruct = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_G) == GLFW_PRESS && !gKeyPressedStruct)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_G) && !gKeyPressedStruct)
     {
         m_StructureEditMode = !m_StructureEditMode;
         if (m_StructureEditMode)
@@ -605,7 +612,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         gKeyPressedStruct = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_G) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_G))
     {
         gKeyPressedStruct = false;
     }
@@ -617,7 +624,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         static bool commaPressed = false;
         static bool periodPressed = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_PRESS && !commaPressed)
+        if (ctx.input.IsKeyDown(GLFW_KEY_COMMA) && !commaPressed)
         {
             size_t count = ctx.tilemap.GetNoProjectionStructureCount();
             if (count > 0)
@@ -637,10 +644,10 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             }
             commaPressed = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_COMMA))
             commaPressed = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_PRESS && !periodPressed)
+        if (ctx.input.IsKeyDown(GLFW_KEY_PERIOD) && !periodPressed)
         {
             size_t count = ctx.tilemap.GetNoProjectionStructureCount();
             if (count > 0)
@@ -657,12 +664,12 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             }
             periodPressed = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_PERIOD))
             periodPressed = false;
 
         // Escape to cancel anchor placement
         static bool escapePressedAnchor = false;
-        if (glfwGetKey(ctx.window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !escapePressedAnchor && m_PlacingAnchor != 0)
+        if (ctx.input.IsKeyDown(GLFW_KEY_ESCAPE) && !escapePressedAnchor && m_PlacingAnchor != 0)
         {
             m_PlacingAnchor = 0;
             m_TempLeftAnchor = glm::vec2(-1.0f, -1.0f);
@@ -670,22 +677,22 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             std::cout << "Anchor placement cancelled" << std::endl;
             escapePressedAnchor = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_ESCAPE) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_ESCAPE))
             escapePressedAnchor = false;
 
         // Delete to remove current structure
         static bool deletePressedStruct = false;
-        if (glfwGetKey(ctx.window, GLFW_KEY_DELETE) == GLFW_PRESS && !deletePressedStruct)
+        if (ctx.input.IsKeyDown(GLFW_KEY_DELETE) && !deletePressedStruct)
         {
             if (m_CurrentStructureId >= 0)
             {
                 std::cout << "Removed structure " << m_CurrentStructureId << std::endl;
-                ctx.tilemap.RemoveNoProjectionStructure(m_CurrentStructureId);
+                RemoveStructure(ctx, m_CurrentStructureId);
                 m_CurrentStructureId = -1;
             }
             deletePressedStruct = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_DELETE) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_DELETE))
             deletePressedStruct = false;
 
     }
@@ -696,7 +703,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Press Escape to cancel/clear frames
     //   - Use , and . to adjust frame duration
     static bool kKeyPressedAnim = false;
-    if (m_EditorMode && glfwGetKey(ctx.window, GLFW_KEY_K) == GLFW_PRESS && !kKeyPressedAnim)
+    if (m_EditorMode && ctx.input.IsKeyDown(GLFW_KEY_K) && !kKeyPressedAnim)
     {
         m_AnimationEditMode = !m_AnimationEditMode;
         if (m_AnimationEditMode)
@@ -723,7 +730,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         kKeyPressedAnim = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_K) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_K))
     {
         kKeyPressedAnim = false;
     }
@@ -734,39 +741,39 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         static bool commaAnim = false;
         static bool periodAnim = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_PRESS && !commaAnim)
+        if (ctx.input.IsKeyDown(GLFW_KEY_COMMA) && !commaAnim)
         {
             m_AnimationFrameDuration = std::max(0.05f, m_AnimationFrameDuration - 0.05f);
             std::cout << "Animation frame duration: " << m_AnimationFrameDuration << "s" << std::endl;
             commaAnim = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_COMMA))
             commaAnim = false;
 
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_PRESS && !periodAnim)
+        if (ctx.input.IsKeyDown(GLFW_KEY_PERIOD) && !periodAnim)
         {
             m_AnimationFrameDuration = std::min(2.0f, m_AnimationFrameDuration + 0.05f);
             std::cout << "Animation frame duration: " << m_AnimationFrameDuration << "s" << std::endl;
             periodAnim = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_PERIOD))
             periodAnim = false;
 
         // Escape to clear frames and deselect animation
         static bool escAnim = false;
-        if (glfwGetKey(ctx.window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !escAnim)
+        if (ctx.input.IsKeyDown(GLFW_KEY_ESCAPE) && !escAnim)
         {
             m_AnimationFrames.clear();
             m_SelectedAnimationId = -1;
             std::cout << "Animation frames/selection cleared" << std::endl;
             escAnim = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_ESCAPE) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_ESCAPE))
             escAnim = false;
 
         // Enter to create animation
         static bool enterAnim = false;
-        if (glfwGetKey(ctx.window, GLFW_KEY_ENTER) == GLFW_PRESS && !enterAnim)
+        if (ctx.input.IsKeyDown(GLFW_KEY_ENTER) && !enterAnim)
         {
             if (m_AnimationFrames.size() >= 2)
             {
@@ -785,7 +792,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             }
             enterAnim = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_ENTER) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_ENTER))
             enterAnim = false;
     }
 
@@ -798,7 +805,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         static bool periodPressed = false;
 
         // Comma key cycles to previous NPC type
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_PRESS && !commaPressed)
+        if (ctx.input.IsKeyDown(GLFW_KEY_COMMA) && !commaPressed)
         {
             if (m_SelectedNPCTypeIndex > 0)
             {
@@ -812,20 +819,20 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
                       << " (" << (m_SelectedNPCTypeIndex + 1) << "/" << m_AvailableNPCTypes.size() << ")" << std::endl;
             commaPressed = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_COMMA) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_COMMA))
         {
             commaPressed = false;
         }
 
         // Period key cycles to next NPC type
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_PRESS && !periodPressed)
+        if (ctx.input.IsKeyDown(GLFW_KEY_PERIOD) && !periodPressed)
         {
             m_SelectedNPCTypeIndex = (m_SelectedNPCTypeIndex + 1) % m_AvailableNPCTypes.size(); // Wrap to start
             std::cout << "Selected NPC type: " << m_AvailableNPCTypes[m_SelectedNPCTypeIndex]
                       << " (" << (m_SelectedNPCTypeIndex + 1) << "/" << m_AvailableNPCTypes.size() << ")" << std::endl;
             periodPressed = true;
         }
-        if (glfwGetKey(ctx.window, GLFW_KEY_PERIOD) == GLFW_RELEASE)
+        if (!ctx.input.IsKeyDown(GLFW_KEY_PERIOD))
         {
             periodPressed = false;
         }
@@ -837,37 +844,71 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     //   - Navigation map
     //   - NPC positions, dialogues and types
     //   - Player spawn position and character type
+    // When running from a streamed world the resident regions are saved instead.
     static bool sKeyPressed = false;
-    if (glfwGetKey(ctx.window, GLFW_KEY_S) == GLFW_PRESS && !sKeyPressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_S) && !sKeyPressed && m_EditorMode && !m_SavingEnabled)
+    {
+        std::cout << "Saving is disabled during input replay" << std::endl;
+        sKeyPressed = true;
+    }
+    if (ctx.input.IsKeyDown(GLFW_KEY_S) && !sKeyPressed && m_EditorMode)
     {
         // Calculate player's current tile for spawn point
         glm::vec2 playerPos = ctx.player.GetPosition();
         int playerTileX = static_cast<int>(std::floor(playerPos.x / ctx.tilemap.GetTileWidth()));
         int playerTileY = static_cast<int>(std::floor((playerPos.y - 0.1f) / ctx.tilemap.GetTileHeight()));
         int characterType = static_cast<int>(ctx.player.GetCharacterType());
+        bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                          ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
-        if (ctx.tilemap.SaveMapToJSON("save.json", &ctx.npcs, playerTileX, playerTileY, characterType))
+        // Shift+S exports the loaded map as a streamed world; a streamed world
+        // saves its resident regions in place, everything else goes to save.json
+        bool saved = false;
+        if (shiftHeld && !ctx.worldStreamer.IsActive())
+        {
+            saved = ctx.tilemap.SaveWorldRegions("world", 64, &ctx.npcs, playerTileX, playerTileY, characterType);
+        }
+        else if (ctx.worldStreamer.IsActive())
+        {
+            saved = ctx.worldStreamer.SaveResident(ctx.tilemap, ctx.npcs, playerTileX, playerTileY, characterType);
+        }
+        else
+        {
+            saved = ctx.tilemap.SaveMapToJSON("save.json", &ctx.npcs, playerTileX, playerTileY, characterType);
+        }
+        if (saved)
         {
             std::cout << "Save successful! Player at tile (" << playerTileX << ", " << playerTileY << "), character type: " << characterType << std::endl;
         }
         sKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_S) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_S))
     {
         sKeyPressed = false;
     }
 
-    // Reloads the game state from save.json, replacing all current state.
+    // Reloads the game state from save.json (or the streamed world), replacing all current state.
     // Also restores player position, character type, and recenters camera.
     static bool lKeyPressed = false;
-    if (glfwGetKey(ctx.window, GLFW_KEY_L) == GLFW_PRESS && !lKeyPressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_L) && !lKeyPressed && m_EditorMode)
     {
         int loadedPlayerTileX = -1;
         int loadedPlayerTileY = -1;
         int loadedCharacterType = -1;
-        if (ctx.tilemap.LoadMapFromJSON("save.json", &ctx.npcs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType))
+        bool loaded = false;
+        if (ctx.worldStreamer.IsActive())
+        {
+            ctx.npcs.clear();
+            loaded = ctx.worldStreamer.Open("world", ctx.tilemap, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+        else
+        {
+            loaded = ctx.tilemap.LoadMapFromJSON("save.json", &ctx.npcs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+        if (loaded)
         {
             std::cout << "Save loaded successfully!" << std::endl;
+            m_History.Clear();
 
             // Restore character type if saved
             if (loadedCharacterType >= 0)
@@ -883,6 +924,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
 
                 // Recenter camera on player
                 glm::vec2 playerPos = ctx.player.GetPosition();
+                ctx.worldStreamer.LoadAround(playerPos, ctx.tilemap, ctx.npcs);
                 float camWorldWidth = static_cast<float>(ctx.tilesVisibleWidth * ctx.tilemap.GetTileWidth());
                 float camWorldHeight = static_cast<float>(ctx.tilesVisibleHeight * ctx.tilemap.GetTileHeight());
                 glm::vec2 playerVisualCenter = glm::vec2(playerPos.x, playerPos.y - 16.0f);
@@ -898,7 +940,7 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
         }
         lKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_L) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_L))
     {
         lKeyPressed = false;
     }
@@ -909,10 +951,10 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     static int lastDeletedTileX = -1;
     static int lastDeletedTileY = -1;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_DELETE) == GLFW_PRESS && m_EditorMode && !m_ShowTilePicker)
+    if (ctx.input.IsKeyDown(GLFW_KEY_DELETE) && m_EditorMode && !m_ShowTilePicker)
     {
         double mouseX, mouseY;
-        glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+        ctx.input.GetCursorPos(mouseX, mouseY);
         auto st = ScreenToTileCoords(ctx, mouseX, mouseY);
         int tileX = st.tileX;
         int tileY = st.tileY;
@@ -925,14 +967,14 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
         {
             // Delete tile on selected layer (set to -1 = empty) and clear animation
-            ctx.tilemap.SetLayerTile(tileX, tileY, m_CurrentLayer, -1);
-            ctx.tilemap.SetTileAnimation(tileX, tileY, static_cast<int>(m_CurrentLayer), -1);
+            EditCell(ctx, EditHistory::Field::Tile, tileX, tileY, m_CurrentLayer, -1);
+            EditCell(ctx, EditHistory::Field::Animation, tileX, tileY, m_CurrentLayer, -1);
             lastDeletedTileX = tileX;
             lastDeletedTileY = tileY;
         }
         deleteKeyHeld = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_DELETE) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_DELETE))
     {
         deleteKeyHeld = false;
         lastDeletedTileX = -1;
@@ -943,10 +985,10 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     // Note: This is different from multi-tile rotation which uses R when
     //       m_MultiTileSelectionMode is true.
     static bool rKeyPressed = false;
-    if (glfwGetKey(ctx.window, GLFW_KEY_R) == GLFW_PRESS && !rKeyPressed && m_EditorMode && !m_ShowTilePicker)
+    if (ctx.input.IsKeyDown(GLFW_KEY_R) && !rKeyPressed && m_EditorMode && !m_ShowTilePicker)
     {
         double mouseX, mouseY;
-        glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+        ctx.input.GetCursorPos(mouseX, mouseY);
         auto st = ScreenToTileCoords(ctx, mouseX, mouseY);
         int tileX = st.tileX;
         int tileY = st.tileY;
@@ -957,12 +999,12 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
             // Rotate tile by 90 degrees on selected layer
             float currentRotation = ctx.tilemap.GetLayerRotation(tileX, tileY, m_CurrentLayer);
             float newRotation = currentRotation + 90.0f;
-            ctx.tilemap.SetLayerRotation(tileX, tileY, m_CurrentLayer, newRotation);
+            EditCell(ctx, EditHistory::Field::Rotation, tileX, tileY, m_CurrentLayer, static_cast<int>(newRotation));
             std::cout << "Rotated Layer " << (m_CurrentLayer + 1) << " tile at (" << tileX << ", " << tileY << ") to " << newRotation << " degrees" << std::endl;
         }
         rKeyPressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_R) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_R))
     {
         rKeyPressed = false;
     }
@@ -980,107 +1022,118 @@ void Editor::ProcessInput(float deltaTime, EditorContext ctx)
     static bool key0Pressed = false;
 
     // Layer switching: Keys 1-9,0 map to dynamic layers 0-9
-    if (glfwGetKey(ctx.window, GLFW_KEY_1) == GLFW_PRESS && !key1Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_1) && !key1Pressed && m_EditorMode)
     {
         m_CurrentLayer = 0;
         std::cout << "Switched to Layer 1: Ground (background)" << std::endl;
         key1Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_1) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_1))
         key1Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_2) == GLFW_PRESS && !key2Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_2) && !key2Pressed && m_EditorMode)
     {
         m_CurrentLayer = 1;
         std::cout << "Switched to Layer 2: Ground Detail (background)" << std::endl;
         key2Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_2) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_2))
         key2Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_3) == GLFW_PRESS && !key3Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_3) && !key3Pressed && m_EditorMode)
     {
         m_CurrentLayer = 2;
         std::cout << "Switched to Layer 3: Objects (background)" << std::endl;
         key3Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_3) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_3))
         key3Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_4) == GLFW_PRESS && !key4Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_4) && !key4Pressed && m_EditorMode)
     {
         m_CurrentLayer = 3;
         std::cout << "Switched to Layer 4: Objects2 (background)" << std::endl;
         key4Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_4) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_4))
         key4Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_5) == GLFW_PRESS && !key5Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_5) && !key5Pressed && m_EditorMode)
     {
         m_CurrentLayer = 4;
         std::cout << "Switched to Layer 5: Objects3 (background)" << std::endl;
         key5Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_5) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_5))
         key5Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_6) == GLFW_PRESS && !key6Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_6) && !key6Pressed && m_EditorMode)
     {
         m_CurrentLayer = 5;
         std::cout << "Switched to Layer 6: Foreground (foreground)" << std::endl;
         key6Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_6) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_6))
         key6Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_7) == GLFW_PRESS && !key7Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_7) && !key7Pressed && m_EditorMode)
     {
         m_CurrentLayer = 6;
         std::cout << "Switched to Layer 7: Foreground2 (foreground)" << std::endl;
         key7Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_7) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_7))
         key7Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_8) == GLFW_PRESS && !key8Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_8) && !key8Pressed && m_EditorMode)
     {
         m_CurrentLayer = 7;
         std::cout << "Switched to Layer 8: Overlay (foreground)" << std::endl;
         key8Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_8) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_8))
         key8Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_9) == GLFW_PRESS && !key9Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_9) && !key9Pressed && m_EditorMode)
     {
         m_CurrentLayer = 8;
         std::cout << "Switched to Layer 9: Overlay2 (foreground)" << std::endl;
         key9Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_9) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_9))
         key9Pressed = false;
 
-    if (glfwGetKey(ctx.window, GLFW_KEY_0) == GLFW_PRESS && !key0Pressed && m_EditorMode)
+    if (ctx.input.IsKeyDown(GLFW_KEY_0) && !key0Pressed && m_EditorMode)
     {
         m_CurrentLayer = 9;
         std::cout << "Switched to Layer 10: Overlay3 (foreground)" << std::endl;
         key0Pressed = true;
     }
-    if (glfwGetKey(ctx.window, GLFW_KEY_0) == GLFW_RELEASE)
+    if (!ctx.input.IsKeyDown(GLFW_KEY_0))
         key0Pressed = false;
 }
 
 void Editor::ProcessMouseInput(EditorContext ctx)
 {
     double mouseX, mouseY;
-    glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+    ctx.input.GetCursorPos(mouseX, mouseY);
 
     // Query mouse button states
-    int leftMouseButton = glfwGetMouseButton(ctx.window, GLFW_MOUSE_BUTTON_LEFT);
-    int rightMouseButton = glfwGetMouseButton(ctx.window, GLFW_MOUSE_BUTTON_RIGHT);
-    bool leftMouseDown = (leftMouseButton == GLFW_PRESS);
-    bool rightMouseDown = (rightMouseButton == GLFW_PRESS);
+    bool leftMouseDown = ctx.input.IsMouseButtonDown(GLFW_MOUSE_BUTTON_LEFT);
+    bool rightMouseDown = ctx.input.IsMouseButtonDown(GLFW_MOUSE_BUTTON_RIGHT);
+
+    // An undo step ends once nothing that paints is held
+    if (!leftMouseDown && !rightMouseDown && !ctx.input.IsKeyDown(GLFW_KEY_DELETE))
+    {
+        m_History.Commit();
+
+        // Once per navigation stroke rather than once per tile dragged over
+        if (m_PatrolRoutesStale)
+        {
+            RecalculateNPCPatrolRoutes(ctx);
+            m_PatrolRoutesStale = false;
+        }
+    }
 
     // Right-click toggles collision or navigation flags depending on mode.
     // Supports drag-to-draw: first click sets target state, dragging applies it.
@@ -1105,7 +1158,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                 int currentAnim = ctx.tilemap.GetTileAnimation(tileX, tileY, m_CurrentLayer);
                 if (currentAnim >= 0)
                 {
-                    ctx.tilemap.SetTileAnimation(tileX, tileY, m_CurrentLayer, -1);
+                    EditCell(ctx, EditHistory::Field::Animation, tileX, tileY, m_CurrentLayer, -1);
                     std::cout << "Removed animation from tile (" << tileX << ", " << tileY << ") on layer " << m_CurrentLayer << std::endl;
                 }
                 m_RightMousePressed = true;
@@ -1114,7 +1167,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             // Elevation edit mode, right-click clears elevation at tile
             else if (m_ElevationEditMode)
             {
-                ctx.tilemap.SetElevation(tileX, tileY, 0);
+                EditCell(ctx, EditHistory::Field::Elevation, tileX, tileY, 0, 0);
                 std::cout << "Cleared elevation at (" << tileX << ", " << tileY << ")" << std::endl;
                 m_RightMousePressed = true;
             }
@@ -1122,21 +1175,21 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             // Shift+right-click, flood-fill to clear all connected tiles
             else if (m_StructureEditMode)
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
                 if (shiftHeld)
                 {
-                    int layer = m_CurrentLayer + 1;
+                    int layer = m_CurrentLayer;
                     int count = FloodFill(ctx.tilemap, tileX, tileY,
-                        [&](int cx, int cy) { return ctx.tilemap.GetTileStructureId(cx, cy, layer) >= 0; },
-                        [&](int cx, int cy) { ctx.tilemap.SetTileStructureId(cx, cy, layer, -1); });
-                    std::cout << "Cleared structure assignment from " << count << " tiles (layer " << layer << ")" << std::endl;
+                        [&](int cx, int cy) { return ctx.tilemap.GetTileStructureId(cx, cy, layer + 1) >= 0; },
+                        [&](int cx, int cy) { EditCell(ctx, EditHistory::Field::StructureId, cx, cy, layer, -1); });
+                    std::cout << "Cleared structure assignment from " << count << " tiles (layer " << (layer + 1) << ")" << std::endl;
                 }
                 else
                 {
                     // Single tile: clear structure assignment
-                    ctx.tilemap.SetTileStructureId(tileX, tileY, m_CurrentLayer + 1, -1);
+                    EditCell(ctx, EditHistory::Field::StructureId, tileX, tileY, m_CurrentLayer, -1);
                     std::cout << "Cleared structure assignment at (" << tileX << ", " << tileY << ")" << std::endl;
                 }
                 m_RightMousePressed = true;
@@ -1145,8 +1198,8 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             // Shift+right-click, flood-fill to clear all connected tiles
             else if (m_NoProjectionEditMode)
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
                 if (shiftHeld)
                 {
@@ -1159,7 +1212,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                         },
                         [&](int cx, int cy) {
                             for (size_t li = 0; li < layerCount; ++li)
-                                ctx.tilemap.SetLayerNoProjection(cx, cy, li, false);
+                                EditCell(ctx, EditHistory::Field::NoProjection, cx, cy, static_cast<int>(li), 0);
                         });
                     std::cout << "Cleared no-projection on " << count << " connected tiles (all layers)" << std::endl;
                 }
@@ -1168,7 +1221,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     // Clear noProjection on ALL layers at this position
                     for (size_t li = 0; li < ctx.tilemap.GetLayerCount(); ++li)
                     {
-                        ctx.tilemap.SetLayerNoProjection(tileX, tileY, li, false);
+                        EditCell(ctx, EditHistory::Field::NoProjection, tileX, tileY, static_cast<int>(li), 0);
                     }
                     std::cout << "Cleared no-projection at (" << tileX << ", " << tileY << ") all layers" << std::endl;
                 }
@@ -1178,20 +1231,20 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             // Shift+right-click, flood-fill to clear all connected tiles
             else if (m_YSortPlusEditMode)
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
                 if (shiftHeld)
                 {
                     int layer = m_CurrentLayer;
                     int count = FloodFill(ctx.tilemap, tileX, tileY,
                         [&](int cx, int cy) { return ctx.tilemap.GetLayerYSortPlus(cx, cy, layer); },
-                        [&](int cx, int cy) { ctx.tilemap.SetLayerYSortPlus(cx, cy, layer, false); });
+                        [&](int cx, int cy) { EditCell(ctx, EditHistory::Field::YSortPlus, cx, cy, layer, 0); });
                     std::cout << "Cleared Y-sort-plus on " << count << " connected tiles (layer " << (layer + 1) << ")" << std::endl;
                 }
                 else
                 {
-                    ctx.tilemap.SetLayerYSortPlus(tileX, tileY, m_CurrentLayer, false);
+                    EditCell(ctx, EditHistory::Field::YSortPlus, tileX, tileY, m_CurrentLayer, 0);
                     std::cout << "Cleared Y-sort-plus at (" << tileX << ", " << tileY << ") layer " << (m_CurrentLayer + 1) << std::endl;
                 }
                 m_RightMousePressed = true;
@@ -1200,20 +1253,20 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             // Shift+right-click, flood-fill to clear all connected tiles
             else if (m_YSortMinusEditMode)
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
                 if (shiftHeld)
                 {
                     int layer = m_CurrentLayer;
                     int count = FloodFill(ctx.tilemap, tileX, tileY,
                         [&](int cx, int cy) { return ctx.tilemap.GetLayerYSortMinus(cx, cy, layer); },
-                        [&](int cx, int cy) { ctx.tilemap.SetLayerYSortMinus(cx, cy, layer, false); });
+                        [&](int cx, int cy) { EditCell(ctx, EditHistory::Field::YSortMinus, cx, cy, layer, 0); });
                     std::cout << "Cleared Y-sort-minus on " << count << " connected tiles (layer " << (layer + 1) << ")" << std::endl;
                 }
                 else
                 {
-                    ctx.tilemap.SetLayerYSortMinus(tileX, tileY, m_CurrentLayer, false);
+                    EditCell(ctx, EditHistory::Field::YSortMinus, tileX, tileY, m_CurrentLayer, 0);
                     std::cout << "Cleared Y-sort-minus at (" << tileX << ", " << tileY << ") layer " << (m_CurrentLayer + 1) << std::endl;
                 }
                 m_RightMousePressed = true;
@@ -1248,7 +1301,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     // Initial click determines target state
                     bool walkable = ctx.tilemap.GetNavigation(tileX, tileY);
                     m_NavigationDragState = !walkable; // Set to opposite of current state
-                    ctx.tilemap.SetNavigation(tileX, tileY, m_NavigationDragState);
+                    EditCell(ctx, EditHistory::Field::Navigation, tileX, tileY, 0, m_NavigationDragState);
                     navigationChanged = true;
                     std::cout << "=== NAVIGATION DRAG START ===" << std::endl;
                     std::cout << "Tile (" << tileX << ", " << tileY << "): "
@@ -1264,7 +1317,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     bool currentWalkable = ctx.tilemap.GetNavigation(tileX, tileY);
                     if (currentWalkable != m_NavigationDragState)
                     {
-                        ctx.tilemap.SetNavigation(tileX, tileY, m_NavigationDragState);
+                        EditCell(ctx, EditHistory::Field::Navigation, tileX, tileY, 0, m_NavigationDragState);
                         navigationChanged = true;
                         std::cout << "Navigation drag: Tile (" << tileX << ", " << tileY << ") -> "
                                   << (m_NavigationDragState ? "ON" : "OFF") << std::endl;
@@ -1273,10 +1326,10 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     m_LastNavigationTileY = tileY;
                 }
 
-                // Recalculate patrol routes when navigation changes
+                // Patrol routes are recalculated when the stroke ends
                 if (navigationChanged)
                 {
-                    RecalculateNPCPatrolRoutes(ctx);
+                    m_PatrolRoutesStale = true;
                 }
             }
             else
@@ -1287,7 +1340,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     // Initial click determines target state
                     bool currentCollision = ctx.tilemap.GetTileCollision(tileX, tileY);
                     m_CollisionDragState = !currentCollision; // Set to opposite of current state
-                    ctx.tilemap.SetTileCollision(tileX, tileY, m_CollisionDragState);
+                    EditCell(ctx, EditHistory::Field::Collision, tileX, tileY, 0, m_CollisionDragState);
                     std::cout << "=== COLLISION DRAG START ===" << std::endl;
                     std::cout << "Tile (" << tileX << ", " << tileY << "): "
                               << (currentCollision ? "ON" : "OFF") << " -> "
@@ -1302,7 +1355,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     bool currentCollision = ctx.tilemap.GetTileCollision(tileX, tileY);
                     if (currentCollision != m_CollisionDragState)
                     {
-                        ctx.tilemap.SetTileCollision(tileX, tileY, m_CollisionDragState);
+                        EditCell(ctx, EditHistory::Field::Collision, tileX, tileY, 0, m_CollisionDragState);
                         std::cout << "Collision drag: Tile (" << tileX << ", " << tileY << ") -> "
                                   << (m_CollisionDragState ? "ON" : "OFF") << std::endl;
                     }
@@ -1515,13 +1568,13 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                             // TODO: Load from save.json only and create dialogues via editor
                             DialogueTree tree;
                             std::string npcName;
-                            static std::mt19937 rng(std::random_device{}());
                             std::uniform_int_distribution<int> dist(0, 4);
-                            int mysteryType = dist(rng);
+                            int mysteryType = dist(m_Rng);
                             BuildMysteryDialogueTree(tree, npcName, kMysteryDialogues[mysteryType]);
 
                             npc.SetDialogueTree(tree);
                             npc.SetName(npcName);
+                            npc.SeedRng(m_Rng());
 
                             ctx.npcs.emplace_back(std::move(npc));
                             std::cout << "Placed NPC " << npcType << " at tile (" << tileX << ", " << tileY << ") with dialogue tree" << std::endl;
@@ -1562,7 +1615,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             if (tileX >= 0 && tileX < ctx.tilemap.GetMapWidth() &&
                 tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
             {
-                ctx.tilemap.SetTileAnimation(tileX, tileY, m_CurrentLayer, m_SelectedAnimationId);
+                EditCell(ctx, EditHistory::Field::Animation, tileX, tileY, m_CurrentLayer, m_SelectedAnimationId);
                 std::cout << "Applied animation #" << m_SelectedAnimationId << " to tile (" << tileX << ", " << tileY << ") layer " << m_CurrentLayer << std::endl;
             }
             return;
@@ -1574,7 +1627,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             if (tileX >= 0 && tileX < ctx.tilemap.GetMapWidth() &&
                 tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
             {
-                ctx.tilemap.SetElevation(tileX, tileY, m_CurrentElevation);
+                EditCell(ctx, EditHistory::Field::Elevation, tileX, tileY, 0, m_CurrentElevation);
                 std::cout << "Set elevation at (" << tileX << ", " << tileY << ") to " << m_CurrentElevation << std::endl;
             }
             return;
@@ -1587,10 +1640,10 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             if (tileX >= 0 && tileX < ctx.tilemap.GetMapWidth() &&
                 tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
-                bool ctrlHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ||
-                                 glfwGetKey(ctx.window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
+                bool ctrlHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) ||
+                                 ctx.input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL));
 
                 if (ctrlHeld && !m_MousePressed)
                 {
@@ -1625,7 +1678,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                         m_PlacingAnchor = 0;
                         m_MousePressed = true;
 
-                        int id = ctx.tilemap.AddNoProjectionStructure(m_TempLeftAnchor, m_TempRightAnchor);
+                        int id = AddStructure(ctx, m_TempLeftAnchor, m_TempRightAnchor);
                         m_CurrentStructureId = id;
                         std::cout << "Right anchor: " << cornerNames[cornerIdx]
                                   << " of tile (" << tileX << ", " << tileY << ")" << std::endl;
@@ -1647,9 +1700,9 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                                    ctx.tilemap.GetTileAnimation(cx, cy, layer) >= 0;
                         },
                         [&](int cx, int cy) {
-                            ctx.tilemap.SetLayerNoProjection(cx, cy, layer, true);
+                            EditCell(ctx, EditHistory::Field::NoProjection, cx, cy, layer, 1);
                             if (structId >= 0)
-                                ctx.tilemap.SetTileStructureId(cx, cy, layer + 1, structId);
+                                EditCell(ctx, EditHistory::Field::StructureId, cx, cy, layer, structId);
                         });
                     if (structId >= 0)
                         std::cout << "Set no-projection on " << count << " tiles, assigned to structure " << structId << std::endl;
@@ -1661,10 +1714,10 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     // Normal click: toggle no-projection on single tile
                     m_MousePressed = true;
                     bool current = ctx.tilemap.GetLayerNoProjection(tileX, tileY, m_CurrentLayer);
-                    ctx.tilemap.SetLayerNoProjection(tileX, tileY, m_CurrentLayer, !current);
+                    EditCell(ctx, EditHistory::Field::NoProjection, tileX, tileY, m_CurrentLayer, !current);
                     if (m_CurrentStructureId >= 0 && !current)
                     {
-                        ctx.tilemap.SetTileStructureId(tileX, tileY, m_CurrentLayer + 1, m_CurrentStructureId);
+                        EditCell(ctx, EditHistory::Field::StructureId, tileX, tileY, m_CurrentLayer, m_CurrentStructureId);
                     }
                     std::cout << (current ? "Cleared" : "Set") << " no-projection at (" << tileX << ", " << tileY << ")" << std::endl;
                 }
@@ -1679,8 +1732,8 @@ void Editor::ProcessMouseInput(EditorContext ctx)
             if (tileX >= 0 && tileX < ctx.tilemap.GetMapWidth() &&
                 tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
             {
-                bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                                  glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+                bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                                  ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
                 if (shiftHeld)
                 {
@@ -1690,13 +1743,13 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                             return ctx.tilemap.GetLayerTile(cx, cy, layer) >= 0 ||
                                    ctx.tilemap.GetTileAnimation(cx, cy, layer) >= 0;
                         },
-                        [&](int cx, int cy) { ctx.tilemap.SetLayerNoProjection(cx, cy, layer, true); });
+                        [&](int cx, int cy) { EditCell(ctx, EditHistory::Field::NoProjection, cx, cy, layer, 1); });
                     std::cout << "Set no-projection on " << count << " connected tiles (layer " << (layer + 1) << ")" << std::endl;
                 }
                 else
                 {
                     // Single tile: set noProjection on current layer only
-                    ctx.tilemap.SetLayerNoProjection(tileX, tileY, m_CurrentLayer, true);
+                    EditCell(ctx, EditHistory::Field::NoProjection, tileX, tileY, m_CurrentLayer, 1);
                     std::cout << "Set no-projection at (" << tileX << ", " << tileY << ") on layer " << (m_CurrentLayer + 1) << std::endl;
                 }
             }
@@ -1707,7 +1760,7 @@ void Editor::ProcessMouseInput(EditorContext ctx)
         // Shift+click, flood-fill to mark all connected tiles in the shape
         if (m_EditorMode && m_YSortPlusEditMode)
         {
-            SetLayerFlagAtTile(ctx, tileX, tileY, &Tilemap::SetLayerYSortPlus, "Y-sort-plus");
+            SetLayerFlagAtTile(ctx, tileX, tileY, EditHistory::Field::YSortPlus, "Y-sort-plus");
             return;
         }
 
@@ -1715,10 +1768,10 @@ void Editor::ProcessMouseInput(EditorContext ctx)
         // Shift+click, flood-fill to mark all connected tiles in the shape
         if (m_EditorMode && m_YSortMinusEditMode)
         {
-            SetLayerFlagAtTile(ctx, tileX, tileY, &Tilemap::SetLayerYSortMinus, "Y-sort-minus");
+            SetLayerFlagAtTile(ctx, tileX, tileY, EditHistory::Field::YSortMinus, "Y-sort-minus");
             // Warn if Y-sort-plus isn't set on this tile (only relevant for single-tile placement)
-            bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                              glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+            bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                              ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
             if (!shiftHeld && tileX >= 0 && tileX < ctx.tilemap.GetMapWidth() &&
                 tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
             {
@@ -1757,8 +1810,8 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                         if (placeX >= 0 && placeX < ctx.tilemap.GetMapWidth() &&
                             placeY >= 0 && placeY < ctx.tilemap.GetMapHeight())
                         {
-                            ctx.tilemap.SetLayerTile(placeX, placeY, m_CurrentLayer, sourceTileID);
-                            ctx.tilemap.SetLayerRotation(placeX, placeY, m_CurrentLayer, tileRotation);
+                            EditCell(ctx, EditHistory::Field::Tile, placeX, placeY, m_CurrentLayer, sourceTileID);
+                            EditCell(ctx, EditHistory::Field::Rotation, placeX, placeY, m_CurrentLayer, static_cast<int>(tileRotation));
                         }
                     }
                 }
@@ -1780,8 +1833,8 @@ void Editor::ProcessMouseInput(EditorContext ctx)
                     tileY >= 0 && tileY < ctx.tilemap.GetMapHeight())
                 {
                     float tileRotation = GetCompensatedTileRotation();
-                    ctx.tilemap.SetLayerTile(tileX, tileY, m_CurrentLayer, m_SelectedTileStartID);
-                    ctx.tilemap.SetLayerRotation(tileX, tileY, m_CurrentLayer, tileRotation);
+                    EditCell(ctx, EditHistory::Field::Tile, tileX, tileY, m_CurrentLayer, m_SelectedTileStartID);
+                    EditCell(ctx, EditHistory::Field::Rotation, tileX, tileY, m_CurrentLayer, static_cast<int>(tileRotation));
 
                     m_LastPlacedTileX = tileX;
                     m_LastPlacedTileY = tileY;
@@ -1863,10 +1916,10 @@ void Editor::ProcessMouseInput(EditorContext ctx)
 void Editor::HandleScroll(double yoffset, EditorContext ctx)
 {
     // Check for Ctrl modifier
-    int ctrlState = glfwGetKey(ctx.window, GLFW_KEY_LEFT_CONTROL) | glfwGetKey(ctx.window, GLFW_KEY_RIGHT_CONTROL);
+    bool ctrlHeld = ctx.input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || ctx.input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL);
 
     // Elevation adjustment with scroll wheel when in elevation edit mode
-    if (m_ElevationEditMode && ctrlState != GLFW_PRESS)
+    if (m_ElevationEditMode && !ctrlHeld)
     {
         if (yoffset > 0)
         {
@@ -1891,11 +1944,11 @@ void Editor::HandleScroll(double yoffset, EditorContext ctx)
         int dataTilesPerCol = ctx.tilemap.GetTilesetDataHeight() / ctx.tilemap.GetTileHeight();
         float baseTileSizePixels = (static_cast<float>(ctx.screenWidth) / static_cast<float>(dataTilesPerRow)) * 1.5f;
 
-        if (ctrlState == GLFW_PRESS)
+        if (ctrlHeld)
         {
             // Zoom centered on mouse
             double mouseX, mouseY;
-            glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+            ctx.input.GetCursorPos(mouseX, mouseY);
 
             float oldTileSize = baseTileSizePixels * m_TilePickerZoom;
 
@@ -1989,15 +2042,14 @@ float Editor::GetCompensatedTileRotation() const
 }
 
 void Editor::SetLayerFlagAtTile(EditorContext ctx, int tileX, int tileY,
-                                void (Tilemap::*setter)(int, int, size_t, bool),
-                                const std::string& flagName)
+                                EditHistory::Field field, const std::string& flagName)
 {
     if (tileX < 0 || tileX >= ctx.tilemap.GetMapWidth() ||
         tileY < 0 || tileY >= ctx.tilemap.GetMapHeight())
         return;
 
-    bool shiftHeld = (glfwGetKey(ctx.window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                      glfwGetKey(ctx.window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+    bool shiftHeld = (ctx.input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                      ctx.input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
     if (shiftHeld)
     {
@@ -2007,12 +2059,12 @@ void Editor::SetLayerFlagAtTile(EditorContext ctx, int tileX, int tileY,
                 return ctx.tilemap.GetLayerTile(cx, cy, layer) >= 0 ||
                        ctx.tilemap.GetTileAnimation(cx, cy, layer) >= 0;
             },
-            [&](int cx, int cy) { (ctx.tilemap.*setter)(cx, cy, layer, true); });
+            [&](int cx, int cy) { EditCell(ctx, field, cx, cy, layer, 1); });
         std::cout << "Set " << flagName << " on " << count << " connected tiles (layer " << (layer + 1) << ")" << std::endl;
     }
     else
     {
-        (ctx.tilemap.*setter)(tileX, tileY, m_CurrentLayer, true);
+        EditCell(ctx, field, tileX, tileY, m_CurrentLayer, 1);
         std::cout << "Set " << flagName << " at (" << tileX << ", " << tileY << ") layer " << (m_CurrentLayer + 1) << std::endl;
     }
 }
@@ -0,0 +1,175 @@
+#include "EditorOverlayCache.h"
+#include "Tilemap.h"
+
+#include <algorithm>
+
+namespace
+{
+// Palette squares are sampled at their inner texels so filtering never reaches a neighbour
+constexpr int PALETTE_CELL = 4;
+}  // namespace
+
+void EditorOverlayCache::SetPalette(std::span<const glm::vec4> colors)
+{
+    Release();
+    m_Overlays.clear();
+    m_Colors.assign(colors.begin(), colors.end());
+
+    const int width = std::max<int>(1, static_cast<int>(m_Colors.size())) * PALETTE_CELL;
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * PALETTE_CELL * 4, 0);
+    for (int y = 0; y < PALETTE_CELL; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const size_t cell = static_cast<size_t>(x / PALETTE_CELL);
+            if (cell >= m_Colors.size())
+                continue;
+            unsigned char *px = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            for (int c = 0; c < 4; ++c)
+                px[c] = static_cast<unsigned char>(std::clamp(m_Colors[cell][c], 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+    // A single row of squares reads the same flipped or not
+    m_Palette.LoadFromData(pixels.data(), width, PALETTE_CELL, 4, false);
+}
+
+void EditorOverlayCache::Draw(IRenderer &renderer, const Tilemap &tilemap, int overlay, uint64_t key, int reach,
+                              glm::vec2 camera, int x0, int y0, int x1, int y1, const Builder &build)
+{
+    if (x1 < x0 || y1 < y0 || overlay < 0)
+        return;
+
+    if (m_Renderer != &renderer)
+    {
+        Release();
+        m_Renderer = &renderer;
+        renderer.UploadTexture(m_Palette);
+    }
+
+    constexpr int BLOCK = Tilemap::REVISION_BLOCK_SIZE;
+    const int mapWidth = tilemap.GetMapWidth();
+    const int mapHeight = tilemap.GetMapHeight();
+    const int blocksX = (mapWidth + BLOCK - 1) / BLOCK;
+    const int blocksY = (mapHeight + BLOCK - 1) / BLOCK;
+    if (blocksX != m_BlocksX || blocksY != m_BlocksY)
+    {
+        for (Overlay &cached : m_Overlays)
+            DropBlocks(cached);
+        m_BlocksX = blocksX;
+        m_BlocksY = blocksY;
+    }
+
+    if (static_cast<size_t>(overlay) >= m_Overlays.size())
+        m_Overlays.resize(static_cast<size_t>(overlay) + 1);
+    Overlay &cached = m_Overlays[static_cast<size_t>(overlay)];
+    if (cached.key != key)
+    {
+        DropBlocks(cached);
+        cached.key = key;
+    }
+    if (cached.blocks.empty())
+        cached.blocks.resize(static_cast<size_t>(blocksX) * static_cast<size_t>(blocksY));
+
+    const double tileWd = static_cast<double>(tilemap.GetTileWidth());
+    const double tileHd = static_cast<double>(tilemap.GetTileHeight());
+    const glm::vec2 viewMin(static_cast<float>(x0 * tileWd), static_cast<float>(y0 * tileHd));
+    const glm::vec2 viewMax(static_cast<float>((x1 + 1) * tileWd), static_cast<float>((y1 + 1) * tileHd));
+
+    // Same rule as the tile chunks: flat meshes only when nothing is projected on the CPU
+    const bool meshes = !(renderer.GetPerspectiveState().enabled && !renderer.IsGpuProjectionEnabled());
+
+    for (int by = y0 / BLOCK; by <= y1 / BLOCK; ++by)
+    {
+        for (int bx = x0 / BLOCK; bx <= x1 / BLOCK; ++bx)
+        {
+            Block &block = cached.blocks[static_cast<size_t>(by * blocksX + bx)];
+            const int tx0 = bx * BLOCK;
+            const int ty0 = by * BLOCK;
+            const int tx1 = std::min(tx0 + BLOCK, mapWidth) - 1;
+            const int ty1 = std::min(ty0 + BLOCK, mapHeight) - 1;
+
+            uint64_t revision = 0;
+            for (int ny = std::max(0, by - reach); ny <= std::min(blocksY - 1, by + reach); ++ny)
+                for (int nx = std::max(0, bx - reach); nx <= std::min(blocksX - 1, bx + reach); ++nx)
+                    revision = std::max(revision, tilemap.GetBlockRevision(nx, ny));
+
+            const glm::vec2 blockWorld(static_cast<float>(tx0 * tileWd), static_cast<float>(ty0 * tileHd));
+            if (!block.built || block.revision != revision)
+            {
+                RebuildBlock(block, blockWorld, tx0, ty0, tx1, ty1, build);
+                block.revision = revision;
+            }
+            if (block.rects.empty())
+                continue;
+
+            // Same double-precision camera offset as the tile chunks
+            const glm::vec2 origin(static_cast<float>(tx0 * tileWd - static_cast<double>(camera.x)),
+                                   static_cast<float>(ty0 * tileHd - static_cast<double>(camera.y)));
+            const glm::vec2 extent(static_cast<float>((tx1 - tx0 + 1) * tileWd),
+                                   static_cast<float>((ty1 - ty0 + 1) * tileHd));
+            const bool crossesLimb = renderer.IsPointBehindSphere(origin) ||
+                                     renderer.IsPointBehindSphere(origin + glm::vec2(extent.x, 0.0f)) ||
+                                     renderer.IsPointBehindSphere(origin + glm::vec2(0.0f, extent.y)) ||
+                                     renderer.IsPointBehindSphere(origin + extent);
+
+            if (meshes && !crossesLimb && block.mesh != IRenderer::INVALID_STATIC_MESH)
+                renderer.DrawStaticMesh(block.mesh, origin);
+            else
+                DrawRects(block.rects, camera, viewMin, viewMax);
+        }
+    }
+}
+
+void EditorOverlayCache::Release()
+{
+    for (Overlay &cached : m_Overlays)
+        DropBlocks(cached);
+    m_Renderer = nullptr;
+}
+
+void EditorOverlayCache::DropBlocks(Overlay &overlay)
+{
+    if (m_Renderer)
+    {
+        for (const Block &block : overlay.blocks)
+            m_Renderer->DestroyStaticMesh(block.mesh);
+    }
+    overlay.blocks.clear();
+}
+
+void EditorOverlayCache::RebuildBlock(Block &block, glm::vec2 blockOrigin, int x0, int y0, int x1, int y1,
+                                      const Builder &build)
+{
+    m_Renderer->DestroyStaticMesh(block.mesh);
+    block.mesh = IRenderer::INVALID_STATIC_MESH;
+    block.rects.clear();
+    block.built = true;
+    build(x0, y0, x1, y1, block.rects);
+    if (block.rects.empty())
+        return;
+
+    std::vector<IRenderer::StaticQuad> quads;
+    quads.reserve(block.rects.size());
+    const glm::vec2 inset(1.0f);
+    const glm::vec2 texSize(static_cast<float>(PALETTE_CELL) - 2.0f * inset.x);
+    for (const Rect &rect : block.rects)
+    {
+        const glm::vec2 cell(static_cast<float>(rect.color * PALETTE_CELL), 0.0f);
+        quads.push_back({rect.position - blockOrigin, rect.size, cell + inset, texSize, 0.0f});
+    }
+    block.mesh = m_Renderer->CreateStaticMesh(m_Palette, quads.data(), quads.size(), m_Renderer->RequiresYFlip());
+}
+
+void EditorOverlayCache::DrawRects(const std::vector<Rect> &rects, glm::vec2 camera, glm::vec2 viewMin,
+                                   glm::vec2 viewMax) const
+{
+    for (const Rect &rect : rects)
+    {
+        if (rect.position.x + rect.size.x < viewMin.x || rect.position.x > viewMax.x ||
+            rect.position.y + rect.size.y < viewMin.y || rect.position.y > viewMax.y)
+            continue;
+        const size_t color = static_cast<size_t>(rect.color);
+        m_Renderer->DrawColoredRect(rect.position - camera, rect.size,
+                                    color < m_Colors.size() ? m_Colors[color] : glm::vec4(1.0f));
+    }
+}
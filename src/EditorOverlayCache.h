@@ -0,0 +1,132 @@
+#pragma once
+
+#include "IRenderer.h"
+#include "Texture.h"
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+class Tilemap;
+
+/**
+ * @class EditorOverlayCache
+ * @brief Editor overlay rectangles baked into static meshes per block of tiles.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Editor
+ *
+ * The collision, navigation, elevation, corner-cutting, Y-sort and layer
+ * overlays used to issue one DrawColoredRect() per flagged tile per frame.
+ * Their input only changes when the map is edited, so the cache asks a
+ * builder for the rects of one Tilemap::REVISION_BLOCK_SIZE block at a
+ * time and keeps them until Tilemap::GetBlockRevision() says the block
+ * changed:
+ *
+ * @code
+ * Draw(overlay, visible range)
+ *   for each visible block
+ *     stale?  --> builder(block tiles) --> rects --> CreateStaticMesh()
+ *     DrawStaticMesh(block mesh, block origin - camera)
+ * @endcode
+ *
+ * Every rect samples one solid cell of a small palette texture, so a whole
+ * overlay over a screen of tiles costs a draw per visible block.
+ *
+ * @par Fallback
+ * Meshes hold flat positions. With perspective projected on the CPU, on
+ * blocks crossing the globe limb, or when the backend returns no mesh, the
+ * cached rects are drawn one DrawColoredRect() each instead; the builder
+ * still only runs when the block changes.
+ *
+ * @par Invalidation
+ * A block is rebuilt when the largest revision over itself and @c reach
+ * blocks around it differs from the one it was built at. Draw()'s @c key
+ * covers inputs that are not map data (such as the edited layer); a new
+ * key rebuilds the whole overlay.
+ *
+ * @par Thread Safety
+ * Not thread-safe; used from the main thread by Editor.
+ *
+ * @see Tilemap::GetBlockRevision(), IRenderer::CreateStaticMesh()
+ */
+class EditorOverlayCache
+{
+public:
+    /// @brief Solid rectangle in world pixels, colored from the palette.
+    struct Rect
+    {
+        glm::vec2 position;  ///< Top-left corner
+        glm::vec2 size;
+        int color;           ///< Index into the colors given to SetPalette()
+    };
+
+    /// Appends the rects of tiles [x0, x1] x [y0, y1] (inclusive)
+    using Builder = std::function<void(int x0, int y0, int x1, int y1, std::vector<Rect> &rects)>;
+
+    EditorOverlayCache() = default;
+    EditorOverlayCache(const EditorOverlayCache &) = delete;
+    EditorOverlayCache &operator=(const EditorOverlayCache &) = delete;
+    ~EditorOverlayCache() = default;
+
+    /**
+     * @brief Set the colors Rect::color refers to.
+     *
+     * Rebuilds the palette texture and drops every cached overlay.
+     */
+    void SetPalette(std::span<const glm::vec4> colors);
+
+    /**
+     * @brief Draw one overlay over the visible tiles.
+     *
+     * @param renderer Renderer to draw with; a different one than last time drops all meshes.
+     * @param tilemap  Map the overlay shows.
+     * @param overlay  Caller-chosen slot, one per kind of overlay (small, dense integers).
+     * @param key      Non-map input of the builder; a change rebuilds the slot.
+     * @param reach    Blocks beyond its own a block's rects depend on (0 or 1).
+     * @param camera   World position of the top-left screen corner.
+     * @param x0, y0, x1, y1 Visible tile range, inclusive.
+     * @param build    Produces the rects of a block.
+     */
+    void Draw(IRenderer &renderer, const Tilemap &tilemap, int overlay, uint64_t key, int reach,
+              glm::vec2 camera, int x0, int y0, int x1, int y1, const Builder &build);
+
+    /**
+     * @brief Destroy meshes held by the renderer that built them.
+     *
+     * Must be called before that renderer is destroyed. Overlays rebuild on
+     * the next Draw().
+     */
+    void Release();
+
+private:
+    /// Cached rects of one block and the mesh baked from them
+    struct Block
+    {
+        std::vector<Rect> rects;
+        int mesh = IRenderer::INVALID_STATIC_MESH;
+        uint64_t revision = 0;  ///< Revision the rects were built at
+        bool built = false;
+    };
+
+    struct Overlay
+    {
+        std::vector<Block> blocks;  ///< Row-major over the map's revision blocks
+        uint64_t key = 0;
+    };
+
+    void DropBlocks(Overlay &overlay);
+    void RebuildBlock(Block &block, glm::vec2 blockOrigin, int x0, int y0, int x1, int y1, const Builder &build);
+
+    /// Draw @p rects one by one, skipping those outside [viewMin, viewMax]
+    void DrawRects(const std::vector<Rect> &rects, glm::vec2 camera, glm::vec2 viewMin, glm::vec2 viewMax) const;
+
+    std::vector<glm::vec4> m_Colors;
+    Texture m_Palette;                ///< One solid square per color, in a single row
+    std::vector<Overlay> m_Overlays;  ///< Indexed by Draw()'s overlay slot
+    IRenderer *m_Renderer = nullptr;  ///< Renderer owning the meshes and palette upload
+    int m_BlocksX = 0;                ///< Block grid the overlays were allocated for
+    int m_BlocksY = 0;
+};
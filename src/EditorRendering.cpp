@@ -2,10 +2,87 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace {
 
+constexpr glm::vec4 kLayerColors[] = {
+    {0.0f, 0.0f, 0.0f, 0.0f}, // layer 0 (ground, unused)
+    {0.2f, 0.5f, 1.0f, 0.4f}, // layer 1 -- blue (Ground Detail)
+    {0.2f, 1.0f, 0.2f, 0.4f}, // layer 2 -- green (Objects)
+    {1.0f, 0.2f, 0.8f, 0.4f}, // layer 3 -- magenta (Objects2)
+    {1.0f, 0.5f, 0.0f, 0.4f}, // layer 4 -- orange (Objects3)
+    {1.0f, 1.0f, 0.2f, 0.4f}, // layer 5 -- yellow (Foreground)
+    {0.2f, 1.0f, 1.0f, 0.4f}, // layer 6 -- cyan (Foreground2)
+    {1.0f, 0.3f, 0.3f, 0.4f}, // layer 7 -- red (Overlay)
+    {1.0f, 0.3f, 1.0f, 0.4f}, // layer 8 -- magenta (Overlay2)
+    {1.0f, 1.0f, 1.0f, 0.4f}, // layer 9 -- white (Overlay3)
+};
+
+/// Overlay cache slots; layer highlights use OVERLAY_LAYER + layer index
+enum OverlaySlot
+{
+    OVERLAY_COLLISION,
+    OVERLAY_NAVIGATION,
+    OVERLAY_ELEVATION,
+    OVERLAY_CORNER_CUTTING,
+    OVERLAY_YSORT_PLUS,
+    OVERLAY_YSORT_MINUS,
+    OVERLAY_LAYER,
+};
+
+/// @name Overlay Palette
+/// Every color a cached overlay rect can have, see BuildOverlayPalette()
+/// @{
+constexpr int COLOR_COLLISION = 0;
+constexpr int COLOR_NAVIGATION = 1;
+constexpr int COLOR_CORNER_EDGE = 2;
+constexpr int COLOR_CORNER_BLOCKED = 3;
+constexpr int COLOR_CORNER_OPEN = 4;
+constexpr int ELEVATION_SHADES = 23;  // Alpha reaches its cap at elevation 23
+constexpr int COLOR_ELEVATION = 5;    // + min(elevation, ELEVATION_SHADES) - 1
+constexpr int MAX_FLAG_LAYERS = 16;   // Flagged-layer counts above this share a shade
+constexpr int COLOR_YSORT_PLUS = COLOR_ELEVATION + ELEVATION_SHADES;  // + 0 in edit mode, else + flagged layers
+constexpr int COLOR_YSORT_MINUS = COLOR_YSORT_PLUS + MAX_FLAG_LAYERS + 1;
+constexpr int COLOR_LAYER = COLOR_YSORT_MINUS + MAX_FLAG_LAYERS + 1;  // + layer index
+constexpr int PALETTE_SIZE = COLOR_LAYER + static_cast<int>(std::size(kLayerColors));
+/// @}
+
+std::vector<glm::vec4> BuildOverlayPalette(size_t layerCount)
+{
+    std::vector<glm::vec4> colors(PALETTE_SIZE, glm::vec4(0.0f));
+    colors[COLOR_COLLISION] = glm::vec4(1.0f, 0.0f, 0.0f, 0.5f);
+    colors[COLOR_NAVIGATION] = glm::vec4(0.0f, 1.0f, 1.0f, 0.3f);
+    colors[COLOR_CORNER_EDGE] = glm::vec4(1.0f, 0.6f, 0.2f, 0.5f);
+    colors[COLOR_CORNER_BLOCKED] = glm::vec4(1.0f, 0.2f, 0.2f, 0.9f);
+    colors[COLOR_CORNER_OPEN] = glm::vec4(0.5f, 1.0f, 0.0f, 0.8f);
+
+    for (int elevation = 1; elevation <= ELEVATION_SHADES; ++elevation)
+    {
+        float alpha = std::min(0.5f, static_cast<float>(elevation) / 32.0f * 0.5f + 0.15f);
+        colors[COLOR_ELEVATION + elevation - 1] = glm::vec4(0.8f, 0.2f, 0.8f, alpha);
+    }
+
+    // Edit mode shows the current layer; otherwise alpha grows with the number of flagged layers
+    auto flagShades = [&](int base, const glm::vec3& color)
+    {
+        colors[base] = glm::vec4(color, 0.5f);
+        for (int count = 1; count <= MAX_FLAG_LAYERS; ++count)
+        {
+            float share = std::min(1.0f, static_cast<float>(count) / static_cast<float>(std::max<size_t>(layerCount, 1)));
+            colors[base + count] = glm::vec4(color, 0.15f + share * 0.35f);
+        }
+    };
+    flagShades(COLOR_YSORT_PLUS, glm::vec3(0.0f, 0.8f, 0.8f));
+    flagShades(COLOR_YSORT_MINUS, glm::vec3(0.9f, 0.2f, 0.9f));
+
+    for (size_t layer = 0; layer < std::size(kLayerColors); ++layer)
+        colors[COLOR_LAYER + layer] = kLayerColors[layer];
+    return colors;
+}
+
+
 struct VisibleTileRange
 {
     int tileWidth, tileHeight;
@@ -82,24 +159,36 @@ StructureBounds FloodFillNoProjBounds(const Tilemap& tilemap, int startX, int st
 
 } // anonymous namespace
 
+void Editor::DrawCachedOverlay(EditorContext ctx, int overlay, uint64_t key, int reach,
+                               const EditorOverlayCache::Builder& build)
+{
+    // Y-sort shades depend on the layer count
+    if (m_OverlayPaletteLayers != ctx.tilemap.GetLayerCount())
+    {
+        m_OverlayPaletteLayers = ctx.tilemap.GetLayerCount();
+        m_OverlayCache.SetPalette(BuildOverlayPalette(m_OverlayPaletteLayers));
+    }
+
+    auto vr = CalcVisibleTileRange(ctx);
+    m_OverlayCache.Draw(ctx.renderer, ctx.tilemap, overlay, key, reach, ctx.cameraPosition,
+                        vr.startX, vr.startY, vr.endX - 1, vr.endY - 1, build);
+}
+
 void Editor::RenderCollisionOverlays(EditorContext ctx)
 {
     auto vr = CalcVisibleTileRange(ctx);
 
-    // Render red overlay for each collision tile
-    for (int y = vr.startY; y < vr.endY; ++y)
-    {
-        for (int x = vr.startX; x < vr.endX; ++x)
+    // Red overlay for each collision tile
+    const glm::vec2 tileSize(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight));
+    DrawCachedOverlay(ctx, OVERLAY_COLLISION, 0, 0,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
         {
-            if (ctx.tilemap.GetTileCollision(x, y))
-            {
-                glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x, y * vr.tileHeight - ctx.cameraPosition.y);
-
-                ctx.renderer.DrawColoredRect(tilePos, glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)),
-                                            glm::vec4(1.0f, 0.0f, 0.0f, 0.5f));
-            }
-        }
-    }
+            ctx.tilemap.GetCollisionMap().ForEachCollisionInRect(x0, y0, x1, y1,
+                [&](int x, int y)
+                {
+                    rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize, COLOR_COLLISION});
+                });
+        });
 
     // Render player hitbox
     glm::vec2 playerPos = ctx.player.GetPosition();
@@ -139,29 +228,42 @@ void Editor::RenderNavigationOverlays(EditorContext ctx)
 {
     auto vr = CalcVisibleTileRange(ctx);
 
-    for (int y = vr.startY; y < vr.endY; ++y)
-    {
-        for (int x = vr.startX; x < vr.endX; ++x)
+    const glm::vec2 tileSize(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight));
+    DrawCachedOverlay(ctx, OVERLAY_NAVIGATION, 0, 0,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
         {
-            if (!ctx.tilemap.GetNavigation(x, y))
-                continue;
-
-            glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x,
-                              y * vr.tileHeight - ctx.cameraPosition.y);
-
-            ctx.renderer.DrawColoredRect(
-                tilePos,
-                glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)),
-                glm::vec4(0.0f, 1.0f, 1.0f, 0.3f));
-        }
-    }
+            ctx.tilemap.GetNavigationMap().ForEachNavigationInRect(x0, y0, x1, y1,
+                [&](int x, int y)
+                {
+                    rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize, COLOR_NAVIGATION});
+                });
+        });
 }
 
 void Editor::RenderElevationOverlays(EditorContext ctx)
 {
     auto vr = CalcVisibleTileRange(ctx);
 
-    bool perspectiveEnabled = ctx.renderer.GetPerspectiveState().enabled;
+    const glm::vec2 tileSize(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight));
+    DrawCachedOverlay(ctx, OVERLAY_ELEVATION, 0, 0,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
+        {
+            for (int y = y0; y <= y1; ++y)
+            {
+                for (int x = x0; x <= x1; ++x)
+                {
+                    int elevation = ctx.tilemap.GetElevation(x, y);
+                    if (elevation <= 0)
+                        continue;
+                    rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize,
+                                     COLOR_ELEVATION + std::min(elevation, ELEVATION_SHADES) - 1});
+                }
+            }
+        });
+
+    // Value labels are only readable without perspective
+    if (ctx.renderer.GetPerspectiveState().enabled)
+        return;
 
     for (int y = vr.startY; y < vr.endY; ++y)
     {
@@ -174,23 +276,13 @@ void Editor::RenderElevationOverlays(EditorContext ctx)
             glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x,
                               y * vr.tileHeight - ctx.cameraPosition.y);
 
-            float alpha = std::min(0.5f, static_cast<float>(elevation) / 32.0f * 0.5f + 0.15f);
-
-            ctx.renderer.DrawColoredRect(
-                tilePos,
-                glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)),
-                glm::vec4(0.8f, 0.2f, 0.8f, alpha));
-
-            if (!perspectiveEnabled)
-            {
-                std::string elevText = std::to_string(elevation);
-                float textScale = 0.2f;
-                float textWidth = elevText.length() * 8.0f * textScale;
-                float textX = tilePos.x + (vr.tileWidth - textWidth) * 0.5f;
-                float textY = tilePos.y + vr.tileHeight * 0.6f;
-                ctx.renderer.DrawText(elevText, glm::vec2(textX, textY), textScale,
-                                     glm::vec3(1.0f, 1.0f, 0.2f), 0.0f, 0.15f);
-            }
+            std::string elevText = std::to_string(elevation);
+            float textScale = 0.2f;
+            float textWidth = elevText.length() * 8.0f * textScale;
+            float textX = tilePos.x + (vr.tileWidth - textWidth) * 0.5f;
+            float textY = tilePos.y + vr.tileHeight * 0.6f;
+            ctx.renderer.DrawText(elevText, glm::vec2(textX, textY), textScale,
+                                 glm::vec3(1.0f, 1.0f, 0.2f), 0.0f, 0.15f);
         }
     }
 }
@@ -557,66 +649,54 @@ void Editor::RenderStructureOverlays(EditorContext ctx)
 
 void Editor::RenderLayerFlagOverlays(EditorContext ctx, bool editMode,
                                       bool (Tilemap::*getter)(int, int, size_t) const,
-                                      const glm::vec3& color)
+                                      int overlay, int colorBase)
 {
     auto vr = CalcVisibleTileRange(ctx);
 
-    for (int y = vr.startY; y < vr.endY; ++y)
-    {
-        for (int x = vr.startX; x < vr.endX; ++x)
+    const glm::vec2 tileSize(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight));
+    const uint64_t key = editMode ? static_cast<uint64_t>(m_CurrentLayer) + 1 : 0;
+    DrawCachedOverlay(ctx, overlay, key, 0,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
         {
-            if (editMode)
+            for (int y = y0; y <= y1; ++y)
             {
-                if (!(ctx.tilemap.*getter)(x, y, m_CurrentLayer))
-                    continue;
-
-                glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x,
-                                  y * vr.tileHeight - ctx.cameraPosition.y);
-
-                ctx.renderer.DrawColoredRect(
-                    tilePos,
-                    glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)),
-                    glm::vec4(color, 0.5f));
-            }
-            else
-            {
-                int count = 0;
-                size_t layerCount = ctx.tilemap.GetLayerCount();
-                for (size_t layer = 0; layer < layerCount; ++layer)
+                for (int x = x0; x <= x1; ++x)
                 {
-                    if ((ctx.tilemap.*getter)(x, y, layer))
-                        count++;
-                }
-
-                if (count == 0)
-                    continue;
-
-                glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x,
-                                  y * vr.tileHeight - ctx.cameraPosition.y);
+                    if (editMode)
+                    {
+                        if ((ctx.tilemap.*getter)(x, y, m_CurrentLayer))
+                            rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize, colorBase});
+                        continue;
+                    }
 
-                float alpha = 0.15f + (static_cast<float>(count) / static_cast<float>(layerCount)) * 0.35f;
+                    int count = 0;
+                    size_t layerCount = ctx.tilemap.GetLayerCount();
+                    for (size_t layer = 0; layer < layerCount; ++layer)
+                    {
+                        if ((ctx.tilemap.*getter)(x, y, layer))
+                            count++;
+                    }
 
-                ctx.renderer.DrawColoredRect(
-                    tilePos,
-                    glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)),
-                    glm::vec4(color, alpha));
+                    if (count > 0)
+                        rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize,
+                                         colorBase + std::min(count, MAX_FLAG_LAYERS)});
+                }
             }
-        }
-    }
+        });
 }
 
 void Editor::RenderYSortPlusOverlays(EditorContext ctx)
 {
     RenderLayerFlagOverlays(ctx, m_YSortPlusEditMode,
                             &Tilemap::GetLayerYSortPlus,
-                            glm::vec3(0.0f, 0.8f, 0.8f));
+                            OVERLAY_YSORT_PLUS, COLOR_YSORT_PLUS);
 }
 
 void Editor::RenderYSortMinusOverlays(EditorContext ctx)
 {
     RenderLayerFlagOverlays(ctx, m_YSortMinusEditMode,
                             &Tilemap::GetLayerYSortMinus,
-                            glm::vec3(0.9f, 0.2f, 0.9f));
+                            OVERLAY_YSORT_MINUS, COLOR_YSORT_MINUS);
 }
 
 void Editor::RenderParticleZoneOverlays(EditorContext ctx)
@@ -693,7 +773,7 @@ void Editor::RenderParticleZoneOverlays(EditorContext ctx)
     {
         // Get current mouse position in world coordinates
         double mouseX, mouseY;
-        glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+        ctx.input.GetCursorPos(mouseX, mouseY);
 
         float worldX = (static_cast<float>(mouseX) / static_cast<float>(ctx.screenWidth)) * worldWidth + ctx.cameraPosition.x;
         float worldY = (static_cast<float>(mouseY) / static_cast<float>(ctx.screenHeight)) * worldHeight + ctx.cameraPosition.y;
@@ -756,8 +836,8 @@ void Editor::RenderNPCDebugInfo(EditorContext ctx)
                                         glm::vec4(1.0f, 0.0f, 1.0f, 0.3f));
         }
 
-        int targetX = npc.m_TargetTileX;
-        int targetY = npc.m_TargetTileY;
+        int targetX = npc.GetTargetTile().x;
+        int targetY = npc.GetTargetTile().y;
 
         glm::vec2 targetPos(targetX * vr.tileWidth - ctx.cameraPosition.x + vr.tileWidth * 0.5f,
                             targetY * vr.tileHeight - ctx.cameraPosition.y + vr.tileHeight * 0.5f);
@@ -791,137 +871,134 @@ void Editor::RenderCornerCuttingOverlays(EditorContext ctx)
     // Running allows center-point collision penetration up to hitbox edge
     float runningEdgePenetration = HITBOX_HALF; // 8 pixels
 
-    // Render collision tolerance zones for all collision tiles
-    for (int y = vr.startY; y < vr.endY; ++y)
-    {
-        for (int x = vr.startX; x < vr.endX; ++x)
+    // Collision tolerance zones for all collision tiles; they read the neighbouring blocks' collision
+    DrawCachedOverlay(ctx, OVERLAY_CORNER_CUTTING, 0, 1,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
         {
-            if (!ctx.tilemap.GetTileCollision(x, y))
-                continue;
-
-            glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x, y * vr.tileHeight - ctx.cameraPosition.y);
-
-            // Check adjacency for this tile to determine valid exposed corners and edges
-            bool freeLeft = (x > 0) && !ctx.tilemap.GetTileCollision(x - 1, y);
-            bool freeRight = (x < ctx.tilemap.GetMapWidth() - 1) && !ctx.tilemap.GetTileCollision(x + 1, y);
-            bool freeTop = (y > 0) && !ctx.tilemap.GetTileCollision(x, y - 1);
-            bool freeBottom = (y < ctx.tilemap.GetMapHeight() - 1) && !ctx.tilemap.GetTileCollision(x, y + 1);
-
-            // Left Edge
-            if (freeLeft)
-            {
-                ctx.renderer.DrawColoredRect(
-                    glm::vec2(tilePos.x, tilePos.y),
-                    glm::vec2(runningEdgePenetration, TILE_SIZE),
-                    glm::vec4(1.0f, 0.6f, 0.2f, 0.5f));
-            }
-            // Right Edge
-            if (freeRight)
-            {
-                ctx.renderer.DrawColoredRect(
-                    glm::vec2(tilePos.x + TILE_SIZE - runningEdgePenetration, tilePos.y),
-                    glm::vec2(runningEdgePenetration, TILE_SIZE),
-                    glm::vec4(1.0f, 0.6f, 0.2f, 0.5f));
-            }
-            // Top Edge
-            if (freeTop)
-            {
-                ctx.renderer.DrawColoredRect(
-                    glm::vec2(tilePos.x, tilePos.y),
-                    glm::vec2(TILE_SIZE, runningEdgePenetration),
-                    glm::vec4(1.0f, 0.6f, 0.2f, 0.5f));
-            }
-            // Bottom Edge
-            if (freeBottom)
-            {
-                ctx.renderer.DrawColoredRect(
-                    glm::vec2(tilePos.x, tilePos.y + TILE_SIZE - runningEdgePenetration),
-                    glm::vec2(TILE_SIZE, runningEdgePenetration),
-                    glm::vec4(1.0f, 0.6f, 0.2f, 0.5f));
-            }
-
-            struct CornerInfo
-            {
-                int dx, dy;                 // Diagonal direction to check
-                float x, y;                 // Screen position of overlap zone
-                bool isValid;               // Is this a valid exposed corner?
-                Tilemap::Corner cornerEnum; // Which corner this is
-            };
-
-            // Check which corners have cutting blocked
-            bool tlBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_TL);
-            bool trBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_TR);
-            bool blBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_BL);
-            bool brBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_BR);
-
-            CornerInfo corners[4] = {
-                // Top-Left: Valid if Left & Top are free
-                {-1, -1, tilePos.x, tilePos.y, freeLeft && freeTop, Tilemap::CORNER_TL},
-                // Top-Right: Valid if Right & Top are free
-                {1, -1, tilePos.x + TILE_SIZE, tilePos.y, freeRight && freeTop, Tilemap::CORNER_TR},
-                // Bottom-Left: Valid if Left & Bottom are free
-                {-1, 1, tilePos.x, tilePos.y + TILE_SIZE, freeLeft && freeBottom, Tilemap::CORNER_BL},
-                // Bottom-Right: Valid if Right & Bottom are free
-                {1, 1, tilePos.x + TILE_SIZE, tilePos.y + TILE_SIZE, freeRight && freeBottom, Tilemap::CORNER_BR}};
-
-            bool cornerBlocked[4] = {tlBlocked, trBlocked, blBlocked, brBlocked};
-
-            for (int i = 0; i < 4; ++i)
-            {
-                const auto &corner = corners[i];
-
-                // Straight walls and internal corners have strictly no penetration
-                if (!corner.isValid)
-                    continue;
-
-                int nx = x + corner.dx;
-                int ny = y + corner.dy;
-
-                // Only render if diagonal neighbor is walkable otherwise no escape path
-                if (nx >= 0 && ny >= 0 &&
-                    nx < ctx.tilemap.GetMapWidth() &&
-                    ny < ctx.tilemap.GetMapHeight() &&
-                    !ctx.tilemap.GetTileCollision(nx, ny))
+            ctx.tilemap.GetCollisionMap().ForEachCollisionInRect(x0, y0, x1, y1,
+                [&](int x, int y)
                 {
-                    // Calculate positions based on corner direction
-                    float walkX = (corner.dx == -1) ? corner.x : corner.x - walkingCornerPenetration;
-                    float walkY = (corner.dy == -1) ? corner.y : corner.y - walkingCornerPenetration;
+                    glm::vec2 tilePos(static_cast<float>(x * vr.tileWidth), static_cast<float>(y * vr.tileHeight));
+
+                    // Check adjacency for this tile to determine valid exposed corners and edges
+                    bool freeLeft = (x > 0) && !ctx.tilemap.GetTileCollision(x - 1, y);
+                    bool freeRight = (x < ctx.tilemap.GetMapWidth() - 1) && !ctx.tilemap.GetTileCollision(x + 1, y);
+                    bool freeTop = (y > 0) && !ctx.tilemap.GetTileCollision(x, y - 1);
+                    bool freeBottom = (y < ctx.tilemap.GetMapHeight() - 1) && !ctx.tilemap.GetTileCollision(x, y + 1);
 
-                    if (cornerBlocked[i])
+                    // Left Edge
+                    if (freeLeft)
                     {
-                        // Draw red indicator for blocked corner cutting
-                        ctx.renderer.DrawColoredRect(
-                            glm::vec2(walkX, walkY),
-                            glm::vec2(walkingCornerPenetration, walkingCornerPenetration),
-                            glm::vec4(1.0f, 0.2f, 0.2f, 0.9f));
+                        rects.push_back({glm::vec2(tilePos.x, tilePos.y),
+                            glm::vec2(runningEdgePenetration, TILE_SIZE),
+                            COLOR_CORNER_EDGE});
                     }
-                    else
+                    // Right Edge
+                    if (freeRight)
                     {
-                        // Draw green walking corner penetration zone (normal)
-                        ctx.renderer.DrawColoredRect(
-                            glm::vec2(walkX, walkY),
-                            glm::vec2(walkingCornerPenetration, walkingCornerPenetration),
-                            glm::vec4(0.5f, 1.0f, 0.0f, 0.8f));
+                        rects.push_back({glm::vec2(tilePos.x + TILE_SIZE - runningEdgePenetration, tilePos.y),
+                            glm::vec2(runningEdgePenetration, TILE_SIZE),
+                            COLOR_CORNER_EDGE});
                     }
-                }
-            }
-        }
-    }
+                    // Top Edge
+                    if (freeTop)
+                    {
+                        rects.push_back({glm::vec2(tilePos.x, tilePos.y),
+                            glm::vec2(TILE_SIZE, runningEdgePenetration),
+                            COLOR_CORNER_EDGE});
+                    }
+                    // Bottom Edge
+                    if (freeBottom)
+                    {
+                        rects.push_back({glm::vec2(tilePos.x, tilePos.y + TILE_SIZE - runningEdgePenetration),
+                            glm::vec2(TILE_SIZE, runningEdgePenetration),
+                            COLOR_CORNER_EDGE});
+                    }
+
+                    struct CornerInfo
+                    {
+                        int dx, dy;                 // Diagonal direction to check
+                        float x, y;                 // World position of overlap zone
+                        bool isValid;               // Is this a valid exposed corner?
+                        Tilemap::Corner cornerEnum; // Which corner this is
+                    };
+
+                    // Check which corners have cutting blocked
+                    bool tlBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_TL);
+                    bool trBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_TR);
+                    bool blBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_BL);
+                    bool brBlocked = ctx.tilemap.IsCornerCutBlocked(x, y, Tilemap::CORNER_BR);
+
+                    CornerInfo corners[4] = {
+                        // Top-Left: Valid if Left & Top are free
+                        {-1, -1, tilePos.x, tilePos.y, freeLeft && freeTop, Tilemap::CORNER_TL},
+                        // Top-Right: Valid if Right & Top are free
+                        {1, -1, tilePos.x + TILE_SIZE, tilePos.y, freeRight && freeTop, Tilemap::CORNER_TR},
+                        // Bottom-Left: Valid if Left & Bottom are free
+                        {-1, 1, tilePos.x, tilePos.y + TILE_SIZE, freeLeft && freeBottom, Tilemap::CORNER_BL},
+                        // Bottom-Right: Valid if Right & Bottom are free
+                        {1, 1, tilePos.x + TILE_SIZE, tilePos.y + TILE_SIZE, freeRight && freeBottom, Tilemap::CORNER_BR}};
+
+                    bool cornerBlocked[4] = {tlBlocked, trBlocked, blBlocked, brBlocked};
+
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const auto &corner = corners[i];
+
+                        // Straight walls and internal corners have strictly no penetration
+                        if (!corner.isValid)
+                            continue;
+
+                        int nx = x + corner.dx;
+                        int ny = y + corner.dy;
+
+                        // Only render if diagonal neighbor is walkable otherwise no escape path
+                        if (nx >= 0 && ny >= 0 &&
+                            nx < ctx.tilemap.GetMapWidth() &&
+                            ny < ctx.tilemap.GetMapHeight() &&
+                            !ctx.tilemap.GetTileCollision(nx, ny))
+                        {
+                            // Calculate positions based on corner direction
+                            float walkX = (corner.dx == -1) ? corner.x : corner.x - walkingCornerPenetration;
+                            float walkY = (corner.dy == -1) ? corner.y : corner.y - walkingCornerPenetration;
+
+                            if (cornerBlocked[i])
+                            {
+                                // Draw red indicator for blocked corner cutting
+                                rects.push_back({glm::vec2(walkX, walkY),
+                                    glm::vec2(walkingCornerPenetration, walkingCornerPenetration),
+                                    COLOR_CORNER_BLOCKED});
+                            }
+                            else
+                            {
+                                // Draw green walking corner penetration zone (normal)
+                                rects.push_back({glm::vec2(walkX, walkY),
+                                    glm::vec2(walkingCornerPenetration, walkingCornerPenetration),
+                                    COLOR_CORNER_OPEN});
+                            }
+                        }
+                    }
+                });
+        });
 }
 
-void Editor::RenderLayerOverlay(EditorContext ctx, int layerIndex, const glm::vec4& color)
+void Editor::RenderLayerOverlay(EditorContext ctx, int layerIndex)
 {
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(std::size(kLayerColors)))
+        return;
+
     auto vr = CalcVisibleTileRange(ctx);
 
-    for (int y = vr.startY; y < vr.endY; ++y)
-        for (int x = vr.startX; x < vr.endX; ++x)
-            if (ctx.tilemap.GetLayerTile(x, y, layerIndex) >= 0)
-            {
-                glm::vec2 tilePos(x * vr.tileWidth - ctx.cameraPosition.x,
-                                  y * vr.tileHeight - ctx.cameraPosition.y);
-                ctx.renderer.DrawColoredRect(tilePos,
-                    glm::vec2(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight)), color);
-            }
+    const glm::vec2 tileSize(static_cast<float>(vr.tileWidth), static_cast<float>(vr.tileHeight));
+    DrawCachedOverlay(ctx, OVERLAY_LAYER + layerIndex, 0, 0,
+        [&](int x0, int y0, int x1, int y1, std::vector<EditorOverlayCache::Rect>& rects)
+        {
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x)
+                    if (ctx.tilemap.GetLayerTile(x, y, layerIndex) >= 0)
+                        rects.push_back({glm::vec2(x * vr.tileWidth, y * vr.tileHeight), tileSize,
+                                         COLOR_LAYER + layerIndex});
+        });
 }
 
 void Editor::RenderEditorUI(EditorContext ctx)
@@ -950,50 +1027,38 @@ void Editor::RenderEditorUI(EditorContext ctx)
     float worldPickerWidth = (tilePickerWidth / ctx.screenWidth) * worldWidth;
     float worldPickerHeight = (tilePickerHeight / ctx.screenHeight) * worldHeight;
 
-    // Background
-    ctx.renderer.DrawColoredRect(glm::vec2(0.0f, 0.0f),
-                                glm::vec2(worldPickerWidth, worldPickerHeight),
-                                glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
-
-    // Render only visible tiles, cull off-screen tiles
-    int startCol = std::max(0, static_cast<int>(std::floor((-m_TilePickerOffsetX) / tileSizePixels)));
-    int endCol = std::min(tilesPerRow - 1, static_cast<int>(std::floor((ctx.screenWidth - m_TilePickerOffsetX) / tileSizePixels)));
-    int startRow = std::max(0, static_cast<int>(std::floor((-m_TilePickerOffsetY) / tileSizePixels)));
-    int endRow = std::min(dataTilesPerCol - 1, static_cast<int>(std::floor((ctx.screenHeight - m_TilePickerOffsetY) / tileSizePixels)));
-
-    for (int row = startRow; row <= endRow; ++row)
+    // The background and tiles only change with zoom, scroll and the tileset,
+    // so they are baked once and composited; the selection is drawn on top
+    if (UpdateTilePickerCache(ctx, tileSizePixels, worldWidth, worldHeight))
     {
-        for (int col = startCol; col <= endCol; ++col)
-        {
-            int tileID = row * tilesPerRow + col;
-            if (tileID < 0 || tileID >= totalTiles)
-                continue;
-
-            if (ctx.tilemap.IsTileTransparent(tileID))
-                continue;
-
-            float screenX = col * tileSizePixels + m_TilePickerOffsetX;
-            float screenY = row * tileSizePixels + m_TilePickerOffsetY;
-
-            float worldX = (screenX / ctx.screenWidth) * worldWidth;
-            float worldY = (screenY / ctx.screenHeight) * worldHeight;
-            float worldTileSize = (tileSizePixels / ctx.screenWidth) * worldWidth;
-
-            int tilesetX = col * ctx.tilemap.GetTileWidth();
-            int tilesetY = row * ctx.tilemap.GetTileHeight();
-
-            glm::vec2 texCoord(static_cast<float>(tilesetX), static_cast<float>(tilesetY));
-            glm::vec2 texSize(ctx.tilemap.GetTileWidth(), ctx.tilemap.GetTileHeight());
-
-            glm::vec3 color = (tileID == m_SelectedTileID) ? glm::vec3(1.5f, 1.5f, 1.0f) : glm::vec3(1.0f);
-
-            // Query renderer at runtime for Y-flip (OpenGL=true, Vulkan=false)
-            bool flipY = ctx.renderer.RequiresYFlip();
+        ctx.renderer.DrawRenderTarget(m_PickerTarget, glm::vec2(0.0f),
+                                      glm::vec2(worldPickerWidth, worldPickerHeight), false);
+    }
+    else
+    {
+        ctx.renderer.DrawColoredRect(glm::vec2(0.0f, 0.0f),
+                                    glm::vec2(worldPickerWidth, worldPickerHeight),
+                                    glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+        DrawTilePickerTiles(ctx, tileSizePixels, worldWidth, worldHeight);
+    }
 
-            ctx.renderer.DrawSpriteRegion(ctx.tilemap.GetTilesetTexture(), glm::vec2(worldX, worldY),
-                                         glm::vec2(worldTileSize, worldTileSize),
-                                         texCoord, texSize, 0.0f, color, flipY);
-        }
+    // Selected tile highlight
+    if (m_SelectedTileID >= 0 && m_SelectedTileID < totalTiles && !ctx.tilemap.IsTileTransparent(m_SelectedTileID))
+    {
+        int col = m_SelectedTileID % tilesPerRow;
+        int row = m_SelectedTileID / tilesPerRow;
+
+        float worldX = ((col * tileSizePixels + m_TilePickerOffsetX) / ctx.screenWidth) * worldWidth;
+        float worldY = ((row * tileSizePixels + m_TilePickerOffsetY) / ctx.screenHeight) * worldHeight;
+        float worldTileSize = (tileSizePixels / ctx.screenWidth) * worldWidth;
+
+        glm::vec2 texCoord(static_cast<float>(col * ctx.tilemap.GetTileWidth()),
+                           static_cast<float>(row * ctx.tilemap.GetTileHeight()));
+        glm::vec2 texSize(ctx.tilemap.GetTileWidth(), ctx.tilemap.GetTileHeight());
+        ctx.renderer.DrawSpriteRegion(ctx.tilemap.GetTilesetTexture(), glm::vec2(worldX, worldY),
+                                     glm::vec2(worldTileSize, worldTileSize),
+                                     texCoord, texSize, 0.0f, glm::vec3(1.5f, 1.5f, 1.0f),
+                                     ctx.renderer.RequiresYFlip());
     }
 
     // Selection rectangle
@@ -1097,6 +1162,115 @@ void Editor::RenderEditorUI(EditorContext ctx)
     }
 }
 
+void Editor::DrawTilePickerTiles(EditorContext ctx, float tileSizePixels, float worldWidth, float worldHeight)
+{
+    int tilesPerRow = ctx.tilemap.GetTilesetDataWidth() / ctx.tilemap.GetTileWidth();
+    int dataTilesPerCol = ctx.tilemap.GetTilesetDataHeight() / ctx.tilemap.GetTileHeight();
+    int totalTiles = tilesPerRow * dataTilesPerCol;
+
+    // Render only visible tiles, cull off-screen tiles
+    int startCol = std::max(0, static_cast<int>(std::floor((-m_TilePickerOffsetX) / tileSizePixels)));
+    int endCol = std::min(tilesPerRow - 1, static_cast<int>(std::floor((ctx.screenWidth - m_TilePickerOffsetX) / tileSizePixels)));
+    int startRow = std::max(0, static_cast<int>(std::floor((-m_TilePickerOffsetY) / tileSizePixels)));
+    int endRow = std::min(dataTilesPerCol - 1, static_cast<int>(std::floor((ctx.screenHeight - m_TilePickerOffsetY) / tileSizePixels)));
+
+    for (int row = startRow; row <= endRow; ++row)
+    {
+        for (int col = startCol; col <= endCol; ++col)
+        {
+            int tileID = row * tilesPerRow + col;
+            if (tileID < 0 || tileID >= totalTiles)
+                continue;
+
+            if (ctx.tilemap.IsTileTransparent(tileID))
+                continue;
+
+            float screenX = col * tileSizePixels + m_TilePickerOffsetX;
+            float screenY = row * tileSizePixels + m_TilePickerOffsetY;
+
+            float worldX = (screenX / ctx.screenWidth) * worldWidth;
+            float worldY = (screenY / ctx.screenHeight) * worldHeight;
+            float worldTileSize = (tileSizePixels / ctx.screenWidth) * worldWidth;
+
+            int tilesetX = col * ctx.tilemap.GetTileWidth();
+            int tilesetY = row * ctx.tilemap.GetTileHeight();
+
+            glm::vec2 texCoord(static_cast<float>(tilesetX), static_cast<float>(tilesetY));
+            glm::vec2 texSize(ctx.tilemap.GetTileWidth(), ctx.tilemap.GetTileHeight());
+
+            // Query renderer at runtime for Y-flip (OpenGL=true, Vulkan=false)
+            bool flipY = ctx.renderer.RequiresYFlip();
+
+            ctx.renderer.DrawSpriteRegion(ctx.tilemap.GetTilesetTexture(), glm::vec2(worldX, worldY),
+                                         glm::vec2(worldTileSize, worldTileSize),
+                                         texCoord, texSize, 0.0f, glm::vec3(1.0f), flipY);
+        }
+    }
+}
+
+bool Editor::UpdateTilePickerCache(EditorContext ctx, float tileSizePixels, float worldWidth, float worldHeight)
+{
+    if (m_PickerRenderer != &ctx.renderer)
+    {
+        // A new backend may support render targets where the old one did not
+        m_PickerTarget = -1;
+        m_PickerCacheEnabled = true;
+        m_PickerCacheValid = false;
+        m_PickerRenderer = &ctx.renderer;
+    }
+    if (!m_PickerCacheEnabled)
+        return false;
+
+    if (m_PickerTarget < 0 || ctx.screenWidth != m_PickerTargetWidth || ctx.screenHeight != m_PickerTargetHeight)
+    {
+        if (m_PickerTarget >= 0)
+            ctx.renderer.DestroyRenderTarget(m_PickerTarget);
+        m_PickerTarget = ctx.renderer.CreateRenderTarget(ctx.screenWidth, ctx.screenHeight);
+        m_PickerTargetWidth = ctx.screenWidth;
+        m_PickerTargetHeight = ctx.screenHeight;
+        m_PickerCacheValid = false;
+        if (m_PickerTarget < 0)
+        {
+            // No offscreen support in this backend, draw tiles directly until the next switch
+            m_PickerCacheEnabled = false;
+            return false;
+        }
+    }
+
+    const TilePickerBake bake{m_TilePickerZoom, m_TilePickerOffsetX, m_TilePickerOffsetY,
+                              ctx.screenWidth, ctx.screenHeight,
+                              ctx.tilesVisibleWidth, ctx.tilesVisibleHeight,
+                              ctx.tilemap.GetTilesetRevision()};
+    if (m_PickerCacheValid && bake == m_PickerBake)
+        return true;
+
+    if (!ctx.renderer.BeginRenderTarget(m_PickerTarget))
+    {
+        m_PickerCacheValid = false;
+        return false;
+    }
+    // The opaque background leaves every texel at full alpha, so the
+    // premultiplied composite reproduces the direct draw exactly
+    ctx.renderer.DrawColoredRect(glm::vec2(0.0f, 0.0f), glm::vec2(worldWidth, worldHeight),
+                                 glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+    DrawTilePickerTiles(ctx, tileSizePixels, worldWidth, worldHeight);
+    ctx.renderer.EndRenderTarget();
+
+    m_PickerBake = bake;
+    m_PickerCacheValid = true;
+    return true;
+}
+
+void Editor::ReleaseOverlayMeshes()
+{
+    m_OverlayCache.Release();
+    if (m_PickerRenderer && m_PickerTarget >= 0)
+        m_PickerRenderer->DestroyRenderTarget(m_PickerTarget);
+    m_PickerTarget = -1;
+    m_PickerCacheValid = false;
+    m_PickerRenderer = nullptr;
+}
+
 void Editor::RenderPlacementPreview(EditorContext ctx)
 {
     // Draw animation mode status when not in tile picker
@@ -1113,7 +1287,7 @@ void Editor::RenderPlacementPreview(EditorContext ctx)
         return;
 
     double mouseX, mouseY;
-    glfwGetCursorPos(ctx.window, &mouseX, &mouseY);
+    ctx.input.GetCursorPos(mouseX, mouseY);
 
     // Convert screen coordinates to world coordinates
     float baseWorldWidth = static_cast<float>(ctx.tilesVisibleWidth * ctx.tilemap.GetTileWidth());
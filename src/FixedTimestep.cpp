@@ -0,0 +1,38 @@
+#include "FixedTimestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+void FixedTimestep::SetStep(float seconds)
+{
+    m_Step = seconds > 0.0f ? seconds : DEFAULT_STEP;
+    // Keep the alpha meaningful for the new step
+    m_Accumulator = std::fmod(m_Accumulator, static_cast<double>(m_Step));
+}
+
+int FixedTimestep::Advance(float frameTime)
+{
+    if (frameTime > 0.0f)
+    {
+        m_Accumulator += frameTime;
+    }
+
+    const double step = m_Step;
+    // Tolerate rounding so a frame of exactly one step always yields one
+    const double epsilon = step * 1e-6;
+    int steps = static_cast<int>(std::floor((m_Accumulator + epsilon) / step));
+    m_Accumulator = std::max(0.0, m_Accumulator - steps * step);
+
+    if (steps > m_MaxSteps)
+    {
+        m_DroppedSteps += steps - m_MaxSteps;
+        steps = m_MaxSteps;
+    }
+    return steps;
+}
+
+void FixedTimestep::Reset()
+{
+    m_Accumulator = 0.0;
+    m_DroppedSteps = 0;
+}
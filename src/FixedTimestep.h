@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @class FixedTimestep
+ * @brief Accumulator that turns variable frame times into whole simulation steps.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Every rendered frame hands its wall-clock time to Advance(), which
+ * returns how many fixed steps the simulation should run. The time that
+ * does not fill a whole step stays in the accumulator; GetAlpha() is that
+ * remainder as a fraction of a step, used to blend the last two simulated
+ * states for drawing:
+ *
+ * @f[
+ * render = previous + (current - previous) \times \alpha
+ * @f]
+ *
+ * At 144 Hz rendering and a 60 Hz step most frames run zero or one step,
+ * so simulation cost no longer scales with the render rate. A machine that
+ * renders slower than the step runs several steps per frame.
+ *
+ * @par Spiral of Death
+ * If a frame would need more than the step limit (a stall, or a machine
+ * that cannot keep up with the simulation), the excess time is dropped and
+ * counted in GetDroppedSteps(), so the game slows down rather than
+ * falling further behind each frame.
+ *
+ * @par Example
+ * @code{.cpp}
+ * const int steps = timestep.Advance(frameTime);
+ * for (int i = 0; i < steps; ++i)
+ *     Simulate(timestep.GetStep());
+ * Draw(timestep.GetAlpha());
+ * @endcode
+ *
+ * @par Thread Safety
+ * Not thread-safe.
+ *
+ * @see Game::Run()
+ */
+class FixedTimestep
+{
+public:
+    /// @brief Default simulation rate (60 Hz).
+    static constexpr float DEFAULT_STEP = 1.0f / 60.0f;
+
+    /// @brief Default upper bound on steps per Advance().
+    static constexpr int DEFAULT_MAX_STEPS = 8;
+
+    /// @brief Set the step length in seconds (non-positive values restore the default).
+    void SetStep(float seconds);
+
+    /// @brief Step length in seconds.
+    [[nodiscard]] float GetStep() const { return m_Step; }
+
+    /// @brief Set the maximum steps one Advance() may return (at least 1).
+    void SetMaxSteps(int steps) { m_MaxSteps = steps > 0 ? steps : 1; }
+
+    /**
+     * @brief Add a frame's time and take the whole steps it completes.
+     * @param frameTime Wall-clock seconds since the previous call (negative counts as 0).
+     * @return Number of steps to simulate this frame.
+     */
+    int Advance(float frameTime);
+
+    /// @brief Leftover time as a fraction of a step, in [0, 1).
+    [[nodiscard]] float GetAlpha() const { return static_cast<float>(m_Accumulator / m_Step); }
+
+    /// @brief Steps discarded by the step limit since construction or Reset().
+    [[nodiscard]] long long GetDroppedSteps() const { return m_DroppedSteps; }
+
+    /// @brief Forget the accumulated time and dropped-step count.
+    void Reset();
+
+private:
+    double m_Accumulator = 0.0;  ///< Seconds not yet simulated, < one step after Advance()
+    float m_Step = DEFAULT_STEP;
+    int m_MaxSteps = DEFAULT_MAX_STEPS;
+    long long m_DroppedSteps = 0;
+};
@@ -0,0 +1,110 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace
+{
+constexpr std::size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+std::size_t AlignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+}  // namespace
+
+FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource *upstream)
+    : m_Upstream(upstream),
+      m_Capacity(capacity)
+{
+    if (m_Capacity > 0)
+        m_Block = static_cast<std::byte *>(m_Upstream->allocate(m_Capacity, BLOCK_ALIGNMENT));
+}
+
+FrameArena::~FrameArena()
+{
+    ReleaseOverflow();
+    if (m_Block)
+        m_Upstream->deallocate(m_Block, m_Capacity, BLOCK_ALIGNMENT);
+}
+
+void FrameArena::Reset()
+{
+    const std::size_t used = GetUsedBytes();
+    m_Peak = std::max(m_Peak, used);
+
+    if (m_Overflow)
+    {
+        ReleaseOverflow();
+
+        // Grow so the same frame fits next time
+        const std::size_t capacity = std::bit_ceil(used);
+        if (m_Block)
+            m_Upstream->deallocate(m_Block, m_Capacity, BLOCK_ALIGNMENT);
+        m_Block = static_cast<std::byte *>(m_Upstream->allocate(capacity, BLOCK_ALIGNMENT));
+        m_Capacity = capacity;
+    }
+
+    m_Used = 0;
+    m_OverflowBytes = 0;
+}
+
+FrameArena &FrameArena::ThisThread()
+{
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void *FrameArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (m_Block)
+    {
+        const auto base = reinterpret_cast<std::uintptr_t>(m_Block);
+        const std::size_t offset = AlignUp(base + m_Used, alignment) - base;
+        if (offset + bytes <= m_Capacity)
+        {
+            m_Used = offset + bytes;
+            return m_Block + offset;
+        }
+    }
+    return AllocateOverflow(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void *, std::size_t, std::size_t)
+{
+    // Memory is reclaimed by Reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource &other) const noexcept
+{
+    return this == &other;
+}
+
+void *FrameArena::AllocateOverflow(std::size_t bytes, std::size_t alignment)
+{
+    // One chunk per allocation; the header is padded so the payload keeps its alignment
+    const std::size_t align = std::max(alignment, alignof(Chunk));
+    const std::size_t header = AlignUp(sizeof(Chunk), align);
+    const std::size_t size = header + bytes;
+
+    auto *chunk = static_cast<Chunk *>(m_Upstream->allocate(size, align));
+    chunk->next = m_Overflow;
+    chunk->size = size;
+    chunk->alignment = align;
+    m_Overflow = chunk;
+
+    m_OverflowBytes += bytes;
+    ++m_OverflowCount;
+    return reinterpret_cast<std::byte *>(chunk) + header;
+}
+
+void FrameArena::ReleaseOverflow()
+{
+    while (m_Overflow)
+    {
+        Chunk *next = m_Overflow->next;
+        m_Upstream->deallocate(m_Overflow, m_Overflow->size, m_Overflow->alignment);
+        m_Overflow = next;
+    }
+}
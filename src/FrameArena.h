@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameArena
+ * @brief Linear allocator for containers that live for one frame.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Allocation bumps a cursor in one block; deallocation does nothing and
+ * Reset() rewinds the cursor at the start of the next frame. Containers
+ * take the arena through the std::pmr adaptors:
+ *
+ * @code{.cpp}
+ * FrameVector<size_t> order(&FrameArena::ThisThread());
+ * order.reserve(m_Layers.size());
+ * @endcode
+ *
+ * @par Overflow
+ * A frame that outgrows the block takes extra chunks from the upstream
+ * resource. Reset() returns them and grows the block to the next power of
+ * two above the frame's usage, so after the first few frames a scene runs
+ * out of a single block with no heap traffic. GetOverflowCount() reports
+ * the chunks taken since startup.
+ *
+ * @par Lifetime
+ * Anything allocated from the arena is invalid after the next Reset().
+ * Keep frame containers on the stack of the code that renders them; never
+ * store them in members or hand them to another frame.
+ *
+ * @par Thread Safety
+ * An arena is used by one thread. ThisThread() gives each thread its own;
+ * the game resets the main thread's arena once per frame.
+ */
+class FrameArena : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY,
+                        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena &) = delete;
+    FrameArena &operator=(const FrameArena &) = delete;
+
+    /**
+     * @brief Release everything allocated since the last reset.
+     *
+     * Frees overflow chunks and, if there were any, replaces the block with
+     * one large enough for the frame that just ended.
+     */
+    void Reset();
+
+    /// @brief Bytes handed out since the last reset, including overflow.
+    [[nodiscard]] std::size_t GetUsedBytes() const { return m_Used + m_OverflowBytes; }
+
+    /// @brief Size of the primary block.
+    [[nodiscard]] std::size_t GetCapacity() const { return m_Capacity; }
+
+    /// @brief Largest GetUsedBytes() seen at a reset.
+    [[nodiscard]] std::size_t GetPeakBytes() const { return m_Peak; }
+
+    /// @brief Overflow chunks taken from upstream since construction.
+    [[nodiscard]] std::size_t GetOverflowCount() const { return m_OverflowCount; }
+
+    /// @brief The calling thread's arena.
+    [[nodiscard]] static FrameArena &ThisThread();
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+private:
+    struct Chunk
+    {
+        Chunk *next;
+        std::size_t size;
+        std::size_t alignment;
+    };
+
+    void *AllocateOverflow(std::size_t bytes, std::size_t alignment);
+    void ReleaseOverflow();
+
+    std::pmr::memory_resource *m_Upstream;
+    std::byte *m_Block = nullptr;
+    std::size_t m_Capacity = 0;
+    std::size_t m_Used = 0;
+    std::size_t m_Peak = 0;
+
+    Chunk *m_Overflow = nullptr;        ///< Chunks taken this frame, newest first
+    std::size_t m_OverflowBytes = 0;    ///< Bytes handed out from those chunks
+    std::size_t m_OverflowCount = 0;
+};
+
+/// Vector whose storage comes from a FrameArena.
+template <class T>
+using FrameVector = std::pmr::vector<T>;
+
+/// String whose storage comes from a FrameArena.
+using FrameString = std::pmr::string;
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @class FrameLruCache
+ * @brief Bounded map that evicts the least recently used entry, never one used this frame.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Holds GPU objects keyed by another handle, such as the Vulkan descriptor
+ * set of each image view. Find() moves an entry to the front of the
+ * recency list and stamps it with the current frame:
+ *
+ * @code
+ *   front                                       back
+ *   [view 7, frame 12] [view 3, frame 12] ... [view 9, frame 4]
+ *                                               ^ EvictOldest() takes this one
+ * @endcode
+ *
+ * @par Eviction
+ * The cache never drops entries by itself; the owner calls EvictOldest()
+ * when Full() and releases the returned value. An entry touched since the
+ * last NextFrame() may already be referenced by commands recorded this
+ * frame, so EvictOldest() refuses it. The caller then falls back to
+ * something short-lived instead, such as a transient pool.
+ *
+ * @par Thread Safety
+ * Not thread-safe; owned by one renderer.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class FrameLruCache
+{
+public:
+    explicit FrameLruCache(std::size_t capacity) : m_Capacity(capacity) {}
+
+    /// @brief Value for @p key, or nullptr. Marks the entry as used this frame.
+    Value *Find(const Key &key)
+    {
+        auto found = m_Index.find(key);
+        if (found == m_Index.end())
+            return nullptr;
+        m_Order.splice(m_Order.begin(), m_Order, found->second);
+        found->second->lastUsed = m_Frame;
+        return &found->second->value;
+    }
+
+    /**
+     * @brief Add @p key as used this frame.
+     *
+     * @return False (nothing added) when the key exists or the cache is Full().
+     */
+    bool Insert(const Key &key, Value value)
+    {
+        if (Full() || m_Index.count(key) != 0)
+            return false;
+        m_Order.push_front(Entry{key, std::move(value), m_Frame});
+        m_Index.emplace(key, m_Order.begin());
+        return true;
+    }
+
+    /**
+     * @brief Remove the least recently used entry unless it was used this frame.
+     *
+     * @param outKey, outValue Receive the removed entry.
+     * @return False when the cache is empty or its oldest entry is still in use.
+     */
+    bool EvictOldest(Key &outKey, Value &outValue)
+    {
+        if (m_Order.empty() || m_Order.back().lastUsed == m_Frame)
+            return false;
+        Entry &oldest = m_Order.back();
+        outKey = oldest.key;
+        outValue = std::move(oldest.value);
+        m_Index.erase(oldest.key);
+        m_Order.pop_back();
+        return true;
+    }
+
+    /// @brief Remove @p key whatever its age; its value goes to @p outValue.
+    bool Erase(const Key &key, Value &outValue)
+    {
+        auto found = m_Index.find(key);
+        if (found == m_Index.end())
+            return false;
+        outValue = std::move(found->second->value);
+        m_Order.erase(found->second);
+        m_Index.erase(found);
+        return true;
+    }
+
+    /// @brief Start a new frame; entries used so far become evictable.
+    void NextFrame() { ++m_Frame; }
+
+    /// @brief Call @p fn(key, value) on every entry, most recent first.
+    template<typename Fn>
+    void ForEach(Fn &&fn) const
+    {
+        for (const Entry &entry : m_Order)
+            fn(entry.key, entry.value);
+    }
+
+    void Clear()
+    {
+        m_Order.clear();
+        m_Index.clear();
+    }
+
+    [[nodiscard]] bool Full() const { return m_Index.size() >= m_Capacity; }
+    [[nodiscard]] std::size_t Size() const { return m_Index.size(); }
+    [[nodiscard]] std::size_t GetCapacity() const { return m_Capacity; }
+
+private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        std::uint64_t lastUsed = 0;
+    };
+
+    using Order = std::list<Entry>;
+
+    std::size_t m_Capacity;
+    std::uint64_t m_Frame = 0;
+    Order m_Order;                                                    ///< Most recently used first
+    std::unordered_map<Key, typename Order::iterator, Hash> m_Index;
+};
@@ -0,0 +1,191 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+namespace
+{
+// Fraction of the remembered oversleep kept after each sleep
+constexpr double OVERSHOOT_DECAY = 0.98;
+}
+
+FramePacer::FramePacer()
+{
+#ifdef _WIN32
+    // High-resolution timers exist from Windows 10 1803; older systems get
+    // the regular timer and a larger learned oversleep margin
+    m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!m_Timer)
+    {
+        m_Timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+    if (m_Timer)
+    {
+        CloseHandle(static_cast<HANDLE>(m_Timer));
+    }
+#endif
+}
+
+void FramePacer::SetTargetFps(float fps)
+{
+    if (fps != m_TargetFps)
+    {
+        m_TargetFps = fps;
+        UpdateInterval();
+    }
+}
+
+void FramePacer::SetRefreshRate(double hz)
+{
+    if (hz != m_RefreshRate)
+    {
+        m_RefreshRate = hz;
+        UpdateInterval();
+    }
+}
+
+void FramePacer::SetAlignToRefresh(bool align)
+{
+    if (align != m_AlignToRefresh)
+    {
+        m_AlignToRefresh = align;
+        UpdateInterval();
+    }
+}
+
+double FramePacer::ComputeInterval(float targetFps, double refreshHz, bool align)
+{
+    if (targetFps <= 0.0f)
+    {
+        return 0.0;
+    }
+
+    const double interval = 1.0 / static_cast<double>(targetFps);
+    if (!align || refreshHz <= 0.0)
+    {
+        return interval;
+    }
+
+    // Tolerance so a 60 FPS cap on a 59.94 Hz display stays at one refresh
+    const double period = 1.0 / refreshHz;
+    const double refreshes = std::max(1.0, std::ceil(interval / period - 0.01));
+    return refreshes * period;
+}
+
+void FramePacer::UpdateInterval()
+{
+    m_Interval = ComputeInterval(m_TargetFps, m_RefreshRate, m_AlignToRefresh);
+    m_HasDeadline = false;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if (m_Interval <= 0.0)
+    {
+        m_HasDeadline = false;
+        return;
+    }
+
+    double now = Now();
+    if (!m_HasDeadline)
+    {
+        m_Deadline = now;
+        m_HasDeadline = true;
+    }
+    m_Deadline += m_Interval;
+
+    if (now >= m_Deadline)
+    {
+        // The frame overran its budget; waiting would only add latency
+        ++m_Missed;
+        m_Deadline = now;
+        return;
+    }
+
+    const double sleepTime = m_Deadline - now - m_SpinThreshold - m_SleepOvershoot;
+    if (sleepTime > 0.0)
+    {
+        Sleep(sleepTime);
+    }
+
+    while ((now = Now()) < m_Deadline)
+    {
+    }
+
+    const double error = now - m_Deadline;
+    ++m_Frames;
+    const double delta = error - m_ErrorMean;
+    m_ErrorMean += delta / static_cast<double>(m_Frames);
+    m_ErrorM2 += delta * (error - m_ErrorMean);
+    m_ErrorMax = std::max(m_ErrorMax, error);
+}
+
+void FramePacer::Sleep(double seconds)
+{
+    const double start = Now();
+#ifdef _WIN32
+    if (m_Timer)
+    {
+        // Negative due time is relative, in 100 ns units
+        LARGE_INTEGER due;
+        due.QuadPart = -static_cast<LONGLONG>(seconds * 1e7);
+        if (SetWaitableTimer(static_cast<HANDLE>(m_Timer), &due, 0, nullptr, nullptr, FALSE))
+        {
+            WaitForSingleObject(static_cast<HANDLE>(m_Timer), INFINITE);
+        }
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    }
+#else
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+#endif
+
+    // Remember the worst recent oversleep so the next sleep ends early enough for the spin
+    const double overshoot = std::max(0.0, (Now() - start) - seconds);
+    m_SleepOvershoot = std::min(std::max(overshoot, m_SleepOvershoot * OVERSHOOT_DECAY), m_Interval);
+}
+
+FramePacer::Stats FramePacer::GetStats() const
+{
+    Stats stats;
+    stats.frames = m_Frames;
+    stats.missed = m_Missed;
+    stats.meanError = m_ErrorMean;
+    stats.stdDevError = m_Frames > 1 ? std::sqrt(m_ErrorM2 / static_cast<double>(m_Frames - 1)) : 0.0;
+    stats.maxError = m_ErrorMax;
+    return stats;
+}
+
+void FramePacer::ResetStats()
+{
+    m_Frames = 0;
+    m_Missed = 0;
+    m_ErrorMean = 0.0;
+    m_ErrorM2 = 0.0;
+    m_ErrorMax = 0.0;
+}
+
+double FramePacer::Now()
+{
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * @class FramePacer
+ * @brief Caps the frame rate by sleeping to a deadline instead of spinning.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * WaitForNextFrame() blocks until the next frame deadline. Deadlines are
+ * spaced one interval apart from the previous deadline rather than from the
+ * moment the wait was entered, so time spent in the frame itself does not
+ * accumulate as drift.
+ *
+ * @par Waiting
+ * Most of the remaining time is slept through the OS: a high-resolution
+ * waitable timer on Windows (CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, falling
+ * back to a regular waitable timer on older systems) and
+ * std::this_thread::sleep_for elsewhere. The sleep stops short of the
+ * deadline by the spin threshold plus the worst recent oversleep, and only
+ * that last fraction of a millisecond is spun on the clock:
+ *
+ * @code
+ * |<------------------- interval ------------------->|
+ * | frame work |     OS sleep     | margin | spin    |
+ *                                                    ^ deadline
+ * @endcode
+ *
+ * @par Refresh Alignment
+ * With SetAlignToRefresh() the interval is rounded up to a whole number of
+ * display refresh periods, so a 500 FPS cap on a 144 Hz display paces at
+ * 144 Hz and a 50 FPS cap at 48 Hz (every third refresh) instead of
+ * beating against the scan-out.
+ *
+ * @par Jitter Statistics
+ * Every paced frame records how late it woke relative to its deadline.
+ * GetStats() returns the mean, standard deviation and maximum of that error
+ * and the number of frames whose work alone overran the deadline.
+ *
+ * @par Thread Safety
+ * Not thread-safe; owned by the thread running the main loop.
+ *
+ * @see Game::Run()
+ */
+class FramePacer
+{
+public:
+    /// @brief Default time spun on the clock before each deadline (seconds).
+    static constexpr double DEFAULT_SPIN_THRESHOLD = 0.0005;
+
+    /// @brief Wake-up error summary since construction or ResetStats().
+    struct Stats
+    {
+        long long frames = 0;      ///< Paced frames measured
+        long long missed = 0;      ///< Frames that reached the wait already past their deadline
+        double meanError = 0.0;    ///< Mean lateness past the deadline (seconds)
+        double stdDevError = 0.0;  ///< Standard deviation of the lateness (seconds)
+        double maxError = 0.0;     ///< Worst lateness (seconds)
+    };
+
+    FramePacer();
+    ~FramePacer();
+
+    FramePacer(const FramePacer &) = delete;
+    FramePacer &operator=(const FramePacer &) = delete;
+
+    /**
+     * @brief Set the frame rate cap.
+     * @param fps Frames per second, <=0 disables pacing.
+     *
+     * Changing the cap starts a new deadline sequence.
+     */
+    void SetTargetFps(float fps);
+
+    /// @brief Frame rate cap (<=0 = unlimited).
+    [[nodiscard]] float GetTargetFps() const { return m_TargetFps; }
+
+    /// @brief Display refresh rate in Hz used for alignment (<=0 = unknown).
+    void SetRefreshRate(double hz);
+
+    /// @brief Round the interval up to whole refresh periods (needs a known refresh rate).
+    void SetAlignToRefresh(bool align);
+
+    [[nodiscard]] bool IsAlignedToRefresh() const { return m_AlignToRefresh; }
+
+    /// @brief Time spun before each deadline instead of slept (seconds, >=0).
+    void SetSpinThreshold(double seconds) { m_SpinThreshold = seconds > 0.0 ? seconds : 0.0; }
+
+    /// @brief Seconds between deadlines, 0 when pacing is disabled.
+    [[nodiscard]] double GetInterval() const { return m_Interval; }
+
+    /**
+     * @brief Interval for a frame cap, optionally rounded to the refresh period.
+     * @param targetFps Frame rate cap, <=0 = unlimited.
+     * @param refreshHz Display refresh rate, <=0 = unknown (no rounding).
+     * @param align     Round up to a whole number of refresh periods.
+     * @return Seconds between frames, 0 for unlimited.
+     */
+    [[nodiscard]] static double ComputeInterval(float targetFps, double refreshHz, bool align);
+
+    /**
+     * @brief Block until the next frame deadline.
+     *
+     * Returns immediately when pacing is disabled. A frame that arrives
+     * after its deadline is counted as missed and restarts the deadline
+     * sequence from now, so one long stall is not followed by a burst of
+     * unpaced frames catching up.
+     */
+    void WaitForNextFrame();
+
+    /// @brief Forget the deadline; the next WaitForNextFrame() starts a new sequence.
+    void Reset() { m_HasDeadline = false; }
+
+    [[nodiscard]] Stats GetStats() const;
+    void ResetStats();
+
+private:
+    static double Now();
+
+    /// Sleep through the OS for about @p seconds and learn how far it overshoots
+    void Sleep(double seconds);
+    void UpdateInterval();
+
+    float m_TargetFps = 0.0f;
+    double m_RefreshRate = 0.0;
+    bool m_AlignToRefresh = false;
+    double m_Interval = 0.0;
+    double m_SpinThreshold = DEFAULT_SPIN_THRESHOLD;
+
+    double m_Deadline = 0.0;
+    bool m_HasDeadline = false;
+    double m_SleepOvershoot = 0.0;  ///< Decaying worst oversleep, kept as extra margin
+
+    // Welford accumulator over the wake-up error
+    long long m_Frames = 0;
+    long long m_Missed = 0;
+    double m_ErrorMean = 0.0;
+    double m_ErrorM2 = 0.0;
+    double m_ErrorMax = 0.0;
+
+#ifdef _WIN32
+    void *m_Timer = nullptr;  ///< Waitable timer HANDLE
+#endif
+};
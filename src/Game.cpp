@@ -2,12 +2,17 @@
 #include "PlayerCharacter.h"
 #include "NonPlayerCharacter.h"
 #include "RendererFactory.h"
+#include "SpriteSheetRegistry.h"
+#include "YSortQueue.h"
+#include "FrameArena.h"
 
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <random>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -28,6 +33,9 @@ Game::Game()
     , m_TilesVisibleHeight(12)
     , m_ResizeSnapTimer(0.0f)
     , m_PendingWindowSnap(false)
+    , m_LowResRendering(true)
+    , m_LowResUIFullRes(true)
+    , m_LightMap(true)
     , m_CameraPosition(0.0f)
     , m_CameraFollowTarget(0.0f)
     , m_HasCameraFollowTarget(false)
@@ -35,13 +43,18 @@ Game::Game()
     , m_CameraTilt(0.2f)
     , m_Enable3DEffect(false)
     , m_GlobeSphereRadius(200.0f)
+    , m_GpuProjection(true)
+    , m_GpuParticles(false)
     , m_FreeCameraMode(false)
     , m_LastFrameTime(0.0f)
+    , m_FixedTimestep(true)
+    , m_PreviousCameraPosition(0.0f)
     , m_PlayerPreviousPosition(0.0f)
     , m_InDialogue(false)
     , m_DialogueNPC(nullptr)
     , m_DialogueText("")
     , m_Renderer(nullptr)
+    , m_Pipeline(nullptr)
     , m_FpsUpdateTimer(0.0f)
     , m_FpsConsoleTimer(0.0f)
     , m_FrameCount(0)
@@ -71,9 +84,14 @@ bool Game::Initialize()
 
     std::cout << "Initialize() step 2: Selecting Renderer API..." << std::endl;
 
-    // Default to OpenGL
+    // Default to OpenGL; a benchmark or replay starts on the backend it measures
     m_RendererAPI = RendererAPI::OpenGL;
-    std::cout << "Renderer API: OpenGL (press F1 to switch)" << std::endl;
+    if (m_BenchmarkMode)
+        m_RendererAPI = m_BenchmarkOptions.renderer;
+    else if (m_ReplayMode)
+        m_RendererAPI = m_ReplayOptions.renderer;
+    std::cout << "Renderer API: " << (m_RendererAPI == RendererAPI::OpenGL ? "OpenGL" : "Vulkan")
+              << " (press F1 to switch)" << std::endl;
     std::cout << "Available renderers: OpenGL, Vulkan" << std::endl;
 
     std::cout << "Initialize() step 3: Setting window hints..." << std::endl;
@@ -89,6 +107,9 @@ bool Game::Initialize()
     {
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     }
+    const bool hiddenWindow =
+        (m_BenchmarkMode && m_BenchmarkOptions.hiddenWindow) || (m_ReplayMode && m_ReplayOptions.hiddenWindow);
+    glfwWindowHint(GLFW_VISIBLE, hiddenWindow ? GLFW_FALSE : GLFW_TRUE);
 
     std::cout << "Initialize() step 4: Creating GLFW window..." << std::endl;
 
@@ -100,15 +121,15 @@ bool Game::Initialize()
         return false;
     }
 
+    // Refresh rate of the display the window opens on, for refresh-aligned pacing
+    if (const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor()))
+    {
+        m_FramePacer.SetRefreshRate(mode->refreshRate);
+    }
+
     std::cout << "Initialize() step 5: Setting window callbacks..." << std::endl;
 
-    // Store Game instance pointer in window for callbacks
-    glfwSetWindowUserPointer(m_Window, this);
-
-    // Set callbacks
-    glfwSetScrollCallback(m_Window, ScrollCallback);
-    glfwSetFramebufferSizeCallback(m_Window, FramebufferSizeCallback);
-    glfwSetWindowRefreshCallback(m_Window, WindowRefreshCallback);
+    InstallWindowCallbacks();
 
     // Sleep 2 seconds after each draw call, set to true to enable
     SetDebugDrawSleep(m_Window, false);
@@ -123,6 +144,21 @@ bool Game::Initialize()
         glfwTerminate();
         return false;
     }
+    SpriteSheetRegistry::SetRenderer(m_Renderer.get());
+    SpriteSheetRegistry::SetLoader(&m_TextureLoader);
+    SpriteSheetRegistry::SetBudget(m_TextureBudget, m_TextureIdleFrames);
+
+    // Edited assets are picked up while the game runs, from wherever they were found
+    {
+        std::vector<std::string> watched;
+        for (const char *dir : {"assets", "shaders"})
+        {
+            std::error_code ec;
+            const bool local = std::filesystem::is_directory(dir, ec);
+            watched.push_back(local ? std::string(dir) : "../" + std::string(dir));
+        }
+        m_AssetWatcher.Start(std::move(watched));
+    }
 
     std::cout << "Initialize() step 7: Renderer created successfully" << std::endl;
 
@@ -159,7 +195,11 @@ bool Game::Initialize()
     std::cout << "About to call Renderer->Init()..." << std::endl;
     try
     {
+        // Stored until Init() creates the swapchain and frame slots
+        m_Renderer->SetPresentMode(m_PresentMode);
+        m_Renderer->SetFramesInFlight(m_FramesInFlight);
         m_Renderer->Init();
+        m_Renderer->SetJobSystem(&m_Jobs);
         std::cout << "Renderer->Init() completed successfully" << std::endl;
     }
     catch (const std::exception &e)
@@ -175,6 +215,8 @@ bool Game::Initialize()
 
     // Set viewport
     m_Renderer->SetViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
+    m_Renderer->SetGpuProjection(m_GpuProjection);
+    m_Particles.SetGpuSimulation(m_GpuParticles && m_Renderer->SupportsGpuParticles());
 
     // World viewport size based on tiles visible
     float initWorldWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth());
@@ -197,6 +239,9 @@ bool Game::Initialize()
         "assets/overworld/6a913092-f773-4d2f-a5d7-09a8d9fbb401.png",
     };
 
+    // Large rectangle edits (region eviction, editor fills) split their rows over the workers
+    m_Tilemap.SetJobSystem(&m_Jobs);
+
     // Load tilesets from current directory first, then try parent directory.
     // This handles both running from build/ subdirectory and project root.
     bool loaded = m_Tilemap.LoadCombinedTilesets(tilesetPaths, m_Tilemap.GetTileWidth(), m_Tilemap.GetTileHeight());
@@ -238,12 +283,59 @@ bool Game::Initialize()
         "assets/non-player/94c6b5b9-99fa-4f3d-bab5-b93684c934e5.png"
     });
 
-    // Try to load save from JSON first, if it exists
-    // If loading fails, generate a default map
+    // Prefer a streamed world directory, then save.wmap (unless save.json
+    // was edited after it was converted), then save.json
+    // If none loads, generate a default map
     int loadedPlayerTileX = -1;
     int loadedPlayerTileY = -1;
     int loadedCharacterType = -1;
-    bool mapLoaded = m_Tilemap.LoadMapFromJSON("save.json", &m_NPCs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+    bool mapLoaded = false;
+    if (m_BenchmarkMode)
+    {
+        // A benchmark measures the map it was given, never a save or the default map
+        const std::string &mapPath = m_BenchmarkOptions.mapPath;
+        std::error_code ec;
+        if (std::filesystem::is_directory(mapPath, ec))
+        {
+            mapLoaded = m_WorldStreamer.Open(mapPath, m_Tilemap, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+        else if (std::filesystem::path(mapPath).extension() == ".wmap")
+        {
+            mapLoaded = m_Tilemap.LoadMapFromBinary(mapPath, &m_NPCs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+        else
+        {
+            mapLoaded = m_Tilemap.LoadMapFromJSON(mapPath, &m_NPCs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+        if (!mapLoaded)
+        {
+            std::cerr << "Failed to load benchmark map: " << mapPath << std::endl;
+            return false;
+        }
+    }
+    else
+    {
+        mapLoaded = m_WorldStreamer.Open("world", m_Tilemap, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+    }
+    if (!mapLoaded)
+    {
+        std::error_code ec;
+        auto binaryTime = std::filesystem::last_write_time("save.wmap", ec);
+        bool binaryCurrent = !ec;
+        if (binaryCurrent)
+        {
+            auto jsonTime = std::filesystem::last_write_time("save.json", ec);
+            binaryCurrent = ec || binaryTime >= jsonTime;
+        }
+        if (binaryCurrent)
+        {
+            mapLoaded = m_Tilemap.LoadMapFromBinary("save.wmap", &m_NPCs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+        }
+    }
+    if (!mapLoaded)
+    {
+        mapLoaded = m_Tilemap.LoadMapFromJSON("save.json", &m_NPCs, &loadedPlayerTileX, &loadedPlayerTileY, &loadedCharacterType);
+    }
     if (!mapLoaded)
     {
         std::cout << "No existing save found, generating default map" << std::endl;
@@ -309,6 +401,11 @@ bool Game::Initialize()
     m_Player.SetTilePosition(playerTileX, playerTileY);
     glm::vec2 playerPos = m_Player.GetPosition();
 
+    // Load the regions around the spawn point before the first frame
+    m_WorldStreamer.LoadAround(playerPos, m_Tilemap, m_NPCs);
+    SyncNPCGrid();
+    m_Pathfinder.SetTilemap(&m_Tilemap);
+
     // Center camera on player's visual center
     // Player's visual center is at playerPos.y - HITBOX_HEIGHT (middle of 32px sprite)
     glm::vec2 playerVisualCenter = glm::vec2(playerPos.x, playerPos.y - PlayerCharacter::HITBOX_HEIGHT);
@@ -333,7 +430,7 @@ bool Game::Initialize()
     m_LastFrameTime = static_cast<float>(glfwGetTime());
 
     // Initialize particle system
-    m_Particles.LoadTextures();
+    m_Particles.LoadTextures(&m_Jobs);
     m_Particles.SetZones(m_Tilemap.GetParticleZones());
     m_Particles.SetTileSize(m_Tilemap.GetTileWidth(), m_Tilemap.GetTileHeight());
     m_Particles.SetTilemap(&m_Tilemap);
@@ -342,7 +439,7 @@ bool Game::Initialize()
     // Initialize day & night cycle
     m_TimeManager.Initialize();
     m_TimeManager.SetDayDuration(240.0f); // 240 seconds = 1 Game day
-    m_SkyRenderer.Initialize();
+    m_SkyRenderer.Initialize(&m_Jobs);
 
     // Initialize dialogue system
     m_DialogueManager.Initialize(this, &m_GameState);
@@ -353,11 +450,23 @@ bool Game::Initialize()
 void Game::Run()
 {
     // Main game loop. Processes input, updates game state, and renders each frame.
-    // Delta time is computed from wall-clock time for frame-rate independent movement.
+    // Delta time is computed from wall-clock time; in fixed-timestep mode it only
+    // decides how many simulation steps run, and drawing interpolates between them.
     try
     {
+        // Time spent loading is not simulated
+        m_Timestep.Reset();
+        BeginSimulationStep();
+        m_FramePacer.Reset();
+
         while (!glfwWindowShouldClose(m_Window))
         {
+            // A --trace capture with a frame limit ends before the next frame opens its zone
+            if (m_TraceFramesLeft > 0 && --m_TraceFramesLeft == 0)
+                StopProfilerCapture();
+
+            WILD_PROFILE_ZONE("Frame");
+            FrameArena::ThisThread().Reset();
             double frameStartTime = glfwGetTime();
             float deltaTime = static_cast<float>(frameStartTime) - m_LastFrameTime;
             m_LastFrameTime = static_cast<float>(frameStartTime);
@@ -368,9 +477,35 @@ void Game::Run()
 
             try
             {
-                ProcessInput(deltaTime);
-                Update(deltaTime);
-                Render();
+                if (m_FixedTimestep)
+                {
+                    const int steps = m_Timestep.Advance(deltaTime);
+                    const float step = m_Timestep.GetStep();
+                    for (int i = 0; i < steps && m_FixedTimestep; ++i)
+                    {
+                        BeginSimulationStep();
+                        m_Input.Advance();
+                        ProcessInput(step);
+                        Update(step);
+                    }
+                }
+                else
+                {
+                    m_Input.Advance();
+                    ProcessInput(deltaTime);
+                    Update(deltaTime);
+                }
+                UpdateFrameStats(deltaTime);
+
+                // F9 may have switched modes during the steps above
+                if (m_FixedTimestep)
+                    RenderInterpolated(m_Timestep.GetAlpha());
+                else
+                    Render();
+
+                // Sheets drawn this frame are stamped; the rest age towards eviction
+                SpriteSheetRegistry::Update();
+                Texture::AdvanceUseFrame();
             }
             catch (const std::exception &e)
             {
@@ -386,20 +521,16 @@ void Game::Run()
             }
 
             glfwPollEvents();
+            RecordPerfHudFrame(glfwGetTime() - frameStartTime);
 
-            // FPS limiter: busy-wait until target frame time is reached.
-            // Busy-waiting is used instead of sleep() for sub-millisecond accuracy,
-            // but this does consume CPU cycles. When m_TargetFps is 0, no limiting.
-            if (m_TargetFps > 0.0f)
-            {
-                double targetFrameTime = 1.0 / static_cast<double>(m_TargetFps);
-                double elapsed = glfwGetTime() - frameStartTime;
-                while (elapsed < targetFrameTime)
-                {
-                    elapsed = glfwGetTime() - frameStartTime;
-                }
-            }
+            // FPS limiter: sleep until the next frame deadline, spinning only for
+            // the last fraction of a millisecond. When m_TargetFps is 0, no limiting.
+            WILD_PROFILE_ZONE("Frame Pacing");
+            m_FramePacer.SetTargetFps(m_TargetFps);
+            m_FramePacer.WaitForNextFrame();
         }
+
+        ReportFramePacing();
     }
     catch (const std::exception &e)
     {
@@ -413,28 +544,123 @@ void Game::Run()
     }
 }
 
-void Game::Update(float deltaTime)
+void Game::SetFixedTimestep(bool enabled, float rate)
 {
-    // Compute blend factor for frame-rate independent exponential smoothing.
-    // Unlike fixed lerp (e.g., lerp 10% per frame), this produces consistent
-    // motion regardless of frame rate.
-    //
-    // Parameters:
-    //   dt - delta time this frame (seconds)
-    //   st - settle time: roughly how long to reach the target (seconds)
-    //   e  - epsilon: how close to target counts as "arrived" (default 1%)
-    //
-    // Returns alpha in [0,1] for use with: current = lerp(current, target, alpha)
-    auto expApproachAlpha = [](float dt, float st, float e = 0.01f) -> float
+    m_FixedTimestep = enabled;
+    m_Timestep.SetStep(rate > 0.0f ? 1.0f / rate : FixedTimestep::DEFAULT_STEP);
+    m_Timestep.Reset();
+    // Nothing to blend from until the next step has run
+    BeginSimulationStep();
+}
+
+void Game::SetTextureBudget(size_t bytes, uint64_t idleFrames)
+{
+    m_TextureBudget = bytes;
+    m_TextureIdleFrames = idleFrames;
+    SpriteSheetRegistry::SetBudget(bytes, idleFrames);
+}
+
+bool Game::SetPipelinedRendering(bool enabled)
+{
+    if (enabled == (m_Pipeline != nullptr))
+        return true;
+    if (!m_Renderer)
+        return false;
+
+    if (enabled && m_RendererAPI != RendererAPI::OpenGL)
     {
-        dt = std::max(0.0f, dt);
-        st = std::max(1e-5f, st);
-        return std::clamp(1.0f - std::pow(e, dt / st), 0.0f, 1.0f);
-    };
+        // Vulkan swapchain recreation calls GLFW functions that must run on the main thread
+        std::cerr << "Pipelined rendering needs the OpenGL renderer" << std::endl;
+        return false;
+    }
+
+    // Chunk meshes are tracked per renderer object; the next frame rebuilds them
+    m_Tilemap.ReleaseChunkMeshes();
+    m_Editor.ReleaseOverlayMeshes();
 
+    if (enabled)
+    {
+        auto pipeline = std::make_unique<PipelinedRenderer>(std::move(m_Renderer), m_Window);
+        m_Pipeline = pipeline.get();
+        m_Renderer = std::move(pipeline);
+    }
+    else
+    {
+        std::unique_ptr<IRenderer> target = m_Pipeline->ReleaseTarget();
+        m_Pipeline = nullptr;
+        m_Renderer = std::move(target);
+    }
+    SpriteSheetRegistry::SetRenderer(m_Renderer.get());
+    return true;
+}
+
+void Game::StartProfilerCapture(const std::string &path, int frames)
+{
+#if defined(WILD_ENABLE_PROFILER)
+    StopProfilerCapture();
+    m_TracePath = path;
+    m_TraceFramesLeft = std::max(frames, 0);
+    Profiler::BeginCapture();
+    std::cout << "Profiler capture started";
+    if (m_TraceFramesLeft > 0)
+        std::cout << " (" << m_TraceFramesLeft << " frames)";
+    std::cout << std::endl;
+#else
+    (void)path;
+    (void)frames;
+    std::cerr << "Profiler not available: build with ENABLE_PROFILER" << std::endl;
+#endif
+}
+
+void Game::StopProfilerCapture()
+{
+    if (!Profiler::IsCapturing())
+        return;
+
+    Profiler::EndCapture();
+    m_TraceFramesLeft = 0;
+    if (Profiler::SaveChromeTrace(m_TracePath))
+    {
+        std::cout << "Profiler capture: " << Profiler::GetEventCount() << " zones written to " << m_TracePath;
+        if (const size_t dropped = Profiler::GetDroppedCount())
+            std::cout << " (" << dropped << " dropped)";
+        std::cout << std::endl;
+    }
+}
+
+void Game::BeginSimulationStep()
+{
+    m_PreviousCameraPosition = m_CameraPosition;
+    m_Player.StorePreviousPosition();
+    CharacterStore::Npcs().StorePreviousPositions();
+}
+
+void Game::RenderInterpolated(float alpha)
+{
+    // Same swap-and-restore as the pixel-snapped camera in Render(); a camera
+    // jump of half a view or more (teleport, map load) is not blended
+    const glm::vec2 simulatedCamera = m_CameraPosition;
+    const glm::vec2 cameraDelta = m_CameraPosition - m_PreviousCameraPosition;
+    const float viewWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth()) / m_CameraZoom;
+    if (glm::length(cameraDelta) < viewWidth * 0.5f)
+    {
+        m_CameraPosition = m_PreviousCameraPosition + cameraDelta * alpha;
+    }
+    m_Player.BeginInterpolatedRender(alpha);
+    CharacterStore::Npcs().BeginInterpolatedRender(alpha);
+
+    Render();
+
+    CharacterStore::Npcs().EndInterpolatedRender();
+    m_Player.EndInterpolatedRender();
+    m_CameraPosition = simulatedCamera;
+}
+
+void Game::UpdateFrameStats(float frameTime)
+{
     // Update FPS counter
     m_FrameCount++;
-    m_FpsUpdateTimer += deltaTime;
+    m_FpsUpdateTimer += frameTime;
     if (m_FpsUpdateTimer >= 1.0f) // Update FPS display every second
     {
         m_CurrentFps = m_FrameCount / m_FpsUpdateTimer;
@@ -445,7 +671,7 @@ void Game::Update(float deltaTime)
     }
 
     // Output stats to console every second [deprecated]
-    m_FpsConsoleTimer += deltaTime;
+    m_FpsConsoleTimer += frameTime;
     if (m_FpsConsoleTimer >= 1.0f)
     {
         const char *renderer = (m_RendererAPI == RendererAPI::OpenGL) ? "OpenGL" : "Vulkan";
@@ -458,6 +684,389 @@ void Game::Update(float deltaTime)
                   << std::endl;*/
         m_FpsConsoleTimer = 0.0f;
     }
+}
+
+void Game::ReloadChangedAssets()
+{
+    const std::vector<std::string> changes = m_AssetWatcher.TakeChanges();
+    if (changes.empty())
+        return;
+
+    WILD_PROFILE_ZONE("Hot Reload");
+    bool shadersChanged = false;
+    for (const std::string &path : changes)
+    {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        // Several stages saved together still rebuild once
+        if (extension == ".vert" || extension == ".frag" || extension == ".comp" || extension == ".spv")
+        {
+            shadersChanged = true;
+            continue;
+        }
+        if (extension != ".png")
+            continue;
+
+        const int tileset = m_Tilemap.FindTileset(path);
+        if (tileset >= 0)
+        {
+            // Top row first; PatchTileset() flips rows into the combined texture itself
+            m_TextureLoader.Decode(path, false, [this, tileset, path](bool ok, ImageCache::Image &image)
+            {
+                if (ok && !m_Tilemap.PatchTileset(tileset, image.pixels.data(), image.width, image.height,
+                                                  image.channels, m_Renderer.get()))
+                {
+                    std::cerr << "Tileset size or format changed, restart to load it: " << path << std::endl;
+                }
+            });
+        }
+        else
+        {
+            SpriteSheetRegistry::Reload(path);
+        }
+    }
+
+    if (shadersChanged && m_Renderer && !m_Renderer->ReloadShaders())
+    {
+        std::cerr << "Shader reload failed or unsupported, keeping the current shaders" << std::endl;
+    }
+}
+
+void Game::ReportFramePacing()
+{
+    const FramePacer::Stats stats = m_FramePacer.GetStats();
+    if (m_FramePacer.GetInterval() > 0.0 && stats.frames + stats.missed > 0)
+    {
+        std::cout << std::fixed << std::setprecision(3) << "Frame pacing (" << 1.0 / m_FramePacer.GetInterval()
+                  << " Hz): " << stats.frames << " frames, lateness mean " << stats.meanError * 1000.0
+                  << " ms, stddev " << stats.stdDevError * 1000.0 << " ms, max " << stats.maxError * 1000.0
+                  << " ms, " << stats.missed << " missed" << std::defaultfloat << std::endl;
+    }
+    m_FramePacer.ResetStats();
+}
+
+void Game::RecordPerfHudFrame(double cpuSeconds)
+{
+    PerfHud::FrameSample sample;
+    sample.cpuMs = static_cast<float>(cpuSeconds * 1000.0);
+    for (const GpuTimerResult &timing : m_Renderer->GetGpuTimerResults())
+        sample.gpuMs += timing.milliseconds;
+    sample.drawCalls = m_Renderer->GetDrawCallCount();
+    sample.renderStats = m_Renderer->GetRenderStats();
+    sample.tiles = m_Tilemap.GetDrawnTileCount();
+    sample.npcs = m_VisibleNpcCount;
+    sample.particles = m_Particles.GetDrawnParticleCount();
+    sample.openGLTextureBytes = Texture::GetOpenGLTextureBytes();
+    sample.vulkanTextureBytes = Texture::GetVulkanTextureBytes();
+
+    const AllocationCounter::Totals allocations = AllocationCounter::GetTotals();
+    sample.allocationsCounted = AllocationCounter::IsEnabled();
+    sample.allocations = allocations.allocations - m_LastAllocations.allocations;
+    sample.allocatedBytes = allocations.bytes - m_LastAllocations.bytes;
+    m_LastAllocations = allocations;
+    sample.frameArenaBytes = FrameArena::ThisThread().GetUsedBytes();
+    sample.frameArenaCapacity = FrameArena::ThisThread().GetCapacity();
+    sample.textureBudget = SpriteSheetRegistry::GetBudget();
+    sample.evictedSheets = SpriteSheetRegistry::GetEvictedCount();
+
+    // Walks every uploaded texture, so only while someone is looking
+    if (m_PerfHud.IsVisible())
+    {
+        MemoryTracker::SetCpuBytes(MemoryTracker::Subsystem::Tilemap, m_Tilemap.GetMemoryBytes());
+        MemoryTracker::SetCpuBytes(MemoryTracker::Subsystem::Particles, m_Particles.GetMemoryBytes());
+        MemoryTracker::SetCpuBytes(MemoryTracker::Subsystem::Sky, m_SkyRenderer.GetMemoryBytes());
+        MemoryTracker::SetCpuBytes(MemoryTracker::Subsystem::Editor, m_Editor.GetHistoryMemoryBytes());
+        sample.memory = MemoryTracker::Collect();
+        sample.memoryCollected = true;
+    }
+
+    m_PerfHud.RecordFrame(sample);
+}
+
+bool Game::ConfigureBenchmark(const BenchmarkOptions &options)
+{
+    if (!m_BenchmarkScript.LoadFromFile(options.scriptPath))
+        return false;
+    if (options.frames > 0)
+        m_BenchmarkScript.SetFrames(options.frames);
+
+    m_BenchmarkOptions = options;
+    m_BenchmarkMode = true;
+    return true;
+}
+
+bool Game::RunBenchmark()
+{
+    if (!m_BenchmarkMode || !m_Window || !m_Renderer)
+    {
+        std::cerr << "RunBenchmark() needs ConfigureBenchmark() and Initialize() first" << std::endl;
+        return false;
+    }
+    const BenchmarkScript &script = m_BenchmarkScript;
+
+    // Same particles, NPC decisions and lighting on every run
+    SeedSimulation(script.GetSeed());
+    m_TimeManager.SetTime(script.GetTimeOfDay());
+    m_TimeManager.SetTimeScale(0.0f);
+
+    const int warmupFrames = script.GetWarmupFrames();
+    const int totalFrames = warmupFrames + script.GetFrames();
+    const float step = script.GetStep();
+    std::cout << "Benchmark: " << warmupFrames << " warmup + " << script.GetFrames() << " frames, "
+              << script.GetWaypoints().size() << " waypoints" << std::endl;
+
+    BenchmarkReport report;
+    m_LastAllocations = AllocationCounter::GetTotals();
+    m_LastFrameTime = static_cast<float>(glfwGetTime());
+
+    int frame = 0;
+    try
+    {
+        for (; frame < totalFrames && !glfwWindowShouldClose(m_Window); ++frame)
+        {
+            WILD_PROFILE_ZONE("Frame");
+            FrameArena::ThisThread().Reset();
+            const double frameStartTime = glfwGetTime();
+
+            // Input is not read; the pose is applied after Update() so camera
+            // smoothing can't pull the view off the script
+            BeginSimulationStep();
+            Update(step);
+            ApplyBenchmarkPose(script.Sample(static_cast<float>(frame) * step));
+            UpdateFrameStats(step);
+            Render();
+
+            glfwPollEvents();
+            RecordPerfHudFrame(glfwGetTime() - frameStartTime);
+            if (frame >= warmupFrames)
+            {
+                report.AddFrame(m_PerfHud.GetLastSample());
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Exception in benchmark frame " << frame << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    BenchmarkReport::RunInfo info;
+    info.map = m_BenchmarkOptions.mapPath;
+    info.script = m_BenchmarkOptions.scriptPath;
+    info.renderer = (m_RendererAPI == RendererAPI::OpenGL) ? "OpenGL" : "Vulkan";
+    info.width = m_ScreenWidth;
+    info.height = m_ScreenHeight;
+    info.hiddenWindow = m_BenchmarkOptions.hiddenWindow;
+    info.warmupFrames = warmupFrames;
+    if (!SaveRunReport(report, info, m_BenchmarkOptions.outputPath, "Benchmark"))
+        return false;
+
+    if (frame < totalFrames)
+    {
+        std::cerr << "Benchmark stopped after " << frame << " of " << totalFrames << " frames" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Game::ConfigureReplay(const ReplayOptions &options)
+{
+    if (!m_Input.StartReplay(options.logPath))
+        return false;
+
+    // Cursor coordinates are only meaningful in a window of the recorded size
+    const InputState::LogHeader &header = m_Input.GetLogHeader();
+    if (header.windowWidth > 0 && header.windowHeight > 0)
+    {
+        m_ScreenWidth = header.windowWidth;
+        m_ScreenHeight = header.windowHeight;
+    }
+
+    m_ReplayOptions = options;
+    m_ReplayMode = true;
+    return true;
+}
+
+bool Game::RunReplay()
+{
+    if (!m_ReplayMode || !m_Window || !m_Renderer)
+    {
+        std::cerr << "RunReplay() needs ConfigureReplay() and Initialize() first" << std::endl;
+        return false;
+    }
+    const InputState::LogHeader &header = m_Input.GetLogHeader();
+
+    SeedSimulation(header.seed);
+    m_TimeManager.SetTime(header.timeOfDay);
+    m_TimeManager.SetTimeScale(header.timeScale);
+    SetFixedTimestep(true, 1.0f / header.step);
+    m_Editor.SetSavingEnabled(false);
+
+    const size_t totalSteps = m_Input.GetReplayStepCount();
+    std::cout << "Replay: " << totalSteps << " steps of " << header.step * 1000.0f << " ms from "
+              << m_ReplayOptions.logPath << std::endl;
+
+    BenchmarkReport report;
+    m_LastAllocations = AllocationCounter::GetTotals();
+    m_LastFrameTime = static_cast<float>(glfwGetTime());
+
+    try
+    {
+        // The log may end with the keypress that closed the window
+        while (!glfwWindowShouldClose(m_Window))
+        {
+            WILD_PROFILE_ZONE("Frame");
+            FrameArena::ThisThread().Reset();
+            const double frameStartTime = glfwGetTime();
+
+            // One recorded step per frame, whatever the frame took
+            BeginSimulationStep();
+            if (!m_Input.Advance())
+                break;
+            ProcessInput(header.step);
+            Update(header.step);
+            UpdateFrameStats(header.step);
+            Render();
+
+            glfwPollEvents();
+            RecordPerfHudFrame(glfwGetTime() - frameStartTime);
+            report.AddFrame(m_PerfHud.GetLastSample());
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Exception in replay step " << m_Input.GetStepIndex() << ": " << e.what() << std::endl;
+        return false;
+    }
+    const size_t steps = m_Input.GetStepIndex();
+    m_Input.StopReplay();
+
+    BenchmarkReport::RunInfo info;
+    info.script = m_ReplayOptions.logPath;
+    info.renderer = (m_RendererAPI == RendererAPI::OpenGL) ? "OpenGL" : "Vulkan";
+    info.width = m_ScreenWidth;
+    info.height = m_ScreenHeight;
+    info.hiddenWindow = m_ReplayOptions.hiddenWindow;
+    if (!SaveRunReport(report, info, m_ReplayOptions.outputPath, "Replay"))
+        return false;
+
+    if (steps < totalSteps)
+    {
+        std::cerr << "Replay stopped after " << steps << " of " << totalSteps << " steps" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Game::StartInputRecording(const std::string &path)
+{
+    if (!m_Window)
+    {
+        std::cerr << "StartInputRecording() needs Initialize() first" << std::endl;
+        return false;
+    }
+
+    InputState::LogHeader header;
+    header.seed = std::random_device{}();
+    header.step = m_Timestep.GetStep();
+    header.timeOfDay = m_TimeManager.GetTimeOfDay();
+    header.timeScale = m_TimeManager.GetTimeScale();
+    glfwGetWindowSize(m_Window, &header.windowWidth, &header.windowHeight);
+    if (!m_Input.StartRecording(path, header))
+        return false;
+
+    // Start from the state RunReplay() recreates
+    SeedSimulation(header.seed);
+    SetFixedTimestep(true, 1.0f / header.step);
+    std::cout << "Recording input to " << path << " (seed " << header.seed << ")" << std::endl;
+    return true;
+}
+
+bool Game::StopInputRecording()
+{
+    if (!m_Input.IsRecording())
+        return true;
+    const size_t steps = m_Input.GetStepIndex();
+    if (!m_Input.StopRecording())
+        return false;
+    std::cout << "Recorded " << steps << " input steps" << std::endl;
+    return true;
+}
+
+void Game::SeedSimulation(std::uint32_t seed)
+{
+    m_Particles.Clear();
+    m_Particles.SetSeed(seed);
+    for (size_t i = 0; i < m_NPCs.size(); ++i)
+    {
+        m_NPCs[i].SeedRng(static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull + i);
+    }
+    m_Editor.SetSeed(seed);
+}
+
+bool Game::SaveRunReport(const BenchmarkReport &report, const BenchmarkReport::RunInfo &info,
+                         const std::string &path, const char *label)
+{
+    if (!report.SaveJson(path, info))
+        return false;
+
+    const BenchmarkReport::Summary cpu = report.GetCpuSummary();
+    const BenchmarkReport::Summary gpu = report.GetGpuSummary();
+    std::cout << std::fixed << std::setprecision(3) << label << " (" << info.renderer << "): " << report.GetFrameCount()
+              << " frames, CPU avg " << cpu.avg << " ms, p99 " << cpu.p99 << " ms";
+    if (gpu.count > 0)
+        std::cout << ", GPU avg " << gpu.avg << " ms, p99 " << gpu.p99 << " ms";
+    std::cout << std::defaultfloat << " -> " << path << std::endl;
+    return true;
+}
+
+void Game::ApplyBenchmarkPose(const BenchmarkScript::Pose &pose)
+{
+    const float tileW = static_cast<float>(m_Tilemap.GetTileWidth());
+    const float tileH = static_cast<float>(m_Tilemap.GetTileHeight());
+
+    // Feet at the bottom center of the (fractional) tile, like SetTilePosition()
+    const glm::vec2 feet((pose.tile.x + 0.5f) * tileW, (pose.tile.y + 1.0f) * tileH);
+    m_Player.GameCharacter::SetPosition(feet);
+    if (std::abs(pose.direction.x) > std::abs(pose.direction.y))
+    {
+        m_Player.SetDirection(pose.direction.x < 0.0f ? Direction::LEFT : Direction::RIGHT);
+    }
+    else if (pose.direction.y != 0.0f)
+    {
+        m_Player.SetDirection(pose.direction.y < 0.0f ? Direction::UP : Direction::DOWN);
+    }
+
+    m_CameraZoom = pose.zoom;
+    const glm::vec2 viewSize(static_cast<float>(m_TilesVisibleWidth) * tileW / m_CameraZoom,
+                             static_cast<float>(m_TilesVisibleHeight) * tileH / m_CameraZoom);
+    const glm::vec2 visualCenter(feet.x, feet.y - PlayerCharacter::HITBOX_HEIGHT);
+    m_CameraPosition = visualCenter - viewSize * 0.5f;
+    m_CameraFollowTarget = m_CameraPosition;
+    m_HasCameraFollowTarget = false;
+}
+
+void Game::Update(float deltaTime)
+{
+    WILD_PROFILE_ZONE("Update");
+    // Compute blend factor for frame-rate independent exponential smoothing.
+    // Unlike fixed lerp (e.g., lerp 10% per frame), this produces consistent
+    // motion regardless of frame rate.
+    //
+    // Parameters:
+    //   dt - delta time this frame (seconds)
+    //   st - settle time: roughly how long to reach the target (seconds)
+    //   e  - epsilon: how close to target counts as "arrived" (default 1%)
+    //
+    // Returns alpha in [0,1] for use with: current = lerp(current, target, alpha)
+    auto expApproachAlpha = [](float dt, float st, float e = 0.01f) -> float
+    {
+        dt = std::max(0.0f, dt);
+        st = std::max(1e-5f, st);
+        return std::clamp(1.0f - std::pow(e, dt / st), 0.0f, 1.0f);
+    };
 
     // Handle deferred window snap after resize settles
     if (m_PendingWindowSnap)
@@ -493,27 +1102,81 @@ void Game::Update(float deltaTime)
     float elevation = m_Tilemap.GetElevationAtWorldPos(playerPos.x, playerPos.y);
     m_Player.SetElevationOffset(elevation);
 
-    // Update NPCs
-    // During dialogue, freeze the NPC being talked to
-    bool inAnyDialogue = m_InDialogue || m_DialogueManager.IsActive();
-    for (auto &npc : m_NPCs)
+    // Advance queued path searches, then hand finished paths to their NPCs.
+    // Unreachable goals (and results that expired) send the NPC back to patrolling.
     {
-        // Skip updating the NPC in dialogue
-        if (inAnyDialogue && m_DialogueNPC == &npc)
+        WILD_PROFILE_ZONE("Pathfinding");
+        m_Pathfinder.Update();
+        for (auto &npc : m_NPCs)
         {
-            continue;
+            Pathfinder::RequestId request = npc.GetPathRequest();
+            if (request == 0 || m_Pathfinder.GetStatus(request) == Pathfinder::PathStatus::Pending)
+            {
+                continue;
+            }
+            std::vector<glm::ivec2> path;
+            if (m_Pathfinder.TakePath(request, path))
+            {
+                npc.FollowPath(std::move(path));
+            }
+            else
+            {
+                npc.SetPathRequest(0);
+            }
         }
-        npc.Update(deltaTime, &m_Tilemap, &playerPos);
+    }
 
-        // Update NPC elevation based on tilemap
-        glm::vec2 npcPos = npc.GetPosition();
-        float npcElevation = m_Tilemap.GetElevationAtWorldPos(npcPos.x, npcPos.y);
-        npc.SetElevationOffset(npcElevation);
+    // Update NPCs in parallel chunks, walking the rows of the NPC store
+    // rather than m_NPCs. Each NPC only writes its own state and reads the
+    // tilemap, so the result is the same for any thread count. Everything
+    // shared (the spatial grid, player/NPC stopping) is merged serially
+    // afterwards.
+    // During dialogue, freeze the NPC being talked to
+    bool inAnyDialogue = m_InDialogue || m_DialogueManager.IsActive();
+    const NonPlayerCharacter *frozenNPC = inAnyDialogue ? m_DialogueNPC : nullptr;
+    constexpr size_t NPC_UPDATE_GRAIN = 64;
+    {
+        WILD_PROFILE_ZONE("NPC Update");
+        m_NPCLod.BeginFrame(m_CameraPosition, m_CameraPosition + viewSize);
+        CharacterStore &store = CharacterStore::Npcs();
+        m_Jobs.ParallelFor(store.GetSlotCount(), NPC_UPDATE_GRAIN, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const auto slot = static_cast<CharacterStore::Slot>(i);
+                // Skip free rows and the NPC in dialogue
+                if (!store.IsLive(slot) || store.GetOwner(slot) == frozenNPC)
+                {
+                    continue;
+                }
+                UpdateNPC(store, slot, deltaTime, playerPos);
+            }
+        });
+        SyncNPCGrid();
     }
 
     // Update editor (tile picker smooth panning, etc.)
     m_Editor.Update(deltaTime, MakeEditorContext());
 
+    // Stream regions around the view center. Edited regions are written back
+    // before eviction; regions stay resident while the editor is open so one
+    // being painted is not rewritten every time it leaves the radius. Streaming
+    // adds and removes NPCs, so it also waits while m_DialogueNPC is in use.
+    if (m_WorldStreamer.IsActive() && !inAnyDialogue)
+    {
+        WILD_PROFILE_ZONE("World Streaming");
+        float streamWorldW = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth()) / m_CameraZoom;
+        float streamWorldH = static_cast<float>(m_TilesVisibleHeight * m_Tilemap.GetTileHeight()) / m_CameraZoom;
+        glm::vec2 viewCenter = m_CameraPosition + glm::vec2(streamWorldW, streamWorldH) * 0.5f;
+        m_WorldStreamer.Update(viewCenter, m_Tilemap, m_NPCs, &m_Particles, !m_Editor.IsActive());
+        SyncNPCGrid();
+    }
+
+    // Files edited on disk, then sheets requested by map loads, streaming,
+    // character switches and those reloads
+    ReloadChangedAssets();
+    m_TextureLoader.Update(m_Renderer.get());
+
     // Calculate world space dimensions with camera zoom applied
     float baseWorldWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth());
     float baseWorldHeight = static_cast<float>(m_TilesVisibleHeight * m_Tilemap.GetTileHeight());
@@ -521,10 +1184,10 @@ void Game::Update(float deltaTime)
     float worldHeight = baseWorldHeight / m_CameraZoom;
 
     // Check if arrow keys are pressed for manual camera control
-    bool arrowUp = glfwGetKey(m_Window, GLFW_KEY_UP) == GLFW_PRESS;
-    bool arrowDown = glfwGetKey(m_Window, GLFW_KEY_DOWN) == GLFW_PRESS;
-    bool arrowLeft = glfwGetKey(m_Window, GLFW_KEY_LEFT) == GLFW_PRESS;
-    bool arrowRight = glfwGetKey(m_Window, GLFW_KEY_RIGHT) == GLFW_PRESS;
+    bool arrowUp = m_Input.IsKeyDown(GLFW_KEY_UP);
+    bool arrowDown = m_Input.IsKeyDown(GLFW_KEY_DOWN);
+    bool arrowLeft = m_Input.IsKeyDown(GLFW_KEY_LEFT);
+    bool arrowRight = m_Input.IsKeyDown(GLFW_KEY_RIGHT);
 
     // When the tile picker is open, arrow keys are repurposed for tilepicker panning
     if (m_Editor.IsActive() && m_Editor.ShowTilePicker())
@@ -539,10 +1202,10 @@ void Game::Update(float deltaTime)
     }
 
     // Check if WASD keys are pressed for player movement
-    bool wasdPressed = (glfwGetKey(m_Window, GLFW_KEY_W) == GLFW_PRESS ||
-                        glfwGetKey(m_Window, GLFW_KEY_A) == GLFW_PRESS ||
-                        glfwGetKey(m_Window, GLFW_KEY_S) == GLFW_PRESS ||
-                        glfwGetKey(m_Window, GLFW_KEY_D) == GLFW_PRESS);
+    bool wasdPressed = (m_Input.IsKeyDown(GLFW_KEY_W) ||
+                        m_Input.IsKeyDown(GLFW_KEY_A) ||
+                        m_Input.IsKeyDown(GLFW_KEY_S) ||
+                        m_Input.IsKeyDown(GLFW_KEY_D));
 
     bool arrowKeysPressed = arrowUp || arrowDown || arrowLeft || arrowRight;
 
@@ -571,8 +1234,8 @@ void Game::Update(float deltaTime)
             float cameraSpeed = 600.0f / m_CameraZoom; // Pixels per second
 
             // Shift modifier for faster panning (2.5x)
-            if (glfwGetKey(m_Window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                glfwGetKey(m_Window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
+            if (m_Input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                m_Input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT))
             {
                 cameraSpeed *= 2.5f;
             }
@@ -622,8 +1285,8 @@ void Game::Update(float deltaTime)
         float cameraSpeed = 600.0f / m_CameraZoom;
 
         // Shift modifier for faster panning (2.5x)
-        if (glfwGetKey(m_Window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-            glfwGetKey(m_Window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
+        if (m_Input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+            m_Input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT))
         {
             cameraSpeed *= 2.5f;
         }
@@ -725,27 +1388,55 @@ void Game::Update(float deltaTime)
     };
 
     auto playerBox = makePlayerAABB(playerPos);
-    auto overlaps = [](const auto &a, const auto &b)
+
+    // Check for player-NPC collisions over the NPC store's position arrays.
+    // NPCs are stopped while colliding and allowed to move again otherwise.
+    CharacterStore::Npcs().StopOverlapping(glm::vec2(playerBox.minX, playerBox.minY),
+                                           glm::vec2(playerBox.maxX, playerBox.maxY), PLAYER_HALF_W, PLAYER_BOX_H);
+}
+
+void Game::UpdateNPC(CharacterStore &store, CharacterStore::Slot slot, float deltaTime, const glm::vec2 &playerPos)
+{
+    const SimLod lod = m_NPCLod.Classify(store.GetPosition(slot));
+    store.m_DeferredSimTime[slot] += deltaTime;
+    if (!m_NPCLod.IsDue(lod, slot))
     {
-        return (a.minX < b.maxX && a.maxX > b.minX &&
-                a.minY < b.maxY && a.maxY > b.minY);
-    };
+        return;
+    }
 
-    // Check for player-NPC collisions and stop NPCs when colliding
-    for (auto &npc : m_NPCs)
+    float simTime = store.m_DeferredSimTime[slot];
+    store.m_DeferredSimTime[slot] = 0.0f;
+
+    if (lod == SimLod::Dormant)
     {
-        auto npcBox = makePlayerAABB(npc.GetPosition());
-        if (overlaps(playerBox, npcBox))
-        {
-            // Stop NPC while colliding with the player
-            npc.SetStopped(true);
-        }
-        else
+        store.GetOwner(slot)->UpdateDormant(simTime, &m_Tilemap);
+    }
+    else
+    {
+        // Coming out of dormancy: cover the time spent far away analytically,
+        // then continue frame by frame from there
+        if (store.m_SimLod[slot] == SimLod::Dormant && simTime > deltaTime)
         {
-            // If not overlapping this frame, allow it to move again
-            npc.SetStopped(false);
+            store.GetOwner(slot)->UpdateDormant(simTime - deltaTime, &m_Tilemap);
+            simTime = deltaTime;
         }
+        NonPlayerCharacter::UpdateSlot(store, slot, simTime, &m_Tilemap, &playerPos);
+
+        // Update NPC elevation based on tilemap
+        glm::vec2 npcPos = store.GetPosition(slot);
+        float npcElevation = m_Tilemap.GetElevationAtWorldPos(npcPos.x, npcPos.y);
+        store.SetElevationOffset(slot, npcElevation);
     }
+    store.m_SimLod[slot] = lod;
+}
+
+void Game::SyncNPCGrid()
+{
+    // Drop ids that no longer name an NPC, then refresh the rest in place
+    const auto count = static_cast<SpatialHash::Id>(m_NPCs.size());
+    m_NPCGrid.Truncate(count);
+    for (SpatialHash::Id id = 0; id < count; ++id)
+        m_NPCGrid.Move(id, m_NPCs[id].GetPosition());
 }
 
 void Game::ConfigureRendererPerspective(float width, float height)
@@ -794,6 +1485,7 @@ void Game::Toggle3DEffect()
 
 void Game::Render()
 {
+    WILD_PROFILE_ZONE("Render");
     // Render order (back to front):
     // 1. Sky color (clear)
     // 2. Background tilemap layers (ground, ground detail, objects)
@@ -816,15 +1508,38 @@ void Game::Render()
     }
 
     m_Renderer->BeginFrame();
+    m_Tilemap.ResetDrawnTileCount();
+    m_Particles.ResetDrawnParticleCount();
+
+    // Low-res mode draws the world one pixel per art texel (at zoom 1) and
+    // upscales it by PIXEL_SCALE, instead of shading every texel 25 times.
+    // The target is rounded up, so a window that is not a multiple of
+    // PIXEL_SCALE (mid-resize) is overhung by a few pixels at the bottom right.
+    const int lowResWidth = (m_ScreenWidth + PIXEL_SCALE - 1) / PIXEL_SCALE;
+    const int lowResHeight = (m_ScreenHeight + PIXEL_SCALE - 1) / PIXEL_SCALE;
+    const bool lowRes = m_LowResRendering && m_Renderer->BeginLowResPass(lowResWidth, lowResHeight);
+    bool lowResOpen = lowRes;
+    auto endLowResPass = [&]()
+    {
+        if (!lowResOpen)
+            return;
+        const int upscaledWidth = lowResWidth * PIXEL_SCALE;
+        const int upscaledHeight = lowResHeight * PIXEL_SCALE;
+        m_Renderer->EndLowResPass(0, m_ScreenHeight - upscaledHeight, upscaledWidth, upscaledHeight);
+        lowResOpen = false;
+    };
 
     // Use sky color from TimeManager for clear color
     glm::vec3 skyColor = m_TimeManager.GetSkyColor();
     m_Renderer->Clear(skyColor.r, skyColor.g, skyColor.b, 1.0f);
 
     // Calculate world space size from actual screen dimensions (not truncated tile count)
-    // This ensures viewport calculations match the true visible area
-    float worldWidth = static_cast<float>(m_ScreenWidth) / static_cast<float>(PIXEL_SCALE);
-    float worldHeight = static_cast<float>(m_ScreenHeight) / static_cast<float>(PIXEL_SCALE);
+    // This ensures viewport calculations match the true visible area. In low-res
+    // mode it matches the target exactly so one world unit is one target pixel.
+    float worldWidth = lowRes ? static_cast<float>(lowResWidth)
+                              : static_cast<float>(m_ScreenWidth) / static_cast<float>(PIXEL_SCALE);
+    float worldHeight = lowRes ? static_cast<float>(lowResHeight)
+                               : static_cast<float>(m_ScreenHeight) / static_cast<float>(PIXEL_SCALE);
 
     // Set ambient color for world rendering (day & night tint)
     m_Renderer->SetAmbientColor(m_TimeManager.GetAmbientColor());
@@ -837,16 +1552,18 @@ void Game::Render()
     glm::mat4 projection = GetOrthoProjection(zoomedWidth, zoomedHeight);
     m_Renderer->SetProjection(projection);
 
-    // Snap camera to pixel grid for rendering to avoid per-frame jitter seams (OpenGL only)
+    // Snap camera to pixel grid for rendering to avoid per-frame jitter seams
+    // (OpenGL, or any backend drawing into the low-res target, whose pixels
+    // are large enough for sub-pixel camera offsets to shimmer)
     const glm::vec2 originalCamera = m_CameraPosition;
     glm::vec2 renderCam = originalCamera;
     glm::vec2 renderSize(zoomedWidth, zoomedHeight);
     glm::vec2 cullCam = originalCamera; // use unsnapped camera for visibility tests
     glm::vec2 cullSize(zoomedWidth, zoomedHeight);
-    if (m_RendererAPI == RendererAPI::OpenGL)
+    if (m_RendererAPI == RendererAPI::OpenGL || lowRes)
     {
-        const float pixelStepX = zoomedWidth / static_cast<float>(m_ScreenWidth);
-        const float pixelStepY = zoomedHeight / static_cast<float>(m_ScreenHeight);
+        const float pixelStepX = zoomedWidth / static_cast<float>(lowRes ? lowResWidth : m_ScreenWidth);
+        const float pixelStepY = zoomedHeight / static_cast<float>(lowRes ? lowResHeight : m_ScreenHeight);
         auto snapToPixel = [](float value, float step)
         {
             return (step > 0.0f) ? std::round(value / step) * step : value;
@@ -881,11 +1598,33 @@ void Game::Render()
     // Use snapped camera for rendering when OpenGL (restore at end of function)
     m_CameraPosition = renderCam;
 
+    // Splat lanterns, glowing particles and emissive tiles into a quarter-tile
+    // light map that replaces the flat ambient tint for the world passes.
+    // Lights are gathered over the cull rectangle, then moved to renderCam.
+    bool lightMap = false;
+    if (m_LightMap && m_Renderer->SupportsLightMap())
+    {
+        m_Lights.clear();
+        m_Particles.CollectLights(cullCam, cullSize, m_Lights);
+        m_Tilemap.CollectTileLights(cullCam, cullSize, m_Lights);
+        const glm::vec2 cullOffset = cullCam - renderCam;
+        for (IRenderer::Light &light : m_Lights)
+        {
+            light.position += cullOffset;
+        }
+        lightMap = m_Renderer->SetLightMap(renderSize, LIGHT_MAP_CELL_SIZE, m_Lights.data(), m_Lights.size());
+    }
+    m_Particles.SetLightMapActive(lightMap);
+
     // Render layers in order with Y-sorted tiles:
     // 1. Background layers (Ground, Ground Detail, Objects, Objects2)
     // 2. Y-sorted pass: Y-sorted tiles from ALL layers + NPCs + player
     // 3. Foreground layers (Foreground, Foreground2, Overlay, Overlay2)
 
+    // GPU timer regions below cover the passes listed above. The renderer
+    // flushes its batches at each boundary so draws land in the right region.
+    m_Renderer->BeginGpuTimer("Background");
+
     // Render background layers - Y-sorted and no-projection tiles are skipped
     m_Tilemap.RenderBackgroundLayers(*m_Renderer, renderCam, renderSize, cullCam, cullSize);
 
@@ -894,6 +1633,8 @@ void Game::Render()
 
     // Render no-projection tiles from background layers (buildings & entities that should appear upright)
     m_Tilemap.RenderBackgroundLayersNoProjection(*m_Renderer, renderCam, renderSize, cullCam, cullSize);
+    m_Renderer->EndGpuTimer();
+    m_Renderer->BeginGpuTimer("Y-Sorted");
 
     // Collect Y-sorted tiles from all layers
     auto ySortPlusTiles = m_Tilemap.GetVisibleYSortPlusTiles(cullCam, cullSize);
@@ -904,15 +1645,15 @@ void Game::Render()
     // Characters are split into top/bottom halves for proper occlusion with tiles.
     struct RenderItem
     {
-        // Type ordering matters for stable sort tiebreaker:
-        // Higher values render later (in front) when Y coordinates match.
+        // Type ordering is the sort tiebreaker:
+        // Higher values render earlier (behind) when sort keys match.
         enum Type
         {
-            PLAYER_TOP = 0,    // Player top half (renders first/behind at same Y)
+            PLAYER_TOP = 0,    // Player top half (renders last/in front at same Y)
             PLAYER_BOTTOM = 1,
             NPC_TOP = 2,
             NPC_BOTTOM = 3,
-            TILE = 4           // Tiles render last/in front at same Y
+            TILE = 4           // Tiles render first/behind at same Y
         } type;
         float sortY;                       // Y coordinate for depth sorting
         Tilemap::YSortPlusTile tile;         // Valid when type == TILE
@@ -950,15 +1691,21 @@ void Game::Render()
     // The top half sorts slightly higher so it can appear behind tiles
     // that the character is walking past.
     // Skip NPCs behind the sphere when full globe is visible.
-    for (const auto &npc : m_NPCs)
+    // Positions are read from the NPC store's arrays; only NPCs that make it
+    // into the list are visited
+    const CharacterStore &npcStore = CharacterStore::Npcs();
+    m_VisibleNpcCount = 0;
+    for (CharacterStore::Slot slot = 0; slot < npcStore.GetSlotCount(); ++slot)
     {
-        glm::vec2 npcPos = npc.GetPosition();
-        float screenX = npcPos.x - renderCam.x;
-        float screenY = npcPos.y - renderCam.y;
+        if (!npcStore.IsLive(slot))
+            continue;
+        float screenX = npcStore.m_PositionX[slot] - renderCam.x;
+        float screenY = npcStore.m_PositionY[slot] - renderCam.y;
         if (m_Renderer->IsPointBehindSphere(glm::vec2(screenX, screenY)))
             continue;
 
-        float anchorY = npcPos.y;
+        const NonPlayerCharacter &npc = *npcStore.GetOwner(slot);
+        float anchorY = npcStore.m_PositionY[slot];
         // Bottom half renders at anchor position
         RenderItem bottomItem;
         bottomItem.type = RenderItem::NPC_BOTTOM;
@@ -973,6 +1720,7 @@ void Game::Render()
         topItem.tile = {};
         topItem.npc = &npc;
         renderList.push_back(topItem);
+        ++m_VisibleNpcCount;
     }
 
     // Add player.
@@ -1002,46 +1750,35 @@ void Game::Render()
     }
 
     // Sort by Y coordinate ascending (lower Y = further from camera = render first).
-    // - Normal tiles (Y-sort+1): use epsilon tiebreaker (tile behind, player in front at same Y)
-    // - Y-sort-1 tiles: use Y offset so tile renders in front at same Y, no tiebreaker
-    // Use stable_sort to maintain consistent ordering for equal elements
-    std::stable_sort(renderList.begin(), renderList.end(),
-              [](const RenderItem &a, const RenderItem &b)
-              {
-                  bool aIsYSortMinusTile = (a.type == RenderItem::TILE && a.tile.ySortMinus);
-                  bool bIsYSortMinusTile = (b.type == RenderItem::TILE && b.tile.ySortMinus);
-
-                  // If comparing a Y-sort-1 tile with an entity, use offset-based comparison
-                  // The offset makes the tile sort as if slightly lower, so it renders in front
-                  // when at the same actual Y, but behind when player has walked past
-                  bool aIsEntity = (a.type <= RenderItem::NPC_BOTTOM);
-                  bool bIsEntity = (b.type <= RenderItem::NPC_BOTTOM);
-
-                  if ((aIsYSortMinusTile && bIsEntity) || (bIsYSortMinusTile && aIsEntity))
-                  {
-                      // Half-tile offset: player must be at least 8px in front to render in front
-                      float aSortY = a.sortY + (aIsYSortMinusTile ? 8.0f : 0.0f);
-                      float bSortY = b.sortY + (bIsYSortMinusTile ? 8.0f : 0.0f);
-                      // Use epsilon for float comparison to avoid flickering
-                      if (std::abs(aSortY - bSortY) > 0.1f)
-                          return aSortY < bSortY;
-                      // Within epsilon: entity first (behind), tile second (in front)
-                      return a.type < b.type;
-                  }
-
-                  // Normal comparison with epsilon tiebreaker
-                  const float epsilon = 1.0f;
-                  if (std::abs(a.sortY - b.sortY) > epsilon)
-                      return a.sortY < b.sortY;
-
-                  // Tiebreaker: higher type comes first (renders behind)
-                  // TILE(4) before PLAYER(0/1) = TILE renders first = TILE behind, PLAYER in front
-                  return a.type > b.type;
-              });
+    // Every pairwise rule is folded into one key per item, so the list is
+    // radix sorted instead of compared:
+    // - Entities sort 1px lower: a normal tile (Y-sort+1) stays behind an
+    //   entity standing up to 1px in front of its anchor
+    // - Y-sort-1 tiles sort a further 8.1px lower: the player must be more
+    //   than 8px in front of the anchor to render in front of the tile
+    // - At equal keys, tiles draw first, then NPC bottom/top, player
+    //   bottom/top, and Y-sort-1 tiles last; equal ranks keep list order
+    constexpr float ENTITY_SORT_BIAS = 1.0f;
+    constexpr float YSORT_MINUS_SORT_BIAS = ENTITY_SORT_BIAS + 8.0f + 0.1f;
+    constexpr std::uint8_t YSORT_MINUS_RANK = RenderItem::TILE + 1;
+    static YSortQueue renderQueue;
+    renderQueue.Clear();
+    renderQueue.Reserve(renderList.size());
+    for (const auto &item : renderList)
+    {
+        if (item.type != RenderItem::TILE)
+            renderQueue.Add(item.sortY + ENTITY_SORT_BIAS, static_cast<std::uint8_t>(RenderItem::TILE - item.type));
+        else if (item.tile.ySortMinus)
+            renderQueue.Add(item.sortY + YSORT_MINUS_SORT_BIAS, YSORT_MINUS_RANK);
+        else
+            renderQueue.Add(item.sortY, 0);
+    }
+    renderQueue.Sort();
 
     // Render sorted list
-    for (const auto &item : renderList)
+    for (size_t i = 0; i < renderQueue.Size(); ++i)
     {
+        const RenderItem &item = renderList[renderQueue.IndexAt(i)];
         switch (item.type)
         {
         case RenderItem::TILE:
@@ -1080,11 +1817,17 @@ void Game::Render()
         }
     }
 
+    m_Renderer->EndGpuTimer();
+
     // Render no-projection tiles from foreground layers
+    m_Renderer->BeginGpuTimer("Foreground");
     m_Tilemap.RenderForegroundLayersNoProjection(*m_Renderer, renderCam, renderSize, cullCam, cullSize);
+    m_Renderer->EndGpuTimer();
 
     // Render noProjection particles, particle system handles suspend internally
+    m_Renderer->BeginGpuTimer("Particles");
     m_Particles.Render(*m_Renderer, m_CameraPosition, true, false);
+    m_Renderer->EndGpuTimer();
 
     // Resume perspective for normal foreground rendering
     // (perspective may still be suspended from Y-sorted loop or RenderForegroundLayersNoProjection
@@ -1092,12 +1835,20 @@ void Game::Render()
     m_Renderer->SuspendPerspective(false);
 
     // Render foreground layers, Y-sorted and no-projection tiles are skipped
+    m_Renderer->BeginGpuTimer("Foreground");
     m_Tilemap.RenderForegroundLayers(*m_Renderer, renderCam, renderSize, cullCam, cullSize);
+    m_Renderer->EndGpuTimer();
 
     // Render regular particles on top of world
+    m_Renderer->BeginGpuTimer("Particles");
     m_Particles.Render(*m_Renderer, m_CameraPosition, false, false);
+    m_Renderer->EndGpuTimer();
+
+    // Sky effects and everything after them keep the flat ambient tint
+    m_Renderer->ClearLightMap();
 
     // Render ambient light overlay
+    m_Renderer->BeginGpuTimer("Sky");
     m_Renderer->SuspendPerspective(true);
     glm::mat4 screenProjection = glm::ortho(0.0f, worldWidth, worldHeight, 0.0f);
     m_Renderer->SetProjection(screenProjection);
@@ -1105,6 +1856,15 @@ void Game::Render()
                          static_cast<int>(worldWidth), static_cast<int>(worldHeight));
     m_Renderer->SetProjection(projection); // Restore world projection
     m_Renderer->SuspendPerspective(false);
+    m_Renderer->EndGpuTimer();
+
+    // Upscale the world now so editor overlays and text get full resolution
+    if (m_LowResUIFullRes)
+    {
+        endLowResPass();
+    }
+
+    m_Renderer->BeginGpuTimer("UI");
 
     // Render editor overlays and tile picker
     if (m_Editor.IsActive() || m_Editor.IsDebugMode())
@@ -1166,54 +1926,25 @@ void Game::Render()
         m_Renderer->DrawText(tileText, glm::vec2(12.0f, 32.0f + lineHeight * currentLine++), 1.0f, glm::vec3(1.0f, 1.0f, 0.0f), 2.0f, 0.85f);
 
         // Draw active quests section (with spacing and descriptions)
-        auto activeQuests = m_GameState.GetActiveQuests();
-        if (!activeQuests.empty())
+        const std::vector<QuestHudLine> &questLines = GetQuestHudLines();
+        if (!questLines.empty())
         {
             currentLine += 0.5f; // Add spacing before quests section
             glm::vec3 questGold(1.0f, 0.85f, 0.2f);
             glm::vec3 descColor(0.9f, 0.75f, 0.5f);
 
-            for (const auto &quest : activeQuests)
+            for (const QuestHudLine &quest : questLines)
             {
-                // Format quest name: "wolf_quest" -> "Wolf Quest"
-                std::string displayName = quest;
-                // Replace underscores with spaces and capitalize
-                for (size_t i = 0; i < displayName.size(); ++i)
-                {
-                    if (displayName[i] == '_')
-                    {
-                        displayName[i] = ' ';
-                        if (i + 1 < displayName.size())
-                        {
-                            displayName[i + 1] = static_cast<char>(std::toupper(displayName[i + 1]));
-                        }
-                    }
-                }
-                if (!displayName.empty())
-                {
-                    displayName[0] = static_cast<char>(std::toupper(displayName[0]));
-                }
-
                 // Draw quest title with exclamation mark
                 float questTextX = 52.0f; // X position where quest name starts
                 glm::vec3 exclamYellow(1.0f, 1.0f, 0.0f);
                 m_Renderer->DrawText(">!<", glm::vec2(12.0f, 32.0f + lineHeight * currentLine), 1.0f, exclamYellow, 2.0f, 0.85f);
-                m_Renderer->DrawText(displayName, glm::vec2(questTextX, 32.0f + lineHeight * currentLine++), 1.0f, questGold, 2.0f, 0.85f);
+                m_Renderer->DrawText(quest.title, glm::vec2(questTextX, 32.0f + lineHeight * currentLine++), 1.0f, questGold, 2.0f, 0.85f);
 
                 // Draw quest description if available
-                std::string description = m_GameState.GetQuestDescription(quest);
-                if (!description.empty())
+                if (!quest.description.empty())
                 {
-                    // Truncate after 20 chars at word boundary
-                    if (description.size() > 20)
-                    {
-                        size_t cutPos = 20;
-                        // Find end of current word (next space or end of string)
-                        while (cutPos < description.size() && description[cutPos] != ' ')
-                            ++cutPos;
-                        description = description.substr(0, cutPos) + "...";
-                    }
-                    m_Renderer->DrawText(description, glm::vec2(questTextX, 32.0f + lineHeight * currentLine++), 0.8f, descColor, 2.0f, 0.7f);
+                    m_Renderer->DrawText(quest.description, glm::vec2(questTextX, 32.0f + lineHeight * currentLine++), 0.8f, descColor, 2.0f, 0.7f);
                 }
             }
         }
@@ -1228,9 +1959,12 @@ void Game::Render()
         float textWidth = strnlen(rendererText, sizeof(rendererText)) * 12.0f;
         m_Renderer->DrawText(rendererText, glm::vec2(rightMargin - textWidth, 32.0f), 1.0f, glm::vec3(1.0f, 0.3f, 0.3f), 2.0f, 0.85f);
 
-        // Resolution
-        char resText[32];
-        snprintf(resText, sizeof(resText), "%dx%d", m_ScreenWidth, m_ScreenHeight);
+        // Resolution (plus the world target size in low-res mode)
+        char resText[48];
+        if (lowRes)
+            snprintf(resText, sizeof(resText), "%dx%d (%dx%d)", m_ScreenWidth, m_ScreenHeight, lowResWidth, lowResHeight);
+        else
+            snprintf(resText, sizeof(resText), "%dx%d", m_ScreenWidth, m_ScreenHeight);
         textWidth = strnlen(resText, sizeof(resText)) * 12.0f;
         m_Renderer->DrawText(resText, glm::vec2(rightMargin - textWidth, 32.0f + lineHeight), 1.0f, glm::vec3(1.0f, 0.3f, 0.3f), 2.0f, 0.85f);
 
@@ -1253,10 +1987,32 @@ void Game::Render()
         textWidth = m_Renderer->GetTextWidth(drawCallText, 1.0f);
         m_Renderer->DrawText(drawCallText, glm::vec2(rightMargin - textWidth, 32.0f + lineHeight * 4), 1.0f, glm::vec3(1.0f, 0.3f, 0.3f), 2.0f, 0.85f);
 
+        // GPU time per pass (resolved a few frames late, see IRenderer::BeginGpuTimer)
+        float gpuLine = 5.0f;
+        for (const GpuTimerResult &timing : m_Renderer->GetGpuTimerResults())
+        {
+            char gpuText[48];
+            snprintf(gpuText, sizeof(gpuText), "%s: %.2fms", timing.name, timing.milliseconds);
+            textWidth = m_Renderer->GetTextWidth(gpuText, 0.8f);
+            m_Renderer->DrawText(gpuText, glm::vec2(rightMargin - textWidth, 32.0f + lineHeight * gpuLine++), 0.8f, glm::vec3(1.0f, 0.6f, 0.6f), 2.0f, 0.85f);
+        }
+
         // Restore world projection (in case EndFrame flushes any batches)
         m_Renderer->SetProjection(projection);
     }
 
+    // Performance HUD in bottom left corner (F12 toggle)
+    if (m_PerfHud.IsVisible())
+    {
+        glm::mat4 uiProjection = glm::ortho(0.0f, static_cast<float>(m_ScreenWidth),
+                                            static_cast<float>(m_ScreenHeight), 0.0f, -1.0f, 1.0f);
+        m_Renderer->SetProjection(uiProjection);
+        m_Renderer->SuspendPerspective(true);
+        m_PerfHud.Render(*m_Renderer, static_cast<float>(m_ScreenHeight));
+        m_Renderer->SuspendPerspective(false);
+        m_Renderer->SetProjection(projection);
+    }
+
     // Render no-projection anchors on top of everything
     if (m_Editor.IsShowNoProjectionAnchors())
     {
@@ -1264,8 +2020,13 @@ void Game::Render()
         m_Editor.RenderNoProjectionAnchors(MakeEditorContext());
         m_Renderer->SuspendPerspective(false);
     }
+    m_Renderer->EndGpuTimer();
 
-    m_Renderer->EndFrame();
+    endLowResPass();
+    {
+        WILD_PROFILE_ZONE("End Frame");
+        m_Renderer->EndFrame();
+    }
 
     // Restore unsnapped camera for game state updates
     m_CameraPosition = originalCamera;
@@ -1273,8 +2034,8 @@ void Game::Render()
     // Accumulate draw calls for averaging (calculated in Update())
     m_DrawCallAccumulator += m_Renderer->GetDrawCallCount();
 
-    // Swap buffers
-    if (m_RendererAPI == RendererAPI::OpenGL)
+    // Swap buffers (the render thread presents pipelined frames)
+    if (m_RendererAPI == RendererAPI::OpenGL && !m_Pipeline)
     {
         // DEBUG: Print frame end marker
         extern bool g_DebugDrawSleep;
@@ -1282,15 +2043,73 @@ void Game::Render()
         {
             std::cout << "===== FRAME END =====" << std::endl;
         }
+        WILD_PROFILE_ZONE("Present");
         glfwSwapBuffers(m_Window);
     }
     // Vulkan handles its own presentation in EndFrame()
 }
 
+const std::vector<Game::QuestHudLine> &Game::GetQuestHudLines()
+{
+    // Rebuilt only when a flag changed since the last build
+    if (m_QuestHudVersion == m_GameState.GetVersion())
+        return m_QuestHudLines;
+    m_QuestHudVersion = m_GameState.GetVersion();
+
+    m_QuestHudLines.clear();
+    for (const std::string &quest : m_GameState.GetActiveQuests())
+    {
+        QuestHudLine &line = m_QuestHudLines.emplace_back();
+
+        // Format quest name: "wolf_quest" -> "Wolf Quest"
+        line.title = quest;
+        // Replace underscores with spaces and capitalize
+        for (size_t i = 0; i < line.title.size(); ++i)
+        {
+            if (line.title[i] == '_')
+            {
+                line.title[i] = ' ';
+                if (i + 1 < line.title.size())
+                {
+                    line.title[i + 1] = static_cast<char>(std::toupper(line.title[i + 1]));
+                }
+            }
+        }
+        if (!line.title.empty())
+        {
+            line.title[0] = static_cast<char>(std::toupper(line.title[0]));
+        }
+
+        line.description = m_GameState.GetQuestDescription(quest);
+        // Truncate after 20 chars at word boundary
+        if (line.description.size() > 20)
+        {
+            size_t cutPos = 20;
+            // Find end of current word (next space or end of string)
+            while (cutPos < line.description.size() && line.description[cutPos] != ' ')
+                ++cutPos;
+            line.description = line.description.substr(0, cutPos) + "...";
+        }
+    }
+    return m_QuestHudLines;
+}
+
 void Game::Shutdown()
 {
+    StopProfilerCapture();
+    StopInputRecording();
+    m_WorldStreamer.Close();
+    m_AssetWatcher.Stop();
+    SpriteSheetRegistry::SetLoader(nullptr);
+    m_TextureLoader.Clear();
+    SetPipelinedRendering(false);
+
     if (m_Renderer)
     {
+        // Chunk meshes belong to this renderer
+        m_Tilemap.ReleaseChunkMeshes();
+        m_Editor.ReleaseOverlayMeshes();
+        SpriteSheetRegistry::SetRenderer(nullptr);
         m_Renderer->Shutdown();
         m_Renderer.reset();
     }
@@ -1309,7 +2128,7 @@ bool Game::SwitchRenderer(RendererAPI api)
     // This requires destroying and recreating the GLFW window because:
     // - OpenGL needs GLFW_OPENGL_CORE_PROFILE context
     // - Vulkan needs GLFW_NO_API (no OpenGL context)
-    // All GPU resources (textures, shaders) must be re-uploaded after the switch.
+    // Textures are re-created from their CPU copies in one batched pass.
 
     if (api == m_RendererAPI)
     {
@@ -1329,9 +2148,18 @@ bool Game::SwitchRenderer(RendererAPI api)
               << (api == RendererAPI::OpenGL ? "OpenGL" : "Vulkan")
               << "..." << std::endl;
 
+    // The render thread holds the GL context of the window about to go away
+    const bool wasPipelined = m_Pipeline != nullptr;
+    SetPipelinedRendering(false);
+
     // Shutdown current renderer
     if (m_Renderer)
     {
+        // Chunk meshes belong to this renderer, line widths to its font
+        m_Tilemap.ReleaseChunkMeshes();
+        m_Editor.ReleaseOverlayMeshes();
+        m_TextLayouts.Clear();
+        SpriteSheetRegistry::SetRenderer(nullptr);
         m_Renderer->Shutdown();
         m_Renderer.reset();
     }
@@ -1372,11 +2200,9 @@ bool Game::SwitchRenderer(RendererAPI api)
     }
     glfwSetWindowPos(m_Window, windowX, windowY);
 
-    // Restore window callbacks
-    glfwSetWindowUserPointer(m_Window, this);
-    glfwSetScrollCallback(m_Window, ScrollCallback);
-    glfwSetFramebufferSizeCallback(m_Window, FramebufferSizeCallback);
-    glfwSetWindowRefreshCallback(m_Window, WindowRefreshCallback);
+    // Restore window callbacks; releases for keys held across the switch went to the old window
+    m_Input.ReleaseAll();
+    InstallWindowCallbacks();
 
     // Create new renderer
     m_Renderer.reset(CreateRenderer(m_RendererAPI, m_Window));
@@ -1385,6 +2211,7 @@ bool Game::SwitchRenderer(RendererAPI api)
         std::cerr << "Failed to create renderer during switch" << std::endl;
         return false;
     }
+    SpriteSheetRegistry::SetRenderer(m_Renderer.get());
 
     // Initialize OpenGL-specific stuff
     if (m_RendererAPI == RendererAPI::OpenGL)
@@ -1409,30 +2236,42 @@ bool Game::SwitchRenderer(RendererAPI api)
     }
 
     // Initialize renderer
+    m_Renderer->SetPresentMode(m_PresentMode);
+    m_Renderer->SetFramesInFlight(m_FramesInFlight);
     m_Renderer->Init();
+    m_Renderer->SetJobSystem(&m_Jobs);
 
     // Set viewport and projection
     m_Renderer->SetViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
+    m_Renderer->SetGpuProjection(m_GpuProjection);
+    m_Particles.SetGpuSimulation(m_GpuParticles && m_Renderer->SupportsGpuParticles());
     float worldWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth()) / m_CameraZoom;
     float worldHeight = static_cast<float>(m_TilesVisibleHeight * m_Tilemap.GetTileHeight()) / m_CameraZoom;
     ConfigureRendererPerspective(worldWidth, worldHeight);
     glm::mat4 projection = GetOrthoProjection(worldWidth, worldHeight);
     m_Renderer->SetProjection(projection);
 
-    // Re-upload textures to new renderer
-    m_Renderer->UploadTexture(m_Tilemap.GetTilesetTexture());
-    m_Player.UploadTextures(*m_Renderer);
-    for (auto &npc : m_NPCs)
+    // Every texture the old renderer had, from its CPU copy; nothing is decoded again
     {
-        npc.UploadTextures(*m_Renderer);
+        WILD_PROFILE_ZONE("Re-upload Textures");
+        const double start = glfwGetTime();
+        const std::vector<Texture *> textures = Texture::GetUploadedTextures();
+        m_Renderer->UploadTextures(textures, &m_Jobs);
+        std::cout << "Re-uploaded " << textures.size() << " textures in "
+                  << (glfwGetTime() - start) * 1000.0 << " ms" << std::endl;
     }
-    m_Particles.UploadTextures(*m_Renderer);
+    // Also drops the sky's cached layer and star buffer, which went with the old renderer
     m_SkyRenderer.UploadTextures(*m_Renderer);
 
     std::cout << "Renderer switch complete! Now using "
               << (m_RendererAPI == RendererAPI::OpenGL ? "OpenGL" : "Vulkan")
               << std::endl;
 
+    if (wasPipelined && m_RendererAPI == RendererAPI::OpenGL)
+    {
+        SetPipelinedRendering(true);
+    }
+
     return true;
 }
 
@@ -1463,8 +2302,8 @@ void Game::OnFramebufferResized(int width, int height)
         m_Renderer->SetViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
     }
 
-    // Update OpenGL viewport if using OpenGL
-    if (m_RendererAPI == RendererAPI::OpenGL)
+    // Update OpenGL viewport if using OpenGL (and this thread holds the context)
+    if (m_RendererAPI == RendererAPI::OpenGL && !m_Pipeline)
     {
         glViewport(0, 0, m_ScreenWidth, m_ScreenHeight);
     }
@@ -1500,6 +2339,25 @@ void Game::SnapWindowToTileBoundaries()
     m_PendingWindowSnap = false;
 }
 
+void Game::InstallWindowCallbacks()
+{
+    // Store Game instance pointer in window for callbacks
+    glfwSetWindowUserPointer(m_Window, this);
+
+    glfwSetScrollCallback(m_Window, ScrollCallback);
+    glfwSetKeyCallback(m_Window, KeyCallback);
+    glfwSetMouseButtonCallback(m_Window, MouseButtonCallback);
+    glfwSetCursorPosCallback(m_Window, CursorPosCallback);
+    glfwSetFramebufferSizeCallback(m_Window, FramebufferSizeCallback);
+    glfwSetWindowRefreshCallback(m_Window, WindowRefreshCallback);
+
+    // The cursor callback only fires on movement
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    glfwGetCursorPos(m_Window, &cursorX, &cursorY);
+    m_Input.OnCursorPos(cursorX, cursorY);
+}
+
 void Game::FramebufferSizeCallback(GLFWwindow *window, int width, int height)
 {
     // Get "this" back from the window's user data
@@ -1526,6 +2384,7 @@ EditorContext Game::MakeEditorContext()
 {
     return EditorContext{
         m_Window,
+        m_Input,
         m_ScreenWidth,
         m_ScreenHeight,
         m_TilesVisibleWidth,
@@ -1542,6 +2401,7 @@ EditorContext Game::MakeEditorContext()
         m_Player,
         m_NPCs,
         *m_Renderer,
-        m_Particles
+        m_Particles,
+        m_WorldStreamer
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Tilemap.h"
+#include "WorldStreamer.h"
 #include "PlayerCharacter.h"
 #include "NonPlayerCharacter.h"
 #include "ParticleSystem.h"
@@ -8,8 +9,25 @@
 #include "GameStateManager.h"
 #include "TimeManager.h"
 #include "SkyRenderer.h"
+#include "SpatialHash.h"
+#include "CharacterStore.h"
+#include "Pathfinder.h"
+#include "JobSystem.h"
+#include "FixedTimestep.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "PerfHud.h"
+#include "AllocationCounter.h"
+#include "AssetWatcher.h"
+#include "AsyncTextureLoader.h"
+#include "BenchmarkScript.h"
+#include "BenchmarkReport.h"
+#include "InputState.h"
+#include "TextLayoutCache.h"
+#include "SimulationLod.h"
 #include "Editor.h"
 #include "IRenderer.h"
+#include "PipelinedRenderer.h"
 #include "RendererAPI.h"
 #include "RendererFactory.h"
 
@@ -29,15 +47,25 @@
  * It owns all major game systems and manages their lifecycle.
  * 
  * @par Game Loop
- * Uses a simple variable-timestep loop:
+ * Simulates in fixed 60 Hz steps and draws every frame in between:
  * @code
  * while (!shouldClose) {
  *     float deltaTime = currentTime - lastTime;
- *     ProcessInput(deltaTime);
- *     Update(deltaTime);
- *     Render();
+ *     for (int i = timestep.Advance(deltaTime); i > 0; --i) {
+ *         ProcessInput(step);
+ *         Update(step);
+ *     }
+ *     RenderInterpolated(timestep.GetAlpha());
  * }
  * @endcode
+ * SetFixedTimestep(false) (or F9) switches back to one variable-length
+ * ProcessInput()/Update() per rendered frame.
+ *
+ * @par Input
+ * GLFW callbacks feed an InputState that is latched once per step, and all
+ * game and editor input is read from it. StartInputRecording() writes the
+ * latched steps to a log; RunReplay() plays one back step for step with the
+ * recorded seed and clock (`wild --record` / `wild --replay`).
  * 
  * @par Frame Timing
  * Delta time is clamped to 0.1s (MAX_DELTA_TIME) to prevent physics
@@ -148,21 +176,23 @@ public:
     bool Initialize();
 
     /**
-     * @brief Starts and maintains the engine's main game loop (variable timestep).
+     * @brief Starts and maintains the engine's main game loop.
      *
      * @details
      * This function is **blocking** and returns only when the application is asked to exit
      *
-     * The loop uses a **variable timestep**: each iteration computes a frame-to-frame
-     * delta time based on the current GLFW time and forwards it to the simulation and rendering
-     * stages.
+     * By default the simulation runs at a **fixed timestep**: the frame-to-frame
+     * delta time goes into m_Timestep, which hands back zero or more whole steps,
+     * and the frame is drawn between the last two simulated states. With the fixed
+     * timestep disabled the frame delta is forwarded directly (variable timestep).
      *
      * @par Per-frame execution order
      * Each frame performs the following steps in order:
      * - Compute @p deltaTime since the previous frame
-     * - @ref ProcessInput(float) "ProcessInput(deltaTime)"
-     * - @ref Update(float) "Update(deltaTime)"
-     * - @ref Render() "Render()"
+     * - For each fixed step: BeginSimulationStep(), ProcessInput(step), Update(step)
+     *   (once with @p deltaTime when the fixed timestep is off)
+     * - UpdateFrameStats(deltaTime)
+     * - @ref RenderInterpolated(float) "RenderInterpolated(alpha)" (or Render())
      * - Poll GLFW events via @c glfwPollEvents()
      *
      * @see ProcessInput(float)
@@ -188,6 +218,129 @@ public:
      * @param fps Target FPS (<=0 = unlimited, default).
      */
     void SetTargetFps(float fps) { m_TargetFps = fps; }
+
+    /**
+     * @brief Simulate in fixed steps with interpolated drawing (default on, 60 Hz).
+     * @param enabled False runs one variable-length update per rendered frame.
+     * @param rate    Simulation steps per second.
+     */
+    void SetFixedTimestep(bool enabled, float rate = 60.0f);
+
+    /**
+     * @brief Record frames on this thread and draw them on a render thread (default off).
+     * @param enabled True wraps the renderer in a PipelinedRenderer.
+     * @return false if the active backend does not support it (Vulkan).
+     *
+     * Simulation of the next frame then overlaps the batching and GL calls
+     * of the previous one, at the cost of one frame of latency.
+     */
+    bool SetPipelinedRendering(bool enabled);
+
+    /**
+     * @brief GPU texture memory before idle sprite sheets are evicted (default DEFAULT_TEXTURE_BUDGET).
+     * @param bytes      Budget for all uploaded textures; 0 never evicts.
+     * @param idleFrames Frames a sheet must go undrawn before it may be evicted.
+     *
+     * Evicted sheets reload through the texture loader the next time a
+     * character draws them. See SpriteSheetRegistry::SetBudget().
+     */
+    void SetTextureBudget(size_t bytes, uint64_t idleFrames = SpriteSheetRegistry::DEFAULT_IDLE_FRAMES);
+
+    /**
+     * @brief Start recording profiler zones for a Chrome trace.
+     * @param path   File the trace is written to when the capture stops.
+     * @param frames Stop and write after this many frames, 0 = until
+     *               StopProfilerCapture() (F11) or shutdown.
+     *
+     * Has no effect in builds without ENABLE_PROFILER.
+     */
+    void StartProfilerCapture(const std::string &path, int frames = 0);
+
+    /// @brief Stop a running capture and write it; no-op when none runs.
+    void StopProfilerCapture();
+
+    /// @brief Settings for a scripted benchmark run (`wild --benchmark`).
+    struct BenchmarkOptions
+    {
+        std::string mapPath;                        ///< .json or .wmap map, or a streamed world directory
+        std::string scriptPath;                     ///< BenchmarkScript file
+        std::string outputPath = "benchmark.json";  ///< Where the BenchmarkReport is written
+        RendererAPI renderer = RendererAPI::OpenGL;
+        bool hiddenWindow = false;                  ///< Create the window invisible
+        int frames = 0;                             ///< Overrides the script's frame count when > 0
+    };
+
+    /**
+     * @brief Prepare a benchmark run; call before Initialize().
+     *
+     * Loads the script. Initialize() then creates the window hidden if
+     * requested, starts on the chosen backend and loads the given map
+     * instead of the save files.
+     *
+     * @return false if the script can't be loaded.
+     */
+    bool ConfigureBenchmark(const BenchmarkOptions &options);
+
+    /**
+     * @brief Run the configured benchmark instead of Run() and write its report.
+     *
+     * Seeds the particle and NPC RNGs, freezes the clock at the script's
+     * time of day and then, for each frame, simulates one step of the
+     * script's length without input, moves the player and camera to the
+     * scripted pose and renders with no frame pacing. The first warmup
+     * frames are not measured.
+     *
+     * @return false if no benchmark is configured, the window was closed
+     *         early or the report can't be written.
+     */
+    bool RunBenchmark();
+
+    /// @brief Settings for replaying an input log (`wild --replay`).
+    struct ReplayOptions
+    {
+        std::string logPath;                     ///< Log written by StartInputRecording()
+        std::string outputPath = "replay.json";  ///< Where the BenchmarkReport is written
+        RendererAPI renderer = RendererAPI::OpenGL;
+        bool hiddenWindow = false;               ///< Create the window invisible
+    };
+
+    /**
+     * @brief Prepare an input replay; call before Initialize().
+     *
+     * Loads and checks the log. Initialize() then opens the window at the
+     * recorded size, hidden if requested, on the chosen backend.
+     *
+     * @return false if the log can't be loaded.
+     */
+    bool ConfigureReplay(const ReplayOptions &options);
+
+    /**
+     * @brief Replay the configured log instead of Run() and write a report.
+     *
+     * Restores the recorded RNG seed and clock, then runs exactly one
+     * fixed step of the recorded length per frame with the logged input,
+     * renders it and measures it like RunBenchmark(). No wall-clock time
+     * reaches the simulation, so every build sees the same session.
+     * Editor saving is disabled for the run.
+     *
+     * @return false if no replay is configured, the window was closed
+     *         before the log ended or the report can't be written.
+     */
+    bool RunReplay();
+
+    /**
+     * @brief Record the input of every following step to @p path (`wild --record`).
+     *
+     * Call after Initialize() and before Run(). Reseeds the RNGs with a
+     * fresh seed, switches to fixed steps (locked until shutdown) and
+     * stores both in the log header with the clock and window size.
+     *
+     * @return false if the log can't be created.
+     */
+    bool StartInputRecording(const std::string &path);
+
+    /// @brief Finish the log; no-op when not recording. Called by Shutdown().
+    bool StopInputRecording();
     
     /**
      * @brief Switch to a different renderer API at runtime.
@@ -206,14 +359,10 @@ public:
     RendererAPI GetRendererAPI() const { return m_RendererAPI; }
 
     /**
-     * @brief GLFW scroll callback for tile picker navigation.
+     * @brief GLFW scroll callback; queues the event for the next step.
      *
-     * Static callback registered with GLFW to handle mouse wheel events.
-     * Behavior depends on current mode:
-     * - **Elevation edit mode** (no Ctrl): Adjusts elevation paint value (0-32)
-     * - **Ctrl+scroll** (tile picker closed): Camera zoom (0.1x-4.0x)
-     * - **Ctrl+scroll** (tile picker open): Tile picker zoom
-     * - **Scroll** (tile picker open, no Ctrl): Tile picker navigation
+     * The wheel is handled by HandleScroll() from ProcessInput(), so it is
+     * part of the latched input and replays on the step it was recorded in.
      *
      * @param window GLFW window handle.
      * @param xoffset Horizontal scroll offset (unused).
@@ -221,6 +370,14 @@ public:
      */
     static void ScrollCallback(GLFWwindow *window, double xoffset, double yoffset);
 
+    /// @name Input Callbacks
+    /// Forward GLFW events to m_Input.
+    /// @{
+    static void KeyCallback(GLFWwindow *window, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
+    static void CursorPosCallback(GLFWwindow *window, double x, double y);
+    /// @}
+
 private:
     /**
      * @brief Process keyboard and mouse input.
@@ -232,6 +389,28 @@ private:
      */
     void ProcessInput(float deltaTime);
 
+    /**
+     * @brief Apply one mouse wheel event; called by ProcessInput() for each queued event.
+     *
+     * - **Elevation edit mode** (no Ctrl): Adjusts elevation paint value (0-32)
+     * - **Ctrl+scroll** (tile picker closed): Camera zoom (0.1x-4.0x)
+     * - **Ctrl+scroll** (tile picker open): Tile picker zoom
+     * - **Scroll** (tile picker open, no Ctrl): Tile picker navigation
+     *
+     * @param yoffset Vertical scroll offset (positive = up/zoom in, negative = down/zoom out).
+     */
+    void HandleScroll(double yoffset);
+
+    /// @brief Install the GLFW callbacks on m_Window (after creating or recreating it).
+    void InstallWindowCallbacks();
+
+    /// @brief Seed the particle, NPC and editor RNGs for a repeatable run.
+    void SeedSimulation(std::uint32_t seed);
+
+    /// @brief Write a benchmark or replay report and print its summary.
+    bool SaveRunReport(const BenchmarkReport &report, const BenchmarkReport::RunInfo &info,
+                       const std::string &path, const char *label);
+
     /**
      * @brief Update game state.
      * 
@@ -258,6 +437,51 @@ private:
      */
     void Render();
 
+    /// @brief Title and shortened description of one active quest on the debug HUD.
+    struct QuestHudLine
+    {
+        std::string title;        ///< "wolf_quest" -> "Wolf Quest"
+        std::string description;  ///< Cut after the word at 20 characters
+    };
+
+    /// @brief HUD quest lines, rebuilt when GameStateManager::GetVersion() changes.
+    const std::vector<QuestHudLine> &GetQuestHudLines();
+
+    /**
+     * @brief Render() with characters and camera blended between the last two steps.
+     *
+     * Positions are swapped in before Render() and the simulated ones
+     * restored afterwards, like the pixel-snapped camera inside Render().
+     *
+     * @param alpha FixedTimestep::GetAlpha() (0 = previous step, 1 = latest).
+     */
+    void RenderInterpolated(float alpha);
+
+    /// @brief Record the state interpolation starts from; called before every fixed step.
+    void BeginSimulationStep();
+
+    /// @brief Advance the FPS and draw call counters by one rendered frame.
+    void UpdateFrameStats(float frameTime);
+
+    /// @brief Print the frame pacer's jitter statistics and start a new measurement.
+    void ReportFramePacing();
+
+    /**
+     * @brief Hot-reload the files AssetWatcher reported since the last frame.
+     *
+     * Tilesets are decoded off-thread and patched into the combined texture,
+     * live character sheets re-decoded in place, and a changed shader
+     * recompiles the renderer's sprite shaders. Other files are ignored.
+     */
+    void ReloadChangedAssets();
+
+    /// @brief Hand the frame that just finished to the performance HUD.
+    /// @param cpuSeconds Time from the frame start to the pacing wait.
+    void RecordPerfHudFrame(double cpuSeconds);
+
+    /// @brief Place the player and center the camera for a benchmark frame.
+    void ApplyBenchmarkPose(const BenchmarkScript::Pose &pose);
+
     /**
      * @brief Compute a projection matrix with 3D globe effect.
      * 
@@ -296,6 +520,31 @@ private:
      */
     void RenderNPCHeadText();
 
+    /**
+     * @brief Bring m_NPCGrid in line with m_NPCs.
+     *
+     * Re-submits every NPC's position to the grid, which only re-buckets
+     * NPCs that changed cell. Grid ids are indices into m_NPCs; ids past the
+     * end of m_NPCs (after streaming or editor removal) are dropped.
+     */
+    void SyncNPCGrid();
+
+    /**
+     * @brief Simulate one NPC row at the level m_NPCLod picks for it.
+     *
+     * Skipped frames accumulate in the row and are handed over when it is
+     * next due. Time spent Dormant is always settled with UpdateDormant(),
+     * so an NPC that comes back into view resumes normal updates with a
+     * single frame's step. Runs on job threads; touches only @p slot and
+     * the NPC that owns it.
+     *
+     * @param store Store holding the row (CharacterStore::Npcs()).
+     * @param slot Live row; also staggers reduced-rate updates.
+     * @param deltaTime Frame time in seconds.
+     * @param playerPos Player feet position for collision.
+     */
+    void UpdateNPC(CharacterStore &store, CharacterStore::Slot slot, float deltaTime, const glm::vec2 &playerPos);
+
     /**
      * @brief Render text inside the dialogue box.
      *
@@ -339,6 +588,11 @@ private:
     static constexpr int PIXEL_SCALE = 5;       ///< Scale factor for rendering (5x)
     float m_ResizeSnapTimer;                    ///< Timer for deferred window snap after resize
     bool m_PendingWindowSnap;                   ///< Whether a window snap is pending
+    bool m_LowResRendering;                     ///< Draw the world at 1/PIXEL_SCALE and upscale (F7)
+    bool m_LowResUIFullRes;                     ///< Draw UI after the upscale, at window resolution
+    bool m_LightMap;                            ///< Light the world from a low-res light map when supported
+    std::vector<IRenderer::Light> m_Lights;     ///< Lights collected for this frame's light map
+    static constexpr float LIGHT_MAP_CELL_SIZE = TILE_PIXEL_SIZE / 4.0f;  ///< World units per light map texel
     /** @} */
     
     /**
@@ -371,11 +625,21 @@ private:
     Tilemap m_Tilemap;                       ///< The game world
     PlayerCharacter m_Player;                ///< Player-controlled character
     std::vector<NonPlayerCharacter> m_NPCs;  ///< All NPCs in the world
+    SpatialHash m_NPCGrid;                   ///< NPC feet positions by tile cell (ids index m_NPCs)
+    Pathfinder m_Pathfinder;                 ///< Budgeted goal-directed NPC paths over m_Tilemap
+    JobSystem m_Jobs;                        ///< Worker threads for the parallel NPC update
+    SimulationLod m_NPCLod;                  ///< Per-NPC update rate by distance to the view
     ParticleSystem m_Particles;              ///< Ambient particle effects (fireflies, etc.)
+    WorldStreamer m_WorldStreamer;           ///< Region streaming when running from a world directory
+    AsyncTextureLoader m_TextureLoader;      ///< Decodes sprite sheets off-thread (destroyed before the characters)
+    AssetWatcher m_AssetWatcher;             ///< Reports edited files under assets/ and shaders/
     TimeManager m_TimeManager;               ///< Day/night cycle time management
     SkyRenderer m_SkyRenderer;               ///< Sky rendering (sun, moon, stars)
     std::unique_ptr<IRenderer> m_Renderer;   ///< Graphics renderer
+    PipelinedRenderer *m_Pipeline;           ///< m_Renderer while pipelined (F10), else nullptr
     RendererAPI m_RendererAPI;               ///< Active renderer type
+    IRenderer::PresentMode m_PresentMode{IRenderer::PresentMode::Mailbox};  ///< Applied before Init() (Ctrl+F6)
+    int m_FramesInFlight{2};                 ///< Applied before Init() (Ctrl+F10)
     /** @} */
 
     /**
@@ -395,11 +659,23 @@ private:
     float m_CameraTilt;              ///< Tilt angle for 3D effect (0.0 = flat, 1.0 = max tilt)
     bool m_Enable3DEffect;           ///< Whether 3D tilt effect is active
     float m_GlobeSphereRadius;       ///< Radius for globe + vanishing point projection (larger = subtler)
+    bool m_GpuProjection;            ///< Evaluate perspective in sprite.vert instead of on the CPU
+    bool m_GpuParticles;             ///< Simulate weather particles in a compute pass when supported (F8)
     bool m_FreeCameraMode;           ///< Free camera mode (Space toggle) - camera doesn't follow player
     /** @} */
 
     float m_LastFrameTime;  ///< Timestamp of last frame (for delta calculation)
 
+    /**
+     * @name Fixed Timestep
+     * @brief Simulation rate decoupled from the render rate.
+     * @{
+     */
+    FixedTimestep m_Timestep;            ///< Accumulator handing out simulation steps
+    bool m_FixedTimestep;                ///< Simulate in fixed steps (F9)
+    glm::vec2 m_PreviousCameraPosition;  ///< m_CameraPosition at the start of the last step
+    /** @} */
+
     /**
      * @name FPS Counter
      * @brief Frame rate measurement.
@@ -414,6 +690,63 @@ private:
     int m_CurrentDrawCalls;     ///< Average draw calls per frame for display
     /** @} */
 
+    /**
+     * @name Frame Pacing
+     * @brief Sleeps out the rest of each frame when m_TargetFps is set.
+     * @{
+     */
+    FramePacer m_FramePacer;  ///< Deadline sleeper, aligned to the display refresh on request (F6)
+    /** @} */
+
+    /**
+     * @name Profiling
+     * @brief Running Profiler capture, if any (F11 or --trace).
+     * @{
+     */
+    std::string m_TracePath;     ///< Where the running capture is written
+    int m_TraceFramesLeft = 0;   ///< Frames until the capture stops, 0 = no limit
+    /** @} */
+
+    /**
+     * @name Performance HUD
+     * @brief Frame graphs and render counters overlay (F12).
+     * @{
+     */
+    PerfHud m_PerfHud;
+    AllocationCounter::Totals m_LastAllocations;  ///< Totals at the previous RecordPerfHudFrame()
+    size_t m_VisibleNpcCount = 0;                 ///< NPCs added to the last render list
+    /** @} */
+
+    /**
+     * @name Texture Budget
+     * @brief GPU memory kept for textures before idle sprite sheets go (see SetTextureBudget()).
+     * @{
+     */
+    static constexpr size_t DEFAULT_TEXTURE_BUDGET = 256u * 1024u * 1024u;  ///< Bytes
+    size_t m_TextureBudget = DEFAULT_TEXTURE_BUDGET;
+    uint64_t m_TextureIdleFrames = SpriteSheetRegistry::DEFAULT_IDLE_FRAMES;
+    /** @} */
+
+    /**
+     * @name Benchmark
+     * @brief Scripted run set up by ConfigureBenchmark().
+     * @{
+     */
+    bool m_BenchmarkMode = false;
+    BenchmarkOptions m_BenchmarkOptions;
+    BenchmarkScript m_BenchmarkScript;
+    /** @} */
+
+    /**
+     * @name Input
+     * @brief Latched per-step input and the replay set up by ConfigureReplay().
+     * @{
+     */
+    InputState m_Input;
+    bool m_ReplayMode = false;
+    ReplayOptions m_ReplayOptions;
+    /** @} */
+
     /// @name Editor
     /// @{
     Editor m_Editor;  ///< Level editor (extracted from Game)
@@ -437,7 +770,10 @@ private:
     std::string m_DialogueText;            ///< Current dialogue text (simple dialogue)
     DialogueManager m_DialogueManager;     ///< Branching dialogue tree manager
     GameStateManager m_GameState;          ///< Game flags and state for consequences
+    std::vector<QuestHudLine> m_QuestHudLines;  ///< Cached by GetQuestHudLines()
+    std::uint64_t m_QuestHudVersion = UINT64_MAX; ///< m_GameState version m_QuestHudLines was built from
     int m_DialoguePage = 0;                ///< Current page of dialogue text (for pagination)
     mutable int m_DialogueTotalPages = 1;  ///< Total pages (cached during rendering)
+    TextLayoutCache m_TextLayouts;         ///< Wrapped dialogue lines, measured with m_Renderer
     /** @} */
 };
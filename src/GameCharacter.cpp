@@ -16,44 +16,74 @@ GameCharacter::GameCharacter()
 
 void GameCharacter::SetElevationOffset(float offset)
 {
-    if (offset != m_TargetElevation)
+    BeginElevationTransition(offset, m_ElevationOffset, m_TargetElevation, m_ElevationStart, m_ElevationProgress);
+}
+
+void GameCharacter::UpdateElevation(float deltaTime)
+{
+    StepElevation(deltaTime, m_ElevationOffset, m_TargetElevation, m_ElevationStart, m_ElevationProgress);
+}
+
+void GameCharacter::AdvanceWalkAnimation()
+{
+    m_CurrentFrame = StepWalkSequence(m_WalkSequenceIndex);
+}
+
+void GameCharacter::ResetAnimation()
+{
+    m_CurrentFrame = 0;
+    m_WalkSequenceIndex = 0;
+    m_AnimationTime = 0.0f;
+}
+
+glm::vec2 GameCharacter::GetInterpolatedPosition(float alpha) const
+{
+    return Interpolate(m_PreviousPosition, m_Position, alpha);
+}
+
+void GameCharacter::BeginElevationTransition(float offset, float current, float &target, float &start, float &progress)
+{
+    if (offset != target)
     {
-        m_ElevationStart = m_ElevationOffset;
-        m_TargetElevation = offset;
-        m_ElevationProgress = 0.0f;
+        start = current;
+        target = offset;
+        progress = 0.0f;
     }
 }
 
-void GameCharacter::UpdateElevation(float deltaTime)
+void GameCharacter::StepElevation(float deltaTime, float &current, float target, float start, float &progress)
 {
-    if (m_ElevationProgress < 1.0f)
+    if (progress < 1.0f)
     {
         constexpr float transitionDuration = 0.15f;
-        m_ElevationProgress += deltaTime / transitionDuration;
+        progress += deltaTime / transitionDuration;
 
-        if (m_ElevationProgress >= 1.0f)
+        if (progress >= 1.0f)
         {
-            m_ElevationProgress = 1.0f;
-            m_ElevationOffset = m_TargetElevation;
+            progress = 1.0f;
+            current = target;
         }
         else
         {
-            float t = m_ElevationProgress;
+            float t = progress;
             float smoothT = t * t * (3.0f - 2.0f * t);
-            m_ElevationOffset = m_ElevationStart + (m_TargetElevation - m_ElevationStart) * smoothT;
+            current = start + (target - start) * smoothT;
         }
     }
 }
 
-void GameCharacter::AdvanceWalkAnimation()
+int GameCharacter::StepWalkSequence(int &sequenceIndex)
 {
-    m_WalkSequenceIndex = (m_WalkSequenceIndex + 1) % WALK_SEQUENCE_LENGTH;
-    m_CurrentFrame = WALK_SEQUENCE[m_WalkSequenceIndex];
+    sequenceIndex = (sequenceIndex + 1) % WALK_SEQUENCE_LENGTH;
+    return WALK_SEQUENCE[sequenceIndex];
 }
 
-void GameCharacter::ResetAnimation()
+glm::vec2 GameCharacter::Interpolate(glm::vec2 previous, glm::vec2 current, float alpha)
 {
-    m_CurrentFrame = 0;
-    m_WalkSequenceIndex = 0;
-    m_AnimationTime = 0.0f;
+    const glm::vec2 delta = current - previous;
+    if (glm::dot(delta, delta) > INTERPOLATION_MAX_DISTANCE * INTERPOLATION_MAX_DISTANCE)
+    {
+        return current;
+    }
+    return previous + delta * alpha;
 }
@@ -10,19 +10,20 @@ class IRenderer;
  * @author Alex (https://github.com/lextpf)
  * @ingroup Entity
  *
- * GameCharacter implements IGameCharacter and factors out the fields and
- * methods common to PlayerCharacter and NonPlayerCharacter: world position,
+ * GameCharacter implements IGameCharacter on member fields: world position,
  * elevation offsets, cardinal direction, walk-cycle animation, and movement
- * speed.
+ * speed. PlayerCharacter derives from it. NonPlayerCharacter keeps the same
+ * state in a CharacterStore row instead and applies the same rules through
+ * the static Shared Steps.
  *
  * @par Design
- * Game stores `PlayerCharacter m_Player` and `vector<NonPlayerCharacter>`
- * by value, never through a GameCharacter pointer. The base class exists
- * purely for code sharing; no virtual dispatch is needed at runtime.
+ * Game stores `PlayerCharacter m_Player` by value, never through a
+ * GameCharacter pointer. The base class exists purely for code sharing; no
+ * virtual dispatch is needed at runtime.
  *
  * @par Position (Bottom-Center)
  * Position is the **bottom-center** of the sprite (where the feet touch
- * the ground). Both derived classes share this convention:
+ * the ground). NPC rows in CharacterStore share this convention:
  * @code
  *     +--------+
  *     |        |
@@ -76,6 +77,42 @@ public:
     void SetDirection(CharacterDirection dir) override { m_Direction = dir; }
     /// @}
 
+    /// @name Render Interpolation
+    /// @brief Drawing between two fixed simulation steps (see FixedTimestep).
+    /// @{
+
+    /// @brief Remember the current position as the start of the next simulation step.
+    void StorePreviousPosition() { m_PreviousPosition = m_Position; }
+
+    /**
+     * @brief Position blended between the previous and the current step.
+     *
+     * Moves longer than INTERPOLATION_MAX_DISTANCE (teleports, spawns,
+     * dormant catch-up) are not blended; the current position is returned.
+     *
+     * @param alpha 0 = previous step, 1 = current step.
+     */
+    glm::vec2 GetInterpolatedPosition(float alpha) const;
+
+    /**
+     * @brief Swap the interpolated position in for drawing.
+     *
+     * Must be paired with EndInterpolatedRender(), which restores the
+     * simulated position. Calls do not nest.
+     */
+    void BeginInterpolatedRender(float alpha)
+    {
+        m_SimulatedPosition = m_Position;
+        m_Position = GetInterpolatedPosition(alpha);
+    }
+
+    /// @brief Restore the position saved by BeginInterpolatedRender().
+    void EndInterpolatedRender() { m_Position = m_SimulatedPosition; }
+
+    /// @brief Longest move between two steps that is still blended (px).
+    static constexpr float INTERPOLATION_MAX_DISTANCE = 48.0f;
+    /// @}
+
     /// @name Elevation
     /// @{
     float GetElevationOffset() const override { return m_ElevationOffset; }
@@ -141,10 +178,30 @@ public:
     static constexpr int WALK_SEQUENCE_LENGTH = 4;    ///< Length of WALK_SEQUENCE
     /// @}
 
+    /// @name Shared Steps
+    /// The rules behind the members above, on plain values, so NPC rows in
+    /// CharacterStore follow them too.
+    /// @{
+
+    /// @brief Start a transition from @p current toward @p offset unless @p offset is already the target.
+    static void BeginElevationTransition(float offset, float current, float &target, float &start, float &progress);
+
+    /// @brief Advance a transition started by BeginElevationTransition() by @p deltaTime seconds.
+    static void StepElevation(float deltaTime, float &current, float target, float start, float &progress);
+
+    /// @brief Move @p sequenceIndex one step along WALK_SEQUENCE; returns the new frame.
+    static int StepWalkSequence(int &sequenceIndex);
+
+    /// @brief Blend @p previous toward @p current; moves past INTERPOLATION_MAX_DISTANCE are not blended.
+    static glm::vec2 Interpolate(glm::vec2 previous, glm::vec2 current, float alpha);
+    /// @}
+
 protected:
     /// @name Position State
     /// @{
     glm::vec2 m_Position{0.0f, 0.0f};       ///< World position (bottom-center of sprite)
+    glm::vec2 m_PreviousPosition{0.0f, 0.0f};   ///< m_Position at the start of the last fixed step
+    glm::vec2 m_SimulatedPosition{0.0f, 0.0f};  ///< m_Position saved during interpolated drawing
     /// @}
 
     /// @name Elevation State
@@ -1,83 +1,15 @@
 #include "Game.h"
 #include "DialogueManager.h"
 #include "DialogueSystem.h"
+#include "FrameArena.h"
 
-#include <functional>
 #include <iostream>
+#include <string_view>
 #include <vector>
 
-namespace
-{
-    /**
-     * Word-wrap text to fit within a maximum width.
-     *
-     * NOTE: This is ASCII/space-delimited only; UTF-8 glyphs and very long
-     * tokens are not split. The renderer must be able to measure each whole
-     * line via measureWidth().
-     *
-     * @param text         The text to wrap.
-     * @param maxWidth     Maximum line width in pixels.
-     * @param measureWidth Function to measure the pixel width of a string.
-     * @return Vector of wrapped lines.
-     */
-    std::vector<std::string> WrapText(
-        const std::string &text,
-        float maxWidth,
-        const std::function<float(const std::string &)> &measureWidth)
-    {
-        std::vector<std::string> lines;
-        std::string currentLine;
-        std::string word;
-
-        // Add current word to line, wrapping if it exceeds max width
-        auto commitWord = [&]()
-        {
-            if (word.empty())
-                return;
-            const std::string testLine = currentLine.empty() ? word : (currentLine + " " + word);
-            if (measureWidth(testLine) > maxWidth && !currentLine.empty())
-            {
-                lines.push_back(currentLine);
-                currentLine = word;
-            }
-            else
-            {
-                currentLine = testLine;
-            }
-            word.clear();
-        };
-
-        // Finish current line and start a new one
-        auto commitLine = [&]()
-        {
-            if (!currentLine.empty())
-            {
-                lines.push_back(currentLine);
-                currentLine.clear();
-            }
-        };
-
-        for (char c : text)
-        {
-            if (c == ' ')
-                commitWord();
-            else if (c == '\n')
-            {
-                commitWord();
-                commitLine();
-            }
-            else
-                word += c;
-        }
-        commitWord();
-        commitLine();
-
-        return lines;
-    }
-}
-
 void Game::RenderNPCHeadText()
 {
+    WILD_PROFILE_ZONE("Dialogue Head Text");
     if (!m_InDialogue || m_DialogueText.empty() || !m_DialogueNPC)
     {
         return;
@@ -114,19 +46,19 @@ void Game::RenderDialogueText(glm::vec2 boxPos, glm::vec2 boxSize)
     float lineHeight = 6.0f;
     float maxWidth = boxSize.x - 20.0f;
 
-    auto lines = WrapText(m_DialogueText, maxWidth, [&](const std::string &s)
-                          { return m_Renderer->GetTextWidth(s, scale); });
+    const TextLayoutCache::TextLayout &layout = m_TextLayouts.Wrap(
+        m_DialogueText, scale, maxWidth, [&](std::string_view s) { return m_Renderer->GetTextWidth(s, scale); });
 
     // Render each line, centered horizontally
     float currentY = boxPos.y;
     glm::vec3 textColor(1.0f, 1.0f, 1.0f);
 
-    for (const std::string &line : lines)
+    for (size_t i = 0; i < layout.lines.size(); ++i)
     {
+        const std::string &line = layout.lines[i];
         if (!line.empty())
         {
-            float lineWidth = m_Renderer->GetTextWidth(line, scale);
-            float lineStartX = boxPos.x + (boxSize.x - lineWidth) * 0.5f;
+            float lineStartX = boxPos.x + (boxSize.x - layout.lineWidths[i]) * 0.5f;
             m_Renderer->DrawText(line, glm::vec2(lineStartX, currentY), scale, textColor);
         }
         currentY += lineHeight;
@@ -136,12 +68,13 @@ void Game::RenderDialogueText(glm::vec2 boxPos, glm::vec2 boxSize)
 
 void Game::RenderDialogueTreeBox()
 {
+    WILD_PROFILE_ZONE("Dialogue Box");
     if (!m_DialogueManager.IsActive())
     {
         return;
     }
 
-    const DialogueNode *node = m_DialogueManager.GetCurrentNode();
+    const CompiledDialogue::Node *node = m_DialogueManager.GetCurrentNode();
     if (!node)
     {
         return;
@@ -280,8 +213,9 @@ void Game::RenderDialogueTreeBox()
     }
 
     const float maxTextWidth = boxWidth - padding * 2;
-    auto allLines = WrapText(node->text, maxTextWidth, [&](const std::string &s)
-                             { return m_Renderer->GetTextWidth(s, textScale); });
+    const TextLayoutCache::TextLayout &textLayout = m_TextLayouts.Wrap(
+        node->text, textScale, maxTextWidth, [&](std::string_view s) { return m_Renderer->GetTextWidth(s, textScale); });
+    const std::vector<std::string> &allLines = textLayout.lines;
 
     const auto &visibleOptions = m_DialogueManager.GetVisibleOptions();
     int numOptions = static_cast<int>(visibleOptions.size());
@@ -395,7 +329,7 @@ void Game::RenderDialogueTreeBox()
 
         for (size_t i = 0; i < visibleOptions.size(); ++i)
         {
-            const DialogueOption *opt = visibleOptions[i];
+            const CompiledDialogue::Option *opt = visibleOptions[i];
             bool isSelected = (static_cast<int>(i) == selectedIndex);
 
             if (isSelected)
@@ -411,24 +345,14 @@ void Game::RenderDialogueTreeBox()
                 m_Renderer->DrawColoredRect(glm::vec2(arrowX, arrowCenterY + 2.0f * z), glm::vec2(1.0f * z, 1.0f * z), arrowGold);
             }
 
-            std::string prefix = "   ";
+            constexpr std::string_view prefix = "   ";
             glm::vec3 optionColor = isSelected ? glm::vec3(0.85f, 0.75f, 0.40f) : glm::vec3(0.58f, 0.55f, 0.50f);
 
-            // Check if this option gives a quest
-            bool givesQuest = false;
-            for (const auto &cons : opt->consequences)
-            {
-                if ((cons.type == DialogueConsequence::Type::SET_FLAG ||
-                     cons.type == DialogueConsequence::Type::SET_FLAG_VALUE) &&
-                    cons.key.find("accepted_") == 0 &&
-                    cons.key.find("_quest") != std::string::npos)
-                {
-                    givesQuest = true;
-                    break;
-                }
-            }
+            // Whether this option gives a quest is worked out when the tree is compiled
+            const bool givesQuest = opt->givesQuest;
 
-            std::string displayText = prefix + opt->text;
+            FrameString displayText(prefix, &FrameArena::ThisThread());
+            displayText += opt->text;
             // TODO: Wrap long option text to maxTextWidth; current rendering can overflow the box.
             m_Renderer->DrawText(displayText, glm::vec2(boxX + padding, currentY), textScale, optionColor, outlineSize, textAlpha);
 
@@ -436,7 +360,8 @@ void Game::RenderDialogueTreeBox()
             if (givesQuest)
             {
                 glm::vec3 questYellow(1.0f, 0.88f, 0.4f);
-                float textWidth = m_Renderer->GetTextWidth(prefix + opt->text + " ", textScale);
+                displayText += ' ';
+                float textWidth = m_Renderer->GetTextWidth(displayText, textScale);
                 float exclamationX = boxX + padding + textWidth;
                 m_Renderer->DrawText(">!<", glm::vec2(exclamationX, currentY), textScale, questYellow, outlineSize, 1.0f);
             }
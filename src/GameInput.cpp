@@ -7,13 +7,23 @@
 
 #include <glad/glad.h>
 
+static_assert(InputState::KEY_COUNT == GLFW_KEY_LAST + 1, "InputState must cover every GLFW key");
+static_assert(InputState::MOUSE_BUTTON_COUNT == GLFW_MOUSE_BUTTON_LAST + 1, "InputState must cover every mouse button");
+
 void Game::ProcessInput(float deltaTime)
 {
+    WILD_PROFILE_ZONE("Input");
     glm::vec2 moveDirection(0.0f);
 
+    // Wheel events queued by ScrollCallback() since the last step
+    for (float yoffset : m_Input.GetScrollEvents())
+    {
+        HandleScroll(yoffset);
+    }
+
     // Check if shift is pressed for running (1.5x movement speed)
-    bool isRunning = (glfwGetKey(m_Window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-                      glfwGetKey(m_Window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS);
+    bool isRunning = (m_Input.IsKeyDown(GLFW_KEY_LEFT_SHIFT) ||
+                      m_Input.IsKeyDown(GLFW_KEY_RIGHT_SHIFT));
 
     // Reset copied NPC appearance when starting to run
     if (isRunning && m_Player.IsUsingCopiedAppearance())
@@ -26,26 +36,26 @@ void Game::ProcessInput(float deltaTime)
 
     // Standard WASD layout for 8-directional movement
     // Y increases downward in screen space (top-left origin), so W = -Y, S = +Y
-    if (glfwGetKey(m_Window, GLFW_KEY_W) == GLFW_PRESS)
+    if (m_Input.IsKeyDown(GLFW_KEY_W))
     {
         moveDirection.y -= 1.0f; // Up
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_A) == GLFW_PRESS)
+    if (m_Input.IsKeyDown(GLFW_KEY_A))
     {
         moveDirection.x -= 1.0f; // Left
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_S) == GLFW_PRESS)
+    if (m_Input.IsKeyDown(GLFW_KEY_S))
     {
         moveDirection.y += 1.0f; // Down
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_D) == GLFW_PRESS)
+    if (m_Input.IsKeyDown(GLFW_KEY_D))
     {
         moveDirection.x += 1.0f; // Right
     }
 
     // Toggles between gameplay and editor mode.
     static bool eKeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_E) == GLFW_PRESS && !eKeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_E) && !eKeyPressed)
     {
         m_Editor.SetActive(!m_Editor.IsActive());
         eKeyPressed = true;
@@ -55,7 +65,7 @@ void Game::ProcessInput(float deltaTime)
             std::cout << "Press T to toggle tile picker visibility" << std::endl;
         }
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_E) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_E))
     {
         eKeyPressed = false;
     }
@@ -73,8 +83,15 @@ void Game::ProcessInput(float deltaTime)
 
     // Resets camera zoom to 1.0x and recenters on player.
     // In editor mode, also resets tile picker zoom and pan.
+    // Ctrl+Z is undo while editing
     static bool zKeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_Z) == GLFW_PRESS && !zKeyPressed)
+    bool undoChord = m_Editor.IsActive() &&
+                     (m_Input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || m_Input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL));
+    if (undoChord && m_Input.IsKeyDown(GLFW_KEY_Z))
+    {
+        zKeyPressed = true;  // Releasing Ctrl first must not reset the camera
+    }
+    if (m_Input.IsKeyDown(GLFW_KEY_Z) && !zKeyPressed)
     {
         m_CameraZoom = 1.0f;
         std::cout << "Camera zoom reset to 1.0x" << std::endl;
@@ -113,14 +130,14 @@ void Game::ProcessInput(float deltaTime)
         }
         zKeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_Z) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_Z))
     {
         zKeyPressed = false;
     }
 
     // Toggle between OpenGL and Vulkan renderers at runtime
     static bool f1KeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_F1) == GLFW_PRESS && !f1KeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_F1) && !f1KeyPressed)
     {
         // Toggle between OpenGL and Vulkan
         RendererAPI newApi = (m_RendererAPI == RendererAPI::OpenGL)
@@ -129,19 +146,19 @@ void Game::ProcessInput(float deltaTime)
         SwitchRenderer(newApi);
         f1KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F1) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F1))
     {
         f1KeyPressed = false;
     }
 
     // Toggles FPS and position information display
     static bool f2KeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_F2) == GLFW_PRESS && !f2KeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_F2) && !f2KeyPressed)
     {
         m_Editor.ToggleShowDebugInfo();
         f2KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F2) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F2))
     {
         f2KeyPressed = false;
     }
@@ -153,12 +170,12 @@ void Game::ProcessInput(float deltaTime)
     //   - NPC information
     //   - All tile layers visible
     static bool f3KeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_F3) == GLFW_PRESS && !f3KeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_F3) && !f3KeyPressed)
     {
         m_Editor.ToggleDebugMode();
         f3KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F3) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F3))
     {
         f3KeyPressed = false;
     }
@@ -166,7 +183,7 @@ void Game::ProcessInput(float deltaTime)
     // Cycle through all 8 time periods
     static bool f4KeyPressed = false;
     static int timeOfDayCycle = 0;
-    if (glfwGetKey(m_Window, GLFW_KEY_F4) == GLFW_PRESS && !f4KeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_F4) && !f4KeyPressed)
     {
         timeOfDayCycle = (timeOfDayCycle + 1) % 8;
         const char *periodName = "";
@@ -208,56 +225,207 @@ void Game::ProcessInput(float deltaTime)
         std::cout << "Time of day: " << periodName << std::endl;
         f4KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F4) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F4))
     {
         f4KeyPressed = false;
     }
 
     // Toggles the 3D globe effect for an isometric-like view
     static bool f5KeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_F5) == GLFW_PRESS && !f5KeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_F5) && !f5KeyPressed)
     {
         Toggle3DEffect();
         f5KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F5) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F5))
     {
         f5KeyPressed = false;
     }
 
-    // Toggle FPS cap (0 = uncapped, 60 = capped)
+    // Ctrl turns F6 and F10 into the renderer's presentation settings
+    const bool presentChord = m_Input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || m_Input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL);
+
+    // Cycle FPS cap: uncapped -> 500 -> display refresh -> uncapped
+    // Ctrl+F6 cycles the present mode: mailbox -> immediate -> FIFO -> mailbox
     static bool f6KeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_F6) == GLFW_PRESS && !f6KeyPressed)
+    if (presentChord && m_Input.IsKeyDown(GLFW_KEY_F6) && !f6KeyPressed)
+    {
+        using PresentMode = IRenderer::PresentMode;
+        const char *name = "FIFO";
+        if (m_PresentMode == PresentMode::Mailbox)
+        {
+            m_PresentMode = PresentMode::Immediate;
+            name = "immediate";
+        }
+        else if (m_PresentMode == PresentMode::Immediate)
+        {
+            m_PresentMode = PresentMode::Fifo;
+        }
+        else
+        {
+            m_PresentMode = PresentMode::Mailbox;
+            name = "mailbox";
+        }
+        if (m_Renderer->SetPresentMode(m_PresentMode))
+            std::cout << "Present mode: " << name << std::endl;
+        else
+            std::cout << "Present mode: not supported by this renderer" << std::endl;
+        f6KeyPressed = true;
+    }
+    if (m_Input.IsKeyDown(GLFW_KEY_F6) && !f6KeyPressed)
     {
+        // Jitter of the mode being left
+        ReportFramePacing();
         if (m_TargetFps <= 0.0f)
         {
             m_TargetFps = 500.0f;
+            m_FramePacer.SetAlignToRefresh(false);
             std::cout << "FPS capped at 500" << std::endl;
         }
+        else if (!m_FramePacer.IsAlignedToRefresh())
+        {
+            // A cap above the refresh rate rounds to one frame per refresh
+            m_FramePacer.SetAlignToRefresh(true);
+            m_FramePacer.SetTargetFps(m_TargetFps);
+            std::cout << "FPS capped at display refresh (" << 1.0 / m_FramePacer.GetInterval() << " Hz)"
+                      << std::endl;
+        }
         else
         {
             m_TargetFps = 0.0f;
+            m_FramePacer.SetAlignToRefresh(false);
             std::cout << "FPS uncapped" << std::endl;
         }
         f6KeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F6) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F6))
     {
         f6KeyPressed = false;
     }
 
+    // Toggle native-resolution world rendering (integer upscale vs. full resolution)
+    static bool f7KeyPressed = false;
+    if (m_Input.IsKeyDown(GLFW_KEY_F7) && !f7KeyPressed)
+    {
+        m_LowResRendering = !m_LowResRendering;
+        std::cout << "Low-res world rendering: " << (m_LowResRendering ? "ON" : "OFF") << std::endl;
+        f7KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F7))
+    {
+        f7KeyPressed = false;
+    }
+
+    // Toggle GPU weather particles (compute-capable renderers only)
+    static bool f8KeyPressed = false;
+    if (m_Input.IsKeyDown(GLFW_KEY_F8) && !f8KeyPressed)
+    {
+        m_GpuParticles = !m_GpuParticles;
+        const bool supported = m_Renderer->SupportsGpuParticles();
+        m_Particles.SetGpuSimulation(m_GpuParticles && supported);
+        std::cout << "GPU particles: " << (m_GpuParticles ? "ON" : "OFF")
+                  << (m_GpuParticles && !supported ? " (not supported by this renderer, using CPU)" : "")
+                  << std::endl;
+        f8KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F8))
+    {
+        f8KeyPressed = false;
+    }
+
+    // Toggle fixed-timestep simulation (variable timestep when off)
+    static bool f9KeyPressed = false;
+    if (m_Input.IsKeyDown(GLFW_KEY_F9) && !f9KeyPressed && (m_Input.IsRecording() || m_Input.IsReplaying()))
+    {
+        // A log only replays when every step has the recorded length
+        std::cout << "Fixed timestep is locked while recording or replaying input" << std::endl;
+        f9KeyPressed = true;
+    }
+    if (m_Input.IsKeyDown(GLFW_KEY_F9) && !f9KeyPressed)
+    {
+        SetFixedTimestep(!m_FixedTimestep, 1.0f / m_Timestep.GetStep());
+        std::cout << "Fixed timestep: ";
+        if (m_FixedTimestep)
+            std::cout << "ON (" << std::round(1.0f / m_Timestep.GetStep()) << " Hz)" << std::endl;
+        else
+            std::cout << "OFF" << std::endl;
+        f9KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F9))
+    {
+        f9KeyPressed = false;
+    }
+
+    // Toggle pipelined rendering (frames drawn on a render thread)
+    // Ctrl+F10 cycles the frames the GPU may lag behind: 1 -> 2 -> 3 -> 1
+    static bool f10KeyPressed = false;
+    if (presentChord && m_Input.IsKeyDown(GLFW_KEY_F10) && !f10KeyPressed)
+    {
+        const int framesInFlight = m_FramesInFlight % 3 + 1;
+        if (m_Renderer->SetFramesInFlight(framesInFlight))
+        {
+            m_FramesInFlight = framesInFlight;
+            std::cout << "Frames in flight: " << m_FramesInFlight << std::endl;
+        }
+        else
+        {
+            std::cout << "Frames in flight: not supported by this renderer" << std::endl;
+        }
+        f10KeyPressed = true;
+    }
+    if (m_Input.IsKeyDown(GLFW_KEY_F10) && !f10KeyPressed)
+    {
+        if (SetPipelinedRendering(m_Pipeline == nullptr))
+        {
+            std::cout << "Pipelined rendering: " << (m_Pipeline ? "ON" : "OFF") << std::endl;
+        }
+        f10KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F10))
+    {
+        f10KeyPressed = false;
+    }
+
+    // Start/stop a profiler capture (written as a Chrome trace when stopped)
+    static bool f11KeyPressed = false;
+    if (m_Input.IsKeyDown(GLFW_KEY_F11) && !f11KeyPressed)
+    {
+        if (Profiler::IsCapturing())
+            StopProfilerCapture();
+        else
+            StartProfilerCapture("wild_trace.json");
+        f11KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F11))
+    {
+        f11KeyPressed = false;
+    }
+
+    // Toggle the performance HUD (frame graphs, draw and flush counters)
+    static bool f12KeyPressed = false;
+    if (m_Input.IsKeyDown(GLFW_KEY_F12) && !f12KeyPressed)
+    {
+        m_PerfHud.Toggle();
+        std::cout << "Performance HUD: " << (m_PerfHud.IsVisible() ? "ON" : "OFF") << std::endl;
+        f12KeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_F12))
+    {
+        f12KeyPressed = false;
+    }
+
     // Toggle free camera mode (Space) - camera stops following player
     // WASD/Arrows can then pan camera while player still moves with WASD
     static bool spaceKeyFreeCamera = false;
     if (!m_InDialogue && !m_DialogueManager.IsActive() && !m_Editor.IsActive())
     {
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_PRESS && !spaceKeyFreeCamera)
+        if (m_Input.IsKeyDown(GLFW_KEY_SPACE) && !spaceKeyFreeCamera)
         {
             m_FreeCameraMode = !m_FreeCameraMode;
             std::cout << "Free Camera Mode: " << (m_FreeCameraMode ? "ON" : "OFF") << std::endl;
             spaceKeyFreeCamera = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_SPACE))
         {
             spaceKeyFreeCamera = false;
         }
@@ -270,26 +438,26 @@ void Game::ProcessInput(float deltaTime)
     if (m_Enable3DEffect)
     {
         // Globe effect parameter adjustment
-        if (glfwGetKey(m_Window, GLFW_KEY_PAGE_UP) == GLFW_PRESS && !pageUpPressed)
+        if (m_Input.IsKeyDown(GLFW_KEY_PAGE_UP) && !pageUpPressed)
         {
             m_GlobeSphereRadius = std::min(500.0f, m_GlobeSphereRadius + 10.0f);
             m_CameraTilt = std::max(0.0f, m_CameraTilt - 0.05f);
             std::cout << "3D Effect - Radius: " << m_GlobeSphereRadius << ", Tilt: " << m_CameraTilt << std::endl;
             pageUpPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_PAGE_UP) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_PAGE_UP))
         {
             pageUpPressed = false;
         }
 
-        if (glfwGetKey(m_Window, GLFW_KEY_PAGE_DOWN) == GLFW_PRESS && !pageDownPressed)
+        if (m_Input.IsKeyDown(GLFW_KEY_PAGE_DOWN) && !pageDownPressed)
         {
             m_GlobeSphereRadius = std::max(50.0f, m_GlobeSphereRadius - 10.0f);
             m_CameraTilt = std::min(1.0f, m_CameraTilt + 0.05f);
             std::cout << "3D Effect - Radius: " << m_GlobeSphereRadius << ", Tilt: " << m_CameraTilt << std::endl;
             pageDownPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_PAGE_DOWN) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_PAGE_DOWN))
         {
             pageDownPressed = false;
         }
@@ -297,7 +465,7 @@ void Game::ProcessInput(float deltaTime)
     // Cycles through available player character sprites.
     // Each character type has its own sprite sheet loaded from assets.
     static bool cKeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_C) == GLFW_PRESS && !cKeyPressed)
+    if (m_Input.IsKeyDown(GLFW_KEY_C) && !cKeyPressed)
     {
         CharacterType currentType = m_Player.GetCharacterType();
         CharacterType newType;
@@ -352,7 +520,7 @@ void Game::ProcessInput(float deltaTime)
 
         cKeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_C) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_C))
     {
         cKeyPressed = false;
     }
@@ -362,7 +530,7 @@ void Game::ProcessInput(float deltaTime)
     //   - Uses center-only collision detection
     //   - Different sprite sheet may be used
     static bool bKeyPressed = false;
-    if (glfwGetKey(m_Window, GLFW_KEY_B) == GLFW_PRESS && !bKeyPressed && !m_Editor.IsActive())
+    if (m_Input.IsKeyDown(GLFW_KEY_B) && !bKeyPressed && !m_Editor.IsActive())
     {
         bool currentBicycling = m_Player.IsBicycling();
         bool newBicycling = !currentBicycling;
@@ -378,7 +546,7 @@ void Game::ProcessInput(float deltaTime)
         std::cout << "Bicycle: " << (newBicycling ? "ON" : "OFF") << std::endl;
         bKeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_B) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_B))
     {
         bKeyPressed = false;
     }
@@ -388,7 +556,7 @@ void Game::ProcessInput(float deltaTime)
     // Note: Running or bicycling will automatically restore original appearance
     //       since NPCs don't have running/bicycle sprites.
     static bool xKeyPressed = false;
-    if (!m_Editor.IsActive() && !m_InDialogue && glfwGetKey(m_Window, GLFW_KEY_X) == GLFW_PRESS && !xKeyPressed)
+    if (!m_Editor.IsActive() && !m_InDialogue && m_Input.IsKeyDown(GLFW_KEY_X) && !xKeyPressed)
     {
         if (m_Player.IsUsingCopiedAppearance())
         {
@@ -406,16 +574,18 @@ void Game::ProcessInput(float deltaTime)
             NonPlayerCharacter *nearestNPC = nullptr;
             float nearestDist = COPY_RANGE + 1.0f;
 
-            for (auto &npc : m_NPCs)
+            m_NPCGrid.ForEachInRadius(playerPos, COPY_RANGE, [&](SpatialHash::Id id, glm::vec2)
             {
-                glm::vec2 npcPos = npc.GetPosition();
+                if (id >= m_NPCs.size())
+                    return;
+                glm::vec2 npcPos = m_NPCs[id].GetPosition();
                 float dist = glm::length(npcPos - playerPos);
                 if (dist < nearestDist && dist <= COPY_RANGE)
                 {
                     nearestDist = dist;
-                    nearestNPC = &npc;
+                    nearestNPC = &m_NPCs[id];
                 }
-            }
+            });
 
             if (nearestNPC != nullptr)
             {
@@ -435,10 +605,10 @@ void Game::ProcessInput(float deltaTime)
     }
     // In debug mode, X key toggles corner cutting on the collision tile under cursor
     // The corner nearest to the mouse cursor within the tile is toggled
-    if (m_Editor.IsDebugMode() && glfwGetKey(m_Window, GLFW_KEY_X) == GLFW_PRESS && !xKeyPressed)
+    if (m_Editor.IsDebugMode() && m_Input.IsKeyDown(GLFW_KEY_X) && !xKeyPressed)
     {
         double mouseX, mouseY;
-        glfwGetCursorPos(m_Window, &mouseX, &mouseY);
+        m_Input.GetCursorPos(mouseX, mouseY);
 
         // Calculate world coordinates from mouse position
         float baseWorldWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth());
@@ -498,17 +668,40 @@ void Game::ProcessInput(float deltaTime)
         }
         xKeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_X) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_X))
     {
         xKeyPressed = false;
     }
 
+    // In debug mode, P sends every NPC to the player's tile through the
+    // pathfinder. Requests are searched over the next frames within budget.
+    static bool pKeyPressed = false;
+    if (m_Editor.IsDebugMode() && m_Input.IsKeyDown(GLFW_KEY_P) && !pKeyPressed)
+    {
+        const float EPS = 0.1f;
+        glm::vec2 playerPos = m_Player.GetPosition();
+        glm::ivec2 playerTile(static_cast<int>(std::floor(playerPos.x / m_Tilemap.GetTileWidth())),
+                              static_cast<int>(std::floor((playerPos.y - EPS) / m_Tilemap.GetTileHeight())));
+        for (auto &npc : m_NPCs)
+        {
+            m_Pathfinder.Cancel(npc.GetPathRequest());
+            npc.SetPathRequest(m_Pathfinder.RequestPath(npc.GetTargetTile(), playerTile));
+        }
+        std::cout << "Requested paths for " << m_NPCs.size() << " NPCs to (" << playerTile.x << ", "
+                  << playerTile.y << ") (P)" << std::endl;
+        pKeyPressed = true;
+    }
+    if (!m_Input.IsKeyDown(GLFW_KEY_P))
+    {
+        pKeyPressed = false;
+    }
+
     // Initiates dialogue with an NPC when
     //   1. Player is within INTERACTION_RANGE and
     //   2. NPC is in front of player or
     //   3. NPC hitbox is overlapping player hitbox
     static bool fKeyPressed = false;
-    if (!m_Editor.IsActive() && !m_InDialogue && glfwGetKey(m_Window, GLFW_KEY_F) == GLFW_PRESS && !fKeyPressed)
+    if (!m_Editor.IsActive() && !m_InDialogue && m_Input.IsKeyDown(GLFW_KEY_F) && !fKeyPressed)
     {
         glm::vec2 playerPos = m_Player.GetPosition();
         Direction playerDir = m_Player.GetDirection();
@@ -549,8 +742,18 @@ void Game::ProcessInput(float deltaTime)
         const float NPC_BOX_H = 16.0f;
         const float COLLISION_EPS = 0.05f; // Small margin for floating-point
 
-        for (auto &npc : m_NPCs)
+        // Candidates from the NPC grid, in m_NPCs order so the first match wins as before
+        std::vector<SpatialHash::Id> nearbyNPCs;
+        m_NPCGrid.ForEachInRadius(playerPos, INTERACTION_RANGE, [&](SpatialHash::Id id, glm::vec2)
         {
+            if (id < m_NPCs.size())
+                nearbyNPCs.push_back(id);
+        });
+        std::sort(nearbyNPCs.begin(), nearbyNPCs.end());
+
+        for (SpatialHash::Id id : nearbyNPCs)
+        {
+            NonPlayerCharacter &npc = m_NPCs[id];
             glm::vec2 npcPos = npc.GetPosition();
             float distance = glm::length(npcPos - playerPos);
 
@@ -885,7 +1088,7 @@ void Game::ProcessInput(float deltaTime)
         }
         fKeyPressed = true;
     }
-    if (glfwGetKey(m_Window, GLFW_KEY_F) == GLFW_RELEASE)
+    if (!m_Input.IsKeyDown(GLFW_KEY_F))
     {
         fKeyPressed = false;
     }
@@ -900,28 +1103,28 @@ void Game::ProcessInput(float deltaTime)
         static bool escapeKeyTree = false;
 
         // Navigate options with Up/Down or W/S
-        if ((glfwGetKey(m_Window, GLFW_KEY_UP) == GLFW_PRESS || glfwGetKey(m_Window, GLFW_KEY_W) == GLFW_PRESS) && !upKeyPressed)
+        if ((m_Input.IsKeyDown(GLFW_KEY_UP) || m_Input.IsKeyDown(GLFW_KEY_W)) && !upKeyPressed)
         {
             m_DialogueManager.SelectPrevious();
             upKeyPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_UP) == GLFW_RELEASE && glfwGetKey(m_Window, GLFW_KEY_W) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_UP) && !m_Input.IsKeyDown(GLFW_KEY_W))
         {
             upKeyPressed = false;
         }
 
-        if ((glfwGetKey(m_Window, GLFW_KEY_DOWN) == GLFW_PRESS || glfwGetKey(m_Window, GLFW_KEY_S) == GLFW_PRESS) && !downKeyPressed)
+        if ((m_Input.IsKeyDown(GLFW_KEY_DOWN) || m_Input.IsKeyDown(GLFW_KEY_S)) && !downKeyPressed)
         {
             m_DialogueManager.SelectNext();
             downKeyPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_DOWN) == GLFW_RELEASE && glfwGetKey(m_Window, GLFW_KEY_S) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_DOWN) && !m_Input.IsKeyDown(GLFW_KEY_S))
         {
             downKeyPressed = false;
         }
 
         // Confirm selection with Enter or Space
-        if (glfwGetKey(m_Window, GLFW_KEY_ENTER) == GLFW_PRESS && !enterKeyTree)
+        if (m_Input.IsKeyDown(GLFW_KEY_ENTER) && !enterKeyTree)
         {
             // Check if we need to advance pages first
             if (!IsDialogueOnLastPage())
@@ -941,12 +1144,12 @@ void Game::ProcessInput(float deltaTime)
             }
             enterKeyTree = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_ENTER) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_ENTER))
         {
             enterKeyTree = false;
         }
 
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_PRESS && !spaceKeyTree)
+        if (m_Input.IsKeyDown(GLFW_KEY_SPACE) && !spaceKeyTree)
         {
             // Check if we need to advance pages first
             if (!IsDialogueOnLastPage())
@@ -965,13 +1168,13 @@ void Game::ProcessInput(float deltaTime)
             }
             spaceKeyTree = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_SPACE))
         {
             spaceKeyTree = false;
         }
 
         // Escape to force-close dialogue
-        if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !escapeKeyTree)
+        if (m_Input.IsKeyDown(GLFW_KEY_ESCAPE) && !escapeKeyTree)
         {
             m_DialogueManager.EndDialogue();
             m_DialoguePage = 0; // Reset pagination
@@ -982,7 +1185,7 @@ void Game::ProcessInput(float deltaTime)
             }
             escapeKeyTree = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_ESCAPE))
         {
             escapeKeyTree = false;
         }
@@ -995,7 +1198,7 @@ void Game::ProcessInput(float deltaTime)
         static bool spaceKeyPressed = false;
         static bool escapeKeyPressed = false;
 
-        if (glfwGetKey(m_Window, GLFW_KEY_ENTER) == GLFW_PRESS && !enterKeyPressed)
+        if (m_Input.IsKeyDown(GLFW_KEY_ENTER) && !enterKeyPressed)
         {
             m_InDialogue = false;
             if (m_DialogueNPC)
@@ -1006,12 +1209,12 @@ void Game::ProcessInput(float deltaTime)
             m_DialogueText = "";
             enterKeyPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_ENTER) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_ENTER))
         {
             enterKeyPressed = false;
         }
 
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_PRESS && !spaceKeyPressed)
+        if (m_Input.IsKeyDown(GLFW_KEY_SPACE) && !spaceKeyPressed)
         {
             m_InDialogue = false;
             if (m_DialogueNPC)
@@ -1022,12 +1225,12 @@ void Game::ProcessInput(float deltaTime)
             m_DialogueText = "";
             spaceKeyPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_SPACE) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_SPACE))
         {
             spaceKeyPressed = false;
         }
 
-        if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS && !escapeKeyPressed)
+        if (m_Input.IsKeyDown(GLFW_KEY_ESCAPE) && !escapeKeyPressed)
         {
             m_InDialogue = false;
             if (m_DialogueNPC)
@@ -1038,7 +1241,7 @@ void Game::ProcessInput(float deltaTime)
             m_DialogueText = "";
             escapeKeyPressed = true;
         }
-        if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_RELEASE)
+        if (!m_Input.IsKeyDown(GLFW_KEY_ESCAPE))
         {
             escapeKeyPressed = false;
         }
@@ -1050,14 +1253,8 @@ void Game::ProcessInput(float deltaTime)
         // Remember previous position for resolving collisions with NPCs
         m_PlayerPreviousPosition = m_Player.GetPosition();
 
-        // Collect NPC positions for collision checking
-        std::vector<glm::vec2> npcPositions;
-        for (const auto &npc : m_NPCs)
-        {
-            npcPositions.push_back(npc.GetPosition());
-        }
-
-        m_Player.Move(moveDirection, deltaTime, &m_Tilemap, &npcPositions);
+        // NPC feet positions come from the grid kept current by Game::Update
+        m_Player.Move(moveDirection, deltaTime, &m_Tilemap, &m_NPCGrid);
     }
     else if (m_InDialogue)
     {
@@ -1074,71 +1271,101 @@ void Game::ProcessInput(float deltaTime)
 
 void Game::ScrollCallback(GLFWwindow *window, double /*xoffset*/, double yoffset)
 {
-    // Retrieve Game instance from window user pointer
+    // Handled by the next ProcessInput(), so recorded wheel events replay on the same step
+    Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window));
+    if (game)
+    {
+        game->m_Input.OnScroll(yoffset);
+    }
+}
+
+void Game::KeyCallback(GLFWwindow *window, int key, int /*scancode*/, int action, int /*mods*/)
+{
+    Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window));
+    if (game)
+    {
+        game->m_Input.OnKey(key, action != GLFW_RELEASE);
+    }
+}
+
+void Game::MouseButtonCallback(GLFWwindow *window, int button, int action, int /*mods*/)
+{
     Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window));
-    if (!game)
+    if (game)
     {
-        return;
+        game->m_Input.OnMouseButton(button, action != GLFW_RELEASE);
     }
+}
 
+void Game::CursorPosCallback(GLFWwindow *window, double x, double y)
+{
+    Game *game = static_cast<Game *>(glfwGetWindowUserPointer(window));
+    if (game)
+    {
+        game->m_Input.OnCursorPos(x, y);
+    }
+}
+
+void Game::HandleScroll(double yoffset)
+{
     // Delegate editor-specific scroll handling
-    if (game->m_Editor.IsActive())
+    if (m_Editor.IsActive())
     {
-        game->m_Editor.HandleScroll(yoffset, game->MakeEditorContext());
+        m_Editor.HandleScroll(yoffset, MakeEditorContext());
         // If tile picker is open, editor handles all scroll
-        if (game->m_Editor.ShowTilePicker())
+        if (m_Editor.ShowTilePicker())
         {
             return;
         }
     }
 
     // Check for Ctrl modifier
-    int ctrlState = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) | glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL);
+    bool ctrlHeld = m_Input.IsKeyDown(GLFW_KEY_LEFT_CONTROL) || m_Input.IsKeyDown(GLFW_KEY_RIGHT_CONTROL);
 
     // Camera zoom with Ctrl+scroll
-    if (ctrlState == GLFW_PRESS)
+    if (ctrlHeld)
     {
         // Zoom centered on player position
-        float baseWorldWidth = static_cast<float>(game->m_TilesVisibleWidth * game->m_Tilemap.GetTileWidth());
-        float baseWorldHeight = static_cast<float>(game->m_TilesVisibleHeight * game->m_Tilemap.GetTileHeight());
+        float baseWorldWidth = static_cast<float>(m_TilesVisibleWidth * m_Tilemap.GetTileWidth());
+        float baseWorldHeight = static_cast<float>(m_TilesVisibleHeight * m_Tilemap.GetTileHeight());
 
-        float oldZoom = game->m_CameraZoom;
+        float oldZoom = m_CameraZoom;
         float oldWorldWidth = baseWorldWidth / oldZoom;
         float oldWorldHeight = baseWorldHeight / oldZoom;
 
         // Get the player's visual center
-        glm::vec2 playerPos = game->m_Player.GetPosition();
+        glm::vec2 playerPos = m_Player.GetPosition();
         glm::vec2 playerVisualCenter = playerPos - glm::vec2(0.0f, PlayerCharacter::HITBOX_HEIGHT * 0.5f);
 
         // Apply zoom with snapping to prevent sub-pixel seams
         float zoomDelta = yoffset > 0 ? 1.1f : 0.9f;
-        game->m_CameraZoom *= zoomDelta;
+        m_CameraZoom *= zoomDelta;
 
         // Editor mode allows zooming out further (0.1x) to see entire map
-        float minZoom = (game->m_Editor.IsActive() && game->m_FreeCameraMode) ? 0.1f : 0.4f;
-        game->m_CameraZoom = std::max(minZoom, std::min(4.0f, game->m_CameraZoom));
+        float minZoom = (m_Editor.IsActive() && m_FreeCameraMode) ? 0.1f : 0.4f;
+        m_CameraZoom = std::max(minZoom, std::min(4.0f, m_CameraZoom));
         // Snap to 0.1 increments
-        game->m_CameraZoom = std::round(game->m_CameraZoom * 10.0f) / 10.0f;
+        m_CameraZoom = std::round(m_CameraZoom * 10.0f) / 10.0f;
 
-        float newZoom = game->m_CameraZoom;
+        float newZoom = m_CameraZoom;
         float newWorldWidth = baseWorldWidth / newZoom;
         float newWorldHeight = baseWorldHeight / newZoom;
 
         // Adjust camera position to keep player centered
-        game->m_CameraPosition = playerVisualCenter - glm::vec2(newWorldWidth * 0.5f, newWorldHeight * 0.5f);
+        m_CameraPosition = playerVisualCenter - glm::vec2(newWorldWidth * 0.5f, newWorldHeight * 0.5f);
 
         // Clamp camera to map bounds (skip in editor free-camera mode)
-        if (!(game->m_Editor.IsActive() && game->m_FreeCameraMode))
+        if (!(m_Editor.IsActive() && m_FreeCameraMode))
         {
-            float mapWidth = static_cast<float>(game->m_Tilemap.GetMapWidth() * game->m_Tilemap.GetTileWidth());
-            float mapHeight = static_cast<float>(game->m_Tilemap.GetMapHeight() * game->m_Tilemap.GetTileHeight());
-            game->m_CameraPosition.x = std::max(0.0f, std::min(game->m_CameraPosition.x, mapWidth - newWorldWidth));
-            game->m_CameraPosition.y = std::max(0.0f, std::min(game->m_CameraPosition.y, mapHeight - newWorldHeight));
+            float mapWidth = static_cast<float>(m_Tilemap.GetMapWidth() * m_Tilemap.GetTileWidth());
+            float mapHeight = static_cast<float>(m_Tilemap.GetMapHeight() * m_Tilemap.GetTileHeight());
+            m_CameraPosition.x = std::max(0.0f, std::min(m_CameraPosition.x, mapWidth - newWorldWidth));
+            m_CameraPosition.y = std::max(0.0f, std::min(m_CameraPosition.y, mapHeight - newWorldHeight));
         }
 
         // Also update the follow target so camera doesn't snap back
-        game->m_CameraFollowTarget = game->m_CameraPosition;
+        m_CameraFollowTarget = m_CameraPosition;
 
-        std::cout << "Camera zoom: " << game->m_CameraZoom << "x" << std::endl;
+        std::cout << "Camera zoom: " << m_CameraZoom << "x" << std::endl;
     }
 }
@@ -0,0 +1,279 @@
+#include "GameStateManager.h"
+
+#include <algorithm>
+#include <charconv>
+
+namespace
+{
+constexpr std::uint32_t NO_QUEST = UINT32_MAX;
+constexpr std::string_view ACCEPTED_PREFIX = "accepted_";
+constexpr std::string_view COMPLETED_PREFIX = "completed_";
+
+bool ParseInt(std::string_view text, std::int64_t &value)
+{
+    const char *end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+// Same spelling as GetFlagValue() uses for integers
+std::string_view FormatInt(std::int64_t value, char (&buffer)[24])
+{
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string_view(buffer, static_cast<std::size_t>(ptr - buffer));
+}
+}  // namespace
+
+GameStateManager::FlagId GameStateManager::Intern(std::string_view key)
+{
+    auto it = m_Ids.find(key);
+    if (it != m_Ids.end())
+        return it->second;
+
+    const auto id = static_cast<FlagId>(m_Names.size());
+    m_Ids.emplace(std::string(key), id);
+    m_Names.emplace_back(key);
+    m_Slots.emplace_back();
+    m_QuestOf.push_back(NO_QUEST);
+    RegisterQuestFlag(id, key);
+    return id;
+}
+
+GameStateManager::FlagId GameStateManager::Find(std::string_view key) const
+{
+    auto it = m_Ids.find(key);
+    return it != m_Ids.end() ? it->second : INVALID_FLAG;
+}
+
+void GameStateManager::SetFlag(FlagId id, bool value)
+{
+    FlagSlot &slot = m_Slots[id];
+    if (slot.type == FlagType::Bool && (slot.number != 0) == value)
+        return;
+    slot.type = FlagType::Bool;
+    slot.number = value ? 1 : 0;
+    slot.text.clear();
+    OnFlagChanged(id);
+}
+
+void GameStateManager::SetFlagInt(FlagId id, std::int64_t value)
+{
+    FlagSlot &slot = m_Slots[id];
+    if (slot.type == FlagType::Int && slot.number == value)
+        return;
+    slot.type = FlagType::Int;
+    slot.number = value;
+    slot.text.clear();
+    OnFlagChanged(id);
+}
+
+void GameStateManager::SetFlagValue(FlagId id, std::string_view value)
+{
+    FlagSlot &slot = m_Slots[id];
+    if (slot.type == FlagType::String && slot.text == value)
+        return;
+    slot.type = FlagType::String;
+    slot.number = 0;
+    slot.text = value;
+    OnFlagChanged(id);
+}
+
+bool GameStateManager::GetFlag(FlagId id) const
+{
+    switch (GetFlagType(id))
+    {
+        case FlagType::Bool:
+        case FlagType::Int:
+            return m_Slots[id].number != 0;
+        case FlagType::String:
+            return m_Slots[id].text == "true" || m_Slots[id].text == "1";
+        default:
+            return false;
+    }
+}
+
+std::int64_t GameStateManager::GetFlagInt(FlagId id) const
+{
+    switch (GetFlagType(id))
+    {
+        case FlagType::Bool:
+        case FlagType::Int:
+            return m_Slots[id].number;
+        case FlagType::String:
+        {
+            std::int64_t value = 0;
+            return ParseInt(m_Slots[id].text, value) ? value : 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+std::string GameStateManager::GetFlagValue(FlagId id) const
+{
+    switch (GetFlagType(id))
+    {
+        case FlagType::Bool:
+            return m_Slots[id].number != 0 ? "true" : "false";
+        case FlagType::Int:
+            return std::to_string(m_Slots[id].number);
+        case FlagType::String:
+            return m_Slots[id].text;
+        default:
+            return "";
+    }
+}
+
+bool GameStateManager::FlagEquals(FlagId id, std::string_view value) const
+{
+    switch (GetFlagType(id))
+    {
+        case FlagType::Bool:
+            return value == (m_Slots[id].number != 0 ? "true" : "false");
+        case FlagType::Int:
+        {
+            char buffer[24];
+            return value == FormatInt(m_Slots[id].number, buffer);
+        }
+        case FlagType::String:
+            return value == m_Slots[id].text;
+        default:
+            return value.empty();
+    }
+}
+
+bool GameStateManager::EvaluateCondition(const DialogueCondition &condition) const
+{
+    switch (condition.type)
+    {
+        case DialogueCondition::Type::FLAG_SET:
+            return HasFlag(condition.key);
+
+        case DialogueCondition::Type::FLAG_NOT_SET:
+            return !HasFlag(condition.key);
+
+        case DialogueCondition::Type::FLAG_EQUALS:
+            return FlagEquals(Find(condition.key), condition.value);
+
+        default:
+            return true;
+    }
+}
+
+bool GameStateManager::EvaluateConditions(const std::vector<DialogueCondition> &conditions) const
+{
+    for (const auto &condition : conditions)
+    {
+        if (!EvaluateCondition(condition))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GameStateManager::Clear()
+{
+    for (FlagSlot &slot : m_Slots)
+        slot = FlagSlot{};
+    for (Quest &quest : m_Quests)
+        quest.active = false;
+    m_ActiveQuests.clear();
+    ++m_Version;
+}
+
+std::string GameStateManager::GetQuestDescription(std::string_view questName) const
+{
+    std::string flagKey(ACCEPTED_PREFIX);
+    flagKey += questName;
+    const FlagId id = Find(flagKey);
+    switch (GetFlagType(id))
+    {
+        case FlagType::String:
+        {
+            const std::string &text = m_Slots[id].text;
+            if (text != "true" && text != "1" && text != "false" && text != "0")
+                return text;
+            return "";
+        }
+        case FlagType::Int:
+        {
+            const std::int64_t number = m_Slots[id].number;
+            return number != 0 && number != 1 ? std::to_string(number) : "";
+        }
+        default:
+            return "";
+    }
+}
+
+void GameStateManager::RegisterQuestFlag(FlagId id, std::string_view key)
+{
+    // accepted_<name>_quest and completed_<name>_quest name the same quest
+    std::string_view questName;
+    bool accepted = false;
+    if (key.starts_with(ACCEPTED_PREFIX) && key.find("_quest") != std::string_view::npos)
+    {
+        questName = key.substr(ACCEPTED_PREFIX.size());
+        accepted = true;
+    }
+    else if (key.starts_with(COMPLETED_PREFIX))
+    {
+        questName = key.substr(COMPLETED_PREFIX.size());
+        // Only if the matching accepted_ key would contain "_quest"
+        if (questName.find("_quest") == std::string_view::npos && !questName.starts_with("quest"))
+            return;
+    }
+    else
+    {
+        return;
+    }
+
+    auto it = std::find_if(m_Quests.begin(), m_Quests.end(),
+                           [questName](const Quest &quest) { return quest.name == questName; });
+    if (it == m_Quests.end())
+    {
+        m_Quests.push_back(Quest{std::string(questName)});
+        it = std::prev(m_Quests.end());
+    }
+    (accepted ? it->accepted : it->completed) = id;
+    m_QuestOf[id] = static_cast<std::uint32_t>(it - m_Quests.begin());
+}
+
+void GameStateManager::OnFlagChanged(FlagId id)
+{
+    ++m_Version;
+    if (m_QuestOf[id] != NO_QUEST)
+        UpdateQuest(m_QuestOf[id]);
+}
+
+void GameStateManager::UpdateQuest(std::uint32_t index)
+{
+    Quest &quest = m_Quests[index];
+
+    // Accepted counts when it holds a description or a true value
+    bool accepted = false;
+    switch (GetFlagType(quest.accepted))
+    {
+        case FlagType::Bool:
+        case FlagType::Int:
+            accepted = m_Slots[quest.accepted].number != 0;
+            break;
+        case FlagType::String:
+        {
+            const std::string &text = m_Slots[quest.accepted].text;
+            accepted = !text.empty() && text != "false" && text != "0";
+            break;
+        }
+        default:
+            break;
+    }
+    const bool active = accepted && !GetFlag(quest.completed);
+    if (active == quest.active)
+        return;
+
+    quest.active = active;
+    if (active)
+        m_ActiveQuests.push_back(quest.name);
+    else
+        std::erase(m_ActiveQuests, quest.name);
+}
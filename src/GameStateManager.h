@@ -2,23 +2,50 @@
 
 #include "DialogueSystem.h"
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @class GameStateManager
  * @brief Manages persistent game state flags and variables.
  * @author Alex (https://github.com/lextpf)
+ * @ingroup Dialogue
  *
  * Central storage for all game flags that dialogue conditions can check
- * and consequences can modify. Flags are stored as string key-value pairs.
+ * and consequences can modify.
  *
  * @section flag_types Flag Types
  * |    Type |     Method     | Storage    | Example            |
  * |---------|----------------|------------|--------------------|
- * | Boolean |   SetFlag()    | true/false | talked_to_elder    |
+ * | Boolean |   SetFlag()    | bool       | talked_to_elder    |
+ * | Integer | SetFlagInt()   | int64      | wolves_killed      |
  * |  String | SetFlagValue() | Any string | accepted_ufo_quest |
  *
+ * GetFlagValue() returns any type as text ("true", "42", ...), so
+ * FLAG_EQUALS conditions work whichever setter wrote the flag.
+ *
+ * @section flag_ids Flag IDs
+ * Every flag name is interned once into a FlagId, a dense index into the
+ * flag slots. The string overloads look the name up on each call; callers
+ * that check the same flag repeatedly resolve it once with Intern() and
+ * use the FlagId overloads, which are a bounds check and an array read:
+ *
+ * @code{.cpp}
+ * const FlagId elder = state.Intern("talked_to_elder");
+ * if (state.GetFlag(elder)) { ... }
+ * @endcode
+ *
+ * IDs stay valid for the manager's lifetime, including across Clear().
+ *
+ * @section flag_version Change Version
+ * GetVersion() increases whenever a flag's value changes. UI that derives
+ * text from flags (the quest list on the HUD) stores the version it built
+ * from and rebuilds only when it differs.
+ *
  * @section quest_lifecycle Quest Lifecycle
  * @htmlonly
  * <pre class="mermaid">
@@ -71,6 +98,11 @@
  * completed_<name>_quest -> "true"
  * ```
  *
+ * Interning a name that follows this pattern registers the quest, and
+ * every write to one of its two flags updates the active quest list, so
+ * GetActiveQuests() returns a stored vector instead of scanning all flags.
+ * Quests are listed in the order they became active.
+ *
  * @par Example: UFO Quest
  * @code{.cpp}
  * // Accept quest with description
@@ -89,168 +121,177 @@
 class GameStateManager
 {
 public:
+    using FlagId = std::uint32_t;
+    static constexpr FlagId INVALID_FLAG = UINT32_MAX;
+
+    /// @brief Stored type of a flag.
+    enum class FlagType : std::uint8_t
+    {
+        Unset,
+        Bool,
+        Int,
+        String
+    };
+
     GameStateManager() = default;
 
+    /// @name Flag IDs
+    /// @{
+
+    /**
+     * @brief ID of @p key, registering it if new.
+     * @return Stable ID; the flag itself stays unset until written.
+     */
+    FlagId Intern(std::string_view key);
+
+    /// @brief ID of @p key, or INVALID_FLAG if the name was never interned.
+    [[nodiscard]] FlagId Find(std::string_view key) const;
+
+    /// @brief Name an ID was interned from.
+    [[nodiscard]] const std::string &GetFlagName(FlagId id) const { return m_Names[id]; }
+
+    /// @brief Number of interned names.
+    [[nodiscard]] std::size_t GetFlagCount() const { return m_Names.size(); }
+    /// @}
+
+    /// @name Writing
+    /// @{
+
     /**
      * @brief Set a boolean flag.
      * @param key Flag name.
      * @param value True or false.
      */
-    void SetFlag(const std::string& key, bool value = true)
-    {
-        m_Flags[key] = value ? "true" : "false";
-    }
+    void SetFlag(std::string_view key, bool value = true) { SetFlag(Intern(key), value); }
+    void SetFlag(FlagId id, bool value = true);
+
+    /// @brief Set an integer flag.
+    void SetFlagInt(std::string_view key, std::int64_t value) { SetFlagInt(Intern(key), value); }
+    void SetFlagInt(FlagId id, std::int64_t value);
 
     /**
-     * @brief Get a boolean flag value.
+     * @brief Set a flag to a string value.
      * @param key Flag name.
-     * @return True if flag is set and equals true or 1, false otherwise.
+     * @param value String value.
      */
-    [[nodiscard]] bool GetFlag(const std::string& key) const
-    {
-        auto it = m_Flags.find(key);
-        if (it == m_Flags.end()) return false;
-        return (it->second == "true" || it->second == "1");
-    }
+    void SetFlagValue(std::string_view key, std::string_view value) { SetFlagValue(Intern(key), value); }
+    void SetFlagValue(FlagId id, std::string_view value);
 
     /**
      * @brief Clear a flag (set to false).
-     * @param key Flag name.
+     *
+     * The flag still exists afterwards, so HasFlag() stays true.
      */
-    void ClearFlag(const std::string& key)
-    {
-        m_Flags[key] = "false";
-    }
+    void ClearFlag(std::string_view key) { SetFlag(Intern(key), false); }
+    void ClearFlag(FlagId id) { SetFlag(id, false); }
+    /// @}
+
+    /// @name Reading
+    /// @{
 
     /**
-     * @brief Set a flag to a string value.
-     * @param key Flag name.
-     * @param value String value.
+     * @brief Get a boolean flag value.
+     * @return True if the flag is a true bool, a nonzero int, or the string "true" or "1".
      */
-    void SetFlagValue(const std::string& key, const std::string& value)
-    {
-        m_Flags[key] = value;
-    }
+    [[nodiscard]] bool GetFlag(std::string_view key) const { return GetFlag(Find(key)); }
+    [[nodiscard]] bool GetFlag(FlagId id) const;
+
+    /// @brief Integer value; bools read as 0/1, strings are parsed, unset or non-numeric is 0.
+    [[nodiscard]] std::int64_t GetFlagInt(std::string_view key) const { return GetFlagInt(Find(key)); }
+    [[nodiscard]] std::int64_t GetFlagInt(FlagId id) const;
 
     /**
-     * @brief Get a flag's string value.
-     * @param key Flag name.
+     * @brief Get a flag's value as text.
      * @return The value, or empty string if not set.
      */
-    [[nodiscard]] std::string GetFlagValue(const std::string& key) const
-    {
-        auto it = m_Flags.find(key);
-        return (it != m_Flags.end()) ? it->second : "";
-    }
+    [[nodiscard]] std::string GetFlagValue(std::string_view key) const { return GetFlagValue(Find(key)); }
+    [[nodiscard]] std::string GetFlagValue(FlagId id) const;
+
+    /// @brief Whether GetFlagValue() would equal @p value, without building the string.
+    [[nodiscard]] bool FlagEquals(FlagId id, std::string_view value) const;
 
     /**
      * @brief Check if a flag exists.
-     * @param key Flag name.
      * @return True if the flag has been set.
      */
-    [[nodiscard]] bool HasFlag(const std::string& key) const
+    [[nodiscard]] bool HasFlag(std::string_view key) const { return HasFlag(Find(key)); }
+    [[nodiscard]] bool HasFlag(FlagId id) const { return GetFlagType(id) != FlagType::Unset; }
+
+    [[nodiscard]] FlagType GetFlagType(FlagId id) const
     {
-        return m_Flags.find(key) != m_Flags.end();
+        return id < m_Slots.size() ? m_Slots[id].type : FlagType::Unset;
     }
+    /// @}
 
     /**
      * @brief Evaluate a single condition.
      * @param condition The condition to check.
      * @return True if condition is met.
      */
-    [[nodiscard]] bool EvaluateCondition(const DialogueCondition& condition) const
-    {
-        switch (condition.type)
-        {
-            case DialogueCondition::Type::FLAG_SET:
-                return HasFlag(condition.key);
-
-            case DialogueCondition::Type::FLAG_NOT_SET:
-                return !HasFlag(condition.key);
-
-            case DialogueCondition::Type::FLAG_EQUALS:
-                return GetFlagValue(condition.key) == condition.value;
-
-            default:
-                return true;
-        }
-    }
+    [[nodiscard]] bool EvaluateCondition(const DialogueCondition &condition) const;
 
     /**
      * @brief Evaluate multiple conditions (&& logic).
      * @param conditions Vector of conditions.
      * @return True if all conditions are met.
      */
-    [[nodiscard]] bool EvaluateConditions(const std::vector<DialogueCondition>& conditions) const
-    {
-        for (const auto& condition : conditions)
-        {
-            if (!EvaluateCondition(condition))
-            {
-                return false;
-            }
-        }
-        return true;
-    }
+    [[nodiscard]] bool EvaluateConditions(const std::vector<DialogueCondition> &conditions) const;
 
     /**
      * @brief Clear all state.
+     *
+     * Unsets every flag; interned IDs remain valid.
      */
-    void Clear()
-    {
-        m_Flags.clear();
-    }
+    void Clear();
+
+    /// @brief Incremented by every change to a flag's value.
+    [[nodiscard]] std::uint64_t GetVersion() const { return m_Version; }
 
     /**
      * @brief Get list of active quest names.
-     * @return Vector of quest names (without "accepted_" prefix).
+     * @return Quest names (without "accepted_" prefix) in the order they became active.
      */
-    [[nodiscard]] std::vector<std::string> GetActiveQuests() const
-    {
-        std::vector<std::string> activeQuests;
-
-        for (const auto& [key, value] : m_Flags)
-        {
-            // Check if this is a quest flag that's active
-            if (key.find("_quest") != std::string::npos &&
-                key.find("accepted_") == 0 &&
-                !value.empty() && value != "false" && value != "0")
-            {
-                // Extract quest name
-                std::string questName = key.substr(9);  // Remove prefix
-
-                // Check if this quest is not completed
-                std::string completedKey = "completed_" + questName;
-                auto completedIt = m_Flags.find(completedKey);
-                if (completedIt == m_Flags.end() ||
-                    (completedIt->second != "true" && completedIt->second != "1"))
-                {
-                    activeQuests.push_back(questName);
-                }
-            }
-        }
-
-        return activeQuests;
-    }
+    [[nodiscard]] const std::vector<std::string> &GetActiveQuests() const { return m_ActiveQuests; }
 
     /**
      * @brief Get a quest's description from its flag value.
      * @param questName Quest identifier (e.g., "ufo_quest")
      * @return The quest description, or empty string if not set
      */
-    [[nodiscard]] std::string GetQuestDescription(const std::string& questName) const
-    {
-        std::string flagKey = "accepted_" + questName;
-        auto it = m_Flags.find(flagKey);
-        if (it != m_Flags.end() &&
-            it->second != "true" && it->second != "1" &&
-            it->second != "false" && it->second != "0")
-        {
-            return it->second;
-        }
-        return "";
-    }
+    [[nodiscard]] std::string GetQuestDescription(std::string_view questName) const;
 
 private:
-    std::unordered_map<std::string, std::string> m_Flags;  ///< All flags as strings
+    struct FlagSlot
+    {
+        FlagType type = FlagType::Unset;
+        std::int64_t number = 0;  ///< Bool (0/1) or Int value
+        std::string text;         ///< String value
+    };
+
+    /// @brief A quest known from its accepted_/completed_ flag names.
+    struct Quest
+    {
+        std::string name;  ///< "<name>_quest"
+        FlagId accepted = INVALID_FLAG;
+        FlagId completed = INVALID_FLAG;
+        bool active = false;
+    };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    void RegisterQuestFlag(FlagId id, std::string_view key);
+    void OnFlagChanged(FlagId id);
+    void UpdateQuest(std::uint32_t quest);
+
+    std::unordered_map<std::string, FlagId, StringHash, std::equal_to<>> m_Ids;
+    std::vector<std::string> m_Names;      ///< By FlagId
+    std::vector<FlagSlot> m_Slots;         ///< By FlagId
+    std::vector<std::uint32_t> m_QuestOf;  ///< By FlagId: index into m_Quests, or UINT32_MAX
+    std::vector<Quest> m_Quests;
+    std::vector<std::string> m_ActiveQuests;
+    std::uint64_t m_Version = 0;
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+
+/**
+ * @class GlyphTable
+ * @brief Flat ASCII glyph lookup indexed by character code.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * The fonts only load characters 0-127, so a 128-entry array replaces the
+ * `std::map<char, Glyph>` the renderers used to search per character.
+ * Find() is a bounds check and a bit test; characters outside ASCII return
+ * nullptr like missing glyphs.
+ *
+ * @tparam Glyph The backend's glyph metrics type.
+ *
+ * @par Thread Safety
+ * Not thread-safe. Concurrent reads are safe.
+ */
+template<typename Glyph>
+class GlyphTable
+{
+public:
+    static constexpr std::size_t CAPACITY = 128;
+
+    /// @brief Glyph for @p c, or nullptr if the font has none.
+    [[nodiscard]] const Glyph *Find(char c) const
+    {
+        const auto index = static_cast<unsigned char>(c);
+        return index < CAPACITY && m_Present[index] ? &m_Glyphs[index] : nullptr;
+    }
+
+    [[nodiscard]] Glyph *Find(char c)
+    {
+        return const_cast<Glyph *>(static_cast<const GlyphTable &>(*this).Find(c));
+    }
+
+    /// @brief Store @p glyph for @p c; ignored outside ASCII.
+    void Insert(char c, const Glyph &glyph)
+    {
+        const auto index = static_cast<unsigned char>(c);
+        if (index >= CAPACITY)
+            return;
+        m_Glyphs[index] = glyph;
+        m_Present.set(index);
+    }
+
+    void Clear() { m_Present.reset(); }
+
+    [[nodiscard]] std::size_t Size() const { return m_Present.count(); }
+    [[nodiscard]] bool Empty() const { return m_Present.none(); }
+
+    /// @brief Call @p fn(c, glyph) for every loaded glyph in code order.
+    template<typename Fn>
+    void ForEach(Fn &&fn) const
+    {
+        for (std::size_t i = 0; i < CAPACITY; ++i)
+        {
+            if (m_Present[i])
+                fn(static_cast<char>(i), m_Glyphs[i]);
+        }
+    }
+
+private:
+    std::array<Glyph, CAPACITY> m_Glyphs{};
+    std::bitset<CAPACITY> m_Present;
+};
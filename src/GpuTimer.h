@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @struct GpuTimerResult
+ * @brief GPU time spent in one named region of a finished frame.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Regions opened several times in one frame with the same name are summed.
+ */
+struct GpuTimerResult
+{
+    const char *name;     ///< Region name passed to IRenderer::BeginGpuTimer().
+    float milliseconds;   ///< GPU time between the begin and end timestamps.
+};
+
+/**
+ * @class GpuTimerFrame
+ * @brief Timestamp slot bookkeeping for one frame of GPU timer queries.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Backends keep one of these per frame in flight, next to an equally sized
+ * block of API queries (GL query objects or a Vulkan query pool range).
+ * Begin() and End() hand out query indices; once the backend has read the
+ * raw timestamps back, Resolve() turns them into per-region milliseconds.
+ *
+ * Regions may nest: each one uses its own pair of absolute timestamps, so
+ * nesting costs nothing extra. When MAX_QUERIES runs out, further regions
+ * are dropped for that frame.
+ */
+class GpuTimerFrame
+{
+public:
+    /// @brief Timestamps per frame (two per region).
+    static constexpr uint32_t MAX_QUERIES = 64;
+
+    /// @brief Returned instead of a query index when nothing should be written.
+    static constexpr uint32_t NO_QUERY = UINT32_MAX;
+
+    /// @brief Forget all regions, making every query slot free again.
+    void Reset()
+    {
+        m_Regions.clear();
+        m_Open.clear();
+        m_QueryCount = 0;
+    }
+
+    /**
+     * @brief Open a region.
+     * @param name Region name; must outlive the results (use a string literal).
+     * @return Query index to write the begin timestamp to, or NO_QUERY.
+     */
+    uint32_t Begin(const char *name)
+    {
+        if (m_QueryCount + 2 > MAX_QUERIES)
+        {
+            // Still track nesting so the matching End() is ignored too
+            m_Open.push_back(NO_REGION);
+            return NO_QUERY;
+        }
+        m_Open.push_back(m_Regions.size());
+        m_Regions.push_back({name, m_QueryCount, NO_QUERY});
+        return m_QueryCount++;
+    }
+
+    /**
+     * @brief Close the innermost open region.
+     * @return Query index to write the end timestamp to, or NO_QUERY.
+     */
+    uint32_t End()
+    {
+        if (m_Open.empty())
+        {
+            return NO_QUERY;
+        }
+        size_t region = m_Open.back();
+        m_Open.pop_back();
+        if (region == NO_REGION)
+        {
+            return NO_QUERY;
+        }
+        m_Regions[region].endQuery = m_QueryCount;
+        return m_QueryCount++;
+    }
+
+    /// @brief Queries written this frame; indices [0, count) are in use.
+    uint32_t GetQueryCount() const { return m_QueryCount; }
+
+    /**
+     * @brief Convert raw timestamps into per-region results.
+     *
+     * @param timestamps   GetQueryCount() raw timestamp values.
+     * @param nsPerTick    Nanoseconds per timestamp tick (1 for OpenGL).
+     * @param validMask    Mask of valid timestamp bits (wraparound safe).
+     * @param out          Cleared, then filled in first-begin order.
+     */
+    void Resolve(const uint64_t *timestamps, double nsPerTick, uint64_t validMask,
+                 std::vector<GpuTimerResult> &out) const
+    {
+        out.clear();
+        for (const Region &region : m_Regions)
+        {
+            if (region.endQuery == NO_QUERY)
+            {
+                continue; // Never closed this frame
+            }
+            uint64_t ticks = (timestamps[region.endQuery] - timestamps[region.beginQuery]) & validMask;
+            float ms = static_cast<float>(static_cast<double>(ticks) * nsPerTick * 1e-6);
+
+            bool merged = false;
+            for (GpuTimerResult &result : out)
+            {
+                if (result.name == region.name || std::strcmp(result.name, region.name) == 0)
+                {
+                    result.milliseconds += ms;
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged)
+            {
+                out.push_back({region.name, ms});
+            }
+        }
+    }
+
+private:
+    static constexpr size_t NO_REGION = SIZE_MAX;
+
+    struct Region
+    {
+        const char *name;
+        uint32_t beginQuery;
+        uint32_t endQuery;
+    };
+
+    std::vector<Region> m_Regions;   ///< Regions begun this frame.
+    std::vector<size_t> m_Open;      ///< Stack of open regions (indices into m_Regions).
+    uint32_t m_QueryCount = 0;       ///< Next free query index.
+};
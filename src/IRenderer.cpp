@@ -1,7 +1,9 @@
 #include "IRenderer.h"
+#include "PerspectiveKernels.h"
 #include "PerspectiveTransform.h"
 
 #include <cmath>
+#include <utility>
 
 void IRenderer::RotateCorners(glm::vec2 corners[4], glm::vec2 size, float rotation)
 {
@@ -22,9 +24,122 @@ void IRenderer::RotateCorners(glm::vec2 corners[4], glm::vec2 size, float rotati
     }
 }
 
+void IRenderer::BuildStaticMeshVertices(const Texture &texture, const StaticQuad *quads, size_t count,
+                                        bool flipY, std::vector<float> &outVertices)
+{
+    outVertices.clear();
+    const float texWidth = static_cast<float>(texture.GetWidth());
+    const float texHeight = static_cast<float>(texture.GetHeight());
+    if (texWidth <= 0.0f || texHeight <= 0.0f)
+    {
+        return;
+    }
+    outVertices.reserve(count * 6 * 4);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const StaticQuad &q = quads[i];
+
+        // Same UV math as DrawSpriteRegion()
+        float u0 = q.texCoord.x / texWidth;
+        float u1 = u0 + q.texSize.x / texWidth;
+        float texY = q.texCoord.y / texHeight;
+        float texH = q.texSize.y / texHeight;
+        float vTop = flipY ? 1.0f - (texY + texH) : texY;
+        float vBottom = flipY ? 1.0f - texY : texY + texH;
+
+        glm::vec2 corners[4] = {
+            {0.0f, 0.0f},
+            {q.size.x, 0.0f},
+            {q.size.x, q.size.y},
+            {0.0f, q.size.y}};
+        RotateCorners(corners, q.size, q.rotation);
+        for (int c = 0; c < 4; c++)
+        {
+            corners[c] += q.position;
+        }
+
+        const glm::vec2 uvs[4] = {{u0, vBottom}, {u1, vBottom}, {u1, vTop}, {u0, vTop}};
+        static constexpr int order[6] = {0, 2, 3, 0, 1, 2};
+        for (int v : order)
+        {
+            outVertices.push_back(corners[v].x);
+            outVertices.push_back(corners[v].y);
+            outVertices.push_back(uvs[v].x);
+            outVertices.push_back(uvs[v].y);
+        }
+    }
+}
+
+IRenderer::SpriteInstance IRenderer::MakeSpriteInstance(glm::vec2 position, glm::vec2 size,
+                                                       glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
+                                                       glm::vec4 color, std::uint16_t flags)
+{
+    auto unorm16 = [](float v)
+    {
+        return static_cast<std::uint16_t>(std::lround(glm::clamp(v, 0.0f, 1.0f) * 65535.0f));
+    };
+    auto unorm8 = [](float v)
+    {
+        return static_cast<std::uint32_t>(std::lround(glm::clamp(v, 0.0f, 1.0f) * 255.0f));
+    };
+
+    SpriteInstance instance;
+    instance.position = position;
+    instance.size = size;
+    instance.uvRect[0] = unorm16(uvMin.x);
+    instance.uvRect[1] = unorm16(uvMin.y);
+    instance.uvRect[2] = unorm16(uvMax.x);
+    instance.uvRect[3] = unorm16(uvMax.y);
+
+    // Wrap to [0, 360) so the 16-bit turn fraction covers any input angle
+    float turns = rotation / 360.0f;
+    turns -= std::floor(turns);
+    instance.rotation = static_cast<std::uint16_t>(static_cast<std::uint32_t>(turns * 65536.0f) & 0xFFFFu);
+    instance.flags = flags;
+    instance.color = unorm8(color.r) | (unorm8(color.g) << 8) | (unorm8(color.b) << 16) | (unorm8(color.a) << 24);
+    return instance;
+}
+
+void IRenderer::DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances,
+                                    size_t count, bool additive)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SpriteInstance &inst = instances[i];
+        glm::vec2 uvMin(inst.uvRect[0] / 65535.0f, inst.uvRect[1] / 65535.0f);
+        glm::vec2 uvMax(inst.uvRect[2] / 65535.0f, inst.uvRect[3] / 65535.0f);
+        if (inst.flags & SPRITE_INSTANCE_FLIP_X)
+        {
+            std::swap(uvMin.x, uvMax.x);
+        }
+        if (inst.flags & SPRITE_INSTANCE_FLIP_Y)
+        {
+            std::swap(uvMin.y, uvMax.y);
+        }
+        glm::vec4 color(static_cast<float>(inst.color & 0xFFu) / 255.0f,
+                        static_cast<float>((inst.color >> 8) & 0xFFu) / 255.0f,
+                        static_cast<float>((inst.color >> 16) & 0xFFu) / 255.0f,
+                        static_cast<float>((inst.color >> 24) & 0xFFu) / 255.0f);
+        float rotation = static_cast<float>(inst.rotation) * (360.0f / 65536.0f);
+        DrawSpriteAtlas(texture, inst.position, inst.size, uvMin, uvMax, rotation, color, additive);
+    }
+}
+
+bool IRenderer::IsPerspectiveActive() const
+{
+    return m_PerspectiveEnabled && !m_PerspectiveSuspended && m_PerspectiveScreenHeight > 0.0f;
+}
+
 void IRenderer::ApplyPerspective(glm::vec2 corners[4]) const
 {
-    if (m_PerspectiveEnabled && !m_PerspectiveSuspended && m_PerspectiveScreenHeight > 0.0f)
+    // GPU mode streams unprojected corners, sprite.vert applies the same math
+    if (m_GpuProjection)
+    {
+        return;
+    }
+
+    if (IsPerspectiveActive())
     {
         perspectiveTransform::Params p;
         p.applyGlobe = (m_ProjectionMode == ProjectionMode::Globe ||
@@ -37,10 +152,54 @@ void IRenderer::ApplyPerspective(glm::vec2 corners[4]) const
         p.screenHeight = static_cast<double>(m_PerspectiveScreenHeight);
         p.horizonScale = static_cast<double>(m_HorizonScale);
         p.sphereRadius = static_cast<double>(m_SphereRadius);
-        perspectiveTransform::TransformCorners(corners, p);
+        PerspectiveKernels::TransformCorners(corners, p);
     }
 }
 
+void IRenderer::ProjectPoints(float *x, float *y, size_t count) const
+{
+    PerspectiveState s = GetPerspectiveState();
+    if (!s.enabled)
+        return;
+
+    // Same parameters as ProjectPoint(), so both agree within PerspectiveKernels::TOLERANCE
+    perspectiveTransform::Params params;
+    params.applyGlobe = (s.mode == ProjectionMode::Globe || s.mode == ProjectionMode::Fisheye);
+    params.applyVanishing = (s.mode == ProjectionMode::VanishingPoint || s.mode == ProjectionMode::Fisheye);
+    params.centerX = static_cast<double>(s.viewWidth) * 0.5;
+    params.centerY = static_cast<double>(s.viewHeight) * 0.5;
+    params.horizonY = static_cast<double>(s.horizonY);
+    params.screenHeight = static_cast<double>(s.viewHeight);
+    params.horizonScale = static_cast<double>(s.horizonScale);
+    params.sphereRadius = static_cast<double>(s.sphereRadius);
+    PerspectiveKernels::TransformPoints(x, y, count, params);
+}
+
+void IRenderer::GetShaderPerspective(bool applyPerspective, glm::vec4 &params0, glm::vec4 &params1) const
+{
+    params0 = glm::vec4(0.0f);
+    params1 = glm::vec4(0.0f);
+    if (!m_GpuProjection || !applyPerspective || !IsPerspectiveActive())
+    {
+        return;
+    }
+
+    // Same parameters ApplyPerspective() feeds into perspectiveTransform::Params
+    bool applyGlobe = (m_ProjectionMode == ProjectionMode::Globe ||
+                       m_ProjectionMode == ProjectionMode::Fisheye);
+    bool applyVanishing = (m_ProjectionMode == ProjectionMode::VanishingPoint ||
+                           m_ProjectionMode == ProjectionMode::Fisheye);
+    params0 = glm::vec4(m_Persp.viewWidth * 0.5f, m_Persp.viewHeight * 0.5f,
+                        m_HorizonY, m_PerspectiveScreenHeight);
+    params1 = glm::vec4(m_HorizonScale, m_SphereRadius,
+                        applyGlobe ? 1.0f : 0.0f, applyVanishing ? 1.0f : 0.0f);
+}
+
+void IRenderer::SetGpuProjection(bool enabled)
+{
+    m_GpuProjection = enabled;
+}
+
 void IRenderer::SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale,
                                               float viewWidth, float viewHeight)
 {
@@ -2,17 +2,24 @@
 
 #include "Texture.h"
 #include "PerspectiveTransform.h"
+#include "GpuTimer.h"
+#include "RenderStats.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <string>
+#include <string_view>
+#include <vector>
 #include <cmath>
+#include <cstdint>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+class JobSystem;
+
 /**
  * @class IRenderer
  * @brief Abstract interface for 2D rendering operations.
@@ -168,6 +175,17 @@ public:
      */
     virtual void Shutdown() = 0;
 
+    /**
+     * @brief Lend the renderer worker threads for its own frame work.
+     *
+     * The Vulkan backend encodes its secondary command buffers on @p jobs
+     * in EndFrame(); other backends ignore it. The pool must outlive the
+     * renderer, or be replaced with nullptr first.
+     *
+     * @param jobs Worker threads, or nullptr to do everything on the calling thread.
+     */
+    virtual void SetJobSystem(JobSystem *jobs) { (void)jobs; }
+
     /**
      * @brief Begin a new rendering frame.
      * 
@@ -274,6 +292,59 @@ public:
                                  glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
                                  glm::vec4 color, bool additive = false) = 0;
 
+    /**
+     * @brief Compact per-instance record for DrawSpriteInstances() (32 bytes).
+     *
+     * Replaces the six expanded vertices of a batched sprite; the vertex
+     * shader builds the quad from it. Use MakeSpriteInstance() to pack.
+     */
+    struct SpriteInstance
+    {
+        glm::vec2 position;       ///< Top-left corner in screen pixels.
+        glm::vec2 size;           ///< Quad size in pixels (negative mirrors).
+        std::uint16_t uvRect[4];  ///< uvMin.x, uvMin.y, uvMax.x, uvMax.y as unorm16.
+        std::uint16_t rotation;   ///< Clockwise rotation, 65536 steps per turn.
+        std::uint16_t flags;      ///< SPRITE_INSTANCE_* bits.
+        std::uint32_t color;      ///< RGBA8, red in the lowest byte.
+    };
+    static_assert(sizeof(SpriteInstance) == 32, "SpriteInstance must stay 32 bytes");
+
+    /// @brief Mirror the UV rect horizontally.
+    static constexpr std::uint16_t SPRITE_INSTANCE_FLIP_X = 1u << 0;
+    /// @brief Mirror the UV rect vertically.
+    static constexpr std::uint16_t SPRITE_INSTANCE_FLIP_Y = 1u << 1;
+
+    /**
+     * @brief Pack DrawSpriteAtlas() arguments into a SpriteInstance.
+     *
+     * @param position Top-left corner in screen pixels.
+     * @param size     Output size in pixels.
+     * @param uvMin    Top-left UV coordinates (normalized 0-1).
+     * @param uvMax    Bottom-right UV coordinates (normalized 0-1).
+     * @param rotation Rotation in degrees, clockwise.
+     * @param color    RGBA color tint/modulation.
+     * @param flags    SPRITE_INSTANCE_* bits.
+     */
+    static SpriteInstance MakeSpriteInstance(glm::vec2 position, glm::vec2 size,
+                                             glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
+                                             glm::vec4 color, std::uint16_t flags = 0);
+
+    /**
+     * @brief Draw many atlas sprites sharing one texture and blend mode.
+     *
+     * Shading matches DrawSpriteAtlas() (texture times per-sprite color).
+     * Backends with instancing upload 32 bytes per sprite and expand the
+     * quad in the vertex shader, with no per-batch sprite cap. The default
+     * implementation forwards each instance to DrawSpriteAtlas().
+     *
+     * @param texture   Atlas texture.
+     * @param instances Sprites to draw, in order.
+     * @param count     Number of instances.
+     * @param additive  Use additive blending for glow effects.
+     */
+    virtual void DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances,
+                                     size_t count, bool additive = false);
+
     /**
      * @brief Draw a solid colored rectangle.
      *
@@ -336,6 +407,98 @@ public:
                                 glm::vec2 texCoord, glm::vec2 texSize,
                                 glm::vec3 color = glm::vec3(1.0f), bool flipY = true) = 0;
 
+    /**
+     * @brief One textured quad baked into a static mesh.
+     *
+     * Fields mirror the DrawSpriteRegion() arguments. Positions are relative
+     * to the mesh origin passed to DrawStaticMesh().
+     */
+    struct StaticQuad
+    {
+        glm::vec2 position;  ///< Top-left corner relative to the mesh origin.
+        glm::vec2 size;      ///< Quad size in pixels.
+        glm::vec2 texCoord;  ///< Top-left of the texture region in pixels.
+        glm::vec2 texSize;   ///< Size of the texture region in pixels.
+        float rotation;      ///< Rotation in degrees around the quad center.
+    };
+
+    /// Returned by CreateStaticMesh() when the backend cannot build the mesh.
+    static constexpr int INVALID_STATIC_MESH = -1;
+
+    /**
+     * @brief Bake quads into a persistent GPU vertex buffer.
+     *
+     * Static meshes hold geometry that rarely changes (e.g. tilemap chunks)
+     * so it can be drawn with a single call per frame instead of being
+     * rebuilt through the sprite batch. Geometry is stored unprojected;
+     * perspective is only applied when GPU projection mode is enabled.
+     *
+     * @param texture Texture sampled by every quad (must outlive the mesh).
+     * @param quads   Quads to bake, drawn in array order.
+     * @param count   Number of quads.
+     * @param flipY   Flip vertical UV coordinates (same as DrawSpriteRegion()).
+     * @return Mesh handle, or INVALID_STATIC_MESH if unsupported or empty.
+     *
+     * @see DrawStaticMesh(), DestroyStaticMesh(), SetGpuProjection()
+     */
+    virtual int CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY)
+    {
+        (void)texture;
+        (void)quads;
+        (void)count;
+        (void)flipY;
+        return INVALID_STATIC_MESH;
+    }
+
+    /**
+     * @brief Draw a static mesh translated by @p origin.
+     *
+     * Flushes pending batches first so draw order is preserved.
+     *
+     * @param mesh   Handle from CreateStaticMesh().
+     * @param origin Screen-space offset added to every vertex.
+     */
+    virtual void DrawStaticMesh(int mesh, glm::vec2 origin)
+    {
+        (void)mesh;
+        (void)origin;
+    }
+
+    /**
+     * @brief Whether UpdateStaticMesh() can patch meshes in place.
+     *
+     * Callers that bake frequently changing quads (animated tiles) check this
+     * and draw those quads through the sprite batch when it is false.
+     */
+    virtual bool SupportsStaticMeshUpdates() const { return false; }
+
+    /**
+     * @brief Overwrite a range of quads of an existing static mesh.
+     *
+     * Only the vertices of the given quads are re-uploaded, so a few
+     * animated tiles changing frame do not force a CreateStaticMesh() rebuild.
+     *
+     * @param mesh      Handle from CreateStaticMesh().
+     * @param firstQuad Index of the first quad to replace.
+     * @param quads     Replacement quads.
+     * @param count     Number of quads; the range must lie inside the mesh.
+     * @param flipY     Same value the mesh was created with.
+     */
+    virtual void UpdateStaticMesh(int mesh, size_t firstQuad, const StaticQuad *quads, size_t count, bool flipY)
+    {
+        (void)mesh;
+        (void)firstQuad;
+        (void)quads;
+        (void)count;
+        (void)flipY;
+    }
+
+    /**
+     * @brief Release a static mesh. Invalid handles are ignored.
+     * @param mesh Handle from CreateStaticMesh().
+     */
+    virtual void DestroyStaticMesh(int mesh) { (void)mesh; }
+
     /**
      * @brief Set the projection matrix.
      * 
@@ -440,6 +603,19 @@ public:
         return glm::vec2(static_cast<float>(resultX), static_cast<float>(resultY));
     }
 
+    /**
+     * @brief ProjectPoint() for many points at once, in place.
+     *
+     * Runs PerspectiveKernels::TransformPoints() in single precision, 4 or 8
+     * points at a time; results stay within PerspectiveKernels::TOLERANCE
+     * of ProjectPoint(). Points are left unchanged while perspective is off.
+     *
+     * @param x     Screen-space X per point (updated).
+     * @param y     Screen-space Y per point (updated).
+     * @param count Number of points.
+     */
+    void ProjectPoints(float *x, float *y, size_t count) const;
+
     /**
      * @brief Compute screen position for a sphere-conforming building vertex.
      *
@@ -645,6 +821,47 @@ public:
      */
     virtual void SuspendPerspective(bool suspend);
 
+    /**
+     * @brief Select where the perspective projection is evaluated.
+     *
+     * In CPU mode (default) every quad corner is pushed through
+     * PerspectiveKernels::TransformCorners() before being batched. In GPU
+     * mode the batcher streams unprojected screen positions and the active
+     * PerspectiveState is uploaded as uniforms (OpenGL) or push constants
+     * (Vulkan) so `sprite.vert` performs the globe/vanishing math per vertex.
+     *
+     * @par Unaffected Paths
+     * | Path               | Behavior in GPU mode                      |
+     * |--------------------|-------------------------------------------|
+     * | DrawWarpedQuad     | Drawn as-is (caller already projected)    |
+     * | SuspendPerspective | Draws submitted while suspended stay flat |
+     * | DrawText           | Never projected                           |
+     * | ProjectPoint       | Still evaluated on the CPU for anchors    |
+     *
+     * @param enabled True to project in the vertex shader.
+     *
+     * @see GetShaderPerspective()
+     */
+    virtual void SetGpuProjection(bool enabled);
+
+    /**
+     * @brief Check whether perspective is evaluated in the vertex shader.
+     * @return True if GPU projection mode is active.
+     */
+    bool IsGpuProjectionEnabled() const { return m_GpuProjection; }
+
+    /**
+     * @brief Let one sprite batch sample several textures.
+     *
+     * When enabled, a texture change no longer ends the sprite batch as long
+     * as a texture slot is free; each vertex carries the slot it samples.
+     * Interleaved tileset, character and particle draws in the Y-sorted pass
+     * then collapse into a few draw calls. Backends without support ignore it.
+     *
+     * @param enabled True to batch across textures.
+     */
+    virtual void SetMultiTextureBatching(bool enabled) { (void)enabled; }
+
     /**
      * @brief Clear the screen to a solid color.
      * 
@@ -672,6 +889,73 @@ public:
      */
     virtual void UploadTexture(const Texture &texture) = 0;
 
+    /**
+     * @brief Upload many textures in one pass.
+     *
+     * Same result as UploadTexture() on each entry; used after a backend
+     * switch with Texture::GetUploadedTextures(). Backends that stage pixels
+     * in host memory copy them on @p jobs in parallel and record all copies
+     * into one submission.
+     *
+     * @param textures Textures to upload; entries without CPU pixels are skipped.
+     * @param jobs     Worker threads for the pixel copies, or nullptr.
+     */
+    virtual void UploadTextures(const std::vector<Texture *> &textures, JobSystem *jobs)
+    {
+        (void)jobs;
+        for (Texture *texture : textures)
+        {
+            if (!texture->m_ImageData.empty())
+                UploadTexture(*texture);
+        }
+    }
+
+    /**
+     * @brief Drop any GPU state this renderer keeps for a texture.
+     *
+     * Called before a shared texture is destroyed while the renderer is
+     * still alive. Backends that cache per-texture objects (descriptor sets,
+     * lookup entries) forget them here; GPU resources a frame in flight may
+     * still read are kept until that frame has finished.
+     *
+     * @param texture Texture that is about to be destroyed. Its GPU handles
+     *                may be taken over by the renderer.
+     */
+    virtual void ReleaseTexture(Texture &texture) { (void)texture; }
+
+    /**
+     * @brief Copy a rectangle of a texture's CPU pixels to its GPU copy.
+     *
+     * Used by hot reload after part of Texture::m_ImageData was rewritten,
+     * so only the changed texels travel to the GPU. Coordinates are in the
+     * CPU copy's row order (the order UploadTexture() sends rows in).
+     *
+     * @param texture Texture already uploaded to this renderer.
+     * @param x, y    First texel of the rectangle.
+     * @param width, height Rectangle size in texels.
+     * @return False if the backend cannot patch in place or the texture has
+     *         no GPU copy here; release and upload it again instead.
+     */
+    virtual bool UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height)
+    {
+        (void)texture;
+        (void)x;
+        (void)y;
+        (void)width;
+        (void)height;
+        return false;
+    }
+
+    /**
+     * @brief Recompile the sprite shaders from shaders/ and swap them in.
+     *
+     * Nothing changes if the new sources fail to compile or link; the old
+     * shaders keep drawing and the error is logged.
+     *
+     * @return True if the new shaders are in use.
+     */
+    virtual bool ReloadShaders() { return false; }
+
     /**
      * @brief Draw text at the specified position.
      *
@@ -688,7 +972,7 @@ public:
      * @param outlineSize Outline/shadow thickness multiplier (default: 1.0).
      * @param alpha Text transparency 0.0-1.0 (default: 0.85).
      */
-    virtual void DrawText(const std::string &text, glm::vec2 position, float scale = 1.0f,
+    virtual void DrawText(std::string_view text, glm::vec2 position, float scale = 1.0f,
                           glm::vec3 color = glm::vec3(1.0f), float outlineSize = 1.0f,
                           float alpha = 0.85f) = 0;
 
@@ -714,7 +998,7 @@ public:
      * @param scale Text scale multiplier.
      * @return Width in pixels.
      */
-    virtual float GetTextWidth(const std::string& text, float scale = 1.0f) const = 0;
+    virtual float GetTextWidth(std::string_view text, float scale = 1.0f) const = 0;
 
     /**
      * @brief Check if this renderer requires Y-axis flipping for textures.
@@ -747,6 +1031,438 @@ public:
      */
     virtual int GetDrawCallCount() const = 0;
 
+    /**
+     * @brief Batch flushes by reason and vertices submitted this frame.
+     *
+     * Backends without the counters report zeros.
+     *
+     * @see RenderStats
+     */
+    const RenderStats &GetRenderStats() const { return m_RenderStats; }
+
+    /// @name Low-Resolution Pass
+    /// @{
+
+    /**
+     * @brief Redirect drawing into an offscreen target at native pixel size.
+     *
+     * Pixel art drawn at window resolution shades every art texel
+     * PIXEL_SCALE^2 times. Drawing the world into a @p width x @p height
+     * target instead (window size / PIXEL_SCALE) and upscaling it once with
+     * EndLowResPass() cuts fill cost by that factor and keeps rotated or
+     * warped sprites on the art's pixel grid.
+     *
+     * Projections are unaffected: a projection spanning @p width x @p height
+     * world units maps one unit to one target pixel. Call this right after
+     * BeginFrame(), before anything is drawn, then Clear() to clear the
+     * target. The target is kept between frames and only recreated when the
+     * size changes.
+     *
+     * @param width  Target width in pixels.
+     * @param height Target height in pixels.
+     * @return False if the backend has no offscreen support or the target
+     *         could not be created; drawing then continues to the window.
+     */
+    virtual bool BeginLowResPass(int width, int height)
+    {
+        (void)width;
+        (void)height;
+        return false;
+    }
+
+    /**
+     * @brief Upscale the offscreen target into the window and draw there again.
+     *
+     * Pending batches are flushed, then the target is copied into the given
+     * window rectangle with nearest-neighbour filtering. Use an integer
+     * multiple of the target size for uniform pixels. The rectangle stays the
+     * viewport for the rest of the frame, so projections set up for the
+     * target still line up with it (UI text then renders at full resolution).
+     * No-op unless BeginLowResPass() returned true this frame.
+     *
+     * @param x      Destination left edge in window pixels.
+     * @param y      Destination bottom edge in window pixels (may be negative
+     *               when the upscaled target overhangs the window).
+     * @param width  Destination width in window pixels.
+     * @param height Destination height in window pixels.
+     */
+    virtual void EndLowResPass(int x, int y, int width, int height)
+    {
+        (void)x;
+        (void)y;
+        (void)width;
+        (void)height;
+    }
+
+    /// @}
+
+    /// @name Render Targets
+    /// Offscreen layers that are drawn once and composited many times.
+    /// @{
+
+    /**
+     * @brief Create an offscreen color target.
+     *
+     * Targets hold premultiplied color at higher than 8-bit precision, so
+     * many faint additive layers can be baked into one without banding.
+     *
+     * @param width  Width in pixels.
+     * @param height Height in pixels.
+     * @return Target handle, or -1 if the backend has no offscreen support.
+     */
+    virtual int CreateRenderTarget(int width, int height)
+    {
+        (void)width;
+        (void)height;
+        return -1;
+    }
+
+    /**
+     * @brief Redirect drawing into @p target and clear it to transparent black.
+     *
+     * The viewport covers the whole target; set a projection spanning its
+     * size. Targets do not nest.
+     *
+     * @return False if @p target is invalid; drawing then continues unchanged.
+     */
+    virtual bool BeginRenderTarget(int target)
+    {
+        (void)target;
+        return false;
+    }
+
+    /// @brief Flush and return drawing to where it went before BeginRenderTarget().
+    virtual void EndRenderTarget() {}
+
+    /**
+     * @brief Composite a target's contents as a screen-aligned quad.
+     *
+     * @param target   Target handle.
+     * @param position Top-left corner under the current projection.
+     * @param size     Quad size under the current projection.
+     * @param additive True adds the target's color to the destination
+     *                 (matches content baked with additive sprites);
+     *                 false blends it over as premultiplied alpha.
+     */
+    virtual void DrawRenderTarget(int target, glm::vec2 position, glm::vec2 size, bool additive)
+    {
+        (void)target;
+        (void)position;
+        (void)size;
+        (void)additive;
+    }
+
+    /// @brief Free a target; the handle may be reused.
+    virtual void DestroyRenderTarget(int target) { (void)target; }
+
+    /// @}
+
+    /// @name Light Map
+    /// Low-resolution light accumulation that replaces the flat ambient tint.
+    /// @{
+
+    /**
+     * @brief Point light splatted into the light map.
+     *
+     * Brightness falls off smoothly from @p color at the center to nothing
+     * at @p radius. Channels above 1 are clamped.
+     */
+    struct Light
+    {
+        glm::vec2 position;  ///< Center under the current projection, before perspective.
+        float radius;        ///< Reach in projection units.
+        glm::vec3 color;     ///< Light added at the center.
+    };
+
+    /// @brief Whether SetLightMap() is implemented.
+    virtual bool SupportsLightMap() const { return false; }
+
+    /**
+     * @brief Accumulate @p lights into a light map and light sprites with it.
+     *
+     * The map starts as the current ambient color (call SetAmbientColor()
+     * first), and each light adds a radial falloff on top, one instanced
+     * draw for all of them. It covers the current viewport at one texel per
+     * @p cellSize projection units; textured sprites then multiply by one
+     * filtered sample of it instead of by the ambient color, until
+     * ClearLightMap(). Light centers are projected with the perspective
+     * active at this call. Render targets keep the flat ambient tint.
+     *
+     * Call after the world projection and perspective are set, before the
+     * world is drawn.
+     *
+     * @param viewSize Projection size in units (the visible world area).
+     * @param cellSize Units per light map texel (a tile or a quarter of one).
+     * @param lights   Lights to splat.
+     * @param count    Number of lights.
+     * @return False if the backend has no light map; sprites keep the ambient tint.
+     */
+    virtual bool SetLightMap(glm::vec2 viewSize, float cellSize, const Light *lights, size_t count)
+    {
+        (void)viewSize;
+        (void)cellSize;
+        (void)lights;
+        (void)count;
+        return false;
+    }
+
+    /// @brief Go back to the flat ambient tint (before drawing sky and UI).
+    virtual void ClearLightMap() {}
+
+    /// @}
+
+    /// @name GPU Star Field
+    /// @{
+
+    /// @brief StarFieldStar::flagsIndex bit marking a background (dim) star.
+    static constexpr std::uint32_t STAR_FIELD_BACKGROUND = 1u << 0;
+
+    /**
+     * @brief One star as uploaded by UploadStarField() (32 bytes).
+     *
+     * Mirrors SkyRenderer's Star plus the layer it belongs to. The index
+     * within the layer lets the shader apply the same "first N stars"
+     * count caps as the CPU path.
+     */
+    struct StarFieldStar
+    {
+        glm::vec2 position;       ///< Normalized sky position (0-1).
+        float baseBrightness;     ///< Star::baseBrightness.
+        float twinklePhase;       ///< Star::twinklePhase (radians).
+        float twinkleSpeed;       ///< Star::twinkleSpeed.
+        float size;               ///< Star::size.
+        std::uint32_t color;      ///< RGBA8 tint, red in the lowest byte.
+        std::uint32_t flagsIndex; ///< STAR_FIELD_BACKGROUND | index within its layer << 1.
+    };
+    static_assert(sizeof(StarFieldStar) == 32, "StarFieldStar must match the stars.vert attributes");
+
+    /// @brief Per-frame inputs of DrawStarField().
+    struct StarFieldParams
+    {
+        glm::vec2 screenSize;             ///< Sky size under the current projection.
+        float time = 0.0f;                ///< Twinkle clock (seconds).
+        float intensity = 0.0f;           ///< Star brightness after weather and dimming (0 = hidden).
+        std::uint32_t backgroundCount = 0;///< Stars in the background layer.
+        std::uint32_t foregroundCount = 0;///< Stars in the foreground layer.
+    };
+
+    /// @brief True if DrawStarField() is implemented (needs instancing and shaders).
+    virtual bool SupportsStarField() const { return false; }
+
+    /**
+     * @brief Copy the star list into a static GPU buffer.
+     *
+     * Call once after the stars are generated and again after a renderer
+     * switch; the buffer is never touched per frame.
+     */
+    virtual void UploadStarField(const StarFieldStar *stars, size_t count)
+    {
+        (void)stars;
+        (void)count;
+    }
+
+    /**
+     * @brief Draw every uploaded star in one instanced call.
+     *
+     * Twinkle, visibility gating and sparkle glows are evaluated in the
+     * shader from @p params. Blending is additive, like the CPU path.
+     *
+     * @param starTexture Sprite for the star itself.
+     * @param glowTexture Sprite for the sparkle glow.
+     * @param params      Frame time, intensity and layer sizes.
+     */
+    virtual void DrawStarField(const Texture &starTexture, const Texture &glowTexture, const StarFieldParams &params)
+    {
+        (void)starTexture;
+        (void)glowTexture;
+        (void)params;
+    }
+
+    /// @}
+
+    /// @name GPU Particles
+    /// @{
+
+    /**
+     * @brief One particle emitter simulated entirely on the GPU.
+     *
+     * Matches the std430 `Emitter` struct in shaders/particles.comp. Each
+     * emitter owns the particle slots [firstSlot, firstSlot + slotCount),
+     * which bounds its live particles; all emitters of a step must use the
+     * same slotCount.
+     */
+    struct GpuParticleEmitter
+    {
+        glm::vec2 position;         ///< Zone top-left (world pixels).
+        glm::vec2 size;             ///< Zone size (world pixels).
+        glm::vec4 uvRect;           ///< Atlas region: uvMin in xy, uvMax in zw.
+        std::uint32_t type;         ///< ParticleType value (Rain, Snow and Fog are simulated).
+        std::uint32_t firstSlot;    ///< First particle slot owned by the emitter.
+        std::uint32_t slotCount;    ///< Number of slots owned.
+        std::uint32_t spawnCount;   ///< Particles to spawn into free slots this step.
+        std::uint32_t flags;        ///< GPU_PARTICLE_* bits.
+        std::uint32_t padding[3];
+    };
+    static_assert(sizeof(GpuParticleEmitter) == 64, "GpuParticleEmitter must match the std430 layout");
+
+    /// @brief Draw the emitter's particles with additive blending.
+    static constexpr std::uint32_t GPU_PARTICLE_ADDITIVE = 1u << 0;
+
+    /// @brief Per-step inputs shared by every GPU emitter.
+    struct GpuParticleStep
+    {
+        float deltaTime = 0.0f;          ///< Seconds since the previous step.
+        float time = 0.0f;               ///< ParticleSystem clock for oscillations.
+        float nightFactor = 0.0f;        ///< 0 = day, 1 = night (see ParticleSystem::SetNightFactor()).
+        std::uint32_t seed = 0;          ///< Changes every step; drives spawn randomness.
+        glm::vec2 wind{0.0f};            ///< Added to weather velocity (pixels/s).
+        glm::vec2 cameraPos{0.0f};       ///< World position of the screen's top-left corner.
+        bool reset = false;              ///< Kill every particle first (slot layout changed).
+    };
+
+    /**
+     * @brief Whether SimulateGpuParticles() and DrawGpuParticles() are implemented.
+     *
+     * Backends without compute support return false and ParticleSystem keeps
+     * every zone on its CPU pool.
+     */
+    virtual bool SupportsGpuParticles() const { return false; }
+
+    /**
+     * @brief Spawn, age, move and cull GPU particles.
+     *
+     * Runs the compute pass over every slot of @p emitters and leaves the
+     * visible particles in a draw list that DrawGpuParticles() consumes
+     * without a CPU round trip. Culling uses the current perspective state,
+     * so call it during rendering, right before DrawGpuParticles().
+     *
+     * @param emitters Emitters with their spawn budget for this step.
+     * @param count    Number of emitters.
+     * @param step     Timing, environment and camera for this step.
+     */
+    virtual void SimulateGpuParticles(const GpuParticleEmitter *emitters, size_t count, const GpuParticleStep &step)
+    {
+        (void)emitters;
+        (void)count;
+        (void)step;
+    }
+
+    /**
+     * @brief Draw the list built by the last SimulateGpuParticles() call.
+     *
+     * Alpha-blended particles are drawn before additive ones, both through
+     * indirect draws sourced from the GPU-written instance buffer. Shading
+     * and projection match DrawSpriteInstances().
+     *
+     * @param atlas Texture the emitters' uvRect values refer to.
+     */
+    virtual void DrawGpuParticles(const Texture &atlas) { (void)atlas; }
+
+    /// @brief Free GPU particle buffers; the next step starts empty.
+    virtual void ReleaseGpuParticles() {}
+
+    /// @}
+
+    /// @name Presentation
+    /// @{
+
+    /// @brief How finished frames are handed to the display.
+    enum class PresentMode
+    {
+        Fifo,      ///< Wait for vertical blank; never tears, always supported.
+        Mailbox,   ///< Replace the queued image; no tearing, lowest latency without it.
+        Immediate  ///< Present at once; may tear.
+    };
+
+    /**
+     * @brief Choose the present mode.
+     *
+     * The Vulkan backend recreates its swapchain, falling back to Fifo when
+     * the surface lacks @p mode. Other backends keep their own swap interval.
+     *
+     * @return False when the backend does not support switching.
+     */
+    virtual bool SetPresentMode(PresentMode mode)
+    {
+        (void)mode;
+        return false;
+    }
+
+    /**
+     * @brief Set how many frames the CPU may record ahead of the GPU.
+     *
+     * More frames hide GPU stalls at the cost of input latency. Waits for
+     * the GPU to go idle; call between frames.
+     *
+     * @param count 1 up to the backend's limit (3 for Vulkan).
+     * @return False when @p count is out of range or switching is unsupported.
+     */
+    virtual bool SetFramesInFlight(int count)
+    {
+        (void)count;
+        return false;
+    }
+
+    /// @}
+
+    /// @name GPU Timers
+    /// @{
+
+    /**
+     * @brief Open a named GPU timing region.
+     *
+     * Writes a GPU timestamp after all previously submitted draws, pending
+     * batches included. Regions may nest and the same name may be used several
+     * times per frame (the times are summed). Must be balanced by
+     * EndGpuTimer() in the same frame.
+     *
+     * @par Latency
+     * Timestamps are read back a few frames later, once the GPU has finished
+     * with them, so timing never stalls the pipeline. GetGpuTimerResults()
+     * therefore describes a frame that is 2-3 frames old.
+     *
+     * @param name Region label; stored by pointer, so pass a string literal.
+     *
+     * @see ScopedGpuTimer
+     */
+    virtual void BeginGpuTimer(const char *name) { (void)name; }
+
+    /// @brief Close the innermost region opened by BeginGpuTimer().
+    virtual void EndGpuTimer() {}
+
+    /**
+     * @brief Per-region GPU times of the most recently resolved frame.
+     *
+     * Empty on backends without timestamp support. Entries keep the order
+     * in which the regions were first opened.
+     */
+    const std::vector<GpuTimerResult> &GetGpuTimerResults() const { return m_GpuTimerResults; }
+
+    /**
+     * @class ScopedGpuTimer
+     * @brief RAII wrapper around BeginGpuTimer() / EndGpuTimer().
+     *
+     * @code
+     * {
+     *     IRenderer::ScopedGpuTimer timer(renderer, "Particles");
+     *     particles.Render(renderer, camera);
+     * }
+     * @endcode
+     */
+    class ScopedGpuTimer
+    {
+    public:
+        ScopedGpuTimer(IRenderer &renderer, const char *name) : m_Renderer(renderer) { m_Renderer.BeginGpuTimer(name); }
+        ~ScopedGpuTimer() { m_Renderer.EndGpuTimer(); }
+        ScopedGpuTimer(const ScopedGpuTimer &) = delete;
+        ScopedGpuTimer &operator=(const ScopedGpuTimer &) = delete;
+
+    private:
+        IRenderer &m_Renderer;
+    };
+
+    /// @}
+
 protected:
     /// @name Perspective State (shared by all renderers)
     /// @{
@@ -758,8 +1474,44 @@ protected:
     float m_SphereRadius = 2000.0f;
     ProjectionMode m_ProjectionMode = ProjectionMode::VanishingPoint;
     PerspectiveState m_Persp;
+    bool m_GpuProjection = false;
     /// @}
 
+    std::vector<GpuTimerResult> m_GpuTimerResults;  ///< Filled by the backend's timer readback.
+    RenderStats m_RenderStats;                      ///< Reset in BeginFrame(), filled by the backend.
+
     static void RotateCorners(glm::vec2 corners[4], glm::vec2 size, float rotation);
+
+    /**
+     * @brief Expand static quads into x,y,u,v triangle vertices.
+     *
+     * Uses the same corner order and UV convention as the sprite batch
+     * (6 vertices per quad: TL, BR, BL, TL, TR, BR).
+     */
+    static void BuildStaticMeshVertices(const Texture &texture, const StaticQuad *quads, size_t count,
+                                        bool flipY, std::vector<float> &outVertices);
+
+    /// True when perspective is configured, not suspended, and has a valid viewport.
+    bool IsPerspectiveActive() const;
+
+    /// CPU projection of quad corners; no-op in GPU projection mode.
     void ApplyPerspective(glm::vec2 corners[4]) const;
+
+    /**
+     * @brief Pack the active perspective for the vertex shader.
+     *
+     * | Vector  | x        | y            | z              | w              |
+     * |---------|----------|--------------|----------------|----------------|
+     * | params0 | centerX  | centerY      | horizonY       | screenHeight   |
+     * | params1 | horizonScale | sphereRadius | applyGlobe (0/1) | applyVanishing (0/1) |
+     *
+     * Both vectors are zero (shader projection off) unless GPU mode is
+     * enabled, perspective is active, and @p applyPerspective is true.
+     *
+     * @param applyPerspective False for geometry that must not be projected
+     *                         (warped quads, text).
+     * @param[out] params0 Center, horizon and screen height.
+     * @param[out] params1 Scales and mode flags.
+     */
+    void GetShaderPerspective(bool applyPerspective, glm::vec4 &params0, glm::vec4 &params1) const;
 };
@@ -0,0 +1,263 @@
+#include "ImageCache.h"
+#include "MappedFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stb_image.h>
+#include <system_error>
+
+namespace
+{
+constexpr uint32_t IMAGE_CACHE_MAGIC = 0x48435854u;  // "TXCH"
+constexpr uint32_t IMAGE_CACHE_VERSION = 1;
+constexpr uint32_t IMAGE_CACHE_FLIP_Y = 1u << 0;
+constexpr uint32_t IMAGE_CACHE_GENERATED = 1u << 1;
+
+struct ImageCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t width;
+    int32_t height;
+    int32_t channels;
+    uint32_t flags;
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint64_t contentHash;
+    uint64_t pixelBytes;
+};
+
+static_assert(sizeof(ImageCacheHeader) == 56);
+}  // namespace
+
+std::string ImageCache::s_Directory = "cache/textures";
+
+static uint64_t HashBytes(const unsigned char *data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static std::string BlobPath(const std::string &path, bool flipY)
+{
+    uint64_t hash = HashBytes(reinterpret_cast<const unsigned char *>(path.data()), path.size());
+    const unsigned char flip = flipY ? 1 : 0;
+    hash = HashBytes(&flip, 1, hash);
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.img", static_cast<unsigned long long>(hash));
+    return (std::filesystem::path(ImageCache::GetDirectory()) / name).string();
+}
+
+static bool IsValidImage(const ImageCache::Image &image)
+{
+    return image.width > 0 && image.height > 0 && image.channels >= 1 && image.channels <= 4 &&
+           image.pixels.size() == size_t(image.width) * image.height * image.channels;
+}
+
+static bool ReadFile(const std::string &path, std::vector<unsigned char> &bytes)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return false;
+    bytes.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return file.good();
+}
+
+static bool Decode(const std::vector<unsigned char> &bytes, bool flipY, ImageCache::Image &out)
+{
+    int width, height, channels;
+    unsigned char *data = stbi_load_from_memory(bytes.data(), static_cast<int>(bytes.size()),
+                                                &width, &height, &channels, 0);
+    if (!data)
+        return false;
+
+    // Flip here instead of via stbi_set_flip_vertically_on_load(): that flag is global
+    const size_t stride = static_cast<size_t>(width) * static_cast<size_t>(channels);
+    out.pixels.resize(stride * static_cast<size_t>(height));
+    for (int y = 0; y < height; ++y)
+    {
+        const int srcY = flipY ? height - 1 - y : y;
+        std::memcpy(out.pixels.data() + y * stride, data + srcY * stride, stride);
+    }
+    out.width = width;
+    out.height = height;
+    out.channels = channels;
+    stbi_image_free(data);
+    return true;
+}
+
+static void WriteBlob(const std::string &blobPath, const ImageCacheHeader &header, const ImageCache::Image &image)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(blobPath).parent_path(), ec);
+
+    // Write to a temporary name so a crash or a concurrent reader never sees half a blob
+    const std::string tempPath = blobPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return;
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(image.pixels.data()),
+                   static_cast<std::streamsize>(image.pixels.size()));
+        if (!file.good())
+        {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, blobPath, ec);
+    if (ec)
+        std::filesystem::remove(tempPath, ec);
+}
+
+std::uint64_t ImageCache::HashParams(std::initializer_list<double> params)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (double value : params)
+        hash = HashBytes(reinterpret_cast<const unsigned char *>(&value), sizeof(value), hash);
+    return hash;
+}
+
+bool ImageCache::LoadGenerated(const std::string &name, std::uint64_t paramsHash,
+                               const std::function<void(Image &)> &generate, Image &out)
+{
+    if (s_Directory.empty())
+    {
+        generate(out);
+        return IsValidImage(out);
+    }
+
+    // Prefix keeps generator names from colliding with file paths
+    const std::string blobPath = BlobPath("generated:" + name, false);
+
+    MappedFile blob;
+    if (blob.Open(blobPath) && blob.GetSize() >= sizeof(ImageCacheHeader))
+    {
+        ImageCacheHeader header;
+        std::memcpy(&header, blob.GetData(), sizeof(header));
+        const bool valid = header.magic == IMAGE_CACHE_MAGIC && header.version == IMAGE_CACHE_VERSION &&
+                           header.flags == IMAGE_CACHE_GENERATED && header.contentHash == paramsHash &&
+                           header.width > 0 && header.height > 0 && header.channels >= 1 &&
+                           header.channels <= 4 &&
+                           header.pixelBytes == uint64_t(header.width) * header.height * header.channels &&
+                           header.pixelBytes <= blob.GetSize() - sizeof(header);
+        if (valid)
+        {
+            out.width = header.width;
+            out.height = header.height;
+            out.channels = header.channels;
+            out.pixels.assign(blob.GetData() + sizeof(header),
+                              blob.GetData() + sizeof(header) + header.pixelBytes);
+            return true;
+        }
+    }
+    blob.Close();
+
+    generate(out);
+    if (!IsValidImage(out))
+        return false;
+
+    ImageCacheHeader header{};
+    header.magic = IMAGE_CACHE_MAGIC;
+    header.version = IMAGE_CACHE_VERSION;
+    header.width = out.width;
+    header.height = out.height;
+    header.channels = out.channels;
+    header.flags = IMAGE_CACHE_GENERATED;
+    header.contentHash = paramsHash;
+    header.pixelBytes = out.pixels.size();
+    WriteBlob(blobPath, header, out);
+    return true;
+}
+
+void ImageCache::SetDirectory(const std::string &directory)
+{
+    s_Directory = directory;
+}
+
+bool ImageCache::Load(const std::string &path, bool flipY, Image &out)
+{
+    std::error_code ec;
+    const uint64_t sourceSize = std::filesystem::file_size(path, ec);
+    if (ec)
+        return false;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+        return false;
+    const int64_t sourceMtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+
+    if (s_Directory.empty())
+    {
+        std::vector<unsigned char> bytes;
+        return ReadFile(path, bytes) && Decode(bytes, flipY, out);
+    }
+
+    const std::string blobPath = BlobPath(path, flipY);
+    const uint32_t flags = flipY ? IMAGE_CACHE_FLIP_Y : 0;
+    std::vector<unsigned char> bytes;
+
+    MappedFile blob;
+    if (blob.Open(blobPath) && blob.GetSize() >= sizeof(ImageCacheHeader))
+    {
+        ImageCacheHeader header;
+        std::memcpy(&header, blob.GetData(), sizeof(header));
+        const bool valid = header.magic == IMAGE_CACHE_MAGIC && header.version == IMAGE_CACHE_VERSION &&
+                           header.flags == flags && header.sourceSize == sourceSize &&
+                           header.width > 0 && header.height > 0 && header.channels >= 1 &&
+                           header.channels <= 4 &&
+                           header.pixelBytes == uint64_t(header.width) * header.height * header.channels &&
+                           header.pixelBytes <= blob.GetSize() - sizeof(header);
+
+        const bool touched = valid && header.sourceMtime != sourceMtime;
+        if (valid && (!touched || (ReadFile(path, bytes) &&
+                                   HashBytes(bytes.data(), bytes.size()) == header.contentHash)))
+        {
+            out.width = header.width;
+            out.height = header.height;
+            out.channels = header.channels;
+            out.pixels.assign(blob.GetData() + sizeof(header),
+                              blob.GetData() + sizeof(header) + header.pixelBytes);
+            blob.Close();
+
+            if (touched)
+            {
+                // Unchanged content: remember the new mtime so the next launch skips the hash
+                header.sourceMtime = sourceMtime;
+                std::fstream file(blobPath, std::ios::binary | std::ios::in | std::ios::out);
+                if (file.is_open())
+                    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            }
+            return true;
+        }
+    }
+    blob.Close();
+
+    if ((bytes.empty() && !ReadFile(path, bytes)) || !Decode(bytes, flipY, out))
+        return false;
+
+    ImageCacheHeader header{};
+    header.magic = IMAGE_CACHE_MAGIC;
+    header.version = IMAGE_CACHE_VERSION;
+    header.width = out.width;
+    header.height = out.height;
+    header.channels = out.channels;
+    header.flags = flags;
+    header.sourceSize = sourceSize;
+    header.sourceMtime = sourceMtime;
+    header.contentHash = HashBytes(bytes.data(), bytes.size());
+    header.pixelBytes = out.pixels.size();
+    WriteBlob(blobPath, header, out);
+    return true;
+}
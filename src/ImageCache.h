@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/**
+ * @class ImageCache
+ * @brief On-disk cache of decoded image pixels, keyed by source file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * PNG decoding dominates cold start: every tileset, player and NPC sheet
+ * goes through zlib and filter reconstruction on each launch. Load() keeps
+ * the decoded, already-flipped pixels in one blob per source under the
+ * cache directory, so later launches read them with a single mapping.
+ *
+ * @par Blob Layout
+ * `<dir>/<fnv1a(path, flipY)>.img` holds a fixed header (format version,
+ * dimensions, source size, mtime and FNV-1a content hash) followed by
+ * `width * height * channels` bytes in upload order.
+ *
+ * @par Validation
+ * | Source vs. header              | Result                                   |
+ * |--------------------------------|------------------------------------------|
+ * | Same size and mtime            | Hit, source is not opened                |
+ * | Same size, other mtime         | Source is hashed; hit if the hash matches|
+ * | Otherwise / bad or missing blob| Decode, then rewrite the blob            |
+ *
+ * A content hit refreshes the stored mtime so a `git checkout` that touches
+ * files without changing them costs one hash per file, once.
+ *
+ * @par Generated Images
+ * LoadGenerated() stores procedural textures the same way, keyed by name.
+ * There is no source file: the blob is reused while its stored parameter
+ * hash (see HashParams()) matches the caller's, otherwise the generator
+ * runs and the blob is rewritten.
+ *
+ * @par Thread Safety
+ * Load() and LoadGenerated() are safe to call concurrently for different
+ * paths or names; Load() never touches stb_image's global flip flag.
+ * SetDirectory() must not race with either.
+ *
+ * @see Texture::LoadFromFile(), Tilemap::LoadCombinedTilesets()
+ */
+class ImageCache
+{
+public:
+    /// @brief Decoded pixels of one image.
+    struct Image
+    {
+        std::vector<unsigned char> pixels;  ///< Row-major, @c channels bytes per pixel
+        int width = 0;
+        int height = 0;
+        int channels = 0;  ///< As stored in the file (1-4)
+    };
+
+    /**
+     * @brief Decode @p path, going through the cache when possible.
+     *
+     * @param path  Image file to load.
+     * @param flipY Store rows bottom-up (OpenGL origin).
+     * @param out   Receives the pixels.
+     * @return `false` if the source cannot be read or decoded.
+     */
+    static bool Load(const std::string &path, bool flipY, Image &out);
+
+    /**
+     * @brief Load a procedural image, running @p generate only on a miss.
+     *
+     * @param name       Unique name of the generator (part of the blob key).
+     * @param paramsHash Hash of everything the pixels depend on; include a
+     *                   revision number and bump it when the generator changes.
+     * @param generate   Fills an Image; called at most once.
+     * @param out        Receives the pixels.
+     * @return `false` if the generator produced an empty image.
+     */
+    static bool LoadGenerated(const std::string &name, std::uint64_t paramsHash,
+                              const std::function<void(Image &)> &generate, Image &out);
+
+    /// @brief FNV-1a over the bytes of @p params, for LoadGenerated().
+    static std::uint64_t HashParams(std::initializer_list<double> params);
+
+    /**
+     * @brief Set the cache directory; an empty string disables caching.
+     *
+     * Defaults to `cache/textures`. The directory is created on first write.
+     */
+    static void SetDirectory(const std::string &directory);
+
+    /// @brief Current cache directory (empty if disabled).
+    static const std::string &GetDirectory() { return s_Directory; }
+
+private:
+    static std::string s_Directory;
+};
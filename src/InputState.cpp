@@ -0,0 +1,401 @@
+#include "InputState.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+constexpr std::uint8_t MAGIC[4] = {'W', 'I', 'N', 'P'};
+constexpr std::size_t FLUSH_BYTES = 64 * 1024;
+
+constexpr std::uint8_t FLAG_KEYS = 1 << 0;
+constexpr std::uint8_t FLAG_BUTTONS = 1 << 1;
+constexpr std::uint8_t FLAG_CURSOR = 1 << 2;
+constexpr std::uint8_t FLAG_SCROLL = 1 << 3;
+
+void AppendU16(std::vector<std::uint8_t> &out, std::uint16_t value)
+{
+    out.push_back(static_cast<std::uint8_t>(value));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void AppendU32(std::vector<std::uint8_t> &out, std::uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+}
+
+void AppendF32(std::vector<std::uint8_t> &out, float value)
+{
+    AppendU32(out, std::bit_cast<std::uint32_t>(value));
+}
+
+bool ReadU8(const std::uint8_t *&data, const std::uint8_t *end, std::uint8_t &value)
+{
+    if (end - data < 1)
+        return false;
+    value = *data++;
+    return true;
+}
+
+bool ReadU16(const std::uint8_t *&data, const std::uint8_t *end, std::uint16_t &value)
+{
+    if (end - data < 2)
+        return false;
+    value = static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+    data += 2;
+    return true;
+}
+
+bool ReadU32(const std::uint8_t *&data, const std::uint8_t *end, std::uint32_t &value)
+{
+    if (end - data < 4)
+        return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(data[i]) << (i * 8);
+    data += 4;
+    return true;
+}
+
+bool ReadF32(const std::uint8_t *&data, const std::uint8_t *end, float &value)
+{
+    std::uint32_t bits = 0;
+    if (!ReadU32(data, end, bits))
+        return false;
+    value = std::bit_cast<float>(bits);
+    return true;
+}
+
+/// Copy everything but the scroll events, which are per step and not delta-encoded
+void CopyHeldState(const InputState::Frame &from, InputState::Frame &to)
+{
+    to.keys = from.keys;
+    to.mouseButtons = from.mouseButtons;
+    to.cursorX = from.cursorX;
+    to.cursorY = from.cursorY;
+}
+}  // namespace
+
+InputState::~InputState()
+{
+    StopRecording();
+}
+
+void InputState::OnKey(int key, bool down)
+{
+    if (m_Replaying || key < 0 || key >= KEY_COUNT)
+        return;
+    m_Live.keys.set(static_cast<std::size_t>(key), down);
+}
+
+void InputState::OnMouseButton(int button, bool down)
+{
+    if (m_Replaying || button < 0 || button >= MOUSE_BUTTON_COUNT)
+        return;
+    const std::uint8_t bit = static_cast<std::uint8_t>(1u << button);
+    m_Live.mouseButtons = down ? (m_Live.mouseButtons | bit) : (m_Live.mouseButtons & ~bit);
+}
+
+void InputState::OnCursorPos(double x, double y)
+{
+    if (m_Replaying)
+        return;
+    m_LiveCursorX = x;
+    m_LiveCursorY = y;
+}
+
+void InputState::OnScroll(double yoffset)
+{
+    if (m_Replaying)
+        return;
+    m_Live.scroll.push_back(static_cast<float>(yoffset));
+}
+
+void InputState::ReleaseAll()
+{
+    if (m_Replaying)
+        return;
+    m_Live.keys.reset();
+    m_Live.mouseButtons = 0;
+}
+
+bool InputState::Advance()
+{
+    if (m_Replaying)
+    {
+        const std::uint8_t *data = m_ReplayData.data() + m_ReplayOffset;
+        const std::uint8_t *end = m_ReplayData.data() + m_ReplayData.size();
+        if (data == end)
+        {
+            m_Current.scroll.clear();
+            return false;
+        }
+        // Checked by StartReplay()
+        DecodeFrame(data, end, m_Current);
+        m_ReplayOffset = static_cast<std::size_t>(data - m_ReplayData.data());
+        ++m_StepIndex;
+        return true;
+    }
+
+    m_Current.keys = m_Live.keys;
+    m_Current.mouseButtons = m_Live.mouseButtons;
+    m_Current.cursorX = static_cast<float>(m_LiveCursorX);
+    m_Current.cursorY = static_cast<float>(m_LiveCursorY);
+    m_Current.scroll.swap(m_Live.scroll);
+    m_Live.scroll.clear();
+
+    if (m_Recording)
+    {
+        EncodeFrame(m_Previous, m_Current, m_LogBuffer);
+        CopyHeldState(m_Current, m_Previous);
+        ++m_StepIndex;
+        if (m_LogBuffer.size() >= FLUSH_BYTES)
+            FlushRecording();
+    }
+    return true;
+}
+
+bool InputState::IsKeyDown(int key) const
+{
+    return key >= 0 && key < KEY_COUNT && m_Current.keys.test(static_cast<std::size_t>(key));
+}
+
+bool InputState::IsMouseButtonDown(int button) const
+{
+    return button >= 0 && button < MOUSE_BUTTON_COUNT && (m_Current.mouseButtons & (1u << button)) != 0;
+}
+
+void InputState::GetCursorPos(double &x, double &y) const
+{
+    x = m_Current.cursorX;
+    y = m_Current.cursorY;
+}
+
+bool InputState::StartRecording(const std::string &path, const LogHeader &header)
+{
+    if (m_Replaying)
+    {
+        std::cerr << "Can't record input while replaying" << std::endl;
+        return false;
+    }
+    StopRecording();
+
+    m_LogFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_LogFile.is_open())
+    {
+        std::cerr << "Failed to create input log: " << path << std::endl;
+        return false;
+    }
+
+    m_Header = header;
+    m_LogBuffer.clear();
+    EncodeHeader(m_Header, m_LogBuffer);
+    // The first record is relative to a frame with nothing held
+    m_Previous = Frame{};
+    m_StepIndex = 0;
+    m_Recording = true;
+    return true;
+}
+
+bool InputState::StopRecording()
+{
+    if (!m_Recording)
+        return true;
+    const bool ok = FlushRecording();
+    m_LogFile.close();
+    m_Recording = false;
+    return ok && !m_LogFile.fail();
+}
+
+bool InputState::FlushRecording()
+{
+    m_LogFile.write(reinterpret_cast<const char *>(m_LogBuffer.data()),
+                    static_cast<std::streamsize>(m_LogBuffer.size()));
+    m_LogBuffer.clear();
+    if (!m_LogFile)
+    {
+        std::cerr << "Failed to write input log" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputState::StartReplay(const std::string &path)
+{
+    StopRecording();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Failed to open input log: " << path << std::endl;
+        return false;
+    }
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const std::uint8_t *cursor = data.data();
+    const std::uint8_t *end = data.data() + data.size();
+    LogHeader header;
+    if (!DecodeHeader(cursor, end, header))
+    {
+        std::cerr << "Not an input log (or a different version): " << path << std::endl;
+        return false;
+    }
+    const std::size_t firstStep = static_cast<std::size_t>(cursor - data.data());
+
+    // Decode once to validate and count, so Advance() can trust the data
+    Frame frame;
+    std::size_t steps = 0;
+    while (cursor != end)
+    {
+        if (!DecodeFrame(cursor, end, frame))
+        {
+            std::cerr << "Input log " << path << " is corrupt after step " << steps << std::endl;
+            return false;
+        }
+        ++steps;
+    }
+
+    m_Header = header;
+    m_ReplayData = std::move(data);
+    m_ReplayOffset = firstStep;
+    m_ReplaySteps = steps;
+    m_StepIndex = 0;
+    m_Current = Frame{};
+    m_Replaying = true;
+    return true;
+}
+
+void InputState::StopReplay()
+{
+    m_Replaying = false;
+    m_ReplayData.clear();
+    m_ReplayData.shrink_to_fit();
+    m_ReplayOffset = 0;
+    m_ReplaySteps = 0;
+}
+
+void InputState::EncodeHeader(const LogHeader &header, std::vector<std::uint8_t> &out)
+{
+    out.insert(out.end(), std::begin(MAGIC), std::end(MAGIC));
+    AppendU32(out, LOG_VERSION);
+    AppendU32(out, header.seed);
+    AppendF32(out, header.step);
+    AppendF32(out, header.timeOfDay);
+    AppendF32(out, header.timeScale);
+    AppendU32(out, static_cast<std::uint32_t>(header.windowWidth));
+    AppendU32(out, static_cast<std::uint32_t>(header.windowHeight));
+}
+
+bool InputState::DecodeHeader(const std::uint8_t *&data, const std::uint8_t *end, LogHeader &header)
+{
+    if (end - data < static_cast<std::ptrdiff_t>(sizeof(MAGIC)) || !std::equal(std::begin(MAGIC), std::end(MAGIC), data))
+        return false;
+    const std::uint8_t *cursor = data + sizeof(MAGIC);
+
+    std::uint32_t version = 0;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    LogHeader decoded;
+    if (!ReadU32(cursor, end, version) || version != LOG_VERSION || !ReadU32(cursor, end, decoded.seed) ||
+        !ReadF32(cursor, end, decoded.step) || !ReadF32(cursor, end, decoded.timeOfDay) ||
+        !ReadF32(cursor, end, decoded.timeScale) || !ReadU32(cursor, end, width) || !ReadU32(cursor, end, height))
+    {
+        return false;
+    }
+    if (!(decoded.step > 0.0f))
+        return false;
+    decoded.windowWidth = static_cast<std::int32_t>(width);
+    decoded.windowHeight = static_cast<std::int32_t>(height);
+
+    header = decoded;
+    data = cursor;
+    return true;
+}
+
+void InputState::EncodeFrame(const Frame &previous, const Frame &frame, std::vector<std::uint8_t> &out)
+{
+    const std::bitset<KEY_COUNT> changed = previous.keys ^ frame.keys;
+    const bool cursorMoved = previous.cursorX != frame.cursorX || previous.cursorY != frame.cursorY;
+
+    std::uint8_t flags = 0;
+    if (changed.any())
+        flags |= FLAG_KEYS;
+    if (previous.mouseButtons != frame.mouseButtons)
+        flags |= FLAG_BUTTONS;
+    if (cursorMoved)
+        flags |= FLAG_CURSOR;
+    if (!frame.scroll.empty())
+        flags |= FLAG_SCROLL;
+    out.push_back(flags);
+
+    if (flags & FLAG_KEYS)
+    {
+        AppendU16(out, static_cast<std::uint16_t>(changed.count()));
+        for (int key = 0; key < KEY_COUNT; ++key)
+        {
+            if (changed.test(static_cast<std::size_t>(key)))
+                AppendU16(out, static_cast<std::uint16_t>(key));
+        }
+    }
+    if (flags & FLAG_BUTTONS)
+        out.push_back(frame.mouseButtons);
+    if (flags & FLAG_CURSOR)
+    {
+        AppendF32(out, frame.cursorX);
+        AppendF32(out, frame.cursorY);
+    }
+    if (flags & FLAG_SCROLL)
+    {
+        // More than 255 wheel events in one step is not a real session; the rest are dropped
+        const std::size_t count = std::min<std::size_t>(frame.scroll.size(), 255);
+        out.push_back(static_cast<std::uint8_t>(count));
+        for (std::size_t i = 0; i < count; ++i)
+            AppendF32(out, frame.scroll[i]);
+    }
+}
+
+bool InputState::DecodeFrame(const std::uint8_t *&data, const std::uint8_t *end, Frame &frame)
+{
+    const std::uint8_t *cursor = data;
+    std::uint8_t flags = 0;
+    if (!ReadU8(cursor, end, flags) || (flags & ~(FLAG_KEYS | FLAG_BUTTONS | FLAG_CURSOR | FLAG_SCROLL)) != 0)
+        return false;
+
+    frame.scroll.clear();
+    if (flags & FLAG_KEYS)
+    {
+        std::uint16_t count = 0;
+        if (!ReadU16(cursor, end, count))
+            return false;
+        for (std::uint16_t i = 0; i < count; ++i)
+        {
+            std::uint16_t key = 0;
+            if (!ReadU16(cursor, end, key) || key >= KEY_COUNT)
+                return false;
+            frame.keys.flip(key);
+        }
+    }
+    if ((flags & FLAG_BUTTONS) && !ReadU8(cursor, end, frame.mouseButtons))
+        return false;
+    if ((flags & FLAG_CURSOR) && (!ReadF32(cursor, end, frame.cursorX) || !ReadF32(cursor, end, frame.cursorY)))
+        return false;
+    if (flags & FLAG_SCROLL)
+    {
+        std::uint8_t count = 0;
+        if (!ReadU8(cursor, end, count))
+            return false;
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            float offset = 0.0f;
+            if (!ReadF32(cursor, end, offset))
+                return false;
+            frame.scroll.push_back(offset);
+        }
+    }
+
+    data = cursor;
+    return true;
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class InputState
+ * @brief Per-step keyboard and mouse state that can be recorded and replayed.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Input
+ *
+ * GLFW callbacks feed the live state through the On*() methods. Advance()
+ * latches it once per simulation step, and game and editor code read only
+ * the latched state, so all input a step sees is in one place:
+ *
+ * @code{.cpp}
+ * input.Advance();
+ * if (input.IsKeyDown(GLFW_KEY_W))
+ *     MoveUp(step);
+ * @endcode
+ *
+ * @par Recording and Replay
+ * While recording, every Advance() appends the latched step to a binary
+ * log. While replaying, Advance() reads the next step from a log instead
+ * and live events are ignored. The log also stores what else the
+ * simulation needs to repeat itself (RNG seed, step length, clock), see
+ * LogHeader.
+ *
+ * @par Log Format
+ * A fixed header followed by one record per step, little-endian:
+ * - flags byte: bit 0 keys changed, bit 1 mouse buttons changed,
+ *   bit 2 cursor moved, bit 3 scroll events
+ * - keys: u16 count, then u16 key codes whose state flipped
+ * - mouse buttons: u8 bitmask
+ * - cursor: f32 x, f32 y
+ * - scroll: u8 count, then f32 vertical offsets
+ *
+ * A step without changes costs one byte; a ten minute session at 60 Hz is
+ * typically a few hundred KB.
+ *
+ * @par Precision
+ * The cursor and scroll offsets are stored as float. The latched state is
+ * rounded the same way during live play, so a recorded session
+ * saw exactly the values its replay will.
+ *
+ * @par Thread Safety
+ * Not thread-safe; use from the main thread.
+ *
+ * @see Game::StartInputRecording(), Game::RunReplay()
+ */
+class InputState
+{
+public:
+    static constexpr int KEY_COUNT = 349;          ///< GLFW_KEY_LAST + 1
+    static constexpr int MOUSE_BUTTON_COUNT = 8;   ///< GLFW_MOUSE_BUTTON_LAST + 1
+    static constexpr std::uint32_t LOG_VERSION = 1;
+
+    /// @brief One step of input.
+    struct Frame
+    {
+        std::bitset<KEY_COUNT> keys;
+        std::uint8_t mouseButtons = 0;  ///< Bit n = mouse button n held
+        float cursorX = 0.0f;           ///< Window coordinates
+        float cursorY = 0.0f;
+        std::vector<float> scroll;      ///< Vertical wheel offsets received during the step
+    };
+
+    /// @brief Simulation settings stored at the start of a log.
+    struct LogHeader
+    {
+        std::uint32_t seed = 1;            ///< Particle, NPC and editor RNG seed
+        float step = 1.0f / 60.0f;         ///< Fixed step length in seconds
+        float timeOfDay = 12.0f;           ///< Clock at the first step (hours)
+        float timeScale = 1.0f;            ///< Clock speed at the first step
+        std::int32_t windowWidth = 0;      ///< Window size the cursor coordinates refer to
+        std::int32_t windowHeight = 0;
+    };
+
+    InputState() = default;
+    ~InputState();
+
+    InputState(const InputState &) = delete;
+    InputState &operator=(const InputState &) = delete;
+
+    /// @name Live Events
+    /// Called from the GLFW callbacks; ignored while replaying.
+    /// @{
+    void OnKey(int key, bool down);
+    void OnMouseButton(int button, bool down);
+    void OnCursorPos(double x, double y);
+    void OnScroll(double yoffset);
+
+    /// @brief Release all held keys and buttons, e.g. when the window is recreated.
+    void ReleaseAll();
+    /// @}
+
+    /**
+     * @brief Latch the input for the next simulation step.
+     *
+     * Takes the live state (and the scroll events since the last call), or
+     * the next step of the log when replaying. Recording appends the
+     * latched step to the log.
+     *
+     * @return false when a replay has run out of steps; the state is then
+     *         the last replayed step without scroll events.
+     */
+    bool Advance();
+
+    /// @name Latched State
+    /// @{
+    [[nodiscard]] bool IsKeyDown(int key) const;
+    [[nodiscard]] bool IsMouseButtonDown(int button) const;
+    void GetCursorPos(double &x, double &y) const;
+    [[nodiscard]] const std::vector<float> &GetScrollEvents() const { return m_Current.scroll; }
+    [[nodiscard]] const Frame &GetFrame() const { return m_Current; }
+    /// @}
+
+    /**
+     * @brief Start writing every latched step to @p path.
+     * @return false if a replay is running or the file can't be created.
+     */
+    bool StartRecording(const std::string &path, const LogHeader &header);
+
+    /**
+     * @brief Write the remaining steps and close the log; no-op when not recording.
+     * @return false if writing failed.
+     */
+    bool StopRecording();
+
+    /**
+     * @brief Load a log and replay it from the first step.
+     *
+     * The whole log is read and checked up front, so a truncated or
+     * corrupt file fails here rather than halfway through a run.
+     *
+     * @return false if the file can't be read or is not a valid log.
+     */
+    bool StartReplay(const std::string &path);
+
+    /// @brief Return to live input.
+    void StopReplay();
+
+    [[nodiscard]] bool IsRecording() const { return m_Recording; }
+    [[nodiscard]] bool IsReplaying() const { return m_Replaying; }
+
+    /// @brief Header of the log being recorded or replayed.
+    [[nodiscard]] const LogHeader &GetLogHeader() const { return m_Header; }
+
+    /// @brief Steps latched since recording or replay started.
+    [[nodiscard]] std::size_t GetStepIndex() const { return m_StepIndex; }
+
+    /// @brief Steps in the replayed log.
+    [[nodiscard]] std::size_t GetReplayStepCount() const { return m_ReplaySteps; }
+
+    /// @name Encoding
+    /// @{
+    static void EncodeHeader(const LogHeader &header, std::vector<std::uint8_t> &out);
+
+    /// @return false if @p data does not start with a header of this version.
+    static bool DecodeHeader(const std::uint8_t *&data, const std::uint8_t *end, LogHeader &header);
+
+    /// @brief Append the changes from @p previous to @p frame.
+    static void EncodeFrame(const Frame &previous, const Frame &frame, std::vector<std::uint8_t> &out);
+
+    /**
+     * @brief Apply the next step record onto @p frame (the previous step).
+     * @return false if the record is truncated or names an unknown key.
+     */
+    static bool DecodeFrame(const std::uint8_t *&data, const std::uint8_t *end, Frame &frame);
+    /// @}
+
+private:
+    bool FlushRecording();
+
+    Frame m_Live;              ///< State built by the On*() events
+    Frame m_Current;           ///< State latched by the last Advance()
+    Frame m_Previous;          ///< Step before m_Current, the base of the next record
+    double m_LiveCursorX = 0.0;
+    double m_LiveCursorY = 0.0;
+
+    LogHeader m_Header;
+    std::size_t m_StepIndex = 0;
+
+    bool m_Recording = false;
+    std::ofstream m_LogFile;
+    std::vector<std::uint8_t> m_LogBuffer;  ///< Encoded steps not yet written
+
+    bool m_Replaying = false;
+    std::vector<std::uint8_t> m_ReplayData;
+    std::size_t m_ReplayOffset = 0;
+    std::size_t m_ReplaySteps = 0;
+};
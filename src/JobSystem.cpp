@@ -0,0 +1,110 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+unsigned JobSystem::DefaultWorkerCount()
+{
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+    m_Workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        m_Workers.emplace_back(&JobSystem::WorkerMain, this);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WakeWorkers.notify_all();
+    for (auto &worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &fn)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    // Nothing to share: skip the wake-up round trip entirely
+    if (m_Workers.empty() || count <= grainSize)
+    {
+        fn(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(m_SubmitMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Task = &fn;
+        m_Count = count;
+        m_Grain = grainSize;
+        m_ChunkCount = (count + grainSize - 1) / grainSize;
+        m_NextChunk.store(0, std::memory_order_relaxed);
+        m_BusyWorkers = static_cast<unsigned>(m_Workers.size());
+        ++m_JobId;
+    }
+    m_WakeWorkers.notify_all();
+
+    RunChunks();
+
+    // fn lives on the caller's stack, so wait until no worker can still be inside it
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_JobDone.wait(lock, [this] { return m_BusyWorkers == 0; });
+    m_Task = nullptr;
+}
+
+void JobSystem::RunChunks()
+{
+    for (;;)
+    {
+        size_t chunk = m_NextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= m_ChunkCount)
+        {
+            return;
+        }
+        size_t begin = chunk * m_Grain;
+        size_t end = std::min(begin + m_Grain, m_Count);
+        WILD_PROFILE_ZONE("Job Chunk");
+        (*m_Task)(begin, end);
+    }
+}
+
+void JobSystem::WorkerMain()
+{
+    WILD_PROFILE_THREAD("Job Worker");
+    std::uint64_t seenJob = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WakeWorkers.wait(lock, [&] { return m_Stop || m_JobId != seenJob; });
+            if (m_Stop)
+            {
+                return;
+            }
+            seenJob = m_JobId;
+        }
+
+        RunChunks();
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (--m_BusyWorkers == 0)
+        {
+            m_JobDone.notify_one();
+        }
+    }
+}
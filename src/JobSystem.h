@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief Fixed pool of worker threads for splitting per-frame loops into chunks.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Workers are started once and sleep between jobs, so a parallel loop costs
+ * a wake-up rather than thread creation. ParallelFor() cuts [0, count) into
+ * chunks of @p grainSize items; workers and the calling thread pull chunks
+ * until none are left, and the call returns when every chunk is done.
+ *
+ * @par Small Loops
+ * A loop that fits in one chunk, or a pool without workers, runs inline on
+ * the calling thread, so small maps pay nothing for the pool.
+ *
+ * @par Chunk Rules
+ * - The function may be called concurrently for different chunks; it must
+ *   only write state owned by the items of its chunk.
+ * - Which thread runs a chunk is unspecified. Results must not depend on it.
+ * - Do not call ParallelFor() from inside a chunk.
+ * - The function must not throw.
+ *
+ * @par Example
+ * @code{.cpp}
+ * jobs.ParallelFor(npcs.size(), 64, [&](size_t begin, size_t end)
+ * {
+ *     for (size_t i = begin; i < end; ++i)
+ *         npcs[i].Update(dt, &tilemap, &playerPos);
+ * });
+ * @endcode
+ *
+ * @par Thread Safety
+ * ParallelFor() may be called from any thread; concurrent calls run one
+ * after the other.
+ */
+class JobSystem
+{
+public:
+    /// @brief Workers used by default: one per hardware thread besides the caller.
+    static unsigned DefaultWorkerCount();
+
+    /// @brief Start @p workerCount worker threads (0 = run every job inline).
+    explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    /// @brief Number of worker threads (the caller also runs chunks).
+    [[nodiscard]] unsigned GetWorkerCount() const { return static_cast<unsigned>(m_Workers.size()); }
+
+    /**
+     * @brief Run @p fn(begin, end) over [0, @p count) in chunks of @p grainSize items.
+     *
+     * Blocks until every chunk has finished.
+     *
+     * @param count     Number of items.
+     * @param grainSize Items per chunk (clamped to at least 1).
+     * @param fn        Called once per chunk with a half-open item range.
+     */
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &fn);
+
+private:
+    void WorkerMain();
+    void RunChunks();
+
+    std::vector<std::thread> m_Workers;
+    std::mutex m_SubmitMutex;  ///< Serializes ParallelFor() callers
+
+    /// @name Current Job
+    /// @{
+    std::mutex m_Mutex;                  ///< Guards the job fields and m_Stop
+    std::condition_variable m_WakeWorkers;
+    std::condition_variable m_JobDone;
+    const std::function<void(size_t, size_t)> *m_Task = nullptr;
+    size_t m_Count = 0;
+    size_t m_Grain = 1;
+    size_t m_ChunkCount = 0;
+    std::atomic<size_t> m_NextChunk{0};
+    std::uint64_t m_JobId = 0;           ///< Bumped per job so workers join each job once
+    unsigned m_BusyWorkers = 0;          ///< Workers that have not finished the current job
+    bool m_Stop = false;
+    /// @}
+};
@@ -0,0 +1,176 @@
+#include "MapRegion.h"
+
+#include <fstream>
+#include <iostream>
+#include <json.hpp>
+
+using json = nlohmann::json;
+
+// Pairs are stored flat ([index, value, index, value, ...]) to keep region
+// files compact and parsing free of per-entry object allocations
+template<typename A, typename B>
+static json FlattenPairs(const std::vector<std::pair<A, B>> &pairs)
+{
+    json arr = json::array();
+    for (const auto &[a, b] : pairs)
+    {
+        arr.push_back(a);
+        arr.push_back(b);
+    }
+    return arr;
+}
+
+template<typename A, typename B>
+static void ReadPairs(const json &j, const char *key, std::vector<std::pair<A, B>> &out)
+{
+    out.clear();
+    if (!j.contains(key) || !j[key].is_array())
+        return;
+    const json &arr = j[key];
+    out.reserve(arr.size() / 2);
+    for (size_t i = 0; i + 1 < arr.size(); i += 2)
+    {
+        out.emplace_back(arr[i].get<A>(), arr[i + 1].get<B>());
+    }
+}
+
+static void ReadIndices(const json &j, const char *key, std::vector<uint32_t> &out)
+{
+    out.clear();
+    if (j.contains(key) && j[key].is_array())
+        out = j[key].get<std::vector<uint32_t>>();
+}
+
+bool MapRegion::IsEmpty() const
+{
+    for (const Layer &layer : layers)
+    {
+        if (!layer.cells.empty() || !layer.structureIds.empty())
+            return false;
+    }
+    return collision.empty() && navigation.empty() && elevation.empty() && cornerCutBlocked.empty() &&
+           particleZones.empty() && (npcs.empty() || npcs == "[]");
+}
+
+bool MapRegion::Read(const std::string &path, MapRegion &out)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR: Could not open region file: " << path << std::endl;
+        return false;
+    }
+
+    try
+    {
+        json j;
+        file >> j;
+
+        out.regionX = j.value("regionX", 0);
+        out.regionY = j.value("regionY", 0);
+        out.originX = j.value("x", 0);
+        out.originY = j.value("y", 0);
+        out.width = j.value("width", 0);
+        out.height = j.value("height", 0);
+
+        out.layers.clear();
+        if (j.contains("layers") && j["layers"].is_array())
+        {
+            for (const auto &layerJson : j["layers"])
+            {
+                Layer layer;
+                ReadPairs(layerJson, "cells", layer.cells);
+                ReadPairs(layerJson, "structureId", layer.structureIds);
+                out.layers.push_back(std::move(layer));
+            }
+        }
+
+        ReadIndices(j, "collision", out.collision);
+        ReadIndices(j, "navigation", out.navigation);
+        ReadPairs(j, "elevation", out.elevation);
+        ReadPairs(j, "cornerCutBlocked", out.cornerCutBlocked);
+
+        out.particleZones.clear();
+        if (j.contains("particleZones") && j["particleZones"].is_array())
+        {
+            for (const auto &zoneJson : j["particleZones"])
+            {
+                ParticleZone zone;
+                zone.position.x = zoneJson.value("x", 0.0f);
+                zone.position.y = zoneJson.value("y", 0.0f);
+                zone.size.x = zoneJson.value("width", 32.0f);
+                zone.size.y = zoneJson.value("height", 32.0f);
+                zone.type = static_cast<ParticleType>(zoneJson.value("type", 0));
+                zone.enabled = zoneJson.value("enabled", true);
+                zone.noProjection = zoneJson.value("noProjection", false);
+                out.particleZones.push_back(zone);
+            }
+        }
+
+        out.npcs = (j.contains("npcs") && j["npcs"].is_array()) ? j["npcs"].dump() : std::string();
+    }
+    catch (const json::exception &e)
+    {
+        std::cerr << "ERROR: Failed to parse region file " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    if (out.width <= 0 || out.height <= 0)
+    {
+        std::cerr << "ERROR: Invalid region dimensions in " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MapRegion::Write(const std::string &path) const
+{
+    json j;
+    j["regionX"] = regionX;
+    j["regionY"] = regionY;
+    j["x"] = originX;
+    j["y"] = originY;
+    j["width"] = width;
+    j["height"] = height;
+
+    json layersArr = json::array();
+    for (const Layer &layer : layers)
+    {
+        json layerJson;
+        layerJson["cells"] = FlattenPairs(layer.cells);
+        if (!layer.structureIds.empty())
+            layerJson["structureId"] = FlattenPairs(layer.structureIds);
+        layersArr.push_back(layerJson);
+    }
+    j["layers"] = layersArr;
+
+    j["collision"] = collision;
+    j["navigation"] = navigation;
+    j["elevation"] = FlattenPairs(elevation);
+    j["cornerCutBlocked"] = FlattenPairs(cornerCutBlocked);
+
+    json zonesArr = json::array();
+    for (const ParticleZone &zone : particleZones)
+    {
+        json zoneJson;
+        zoneJson["x"] = zone.position.x;
+        zoneJson["y"] = zone.position.y;
+        zoneJson["width"] = zone.size.x;
+        zoneJson["height"] = zone.size.y;
+        zoneJson["type"] = static_cast<int>(zone.type);
+        zoneJson["enabled"] = zone.enabled;
+        zoneJson["noProjection"] = zone.noProjection;
+        zonesArr.push_back(zoneJson);
+    }
+    j["particleZones"] = zonesArr;
+    j["npcs"] = npcs.empty() ? json::array() : json::parse(npcs);
+
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR: Could not open region file for writing: " << path << std::endl;
+        return false;
+    }
+    file << j.dump();
+    return file.good();
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ParticleSystem.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct MapRegion
+ * @brief Content of one square block of a streamed world.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * A streamed world is split into regionSize x regionSize tile blocks, each
+ * stored in its own file next to a world manifest (see WorldManifest). A
+ * MapRegion is the plain-data form of one such file: it can be parsed on a
+ * background thread and later applied to the Tilemap on the main thread.
+ *
+ * All per-tile data is sparse and uses region-local row-major indices
+ * (`index = localY * width + localX`), so a region can be applied without
+ * knowing the size of the world it came from.
+ *
+ * @par File Format
+ * @code{.json}
+ * {
+ *   "regionX": 1, "regionY": 0, "x": 64, "y": 0, "width": 64, "height": 64,
+ *   "layers": [ { "cells": [index, bits, ...], "structureId": [index, id, ...] }, ... ],
+ *   "collision": [index, ...],
+ *   "navigation": [index, ...],
+ *   "elevation": [index, value, ...],
+ *   "cornerCutBlocked": [index, mask, ...],
+ *   "particleZones": [ { "x": 1040, "y": 96, "width": 32, "height": 32, "type": 0 }, ... ],
+ *   "npcs": [ same objects as the save.json "npcs" array ]
+ * }
+ * @endcode
+ *
+ * @see WorldManifest, WorldStreamer, Tilemap::ApplyRegion()
+ */
+struct MapRegion
+{
+    /// @brief Non-empty cells and structure IDs of one tile layer.
+    struct Layer
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> cells;        ///< (local index, PackedTile::bits)
+        std::vector<std::pair<uint32_t, int32_t>> structureIds;  ///< (local index, structure ID)
+    };
+
+    int regionX = 0;  ///< Region column in the region grid
+    int regionY = 0;  ///< Region row in the region grid
+    int originX = 0;  ///< First tile column covered
+    int originY = 0;  ///< First tile row covered
+    int width = 0;    ///< Tiles covered horizontally (edge regions may be narrower)
+    int height = 0;   ///< Tiles covered vertically (edge regions may be shorter)
+
+    std::vector<Layer> layers;                                ///< One entry per tile layer
+    std::vector<uint32_t> collision;                          ///< Local indices of blocked tiles
+    std::vector<uint32_t> navigation;                         ///< Local indices of NPC-walkable tiles
+    std::vector<std::pair<uint32_t, int>> elevation;          ///< (local index, elevation), non-zero only
+    std::vector<std::pair<uint32_t, uint8_t>> cornerCutBlocked; ///< (local index, corner mask), non-zero only
+    std::vector<ParticleZone> particleZones;                  ///< Zones whose top-left corner lies in the region
+    std::string npcs;                                         ///< NPC array as JSON text (parsed on apply)
+
+    /// @brief `true` if the region holds no data at all (no file needs to be written).
+    bool IsEmpty() const;
+
+    /**
+     * @brief Parse a region file.
+     *
+     * Safe to call from any thread; touches nothing but @p out.
+     *
+     * @param path Region file path.
+     * @param out  Filled on success.
+     * @return `true` if the file was read and parsed.
+     */
+    static bool Read(const std::string &path, MapRegion &out);
+
+    /**
+     * @brief Write this region to a file.
+     * @param path Region file path.
+     * @return `true` if written successfully.
+     */
+    bool Write(const std::string &path) const;
+};
+
+/**
+ * @struct WorldManifest
+ * @brief Layout of a streamed world directory.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * A world directory holds `world.json` (map dimensions, layer definitions,
+ * animation and structure tables, player spawn and the list of non-empty
+ * regions) plus one `region_<x>_<y>.json` file per non-empty region.
+ *
+ * @see Tilemap::LoadWorldManifest(), Tilemap::SaveWorldManifest()
+ */
+struct WorldManifest
+{
+    static constexpr const char *MANIFEST_FILE = "world.json";
+
+    std::string directory;          ///< World directory (no trailing separator)
+    int regionSize = 0;             ///< Region edge length in tiles (multiple of Tilemap::CHUNK_SIZE)
+    int regionsX = 0;               ///< Region grid width
+    int regionsY = 0;               ///< Region grid height
+    std::vector<uint8_t> present;   ///< Row-major, 1 if the region has a file
+
+    /// @brief `true` if region (@p regionX, @p regionY) is inside the grid and has a file.
+    bool HasRegion(int regionX, int regionY) const
+    {
+        if (regionX < 0 || regionX >= regionsX || regionY < 0 || regionY >= regionsY)
+            return false;
+        return present[static_cast<size_t>(regionY) * regionsX + regionX] != 0;
+    }
+
+    /// @brief Path of the manifest file.
+    std::string GetManifestPath() const { return directory + "/" + MANIFEST_FILE; }
+
+    /// @brief Path of the file for region (@p regionX, @p regionY).
+    std::string GetRegionPath(int regionX, int regionY) const
+    {
+        return directory + "/region_" + std::to_string(regionX) + "_" + std::to_string(regionY) + ".json";
+    }
+};
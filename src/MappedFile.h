@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Thin RAII wrapper over `CreateFileMapping`/`MapViewOfFile` on Windows and
+ * `mmap` elsewhere. Pages are faulted in by the OS on first access, so
+ * opening a large file is cheap and only the parts that get read cost I/O.
+ *
+ * @par Lifetime
+ * Pointers returned by GetData() stay valid until Close() or destruction.
+ * The wrapper is move-only.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Map @p path read-only, replacing any previous mapping.
+     * @return `true` on success; empty files fail to map.
+     */
+    bool Open(const std::string &path);
+
+    /// @brief Unmap and close the file.
+    void Close();
+
+    /// @brief `true` while a file is mapped.
+    bool IsOpen() const { return m_Data != nullptr; }
+
+    /// @brief First byte of the mapping, or nullptr.
+    const uint8_t *GetData() const { return m_Data; }
+
+    /// @brief Mapped size in bytes.
+    size_t GetSize() const { return m_Size; }
+
+private:
+    const uint8_t *m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void *m_File = nullptr;     ///< HANDLE from CreateFile
+    void *m_Mapping = nullptr;  ///< HANDLE from CreateFileMapping
+#else
+    int m_Fd = -1;
+#endif
+};
@@ -0,0 +1,69 @@
+#include "MemoryTracker.h"
+#include "Texture.h"
+
+namespace
+{
+std::array<std::size_t, MemoryTracker::SUBSYSTEM_COUNT> s_CpuBytes{};
+
+std::size_t Index(MemoryTracker::Subsystem subsystem)
+{
+    const std::size_t index = static_cast<std::size_t>(subsystem);
+    return index < MemoryTracker::SUBSYSTEM_COUNT ? index : static_cast<std::size_t>(MemoryTracker::Subsystem::Other);
+}
+}  // namespace
+
+void MemoryTracker::SetCpuBytes(Subsystem subsystem, std::size_t bytes)
+{
+    s_CpuBytes[Index(subsystem)] = bytes;
+}
+
+MemoryTracker::Report MemoryTracker::Collect()
+{
+    Report report{};
+    for (std::size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        report[i].cpuBytes = s_CpuBytes[i];
+    }
+
+    for (const Texture *texture : Texture::GetUploadedTextures())
+    {
+        Usage &usage = report[Index(texture->GetMemoryTag())];
+        usage.cpuBytes += texture->GetCpuBytes();
+        usage.gpuBytes += texture->GetGpuBytes();
+    }
+    return report;
+}
+
+MemoryTracker::Usage MemoryTracker::GetTotal(const Report &report)
+{
+    Usage total;
+    for (const Usage &usage : report)
+    {
+        total.cpuBytes += usage.cpuBytes;
+        total.gpuBytes += usage.gpuBytes;
+    }
+    return total;
+}
+
+const char *MemoryTracker::GetName(Subsystem subsystem)
+{
+    switch (subsystem)
+    {
+        case Subsystem::Tilemap:
+            return "Tilemap";
+        case Subsystem::Tileset:
+            return "Tileset";
+        case Subsystem::Characters:
+            return "Characters";
+        case Subsystem::Particles:
+            return "Particles";
+        case Subsystem::Sky:
+            return "Sky";
+        case Subsystem::Editor:
+            return "Editor";
+        case Subsystem::Other:
+        case Subsystem::Count:
+            break;
+    }
+    return "Other";
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class MemoryTracker
+ * @brief CPU and GPU bytes per engine subsystem.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Core
+ *
+ * Texture::GetOpenGLTextureBytes() and AllocationCounter say how much memory
+ * is in use, not who holds it. The tracker splits it by subsystem from two
+ * sources:
+ *
+ * @code
+ *   SetCpuBytes(Tilemap, m_Tilemap.GetMemoryBytes())     owned containers, reported by owners
+ *   Texture::SetMemoryTag(Tileset)                         textures, charged to their tag
+ *                          \                /
+ *                         Collect() --> Report[Subsystem] = {cpuBytes, gpuBytes}
+ * @endcode
+ *
+ * Owners report the heap their containers reserve whenever they sample
+ * (the game does it once per frame while the performance HUD is shown);
+ * nothing is counted per allocation. Collect() adds every uploaded texture
+ * (Texture::GetUploadedTextures()) to its tag: the CPU pixel buffer and
+ * whatever GPU copy it has on the current backends. Untagged textures are
+ * charged to Subsystem::Other.
+ *
+ * @par What Is Not Counted
+ * Renderer-internal buffers (vertex batches, chunk meshes, descriptor
+ * pools) and memory behind C libraries and the driver. The per-subsystem
+ * CPU figures are container capacities, so they are close to, but not the
+ * same as, what the allocator handed out.
+ *
+ * @par Thread Safety
+ * Main thread only, like Texture.
+ *
+ * @see Texture::GetGpuBytes(), SpriteSheetRegistry::SetBudget()
+ */
+class MemoryTracker
+{
+public:
+    enum class Subsystem : std::uint8_t
+    {
+        Tilemap,     ///< Layers, collision, navigation, chunk caches
+        Tileset,     ///< Tileset atlas texture
+        Characters,  ///< Shared sprite sheets
+        Particles,   ///< Particle pool, scratch buffers and atlas
+        Sky,         ///< Sky textures and star/ray lists
+        Editor,      ///< Undo history
+        Other,       ///< Untagged textures (fonts, UI)
+        Count
+    };
+
+    static constexpr std::size_t SUBSYSTEM_COUNT = static_cast<std::size_t>(Subsystem::Count);
+
+    struct Usage
+    {
+        std::size_t cpuBytes = 0;
+        std::size_t gpuBytes = 0;
+    };
+
+    /// @brief Usage per subsystem, indexed by Subsystem.
+    using Report = std::array<Usage, SUBSYSTEM_COUNT>;
+
+    /// @brief Replace the heap bytes @p subsystem owns outside textures.
+    static void SetCpuBytes(Subsystem subsystem, std::size_t bytes);
+
+    /// @brief Reported CPU bytes plus every uploaded texture, per subsystem.
+    [[nodiscard]] static Report Collect();
+
+    /// @brief Sum over all subsystems of @p report.
+    [[nodiscard]] static Usage GetTotal(const Report &report);
+
+    /// @brief Short display name ("Tilemap", "Sky", ...).
+    [[nodiscard]] static const char *GetName(Subsystem subsystem);
+
+    /// @brief Heap bytes reserved by one or more std::vector (or similar) @p containers.
+    template<typename... Containers>
+    [[nodiscard]] static std::size_t CapacityBytes(const Containers &...containers)
+    {
+        return (std::size_t{0} + ... + (containers.capacity() * sizeof(typename Containers::value_type)));
+    }
+};
@@ -1,16 +1,25 @@
 #include "NonPlayerCharacter.h"
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <cmath>
+#include <atomic>
 #include <random>
 #include <iostream>
+#include <utility>
 
 namespace
 {
-    std::mt19937 &GetNpcRng()
+    // Seed for the next NPC's RNG stream. Starts from a per-run random value;
+    // each NPC takes the next one, so streams depend only on creation order.
+    uint64_t NextNpcSeed()
     {
-        static std::mt19937 rng(std::random_device{}());
-        return rng;
+        static std::atomic<uint64_t> counter{std::random_device{}()};
+        // SplitMix64 finalizer: consecutive counters give unrelated seeds
+        uint64_t z = counter.fetch_add(0x9e3779b97f4a7c15ull, std::memory_order_relaxed);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
     }
 
     // Width of each NPC sprite frame in pixels.
@@ -36,23 +45,94 @@ namespace
 
     // Minimum movement distance to avoid division by zero.
     constexpr float MIN_MOVEMENT_DIST = 0.001f;
+
+    // Whether NPC and player hitboxes (16x16, centered on feet) overlap.
+    bool HitboxesOverlap(glm::vec2 npc, glm::vec2 player)
+    {
+        constexpr float eps = GameCharacter::COLLISION_EPS;
+        float npcMinX = npc.x - NPC_HALF_WIDTH + eps;
+        float npcMaxX = npc.x + NPC_HALF_WIDTH - eps;
+        float npcMaxY = npc.y - eps;
+        float npcMinY = npc.y - NPC_HITBOX_HEIGHT + eps;
+
+        float playerMinX = player.x - NPC_HALF_WIDTH + eps;
+        float playerMaxX = player.x + NPC_HALF_WIDTH - eps;
+        float playerMaxY = player.y - eps;
+        float playerMinY = player.y - NPC_HITBOX_HEIGHT + eps;
+
+        return npcMinX < playerMaxX && npcMaxX > playerMinX &&
+               npcMinY < playerMaxY && npcMaxY > playerMinY;
+    }
+
+    // Bottom-center of a tile in world pixels.
+    glm::vec2 TileAnchor(int tileX, int tileY, int tileSize)
+    {
+        return glm::vec2(tileX * tileSize + tileSize * 0.5f,
+                         tileY * tileSize + static_cast<float>(tileSize));
+    }
 }
 
 NonPlayerCharacter::NonPlayerCharacter()
-    : GameCharacter()
-    , m_TileX(0)
-    , m_TileY(0)
-    , m_TargetTileX(0)
-    , m_TargetTileY(0)
-    , m_WaitTimer(0.0f)
-    , m_IsStopped(false)
-    , m_StandingStill(false)
-    , m_LookAroundTimer(0.0f)
-    , m_RandomStandStillCheckTimer(0.0f)
-    , m_RandomStandStillTimer(0.0f)
-    , m_Dialogue("Hello! How are you today?")
+    : m_Slot(CharacterStore::Npcs().Allocate(this))
+{
+    SeedRng(NextNpcSeed());
+}
+
+NonPlayerCharacter::~NonPlayerCharacter()
+{
+    if (m_Slot != CharacterStore::INVALID_SLOT)
+        CharacterStore::Npcs().Release(m_Slot);
+}
+
+NonPlayerCharacter::NonPlayerCharacter(NonPlayerCharacter &&other) noexcept
+    : m_SpriteSheet(std::move(other.m_SpriteSheet))
+    , m_Profile(std::move(other.m_Profile))
+    , m_PatrolRoute(std::move(other.m_PatrolRoute))
+    , m_GoalPath(std::move(other.m_GoalPath))
+    , m_GoalPathIndex(other.m_GoalPathIndex)
+    , m_PathRequest(other.m_PathRequest)
+    , m_HomeRegion(other.m_HomeRegion)
+    , m_Rng(other.m_Rng)
+    , m_Slot(std::exchange(other.m_Slot, CharacterStore::INVALID_SLOT))
 {
-    m_Speed = 25.0f;
+    if (m_Slot != CharacterStore::INVALID_SLOT)
+        CharacterStore::Npcs().SetOwner(m_Slot, this);
+}
+
+NonPlayerCharacter &NonPlayerCharacter::operator=(NonPlayerCharacter &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    // Swap so our old row is released along with other
+    std::swap(m_SpriteSheet, other.m_SpriteSheet);
+    std::swap(m_Profile, other.m_Profile);
+    std::swap(m_PatrolRoute, other.m_PatrolRoute);
+    std::swap(m_GoalPath, other.m_GoalPath);
+    std::swap(m_GoalPathIndex, other.m_GoalPathIndex);
+    std::swap(m_PathRequest, other.m_PathRequest);
+    std::swap(m_HomeRegion, other.m_HomeRegion);
+    std::swap(m_Rng, other.m_Rng);
+    std::swap(m_Slot, other.m_Slot);
+
+    CharacterStore &store = CharacterStore::Npcs();
+    if (m_Slot != CharacterStore::INVALID_SLOT)
+        store.SetOwner(m_Slot, this);
+    if (other.m_Slot != CharacterStore::INVALID_SLOT)
+        store.SetOwner(other.m_Slot, &other);
+    return *this;
+}
+
+const DialogueTree &NonPlayerCharacter::GetDialogueTree() const
+{
+    static const DialogueTree empty;
+    return m_Profile->dialogueTree ? m_Profile->dialogueTree->GetSource() : empty;
+}
+
+void NonPlayerCharacter::SeedRng(uint64_t seed)
+{
+    // minstd rejects 0 (and multiples of its modulus); fold into [1, modulus)
+    m_Rng.seed(static_cast<std::minstd_rand::result_type>(seed % (std::minstd_rand::modulus - 1) + 1));
 }
 
 bool NonPlayerCharacter::Load(const std::string &relativePath)
@@ -66,49 +146,70 @@ bool NonPlayerCharacter::Load(const std::string &relativePath)
     // Remove .png extension if present
     if (filename.size() > 4 && filename.substr(filename.size() - 4) == ".png")
     {
-        m_Type = filename.substr(0, filename.size() - 4);
+        m_Profile->type = filename.substr(0, filename.size() - 4);
     }
     else
     {
-        m_Type = filename;
+        m_Profile->type = filename;
     }
 
-    // Try loading from given path
+    // Try loading from given path; NPCs of one type share the sheet
     std::string path = relativePath;
-    if (!m_SpriteSheet.LoadFromFile(path))
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(path);
+    if (!sheet)
     {
         // Fallback: try parent directory
         std::string altPath = "../" + path;
-        if (!m_SpriteSheet.LoadFromFile(altPath))
+        sheet = SpriteSheetRegistry::Acquire(altPath);
+        if (!sheet)
         {
             std::cerr << "Failed to load NPC sprite sheet: "
                       << path << " or " << altPath << std::endl;
             return false;
         }
     }
+    m_SpriteSheet = std::move(sheet);
     return true;
 }
 
 void NonPlayerCharacter::UploadTextures(IRenderer &renderer)
 {
-    renderer.UploadTexture(m_SpriteSheet);
+    if (m_SpriteSheet)
+    {
+        renderer.UploadTexture(*m_SpriteSheet);
+    }
 }
 
 void NonPlayerCharacter::SetTilePosition(int tileX, int tileY, int tileSize, bool preserveRoute)
 {
-    m_TileX = tileX;
-    m_TileY = tileY;
+    CharacterStore &store = Store();
+    store.m_TileX[m_Slot] = tileX;
+    store.m_TileY[m_Slot] = tileY;
 
     // Position at bottom-center of tile
-    m_Position.x = tileX * tileSize + tileSize * 0.5f;
-    m_Position.y = tileY * tileSize + static_cast<float>(tileSize);
+    store.SetPosition(m_Slot, TileAnchor(tileX, tileY, tileSize));
 
-    m_TargetTileX = tileX;
-    m_TargetTileY = tileY;
+    store.m_TargetTileX[m_Slot] = tileX;
+    store.m_TargetTileY[m_Slot] = tileY;
 
     if (!preserveRoute)
     {
         m_PatrolRoute.Reset();
+        m_GoalPath.clear();
+        m_GoalPathIndex = 0;
+        m_PathRequest = 0;
+    }
+}
+
+void NonPlayerCharacter::FollowPath(std::vector<glm::ivec2> path)
+{
+    m_PathRequest = 0;
+    m_GoalPath = std::move(path);
+    m_GoalPathIndex = 0;
+    if (!m_GoalPath.empty())
+    {
+        Store().m_StandingStill[m_Slot] = 0;
+        Store().m_StandStillTimer[m_Slot] = 0.0f;
     }
 }
 
@@ -136,250 +237,323 @@ glm::vec2 NonPlayerCharacter::GetSpriteCoords(int frame, NPCDirection dir) const
     return glm::vec2(static_cast<float>(spriteX), static_cast<float>(spriteY));
 }
 
-void NonPlayerCharacter::Update(float deltaTime, const Tilemap *tilemap, const glm::vec2 *playerPosition)
+void NonPlayerCharacter::UpdateSlot(CharacterStore &store, CharacterStore::Slot slot, float deltaTime,
+                                    const Tilemap *tilemap, const glm::vec2 *playerPosition)
 {
     if (!tilemap)
         return;
 
     // Smooth elevation transition (must run regardless of movement state)
-    UpdateElevation(deltaTime);
+    store.UpdateElevation(slot, deltaTime);
+
+    float &waitTimer = store.m_WaitTimer[slot];
+    const glm::vec2 position = store.GetPosition(slot);
 
     bool isCollidingWithPlayer = false;
-    if (playerPosition)
-    {
-        // Build NPC hitbox (16x16, centered on feet)
-        float npcMinX = m_Position.x - NPC_HALF_WIDTH + COLLISION_EPS;
-        float npcMaxX = m_Position.x + NPC_HALF_WIDTH - COLLISION_EPS;
-        float npcMaxY = m_Position.y - COLLISION_EPS;
-        float npcMinY = m_Position.y - NPC_HITBOX_HEIGHT + COLLISION_EPS;
-
-        // Build player hitbox (16x16, centered on feet)
-        float playerMinX = playerPosition->x - NPC_HALF_WIDTH + COLLISION_EPS;
-        float playerMaxX = playerPosition->x + NPC_HALF_WIDTH - COLLISION_EPS;
-        float playerMaxY = playerPosition->y - COLLISION_EPS;
-        float playerMinY = playerPosition->y - NPC_HITBOX_HEIGHT + COLLISION_EPS;
-
-        // AABB intersection test
-        if (npcMinX < playerMaxX && npcMaxX > playerMinX &&
-            npcMinY < playerMaxY && npcMaxY > playerMinY)
-        {
-            isCollidingWithPlayer = true;
-            m_WaitTimer = 0.5f;
-        }
+    if (playerPosition && HitboxesOverlap(position, *playerPosition))
+    {
+        isCollidingWithPlayer = true;
+        waitTimer = 0.5f;
     }
 
-    if (m_IsStopped || isCollidingWithPlayer)
+    if (store.m_Stopped[slot] || isCollidingWithPlayer)
     {
-        ResetAnimation();
+        store.ResetAnimation(slot);
         return;
     }
 
-    if (m_StandingStill)
+    if (store.m_StandingStill[slot])
     {
-        ResetAnimation();
+        store.ResetAnimation(slot);
 
-        // Random pause: Count down timer
-        if (m_RandomStandStillTimer > 0.0f)
+        // Random pause: Count down timer; without one (no path) look around indefinitely
+        float &standStillTimer = store.m_StandStillTimer[slot];
+        bool keepStanding = true;
+        if (standStillTimer > 0.0f)
         {
-            m_RandomStandStillTimer -= deltaTime;
-            if (m_RandomStandStillTimer <= 0.0f)
-            {
-                m_StandingStill = false;
-                m_RandomStandStillTimer = 0.0f;
-            }
-            else
+            standStillTimer -= deltaTime;
+            if (standStillTimer <= 0.0f)
             {
-                // Look around while paused
-                UpdateLookAround(deltaTime);
-                return;
+                store.m_StandingStill[slot] = 0;
+                standStillTimer = 0.0f;
+                keepStanding = false;
             }
         }
-        else
+
+        if (keepStanding)
         {
-            // No path available: Look around indefinitely
-            UpdateLookAround(deltaTime);
+            // Look around while paused
+            store.m_LookAroundTimer[slot] -= deltaTime;
+            if (store.m_LookAroundTimer[slot] <= 0.0f)
+                store.GetOwner(slot)->LookAround();
             return;
         }
     }
 
     const int tileSize = tilemap->GetTileWidth();
-    m_TileX = static_cast<int>(std::floor(m_Position.x / tileSize));
-    m_TileY = static_cast<int>(std::floor((m_Position.y - 0.1f) / tileSize));
+    const int tileX = static_cast<int>(std::floor(position.x / tileSize));
+    const int tileY = static_cast<int>(std::floor((position.y - 0.1f) / tileSize));
+    store.m_TileX[slot] = tileX;
+    store.m_TileY[slot] = tileY;
 
-    if (m_WaitTimer > 0.0f)
+    if (waitTimer > 0.0f)
     {
-        m_WaitTimer -= deltaTime;
-        if (m_WaitTimer < 0.0f)
-            m_WaitTimer = 0.0f;
+        waitTimer -= deltaTime;
+        if (waitTimer < 0.0f)
+            waitTimer = 0.0f;
     }
 
-    m_AnimationTime += deltaTime;
-    if (m_AnimationTime >= NPC_ANIM_SPEED)
+    float &animationTime = store.m_AnimationTime[slot];
+    animationTime += deltaTime;
+    if (animationTime >= NPC_ANIM_SPEED)
     {
-        m_AnimationTime -= NPC_ANIM_SPEED;
-        AdvanceWalkAnimation();
+        animationTime -= NPC_ANIM_SPEED;
+        store.AdvanceWalkAnimation(slot);
     }
 
-    if (m_WaitTimer > 0.0f)
+    if (waitTimer > 0.0f)
         return;
 
-    if (m_PatrolRoute.IsValid() && m_RandomStandStillCheckTimer > 0.0f)
+    // Only positive once a patrol route is set up; every route setup rewrites it
+    float &checkTimer = store.m_StandStillCheckTimer[slot];
+    if (checkTimer > 0.0f)
     {
-        m_RandomStandStillCheckTimer -= deltaTime;
+        checkTimer -= deltaTime;
     }
 
-    glm::vec2 targetPos(
-        m_TargetTileX * tileSize + tileSize * 0.5f,
-        m_TargetTileY * tileSize + static_cast<float>(tileSize));
+    glm::vec2 targetPos = TileAnchor(store.m_TargetTileX[slot], store.m_TargetTileY[slot], tileSize);
 
-    glm::vec2 toTarget = targetPos - m_Position;
+    glm::vec2 toTarget = targetPos - position;
     float dist = glm::length(toTarget);
 
     // Check if we've reached the current waypoint
     if (dist < WAYPOINT_REACH_THRESHOLD)
     {
-        m_Position = targetPos;
-
-        // Initialize patrol route if needed
-        if (!m_PatrolRoute.IsValid())
-        {
-            if (!m_PatrolRoute.Initialize(m_TileX, m_TileY, tilemap, 100))
-            {
-                EnterStandingStillMode(false);
-                return;
-            }
-            else
-            {
-                m_StandingStill = false;
-                m_RandomStandStillTimer = 0.0f;
-                m_RandomStandStillCheckTimer = 5.0f + (GetNpcRng()() % 500) / 100.0f;
-            }
-        }
-
-        // Random pause check (30% chance when timer expires at waypoint)
-        if (m_PatrolRoute.IsValid() && m_RandomStandStillCheckTimer <= 0.0f)
-        {
-            m_RandomStandStillCheckTimer = 5.0f + (GetNpcRng()() % 500) / 100.0f;
-            if ((GetNpcRng()() % 100) < 30)
-            {
-                float duration = 2.0f + (GetNpcRng()() % 300) / 100.0f;
-                EnterStandingStillMode(true, duration);
-                return;
-            }
-        }
-
-        // Get next waypoint
-        int nextX, nextY;
-        if (m_PatrolRoute.GetNextWaypoint(nextX, nextY))
-        {
-            m_TargetTileX = nextX;
-            m_TargetTileY = nextY;
-            UpdateDirectionFromMovement(m_TargetTileX - m_TileX, m_TargetTileY - m_TileY);
-        }
-        else
-        {
-            m_WaitTimer = 1.0f;
-        }
+        store.SetPosition(slot, targetPos);
+        store.GetOwner(slot)->OnWaypointReached(tilemap, true);
         return;
     }
 
     if (dist > MIN_MOVEMENT_DIST)
     {
+        // Never step past the target: with long frames (or LOD catch-up
+        // steps) an overshoot larger than the reach threshold would oscillate
         glm::vec2 dir = toTarget / dist;
-        glm::vec2 newPosition = m_Position + dir * m_Speed * deltaTime;
+        glm::vec2 newPosition = position + dir * std::min(store.m_Speed[slot] * deltaTime, dist);
 
-        bool wouldCollide = CheckPlayerCollision(newPosition, playerPosition);
+        bool wouldCollide = playerPosition && HitboxesOverlap(newPosition, *playerPosition);
 
         if (!wouldCollide)
         {
-            m_Position = newPosition;
+            store.SetPosition(slot, newPosition);
             UpdateDirectionFromMovement(
+                store.m_Direction[slot],
                 static_cast<int>(dir.x > 0) - static_cast<int>(dir.x < 0),
                 static_cast<int>(dir.y > 0) - static_cast<int>(dir.y < 0));
         }
         else
         {
-            m_WaitTimer = 0.5f;
+            waitTimer = 0.5f;
         }
     }
 }
 
-void NonPlayerCharacter::UpdateLookAround(float deltaTime)
+bool NonPlayerCharacter::OnWaypointReached(const Tilemap *tilemap, bool allowRandomPause)
 {
-    m_LookAroundTimer -= deltaTime;
-    if (m_LookAroundTimer <= 0.0f)
+    CharacterStore &store = Store();
+
+    // A pending path request holds the NPC here until Game hands over the result
+    if (m_PathRequest != 0)
     {
-        static const NPCDirection directions[] = {
-            NPCDirection::LEFT, NPCDirection::RIGHT,
-            NPCDirection::UP, NPCDirection::DOWN};
-        m_Direction = directions[GetNpcRng()() % 4];
-        m_LookAroundTimer = 2.0f;
+        store.ResetAnimation(m_Slot);
+        return false;
     }
+
+    const int tileX = store.m_TileX[m_Slot];
+    const int tileY = store.m_TileY[m_Slot];
+    std::int32_t &targetX = store.m_TargetTileX[m_Slot];
+    std::int32_t &targetY = store.m_TargetTileY[m_Slot];
+
+    // Goal paths take priority over the patrol loop
+    if (!m_GoalPath.empty())
+    {
+        if (m_GoalPathIndex < m_GoalPath.size())
+        {
+            targetX = m_GoalPath[m_GoalPathIndex].x;
+            targetY = m_GoalPath[m_GoalPathIndex].y;
+            ++m_GoalPathIndex;
+            UpdateDirectionFromMovement(store.m_Direction[m_Slot], targetX - tileX, targetY - tileY);
+            return true;
+        }
+
+        // Arrived: pause, then patrol around the destination
+        m_GoalPath.clear();
+        m_GoalPathIndex = 0;
+        m_PatrolRoute.Reset();
+        store.m_WaitTimer[m_Slot] = 1.0f;
+        return false;
+    }
+
+    // Initialize patrol route if needed
+    if (!m_PatrolRoute.IsValid())
+    {
+        if (!m_PatrolRoute.Initialize(tileX, tileY, tilemap, 100))
+        {
+            EnterStandingStillMode(false);
+            return false;
+        }
+        else
+        {
+            store.m_StandingStill[m_Slot] = 0;
+            store.m_StandStillTimer[m_Slot] = 0.0f;
+            store.m_StandStillCheckTimer[m_Slot] = 5.0f + (m_Rng() % 500) / 100.0f;
+        }
+    }
+
+    // Random pause check (30% chance when timer expires at waypoint)
+    if (allowRandomPause && m_PatrolRoute.IsValid() && store.m_StandStillCheckTimer[m_Slot] <= 0.0f)
+    {
+        store.m_StandStillCheckTimer[m_Slot] = 5.0f + (m_Rng() % 500) / 100.0f;
+        if ((m_Rng() % 100) < 30)
+        {
+            float duration = 2.0f + (m_Rng() % 300) / 100.0f;
+            EnterStandingStillMode(true, duration);
+            return false;
+        }
+    }
+
+    // Get next waypoint
+    int nextX, nextY;
+    if (m_PatrolRoute.GetNextWaypoint(nextX, nextY))
+    {
+        targetX = nextX;
+        targetY = nextY;
+        UpdateDirectionFromMovement(store.m_Direction[m_Slot], targetX - tileX, targetY - tileY);
+        return true;
+    }
+
+    store.m_WaitTimer[m_Slot] = 1.0f;
+    return false;
 }
 
-void NonPlayerCharacter::EnterStandingStillMode(bool isRandom, float duration)
+void NonPlayerCharacter::UpdateDormant(float deltaTime, const Tilemap *tilemap)
 {
-    m_StandingStill = true;
-    m_RandomStandStillTimer = isRandom ? duration : 0.0f;
-    m_LookAroundTimer = 2.0f;
-    ResetAnimation();
+    CharacterStore &store = Store();
+    if (!tilemap || store.m_Stopped[m_Slot])
+        return;
+
+    // Nobody sees a dormant NPC: no animation, no look-around, no random
+    // pauses. Timers still run so a pause that started on screen ends on time.
+    store.ResetAnimation(m_Slot);
+
+    if (store.m_StandingStill[m_Slot])
+    {
+        float &standStillTimer = store.m_StandStillTimer[m_Slot];
+        if (standStillTimer <= 0.0f)
+            return;  // No route: stays put until the map changes
+
+        standStillTimer -= deltaTime;
+        if (standStillTimer > 0.0f)
+            return;
+        deltaTime = -standStillTimer;
+        store.m_StandingStill[m_Slot] = 0;
+        standStillTimer = 0.0f;
+    }
+
+    float &waitTimer = store.m_WaitTimer[m_Slot];
+    if (waitTimer > 0.0f)
+    {
+        float waited = std::min(waitTimer, deltaTime);
+        waitTimer -= waited;
+        deltaTime -= waited;
+    }
+
+    // Walk the route for the distance this much time covers, passing through
+    // as many waypoints as it takes
+    const int tileSize = tilemap->GetTileWidth();
+    glm::vec2 position = store.GetPosition(m_Slot);
+    float remaining = store.m_Speed[m_Slot] * deltaTime;
+    constexpr int MAX_WAYPOINTS_PER_STEP = 64;
+    for (int i = 0; i < MAX_WAYPOINTS_PER_STEP && remaining > 0.0f; ++i)
+    {
+        glm::vec2 targetPos = TileAnchor(store.m_TargetTileX[m_Slot], store.m_TargetTileY[m_Slot], tileSize);
+        glm::vec2 toTarget = targetPos - position;
+        float dist = glm::length(toTarget);
+
+        if (dist > remaining)
+        {
+            position += toTarget * (remaining / dist);
+            break;
+        }
+
+        position = targetPos;
+        remaining -= dist;
+        store.m_TileX[m_Slot] = store.m_TargetTileX[m_Slot];
+        store.m_TileY[m_Slot] = store.m_TargetTileY[m_Slot];
+        if (!OnWaypointReached(tilemap, false))
+            break;
+    }
 
+    store.SetPosition(m_Slot, position);
+    store.m_TileX[m_Slot] = static_cast<int>(std::floor(position.x / tileSize));
+    store.m_TileY[m_Slot] = static_cast<int>(std::floor((position.y - 0.1f) / tileSize));
+
+    // Land on the tile's elevation directly; there is no transition to watch
+    float elevation = tilemap->GetElevationAtWorldPos(position.x, position.y);
+    store.m_ElevationOffset[m_Slot] = store.m_TargetElevation[m_Slot] = store.m_ElevationStart[m_Slot] = elevation;
+    store.m_ElevationProgress[m_Slot] = 1.0f;
+}
+
+void NonPlayerCharacter::LookAround()
+{
     static const NPCDirection directions[] = {
         NPCDirection::LEFT, NPCDirection::RIGHT,
         NPCDirection::UP, NPCDirection::DOWN};
-    m_Direction = directions[GetNpcRng()() % 4];
+    Store().m_Direction[m_Slot] = directions[m_Rng() % 4];
+    Store().m_LookAroundTimer[m_Slot] = 2.0f;
+}
+
+void NonPlayerCharacter::EnterStandingStillMode(bool isRandom, float duration)
+{
+    CharacterStore &store = Store();
+    store.m_StandingStill[m_Slot] = 1;
+    store.m_StandStillTimer[m_Slot] = isRandom ? duration : 0.0f;
+    store.ResetAnimation(m_Slot);
+    LookAround();
 }
 
-void NonPlayerCharacter::UpdateDirectionFromMovement(int dx, int dy)
+void NonPlayerCharacter::UpdateDirectionFromMovement(CharacterDirection &direction, int dx, int dy)
 {
     if (std::abs(dx) > std::abs(dy))
     {
-        m_Direction = (dx > 0) ? NPCDirection::RIGHT : NPCDirection::LEFT;
+        direction = (dx > 0) ? NPCDirection::RIGHT : NPCDirection::LEFT;
     }
     else if (dy != 0)
     {
-        m_Direction = (dy > 0) ? NPCDirection::DOWN : NPCDirection::UP;
+        direction = (dy > 0) ? NPCDirection::DOWN : NPCDirection::UP;
     }
 }
 
-bool NonPlayerCharacter::CheckPlayerCollision(const glm::vec2 &newPosition, const glm::vec2 *playerPos) const
-{
-    if (!playerPos)
-        return false;
-
-    float npcMinX = newPosition.x - NPC_HALF_WIDTH + COLLISION_EPS;
-    float npcMaxX = newPosition.x + NPC_HALF_WIDTH - COLLISION_EPS;
-    float npcMaxY = newPosition.y - COLLISION_EPS;
-    float npcMinY = newPosition.y - NPC_HITBOX_HEIGHT + COLLISION_EPS;
-
-    float playerMinX = playerPos->x - NPC_HALF_WIDTH + COLLISION_EPS;
-    float playerMaxX = playerPos->x + NPC_HALF_WIDTH - COLLISION_EPS;
-    float playerMaxY = playerPos->y - COLLISION_EPS;
-    float playerMinY = playerPos->y - NPC_HITBOX_HEIGHT + COLLISION_EPS;
-
-    return npcMinX < playerMaxX && npcMaxX > playerMinX &&
-           npcMinY < playerMaxY && npcMaxY > playerMinY;
-}
-
 bool NonPlayerCharacter::ReinitializePatrolRoute(const Tilemap *tilemap)
 {
     if (!tilemap)
         return false;
 
+    CharacterStore &store = Store();
     m_PatrolRoute.Reset();
-    bool success = m_PatrolRoute.Initialize(m_TileX, m_TileY, tilemap, 100);
+    bool success = m_PatrolRoute.Initialize(store.m_TileX[m_Slot], store.m_TileY[m_Slot], tilemap, 100);
 
     if (success)
     {
-        m_StandingStill = false;
-        m_RandomStandStillTimer = 0.0f;
-        m_RandomStandStillCheckTimer = 5.0f + (GetNpcRng()() % 500) / 100.0f;
+        store.m_StandingStill[m_Slot] = 0;
+        store.m_StandStillTimer[m_Slot] = 0.0f;
+        store.m_StandStillCheckTimer[m_Slot] = 5.0f + (m_Rng() % 500) / 100.0f;
     }
     else
     {
-        m_StandingStill = true;
-        m_RandomStandStillTimer = 0.0f;
-        m_LookAroundTimer = 2.0f;
+        store.m_StandingStill[m_Slot] = 1;
+        store.m_StandStillTimer[m_Slot] = 0.0f;
+        store.m_LookAroundTimer[m_Slot] = 2.0f;
     }
 
     return success;
@@ -396,7 +570,8 @@ void NonPlayerCharacter::Render(IRenderer &renderer, glm::vec2 cameraPos) const
     constexpr float spriteHeight = static_cast<float>(NPC_SPRITE_HEIGHT);
 
     // Convert world position to screen space
-    glm::vec2 bottomCenter = m_Position - cameraPos;
+    const CharacterStore &store = Store();
+    glm::vec2 bottomCenter = store.GetPosition(m_Slot) - cameraPos;
 
     // Only use ProjectPoint if inside the expanded 3D viewport (prevents globe wrap-around artifacts)
     auto perspState = renderer.GetPerspectiveState();
@@ -418,10 +593,11 @@ void NonPlayerCharacter::Render(IRenderer &renderer, glm::vec2 cameraPos) const
 
     // Position sprite with feet at projected point
     glm::vec2 renderPos = bottomCenter - glm::vec2(spriteWidth / 2.0f, spriteHeight);
-    glm::vec2 spriteCoords = GetSpriteCoords(m_CurrentFrame, m_Direction);
+    glm::vec2 spriteCoords = GetSpriteCoords(store.m_Frame[m_Slot], store.m_Direction[m_Slot]);
 
+    MarkSpriteSheetUsed();
     renderer.DrawSpriteRegion(
-        m_SpriteSheet,
+        GetSpriteSheet(),
         renderPos,
         glm::vec2(spriteWidth, spriteHeight),
         spriteCoords,
@@ -438,8 +614,9 @@ void NonPlayerCharacter::RenderBottomHalf(IRenderer &renderer, glm::vec2 cameraP
     constexpr float halfHeight = 16.0f;
 
     // Apply elevation before projection
-    glm::vec2 bottomCenter = m_Position - cameraPos;
-    bottomCenter.y -= m_ElevationOffset;
+    const CharacterStore &store = Store();
+    glm::vec2 bottomCenter = store.GetPosition(m_Slot) - cameraPos;
+    bottomCenter.y -= store.m_ElevationOffset[m_Slot];
 
     // Only use ProjectPoint if inside the expanded 3D viewport (prevents globe wrap-around artifacts)
     auto perspState = renderer.GetPerspectiveState();
@@ -460,12 +637,13 @@ void NonPlayerCharacter::RenderBottomHalf(IRenderer &renderer, glm::vec2 cameraP
     }
 
     glm::vec2 renderPos = bottomCenter - glm::vec2(spriteWidth / 2.0f, spriteHeight);
-    glm::vec2 spriteCoords = GetSpriteCoords(m_CurrentFrame, m_Direction);
+    glm::vec2 spriteCoords = GetSpriteCoords(store.m_Frame[m_Slot], store.m_Direction[m_Slot]);
 
     // Draw lower 16 pixels (feet area)
     renderer.SuspendPerspective(true);
+    MarkSpriteSheetUsed();
     renderer.DrawSpriteRegion(
-        m_SpriteSheet,
+        GetSpriteSheet(),
         renderPos + glm::vec2(0.0f, halfHeight),
         glm::vec2(spriteWidth, halfHeight),
         spriteCoords,
@@ -483,8 +661,9 @@ void NonPlayerCharacter::RenderTopHalf(IRenderer &renderer, glm::vec2 cameraPos)
     constexpr float halfHeight = 16.0f;
 
     // Apply elevation before projection
-    glm::vec2 bottomCenter = m_Position - cameraPos;
-    bottomCenter.y -= m_ElevationOffset;
+    const CharacterStore &store = Store();
+    glm::vec2 bottomCenter = store.GetPosition(m_Slot) - cameraPos;
+    bottomCenter.y -= store.m_ElevationOffset[m_Slot];
 
     // Only use ProjectPoint if inside the expanded 3D viewport (prevents globe wrap-around artifacts)
     auto perspState = renderer.GetPerspectiveState();
@@ -505,14 +684,15 @@ void NonPlayerCharacter::RenderTopHalf(IRenderer &renderer, glm::vec2 cameraPos)
     }
 
     glm::vec2 renderPos = bottomCenter - glm::vec2(spriteWidth / 2.0f, spriteHeight);
-    glm::vec2 spriteCoords = GetSpriteCoords(m_CurrentFrame, m_Direction);
+    glm::vec2 spriteCoords = GetSpriteCoords(store.m_Frame[m_Slot], store.m_Direction[m_Slot]);
 
     // Draw upper 16 pixels (head/torso area)
     glm::vec2 topHalfCoords = spriteCoords + glm::vec2(0.0f, halfHeight);
 
     renderer.SuspendPerspective(true);
+    MarkSpriteSheetUsed();
     renderer.DrawSpriteRegion(
-        m_SpriteSheet,
+        GetSpriteSheet(),
         renderPos,
         glm::vec2(spriteWidth, halfHeight),
         topHalfCoords,
@@ -1,14 +1,37 @@
 #pragma once
 
 #include "Texture.h"
+#include "CharacterStore.h"
 #include "GameCharacter.h"
 #include "IRenderer.h"
 #include "Tilemap.h"
 #include "PatrolRoute.h"
-#include "DialogueSystem.h"
+#include "SimulationLod.h"
+#include "SpriteSheetRegistry.h"
+#include "CompiledDialogue.h"
 
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <string>
+#include <vector>
+
+/**
+ * @struct NPCProfile
+ * @brief Identity and dialogue of an NPC, read only on interaction and save.
+ * @ingroup Entities
+ *
+ * Kept behind a pointer so the NPC objects Game updates every frame stay
+ * small and dense.
+ */
+struct NPCProfile
+{
+    std::string type;                                     ///< Sprite sheet name without extension
+    std::string name;                                     ///< Display name
+    std::string dialogue = "Hello! How are you today?";   ///< Fallback line without a dialogue tree
+    std::shared_ptr<const CompiledDialogue> dialogueTree; ///< Branching conversation, shared by type (may be null)
+};
 
 /**
  * @class NonPlayerCharacter
@@ -20,17 +43,76 @@
  * NPCs follow patrol routes through the navigation map and can interact
  * with the player through collision and dialogue.
  *
+ * @par Determinism
+ * Random pauses and look-around directions come from a per-NPC RNG stream
+ * (see SeedRng()), never from shared state, so an NPC's behavior does not
+ * depend on the order in which NPCs are updated.
+ *
+ * @par Data Layout
+ * Position, tiles, direction, timers, animation and elevation live in a row
+ * of CharacterStore::Npcs(); the object holds that row's slot plus the cold
+ * state (route, goal path, sprite sheet, RNG) and an out-of-line NPCProfile
+ * for identity and dialogue. The IGameCharacter accessors read and write the
+ * row. UpdateSlot() is the per-frame step on the row itself, and touches the
+ * object only to pick the next waypoint or a random direction. Moving an NPC
+ * hands its row over; a moved-from NPC holds none and may only be assigned
+ * or destroyed.
+ *
+ * @par Thread Safety
+ * Update() only writes the NPC's own row and object and reads the Tilemap,
+ * so different NPCs may be updated on different threads at once while
+ * nobody edits the map. Construction, moves and destruction are main-thread
+ * only (see CharacterStore).
+ *
  * @see PatrolRoute, NavigationMap, PlayerCharacter
  */
-class NonPlayerCharacter : public GameCharacter
+class NonPlayerCharacter : public IGameCharacter
 {
 public:
     NonPlayerCharacter();
+    ~NonPlayerCharacter() override;
 
     NonPlayerCharacter(const NonPlayerCharacter &) = delete;
     NonPlayerCharacter &operator=(const NonPlayerCharacter &) = delete;
-    NonPlayerCharacter(NonPlayerCharacter &&) noexcept = default;
-    NonPlayerCharacter &operator=(NonPlayerCharacter &&) noexcept = default;
+    NonPlayerCharacter(NonPlayerCharacter &&other) noexcept;
+    NonPlayerCharacter &operator=(NonPlayerCharacter &&other) noexcept;
+
+    /// @name Position & Direction
+    /// @{
+    glm::vec2 GetPosition() const override { return Store().GetPosition(m_Slot); }
+    void SetPosition(glm::vec2 pos) override { Store().SetPosition(m_Slot, pos); }
+    CharacterDirection GetDirection() const override { return Store().m_Direction[m_Slot]; }
+    void SetDirection(CharacterDirection dir) override { Store().m_Direction[m_Slot] = dir; }
+    /// @}
+
+    /// @name Elevation
+    /// @{
+    float GetElevationOffset() const override { return Store().m_ElevationOffset[m_Slot]; }
+    float GetTargetElevation() const override { return Store().m_TargetElevation[m_Slot]; }
+    void SetElevationOffset(float offset) override { Store().SetElevationOffset(m_Slot, offset); }
+    void UpdateElevation(float deltaTime) override { Store().UpdateElevation(m_Slot, deltaTime); }
+    /// @}
+
+    /// @name Movement
+    /// @{
+    float GetSpeed() const override { return Store().m_Speed[m_Slot]; }
+    void SetSpeed(float speed) override { Store().m_Speed[m_Slot] = speed; }
+    /// @}
+
+    /// @name Animation
+    /// @{
+    int GetCurrentFrame() const override { return Store().m_Frame[m_Slot]; }
+    void SetCurrentFrame(int frame) override { Store().m_Frame[m_Slot] = frame; }
+    float GetAnimationTime() const override { return Store().m_AnimationTime[m_Slot]; }
+    void SetAnimationTime(float time) override { Store().m_AnimationTime[m_Slot] = time; }
+    int GetWalkSequenceIndex() const override { return Store().m_WalkSequenceIndex[m_Slot]; }
+    void SetWalkSequenceIndex(int index) override { Store().m_WalkSequenceIndex[m_Slot] = index; }
+    void AdvanceWalkAnimation() override { Store().AdvanceWalkAnimation(m_Slot); }
+    void ResetAnimation() override { Store().ResetAnimation(m_Slot); }
+    /// @}
+
+    /// @brief Row of this NPC in CharacterStore::Npcs().
+    CharacterStore::Slot GetSlot() const { return m_Slot; }
 
     /**
      * @brief Load NPC sprite sheet from file.
@@ -60,7 +142,44 @@ public:
      * @param tilemap Tilemap for navigation queries.
      * @param playerPosition Optional player position for collision.
      */
-    void Update(float deltaTime, const Tilemap *tilemap, const glm::vec2 *playerPosition = nullptr);
+    void Update(float deltaTime, const Tilemap *tilemap, const glm::vec2 *playerPosition = nullptr)
+    {
+        UpdateSlot(Store(), m_Slot, deltaTime, tilemap, playerPosition);
+    }
+
+    /**
+     * @brief Update() on a store row, for passes that walk the store.
+     * @param store Store holding the row (CharacterStore::Npcs() outside tests).
+     * @param slot Live row owned by an NPC.
+     * @param deltaTime Frame time in seconds.
+     * @param tilemap Tilemap for navigation queries.
+     * @param playerPosition Optional player position for collision.
+     */
+    static void UpdateSlot(CharacterStore &store, CharacterStore::Slot slot, float deltaTime, const Tilemap *tilemap,
+                           const glm::vec2 *playerPosition);
+
+    /**
+     * @brief Cheap update for NPCs far from the view (SimLod::Dormant).
+     *
+     * Moves the NPC along its goal path or patrol route by the distance it
+     * would have walked in @p deltaTime, however many waypoints that spans.
+     * Skips animation, look-around and random pauses, and snaps elevation,
+     * so switching back to Update() continues from a consistent state.
+     *
+     * @param deltaTime Time to advance in seconds (may span many frames).
+     * @param tilemap Tilemap for navigation queries.
+     */
+    void UpdateDormant(float deltaTime, const Tilemap *tilemap);
+
+    /**
+     * @brief Restart this NPC's RNG stream.
+     *
+     * Each NPC is seeded on construction from a per-run sequence; reseed to
+     * reproduce a run exactly.
+     *
+     * @param seed Any value.
+     */
+    void SeedRng(uint64_t seed);
 
     /**
      * @brief Render the full NPC sprite.
@@ -85,27 +204,38 @@ public:
 
     // --- Tile accessors ---
 
-    int GetTileX() const { return m_TileX; }
-    int GetTileY() const { return m_TileY; }
+    int GetTileX() const { return Store().m_TileX[m_Slot]; }
+    int GetTileY() const { return Store().m_TileY[m_Slot]; }
 
     // --- Type/name/dialogue ---
 
-    const std::string &GetType() const { return m_Type; }
-    std::string GetSpritePath() const { return "assets/non-player/" + m_Type + ".png"; }
+    const std::string &GetType() const { return m_Profile->type; }
+    std::string GetSpritePath() const { return "assets/non-player/" + m_Profile->type + ".png"; }
+
+    /// Sprite sheet shared by every NPC of this type (an empty texture before Load()).
+    const Texture &GetSpriteSheet() const { return m_SpriteSheet ? *m_SpriteSheet : SpriteSheetRegistry::GetEmpty(); }
+
+    bool IsStopped() const { return Store().m_Stopped[m_Slot] != 0; }
+    void SetStopped(bool stopped) { Store().m_Stopped[m_Slot] = stopped; }
+
+    const std::string &GetName() const { return m_Profile->name; }
+    void SetName(const std::string &name) { m_Profile->name = name; }
 
-    bool IsStopped() const { return m_IsStopped; }
-    void SetStopped(bool stopped) { m_IsStopped = stopped; }
+    const std::string &GetDialogue() const { return m_Profile->dialogue; }
+    void SetDialogue(const std::string &dialogue) { m_Profile->dialogue = dialogue; }
 
-    const std::string &GetName() const { return m_Name; }
-    void SetName(const std::string &name) { m_Name = name; }
+    /// Editable form of the conversation (empty without one).
+    const DialogueTree &GetDialogueTree() const;
+    /// Compile @p tree, sharing the result with NPCs that already hold an equal tree.
+    void SetDialogueTree(const DialogueTree &tree) { m_Profile->dialogueTree = CompiledDialogue::Share(tree); }
+    bool HasDialogueTree() const { return m_Profile->dialogueTree != nullptr; }
+    const std::shared_ptr<const CompiledDialogue> &GetCompiledDialogue() const { return m_Profile->dialogueTree; }
 
-    const std::string &GetDialogue() const { return m_Dialogue; }
-    void SetDialogue(const std::string &dialogue) { m_Dialogue = dialogue; }
+    // --- World streaming ---
 
-    const DialogueTree& GetDialogueTree() const { return m_DialogueTree; }
-    DialogueTree& GetDialogueTree() { return m_DialogueTree; }
-    void SetDialogueTree(const DialogueTree& tree) { m_DialogueTree = tree; }
-    bool HasDialogueTree() const { return !m_DialogueTree.nodes.empty(); }
+    /// Region that spawned this NPC and saves it back; (-1, -1) = not streamed
+    glm::ivec2 GetHomeRegion() const { return m_HomeRegion; }
+    void SetHomeRegion(glm::ivec2 region) { m_HomeRegion = region; }
 
     /**
      * @brief Reinitialize patrol route from current position.
@@ -114,6 +244,23 @@ public:
      */
     bool ReinitializePatrolRoute(const Tilemap *tilemap);
 
+    // --- Goal-directed movement ---
+
+    /// Tile the NPC is currently walking to (where a new path should start)
+    glm::ivec2 GetTargetTile() const { return {Store().m_TargetTileX[m_Slot], Store().m_TargetTileY[m_Slot]}; }
+
+    /// Pathfinder request in flight (0 = none). The NPC holds at its target tile until it resolves.
+    uint32_t GetPathRequest() const { return m_PathRequest; }
+    void SetPathRequest(uint32_t request) { m_PathRequest = request; }
+
+    /**
+     * @brief Walk @p path from the current target tile, then resume patrolling.
+     * @param path Cardinal steps starting next to GetTargetTile(), as produced by Pathfinder.
+     */
+    void FollowPath(std::vector<glm::ivec2> path);
+
+    bool IsFollowingPath() const { return m_GoalPathIndex < m_GoalPath.size(); }
+
     /**
      * @brief Reset animation to idle frame.
      */
@@ -130,32 +277,36 @@ public:
     /// @name Public State (for editor/debug access)
     /// @{
 
-    Texture m_SpriteSheet;
-    std::string m_Type;
-    std::string m_Name;
-    std::string m_Dialogue;
-    DialogueTree m_DialogueTree;
+    SpriteSheetRegistry::Handle m_SpriteSheet;  ///< Shared through SpriteSheetRegistry
+    std::unique_ptr<NPCProfile> m_Profile{std::make_unique<NPCProfile>()};  ///< Cold data, kept out of line
 
-    int m_TileX{0};
-    int m_TileY{0};
-
-    int m_TargetTileX{0};
-    int m_TargetTileY{0};
+    PatrolRoute m_PatrolRoute;
 
-    float m_WaitTimer{0.0f};
-    bool m_IsStopped{false};
-    bool m_StandingStill{false};
-    float m_LookAroundTimer{0.0f};
-    float m_RandomStandStillCheckTimer{0.0f};
-    float m_RandomStandStillTimer{0.0f};
+    std::vector<glm::ivec2> m_GoalPath;  ///< Path from FollowPath(), walked before the patrol resumes
+    size_t m_GoalPathIndex{0};
+    uint32_t m_PathRequest{0};
 
-    PatrolRoute m_PatrolRoute;
+    glm::ivec2 m_HomeRegion{-1, -1};
 
     /// @}
 
 private:
-    void UpdateLookAround(float deltaTime);
+    static CharacterStore &Store() { return CharacterStore::Npcs(); }
+
+    /// Pick the next target after arriving on one. Returns `true` if the NPC should keep walking.
+    bool OnWaypointReached(const Tilemap *tilemap, bool allowRandomPause);
+    /// Face a random direction and restart the look-around timer
+    void LookAround();
     void EnterStandingStillMode(bool isRandom, float duration = 0.0f);
-    void UpdateDirectionFromMovement(int dx, int dy);
-    bool CheckPlayerCollision(const glm::vec2& newPosition, const glm::vec2* playerPos) const;
+    static void UpdateDirectionFromMovement(CharacterDirection &direction, int dx, int dy);
+
+    /// Draw-path helper: stamp the sheet for this frame so the texture budget keeps it loaded
+    void MarkSpriteSheetUsed() const
+    {
+        if (m_SpriteSheet)
+            m_SpriteSheet->MarkUsed();
+    }
+
+    std::minstd_rand m_Rng;  ///< Behavior randomness; small so every NPC can own one
+    CharacterStore::Slot m_Slot{CharacterStore::INVALID_SLOT};  ///< Row in CharacterStore::Npcs()
 };
@@ -8,6 +8,8 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <cstddef>
 #include <GLFW/glfw3.h>
 
 // Debug: Sleep after each draw call to visualize render order
@@ -37,6 +39,35 @@ static void DebugAfterDraw(const char *label, int count)
     }
 }
 
+// Attribute layout shared by the batch VAOs: position (xy) + texcoord (uv)
+// followed by either a color (rgba) or a texture slot
+static void SetupBatchVertexLayout(GLsizei stride, bool hasColor, bool hasTexSlot)
+{
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    if (hasColor)
+    {
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (void *)(4 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+    }
+    else
+    {
+        glDisableVertexAttribArray(2);
+    }
+    if (hasTexSlot)
+    {
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void *)(4 * sizeof(float)));
+        glEnableVertexAttribArray(3);
+    }
+    else
+    {
+        // Disabled attribute reads the default (0,0,0,1), i.e. slot 0
+        glDisableVertexAttribArray(3);
+    }
+}
+
 OpenGLRenderer::OpenGLRenderer()
     // Core geometry buffers
     : m_VAO(0)                                                     // Vertex array object for unit quad
@@ -52,11 +83,20 @@ OpenGLRenderer::OpenGLRenderer()
     , m_ColorLoc(-1)                                               // RGB color tint
     , m_AlphaLoc(-1)                                               // Transparency multiplier
     , m_AmbientColorLoc(-1)                                        // Day/night ambient light
+    , m_PerspParams0Loc(-1)                                        // GPU perspective center/horizon
+    , m_PerspParams1Loc(-1)                                        // GPU perspective scales/flags
+    , m_InstancedLoc(-1)                                           // Instanced sprite expansion toggle
+    , m_UseColorOnlyLoc(-1)                                        // Texture/color mix mode
     , m_AmbientColor(1.0f, 1.0f, 1.0f)                             // Current ambient (white = full bright)
+    // Persistent vertex streams
+    , m_StreamSegment(0)                                           // Ring segment written this frame
+    , m_PersistentStreams(false)                                   // Enabled in SetupQuad() on GL 4.4+
     // Sprite batching
     , m_BatchVAO(0)                                                // VAO for batched sprites
     , m_BatchVBO(0)                                                // VBO for batched sprite vertices
-    , m_CurrentBatchTexture(0)                                     // Active texture for current batch
+    , m_BatchTextureCount(0)                                       // No texture slots claimed yet
+    , m_MultiTextureBatching(true)                                 // Batch across up to 8 textures
+    , m_BatchApplyPerspective(true)                                // Batch is projected in the shader
     // Colored rectangle batching
     , m_RectBatchVAO(0)                                            // VAO for colored rectangles
     , m_RectBatchVBO(0)                                            // VBO for rectangle vertices
@@ -76,6 +116,14 @@ OpenGLRenderer::OpenGLRenderer()
     m_BatchVertices.reserve(MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
     m_RectBatchVertices.reserve(MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
     m_ParticleBatchVertices.reserve(MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
+    for (GLsync &fence : m_StreamFences)
+    {
+        fence = nullptr;
+    }
+    for (unsigned int &slot : m_BatchTextures)
+    {
+        slot = 0;
+    }
 }
 
 OpenGLRenderer::~OpenGLRenderer()
@@ -91,7 +139,8 @@ void OpenGLRenderer::Shutdown()
         glDeleteTextures(1, &m_FontAtlasTexture);
         m_FontAtlasTexture = 0;
     }
-    m_Characters.clear();
+    m_Characters.Clear();
+    m_TextMeshes.Clear();
 
 #ifdef USE_FREETYPE
     // Cleanup FreeType
@@ -153,6 +202,78 @@ void OpenGLRenderer::Shutdown()
         glDeleteBuffers(1, &m_RectBatchVBO);
         m_RectBatchVBO = 0;
     }
+    if (m_InstanceVAO != 0)
+    {
+        glDeleteVertexArrays(1, &m_InstanceVAO);
+        m_InstanceVAO = 0;
+    }
+    if (m_InstanceVBO != 0)
+    {
+        glDeleteBuffers(1, &m_InstanceVBO);
+        m_InstanceVBO = 0;
+    }
+    m_InstanceCapacity = 0;
+    ReleaseGpuParticles();
+    if (m_ParticleComputeProgram != 0)
+    {
+        glDeleteProgram(m_ParticleComputeProgram);
+        m_ParticleComputeProgram = 0;
+    }
+    if (m_StarFieldVAO != 0)
+    {
+        glDeleteVertexArrays(1, &m_StarFieldVAO);
+        m_StarFieldVAO = 0;
+    }
+    if (m_StarFieldVBO != 0)
+    {
+        glDeleteBuffers(1, &m_StarFieldVBO);
+        m_StarFieldVBO = 0;
+    }
+    m_StarFieldCount = 0;
+    if (m_StarFieldProgram != 0)
+    {
+        glDeleteProgram(m_StarFieldProgram);
+        m_StarFieldProgram = 0;
+    }
+    if (m_GpuTimerQueries[0][0] != 0)
+    {
+        glDeleteQueries(GPU_TIMER_FRAMES * GpuTimerFrame::MAX_QUERIES, &m_GpuTimerQueries[0][0]);
+        m_GpuTimerQueries[0][0] = 0;
+    }
+    for (GpuTimerFrame &frame : m_GpuTimerFrames)
+    {
+        frame.Reset();
+    }
+    m_GpuTimerResults.clear();
+    DestroyLowResTarget();
+    m_LowResActive = false;
+    for (int target = 0; target < static_cast<int>(m_RenderTargets.size()); ++target)
+    {
+        DestroyRenderTarget(target);
+    }
+    m_RenderTargets.clear();
+    m_FreeRenderTargets.clear();
+    DestroyLightMapTarget();
+    m_LightMapActive = false;
+    if (m_LightFalloffTexture != 0)
+    {
+        glDeleteTextures(1, &m_LightFalloffTexture);
+        m_LightFalloffTexture = 0;
+    }
+    DestroyVertexStream(m_SpriteStream);
+    DestroyVertexStream(m_RectStream);
+    DestroyVertexStream(m_ParticleStream);
+    DestroyVertexStream(m_TextStream);
+    for (GLsync &fence : m_StreamFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    m_PersistentStreams = false;
+
     if (m_ShaderProgram != 0)
     {
         glDeleteProgram(m_ShaderProgram);
@@ -164,6 +285,13 @@ void OpenGLRenderer::Shutdown()
         m_WhiteTexture = 0;
     }
 
+    for (size_t i = 0; i < m_StaticMeshes.size(); ++i)
+    {
+        DestroyStaticMesh(static_cast<int>(i));
+    }
+    m_StaticMeshes.clear();
+    m_FreeStaticMeshes.clear();
+
     m_BatchVertices.clear();
     m_RectBatchVertices.clear();
 }
@@ -194,6 +322,7 @@ void OpenGLRenderer::Init()
     // Order matters geometry buffers first, then textures, then shaders.
     SetupQuad();
     CreateWhiteTexture();
+    glGenQueries(GPU_TIMER_FRAMES * GpuTimerFrame::MAX_QUERIES, &m_GpuTimerQueries[0][0]);
 
 #ifdef USE_FREETYPE
     // Try to load font from project assets, fall back to system fonts if needed
@@ -213,9 +342,9 @@ void OpenGLRenderer::Init()
             continue;
         }
 
-        size_t beforeCount = m_Characters.size();
+        size_t beforeCount = m_Characters.Size();
         LoadFont(fontPath);
-        if (m_Characters.size() > beforeCount)
+        if (m_Characters.Size() > beforeCount)
         {
             fontLoaded = true;
             break;
@@ -229,6 +358,20 @@ void OpenGLRenderer::Init()
 #else
     std::cerr << "WARNING: FreeType not available. Text rendering disabled." << std::endl;
 #endif
+    m_ShaderProgram = BuildSpriteProgram();
+    if (m_ShaderProgram == 0)
+    {
+        std::cerr << "ERROR: Failed to build the sprite shader!" << std::endl;
+        return;
+    }
+    CacheSpriteUniforms();
+
+    SetupParticleCompute();
+    SetupStarField();
+}
+
+unsigned int OpenGLRenderer::BuildSpriteProgram()
+{
     // Load and compile shaders from files
     std::string vertexShaderSource = LoadShaderFromFile("shaders/sprite.vert");
     std::string fragmentShaderSource = LoadShaderFromFile("shaders/sprite.frag");
@@ -236,59 +379,116 @@ void OpenGLRenderer::Init()
     if (vertexShaderSource.empty() || fragmentShaderSource.empty())
     {
         std::cerr << "ERROR: Failed to load shader files!" << std::endl;
-        return;
+        return 0;
     }
 
-    // Compile vertex shader
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    const char *vertexSourcePtr = vertexShaderSource.c_str();
-    glShaderSource(vertexShader, 1, &vertexSourcePtr, nullptr);
-    glCompileShader(vertexShader);
-
     int success;
     char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        glGetShaderInfoLog(vertexShader, 512, nullptr, infoLog);
-        std::cerr << "Vertex shader compilation failed: " << infoLog << std::endl;
-    }
-
-    // Compile fragment shader
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    const char *fragmentSourcePtr = fragmentShaderSource.c_str();
-    glShaderSource(fragmentShader, 1, &fragmentSourcePtr, nullptr);
-    glCompileShader(fragmentShader);
+    auto compile = [&](GLenum type, const std::string &source, const char *name) -> unsigned int
+    {
+        unsigned int shader = glCreateShader(type);
+        const char *sourcePtr = source.c_str();
+        glShaderSource(shader, 1, &sourcePtr, nullptr);
+        glCompileShader(shader);
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+            std::cerr << name << " shader compilation failed: " << infoLog << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    };
 
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if (!success)
+    unsigned int vertexShader = compile(GL_VERTEX_SHADER, vertexShaderSource, "Vertex");
+    unsigned int fragmentShader = compile(GL_FRAGMENT_SHADER, fragmentShaderSource, "Fragment");
+    if (vertexShader == 0 || fragmentShader == 0)
     {
-        glGetShaderInfoLog(fragmentShader, 512, nullptr, infoLog);
-        std::cerr << "Fragment shader compilation failed: " << infoLog << std::endl;
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
     }
 
     // Link shader program
-    m_ShaderProgram = glCreateProgram();
-    glAttachShader(m_ShaderProgram, vertexShader);
-    glAttachShader(m_ShaderProgram, fragmentShader);
-    glLinkProgram(m_ShaderProgram);
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
 
-    glGetProgramiv(m_ShaderProgram, GL_LINK_STATUS, &success);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success)
     {
-        glGetProgramInfoLog(m_ShaderProgram, 512, nullptr, infoLog);
+        glGetProgramInfoLog(program, 512, nullptr, infoLog);
         std::cerr << "Shader program linking failed: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
     }
+    return program;
+}
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
+void OpenGLRenderer::CacheSpriteUniforms()
+{
     // Cache uniform locations for performance
     m_ModelLoc = glGetUniformLocation(m_ShaderProgram, "model");
     m_ProjectionLoc = glGetUniformLocation(m_ShaderProgram, "projection");
     m_ColorLoc = glGetUniformLocation(m_ShaderProgram, "spriteColor");
     m_AlphaLoc = glGetUniformLocation(m_ShaderProgram, "spriteAlpha");
     m_AmbientColorLoc = glGetUniformLocation(m_ShaderProgram, "ambientColor");
+    m_PerspParams0Loc = glGetUniformLocation(m_ShaderProgram, "perspParams0");
+    m_PerspParams1Loc = glGetUniformLocation(m_ShaderProgram, "perspParams1");
+    m_InstancedLoc = glGetUniformLocation(m_ShaderProgram, "instanced");
+    m_UseColorOnlyLoc = glGetUniformLocation(m_ShaderProgram, "useColorOnly");
+    m_LightMapEnabledLoc = glGetUniformLocation(m_ShaderProgram, "lightMapEnabled");
+    m_LightMapRectLoc = glGetUniformLocation(m_ShaderProgram, "lightMapRect");
+}
+
+bool OpenGLRenderer::ReloadShaders()
+{
+    // A broken edit keeps the running program
+    unsigned int program = BuildSpriteProgram();
+    if (program == 0)
+        return false;
+
+    // Queued geometry was meant for the old program
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+
+    glDeleteProgram(m_ShaderProgram);
+    m_ShaderProgram = program;
+    CacheSpriteUniforms();
+    glUseProgram(m_ShaderProgram);
+    std::cout << "Reloaded sprite shaders" << std::endl;
+    return true;
+}
+
+void OpenGLRenderer::UploadPerspectiveUniforms(bool applyPerspective)
+{
+    // Zero parameters disable the shader projection, which is what CPU mode
+    // relies on since its vertices arrive already projected
+    glm::vec4 params0, params1;
+    GetShaderPerspective(applyPerspective, params0, params1);
+    glUniform4fv(m_PerspParams0Loc, 1, glm::value_ptr(params0));
+    glUniform4fv(m_PerspParams1Loc, 1, glm::value_ptr(params1));
+}
+
+void OpenGLRenderer::UploadLightUniforms()
+{
+    glUniform3f(m_AmbientColorLoc, m_AmbientColor.r, m_AmbientColor.g, m_AmbientColor.b);
+
+    // The map covers the world viewport, render targets have their own
+    const bool lightMap = m_LightMapActive && m_ActiveRenderTarget < 0;
+    glUniform1i(m_LightMapEnabledLoc, lightMap ? 1 : 0);
+    if (lightMap)
+    {
+        glUniform4fv(m_LightMapRectLoc, 1, glm::value_ptr(m_LightMapRect));
+        glActiveTexture(GL_TEXTURE0 + LIGHT_MAP_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, m_LightMapTexture);
+        glActiveTexture(GL_TEXTURE0);
+    }
 }
 
 void OpenGLRenderer::SetAmbientColor(const glm::vec3 &color)
@@ -300,161 +500,701 @@ void OpenGLRenderer::BeginFrame()
 {
     // Reset batch state at start of frame
     m_BatchVertices.clear();
-    m_CurrentBatchTexture = 0;
+    m_BatchTextureCount = 0;
     m_RectBatchVertices.clear();
     m_ParticleBatchVertices.clear();
     m_CurrentParticleTexture = 0;
     m_DrawCallCount = 0;
+    m_RenderStats.Reset();
+    m_TextMeshes.NextFrame();
+
+    AdvanceStreamSegment();
+    ResolveGpuTimers();
 }
 
 void OpenGLRenderer::EndFrame()
 {
     // Flush any remaining batched sprites, rects, and particles
-    FlushBatch();
-    FlushRectBatch();
-    FlushParticleBatch();
-}
+    FlushBatch(RenderStats::FlushReason::FrameEnd);
+    FlushRectBatch(RenderStats::FlushReason::FrameEnd);
+    FlushParticleBatch(RenderStats::FlushReason::FrameEnd);
+    ClearLightMap();
 
-void OpenGLRenderer::SetProjection(glm::mat4 projection)
-{
-    // Flush any pending batches before changing projection
-    // This prevents world-space sprites from being drawn with UI projection (or vice versa)
-    FlushBatch();
-    FlushRectBatch();
-    FlushParticleBatch();
-    m_Projection = projection;
+    // A pass left open would leave the next frame drawing offscreen
+    if (m_LowResActive)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        m_LowResActive = false;
+        m_LowResViewportChanged = true;
+    }
+    if (m_LowResViewportChanged && m_Viewport[2] > 0 && m_Viewport[3] > 0)
+    {
+        glViewport(m_Viewport[0], m_Viewport[1], m_Viewport[2], m_Viewport[3]);
+    }
+    m_LowResViewportChanged = false;
 }
 
-void OpenGLRenderer::SetViewport(int x, int y, int width, int height)
+void OpenGLRenderer::ResolveGpuTimers()
 {
-    glViewport(x, y, width, height);
+    m_GpuTimerSlot = (m_GpuTimerSlot + 1) % GPU_TIMER_FRAMES;
+    GpuTimerFrame &frame = m_GpuTimerFrames[m_GpuTimerSlot];
+    const uint32_t count = frame.GetQueryCount();
+    if (count > 0 && m_GpuTimerQueries[0][0] != 0)
+    {
+        // Queries complete in order, so the last one being ready means all are
+        GLint available = 0;
+        glGetQueryObjectiv(m_GpuTimerQueries[m_GpuTimerSlot][count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            uint64_t timestamps[GpuTimerFrame::MAX_QUERIES];
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                GLuint64 value = 0;
+                glGetQueryObjectui64v(m_GpuTimerQueries[m_GpuTimerSlot][i], GL_QUERY_RESULT, &value);
+                timestamps[i] = value;
+            }
+            frame.Resolve(timestamps, 1.0, ~0ull, m_GpuTimerResults);
+        }
+        // Otherwise the GPU is more than GPU_TIMER_FRAMES behind; drop this
+        // frame's timings instead of waiting for them
+    }
+    frame.Reset();
 }
 
-void OpenGLRenderer::SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale,
-                                                  float viewWidth, float viewHeight)
+void OpenGLRenderer::BeginGpuTimer(const char *name)
 {
+    if (m_GpuTimerQueries[0][0] == 0)
+        return;
+
+    // Batched draws recorded so far belong before the timestamp
     FlushBatch();
     FlushRectBatch();
     FlushParticleBatch();
-    IRenderer::SetVanishingPointPerspective(enabled, horizonY, horizonScale, viewWidth, viewHeight);
+
+    uint32_t query = m_GpuTimerFrames[m_GpuTimerSlot].Begin(name);
+    if (query != GpuTimerFrame::NO_QUERY)
+    {
+        glQueryCounter(m_GpuTimerQueries[m_GpuTimerSlot][query], GL_TIMESTAMP);
+    }
 }
 
-void OpenGLRenderer::SetGlobePerspective(bool enabled, float sphereRadius,
-                                         float viewWidth, float viewHeight)
+void OpenGLRenderer::EndGpuTimer()
 {
+    if (m_GpuTimerQueries[0][0] == 0)
+        return;
+
     FlushBatch();
     FlushRectBatch();
     FlushParticleBatch();
-    IRenderer::SetGlobePerspective(enabled, sphereRadius, viewWidth, viewHeight);
+
+    uint32_t query = m_GpuTimerFrames[m_GpuTimerSlot].End();
+    if (query != GpuTimerFrame::NO_QUERY)
+    {
+        glQueryCounter(m_GpuTimerQueries[m_GpuTimerSlot][query], GL_TIMESTAMP);
+    }
 }
 
-void OpenGLRenderer::SetFisheyePerspective(bool enabled, float sphereRadius,
-                                           float horizonY, float horizonScale,
-                                           float viewWidth, float viewHeight)
+bool OpenGLRenderer::BeginLowResPass(int width, int height)
 {
+    if (width <= 0 || height <= 0)
+        return false;
+
     FlushBatch();
     FlushRectBatch();
     FlushParticleBatch();
-    IRenderer::SetFisheyePerspective(enabled, sphereRadius, horizonY, horizonScale, viewWidth, viewHeight);
+
+    if (m_LowResFBO == 0 || width != m_LowResWidth || height != m_LowResHeight)
+    {
+        DestroyLowResTarget();
+        if (!CreateLowResTarget(width, height))
+            return false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LowResFBO);
+    glViewport(0, 0, width, height);
+    m_LowResActive = true;
+    return true;
 }
 
-void OpenGLRenderer::SuspendPerspective(bool suspend)
+void OpenGLRenderer::EndLowResPass(int x, int y, int width, int height)
 {
+    if (!m_LowResActive)
+        return;
+
     FlushBatch();
     FlushRectBatch();
     FlushParticleBatch();
-    IRenderer::SuspendPerspective(suspend);
+
+    // A blit copies texels without blending, so the target's alpha channel
+    // (left below 1 by translucent sprites) never reaches the window
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_LowResFBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, m_LowResWidth, m_LowResHeight,
+                      x, y, x + width, y + height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glViewport(x, y, width, height);
+    m_LowResActive = false;
+    m_LowResViewportChanged = true;
+
+    // The light map was laid over the target's viewport, not this one
+    ClearLightMap();
 }
 
-void OpenGLRenderer::Clear(float r, float g, float b, float a)
+bool OpenGLRenderer::CreateLowResTarget(int width, int height)
 {
-    glClearColor(r, g, b, a);
-    glClear(GL_COLOR_BUFFER_BIT);
+    glGenTextures(1, &m_LowResTexture);
+    glBindTexture(GL_TEXTURE_2D, m_LowResTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_LowResFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LowResFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_LowResTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Low-res framebuffer incomplete (0x" << std::hex << status << std::dec
+                  << "), drawing at window resolution" << std::endl;
+        DestroyLowResTarget();
+        return false;
+    }
+
+    m_LowResWidth = width;
+    m_LowResHeight = height;
+    return true;
 }
 
-void OpenGLRenderer::UploadTexture(const Texture &texture)
+void OpenGLRenderer::DestroyLowResTarget()
 {
-    // Recreate only if the texture does not belong to the active GL context generation.
-    const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
-    if (texture.GetID() == 0 || texture.m_OpenGLContextGeneration != currentGen)
+    if (m_LowResFBO != 0)
     {
-        const_cast<Texture &>(texture).RecreateOpenGLTexture();
+        glDeleteFramebuffers(1, &m_LowResFBO);
+        m_LowResFBO = 0;
+    }
+    if (m_LowResTexture != 0)
+    {
+        glDeleteTextures(1, &m_LowResTexture);
+        m_LowResTexture = 0;
     }
+    m_LowResWidth = 0;
+    m_LowResHeight = 0;
 }
 
-void OpenGLRenderer::SetupQuad()
+int OpenGLRenderer::CreateRenderTarget(int width, int height)
 {
-    // Unit quad vertices a 1x1 quad from (0,0) to (1,1)
-    // Each vertex has 4 floats position (x,y) and texture coords (u,v)
-    // This quad is used for immediate-mode sprite rendering (non-batched)
-    float vertices[] = {
-        // pos      // tex
-        0.0f, 1.0f, 0.0f, 1.0f,  // Bottom-left
-        1.0f, 0.0f, 1.0f, 0.0f,  // Top-right
-        0.0f, 0.0f, 0.0f, 0.0f,  // Top-left
-        0.0f, 1.0f, 0.0f, 1.0f,  // Bottom-left (second triangle)
-        1.0f, 1.0f, 1.0f, 1.0f,  // Bottom-right
-        1.0f, 0.0f, 1.0f, 0.0f}; // Top-right
+    if (width <= 0 || height <= 0)
+        return -1;
 
-    // Two triangles forming a quad (indices into vertex array)
-    unsigned int indices[] = {
-        0, 1, 2,  // First triangle
-        3, 4, 5}; // Second triangle
+    RenderTarget target;
+    target.width = width;
+    target.height = height;
 
-    // Generate OpenGL objects for the unit quad
-    glGenVertexArrays(1, &m_VAO);
-    glGenBuffers(1, &m_VBO);
-    glGenBuffers(1, &m_EBO);
+    // Half-float so dozens of faint additive layers accumulate without banding
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    glBindVertexArray(m_VAO);
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
 
-    // Upload vertex data (static since unit quad never changes)
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Render target framebuffer incomplete (0x" << std::hex << status << std::dec << ")"
+                  << std::endl;
+        glDeleteFramebuffers(1, &target.fbo);
+        glDeleteTextures(1, &target.texture);
+        return -1;
+    }
 
-    // Upload index data
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    int handle;
+    if (!m_FreeRenderTargets.empty())
+    {
+        handle = m_FreeRenderTargets.back();
+        m_FreeRenderTargets.pop_back();
+        m_RenderTargets[handle] = target;
+    }
+    else
+    {
+        handle = static_cast<int>(m_RenderTargets.size());
+        m_RenderTargets.push_back(target);
+    }
+    return handle;
+}
 
-    // Configure vertex attributes layout matches shader inputs
-    // Location 0: position (2 floats at offset 0)
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
-    glEnableVertexAttribArray(0);
+bool OpenGLRenderer::BeginRenderTarget(int target)
+{
+    if (target < 0 || target >= static_cast<int>(m_RenderTargets.size()) ||
+        m_RenderTargets[target].fbo == 0 || m_ActiveRenderTarget >= 0)
+        return false;
 
-    // Location 1: texture coords (2 floats at offset 8 bytes)
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
 
-    // Location 2: color disabled here, used only by colored rect/particle batches
-    glDisableVertexAttribArray(2);
+    // The low-res pass or the window may be bound, restore whichever it was
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    m_RenderTargetPreviousFBO = static_cast<unsigned int>(previous);
+    glGetIntegerv(GL_VIEWPORT, m_RenderTargetPreviousViewport);
 
-    glBindVertexArray(0);
+    const RenderTarget &rt = m_RenderTargets[target];
+    glBindFramebuffer(GL_FRAMEBUFFER, rt.fbo);
+    glViewport(0, 0, rt.width, rt.height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    m_ActiveRenderTarget = target;
+    return true;
+}
 
-    // Text uses dynamic batching all characters in a DrawText call are
-    // uploaded at once and drawn with two draw calls (outline + main text)
-    glGenVertexArrays(1, &m_TextVAO);
-    glGenBuffers(1, &m_TextVBO);
+void OpenGLRenderer::EndRenderTarget()
+{
+    if (m_ActiveRenderTarget < 0)
+        return;
 
-    glBindVertexArray(m_TextVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_TextVBO);
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
 
-    // Pre-allocate buffer for text quads (6 vertices per character, dynamic for frequent updates)
-    glBufferData(GL_ARRAY_BUFFER, MAX_TEXT_QUADS * 6 * sizeof(TextVertex), nullptr, GL_DYNAMIC_DRAW);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_RenderTargetPreviousFBO);
+    glViewport(m_RenderTargetPreviousViewport[0], m_RenderTargetPreviousViewport[1],
+               m_RenderTargetPreviousViewport[2], m_RenderTargetPreviousViewport[3]);
+    m_ActiveRenderTarget = -1;
+}
 
-    // Same vertex layout as sprites position + texcoord
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glDisableVertexAttribArray(2); // Text uses uniform color, not per-vertex
+void OpenGLRenderer::DrawRenderTarget(int target, glm::vec2 position, glm::vec2 size, bool additive)
+{
+    if (target < 0 || target >= static_cast<int>(m_RenderTargets.size()) ||
+        m_RenderTargets[target].fbo == 0 || target == m_ActiveRenderTarget)
+        return;
 
-    glBindVertexArray(0);
-    m_TextBatchVertices.reserve(MAX_TEXT_QUADS * 6);
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
 
-    // Sprites are batched by texture all sprites using the same texture are
-    // collected and drawn in a single draw call to minimize state changes
-    glGenVertexArrays(1, &m_BatchVAO);
-    glGenBuffers(1, &m_BatchVBO);
+    // Contents are premultiplied, so neither mode multiplies by source alpha.
+    // The quad goes through the particle batch as a non-additive draw, which
+    // leaves the blend function set here alone.
+    glBlendFunc(GL_ONE, additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+    PushParticleQuad(m_RenderTargets[target].texture, position, size, glm::vec2(0.0f), glm::vec2(1.0f), 0.0f,
+                     glm::vec4(1.0f), false);
+    FlushParticleBatch();
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void OpenGLRenderer::DestroyRenderTarget(int target)
+{
+    if (target < 0 || target >= static_cast<int>(m_RenderTargets.size()) || m_RenderTargets[target].fbo == 0)
+        return;
+
+    if (target == m_ActiveRenderTarget)
+        EndRenderTarget();
+
+    RenderTarget &rt = m_RenderTargets[target];
+    glDeleteFramebuffers(1, &rt.fbo);
+    glDeleteTextures(1, &rt.texture);
+    rt = RenderTarget{};
+    m_FreeRenderTargets.push_back(target);
+}
+
+bool OpenGLRenderer::SetLightMap(glm::vec2 viewSize, float cellSize, const Light *lights, size_t count)
+{
+    m_LightMapActive = false;
+    if (viewSize.x <= 0.0f || viewSize.y <= 0.0f || cellSize <= 0.0f || m_ActiveRenderTarget >= 0)
+        return false;
+
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+
+    const int width = std::max(1, static_cast<int>(std::ceil(viewSize.x / cellSize)));
+    const int height = std::max(1, static_cast<int>(std::ceil(viewSize.y / cellSize)));
+    if (m_LightMapFBO == 0 || width != m_LightMapWidth || height != m_LightMapHeight)
+    {
+        DestroyLightMapTarget();
+        if (!CreateLightMapTarget(width, height))
+            return false;
+    }
+    if (m_LightFalloffTexture == 0)
+    {
+        CreateLightFalloffTexture();
+    }
+
+    // The map spans whatever viewport the world is drawn into, the low-res
+    // target or the window, so sprites find their texel from gl_FragCoord
+    GLint viewport[4] = {};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (viewport[2] <= 0 || viewport[3] <= 0)
+        return false;
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LightMapFBO);
+    glViewport(0, 0, width, height);
+    glClearColor(m_AmbientColor.r, m_AmbientColor.g, m_AmbientColor.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Only the centers are projected, falloffs stay round like the glow sprites
+    m_LightCenterX.resize(count);
+    m_LightCenterY.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_LightCenterX[i] = lights[i].position.x;
+        m_LightCenterY[i] = lights[i].position.y;
+    }
+    ProjectPoints(m_LightCenterX.data(), m_LightCenterY.data(), count);
+
+    m_LightInstances.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float radius = lights[i].radius;
+        if (radius <= 0.0f)
+            continue;
+        const glm::vec2 center(m_LightCenterX[i], m_LightCenterY[i]);
+        m_LightInstances.push_back(MakeSpriteInstance(center - glm::vec2(radius), glm::vec2(radius * 2.0f),
+                                                      glm::vec2(0.0f), glm::vec2(1.0f), 0.0f,
+                                                      glm::vec4(lights[i].color, 1.0f)));
+    }
+
+    if (!m_LightInstances.empty() && m_LightFalloffTexture != 0)
+    {
+        UploadInstances(m_LightInstances.data(), m_LightInstances.size());
+        glUseProgram(m_ShaderProgram);
+
+        // Lights add up on top of the ambient clear
+        glBlendFunc(GL_ONE, GL_ONE);
+        glm::mat4 identity = glm::mat4(1.0f);
+        glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(identity));
+        glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+        UploadPerspectiveUniforms(false);
+        glUniform1i(m_UseColorOnlyLoc, 3);
+        glUniform1i(m_InstancedLoc, 1);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, m_LightFalloffTexture);
+
+        const size_t instanceCount = m_LightInstances.size();
+        glBindVertexArray(m_InstanceVAO);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(VERTICES_PER_SPRITE),
+                              static_cast<GLsizei>(instanceCount));
+        DebugAfterDraw("LightMap", static_cast<int>(instanceCount * VERTICES_PER_SPRITE));
+        glBindVertexArray(0);
+        ++m_DrawCallCount;
+        m_RenderStats.vertices += instanceCount * VERTICES_PER_SPRITE;
+
+        glUniform1i(m_InstancedLoc, 0);
+        glUniform1i(m_UseColorOnlyLoc, 0);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    m_LightMapRect = glm::vec4(static_cast<float>(viewport[0]), static_cast<float>(viewport[1]),
+                               1.0f / static_cast<float>(viewport[2]), 1.0f / static_cast<float>(viewport[3]));
+    m_LightMapActive = true;
+    return true;
+}
+
+void OpenGLRenderer::ClearLightMap()
+{
+    if (!m_LightMapActive)
+        return;
+
+    // Queued sprites were meant to be lit
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    m_LightMapActive = false;
+
+    // Draws that reuse the last uniforms must not sample the stale map
+    glUseProgram(m_ShaderProgram);
+    glUniform1i(m_LightMapEnabledLoc, 0);
+}
+
+bool OpenGLRenderer::CreateLightMapTarget(int width, int height)
+{
+    // Half-float holds lights brighter than white until the sprite shader
+    // clamps them, and linear filtering smooths the coarse texels
+    glGenTextures(1, &m_LightMapTexture);
+    glBindTexture(GL_TEXTURE_2D, m_LightMapTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_HALF_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &m_LightMapFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_LightMapFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_LightMapTexture, 0);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Light map framebuffer incomplete (0x" << std::hex << status << std::dec
+                  << "), using flat ambient light" << std::endl;
+        DestroyLightMapTarget();
+        return false;
+    }
+
+    m_LightMapWidth = width;
+    m_LightMapHeight = height;
+    return true;
+}
+
+void OpenGLRenderer::DestroyLightMapTarget()
+{
+    if (m_LightMapFBO != 0)
+    {
+        glDeleteFramebuffers(1, &m_LightMapFBO);
+        m_LightMapFBO = 0;
+    }
+    if (m_LightMapTexture != 0)
+    {
+        glDeleteTextures(1, &m_LightMapTexture);
+        m_LightMapTexture = 0;
+    }
+    m_LightMapWidth = 0;
+    m_LightMapHeight = 0;
+}
+
+void OpenGLRenderer::CreateLightFalloffTexture()
+{
+    // Smooth (1 - d^2)^2 falloff in RGB; alpha stays opaque so sprite.frag's
+    // alpha cutout never drops the faint rim of a light
+    constexpr int SIZE = 64;
+    std::vector<unsigned char> pixels(static_cast<size_t>(SIZE) * SIZE * 4);
+    for (int y = 0; y < SIZE; ++y)
+    {
+        for (int x = 0; x < SIZE; ++x)
+        {
+            const float dx = (static_cast<float>(x) + 0.5f) / SIZE * 2.0f - 1.0f;
+            const float dy = (static_cast<float>(y) + 0.5f) / SIZE * 2.0f - 1.0f;
+            const float falloff = std::max(0.0f, 1.0f - (dx * dx + dy * dy));
+            const auto value = static_cast<unsigned char>(std::lround(falloff * falloff * 255.0f));
+            unsigned char *pixel = &pixels[(static_cast<size_t>(y) * SIZE + x) * 4];
+            pixel[0] = value;
+            pixel[1] = value;
+            pixel[2] = value;
+            pixel[3] = 255;
+        }
+    }
+
+    glGenTextures(1, &m_LightFalloffTexture);
+    glBindTexture(GL_TEXTURE_2D, m_LightFalloffTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, SIZE, SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void OpenGLRenderer::SetProjection(glm::mat4 projection)
+{
+    // Flush any pending batches before changing projection
+    // This prevents world-space sprites from being drawn with UI projection (or vice versa)
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    m_Projection = projection;
+}
+
+void OpenGLRenderer::SetViewport(int x, int y, int width, int height)
+{
+    m_Viewport[0] = x;
+    m_Viewport[1] = y;
+    m_Viewport[2] = width;
+    m_Viewport[3] = height;
+    glViewport(x, y, width, height);
+}
+
+void OpenGLRenderer::SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale,
+                                                  float viewWidth, float viewHeight)
+{
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    IRenderer::SetVanishingPointPerspective(enabled, horizonY, horizonScale, viewWidth, viewHeight);
+}
+
+void OpenGLRenderer::SetGlobePerspective(bool enabled, float sphereRadius,
+                                         float viewWidth, float viewHeight)
+{
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    IRenderer::SetGlobePerspective(enabled, sphereRadius, viewWidth, viewHeight);
+}
+
+void OpenGLRenderer::SetFisheyePerspective(bool enabled, float sphereRadius,
+                                           float horizonY, float horizonScale,
+                                           float viewWidth, float viewHeight)
+{
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    IRenderer::SetFisheyePerspective(enabled, sphereRadius, horizonY, horizonScale, viewWidth, viewHeight);
+}
+
+void OpenGLRenderer::SuspendPerspective(bool suspend)
+{
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    IRenderer::SuspendPerspective(suspend);
+}
+
+void OpenGLRenderer::SetGpuProjection(bool enabled)
+{
+    // Pending vertices were built for the previous mode
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+    IRenderer::SetGpuProjection(enabled);
+}
+
+void OpenGLRenderer::SetMultiTextureBatching(bool enabled)
+{
+    FlushBatch();
+    m_MultiTextureBatching = enabled;
+}
+
+void OpenGLRenderer::Clear(float r, float g, float b, float a)
+{
+    glClearColor(r, g, b, a);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void OpenGLRenderer::UploadTexture(const Texture &texture)
+{
+    // Recreate only if the texture does not belong to the active GL context generation.
+    const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
+    if (texture.GetID() == 0 || texture.m_OpenGLContextGeneration != currentGen)
+    {
+        const_cast<Texture &>(texture).RecreateOpenGLTexture();
+    }
+}
+
+void OpenGLRenderer::ReleaseTexture(Texture &texture)
+{
+    // The open sprite batch may still sample it
+    if (!m_BatchVertices.empty())
+    {
+        for (int slot = 0; slot < m_BatchTextureCount; ++slot)
+        {
+            if (m_BatchTextures[slot] == texture.GetID())
+            {
+                FlushBatch();
+                break;
+            }
+        }
+    }
+
+    // Runs on the render thread when pipelined, where the context is current
+    texture.DestroyOpenGLTexture();
+}
+
+bool OpenGLRenderer::UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height)
+{
+    // Draws already batched must still see the old texels
+    FlushBatch();
+    return const_cast<Texture &>(texture).UpdateOpenGLRegion(x, y, width, height);
+}
+
+void OpenGLRenderer::SetupQuad()
+{
+    // Unit quad vertices a 1x1 quad from (0,0) to (1,1)
+    // Each vertex has 4 floats position (x,y) and texture coords (u,v)
+    // This quad is used for immediate-mode sprite rendering (non-batched)
+    float vertices[] = {
+        // pos      // tex
+        0.0f, 1.0f, 0.0f, 1.0f,  // Bottom-left
+        1.0f, 0.0f, 1.0f, 0.0f,  // Top-right
+        0.0f, 0.0f, 0.0f, 0.0f,  // Top-left
+        0.0f, 1.0f, 0.0f, 1.0f,  // Bottom-left (second triangle)
+        1.0f, 1.0f, 1.0f, 1.0f,  // Bottom-right
+        1.0f, 0.0f, 1.0f, 0.0f}; // Top-right
+
+    // Two triangles forming a quad (indices into vertex array)
+    unsigned int indices[] = {
+        0, 1, 2,  // First triangle
+        3, 4, 5}; // Second triangle
+
+    // Generate OpenGL objects for the unit quad
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+
+    glBindVertexArray(m_VAO);
+
+    // Upload vertex data (static since unit quad never changes)
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    // Upload index data
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    // Configure vertex attributes layout matches shader inputs
+    // Location 0: position (2 floats at offset 0)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
+    glEnableVertexAttribArray(0);
+
+    // Location 1: texture coords (2 floats at offset 8 bytes)
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // Location 2: color disabled here, used only by colored rect/particle batches
+    glDisableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+
+    // Text uses dynamic batching all characters in a DrawText call are
+    // uploaded at once and drawn with two draw calls (outline + main text)
+    glGenVertexArrays(1, &m_TextVAO);
+    glGenBuffers(1, &m_TextVBO);
+
+    glBindVertexArray(m_TextVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_TextVBO);
+
+    // Pre-allocate buffer for text quads (6 vertices per character, dynamic for frequent updates)
+    glBufferData(GL_ARRAY_BUFFER, MAX_TEXT_QUADS * 6 * sizeof(TextVertex), nullptr, GL_DYNAMIC_DRAW);
+
+    // Same vertex layout as sprites position + texcoord
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glDisableVertexAttribArray(2); // Text uses uniform color, not per-vertex
+
+    glBindVertexArray(0);
+
+    // Sprites are batched by texture all sprites using the same texture are
+    // collected and drawn in a single draw call to minimize state changes
+    glGenVertexArrays(1, &m_BatchVAO);
+    glGenBuffers(1, &m_BatchVBO);
 
     glBindVertexArray(m_BatchVAO);
     glBindBuffer(GL_ARRAY_BUFFER, m_BatchVBO);
@@ -463,12 +1203,8 @@ void OpenGLRenderer::SetupQuad()
     size_t batchBufferSize = MAX_BATCH_SPRITES * VERTICES_PER_SPRITE * sizeof(BatchVertex);
     glBufferData(GL_ARRAY_BUFFER, batchBufferSize, nullptr, GL_DYNAMIC_DRAW);
 
-    // Vertex layout position (xy) + texcoord (uv), no color
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void *)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void *)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glDisableVertexAttribArray(2); // Sprites use uniform color
+    // Vertex layout position (xy) + texcoord (uv) + texture slot, no color
+    SetupBatchVertexLayout(sizeof(BatchVertex), false, true);
 
     glBindVertexArray(0);
 
@@ -492,6 +1228,148 @@ void OpenGLRenderer::SetupQuad()
     glEnableVertexAttribArray(2);
 
     glBindVertexArray(0);
+
+    SetupInstanceBuffers();
+
+    // GL 4.4+ persistent rings that the batchers write into directly,
+    // the buffers above stay as the fallback for older drivers
+    m_PersistentStreams = GLAD_GL_VERSION_4_4 && glBufferStorage != nullptr;
+    if (m_PersistentStreams)
+    {
+        const size_t batchVertices = MAX_BATCH_SPRITES * VERTICES_PER_SPRITE;
+        CreateVertexStream(m_SpriteStream, sizeof(BatchVertex), batchVertices, false, true);
+        CreateVertexStream(m_RectStream, sizeof(ColoredVertex), batchVertices, true, false);
+        CreateVertexStream(m_ParticleStream, sizeof(ColoredVertex), batchVertices, true, false);
+        CreateVertexStream(m_TextStream, sizeof(TextVertex), MAX_TEXT_QUADS * 6 * 4, false, false);
+        std::cout << "OpenGL: using persistent mapped vertex streams (" << STREAM_SEGMENTS
+                  << " segments)" << std::endl;
+    }
+}
+
+void OpenGLRenderer::SetupInstanceBuffers()
+{
+    // No per-vertex buffer: sprite.vert picks the quad corner from gl_VertexID
+    // and reads everything else from one SpriteInstance per instance
+    glGenVertexArrays(1, &m_InstanceVAO);
+    glGenBuffers(1, &m_InstanceVBO);
+
+    glBindVertexArray(m_InstanceVAO);
+    SetupInstanceAttributes(m_InstanceVBO);
+    glBindVertexArray(0);
+}
+
+void OpenGLRenderer::SetupInstanceAttributes(unsigned int buffer)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    const GLsizei stride = sizeof(SpriteInstance);
+    for (GLuint location = 0; location < 4; ++location)
+    {
+        glDisableVertexAttribArray(location);
+    }
+
+    // Location 4: position (xy) + size (zw)
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(SpriteInstance, position));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    // Location 5: UV rect as normalized 16-bit values
+    glVertexAttribPointer(5, 4, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void *)offsetof(SpriteInstance, uvRect));
+    glEnableVertexAttribArray(5);
+    glVertexAttribDivisor(5, 1);
+
+    // Location 6: rotation + flags, kept as integers
+    glVertexAttribIPointer(6, 2, GL_UNSIGNED_SHORT, stride, (void *)offsetof(SpriteInstance, rotation));
+    glEnableVertexAttribArray(6);
+    glVertexAttribDivisor(6, 1);
+
+    // Location 7: RGBA8 color
+    glVertexAttribPointer(7, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *)offsetof(SpriteInstance, color));
+    glEnableVertexAttribArray(7);
+    glVertexAttribDivisor(7, 1);
+}
+
+void OpenGLRenderer::CreateVertexStream(VertexStream &stream, size_t vertexSize, size_t segmentVertices,
+                                        bool hasColor, bool hasTexSlot)
+{
+    stream.vertexSize = vertexSize;
+    stream.segmentBytes = vertexSize * segmentVertices;
+    stream.head = 0;
+
+    // Immutable storage mapped once for the lifetime of the renderer. Coherent
+    // mapping makes CPU writes visible to later draws without explicit flushes
+    const GLsizeiptr totalBytes = static_cast<GLsizeiptr>(stream.segmentBytes * STREAM_SEGMENTS);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenVertexArrays(1, &stream.vao);
+    glGenBuffers(1, &stream.vbo);
+    glBindVertexArray(stream.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.vbo);
+    glBufferStorage(GL_ARRAY_BUFFER, totalBytes, nullptr, flags);
+    stream.mapped = static_cast<unsigned char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, totalBytes, flags));
+    SetupBatchVertexLayout(static_cast<GLsizei>(vertexSize), hasColor, hasTexSlot);
+    glBindVertexArray(0);
+
+    if (!stream.mapped)
+    {
+        // Batches using this stream fall back to the staging path
+        std::cerr << "WARNING: persistent mapping failed, using buffer orphaning for this batch type" << std::endl;
+        DestroyVertexStream(stream);
+    }
+}
+
+void OpenGLRenderer::DestroyVertexStream(VertexStream &stream)
+{
+    if (stream.mapped)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, stream.vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        stream.mapped = nullptr;
+    }
+    if (stream.vao != 0)
+    {
+        glDeleteVertexArrays(1, &stream.vao);
+        stream.vao = 0;
+    }
+    if (stream.vbo != 0)
+    {
+        glDeleteBuffers(1, &stream.vbo);
+        stream.vbo = 0;
+    }
+    stream.head = 0;
+}
+
+void OpenGLRenderer::AdvanceStreamSegment()
+{
+    if (!m_PersistentStreams)
+        return;
+
+    // Everything drawn from the segment so far completes with this fence
+    if (m_StreamFences[m_StreamSegment])
+    {
+        glDeleteSync(m_StreamFences[m_StreamSegment]);
+    }
+    m_StreamFences[m_StreamSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_StreamSegment = (m_StreamSegment + 1) % STREAM_SEGMENTS;
+
+    // Only blocks when the GPU is more than two frames behind
+    GLsync fence = m_StreamFences[m_StreamSegment];
+    if (fence)
+    {
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, 0, 1000000);
+        }
+        glDeleteSync(fence);
+        m_StreamFences[m_StreamSegment] = nullptr;
+    }
+
+    m_SpriteStream.head = 0;
+    m_RectStream.head = 0;
+    m_ParticleStream.head = 0;
+    m_TextStream.head = 0;
 }
 
 void OpenGLRenderer::DrawSprite(const Texture &texture, glm::vec2 position, glm::vec2 size,
@@ -508,7 +1386,7 @@ void OpenGLRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position
     // When switching between batch types (rect vs sprite) or textures, flush first.
     if (!m_RectBatchVertices.empty())
     {
-        FlushRectBatch();
+        FlushRectBatch(RenderStats::FlushReason::BatchSwitch);
     }
 
     unsigned int texID = texture.GetID();
@@ -521,21 +1399,29 @@ void OpenGLRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position
             return;
     }
 
-    // Texture change forces a flush, sprites with different textures can't be batched.
-    // Use batch-content check instead of m_CurrentBatchTexture!=0 so an invalid
-    // texture ID (0) cannot contaminate subsequent sprites in the same batch.
-    if (!m_BatchVertices.empty() && m_CurrentBatchTexture != texID)
+    // In GPU projection mode warped quads share this batch unprojected,
+    // so a batch can only hold one kind
+    if (!m_BatchVertices.empty() && m_GpuProjection && !m_BatchApplyPerspective)
     {
         FlushBatch();
     }
 
-    // Batch full, flush and start new batch
-    if (m_BatchVertices.size() >= MAX_BATCH_SPRITES * VERTICES_PER_SPRITE)
+    // Batch (or its stream segment) full, flush and start new batch
+    if (!m_BatchVertices.HasRoom(VERTICES_PER_SPRITE))
     {
-        FlushBatch();
+        FlushBatch(RenderStats::FlushReason::BufferFull);
+    }
+
+    // A texture that is not in the batch and finds no free slot forces a flush
+    int texSlot = AcquireBatchTextureSlot(texID);
+    if (texSlot < 0)
+    {
+        FlushBatch(RenderStats::FlushReason::TextureChange);
+        texSlot = AcquireBatchTextureSlot(texID);
     }
+    OpenStreamBatch(m_BatchVertices, m_SpriteStream, MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
 
-    m_CurrentBatchTexture = texID;
+    m_BatchApplyPerspective = true;
 
     // Convert pixel coordinates to normalized UV coordinates (0-1 range)
     float texX = texCoord.x / texture.GetWidth();
@@ -565,6 +1451,7 @@ void OpenGLRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position
 
     // Build quad corners in local space, origin at top-left of sprite
     // Vertices are pre-transformed on CPU to allow batching sprites with different transforms
+    // (perspective is left to sprite.vert in GPU projection mode)
     glm::vec2 corners[4] = {
         {0.0f, 0.0f},     // Top-left
         {size.x, 0.0f},   // Top-right
@@ -592,13 +1479,14 @@ void OpenGLRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position
 
     // Assemble quad as two triangles (6 vertices total)
     // Using counter-clockwise winding for front-facing
-    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y}); // TL
-    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y}); // BR
-    m_BatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y}); // BL
-
-    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y}); // TL
-    m_BatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y}); // TR
-    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y}); // BR
+    const float slot = static_cast<float>(texSlot);
+    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, slot}); // TL
+    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, slot}); // BR
+    m_BatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y, slot}); // BL
+
+    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, slot}); // TL
+    m_BatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y, slot}); // TR
+    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, slot}); // BR
 }
 
 void OpenGLRenderer::DrawSpriteAlpha(const Texture &texture, glm::vec2 position, glm::vec2 size,
@@ -615,9 +1503,9 @@ void OpenGLRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position,
 
     // Must flush other batch types before adding to particle batch
     if (!m_BatchVertices.empty())
-        FlushBatch();
+        FlushBatch(RenderStats::FlushReason::BatchSwitch);
     if (!m_RectBatchVertices.empty())
-        FlushRectBatch();
+        FlushRectBatch(RenderStats::FlushReason::BatchSwitch);
 
     unsigned int texID = texture.GetID();
     const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
@@ -629,20 +1517,28 @@ void OpenGLRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position,
             return;
     }
 
+    PushParticleQuad(texID, position, size, uvMin, uvMax, rotation, color, additive);
+}
+
+void OpenGLRenderer::PushParticleQuad(unsigned int texID, glm::vec2 position, glm::vec2 size,
+                                      glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
+                                      glm::vec4 color, bool additive)
+{
     // Flush particle batch if texture or blend mode changed.
     // Same rule as sprite batch: once vertices exist, texture mismatch must flush
     // even if previous texture ID was 0.
     if (!m_ParticleBatchVertices.empty() &&
         (m_CurrentParticleTexture != texID || m_ParticleBatchAdditive != additive))
     {
-        FlushParticleBatch();
+        FlushParticleBatch(m_CurrentParticleTexture != texID ? RenderStats::FlushReason::TextureChange : RenderStats::FlushReason::BlendChange);
     }
 
     // Check batch capacity
-    if (m_ParticleBatchVertices.size() >= MAX_BATCH_SPRITES * VERTICES_PER_SPRITE)
+    if (!m_ParticleBatchVertices.HasRoom(VERTICES_PER_SPRITE))
     {
-        FlushParticleBatch();
+        FlushParticleBatch(RenderStats::FlushReason::BufferFull);
     }
+    OpenStreamBatch(m_ParticleBatchVertices, m_ParticleStream, MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
 
     m_CurrentParticleTexture = texID;
     m_ParticleBatchAdditive = additive;
@@ -658,46 +1554,540 @@ void OpenGLRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position,
         {size.x, size.y},
         {0.0f, size.y}};
 
-    RotateCorners(corners, size, rotation);
+    RotateCorners(corners, size, rotation);
+
+    // Translate to world position
+    for (int i = 0; i < 4; i++)
+    {
+        corners[i] += position;
+    }
+
+    ApplyPerspective(corners);
+
+    // UV coordinates (OpenGL Y flipped)
+    glm::vec2 uvs[4] = {
+        {u0, v1}, // Top-left
+        {u1, v1}, // Top-right
+        {u1, v0}, // Bottom-right
+        {u0, v0}  // Bottom-left
+    };
+
+    // Add 6 vertices (2 triangles) with per-vertex color to batch
+    float r = color.r, g = color.g, b = color.b, a = color.a;
+    m_ParticleBatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, r, g, b, a});
+    m_ParticleBatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, r, g, b, a});
+    m_ParticleBatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y, r, g, b, a});
+
+    m_ParticleBatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, r, g, b, a});
+    m_ParticleBatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y, r, g, b, a});
+    m_ParticleBatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, r, g, b, a});
+}
+
+void OpenGLRenderer::DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances,
+                                         size_t count, bool additive)
+{
+    if (count == 0)
+        return;
+
+    // Quads are expanded in the shader, so CPU perspective has no corners
+    // to project, route through the particle batch instead
+    if (IsPerspectiveActive() && !m_GpuProjection)
+    {
+        IRenderer::DrawSpriteInstances(texture, instances, count, additive);
+        return;
+    }
+
+    unsigned int texID = texture.GetID();
+    const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
+    if (texture.m_OpenGLContextGeneration != currentGen || texID == 0)
+    {
+        const_cast<Texture &>(texture).RecreateOpenGLTexture();
+        texID = texture.GetID();
+        if (texID == 0)
+            return;
+    }
+
+    // Keep draw order with anything already batched
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+
+    UploadInstances(instances, count);
+    glUseProgram(m_ShaderProgram);
+
+    if (additive)
+    {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    }
+
+    glm::mat4 identity = glm::mat4(1.0f);
+    glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+    UploadPerspectiveUniforms(true);
+
+    // Same shading as the particle batch: texture * per-sprite color
+    glUniform1i(m_UseColorOnlyLoc, 3);
+    glUniform1i(m_InstancedLoc, 1);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texID);
+
+    glBindVertexArray(m_InstanceVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(VERTICES_PER_SPRITE), static_cast<GLsizei>(count));
+    DebugAfterDraw("SpriteInstances", static_cast<int>(count * VERTICES_PER_SPRITE));
+    glBindVertexArray(0);
+    ++m_DrawCallCount;
+    m_RenderStats.vertices += count * VERTICES_PER_SPRITE;
+
+    // Restore state
+    glUniform1i(m_InstancedLoc, 0);
+    glUniform1i(m_UseColorOnlyLoc, 0);
+    if (additive)
+    {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+void OpenGLRenderer::UploadInstances(const SpriteInstance *instances, size_t count)
+{
+    // Orphan and regrow instead of capping the batch, growth is amortized
+    glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+    const size_t dataSize = count * sizeof(SpriteInstance);
+    if (count > m_InstanceCapacity)
+    {
+        m_InstanceCapacity = std::max(count, m_InstanceCapacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, m_InstanceCapacity * sizeof(SpriteInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, instances);
+}
+
+// Size of one particle slot, the std430 Particle struct in shaders/particles.comp
+static constexpr size_t GPU_PARTICLE_BYTES = 40;
+
+void OpenGLRenderer::SetupParticleCompute()
+{
+    // Compute shaders are core in 4.3; without them ParticleSystem stays on the CPU
+    if (!GLAD_GL_VERSION_4_3)
+    {
+        return;
+    }
+
+    std::string computeSource = LoadShaderFromFile("shaders/particles.comp");
+    if (computeSource.empty())
+    {
+        std::cerr << "WARNING: GPU particles disabled, particles.comp not found" << std::endl;
+        return;
+    }
+
+    unsigned int computeShader = glCreateShader(GL_COMPUTE_SHADER);
+    const char *computeSourcePtr = computeSource.c_str();
+    glShaderSource(computeShader, 1, &computeSourcePtr, nullptr);
+    glCompileShader(computeShader);
+
+    int success;
+    char infoLog[512];
+    glGetShaderiv(computeShader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(computeShader, 512, nullptr, infoLog);
+        std::cerr << "Particle compute shader compilation failed: " << infoLog << std::endl;
+        glDeleteShader(computeShader);
+        return;
+    }
+
+    m_ParticleComputeProgram = glCreateProgram();
+    glAttachShader(m_ParticleComputeProgram, computeShader);
+    glLinkProgram(m_ParticleComputeProgram);
+    glDeleteShader(computeShader);
+
+    glGetProgramiv(m_ParticleComputeProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(m_ParticleComputeProgram, 512, nullptr, infoLog);
+        std::cerr << "Particle compute program linking failed: " << infoLog << std::endl;
+        glDeleteProgram(m_ParticleComputeProgram);
+        m_ParticleComputeProgram = 0;
+    }
+}
+
+void OpenGLRenderer::SetupStarField()
+{
+    std::string vertexSource = LoadShaderFromFile("shaders/stars.vert");
+    std::string fragmentSource = LoadShaderFromFile("shaders/stars.frag");
+    if (vertexSource.empty() || fragmentSource.empty())
+    {
+        std::cerr << "WARNING: GPU star field disabled, stars.vert/stars.frag not found" << std::endl;
+        return;
+    }
+
+    int success;
+    char infoLog[512];
+    auto compile = [&](GLenum type, const std::string &source, const char *name) -> unsigned int
+    {
+        unsigned int shader = glCreateShader(type);
+        const char *sourcePtr = source.c_str();
+        glShaderSource(shader, 1, &sourcePtr, nullptr);
+        glCompileShader(shader);
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+        if (!success)
+        {
+            glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+            std::cerr << "Star field " << name << " shader compilation failed: " << infoLog << std::endl;
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    };
+
+    unsigned int vertexShader = compile(GL_VERTEX_SHADER, vertexSource, "vertex");
+    unsigned int fragmentShader = compile(GL_FRAGMENT_SHADER, fragmentSource, "fragment");
+    if (vertexShader == 0 || fragmentShader == 0)
+    {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return;
+    }
+
+    m_StarFieldProgram = glCreateProgram();
+    glAttachShader(m_StarFieldProgram, vertexShader);
+    glAttachShader(m_StarFieldProgram, fragmentShader);
+    glLinkProgram(m_StarFieldProgram);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    glGetProgramiv(m_StarFieldProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(m_StarFieldProgram, 512, nullptr, infoLog);
+        std::cerr << "Star field program linking failed: " << infoLog << std::endl;
+        glDeleteProgram(m_StarFieldProgram);
+        m_StarFieldProgram = 0;
+        return;
+    }
+
+    // Sampler units never change
+    glUseProgram(m_StarFieldProgram);
+    glUniform1i(glGetUniformLocation(m_StarFieldProgram, "starTexture"), 0);
+    glUniform1i(glGetUniformLocation(m_StarFieldProgram, "glowTexture"), 1);
+    glUseProgram(m_ShaderProgram);
+}
+
+void OpenGLRenderer::EnsureGpuParticleBuffers(size_t slots, size_t emitters)
+{
+    if (m_GpuDrawCommandBuffer == 0)
+    {
+        glGenBuffers(1, &m_GpuDrawCommandBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuDrawCommandBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, 2 * 4 * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    if (slots > m_GpuParticleSlots)
+    {
+        if (m_GpuParticleBuffer == 0)
+        {
+            glGenBuffers(1, &m_GpuParticleBuffer);
+            glGenBuffers(1, &m_GpuInstanceBuffer);
+            glGenVertexArrays(1, &m_GpuParticleVAO);
+        }
+
+        // Zeroed slots have no lifetime left, so growing starts them all dead
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuParticleBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, slots * GPU_PARTICLE_BYTES, nullptr, GL_DYNAMIC_COPY);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuInstanceBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, slots * sizeof(SpriteInstance), nullptr, GL_DYNAMIC_COPY);
+
+        glBindVertexArray(m_GpuParticleVAO);
+        SetupInstanceAttributes(m_GpuInstanceBuffer);
+        glBindVertexArray(0);
+
+        m_GpuParticleSlots = slots;
+    }
+
+    if (emitters > m_GpuEmitterCapacity)
+    {
+        if (m_GpuEmitterBuffer == 0)
+        {
+            glGenBuffers(1, &m_GpuEmitterBuffer);
+            glGenBuffers(1, &m_GpuSpawnCounterBuffer);
+        }
+        m_GpuEmitterCapacity = std::max(emitters, m_GpuEmitterCapacity * 2);
+
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuEmitterBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, m_GpuEmitterCapacity * sizeof(GpuParticleEmitter), nullptr,
+                     GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuSpawnCounterBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, m_GpuEmitterCapacity * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+    }
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void OpenGLRenderer::SimulateGpuParticles(const GpuParticleEmitter *emitters, size_t count,
+                                          const GpuParticleStep &step)
+{
+    m_GpuParticleDrawReady = false;
+    if (m_ParticleComputeProgram == 0 || count == 0)
+    {
+        return;
+    }
+
+    size_t slots = 0;
+    GLuint slotsPerEmitter = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        slots = std::max(slots, static_cast<size_t>(emitters[i].firstSlot) + emitters[i].slotCount);
+        slotsPerEmitter = std::max(slotsPerEmitter, emitters[i].slotCount);
+    }
+    if (slots == 0)
+    {
+        return;
+    }
+
+    const bool grew = slots > m_GpuParticleSlots;
+    EnsureGpuParticleBuffers(slots, count);
+    if (step.reset && !grew)
+    {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuParticleBuffer);
+        glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuEmitterBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(GpuParticleEmitter), emitters);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuSpawnCounterBuffer);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    // Both lists start empty: six vertices per instance, no instances yet
+    const GLuint commands[8] = {static_cast<GLuint>(VERTICES_PER_SPRITE), 0, 0, 0,
+                                static_cast<GLuint>(VERTICES_PER_SPRITE), 0, 0, 0};
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_GpuDrawCommandBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(commands), commands);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_GpuParticleBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_GpuEmitterBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_GpuSpawnCounterBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_GpuInstanceBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, m_GpuDrawCommandBuffer);
+
+    // Same globe test as IsPointBehindSphere(); a zero radius disables it
+    const PerspectiveState persp = GetPerspectiveState();
+    const bool hasGlobe = persp.enabled &&
+                          (persp.mode == ProjectionMode::Globe || persp.mode == ProjectionMode::Fisheye);
+    const glm::vec3 sphere = hasGlobe
+                                 ? glm::vec3(persp.viewWidth * 0.5f, persp.viewHeight * 0.5f, persp.sphereRadius)
+                                 : glm::vec3(0.0f);
+
+    const GLuint program = m_ParticleComputeProgram;
+    glUseProgram(program);
+    glUniform1f(glGetUniformLocation(program, "deltaTime"), step.deltaTime);
+    glUniform1f(glGetUniformLocation(program, "time"), step.time);
+    glUniform1f(glGetUniformLocation(program, "nightFactor"), step.nightFactor);
+    glUniform1ui(glGetUniformLocation(program, "seed"), step.seed);
+    glUniform2fv(glGetUniformLocation(program, "wind"), 1, glm::value_ptr(step.wind));
+    glUniform2fv(glGetUniformLocation(program, "cameraPos"), 1, glm::value_ptr(step.cameraPos));
+    glUniform2f(glGetUniformLocation(program, "viewSize"), persp.viewWidth, persp.viewHeight);
+    glUniform3fv(glGetUniformLocation(program, "sphere"), 1, glm::value_ptr(sphere));
+    glUniform1ui(glGetUniformLocation(program, "totalSlots"), static_cast<GLuint>(m_GpuParticleSlots));
+
+    const GLint finalizeLoc = glGetUniformLocation(program, "finalizePass");
+    glUniform1i(finalizeLoc, 0);
+    glDispatchCompute((slotsPerEmitter + 255) / 256, static_cast<GLuint>(count), 1);
+
+    // The additive list grows down from the end, so its base instance is
+    // only known once every slot has been processed
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+    glUniform1i(finalizeLoc, 1);
+    glDispatchCompute(1, 1, 1);
+
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    glUseProgram(m_ShaderProgram);
+    m_GpuParticleDrawReady = true;
+}
+
+void OpenGLRenderer::DrawGpuParticles(const Texture &atlas)
+{
+    if (!m_GpuParticleDrawReady)
+        return;
+
+    unsigned int texID = atlas.GetID();
+    const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
+    if (atlas.m_OpenGLContextGeneration != currentGen || texID == 0)
+    {
+        const_cast<Texture &>(atlas).RecreateOpenGLTexture();
+        texID = atlas.GetID();
+        if (texID == 0)
+            return;
+    }
+
+    // Keep draw order with anything already batched
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+
+    glUseProgram(m_ShaderProgram);
+
+    glm::mat4 identity = glm::mat4(1.0f);
+    glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(identity));
+    glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+
+    // The CPU never sees these quads, so perspective is evaluated in
+    // sprite.vert even when the rest of the frame projects on the CPU
+    const bool gpuProjection = m_GpuProjection;
+    m_GpuProjection = true;
+    UploadPerspectiveUniforms(true);
+    m_GpuProjection = gpuProjection;
+
+    // Same shading as DrawSpriteInstances(): texture * per-sprite color
+    glUniform1i(m_UseColorOnlyLoc, 3);
+    glUniform1i(m_InstancedLoc, 1);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texID);
+
+    glBindVertexArray(m_GpuParticleVAO);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_GpuDrawCommandBuffer);
+
+    // Alpha-blended weather first, then additive, like ParticleSystem::Render()
+    glDrawArraysIndirect(GL_TRIANGLES, (void *)0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDrawArraysIndirect(GL_TRIANGLES, (void *)(4 * sizeof(GLuint)));
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    DebugAfterDraw("GpuParticles", 0);
+    m_DrawCallCount += 2;
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Restore state
+    glUniform1i(m_InstancedLoc, 0);
+    glUniform1i(m_UseColorOnlyLoc, 0);
+}
 
-    // Translate to world position
-    for (int i = 0; i < 4; i++)
+void OpenGLRenderer::ReleaseGpuParticles()
+{
+    if (m_GpuParticleVAO != 0)
     {
-        corners[i] += position;
+        glDeleteVertexArrays(1, &m_GpuParticleVAO);
+        m_GpuParticleVAO = 0;
     }
+    unsigned int *buffers[] = {&m_GpuParticleBuffer, &m_GpuEmitterBuffer, &m_GpuSpawnCounterBuffer,
+                               &m_GpuInstanceBuffer, &m_GpuDrawCommandBuffer};
+    for (unsigned int *buffer : buffers)
+    {
+        if (*buffer != 0)
+        {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    m_GpuParticleSlots = 0;
+    m_GpuEmitterCapacity = 0;
+    m_GpuParticleDrawReady = false;
+}
 
-    ApplyPerspective(corners);
+void OpenGLRenderer::UploadStarField(const StarFieldStar *stars, size_t count)
+{
+    if (m_StarFieldProgram == 0)
+        return;
 
-    // UV coordinates (OpenGL Y flipped)
-    glm::vec2 uvs[4] = {
-        {u0, v1}, // Top-left
-        {u1, v1}, // Top-right
-        {u1, v0}, // Bottom-right
-        {u0, v0}  // Bottom-left
+    if (m_StarFieldVAO == 0)
+    {
+        glGenVertexArrays(1, &m_StarFieldVAO);
+        glGenBuffers(1, &m_StarFieldVBO);
+
+        glBindVertexArray(m_StarFieldVAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_StarFieldVBO);
+        const GLsizei stride = sizeof(StarFieldStar);
+
+        // position
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(StarFieldStar, position));
+        glVertexAttribDivisor(0, 1);
+        // baseBrightness, twinklePhase, twinkleSpeed, size
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(StarFieldStar, baseBrightness));
+        glVertexAttribDivisor(1, 1);
+        // RGBA8 color
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void *)offsetof(StarFieldStar, color));
+        glVertexAttribDivisor(2, 1);
+        // flagsIndex
+        glEnableVertexAttribArray(3);
+        glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, stride, (void *)offsetof(StarFieldStar, flagsIndex));
+        glVertexAttribDivisor(3, 1);
+        glBindVertexArray(0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_StarFieldVBO);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(StarFieldStar), count > 0 ? stars : nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_StarFieldCount = count;
+}
+
+void OpenGLRenderer::DrawStarField(const Texture &starTexture, const Texture &glowTexture,
+                                   const StarFieldParams &params)
+{
+    if (m_StarFieldProgram == 0 || m_StarFieldCount == 0 || params.intensity <= 0.0f)
+        return;
+
+    auto resolve = [](const Texture &texture) -> unsigned int
+    {
+        unsigned int texID = texture.GetID();
+        if (texture.m_OpenGLContextGeneration != Texture::GetCurrentOpenGLContextGeneration() || texID == 0)
+        {
+            const_cast<Texture &>(texture).RecreateOpenGLTexture();
+            texID = texture.GetID();
+        }
+        return texID;
     };
+    const unsigned int starID = resolve(starTexture);
+    const unsigned int glowID = resolve(glowTexture);
+    if (starID == 0 || glowID == 0)
+        return;
 
-    // Add 6 vertices (2 triangles) with per-vertex color to batch
-    float r = color.r, g = color.g, b = color.b, a = color.a;
-    m_ParticleBatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, r, g, b, a});
-    m_ParticleBatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, r, g, b, a});
-    m_ParticleBatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y, r, g, b, a});
+    // Keep draw order with anything already batched
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
 
-    m_ParticleBatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, r, g, b, a});
-    m_ParticleBatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y, r, g, b, a});
-    m_ParticleBatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, r, g, b, a});
+    const GLuint program = m_StarFieldProgram;
+    glUseProgram(program);
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(m_Projection));
+    glUniform2f(glGetUniformLocation(program, "screenSize"), params.screenSize.x, params.screenSize.y);
+    glUniform1f(glGetUniformLocation(program, "time"), params.time);
+    glUniform1f(glGetUniformLocation(program, "intensity"), params.intensity);
+    glUniform1ui(glGetUniformLocation(program, "backgroundCount"), params.backgroundCount);
+    glUniform1ui(glGetUniformLocation(program, "foregroundCount"), params.foregroundCount);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, glowID);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, starID);
+
+    // stars.frag outputs premultiplied color
+    glBlendFunc(GL_ONE, GL_ONE);
+    glBindVertexArray(m_StarFieldVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(m_StarFieldCount));
+    glBindVertexArray(0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    DebugAfterDraw("StarField", static_cast<int>(m_StarFieldCount * 6));
+    m_DrawCallCount++;
+    m_RenderStats.vertices += m_StarFieldCount * 6;
+
+    glUseProgram(m_ShaderProgram);
 }
 
-void OpenGLRenderer::FlushBatch()
+void OpenGLRenderer::FlushBatch(RenderStats::FlushReason reason)
 {
     if (m_BatchVertices.empty())
         return;
 
     // Texture ID 0 is invalid for sprite sampling in core profile.
     // Drop this batch instead of accidentally sampling a previously bound texture.
-    if (m_CurrentBatchTexture == 0)
+    if (m_BatchTextureCount == 0)
     {
         m_BatchVertices.clear();
-        m_CurrentBatchTexture = 0;
         return;
     }
 
@@ -709,35 +2099,75 @@ void OpenGLRenderer::FlushBatch()
     glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
     glUniform3f(m_ColorLoc, 1.0f, 1.0f, 1.0f); // No color tint
     glUniform1f(m_AlphaLoc, 1.0f);             // Full opacity
-    glUniform3f(m_AmbientColorLoc, m_AmbientColor.r, m_AmbientColor.g, m_AmbientColor.b);
+    UploadLightUniforms();
+    UploadPerspectiveUniforms(m_BatchApplyPerspective);
 
-    // Upload vertex data using buffer orphaning technique
-    // GL_MAP_INVALIDATE_BUFFER_BIT tells driver we don't need old data,
-    // allowing it to allocate new storage and avoid GPU/CPU sync stall
     size_t dataSize = m_BatchVertices.size() * sizeof(BatchVertex);
-    glBindBuffer(GL_ARRAY_BUFFER, m_BatchVBO);
-    void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
-                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
-    if (ptr)
+    GLint firstVertex = 0;
+    if (m_BatchVertices.mapped)
     {
-        memcpy(ptr, m_BatchVertices.data(), dataSize);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+        // Vertices were written straight into the persistent stream, just claim the space
+        m_SpriteStream.head += dataSize;
+        firstVertex = static_cast<GLint>(m_BatchVertices.first);
+        glBindVertexArray(m_SpriteStream.vao);
+    }
+    else
+    {
+        // Upload vertex data using buffer orphaning technique
+        // GL_MAP_INVALIDATE_BUFFER_BIT tells driver we don't need old data,
+        // allowing it to allocate new storage and avoid GPU/CPU sync stall
+        glBindBuffer(GL_ARRAY_BUFFER, m_BatchVBO);
+        void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (ptr)
+        {
+            memcpy(ptr, m_BatchVertices.data(), dataSize);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        glBindVertexArray(m_BatchVAO);
     }
 
-    // Bind the shared texture for this batch
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_CurrentBatchTexture);
+    // Bind every texture of this batch to its slot's unit (sprite.frag spriteSlots[])
+    for (int slot = m_BatchTextureCount - 1; slot >= 0; --slot)
+    {
+        glActiveTexture(GL_TEXTURE0 + slot);
+        glBindTexture(GL_TEXTURE_2D, m_BatchTextures[slot]);
+    }
 
     // Single draw call for all sprites in batch (main performance benefit of batching!)
-    glBindVertexArray(m_BatchVAO);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_BatchVertices.size()));
+    glDrawArrays(GL_TRIANGLES, firstVertex, static_cast<GLsizei>(m_BatchVertices.size()));
     DebugAfterDraw("SpriteBatch", static_cast<int>(m_BatchVertices.size()));
     glBindVertexArray(0);
     ++m_DrawCallCount;
+    m_RenderStats.CountFlush(reason, m_BatchVertices.size());
 
     // Reset for next batch, clearing texture forces explicit rebind to prevent stale state
     m_BatchVertices.clear();
-    m_CurrentBatchTexture = 0;
+    m_BatchTextureCount = 0;
+}
+
+int OpenGLRenderer::AcquireBatchTextureSlot(unsigned int texID)
+{
+    // Texture 0 never gets a slot, an invalid ID must not leak into the batch
+    if (texID == 0)
+        return -1;
+
+    if (m_BatchVertices.empty())
+    {
+        m_BatchTextureCount = 0;
+    }
+    for (int slot = 0; slot < m_BatchTextureCount; ++slot)
+    {
+        if (m_BatchTextures[slot] == texID)
+            return slot;
+    }
+
+    const int maxSlots = m_MultiTextureBatching ? MAX_BATCH_TEXTURE_SLOTS : 1;
+    if (m_BatchTextureCount >= maxSlots)
+        return -1;
+
+    m_BatchTextures[m_BatchTextureCount] = texID;
+    return m_BatchTextureCount++;
 }
 
 void OpenGLRenderer::CreateWhiteTexture()
@@ -765,21 +2195,22 @@ void OpenGLRenderer::DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::ve
     // If switching from sprite to rect mode, flush sprites first
     if (!m_BatchVertices.empty())
     {
-        FlushBatch();
+        FlushBatch(RenderStats::FlushReason::BatchSwitch);
     }
 
     // If blend mode changed, flush current batch first
     if (!m_RectBatchVertices.empty() && m_RectBatchAdditive != additive)
     {
-        FlushRectBatch();
+        FlushRectBatch(RenderStats::FlushReason::BlendChange);
     }
     m_RectBatchAdditive = additive;
 
     // Check batch capacity
-    if (m_RectBatchVertices.size() >= MAX_BATCH_SPRITES * VERTICES_PER_SPRITE)
+    if (!m_RectBatchVertices.HasRoom(VERTICES_PER_SPRITE))
     {
-        FlushRectBatch();
+        FlushRectBatch(RenderStats::FlushReason::BufferFull);
     }
+    OpenStreamBatch(m_RectBatchVertices, m_RectStream, MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
 
     // Pre-transform vertices (no rotation for rects)
     glm::vec2 corners[4] = {
@@ -811,9 +2242,9 @@ void OpenGLRenderer::DrawWarpedQuad(const Texture& texture, const glm::vec2 corn
 
     // Flush other batch types first
     if (!m_RectBatchVertices.empty())
-        FlushRectBatch();
+        FlushRectBatch(RenderStats::FlushReason::BatchSwitch);
     if (!m_ParticleBatchVertices.empty())
-        FlushParticleBatch();
+        FlushParticleBatch(RenderStats::FlushReason::BatchSwitch);
 
     unsigned int texID = texture.GetID();
     const std::uint64_t currentGen = Texture::GetCurrentOpenGLContextGeneration();
@@ -825,20 +2256,27 @@ void OpenGLRenderer::DrawWarpedQuad(const Texture& texture, const glm::vec2 corn
             return;
     }
 
-    // Flush sprite batch if texture changed.
-    // Do not special-case texture 0, or stale/invalid IDs can leak into the batch.
-    if (!m_BatchVertices.empty() && m_CurrentBatchTexture != texID)
+    // Already projected by the caller, must not go through sprite.vert projection
+    if (!m_BatchVertices.empty() && m_GpuProjection && m_BatchApplyPerspective)
     {
         FlushBatch();
     }
 
     // Check batch capacity
-    if (m_BatchVertices.size() >= MAX_BATCH_SPRITES * VERTICES_PER_SPRITE)
+    if (!m_BatchVertices.HasRoom(VERTICES_PER_SPRITE))
     {
-        FlushBatch();
+        FlushBatch(RenderStats::FlushReason::BufferFull);
+    }
+
+    int texSlot = AcquireBatchTextureSlot(texID);
+    if (texSlot < 0)
+    {
+        FlushBatch(RenderStats::FlushReason::TextureChange);
+        texSlot = AcquireBatchTextureSlot(texID);
     }
+    OpenStreamBatch(m_BatchVertices, m_SpriteStream, MAX_BATCH_SPRITES * VERTICES_PER_SPRITE);
 
-    m_CurrentBatchTexture = texID;
+    m_BatchApplyPerspective = false;
 
     // Calculate UV coordinates from pixel coordinates
     float texW = static_cast<float>(texture.GetWidth());
@@ -876,17 +2314,142 @@ void OpenGLRenderer::DrawWarpedQuad(const Texture& texture, const glm::vec2 corn
 
     // Assemble quad as two triangles (6 vertices)
     // Triangle 1: TL, BR, BL
-    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y});
-    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y});
-    m_BatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y});
+    const float slot = static_cast<float>(texSlot);
+    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, slot});
+    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, slot});
+    m_BatchVertices.push_back({corners[3].x, corners[3].y, uvs[3].x, uvs[3].y, slot});
 
     // Triangle 2: TL, TR, BR
-    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y});
-    m_BatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y});
-    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y});
+    m_BatchVertices.push_back({corners[0].x, corners[0].y, uvs[0].x, uvs[0].y, slot});
+    m_BatchVertices.push_back({corners[1].x, corners[1].y, uvs[1].x, uvs[1].y, slot});
+    m_BatchVertices.push_back({corners[2].x, corners[2].y, uvs[2].x, uvs[2].y, slot});
+}
+
+int OpenGLRenderer::CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY)
+{
+    if (count == 0)
+    {
+        return INVALID_STATIC_MESH;
+    }
+
+    std::vector<float> vertices;
+    BuildStaticMeshVertices(texture, quads, count, flipY, vertices);
+    if (vertices.empty())
+    {
+        return INVALID_STATIC_MESH;
+    }
+
+    StaticMesh mesh;
+    mesh.vertexCount = static_cast<GLsizei>(vertices.size() / 4);
+    mesh.texture = &texture;
+
+    // Uploaded once, the driver is free to place this in video memory
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glBindVertexArray(mesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    // Position (xy) + texcoord (uv), always samples slot 0
+    SetupBatchVertexLayout(4 * sizeof(float), false, false);
+    glBindVertexArray(0);
+
+    if (!m_FreeStaticMeshes.empty())
+    {
+        int handle = m_FreeStaticMeshes.back();
+        m_FreeStaticMeshes.pop_back();
+        m_StaticMeshes[handle] = mesh;
+        return handle;
+    }
+    m_StaticMeshes.push_back(mesh);
+    return static_cast<int>(m_StaticMeshes.size() - 1);
+}
+
+void OpenGLRenderer::DrawStaticMesh(int mesh, glm::vec2 origin)
+{
+    if (mesh < 0 || mesh >= static_cast<int>(m_StaticMeshes.size()) || m_StaticMeshes[mesh].vao == 0)
+    {
+        return;
+    }
+    const StaticMesh &staticMesh = m_StaticMeshes[mesh];
+
+    // Keep draw order with anything already batched
+    FlushBatch();
+    FlushRectBatch();
+    FlushParticleBatch();
+
+    unsigned int texID = staticMesh.texture->GetID();
+    if (staticMesh.texture->m_OpenGLContextGeneration != Texture::GetCurrentOpenGLContextGeneration() || texID == 0)
+    {
+        const_cast<Texture *>(staticMesh.texture)->RecreateOpenGLTexture();
+        texID = staticMesh.texture->GetID();
+        if (texID == 0)
+            return;
+    }
+
+    glUseProgram(m_ShaderProgram);
+
+    // Mesh vertices are origin-relative, the model matrix places them on screen
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(origin, 0.0f));
+    glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+    glUniform3f(m_ColorLoc, 1.0f, 1.0f, 1.0f);
+    glUniform1f(m_AlphaLoc, 1.0f);
+    UploadLightUniforms();
+    UploadPerspectiveUniforms(true);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texID);
+
+    glBindVertexArray(staticMesh.vao);
+    glDrawArrays(GL_TRIANGLES, 0, staticMesh.vertexCount);
+    DebugAfterDraw("StaticMesh", static_cast<int>(staticMesh.vertexCount));
+    glBindVertexArray(0);
+    ++m_DrawCallCount;
+    m_RenderStats.vertices += static_cast<std::uint64_t>(staticMesh.vertexCount);
+}
+
+void OpenGLRenderer::UpdateStaticMesh(int mesh, size_t firstQuad, const StaticQuad *quads, size_t count, bool flipY)
+{
+    if (mesh < 0 || mesh >= static_cast<int>(m_StaticMeshes.size()) || m_StaticMeshes[mesh].vao == 0 || count == 0)
+    {
+        return;
+    }
+    const StaticMesh &staticMesh = m_StaticMeshes[mesh];
+    if ((firstQuad + count) * 6 > static_cast<size_t>(staticMesh.vertexCount))
+    {
+        return;
+    }
+
+    std::vector<float> vertices;
+    BuildStaticMeshVertices(*staticMesh.texture, quads, count, flipY, vertices);
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    // 6 vertices of 4 floats per quad, same layout CreateStaticMesh() uploaded
+    glBindBuffer(GL_ARRAY_BUFFER, staticMesh.vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(firstQuad * 6 * 4 * sizeof(float)),
+                    static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OpenGLRenderer::DestroyStaticMesh(int mesh)
+{
+    if (mesh < 0 || mesh >= static_cast<int>(m_StaticMeshes.size()) || m_StaticMeshes[mesh].vao == 0)
+    {
+        return;
+    }
+
+    StaticMesh &staticMesh = m_StaticMeshes[mesh];
+    glDeleteVertexArrays(1, &staticMesh.vao);
+    glDeleteBuffers(1, &staticMesh.vbo);
+    staticMesh = StaticMesh{};
+    m_FreeStaticMeshes.push_back(mesh);
 }
 
-void OpenGLRenderer::FlushRectBatch()
+void OpenGLRenderer::FlushRectBatch(RenderStats::FlushReason reason)
 {
     if (m_RectBatchVertices.empty())
         return;
@@ -905,39 +2468,47 @@ void OpenGLRenderer::FlushRectBatch()
     glm::mat4 identity = glm::mat4(1.0f);
     glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(identity));
     glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+    UploadPerspectiveUniforms(true);
 
     // Tell shader to use per-vertex color instead of texture sampling
     // useColorOnly modes: 0=texture, 1=uniform color, 2=vertex color, 3=texture*vertex color
-    static GLint useColorOnlyLoc = -1;
-    if (useColorOnlyLoc == -1)
-    {
-        useColorOnlyLoc = glGetUniformLocation(m_ShaderProgram, "useColorOnly");
-    }
-    glUniform1i(useColorOnlyLoc, 2);
+    glUniform1i(m_UseColorOnlyLoc, 2);
 
-    // Upload with buffer orphaning to avoid GPU sync stall
     size_t dataSize = m_RectBatchVertices.size() * sizeof(ColoredVertex);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RectBatchVBO);
-    void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
-                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
-    if (ptr)
+    GLint firstVertex = 0;
+    if (m_RectBatchVertices.mapped)
     {
-        memcpy(ptr, m_RectBatchVertices.data(), dataSize);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+        // Already in the persistent stream
+        m_RectStream.head += dataSize;
+        firstVertex = static_cast<GLint>(m_RectBatchVertices.first);
+        glBindVertexArray(m_RectStream.vao);
+    }
+    else
+    {
+        // Upload with buffer orphaning to avoid GPU sync stall
+        glBindBuffer(GL_ARRAY_BUFFER, m_RectBatchVBO);
+        void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (ptr)
+        {
+            memcpy(ptr, m_RectBatchVertices.data(), dataSize);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        glBindVertexArray(m_RectBatchVAO);
     }
 
     // White texture acts as placeholder, shader ignores it in vertex color mode
     glBindTexture(GL_TEXTURE_2D, m_WhiteTexture);
 
     // Single draw call for all rectangles
-    glBindVertexArray(m_RectBatchVAO);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_RectBatchVertices.size()));
+    glDrawArrays(GL_TRIANGLES, firstVertex, static_cast<GLsizei>(m_RectBatchVertices.size()));
     DebugAfterDraw("RectBatch", static_cast<int>(m_RectBatchVertices.size()));
     glBindVertexArray(0);
     ++m_DrawCallCount;
+    m_RenderStats.CountFlush(reason, m_RectBatchVertices.size());
 
     // Restore shader and blend state for next batch
-    glUniform1i(useColorOnlyLoc, 0);
+    glUniform1i(m_UseColorOnlyLoc, 0);
     if (m_RectBatchAdditive)
     {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -946,7 +2517,7 @@ void OpenGLRenderer::FlushRectBatch()
     m_RectBatchVertices.clear();
 }
 
-void OpenGLRenderer::FlushParticleBatch()
+void OpenGLRenderer::FlushParticleBatch(RenderStats::FlushReason reason)
 {
     // Particles are batched separately from sprites because they use per-vertex
     // color/alpha for effects like fading, color variation, and glow intensity
@@ -971,25 +2542,33 @@ void OpenGLRenderer::FlushParticleBatch()
     glm::mat4 identity = glm::mat4(1.0f);
     glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(identity));
     glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+    UploadPerspectiveUniforms(true);
 
     // Mode 3: multiply texture color by per-vertex color
     // This allows particles to be tinted and faded individually while using a shared texture
-    static GLint useColorOnlyLoc = -1;
-    if (useColorOnlyLoc == -1)
-    {
-        useColorOnlyLoc = glGetUniformLocation(m_ShaderProgram, "useColorOnly");
-    }
-    glUniform1i(useColorOnlyLoc, 3);
+    glUniform1i(m_UseColorOnlyLoc, 3);
 
-    // Upload particle vertices, reuses rect batch VBO since same vertex layout
     size_t dataSize = m_ParticleBatchVertices.size() * sizeof(ColoredVertex);
-    glBindBuffer(GL_ARRAY_BUFFER, m_RectBatchVBO);
-    void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
-                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
-    if (ptr)
+    GLint firstVertex = 0;
+    if (m_ParticleBatchVertices.mapped)
     {
-        memcpy(ptr, m_ParticleBatchVertices.data(), dataSize);
-        glUnmapBuffer(GL_ARRAY_BUFFER);
+        // Own stream, rects may be accumulating in theirs at the same time
+        m_ParticleStream.head += dataSize;
+        firstVertex = static_cast<GLint>(m_ParticleBatchVertices.first);
+        glBindVertexArray(m_ParticleStream.vao);
+    }
+    else
+    {
+        // Upload particle vertices, reuses rect batch VBO since same vertex layout
+        glBindBuffer(GL_ARRAY_BUFFER, m_RectBatchVBO);
+        void *ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, dataSize,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (ptr)
+        {
+            memcpy(ptr, m_ParticleBatchVertices.data(), dataSize);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        glBindVertexArray(m_RectBatchVAO);
     }
 
     // All particles in this batch share the same texture (e.g., soft circle for glow)
@@ -997,14 +2576,14 @@ void OpenGLRenderer::FlushParticleBatch()
     glBindTexture(GL_TEXTURE_2D, m_CurrentParticleTexture);
 
     // Single draw call for entire particle batch
-    glBindVertexArray(m_RectBatchVAO);
-    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_ParticleBatchVertices.size()));
+    glDrawArrays(GL_TRIANGLES, firstVertex, static_cast<GLsizei>(m_ParticleBatchVertices.size()));
     DebugAfterDraw("ParticleBatch", static_cast<int>(m_ParticleBatchVertices.size()));
     glBindVertexArray(0);
     ++m_DrawCallCount;
+    m_RenderStats.CountFlush(reason, m_ParticleBatchVertices.size());
 
     // Restore state
-    glUniform1i(useColorOnlyLoc, 0);
+    glUniform1i(m_UseColorOnlyLoc, 0);
     if (m_ParticleBatchAdditive)
     {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -1183,7 +2762,7 @@ void OpenGLRenderer::LoadFont(const std::string &fontPath)
             glm::ivec2(gd.bearingX, gd.bearingY),
             gd.advance,
             u0, v0, u1, v1};
-        m_Characters.insert(std::pair<char, Character>(c, character));
+        m_Characters.Insert(static_cast<char>(c), character);
 
         currentX += w + PADDING;
         if (h > rowHeight)
@@ -1192,6 +2771,9 @@ void OpenGLRenderer::LoadFont(const std::string &fontPath)
         delete[] gd.bitmap;
     }
 
+    // Meshes built against an earlier atlas have stale UVs
+    m_TextMeshes.Clear();
+
     // Upload atlas to GPU
     glGenTextures(1, &m_FontAtlasTexture);
     glBindTexture(GL_TEXTURE_2D, m_FontAtlasTexture);
@@ -1208,7 +2790,7 @@ void OpenGLRenderer::LoadFont(const std::string &fontPath)
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     std::cout << "Loaded font: " << fontPath << " (atlas " << atlasWidth << "x" << atlasHeight
-              << ", " << m_Characters.size() << " characters)" << std::endl;
+              << ", " << m_Characters.Size() << " characters)" << std::endl;
 #else
     std::cerr << "ERROR: LoadFont called but FreeType is not available!" << std::endl;
 #endif
@@ -1218,13 +2800,8 @@ float OpenGLRenderer::GetTextAscent(float scale) const
 {
     // Find the maximum bearing.y (ascent) across all loaded characters
     int maxAscent = 0;
-    for (const auto &pair : m_Characters)
-    {
-        if (pair.second.Bearing.y > maxAscent)
-        {
-            maxAscent = pair.second.Bearing.y;
-        }
-    }
+    m_Characters.ForEach([&maxAscent](char, const Character &ch)
+                         { maxAscent = std::max(maxAscent, ch.Bearing.y); });
     // If no characters loaded, use font size as fallback
     if (maxAscent == 0)
     {
@@ -1233,9 +2810,9 @@ float OpenGLRenderer::GetTextAscent(float scale) const
     return static_cast<float>(maxAscent) * scale;
 }
 
-float OpenGLRenderer::GetTextWidth(const std::string &text, float scale) const
+float OpenGLRenderer::GetTextWidth(std::string_view text, float scale) const
 {
-    if (m_Characters.empty() || text.empty())
+    if (m_Characters.Empty() || text.empty())
     {
         return 0.0f;
     }
@@ -1243,24 +2820,23 @@ float OpenGLRenderer::GetTextWidth(const std::string &text, float scale) const
     float width = 0.0f;
     for (char c : text)
     {
-        auto it = m_Characters.find(c);
-        if (it != m_Characters.end())
+        if (const Character *ch = m_Characters.Find(c))
         {
             // Advance is in 1/64th pixels (FreeType convention)
-            width += (it->second.Advance >> 6) * scale;
+            width += (ch->Advance >> 6) * scale;
         }
     }
     return width;
 }
 
-void OpenGLRenderer::DrawText(const std::string &text, glm::vec2 position, float scale, glm::vec3 color,
+void OpenGLRenderer::DrawText(std::string_view text, glm::vec2 position, float scale, glm::vec3 color,
                               float outlineSize, float alpha)
 {
     // Text uses different render state, so flush other batches first
     FlushBatch();
     FlushRectBatch();
 
-    if (m_Characters.empty() || m_FontAtlasTexture == 0)
+    if (m_Characters.Empty() || m_FontAtlasTexture == 0)
     {
         std::cerr << "DrawText: No font atlas loaded!" << std::endl;
         return;
@@ -1271,18 +2847,93 @@ void OpenGLRenderer::DrawText(const std::string &text, glm::vec2 position, float
         return;
     }
 
-    m_TextBatchVertices.clear();
+    const TextMeshCache::TextMesh *mesh = m_TextMeshes.Find(text, scale, outlineSize);
+    if (!mesh)
+    {
+        TextMeshCache::TextMesh &built = m_TextMeshes.Insert(text, scale, outlineSize);
+        BuildTextMesh(text, scale, outlineSize, built);
+        mesh = &built;
+    }
+
+    const size_t outlineVertexCount = mesh->outlineVertexCount;
+    const size_t totalVertexCount = mesh->vertices.size();
+    if (totalVertexCount == 0)
+    {
+        return;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(m_ShaderProgram);
+
+    // Cached meshes are built at the origin
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f));
+    glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
+    UploadPerspectiveUniforms(false); // Text is never projected
+
+    // Use texture mode (mode 0) color uniform tints the white glyphs
+    glUniform1i(m_UseColorOnlyLoc, 0);
+    glUniform1f(m_AlphaLoc, alpha);
+    UploadLightUniforms();
+
+    // Upload all text vertices in one buffer update
+    const size_t textBytes = totalVertexCount * sizeof(TextVertex);
+    GLint firstVertex = 0;
+    if (m_TextStream.mapped && m_TextStream.head + textBytes <= m_TextStream.segmentBytes)
+    {
+        // Copy into this frame's ring segment, no driver-side sync
+        const size_t offset = static_cast<size_t>(m_StreamSegment) * m_TextStream.segmentBytes + m_TextStream.head;
+        memcpy(m_TextStream.mapped + offset, mesh->vertices.data(), textBytes);
+        m_TextStream.head += textBytes;
+        firstVertex = static_cast<GLint>(offset / sizeof(TextVertex));
+        glBindVertexArray(m_TextStream.vao);
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_TextVBO);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, textBytes, mesh->vertices.data());
+        glBindVertexArray(m_TextVAO);
+    }
+
+    // Bind font atlas (contains all glyphs in one texture)
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_FontAtlasTexture);
+
+    // Draw outline first (black, behind main text)
+    if (outlineVertexCount > 0)
+    {
+        glUniform3f(m_ColorLoc, 0.0f, 0.0f, 0.0f);
+        glDrawArrays(GL_TRIANGLES, firstVertex, static_cast<GLsizei>(outlineVertexCount));
+        DebugAfterDraw("TextOutline", static_cast<int>(outlineVertexCount));
+    }
+
+    // Draw main text on top (user-specified color)
+    size_t mainVertexCount = totalVertexCount - outlineVertexCount;
+    if (mainVertexCount > 0)
+    {
+        glUniform3f(m_ColorLoc, color.x, color.y, color.z);
+        glDrawArrays(GL_TRIANGLES, firstVertex + static_cast<GLint>(outlineVertexCount),
+                     static_cast<GLsizei>(mainVertexCount));
+        DebugAfterDraw("TextMain", static_cast<int>(mainVertexCount));
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
+void OpenGLRenderer::BuildTextMesh(std::string_view text, float scale, float outlineSize,
+                                   TextMeshCache::TextMesh &mesh) const
+{
     // Determine line height from first printable character
     float lineHeight = 24.0f;
     for (auto c : text)
     {
         if (c != '\n')
         {
-            auto it = m_Characters.find(c);
-            if (it != m_Characters.end())
+            if (const Character *ch = m_Characters.Find(c))
             {
-                lineHeight = static_cast<float>(it->second.Size.y);
+                lineHeight = static_cast<float>(ch->Size.y);
                 break;
             }
         }
@@ -1290,38 +2941,38 @@ void OpenGLRenderer::DrawText(const std::string &text, glm::vec2 position, float
 
     float outlineOffset = 2.0f * scale * outlineSize;
 
-    // Helper add a quad for one character to the vertex batch
-    auto addCharQuad = [this](float xpos, float ypos, float w, float h,
-                              float u0, float v0, float u1, float v1)
+    // Helper add a quad for one character to the mesh
+    auto addCharQuad = [&mesh](float xpos, float ypos, float w, float h,
+                               float u0, float v0, float u1, float v1)
     {
         // Two triangles per character (6 vertices)
-        m_TextBatchVertices.push_back({xpos, ypos, u0, v0});         // TL
-        m_TextBatchVertices.push_back({xpos, ypos + h, u0, v1});     // BL
-        m_TextBatchVertices.push_back({xpos + w, ypos + h, u1, v1}); // BR
-        m_TextBatchVertices.push_back({xpos, ypos, u0, v0});         // TL
-        m_TextBatchVertices.push_back({xpos + w, ypos + h, u1, v1}); // BR
-        m_TextBatchVertices.push_back({xpos + w, ypos, u1, v0});     // TR
+        mesh.vertices.push_back({xpos, ypos, u0, v0});         // TL
+        mesh.vertices.push_back({xpos, ypos + h, u0, v1});     // BL
+        mesh.vertices.push_back({xpos + w, ypos + h, u1, v1}); // BR
+        mesh.vertices.push_back({xpos, ypos, u0, v0});         // TL
+        mesh.vertices.push_back({xpos + w, ypos + h, u1, v1}); // BR
+        mesh.vertices.push_back({xpos + w, ypos, u1, v0});     // TR
     };
 
-    // Helper generate vertices for entire text string at given offset
+    // Helper generate vertices for entire text string at given offset from the origin
     auto buildTextVertices = [&](float offsetX, float offsetY)
     {
-        float x = position.x + offsetX;
-        float y = position.y + offsetY;
+        float x = offsetX;
+        float y = offsetY;
 
         for (auto c : text)
         {
             if (c == '\n')
             {
-                x = position.x + offsetX; // Carriage return
-                y += lineHeight * scale;  // Line feed
+                x = offsetX;             // Carriage return
+                y += lineHeight * scale; // Line feed
                 continue;
             }
 
-            auto it = m_Characters.find(c);
-            if (it == m_Characters.end())
+            const Character *glyph = m_Characters.Find(c);
+            if (!glyph)
                 continue;
-            const Character &ch = it->second;
+            const Character &ch = *glyph;
 
             // Position glyph using its bearing (offset from cursor to top-left)
             float xpos = x + ch.Bearing.x * scale;
@@ -1344,63 +2995,8 @@ void OpenGLRenderer::DrawText(const std::string &text, glm::vec2 position, float
                           outlineDirections[dir][1] * outlineOffset);
     }
 
-    size_t outlineVertexCount = m_TextBatchVertices.size();
+    mesh.outlineVertexCount = mesh.vertices.size();
 
     // Add main text vertices (drawn on top of outline)
     buildTextVertices(0, 0);
-
-    size_t totalVertexCount = m_TextBatchVertices.size();
-
-    if (totalVertexCount == 0)
-    {
-        return;
-    }
-
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glUseProgram(m_ShaderProgram);
-
-    glm::mat4 model = glm::mat4(1.0f);
-    glUniformMatrix4fv(m_ModelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(m_ProjectionLoc, 1, GL_FALSE, glm::value_ptr(m_Projection));
-
-    // Use texture mode (mode 0) color uniform tints the white glyphs
-    static GLint useColorOnlyLoc = -1;
-    if (useColorOnlyLoc == -1)
-    {
-        useColorOnlyLoc = glGetUniformLocation(m_ShaderProgram, "useColorOnly");
-    }
-    glUniform1i(useColorOnlyLoc, 0);
-    glUniform1f(m_AlphaLoc, alpha);
-    glUniform3f(m_AmbientColorLoc, m_AmbientColor.r, m_AmbientColor.g, m_AmbientColor.b);
-
-    // Upload all text vertices in one buffer update
-    glBindBuffer(GL_ARRAY_BUFFER, m_TextVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, totalVertexCount * sizeof(TextVertex), m_TextBatchVertices.data());
-
-    // Bind font atlas (contains all glyphs in one texture)
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, m_FontAtlasTexture);
-
-    glBindVertexArray(m_TextVAO);
-
-    // Draw outline first (black, behind main text)
-    if (outlineVertexCount > 0)
-    {
-        glUniform3f(m_ColorLoc, 0.0f, 0.0f, 0.0f);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(outlineVertexCount));
-        DebugAfterDraw("TextOutline", static_cast<int>(outlineVertexCount));
-    }
-
-    // Draw main text on top (user-specified color)
-    size_t mainVertexCount = totalVertexCount - outlineVertexCount;
-    if (mainVertexCount > 0)
-    {
-        glUniform3f(m_ColorLoc, color.x, color.y, color.z);
-        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(outlineVertexCount), static_cast<GLsizei>(mainVertexCount));
-        DebugAfterDraw("TextMain", static_cast<int>(mainVertexCount));
-    }
-
-    glBindTexture(GL_TEXTURE_2D, 0);
 }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "GlyphTable.h"
+#include "TextMeshCache.h"
 
 #include <glad/glad.h>
+#include <algorithm>
 #include <map>
 #include <string>
+#include <vector>
 
 #ifdef USE_FREETYPE
 #include <ft2build.h>
@@ -77,18 +81,31 @@
  *
  * @par Flush Triggers
  * The batch is flushed (submitted to GPU) when:
- * - **Texture changes**: New sprite uses different texture than current batch
+ * - **Texture changes**: New sprite uses a texture not in the batch and all
+ *   MAX_BATCH_TEXTURE_SLOTS slots are taken (one slot without multi-texture batching)
  * - **Buffer full**: Batch reaches MAX_BATCH_SPRITES (10000 sprites)
  * - **Frame ends**: EndFrame() flushes any remaining geometry
  * - **State changes**: SetProjection(), blend mode changes, etc.
  *
+ * Every flush that draws is counted in GetRenderStats() under the trigger
+ * that caused it.
+ *
  * @par Batch Types
  * | Batch Type  | Buffer              | Trigger            |
  * |-------------|---------------------|--------------------|
  * | Sprites     | m_BatchVertices     | Texture change     |
  * | Rects       | m_RectBatchVertices | Blend mode change  |
  * | Particles   | m_ParticleBatchVertices | Texture/blend  |
- * | Text        | m_TextBatchVertices | Per DrawText call  |
+ * | Text        | m_TextMeshes        | Per DrawText call  |
+ *
+ * @par Vertex Streams
+ * On GL 4.4+ each batch type owns a persistent, coherent `glBufferStorage`
+ * ring split into STREAM_SEGMENTS per-frame segments. Batches write
+ * vertices straight into the mapped segment and flushes only issue the
+ * draw; a fence per segment keeps the CPU from overwriting data the GPU
+ * has not consumed yet. Without buffer storage, or once a frame exhausts
+ * its segment, batches fall back to a `std::vector` staging copy that is
+ * uploaded with buffer orphaning.
  *
  * @section gl_shaders Shader Architecture
  * Uses a single unified shader program for all 2D rendering:
@@ -103,6 +120,8 @@
  * | color        | vec3  | Color tint                 |
  * | alpha        | float | Transparency               |
  * | ambientColor | vec3  | Day/night lighting         |
+ * | perspParams0 | vec4  | GPU perspective center     |
+ * | perspParams1 | vec4  | GPU perspective scale/mode |
  *
  * @section gl_font Font Rendering
  * Text is rendered using FreeType for glyph rasterization and a
@@ -111,7 +130,13 @@
  * @par Atlas Layout
  * All ASCII glyphs (32-127) are packed into a single texture at
  * initialization. UV coordinates for each character are cached
- * in the m_Characters map.
+ * in the flat m_Characters table.
+ *
+ * @par Text Meshes
+ * DrawText() keeps the outline and glyph quads of each string it draws in
+ * m_TextMeshes, built at the origin and placed with the model matrix. A
+ * string drawn again at the same scale and outline is copied into the text
+ * stream without walking its glyphs.
  *
  * @see IRenderer Base interface with method documentation
  * @see VulkanRenderer Alternative Vulkan implementation
@@ -138,11 +163,19 @@ public:
     void DrawSpriteAtlas(const Texture &texture, glm::vec2 position, glm::vec2 size,
                          glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
                          glm::vec4 color, bool additive = false) override;
+    void DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances,
+                             size_t count, bool additive = false) override;
     void DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::vec4 color, bool additive = false) override;
     void DrawWarpedQuad(const Texture& texture, const glm::vec2 corners[4],
                         glm::vec2 texCoord, glm::vec2 texSize,
                         glm::vec3 color = glm::vec3(1.0f), bool flipY = true) override;
 
+    int CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY) override;
+    void DrawStaticMesh(int mesh, glm::vec2 origin) override;
+    bool SupportsStaticMeshUpdates() const override { return true; }
+    void UpdateStaticMesh(int mesh, size_t firstQuad, const StaticQuad *quads, size_t count, bool flipY) override;
+    void DestroyStaticMesh(int mesh) override;
+
     void SetProjection(glm::mat4 projection) override;
     void SetViewport(int x, int y, int width, int height) override;
     void SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale,
@@ -153,15 +186,20 @@ public:
                                float horizonY, float horizonScale,
                                float viewWidth, float viewHeight) override;
     void SuspendPerspective(bool suspend) override;
+    void SetGpuProjection(bool enabled) override;
+    void SetMultiTextureBatching(bool enabled) override;
     void Clear(float r, float g, float b, float a) override;
 
     void UploadTexture(const Texture &texture) override;
+    void ReleaseTexture(Texture &texture) override;
+    bool UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height) override;
+    bool ReloadShaders() override;
 
-    void DrawText(const std::string &text, glm::vec2 position, float scale = 1.0f,
+    void DrawText(std::string_view text, glm::vec2 position, float scale = 1.0f,
                   glm::vec3 color = glm::vec3(1.0f), float outlineSize = 1.0f,
                   float alpha = 0.85f) override;
     float GetTextAscent(float scale = 1.0f) const override;
-    float GetTextWidth(const std::string& text, float scale = 1.0f) const override;
+    float GetTextWidth(std::string_view text, float scale = 1.0f) const override;
 
     /// @brief OpenGL uses bottom-left texture origin, requires Y-flip.
     bool RequiresYFlip() const override { return true; }
@@ -170,6 +208,43 @@ public:
 
     int GetDrawCallCount() const override { return m_DrawCallCount; }
 
+    /// @brief Flush pending batches, then write a GL_TIMESTAMP query.
+    void BeginGpuTimer(const char *name) override;
+    void EndGpuTimer() override;
+
+    /// @brief Bind m_LowResFBO, (re)creating its texture when the size changes.
+    bool BeginLowResPass(int width, int height) override;
+    /// @brief glBlitFramebuffer() the target to the window with GL_NEAREST.
+    void EndLowResPass(int x, int y, int width, int height) override;
+
+    /// @brief GL_RGBA16F texture attached to its own framebuffer.
+    int CreateRenderTarget(int width, int height) override;
+    bool BeginRenderTarget(int target) override;
+    void EndRenderTarget() override;
+    /// @brief One quad through the particle batch with a premultiplied blend function.
+    void DrawRenderTarget(int target, glm::vec2 position, glm::vec2 size, bool additive) override;
+    void DestroyRenderTarget(int target) override;
+
+    bool SupportsLightMap() const override { return true; }
+    /// @brief Splat into m_LightMapFBO with additive instanced falloff quads.
+    bool SetLightMap(glm::vec2 viewSize, float cellSize, const Light *lights, size_t count) override;
+    void ClearLightMap() override;
+
+    /// @brief True once shaders/particles.comp compiled (needs GL 4.3).
+    bool SupportsGpuParticles() const override { return m_ParticleComputeProgram != 0; }
+    void SimulateGpuParticles(const GpuParticleEmitter *emitters, size_t count,
+                              const GpuParticleStep &step) override;
+    void DrawGpuParticles(const Texture &atlas) override;
+    void ReleaseGpuParticles() override;
+
+    /// @brief True once shaders/stars.vert and stars.frag linked.
+    bool SupportsStarField() const override { return m_StarFieldProgram != 0; }
+    /// @brief GL_STATIC_DRAW instance buffer; replaces any previous upload.
+    void UploadStarField(const StarFieldStar *stars, size_t count) override;
+    /// @brief glDrawArraysInstanced() with 6 vertices per star, blended ONE, ONE.
+    void DrawStarField(const Texture &starTexture, const Texture &glowTexture,
+                       const StarFieldParams &params) override;
+
 private:
     /// @name Initialization Helpers
     /// @{
@@ -202,7 +277,7 @@ private:
         float u0, v0, u1, v1;   ///< UV coordinates in the font atlas.
     };
 
-    std::map<char, Character> m_Characters;   ///< Glyph lookup table.
+    GlyphTable<Character> m_Characters;       ///< Glyph lookup table.
     unsigned int m_FontAtlasTexture;          ///< OpenGL texture ID for font atlas.
     int m_FontAtlasWidth, m_FontAtlasHeight;  ///< Atlas dimensions.
 
@@ -231,8 +306,129 @@ private:
     GLint m_ColorLoc;          ///< RGB color tint.
     GLint m_AlphaLoc;          ///< Transparency multiplier.
     GLint m_AmbientColorLoc;   ///< Day/night ambient light color.
+    GLint m_PerspParams0Loc;   ///< GPU perspective center/horizon.
+    GLint m_PerspParams1Loc;   ///< GPU perspective scales/mode flags.
+    GLint m_InstancedLoc;      ///< Expand SpriteInstance records in sprite.vert.
+    GLint m_UseColorOnlyLoc;   ///< Texture/color mix mode (0-3).
+    GLint m_LightMapEnabledLoc = -1;  ///< Sample lightMap instead of ambientColor.
+    GLint m_LightMapRectLoc = -1;     ///< Viewport origin (xy) and 1 / size (zw) for lightMap.
     glm::vec3 m_AmbientColor;  ///< Current ambient light value.
 
+    /// @brief Compile and link shaders/sprite.vert + sprite.frag; 0 on failure.
+    unsigned int BuildSpriteProgram();
+
+    /// @brief Look up the uniform locations of m_ShaderProgram.
+    void CacheSpriteUniforms();
+
+    /// @brief Upload perspective uniforms for the next draw (zero = no projection).
+    void UploadPerspectiveUniforms(bool applyPerspective);
+
+    /// @brief Upload ambientColor and the light map state for the next textured draw.
+    void UploadLightUniforms();
+
+    /// @}
+
+    /// @name Persistent Vertex Streams
+    /// @{
+
+    /// @brief Frames a stream segment can be in flight (triple buffering).
+    static constexpr int STREAM_SEGMENTS = 3;
+
+    /**
+     * @brief Persistent-mapped ring buffer for one vertex format (GL 4.4+).
+     *
+     * Segment @c m_StreamSegment receives this frame's vertices; @c head is
+     * the next free byte inside it.
+     */
+    struct VertexStream {
+        unsigned int vao = 0;             ///< VAO sourcing from @c vbo.
+        unsigned int vbo = 0;             ///< Immutable glBufferStorage buffer.
+        unsigned char *mapped = nullptr;  ///< Persistent coherent mapping (nullptr = unavailable).
+        size_t vertexSize = 0;            ///< Bytes per vertex.
+        size_t segmentBytes = 0;          ///< Bytes per frame segment.
+        size_t head = 0;                  ///< Write offset inside the current segment.
+    };
+
+    /**
+     * @brief Vertex accumulator for one batch with a std::vector-like interface.
+     *
+     * While @c mapped is set, vertices are written directly into the stream
+     * segment; otherwise they are staged and uploaded by the flush.
+     */
+    template <typename Vertex>
+    struct StreamBatch {
+        std::vector<Vertex> staging;  ///< Fallback storage.
+        Vertex *mapped = nullptr;     ///< Write target inside a stream, or nullptr.
+        size_t first = 0;             ///< First vertex index of this batch in the stream.
+        size_t count = 0;             ///< Vertices accumulated.
+        size_t capacity = 0;          ///< Vertex limit of the open batch.
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        bool HasRoom(size_t vertices) const { return count == 0 || count + vertices <= capacity; }
+        const Vertex *data() const { return mapped ? mapped : staging.data(); }
+        void reserve(size_t vertices) { staging.reserve(vertices); }
+        void push_back(const Vertex &v)
+        {
+            if (mapped)
+                mapped[count] = v;
+            else
+                staging.push_back(v);
+            ++count;
+        }
+        void clear()
+        {
+            staging.clear();
+            mapped = nullptr;
+            count = 0;
+        }
+    };
+
+    VertexStream m_SpriteStream;    ///< BatchVertex ring.
+    VertexStream m_RectStream;      ///< ColoredVertex ring for rects.
+    VertexStream m_ParticleStream;  ///< ColoredVertex ring for particles.
+    VertexStream m_TextStream;      ///< TextVertex ring.
+    GLsync m_StreamFences[STREAM_SEGMENTS];  ///< Fence per segment, set when the frame moves on.
+    int m_StreamSegment;                     ///< Segment written this frame.
+    bool m_PersistentStreams;                ///< glBufferStorage path active.
+
+    /// @brief Allocate and map a ring (no-op if GL 4.4 is unavailable).
+    void CreateVertexStream(VertexStream &stream, size_t vertexSize, size_t segmentVertices,
+                            bool hasColor, bool hasTexSlot);
+
+    /// @brief Unmap and delete a ring.
+    void DestroyVertexStream(VertexStream &stream);
+
+    /// @brief Fence the finished segment and wait until the next one is free.
+    void AdvanceStreamSegment();
+
+    /**
+     * @brief Point an empty batch at the free space of @p stream.
+     *
+     * Selects the staging fallback when the stream is unavailable or the
+     * current segment has no room for another quad.
+     */
+    template <typename Vertex>
+    void OpenStreamBatch(StreamBatch<Vertex> &batch, VertexStream &stream, size_t maxVertices)
+    {
+        if (!batch.empty())
+            return;
+
+        const size_t freeVertices = stream.mapped ? (stream.segmentBytes - stream.head) / sizeof(Vertex) : 0;
+        if (freeVertices >= VERTICES_PER_SPRITE)
+        {
+            const size_t offset = static_cast<size_t>(m_StreamSegment) * stream.segmentBytes + stream.head;
+            batch.mapped = reinterpret_cast<Vertex *>(stream.mapped + offset);
+            batch.first = offset / sizeof(Vertex);
+            batch.capacity = std::min(freeVertices, maxVertices);
+        }
+        else
+        {
+            batch.mapped = nullptr;
+            batch.capacity = maxVertices;
+        }
+    }
+
     /// @}
 
     /// @}
@@ -243,13 +439,13 @@ private:
     /// @brief Maximum characters per DrawText call before flush.
     static constexpr size_t MAX_TEXT_QUADS = 2048;
 
-    /// @brief Vertex format for text quads.
-    struct TextVertex {
-        float x, y;   ///< Screen position.
-        float u, v;   ///< Font atlas UV.
-    };
+    /// @brief Vertex format for text quads (position relative to the text origin).
+    using TextVertex = TextMeshCache::Vertex;
 
-    std::vector<TextVertex> m_TextBatchVertices;  ///< Accumulated text geometry.
+    /// @brief Append the outline and main quads of @p text at the origin to @p mesh.
+    void BuildTextMesh(std::string_view text, float scale, float outlineSize, TextMeshCache::TextMesh &mesh) const;
+
+    TextMeshCache m_TextMeshes;                   ///< Quads of recently drawn strings.
     unsigned int m_TextVAO, m_TextVBO;            ///< Text-specific buffers.
 
     /// @}
@@ -262,18 +458,31 @@ private:
     static constexpr size_t VERTICES_PER_SPRITE = 6;   ///< Two triangles.
     static constexpr size_t FLOATS_PER_VERTEX = 4;     ///< x, y, u, v.
 
+    /// @brief Textures one sprite batch can sample (texture units 0..N-1).
+    static constexpr int MAX_BATCH_TEXTURE_SLOTS = 8;
+
     /// @brief Vertex format for batched sprites (pre-transformed).
     struct BatchVertex {
-        float x, y;   ///< Final screen position after perspective.
-        float u, v;   ///< Texture coordinates.
+        float x, y;     ///< Screen position (after perspective unless GPU projection is on).
+        float u, v;     ///< Texture coordinates.
+        float texSlot;  ///< Index into m_BatchTextures (sprite.frag spriteSlots[]).
     };
 
-    std::vector<BatchVertex> m_BatchVertices;  ///< Accumulated sprite geometry.
+    StreamBatch<BatchVertex> m_BatchVertices;  ///< Accumulated sprite geometry.
     unsigned int m_BatchVAO, m_BatchVBO;       ///< Sprite batch buffers.
-    unsigned int m_CurrentBatchTexture;        ///< Active texture for batching.
+    unsigned int m_BatchTextures[MAX_BATCH_TEXTURE_SLOTS]; ///< Textures bound for the batch, by slot.
+    int m_BatchTextureCount;                   ///< Slots in use (0 = no texture yet).
+    bool m_MultiTextureBatching;               ///< Allow more than one texture slot per batch.
+    bool m_BatchApplyPerspective;              ///< Batch is projected in the shader (GPU mode).
+
+    /// @brief Submit accumulated sprites to GPU and reset batch, counting the flush under @p reason.
+    void FlushBatch(RenderStats::FlushReason reason = RenderStats::FlushReason::StateChange);
 
-    /// @brief Submit accumulated sprites to GPU and reset batch.
-    void FlushBatch();
+    /**
+     * @brief Slot of @p texID in the open sprite batch, claiming a free slot if needed.
+     * @return Slot index, or -1 when the batch must be flushed first.
+     */
+    int AcquireBatchTextureSlot(unsigned int texID);
 
     /// @}
 
@@ -287,14 +496,14 @@ private:
         float r, g, b, a;  ///< Per-vertex color.
     };
 
-    std::vector<ColoredVertex> m_RectBatchVertices;  ///< Accumulated rect geometry.
+    StreamBatch<ColoredVertex> m_RectBatchVertices;  ///< Accumulated rect geometry.
     unsigned int m_RectBatchVAO, m_RectBatchVBO;     ///< Rect batch buffers.
     bool m_RectBatchAdditive;                        ///< Current blend mode.
 
     /// @}
 
-    /// @brief Submit accumulated rects to GPU and reset batch.
-    void FlushRectBatch();
+    /// @brief Submit accumulated rects to GPU and reset batch, counting the flush under @p reason.
+    void FlushRectBatch(RenderStats::FlushReason reason = RenderStats::FlushReason::StateChange);
 
     /// @brief Create VAO/VBO for colored rectangle batching.
     void SetupRectBatchBuffers();
@@ -302,20 +511,168 @@ private:
     /// @name Particle Batching
     /// @{
 
-    std::vector<ColoredVertex> m_ParticleBatchVertices;  ///< Particle geometry.
+    StreamBatch<ColoredVertex> m_ParticleBatchVertices;  ///< Particle geometry.
     unsigned int m_CurrentParticleTexture;               ///< Active particle texture.
     bool m_ParticleBatchAdditive;                        ///< Particle blend mode.
 
     /// @}
 
-    /// @brief Submit accumulated particles to GPU and reset batch.
-    void FlushParticleBatch();
+    /// @brief Submit accumulated particles to GPU and reset batch, counting the flush under @p reason.
+    void FlushParticleBatch(RenderStats::FlushReason reason = RenderStats::FlushReason::StateChange);
+
+    /// @brief Append one quad sampling GL texture @p texID to the particle batch.
+    void PushParticleQuad(unsigned int texID, glm::vec2 position, glm::vec2 size,
+                          glm::vec2 uvMin, glm::vec2 uvMax, float rotation,
+                          glm::vec4 color, bool additive);
+
+    /// @name Instanced Sprites
+    /// @{
+
+    unsigned int m_InstanceVAO = 0, m_InstanceVBO = 0;  ///< SpriteInstance attributes (divisor 1).
+    size_t m_InstanceCapacity = 0;                      ///< Instances the VBO can hold, grows on demand.
+
+    /// @brief Create the instance VAO/VBO used by DrawSpriteInstances().
+    void SetupInstanceBuffers();
+
+    /// @brief Point attributes 4-7 of the bound VAO at SpriteInstance records in @p buffer.
+    static void SetupInstanceAttributes(unsigned int buffer);
+
+    /// @brief Copy @p count records into m_InstanceVBO, growing it if needed.
+    void UploadInstances(const SpriteInstance *instances, size_t count);
+
+    /// @}
+
+    /// @name GPU Particles
+    /// @{
+
+    unsigned int m_ParticleComputeProgram = 0;  ///< shaders/particles.comp; 0 if unavailable.
+    unsigned int m_GpuParticleBuffer = 0;       ///< Particle slots (binding 0).
+    unsigned int m_GpuEmitterBuffer = 0;        ///< GpuParticleEmitter array (binding 1).
+    unsigned int m_GpuSpawnCounterBuffer = 0;   ///< Spawns claimed per emitter (binding 2).
+    unsigned int m_GpuInstanceBuffer = 0;       ///< Draw list (binding 3), also the instance VBO.
+    unsigned int m_GpuDrawCommandBuffer = 0;    ///< Two indirect draws (binding 4).
+    unsigned int m_GpuParticleVAO = 0;          ///< SpriteInstance attributes over m_GpuInstanceBuffer.
+    size_t m_GpuParticleSlots = 0;              ///< Slots allocated in the particle/instance buffers.
+    size_t m_GpuEmitterCapacity = 0;            ///< Emitters the emitter/counter buffers can hold.
+    bool m_GpuParticleDrawReady = false;        ///< A draw list was built since the last release.
+
+    /// @brief Compile the particle compute shader; leaves the program 0 on failure.
+    void SetupParticleCompute();
+
+    /// @brief Grow the GPU particle buffers; new slots start dead.
+    void EnsureGpuParticleBuffers(size_t slots, size_t emitters);
+
+    /// @}
+
+    /// @name GPU Star Field
+    /// @{
+
+    unsigned int m_StarFieldProgram = 0;  ///< shaders/stars.vert + stars.frag; 0 if unavailable.
+    unsigned int m_StarFieldVAO = 0;      ///< StarFieldStar attributes over m_StarFieldVBO.
+    unsigned int m_StarFieldVBO = 0;      ///< Uploaded StarFieldStar records.
+    size_t m_StarFieldCount = 0;          ///< Stars in m_StarFieldVBO.
+
+    /// @brief Compile the star field program; leaves it 0 on failure.
+    void SetupStarField();
+
+    /// @}
+
+    /// @name Static Meshes
+    /// @{
+
+    /// @brief Persistent GL_STATIC_DRAW geometry created by CreateStaticMesh().
+    struct StaticMesh {
+        unsigned int vao = 0;            ///< Vertex array (BatchVertex layout).
+        unsigned int vbo = 0;            ///< Vertex buffer.
+        GLsizei vertexCount = 0;         ///< Triangle vertices (6 per quad).
+        const Texture *texture = nullptr;///< Sampled texture (ID re-read each draw).
+    };
+
+    std::vector<StaticMesh> m_StaticMeshes;  ///< Indexed by mesh handle.
+    std::vector<int> m_FreeStaticMeshes;     ///< Recycled handles.
+
+    /// @}
 
     /// @name Performance Metrics
     /// @{
 
     int m_DrawCallCount = 0;  ///< Number of draw calls this frame (for debug display).
 
+    /// @brief Frames a timestamp query gets before it is read back.
+    static constexpr int GPU_TIMER_FRAMES = 3;
+
+    /// Query objects, one block per frame; 0 until created in Init().
+    unsigned int m_GpuTimerQueries[GPU_TIMER_FRAMES][GpuTimerFrame::MAX_QUERIES] = {};
+    GpuTimerFrame m_GpuTimerFrames[GPU_TIMER_FRAMES];  ///< Region bookkeeping per block.
+    int m_GpuTimerSlot = 0;                            ///< Block written this frame.
+
+    /// @brief Advance m_GpuTimerSlot, reading the oldest block back if it is ready.
+    void ResolveGpuTimers();
+
+    /// @}
+
+    /// @name Low-Resolution Pass
+    /// @{
+
+    unsigned int m_LowResFBO = 0;            ///< Framebuffer the world is drawn into.
+    unsigned int m_LowResTexture = 0;        ///< GL_RGBA8 color attachment, GL_NEAREST filtered.
+    int m_LowResWidth = 0;                   ///< Target size in pixels.
+    int m_LowResHeight = 0;
+    bool m_LowResActive = false;             ///< m_LowResFBO is bound.
+    bool m_LowResViewportChanged = false;    ///< EndLowResPass() moved the viewport this frame.
+    int m_Viewport[4] = {};                  ///< Last SetViewport() rectangle, restored in EndFrame().
+
+    /// @brief Create m_LowResFBO with a @p width x @p height attachment.
+    /// @return False if the framebuffer is incomplete (resources are released).
+    bool CreateLowResTarget(int width, int height);
+    void DestroyLowResTarget();
+
+    /// @}
+
+    /// @name Render Targets
+    /// @{
+
+    /// @brief Offscreen layer created by CreateRenderTarget().
+    struct RenderTarget {
+        unsigned int fbo = 0;      ///< Framebuffer; 0 marks a free handle.
+        unsigned int texture = 0;  ///< GL_RGBA16F color attachment.
+        int width = 0;
+        int height = 0;
+    };
+
+    std::vector<RenderTarget> m_RenderTargets;    ///< Indexed by target handle.
+    std::vector<int> m_FreeRenderTargets;         ///< Recycled handles.
+    int m_ActiveRenderTarget = -1;                ///< Bound by BeginRenderTarget(), -1 if none.
+    unsigned int m_RenderTargetPreviousFBO = 0;   ///< Draw framebuffer to restore in EndRenderTarget().
+    int m_RenderTargetPreviousViewport[4] = {};   ///< Viewport to restore in EndRenderTarget().
+
+    /// @}
+
+    /// @name Light Map
+    /// @{
+
+    /// sprite.frag samples the light map from this unit, after the batch slots
+    static constexpr int LIGHT_MAP_TEXTURE_UNIT = 8;
+
+    unsigned int m_LightMapFBO = 0;           ///< Framebuffer lights are splatted into.
+    unsigned int m_LightMapTexture = 0;       ///< GL_RGBA16F color attachment, GL_LINEAR filtered.
+    int m_LightMapWidth = 0;                  ///< Light map size in texels.
+    int m_LightMapHeight = 0;
+    bool m_LightMapActive = false;            ///< SetLightMap() succeeded and no ClearLightMap() yet.
+    glm::vec4 m_LightMapRect{0.0f};           ///< Viewport the map covers: origin, 1 / size.
+    unsigned int m_LightFalloffTexture = 0;   ///< Radial falloff splatted per light, GL_RGBA8.
+    std::vector<SpriteInstance> m_LightInstances;  ///< Reused per SetLightMap().
+    std::vector<float> m_LightCenterX;        ///< Light centers being projected.
+    std::vector<float> m_LightCenterY;
+
+    /// @brief Create m_LightMapFBO with a @p width x @p height attachment.
+    /// @return False if the framebuffer is incomplete (resources are released).
+    bool CreateLightMapTarget(int width, int height);
+    void DestroyLightMapTarget();
+
+    /// @brief Generate m_LightFalloffTexture (smooth radial falloff, opaque alpha).
+    void CreateLightFalloffTexture();
+
     /// @}
 
     /// @name Shader Loading
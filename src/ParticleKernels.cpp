@@ -0,0 +1,293 @@
+#include "ParticleKernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WILD_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define WILD_TARGET_AVX2
+#else
+#define WILD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define WILD_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+using IntegrateFn = void (*)(float *, float *, float *, const float *, const float *, std::size_t, float);
+using CullFn = void (*)(const float *, const float *, const float *, std::size_t, glm::vec2, glm::vec2, float,
+                        float, std::uint8_t *);
+
+// Scalar loops double as the tail handlers of the vector paths
+void IntegrateScalar(float *lifetime, float *positionX, float *positionY, const float *velocityX,
+                     const float *velocityY, std::size_t count, float deltaTime)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        lifetime[i] -= deltaTime;
+        positionX[i] += velocityX[i] * deltaTime;
+        positionY[i] += velocityY[i] * deltaTime;
+    }
+}
+
+void CullScalar(const float *positionX, const float *positionY, const float *size, std::size_t count,
+                glm::vec2 viewMin, glm::vec2 viewMax, float sizePadding, float padding, std::uint8_t *visible)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float pad = size[i] * sizePadding + padding;
+        const bool inX = (positionX[i] >= viewMin.x - pad) & (positionX[i] <= viewMax.x + pad);
+        const bool inY = (positionY[i] >= viewMin.y - pad) & (positionY[i] <= viewMax.y + pad);
+        visible[i] = static_cast<std::uint8_t>(inX & inY);
+    }
+}
+
+#if WILD_KERNELS_X86
+void IntegrateSSE2(float *lifetime, float *positionX, float *positionY, const float *velocityX,
+                   const float *velocityY, std::size_t count, float deltaTime)
+{
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(lifetime + i, _mm_sub_ps(_mm_loadu_ps(lifetime + i), dt));
+        _mm_storeu_ps(positionX + i,
+                      _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(_mm_loadu_ps(velocityX + i), dt)));
+        _mm_storeu_ps(positionY + i,
+                      _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(_mm_loadu_ps(velocityY + i), dt)));
+    }
+    IntegrateScalar(lifetime + i, positionX + i, positionY + i, velocityX + i, velocityY + i, count - i, deltaTime);
+}
+
+void CullSSE2(const float *positionX, const float *positionY, const float *size, std::size_t count,
+              glm::vec2 viewMin, glm::vec2 viewMax, float sizePadding, float padding, std::uint8_t *visible)
+{
+    const __m128 minX = _mm_set1_ps(viewMin.x), maxX = _mm_set1_ps(viewMax.x);
+    const __m128 minY = _mm_set1_ps(viewMin.y), maxY = _mm_set1_ps(viewMax.y);
+    const __m128 scale = _mm_set1_ps(sizePadding), bias = _mm_set1_ps(padding);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 pad = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(size + i), scale), bias);
+        const __m128 x = _mm_loadu_ps(positionX + i);
+        const __m128 y = _mm_loadu_ps(positionY + i);
+        __m128 in = _mm_and_ps(_mm_cmpge_ps(x, _mm_sub_ps(minX, pad)), _mm_cmple_ps(x, _mm_add_ps(maxX, pad)));
+        in = _mm_and_ps(in, _mm_cmpge_ps(y, _mm_sub_ps(minY, pad)));
+        in = _mm_and_ps(in, _mm_cmple_ps(y, _mm_add_ps(maxY, pad)));
+        // Narrow the 32-bit lane masks to one 0/1 byte per particle
+        const __m128i bits = _mm_srli_epi32(_mm_castps_si128(in), 31);
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(bits, bits), _mm_setzero_si128());
+        const int packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(visible + i, &packed, 4);
+    }
+    CullScalar(positionX + i, positionY + i, size + i, count - i, viewMin, viewMax, sizePadding, padding,
+               visible + i);
+}
+
+WILD_TARGET_AVX2 void IntegrateAVX2(float *lifetime, float *positionX, float *positionY, const float *velocityX,
+                                    const float *velocityY, std::size_t count, float deltaTime)
+{
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_ps(lifetime + i, _mm256_sub_ps(_mm256_loadu_ps(lifetime + i), dt));
+        _mm256_storeu_ps(positionX + i, _mm256_add_ps(_mm256_loadu_ps(positionX + i),
+                                                      _mm256_mul_ps(_mm256_loadu_ps(velocityX + i), dt)));
+        _mm256_storeu_ps(positionY + i, _mm256_add_ps(_mm256_loadu_ps(positionY + i),
+                                                      _mm256_mul_ps(_mm256_loadu_ps(velocityY + i), dt)));
+    }
+    IntegrateSSE2(lifetime + i, positionX + i, positionY + i, velocityX + i, velocityY + i, count - i, deltaTime);
+}
+
+WILD_TARGET_AVX2 void CullAVX2(const float *positionX, const float *positionY, const float *size,
+                               std::size_t count, glm::vec2 viewMin, glm::vec2 viewMax, float sizePadding,
+                               float padding, std::uint8_t *visible)
+{
+    const __m256 minX = _mm256_set1_ps(viewMin.x), maxX = _mm256_set1_ps(viewMax.x);
+    const __m256 minY = _mm256_set1_ps(viewMin.y), maxY = _mm256_set1_ps(viewMax.y);
+    const __m256 scale = _mm256_set1_ps(sizePadding), bias = _mm256_set1_ps(padding);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256 pad = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(size + i), scale), bias);
+        const __m256 x = _mm256_loadu_ps(positionX + i);
+        const __m256 y = _mm256_loadu_ps(positionY + i);
+        __m256 in = _mm256_and_ps(_mm256_cmp_ps(x, _mm256_sub_ps(minX, pad), _CMP_GE_OQ),
+                                  _mm256_cmp_ps(x, _mm256_add_ps(maxX, pad), _CMP_LE_OQ));
+        in = _mm256_and_ps(in, _mm256_cmp_ps(y, _mm256_sub_ps(minY, pad), _CMP_GE_OQ));
+        in = _mm256_and_ps(in, _mm256_cmp_ps(y, _mm256_add_ps(maxY, pad), _CMP_LE_OQ));
+        const __m256i bits = _mm256_srli_epi32(_mm256_castps_si256(in), 31);
+        const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(visible + i), _mm_packus_epi16(words, words));
+    }
+    CullSSE2(positionX + i, positionY + i, size + i, count - i, viewMin, viewMax, sizePadding, padding,
+             visible + i);
+}
+
+bool CpuHasAVX2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;  // The OS does not save YMM registers
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if WILD_KERNELS_NEON
+void IntegrateNEON(float *lifetime, float *positionX, float *positionY, const float *velocityX,
+                   const float *velocityY, std::size_t count, float deltaTime)
+{
+    const float32x4_t dt = vdupq_n_f32(deltaTime);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        // vmulq + vaddq rather than vmlaq/vfmaq so results match the scalar path
+        vst1q_f32(lifetime + i, vsubq_f32(vld1q_f32(lifetime + i), dt));
+        vst1q_f32(positionX + i, vaddq_f32(vld1q_f32(positionX + i), vmulq_f32(vld1q_f32(velocityX + i), dt)));
+        vst1q_f32(positionY + i, vaddq_f32(vld1q_f32(positionY + i), vmulq_f32(vld1q_f32(velocityY + i), dt)));
+    }
+    IntegrateScalar(lifetime + i, positionX + i, positionY + i, velocityX + i, velocityY + i, count - i, deltaTime);
+}
+
+void CullNEON(const float *positionX, const float *positionY, const float *size, std::size_t count,
+              glm::vec2 viewMin, glm::vec2 viewMax, float sizePadding, float padding, std::uint8_t *visible)
+{
+    const float32x4_t minX = vdupq_n_f32(viewMin.x), maxX = vdupq_n_f32(viewMax.x);
+    const float32x4_t minY = vdupq_n_f32(viewMin.y), maxY = vdupq_n_f32(viewMax.y);
+    const float32x4_t scale = vdupq_n_f32(sizePadding), bias = vdupq_n_f32(padding);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float32x4_t pad = vaddq_f32(vmulq_f32(vld1q_f32(size + i), scale), bias);
+        const float32x4_t x = vld1q_f32(positionX + i);
+        const float32x4_t y = vld1q_f32(positionY + i);
+        uint32x4_t in = vandq_u32(vcgeq_f32(x, vsubq_f32(minX, pad)), vcleq_f32(x, vaddq_f32(maxX, pad)));
+        in = vandq_u32(in, vcgeq_f32(y, vsubq_f32(minY, pad)));
+        in = vandq_u32(in, vcleq_f32(y, vaddq_f32(maxY, pad)));
+        // Narrow the 32-bit lane masks to one byte per particle
+        const uint16x4_t narrow16 = vmovn_u32(in);
+        const uint8x8_t narrow8 = vmovn_u16(vcombine_u16(narrow16, narrow16));
+        std::uint8_t bytes[8];
+        vst1_u8(bytes, vand_u8(narrow8, vdup_n_u8(1)));
+        for (int k = 0; k < 4; ++k)
+        {
+            visible[i + k] = bytes[k];
+        }
+    }
+    CullScalar(positionX + i, positionY + i, size + i, count - i, viewMin, viewMax, sizePadding, padding,
+               visible + i);
+}
+#endif
+
+struct KernelTable
+{
+    ParticleKernels::Isa isa;
+    IntegrateFn integrate;
+    CullFn cull;
+};
+
+KernelTable MakeTable(ParticleKernels::Isa isa)
+{
+    switch (isa)
+    {
+#if WILD_KERNELS_X86
+        case ParticleKernels::Isa::AVX2:
+            if (CpuHasAVX2())
+            {
+                return {isa, IntegrateAVX2, CullAVX2};
+            }
+            break;
+        case ParticleKernels::Isa::SSE2:
+            return {isa, IntegrateSSE2, CullSSE2};
+#endif
+#if WILD_KERNELS_NEON
+        case ParticleKernels::Isa::NEON:
+            return {isa, IntegrateNEON, CullNEON};
+#endif
+        default:
+            break;
+    }
+    return {ParticleKernels::Isa::Scalar, IntegrateScalar, CullScalar};
+}
+
+KernelTable &Table()
+{
+    static KernelTable table = MakeTable(ParticleKernels::GetBestIsa());
+    return table;
+}
+}  // namespace
+
+bool ParticleKernels::IsSupported(Isa isa)
+{
+    return MakeTable(isa).isa == isa;
+}
+
+ParticleKernels::Isa ParticleKernels::GetBestIsa()
+{
+#if WILD_KERNELS_X86
+    return CpuHasAVX2() ? Isa::AVX2 : Isa::SSE2;
+#elif WILD_KERNELS_NEON
+    return Isa::NEON;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+ParticleKernels::Isa ParticleKernels::GetIsa()
+{
+    return Table().isa;
+}
+
+void ParticleKernels::SetIsa(Isa isa)
+{
+    Table() = MakeTable(isa);
+}
+
+const char *ParticleKernels::GetIsaName(Isa isa)
+{
+    switch (isa)
+    {
+        case Isa::SSE2:
+            return "SSE2";
+        case Isa::AVX2:
+            return "AVX2";
+        case Isa::NEON:
+            return "NEON";
+        case Isa::Scalar:
+        default:
+            return "Scalar";
+    }
+}
+
+void ParticleKernels::Integrate(float *lifetime, float *positionX, float *positionY, const float *velocityX,
+                                const float *velocityY, std::size_t count, float deltaTime)
+{
+    Table().integrate(lifetime, positionX, positionY, velocityX, velocityY, count, deltaTime);
+}
+
+void ParticleKernels::Cull(const float *positionX, const float *positionY, const float *size, std::size_t count,
+                           glm::vec2 viewMin, glm::vec2 viewMax, float sizePadding, float padding,
+                           std::uint8_t *visible)
+{
+    Table().cull(positionX, positionY, size, count, viewMin, viewMax, sizePadding, padding, visible);
+}
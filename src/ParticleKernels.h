@@ -0,0 +1,103 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class ParticleKernels
+ * @brief Vectorized bulk passes over ParticlePool arrays.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Effects
+ *
+ * The parts of the particle update that are the same for every particle
+ * type run here, 4 or 8 particles per instruction, over the packed arrays.
+ * Type-specific motion and fades stay in ParticleSystem::Update(), which
+ * branches per particle and is dominated by its sin/cos calls.
+ *
+ * | Kernel      | Reads                     | Writes                    |
+ * |-------------|---------------------------|---------------------------|
+ * | Integrate() | lifetime, position, velocity | lifetime, position     |
+ * | Cull()      | position, size            | one visibility byte each  |
+ *
+ * @par Instruction Sets
+ * The widest supported set is picked at runtime on first use:
+ * AVX2 (8 wide) or SSE2 (4 wide) on x86-64, NEON (4 wide) on ARM64, and a
+ * scalar loop everywhere else. SetIsa() forces a narrower set, which the
+ * tests and benchmarks use to compare paths.
+ *
+ * @par Results
+ * Every path performs the same single-precision operations in the same
+ * order (no fused multiply-add), so all of them produce bit-identical
+ * results.
+ *
+ * @par Thread Safety
+ * Kernels are reentrant. SetIsa() must not race with kernel calls.
+ *
+ * @see ParticlePool, ParticleSystem::Update(), ParticleSystem::Render()
+ */
+class ParticleKernels
+{
+public:
+    /// @brief Instruction set a kernel path is written for.
+    enum class Isa : std::uint8_t
+    {
+        Scalar,
+        SSE2,
+        AVX2,
+        NEON
+    };
+
+    /// @brief `true` if @p isa can run on this CPU and build.
+    static bool IsSupported(Isa isa);
+
+    /// @brief Widest instruction set supported here.
+    static Isa GetBestIsa();
+
+    /// @brief Instruction set the kernels currently use.
+    static Isa GetIsa();
+
+    /// @brief Force an instruction set; unsupported ones fall back to Scalar.
+    static void SetIsa(Isa isa);
+
+    /// @brief Display name ("AVX2", "SSE2", ...).
+    static const char *GetIsaName(Isa isa);
+
+    /**
+     * @brief Age particles and advance them along their velocity.
+     *
+     * For each particle: `lifetime -= dt`, `position += velocity * dt`.
+     *
+     * @param lifetime   Remaining lifetime per particle (updated).
+     * @param positionX  X position per particle (updated).
+     * @param positionY  Y position per particle (updated).
+     * @param velocityX  X velocity per particle.
+     * @param velocityY  Y velocity per particle.
+     * @param count      Number of particles.
+     * @param deltaTime  Frame time in seconds.
+     */
+    static void Integrate(float *lifetime, float *positionX, float *positionY,
+                          const float *velocityX, const float *velocityY,
+                          std::size_t count, float deltaTime);
+
+    /**
+     * @brief Mark particles whose padded square lies in a rectangle.
+     *
+     * A particle is visible when its position is inside [@p viewMin, @p viewMax]
+     * grown by `size * sizePadding + padding` on every side (bounds inclusive).
+     *
+     * @param positionX   X position per particle.
+     * @param positionY   Y position per particle.
+     * @param size        Sprite size per particle.
+     * @param count       Number of particles.
+     * @param viewMin     Top-left of the visible rectangle.
+     * @param viewMax     Bottom-right of the visible rectangle.
+     * @param sizePadding Padding per unit of particle size.
+     * @param padding     Constant padding.
+     * @param visible     Receives 1 (visible) or 0 per particle.
+     */
+    static void Cull(const float *positionX, const float *positionY, const float *size,
+                     std::size_t count, glm::vec2 viewMin, glm::vec2 viewMax,
+                     float sizePadding, float padding, std::uint8_t *visible);
+};
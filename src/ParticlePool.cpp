@@ -0,0 +1,159 @@
+#include "ParticlePool.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+
+ParticlePool::ParticlePool(std::size_t capacity)
+{
+    SetCapacity(capacity);
+}
+
+void ParticlePool::SetCapacity(std::size_t capacity)
+{
+    // Drop particles that no longer fit so the zone counts stay exact
+    while (m_Count > capacity)
+    {
+        Remove(m_Count - 1);
+    }
+
+    m_Capacity = capacity;
+    m_PositionX.resize(capacity);
+    m_PositionY.resize(capacity);
+    m_VelocityX.resize(capacity);
+    m_VelocityY.resize(capacity);
+    m_Color.resize(capacity);
+    m_Size.resize(capacity);
+    m_Lifetime.resize(capacity);
+    m_MaxLifetime.resize(capacity);
+    m_Phase.resize(capacity);
+    m_Rotation.resize(capacity);
+    m_Additive.resize(capacity);
+    m_NoProjection.resize(capacity);
+    m_ZoneIndex.resize(capacity);
+    m_Type.resize(capacity);
+}
+
+bool ParticlePool::Add(const Particle &particle)
+{
+    if (m_Count == m_Capacity)
+    {
+        return false;
+    }
+
+    const std::size_t i = m_Count++;
+    m_PositionX[i] = particle.position.x;
+    m_PositionY[i] = particle.position.y;
+    m_VelocityX[i] = particle.velocity.x;
+    m_VelocityY[i] = particle.velocity.y;
+    m_Color[i] = particle.color;
+    m_Size[i] = particle.size;
+    m_Lifetime[i] = particle.lifetime;
+    m_MaxLifetime[i] = particle.maxLifetime;
+    m_Phase[i] = particle.phase;
+    m_Rotation[i] = particle.rotation;
+    m_Additive[i] = particle.additive ? 1 : 0;
+    m_NoProjection[i] = particle.noProjection ? 1 : 0;
+    m_ZoneIndex[i] = particle.zoneIndex;
+    m_Type[i] = particle.type;
+    CountZone(particle.zoneIndex, +1);
+    return true;
+}
+
+void ParticlePool::Remove(std::size_t index)
+{
+    CountZone(m_ZoneIndex[index], -1);
+
+    const std::size_t last = --m_Count;
+    if (index != last)
+    {
+        m_PositionX[index] = m_PositionX[last];
+        m_PositionY[index] = m_PositionY[last];
+        m_VelocityX[index] = m_VelocityX[last];
+        m_VelocityY[index] = m_VelocityY[last];
+        m_Color[index] = m_Color[last];
+        m_Size[index] = m_Size[last];
+        m_Lifetime[index] = m_Lifetime[last];
+        m_MaxLifetime[index] = m_MaxLifetime[last];
+        m_Phase[index] = m_Phase[last];
+        m_Rotation[index] = m_Rotation[last];
+        m_Additive[index] = m_Additive[last];
+        m_NoProjection[index] = m_NoProjection[last];
+        m_ZoneIndex[index] = m_ZoneIndex[last];
+        m_Type[index] = m_Type[last];
+    }
+}
+
+Particle ParticlePool::Get(std::size_t index) const
+{
+    Particle p;
+    p.position = glm::vec2(m_PositionX[index], m_PositionY[index]);
+    p.velocity = glm::vec2(m_VelocityX[index], m_VelocityY[index]);
+    p.color = m_Color[index];
+    p.size = m_Size[index];
+    p.lifetime = m_Lifetime[index];
+    p.maxLifetime = m_MaxLifetime[index];
+    p.phase = m_Phase[index];
+    p.rotation = m_Rotation[index];
+    p.additive = m_Additive[index] != 0;
+    p.noProjection = m_NoProjection[index] != 0;
+    p.zoneIndex = m_ZoneIndex[index];
+    p.type = m_Type[index];
+    return p;
+}
+
+void ParticlePool::Clear()
+{
+    m_Count = 0;
+    std::fill(m_ZoneCounts.begin(), m_ZoneCounts.end(), 0u);
+}
+
+std::size_t ParticlePool::GetMemoryBytes() const
+{
+    return MemoryTracker::CapacityBytes(m_PositionX, m_PositionY, m_VelocityX, m_VelocityY, m_Color, m_Size,
+                                        m_Lifetime, m_MaxLifetime, m_Phase, m_Rotation, m_Additive,
+                                        m_NoProjection, m_ZoneIndex, m_Type, m_ZoneCounts);
+}
+
+std::size_t ParticlePool::GetZoneCount(int zoneIndex) const
+{
+    if (zoneIndex < 0 || static_cast<std::size_t>(zoneIndex) >= m_ZoneCounts.size())
+    {
+        return 0;
+    }
+    return m_ZoneCounts[zoneIndex];
+}
+
+void ParticlePool::RemoveZone(int zoneIndex)
+{
+    for (std::size_t i = 0; i < m_Count;)
+    {
+        if (m_ZoneIndex[i] == zoneIndex)
+        {
+            Remove(i);
+            continue;
+        }
+        if (m_ZoneIndex[i] > zoneIndex)
+        {
+            m_ZoneIndex[i]--;
+        }
+        ++i;
+    }
+
+    if (zoneIndex >= 0 && static_cast<std::size_t>(zoneIndex) < m_ZoneCounts.size())
+    {
+        m_ZoneCounts.erase(m_ZoneCounts.begin() + zoneIndex);
+    }
+}
+
+void ParticlePool::CountZone(int zoneIndex, int delta)
+{
+    if (zoneIndex < 0)
+    {
+        return;
+    }
+    if (static_cast<std::size_t>(zoneIndex) >= m_ZoneCounts.size())
+    {
+        m_ZoneCounts.resize(static_cast<std::size_t>(zoneIndex) + 1, 0u);
+    }
+    m_ZoneCounts[zoneIndex] = static_cast<std::uint32_t>(static_cast<int>(m_ZoneCounts[zoneIndex]) + delta);
+}
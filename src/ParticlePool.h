@@ -0,0 +1,179 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum ParticleType
+ * @brief Categories of particle effects with distinct visual behaviors.
+ * @author Alex (https://github.com/lextpf)
+ *
+ * Each type has unique spawn, movement, and rendering characteristics.
+ *
+ * | Type     | Movement        | Blending | Use Case              |
+ * |----------|-----------------|----------|-----------------------|
+ * | Firefly  | Drifting, pulse | Additive | Night ambiance        |
+ * | Rain     | Fast downward   | Alpha    | Weather               |
+ * | Snow     | Slow drift down | Additive | Weather               |
+ * | Fog      | Slow drift      | Alpha    | Atmosphere            |
+ * | Sparkles | Stationary      | Additive | Magic/treasure        |
+ * | Wisp     | Spiral wander   | Additive | Magical areas         |
+ * | Lantern  | Stationary glow | Additive | Night lighting        |
+ * | Sunshine | Angled rays     | Additive | Forest clearings      |
+ */
+enum class ParticleType : std::uint8_t
+{
+    Firefly = 0,   ///< Pulsing yellow-green glow, gentle drift
+    Rain = 1,      ///< Fast falling droplets, slight angle
+    Snow = 2,      ///< Slow falling flakes with side drift
+    Fog = 3,       ///< Large translucent patches, very slow
+    Sparkles = 4,  ///< Brief bright flashes, stationary
+    Wisp = 5,      ///< Magical spiraling orbs, color variety
+    Lantern = 6,   ///< Warm glow, night-only visibility
+    Sunshine = 7   ///< Sun rays (day=yellow) / moon beams (night=blue)
+};
+
+/**
+ * @struct Particle
+ * @brief Runtime state for a single active particle.
+ * @author Alex (https://github.com/lextpf)
+ *
+ * Particles are spawned by zones and updated each frame until their
+ * lifetime expires. The `type` field is stored directly to handle
+ * cases where the spawning zone is deleted mid-flight.
+ *
+ * This is the interchange form used to spawn and inspect particles;
+ * live particles are stored field by field in a ParticlePool.
+ */
+struct Particle
+{
+    glm::vec2 position;     ///< World position (pixels).
+    glm::vec2 velocity;     ///< Movement per second (pixels/s).
+    glm::vec4 color;        ///< RGBA color (alpha may animate).
+    float size;             ///< Sprite size in pixels.
+    float lifetime;         ///< Remaining life (seconds).
+    float maxLifetime;      ///< Original lifetime for fade calculations.
+    float phase;            ///< Random phase offset for oscillation effects.
+    float rotation;         ///< Sprite rotation (degrees).
+    bool additive;          ///< Use additive blending for glow.
+    bool noProjection;      ///< Render without perspective distortion.
+    int zoneIndex;          ///< Spawning zone index (-1 for orphaned).
+    ParticleType type;      ///< Particle behavior type.
+};
+
+/**
+ * @class ParticlePool
+ * @brief Fixed-capacity structure-of-arrays storage for live particles.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Effects
+ *
+ * Every particle attribute lives in its own array, so the per-frame passes
+ * (lifetime, integration, fades, culling) stream through exactly the fields
+ * they touch. All arrays are allocated up front for the full capacity;
+ * spawning and removal never allocate.
+ *
+ * @par Removal
+ * Remove() moves the last particle into the hole, so it is O(1) and a
+ * frame in which many particles die stays linear. Particle order is not
+ * preserved; iterate with an index and do not advance it after a removal.
+ *
+ * @par Zone Budgets
+ * The pool keeps a live count per spawning zone, so a per-zone cap is a
+ * lookup instead of a scan over every particle.
+ *
+ * @par Example
+ * @code{.cpp}
+ * for (size_t i = 0; i < pool.Size();)
+ * {
+ *     pool.m_Lifetime[i] -= dt;
+ *     if (pool.m_Lifetime[i] <= 0.0f)
+ *     {
+ *         pool.Remove(i);  // Last particle now sits at i
+ *         continue;
+ *     }
+ *     ++i;
+ * }
+ * @endcode
+ *
+ * @see ParticleSystem
+ */
+class ParticlePool
+{
+public:
+    /// @brief Capacity used unless SetCapacity() is called.
+    static constexpr std::size_t DEFAULT_CAPACITY = 8192;
+
+    explicit ParticlePool(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Change the capacity (allocates).
+     *
+     * Particles past the new capacity are dropped.
+     */
+    void SetCapacity(std::size_t capacity);
+
+    [[nodiscard]] std::size_t GetCapacity() const { return m_Capacity; }
+
+    /// @brief Heap bytes of the attribute arrays and zone counts.
+    [[nodiscard]] std::size_t GetMemoryBytes() const;
+    [[nodiscard]] std::size_t Size() const { return m_Count; }
+    [[nodiscard]] bool Empty() const { return m_Count == 0; }
+    [[nodiscard]] bool IsFull() const { return m_Count == m_Capacity; }
+
+    /**
+     * @brief Append a particle.
+     * @return `false` if the pool is full (the particle is dropped).
+     */
+    bool Add(const Particle &particle);
+
+    /// @brief Remove the particle at @p index by moving the last one into its place.
+    void Remove(std::size_t index);
+
+    /// @brief Copy of the particle at @p index.
+    [[nodiscard]] Particle Get(std::size_t index) const;
+
+    /// @brief Remove every particle.
+    void Clear();
+
+    /// @brief Live particles spawned by @p zoneIndex.
+    [[nodiscard]] std::size_t GetZoneCount(int zoneIndex) const;
+
+    /**
+     * @brief Remove the particles of a deleted zone and renumber the rest.
+     *
+     * Particles of zones above @p zoneIndex move down one index, matching
+     * the erase from the zone list.
+     */
+    void RemoveZone(int zoneIndex);
+
+    /// @name Attribute Arrays
+    /// Entries [0, Size()) are live. Sized to the capacity; do not resize.
+    /// @{
+
+    std::vector<float> m_PositionX;
+    std::vector<float> m_PositionY;
+    std::vector<float> m_VelocityX;
+    std::vector<float> m_VelocityY;
+    std::vector<glm::vec4> m_Color;
+    std::vector<float> m_Size;
+    std::vector<float> m_Lifetime;
+    std::vector<float> m_MaxLifetime;
+    std::vector<float> m_Phase;
+    std::vector<float> m_Rotation;
+    std::vector<std::uint8_t> m_Additive;
+    std::vector<std::uint8_t> m_NoProjection;
+    std::vector<int> m_ZoneIndex;
+    std::vector<ParticleType> m_Type;
+
+    /// @}
+
+private:
+    void CountZone(int zoneIndex, int delta);
+
+    std::size_t m_Count = 0;
+    std::size_t m_Capacity = 0;
+    std::vector<std::uint32_t> m_ZoneCounts;  ///< Live particles per zone index
+};
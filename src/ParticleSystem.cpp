@@ -1,4 +1,7 @@
 #include "ParticleSystem.h"
+#include "ParticleKernels.h"
+#include "Profiler.h"
+#include "TextureBaker.h"
 #include "Tilemap.h"
 
 #include <algorithm>
@@ -10,6 +13,15 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace
+{
+// Weather types take wind and are the ones the GPU path simulates
+bool IsWeather(ParticleType type)
+{
+    return type == ParticleType::Rain || type == ParticleType::Snow || type == ParticleType::Fog;
+}
+}  // namespace
+
 ParticleSystem::ParticleSystem()
     : m_Zones(nullptr)                             // Particle zones from tilemap
     , m_Tilemap(nullptr)                           // Reference to tilemap for structure queries
@@ -18,16 +30,138 @@ ParticleSystem::ParticleSystem()
     , m_TileHeight(32), m_MaxParticlesPerZone(25)  // Particle density cap per zone
     , m_Time(0.0f)                                 // Accumulated time for animation cycles
     , m_NightFactor(0.0f)                          // Day & night blend (0 = day, 1 = night)
+    , m_Wind(0.0f)                                 // No wind until the game sets one
+    // Firefly, Rain, Snow, Fog, Sparkles, Wisp, Lantern, Sunshine
+    , m_ZonePriorities{1.0f, 1.0f, 1.0f, 0.5f, 1.0f, 1.5f, 2.0f, 1.0f}
+    , m_ParticleBudget(0)                          // Whole pool shared by scheduled zones
+    , m_ZoneRevision(0)                            // Tilemap zone revision last indexed
+    , m_ZoneIndexDirty(true)                       // Index on the first Update()
+    , m_GpuSimulation(false)                       // Opt-in, needs renderer support
+    , m_GpuParticlesPerZone(16384)                 // GPU slots per weather zone
+    , m_GpuDensity(1.0f)                           // Same spawn rate as the CPU path
+    , m_GpuPendingDelta(0.0f)                      // Time since the last GPU step
+    , m_GpuStepCount(0)                            // GPU spawn seed
+    , m_GpuLayoutDirty(true)                       // First step starts from empty slots
     , m_Rng(std::random_device{}())                // Seeded Mersenne Twister RNG
     , m_Dist01(0.0f, 1.0f)                         // Uniform distribution for random values
     , m_TexturesLoaded(false)                      // Lazy-load flag for particle sprites
 {
-    m_Particles.reserve(500);  // Pre-allocate to reduce reallocations
+    m_AtlasTexture.SetMemoryTag(MemoryTracker::Subsystem::Particles);
+}
+
+void ParticleSystem::SetGpuSimulation(bool enabled)
+{
+    if (enabled == m_GpuSimulation)
+        return;
+
+    m_GpuSimulation = enabled;
+    m_GpuLayoutDirty = true;
+    if (!enabled)
+    {
+        m_GpuEmitters.clear();
+        m_GpuEmitterZones.clear();
+        m_GpuEmitterOfZone.clear();
+    }
+}
+
+void ParticleSystem::SetZonePriority(ParticleType type, float priority)
+{
+    const auto index = static_cast<size_t>(type);
+    if (index < m_ZonePriorities.size())
+    {
+        m_ZonePriorities[index] = std::max(priority, 0.0f);
+        m_ZoneIndexDirty = true;
+    }
+}
+
+void ParticleSystem::SyncZoneIndex()
+{
+    const std::uint64_t revision = m_Tilemap ? m_Tilemap->GetParticleZoneRevision() : 0;
+    if (!m_ZoneIndexDirty && revision == m_ZoneRevision && m_Zones->size() == m_Scheduler.GetZoneCount())
+        return;
+
+    m_ScheduledZones.resize(m_Zones->size());
+    for (size_t i = 0; i < m_Zones->size(); ++i)
+    {
+        const ParticleZone &zone = (*m_Zones)[i];
+        ParticleZoneScheduler::Zone &entry = m_ScheduledZones[i];
+        entry.position = zone.position;
+        entry.size = zone.size;
+        const auto type = static_cast<size_t>(zone.type);
+        entry.priority = type < m_ZonePriorities.size() ? m_ZonePriorities[type] : 1.0f;
+        entry.enabled = zone.enabled;
+    }
+    m_Scheduler.SetZones(m_ScheduledZones);
+    m_ZoneRevision = revision;
+    m_ZoneIndexDirty = false;
+}
+
+void ParticleSystem::SetGpuParticlesPerZone(size_t count)
+{
+    m_GpuParticlesPerZone = std::max<size_t>(count, 1);
+}
+
+void ParticleSystem::SetSeed(std::uint32_t seed)
+{
+    m_Rng.seed(seed);
+    m_Dist01.reset();
+    m_GpuStepCount = 0;
+}
+
+void ParticleSystem::SyncGpuEmitters()
+{
+    // Emitters own fixed slot ranges, so any change to which zones run on
+    // the GPU, or to their types, invalidates every live GPU particle
+    const auto slotCount = static_cast<std::uint32_t>(m_GpuParticlesPerZone);
+    m_GpuEmitterOfZone.assign(m_Zones->size(), -1);
+
+    size_t emitterCount = 0;
+    for (size_t i = 0; i < m_Zones->size(); ++i)
+    {
+        const ParticleZone &zone = (*m_Zones)[i];
+        if (!IsWeather(zone.type) || zone.noProjection)
+            continue;
+
+        if (emitterCount == m_GpuEmitters.size())
+        {
+            m_GpuEmitters.push_back({});
+            m_GpuEmitterZones.push_back(-1);
+        }
+        IRenderer::GpuParticleEmitter &emitter = m_GpuEmitters[emitterCount];
+        const auto type = static_cast<std::uint32_t>(zone.type);
+        if (m_GpuEmitterZones[emitterCount] != static_cast<int>(i) || emitter.type != type ||
+            emitter.slotCount != slotCount)
+        {
+            m_GpuLayoutDirty = true;
+            m_GpuEmitterZones[emitterCount] = static_cast<int>(i);
+            emitter.spawnCount = 0;
+        }
+
+        // Zones can be moved in the editor, so the rectangle is refreshed every frame
+        const AtlasRegion &region = m_AtlasRegions[type];
+        emitter.position = zone.position;
+        emitter.size = zone.size;
+        emitter.uvRect = glm::vec4(region.uvMin, region.uvMax);
+        emitter.type = type;
+        emitter.firstSlot = static_cast<std::uint32_t>(emitterCount) * slotCount;
+        emitter.slotCount = slotCount;
+        emitter.flags = zone.type == ParticleType::Snow ? IRenderer::GPU_PARTICLE_ADDITIVE : 0u;  // As SpawnSnow()
+
+        m_GpuEmitterOfZone[i] = static_cast<int>(emitterCount);
+        ++emitterCount;
+    }
+
+    if (emitterCount != m_GpuEmitters.size())
+    {
+        m_GpuLayoutDirty = true;
+        m_GpuEmitters.resize(emitterCount);
+        m_GpuEmitterZones.resize(emitterCount);
+    }
 }
 
-bool ParticleSystem::LoadTextures()
+bool ParticleSystem::LoadTextures(JobSystem *jobs)
 {
-    BuildAtlas();
+    BuildAtlas(jobs);
     m_TexturesLoaded = true;
     return true;
 }
@@ -40,19 +174,11 @@ void ParticleSystem::UploadTextures(IRenderer &renderer)
     renderer.UploadTexture(m_AtlasTexture);
 }
 
-void ParticleSystem::BuildAtlas()
+void ParticleSystem::BuildAtlas(JobSystem *jobs)
 {
     // Particle texture sources: 6 files + 2 procedural
     // We'll pack them in a 512x512 atlas with a simple row layout
-
-    struct TextureSource
-    {
-        std::vector<unsigned char> pixels;
-        int width = 0;
-        int height = 0;
-    };
-
-    TextureSource sources[8];
+    ImageCache::Image sources[8];
     const char *filePaths[6] = {
         "assets/particles/304502d7-426b-4abc-a608-ff01a185df96.png", // Firefly
         "assets/particles/9509e404-2fce-4fbf-a082-720f85e7244e.png", // Rain
@@ -62,47 +188,48 @@ void ParticleSystem::BuildAtlas()
         "assets/particles/ead11602-6c24-45dc-b657-03d637e2a543.png"  // Wisp
     };
 
-    // Load file-based textures temporarily to get their pixel data
+    // Decode the files and run the generators as parallel tasks; all of
+    // them go through the image cache. Rows are flipped like Texture::LoadFromFile()
+    TextureBaker baker;
+    for (int i = 0; i < 6; i++)
+    {
+        baker.AddFile(filePaths[i], true, sources[i]);
+    }
+    baker.AddGenerated("particles.lantern", ImageCache::HashParams({TEXTURE_REVISION, 256, 256}),
+                       GenerateLanternPixels, sources[6]);
+    baker.AddGenerated("particles.sunshine", ImageCache::HashParams({TEXTURE_REVISION, 48, 192}),
+                       GenerateSunshinePixels, sources[7]);
+    baker.Run(jobs);
+
     for (int i = 0; i < 6; i++)
     {
-        Texture temp;
-        if (temp.LoadFromFile(filePaths[i]))
+        ImageCache::Image &source = sources[i];
+        if (source.pixels.empty())
         {
-            sources[i].width = temp.m_Width;
-            sources[i].height = temp.m_Height;
-            size_t dataSize = temp.m_Width * temp.m_Height * temp.m_Channels;
-            sources[i].pixels.resize(dataSize);
-            if (!temp.m_ImageData.empty())
-            {
-                memcpy(sources[i].pixels.data(), temp.m_ImageData.data(), dataSize);
-                // Convert to RGBA if needed
-                if (temp.m_Channels == 3)
-                {
-                    std::vector<unsigned char> rgba(temp.m_Width * temp.m_Height * 4);
-                    for (int j = 0; j < temp.m_Width * temp.m_Height; j++)
-                    {
-                        rgba[j * 4 + 0] = sources[i].pixels[j * 3 + 0];
-                        rgba[j * 4 + 1] = sources[i].pixels[j * 3 + 1];
-                        rgba[j * 4 + 2] = sources[i].pixels[j * 3 + 2];
-                        rgba[j * 4 + 3] = 255;
-                    }
-                    sources[i].pixels = std::move(rgba);
-                }
-            }
+            // Fallback: 16x16 white texture
+            source.width = 16;
+            source.height = 16;
+            source.channels = 4;
+            source.pixels.assign(16 * 16 * 4, 255);
         }
-        else
+        else if (source.channels != 4)
         {
-            // Fallback: 16x16 white texture
-            sources[i].width = 16;
-            sources[i].height = 16;
-            sources[i].pixels.resize(16 * 16 * 4, 255);
+            // Convert to RGBA; grey channels are replicated
+            std::vector<unsigned char> rgba(source.width * source.height * 4);
+            const int channels = source.channels;
+            for (int j = 0; j < source.width * source.height; j++)
+            {
+                const unsigned char *src = &source.pixels[j * channels];
+                rgba[j * 4 + 0] = src[0];
+                rgba[j * 4 + 1] = src[channels >= 3 ? 1 : 0];
+                rgba[j * 4 + 2] = src[channels >= 3 ? 2 : 0];
+                rgba[j * 4 + 3] = channels == 2 ? src[1] : channels == 4 ? src[3] : 255;
+            }
+            source.pixels = std::move(rgba);
+            source.channels = 4;
         }
     }
 
-    // Generate procedural textures
-    GenerateLanternPixels(sources[6].pixels, sources[6].width, sources[6].height);
-    GenerateSunshinePixels(sources[7].pixels, sources[7].width, sources[7].height);
-
     // Calculate atlas layout - simple horizontal packing with rows
     // Atlas size: 512x512 should be plenty
     const int atlasWidth = 512;
@@ -171,169 +298,207 @@ void ParticleSystem::BuildAtlas()
     std::cout << "Particle atlas built: " << atlasWidth << "x" << atlasHeight << std::endl;
 }
 
-void ParticleSystem::GenerateLanternPixels(std::vector<unsigned char> &pixels, int &width, int &height)
+void ParticleSystem::GenerateLanternPixels(ImageCache::Image &image)
 {
-    width = 256;
-    height = 256;
-    pixels.resize(width * height * 4);
+    const int width = 256;
+    const int height = 256;
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.resize(width * height * 4);
     float center = width / 2.0f;
 
+    // Alpha for a whole row first: the loop is branch-free so the compiler can vectorize it
+    float alphaRow[256];
     for (int y = 0; y < height; y++)
     {
+        const float dy = y - center;
         for (int x = 0; x < width; x++)
         {
-            int idx = (y * width + x) * 4;
-
             float dx = x - center;
-            float dy = y - center;
             float dist = std::sqrt(dx * dx + dy * dy) / center;
 
             float alpha = std::exp(-dist * dist * 1.2f);
             float centerReduction = std::exp(-dist * dist * 8.0f) * 0.3f;
             alpha = alpha * (1.0f - centerReduction);
 
-            if (dist > 0.6f)
-            {
-                float outerFade = 1.0f - (dist - 0.6f) / 0.4f;
-                outerFade = std::max(0.0f, outerFade);
-                outerFade = std::pow(outerFade, 0.4f);
-                alpha *= outerFade;
-            }
+            float outerFade = std::max(0.0f, 1.0f - (dist - 0.6f) / 0.4f);
+            outerFade = std::pow(outerFade, 0.4f);
+            alphaRow[x] = dist > 0.6f ? alpha * outerFade : alpha;
+        }
 
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = static_cast<unsigned char>(220 + alpha * 35);
-            pixels[idx + 2] = static_cast<unsigned char>(160 + alpha * 50);
-            pixels[idx + 3] = static_cast<unsigned char>(alpha * 120);
+        unsigned char *row = &image.pixels[y * width * 4];
+        for (int x = 0; x < width; x++)
+        {
+            const float alpha = alphaRow[x];
+            row[x * 4 + 0] = 255;
+            row[x * 4 + 1] = static_cast<unsigned char>(220 + alpha * 35);
+            row[x * 4 + 2] = static_cast<unsigned char>(160 + alpha * 50);
+            row[x * 4 + 3] = static_cast<unsigned char>(alpha * 120);
         }
     }
 }
 
-void ParticleSystem::GenerateSunshinePixels(std::vector<unsigned char> &pixels, int &width, int &height)
+void ParticleSystem::GenerateSunshinePixels(ImageCache::Image &image)
 {
-    width = 48;
-    height = 192;
-    pixels.resize(width * height * 4);
+    const int width = 48;
+    const int height = 192;
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.resize(width * height * 4);
     float centerX = width / 2.0f;
 
-    for (int y = 0; y < height; y++)
+    // Terms that depend on x alone, shared by every row
+    float columnDx[48];
+    float columnGaussian[48];
+    for (int x = 0; x < width; x++)
     {
-        for (int x = 0; x < width; x++)
-        {
-            int idx = (y * width + x) * 4;
+        columnDx[x] = std::abs(x - centerX) / centerX;
+        columnGaussian[x] = std::exp(-columnDx[x] * columnDx[x] * 1.5f);
+    }
 
-            float dx = std::abs(x - centerX) / centerX;
-            float dy = static_cast<float>(y) / static_cast<float>(height);
+    for (int y = 0; y < height; y++)
+    {
+        // Terms that depend on y alone
+        float dy = static_cast<float>(y) / static_cast<float>(height);
+        float beamWidth = 0.2f + dy * 0.55f;
 
-            float beamWidth = 0.2f + dy * 0.55f;
-            float horizontalFalloff = 1.0f - std::min(1.0f, dx / beamWidth);
-            horizontalFalloff = std::pow(horizontalFalloff, 1.2f);
-            horizontalFalloff *= std::exp(-dx * dx * 1.5f);
+        float topFeather = std::min(1.0f, dy / 0.30f);
+        topFeather = std::pow(topFeather, 2.0f);
+        float bottomFeather = std::min(1.0f, (1.0f - dy) / 0.30f);
+        bottomFeather = std::pow(bottomFeather, 2.0f);
 
-            float topFeather = std::min(1.0f, dy / 0.30f);
-            topFeather = std::pow(topFeather, 2.0f);
-            float bottomFeather = std::min(1.0f, (1.0f - dy) / 0.30f);
-            bottomFeather = std::pow(bottomFeather, 2.0f);
+        float verticalIntensity = 0.5f + 0.5f * std::sin(dy * M_PI);
+        float beamScale = verticalIntensity * topFeather * bottomFeather;
 
-            float verticalIntensity = 0.5f + 0.5f * std::sin(dy * M_PI);
-            float beamAlpha = horizontalFalloff * verticalIntensity * topFeather * bottomFeather;
+        float groundGlowY = 1.0f - std::abs(dy - 0.78f) / 0.15f;
+        groundGlowY = std::max(0.0f, groundGlowY);
+        float groundScale = groundGlowY * 0.35f * bottomFeather;
 
-            float groundGlowY = 1.0f - std::abs(dy - 0.78f) / 0.15f;
-            groundGlowY = std::max(0.0f, groundGlowY);
-            float groundGlowX = std::exp(-dx * dx * 1.5f);
-            float groundGlow = groundGlowY * groundGlowX * 0.35f * bottomFeather;
+        unsigned char *row = &image.pixels[y * width * 4];
+        for (int x = 0; x < width; x++)
+        {
+            float horizontalFalloff = 1.0f - std::min(1.0f, columnDx[x] / beamWidth);
+            horizontalFalloff = std::pow(horizontalFalloff, 1.2f);
+            horizontalFalloff *= columnGaussian[x];
 
-            float alpha = std::min(1.0f, beamAlpha + groundGlow);
+            float alpha = std::min(1.0f, horizontalFalloff * beamScale + columnGaussian[x] * groundScale);
 
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = 255;
-            pixels[idx + 2] = 255;
-            pixels[idx + 3] = static_cast<unsigned char>(alpha * 140);
+            row[x * 4 + 0] = 255;
+            row[x * 4 + 1] = 255;
+            row[x * 4 + 2] = 255;
+            row[x * 4 + 3] = static_cast<unsigned char>(alpha * 140);
         }
     }
 }
 
 void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 viewSize)
 {
+    WILD_PROFILE_ZONE("Particles Update");
     if (!m_Zones || m_Zones->empty())
+    {
+        if (!m_GpuEmitters.empty())
+        {
+            m_GpuEmitters.clear();
+            m_GpuEmitterZones.clear();
+            m_GpuLayoutDirty = true;
+        }
         return;
+    }
 
     m_Time += deltaTime;
 
+    if (m_GpuSimulation)
+    {
+        SyncGpuEmitters();
+        m_GpuPendingDelta += deltaTime;
+    }
+
     // Ensure we have enough spawn timers
     if (m_ZoneSpawnTimers.size() < m_Zones->size())
     {
         m_ZoneSpawnTimers.resize(m_Zones->size(), 0.0f);
     }
 
-    // Update existing particles
-    for (auto it = m_Particles.begin(); it != m_Particles.end();)
+    // Age and integrate every particle in one pass over the packed arrays
+    const size_t count = m_Pool.Size();
+    float *lifetimes = m_Pool.m_Lifetime.data();
+    float *positionsX = m_Pool.m_PositionX.data();
+    float *positionsY = m_Pool.m_PositionY.data();
+    const float *velocitiesX = m_Pool.m_VelocityX.data();
+    const float *velocitiesY = m_Pool.m_VelocityY.data();
+    ParticleKernels::Integrate(lifetimes, positionsX, positionsY, velocitiesX, velocitiesY, count, deltaTime);
+
+    // Remove dead particles and those whose zone no longer exists, then
+    // apply type-specific behavior to the rest
+    const int zoneCount = static_cast<int>(m_Zones->size());
+    for (size_t i = 0; i < m_Pool.Size();)
     {
-        Particle &p = *it;
-
-        // Decrease lifetime
-        p.lifetime -= deltaTime;
-        if (p.lifetime <= 0.0f)
+        const int zoneIndex = m_Pool.m_ZoneIndex[i];
+        if (m_Pool.m_Lifetime[i] <= 0.0f || zoneIndex < 0 || zoneIndex >= zoneCount)
         {
-            it = m_Particles.erase(it);
+            // The last particle moves into slot i and is handled next
+            m_Pool.Remove(i);
             continue;
         }
 
-        // Remove particle if its zone no longer exists
-        if (p.zoneIndex < 0 || p.zoneIndex >= static_cast<int>(m_Zones->size()))
+        float &x = m_Pool.m_PositionX[i];
+        float &y = m_Pool.m_PositionY[i];
+        float &lifetime = m_Pool.m_Lifetime[i];
+        float &rotation = m_Pool.m_Rotation[i];
+        glm::vec4 &color = m_Pool.m_Color[i];
+        const float maxLifetime = m_Pool.m_MaxLifetime[i];
+        const float phase = m_Pool.m_Phase[i];
+
+        if (IsWeather(m_Pool.m_Type[i]))
         {
-            it = m_Particles.erase(it);
-            continue;
+            x += m_Wind.x * deltaTime;
+            y += m_Wind.y * deltaTime;
         }
 
-        // Update position
-        p.position += p.velocity * deltaTime;
-
-        // Use the particle's stored type for behavior
-        ParticleType pType = p.type;
-
-        // Type-specific behavior
-        switch (pType)
+        switch (m_Pool.m_Type[i])
         {
         case ParticleType::Firefly:
         {
             // Gentle random drift
-            float driftX = std::sin(m_Time * 2.0f + p.phase) * 10.0f;
-            float driftY = std::cos(m_Time * 1.5f + p.phase * 1.3f) * 8.0f;
-            p.position.x += driftX * deltaTime;
-            p.position.y += driftY * deltaTime;
+            float driftX = std::sin(m_Time * 2.0f + phase) * 10.0f;
+            float driftY = std::cos(m_Time * 1.5f + phase * 1.3f) * 8.0f;
+            x += driftX * deltaTime;
+            y += driftY * deltaTime;
 
             // Slow rotation as they drift
-            float rotationSpeed = 20.0f + (p.phase / 6.28f) * 40.0f; // 20-60 degrees per second
-            if (std::fmod(p.phase, 2.0f) < 1.0f)
+            float rotationSpeed = 20.0f + (phase / 6.28f) * 40.0f; // 20-60 degrees per second
+            if (std::fmod(phase, 2.0f) < 1.0f)
                 rotationSpeed = -rotationSpeed;
-            p.rotation += rotationSpeed * deltaTime;
+            rotation += rotationSpeed * deltaTime;
 
             // Pulsing glow, alpha oscillates between 0.2 and 0.8
-            float pulse = 0.5f + 0.5f * std::sin(m_Time * 4.0f + p.phase);
-            float lifeFade = std::min(1.0f, p.lifetime / (p.maxLifetime * 0.3f));
-            float fadeIn = std::min(1.0f, (p.maxLifetime - p.lifetime) / 0.5f);
-            p.color.a = pulse * lifeFade * fadeIn * 0.8f;
+            float pulse = 0.5f + 0.5f * std::sin(m_Time * 4.0f + phase);
+            float lifeFade = std::min(1.0f, lifetime / (maxLifetime * 0.3f));
+            float fadeIn = std::min(1.0f, (maxLifetime - lifetime) / 0.5f);
+            color.a = pulse * lifeFade * fadeIn * 0.8f;
             break;
         }
         case ParticleType::Rain:
         {
             // Fade in smoothly over first 0.15 seconds
-            float fadeIn = std::min(1.0f, (p.maxLifetime - p.lifetime) / 0.15f);
+            float fadeIn = std::min(1.0f, (maxLifetime - lifetime) / 0.15f);
             // Target alpha stored in phase
-            p.color.a = fadeIn * p.phase;
+            color.a = fadeIn * phase;
 
             // Check if rain has fallen below its zone
-            if (p.zoneIndex >= 0 && p.zoneIndex < static_cast<int>(m_Zones->size()))
+            if (zoneIndex >= 0 && zoneIndex < static_cast<int>(m_Zones->size()))
             {
-                const auto &zone = (*m_Zones)[p.zoneIndex];
+                const auto &zone = (*m_Zones)[zoneIndex];
 
                 // Vary ground height per particle using position.x as seed
                 // This creates natural variation so rain doesn't end on same line
-                float heightVariation = std::fmod(std::abs(p.position.x * 7.3f + p.phase * 100.0f), 60.0f);
+                float heightVariation = std::fmod(std::abs(x * 7.3f + phase * 100.0f), 60.0f);
                 float groundY = zone.position.y + zone.size.y + 20.0f + heightVariation;
-                if (p.position.y > groundY)
+                if (y > groundY)
                 {
-                    p.lifetime = 0.0f;
+                    lifetime = 0.0f;
                 }
             }
             break;
@@ -341,22 +506,22 @@ void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 view
         case ParticleType::Snow:
         {
             // Snow drifts side to side
-            float drift = std::sin(m_Time * 1.5f + p.phase) * 20.0f;
-            p.position.x += drift * deltaTime;
+            float drift = std::sin(m_Time * 1.5f + phase) * 20.0f;
+            x += drift * deltaTime;
 
             // Rotate as it falls
-            float rotationSpeed = 30.0f + (p.phase / 6.28f) * 60.0f; // 30-90 degrees per second
-            if (std::fmod(p.phase, 2.0f) < 1.0f)
+            float rotationSpeed = 30.0f + (phase / 6.28f) * 60.0f; // 30-90 degrees per second
+            if (std::fmod(phase, 2.0f) < 1.0f)
                 rotationSpeed = -rotationSpeed; // Half rotate clockwise, half counter-clockwise
-            p.rotation += rotationSpeed * deltaTime;
+            rotation += rotationSpeed * deltaTime;
 
             // Check if snow has fallen below its zone
-            if (p.zoneIndex >= 0 && p.zoneIndex < static_cast<int>(m_Zones->size()))
+            if (zoneIndex >= 0 && zoneIndex < static_cast<int>(m_Zones->size()))
             {
-                const auto &zone = (*m_Zones)[p.zoneIndex];
-                if (p.position.y > zone.position.y + zone.size.y + 50.0f)
+                const auto &zone = (*m_Zones)[zoneIndex];
+                if (y > zone.position.y + zone.size.y + 50.0f)
                 {
-                    p.lifetime = 0.0f;
+                    lifetime = 0.0f;
                 }
             }
             break;
@@ -364,56 +529,56 @@ void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 view
         case ParticleType::Fog:
         {
             // Fog drifts very slowly
-            float driftX = std::sin(m_Time * 0.15f + p.phase) * 2.5f;
-            float driftY = std::cos(m_Time * 0.1f + p.phase * 0.5f) * 1.0f;
+            float driftX = std::sin(m_Time * 0.15f + phase) * 2.5f;
+            float driftY = std::cos(m_Time * 0.1f + phase * 0.5f) * 1.0f;
 
             // Add subtle swirling motion for smoky effect
-            float swirl = std::sin(m_Time * 0.4f + p.phase * 2.0f) * 1.5f;
-            p.position.x += (driftX + swirl) * deltaTime;
-            p.position.y += driftY * deltaTime;
+            float swirl = std::sin(m_Time * 0.4f + phase * 2.0f) * 1.5f;
+            x += (driftX + swirl) * deltaTime;
+            y += driftY * deltaTime;
 
             // Slow pulsing alpha
-            float pulse = 0.9f + 0.1f * std::sin(m_Time * 0.25f + p.phase);
+            float pulse = 0.9f + 0.1f * std::sin(m_Time * 0.25f + phase);
 
             // Long fade in and fade out for smooth feathered appearance
-            float lifeFade = std::min(1.0f, p.lifetime / (p.maxLifetime * 0.4f));
-            float fadeIn = std::min(1.0f, (p.maxLifetime - p.lifetime) / 4.0f);
+            float lifeFade = std::min(1.0f, lifetime / (maxLifetime * 0.4f));
+            float fadeIn = std::min(1.0f, (maxLifetime - lifetime) / 4.0f);
 
             // More visible during day, significantly less at night
             float dayBoost = 1.0f + (1.0f - m_NightFactor) * 0.4f;
             float nightReduce = 1.0f - m_NightFactor * 0.6f;
-            p.color.a = pulse * lifeFade * fadeIn * 0.28f * dayBoost * nightReduce;
+            color.a = pulse * lifeFade * fadeIn * 0.28f * dayBoost * nightReduce;
             break;
         }
         case ParticleType::Sparkles:
         {
             // Instant sparkle, bright flash then fade
-            float lifeRatio = 1.0f - (p.lifetime / p.maxLifetime); // 0 at start, 1 at end
+            float lifeRatio = 1.0f - (lifetime / maxLifetime); // 0 at start, 1 at end
             float flash = lifeRatio < 0.15f ? 1.0f : 0.0f;         // Bright only in first 15% of life
-            p.color.a = flash;
+            color.a = flash;
             break;
         }
         case ParticleType::Wisp:
         {
             // Magical spiraling movement
-            float spiralX = std::sin(m_Time * 1.5f + p.phase) * 20.0f;
-            float spiralY = std::cos(m_Time * 1.2f + p.phase * 0.7f) * 15.0f;
-            float wobble = std::sin(m_Time * 3.0f + p.phase * 2.0f) * 8.0f;
-            p.position.x += (spiralX + wobble) * deltaTime;
-            p.position.y += spiralY * deltaTime;
+            float spiralX = std::sin(m_Time * 1.5f + phase) * 20.0f;
+            float spiralY = std::cos(m_Time * 1.2f + phase * 0.7f) * 15.0f;
+            float wobble = std::sin(m_Time * 3.0f + phase * 2.0f) * 8.0f;
+            x += (spiralX + wobble) * deltaTime;
+            y += spiralY * deltaTime;
 
             // Gentle rotation
-            float rotSpeed = 45.0f + (p.phase / 6.28f) * 30.0f; // 45-75 deg/sec
-            if (std::fmod(p.phase, 2.0f) < 1.0f)
+            float rotSpeed = 45.0f + (phase / 6.28f) * 30.0f; // 45-75 deg/sec
+            if (std::fmod(phase, 2.0f) < 1.0f)
                 rotSpeed = -rotSpeed;
-            p.rotation += rotSpeed * deltaTime;
+            rotation += rotSpeed * deltaTime;
 
             // Pulsing glow effect
-            float twinkle = 0.5f + 0.5f * std::sin(m_Time * 4.0f + p.phase * 3.0f);
-            float shimmer = 0.8f + 0.2f * std::sin(m_Time * 7.0f + p.phase);
-            float lifeFade = std::min(1.0f, p.lifetime / (p.maxLifetime * 0.25f));
-            float fadeIn = std::min(1.0f, (p.maxLifetime - p.lifetime) / 1.0f);
-            p.color.a = twinkle * shimmer * lifeFade * fadeIn * 0.85f;
+            float twinkle = 0.5f + 0.5f * std::sin(m_Time * 4.0f + phase * 3.0f);
+            float shimmer = 0.8f + 0.2f * std::sin(m_Time * 7.0f + phase);
+            float lifeFade = std::min(1.0f, lifetime / (maxLifetime * 0.25f));
+            float fadeIn = std::min(1.0f, (maxLifetime - lifetime) / 1.0f);
+            color.a = twinkle * shimmer * lifeFade * fadeIn * 0.85f;
             break;
         }
         case ParticleType::Lantern:
@@ -422,74 +587,62 @@ void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 view
             // Completely off during daytime
             if (m_NightFactor < 0.05f)
             {
-                p.color.a = 0.0f;
+                color.a = 0.0f;
                 break;
             }
-            float pulse = 0.9f + 0.1f * std::sin(m_Time * 1.5f + p.phase);
-            float flicker = 0.97f + 0.03f * std::sin(m_Time * 6.0f + p.phase * 2.0f);
+            float pulse = 0.9f + 0.1f * std::sin(m_Time * 1.5f + phase);
+            float flicker = 0.97f + 0.03f * std::sin(m_Time * 6.0f + phase * 2.0f);
 
             // Night factor controls visibility
             float nightAlpha = m_NightFactor * 0.35f;
-            p.color.a = pulse * flicker * nightAlpha;
+            color.a = pulse * flicker * nightAlpha;
             break;
         }
         case ParticleType::Sunshine:
         {
             // Sun & moon rays, yellow during day, blue during night
             // Very gentle shimmer effect
-            float shimmer = 0.95f + 0.05f * std::sin(m_Time * 1.2f + p.phase);
-            float flicker = 0.97f + 0.03f * std::sin(m_Time * 3.0f + p.phase * 1.5f);
+            float shimmer = 0.95f + 0.05f * std::sin(m_Time * 1.2f + phase);
+            float flicker = 0.97f + 0.03f * std::sin(m_Time * 3.0f + phase * 1.5f);
 
             // Fade in and out very smoothly
-            float lifeFade = std::min(1.0f, p.lifetime / (p.maxLifetime * 0.4f));
-            float fadeIn = std::min(1.0f, (p.maxLifetime - p.lifetime) / 2.0f);
+            float lifeFade = std::min(1.0f, lifetime / (maxLifetime * 0.4f));
+            float fadeIn = std::min(1.0f, (maxLifetime - lifetime) / 2.0f);
 
             // Interpolate color between golden yellow (day) and pale blue (night)
             // Day color: warm golden (1.0, 0.9, 0.5)
             // Night color: cool blue (0.5, 0.7, 1.0)
             float nightBlend = m_NightFactor;
-            p.color.r = 1.0f * (1.0f - nightBlend) + 0.5f * nightBlend;
-            p.color.g = 0.9f * (1.0f - nightBlend) + 0.7f * nightBlend;
-            p.color.b = 0.5f * (1.0f - nightBlend) + 1.0f * nightBlend;
+            color.r = 1.0f * (1.0f - nightBlend) + 0.5f * nightBlend;
+            color.g = 0.9f * (1.0f - nightBlend) + 0.7f * nightBlend;
+            color.b = 0.5f * (1.0f - nightBlend) + 1.0f * nightBlend;
 
             // Subtle alpha
             float baseAlpha = 0.16f + (1.0f - m_NightFactor) * 0.06f;
-            p.color.a = shimmer * flicker * lifeFade * fadeIn * baseAlpha;
+            color.a = shimmer * flicker * lifeFade * fadeIn * baseAlpha;
             break;
         }
         }
 
-        ++it;
+        ++i;
     }
 
-    // Spawn new particles for each zone
-    for (size_t i = 0; i < m_Zones->size(); ++i)
+    // Only zones near the view spawn, each within its share of the budget
+    SyncZoneIndex();
+    const size_t budget = m_ParticleBudget > 0 ? m_ParticleBudget : m_Pool.GetCapacity();
+    m_Scheduler.Schedule(cameraPos, cameraPos + viewSize, budget, m_MaxParticlesPerZone);
+
+    for (const std::uint32_t i : m_Scheduler.GetScheduledZones())
     {
         const ParticleZone &zone = (*m_Zones)[i];
-        if (!zone.enabled)
-            continue;
-
-        // Check if zone is visible in current view
-        float margin = 80.0f; // 5 tiles of margin to spawn offscreen
-        bool visible = !(zone.position.x + zone.size.x < cameraPos.x - margin ||
-                         zone.position.x > cameraPos.x + viewSize.x + margin ||
-                         zone.position.y + zone.size.y < cameraPos.y - margin ||
-                         zone.position.y > cameraPos.y + viewSize.y + margin);
-
-        if (!visible)
-            continue;
+        const ParticleZoneScheduler::Plan &plan = m_Scheduler.GetPlan(i);
 
         // Skip spawning lantern glows during daytime to avoid flicker
         if (zone.type == ParticleType::Lantern && m_NightFactor < 0.05f)
             continue;
 
-        // Count particles for this zone
-        size_t zoneParticleCount = 0;
-        for (const auto &p : m_Particles)
-        {
-            if (p.zoneIndex == static_cast<int>(i))
-                zoneParticleCount++;
-        }
+        // Live particles for this zone, counted by the pool
+        size_t zoneParticleCount = m_Pool.GetZoneCount(static_cast<int>(i));
 
         // Spawn rate depends on zone type
         float spawnRate;
@@ -526,11 +679,31 @@ void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 view
         // Scale spawn rate by zone size
         float areaFactor = (zone.size.x * zone.size.y) / (64.0f * 64.0f);
         spawnRate *= std::max(0.5f, std::min(3.0f, areaFactor));
+        spawnRate *= m_Scheduler.GetSpawnScale(plan.state);
 
         m_ZoneSpawnTimers[i] += deltaTime;
         float spawnInterval = 1.0f / spawnRate;
 
-        while (m_ZoneSpawnTimers[i] >= spawnInterval && zoneParticleCount < m_MaxParticlesPerZone)
+        // GPU zones hand their spawn budget to the next compute step
+        const int emitterIndex = m_GpuSimulation ? m_GpuEmitterOfZone[i] : -1;
+        if (emitterIndex >= 0)
+        {
+            IRenderer::GpuParticleEmitter &emitter = m_GpuEmitters[emitterIndex];
+            const float gpuInterval = spawnInterval / m_GpuDensity;
+            const auto due = static_cast<std::uint32_t>(m_ZoneSpawnTimers[i] / gpuInterval);
+            const std::uint32_t spawns = std::min(due, emitter.slotCount - emitter.spawnCount);
+            emitter.spawnCount += spawns;
+            m_ZoneSpawnTimers[i] -= static_cast<float>(spawns) * gpuInterval;
+            continue;
+        }
+
+        if (plan.resumed)
+        {
+            PrewarmZone(static_cast<int>(i), zone, spawnRate, plan.budget);
+            zoneParticleCount = m_Pool.GetZoneCount(static_cast<int>(i));
+        }
+
+        while (m_ZoneSpawnTimers[i] >= spawnInterval && zoneParticleCount < plan.budget && !m_Pool.IsFull())
         {
             m_ZoneSpawnTimers[i] -= spawnInterval;
             SpawnParticleInZone(static_cast<int>(i), zone);
@@ -539,6 +712,40 @@ void ParticleSystem::Update(float deltaTime, glm::vec2 cameraPos, glm::vec2 view
     }
 }
 
+void ParticleSystem::PrewarmZone(int zoneIndex, const ParticleZone &zone, float spawnRate, size_t budget)
+{
+    // A zone that ran continuously holds about spawnRate * lifetime particles
+    // with ages spread evenly over the lifetime; recreate that state instead of
+    // letting the zone fill up in view. Rain that would already have hit the
+    // ground is removed by the next Update(), as it would have been.
+    size_t count = m_Pool.GetZoneCount(zoneIndex);
+    size_t target = budget;
+    bool targetKnown = false;
+    while (count < target && !m_Pool.IsFull())
+    {
+        const size_t slot = m_Pool.Size();
+        SpawnParticleInZone(zoneIndex, zone);
+        if (m_Pool.Size() == slot)
+            break;  // The type declined to spawn (e.g. overlapping sun rays)
+
+        const float maxLifetime = m_Pool.m_MaxLifetime[slot];
+        if (!targetKnown)
+        {
+            target = std::min(budget, static_cast<size_t>(std::ceil(spawnRate * maxLifetime)));
+            targetKnown = true;
+        }
+
+        const float age = m_Dist01(m_Rng) * maxLifetime;
+        glm::vec2 velocity(m_Pool.m_VelocityX[slot], m_Pool.m_VelocityY[slot]);
+        if (IsWeather(m_Pool.m_Type[slot]))
+            velocity += m_Wind;
+        m_Pool.m_Lifetime[slot] -= age;
+        m_Pool.m_PositionX[slot] += velocity.x * age;
+        m_Pool.m_PositionY[slot] += velocity.y * age;
+        ++count;
+    }
+}
+
 void ParticleSystem::SpawnParticleInZone(int zoneIndex, const ParticleZone &zone)
 {
     switch (zone.type)
@@ -595,7 +802,7 @@ void ParticleSystem::SpawnFirefly(int zoneIndex, const ParticleZone &zone)
     p.rotation = 0.0f;
     p.additive = true;
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnRain(int zoneIndex, const ParticleZone &zone)
@@ -624,7 +831,7 @@ void ParticleSystem::SpawnRain(int zoneIndex, const ParticleZone &zone)
     p.rotation = -35.0f - m_Dist01(m_Rng) * 30.0f; // -35 to -65 degrees
     p.additive = false;
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnSnow(int zoneIndex, const ParticleZone &zone)
@@ -652,7 +859,7 @@ void ParticleSystem::SpawnSnow(int zoneIndex, const ParticleZone &zone)
     p.rotation = 0.0f;
     p.additive = true; // Additive blending for brighter snow
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnFog(int zoneIndex, const ParticleZone &zone)
@@ -682,7 +889,7 @@ void ParticleSystem::SpawnFog(int zoneIndex, const ParticleZone &zone)
     p.rotation = 0.0f;
     p.additive = false;
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnSparkles(int zoneIndex, const ParticleZone &zone)
@@ -711,7 +918,7 @@ void ParticleSystem::SpawnSparkles(int zoneIndex, const ParticleZone &zone)
     p.rotation = 0.0f;
     p.additive = true; // Additive for glow effect
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnWisp(int zoneIndex, const ParticleZone &zone)
@@ -745,7 +952,7 @@ void ParticleSystem::SpawnWisp(int zoneIndex, const ParticleZone &zone)
     p.rotation = m_Dist01(m_Rng) * 360.0f; // Random starting rotation
     p.additive = true;                     // Glowing ethereal effect
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnLantern(int zoneIndex, const ParticleZone &zone)
@@ -775,23 +982,23 @@ void ParticleSystem::SpawnLantern(int zoneIndex, const ParticleZone &zone)
     p.rotation = 0.0f;
     p.additive = true; // Additive blending for glow effect
 
-    m_Particles.push_back(p);
+    m_Pool.Add(p);
 }
 
 void ParticleSystem::SpawnSunshine(int zoneIndex, const ParticleZone &zone)
 {
     // Helper: Check if a point is covered by a sunshine ray
     // Rays are rotated rectangles with 1:4 aspect ratio (width:height)
-    auto pointInRay = [](glm::vec2 point, const Particle &ray) -> bool
+    auto pointInRay = [this](glm::vec2 point, size_t ray) -> bool
     {
-        float halfWidth = ray.size * 0.5f;
-        float halfHeight = ray.size * 2.0f; // 1:4 aspect ratio
+        float halfWidth = m_Pool.m_Size[ray] * 0.5f;
+        float halfHeight = m_Pool.m_Size[ray] * 2.0f; // 1:4 aspect ratio
 
         // Transform point to ray's local space (centered, axis-aligned)
-        glm::vec2 local = point - ray.position;
+        glm::vec2 local = point - glm::vec2(m_Pool.m_PositionX[ray], m_Pool.m_PositionY[ray]);
 
         // Rotate point by negative ray rotation
-        float radians = glm::radians(-ray.rotation);
+        float radians = glm::radians(-m_Pool.m_Rotation[ray]);
         float cosR = std::cos(radians);
         float sinR = std::sin(radians);
         glm::vec2 rotated(
@@ -806,9 +1013,9 @@ void ParticleSystem::SpawnSunshine(int zoneIndex, const ParticleZone &zone)
     auto countRaysAtPoint = [&](glm::vec2 point) -> int
     {
         int count = 0;
-        for (const auto &existing : m_Particles)
+        for (size_t i = 0; i < m_Pool.Size(); ++i)
         {
-            if (existing.type == ParticleType::Sunshine && pointInRay(point, existing))
+            if (m_Pool.m_Type[i] == ParticleType::Sunshine && pointInRay(point, i))
                 count++;
         }
         return count;
@@ -880,42 +1087,97 @@ void ParticleSystem::SpawnSunshine(int zoneIndex, const ParticleZone &zone)
         // Check if this ray would create overcrowded spots (3+ rays at same point)
         if (!wouldOvercrowd(p.position, p.rotation, p.size))
         {
-            m_Particles.push_back(p);
+            m_Pool.Add(p);
             return;
         }
     }
     // After 3 failed attempts, skip spawning this frame
 }
 
+void ParticleSystem::CollectLights(glm::vec2 cameraPos, glm::vec2 viewSize,
+                                   std::vector<IRenderer::Light> &lights) const
+{
+    WILD_PROFILE_ZONE("Particle Lights");
+    const size_t count = m_Pool.Size();
+    for (size_t index = 0; index < count; ++index)
+    {
+        // Light reach relative to the sprite size, and brightness at full alpha
+        float reach, gain;
+        switch (m_Pool.m_Type[index])
+        {
+        case ParticleType::Lantern:
+            reach = 0.5f;  // The glow sprite is already 4.5x the zone
+            gain = 1.5f;
+            break;
+        case ParticleType::Firefly:
+            reach = 5.0f;
+            gain = 0.5f;
+            break;
+        case ParticleType::Wisp:
+            reach = 4.0f;
+            gain = 0.4f;
+            break;
+        default:
+            continue;
+        }
+
+        const glm::vec4 color = m_Pool.m_Color[index];
+        if (color.a <= 0.01f)
+            continue;
+
+        IRenderer::Light light;
+        light.position = glm::vec2(m_Pool.m_PositionX[index], m_Pool.m_PositionY[index]) - cameraPos;
+        light.radius = m_Pool.m_Size[index] * reach;
+        if (light.position.x < -light.radius || light.position.y < -light.radius ||
+            light.position.x > viewSize.x + light.radius || light.position.y > viewSize.y + light.radius)
+            continue;
+        light.color = glm::vec3(color) * (color.a * gain);
+        lights.push_back(light);
+    }
+}
+
+size_t ParticleSystem::GetMemoryBytes() const
+{
+    return m_Pool.GetMemoryBytes() +
+           MemoryTracker::CapacityBytes(m_InstanceScratch, m_NoProjectionBatch, m_RegularBatch, m_VisibleMask,
+                                        m_ZoneSpawnTimers, m_ScheduledZones, m_GpuEmitters, m_GpuEmitterZones,
+                                        m_GpuEmitterOfZone);
+}
+
 void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noProjectionOnly, bool renderAll)
 {
+    WILD_PROFILE_ZONE("Particles Render");
     // For noProjection particles, we need to:
     // 1. Calculate positions while perspective is enabled
     // 2. Suspend perspective
     // 3. Draw at calculated positions
     // 4. Resume perspective
 
-    struct ParticleRenderData
-    {
-        glm::vec2 screenPos;
-        glm::vec2 size;
-        glm::vec4 color;
-        float rotation;
-        float phase;
-        bool additive;
-        ParticleType type;
-    };
+    // Batches are members so a frame does not allocate once they have grown
+    std::vector<ParticleRenderData> &noProjectionBatch = m_NoProjectionBatch;
+    std::vector<ParticleRenderData> &regularBatch = m_RegularBatch;
+    noProjectionBatch.clear();
+    regularBatch.clear();
 
-    std::vector<ParticleRenderData> noProjectionBatch;
-    std::vector<ParticleRenderData> regularBatch;
+    // Get perspective state for viewport checking
+    const auto perspState = renderer.GetPerspectiveState();
+
+    // Cull regular particles against the viewport in one vectorized pass.
+    // Use generous padding to account for particle size and partial visibility
+    const size_t count = m_Pool.Size();
+    m_VisibleMask.resize(m_Pool.GetCapacity());
+    ParticleKernels::Cull(m_Pool.m_PositionX.data(), m_Pool.m_PositionY.data(), m_Pool.m_Size.data(), count,
+                          cameraPos, cameraPos + glm::vec2(perspState.viewWidth, perspState.viewHeight),
+                          2.0f, 50.0f, m_VisibleMask.data());
 
     // First pass: Calculate all positions (ProjectPoint works while perspective enabled)
-    for (const Particle &p : m_Particles)
+    for (size_t index = 0; index < count; ++index)
     {
+        const int zoneIndex = m_Pool.m_ZoneIndex[index];
         bool isNoProjection = false;
-        if (m_Zones && p.zoneIndex >= 0 && p.zoneIndex < static_cast<int>(m_Zones->size()))
+        if (m_Zones && zoneIndex >= 0 && zoneIndex < static_cast<int>(m_Zones->size()))
         {
-            isNoProjection = (*m_Zones)[p.zoneIndex].noProjection;
+            isNoProjection = (*m_Zones)[zoneIndex].noProjection;
         }
 
         // Filter particles based on noProjection flag
@@ -927,6 +1189,15 @@ void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noPro
                 continue;
         }
 
+        // Regular particles outside the viewport are skipped before unpacking
+        if (!isNoProjection && !m_VisibleMask[index])
+            continue;
+
+        // The light map already carries the lantern's glow
+        if (m_LightMapActive && m_Pool.m_Type[index] == ParticleType::Lantern)
+            continue;
+
+        const Particle p = m_Pool.Get(index);
         ParticleRenderData data;
         data.size = glm::vec2(p.size, p.size);
         data.color = p.color;
@@ -938,9 +1209,6 @@ void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noPro
         // Convert world position to screen position
         data.screenPos = p.position - cameraPos;
 
-        // Get perspective state for viewport checking
-        auto perspState = renderer.GetPerspectiveState();
-
         // NoProjection particles: Use tilemap's actual structure bounds
         if (isNoProjection && m_Tilemap && m_TileWidth > 0 && m_TileHeight > 0)
         {
@@ -1033,19 +1301,7 @@ void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noPro
         }
         else
         {
-            // Cull regular particles that are outside viewport or behind sphere
-            // Use generous padding to account for particle size and partial visibility
-            float padding = std::max(data.size.x, data.size.y) * 2.0f + 50.0f;
-
-            bool outsideViewport = data.screenPos.x < -padding ||
-                                   data.screenPos.x > perspState.viewWidth + padding ||
-                                   data.screenPos.y < -padding ||
-                                   data.screenPos.y > perspState.viewHeight + padding;
-
-            if (outsideViewport)
-                continue;
-
-            // Check if particle is behind the sphere (only when globe/fisheye is enabled)
+            // Viewport culling happened above; check if particle is behind the sphere (only when globe/fisheye is enabled)
             if (renderer.IsPointBehindSphere(data.screenPos))
                 continue;
 
@@ -1053,44 +1309,65 @@ void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noPro
         }
     }
 
-    // Lambda to draw a particle using the texture atlas
-    auto drawParticle = [&](const ParticleRenderData &data)
+    const bool useAtlas = m_TexturesLoaded && m_AtlasTexture.GetID() != 0;
+
+    // Lambda to pack a particle into an atlas sprite instance
+    auto makeInstance = [&](const ParticleRenderData &data)
     {
-        if (m_TexturesLoaded && m_AtlasTexture.GetID() != 0)
+        int typeIndex = static_cast<int>(data.type);
+        const AtlasRegion &region = m_AtlasRegions[typeIndex];
+
+        glm::vec2 renderSize = data.size;
+        // Sunshine uses elongated beam texture (48x192 aspect ratio = 1:4)
+        if (data.type == ParticleType::Sunshine)
         {
-            int typeIndex = static_cast<int>(data.type);
-            const AtlasRegion &region = m_AtlasRegions[typeIndex];
+            renderSize = glm::vec2(data.size.x, data.size.x * 4.0f);
+        }
+        // Rain uses stretched vertical texture with per-droplet variation
+        else if (data.type == ParticleType::Rain)
+        {
+            // Vary stretch between 1.0x and 1.4x based on particle phase
+            float stretch = 1.0f + 0.4f * (std::sin(data.phase) * 0.5f + 0.5f);
+            renderSize = glm::vec2(data.size.x, data.size.x * stretch);
+        }
+        // Snow flips like a coin
+        else if (data.type == ParticleType::Snow)
+        {
+            float flipScale = std::cos(m_Time * 3.0f + data.phase);
+            renderSize.x *= flipScale;
+        }
+        glm::vec2 centeredPos = data.screenPos - renderSize * 0.5f;
+        return IRenderer::MakeSpriteInstance(centeredPos, renderSize,
+                                             region.uvMin, region.uvMax,
+                                             data.rotation, data.color);
+    };
 
-            glm::vec2 renderSize = data.size;
-            // Sunshine uses elongated beam texture (48x192 aspect ratio = 1:4)
-            if (data.type == ParticleType::Sunshine)
-            {
-                renderSize = glm::vec2(data.size.x, data.size.x * 4.0f);
-            }
-            // Rain uses stretched vertical texture with per-droplet variation
-            else if (data.type == ParticleType::Rain)
-            {
-                // Vary stretch between 1.0x and 1.4x based on particle phase
-                float stretch = 1.0f + 0.4f * (std::sin(data.phase) * 0.5f + 0.5f);
-                renderSize = glm::vec2(data.size.x, data.size.x * stretch);
-            }
-            // Snow flips like a coin
-            else if (data.type == ParticleType::Snow)
+    // Lambda to draw a batch, one instanced draw per run of equal blend mode
+    auto drawBatch = [&](const std::vector<ParticleRenderData> &batch)
+    {
+        if (!useAtlas)
+        {
+            for (const auto &data : batch)
             {
-                float flipScale = std::cos(m_Time * 3.0f + data.phase);
-                renderSize.x *= flipScale;
+                glm::vec2 size = data.size;
+                if (data.type == ParticleType::Rain)
+                    size = glm::vec2(1.0f, 8.0f);
+                renderer.DrawColoredRect(data.screenPos, size, data.color, data.additive);
             }
-            glm::vec2 centeredPos = data.screenPos - renderSize * 0.5f;
-            renderer.DrawSpriteAtlas(m_AtlasTexture, centeredPos, renderSize,
-                                     region.uvMin, region.uvMax,
-                                     data.rotation, data.color, data.additive);
+            return;
         }
-        else
+
+        size_t i = 0;
+        while (i < batch.size())
         {
-            glm::vec2 size = data.size;
-            if (data.type == ParticleType::Rain)
-                size = glm::vec2(1.0f, 8.0f);
-            renderer.DrawColoredRect(data.screenPos, size, data.color, data.additive);
+            const bool additive = batch[i].additive;
+            m_InstanceScratch.clear();
+            for (; i < batch.size() && batch[i].additive == additive; ++i)
+            {
+                m_InstanceScratch.push_back(makeInstance(batch[i]));
+            }
+            renderer.DrawSpriteInstances(m_AtlasTexture, m_InstanceScratch.data(),
+                                         m_InstanceScratch.size(), additive);
         }
     };
 
@@ -1103,43 +1380,50 @@ void ParticleSystem::Render(IRenderer &renderer, glm::vec2 cameraPos, bool noPro
 
     std::sort(noProjectionBatch.begin(), noProjectionBatch.end(), sortByBlendMode);
     std::sort(regularBatch.begin(), regularBatch.end(), sortByBlendMode);
+    m_DrawnParticles += noProjectionBatch.size() + regularBatch.size();
 
     // Draw noProjection particles with perspective suspended
     if (!noProjectionBatch.empty())
     {
         renderer.SuspendPerspective(true);
-        for (const auto &data : noProjectionBatch)
-        {
-            drawParticle(data);
-        }
+        drawBatch(noProjectionBatch);
         renderer.SuspendPerspective(false);
     }
 
     // Draw regular particles normally
-    for (const auto &data : regularBatch)
+    drawBatch(regularBatch);
+
+    // GPU weather is never no-projection, so it belongs to the regular pass
+    if (m_GpuSimulation && !m_GpuEmitters.empty() && useAtlas && (renderAll || !noProjectionOnly))
     {
-        drawParticle(data);
+        IRenderer::GpuParticleStep step;
+        step.deltaTime = m_GpuPendingDelta;
+        step.time = m_Time;
+        step.nightFactor = m_NightFactor;
+        step.seed = ++m_GpuStepCount;
+        step.wind = m_Wind;
+        step.cameraPos = cameraPos;
+        step.reset = m_GpuLayoutDirty;
+        renderer.SimulateGpuParticles(m_GpuEmitters.data(), m_GpuEmitters.size(), step);
+        renderer.DrawGpuParticles(m_AtlasTexture);
+
+        m_GpuPendingDelta = 0.0f;
+        m_GpuLayoutDirty = false;
+        for (IRenderer::GpuParticleEmitter &emitter : m_GpuEmitters)
+        {
+            emitter.spawnCount = 0;
+        }
     }
 }
 
 void ParticleSystem::OnZoneRemoved(int zoneIndex)
 {
     // Remove particles from the deleted zone and adjust indices for remaining particles
-    for (auto it = m_Particles.begin(); it != m_Particles.end();)
+    m_Pool.RemoveZone(zoneIndex);
+
+    // Spawn timers are indexed by zone as well
+    if (zoneIndex >= 0 && zoneIndex < static_cast<int>(m_ZoneSpawnTimers.size()))
     {
-        if (it->zoneIndex == zoneIndex)
-        {
-            // Remove particles from the deleted zone
-            it = m_Particles.erase(it);
-        }
-        else
-        {
-            // Adjust indices for particles from higher-indexed zones
-            if (it->zoneIndex > zoneIndex)
-            {
-                it->zoneIndex--;
-            }
-            ++it;
-        }
+        m_ZoneSpawnTimers.erase(m_ZoneSpawnTimers.begin() + zoneIndex);
     }
 }
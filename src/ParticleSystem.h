@@ -1,69 +1,21 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "ImageCache.h"
+#include "ParticlePool.h"
+#include "ParticleZoneScheduler.h"
 #include "Texture.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <random>
 #include <glm/glm.hpp>
 
+class JobSystem;
 class Tilemap;
 
-/**
- * @enum ParticleType
- * @brief Categories of particle effects with distinct visual behaviors.
- * @author Alex (https://github.com/lextpf)
- *
- * Each type has unique spawn, movement, and rendering characteristics.
- *
- * | Type     | Movement        | Blending | Use Case              |
- * |----------|-----------------|----------|-----------------------|
- * | Firefly  | Drifting, pulse | Additive | Night ambiance        |
- * | Rain     | Fast downward   | Alpha    | Weather               |
- * | Snow     | Slow drift down | Additive | Weather               |
- * | Fog      | Slow drift      | Alpha    | Atmosphere            |
- * | Sparkles | Stationary      | Additive | Magic/treasure        |
- * | Wisp     | Spiral wander   | Additive | Magical areas         |
- * | Lantern  | Stationary glow | Additive | Night lighting        |
- * | Sunshine | Angled rays     | Additive | Forest clearings      |
- */
-enum class ParticleType
-{
-    Firefly = 0,   ///< Pulsing yellow-green glow, gentle drift
-    Rain = 1,      ///< Fast falling droplets, slight angle
-    Snow = 2,      ///< Slow falling flakes with side drift
-    Fog = 3,       ///< Large translucent patches, very slow
-    Sparkles = 4,  ///< Brief bright flashes, stationary
-    Wisp = 5,      ///< Magical spiraling orbs, color variety
-    Lantern = 6,   ///< Warm glow, night-only visibility
-    Sunshine = 7   ///< Sun rays (day=yellow) / moon beams (night=blue)
-};
-
-/**
- * @struct Particle
- * @brief Runtime state for a single active particle.
- * @author Alex (https://github.com/lextpf)
- *
- * Particles are spawned by zones and updated each frame until their
- * lifetime expires. The `type` field is stored directly to handle
- * cases where the spawning zone is deleted mid-flight.
- */
-struct Particle
-{
-    glm::vec2 position;     ///< World position (pixels).
-    glm::vec2 velocity;     ///< Movement per second (pixels/s).
-    glm::vec4 color;        ///< RGBA color (alpha may animate).
-    float size;             ///< Sprite size in pixels.
-    float lifetime;         ///< Remaining life (seconds).
-    float maxLifetime;      ///< Original lifetime for fade calculations.
-    float phase;            ///< Random phase offset for oscillation effects.
-    float rotation;         ///< Sprite rotation (degrees).
-    bool additive;          ///< Use additive blending for glow.
-    bool noProjection;      ///< Render without perspective distortion.
-    int zoneIndex;          ///< Spawning zone index (-1 for orphaned).
-    ParticleType type;      ///< Particle behavior type.
-};
-
 /**
  * @struct ParticleZone
  * @brief Rectangular region that spawns particles of a specific type.
@@ -167,10 +119,39 @@ struct ParticleZone
  * Missing textures fall back to colored rectangles. Some textures are
  * procedurally generated.
  *
+ * @section particle_gpu GPU Simulation
+ * With SetGpuSimulation() on, Rain, Snow and Fog zones without
+ * `noProjection` are simulated by the renderer (IRenderer::SimulateGpuParticles()).
+ * Each such zone owns a fixed range of GPU particle slots; spawning,
+ * integration, the per-type fades and culling run in a compute pass,
+ * and the surviving particles are drawn through indirect draws from the
+ * same buffer. Per frame the CPU only sends the zone rectangles with their
+ * spawn budget, the night factor, wind and the camera.
+ *
+ * No-projection zones and the other types stay on the CPU pool: they
+ * need the tilemap's structure bounds or per-particle overlap tests,
+ * and rarely hold more than a few dozen particles.
+ *
+ * @section particle_scheduling Zone Scheduling
+ * Zones are indexed in a ParticleZoneScheduler grid, rebuilt only when
+ * Tilemap::GetParticleZoneRevision() changes, so a frame visits just the
+ * zones near the camera. Zones in view (+80 px) spawn at full rate, zones
+ * in the band beyond at a quarter rate, and the rest are paused.
+ *
+ * The frame budget (SetParticleBudget()) is split between the scheduled
+ * zones by on-screen area times their type priority (SetZonePriority()),
+ * capped per zone by SetMaxParticlesPerZone(). A zone that wakes up is
+ * pre-warmed: it is filled to its steady-state count with particles of
+ * random age, so it never pops in empty. GPU zones follow the same
+ * pause and rate rules but are not pre-warmed.
+ *
  * @section particle_performance Performance Notes
- * - Particles are pooled in a single vector (reserved for 500)
- * - Only zones within camera view (+margin) spawn particles
- * - Per-zone particle cap prevents runaway spawning
+ * - Particles live in a fixed-capacity ParticlePool, one array per field;
+ *   spawning and dying never allocate, and removal is swap-with-last
+ * - Only zones within camera view (+margin) spawn particles, found through
+ *   a grid instead of a scan over every zone
+ * - Per-zone particle cap prevents runaway spawning; the pool keeps the
+ *   per-zone counts, so the check is a lookup
  * - Spawn rate scales with zone area (0.5x to 3x multiplier)
  *
  * @see ParticleZone, Particle, Tilemap::GetParticleZones()
@@ -186,9 +167,11 @@ public:
      * Attempts to load each texture independently. Missing textures
      * will fall back to colored rectangles during rendering.
      *
+     * @param jobs Worker pool for decoding and generating the atlas sources
+     *             (nullptr = on this thread).
      * @return Always true (individual failures are non-fatal).
      */
-    bool LoadTextures();
+    bool LoadTextures(JobSystem *jobs = nullptr);
 
     /**
      * @brief Re-upload all particle textures to the renderer.
@@ -204,7 +187,11 @@ public:
      * @brief Set the zone list for particle spawning.
      * @param zones Pointer to zone vector (owned by Tilemap).
      */
-    void SetZones(const std::vector<ParticleZone>* zones) { m_Zones = zones; }
+    void SetZones(const std::vector<ParticleZone>* zones)
+    {
+        m_Zones = zones;
+        m_ZoneIndexDirty = true;
+    }
 
     /**
      * @brief Set tile dimensions for no-projection calculations.
@@ -225,6 +212,37 @@ public:
      */
     void SetMaxParticlesPerZone(size_t count) { m_MaxParticlesPerZone = count; }
 
+    /**
+     * @brief Set the total number of live particles (allocates the pool).
+     *
+     * Spawns beyond the limit are skipped until particles die.
+     *
+     * @param count Pool capacity (default ParticlePool::DEFAULT_CAPACITY).
+     */
+    void SetMaxParticles(size_t count) { m_Pool.SetCapacity(count); }
+
+    /**
+     * @brief Set the live particles shared by all scheduled zones.
+     * @param count Frame particle budget; 0 uses the pool capacity (default).
+     * @see particle_scheduling
+     */
+    void SetParticleBudget(size_t count) { m_ParticleBudget = count; }
+
+    /**
+     * @brief Set the budget weight of a particle type.
+     *
+     * A zone's share of the frame budget is its on-screen area times this
+     * weight. Defaults favor small, sparse types (Lantern, Wisp) over
+     * large fills (Fog).
+     *
+     * @param type     Particle type.
+     * @param priority Weight (>= 0; 0 gives the type no budget).
+     */
+    void SetZonePriority(ParticleType type, float priority);
+
+    /// @brief Scheduler tuning (margins, decimated rate, grid cell size).
+    ParticleZoneScheduler& GetZoneScheduler() { return m_Scheduler; }
+
     /**
      * @brief Set the night visibility factor for lantern effects.
      *
@@ -234,6 +252,84 @@ public:
      */
     void SetNightFactor(float factor) { m_NightFactor = factor; }
 
+    /**
+     * @brief Append the light given off by glowing particles.
+     *
+     * Lanterns, fireflies and wisps each add a radial light in their own
+     * color, scaled by their current alpha (so lanterns fade with the night
+     * factor). Positions are relative to @p cameraPos, as expected by
+     * IRenderer::SetLightMap().
+     *
+     * @param cameraPos Camera position (top-left of the view).
+     * @param viewSize  View size; lights that cannot reach it are skipped.
+     * @param lights    Receives the lights.
+     */
+    void CollectLights(glm::vec2 cameraPos, glm::vec2 viewSize, std::vector<IRenderer::Light>& lights) const;
+
+    /**
+     * @brief Leave lantern glows to the light map.
+     *
+     * While set, Render() skips the large additive lantern sprites, whose
+     * light CollectLights() reports instead. Fireflies and wisps are still
+     * drawn, they are visible specks as well as light sources.
+     *
+     * @param active True once IRenderer::SetLightMap() succeeded this frame.
+     */
+    void SetLightMapActive(bool active) { m_LightMapActive = active; }
+
+    /**
+     * @brief Set the wind applied to weather particles (Rain, Snow, Fog).
+     * @param wind Velocity added to every weather particle (pixels/s).
+     */
+    void SetWind(glm::vec2 wind) { m_Wind = wind; }
+
+    /**
+     * @brief Simulate weather zones on the GPU instead of the CPU pool.
+     *
+     * Only enable when the active renderer reports
+     * IRenderer::SupportsGpuParticles(), and re-apply after a renderer switch.
+     * Toggling discards the particles of the affected zones.
+     *
+     * @param enabled True to hand Rain, Snow and Fog zones to the GPU.
+     * @see particle_gpu
+     */
+    void SetGpuSimulation(bool enabled);
+
+    /// @brief Whether weather zones are simulated on the GPU.
+    bool IsGpuSimulation() const { return m_GpuSimulation; }
+
+    /**
+     * @brief Set the GPU particle slots reserved per weather zone.
+     *
+     * Slots are allocated up front (40 bytes each, plus a 32-byte draw
+     * record), so this is the GPU counterpart of SetMaxParticlesPerZone().
+     *
+     * @param count Live particle cap per GPU zone (default 16384).
+     */
+    void SetGpuParticlesPerZone(size_t count);
+
+    /**
+     * @brief Scale the spawn rate of GPU weather zones.
+     *
+     * At 1.0 GPU zones look like their CPU counterparts. Rain at 100x
+     * spawns up to 15000 drops per second in a large zone at no CPU cost;
+     * raise SetGpuParticlesPerZone() to match.
+     *
+     * @param density Spawn rate multiplier (> 0).
+     */
+    void SetGpuDensity(float density) { m_GpuDensity = std::max(density, 0.001f); }
+
+    /**
+     * @brief Reseed the spawn randomness (CPU and GPU) for a repeatable run.
+     *
+     * By default the RNG is seeded from std::random_device. Only particles
+     * spawned afterwards are affected; call Clear() first to also drop the
+     * live ones.
+     *
+     * @param seed Seed for the CPU RNG; also restarts the GPU step seeds.
+     */
+    void SetSeed(std::uint32_t seed);
+
     /**
      * @brief Update all particles and spawn new ones.
      *
@@ -241,7 +337,7 @@ public:
      * 1. Decrement lifetimes, remove dead particles
      * 2. Update positions based on velocity and type-specific behavior
      * 3. Update alpha/color for effects (pulsing, fading)
-     * 4. Spawn new particles in visible zones
+     * 4. Schedule zones and spawn into those near the view (see particle_scheduling)
      *
      * @param deltaTime Frame time in seconds.
      * @param cameraPos Camera position for visibility culling.
@@ -265,14 +361,31 @@ public:
 
     /**
      * @brief Get read-only access to the particle pool.
-     * @return Reference to particle vector.
+     * @return Reference to the live particles.
+     */
+    const ParticlePool& GetParticles() const { return m_Pool; }
+
+    /// @brief Heap bytes of the pool and the per-frame scratch buffers (atlas excluded).
+    size_t GetMemoryBytes() const;
+
+    /**
+     * @brief CPU particles that passed culling in Render() since the last reset.
+     *
+     * GPU-simulated weather is not included; its visible count stays on the GPU.
      */
-    const std::vector<Particle>& GetParticles() const { return m_Particles; }
+    size_t GetDrawnParticleCount() const { return m_DrawnParticles; }
+
+    /// @brief Start a new count for GetDrawnParticleCount() (once per frame).
+    void ResetDrawnParticleCount() { m_DrawnParticles = 0; }
 
     /**
-     * @brief Remove all active particles.
+     * @brief Remove all active particles, including GPU-simulated ones.
      */
-    void Clear() { m_Particles.clear(); }
+    void Clear()
+    {
+        m_Pool.Clear();
+        m_GpuLayoutDirty = true;
+    }
 
     /**
      * @brief Handle zone deletion by cleaning up orphaned particles.
@@ -295,12 +408,39 @@ private:
     void SpawnLantern(int zoneIndex, const ParticleZone& zone);
     void SpawnSunshine(int zoneIndex, const ParticleZone& zone);
 
+    /// @brief Rebuild the GPU emitter list from the zones, flagging slot layout changes.
+    void SyncGpuEmitters();
+
+    /// @brief Re-index the zones in the scheduler if the zone list changed.
+    void SyncZoneIndex();
+
+    /// @brief Fill a waking zone to its steady-state count with particles of random age.
+    void PrewarmZone(int zoneIndex, const ParticleZone& zone, float spawnRate, size_t budget);
+
     /// @name Particle Pool
     /// @{
 
-    std::vector<Particle> m_Particles;            ///< Active particle pool.
+    ParticlePool m_Pool;                          ///< Active particles (SoA, fixed capacity).
     const std::vector<ParticleZone>* m_Zones;     ///< Zone list (owned by Tilemap).
     const Tilemap* m_Tilemap;                     ///< Tilemap for structure queries.
+    std::vector<IRenderer::SpriteInstance> m_InstanceScratch;  ///< Reused per Render() run.
+
+    /// Screen-space particle gathered by Render() before drawing.
+    struct ParticleRenderData
+    {
+        glm::vec2 screenPos;
+        glm::vec2 size;
+        glm::vec4 color;
+        float rotation;
+        float phase;
+        bool additive;
+        ParticleType type;
+    };
+    std::vector<ParticleRenderData> m_NoProjectionBatch;  ///< Reused per Render() run.
+    std::vector<ParticleRenderData> m_RegularBatch;       ///< Reused per Render() run.
+    std::vector<uint8_t> m_VisibleMask;                   ///< Viewport cull result per pool slot.
+    size_t m_DrawnParticles = 0;                          ///< Drawn since ResetDrawnParticleCount().
+    bool m_LightMapActive = false;                        ///< Lanterns are lit by the light map.
 
     /// @}
 
@@ -313,6 +453,34 @@ private:
     float m_Time;                          ///< Elapsed time for oscillation effects.
     float m_NightFactor;                   ///< Day/night factor (0-1) for lanterns.
     std::vector<float> m_ZoneSpawnTimers;  ///< Per-zone spawn accumulators.
+    glm::vec2 m_Wind;                      ///< Wind added to weather particles (pixels/s).
+
+    /// @}
+
+    /// @name Zone Scheduling
+    /// @{
+
+    ParticleZoneScheduler m_Scheduler;                        ///< Zone grid, states and budgets.
+    std::vector<ParticleZoneScheduler::Zone> m_ScheduledZones; ///< Scratch for SyncZoneIndex().
+    std::array<float, 8> m_ZonePriorities;                    ///< Budget weight per ParticleType.
+    size_t m_ParticleBudget;                                  ///< Frame budget, 0 = pool capacity.
+    std::uint64_t m_ZoneRevision;                             ///< Tilemap revision last indexed.
+    bool m_ZoneIndexDirty;                                    ///< Force a re-index next Update().
+
+    /// @}
+
+    /// @name GPU Simulation
+    /// @{
+
+    bool m_GpuSimulation;                                     ///< Weather zones run on the GPU.
+    size_t m_GpuParticlesPerZone;                             ///< Slots per GPU emitter.
+    float m_GpuDensity;                                       ///< GPU spawn rate multiplier.
+    std::vector<IRenderer::GpuParticleEmitter> m_GpuEmitters; ///< One per GPU zone, spawn budget pending.
+    std::vector<int> m_GpuEmitterZones;                       ///< Zone index of each emitter.
+    std::vector<int> m_GpuEmitterOfZone;                      ///< Emitter per zone, -1 for CPU zones.
+    float m_GpuPendingDelta;                                  ///< Time not yet stepped on the GPU.
+    std::uint32_t m_GpuStepCount;                             ///< Seeds the GPU spawn randomness.
+    bool m_GpuLayoutDirty;                                    ///< Kill GPU particles on the next step.
 
     /// @}
 
@@ -346,25 +514,25 @@ private:
      * @brief Build the texture atlas from individual particle textures.
      *
      * Loads all particle textures, packs them into a single atlas,
-     * and calculates UV regions for each particle type.
+     * and calculates UV regions for each particle type. The sources are
+     * decoded or generated in parallel on @p jobs through a TextureBaker.
      */
-    void BuildAtlas();
+    void BuildAtlas(JobSystem *jobs);
+
+    /// @brief Part of the generators' cache key; bump when a Generate*Pixels() changes.
+    static constexpr int TEXTURE_REVISION = 1;
 
     /**
      * @brief Generate the lantern glow texture procedurally.
-     * @param[out] pixels Output pixel buffer (256x256 RGBA).
-     * @param[out] width  Output width.
-     * @param[out] height Output height.
+     * @param[out] image Receives 256x256 RGBA pixels.
      */
-    void GenerateLanternPixels(std::vector<unsigned char> &pixels, int &width, int &height);
+    static void GenerateLanternPixels(ImageCache::Image &image);
 
     /**
      * @brief Generate the sunshine ray texture procedurally.
-     * @param[out] pixels Output pixel buffer (48x192 RGBA).
-     * @param[out] width  Output width.
-     * @param[out] height Output height.
+     * @param[out] image Receives 48x192 RGBA pixels.
      */
-    void GenerateSunshinePixels(std::vector<unsigned char> &pixels, int &width, int &height);
+    static void GenerateSunshinePixels(ImageCache::Image &image);
 
     /// @}
 };
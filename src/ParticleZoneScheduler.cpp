@@ -0,0 +1,144 @@
+#include "ParticleZoneScheduler.h"
+
+#include <algorithm>
+
+void ParticleZoneScheduler::SetZones(const std::vector<Zone> &zones)
+{
+    m_Zones = zones;
+    m_Plans.resize(zones.size());
+    m_VisitStamp.assign(zones.size(), 0u);
+    m_Stamp = 0;
+
+    // Drop scheduled indices that no longer exist
+    auto stale = [&](std::uint32_t index) { return index >= m_Zones.size(); };
+    m_Scheduled.erase(std::remove_if(m_Scheduled.begin(), m_Scheduled.end(), stale), m_Scheduled.end());
+    m_PrevScheduled.erase(std::remove_if(m_PrevScheduled.begin(), m_PrevScheduled.end(), stale),
+                          m_PrevScheduled.end());
+
+    m_Cells.clear();
+    m_LargeZones.clear();
+    for (std::uint32_t index = 0; index < m_Zones.size(); ++index)
+    {
+        const Zone &zone = m_Zones[index];
+        if (!zone.enabled)
+            continue;
+
+        const int cx0 = CellCoord(zone.position.x), cy0 = CellCoord(zone.position.y);
+        const int cx1 = CellCoord(zone.position.x + zone.size.x);
+        const int cy1 = CellCoord(zone.position.y + zone.size.y);
+        if ((cx1 - cx0 + 1) * (cy1 - cy0 + 1) > MAX_ZONE_CELLS)
+        {
+            m_LargeZones.push_back(index);
+            continue;
+        }
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+                m_Cells[CellKey(cx, cy)].push_back(index);
+        }
+    }
+}
+
+void ParticleZoneScheduler::Schedule(glm::vec2 viewMin, glm::vec2 viewMax, std::size_t particleBudget,
+                                     std::size_t zoneCap)
+{
+    // Everything scheduled last frame is Paused unless the query finds it again
+    m_PrevScheduled.swap(m_Scheduled);
+    m_Scheduled.clear();
+    for (std::uint32_t index : m_PrevScheduled)
+        m_Plans[index].state = State::Paused;
+
+    const glm::vec2 activeMin = viewMin - glm::vec2(m_ActiveMargin);
+    const glm::vec2 activeMax = viewMax + glm::vec2(m_ActiveMargin);
+    const glm::vec2 reach(m_ActiveMargin + m_DecimatedDistance);
+
+    const std::uint32_t decimatedCap = static_cast<std::uint32_t>(
+        std::ceil(static_cast<float>(zoneCap) * std::clamp(m_DecimatedRate, 0.0f, 1.0f)));
+    m_Weights.clear();
+    m_Caps.clear();
+    ForEachZoneInBox(viewMin - reach, viewMax + reach, [&](std::uint32_t index) { m_Scheduled.push_back(index); });
+    std::sort(m_Scheduled.begin(), m_Scheduled.end());
+
+    for (std::uint32_t index : m_Scheduled)
+    {
+        const Zone &zone = m_Zones[index];
+        Plan &plan = m_Plans[index];
+
+        // Part of the zone inside the margin-grown view; empty for Decimated zones
+        const glm::vec2 overlapMin = glm::max(zone.position, activeMin);
+        const glm::vec2 overlapMax = glm::min(zone.position + zone.size, activeMax);
+        const bool active = overlapMin.x <= overlapMax.x && overlapMin.y <= overlapMax.y;
+
+        float area;
+        if (active)
+        {
+            plan.state = State::Active;
+            area = (overlapMax.x - overlapMin.x) * (overlapMax.y - overlapMin.y);
+            m_Caps.push_back(static_cast<std::uint32_t>(zoneCap));
+        }
+        else
+        {
+            plan.state = State::Decimated;
+            area = zone.size.x * zone.size.y * m_DecimatedRate;
+            m_Caps.push_back(decimatedCap);
+        }
+        // Degenerate zones still get a share
+        m_Weights.push_back(std::max(area, 1.0f) * std::max(zone.priority, 0.0f));
+    }
+
+    // Resumed = scheduled now but not last frame (both lists are sorted)
+    size_t prev = 0;
+    for (std::uint32_t index : m_Scheduled)
+    {
+        while (prev < m_PrevScheduled.size() && m_PrevScheduled[prev] < index)
+            ++prev;
+        m_Plans[index].resumed = prev == m_PrevScheduled.size() || m_PrevScheduled[prev] != index;
+    }
+    for (std::uint32_t index : m_PrevScheduled)
+    {
+        if (m_Plans[index].state == State::Paused)
+        {
+            m_Plans[index].budget = 0;
+            m_Plans[index].resumed = false;
+        }
+    }
+
+    // Split the budget by weight, then hand what capped zones cannot use to
+    // the rest until no share exceeds its cap
+    const size_t count = m_Scheduled.size();
+    double budgetLeft = static_cast<double>(particleBudget);
+    double weightLeft = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_Plans[m_Scheduled[i]].budget = 0;
+        weightLeft += m_Weights[i];
+    }
+
+    bool capped = true;
+    while (capped && weightLeft > 0.0)
+    {
+        capped = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (m_Weights[i] <= 0.0f)
+                continue;
+            const double share = budgetLeft * m_Weights[i] / weightLeft;
+            if (share >= m_Caps[i])
+            {
+                m_Plans[m_Scheduled[i]].budget = m_Caps[i];
+                budgetLeft -= m_Caps[i];
+                weightLeft -= m_Weights[i];
+                m_Weights[i] = 0.0f;
+                capped = true;
+            }
+        }
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (m_Weights[i] > 0.0f && weightLeft > 0.0)
+        {
+            m_Plans[m_Scheduled[i]].budget =
+                static_cast<std::uint32_t>(std::max(0.0, budgetLeft * m_Weights[i] / weightLeft));
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ParticleZoneScheduler
+ * @brief Decides which particle zones spawn this frame and how many particles each may hold.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Effects
+ *
+ * Zones are bucketed into a uniform grid once (SetZones()), so a frame only
+ * visits the zones near the camera instead of every zone in the map. Every
+ * visited zone is classified by its distance to the view:
+ *
+ * | State     | Distance to view               | Spawning                 |
+ * |-----------|--------------------------------|--------------------------|
+ * | Active    | <= active margin               | Full rate                |
+ * | Decimated | <= margin + decimated distance | Rate x decimated rate    |
+ * | Paused    | Beyond, or disabled            | None (not even visited)  |
+ *
+ * @par Budget
+ * The frame particle budget is split between the scheduled zones in
+ * proportion to `priority x area`, where the area of an Active zone is the
+ * part inside the (margin-grown) view and that of a Decimated zone is its
+ * full area scaled by the decimated rate. No zone gets more than the
+ * per-zone cap; budget a capped zone cannot use goes to the others.
+ *
+ * @par Resuming
+ * Plan::resumed is set on the frame a zone leaves Paused. The caller uses
+ * it to pre-warm the zone, so it comes into view already populated.
+ *
+ * @par Thread Safety
+ * Not thread-safe.
+ *
+ * @see ParticleSystem::Update(), SimulationLod
+ */
+class ParticleZoneScheduler
+{
+public:
+    /// @brief Scheduling state of a zone for the current frame.
+    enum class State : std::uint8_t
+    {
+        Paused,     ///< No spawning
+        Decimated,  ///< Near the view: spawns at a reduced rate
+        Active      ///< On screen or at its edge: spawns at full rate
+    };
+
+    /// @brief Zone rectangle as seen by the scheduler.
+    struct Zone
+    {
+        glm::vec2 position{0.0f};  ///< Top-left corner (world pixels)
+        glm::vec2 size{0.0f};      ///< Width and height (world pixels)
+        float priority = 1.0f;     ///< Budget weight per pixel of area
+        bool enabled = true;       ///< Disabled zones are always Paused
+    };
+
+    /// @brief Result of Schedule() for one zone.
+    struct Plan
+    {
+        State state = State::Paused;
+        std::uint32_t budget = 0;  ///< Live particles the zone may hold
+        bool resumed = false;      ///< Was Paused last frame
+    };
+
+    /// @brief Default grid cell edge length (px).
+    static constexpr float DEFAULT_CELL_SIZE = 512.0f;
+
+    /// @brief Default margin around the view that still counts as on screen (px).
+    static constexpr float DEFAULT_ACTIVE_MARGIN = 80.0f;
+
+    /// @brief Default width of the Decimated band beyond the margin (px).
+    static constexpr float DEFAULT_DECIMATED_DISTANCE = 320.0f;
+
+    /// @brief Default spawn rate and budget multiplier of Decimated zones.
+    static constexpr float DEFAULT_DECIMATED_RATE = 0.25f;
+
+    /**
+     * @brief Replace the zone list and rebuild the grid.
+     *
+     * Plans of indices that still exist are kept, so a rebuild does not
+     * make every zone count as resumed; new indices start Paused.
+     */
+    void SetZones(const std::vector<Zone> &zones);
+
+    /// @brief Number of zones passed to SetZones().
+    [[nodiscard]] std::size_t GetZoneCount() const { return m_Zones.size(); }
+
+    /**
+     * @brief Classify the zones for a frame and split the particle budget.
+     * @param viewMin        Top-left corner of the view (world px).
+     * @param viewMax        Bottom-right corner of the view (world px).
+     * @param particleBudget Live particles shared by all scheduled zones.
+     * @param zoneCap        Live particles a single zone may hold.
+     */
+    void Schedule(glm::vec2 viewMin, glm::vec2 viewMax, std::size_t particleBudget, std::size_t zoneCap);
+
+    /// @brief Zones that are not Paused this frame, in ascending index order.
+    [[nodiscard]] const std::vector<std::uint32_t> &GetScheduledZones() const { return m_Scheduled; }
+
+    /// @brief Plan of @p zone for the current frame.
+    [[nodiscard]] const Plan &GetPlan(std::size_t zone) const { return m_Plans[zone]; }
+
+    /// @brief Spawn rate multiplier for @p state.
+    [[nodiscard]] float GetSpawnScale(State state) const
+    {
+        return state == State::Active ? 1.0f : state == State::Decimated ? m_DecimatedRate : 0.0f;
+    }
+
+    /// @brief Call @p fn(index) once for every zone overlapping [@p min, @p max].
+    template<typename Fn>
+    void ForEachZoneInBox(glm::vec2 min, glm::vec2 max, Fn &&fn)
+    {
+        // Zones spanning several cells are reported once per query
+        if (++m_Stamp == 0)
+        {
+            std::fill(m_VisitStamp.begin(), m_VisitStamp.end(), 0u);
+            m_Stamp = 1;
+        }
+
+        auto visit = [&](std::uint32_t index)
+        {
+            if (m_VisitStamp[index] == m_Stamp)
+                return;
+            m_VisitStamp[index] = m_Stamp;
+            const Zone &zone = m_Zones[index];
+            if (zone.position.x > max.x || zone.position.x + zone.size.x < min.x ||
+                zone.position.y > max.y || zone.position.y + zone.size.y < min.y)
+                return;
+            fn(index);
+        };
+
+        for (std::uint32_t index : m_LargeZones)
+            visit(index);
+
+        if (m_Cells.empty() || min.x > max.x || min.y > max.y)
+            return;
+        const int cx0 = CellCoord(min.x), cy0 = CellCoord(min.y);
+        const int cx1 = CellCoord(max.x), cy1 = CellCoord(max.y);
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                auto it = m_Cells.find(CellKey(cx, cy));
+                if (it == m_Cells.end())
+                    continue;
+                for (std::uint32_t index : it->second)
+                    visit(index);
+            }
+        }
+    }
+
+    void SetCellSize(float pixels) { m_CellSize = pixels > 0.0f ? pixels : DEFAULT_CELL_SIZE; }
+    void SetActiveMargin(float pixels) { m_ActiveMargin = pixels; }
+    void SetDecimatedDistance(float pixels) { m_DecimatedDistance = pixels; }
+    void SetDecimatedRate(float rate) { m_DecimatedRate = rate; }
+
+private:
+    /// @brief Zones covering more cells than this skip the grid and are tested every query.
+    static constexpr int MAX_ZONE_CELLS = 64;
+
+    [[nodiscard]] int CellCoord(float v) const { return static_cast<int>(std::floor(v / m_CellSize)); }
+
+    [[nodiscard]] static std::uint64_t CellKey(int cx, int cy)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint32_t>(cy);
+    }
+
+    std::vector<Zone> m_Zones;
+    std::vector<Plan> m_Plans;
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_Cells;
+    std::vector<std::uint32_t> m_LargeZones;  ///< Too big to bucket
+    std::vector<std::uint32_t> m_VisitStamp;  ///< Per zone, dedupes multi-cell zones
+    std::uint32_t m_Stamp = 0;
+
+    std::vector<std::uint32_t> m_Scheduled;      ///< Not Paused this frame
+    std::vector<std::uint32_t> m_PrevScheduled;  ///< Not Paused last frame
+    std::vector<float> m_Weights;                ///< Per scheduled zone, reused
+    std::vector<std::uint32_t> m_Caps;           ///< Per scheduled zone, reused
+
+    float m_CellSize = DEFAULT_CELL_SIZE;
+    float m_ActiveMargin = DEFAULT_ACTIVE_MARGIN;
+    float m_DecimatedDistance = DEFAULT_DECIMATED_DISTANCE;
+    float m_DecimatedRate = DEFAULT_DECIMATED_RATE;
+};
@@ -0,0 +1,874 @@
+#include "Pathfinder.h"
+#include "Tilemap.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+
+namespace
+{
+/// Direction indices: +x, -x, +y, -y; DIR_START expands all four
+constexpr int DIR_START = 4;
+const glm::ivec2 DIR_STEP[4] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+/// Openings at least this long get an entrance at each end instead of one in the middle
+constexpr int LONG_ENTRANCE = 6;
+}  // namespace
+
+static int Manhattan(glm::ivec2 a, glm::ivec2 b)
+{
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+/**
+ * Resumable jump point search on the 4-connected grid, limited to a rectangle.
+ *
+ * Canonical paths move horizontally first. A horizontal jump therefore stops
+ * wherever a vertical scan from it finds something; a vertical jump stops at
+ * the goal or where a side tile becomes reachable only through this column
+ * (its neighbour behind us is blocked).
+ */
+class Pathfinder::GridSearch
+{
+public:
+    using State = SearchState;
+
+    explicit GridSearch(const Pathfinder &owner)
+        : m_Owner(owner)
+    {
+    }
+
+    /// Start a search from @p start to @p goal inside @p bounds (x0, y0, x1, y1 inclusive)
+    void Begin(glm::ivec2 start, glm::ivec2 goal, glm::ivec4 bounds)
+    {
+        const size_t cells = static_cast<size_t>(m_Owner.m_Width) * static_cast<size_t>(m_Owner.m_Height);
+        if (m_Stamp.size() != cells)
+        {
+            m_Stamp.assign(cells, 0);
+            m_G.resize(cells);
+            m_Parent.resize(cells);
+            m_Dir.resize(cells);
+            m_Generation = 0;
+        }
+        if (++m_Generation == 0)
+        {
+            std::fill(m_Stamp.begin(), m_Stamp.end(), 0);
+            m_Generation = 1;
+        }
+
+        m_Start = start;
+        m_Goal = goal;
+        m_Bounds = bounds;
+        m_Found = -1;
+        m_Open.clear();
+        Push(Index(start.x, start.y), 0, -1, DIR_START);
+    }
+
+    /// Expand nodes until the goal is popped, the open list empties or @p budget runs out
+    State Step(int &budget)
+    {
+        while (budget > 0 && !m_Open.empty())
+        {
+            std::pop_heap(m_Open.begin(), m_Open.end(), std::greater<>{});
+            const HeapEntry entry = m_Open.back();
+            m_Open.pop_back();
+
+            const int node = entry.node;
+            if ((m_Dir[node] & CLOSED) || entry.g != m_G[node])
+                continue;
+            m_Dir[node] |= CLOSED;
+
+            if (node == Index(m_Goal.x, m_Goal.y))
+            {
+                m_Found = node;
+                return State::Found;
+            }
+
+            m_Scanned = 0;
+            Expand(node);
+            budget -= std::max(1, m_Scanned);
+        }
+        return m_Open.empty() ? State::Failed : State::Running;
+    }
+
+    /// Append the found path to @p path, excluding the start tile
+    void AppendPath(std::vector<glm::ivec2> &path) const
+    {
+        if (m_Found < 0)
+            return;
+
+        // Jump points from goal back to start, then walk each straight segment forward
+        std::vector<int> jumps;
+        for (int node = m_Found; node >= 0; node = m_Parent[node])
+            jumps.push_back(node);
+
+        const int width = m_Owner.m_Width;
+        for (size_t i = jumps.size() - 1; i > 0; --i)
+        {
+            glm::ivec2 cell(jumps[i] % width, jumps[i] / width);
+            const glm::ivec2 to(jumps[i - 1] % width, jumps[i - 1] / width);
+            const glm::ivec2 step((to.x > cell.x) - (to.x < cell.x), (to.y > cell.y) - (to.y < cell.y));
+            while (cell != to)
+            {
+                cell += step;
+                path.push_back(cell);
+            }
+        }
+    }
+
+private:
+    static constexpr uint8_t CLOSED = 0x80;
+
+    int Index(int x, int y) const { return y * m_Owner.m_Width + x; }
+
+    bool Walkable(int x, int y) const
+    {
+        return x >= m_Bounds.x && y >= m_Bounds.y && x <= m_Bounds.z && y <= m_Bounds.w &&
+               m_Owner.IsWalkable(x, y);
+    }
+
+    void Push(int node, int g, int parent, int dir)
+    {
+        if (m_Stamp[node] != m_Generation)
+        {
+            m_Stamp[node] = m_Generation;
+            m_G[node] = INT_MAX;
+            m_Dir[node] = 0;
+        }
+        if ((m_Dir[node] & CLOSED) || g >= m_G[node])
+            return;
+
+        m_G[node] = g;
+        m_Parent[node] = parent;
+        m_Dir[node] = static_cast<uint8_t>(dir);
+
+        const glm::ivec2 cell(node % m_Owner.m_Width, node / m_Owner.m_Width);
+        m_Open.push_back({g + Manhattan(cell, m_Goal), g, node});
+        std::push_heap(m_Open.begin(), m_Open.end(), std::greater<>{});
+    }
+
+    void Expand(int node)
+    {
+        const int x = node % m_Owner.m_Width;
+        const int y = node / m_Owner.m_Width;
+        const int dir = m_Dir[node] & ~CLOSED;
+
+        auto jumpFrom = [&](int d)
+        {
+            const int jump = Jump(x, y, d);
+            if (jump >= 0)
+            {
+                const glm::ivec2 cell(jump % m_Owner.m_Width, jump / m_Owner.m_Width);
+                Push(jump, m_G[node] + Manhattan(cell, {x, y}), node, d);
+            }
+        };
+
+        if (dir == DIR_START)
+        {
+            for (int d = 0; d < 4; ++d)
+                jumpFrom(d);
+        }
+        else if (dir < 2)
+        {
+            // Arrived horizontally: ahead and both verticals are natural
+            jumpFrom(dir);
+            jumpFrom(2);
+            jumpFrom(3);
+        }
+        else
+        {
+            // Arrived vertically: ahead is natural, sides only when forced
+            const int dy = DIR_STEP[dir].y;
+            jumpFrom(dir);
+            if (Walkable(x + 1, y) && !Walkable(x + 1, y - dy))
+                jumpFrom(0);
+            if (Walkable(x - 1, y) && !Walkable(x - 1, y - dy))
+                jumpFrom(1);
+        }
+    }
+
+    bool HasForcedNeighbour(int x, int y, int dy) const
+    {
+        return (Walkable(x + 1, y) && !Walkable(x + 1, y - dy)) ||
+               (Walkable(x - 1, y) && !Walkable(x - 1, y - dy));
+    }
+
+    /// Walk vertically from (x, y); true if a jump point or the goal lies on the way
+    bool ScanVertical(int x, int y, int dy)
+    {
+        for (;;)
+        {
+            y += dy;
+            ++m_Scanned;
+            if (!Walkable(x, y))
+                return false;
+            if ((x == m_Goal.x && y == m_Goal.y) || HasForcedNeighbour(x, y, dy))
+                return true;
+        }
+    }
+
+    /// Next jump point from (x, y) in direction @p dir, or -1
+    int Jump(int x, int y, int dir)
+    {
+        const glm::ivec2 step = DIR_STEP[dir];
+        for (;;)
+        {
+            x += step.x;
+            y += step.y;
+            ++m_Scanned;
+            if (!Walkable(x, y))
+                return -1;
+            if (x == m_Goal.x && y == m_Goal.y)
+                return Index(x, y);
+            if (step.x != 0)
+            {
+                if (ScanVertical(x, y, 1) || ScanVertical(x, y, -1))
+                    return Index(x, y);
+            }
+            else if (HasForcedNeighbour(x, y, step.y))
+            {
+                return Index(x, y);
+            }
+        }
+    }
+
+    const Pathfinder &m_Owner;
+    glm::ivec2 m_Start{0};
+    glm::ivec2 m_Goal{0};
+    glm::ivec4 m_Bounds{0};
+    std::vector<uint32_t> m_Stamp;  ///< Entry valid when equal to m_Generation
+    std::vector<int> m_G;
+    std::vector<int> m_Parent;
+    std::vector<uint8_t> m_Dir;     ///< Arrival direction, CLOSED bit once expanded
+    std::vector<HeapEntry> m_Open;
+    uint32_t m_Generation = 0;
+    int m_Scanned = 0;
+    int m_Found = -1;
+};
+
+Pathfinder::Pathfinder()
+    : m_ClusterDistance(CLUSTER_SIZE * CLUSTER_SIZE, -1)
+{
+    m_ClusterQueue.reserve(CLUSTER_SIZE * CLUSTER_SIZE);
+    m_AsyncSlot.grid = std::make_unique<GridSearch>(*this);
+    m_SyncSlot.grid = std::make_unique<GridSearch>(*this);
+}
+
+Pathfinder::~Pathfinder() = default;
+
+void Pathfinder::SetTilemap(const Tilemap *tilemap)
+{
+    m_Tilemap = tilemap;
+    m_Queue.clear();
+    m_Results.clear();
+    ResetGraph();
+    m_SeenVersion = tilemap ? tilemap->GetNavigationVersion() : 0;
+}
+
+bool Pathfinder::IsWalkable(int x, int y) const
+{
+    if (!m_Tilemap || x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+        return false;
+    return m_Tilemap->GetNavigation(x, y) && !m_Tilemap->GetTileCollision(x, y);
+}
+
+bool Pathfinder::FindPath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path)
+{
+    SyncNavigation();
+
+    Request request;
+    request.start = start;
+    request.goal = goal;
+
+    PathStatus status = PathStatus::NotFound;
+    int budget = INT_MAX;
+    while (!StepRequest(request, m_SyncSlot, budget, status))
+        budget = INT_MAX;
+
+    path = std::move(request.path);
+    return status == PathStatus::Found;
+}
+
+Pathfinder::RequestId Pathfinder::RequestPath(glm::ivec2 start, glm::ivec2 goal)
+{
+    Request request;
+    request.id = m_NextId++;
+    if (m_NextId == 0)
+        m_NextId = 1;
+    request.start = start;
+    request.goal = goal;
+    m_Queue.push_back(std::move(request));
+    return m_Queue.back().id;
+}
+
+void Pathfinder::Cancel(RequestId id)
+{
+    m_Results.erase(id);
+    std::erase_if(m_Queue, [id](const Request &request) { return request.id == id; });
+}
+
+Pathfinder::PathStatus Pathfinder::GetStatus(RequestId id) const
+{
+    if (auto it = m_Results.find(id); it != m_Results.end())
+        return it->second.status;
+    const bool queued = std::any_of(m_Queue.begin(), m_Queue.end(),
+                                    [id](const Request &request) { return request.id == id; });
+    return queued ? PathStatus::Pending : PathStatus::Unknown;
+}
+
+bool Pathfinder::TakePath(RequestId id, std::vector<glm::ivec2> &path)
+{
+    auto it = m_Results.find(id);
+    if (it == m_Results.end())
+        return false;
+
+    const bool found = it->second.status == PathStatus::Found;
+    if (found)
+        path = std::move(it->second.path);
+    m_Results.erase(it);
+    return found;
+}
+
+void Pathfinder::Update(int budget)
+{
+    ++m_UpdateCount;
+    SyncNavigation();
+
+    // Results whose requester went away (NPC streamed out) are dropped eventually
+    std::erase_if(m_Results, [this](const auto &entry) { return m_UpdateCount >= entry.second.expiresAt; });
+
+    while (budget > 0 && !m_Queue.empty())
+    {
+        Request &request = m_Queue.front();
+        if (request.phase != Phase::Begin && request.version != m_SeenVersion)
+            request.phase = Phase::Begin;  // The map changed under this request
+
+        PathStatus status = PathStatus::NotFound;
+        if (!StepRequest(request, m_AsyncSlot, budget, status))
+            break;
+
+        m_Results[request.id] = Result{status, std::move(request.path), m_UpdateCount + RESULT_LIFETIME};
+        m_Queue.pop_front();
+    }
+}
+
+bool Pathfinder::StepRequest(Request &request, SearchSlot &slot, int &budget, PathStatus &status)
+{
+    GridSearch &search = *slot.grid;
+    while (budget > 0)
+    {
+        switch (request.phase)
+        {
+        case Phase::Begin:
+        {
+            request.version = m_SeenVersion;
+            request.path.clear();
+            request.waypoints.clear();
+            request.leg = 0;
+            request.searching = false;
+
+            if (!IsWalkable(request.start.x, request.start.y) || !IsWalkable(request.goal.x, request.goal.y))
+            {
+                status = PathStatus::NotFound;
+                return true;
+            }
+            if (request.start == request.goal)
+            {
+                status = PathStatus::Found;
+                return true;
+            }
+
+            // Touching clusters: a bounded direct search usually beats the abstract graph
+            const glm::ivec4 a = ClusterBounds(ClusterOf(request.start));
+            const glm::ivec4 b = ClusterBounds(ClusterOf(request.goal));
+            if (std::abs(a.x - b.x) <= CLUSTER_SIZE && std::abs(a.y - b.y) <= CLUSTER_SIZE)
+            {
+                const glm::ivec4 bounds(std::max(0, std::min(a.x, b.x) - CLUSTER_SIZE),
+                                        std::max(0, std::min(a.y, b.y) - CLUSTER_SIZE),
+                                        std::min(m_Width - 1, std::max(a.z, b.z) + CLUSTER_SIZE),
+                                        std::min(m_Height - 1, std::max(a.w, b.w) + CLUSTER_SIZE));
+                search.Begin(request.start, request.goal, bounds);
+                request.phase = Phase::Direct;
+            }
+            else
+            {
+                request.phase = Phase::Graph;
+            }
+            break;
+        }
+
+        case Phase::Direct:
+            switch (search.Step(budget))
+            {
+            case GridSearch::State::Running:
+                return false;
+            case GridSearch::State::Found:
+                search.AppendPath(request.path);
+                status = PathStatus::Found;
+                return true;
+            case GridSearch::State::Failed:
+                // The way round may leave the local window
+                request.phase = Phase::Graph;
+                break;
+            }
+            break;
+
+        case Phase::Graph:
+            if (!ProcessGraph(budget))
+                return false;
+            BeginAbstract(slot, request.start, request.goal, budget);
+            request.phase = Phase::Abstract;
+            break;
+
+        case Phase::Abstract:
+            switch (StepAbstract(slot, request.waypoints, budget))
+            {
+            case SearchState::Running:
+                return false;
+            case SearchState::Found:
+                request.phase = Phase::Refine;
+                break;
+            case SearchState::Failed:
+                status = PathStatus::NotFound;
+                return true;
+            }
+            break;
+
+        case Phase::Refine:
+        {
+            if (request.leg + 1 >= request.waypoints.size())
+            {
+                status = PathStatus::Found;
+                return true;
+            }
+
+            const glm::ivec2 from = request.waypoints[request.leg];
+            const glm::ivec2 to = request.waypoints[request.leg + 1];
+            if (!request.searching)
+            {
+                if (from == to)
+                {
+                    ++request.leg;
+                    break;
+                }
+                if (Manhattan(from, to) == 1)
+                {
+                    request.path.push_back(to);
+                    ++request.leg;
+                    break;
+                }
+                // Every multi-tile leg stays inside one cluster
+                search.Begin(from, to, ClusterBounds(ClusterOf(from)));
+                request.searching = true;
+            }
+
+            const GridSearch::State state = search.Step(budget);
+            if (state == GridSearch::State::Running)
+                return false;
+            request.searching = false;
+            if (state == GridSearch::State::Failed)
+            {
+                status = PathStatus::NotFound;
+                return true;
+            }
+            search.AppendPath(request.path);
+            ++request.leg;
+            break;
+        }
+        }
+    }
+    return false;
+}
+
+void Pathfinder::SyncNavigation()
+{
+    if (!m_Tilemap)
+        return;
+
+    const uint64_t version = m_Tilemap->GetNavigationVersion();
+    if (version == m_SeenVersion)
+        return;
+
+    const bool sameSize = m_Width == m_Tilemap->GetMapWidth() && m_Height == m_Tilemap->GetMapHeight();
+    if (!sameSize ||
+        !m_Tilemap->ForEachNavigationChangeSince(m_SeenVersion, [this](int x, int y) { InvalidateCell(x, y); }))
+    {
+        ResetGraph();
+    }
+    m_SeenVersion = version;
+}
+
+void Pathfinder::ResetGraph()
+{
+    m_Width = m_Tilemap ? m_Tilemap->GetMapWidth() : 0;
+    m_Height = m_Tilemap ? m_Tilemap->GetMapHeight() : 0;
+    m_ClustersX = (m_Width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    m_ClustersY = (m_Height + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+
+    const size_t clusterCount = static_cast<size_t>(m_ClustersX) * static_cast<size_t>(m_ClustersY);
+    m_Nodes.clear();
+    m_FreeNodes.clear();
+    m_Clusters.assign(clusterCount, Cluster{});
+    m_VerticalBorders.assign(clusterCount, Border{});
+    m_HorizontalBorders.assign(clusterCount, Border{});
+    m_DirtyBorders.clear();
+    m_StaleClusters.clear();
+
+    // Everything is rebuilt lazily by ProcessGraph() once a distant request needs it
+    for (int cy = 0; cy < m_ClustersY; ++cy)
+    {
+        for (int cx = 0; cx < m_ClustersX; ++cx)
+        {
+            const int index = cy * m_ClustersX + cx;
+            m_StaleClusters.push_back(index);
+            m_VerticalBorders[index].dirty = cx + 1 < m_ClustersX;
+            m_HorizontalBorders[index].dirty = cy + 1 < m_ClustersY;
+            if (m_VerticalBorders[index].dirty)
+                m_DirtyBorders.push_back(index * 2 + 1);
+            if (m_HorizontalBorders[index].dirty)
+                m_DirtyBorders.push_back(index * 2);
+        }
+    }
+}
+
+void Pathfinder::InvalidateCell(int x, int y)
+{
+    if (x < 0 || y < 0 || x >= m_Width || y >= m_Height)
+        return;
+
+    const int cx = x / CLUSTER_SIZE;
+    const int cy = y / CLUSTER_SIZE;
+    const int cluster = cy * m_ClustersX + cx;
+    MarkClusterStale(cluster);
+
+    // Only tiles on a cluster edge can open or close an entrance
+    const int lx = x - cx * CLUSTER_SIZE;
+    const int ly = y - cy * CLUSTER_SIZE;
+    if (lx == 0 && cx > 0)
+        MarkBorderDirty(true, cluster - 1);
+    if (lx == CLUSTER_SIZE - 1 && cx + 1 < m_ClustersX)
+        MarkBorderDirty(true, cluster);
+    if (ly == 0 && cy > 0)
+        MarkBorderDirty(false, cluster - m_ClustersX);
+    if (ly == CLUSTER_SIZE - 1 && cy + 1 < m_ClustersY)
+        MarkBorderDirty(false, cluster);
+}
+
+void Pathfinder::MarkBorderDirty(bool vertical, int index)
+{
+    Border &border = vertical ? m_VerticalBorders[index] : m_HorizontalBorders[index];
+    if (border.dirty)
+        return;
+    border.dirty = true;
+    m_DirtyBorders.push_back(index * 2 + (vertical ? 1 : 0));
+}
+
+void Pathfinder::MarkClusterStale(int cluster)
+{
+    if (m_Clusters[cluster].stale)
+        return;
+    m_Clusters[cluster].stale = true;
+    m_StaleClusters.push_back(cluster);
+}
+
+int Pathfinder::AllocateNode(glm::ivec2 cell)
+{
+    int node;
+    if (!m_FreeNodes.empty())
+    {
+        node = m_FreeNodes.back();
+        m_FreeNodes.pop_back();
+    }
+    else
+    {
+        node = static_cast<int>(m_Nodes.size());
+        m_Nodes.emplace_back();
+    }
+
+    AbstractNode &entry = m_Nodes[node];
+    entry.cell = cell;
+    entry.cluster = ClusterOf(cell);
+    entry.partner = -1;
+    entry.edges.clear();
+    m_Clusters[entry.cluster].nodes.push_back(node);
+    return node;
+}
+
+void Pathfinder::FreeNode(int node)
+{
+    AbstractNode &entry = m_Nodes[node];
+    std::erase(m_Clusters[entry.cluster].nodes, node);
+    entry.cluster = -1;
+    entry.partner = -1;
+    entry.edges.clear();
+    m_FreeNodes.push_back(node);
+}
+
+void Pathfinder::RebuildBorder(bool vertical, int index, int &budget)
+{
+    Border &border = vertical ? m_VerticalBorders[index] : m_HorizontalBorders[index];
+    border.dirty = false;
+    for (int node : border.nodes)
+        FreeNode(node);
+    border.nodes.clear();
+
+    const int cx = index % m_ClustersX;
+    const int cy = index / m_ClustersX;
+    const int length = vertical ? std::min(CLUSTER_SIZE, m_Height - cy * CLUSTER_SIZE)
+                                : std::min(CLUSTER_SIZE, m_Width - cx * CLUSTER_SIZE);
+
+    // Tile i along the border on our side; the far side is one step right or down
+    auto inner = [&](int i)
+    {
+        return vertical ? glm::ivec2((cx + 1) * CLUSTER_SIZE - 1, cy * CLUSTER_SIZE + i)
+                        : glm::ivec2(cx * CLUSTER_SIZE + i, (cy + 1) * CLUSTER_SIZE - 1);
+    };
+    const glm::ivec2 across = vertical ? glm::ivec2(1, 0) : glm::ivec2(0, 1);
+
+    auto addEntrance = [&](int i)
+    {
+        const int nearNode = AllocateNode(inner(i));
+        const int farNode = AllocateNode(inner(i) + across);
+        m_Nodes[nearNode].partner = farNode;
+        m_Nodes[farNode].partner = nearNode;
+        border.nodes.push_back(nearNode);
+        border.nodes.push_back(farNode);
+    };
+
+    int runStart = -1;
+    for (int i = 0; i <= length; ++i)
+    {
+        bool open = false;
+        if (i < length)
+        {
+            const glm::ivec2 a = inner(i);
+            open = IsWalkable(a.x, a.y) && IsWalkable(a.x + across.x, a.y + across.y);
+        }
+
+        if (open && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if (!open && runStart >= 0)
+        {
+            const int runEnd = i - 1;
+            if (runEnd - runStart + 1 >= LONG_ENTRANCE)
+            {
+                addEntrance(runStart);
+                addEntrance(runEnd);
+            }
+            else
+            {
+                addEntrance((runStart + runEnd) / 2);
+            }
+            runStart = -1;
+        }
+    }
+    budget -= 2 * length;
+
+    MarkClusterStale(index);
+    MarkClusterStale(vertical ? index + 1 : index + m_ClustersX);
+}
+
+void Pathfinder::RebuildClusterEdges(int cluster, int &budget)
+{
+    Cluster &entry = m_Clusters[cluster];
+    entry.stale = false;
+    for (int node : entry.nodes)
+        m_Nodes[node].edges.clear();
+
+    // One flood per entrance gives its distance to every later entrance
+    for (size_t i = 0; i < entry.nodes.size(); ++i)
+    {
+        const int from = entry.nodes[i];
+        FloodCluster(m_Nodes[from].cell, budget);
+        for (size_t j = i + 1; j < entry.nodes.size(); ++j)
+        {
+            const int to = entry.nodes[j];
+            const int distance = FloodDistance(cluster, m_Nodes[to].cell);
+            if (distance < 0)
+                continue;
+            m_Nodes[from].edges.push_back({to, distance});
+            m_Nodes[to].edges.push_back({from, distance});
+        }
+    }
+}
+
+bool Pathfinder::ProcessGraph(int &budget)
+{
+    while (!m_DirtyBorders.empty())
+    {
+        if (budget <= 0)
+            return false;
+        const int code = m_DirtyBorders.back();
+        m_DirtyBorders.pop_back();
+        const bool vertical = (code & 1) != 0;
+        const int index = code / 2;
+        if ((vertical ? m_VerticalBorders[index] : m_HorizontalBorders[index]).dirty)
+            RebuildBorder(vertical, index, budget);
+    }
+
+    while (!m_StaleClusters.empty())
+    {
+        if (budget <= 0)
+            return false;
+        const int cluster = m_StaleClusters.back();
+        m_StaleClusters.pop_back();
+        if (m_Clusters[cluster].stale)
+            RebuildClusterEdges(cluster, budget);
+    }
+    return true;
+}
+
+int Pathfinder::ClusterOf(glm::ivec2 cell) const
+{
+    return (cell.y / CLUSTER_SIZE) * m_ClustersX + cell.x / CLUSTER_SIZE;
+}
+
+glm::ivec4 Pathfinder::ClusterBounds(int cluster) const
+{
+    const int x0 = (cluster % m_ClustersX) * CLUSTER_SIZE;
+    const int y0 = (cluster / m_ClustersX) * CLUSTER_SIZE;
+    return {x0, y0, std::min(x0 + CLUSTER_SIZE, m_Width) - 1, std::min(y0 + CLUSTER_SIZE, m_Height) - 1};
+}
+
+int Pathfinder::FloodCluster(glm::ivec2 from, int &budget)
+{
+    const int cluster = ClusterOf(from);
+    const glm::ivec4 bounds = ClusterBounds(cluster);
+    auto local = [&](int x, int y) { return (y - bounds.y) * CLUSTER_SIZE + (x - bounds.x); };
+
+    std::fill(m_ClusterDistance.begin(), m_ClusterDistance.end(), -1);
+    m_ClusterQueue.clear();
+    if (!IsWalkable(from.x, from.y))
+        return cluster;
+
+    m_ClusterDistance[local(from.x, from.y)] = 0;
+    m_ClusterQueue.push_back(local(from.x, from.y));
+    for (size_t head = 0; head < m_ClusterQueue.size(); ++head)
+    {
+        const int cell = m_ClusterQueue[head];
+        const int x = bounds.x + cell % CLUSTER_SIZE;
+        const int y = bounds.y + cell / CLUSTER_SIZE;
+        for (const glm::ivec2 &step : DIR_STEP)
+        {
+            const int nx = x + step.x;
+            const int ny = y + step.y;
+            if (nx < bounds.x || ny < bounds.y || nx > bounds.z || ny > bounds.w || !IsWalkable(nx, ny))
+                continue;
+            int &distance = m_ClusterDistance[local(nx, ny)];
+            if (distance >= 0)
+                continue;
+            distance = m_ClusterDistance[cell] + 1;
+            m_ClusterQueue.push_back(local(nx, ny));
+        }
+    }
+    budget -= static_cast<int>(m_ClusterQueue.size());
+    return cluster;
+}
+
+int Pathfinder::FloodDistance(int cluster, glm::ivec2 cell) const
+{
+    const glm::ivec4 bounds = ClusterBounds(cluster);
+    if (cell.x < bounds.x || cell.y < bounds.y || cell.x > bounds.z || cell.y > bounds.w)
+        return -1;
+    return m_ClusterDistance[(cell.y - bounds.y) * CLUSTER_SIZE + (cell.x - bounds.x)];
+}
+
+void Pathfinder::BeginAbstract(SearchSlot &slot, glm::ivec2 start, glm::ivec2 goal, int &budget)
+{
+    const int nodeCount = static_cast<int>(m_Nodes.size());
+    const int startNode = nodeCount;
+    const int goalNode = nodeCount + 1;
+    slot.start = start;
+    slot.goal = goal;
+
+    // Temporary start and goal nodes hook into the entrances of their clusters
+    const int startCluster = FloodCluster(start, budget);
+    slot.startEdges.clear();
+    for (int node : m_Clusters[startCluster].nodes)
+    {
+        const int distance = FloodDistance(startCluster, m_Nodes[node].cell);
+        if (distance >= 0)
+            slot.startEdges.push_back({node, distance});
+    }
+    const int direct = FloodDistance(startCluster, goal);
+    if (direct >= 0)
+        slot.startEdges.push_back({goalNode, direct});
+
+    const int goalCluster = FloodCluster(goal, budget);
+    slot.goalCost.assign(nodeCount, -1);
+    bool goalLinked = direct >= 0;
+    for (int node : m_Clusters[goalCluster].nodes)
+    {
+        slot.goalCost[node] = FloodDistance(goalCluster, m_Nodes[node].cell);
+        goalLinked |= slot.goalCost[node] >= 0;
+    }
+
+    slot.g.assign(nodeCount + 2, INT_MAX);
+    slot.parent.assign(nodeCount + 2, -1);
+    slot.open.clear();
+
+    // A start or goal sealed inside its cluster cannot be reached; skip the search
+    if (slot.startEdges.empty() || !goalLinked)
+        return;
+    slot.g[startNode] = 0;
+    slot.open.push_back({Manhattan(start, goal), 0, startNode});
+}
+
+Pathfinder::SearchState Pathfinder::StepAbstract(SearchSlot &slot, std::vector<glm::ivec2> &waypoints, int &budget)
+{
+    const int startNode = static_cast<int>(m_Nodes.size());
+    const int goalNode = startNode + 1;
+    auto cellOf = [&](int node)
+    {
+        return node == startNode ? slot.start : node == goalNode ? slot.goal : m_Nodes[node].cell;
+    };
+    auto relax = [&](int from, int to, int cost)
+    {
+        const int g = slot.g[from] + cost;
+        if (g >= slot.g[to])
+            return;
+        slot.g[to] = g;
+        slot.parent[to] = from;
+        slot.open.push_back({g + Manhattan(cellOf(to), slot.goal), g, to});
+        std::push_heap(slot.open.begin(), slot.open.end(), std::greater<>{});
+    };
+
+    while (budget > 0 && !slot.open.empty())
+    {
+        std::pop_heap(slot.open.begin(), slot.open.end(), std::greater<>{});
+        const HeapEntry entry = slot.open.back();
+        slot.open.pop_back();
+        if (entry.g != slot.g[entry.node])
+            continue;
+
+        if (entry.node == goalNode)
+        {
+            waypoints.clear();
+            for (int node = goalNode; node >= 0; node = slot.parent[node])
+                waypoints.push_back(cellOf(node));
+            std::reverse(waypoints.begin(), waypoints.end());
+            return SearchState::Found;
+        }
+
+        if (entry.node == startNode)
+        {
+            for (const AbstractEdge &edge : slot.startEdges)
+                relax(startNode, edge.to, edge.cost);
+            budget -= static_cast<int>(slot.startEdges.size()) + 1;
+            continue;
+        }
+
+        const AbstractNode &node = m_Nodes[entry.node];
+        if (node.partner >= 0)
+            relax(entry.node, node.partner, 1);
+        for (const AbstractEdge &edge : node.edges)
+            relax(entry.node, edge.to, edge.cost);
+        if (slot.goalCost[entry.node] >= 0)
+            relax(entry.node, goalNode, slot.goalCost[entry.node]);
+        budget -= static_cast<int>(node.edges.size()) + 1;
+    }
+    return slot.open.empty() ? SearchState::Failed : SearchState::Running;
+}
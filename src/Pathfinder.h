@@ -0,0 +1,282 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Tilemap;
+
+/**
+ * @class Pathfinder
+ * @brief Goal-directed NPC paths over the navigation grid, computed under a per-frame budget.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * A tile is walkable when its navigation flag is set and it has no
+ * collision, the same rule PatrolRoute applies. Paths are 4-connected, so
+ * NPCs can follow them with their usual tile-to-tile stepping.
+ *
+ * @par Search
+ * Nearby goals (start and goal clusters touching) are found with jump point
+ * search restricted to the clusters around them. Jump point search only
+ * pushes the tiles where an optimal path can turn, so open corridors cost a
+ * scan instead of one heap operation per tile. Paths scan horizontally
+ * first and branch vertically, which is the canonical order for 4-connected
+ * grids.
+ *
+ * Distant goals go through an HPA*-style abstract graph: the map is split
+ * into CLUSTER_SIZE x CLUSTER_SIZE clusters whose shared borders carry
+ * entrance nodes, and entrances of the same cluster are linked by their
+ * walking distance. The abstract path is refined leg by leg with jump point
+ * search restricted to one cluster.
+ *
+ * @par Invalidation
+ * Every Update() reads Tilemap::ForEachNavigationChangeSince(). A changed
+ * tile marks its own cluster's internal edges stale and, if it lies on a
+ * cluster edge, the entrances of that border. Only those parts are rebuilt,
+ * lazily and inside the frame budget. Loads and resizes rebuild everything.
+ * A request in flight while the map changes starts over.
+ *
+ * @par Budget
+ * Update() works through queued requests in order until it has scanned
+ * about @p budget tiles, then returns; the active search resumes on the
+ * next call. A hundred NPCs asking at once are spread over several frames
+ * rather than stalling one.
+ *
+ * @par Example
+ * @code{.cpp}
+ * Pathfinder::RequestId id = pathfinder.RequestPath(npcTile, playerTile);
+ * // every frame
+ * pathfinder.Update();
+ * std::vector<glm::ivec2> path;
+ * if (pathfinder.TakePath(id, path))
+ *     npc.FollowPath(std::move(path));
+ * @endcode
+ *
+ * @par Thread Safety
+ * Not thread-safe. Call from the thread that edits the tilemap.
+ *
+ * @see NavigationMap, PatrolRoute, NonPlayerCharacter::FollowPath()
+ */
+class Pathfinder
+{
+public:
+    /// @brief Handle of an asynchronous request; 0 is never issued.
+    using RequestId = std::uint32_t;
+
+    /// @brief State of a request as seen by GetStatus().
+    enum class PathStatus
+    {
+        Unknown,  ///< Never issued, cancelled, taken or expired
+        Pending,  ///< Queued or being searched
+        Found,    ///< Path ready for TakePath()
+        NotFound  ///< Goal unreachable (or start/goal not walkable)
+    };
+
+    /// @brief Cluster edge length in tiles.
+    static constexpr int CLUSTER_SIZE = 16;
+
+    /// @brief Default tiles scanned per Update().
+    static constexpr int DEFAULT_FRAME_BUDGET = 8192;
+
+    /// @brief Update() calls a finished result is kept before it is dropped.
+    static constexpr std::uint32_t RESULT_LIFETIME = 600;
+
+    Pathfinder();
+    ~Pathfinder();
+
+    Pathfinder(const Pathfinder &) = delete;
+    Pathfinder &operator=(const Pathfinder &) = delete;
+
+    /**
+     * @brief Attach the tilemap to search; drops all requests and cached graph data.
+     * @param tilemap Map to path on (may be nullptr). Must outlive the Pathfinder.
+     */
+    void SetTilemap(const Tilemap *tilemap);
+
+    /**
+     * @brief Compute a path immediately, ignoring the frame budget.
+     *
+     * @param start Start tile.
+     * @param goal  Goal tile.
+     * @param path  Receives the tiles to step through, excluding @p start and
+     *              ending at @p goal (empty if start == goal).
+     * @return `false` if no path exists.
+     */
+    bool FindPath(glm::ivec2 start, glm::ivec2 goal, std::vector<glm::ivec2> &path);
+
+    /**
+     * @brief Queue a path request; it is searched during later Update() calls.
+     * @return Handle for GetStatus() / TakePath() / Cancel().
+     */
+    RequestId RequestPath(glm::ivec2 start, glm::ivec2 goal);
+
+    /// @brief Drop a queued request or an untaken result.
+    void Cancel(RequestId id);
+
+    /// @brief Current state of @p id.
+    [[nodiscard]] PathStatus GetStatus(RequestId id) const;
+
+    /**
+     * @brief Move a finished path out (same format as FindPath()).
+     * @return `true` if @p id finished with PathStatus::Found. Found and
+     *         NotFound results are both released by this call.
+     */
+    bool TakePath(RequestId id, std::vector<glm::ivec2> &path);
+
+    /**
+     * @brief Pick up tilemap edits and advance queued requests.
+     * @param budget Approximate number of tiles to scan this call.
+     */
+    void Update(int budget = DEFAULT_FRAME_BUDGET);
+
+    /// @brief Requests queued or in flight.
+    [[nodiscard]] std::size_t GetPendingCount() const { return m_Queue.size(); }
+
+    /// @brief `true` if NPCs may stand on tile (@p x, @p y).
+    [[nodiscard]] bool IsWalkable(int x, int y) const;
+
+private:
+    class GridSearch;
+
+    enum class Phase : std::uint8_t
+    {
+        Begin,
+        Direct,   ///< Jump point search around start and goal
+        Graph,    ///< Waiting for dirty clusters to be rebuilt
+        Abstract, ///< A* over the cluster graph
+        Refine    ///< Jump point search per abstract leg
+    };
+
+    enum class SearchState : std::uint8_t
+    {
+        Running,
+        Found,
+        Failed
+    };
+
+    struct Request
+    {
+        RequestId id = 0;
+        glm::ivec2 start{0};
+        glm::ivec2 goal{0};
+        std::uint64_t version = 0;            ///< Navigation version the work is based on
+        Phase phase = Phase::Begin;
+        std::vector<glm::ivec2> waypoints;    ///< Abstract path, start to goal
+        std::size_t leg = 0;                  ///< Next waypoint pair to refine
+        bool searching = false;               ///< GridSearch holds the current leg
+        std::vector<glm::ivec2> path;
+    };
+
+    struct Result
+    {
+        PathStatus status = PathStatus::NotFound;
+        std::vector<glm::ivec2> path;
+        std::uint32_t expiresAt = 0;
+    };
+
+    struct AbstractEdge
+    {
+        int to;    ///< Node index
+        int cost;  ///< Walking distance in tiles
+    };
+
+    struct AbstractNode
+    {
+        glm::ivec2 cell{0};
+        int cluster = -1;
+        int partner = -1;                ///< Matching node across the border (cost 1)
+        std::vector<AbstractEdge> edges; ///< Same-cluster nodes reachable inside the cluster
+    };
+
+    struct Border
+    {
+        std::vector<int> nodes;  ///< Nodes on both sides of this border
+        bool dirty = true;
+    };
+
+    struct Cluster
+    {
+        std::vector<int> nodes;
+        bool stale = true;  ///< Node edges need recomputing
+    };
+
+    struct HeapEntry
+    {
+        int f;
+        int g;
+        int node;
+
+        /// Heap order for std::greater: lowest f first, deeper node on ties
+        bool operator>(const HeapEntry &other) const { return f > other.f || (f == other.f && g < other.g); }
+    };
+
+    /// Scratch of one search in progress; queued requests and FindPath() each own one
+    struct SearchSlot
+    {
+        std::unique_ptr<GridSearch> grid;
+        std::vector<int> g;                    ///< Abstract cost per node, then start and goal
+        std::vector<int> parent;
+        std::vector<int> goalCost;             ///< Node to goal inside the goal cluster, -1 if none
+        std::vector<AbstractEdge> startEdges;  ///< Start to nodes of its cluster (and to the goal)
+        std::vector<HeapEntry> open;
+        glm::ivec2 start{0};
+        glm::ivec2 goal{0};
+    };
+
+    /// @name Graph Maintenance
+    /// @{
+    void SyncNavigation();
+    void ResetGraph();
+    void InvalidateCell(int x, int y);
+    void MarkBorderDirty(bool vertical, int index);
+    void MarkClusterStale(int cluster);
+    void RebuildBorder(bool vertical, int index, int &budget);
+    void RebuildClusterEdges(int cluster, int &budget);
+    bool ProcessGraph(int &budget);
+    int AllocateNode(glm::ivec2 cell);
+    void FreeNode(int node);
+    /// @}
+
+    /// @name Queries
+    /// @{
+    [[nodiscard]] int ClusterOf(glm::ivec2 cell) const;
+    [[nodiscard]] glm::ivec4 ClusterBounds(int cluster) const;
+    int FloodCluster(glm::ivec2 from, int &budget);
+    [[nodiscard]] int FloodDistance(int cluster, glm::ivec2 cell) const;
+    void BeginAbstract(SearchSlot &slot, glm::ivec2 start, glm::ivec2 goal, int &budget);
+    SearchState StepAbstract(SearchSlot &slot, std::vector<glm::ivec2> &waypoints, int &budget);
+    bool StepRequest(Request &request, SearchSlot &slot, int &budget, PathStatus &status);
+    /// @}
+
+    const Tilemap *m_Tilemap = nullptr;
+    int m_Width = 0;
+    int m_Height = 0;
+    int m_ClustersX = 0;
+    int m_ClustersY = 0;
+    std::uint64_t m_SeenVersion = 0;
+
+    std::vector<AbstractNode> m_Nodes;
+    std::vector<int> m_FreeNodes;
+    std::vector<Cluster> m_Clusters;
+    std::vector<Border> m_VerticalBorders;    ///< Between cluster i and i + 1 (index of the left cluster)
+    std::vector<Border> m_HorizontalBorders;  ///< Between cluster i and the one below (index of the upper cluster)
+    std::vector<int> m_DirtyBorders;          ///< Encoded as index * 2 + vertical
+    std::vector<int> m_StaleClusters;
+
+    /// Cluster-local BFS scratch: distance per cell, -1 = unreached
+    std::vector<int> m_ClusterDistance;
+    std::vector<int> m_ClusterQueue;
+
+    SearchSlot m_AsyncSlot;
+    SearchSlot m_SyncSlot;
+    std::deque<Request> m_Queue;
+    std::unordered_map<RequestId, Result> m_Results;
+    RequestId m_NextId = 1;
+    std::uint32_t m_UpdateCount = 0;
+};
@@ -3,6 +3,84 @@
 
 #include <iostream>
 #include <algorithm>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+// The 4 cardinal directions. The order matters for determinism: if we always
+// check Right, Left, Down, Up in that order, then the same map will always
+// produce the same patrol route.
+constexpr int DIR_X[] = {1, -1, 0, 0};
+constexpr int DIR_Y[] = {0, 0, 1, -1};
+
+/// Everything a generated route depends on.
+struct RouteKey
+{
+    const Tilemap *tilemap;
+    int tileX;
+    int tileY;
+    int maxLength;
+    std::uint64_t navigationVersion;
+
+    bool operator==(const RouteKey &) const = default;
+};
+
+struct RouteKeyHash
+{
+    size_t operator()(const RouteKey &key) const
+    {
+        size_t h = std::hash<const Tilemap *>{}(key.tilemap);
+        auto mix = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2); };
+        mix(static_cast<size_t>(static_cast<unsigned>(key.tileX)));
+        mix(static_cast<size_t>(static_cast<unsigned>(key.tileY)));
+        mix(static_cast<size_t>(static_cast<unsigned>(key.maxLength)));
+        mix(static_cast<size_t>(key.navigationVersion));
+        return h;
+    }
+};
+
+/**
+ * Per-thread buffers reused by every route generation.
+ *
+ * Instead of clearing a visited array for each pass, tiles are stamped with
+ * a generation number: a tile is "marked" in a pass when its stamp equals
+ * that pass's value. Each Generate() takes a fresh block of PASS_COUNT
+ * values, so nothing is cleared between calls.
+ */
+struct RouteScratch
+{
+    static constexpr std::uint32_t PASS_COUNT = 4;
+
+    std::vector<std::uint32_t> stamp;  ///< Per-tile generation stamp
+    std::uint32_t generation = 0;      ///< Last value handed out
+    std::vector<glm::ivec2> tiles;     ///< BFS queue; the first entries are the connected set
+
+    struct Frame
+    {
+        glm::ivec2 tile;
+        int nextDir;  ///< Next direction to try (index into DIR_X/DIR_Y)
+    };
+    std::vector<Frame> stack;          ///< Explicit DFS stack
+
+    /// Start a generation over @p tileCount tiles; returns the first of PASS_COUNT fresh stamp values.
+    std::uint32_t Begin(size_t tileCount)
+    {
+        if (stamp.size() != tileCount || generation > std::numeric_limits<std::uint32_t>::max() - PASS_COUNT)
+        {
+            stamp.assign(tileCount, 0);
+            generation = 0;
+        }
+        std::uint32_t base = generation + 1;
+        generation += PASS_COUNT;
+        return base;
+    }
+};
+
+thread_local RouteScratch t_RouteScratch;
+}  // namespace
 
 bool PatrolRoute::Initialize(int startTileX, int startTileY, const Tilemap *tilemap, int maxRouteLength)
 {
@@ -12,6 +90,10 @@ bool PatrolRoute::Initialize(int startTileX, int startTileY, const Tilemap *tile
         return false;
     }
 
+    m_Route.reset();
+    m_CurrentWaypointIndex = 0;
+    m_PingPongForward = true;
+
     if (!IsValidTile(startTileX, startTileY, tilemap))
     {
         std::cerr << "PatrolRoute::Initialize: Starting tile (" << startTileX << ", " << startTileY
@@ -19,45 +101,128 @@ bool PatrolRoute::Initialize(int startTileX, int startTileY, const Tilemap *tile
         return false;
     }
 
-    m_Waypoints.clear();
-    m_CurrentWaypointIndex = 0;
-    m_PingPongForward = true;
-    m_IsClosed = false;
+    // Routes depend only on walkability, so NPCs placed on the same tile of the
+    // same map revision get the same route. Share it instead of regenerating.
+    // The cache holds weak references: a route disappears with its last user.
+    static std::mutex s_CacheMutex;
+    static std::unordered_map<RouteKey, std::weak_ptr<const RouteData>, RouteKeyHash> s_Cache;
+
+    const RouteKey key{tilemap, startTileX, startTileY, maxRouteLength, tilemap->GetNavigationVersion()};
+    {
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        auto it = s_Cache.find(key);
+        if (it != s_Cache.end())
+        {
+            m_Route = it->second.lock();
+            if (m_Route)
+            {
+                return true;
+            }
+        }
+    }
+
+    // Generate outside the lock so NPCs initializing on several threads don't serialize
+    auto route = std::make_shared<RouteData>();
+    Generate(glm::ivec2(startTileX, startTileY), tilemap, static_cast<size_t>(maxRouteLength), *route);
 
-    int mapWidth = tilemap->GetMapWidth();
-    int mapHeight = tilemap->GetMapHeight();
+    if (route->waypoints.size() < 2)
+    {
+        std::cerr << "PatrolRoute::Initialize: Route too short (" << route->waypoints.size()
+                  << " waypoints)" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_CacheMutex);
+        std::weak_ptr<const RouteData> &slot = s_Cache[key];
+        if (auto existing = slot.lock())
+        {
+            // Another thread finished the same route first
+            m_Route = std::move(existing);
+            return true;
+        }
+        slot = route;
+
+        // Drop routes nobody uses any more and routes of older map revisions
+        std::erase_if(s_Cache, [&key](const auto &entry)
+        {
+            return entry.second.expired() ||
+                   (entry.first.tilemap == key.tilemap && entry.first.navigationVersion != key.navigationVersion);
+        });
+    }
+    m_Route = route;
+
+    // Count unique tiles for the log message. Due to backtracking in DFS mode,
+    // the waypoint list may contain the same tile multiple times.
+    RouteScratch &scratch = t_RouteScratch;
+    const int mapWidth = tilemap->GetMapWidth();
+    const std::uint32_t seen = scratch.Begin(static_cast<size_t>(mapWidth) * tilemap->GetMapHeight());
+    size_t uniqueTiles = 0;
+    for (const auto &wp : m_Route->waypoints)
+    {
+        std::uint32_t &s = scratch.stamp[wp.y * mapWidth + wp.x];
+        if (s != seen)
+        {
+            s = seen;
+            ++uniqueTiles;
+        }
+    }
+
+    std::cout << "Created patrol route: " << m_Route->waypoints.size() << " waypoints, "
+              << uniqueTiles << " unique tiles, mode="
+              << (m_Route->closed ? "loop" : "ping-pong")
+              << ", start=(" << startTileX << ", " << startTileY << ")" << std::endl;
+
+    return true;
+}
+
+void PatrolRoute::Generate(glm::ivec2 start, const Tilemap *tilemap, size_t maxLength, RouteData &route)
+{
+    const int mapWidth = tilemap->GetMapWidth();
+    const int mapHeight = tilemap->GetMapHeight();
+
+    RouteScratch &scratch = t_RouteScratch;
+    const std::uint32_t base = scratch.Begin(static_cast<size_t>(mapWidth) * mapHeight);
+    const std::uint32_t queued = base;       // Reached by the BFS
+    const std::uint32_t inSet = base + 1;    // Part of the connected set
+    const std::uint32_t walked = base + 2;   // Visited by the cycle walk or the DFS
+    std::vector<std::uint32_t> &stamp = scratch.stamp;
+
+    auto indexOf = [mapWidth](glm::ivec2 t) { return t.y * mapWidth + t.x; };
+    auto inBounds = [mapWidth, mapHeight](int x, int y) { return x >= 0 && y >= 0 && x < mapWidth && y < mapHeight; };
 
     // Use breadth-first search to collect all walkable tiles reachable from the start.
     // BFS explores in expanding rings outward, so tiles closer to start are found first.
     // This means if we hit maxRouteLength, we get a compact cluster around the start
     // rather than a long tendril in one random direction.
-    std::vector<glm::ivec2> connectedTiles;
-    std::vector<bool> visited(mapWidth * mapHeight, false);
-    std::vector<glm::ivec2> bfsQueue;
-
-    glm::ivec2 start(startTileX, startTileY);
-    bfsQueue.push_back(start);
-    visited[startTileY * mapWidth + startTileX] = true;
-
-    while (!bfsQueue.empty() && connectedTiles.size() < static_cast<size_t>(maxRouteLength))
+    //
+    // scratch.tiles doubles as the FIFO queue: entries before `head` have been
+    // popped and form the connected set, entries after it are still queued.
+    std::vector<glm::ivec2> &tiles = scratch.tiles;
+    tiles.clear();
+    tiles.push_back(start);
+    stamp[indexOf(start)] = queued;
+
+    size_t head = 0;
+    while (head < tiles.size() && head < maxLength)
     {
-        // Pop from front (FIFO) - this is what makes it BFS instead of DFS.
-        // If we popped from back, closer tiles would be processed last.
-        glm::ivec2 current = bfsQueue.front();
-        bfsQueue.erase(bfsQueue.begin());
-        connectedTiles.push_back(current);
-
-        auto neighbors = GetValidNeighbors(current.x, current.y, tilemap);
-        for (const auto &neighbor : neighbors)
+        const glm::ivec2 current = tiles[head++];
+        for (int d = 0; d < 4; ++d)
         {
-            int idx = neighbor.y * mapWidth + neighbor.x;
-            if (!visited[idx])
+            const int nx = current.x + DIR_X[d];
+            const int ny = current.y + DIR_Y[d];
+            if (IsValidTile(nx, ny, tilemap) && stamp[ny * mapWidth + nx] != queued)
             {
-                visited[idx] = true;
-                bfsQueue.push_back(neighbor);
+                stamp[ny * mapWidth + nx] = queued;
+                tiles.emplace_back(nx, ny);
             }
         }
     }
+    const size_t connectedCount = head;
+    for (size_t i = 0; i < connectedCount; ++i)
+    {
+        stamp[indexOf(tiles[i])] = inSet;
+    }
 
     // Detect if the connected tiles form a simple cycle (ring shape).
     // A simple cycle has a special property: every tile has exactly 2 neighbors
@@ -71,69 +236,56 @@ bool PatrolRoute::Initialize(int startTileX, int startTileY, const Tilemap *tile
     //
     // In the cycle, A connects to B and D, B connects to A and C, etc.
     // In the non-cycle, B connects to A and C, but A only connects to B.
-    bool isSimpleCycle = connectedTiles.size() >= 3;
-    if (isSimpleCycle)
+    // Set membership is a stamp lookup, so the test is linear in the set size.
+    bool isSimpleCycle = connectedCount >= 3;
+    for (size_t i = 0; isSimpleCycle && i < connectedCount; ++i)
     {
-        for (const auto &tile : connectedTiles)
+        const glm::ivec2 tile = tiles[i];
+        int neighborCount = 0;
+        for (int d = 0; d < 4; ++d)
         {
-            int neighborCount = 0;
-            auto neighbors = GetValidNeighbors(tile.x, tile.y, tilemap);
-            for (const auto &neighbor : neighbors)
+            const int nx = tile.x + DIR_X[d];
+            const int ny = tile.y + DIR_Y[d];
+            if (inBounds(nx, ny) && stamp[ny * mapWidth + nx] == inSet)
             {
-                // Check if this neighbor is part of our collected set.
-                // We do a linear search here because the set is small (maxRouteLength).
-                for (const auto &ct : connectedTiles)
-                {
-                    if (ct == neighbor)
-                    {
-                        neighborCount++;
-                        break;
-                    }
-                }
+                neighborCount++;
             }
+        }
 
-            // Any tile with != 2 neighbors in the set breaks the cycle property.
-            // A tile with 1 neighbor is a dead end. A tile with 3+ is a junction.
-            if (neighborCount != 2)
-            {
-                isSimpleCycle = false;
-                break;
-            }
+        // Any tile with != 2 neighbors in the set breaks the cycle property.
+        // A tile with 1 neighbor is a dead end. A tile with 3+ is a junction.
+        if (neighborCount != 2)
+        {
+            isSimpleCycle = false;
         }
     }
 
+    std::vector<glm::ivec2> &path = route.waypoints;
+    path.clear();
+
     if (isSimpleCycle)
     {
         // For a cycle, we walk around the ring by always picking the unvisited neighbor.
         // Since each tile has exactly 2 neighbors in the set, and we mark tiles visited
         // as we go, there's always exactly one valid choice (until we complete the loop).
-        std::vector<bool> cycleVisited(mapWidth * mapHeight, false);
+        // Visiting re-stamps a tile from inSet to walked, so "in set and unvisited"
+        // is a single comparison.
+        path.reserve(connectedCount);
         glm::ivec2 current = start;
-        glm::ivec2 prev(-1, -1);
-
-        while (m_Waypoints.size() < connectedTiles.size())
+        while (path.size() < connectedCount)
         {
-            m_Waypoints.push_back(current);
-            cycleVisited[current.y * mapWidth + current.x] = true;
+            path.push_back(current);
+            stamp[indexOf(current)] = walked;
 
             // Find the next tile: must be in our set and not yet visited.
-            auto neighbors = GetValidNeighbors(current.x, current.y, tilemap);
             glm::ivec2 next(-1, -1);
-            for (const auto &neighbor : neighbors)
+            for (int d = 0; d < 4; ++d)
             {
-                bool inSet = false;
-                for (const auto &ct : connectedTiles)
-                {
-                    if (ct == neighbor)
-                    {
-                        inSet = true;
-                        break;
-                    }
-                }
-
-                if (inSet && !cycleVisited[neighbor.y * mapWidth + neighbor.x])
+                const int nx = current.x + DIR_X[d];
+                const int ny = current.y + DIR_Y[d];
+                if (inBounds(nx, ny) && stamp[ny * mapWidth + nx] == inSet)
                 {
-                    next = neighbor;
+                    next = glm::ivec2(nx, ny);
                     break;
                 }
             }
@@ -142,132 +294,101 @@ bool PatrolRoute::Initialize(int startTileX, int startTileY, const Tilemap *tile
             {
                 break;
             }
-
-            prev = current;
             current = next;
         }
 
         // Closed loop means NPC walks: 0 -> 1 -> 2 -> ... -> N-1 -> 0 -> 1 -> ...
-        m_IsClosed = true;
-    }
-    else
-    {
-        // Not a cycle, so use depth-first search with backtracking.
-        // DFS explores as deep as possible before backtracking, which produces
-        // a path that visits all tiles but includes "return trips" back through
-        // already-visited tiles. This makes the path contiguous (no teleporting).
-        std::fill(visited.begin(), visited.end(), false);
-        DFSTraversal(start, visited, m_Waypoints, tilemap, static_cast<size_t>(maxRouteLength));
-
-        // Even non-cycles might loop back if the last tile is next to the first.
-        if (m_Waypoints.size() >= 2)
-        {
-            const glm::ivec2 &first = m_Waypoints.front();
-            const glm::ivec2 &last = m_Waypoints.back();
-            m_IsClosed = AreAdjacent(last, first) || (last == first);
-        }
+        route.closed = true;
+        return;
     }
 
-    if (m_Waypoints.size() < 2)
+    // Not a cycle, so use depth-first search with backtracking.
+    // DFS explores as deep as possible before backtracking, which produces
+    // a path that visits all tiles but includes "return trips" back through
+    // already-visited tiles. This makes the path contiguous (no teleporting).
+    //
+    // The traversal runs on an explicit stack so large open areas can't
+    // overflow the call stack. Each frame remembers which direction it tries
+    // next, which reproduces the recursive visiting order exactly.
+    //
+    // When a child branch is finished we "backtrack" by adding the parent tile
+    // again. This is the key trick: it means the NPC path goes
+    // A -> B -> C -> B -> D -> B -> A instead of A -> B -> C, D.
+    // Without this, the path would have discontinuities (teleporting).
+    //
+    // Example on a T-shaped map:
+    //       A
+    //       |
+    //   C - B - D
+    //
+    // DFS visits: A, then B, then C (dead end, backtrack to B),
+    // then D (dead end, backtrack to B), then back to A.
+    // Path produced: [A, B, C, B, D, B, A]
+    std::vector<RouteScratch::Frame> &stack = scratch.stack;
+    stack.clear();
+    if (maxLength > 0)
     {
-        std::cerr << "PatrolRoute::Initialize: Route too short (" << m_Waypoints.size()
-                  << " waypoints)" << std::endl;
-        m_Waypoints.clear();
-        return false;
+        stamp[indexOf(start)] = walked;
+        path.push_back(start);
+        stack.push_back({start, 0});
     }
 
-    // Count unique tiles for the log message. Due to backtracking in DFS mode,
-    // the waypoint list may contain the same tile multiple times.
-    std::vector<glm::ivec2> uniqueTiles;
-    for (const auto &wp : m_Waypoints)
+    while (!stack.empty())
     {
-        bool found = false;
-        for (const auto &ut : uniqueTiles)
+        RouteScratch::Frame &frame = stack.back();
+        bool descended = false;
+        while (frame.nextDir < 4 && path.size() < maxLength)
         {
-            if (ut == wp)
+            const int d = frame.nextDir++;
+            const int nx = frame.tile.x + DIR_X[d];
+            const int ny = frame.tile.y + DIR_Y[d];
+            if (IsValidTile(nx, ny, tilemap) && stamp[ny * mapWidth + nx] != walked)
             {
-                found = true;
+                stamp[ny * mapWidth + nx] = walked;
+                path.emplace_back(nx, ny);
+                stack.push_back({glm::ivec2(nx, ny), 0});  // invalidates `frame`
+                descended = true;
                 break;
             }
         }
-        if (!found)
+        if (descended)
         {
-            uniqueTiles.push_back(wp);
+            continue;
         }
-    }
-
-    std::cout << "Created patrol route: " << m_Waypoints.size() << " waypoints, "
-              << uniqueTiles.size() << " unique tiles, mode="
-              << (m_IsClosed ? "loop" : "ping-pong")
-              << ", start=(" << startTileX << ", " << startTileY << ")" << std::endl;
-
-    return true;
-}
 
-void PatrolRoute::DFSTraversal(glm::ivec2 current,
-                               std::vector<bool> &visited,
-                               std::vector<glm::ivec2> &path,
-                               const Tilemap *tilemap,
-                               size_t maxLength)
-{
-    if (path.size() >= maxLength)
-    {
-        return;
+        stack.pop_back();
+        if (!stack.empty() && path.size() < maxLength)
+        {
+            path.push_back(stack.back().tile);
+        }
     }
 
-    int mapWidth = tilemap->GetMapWidth();
-    int index = current.y * mapWidth + current.x;
-
-    visited[index] = true;
-    path.push_back(current);
-
-    auto neighbors = GetValidNeighbors(current.x, current.y, tilemap);
-
-    for (const auto &neighbor : neighbors)
+    // Even non-cycles might loop back if the last tile is next to the first.
+    if (path.size() >= 2)
     {
-        int neighborIndex = neighbor.y * mapWidth + neighbor.x;
-        if (!visited[neighborIndex] && path.size() < maxLength)
-        {
-            // Recurse deeper into this branch.
-            DFSTraversal(neighbor, visited, path, tilemap, maxLength);
-
-            // After returning from the recursive call, we "backtrack" by adding
-            // the current tile again. This is the key trick: it means the NPC
-            // path goes A -> B -> C -> B -> D -> B -> A instead of A -> B -> C, D.
-            // Without this, the path would have discontinuities (teleporting).
-            //
-            // Example on a T-shaped map:
-            //       A
-            //       |
-            //   C - B - D
-            //
-            // DFS visits: A, then B, then C (dead end, backtrack to B),
-            // then D (dead end, backtrack to B), then back to A.
-            // Path produced: [A, B, C, B, D, B, A]
-            if (path.size() < maxLength)
-            {
-                path.push_back(current);
-            }
-        }
+        const glm::ivec2 &first = path.front();
+        const glm::ivec2 &last = path.back();
+        route.closed = AreAdjacent(last, first) || (last == first);
     }
 }
 
 bool PatrolRoute::GetNextWaypoint(int &tileX, int &tileY)
 {
-    if (m_Waypoints.empty())
+    if (!m_Route)
     {
         return false;
     }
 
-    const auto &waypoint = m_Waypoints[m_CurrentWaypointIndex];
+    const std::vector<glm::ivec2> &waypoints = m_Route->waypoints;
+    const auto &waypoint = waypoints[m_CurrentWaypointIndex];
     tileX = waypoint.x;
     tileY = waypoint.y;
 
-    if (m_IsClosed)
+    if (m_Route->closed)
     {
         // Closed loop: wrap around using modulo.
         // Index goes 0, 1, 2, ..., N-1, 0, 1, 2, ... forever.
-        m_CurrentWaypointIndex = (m_CurrentWaypointIndex + 1) % static_cast<int>(m_Waypoints.size());
+        m_CurrentWaypointIndex = (m_CurrentWaypointIndex + 1) % static_cast<int>(waypoints.size());
     }
     else
     {
@@ -276,11 +397,11 @@ bool PatrolRoute::GetNextWaypoint(int &tileX, int &tileY)
         if (m_PingPongForward)
         {
             m_CurrentWaypointIndex++;
-            if (m_CurrentWaypointIndex >= static_cast<int>(m_Waypoints.size()))
+            if (m_CurrentWaypointIndex >= static_cast<int>(waypoints.size()))
             {
                 // Reached the end, turn around. Go to N-2 (not N-1) to avoid
                 // repeating the endpoint twice.
-                m_CurrentWaypointIndex = static_cast<int>(m_Waypoints.size()) - 2;
+                m_CurrentWaypointIndex = static_cast<int>(waypoints.size()) - 2;
                 if (m_CurrentWaypointIndex < 0)
                 {
                     m_CurrentWaypointIndex = 0;
@@ -296,7 +417,7 @@ bool PatrolRoute::GetNextWaypoint(int &tileX, int &tileY)
                 // Reached the start, turn around. Go to 1 (not 0) to avoid
                 // repeating the startpoint twice.
                 m_CurrentWaypointIndex = 1;
-                if (m_CurrentWaypointIndex >= static_cast<int>(m_Waypoints.size()))
+                if (m_CurrentWaypointIndex >= static_cast<int>(waypoints.size()))
                 {
                     m_CurrentWaypointIndex = 0;
                 }
@@ -308,36 +429,7 @@ bool PatrolRoute::GetNextWaypoint(int &tileX, int &tileY)
     return true;
 }
 
-std::vector<glm::ivec2> PatrolRoute::GetValidNeighbors(int tileX, int tileY, const Tilemap *tilemap) const
-{
-    std::vector<glm::ivec2> neighbors;
-
-    if (!tilemap)
-    {
-        return neighbors;
-    }
-
-    // Check the 4 cardinal directions. The order matters for determinism:
-    // if we always check Right, Left, Down, Up in that order, then the same
-    // map will always produce the same patrol route.
-    const int dx[] = {1, -1, 0, 0};
-    const int dy[] = {0, 0, 1, -1};
-
-    for (int i = 0; i < 4; ++i)
-    {
-        int nx = tileX + dx[i];
-        int ny = tileY + dy[i];
-
-        if (IsValidTile(nx, ny, tilemap))
-        {
-            neighbors.push_back(glm::ivec2(nx, ny));
-        }
-    }
-
-    return neighbors;
-}
-
-bool PatrolRoute::IsValidTile(int tileX, int tileY, const Tilemap *tilemap) const
+bool PatrolRoute::IsValidTile(int tileX, int tileY, const Tilemap *tilemap)
 {
     if (!tilemap)
     {
@@ -369,7 +461,7 @@ bool PatrolRoute::IsValidTile(int tileX, int tileY, const Tilemap *tilemap) cons
     return true;
 }
 
-bool PatrolRoute::AreAdjacent(const glm::ivec2 &a, const glm::ivec2 &b) const
+bool PatrolRoute::AreAdjacent(const glm::ivec2 &a, const glm::ivec2 &b)
 {
     // Two tiles are adjacent if they differ by exactly 1 in X or Y, but not both.
     // This is Manhattan distance == 1, which corresponds to the 4 cardinal directions.
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -128,15 +130,28 @@ class Tilemap;
  * - **Loop Mode**: Index wraps: 0, 1, 2, ..., N-1, 0, 1, ...
  * - **Ping-Pong Mode**: Index bounces: 0, 1, ..., N-1, N-2, ..., 1, 0, 1, ...
  *
+ * @par Route Sharing
+ * Generated routes are cached by (tilemap, start tile, maxRouteLength,
+ * Tilemap::GetNavigationVersion()). NPCs placed on the same tile share one
+ * immutable waypoint list; each PatrolRoute only keeps its own iteration
+ * state. Any navigation or collision edit bumps the version, so stale routes
+ * are never handed out. Entries live as long as some route still uses them.
+ *
  * @par Time Complexity
- * - **Initialize**: O(V) where V = connected walkable tiles
+ * - **Initialize**: O(V) where V = connected walkable tiles, O(1) on a cache hit
  *   - BFS visits each tile once
- *   - DFS backtrack steps bounded by 2V
+ *   - Cycle test and walk use a per-tile stamp, O(1) per neighbor
+ *   - DFS backtrack steps bounded by 2V, on an explicit stack
  * - **GetNextWaypoint**: O(1)
  *
  * @par Space Complexity
- * - O(V) for visited set during traversal
- * - O(2V) worst case for stored waypoints (full backtracks)
+ * - O(map tiles) of per-thread scratch, reused across calls
+ * - O(2V) worst case for stored waypoints (full backtracks), shared
+ *
+ * @par Thread Safety
+ * Initialize() may run on several threads at once: scratch buffers are
+ * per-thread and the route cache is locked. A single PatrolRoute is not
+ * thread-safe.
  *
  * @see NonPlayerCharacter, Tilemap
  */
@@ -152,7 +167,8 @@ public:
      * @brief Generate a patrol route from a starting tile.
      *
      * Uses BFS to collect reachable tiles, then determines the optimal
-     * traversal strategy (cycle walk or DFS with backtracking).
+     * traversal strategy (cycle walk or DFS with backtracking). Reuses the
+     * cached route when one exists for the same inputs.
      *
      * @param startTileX Starting tile column.
      * @param startTileY Starting tile row.
@@ -184,19 +200,19 @@ public:
      * @brief Check if route is valid (has waypoints).
      * @return `true` if route has at least one waypoint.
      */
-    bool IsValid() const { return !m_Waypoints.empty(); }
+    bool IsValid() const { return m_Route != nullptr; }
 
     /**
      * @brief Check if route uses closed loop mode.
      * @return `true` if loop, `false` if ping-pong.
      */
-    bool IsClosed() const { return m_IsClosed; }
+    bool IsClosed() const { return m_Route && m_Route->closed; }
 
     /**
      * @brief Get total number of waypoints.
      * @return Waypoint count.
      */
-    size_t GetWaypointCount() const { return m_Waypoints.size(); }
+    size_t GetWaypointCount() const { return m_Route ? m_Route->waypoints.size() : 0; }
 
     /**
      * @brief Reset iteration to first waypoint.
@@ -209,29 +225,23 @@ public:
 
 private:
     /**
-     * @brief DFS traversal that records full path including backtracks.
-     *
-     * @param current Current tile being visited.
-     * @param visited Set of already-visited tiles.
-     * @param path Output path accumulator.
-     * @param tilemap Tilemap for neighbor queries.
-     * @param maxLength Maximum path length.
+     * @brief Immutable route data, shared by every PatrolRoute built from the same inputs.
      */
-    void DFSTraversal(glm::ivec2 current,
-                      std::vector<bool> &visited,
-                      std::vector<glm::ivec2> &path,
-                      const Tilemap *tilemap,
-                      size_t maxLength);
+    struct RouteData
+    {
+        std::vector<glm::ivec2> waypoints;    ///< Patrol waypoints (includes backtracks).
+        bool closed{false};                   ///< True = loop mode, false = ping-pong.
+    };
 
     /**
-     * @brief Get 4-directional walkable neighbors.
+     * @brief Build a route without consulting the cache.
      *
-     * @param tileX Tile column.
-     * @param tileY Tile row.
+     * @param start Starting tile (must be walkable).
      * @param tilemap Tilemap for navigation queries.
-     * @return Vector of valid neighbor coordinates.
+     * @param maxLength Maximum waypoints.
+     * @param[out] route Receives the waypoints and traversal mode.
      */
-    std::vector<glm::ivec2> GetValidNeighbors(int tileX, int tileY, const Tilemap *tilemap) const;
+    static void Generate(glm::ivec2 start, const Tilemap *tilemap, size_t maxLength, RouteData &route);
 
     /**
      * @brief Check if a tile is walkable.
@@ -241,7 +251,7 @@ private:
      * @param tilemap Tilemap for navigation queries.
      * @return `true` if tile is walkable.
      */
-    bool IsValidTile(int tileX, int tileY, const Tilemap *tilemap) const;
+    static bool IsValidTile(int tileX, int tileY, const Tilemap *tilemap);
 
     /**
      * @brief Check if two tiles are adjacent (Manhattan distance = 1).
@@ -249,10 +259,9 @@ private:
      * @param b Second tile.
      * @return `true` if cardinally adjacent.
      */
-    bool AreAdjacent(const glm::ivec2 &a, const glm::ivec2 &b) const;
+    static bool AreAdjacent(const glm::ivec2 &a, const glm::ivec2 &b);
 
-    std::vector<glm::ivec2> m_Waypoints;      ///< Patrol waypoints (includes backtracks).
+    std::shared_ptr<const RouteData> m_Route; ///< Shared waypoints; null until initialized.
     int m_CurrentWaypointIndex{0};            ///< Current position in waypoint array.
-    bool m_IsClosed{false};                   ///< True = loop mode, false = ping-pong.
     bool m_PingPongForward{true};             ///< Direction for ping-pong traversal.
 };
@@ -0,0 +1,188 @@
+#include "PerfHud.h"
+#include "IRenderer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+constexpr float MARGIN = 12.0f;
+constexpr float PADDING = 8.0f;
+constexpr float BAR_WIDTH = 2.0f;
+constexpr float GRAPH_HEIGHT = 64.0f;
+constexpr float GRAPH_CEILING_MS = 1000.0f / 30.0f;  ///< Top of the graph
+constexpr float BUDGET_MS = 1000.0f / 60.0f;         ///< Guide line and over-budget threshold
+constexpr float TEXT_SCALE = 0.7f;
+constexpr float LINE_HEIGHT = 20.0f;
+
+const glm::vec3 TEXT_COLOR(0.85f, 1.0f, 0.85f);
+const glm::vec4 PANEL_COLOR(0.0f, 0.0f, 0.0f, 0.6f);
+const glm::vec4 GUIDE_COLOR(1.0f, 1.0f, 1.0f, 0.25f);
+const glm::vec4 CPU_COLOR(0.3f, 0.9f, 0.4f, 0.85f);
+const glm::vec4 CPU_OVER_COLOR(1.0f, 0.3f, 0.3f, 0.9f);
+const glm::vec4 GPU_COLOR(1.0f, 0.65f, 0.2f, 0.9f);
+
+/// "12.3 MB", "5.2 KB" or "87 B"
+std::string FormatBytes(double bytes)
+{
+    char text[32];
+    if (bytes >= 1024.0 * 1024.0)
+        std::snprintf(text, sizeof(text), "%.1f MB", bytes / (1024.0 * 1024.0));
+    else if (bytes >= 1024.0)
+        std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+    else
+        std::snprintf(text, sizeof(text), "%.0f B", bytes);
+    return text;
+}
+
+float BarHeight(float ms)
+{
+    return std::clamp(ms / GRAPH_CEILING_MS, 0.0f, 1.0f) * GRAPH_HEIGHT;
+}
+}
+
+void PerfHud::RecordFrame(const FrameSample &sample)
+{
+    m_Last = sample;
+    m_CpuMs[m_Head] = sample.cpuMs;
+    m_GpuMs[m_Head] = sample.gpuMs;
+    m_Head = (m_Head + 1) % HISTORY;
+    m_Count = std::min(m_Count + 1, HISTORY);
+}
+
+void PerfHud::Render(IRenderer &renderer, float screenHeight) const
+{
+    if (!m_Visible)
+        return;
+
+    using Reason = RenderStats::FlushReason;
+    const RenderStats &stats = m_Last.renderStats;
+
+    float maxCpu = 0.0f;
+    for (std::size_t i = 0; i < m_Count; ++i)
+        maxCpu = std::max(maxCpu, m_CpuMs[i]);
+
+    std::string lines[8];
+    std::size_t lineCount = 6;
+    char text[160];
+
+    if (m_Last.gpuMs > 0.0f)
+        std::snprintf(text, sizeof(text), "CPU %.2fms (max %.2f)  GPU %.2fms", m_Last.cpuMs, maxCpu, m_Last.gpuMs);
+    else
+        std::snprintf(text, sizeof(text), "CPU %.2fms (max %.2f)  GPU n/a", m_Last.cpuMs, maxCpu);
+    lines[0] = text;
+
+    std::snprintf(text, sizeof(text), "Draws %d  Verts %.1fk", m_Last.drawCalls,
+                  static_cast<double>(stats.vertices) / 1000.0);
+    lines[1] = text;
+
+    lines[2] = "Flush:";
+    for (std::size_t r = 0; r < RenderStats::REASON_COUNT; ++r)
+    {
+        const Reason reason = static_cast<Reason>(r);
+        std::snprintf(text, sizeof(text), " %s %u", RenderStats::GetReasonName(reason),
+                      static_cast<unsigned>(stats.GetFlushes(reason)));
+        lines[2] += text;
+    }
+
+    std::snprintf(text, sizeof(text), "Tiles %zu  NPCs %zu  Particles %zu", m_Last.tiles, m_Last.npcs,
+                  m_Last.particles);
+    lines[3] = text;
+
+    lines[4] = "Textures: GL " + FormatBytes(static_cast<double>(m_Last.openGLTextureBytes)) + "  VK " +
+               FormatBytes(static_cast<double>(m_Last.vulkanTextureBytes));
+    if (m_Last.textureBudget > 0)
+    {
+        std::snprintf(text, sizeof(text), "  budget %s (%zu sheets evicted)",
+                      FormatBytes(static_cast<double>(m_Last.textureBudget)).c_str(), m_Last.evictedSheets);
+        lines[4] += text;
+    }
+
+    if (m_Last.allocationsCounted)
+    {
+        std::snprintf(text, sizeof(text), "Allocs/frame: %llu (%s)", static_cast<unsigned long long>(m_Last.allocations),
+                      FormatBytes(static_cast<double>(m_Last.allocatedBytes)).c_str());
+        lines[5] = text;
+    }
+    else
+    {
+        lines[5] = "Allocs/frame: n/a (ENABLE_PROFILER off)";
+    }
+    lines[5] += "  Arena " + FormatBytes(static_cast<double>(m_Last.frameArenaBytes)) + " / " +
+                FormatBytes(static_cast<double>(m_Last.frameArenaCapacity));
+
+    if (stats.framesInFlight > 0)
+    {
+        std::snprintf(text, sizeof(text), "Vulkan: frames %u  secondaries %u  sets %u/%u (+%u -%u)  transient %u",
+                      static_cast<unsigned>(stats.framesInFlight), static_cast<unsigned>(stats.secondaryCommandBuffers),
+                      static_cast<unsigned>(stats.descriptorSetsCached),
+                      static_cast<unsigned>(stats.descriptorSetCapacity),
+                      static_cast<unsigned>(stats.descriptorSetsCreated),
+                      static_cast<unsigned>(stats.descriptorSetsEvicted),
+                      static_cast<unsigned>(stats.transientDescriptorSets));
+        lines[lineCount++] = text;
+    }
+
+    if (m_Last.memoryCollected)
+    {
+        std::string &line = lines[lineCount++];
+        line = "Memory CPU/GPU:";
+        for (std::size_t s = 0; s < MemoryTracker::SUBSYSTEM_COUNT; ++s)
+        {
+            const MemoryTracker::Usage &usage = m_Last.memory[s];
+            if (usage.cpuBytes == 0 && usage.gpuBytes == 0)
+                continue;
+            line += line.back() == ':' ? " " : "  ";
+            line += std::string(MemoryTracker::GetName(static_cast<MemoryTracker::Subsystem>(s))) + " " +
+                    FormatBytes(static_cast<double>(usage.cpuBytes)) + "/" +
+                    FormatBytes(static_cast<double>(usage.gpuBytes));
+        }
+    }
+
+    // Panel wide enough for the graph and the longest line
+    const float graphWidth = static_cast<float>(HISTORY) * BAR_WIDTH;
+    float contentWidth = graphWidth;
+    for (std::size_t i = 0; i < lineCount; ++i)
+        contentWidth = std::max(contentWidth, renderer.GetTextWidth(lines[i], TEXT_SCALE));
+
+    const float panelWidth = contentWidth + PADDING * 2.0f;
+    const float panelHeight = PADDING + GRAPH_HEIGHT + PADDING + LINE_HEIGHT * static_cast<float>(lineCount) + PADDING;
+    const glm::vec2 panelPos(MARGIN, screenHeight - MARGIN - panelHeight);
+    renderer.DrawColoredRect(panelPos, glm::vec2(panelWidth, panelHeight), PANEL_COLOR, false);
+
+    // Bars grow up from the graph baseline, oldest frame on the left
+    const float graphX = panelPos.x + PADDING;
+    const float graphBottom = panelPos.y + PADDING + GRAPH_HEIGHT;
+    renderer.DrawColoredRect(glm::vec2(graphX, graphBottom - BarHeight(BUDGET_MS)), glm::vec2(graphWidth, 1.0f),
+                             GUIDE_COLOR, false);
+    renderer.DrawColoredRect(glm::vec2(graphX, graphBottom - GRAPH_HEIGHT), glm::vec2(graphWidth, 1.0f),
+                             GUIDE_COLOR, false);
+
+    const std::size_t oldest = (m_Head + HISTORY - m_Count) % HISTORY;
+    const float firstX = graphX + static_cast<float>(HISTORY - m_Count) * BAR_WIDTH;
+    for (std::size_t i = 0; i < m_Count; ++i)
+    {
+        const std::size_t slot = (oldest + i) % HISTORY;
+        const float x = firstX + static_cast<float>(i) * BAR_WIDTH;
+
+        const float cpuHeight = BarHeight(m_CpuMs[slot]);
+        renderer.DrawColoredRect(glm::vec2(x, graphBottom - cpuHeight), glm::vec2(BAR_WIDTH, cpuHeight),
+                                 m_CpuMs[slot] > BUDGET_MS ? CPU_OVER_COLOR : CPU_COLOR, false);
+
+        // GPU drawn as a thin line over the CPU bar of the same frame
+        if (m_GpuMs[slot] > 0.0f)
+        {
+            const float gpuY = graphBottom - BarHeight(m_GpuMs[slot]);
+            renderer.DrawColoredRect(glm::vec2(x, gpuY), glm::vec2(BAR_WIDTH, 2.0f), GPU_COLOR, false);
+        }
+    }
+
+    const float ascent = renderer.GetTextAscent(TEXT_SCALE);
+    float y = graphBottom + PADDING + ascent;
+    for (std::size_t i = 0; i < lineCount; ++i)
+    {
+        renderer.DrawText(lines[i], glm::vec2(graphX, y), TEXT_SCALE, TEXT_COLOR, 2.0f, 0.9f);
+        y += LINE_HEIGHT;
+    }
+}
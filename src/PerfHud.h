@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MemoryTracker.h"
+#include "RenderStats.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class IRenderer;
+
+/**
+ * @class PerfHud
+ * @brief Toggleable overlay with frame time graphs and per-frame render counters.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * The game loop hands one FrameSample to RecordFrame() per frame, whether
+ * the overlay is shown or not, so the graphs are already filled when it is
+ * toggled on (F12). Render() draws a panel in the bottom-left corner:
+ *
+ * @code
+ * +----------------------------------------+
+ * | CPU/GPU bars, last HISTORY frames      |  16.7 ms and 33.3 ms guides
+ * +----------------------------------------+
+ * CPU 4.12ms (max 6.80)  GPU 2.31ms
+ * Draws 43  Verts 18.2k
+ * Flush: texture 2 blend 4 full 0 switch 11 state 9 end 2
+ * Tiles 2310  NPCs 6  Particles 412
+ * Textures: GL 24.1 MB  VK 0.0 MB  budget 256.0 MB (3 sheets evicted)
+ * Memory CPU/GPU: Tilemap 6.2 MB/0 B  Tileset 4.0 MB/4.0 MB  Characters 8.1 MB/8.1 MB ...
+ * Allocs/frame: 0 (0 B)  Arena 12.4 KB / 256.0 KB
+ * Vulkan: frames 2  secondaries 6  sets 212/512 (+3 -1)  transient 0
+ * @endcode
+ *
+ * The Vulkan line only appears on that backend (RenderStats::framesInFlight
+ * is zero elsewhere). The memory line lists the MemoryTracker subsystems
+ * that hold anything; the game only collects it while the overlay is
+ * visible, since Collect() walks every uploaded texture.
+ *
+ * CPU time covers the frame from its start until the pacing wait, so it
+ * includes Present. GPU time is the sum of the IRenderer GPU timer passes
+ * and lags a few frames behind (see IRenderer::BeginGpuTimer()). Counters
+ * describe the last finished frame; with pipelined rendering the renderer
+ * counters are one frame older still.
+ *
+ * The overlay draws with DrawColoredRect() and DrawText() in screen space,
+ * so its own text and rects show up in the next frame's counters.
+ *
+ * @par Thread Safety
+ * Not thread-safe; used from the game thread only.
+ *
+ * @see RenderStats, AllocationCounter, MemoryTracker
+ */
+class PerfHud
+{
+public:
+    /// @brief Frames kept for the graphs.
+    static constexpr std::size_t HISTORY = 120;
+
+    /// @brief Everything the overlay shows about one finished frame.
+    struct FrameSample
+    {
+        float cpuMs = 0.0f;            ///< Frame work before the pacing wait
+        float gpuMs = 0.0f;            ///< Sum of the GPU timer passes (0 = unsupported)
+        int drawCalls = 0;
+        RenderStats renderStats;
+        std::size_t tiles = 0;         ///< Tile quads submitted
+        std::size_t npcs = 0;          ///< NPCs in the Y-sorted render list
+        std::size_t particles = 0;     ///< CPU particles that passed culling
+        std::size_t openGLTextureBytes = 0;
+        std::size_t vulkanTextureBytes = 0;
+        bool allocationsCounted = false;  ///< AllocationCounter::IsEnabled()
+        std::uint64_t allocations = 0;    ///< operator new calls this frame
+        std::uint64_t allocatedBytes = 0; ///< Bytes requested by them
+        std::size_t frameArenaBytes = 0;     ///< FrameArena used by the main thread this frame
+        std::size_t frameArenaCapacity = 0;  ///< Its primary block
+        std::size_t textureBudget = 0;       ///< SpriteSheetRegistry::GetBudget() (0 = none)
+        std::size_t evictedSheets = 0;       ///< Sheets currently evicted to stay in budget
+        bool memoryCollected = false;        ///< memory is filled in
+        MemoryTracker::Report memory{};
+    };
+
+    void SetVisible(bool visible) { m_Visible = visible; }
+    [[nodiscard]] bool IsVisible() const { return m_Visible; }
+    void Toggle() { m_Visible = !m_Visible; }
+
+    /// @brief Append a finished frame to the history.
+    void RecordFrame(const FrameSample &sample);
+
+    /// @brief Most recent sample (all zeros before the first RecordFrame()).
+    [[nodiscard]] const FrameSample &GetLastSample() const { return m_Last; }
+
+    /**
+     * @brief Draw the overlay in screen space.
+     *
+     * The caller sets a screen-space projection with perspective suspended.
+     *
+     * @param renderer     Active renderer.
+     * @param screenHeight Window height in pixels; the panel sits at the bottom.
+     */
+    void Render(IRenderer &renderer, float screenHeight) const;
+
+private:
+    bool m_Visible = false;
+    FrameSample m_Last;
+    std::array<float, HISTORY> m_CpuMs{};  ///< Ring buffer, m_Head is the next slot
+    std::array<float, HISTORY> m_GpuMs{};
+    std::size_t m_Head = 0;
+    std::size_t m_Count = 0;
+};
@@ -0,0 +1,348 @@
+#include "PerspectiveKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WILD_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#define WILD_TARGET_AVX2
+#else
+#define WILD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define WILD_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+// Params narrowed to float once per call
+struct Constants
+{
+    bool globe;
+    bool vanishing;
+    float centerX, centerY;
+    float radius;
+    float horizonY, depthRange;
+    float horizonScale, depthScale;  ///< horizonScale and 1 - horizonScale
+};
+
+using TransformFn = void (*)(float *, float *, std::size_t, const Constants &);
+
+// 2 pi split in two so the reduction stays exact for the few turns a screen spans
+constexpr float INV_TWO_PI = 0.159154943091895335769f;
+constexpr float TWO_PI_HI = 6.28125f;
+constexpr float TWO_PI_LO = 0.00193530717958647692f;
+constexpr float PI = 3.14159265358979323846f;
+constexpr float HALF_PI = 1.57079632679489661923f;
+
+// Taylor terms up to t^11; the t^13 term is below 6e-8 on [-pi/2, pi/2]
+constexpr float S3 = -1.0f / 6.0f;
+constexpr float S5 = 1.0f / 120.0f;
+constexpr float S7 = -1.0f / 5040.0f;
+constexpr float S9 = 1.0f / 362880.0f;
+constexpr float S11 = -1.0f / 39916800.0f;
+
+constexpr float MIN_DISTANCE = 0.001f;  ///< Same cut-off as TransformPoint()
+
+// Scalar loops double as the tail handlers of the vector paths
+float SinScalar(float t)
+{
+    const float k = std::nearbyint(t * INV_TWO_PI);
+    t = (t - k * TWO_PI_HI) - k * TWO_PI_LO;
+    if (t > HALF_PI)
+        t = PI - t;
+    else if (t < -HALF_PI)
+        t = -PI - t;
+    const float t2 = t * t;
+    float poly = S11;
+    poly = S9 + t2 * poly;
+    poly = S7 + t2 * poly;
+    poly = S5 + t2 * poly;
+    poly = S3 + t2 * poly;
+    return t + (t * t2) * poly;
+}
+
+void TransformScalar(float *x, float *y, std::size_t count, const Constants &c)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float px = x[i];
+        float py = y[i];
+        if (c.globe)
+        {
+            const float dx = px - c.centerX;
+            const float dy = py - c.centerY;
+            const float d = std::sqrt(dx * dx + dy * dy);
+            if (d > MIN_DISTANCE)
+            {
+                const float ratio = (c.radius * SinScalar(d / c.radius)) / d;
+                px = c.centerX + dx * ratio;
+                py = c.centerY + dy * ratio;
+            }
+        }
+        if (c.vanishing)
+        {
+            const float depth = std::min(1.0f, std::max(0.0f, (py - c.horizonY) / c.depthRange));
+            const float scale = c.horizonScale + c.depthScale * depth;
+            px = c.centerX + (px - c.centerX) * scale;
+            py = c.horizonY + (py - c.horizonY) * scale;
+        }
+        x[i] = px;
+        y[i] = py;
+    }
+}
+
+#if WILD_KERNELS_X86
+inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 SinSSE2(__m128 t)
+{
+    // cvtps rounds to nearest even, like nearbyint() in the default mode
+    const __m128 k = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(t, _mm_set1_ps(INV_TWO_PI))));
+    t = _mm_sub_ps(_mm_sub_ps(t, _mm_mul_ps(k, _mm_set1_ps(TWO_PI_HI))), _mm_mul_ps(k, _mm_set1_ps(TWO_PI_LO)));
+    t = Select(_mm_cmpgt_ps(t, _mm_set1_ps(HALF_PI)), _mm_sub_ps(_mm_set1_ps(PI), t), t);
+    t = Select(_mm_cmplt_ps(t, _mm_set1_ps(-HALF_PI)), _mm_sub_ps(_mm_set1_ps(-PI), t), t);
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 poly = _mm_set1_ps(S11);
+    poly = _mm_add_ps(_mm_set1_ps(S9), _mm_mul_ps(t2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(S7), _mm_mul_ps(t2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(S5), _mm_mul_ps(t2, poly));
+    poly = _mm_add_ps(_mm_set1_ps(S3), _mm_mul_ps(t2, poly));
+    return _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, t2), poly));
+}
+
+void TransformSSE2(float *x, float *y, std::size_t count, const Constants &c)
+{
+    const __m128 centerX = _mm_set1_ps(c.centerX), centerY = _mm_set1_ps(c.centerY);
+    const __m128 radius = _mm_set1_ps(c.radius), minDistance = _mm_set1_ps(MIN_DISTANCE);
+    const __m128 horizonY = _mm_set1_ps(c.horizonY), depthRange = _mm_set1_ps(c.depthRange);
+    const __m128 horizonScale = _mm_set1_ps(c.horizonScale), depthScale = _mm_set1_ps(c.depthScale);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(x + i);
+        __m128 py = _mm_loadu_ps(y + i);
+        if (c.globe)
+        {
+            const __m128 dx = _mm_sub_ps(px, centerX);
+            const __m128 dy = _mm_sub_ps(py, centerY);
+            const __m128 d = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+            // Points at the center keep their position; the clamp only avoids 0/0 there
+            const __m128 offCenter = _mm_cmpgt_ps(d, minDistance);
+            const __m128 safe = _mm_max_ps(d, minDistance);
+            const __m128 ratio = _mm_div_ps(_mm_mul_ps(radius, SinSSE2(_mm_div_ps(safe, radius))), safe);
+            px = Select(offCenter, _mm_add_ps(centerX, _mm_mul_ps(dx, ratio)), px);
+            py = Select(offCenter, _mm_add_ps(centerY, _mm_mul_ps(dy, ratio)), py);
+        }
+        if (c.vanishing)
+        {
+            const __m128 depth =
+                _mm_min_ps(one, _mm_max_ps(zero, _mm_div_ps(_mm_sub_ps(py, horizonY), depthRange)));
+            const __m128 scale = _mm_add_ps(horizonScale, _mm_mul_ps(depthScale, depth));
+            px = _mm_add_ps(centerX, _mm_mul_ps(_mm_sub_ps(px, centerX), scale));
+            py = _mm_add_ps(horizonY, _mm_mul_ps(_mm_sub_ps(py, horizonY), scale));
+        }
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+    }
+    TransformScalar(x + i, y + i, count - i, c);
+}
+
+WILD_TARGET_AVX2 inline __m256 SinAVX2(__m256 t)
+{
+    const __m256 k = _mm256_cvtepi32_ps(_mm256_cvtps_epi32(_mm256_mul_ps(t, _mm256_set1_ps(INV_TWO_PI))));
+    t = _mm256_sub_ps(_mm256_sub_ps(t, _mm256_mul_ps(k, _mm256_set1_ps(TWO_PI_HI))),
+                      _mm256_mul_ps(k, _mm256_set1_ps(TWO_PI_LO)));
+    t = _mm256_blendv_ps(t, _mm256_sub_ps(_mm256_set1_ps(PI), t),
+                         _mm256_cmp_ps(t, _mm256_set1_ps(HALF_PI), _CMP_GT_OQ));
+    t = _mm256_blendv_ps(t, _mm256_sub_ps(_mm256_set1_ps(-PI), t),
+                         _mm256_cmp_ps(t, _mm256_set1_ps(-HALF_PI), _CMP_LT_OQ));
+    const __m256 t2 = _mm256_mul_ps(t, t);
+    __m256 poly = _mm256_set1_ps(S11);
+    poly = _mm256_add_ps(_mm256_set1_ps(S9), _mm256_mul_ps(t2, poly));
+    poly = _mm256_add_ps(_mm256_set1_ps(S7), _mm256_mul_ps(t2, poly));
+    poly = _mm256_add_ps(_mm256_set1_ps(S5), _mm256_mul_ps(t2, poly));
+    poly = _mm256_add_ps(_mm256_set1_ps(S3), _mm256_mul_ps(t2, poly));
+    return _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(t, t2), poly));
+}
+
+WILD_TARGET_AVX2 void TransformAVX2(float *x, float *y, std::size_t count, const Constants &c)
+{
+    const __m256 centerX = _mm256_set1_ps(c.centerX), centerY = _mm256_set1_ps(c.centerY);
+    const __m256 radius = _mm256_set1_ps(c.radius), minDistance = _mm256_set1_ps(MIN_DISTANCE);
+    const __m256 horizonY = _mm256_set1_ps(c.horizonY), depthRange = _mm256_set1_ps(c.depthRange);
+    const __m256 horizonScale = _mm256_set1_ps(c.horizonScale), depthScale = _mm256_set1_ps(c.depthScale);
+    const __m256 zero = _mm256_setzero_ps(), one = _mm256_set1_ps(1.0f);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 px = _mm256_loadu_ps(x + i);
+        __m256 py = _mm256_loadu_ps(y + i);
+        if (c.globe)
+        {
+            const __m256 dx = _mm256_sub_ps(px, centerX);
+            const __m256 dy = _mm256_sub_ps(py, centerY);
+            const __m256 d = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+            const __m256 offCenter = _mm256_cmp_ps(d, minDistance, _CMP_GT_OQ);
+            const __m256 safe = _mm256_max_ps(d, minDistance);
+            const __m256 ratio =
+                _mm256_div_ps(_mm256_mul_ps(radius, SinAVX2(_mm256_div_ps(safe, radius))), safe);
+            px = _mm256_blendv_ps(px, _mm256_add_ps(centerX, _mm256_mul_ps(dx, ratio)), offCenter);
+            py = _mm256_blendv_ps(py, _mm256_add_ps(centerY, _mm256_mul_ps(dy, ratio)), offCenter);
+        }
+        if (c.vanishing)
+        {
+            const __m256 depth = _mm256_min_ps(
+                one, _mm256_max_ps(zero, _mm256_div_ps(_mm256_sub_ps(py, horizonY), depthRange)));
+            const __m256 scale = _mm256_add_ps(horizonScale, _mm256_mul_ps(depthScale, depth));
+            px = _mm256_add_ps(centerX, _mm256_mul_ps(_mm256_sub_ps(px, centerX), scale));
+            py = _mm256_add_ps(horizonY, _mm256_mul_ps(_mm256_sub_ps(py, horizonY), scale));
+        }
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+    }
+    TransformSSE2(x + i, y + i, count - i, c);
+}
+#endif
+
+#if WILD_KERNELS_NEON
+inline float32x4_t SinNEON(float32x4_t t)
+{
+    // vmulq + vaddq rather than vmlaq/vfmaq so results match the scalar path
+    const float32x4_t k = vcvtq_f32_s32(vcvtnq_s32_f32(vmulq_f32(t, vdupq_n_f32(INV_TWO_PI))));
+    t = vsubq_f32(vsubq_f32(t, vmulq_f32(k, vdupq_n_f32(TWO_PI_HI))), vmulq_f32(k, vdupq_n_f32(TWO_PI_LO)));
+    t = vbslq_f32(vcgtq_f32(t, vdupq_n_f32(HALF_PI)), vsubq_f32(vdupq_n_f32(PI), t), t);
+    t = vbslq_f32(vcltq_f32(t, vdupq_n_f32(-HALF_PI)), vsubq_f32(vdupq_n_f32(-PI), t), t);
+    const float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t poly = vdupq_n_f32(S11);
+    poly = vaddq_f32(vdupq_n_f32(S9), vmulq_f32(t2, poly));
+    poly = vaddq_f32(vdupq_n_f32(S7), vmulq_f32(t2, poly));
+    poly = vaddq_f32(vdupq_n_f32(S5), vmulq_f32(t2, poly));
+    poly = vaddq_f32(vdupq_n_f32(S3), vmulq_f32(t2, poly));
+    return vaddq_f32(t, vmulq_f32(vmulq_f32(t, t2), poly));
+}
+
+void TransformNEON(float *x, float *y, std::size_t count, const Constants &c)
+{
+    const float32x4_t centerX = vdupq_n_f32(c.centerX), centerY = vdupq_n_f32(c.centerY);
+    const float32x4_t radius = vdupq_n_f32(c.radius), minDistance = vdupq_n_f32(MIN_DISTANCE);
+    const float32x4_t horizonY = vdupq_n_f32(c.horizonY), depthRange = vdupq_n_f32(c.depthRange);
+    const float32x4_t horizonScale = vdupq_n_f32(c.horizonScale), depthScale = vdupq_n_f32(c.depthScale);
+    const float32x4_t zero = vdupq_n_f32(0.0f), one = vdupq_n_f32(1.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t px = vld1q_f32(x + i);
+        float32x4_t py = vld1q_f32(y + i);
+        if (c.globe)
+        {
+            const float32x4_t dx = vsubq_f32(px, centerX);
+            const float32x4_t dy = vsubq_f32(py, centerY);
+            const float32x4_t d = vsqrtq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)));
+            const uint32x4_t offCenter = vcgtq_f32(d, minDistance);
+            const float32x4_t safe = vmaxq_f32(d, minDistance);
+            const float32x4_t ratio = vdivq_f32(vmulq_f32(radius, SinNEON(vdivq_f32(safe, radius))), safe);
+            px = vbslq_f32(offCenter, vaddq_f32(centerX, vmulq_f32(dx, ratio)), px);
+            py = vbslq_f32(offCenter, vaddq_f32(centerY, vmulq_f32(dy, ratio)), py);
+        }
+        if (c.vanishing)
+        {
+            const float32x4_t depth = vminq_f32(one, vmaxq_f32(zero, vdivq_f32(vsubq_f32(py, horizonY), depthRange)));
+            const float32x4_t scale = vaddq_f32(horizonScale, vmulq_f32(depthScale, depth));
+            px = vaddq_f32(centerX, vmulq_f32(vsubq_f32(px, centerX), scale));
+            py = vaddq_f32(horizonY, vmulq_f32(vsubq_f32(py, horizonY), scale));
+        }
+        vst1q_f32(x + i, px);
+        vst1q_f32(y + i, py);
+    }
+    TransformScalar(x + i, y + i, count - i, c);
+}
+#endif
+
+struct KernelTable
+{
+    PerspectiveKernels::Isa isa;
+    TransformFn transform;
+};
+
+KernelTable MakeTable(PerspectiveKernels::Isa isa)
+{
+    // ParticleKernels owns CPU detection; both pick from the same sets
+    if (!ParticleKernels::IsSupported(isa))
+    {
+        isa = PerspectiveKernels::Isa::Scalar;
+    }
+    switch (isa)
+    {
+#if WILD_KERNELS_X86
+        case PerspectiveKernels::Isa::AVX2:
+            return {isa, TransformAVX2};
+        case PerspectiveKernels::Isa::SSE2:
+            return {isa, TransformSSE2};
+#endif
+#if WILD_KERNELS_NEON
+        case PerspectiveKernels::Isa::NEON:
+            return {isa, TransformNEON};
+#endif
+        default:
+            break;
+    }
+    return {PerspectiveKernels::Isa::Scalar, TransformScalar};
+}
+
+KernelTable &Table()
+{
+    static KernelTable table = MakeTable(ParticleKernels::GetBestIsa());
+    return table;
+}
+}  // namespace
+
+PerspectiveKernels::Isa PerspectiveKernels::GetIsa()
+{
+    return Table().isa;
+}
+
+void PerspectiveKernels::SetIsa(Isa isa)
+{
+    Table() = MakeTable(isa);
+}
+
+void PerspectiveKernels::TransformPoints(float *x, float *y, std::size_t count, const perspectiveTransform::Params &p)
+{
+    if (count == 0 || (!p.applyGlobe && !p.applyVanishing))
+        return;
+
+    Constants c{};
+    c.globe = p.applyGlobe;
+    c.centerX = static_cast<float>(p.centerX);
+    c.centerY = static_cast<float>(p.centerY);
+    c.radius = static_cast<float>(p.sphereRadius);
+    c.horizonY = static_cast<float>(p.horizonY);
+    c.horizonScale = static_cast<float>(p.horizonScale);
+    c.depthScale = static_cast<float>(1.0 - p.horizonScale);
+
+    // TransformPoint() skips the step when the horizon sits at the bottom edge
+    const double depthRange = p.screenHeight - p.horizonY;
+    c.vanishing = p.applyVanishing && depthRange >= 1e-5;
+    c.depthRange = static_cast<float>(depthRange);
+
+    Table().transform(x, y, count, c);
+}
+
+void PerspectiveKernels::TransformCorners(glm::vec2 corners[4], const perspectiveTransform::Params &p)
+{
+    float x[4] = {corners[0].x, corners[1].x, corners[2].x, corners[3].x};
+    float y[4] = {corners[0].y, corners[1].y, corners[2].y, corners[3].y};
+    TransformPoints(x, y, 4, p);
+    for (int i = 0; i < 4; ++i)
+    {
+        corners[i] = glm::vec2(x[i], y[i]);
+    }
+}
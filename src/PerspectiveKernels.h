@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ParticleKernels.h"
+#include "PerspectiveTransform.h"
+
+#include <cstddef>
+
+/**
+ * @class PerspectiveKernels
+ * @brief Vectorized perspectiveTransform::TransformPoint() over arrays of points.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Even with GPU projection the CPU projects points for sprite corners in
+ * CPU mode (IRenderer::ApplyPerspective()), picking and anchors. This runs
+ * the same globe and vanishing-point math in single precision, 4 or 8
+ * points per instruction, over separate X and Y arrays:
+ *
+ * @code
+ *   x[] = {x0, x1, x2, ...}   --TransformPoints()-->   x'[], y'[] (in place)
+ *   y[] = {y0, y1, y2, ...}
+ * @endcode
+ *
+ * @par Accuracy
+ * The sine is a range-reduced odd polynomial instead of std::sin(), and
+ * everything else is plain IEEE float arithmetic, so results stay within
+ * TOLERANCE of the double-precision TransformPoint() across the screen.
+ * That is far below what a pixel-snapped sprite can show.
+ *
+ * @par Instruction Sets
+ * Same choice as ParticleKernels (AVX2, SSE2, NEON or scalar), picked on
+ * first use; SetIsa() forces a narrower path for tests and benchmarks.
+ * All paths do the same float operations in the same order.
+ *
+ * @par Thread Safety
+ * TransformPoints() is reentrant. SetIsa() must not race with it.
+ *
+ * @see perspectiveTransform, IRenderer::ProjectPoints()
+ */
+class PerspectiveKernels
+{
+public:
+    using Isa = ParticleKernels::Isa;
+
+    /// @brief Largest distance, in pixels, from the double-precision result.
+    static constexpr float TOLERANCE = 1.0f / 1024.0f;
+
+    /// @brief Instruction set TransformPoints() currently uses.
+    static Isa GetIsa();
+
+    /// @brief Force an instruction set; unsupported ones fall back to Scalar.
+    static void SetIsa(Isa isa);
+
+    /**
+     * @brief Project @p count points in place.
+     *
+     * Same steps and conditions as perspectiveTransform::TransformPoint():
+     * globe curvature first, then vanishing-point scaling, each skipped when
+     * its flag in @p p is false.
+     *
+     * @param x     X coordinate per point (updated).
+     * @param y     Y coordinate per point (updated).
+     * @param count Number of points.
+     * @param p     Projection parameters.
+     */
+    static void TransformPoints(float *x, float *y, std::size_t count, const perspectiveTransform::Params &p);
+
+    /// @brief TransformPoints() on the four corners of a quad [TL, TR, BR, BL].
+    static void TransformCorners(glm::vec2 corners[4], const perspectiveTransform::Params &p);
+};
@@ -0,0 +1,794 @@
+#include "PipelinedRenderer.h"
+#include "Profiler.h"
+
+#include <GLFW/glfw3.h>
+
+#include <exception>
+#include <iostream>
+#include <utility>
+
+void PipelinedRenderer::FrameSnapshot::Clear()
+{
+    // clear() keeps capacity, so steady-state recording does not allocate
+    commands.clear();
+    instances.clear();
+    quads.clear();
+    corners.clear();
+    matrices.clear();
+    text.clear();
+    stars.clear();
+    starParams.clear();
+    emitters.clear();
+    steps.clear();
+    lights.clear();
+    present = false;
+    lowResResult = false;
+    lightMapResult = false;
+}
+
+PipelinedRenderer::PipelinedRenderer(std::unique_ptr<IRenderer> target, GLFWwindow *window)
+    : m_Target(std::move(target))
+    , m_Window(window)
+{
+    // Mirror the target's perspective so queries made before the next
+    // ConfigureRendererPerspective() still answer correctly
+    const PerspectiveState persp = m_Target->GetPerspectiveState();
+    switch (persp.mode)
+    {
+    case ProjectionMode::VanishingPoint:
+        IRenderer::SetVanishingPointPerspective(persp.enabled, persp.horizonY, persp.horizonScale,
+                                                persp.viewWidth, persp.viewHeight);
+        break;
+    case ProjectionMode::Globe:
+        IRenderer::SetGlobePerspective(persp.enabled, persp.sphereRadius, persp.viewWidth, persp.viewHeight);
+        break;
+    case ProjectionMode::Fisheye:
+        IRenderer::SetFisheyePerspective(persp.enabled, persp.sphereRadius, persp.horizonY, persp.horizonScale,
+                                         persp.viewWidth, persp.viewHeight);
+        break;
+    }
+    IRenderer::SetGpuProjection(m_Target->IsGpuProjectionEnabled());
+    m_GpuTimerResults = m_Target->GetGpuTimerResults();
+    m_RenderStats = m_Target->GetRenderStats();
+    m_ReplayedDrawCalls = m_Target->GetDrawCallCount();
+
+    // The GL context can only be current on one thread
+    if (m_Window)
+    {
+        glfwMakeContextCurrent(nullptr);
+    }
+    m_Thread = std::thread(&PipelinedRenderer::RenderThreadMain, this);
+}
+
+PipelinedRenderer::~PipelinedRenderer()
+{
+    if (m_Target)
+    {
+        ReleaseTarget();
+    }
+}
+
+std::unique_ptr<IRenderer> PipelinedRenderer::ReleaseTarget()
+{
+    // Deferred destroys and state changes recorded outside a frame still
+    // have to reach the target
+    if (!m_Snapshots[m_Recording].commands.empty())
+    {
+        Submit(false);
+    }
+    WaitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_WorkReady.notify_one();
+    m_Thread.join();
+
+    if (m_Window)
+    {
+        glfwMakeContextCurrent(m_Window);
+    }
+    return std::move(m_Target);
+}
+
+void PipelinedRenderer::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_WorkDone.wait(lock, [this] { return !m_FramePending && !m_Task; });
+}
+
+void PipelinedRenderer::RenderThreadMain()
+{
+    WILD_PROFILE_THREAD("Render");
+    if (m_Window)
+    {
+        glfwMakeContextCurrent(m_Window);
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;)
+    {
+        m_WorkReady.wait(lock, [this] { return m_FramePending || m_Task || m_Stop; });
+
+        if (m_Task)
+        {
+            const std::function<void()> *task = m_Task;
+            lock.unlock();
+            std::exception_ptr error;
+            try
+            {
+                (*task)();
+            }
+            catch (...)
+            {
+                // Invoke() rethrows it on the thread that asked for the task
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_TaskError = std::move(error);
+            m_Task = nullptr;
+            m_WorkDone.notify_all();
+        }
+        else if (m_FramePending)
+        {
+            FrameSnapshot &snapshot = m_Snapshots[1 - m_Recording];
+            lock.unlock();
+            try
+            {
+                Replay(snapshot);
+            }
+            catch (const std::exception &e)
+            {
+                // Nothing up the stack of this thread could handle it; drop the frame
+                std::cerr << "Exception on render thread: " << e.what() << std::endl;
+            }
+            if (snapshot.present && m_Window)
+            {
+                WILD_PROFILE_ZONE("Present");
+                glfwSwapBuffers(m_Window);
+            }
+            const int drawCalls = m_Target->GetDrawCallCount();
+            lock.lock();
+            if (snapshot.present)
+            {
+                m_ReplayedDrawCalls = drawCalls;
+                m_ReplayedGpuTimers = m_Target->GetGpuTimerResults();
+                m_ReplayedStats = m_Target->GetRenderStats();
+            }
+            m_FramePending = false;
+            m_WorkDone.notify_all();
+        }
+        else
+        {
+            break;
+        }
+    }
+    lock.unlock();
+
+    if (m_Window)
+    {
+        glfwMakeContextCurrent(nullptr);
+    }
+}
+
+void PipelinedRenderer::Submit(bool present)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    {
+        WILD_PROFILE_ZONE("Wait Render Thread");
+        m_WorkDone.wait(lock, [this] { return !m_FramePending && !m_Task; });
+    }
+
+    // The snapshot the render thread just finished is free for recording
+    const FrameSnapshot &replayed = m_Snapshots[1 - m_Recording];
+    if (replayed.present)
+    {
+        m_LowResAvailable = replayed.lowResResult;
+        m_LightMapAvailable = replayed.lightMapResult;
+    }
+    m_GpuTimerResults = m_ReplayedGpuTimers;
+    m_RenderStats = m_ReplayedStats;
+
+    m_Snapshots[m_Recording].present = present;
+    m_Recording = 1 - m_Recording;
+    m_Snapshots[m_Recording].Clear();
+    m_FramePending = true;
+    lock.unlock();
+    m_WorkReady.notify_one();
+}
+
+void PipelinedRenderer::Invoke(const std::function<void()> &task)
+{
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_WorkDone.wait(lock, [this] { return !m_FramePending && !m_Task; });
+    m_Task = &task;
+    m_WorkReady.notify_one();
+    m_WorkDone.wait(lock, [this] { return !m_Task; });
+    if (m_TaskError)
+    {
+        std::rethrow_exception(std::exchange(m_TaskError, nullptr));
+    }
+}
+
+PipelinedRenderer::Command &PipelinedRenderer::Record(Op op)
+{
+    Command &cmd = m_Snapshots[m_Recording].commands.emplace_back();
+    cmd.op = op;
+    cmd.flag = false;
+    cmd.texture = nullptr;
+    cmd.texture2 = nullptr;
+    cmd.name = nullptr;
+    cmd.offset = 0;
+    cmd.count = 0;
+    return cmd;
+}
+
+void PipelinedRenderer::Replay(FrameSnapshot &snapshot)
+{
+    WILD_PROFILE_ZONE("Replay");
+    IRenderer &target = *m_Target;
+    for (const Command &cmd : snapshot.commands)
+    {
+        switch (cmd.op)
+        {
+        case Op::BeginFrame:
+            target.BeginFrame();
+            break;
+        case Op::EndFrame:
+            target.EndFrame();
+            break;
+        case Op::DrawSprite:
+            target.DrawSprite(*cmd.texture, cmd.v0, cmd.v1, cmd.params.x, glm::vec3(cmd.color));
+            break;
+        case Op::DrawSpriteAlpha:
+            target.DrawSpriteAlpha(*cmd.texture, cmd.v0, cmd.v1, cmd.params.x, cmd.color, cmd.flag);
+            break;
+        case Op::DrawSpriteRegion:
+            target.DrawSpriteRegion(*cmd.texture, cmd.v0, cmd.v1, cmd.v2, cmd.v3, cmd.params.x,
+                                    glm::vec3(cmd.color), cmd.flag);
+            break;
+        case Op::DrawSpriteAtlas:
+            target.DrawSpriteAtlas(*cmd.texture, cmd.v0, cmd.v1, cmd.v2, cmd.v3, cmd.params.x, cmd.color, cmd.flag);
+            break;
+        case Op::DrawSpriteInstances:
+            target.DrawSpriteInstances(*cmd.texture, snapshot.instances.data() + cmd.offset, cmd.count, cmd.flag);
+            break;
+        case Op::DrawColoredRect:
+            target.DrawColoredRect(cmd.v0, cmd.v1, cmd.color, cmd.flag);
+            break;
+        case Op::DrawWarpedQuad:
+            target.DrawWarpedQuad(*cmd.texture, snapshot.corners.data() + cmd.offset, cmd.v2, cmd.v3,
+                                  glm::vec3(cmd.color), cmd.flag);
+            break;
+        case Op::DrawStaticMesh:
+            target.DrawStaticMesh(cmd.ints.x, cmd.v0);
+            break;
+        case Op::UpdateStaticMesh:
+            target.UpdateStaticMesh(cmd.ints.x, static_cast<size_t>(cmd.ints.y), snapshot.quads.data() + cmd.offset,
+                                    cmd.count, cmd.flag);
+            break;
+        case Op::DestroyStaticMesh:
+            target.DestroyStaticMesh(cmd.ints.x);
+            break;
+        case Op::SetProjection:
+            target.SetProjection(snapshot.matrices[cmd.offset]);
+            break;
+        case Op::SetViewport:
+            target.SetViewport(cmd.ints.x, cmd.ints.y, cmd.ints.z, cmd.ints.w);
+            break;
+        case Op::SetVanishingPointPerspective:
+            target.SetVanishingPointPerspective(cmd.flag, cmd.params.x, cmd.params.y, cmd.v0.x, cmd.v0.y);
+            break;
+        case Op::SetGlobePerspective:
+            target.SetGlobePerspective(cmd.flag, cmd.params.z, cmd.v0.x, cmd.v0.y);
+            break;
+        case Op::SetFisheyePerspective:
+            target.SetFisheyePerspective(cmd.flag, cmd.params.z, cmd.params.x, cmd.params.y, cmd.v0.x, cmd.v0.y);
+            break;
+        case Op::SuspendPerspective:
+            target.SuspendPerspective(cmd.flag);
+            break;
+        case Op::SetGpuProjection:
+            target.SetGpuProjection(cmd.flag);
+            break;
+        case Op::SetMultiTextureBatching:
+            target.SetMultiTextureBatching(cmd.flag);
+            break;
+        case Op::Clear:
+            target.Clear(cmd.color.r, cmd.color.g, cmd.color.b, cmd.color.a);
+            break;
+        case Op::DrawText:
+            target.DrawText(std::string_view(snapshot.text.data() + cmd.offset, cmd.count), cmd.v0, cmd.params.x,
+                            glm::vec3(cmd.color), cmd.params.y, cmd.color.a);
+            break;
+        case Op::SetAmbientColor:
+            target.SetAmbientColor(glm::vec3(cmd.color));
+            break;
+        case Op::BeginLowResPass:
+            snapshot.lowResResult = target.BeginLowResPass(cmd.ints.x, cmd.ints.y);
+            break;
+        case Op::EndLowResPass:
+            target.EndLowResPass(cmd.ints.x, cmd.ints.y, cmd.ints.z, cmd.ints.w);
+            break;
+        case Op::BeginRenderTarget:
+            target.BeginRenderTarget(cmd.ints.x);
+            break;
+        case Op::EndRenderTarget:
+            target.EndRenderTarget();
+            break;
+        case Op::DrawRenderTarget:
+            target.DrawRenderTarget(cmd.ints.x, cmd.v0, cmd.v1, cmd.flag);
+            break;
+        case Op::DestroyRenderTarget:
+            target.DestroyRenderTarget(cmd.ints.x);
+            break;
+        case Op::SetLightMap:
+            snapshot.lightMapResult =
+                target.SetLightMap(cmd.v0, cmd.params.x, snapshot.lights.data() + cmd.offset, cmd.count);
+            break;
+        case Op::ClearLightMap:
+            target.ClearLightMap();
+            break;
+        case Op::UploadStarField:
+            target.UploadStarField(snapshot.stars.data() + cmd.offset, cmd.count);
+            break;
+        case Op::DrawStarField:
+            target.DrawStarField(*cmd.texture, *cmd.texture2, snapshot.starParams[cmd.offset]);
+            break;
+        case Op::SimulateGpuParticles:
+            target.SimulateGpuParticles(snapshot.emitters.data() + cmd.offset, cmd.count,
+                                        snapshot.steps[static_cast<size_t>(cmd.ints.x)]);
+            break;
+        case Op::DrawGpuParticles:
+            target.DrawGpuParticles(*cmd.texture);
+            break;
+        case Op::ReleaseGpuParticles:
+            target.ReleaseGpuParticles();
+            break;
+        case Op::BeginGpuTimer:
+            target.BeginGpuTimer(cmd.name);
+            break;
+        case Op::EndGpuTimer:
+            target.EndGpuTimer();
+            break;
+        }
+    }
+}
+
+void PipelinedRenderer::Init()
+{
+    Invoke([this] { m_Target->Init(); });
+}
+
+void PipelinedRenderer::Shutdown()
+{
+    WaitIdle();
+    Invoke([this] { m_Target->Shutdown(); });
+}
+
+void PipelinedRenderer::SetJobSystem(JobSystem *jobs)
+{
+    // The target uses the pool from the render thread, inside EndFrame()
+    Invoke([&] { m_Target->SetJobSystem(jobs); });
+}
+
+void PipelinedRenderer::BeginFrame()
+{
+    Record(Op::BeginFrame);
+}
+
+void PipelinedRenderer::EndFrame()
+{
+    Record(Op::EndFrame);
+    Submit(true);
+}
+
+void PipelinedRenderer::DrawSprite(const Texture &texture, glm::vec2 position, glm::vec2 size, float rotation,
+                                   glm::vec3 color)
+{
+    Command &cmd = Record(Op::DrawSprite);
+    cmd.texture = &texture;
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.params.x = rotation;
+    cmd.color = glm::vec4(color, 1.0f);
+}
+
+void PipelinedRenderer::DrawSpriteAlpha(const Texture &texture, glm::vec2 position, glm::vec2 size, float rotation,
+                                        glm::vec4 color, bool additive)
+{
+    Command &cmd = Record(Op::DrawSpriteAlpha);
+    cmd.texture = &texture;
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.params.x = rotation;
+    cmd.color = color;
+    cmd.flag = additive;
+}
+
+void PipelinedRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position, glm::vec2 size,
+                                         glm::vec2 texCoord, glm::vec2 texSize, float rotation, glm::vec3 color,
+                                         bool flipY)
+{
+    Command &cmd = Record(Op::DrawSpriteRegion);
+    cmd.texture = &texture;
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.v2 = texCoord;
+    cmd.v3 = texSize;
+    cmd.params.x = rotation;
+    cmd.color = glm::vec4(color, 1.0f);
+    cmd.flag = flipY;
+}
+
+void PipelinedRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position, glm::vec2 size, glm::vec2 uvMin,
+                                        glm::vec2 uvMax, float rotation, glm::vec4 color, bool additive)
+{
+    Command &cmd = Record(Op::DrawSpriteAtlas);
+    cmd.texture = &texture;
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.v2 = uvMin;
+    cmd.v3 = uvMax;
+    cmd.params.x = rotation;
+    cmd.color = color;
+    cmd.flag = additive;
+}
+
+void PipelinedRenderer::DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances, size_t count,
+                                            bool additive)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::DrawSpriteInstances);
+    cmd.texture = &texture;
+    cmd.flag = additive;
+    cmd.offset = static_cast<std::uint32_t>(snapshot.instances.size());
+    cmd.count = static_cast<std::uint32_t>(count);
+    snapshot.instances.insert(snapshot.instances.end(), instances, instances + count);
+}
+
+void PipelinedRenderer::DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::vec4 color, bool additive)
+{
+    Command &cmd = Record(Op::DrawColoredRect);
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.color = color;
+    cmd.flag = additive;
+}
+
+void PipelinedRenderer::DrawWarpedQuad(const Texture &texture, const glm::vec2 corners[4], glm::vec2 texCoord,
+                                       glm::vec2 texSize, glm::vec3 color, bool flipY)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::DrawWarpedQuad);
+    cmd.texture = &texture;
+    cmd.v2 = texCoord;
+    cmd.v3 = texSize;
+    cmd.color = glm::vec4(color, 1.0f);
+    cmd.flag = flipY;
+    cmd.offset = static_cast<std::uint32_t>(snapshot.corners.size());
+    snapshot.corners.insert(snapshot.corners.end(), corners, corners + 4);
+}
+
+int PipelinedRenderer::CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY)
+{
+    int mesh = INVALID_STATIC_MESH;
+    Invoke([&] { mesh = m_Target->CreateStaticMesh(texture, quads, count, flipY); });
+    return mesh;
+}
+
+void PipelinedRenderer::DrawStaticMesh(int mesh, glm::vec2 origin)
+{
+    Command &cmd = Record(Op::DrawStaticMesh);
+    cmd.ints.x = mesh;
+    cmd.v0 = origin;
+}
+
+bool PipelinedRenderer::SupportsStaticMeshUpdates() const
+{
+    return m_Target->SupportsStaticMeshUpdates();
+}
+
+void PipelinedRenderer::UpdateStaticMesh(int mesh, size_t firstQuad, const StaticQuad *quads, size_t count,
+                                         bool flipY)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::UpdateStaticMesh);
+    cmd.ints.x = mesh;
+    cmd.ints.y = static_cast<int>(firstQuad);
+    cmd.flag = flipY;
+    cmd.offset = static_cast<std::uint32_t>(snapshot.quads.size());
+    cmd.count = static_cast<std::uint32_t>(count);
+    snapshot.quads.insert(snapshot.quads.end(), quads, quads + count);
+}
+
+void PipelinedRenderer::DestroyStaticMesh(int mesh)
+{
+    Command &cmd = Record(Op::DestroyStaticMesh);
+    cmd.ints.x = mesh;
+}
+
+void PipelinedRenderer::SetProjection(glm::mat4 projection)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::SetProjection);
+    cmd.offset = static_cast<std::uint32_t>(snapshot.matrices.size());
+    snapshot.matrices.push_back(projection);
+}
+
+void PipelinedRenderer::SetViewport(int x, int y, int width, int height)
+{
+    Command &cmd = Record(Op::SetViewport);
+    cmd.ints = glm::ivec4(x, y, width, height);
+}
+
+void PipelinedRenderer::SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale,
+                                                     float viewWidth, float viewHeight)
+{
+    IRenderer::SetVanishingPointPerspective(enabled, horizonY, horizonScale, viewWidth, viewHeight);
+    Command &cmd = Record(Op::SetVanishingPointPerspective);
+    cmd.flag = enabled;
+    cmd.params = glm::vec4(horizonY, horizonScale, 0.0f, 0.0f);
+    cmd.v0 = glm::vec2(viewWidth, viewHeight);
+}
+
+void PipelinedRenderer::SetGlobePerspective(bool enabled, float sphereRadius, float viewWidth, float viewHeight)
+{
+    IRenderer::SetGlobePerspective(enabled, sphereRadius, viewWidth, viewHeight);
+    Command &cmd = Record(Op::SetGlobePerspective);
+    cmd.flag = enabled;
+    cmd.params = glm::vec4(0.0f, 0.0f, sphereRadius, 0.0f);
+    cmd.v0 = glm::vec2(viewWidth, viewHeight);
+}
+
+void PipelinedRenderer::SetFisheyePerspective(bool enabled, float sphereRadius, float horizonY, float horizonScale,
+                                              float viewWidth, float viewHeight)
+{
+    IRenderer::SetFisheyePerspective(enabled, sphereRadius, horizonY, horizonScale, viewWidth, viewHeight);
+    Command &cmd = Record(Op::SetFisheyePerspective);
+    cmd.flag = enabled;
+    cmd.params = glm::vec4(horizonY, horizonScale, sphereRadius, 0.0f);
+    cmd.v0 = glm::vec2(viewWidth, viewHeight);
+}
+
+void PipelinedRenderer::SuspendPerspective(bool suspend)
+{
+    IRenderer::SuspendPerspective(suspend);
+    Record(Op::SuspendPerspective).flag = suspend;
+}
+
+void PipelinedRenderer::SetGpuProjection(bool enabled)
+{
+    IRenderer::SetGpuProjection(enabled);
+    Record(Op::SetGpuProjection).flag = enabled;
+}
+
+void PipelinedRenderer::SetMultiTextureBatching(bool enabled)
+{
+    Record(Op::SetMultiTextureBatching).flag = enabled;
+}
+
+void PipelinedRenderer::Clear(float r, float g, float b, float a)
+{
+    Record(Op::Clear).color = glm::vec4(r, g, b, a);
+}
+
+void PipelinedRenderer::UploadTexture(const Texture &texture)
+{
+    Invoke([&] { m_Target->UploadTexture(texture); });
+}
+
+void PipelinedRenderer::UploadTextures(const std::vector<Texture *> &textures, JobSystem *jobs)
+{
+    Invoke([&] { m_Target->UploadTextures(textures, jobs); });
+}
+
+void PipelinedRenderer::ReleaseTexture(Texture &texture)
+{
+    // Waits for the in-flight frame, which may still draw the texture
+    Invoke([&] { m_Target->ReleaseTexture(texture); });
+}
+
+bool PipelinedRenderer::UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height)
+{
+    // Waits for the in-flight frame, which may still sample the old texels
+    bool updated = false;
+    Invoke([&] { updated = m_Target->UpdateTextureRegion(texture, x, y, width, height); });
+    return updated;
+}
+
+bool PipelinedRenderer::ReloadShaders()
+{
+    bool reloaded = false;
+    Invoke([&] { reloaded = m_Target->ReloadShaders(); });
+    return reloaded;
+}
+
+void PipelinedRenderer::DrawText(std::string_view text, glm::vec2 position, float scale, glm::vec3 color,
+                                 float outlineSize, float alpha)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::DrawText);
+    cmd.v0 = position;
+    cmd.params = glm::vec4(scale, outlineSize, 0.0f, 0.0f);
+    cmd.color = glm::vec4(color, alpha);
+    cmd.offset = static_cast<std::uint32_t>(snapshot.text.size());
+    cmd.count = static_cast<std::uint32_t>(text.size());
+    snapshot.text.insert(snapshot.text.end(), text.begin(), text.end());
+}
+
+float PipelinedRenderer::GetTextAscent(float scale) const
+{
+    return m_Target->GetTextAscent(scale);
+}
+
+float PipelinedRenderer::GetTextWidth(std::string_view text, float scale) const
+{
+    return m_Target->GetTextWidth(text, scale);
+}
+
+bool PipelinedRenderer::RequiresYFlip() const
+{
+    return m_Target->RequiresYFlip();
+}
+
+void PipelinedRenderer::SetAmbientColor(const glm::vec3 &color)
+{
+    Record(Op::SetAmbientColor).color = glm::vec4(color, 1.0f);
+}
+
+int PipelinedRenderer::GetDrawCallCount() const
+{
+    return m_ReplayedDrawCalls;
+}
+
+bool PipelinedRenderer::BeginLowResPass(int width, int height)
+{
+    Record(Op::BeginLowResPass).ints = glm::ivec4(width, height, 0, 0);
+    return m_LowResAvailable;
+}
+
+void PipelinedRenderer::EndLowResPass(int x, int y, int width, int height)
+{
+    Record(Op::EndLowResPass).ints = glm::ivec4(x, y, width, height);
+}
+
+int PipelinedRenderer::CreateRenderTarget(int width, int height)
+{
+    int target = -1;
+    Invoke([&] { target = m_Target->CreateRenderTarget(width, height); });
+    return target;
+}
+
+bool PipelinedRenderer::BeginRenderTarget(int target)
+{
+    if (target < 0)
+    {
+        return false;
+    }
+    Record(Op::BeginRenderTarget).ints.x = target;
+    return true;
+}
+
+void PipelinedRenderer::EndRenderTarget()
+{
+    Record(Op::EndRenderTarget);
+}
+
+void PipelinedRenderer::DrawRenderTarget(int target, glm::vec2 position, glm::vec2 size, bool additive)
+{
+    Command &cmd = Record(Op::DrawRenderTarget);
+    cmd.ints.x = target;
+    cmd.v0 = position;
+    cmd.v1 = size;
+    cmd.flag = additive;
+}
+
+void PipelinedRenderer::DestroyRenderTarget(int target)
+{
+    Record(Op::DestroyRenderTarget).ints.x = target;
+}
+
+bool PipelinedRenderer::SupportsLightMap() const
+{
+    return m_Target->SupportsLightMap();
+}
+
+bool PipelinedRenderer::SetLightMap(glm::vec2 viewSize, float cellSize, const Light *lights, size_t count)
+{
+    if (!m_Target->SupportsLightMap())
+    {
+        return false;
+    }
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::SetLightMap);
+    cmd.v0 = viewSize;
+    cmd.params.x = cellSize;
+    cmd.offset = static_cast<std::uint32_t>(snapshot.lights.size());
+    cmd.count = static_cast<std::uint32_t>(count);
+    snapshot.lights.insert(snapshot.lights.end(), lights, lights + count);
+    return m_LightMapAvailable;
+}
+
+void PipelinedRenderer::ClearLightMap()
+{
+    Record(Op::ClearLightMap);
+}
+
+bool PipelinedRenderer::SupportsStarField() const
+{
+    return m_Target->SupportsStarField();
+}
+
+void PipelinedRenderer::UploadStarField(const StarFieldStar *stars, size_t count)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::UploadStarField);
+    cmd.offset = static_cast<std::uint32_t>(snapshot.stars.size());
+    cmd.count = static_cast<std::uint32_t>(count);
+    snapshot.stars.insert(snapshot.stars.end(), stars, stars + count);
+}
+
+void PipelinedRenderer::DrawStarField(const Texture &starTexture, const Texture &glowTexture,
+                                      const StarFieldParams &params)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::DrawStarField);
+    cmd.texture = &starTexture;
+    cmd.texture2 = &glowTexture;
+    cmd.offset = static_cast<std::uint32_t>(snapshot.starParams.size());
+    snapshot.starParams.push_back(params);
+}
+
+bool PipelinedRenderer::SupportsGpuParticles() const
+{
+    return m_Target->SupportsGpuParticles();
+}
+
+void PipelinedRenderer::SimulateGpuParticles(const GpuParticleEmitter *emitters, size_t count,
+                                             const GpuParticleStep &step)
+{
+    FrameSnapshot &snapshot = m_Snapshots[m_Recording];
+    Command &cmd = Record(Op::SimulateGpuParticles);
+    cmd.offset = static_cast<std::uint32_t>(snapshot.emitters.size());
+    cmd.count = static_cast<std::uint32_t>(count);
+    cmd.ints.x = static_cast<int>(snapshot.steps.size());
+    snapshot.emitters.insert(snapshot.emitters.end(), emitters, emitters + count);
+    snapshot.steps.push_back(step);
+}
+
+void PipelinedRenderer::DrawGpuParticles(const Texture &atlas)
+{
+    Record(Op::DrawGpuParticles).texture = &atlas;
+}
+
+void PipelinedRenderer::ReleaseGpuParticles()
+{
+    Record(Op::ReleaseGpuParticles);
+}
+
+bool PipelinedRenderer::SetPresentMode(PresentMode mode)
+{
+    // The target recreates its swapchain, which the render thread presents to
+    bool applied = false;
+    Invoke([&] { applied = m_Target->SetPresentMode(mode); });
+    return applied;
+}
+
+bool PipelinedRenderer::SetFramesInFlight(int count)
+{
+    bool applied = false;
+    Invoke([&] { applied = m_Target->SetFramesInFlight(count); });
+    return applied;
+}
+
+void PipelinedRenderer::BeginGpuTimer(const char *name)
+{
+    Record(Op::BeginGpuTimer).name = name;
+}
+
+void PipelinedRenderer::EndGpuTimer()
+{
+    Record(Op::EndGpuTimer);
+}
@@ -0,0 +1,304 @@
+#pragma once
+
+#include "IRenderer.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct GLFWwindow;
+
+/**
+ * @class PipelinedRenderer
+ * @brief Records frames on the game thread and replays them on a render thread.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Wraps a backend renderer (the target) and owns it while pipelining is
+ * active. Every IRenderer call made on the game thread is appended to a
+ * FrameSnapshot instead of being executed: projection, perspective and
+ * ambient state changes, and every draw with copies of the arrays and
+ * strings it was given. EndFrame() hands the finished snapshot to the render
+ * thread, which holds the GL context, replays the commands into the target
+ * and presents. Simulation and recording of frame N+1 then run while frame
+ * N is translated into batches and GL calls:
+ *
+ * @code
+ * game thread:   | update N+1 | record N+1 | update N+2 | record N+2 |
+ * render thread:              | replay N   | present    | replay N+1 |
+ * @endcode
+ *
+ * Two snapshots alternate. EndFrame() waits until the render thread has
+ * finished the previous one, so at most one frame is in flight and the
+ * added latency is bounded by one frame.
+ *
+ * @par Game-Thread State
+ * The wrapper keeps its own copy of the IRenderer perspective state, so
+ * ProjectPoint(), IsPointBehindSphere() and GetPerspectiveState() answer
+ * for the frame being recorded without touching the target. Const
+ * queries that only read data fixed at Init() (text metrics, feature
+ * support) go straight to the target.
+ *
+ * @par Synchronous Calls
+ * Calls that return a resource or must finish before the caller continues
+ * (UploadTexture(), ReleaseTexture(), CreateStaticMesh(),
+ * CreateRenderTarget(), Init(), Shutdown()) wait for the in-flight frame
+ * and then run on the render thread while the game thread blocks. They are
+ * rare (loading, cache misses), so the stall does not show in steady state.
+ * An exception thrown by the target during such a call is caught on the
+ * render thread and rethrown to the game thread by the call that waited.
+ * Destroying or updating resources is recorded like a draw, so it happens
+ * after the draws that were recorded before it.
+ *
+ * @par Predicted Results
+ * BeginLowResPass(), SetLightMap() and BeginRenderTarget() report success
+ * before the target has run them: the low-res pass and the light map return
+ * the last replayed result and a render target succeeds when the handle is
+ * valid. A wrong guess
+ * costs one frame drawn with the fallback layout.
+ *
+ * @par Stats
+ * GetDrawCallCount(), GetRenderStats() and GetGpuTimerResults() describe
+ * the last replayed frame, one frame older than with the target used
+ * directly.
+ *
+ * @par Thread Safety
+ * All IRenderer calls must come from one thread (the game thread).
+ * Textures referenced by a recorded draw must stay alive until that frame
+ * has been replayed; release them through ReleaseTexture(), which waits for
+ * the in-flight frame. Textures loaded while pipelining is active find no
+ * GL context on the game thread and are uploaded on first use instead.
+ *
+ * @see Game::SetPipelinedRendering()
+ */
+class PipelinedRenderer : public IRenderer
+{
+public:
+    /**
+     * @brief Take over a renderer and start the render thread.
+     * @param target Initialized backend renderer.
+     * @param window Window whose GL context moves to the render thread and
+     *               is presented after each frame, or nullptr for backends
+     *               that present in EndFrame().
+     */
+    PipelinedRenderer(std::unique_ptr<IRenderer> target, GLFWwindow *window);
+    ~PipelinedRenderer() override;
+
+    PipelinedRenderer(const PipelinedRenderer &) = delete;
+    PipelinedRenderer &operator=(const PipelinedRenderer &) = delete;
+
+    /**
+     * @brief Finish all recorded work, stop the render thread and return the target.
+     *
+     * Commands recorded since the last EndFrame() are replayed first. The GL
+     * context is current on the calling thread again afterwards. The wrapper
+     * must not be used after this.
+     */
+    std::unique_ptr<IRenderer> ReleaseTarget();
+
+    /// @brief Block until the render thread has replayed everything submitted.
+    void WaitIdle();
+
+    /// @name IRenderer
+    /// @{
+    void Init() override;
+    void Shutdown() override;
+    void SetJobSystem(JobSystem *jobs) override;
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void DrawSprite(const Texture &texture, glm::vec2 position, glm::vec2 size, float rotation,
+                    glm::vec3 color) override;
+    void DrawSpriteAlpha(const Texture &texture, glm::vec2 position, glm::vec2 size, float rotation,
+                         glm::vec4 color, bool additive) override;
+    void DrawSpriteRegion(const Texture &texture, glm::vec2 position, glm::vec2 size, glm::vec2 texCoord,
+                          glm::vec2 texSize, float rotation, glm::vec3 color, bool flipY) override;
+    void DrawSpriteAtlas(const Texture &texture, glm::vec2 position, glm::vec2 size, glm::vec2 uvMin,
+                         glm::vec2 uvMax, float rotation, glm::vec4 color, bool additive) override;
+    void DrawSpriteInstances(const Texture &texture, const SpriteInstance *instances, size_t count,
+                             bool additive) override;
+    void DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::vec4 color, bool additive) override;
+    void DrawWarpedQuad(const Texture &texture, const glm::vec2 corners[4], glm::vec2 texCoord,
+                        glm::vec2 texSize, glm::vec3 color, bool flipY) override;
+
+    int CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY) override;
+    void DrawStaticMesh(int mesh, glm::vec2 origin) override;
+    bool SupportsStaticMeshUpdates() const override;
+    void UpdateStaticMesh(int mesh, size_t firstQuad, const StaticQuad *quads, size_t count, bool flipY) override;
+    void DestroyStaticMesh(int mesh) override;
+
+    void SetProjection(glm::mat4 projection) override;
+    void SetViewport(int x, int y, int width, int height) override;
+    void SetVanishingPointPerspective(bool enabled, float horizonY, float horizonScale, float viewWidth,
+                                      float viewHeight) override;
+    void SetGlobePerspective(bool enabled, float sphereRadius, float viewWidth, float viewHeight) override;
+    void SetFisheyePerspective(bool enabled, float sphereRadius, float horizonY, float horizonScale,
+                               float viewWidth, float viewHeight) override;
+    void SuspendPerspective(bool suspend) override;
+    void SetGpuProjection(bool enabled) override;
+    void SetMultiTextureBatching(bool enabled) override;
+    void Clear(float r, float g, float b, float a) override;
+
+    void UploadTexture(const Texture &texture) override;
+    void UploadTextures(const std::vector<Texture *> &textures, JobSystem *jobs) override;
+    void ReleaseTexture(Texture &texture) override;
+    bool UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height) override;
+    bool ReloadShaders() override;
+
+    void DrawText(std::string_view text, glm::vec2 position, float scale, glm::vec3 color, float outlineSize,
+                  float alpha) override;
+    float GetTextAscent(float scale) const override;
+    float GetTextWidth(std::string_view text, float scale) const override;
+    bool RequiresYFlip() const override;
+    void SetAmbientColor(const glm::vec3 &color) override;
+    int GetDrawCallCount() const override;
+
+    bool BeginLowResPass(int width, int height) override;
+    void EndLowResPass(int x, int y, int width, int height) override;
+
+    int CreateRenderTarget(int width, int height) override;
+    bool BeginRenderTarget(int target) override;
+    void EndRenderTarget() override;
+    void DrawRenderTarget(int target, glm::vec2 position, glm::vec2 size, bool additive) override;
+    void DestroyRenderTarget(int target) override;
+
+    bool SupportsLightMap() const override;
+    bool SetLightMap(glm::vec2 viewSize, float cellSize, const Light *lights, size_t count) override;
+    void ClearLightMap() override;
+
+    bool SupportsStarField() const override;
+    void UploadStarField(const StarFieldStar *stars, size_t count) override;
+    void DrawStarField(const Texture &starTexture, const Texture &glowTexture, const StarFieldParams &params) override;
+
+    bool SupportsGpuParticles() const override;
+    void SimulateGpuParticles(const GpuParticleEmitter *emitters, size_t count, const GpuParticleStep &step) override;
+    void DrawGpuParticles(const Texture &atlas) override;
+    void ReleaseGpuParticles() override;
+
+    bool SetPresentMode(PresentMode mode) override;
+    bool SetFramesInFlight(int count) override;
+
+    void BeginGpuTimer(const char *name) override;
+    void EndGpuTimer() override;
+    /// @}
+
+private:
+    enum class Op : std::uint8_t
+    {
+        BeginFrame,
+        EndFrame,
+        DrawSprite,
+        DrawSpriteAlpha,
+        DrawSpriteRegion,
+        DrawSpriteAtlas,
+        DrawSpriteInstances,
+        DrawColoredRect,
+        DrawWarpedQuad,
+        DrawStaticMesh,
+        UpdateStaticMesh,
+        DestroyStaticMesh,
+        SetProjection,
+        SetViewport,
+        SetVanishingPointPerspective,
+        SetGlobePerspective,
+        SetFisheyePerspective,
+        SuspendPerspective,
+        SetGpuProjection,
+        SetMultiTextureBatching,
+        Clear,
+        DrawText,
+        SetAmbientColor,
+        BeginLowResPass,
+        EndLowResPass,
+        BeginRenderTarget,
+        EndRenderTarget,
+        DrawRenderTarget,
+        DestroyRenderTarget,
+        SetLightMap,
+        ClearLightMap,
+        UploadStarField,
+        DrawStarField,
+        SimulateGpuParticles,
+        DrawGpuParticles,
+        ReleaseGpuParticles,
+        BeginGpuTimer,
+        EndGpuTimer
+    };
+
+    /**
+     * One recorded call. Field use depends on the op (see Replay()); arrays
+     * and strings live in the snapshot's side buffers at [offset, offset + count).
+     */
+    struct Command
+    {
+        Op op;
+        bool flag;                 ///< additive, flipY, enabled or suspend
+        const Texture *texture;
+        const Texture *texture2;   ///< DrawStarField glow texture
+        const char *name;          ///< BeginGpuTimer label (string literal)
+        glm::vec2 v0, v1, v2, v3;  ///< position, size, texCoord/uvMin, texSize/uvMax
+        glm::vec4 color;
+        glm::vec4 params;          ///< rotation and per-op floats
+        glm::ivec4 ints;           ///< handles, viewport, pass rectangles
+        std::uint32_t offset;
+        std::uint32_t count;
+    };
+
+    /// Everything one frame draws, in call order, with copies of its inputs
+    struct FrameSnapshot
+    {
+        std::vector<Command> commands;
+        std::vector<SpriteInstance> instances;
+        std::vector<StaticQuad> quads;
+        std::vector<glm::vec2> corners;
+        std::vector<glm::mat4> matrices;
+        std::vector<char> text;
+        std::vector<StarFieldStar> stars;
+        std::vector<StarFieldParams> starParams;
+        std::vector<GpuParticleEmitter> emitters;
+        std::vector<GpuParticleStep> steps;
+        std::vector<Light> lights;
+        bool present = false;         ///< Swap buffers after replaying
+        bool lowResResult = false;    ///< What the target's BeginLowResPass() returned
+        bool lightMapResult = false;  ///< What the target's SetLightMap() returned
+
+        void Clear();
+    };
+
+    Command &Record(Op op);
+    void Replay(FrameSnapshot &snapshot);
+    void RenderThreadMain();
+
+    /// Hand the recording snapshot to the render thread (waits for the previous one)
+    void Submit(bool present);
+
+    /// Run @p task on the render thread and wait for it; rethrows whatever @p task threw
+    void Invoke(const std::function<void()> &task);
+
+    std::unique_ptr<IRenderer> m_Target;
+    GLFWwindow *m_Window;
+
+    FrameSnapshot m_Snapshots[2];
+    int m_Recording = 0;  ///< Snapshot the game thread appends to
+
+    std::thread m_Thread;
+    std::mutex m_Mutex;
+    std::condition_variable m_WorkReady;  ///< Render thread waits for a frame or task
+    std::condition_variable m_WorkDone;   ///< Game thread waits for it to finish
+    bool m_FramePending = false;          ///< m_Snapshots[1 - m_Recording] awaits replay
+    const std::function<void()> *m_Task = nullptr;
+    std::exception_ptr m_TaskError;       ///< Thrown by m_Task, rethrown by Invoke()
+    bool m_Stop = false;
+
+    // Results of the last replayed frame, copied on Submit()
+    int m_ReplayedDrawCalls = 0;
+    std::vector<GpuTimerResult> m_ReplayedGpuTimers;
+    RenderStats m_ReplayedStats;
+    bool m_LowResAvailable = true;  ///< Prediction for BeginLowResPass()
+    bool m_LightMapAvailable = true;  ///< Prediction for SetLightMap()
+};
@@ -1,11 +1,14 @@
 #include "PlayerCharacter.h"
 #include "Tilemap.h"
+#include "CollisionSweep.h"
+#include "SpatialHash.h"
 #include "IRenderer.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -62,28 +65,58 @@ PlayerCharacter::PlayerCharacter()
 
 PlayerCharacter::~PlayerCharacter() = default;
 
+// Replace a sheet only if the new one loads, so a missing file keeps the old look
+static bool AcquireSheet(const std::string &path, SpriteSheetRegistry::Handle &sheet)
+{
+    SpriteSheetRegistry::Handle loaded = SpriteSheetRegistry::Acquire(path);
+    if (!loaded)
+        return false;
+    sheet = std::move(loaded);
+    return true;
+}
+
 bool PlayerCharacter::LoadSpriteSheet(const std::string &path)
 {
-    return m_SpriteSheet.LoadFromFile(path);
+    return AcquireSheet(path, m_SpriteSheet);
 }
 
 bool PlayerCharacter::LoadRunningSpriteSheet(const std::string &path)
 {
-    return m_RunningSpriteSheet.LoadFromFile(path);
+    return AcquireSheet(path, m_RunningSpriteSheet);
 }
 
 bool PlayerCharacter::LoadBicycleSpriteSheet(const std::string &path)
 {
-    return m_BicycleSpriteSheet.LoadFromFile(path);
+    return AcquireSheet(path, m_BicycleSpriteSheet);
 }
 
 void PlayerCharacter::UploadTextures(IRenderer &renderer)
 {
     // Upload all sprite textures to the renderer
     // This is needed when switching renderers to recreate textures in the new context
-    renderer.UploadTexture(m_SpriteSheet);
-    renderer.UploadTexture(m_RunningSpriteSheet);
-    renderer.UploadTexture(m_BicycleSpriteSheet);
+    for (const SpriteSheetRegistry::Handle *sheet : {&m_SpriteSheet, &m_RunningSpriteSheet, &m_BicycleSpriteSheet})
+    {
+        if (*sheet)
+            renderer.UploadTexture(**sheet);
+    }
+}
+
+const Texture &PlayerCharacter::GetActiveSpriteSheet() const
+{
+    const SpriteSheetRegistry::Handle &sheet = m_IsBicycling                             ? m_BicycleSpriteSheet
+                                               : (m_AnimationType == AnimationType::RUN) ? m_RunningSpriteSheet
+                                                                                         : m_SpriteSheet;
+    return sheet ? *sheet : SpriteSheetRegistry::GetEmpty();
+}
+
+void PlayerCharacter::MarkSpriteSheetsUsed() const
+{
+    // Switching to running or the bicycle must not wait on a budget reload
+    for (const SpriteSheetRegistry::Handle *held : {&m_SpriteSheet, &m_RunningSpriteSheet, &m_BicycleSpriteSheet})
+    {
+        if (*held)
+            (*held)->MarkUsed();
+    }
 }
 
 void PlayerCharacter::SetCharacterAsset(CharacterType characterType, const std::string &spriteType, const std::string &path)
@@ -114,59 +147,90 @@ bool PlayerCharacter::SwitchCharacter(CharacterType characterType)
     };
 
     // Lambda: Attempt load with fallback to parent directory
-    auto tryLoad = [this](const std::string &path, bool (PlayerCharacter::*loadFunc)(const std::string &)) -> bool
+    auto tryAcquire = [](const std::string &path) -> SpriteSheetRegistry::Handle
     {
-        if ((this->*loadFunc)(path))
-            return true;
-        return (this->*loadFunc)("../" + path); // Try parent directory
+        SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(path);
+        return sheet ? sheet : SpriteSheetRegistry::Acquire("../" + path); // Try parent directory
     };
 
-    // Load all sprite sheets
-    bool walkingLoaded = tryLoad(getAssetPath("Walking"), &PlayerCharacter::LoadSpriteSheet);
-    bool runningLoaded = tryLoad(getAssetPath("Running"), &PlayerCharacter::LoadRunningSpriteSheet);
-    bool bicycleLoaded = tryLoad(getAssetPath("Bicycle"), &PlayerCharacter::LoadBicycleSpriteSheet);
+    // Acquire all sprite sheets; they may still be decoding when this returns
+    SpriteSheetRegistry::Handle walking = tryAcquire(getAssetPath("Walking"));
+    SpriteSheetRegistry::Handle running = tryAcquire(getAssetPath("Running"));
+    SpriteSheetRegistry::Handle bicycle = tryAcquire(getAssetPath("Bicycle"));
 
     // Validate required sprites loaded
-    if (!walkingLoaded || !runningLoaded)
+    if (!walking || !running)
     {
         std::cerr << "Failed to load character sprites for " << typeName << std::endl;
         return false;
     }
 
-    if (!bicycleLoaded)
+    if (!bicycle)
         std::cout << "Warning: Bicycle sprite not found for " << typeName << std::endl;
 
-    std::cout << "Switched to " << typeName << std::endl;
+    // Swap all sheets at once, when the last one is ready, so the player never
+    // shows a mix of two characters; with nothing to show yet, take them now
+    struct PendingSwitch
+    {
+        int remaining;
+        bool failed = false;
+    };
+    const std::uint64_t request = ++m_SheetRequest;
+    auto pending = std::make_shared<PendingSwitch>(PendingSwitch{bicycle ? 3 : 2});
+    auto apply = [this, walking, running, bicycle]()
+    {
+        m_SpriteSheet = walking;
+        m_RunningSpriteSheet = running;
+        if (bicycle)
+            m_BicycleSpriteSheet = bicycle;
+    };
+    if (!m_SpriteSheet)
+        apply();
+
+    auto onReady = [this, request, pending, apply, typeName](bool loaded)
+    {
+        pending->failed = pending->failed || !loaded;
+        if (--pending->remaining > 0 || request != m_SheetRequest)
+            return;
+        if (pending->failed)
+        {
+            std::cerr << "Failed to load character sprites for " << typeName << std::endl;
+            return;
+        }
+        apply();
+        std::cout << "Switched to " << typeName << std::endl;
+    };
+    for (const SpriteSheetRegistry::Handle *sheet : {&walking, &running, &bicycle})
+    {
+        if (*sheet)
+            SpriteSheetRegistry::WhenReady(*sheet, onReady);
+    }
     return true;
 }
 
 bool PlayerCharacter::CopyAppearanceFrom(const std::string &spritePath)
 {
-    // Load the NPC sprite sheet as all player sprites
-    // NPC sprites use the same layout as player sprites
-    bool walkLoaded = m_SpriteSheet.LoadFromFile(spritePath);
-    if (!walkLoaded)
+    // Use the NPC sprite sheet as all player sprites
+    // NPC sprites use the same layout as player sprites, and the registry
+    // returns the texture the NPCs already hold instead of reading the file again
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(spritePath);
+    if (!sheet)
     {
         // Try parent directory
-        walkLoaded = m_SpriteSheet.LoadFromFile("../" + spritePath);
+        sheet = SpriteSheetRegistry::Acquire("../" + spritePath);
     }
 
-    if (!walkLoaded)
+    if (!sheet)
     {
         std::cerr << "Failed to copy appearance from: " << spritePath << std::endl;
         return false;
     }
 
-    // Use the same sprite for running and bicycle modes
-    if (!m_RunningSpriteSheet.LoadFromFile(spritePath))
-    {
-        m_RunningSpriteSheet.LoadFromFile("../" + spritePath);
-    }
-
-    if (!m_BicycleSpriteSheet.LoadFromFile(spritePath))
-    {
-        m_BicycleSpriteSheet.LoadFromFile("../" + spritePath);
-    }
+    // Use the same sprite for running and bicycle modes; a switch still loading is dropped
+    ++m_SheetRequest;
+    m_SpriteSheet = sheet;
+    m_RunningSpriteSheet = sheet;
+    m_BicycleSpriteSheet = std::move(sheet);
 
     m_IsUsingCopiedAppearance = true;
     std::cout << "Copied appearance from: " << spritePath << std::endl;
@@ -262,9 +326,8 @@ void PlayerCharacter::Render(IRenderer &renderer, glm::vec2 cameraPos)
     }*/
 
     // Select sprite sheet based on movement mode
-    const Texture &sheet = m_IsBicycling                             ? m_BicycleSpriteSheet
-                           : (m_AnimationType == AnimationType::RUN) ? m_RunningSpriteSheet
-                                                                     : m_SpriteSheet;
+    MarkSpriteSheetsUsed();
+    const Texture &sheet = GetActiveSpriteSheet();
 
     // Suspend perspective - we already projected the position, don't double-project
     renderer.SuspendPerspective(true);
@@ -320,9 +383,8 @@ void PlayerCharacter::RenderBottomHalf(IRenderer &renderer, glm::vec2 cameraPos)
     }*/
 
     // Select sprite sheet based on movement mode
-    const Texture &sheet = m_IsBicycling                             ? m_BicycleSpriteSheet
-                           : (m_AnimationType == AnimationType::RUN) ? m_RunningSpriteSheet
-                                                                     : m_SpriteSheet;
+    MarkSpriteSheetsUsed();
+    const Texture &sheet = GetActiveSpriteSheet();
 
     // Bottom half: lower 16 pixels of the sprite
     // Render position is offset to show only the bottom half
@@ -383,9 +445,8 @@ void PlayerCharacter::RenderTopHalf(IRenderer &renderer, glm::vec2 cameraPos)
     }*/
 
     // Select sprite sheet based on movement mode
-    const Texture &sheet = m_IsBicycling                             ? m_BicycleSpriteSheet
-                           : (m_AnimationType == AnimationType::RUN) ? m_RunningSpriteSheet
-                                                                     : m_SpriteSheet;
+    MarkSpriteSheetsUsed();
+    const Texture &sheet = GetActiveSpriteSheet();
 
     // Top half: upper 16 pixels of the sprite (head/torso area)
     // Sprite coords offset to get upper half from texture
@@ -406,9 +467,9 @@ float PlayerCharacter::CalculateFollowAlpha(float deltaTime, float settleTime, f
     return std::clamp(alpha, 0.0f, 1.0f);
 }
 
-bool PlayerCharacter::CollidesWithNPC(const glm::vec2 &bottomCenterPos, const std::vector<glm::vec2> *npcPositions) const
+bool PlayerCharacter::CollidesWithNPC(const glm::vec2 &bottomCenterPos, const SpatialHash *npcGrid) const
 {
-    if (!npcPositions || npcPositions->empty())
+    if (!npcGrid || npcGrid->Size() == 0)
         return false;
 
     // Hitbox dimensions
@@ -426,8 +487,10 @@ bool PlayerCharacter::CollidesWithNPC(const glm::vec2 &bottomCenterPos, const st
     float playerMaxY = bottomCenterPos.y - EPS;
     float playerMinY = bottomCenterPos.y - HITBOX_HEIGHT + EPS;
 
-    // Test against each NPC
-    for (const auto &npcbottomCenterPos : *npcPositions)
+    // Only NPCs whose feet lie within one hitbox of the player can overlap
+    const glm::vec2 searchMin(playerMinX - NPC_HALF_W, playerMinY);
+    const glm::vec2 searchMax(playerMaxX + NPC_HALF_W, playerMaxY + NPC_BOX_H);
+    return npcGrid->AnyInBox(searchMin, searchMax, [&](SpatialHash::Id, glm::vec2 npcbottomCenterPos)
     {
         // Calculate NPC AABB (shrunk by epsilon)
         float npcMinX = npcbottomCenterPos.x - NPC_HALF_W + EPS;
@@ -436,11 +499,9 @@ bool PlayerCharacter::CollidesWithNPC(const glm::vec2 &bottomCenterPos, const st
         float npcMinY = npcbottomCenterPos.y - NPC_BOX_H + EPS;
 
         // AABB overlap test
-        if (playerMinX < npcMaxX && playerMaxX > npcMinX &&
-            playerMinY < npcMaxY && playerMaxY > npcMinY)
-            return true;
-    }
-    return false;
+        return playerMinX < npcMaxX && playerMaxX > npcMinX &&
+               playerMinY < npcMaxY && playerMaxY > npcMinY;
+    });
 }
 
 bool PlayerCharacter::CollidesWithTilesCenter(const glm::vec2 &bottomCenterPos, const Tilemap *tilemap) const
@@ -510,6 +571,10 @@ bool PlayerCharacter::CollidesWithTilesStrict(const glm::vec2 &bottomCenterPos,
         return !inBounds(x, y) || tilemap->GetTileCollision(x, y);
     };
 
+    // Only blocking tiles under the hitbox can collide; open ground is the common case
+    if (!tilemap->GetCollisionMap().AnyCollisionInRect(tileX0, tileY0, tileX1, tileY1))
+        return false;
+
     float hitboxArea = (maxX - minX) * (maxY - minY);
 
     for (int ty = tileY0; ty <= tileY1; ++ty)
@@ -818,7 +883,7 @@ bool PlayerCharacter::CollidesWithTilesStrict(const glm::vec2 &bottomCenterPos,
 }
 
 bool PlayerCharacter::CollidesAt(const glm::vec2 &bottomCenterPos, const Tilemap *tilemap,
-                                 const std::vector<glm::vec2> *npcPositions, bool sprintMode,
+                                 const SpatialHash *npcGrid, bool sprintMode,
                                  int moveDx, int moveDy, bool diagonalInput) const
 {
     bool tileCollision = false;
@@ -834,7 +899,7 @@ bool PlayerCharacter::CollidesAt(const glm::vec2 &bottomCenterPos, const Tilemap
         tileCollision = CollidesWithTilesStrict(bottomCenterPos, tilemap, moveDx, moveDy, diagonalInput);
     }
 
-    return tileCollision || CollidesWithNPC(bottomCenterPos, npcPositions);
+    return tileCollision || CollidesWithNPC(bottomCenterPos, npcGrid);
 }
 
 bool PlayerCharacter::IsCornerPenetration(const glm::vec2 &bottomCenterPos, const Tilemap *tilemap) const
@@ -856,6 +921,10 @@ bool PlayerCharacter::IsCornerPenetration(const glm::vec2 &bottomCenterPos, cons
     int tileY0 = static_cast<int>(std::floor(minY / TILE_H));
     int tileY1 = static_cast<int>(std::floor(maxY / TILE_H));
 
+    // A corner pocket needs blocked tiles in two rows and two columns
+    if (tilemap->GetCollisionMap().CountCollisionsInRect(tileX0, tileY0, tileX1, tileY1) < 2)
+        return false;
+
     bool hasRowDiff = false;
     bool hasColDiff = false;
     int firstRow = std::numeric_limits<int>::max();
@@ -903,7 +972,7 @@ bool PlayerCharacter::IsCornerPenetration(const glm::vec2 &bottomCenterPos, cons
 }
 
 glm::vec2 PlayerCharacter::ComputeSprintCornerEject(const Tilemap *tilemap,
-                                                    const std::vector<glm::vec2> *npcPositions,
+                                                    const SpatialHash *npcGrid,
                                                     glm::vec2 normalizedDir) const
 {
     if (!tilemap)
@@ -923,7 +992,7 @@ glm::vec2 PlayerCharacter::ComputeSprintCornerEject(const Tilemap *tilemap,
     auto clearStrict = [&](const glm::vec2 &pos)
     {
         return !CollidesWithTilesStrict(pos, tilemap, 0, 0, false) &&
-               !CollidesWithNPC(pos, npcPositions);
+               !CollidesWithNPC(pos, npcGrid);
     };
 
     for (int dy = -MAX_STEP; dy <= MAX_STEP; ++dy)
@@ -1436,7 +1505,7 @@ glm::vec2 PlayerCharacter::GetCornerSlideDirection(
 }
 
 glm::vec2 PlayerCharacter::FindClosestSafeTileCenter(const Tilemap *tilemap,
-                                                     const std::vector<glm::vec2> *npcPositions) const
+                                                     const SpatialHash *npcGrid) const
 {
     if (!tilemap)
         return m_Position;
@@ -1463,7 +1532,7 @@ glm::vec2 PlayerCharacter::FindClosestSafeTileCenter(const Tilemap *tilemap,
             glm::vec2 bottomCenterPos(tx * TILE_W + TILE_W * 0.5f, ty * TILE_H + TILE_H);
 
             if (!CollidesWithTilesStrict(bottomCenterPos, tilemap, 0, 0, false) &&
-                !CollidesWithNPC(bottomCenterPos, npcPositions))
+                !CollidesWithNPC(bottomCenterPos, npcGrid))
             {
                 float dist2 = glm::dot(bottomCenterPos - m_Position, bottomCenterPos - m_Position);
                 if (dist2 < bestDist2)
@@ -1478,12 +1547,12 @@ glm::vec2 PlayerCharacter::FindClosestSafeTileCenter(const Tilemap *tilemap,
 }
 
 void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *tilemap,
-                           const std::vector<glm::vec2> *npcPositions)
+                           const SpatialHash *npcGrid)
 {
     // === No input: handle idle state ===
     if (glm::length(direction) < 0.1f)
     {
-        HandleIdleSnap(deltaTime, tilemap, npcPositions);
+        HandleIdleSnap(deltaTime, tilemap, npcGrid);
         return;
     }
 
@@ -1554,16 +1623,23 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
 
     if (tilemap)
     {
+        // Sweep the strict hitbox over the whole move once. Without a contact neither the
+        // start nor the end overlaps a blocking tile, so the tile probes below can be skipped.
+        constexpr float SWEEP_EPS = 0.05f;
+        const SweepBox hitbox{glm::vec2(m_Position.x - HALF_HITBOX_WIDTH + SWEEP_EPS, m_Position.y - HITBOX_HEIGHT + SWEEP_EPS),
+                              glm::vec2(m_Position.x + HALF_HITBOX_WIDTH - SWEEP_EPS, m_Position.y - SWEEP_EPS)};
+        const SweepContact sweep = SweepAABB(*tilemap, hitbox, desiredMovement);
+
         // Track last safe position
-        if (!CollidesWithTilesStrict(m_Position, tilemap, 0, 0, false))
+        if (!sweep.hit || !CollidesWithTilesStrict(m_Position, tilemap, 0, 0, false))
             m_LastSafeTileCenter = GetCurrentTileCenter(static_cast<float>(tilemap->GetTileWidth()));
 
         // Try full movement first
         glm::vec2 testPos = m_Position + desiredMovement;
-        bool npcBlocked = CollidesWithNPC(testPos, npcPositions);
-        bool tileBlocked = sprintMode
-                               ? CollidesWithTilesCenter(testPos, tilemap)
-                               : CollidesWithTilesStrict(testPos, tilemap, moveDx, moveDy, diagonalInput);
+        bool npcBlocked = CollidesWithNPC(testPos, npcGrid);
+        bool tileBlocked = sweep.hit &&
+                           (sprintMode ? CollidesWithTilesCenter(testPos, tilemap)
+                                       : CollidesWithTilesStrict(testPos, tilemap, moveDx, moveDy, diagonalInput));
         bool initiallyTileBlocked = tileBlocked;
 
         bool didCornerSlide = false;
@@ -1578,7 +1654,7 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
             // 1) Try the real corner/slide solver FIRST (it can do slide+forward at corners)
             glm::vec2 slideMovement = TrySlideMovement(
                 desiredMovement, normalizedDir, deltaTime, currentSpeed,
-                tilemap, npcPositions, sprintMode, moveDx, moveDy, diagonalInput);
+                tilemap, npcGrid, sprintMode, moveDx, moveDy, diagonalInput);
 
             if (glm::length(slideMovement) > 0.001f)
             {
@@ -1594,8 +1670,8 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
                     glm::vec2 moveX(desiredMovement.x, 0.0f);
                     glm::vec2 moveY(0.0f, desiredMovement.y);
 
-                    bool okX = !CollidesAt(m_Position + moveX, tilemap, npcPositions, sprintMode, moveDx, 0, false);
-                    bool okY = !CollidesAt(m_Position + moveY, tilemap, npcPositions, sprintMode, 0, moveDy, false);
+                    bool okX = !CollidesAt(m_Position + moveX, tilemap, npcGrid, sprintMode, moveDx, 0, false);
+                    bool okY = !CollidesAt(m_Position + moveY, tilemap, npcGrid, sprintMode, 0, moveDy, false);
 
                     if (okX && !okY)
                     {
@@ -1627,18 +1703,18 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
         {
             desiredMovement = ApplyLaneSnapping(
                 desiredMovement, normalizedDir, deltaTime,
-                tilemap, npcPositions, sprintMode, effDx, effDy);
+                tilemap, npcGrid, sprintMode, effDx, effDy);
         }
 
         // Final collision check
-        if (CollidesAt(m_Position + desiredMovement, tilemap, npcPositions, sprintMode, effDx, effDy, effDiagonal))
+        if (CollidesAt(m_Position + desiredMovement, tilemap, npcGrid, sprintMode, effDx, effDy, effDiagonal))
         {
             // Try axis-separated movement
             glm::vec2 tryX = m_Position + glm::vec2(desiredMovement.x, 0.0f);
             glm::vec2 tryY = m_Position + glm::vec2(0.0f, desiredMovement.y);
 
-            bool okX = !CollidesAt(tryX, tilemap, npcPositions, sprintMode, moveDx, 0, false);
-            bool okY = !CollidesAt(tryY, tilemap, npcPositions, sprintMode, 0, moveDy, false);
+            bool okX = !CollidesAt(tryX, tilemap, npcGrid, sprintMode, moveDx, 0, false);
+            bool okY = !CollidesAt(tryY, tilemap, npcGrid, sprintMode, 0, moveDy, false);
 
             if (okX && okY)
             {
@@ -1701,7 +1777,7 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
                 {
                     float mid = (lo + hi) * 0.5f;
                     glm::vec2 tryPos = m_Position + dir * mid;
-                    if (!CollidesAt(tryPos, tilemap, npcPositions, sprintMode, finalDx, finalDy, finalDiag))
+                    if (!CollidesAt(tryPos, tilemap, npcGrid, sprintMode, finalDx, finalDy, finalDiag))
                         lo = mid;
                     else
                         hi = mid;
@@ -1724,7 +1800,7 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
 
             if (glm::length(desiredMovement) < 0.001f || currentlyStuck || wouldBeStuck)
             {
-                glm::vec2 cornerEject = ComputeSprintCornerEject(tilemap, npcPositions, normalizedDir);
+                glm::vec2 cornerEject = ComputeSprintCornerEject(tilemap, npcGrid, normalizedDir);
                 if (glm::length(cornerEject) > 0.001f)
                     desiredMovement = cornerEject;
             }
@@ -1739,7 +1815,7 @@ void PlayerCharacter::Move(glm::vec2 direction, float deltaTime, const Tilemap *
 
 glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2 normalizedDir,
                                             float deltaTime, float currentSpeed,
-                                            const Tilemap *tilemap, const std::vector<glm::vec2> *npcPositions,
+                                            const Tilemap *tilemap, const SpatialHash *npcGrid,
                                             bool sprintMode, int moveDx, int moveDy, bool diagonalInput)
 {
     // When sprinting and cutting corners diagonally, use strict collision to avoid over-lenient center checks
@@ -1749,8 +1825,8 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
     // Test if desired movement is already valid
     glm::vec2 testPos = m_Position + desiredMovement;
 
-    if (!CollidesAt(testPos, tilemap, npcPositions, slideSprintMode, moveDx, moveDy, diagonalInput) &&
-        !CollidesWithNPC(testPos, npcPositions))
+    if (!CollidesAt(testPos, tilemap, npcGrid, slideSprintMode, moveDx, moveDy, diagonalInput) &&
+        !CollidesWithNPC(testPos, npcGrid))
     {
         // Only reset hysteresis if commit timer expired (prevents jitter at corners)
         if (m_SlideCommitTimer <= 0.0f)
@@ -1759,7 +1835,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
     }
 
     // NPC collision: don't slide, just stop
-    if (CollidesWithNPC(testPos, npcPositions))
+    if (CollidesWithNPC(testPos, npcGrid))
     {
         m_SlideHysteresisDir = glm::vec2(0.0f);
         m_SlideCommitTimer = 0.0f;
@@ -1799,8 +1875,8 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
 
         // Test slide + full forward movement
         glm::vec2 testSlideForward = m_Position + slideOffset + forwardMove;
-        if (!CollidesAt(testSlideForward, tilemap, npcPositions, sprintMode, moveDx, moveDy, false) &&
-            !CollidesWithNPC(testSlideForward, npcPositions))
+        if (!CollidesAt(testSlideForward, tilemap, npcGrid, sprintMode, moveDx, moveDy, false) &&
+            !CollidesWithNPC(testSlideForward, npcGrid))
         {
             // Found valid slide - clamp to speed limit
             float clampedSlide = std::min(slideAmount, maxSlide);
@@ -1811,7 +1887,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
                 clampedOffset = glm::vec2(slideDir.x * clampedSlide, 0.0f);
 
             // After computing clampedOffset
-            if (CollidesAt(m_Position + clampedOffset, tilemap, npcPositions, sprintMode,
+            if (CollidesAt(m_Position + clampedOffset, tilemap, npcGrid, sprintMode,
                 (int)slideDir.x, (int)slideDir.y, false))
             {
             continue; // clamped step isn't safe; try a different slideAmount
@@ -1823,7 +1899,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
             {
                 float mid = (lo + hi) * 0.5f;
                 glm::vec2 tryPos = m_Position + clampedOffset + forwardMove * mid;
-                if (!CollidesAt(tryPos, tilemap, npcPositions, sprintMode, moveDx, moveDy, false))
+                if (!CollidesAt(tryPos, tilemap, npcGrid, sprintMode, moveDx, moveDy, false))
                     lo = mid;
                 else
                     hi = mid;
@@ -1834,7 +1910,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
 
         // Test slide only (no forward progress this frame)
         glm::vec2 testSlideOnly = m_Position + slideOffset;
-        if (!CollidesAt(testSlideOnly, tilemap, npcPositions, sprintMode,
+        if (!CollidesAt(testSlideOnly, tilemap, npcGrid, sprintMode,
                         (int)slideDir.x, (int)slideDir.y, false))
         {
             float clampedSlide = std::min(slideAmount, maxSlide);
@@ -1876,7 +1952,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
             // Use fixed 1-pixel probe for DETECTION of valid corner path
             glm::vec2 testSlideForward = m_Position + slideOffset + forwardProbe;
 
-            if (!CollidesAt(testSlideForward, tilemap, npcPositions, slideSprintMode, moveDx, moveDy, diagonalInput))
+            if (!CollidesAt(testSlideForward, tilemap, npcGrid, slideSprintMode, moveDx, moveDy, diagonalInput))
             {
                 float clampedSlide = std::min(slideAmount, maxSlide);
                 glm::vec2 clampedOffset = horizontalPrimary
@@ -1884,7 +1960,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
                                               : glm::vec2(dir.x * clampedSlide, 0.0f);
 
                 // must be safe to apply the perpendicular step
-                if (CollidesAt(m_Position + clampedOffset, tilemap, npcPositions, slideSprintMode,
+                if (CollidesAt(m_Position + clampedOffset, tilemap, npcGrid, slideSprintMode,
                                (int)dir.x, (int)dir.y, diagonalInput))
                     continue;
 
@@ -1901,7 +1977,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
                 {
                     float mid = (lo + hi) * 0.5f;
                     glm::vec2 tryPos = m_Position + clampedOffset + forwardMove * mid;
-                    if (!CollidesAt(tryPos, tilemap, npcPositions, slideSprintMode, moveDx, moveDy, diagonalInput))
+                    if (!CollidesAt(tryPos, tilemap, npcGrid, slideSprintMode, moveDx, moveDy, diagonalInput))
                         lo = mid;
                     else
                         hi = mid;
@@ -1913,14 +1989,14 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
                 // but only keep it if still collision-free.
                 constexpr float SLIDE_BLEND = 0.35f;
                 glm::vec2 blended = glm::mix(desiredMovement, slideResult, SLIDE_BLEND);
-                if (!CollidesAt(m_Position + blended, tilemap, npcPositions, slideSprintMode, moveDx, moveDy, diagonalInput))
+                if (!CollidesAt(m_Position + blended, tilemap, npcGrid, slideSprintMode, moveDx, moveDy, diagonalInput))
                     return blended;
 
                 return slideResult;
             }
 
             glm::vec2 testSlideOnly = m_Position + slideOffset;
-            if (!CollidesAt(testSlideOnly, tilemap, npcPositions, slideSprintMode, (int)dir.x, (int)dir.y, diagonalInput))
+            if (!CollidesAt(testSlideOnly, tilemap, npcGrid, slideSprintMode, (int)dir.x, (int)dir.y, diagonalInput))
             {
                 float clampedSlide = std::min(slideAmount, maxSlide);
                 return horizontalPrimary
@@ -1943,7 +2019,7 @@ glm::vec2 PlayerCharacter::TrySlideMovement(glm::vec2 desiredMovement, glm::vec2
 glm::vec2 PlayerCharacter::ApplyLaneSnapping(
     glm::vec2 desiredMovement, glm::vec2 normalizedDir,
     float deltaTime, const Tilemap *tilemap,
-    const std::vector<glm::vec2> *npcPositions,
+    const SpatialHash *npcGrid,
     bool sprintMode, int moveDx, int moveDy)
 {
     if (!tilemap)
@@ -1973,7 +2049,7 @@ glm::vec2 PlayerCharacter::ApplyLaneSnapping(
         glm::vec2 testPos = m_Position + glm::vec2(desiredMovement.x, correction);
 
         // moving horizontally: moveDx matters, moveDy = 0
-        if (!CollidesAt(testPos, tilemap, npcPositions, sprintMode, moveDx, 0, false))
+        if (!CollidesAt(testPos, tilemap, npcGrid, sprintMode, moveDx, 0, false))
         {
             desiredMovement.y += correction;
         }
@@ -1983,7 +2059,7 @@ glm::vec2 PlayerCharacter::ApplyLaneSnapping(
             int corrDy = (correction > 0.0f) ? 1 : -1;
             glm::vec2 testPerpOnly = m_Position + glm::vec2(0.0f, correction);
 
-            if (!CollidesAt(testPerpOnly, tilemap, npcPositions, sprintMode, 0, corrDy, false))
+            if (!CollidesAt(testPerpOnly, tilemap, npcGrid, sprintMode, 0, corrDy, false))
                 desiredMovement.y += correction;
         }
     }
@@ -1999,7 +2075,7 @@ glm::vec2 PlayerCharacter::ApplyLaneSnapping(
         glm::vec2 testPos = m_Position + glm::vec2(correction, desiredMovement.y);
 
         // moving vertically: moveDy matters, moveDx = 0
-        if (!CollidesAt(testPos, tilemap, npcPositions, sprintMode, 0, moveDy, false))
+        if (!CollidesAt(testPos, tilemap, npcGrid, sprintMode, 0, moveDy, false))
         {
             desiredMovement.x += correction;
         }
@@ -2008,7 +2084,7 @@ glm::vec2 PlayerCharacter::ApplyLaneSnapping(
             int corrDx = (correction > 0.0f) ? 1 : -1;
             glm::vec2 testPerpOnly = m_Position + glm::vec2(correction, 0.0f);
 
-            if (!CollidesAt(testPerpOnly, tilemap, npcPositions, sprintMode, corrDx, 0, false))
+            if (!CollidesAt(testPerpOnly, tilemap, npcGrid, sprintMode, corrDx, 0, false))
                 desiredMovement.x += correction;
         }
     }
@@ -2017,7 +2093,7 @@ glm::vec2 PlayerCharacter::ApplyLaneSnapping(
 }
 
 void PlayerCharacter::HandleIdleSnap(float deltaTime, const Tilemap *tilemap,
-                                     const std::vector<glm::vec2> *npcPositions)
+                                     const SpatialHash *npcGrid)
 {
     float tileSize = tilemap ? static_cast<float>(tilemap->GetTileWidth()) : 16.0f;
     glm::vec2 targetCenter = GetCurrentTileCenter(tileSize);
@@ -2026,7 +2102,7 @@ void PlayerCharacter::HandleIdleSnap(float deltaTime, const Tilemap *tilemap,
     // === Stuck Detection: teleport to safety if inside collision ===
     if (tilemap && CollidesWithTilesStrict(m_Position, tilemap, 0, 0, false))
     {
-        m_Position = FindClosestSafeTileCenter(tilemap, npcPositions);
+        m_Position = FindClosestSafeTileCenter(tilemap, npcGrid);
         targetCenter = GetCurrentTileCenter(tileSize);
         distanceToCenter = glm::length(targetCenter - m_Position);
     }
@@ -2069,12 +2145,12 @@ void PlayerCharacter::HandleIdleSnap(float deltaTime, const Tilemap *tilemap,
 
             glm::vec2 testX = m_Position + glm::vec2(snapMovement.x, 0.0f);
             if (!CollidesWithTilesStrict(testX, tilemap, 0, 0, false) &&
-                !CollidesWithNPC(testX, npcPositions))
+                !CollidesWithNPC(testX, npcGrid))
                 finalSnap.x = snapMovement.x;
 
             glm::vec2 testY = m_Position + glm::vec2(0.0f, snapMovement.y);
             if (!CollidesWithTilesStrict(testY, tilemap, 0, 0, false) &&
-                !CollidesWithNPC(testY, npcPositions))
+                !CollidesWithNPC(testY, npcGrid))
                 finalSnap.y = snapMovement.y;
 
             m_Position += finalSnap;
@@ -2082,7 +2158,7 @@ void PlayerCharacter::HandleIdleSnap(float deltaTime, const Tilemap *tilemap,
             // Final exact snap when progress complete and position is safe
             if (m_SnapProgress >= 1.0f &&
                 !CollidesWithTilesStrict(targetCenter, tilemap, 0, 0, false) &&
-                !CollidesWithNPC(targetCenter, npcPositions))
+                !CollidesWithNPC(targetCenter, npcGrid))
             {
                 m_Position = targetCenter;
             }
@@ -2097,7 +2173,7 @@ void PlayerCharacter::HandleIdleSnap(float deltaTime, const Tilemap *tilemap,
         // Close enough to center - snap exactly to avoid fractional positions
         if (tilemap &&
             !CollidesWithTilesStrict(targetCenter, tilemap, 0, 0, false) &&
-            !CollidesWithNPC(targetCenter, npcPositions))
+            !CollidesWithNPC(targetCenter, npcGrid))
         {
             m_Position = targetCenter;
         }
@@ -3,7 +3,9 @@
 #include "Texture.h"
 #include "GameCharacter.h"
 #include "IRenderer.h"
+#include "SpriteSheetRegistry.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <string>
@@ -185,9 +187,9 @@ public:
      * @param direction Input direction vector (should be normalized or zero).
      * @param deltaTime Time elapsed since last frame in seconds.
      * @param tilemap Optional tilemap for collision detection.
-     * @param npcPositions Optional list of NPC feet positions for collision.
+     * @param npcGrid Optional spatial hash of NPC feet positions for collision.
      */
-    void Move(glm::vec2 direction, float deltaTime, const class Tilemap *tilemap = nullptr, const std::vector<glm::vec2> *npcPositions = nullptr);
+    void Move(glm::vec2 direction, float deltaTime, const class Tilemap *tilemap = nullptr, const class SpatialHash *npcGrid = nullptr);
 
     /**
      * @brief Immediately stop movement and reset to idle animation.
@@ -220,8 +222,13 @@ public:
 
     /**
      * @brief Switch to a different character appearance.
+     *
+     * Sheets still being decoded (see SpriteSheetRegistry::SetLoader()) are
+     * swapped in together once all of them are ready; until then the old
+     * appearance stays.
+     *
      * @param characterType The character type to switch to.
-     * @return true if all required sprites loaded successfully.
+     * @return true if all required sprite files were found.
      */
     bool SwitchCharacter(CharacterType characterType);
 
@@ -233,6 +240,10 @@ public:
 
     /**
      * @brief Copy appearance from an NPC sprite sheet.
+     *
+     * The sheet comes from SpriteSheetRegistry, so it is the same texture
+     * the NPCs of that type draw with, and it serves all three modes.
+     *
      * @param spritePath Path to the NPC sprite sheet.
      * @return true if sprite loaded successfully.
      */
@@ -316,9 +327,16 @@ private:
      * @name Sprite Sheet Textures
      * @{
      */
-    Texture m_SpriteSheet;         ///< Walking/idle sprite sheet
-    Texture m_RunningSpriteSheet;  ///< Running sprite sheet
-    Texture m_BicycleSpriteSheet;  ///< Bicycle sprite sheet
+    SpriteSheetRegistry::Handle m_SpriteSheet;         ///< Walking/idle sprite sheet
+    SpriteSheetRegistry::Handle m_RunningSpriteSheet;  ///< Running sprite sheet
+    SpriteSheetRegistry::Handle m_BicycleSpriteSheet;  ///< Bicycle sprite sheet
+    std::uint64_t m_SheetRequest = 0;                  ///< Bumped per appearance change; stale switches are dropped
+
+    /// Sheet for the current movement mode (an empty texture if not loaded).
+    const Texture &GetActiveSpriteSheet() const;
+
+    /// Draw-path helper: stamp all three sheets for this frame so the texture budget keeps them loaded
+    void MarkSpriteSheetsUsed() const;
     /** @} */
 
     /**
@@ -364,32 +382,32 @@ private:
 
     /// @name Collision Detection Helpers
     /// @{
-    bool CollidesWithNPC(const glm::vec2 &feetPos, const std::vector<glm::vec2> *npcPositions) const;
+    bool CollidesWithNPC(const glm::vec2 &feetPos, const class SpatialHash *npcGrid) const;
     bool CollidesWithTilesStrict(const glm::vec2 &feetPos, const class Tilemap *tilemap,
                                   int moveDx, int moveDy, bool diagonalInput) const;
     bool CollidesWithTilesCenter(const glm::vec2 &feetPos, const class Tilemap *tilemap) const;
     bool CollidesAt(const glm::vec2 &feetPos, const class Tilemap *tilemap,
-                    const std::vector<glm::vec2> *npcPositions, bool sprintMode,
+                    const class SpatialHash *npcGrid, bool sprintMode,
                     int moveDx = 0, int moveDy = 0, bool diagonalInput = false) const;
     bool IsCornerPenetration(const glm::vec2 &feetPos, const class Tilemap *tilemap) const;
     glm::vec2 ComputeSprintCornerEject(const class Tilemap *tilemap,
-                                       const std::vector<glm::vec2> *npcPositions,
+                                       const class SpatialHash *npcGrid,
                                        glm::vec2 normalizedDir) const;
     glm::vec2 GetCornerSlideDirection(const glm::vec2& testPos, const class Tilemap* tilemap,
                                        int moveDirX, int moveDirY);
     glm::vec2 FindClosestSafeTileCenter(const class Tilemap *tilemap,
-                                        const std::vector<glm::vec2> *npcPositions) const;
+                                        const class SpatialHash *npcGrid) const;
     static float CalculateFollowAlpha(float deltaTime, float settleTime, float epsilon = 0.01f);
     glm::vec2 TrySlideMovement(glm::vec2 desiredMovement, glm::vec2 normalizedDir,
                                 float deltaTime, float currentSpeed,
-                                const class Tilemap *tilemap, const std::vector<glm::vec2> *npcPositions,
+                                const class Tilemap *tilemap, const class SpatialHash *npcGrid,
                                 bool sprintMode, int moveDx, int moveDy, bool diagonalInput);
     glm::vec2 ApplyLaneSnapping(glm::vec2 desiredMovement, glm::vec2 normalizedDir,
         float deltaTime, const Tilemap *tilemap,
-        const std::vector<glm::vec2> *npcPositions,
+        const class SpatialHash *npcGrid,
         bool sprintMode, int moveDx, int moveDy);
     void HandleIdleSnap(float deltaTime, const class Tilemap *tilemap,
-                        const std::vector<glm::vec2> *npcPositions);
+                        const class SpatialHash *npcGrid);
     /// @}
 
     static std::map<std::pair<CharacterType, std::string>, std::string> s_CharacterAssets;
@@ -0,0 +1,254 @@
+#include "Profiler.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace
+{
+struct Event
+{
+    const char *name;
+    std::int64_t start;
+    std::int64_t end;
+};
+
+constexpr std::size_t EVENTS_PER_CHUNK = 4096;
+constexpr std::size_t MAX_CHUNKS = Profiler::MAX_EVENTS_PER_THREAD / EVENTS_PER_CHUNK;
+
+// Written only by the owning thread; the exporting thread reads the first
+// `count` events after an acquire load
+struct ThreadBuffer
+{
+    std::array<std::unique_ptr<Event[]>, MAX_CHUNKS> chunks;
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<std::uint32_t> capture{0};  ///< Capture the events belong to
+    std::string name;                       ///< Guarded by Registry::mutex
+    std::uint32_t id = 0;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// Leaked on purpose: threads may still record while static destructors run
+Registry &GetRegistry()
+{
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+std::atomic<bool> s_Capturing{false};
+std::atomic<std::uint32_t> s_Capture{0};
+std::int64_t s_CaptureStart = 0;
+
+ThreadBuffer &LocalBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        Registry &registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto owned = std::make_unique<ThreadBuffer>();
+        owned->id = static_cast<std::uint32_t>(registry.buffers.size());
+        buffer = owned.get();
+        registry.buffers.push_back(std::move(owned));
+    }
+    return *buffer;
+}
+
+void WriteJsonString(std::ostream &out, const char *text)
+{
+    out << '"';
+    for (const char *c = text; *c; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) < 0x20)
+            out << ' ';
+        else
+            out << *c;
+    }
+    out << '"';
+}
+}
+
+Profiler::Scope::Scope(const char *name)
+    : m_Name(s_Capturing.load(std::memory_order_relaxed) ? name : nullptr)
+{
+    if (m_Name)
+    {
+        m_Start = Now();
+    }
+}
+
+Profiler::Scope::~Scope()
+{
+    if (m_Name)
+    {
+        Record(m_Name, m_Start, Now());
+    }
+}
+
+std::int64_t Profiler::Now()
+{
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+void Profiler::BeginCapture()
+{
+    // Buffers notice the new capture number and restart on their next event
+    s_CaptureStart = Now();
+    s_Capture.fetch_add(1, std::memory_order_relaxed);
+    s_Capturing.store(true, std::memory_order_release);
+}
+
+void Profiler::EndCapture()
+{
+    s_Capturing.store(false, std::memory_order_release);
+}
+
+bool Profiler::IsCapturing()
+{
+    return s_Capturing.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(const char *name)
+{
+    ThreadBuffer &buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+    buffer.name = name;
+}
+
+void Profiler::Record(const char *name, std::int64_t start, std::int64_t end)
+{
+    ThreadBuffer &buffer = LocalBuffer();
+
+    const std::uint32_t capture = s_Capture.load(std::memory_order_relaxed);
+    if (buffer.capture.load(std::memory_order_relaxed) != capture)
+    {
+        buffer.count.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.capture.store(capture, std::memory_order_release);
+    }
+
+    const std::size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index >= MAX_EVENTS_PER_THREAD)
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::unique_ptr<Event[]> &chunk = buffer.chunks[index / EVENTS_PER_CHUNK];
+    if (!chunk)
+    {
+        chunk = std::make_unique<Event[]>(EVENTS_PER_CHUNK);
+    }
+    chunk[index % EVENTS_PER_CHUNK] = {name, start, end};
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+std::size_t Profiler::GetEventCount()
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const std::uint32_t capture = s_Capture.load(std::memory_order_relaxed);
+    std::size_t total = 0;
+    for (const auto &buffer : registry.buffers)
+    {
+        if (buffer->capture.load(std::memory_order_acquire) == capture)
+            total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+std::size_t Profiler::GetDroppedCount()
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const std::uint32_t capture = s_Capture.load(std::memory_order_relaxed);
+    std::size_t total = 0;
+    for (const auto &buffer : registry.buffers)
+    {
+        if (buffer->capture.load(std::memory_order_acquire) == capture)
+            total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Profiler::WriteChromeTrace(std::ostream &out)
+{
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const std::uint32_t capture = s_Capture.load(std::memory_order_relaxed);
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]()
+    {
+        if (!first)
+            out << ",\n";
+        first = false;
+    };
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    for (const auto &buffer : registry.buffers)
+    {
+        if (!buffer->name.empty())
+        {
+            separator();
+            out << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":\"thread_name\",\"args\":{\"name\":";
+            WriteJsonString(out, buffer->name.c_str());
+            out << "}}";
+        }
+
+        if (buffer->capture.load(std::memory_order_acquire) != capture)
+            continue;
+
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Event &event = buffer->chunks[i / EVENTS_PER_CHUNK][i % EVENTS_PER_CHUNK];
+            separator();
+            out << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id << ",\"name\":";
+            WriteJsonString(out, event.name);
+            out << ",\"ts\":" << static_cast<double>(event.start - s_CaptureStart) * 1e-3
+                << ",\"dur\":" << static_cast<double>(event.end - event.start) * 1e-3 << "}";
+        }
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+    out << "\n]}\n";
+}
+
+bool Profiler::SaveChromeTrace(const std::string &path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Profiler: could not open " << path << " for writing" << std::endl;
+        return false;
+    }
+    WriteChromeTrace(file);
+    if (!file)
+    {
+        std::cerr << "Profiler: failed writing " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct RenderStats
+ * @brief Per-frame submission counters kept by every backend.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Backends reset the counters in BeginFrame() and count each batch flush
+ * that actually issued a draw, together with the reason the batch was
+ * closed. Non-batched draws (static meshes, instances, star field) only
+ * add their vertices. Read through IRenderer::GetRenderStats().
+ *
+ * | Reason        | Batch was closed because...                           |
+ * |---------------|-------------------------------------------------------|
+ * | TextureChange | the next sprite needs a texture with no free slot     |
+ * | BlendChange   | the next quad uses the other blend mode               |
+ * | BufferFull    | the vertex buffer or stream segment ran out of room   |
+ * | BatchSwitch   | a different batch type (sprite/rect/particle) started |
+ * | StateChange   | projection, render target, pass or non-batched draw   |
+ * | FrameEnd      | EndFrame() flushed what was left                      |
+ *
+ * @par Vulkan Resources
+ * The Vulkan backend also reports its descriptor set cache and frame
+ * pacing. The cache size, capacity, secondaries and frames in flight are
+ * levels sampled in EndFrame(); the other descriptor counters count
+ * events during the frame. They stay zero on other backends.
+ */
+struct RenderStats
+{
+    enum class FlushReason : std::uint8_t
+    {
+        TextureChange,
+        BlendChange,
+        BufferFull,
+        BatchSwitch,
+        StateChange,
+        FrameEnd,
+        Count
+    };
+
+    static constexpr std::size_t REASON_COUNT = static_cast<std::size_t>(FlushReason::Count);
+
+    std::uint32_t flushes[REASON_COUNT] = {};  ///< Batch flushes by reason.
+    std::uint64_t vertices = 0;                ///< Vertices submitted by all draws.
+
+    std::uint32_t framesInFlight = 0;           ///< Frames the CPU may record ahead of the GPU.
+    std::uint32_t secondaryCommandBuffers = 0;  ///< Secondaries the primary buffer executed.
+    std::uint32_t descriptorSetsCached = 0;     ///< Persistent sets in the cache.
+    std::uint32_t descriptorSetCapacity = 0;    ///< Most sets the cache keeps.
+    std::uint32_t descriptorSetsCreated = 0;    ///< Persistent sets allocated this frame.
+    std::uint32_t descriptorSetsEvicted = 0;    ///< Least recently used sets dropped this frame.
+    std::uint32_t transientDescriptorSets = 0;  ///< Sets from this frame's transient pool.
+
+    /// @brief Clear the counters for a new frame.
+    void Reset() { *this = RenderStats{}; }
+
+    /// @brief Count one batch flush of @p vertexCount vertices.
+    void CountFlush(FlushReason reason, std::size_t vertexCount)
+    {
+        ++flushes[static_cast<std::size_t>(reason)];
+        vertices += vertexCount;
+    }
+
+    /// @brief Flushes counted for @p reason.
+    std::uint32_t GetFlushes(FlushReason reason) const { return flushes[static_cast<std::size_t>(reason)]; }
+
+    /// @brief Short display label for @p reason.
+    static const char *GetReasonName(FlushReason reason)
+    {
+        switch (reason)
+        {
+            case FlushReason::TextureChange:
+                return "texture";
+            case FlushReason::BlendChange:
+                return "blend";
+            case FlushReason::BufferFull:
+                return "full";
+            case FlushReason::BatchSwitch:
+                return "switch";
+            case FlushReason::StateChange:
+                return "state";
+            case FlushReason::FrameEnd:
+                return "end";
+            default:
+                return "?";
+        }
+    }
+};
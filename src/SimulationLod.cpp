@@ -0,0 +1,47 @@
+#include "SimulationLod.h"
+
+#include <algorithm>
+
+void SimulationLod::BeginFrame(glm::vec2 viewMin, glm::vec2 viewMax)
+{
+    m_ViewMin = viewMin;
+    m_ViewMax = viewMax;
+    ++m_Frame;
+}
+
+SimLod SimulationLod::Classify(glm::vec2 position) const
+{
+    if (!m_Enabled)
+    {
+        return SimLod::Full;
+    }
+
+    // Chebyshev distance to the view rectangle (0 inside it)
+    float dx = std::max({m_ViewMin.x - position.x, position.x - m_ViewMax.x, 0.0f});
+    float dy = std::max({m_ViewMin.y - position.y, position.y - m_ViewMax.y, 0.0f});
+    float distance = std::max(dx, dy);
+
+    if (distance <= m_FullMargin)
+    {
+        return SimLod::Full;
+    }
+    if (distance <= m_FullMargin + m_ReducedDistance)
+    {
+        return SimLod::Reduced;
+    }
+    return SimLod::Dormant;
+}
+
+bool SimulationLod::IsDue(SimLod lod, std::size_t slot) const
+{
+    switch (lod)
+    {
+        case SimLod::Reduced:
+            return (m_Frame + slot) % m_ReducedInterval == 0;
+        case SimLod::Dormant:
+            return (m_Frame + slot) % m_DormantInterval == 0;
+        case SimLod::Full:
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief How much simulation an NPC gets this frame.
+ * @ingroup Entities
+ */
+enum class SimLod : std::uint8_t
+{
+    Full,     ///< On screen (or at its edge): full update every frame
+    Reduced,  ///< Near the view: full update every few frames with the accumulated time
+    Dormant   ///< Far away: patrol position advanced analytically, no animation
+};
+
+/**
+ * @class SimulationLod
+ * @brief Picks a simulation level per NPC from its distance to the view.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Entities
+ *
+ * Distances are measured from the NPC's feet to the view rectangle, so
+ * anything inside it (plus a margin covering sprites that straddle the edge)
+ * is Full. The band beyond that is Reduced, everything else Dormant.
+ *
+ * @par Staggering
+ * Reduced and Dormant NPCs are only due every Nth frame. The frame an NPC
+ * is due on is offset by its slot index, so the work is spread evenly over
+ * the interval instead of arriving in bursts.
+ *
+ * @par Seamless Promotion
+ * Skipped frames are not lost: the caller keeps the time an NPC was not
+ * simulated and hands all of it over when the NPC is next due. An NPC that
+ * becomes Full is always due, so it catches up before it is seen.
+ *
+ * @see NonPlayerCharacter::UpdateDormant(), Game::UpdateNPC()
+ */
+class SimulationLod
+{
+public:
+    /// @brief Default margin around the view that still counts as on screen (px).
+    static constexpr float DEFAULT_FULL_MARGIN = 32.0f;
+
+    /// @brief Default width of the Reduced band beyond the margin (px).
+    static constexpr float DEFAULT_REDUCED_DISTANCE = 320.0f;
+
+    /// @brief Default frames between updates of a Reduced NPC.
+    static constexpr std::uint32_t DEFAULT_REDUCED_INTERVAL = 4;
+
+    /// @brief Default frames between updates of a Dormant NPC.
+    static constexpr std::uint32_t DEFAULT_DORMANT_INTERVAL = 16;
+
+    /**
+     * @brief Start a frame with the current view rectangle (world px).
+     * @param viewMin Top-left corner of the view.
+     * @param viewMax Bottom-right corner of the view.
+     */
+    void BeginFrame(glm::vec2 viewMin, glm::vec2 viewMax);
+
+    /// @brief Level for an NPC whose feet are at @p position.
+    [[nodiscard]] SimLod Classify(glm::vec2 position) const;
+
+    /// @brief `true` if an NPC in @p slot at level @p lod should be simulated this frame.
+    [[nodiscard]] bool IsDue(SimLod lod, std::size_t slot) const;
+
+    /// @brief When disabled every NPC is Full.
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+    [[nodiscard]] bool IsEnabled() const { return m_Enabled; }
+
+    void SetFullMargin(float pixels) { m_FullMargin = pixels; }
+    void SetReducedDistance(float pixels) { m_ReducedDistance = pixels; }
+    void SetReducedInterval(std::uint32_t frames) { m_ReducedInterval = frames > 0 ? frames : 1; }
+    void SetDormantInterval(std::uint32_t frames) { m_DormantInterval = frames > 0 ? frames : 1; }
+
+private:
+    glm::vec2 m_ViewMin{0.0f};
+    glm::vec2 m_ViewMax{0.0f};
+    float m_FullMargin = DEFAULT_FULL_MARGIN;
+    float m_ReducedDistance = DEFAULT_REDUCED_DISTANCE;
+    std::uint32_t m_ReducedInterval = DEFAULT_REDUCED_INTERVAL;
+    std::uint32_t m_DormantInterval = DEFAULT_DORMANT_INTERVAL;
+    std::uint32_t m_Frame = 0;
+    bool m_Enabled = true;
+};
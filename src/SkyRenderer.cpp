@@ -1,5 +1,7 @@
 #include "SkyRenderer.h"
+#include "TextureBaker.h"
 #include "TimeManager.h"
+#include "Profiler.h"
 
 #include <cmath>
 #include <random>
@@ -14,63 +16,94 @@ SkyRenderer::SkyRenderer()
     , m_ShootingStarTimer(0.0f)
     , m_LastScreenWidth(0.0f)
     , m_LastScreenHeight(0.0f)
+    , m_CacheEnabled(true)
+    , m_CacheTarget(-1)
+    , m_CacheWidth(0)
+    , m_CacheHeight(0)
+    , m_CacheValid(false)
+    , m_CacheEmpty(true)
+    , m_CacheStarVisibility(0.0f)
+    , m_CacheDawnIntensity(0.0f)
+    , m_CacheWeather(0)
+    , m_GpuStarField(true)
+    , m_GpuStarsActive(false)
+    , m_StarFieldUploaded(false)
     , m_Initialized(false)
 {
+    for (Texture *texture : {&m_RayTexture, &m_StarTexture, &m_StarGlowTexture, &m_ShootingStarTexture, &m_GlowTexture})
+    {
+        texture->SetMemoryTag(MemoryTracker::Subsystem::Sky);
+    }
 }
 
 SkyRenderer::~SkyRenderer()
 {
 }
 
-void SkyRenderer::Initialize()
+namespace
+{
+// Shared tail of every generator: white RGB, alpha from a float row
+void StoreWhiteAlphaRow(const float *alpha, int width, unsigned char *rgba)
+{
+    for (int x = 0; x < width; x++)
+    {
+        rgba[x * 4 + 0] = 255;
+        rgba[x * 4 + 1] = 255;
+        rgba[x * 4 + 2] = 255;
+        rgba[x * 4 + 3] = static_cast<unsigned char>(std::clamp(alpha[x] * 255.0f, 0.0f, 255.0f));
+    }
+}
+
+void BeginImage(ImageCache::Image &image, int width, int height)
+{
+    image.width = width;
+    image.height = height;
+    image.channels = 4;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+}
+
+void LoadTexture(Texture &texture, ImageCache::Image &image)
+{
+    if (!image.pixels.empty())
+        texture.LoadFromData(image.pixels.data(), image.width, image.height, image.channels, false);
+}
+}  // namespace
+
+void SkyRenderer::Initialize(JobSystem *jobs)
 {
     if (m_Initialized)
         return;
 
-    GenerateRayTexture();
-    GenerateStarTexture();
-    GenerateStarGlowTexture();
-    GenerateShootingStarTexture();
+    // Pixels come from the cache or from generators running in parallel;
+    // the textures are created here, on the thread that owns the context
+    ImageCache::Image ray, star, starGlow, shootingStar, glow;
+    TextureBaker baker;
+    baker.AddGenerated("sky.ray",
+                       ImageCache::HashParams({TEXTURE_REVISION, RAY_TEXTURE_WIDTH, RAY_TEXTURE_HEIGHT}),
+                       GenerateRayPixels, ray);
+    baker.AddGenerated("sky.star", ImageCache::HashParams({TEXTURE_REVISION, STAR_TEXTURE_SIZE}),
+                       GenerateStarPixels, star);
+    baker.AddGenerated("sky.star_glow", ImageCache::HashParams({TEXTURE_REVISION, STAR_GLOW_TEXTURE_SIZE}),
+                       GenerateStarGlowPixels, starGlow);
+    baker.AddGenerated("sky.shooting_star",
+                       ImageCache::HashParams({TEXTURE_REVISION, SHOOTING_STAR_TEXTURE_WIDTH,
+                                               SHOOTING_STAR_TEXTURE_HEIGHT}),
+                       GenerateShootingStarPixels, shootingStar);
+    baker.AddGenerated("sky.glow", ImageCache::HashParams({TEXTURE_REVISION, GLOW_TEXTURE_SIZE}),
+                       GenerateGlowPixels, glow);
+    baker.Run(jobs);
+
+    LoadTexture(m_RayTexture, ray);
+    LoadTexture(m_StarTexture, star);
+    LoadTexture(m_StarGlowTexture, starGlow);
+    LoadTexture(m_ShootingStarTexture, shootingStar);
+    LoadTexture(m_GlowTexture, glow);
+
     GenerateLightRays();
     GenerateStars(STAR_COUNT);
     GenerateBackgroundStars(BACKGROUND_STAR_COUNT);
     GenerateDewSparkles();
 
-    // Generate glow texture for light source
-    std::vector<unsigned char> glowPixels(GLOW_TEXTURE_SIZE * GLOW_TEXTURE_SIZE * 4);
-    float center = GLOW_TEXTURE_SIZE / 2.0f;
-
-    for (int y = 0; y < GLOW_TEXTURE_SIZE; y++)
-    {
-        for (int x = 0; x < GLOW_TEXTURE_SIZE; x++)
-        {
-            float dx = x - center;
-            float dy = y - center;
-            float dist = std::sqrt(dx * dx + dy * dy) / center;
-
-            int idx = (y * GLOW_TEXTURE_SIZE + x) * 4;
-
-            // Multi-layered glow falloff for realistic light bloom
-            float core = std::max(0.0f, 1.0f - dist * 2.0f);
-            core = core * core * core;
-
-            float inner = std::max(0.0f, 1.0f - dist * 1.2f);
-            inner = inner * inner;
-
-            float outer = std::max(0.0f, 1.0f - dist);
-            outer = std::exp(-dist * 3.0f);
-
-            float alpha = core * 0.8f + inner * 0.5f + outer * 0.3f;
-            alpha = std::min(1.0f, alpha);
-
-            glowPixels[idx + 0] = 255;
-            glowPixels[idx + 1] = 255;
-            glowPixels[idx + 2] = 255;
-            glowPixels[idx + 3] = static_cast<unsigned char>(alpha * 255);
-        }
-    }
-    m_GlowTexture.LoadFromData(glowPixels.data(), GLOW_TEXTURE_SIZE, GLOW_TEXTURE_SIZE, 4, false);
-
     m_Initialized = true;
 }
 
@@ -84,10 +117,34 @@ void SkyRenderer::UploadTextures(IRenderer &renderer)
     renderer.UploadTexture(m_StarGlowTexture);
     renderer.UploadTexture(m_ShootingStarTexture);
     renderer.UploadTexture(m_GlowTexture);
+
+    // Called after a backend switch: the old renderer took the target and
+    // the star buffer with it
+    m_CacheTarget = -1;
+    m_CacheValid = false;
+    m_StarFieldUploaded = false;
+}
+
+void SkyRenderer::SetLayerCache(bool enabled)
+{
+    m_CacheEnabled = enabled;
+    m_CacheValid = false;
+}
+
+void SkyRenderer::SetGpuStarField(bool enabled)
+{
+    m_GpuStarField = enabled;
+}
+
+size_t SkyRenderer::GetMemoryBytes() const
+{
+    return MemoryTracker::CapacityBytes(m_Stars, m_BackgroundStars, m_SunRays, m_MoonRays, m_ShootingStars,
+                                        m_DewSparkles);
 }
 
 void SkyRenderer::Update(float deltaTime, const TimeManager &time)
 {
+    WILD_PROFILE_ZONE("Sky Update");
     m_Time += deltaTime;
 
     // Update shooting stars during night
@@ -99,6 +156,7 @@ void SkyRenderer::Update(float deltaTime, const TimeManager &time)
 
 void SkyRenderer::Render(IRenderer &renderer, const TimeManager &time, int screenWidth, int screenHeight)
 {
+    WILD_PROFILE_ZONE("Sky Render");
     if (!m_Initialized)
         return;
 
@@ -109,25 +167,59 @@ void SkyRenderer::Render(IRenderer &renderer, const TimeManager &time, int scree
     // Disable ambient color for sky rendering
     renderer.SetAmbientColor(glm::vec3(1.0f));
 
-    // Dawn/morning gradient effects (rendered first as background)
-    float dawnIntensity = time.GetDawnIntensity();
-    if (dawnIntensity > 0.01f)
+    // Background stars move out of the cache in GPU mode, so a mode change
+    // invalidates the bake
+    const bool gpuStars = m_GpuStarField && renderer.SupportsStarField();
+    if (gpuStars != m_GpuStarsActive)
     {
-        RenderDawnGradient(renderer, time, screenWidth, screenHeight);
-        RenderDawnHorizonGlow(renderer, time, screenWidth, screenHeight);
+        m_GpuStarsActive = gpuStars;
+        m_CacheValid = false;
+    }
+    if (gpuStars && !m_StarFieldUploaded)
+    {
+        UploadStarField(renderer);
+    }
+
+    // Every layer is additive, so the baked layers can be composited in one
+    // quad regardless of what is drawn live on top of them
+    const bool cached = m_CacheEnabled && UpdateLayerCache(renderer, time, screenWidth, screenHeight);
+    if (cached)
+    {
+        if (!m_CacheEmpty)
+        {
+            renderer.DrawRenderTarget(m_CacheTarget, glm::vec2(0.0f),
+                                      glm::vec2(static_cast<float>(screenWidth), static_cast<float>(screenHeight)),
+                                      true);
+        }
+    }
+    else
+    {
+        RenderCachedLayers(renderer, time, screenWidth, screenHeight, true);
     }
 
-    // Render atmospheric glow (subtle night sky color)
     float starVisibility = time.GetStarVisibility();
     if (starVisibility > 0.1f)
     {
-        RenderAtmosphericGlow(renderer, time, screenWidth, screenHeight);
+        RenderAuroraShimmer(renderer, time, screenWidth, screenHeight);
     }
 
-    // Render stars (background, only at night - fades during dawn)
+    // Render stars (only at night - fades during dawn)
     if (starVisibility > 0.01f)
     {
-        RenderStars(renderer, time, screenWidth, screenHeight);
+        if (gpuStars)
+        {
+            IRenderer::StarFieldParams params;
+            params.screenSize = glm::vec2(static_cast<float>(screenWidth), static_cast<float>(screenHeight));
+            params.time = m_Time;
+            params.intensity = GetStarIntensity(time);
+            params.backgroundCount = static_cast<std::uint32_t>(m_BackgroundStars.size());
+            params.foregroundCount = static_cast<std::uint32_t>(m_Stars.size());
+            renderer.DrawStarField(m_StarTexture, m_StarGlowTexture, params);
+        }
+        else
+        {
+            RenderForegroundStars(renderer, time, screenWidth, screenHeight);
+        }
         RenderShootingStars(renderer, time, screenWidth, screenHeight);
     }
 
@@ -152,68 +244,146 @@ void SkyRenderer::Render(IRenderer &renderer, const TimeManager &time, int scree
     }
 }
 
-void SkyRenderer::GenerateRayTexture()
+void SkyRenderer::RenderCachedLayers(IRenderer &renderer, const TimeManager &time, int screenWidth, int screenHeight,
+                                     bool animate)
 {
-    // Create a VERTICAL ray texture - soft, wide gradient
-    std::vector<unsigned char> pixels(RAY_TEXTURE_WIDTH * RAY_TEXTURE_HEIGHT * 4);
-    float centerX = RAY_TEXTURE_WIDTH / 2.0f;
+    // Dawn/morning gradient effects (rendered first as background)
+    float dawnIntensity = time.GetDawnIntensity();
+    if (dawnIntensity > 0.01f)
+    {
+        RenderDawnGradient(renderer, time, screenWidth, screenHeight);
+        RenderDawnHorizonGlow(renderer, time, screenWidth, screenHeight);
+    }
 
-    for (int y = 0; y < RAY_TEXTURE_HEIGHT; y++)
+    // Render atmospheric glow (subtle night sky color)
+    float starVisibility = time.GetStarVisibility();
+    if (starVisibility > 0.1f)
     {
-        for (int x = 0; x < RAY_TEXTURE_WIDTH; x++)
+        RenderAtmosphericGlow(renderer, time, screenWidth, screenHeight);
+    }
+
+    // The GPU star field draws the background layer with the foreground one
+    if (starVisibility > 0.01f && !m_GpuStarsActive)
+    {
+        RenderBackgroundStars(renderer, time, screenWidth, screenHeight, animate);
+    }
+}
+
+bool SkyRenderer::UpdateLayerCache(IRenderer &renderer, const TimeManager &time, int screenWidth, int screenHeight)
+{
+    if (m_CacheTarget < 0 || screenWidth != m_CacheWidth || screenHeight != m_CacheHeight)
+    {
+        if (m_CacheTarget >= 0)
+            renderer.DestroyRenderTarget(m_CacheTarget);
+        m_CacheTarget = renderer.CreateRenderTarget(screenWidth, screenHeight);
+        m_CacheWidth = screenWidth;
+        m_CacheHeight = screenHeight;
+        m_CacheValid = false;
+        if (m_CacheTarget < 0)
         {
-            int idx = (y * RAY_TEXTURE_WIDTH + x) * 4;
+            // No offscreen support in this backend, stop trying until the next switch
+            m_CacheEnabled = false;
+            return false;
+        }
+    }
 
-            // Progress along ray (0 = top/start, 1 = bottom/end)
-            float progress = static_cast<float>(y) / RAY_TEXTURE_HEIGHT;
+    const float starVisibility = time.GetStarVisibility();
+    const float dawnIntensity = time.GetDawnIntensity();
+    const int weather = static_cast<int>(time.GetWeather());
+    if (m_CacheValid && weather == m_CacheWeather &&
+        std::abs(starVisibility - m_CacheStarVisibility) <= CACHE_REBAKE_THRESHOLD &&
+        std::abs(dawnIntensity - m_CacheDawnIntensity) <= CACHE_REBAKE_THRESHOLD)
+    {
+        return true;
+    }
 
-            // Distance from center (0 = center, 1 = edge)
-            float distFromCenter = std::abs(x - centerX) / centerX;
+    m_CacheStarVisibility = starVisibility;
+    m_CacheDawnIntensity = dawnIntensity;
+    m_CacheWeather = weather;
+    m_CacheValid = true;
 
-            // Vertical fade: bright at top, fading toward bottom
-            // Smooth curve that starts bright and gradually fades
-            float verticalFade = 1.0f - progress;
-            verticalFade = std::pow(verticalFade, 0.4f); // Gentle fade curve
+    // Same gates as RenderCachedLayers(): nothing to bake in daylight
+    m_CacheEmpty = dawnIntensity <= 0.01f && starVisibility <= (m_GpuStarsActive ? 0.1f : 0.01f);
+    if (m_CacheEmpty)
+        return true;
 
-            // Horizontal fade: very soft gaussian for diffuse ray edges
-            float horizontalFade = std::exp(-distFromCenter * distFromCenter * 3.0f);
+    if (!renderer.BeginRenderTarget(m_CacheTarget))
+    {
+        m_CacheValid = false;
+        return false;
+    }
+    RenderCachedLayers(renderer, time, screenWidth, screenHeight, false);
+    renderer.EndRenderTarget();
+    return true;
+}
 
-            // Combine with smooth multiplication
-            float alpha = verticalFade * horizontalFade;
+void SkyRenderer::GenerateRayPixels(ImageCache::Image &image)
+{
+    // Create a VERTICAL ray texture - soft, wide gradient
+    BeginImage(image, RAY_TEXTURE_WIDTH, RAY_TEXTURE_HEIGHT);
+    const float centerX = RAY_TEXTURE_WIDTH / 2.0f;
 
-            // Additional softening at the very bottom
-            if (progress > 0.7f)
-            {
-                float bottomFade = 1.0f - (progress - 0.7f) / 0.3f;
-                alpha *= bottomFade * bottomFade;
-            }
+    // The falloff is separable: one horizontal profile scaled per row
+    float horizontalFade[RAY_TEXTURE_WIDTH];
+    for (int x = 0; x < RAY_TEXTURE_WIDTH; x++)
+    {
+        // Distance from center (0 = center, 1 = edge)
+        float distFromCenter = std::abs(x - centerX) / centerX;
 
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = 255;
-            pixels[idx + 2] = 255;
-            pixels[idx + 3] = static_cast<unsigned char>(std::max(0.0f, std::min(alpha * 255.0f, 255.0f)));
-        }
+        // Horizontal fade: very soft gaussian for diffuse ray edges
+        horizontalFade[x] = std::exp(-distFromCenter * distFromCenter * 3.0f);
     }
 
-    m_RayTexture.LoadFromData(pixels.data(), RAY_TEXTURE_WIDTH, RAY_TEXTURE_HEIGHT, 4, false);
+    float alpha[RAY_TEXTURE_WIDTH];
+    for (int y = 0; y < RAY_TEXTURE_HEIGHT; y++)
+    {
+        // Progress along ray (0 = top/start, 1 = bottom/end)
+        float progress = static_cast<float>(y) / RAY_TEXTURE_HEIGHT;
+
+        // Vertical fade: bright at top, fading toward bottom
+        // Smooth curve that starts bright and gradually fades
+        float verticalFade = std::pow(1.0f - progress, 0.4f);
+
+        // Additional softening at the very bottom
+        if (progress > 0.7f)
+        {
+            float bottomFade = 1.0f - (progress - 0.7f) / 0.3f;
+            verticalFade *= bottomFade * bottomFade;
+        }
+
+        for (int x = 0; x < RAY_TEXTURE_WIDTH; x++)
+            alpha[x] = verticalFade * horizontalFade[x];
+        StoreWhiteAlphaRow(alpha, RAY_TEXTURE_WIDTH, &image.pixels[y * RAY_TEXTURE_WIDTH * 4]);
+    }
 }
 
-void SkyRenderer::GenerateStarTexture()
+void SkyRenderer::GenerateStarPixels(ImageCache::Image &image)
 {
-    std::vector<unsigned char> pixels(STAR_TEXTURE_SIZE * STAR_TEXTURE_SIZE * 4);
-    float center = STAR_TEXTURE_SIZE / 2.0f;
-
+    BeginImage(image, STAR_TEXTURE_SIZE, STAR_TEXTURE_SIZE);
+    const float center = STAR_TEXTURE_SIZE / 2.0f;
+
+    // Spike directions, rotated 45 degrees for the 4-point spikes
+    const float spike4Cos = std::cos(0.785f);
+    const float spike4Sin = std::sin(0.785f);
+
+    // Branch-free row passes without atan2/cos/pow, so the compiler can
+    // vectorize them: with c = cos(angle), s = sin(angle),
+    //   cos(3 angle) = 4c^3 - 3c,
+    //   cos(2 angle + 0.785) = (c^2 - s^2) cos(0.785) - 2cs sin(0.785)
+    float alpha[STAR_TEXTURE_SIZE];
     for (int y = 0; y < STAR_TEXTURE_SIZE; y++)
     {
+        const float dy = y - center;
         for (int x = 0; x < STAR_TEXTURE_SIZE; x++)
         {
-            float dx = x - center;
-            float dy = y - center;
-            float distance = std::sqrt(dx * dx + dy * dy);
-            float maxDist = STAR_TEXTURE_SIZE / 2.0f;
-            float normalizedDist = distance / maxDist;
+            const float dx = x - center;
+            const float distance = std::sqrt(dx * dx + dy * dy);
+            const float normalizedDist = distance / center;
 
-            int idx = (y * STAR_TEXTURE_SIZE + x) * 4;
+            // atan2(0, 0) = 0, so the center pixel uses angle 0
+            const float invDist = distance > 0.0f ? 1.0f / distance : 0.0f;
+            const float c = distance > 0.0f ? dx * invDist : 1.0f;
+            const float s = dy * invDist;
 
             // Ultra-bright core with sharp falloff
             float core = std::exp(-normalizedDist * normalizedDist * 50.0f);
@@ -224,43 +394,40 @@ void SkyRenderer::GenerateStarTexture()
             // Soft outer halo
             float outer = std::exp(-normalizedDist * 3.0f) * 0.25f;
 
-            // 6-point star diffraction spikes (more realistic)
-            float angle = std::atan2(dy, dx);
-            float spike6 = std::pow(std::abs(std::cos(angle * 3.0f)), 12.0f);
+            // 6-point star diffraction spikes: |cos(3 angle)|^12
+            float cos3 = c * (4.0f * c * c - 3.0f);
+            float spike6 = cos3 * cos3;
+            spike6 = spike6 * spike6 * spike6;
+            spike6 *= spike6;
             float spikeIntensity = spike6 * std::exp(-normalizedDist * 0.8f) * 0.5f;
 
-            // Secondary 4-point spikes (subtle, rotated 45 degrees)
-            float spike4 = std::pow(std::abs(std::cos(angle * 2.0f + 0.785f)), 16.0f);
+            // Secondary 4-point spikes (subtle, rotated 45 degrees): |cos(2 angle + 0.785)|^16
+            float cos2 = (c * c - s * s) * spike4Cos - 2.0f * c * s * spike4Sin;
+            float spike4 = cos2 * cos2;
+            spike4 *= spike4;
+            spike4 *= spike4;
+            spike4 *= spike4;
             float spike4Intensity = spike4 * std::exp(-normalizedDist * 1.2f) * 0.2f;
 
-            float intensity = core + inner + outer + spikeIntensity + spike4Intensity;
-            intensity = std::min(1.0f, intensity);
-
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = 255;
-            pixels[idx + 2] = 255;
-            pixels[idx + 3] = static_cast<unsigned char>(std::max(0.0f, std::min(intensity * 255.0f, 255.0f)));
+            alpha[x] = std::min(1.0f, core + inner + outer + spikeIntensity + spike4Intensity);
         }
+        StoreWhiteAlphaRow(alpha, STAR_TEXTURE_SIZE, &image.pixels[y * STAR_TEXTURE_SIZE * 4]);
     }
-
-    m_StarTexture.LoadFromData(pixels.data(), STAR_TEXTURE_SIZE, STAR_TEXTURE_SIZE, 4, false);
 }
 
-void SkyRenderer::GenerateStarGlowTexture()
+void SkyRenderer::GenerateStarGlowPixels(ImageCache::Image &image)
 {
-    std::vector<unsigned char> pixels(STAR_GLOW_TEXTURE_SIZE * STAR_GLOW_TEXTURE_SIZE * 4);
-    float center = STAR_GLOW_TEXTURE_SIZE / 2.0f;
+    BeginImage(image, STAR_GLOW_TEXTURE_SIZE, STAR_GLOW_TEXTURE_SIZE);
+    const float center = STAR_GLOW_TEXTURE_SIZE / 2.0f;
 
+    float alpha[STAR_GLOW_TEXTURE_SIZE];
     for (int y = 0; y < STAR_GLOW_TEXTURE_SIZE; y++)
     {
+        const float dy = y - center;
         for (int x = 0; x < STAR_GLOW_TEXTURE_SIZE; x++)
         {
-            float dx = x - center;
-            float dy = y - center;
-            float distance = std::sqrt(dx * dx + dy * dy);
-            float normalizedDist = distance / center;
-
-            int idx = (y * STAR_GLOW_TEXTURE_SIZE + x) * 4;
+            const float dx = x - center;
+            const float normalizedDist = std::sqrt(dx * dx + dy * dy) / center;
 
             // Soft gaussian glow for bright star halos
             float glow = std::exp(-normalizedDist * normalizedDist * 2.5f);
@@ -268,53 +435,68 @@ void SkyRenderer::GenerateStarGlowTexture()
             // Additional soft outer ring
             float ring = std::exp(-normalizedDist * 1.5f) * 0.3f;
 
-            float intensity = glow + ring;
-            intensity = std::min(1.0f, intensity);
-
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = 255;
-            pixels[idx + 2] = 255;
-            pixels[idx + 3] = static_cast<unsigned char>(intensity * 255);
+            alpha[x] = std::min(1.0f, glow + ring);
         }
+        StoreWhiteAlphaRow(alpha, STAR_GLOW_TEXTURE_SIZE, &image.pixels[y * STAR_GLOW_TEXTURE_SIZE * 4]);
     }
-
-    m_StarGlowTexture.LoadFromData(pixels.data(), STAR_GLOW_TEXTURE_SIZE, STAR_GLOW_TEXTURE_SIZE, 4, false);
 }
 
-void SkyRenderer::GenerateShootingStarTexture()
+void SkyRenderer::GenerateShootingStarPixels(ImageCache::Image &image)
 {
     // Create a horizontal streak texture for shooting stars
-    const int width = 128;
-    const int height = 16;
-    std::vector<unsigned char> pixels(width * height * 4);
-
-    float centerY = height / 2.0f;
+    const int width = SHOOTING_STAR_TEXTURE_WIDTH;
+    const int height = SHOOTING_STAR_TEXTURE_HEIGHT;
+    BeginImage(image, width, height);
+    const float centerY = height / 2.0f;
+
+    // Bright head fading to dim tail; separable, so computed once per column
+    float lengthFade[SHOOTING_STAR_TEXTURE_WIDTH];
+    for (int x = 0; x < width; x++)
+    {
+        float progress = static_cast<float>(x) / width; // 0 at left (head), 1 at right (tail)
+        lengthFade[x] = std::exp(-progress * 2.5f);
+    }
 
+    float alpha[SHOOTING_STAR_TEXTURE_WIDTH];
     for (int y = 0; y < height; y++)
     {
+        // Thin streak
+        float distFromCenter = std::abs(y - centerY) / centerY;
+        float widthFade = std::exp(-distFromCenter * distFromCenter * 8.0f);
+
         for (int x = 0; x < width; x++)
-        {
-            int idx = (y * width + x) * 4;
+            alpha[x] = lengthFade[x] * widthFade;
+        StoreWhiteAlphaRow(alpha, width, &image.pixels[y * width * 4]);
+    }
+}
+
+void SkyRenderer::GenerateGlowPixels(ImageCache::Image &image)
+{
+    BeginImage(image, GLOW_TEXTURE_SIZE, GLOW_TEXTURE_SIZE);
+    const float center = GLOW_TEXTURE_SIZE / 2.0f;
 
-            float progress = static_cast<float>(x) / width; // 0 at left (head), 1 at right (tail)
-            float distFromCenter = std::abs(y - centerY) / centerY;
+    float alpha[GLOW_TEXTURE_SIZE];
+    for (int y = 0; y < GLOW_TEXTURE_SIZE; y++)
+    {
+        const float dy = y - center;
+        for (int x = 0; x < GLOW_TEXTURE_SIZE; x++)
+        {
+            const float dx = x - center;
+            const float dist = std::sqrt(dx * dx + dy * dy) / center;
 
-            // Bright head fading to dim tail
-            float lengthFade = std::exp(-progress * 2.5f);
+            // Multi-layered glow falloff for realistic light bloom
+            float core = std::max(0.0f, 1.0f - dist * 2.0f);
+            core = core * core * core;
 
-            // Thin streak
-            float widthFade = std::exp(-distFromCenter * distFromCenter * 8.0f);
+            float inner = std::max(0.0f, 1.0f - dist * 1.2f);
+            inner = inner * inner;
 
-            float intensity = lengthFade * widthFade;
+            float outer = std::exp(-dist * 3.0f);
 
-            pixels[idx + 0] = 255;
-            pixels[idx + 1] = 255;
-            pixels[idx + 2] = 255;
-            pixels[idx + 3] = static_cast<unsigned char>(std::min(intensity * 255.0f, 255.0f));
+            alpha[x] = std::min(1.0f, core * 0.8f + inner * 0.5f + outer * 0.3f);
         }
+        StoreWhiteAlphaRow(alpha, GLOW_TEXTURE_SIZE, &image.pixels[y * GLOW_TEXTURE_SIZE * 4]);
     }
-
-    m_ShootingStarTexture.LoadFromData(pixels.data(), width, height, 4, false);
 }
 
 void SkyRenderer::GenerateLightRays()
@@ -458,16 +640,65 @@ glm::vec2 SkyRenderer::GetLightSourcePosition(float arc, int screenWidth, int sc
 }
 
 void SkyRenderer::RenderStars(IRenderer &renderer, const TimeManager &time, int screenWidth, int screenHeight)
+{
+    RenderBackgroundStars(renderer, time, screenWidth, screenHeight, true);
+    RenderForegroundStars(renderer, time, screenWidth, screenHeight);
+}
+
+float SkyRenderer::GetStarIntensity(const TimeManager &time) const
 {
     float visibility = time.GetStarVisibility();
     if (visibility < 0.01f)
-        return;
+        return 0.0f;
 
     if (time.GetWeather() == WeatherState::Overcast)
         visibility *= 0.05f;
 
     // Reduce overall star intensity - dimmer stars
-    visibility *= 0.35f;
+    return visibility * 0.35f;
+}
+
+void SkyRenderer::UploadStarField(IRenderer &renderer)
+{
+    auto pack = [](const glm::vec3 &color)
+    {
+        auto channel = [](float v)
+        { return static_cast<std::uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+        return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (255u << 24);
+    };
+
+    std::vector<IRenderer::StarFieldStar> records;
+    records.reserve(m_BackgroundStars.size() + m_Stars.size());
+    auto append = [&](const std::vector<Star> &stars, std::uint32_t flags)
+    {
+        for (std::uint32_t i = 0; i < stars.size(); ++i)
+        {
+            const Star &star = stars[i];
+            IRenderer::StarFieldStar record;
+            record.position = star.position;
+            record.baseBrightness = star.baseBrightness;
+            record.twinklePhase = star.twinklePhase;
+            record.twinkleSpeed = star.twinkleSpeed;
+            record.size = star.size;
+            record.color = pack(star.color);
+            record.flagsIndex = flags | (i << 1);
+            records.push_back(record);
+        }
+    };
+    // Background first, like the CPU path
+    append(m_BackgroundStars, IRenderer::STAR_FIELD_BACKGROUND);
+    append(m_Stars, 0u);
+
+    renderer.UploadStarField(records.data(), records.size());
+    m_StarFieldUploaded = true;
+}
+
+void SkyRenderer::RenderBackgroundStars(IRenderer &renderer, const TimeManager &time, int screenWidth,
+                                        int screenHeight, bool animate)
+{
+    float visibility = GetStarIntensity(time);
+    if (visibility <= 0.0f)
+        return;
 
     // Stars appear gradually - brightest first, then dimmer ones fade in
     // visibility goes 0->1 as night falls, use it to threshold which stars appear
@@ -486,7 +717,9 @@ void SkyRenderer::RenderStars(IRenderer &renderer, const TimeManager &time, int
         if (star.baseBrightness < appearThreshold)
             continue;
 
-        float twinkle = 0.6f + 0.4f * std::sin(m_Time * star.twinkleSpeed * 1.5f + star.twinklePhase);
+        // The cache bakes the average of the twinkle
+        float twinkle = animate ? 0.6f + 0.4f * std::sin(m_Time * star.twinkleSpeed * 1.5f + star.twinklePhase)
+                                : 0.6f;
         float brightness = star.baseBrightness * twinkle * visibility * 0.3f;
 
         if (brightness < 0.01f)
@@ -507,8 +740,18 @@ void SkyRenderer::RenderStars(IRenderer &renderer, const TimeManager &time, int
             true);
         bgCount++;
     }
+}
 
-    // Second pass: Main stars - gradual appearance, sparkly twinkle
+void SkyRenderer::RenderForegroundStars(IRenderer &renderer, const TimeManager &time, int screenWidth,
+                                        int screenHeight)
+{
+    float visibility = GetStarIntensity(time);
+    if (visibility <= 0.0f)
+        return;
+
+    float appearThreshold = 1.0f - visibility * 2.0f;
+
+    // Main stars - gradual appearance, sparkly twinkle
     int starCount = 0;
     int maxStars = static_cast<int>(m_Stars.size() * visibility * 0.6f);
 
@@ -920,6 +1163,13 @@ void SkyRenderer::RenderAtmosphericGlow(IRenderer &renderer, const TimeManager &
         glm::vec2(static_cast<float>(screenWidth), glowHeight),
         glm::vec4(0.08f, 0.12f, 0.25f, horizonGlowAlpha),
         true);
+}
+
+void SkyRenderer::RenderAuroraShimmer(IRenderer &renderer, const TimeManager &time, int screenWidth, int screenHeight)
+{
+    float visibility = time.GetStarVisibility();
+    if (visibility < 0.2f)
+        return;
 
     // Occasional subtle shimmer at top
     float shimmer = std::sin(m_Time * 0.25f) * 0.5f + 0.5f;
@@ -4,8 +4,11 @@
 #include <glm/glm.hpp>
 
 #include "IRenderer.h"
+#include "ImageCache.h"
 #include "Texture.h"
 
+class JobSystem;
+
 class TimeManager;
 
 /**
@@ -165,12 +168,27 @@ struct DewSparkle
  * 7. Dew sparkles (morning only)
  * 8. Sun/Moon rays (god rays effect)
  *
+ * @par Layer Cache
+ * The slow-changing layers (dawn gradient and horizon glow, the night
+ * horizon band and the background stars) only depend on the star
+ * visibility, dawn intensity, weather and screen size. With the cache on
+ * (the default) they are baked into one offscreen render target, and the
+ * bake is repeated only when one of those inputs has moved by more than
+ * CACHE_REBAKE_THRESHOLD or the screen is resized. Each frame then costs
+ * one quad for the cached layers, plus the live effects: foreground star
+ * twinkle, aurora shimmer, shooting stars, dew sparkles and rays. Baked
+ * background stars keep their average twinkle brightness. Backends
+ * without render targets draw every layer directly.
+ *
  * @par Procedural Textures
  * All textures are generated procedurally at initialization:
  * - Star texture: Soft circular gradient with glow
  * - Ray texture: Vertical gradient for light rays
  * - Glow texture: Large soft radial gradient
  *
+ * The generators run concurrently through a TextureBaker and their pixels
+ * are kept in the ImageCache, so later launches skip them entirely.
+ *
  * @par Usage
  * @code
  * SkyRenderer sky;
@@ -212,8 +230,12 @@ public:
      * 5. Populate star arrays with random positions/properties
      * 6. Populate light ray arrays for sun and moon
      * 7. Generate dew sparkle positions
+     *
+     * Steps 1-4 run as parallel tasks on @p jobs, or load from the cache.
+     *
+     * @param jobs Worker pool for the texture generators (nullptr = inline).
      */
-    void Initialize();
+    void Initialize(JobSystem* jobs = nullptr);
 
     /**
      * @brief Re-upload all sky textures to the renderer.
@@ -249,39 +271,71 @@ public:
      */
     void Render(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
 
+    /**
+     * @brief Bake the slow-changing layers into a render target (default on).
+     * @param enabled False draws every layer directly each frame.
+     */
+    void SetLayerCache(bool enabled);
+
+    /// @brief Whether the layer cache is enabled.
+    bool IsLayerCacheEnabled() const { return m_CacheEnabled; }
+
+    /**
+     * @brief Draw both star layers in one instanced call (default on).
+     *
+     * Used only when IRenderer::SupportsStarField(); otherwise stars are
+     * drawn sprite by sprite. In GPU mode the background stars twinkle
+     * live instead of being baked into the layer cache.
+     *
+     * @param enabled False forces the per-sprite path.
+     */
+    void SetGpuStarField(bool enabled);
+
+    /// @brief Whether the GPU star field is enabled.
+    bool IsGpuStarFieldEnabled() const { return m_GpuStarField; }
+
+    /// @brief Heap bytes of the star, ray and sparkle lists (textures excluded).
+    size_t GetMemoryBytes() const;
+
 private:
     /// @name Texture Generation
-    /// @brief Procedural texture creation for sky effects.
+    /// @brief Procedural pixel generators for sky effects.
+    ///
+    /// Each fills an RGBA image and touches no member state, so they run
+    /// concurrently on worker threads.
     /// @{
 
     /**
-     * @brief Generate the light ray texture.
+     * @brief Generate the light ray pixels.
      *
      * Creates a vertical gradient texture used for sun/moon rays.
      * Bright at top, fading to transparent at bottom.
      */
-    void GenerateRayTexture();
+    static void GenerateRayPixels(ImageCache::Image& image);
 
     /**
-     * @brief Generate the main star texture.
+     * @brief Generate the main star pixels.
      *
      * Creates a small soft circular gradient for star rendering.
      */
-    void GenerateStarTexture();
+    static void GenerateStarPixels(ImageCache::Image& image);
 
     /**
-     * @brief Generate the star glow texture.
+     * @brief Generate the star glow pixels.
      *
      * Creates a larger, softer glow rendered behind bright stars.
      */
-    void GenerateStarGlowTexture();
+    static void GenerateStarGlowPixels(ImageCache::Image& image);
 
     /**
-     * @brief Generate the shooting star texture.
+     * @brief Generate the shooting star pixels.
      *
      * Creates an elongated streak texture for meteor trails.
      */
-    void GenerateShootingStarTexture();
+    static void GenerateShootingStarPixels(ImageCache::Image& image);
+
+    /// @brief Generate the atmospheric glow pixels (layered radial falloff).
+    static void GenerateGlowPixels(ImageCache::Image& image);
 
     /// @}
 
@@ -369,6 +423,22 @@ private:
      */
     void RenderStars(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
 
+    /**
+     * @brief Render the dim background star field.
+     * @param animate False draws every star at its average twinkle (for the cache).
+     */
+    void RenderBackgroundStars(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight,
+                               bool animate);
+
+    /// @brief Render the bright, twinkling foreground stars.
+    void RenderForegroundStars(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
+
+    /// @brief Star brightness factor after weather and the overall dimming (0 = hidden).
+    float GetStarIntensity(const TimeManager& time) const;
+
+    /// @brief Pack both star layers into IRenderer::StarFieldStar records and upload them.
+    void UploadStarField(IRenderer& renderer);
+
     /**
      * @brief Render active shooting stars with trails.
      *
@@ -392,6 +462,20 @@ private:
      */
     void RenderAtmosphericGlow(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
 
+    /// @brief Render the slowly pulsing band at the top of the night sky.
+    void RenderAuroraShimmer(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
+
+    /**
+     * @brief Re-bake the cached layers if their inputs moved past the threshold.
+     * @return True if m_CacheTarget is current and can be composited;
+     *         false if the backend has no render targets.
+     */
+    bool UpdateLayerCache(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight);
+
+    /// @brief Draw every layer that goes into the cache.
+    void RenderCachedLayers(IRenderer& renderer, const TimeManager& time, int screenWidth, int screenHeight,
+                            bool animate);
+
     /**
      * @brief Render god rays emanating from the sun.
      *
@@ -510,6 +594,31 @@ private:
     float m_LastScreenHeight;   ///< Cached screen height for resize detection
     /// @}
 
+    /// @name Layer Cache
+    /// @brief Render target holding the slow-changing layers.
+    /// @{
+    bool m_CacheEnabled;            ///< SetLayerCache() state
+    int m_CacheTarget;              ///< Render target handle, -1 if none
+    int m_CacheWidth;               ///< Target size in pixels
+    int m_CacheHeight;
+    bool m_CacheValid;              ///< Target holds a bake of the values below
+    bool m_CacheEmpty;              ///< Bake drew nothing (daytime), skip compositing
+    float m_CacheStarVisibility;    ///< TimeManager::GetStarVisibility() at the bake
+    float m_CacheDawnIntensity;     ///< TimeManager::GetDawnIntensity() at the bake
+    int m_CacheWeather;             ///< WeatherState at the bake
+
+    /// @brief Change in star visibility or dawn intensity that triggers a re-bake.
+    static constexpr float CACHE_REBAKE_THRESHOLD = 0.01f;
+    /// @}
+
+    /// @name GPU Star Field
+    /// @brief Instanced star drawing state.
+    /// @{
+    bool m_GpuStarField;            ///< SetGpuStarField() state
+    bool m_GpuStarsActive;          ///< This frame draws stars on the GPU (keeps them out of the cache)
+    bool m_StarFieldUploaded;       ///< Star records are in the current renderer's buffer
+    /// @}
+
     /// @name Texture Size Constants
     /// @brief Dimensions for procedurally generated textures.
     /// @{
@@ -518,6 +627,11 @@ private:
     static constexpr int STAR_TEXTURE_SIZE = 64;       ///< Star point texture size
     static constexpr int STAR_GLOW_TEXTURE_SIZE = 128; ///< Star glow texture size
     static constexpr int GLOW_TEXTURE_SIZE = 256;      ///< Atmospheric glow texture size
+    static constexpr int SHOOTING_STAR_TEXTURE_WIDTH = 128;
+    static constexpr int SHOOTING_STAR_TEXTURE_HEIGHT = 16;
+
+    /// @brief Part of every generator's cache key; bump when a Generate*Pixels() changes.
+    static constexpr int TEXTURE_REVISION = 1;
     /// @}
 
     /// @name Rendering Constants
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct CellSpan
+ * @brief Cells [x0, x1) of row y.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ */
+struct CellSpan
+{
+    int y;
+    int x0;
+    int x1;
+
+    friend constexpr bool operator==(const CellSpan &, const CellSpan &) = default;
+};
+
+/// @brief Number of cells covered by @p spans.
+inline std::size_t CountSpanCells(const std::vector<CellSpan> &spans)
+{
+    std::size_t count = 0;
+    for (const CellSpan &span : spans)
+        count += static_cast<std::size_t>(span.x1 - span.x0);
+    return count;
+}
+
+/**
+ * @brief 4-connected region around (@p startX, @p startY) as horizontal spans.
+ *
+ * A per-cell flood fill pushes four neighbours for every cell it visits.
+ * The scanline version grows a whole run left and right first, then scans
+ * the rows above and below that run and seeds one new run per stretch of
+ * matching cells:
+ *
+ * @code
+ *   row y-1:  ..##..###.     one seed per stretch of '#' above the run
+ *   row y  :  .[######]..    run grown from the seed
+ *   row y+1:  ...####...     one seed below
+ * @endcode
+ *
+ * @p match is only called on unvisited cells and nothing is modified while
+ * the region is found, so the caller can edit the spans afterwards in one
+ * go (and the match may read the cells being edited).
+ *
+ * @param width, height Grid size; cells outside are never visited.
+ * @param match         `bool(int x, int y)`, true if the cell belongs to the region.
+ * @return Spans sorted by row, then column; empty if the start cell does not match.
+ */
+template<typename MatchFn>
+std::vector<CellSpan> ScanlineFloodFill(int width, int height, int startX, int startY, MatchFn &&match)
+{
+    std::vector<CellSpan> spans;
+    if (startX < 0 || startX >= width || startY < 0 || startY >= height)
+        return spans;
+
+    std::vector<bool> visited(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), false);
+    auto open = [&](int x, int y)
+    {
+        return !visited[static_cast<std::size_t>(y) * width + x] && match(x, y);
+    };
+
+    struct Seed
+    {
+        int x, y;
+    };
+    std::vector<Seed> seeds{{startX, startY}};
+    while (!seeds.empty())
+    {
+        const Seed seed = seeds.back();
+        seeds.pop_back();
+        if (!open(seed.x, seed.y))
+            continue;
+
+        int x0 = seed.x;
+        while (x0 > 0 && open(x0 - 1, seed.y))
+            --x0;
+        int x1 = seed.x + 1;
+        while (x1 < width && open(x1, seed.y))
+            ++x1;
+
+        const std::size_t row = static_cast<std::size_t>(seed.y) * width;
+        std::fill(visited.begin() + static_cast<std::ptrdiff_t>(row + x0),
+                  visited.begin() + static_cast<std::ptrdiff_t>(row + x1), true);
+        spans.push_back({seed.y, x0, x1});
+
+        for (int y : {seed.y - 1, seed.y + 1})
+        {
+            if (y < 0 || y >= height)
+                continue;
+            bool inStretch = false;
+            for (int x = x0; x < x1; ++x)
+            {
+                const bool isOpen = open(x, y);
+                if (isOpen && !inStretch)
+                    seeds.push_back({x, y});
+                inStretch = isOpen;
+            }
+        }
+    }
+
+    std::sort(spans.begin(), spans.end(), [](const CellSpan &a, const CellSpan &b)
+              { return a.y != b.y ? a.y < b.y : a.x0 < b.x0; });
+    return spans;
+}
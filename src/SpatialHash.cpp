@@ -0,0 +1,103 @@
+#include "SpatialHash.h"
+
+SpatialHash::SpatialHash(float cellSize)
+    : m_CellSize(cellSize > 0.0f ? cellSize : 16.0f)
+    , m_InvCellSize(1.0f / m_CellSize)
+{
+}
+
+void SpatialHash::SetCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f || cellSize == m_CellSize)
+        return;
+
+    m_CellSize = cellSize;
+    m_InvCellSize = 1.0f / cellSize;
+
+    // Cell keys depend on the size, so rebuild every bucket
+    m_Cells.clear();
+    for (Id id = 0; id < m_Entries.size(); ++id)
+    {
+        if (m_Entries[id].present)
+            Link(id, KeyFor(m_Entries[id].position));
+    }
+}
+
+void SpatialHash::Clear()
+{
+    m_Entries.clear();
+    m_Cells.clear();
+    m_Count = 0;
+}
+
+void SpatialHash::Insert(Id id, glm::vec2 position)
+{
+    Move(id, position);
+}
+
+void SpatialHash::Move(Id id, glm::vec2 position)
+{
+    if (id >= m_Entries.size())
+        m_Entries.resize(static_cast<size_t>(id) + 1);
+
+    Entry &entry = m_Entries[id];
+    entry.position = position;
+
+    const std::uint64_t cell = KeyFor(position);
+    if (entry.present)
+    {
+        // Staying inside the same cell is the common case: no bucket traffic
+        if (entry.cell == cell)
+            return;
+        Unlink(id);
+    }
+    else
+    {
+        entry.present = true;
+        ++m_Count;
+    }
+    Link(id, cell);
+}
+
+void SpatialHash::Remove(Id id)
+{
+    if (!Contains(id))
+        return;
+
+    Unlink(id);
+    m_Entries[id].present = false;
+    --m_Count;
+}
+
+void SpatialHash::Truncate(Id count)
+{
+    for (Id id = count; id < m_Entries.size(); ++id)
+        Remove(id);
+    if (count < m_Entries.size())
+        m_Entries.resize(count);
+}
+
+void SpatialHash::Link(Id id, std::uint64_t cell)
+{
+    std::vector<Id> &bucket = m_Cells[cell];
+    m_Entries[id].cell = cell;
+    m_Entries[id].slot = static_cast<std::uint32_t>(bucket.size());
+    bucket.push_back(id);
+}
+
+void SpatialHash::Unlink(Id id)
+{
+    auto it = m_Cells.find(m_Entries[id].cell);
+    if (it == m_Cells.end())
+        return;
+
+    // Swap-remove keeps the bucket dense; patch the slot of the entry moved in
+    std::vector<Id> &bucket = it->second;
+    const std::uint32_t slot = m_Entries[id].slot;
+    const Id last = bucket.back();
+    bucket[slot] = last;
+    m_Entries[last].slot = slot;
+    bucket.pop_back();
+    if (bucket.empty())
+        m_Cells.erase(it);
+}
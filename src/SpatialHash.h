@@ -0,0 +1,173 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class SpatialHash
+ * @brief Uniform grid of character anchor points for neighbourhood queries.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Entities
+ *
+ * Buckets points by the grid cell they fall into so box and radius queries
+ * only visit the few cells they overlap instead of every character. With
+ * the default 16 px cell (one tile) a 16x16 hitbox query touches at most
+ * 3x3 cells, which keeps per-query cost independent of the NPC count.
+ *
+ * @par Identifiers
+ * Entries are addressed by a small dense id chosen by the caller (Game uses
+ * the index into its NPC vector). Ids index a flat array, so keep them
+ * compact; gaps cost a few bytes each.
+ *
+ * @par Incremental Updates
+ * Move() only touches the buckets when the point crosses a cell boundary;
+ * moving within a cell just rewrites the stored position. Removal swaps the
+ * last entry of the bucket into the hole, so every update is O(1).
+ *
+ * @par Query Semantics
+ * Queries test the stored *points* (feet anchors). To find characters whose
+ * hitboxes overlap a box, grow the query box by the hitbox extents and run
+ * the exact overlap test in the callback. Iteration order is unspecified.
+ *
+ * @par Thread Safety
+ * Not thread-safe. Concurrent queries are safe; updates require synchronization.
+ *
+ * @see PlayerCharacter::CollidesWithNPC(), Game::SyncNPCGrid()
+ */
+class SpatialHash
+{
+public:
+    using Id = std::uint32_t;
+
+    /// @brief Create an empty grid with @p cellSize px square cells.
+    explicit SpatialHash(float cellSize = 16.0f);
+
+    /// @brief Change the cell size; existing entries are re-bucketed.
+    void SetCellSize(float cellSize);
+
+    /// @brief Cell edge length in world pixels.
+    [[nodiscard]] float GetCellSize() const { return m_CellSize; }
+
+    /// @brief Remove every entry.
+    void Clear();
+
+    /// @brief Add @p id at @p position, or move it there if already present.
+    void Insert(Id id, glm::vec2 position);
+
+    /// @brief Update the position of @p id (inserts it if missing).
+    void Move(Id id, glm::vec2 position);
+
+    /// @brief Remove @p id; no-op if absent.
+    void Remove(Id id);
+
+    /// @brief Remove every id >= @p count.
+    void Truncate(Id count);
+
+    /// @brief `true` if @p id is present.
+    [[nodiscard]] bool Contains(Id id) const { return id < m_Entries.size() && m_Entries[id].present; }
+
+    /// @brief Stored position of @p id (must be present).
+    [[nodiscard]] glm::vec2 GetPosition(Id id) const { return m_Entries[id].position; }
+
+    /// @brief Number of present entries.
+    [[nodiscard]] std::size_t Size() const { return m_Count; }
+
+    /**
+     * @brief Call @p fn(id, position) for every point inside [@p min, @p max] (inclusive).
+     *
+     * If @p fn returns `bool`, returning `false` stops the query early.
+     */
+    template<typename Fn>
+    void ForEachInBox(glm::vec2 min, glm::vec2 max, Fn &&fn) const
+    {
+        if (m_Count == 0 || min.x > max.x || min.y > max.y)
+            return;
+
+        const int cx0 = CellCoord(min.x), cy0 = CellCoord(min.y);
+        const int cx1 = CellCoord(max.x), cy1 = CellCoord(max.y);
+        for (int cy = cy0; cy <= cy1; ++cy)
+        {
+            for (int cx = cx0; cx <= cx1; ++cx)
+            {
+                auto it = m_Cells.find(CellKey(cx, cy));
+                if (it == m_Cells.end())
+                    continue;
+                for (Id id : it->second)
+                {
+                    const glm::vec2 p = m_Entries[id].position;
+                    if (p.x < min.x || p.x > max.x || p.y < min.y || p.y > max.y)
+                        continue;
+                    if constexpr (std::is_same_v<std::invoke_result_t<Fn &, Id, glm::vec2>, bool>)
+                    {
+                        if (!fn(id, p))
+                            return;
+                    }
+                    else
+                    {
+                        fn(id, p);
+                    }
+                }
+            }
+        }
+    }
+
+    /// @brief Call @p fn(id, position) for every point within @p radius of @p center.
+    template<typename Fn>
+    void ForEachInRadius(glm::vec2 center, float radius, Fn &&fn) const
+    {
+        const float radiusSq = radius * radius;
+        ForEachInBox(center - glm::vec2(radius), center + glm::vec2(radius), [&](Id id, glm::vec2 p)
+        {
+            const glm::vec2 d = p - center;
+            if (d.x * d.x + d.y * d.y <= radiusSq)
+                fn(id, p);
+        });
+    }
+
+    /// @brief `true` if @p pred(id, position) holds for any point inside [@p min, @p max].
+    template<typename Pred>
+    [[nodiscard]] bool AnyInBox(glm::vec2 min, glm::vec2 max, Pred &&pred) const
+    {
+        bool found = false;
+        ForEachInBox(min, max, [&](Id id, glm::vec2 p)
+        {
+            found = pred(id, p);
+            return !found;
+        });
+        return found;
+    }
+
+private:
+    struct Entry
+    {
+        glm::vec2 position{0.0f};
+        std::uint64_t cell = 0;
+        std::uint32_t slot = 0;  ///< Index inside the cell's bucket
+        bool present = false;
+    };
+
+    [[nodiscard]] int CellCoord(float v) const { return static_cast<int>(std::floor(v * m_InvCellSize)); }
+
+    [[nodiscard]] static std::uint64_t CellKey(int cx, int cy)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint32_t>(cy);
+    }
+
+    [[nodiscard]] std::uint64_t KeyFor(glm::vec2 p) const { return CellKey(CellCoord(p.x), CellCoord(p.y)); }
+
+    void Link(Id id, std::uint64_t cell);
+    void Unlink(Id id);
+
+    float m_CellSize;
+    float m_InvCellSize;
+    std::vector<Entry> m_Entries;
+    std::unordered_map<std::uint64_t, std::vector<Id>> m_Cells;
+    std::size_t m_Count = 0;
+};
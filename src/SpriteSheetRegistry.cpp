@@ -0,0 +1,308 @@
+#include "SpriteSheetRegistry.h"
+#include "AsyncTextureLoader.h"
+#include "IRenderer.h"
+#include "ImageCache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct SheetEntry
+{
+    std::weak_ptr<const Texture> sheet;
+    bool evicted = false;           ///< Holding the placeholder since evictedFrame
+    std::uint64_t evictedFrame = 0;
+};
+
+struct RegistryState
+{
+    std::unordered_map<std::string, SheetEntry> sheets;
+    IRenderer *renderer = nullptr;
+    AsyncTextureLoader *loader = nullptr;
+    std::size_t gpuBudget = 0;
+    std::uint64_t idleFrames = SpriteSheetRegistry::DEFAULT_IDLE_FRAMES;
+};
+
+// Never destroyed: handles held by statics may still be released during exit
+RegistryState &State()
+{
+    static RegistryState *state = new RegistryState();
+    return *state;
+}
+
+std::string CanonicalKey(const std::string &path)
+{
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.generic_string();
+}
+
+/// Decode @p path into @p sheet, through the loader if there is one
+void ReloadSheet(RegistryState &state, const std::shared_ptr<Texture> &sheet, const std::string &path)
+{
+    if (state.loader)
+    {
+        state.loader->Reload(sheet, path);
+        return;
+    }
+
+    ImageCache::Image image;
+    if (!ImageCache::Load(path, true, image))
+    {
+        std::cerr << "Failed to reload texture: " << path << std::endl;
+        return;
+    }
+    if (state.renderer)
+    {
+        state.renderer->ReleaseTexture(*sheet);
+    }
+    sheet->AdoptPixels(std::move(image.pixels), image.width, image.height, image.channels);
+    if (state.renderer)
+    {
+        state.renderer->UploadTexture(*sheet);
+    }
+}
+
+/// Swap @p sheet's pixels for a transparent 1x1 placeholder
+void EvictSheet(RegistryState &state, Texture &sheet)
+{
+    if (state.renderer)
+    {
+        state.renderer->ReleaseTexture(sheet);
+    }
+    sheet.AdoptPixels(std::vector<unsigned char>(4, 0), 1, 1, 4);
+    if (state.renderer)
+    {
+        state.renderer->UploadTexture(sheet);
+    }
+}
+}  // namespace
+
+SpriteSheetRegistry::Handle SpriteSheetRegistry::Acquire(const std::string &path, ReadyCallback onReady)
+{
+    if (path.empty())
+    {
+        return nullptr;
+    }
+
+    RegistryState &state = State();
+    std::string key = CanonicalKey(path);
+    auto it = state.sheets.find(key);
+    if (it != state.sheets.end())
+    {
+        if (Handle sheet = it->second.sheet.lock())
+        {
+            if (onReady)
+            {
+                WhenReady(sheet, std::move(onReady));
+            }
+            return sheet;
+        }
+    }
+
+    auto texture = std::make_unique<Texture>();
+    if (state.loader)
+    {
+        // Missing files still fail here, so callers can try another path
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(path, ec))
+        {
+            std::cerr << "Failed to load texture: " << path << std::endl;
+            return nullptr;
+        }
+    }
+    else if (!texture->LoadFromFile(path))
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Texture> sheet(texture.release(), [key](Texture *owned)
+    {
+        RegistryState &state = State();
+        if (state.renderer)
+        {
+            state.renderer->ReleaseTexture(*owned);
+        }
+        auto entry = state.sheets.find(key);
+        if (entry != state.sheets.end() && entry->second.sheet.expired())
+        {
+            state.sheets.erase(entry);
+        }
+        delete owned;
+    });
+    state.sheets[key] = SheetEntry{sheet};
+    sheet->SetMemoryTag(MemoryTracker::Subsystem::Characters);
+    sheet->MarkUsed();  // Not idle before it had a chance to be drawn
+
+    if (state.loader)
+    {
+        state.loader->Load(sheet, path, std::move(onReady));
+    }
+    else if (onReady)
+    {
+        onReady(true);
+    }
+    return sheet;
+}
+
+void SpriteSheetRegistry::WhenReady(const Handle &sheet, ReadyCallback onReady)
+{
+    AsyncTextureLoader *loader = State().loader;
+    if (!loader || !loader->OnReady(*sheet, onReady))
+    {
+        onReady(true);
+    }
+}
+
+bool SpriteSheetRegistry::Reload(const std::string &path)
+{
+    RegistryState &state = State();
+    auto it = state.sheets.find(CanonicalKey(path));
+    if (it == state.sheets.end())
+    {
+        return false;
+    }
+    Handle live = it->second.sheet.lock();
+    if (!live)
+    {
+        return false;
+    }
+
+    // Owners only read the sheet; replacing its pixels is the registry's job
+    it->second.evicted = false;
+    ReloadSheet(state, std::const_pointer_cast<Texture>(live), path);
+    return true;
+}
+
+void SpriteSheetRegistry::SetLoader(AsyncTextureLoader *loader)
+{
+    State().loader = loader;
+}
+
+void SpriteSheetRegistry::SetRenderer(IRenderer *renderer)
+{
+    State().renderer = renderer;
+}
+
+std::size_t SpriteSheetRegistry::GetLoadedCount()
+{
+    std::size_t count = 0;
+    for (const auto &[key, entry] : State().sheets)
+    {
+        if (!entry.sheet.expired())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void SpriteSheetRegistry::SetBudget(std::size_t gpuBytes, std::uint64_t idleFrames)
+{
+    RegistryState &state = State();
+    state.gpuBudget = gpuBytes;
+    state.idleFrames = idleFrames;
+}
+
+std::size_t SpriteSheetRegistry::GetBudget()
+{
+    return State().gpuBudget;
+}
+
+void SpriteSheetRegistry::Update()
+{
+    Update(Texture::GetOpenGLTextureBytes() + Texture::GetVulkanTextureBytes(),
+           [](const Texture &sheet) { return sheet.GetGpuBytes(); });
+}
+
+void SpriteSheetRegistry::Update(std::size_t gpuBytesInUse, const SheetBytes &sheetBytes)
+{
+    RegistryState &state = State();
+    const std::uint64_t frame = Texture::GetUseFrame();
+
+    struct Candidate
+    {
+        std::uint64_t lastUsed;
+        SheetEntry *entry;
+        std::shared_ptr<Texture> sheet;
+    };
+    std::vector<Candidate> idle;
+
+    for (auto &[key, entry] : state.sheets)
+    {
+        Handle live = entry.sheet.lock();
+        if (!live)
+        {
+            continue;
+        }
+        std::shared_ptr<Texture> sheet = std::const_pointer_cast<Texture>(live);
+
+        if (entry.evicted)
+        {
+            // Drawn since it was evicted: bring the pixels back
+            if (sheet->GetLastUsedFrame() > entry.evictedFrame)
+            {
+                entry.evicted = false;
+                ReloadSheet(state, sheet, key);
+            }
+            continue;
+        }
+
+        if (state.gpuBudget > 0 && frame - sheet->GetLastUsedFrame() >= state.idleFrames &&
+            !(state.loader && state.loader->IsPending(*sheet)))
+        {
+            idle.push_back({sheet->GetLastUsedFrame(), &entry, std::move(sheet)});
+        }
+    }
+
+    if (idle.empty())
+    {
+        return;
+    }
+    std::size_t used = gpuBytesInUse;
+    if (used <= state.gpuBudget)
+    {
+        return;
+    }
+
+    std::sort(idle.begin(), idle.end(),
+              [](const Candidate &a, const Candidate &b) { return a.lastUsed < b.lastUsed; });
+    for (Candidate &candidate : idle)
+    {
+        if (used <= state.gpuBudget)
+        {
+            break;
+        }
+        // ReleaseTexture() may hold the memory until frames in flight finish;
+        // count it as freed now so one frame does not evict more than it needs
+        const std::size_t freed = sheetBytes(*candidate.sheet);
+        EvictSheet(state, *candidate.sheet);
+        used -= std::min(used, freed);
+        candidate.entry->evicted = true;
+        candidate.entry->evictedFrame = frame;
+    }
+}
+
+std::size_t SpriteSheetRegistry::GetEvictedCount()
+{
+    std::size_t count = 0;
+    for (const auto &[key, entry] : State().sheets)
+    {
+        if (entry.evicted && !entry.sheet.expired())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+const Texture &SpriteSheetRegistry::GetEmpty()
+{
+    static const Texture *empty = new Texture();
+    return *empty;
+}
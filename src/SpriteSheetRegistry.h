@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Texture.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+class AsyncTextureLoader;
+class IRenderer;
+
+/**
+ * @class SpriteSheetRegistry
+ * @brief Shared, reference-counted character sprite sheets keyed by file.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * A map with fifty villagers of one type used to decode the same PNG fifty
+ * times and keep fifty identical textures on the GPU. Acquire() hands out
+ * one shared Texture per file instead; the texture lives as long as any
+ * character still holds its handle.
+ *
+ * @par Keys
+ * Paths are keyed by their canonical form, so `assets/npc.png` and
+ * `../game/assets/npc.png` share a sheet. Failed loads are not remembered;
+ * a later Acquire() tries the file again.
+ *
+ * @par Asynchronous Loading
+ * With a loader set (see SetLoader()), Acquire() checks that the file
+ * exists and returns a transparent placeholder at once; the PNG is decoded
+ * on the loader's workers and the sheet fills in during a later
+ * AsyncTextureLoader::Update(). Characters simply draw nothing until then.
+ * Code that must wait passes a callback. Without a loader, sheets are
+ * decoded before Acquire() returns.
+ *
+ * @par Hot Reload
+ * Reload() re-decodes a live sheet after its file changed. Every holder
+ * shares the one texture, so all characters using it pick up the new
+ * pixels at once; the old ones keep drawing until then.
+ *
+ * @par Texture Budget
+ * With a budget set (see SetBudget()), Update() keeps GPU texture memory
+ * under it by evicting sheets nothing has drawn for a while, such as the
+ * sheets of NPCs far from the camera. An evicted sheet keeps its handle
+ * and shrinks to a transparent 1x1 placeholder; the first frame that
+ * draws it again (Texture::MarkUsed()) queues a reload, through the
+ * loader when one is set:
+ *
+ * @code
+ *   loaded --idle >= idleFrames, over budget--> evicted (1x1) --drawn--> reloading --> loaded
+ * @endcode
+ *
+ * Sheets are evicted longest-idle first and only while the budget is
+ * exceeded, so a map that fits never loses a sheet. Characters draw nothing
+ * for the few frames a reload takes.
+ *
+ * @par Renderer Lifetime
+ * When the last handle goes away the registry tells the current renderer
+ * (see SetRenderer()) so it can drop cached descriptor sets and defer
+ * freeing GPU memory a frame in flight may still read. After a renderer
+ * switch, live sheets are uploaded again with every other texture (see
+ * Texture::GetUploadedTextures()).
+ *
+ * @par Thread Safety
+ * Main thread only, like Texture itself.
+ *
+ * @see NonPlayerCharacter::Load(), PlayerCharacter::CopyAppearanceFrom()
+ */
+class SpriteSheetRegistry
+{
+public:
+    /// @brief Shared, read-only sprite sheet.
+    using Handle = std::shared_ptr<const Texture>;
+
+    /// @brief Called once the sheet has its pixels (@c true) or failed to decode (@c false).
+    using ReadyCallback = std::function<void(bool loaded)>;
+
+    /**
+     * @brief Get the sheet for @p path, loading it on first use.
+     * @param path    Image file, relative to the working directory.
+     * @param onReady Optional; runs right away if the sheet is already loaded,
+     *                otherwise from AsyncTextureLoader::Update() on the main thread.
+     * @return Shared sheet (possibly still loading), or nullptr if the file
+     *         cannot be loaded (does not exist, with a loader set).
+     */
+    static Handle Acquire(const std::string &path, ReadyCallback onReady = {});
+
+    /// @brief Run @p onReady once @p sheet has its pixels (right away if it already has them).
+    static void WhenReady(const Handle &sheet, ReadyCallback onReady);
+
+    /**
+     * @brief Decode @p path again into its live sheet, if there is one.
+     *
+     * Goes through the loader when one is set, otherwise decodes and
+     * uploads before returning.
+     *
+     * @return False if no live sheet was loaded from @p path.
+     */
+    static bool Reload(const std::string &path);
+
+    /**
+     * @brief Decode new sheets on @p loader instead of inside Acquire().
+     *
+     * Set before loading characters; clear (nullptr) before destroying the loader.
+     */
+    static void SetLoader(AsyncTextureLoader *loader);
+
+    /**
+     * @brief Renderer notified when a sheet is destroyed.
+     *
+     * Set after creating a renderer and cleared (nullptr) before destroying it.
+     */
+    static void SetRenderer(IRenderer *renderer);
+
+    /// @brief Number of distinct sheets currently alive.
+    static std::size_t GetLoadedCount();
+
+    /// @brief Frames a sheet must go undrawn before Update() may evict it (10 s at 60 FPS).
+    static constexpr std::uint64_t DEFAULT_IDLE_FRAMES = 600;
+
+    /**
+     * @brief Keep GPU texture memory under @p gpuBytes by evicting idle sheets.
+     *
+     * @param gpuBytes   Budget for every uploaded texture on both backends
+     *                   (Texture::GetOpenGLTextureBytes() plus
+     *                   Texture::GetVulkanTextureBytes()); 0 turns eviction off.
+     * @param idleFrames Undrawn frames before a sheet may be evicted.
+     */
+    static void SetBudget(std::size_t gpuBytes, std::uint64_t idleFrames = DEFAULT_IDLE_FRAMES);
+
+    /// @brief Budget from SetBudget() (0 = none).
+    static std::size_t GetBudget();
+
+    /**
+     * @brief Reload evicted sheets that were drawn again, then evict to the budget.
+     *
+     * Call once per frame after drawing and before Texture::AdvanceUseFrame().
+     */
+    static void Update();
+
+    /// @brief GPU bytes evicting @p sheet gives back.
+    using SheetBytes = std::function<std::size_t(const Texture &sheet)>;
+
+    /**
+     * @brief Update() against a budget use measured by the caller.
+     *
+     * Update() reads @p gpuBytesInUse from both backends and counts each
+     * evicted sheet as freeing its Texture::GetGpuBytes(); this form takes
+     * both from the caller, for tools and tests that run without a renderer.
+     */
+    static void Update(std::size_t gpuBytesInUse, const SheetBytes &sheetBytes);
+
+    /// @brief Live sheets currently evicted to their placeholder.
+    static std::size_t GetEvictedCount();
+
+    /// @brief Empty texture drawn in place of a missing sheet.
+    static const Texture &GetEmpty();
+};
@@ -0,0 +1,106 @@
+#include "TextLayoutCache.h"
+
+#include <algorithm>
+#include <bit>
+
+std::size_t TextLayoutCache::KeyHash::operator()(const KeyView &key) const
+{
+    std::size_t hash = std::hash<std::string_view>{}(key.text);
+    hash ^= std::hash<std::uint32_t>{}(std::bit_cast<std::uint32_t>(key.scale)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<std::uint32_t>{}(std::bit_cast<std::uint32_t>(key.maxWidth)) + 0x9e3779b9 + (hash << 6) +
+            (hash >> 2);
+    return hash;
+}
+
+const TextLayoutCache::TextLayout &TextLayoutCache::Wrap(std::string_view text, float scale, float maxWidth,
+                                                         const MeasureFn &measureWidth)
+{
+    ++m_Clock;
+    auto it = m_Entries.find(KeyView{text, scale, maxWidth});
+    if (it != m_Entries.end())
+    {
+        ++m_Hits;
+        it->second.lastUsed = m_Clock;
+        return it->second.layout;
+    }
+    ++m_Misses;
+
+    if (m_Entries.size() >= MAX_ENTRIES)
+    {
+        auto oldest = std::min_element(m_Entries.begin(), m_Entries.end(), [](const auto &a, const auto &b)
+                                       { return a.second.lastUsed < b.second.lastUsed; });
+        m_Entries.erase(oldest);
+    }
+
+    it = m_Entries.emplace(Key{std::string(text), scale, maxWidth}, Entry{}).first;
+    it->second.lastUsed = m_Clock;
+    WrapInto(text, maxWidth, measureWidth, it->second.layout);
+    return it->second.layout;
+}
+
+void TextLayoutCache::WrapInto(std::string_view text, float maxWidth, const MeasureFn &measureWidth, TextLayout &out)
+{
+    out.lines.clear();
+    out.lineWidths.clear();
+    out.width = 0.0f;
+
+    std::string currentLine;
+    float currentWidth = 0.0f;
+    std::string testLine;
+
+    auto pushLine = [&](std::string &line, float width)
+    {
+        out.lines.push_back(std::move(line));
+        out.lineWidths.push_back(width);
+        out.width = std::max(out.width, width);
+        line.clear();
+    };
+
+    // Add a word to the line, wrapping if it exceeds max width
+    auto commitWord = [&](std::string_view word)
+    {
+        if (word.empty())
+            return;
+        testLine = currentLine;
+        if (!testLine.empty())
+            testLine += ' ';
+        testLine += word;
+        const float testWidth = measureWidth(testLine);
+        if (testWidth > maxWidth && !currentLine.empty())
+        {
+            pushLine(currentLine, currentWidth);
+            currentLine = word;
+            currentWidth = measureWidth(currentLine);
+        }
+        else
+        {
+            currentLine.swap(testLine);
+            currentWidth = testWidth;
+        }
+    };
+
+    // Finish the current line and start a new one
+    auto commitLine = [&]()
+    {
+        if (!currentLine.empty())
+            pushLine(currentLine, currentWidth);
+        currentWidth = 0.0f;
+    };
+
+    std::size_t wordStart = 0;
+    for (std::size_t i = 0; i <= text.size(); ++i)
+    {
+        const char c = i < text.size() ? text[i] : '\n';
+        if (c != ' ' && c != '\n')
+            continue;
+        commitWord(text.substr(wordStart, i - wordStart));
+        wordStart = i + 1;
+        if (c == '\n')
+            commitLine();
+    }
+}
+
+void TextLayoutCache::Clear()
+{
+    m_Entries.clear();
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TextLayoutCache
+ * @brief Word-wrapped lines of recently laid out strings.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Dialogue boxes wrap the same text every frame while it is on screen.
+ * Wrap() wraps a string once per (text, scale, wrap width) and hands back
+ * the lines and their measured widths on later calls:
+ *
+ * @code{.cpp}
+ * const TextLayout &layout = m_TextLayouts.Wrap(text, scale, maxWidth,
+ *     [&](std::string_view s) { return m_Renderer->GetTextWidth(s, scale); });
+ * for (std::size_t i = 0; i < layout.lines.size(); ++i)
+ *     DrawCentered(layout.lines[i], layout.lineWidths[i]);
+ * @endcode
+ *
+ * Wrapping is ASCII and space-delimited: runs of spaces collapse, '\n'
+ * starts a new line, and a word wider than the limit gets a line of its
+ * own rather than being split.
+ *
+ * @par Invalidation
+ * Widths come from the measure function at the time of wrapping; Clear()
+ * the cache when the font or renderer changes.
+ *
+ * @par Thread Safety
+ * Not thread-safe; use from the main thread.
+ */
+class TextLayoutCache
+{
+public:
+    static constexpr std::size_t MAX_ENTRIES = 64;
+
+    /// @brief Wrapped lines of one string.
+    struct TextLayout
+    {
+        std::vector<std::string> lines;
+        std::vector<float> lineWidths;  ///< Measured width of each line
+        float width = 0.0f;             ///< Widest line
+    };
+
+    using MeasureFn = std::function<float(std::string_view)>;
+
+    /**
+     * @brief Wrap @p text to @p maxWidth, or return the cached layout.
+     *
+     * @p scale is only part of the key; @p measureWidth must already apply it.
+     * The reference is valid until the next Wrap() or Clear().
+     */
+    const TextLayout &Wrap(std::string_view text, float scale, float maxWidth, const MeasureFn &measureWidth);
+
+    /**
+     * @brief Word-wrap without caching.
+     * @param out Receives the lines; its previous contents are replaced.
+     */
+    static void WrapInto(std::string_view text, float maxWidth, const MeasureFn &measureWidth, TextLayout &out);
+
+    void Clear();
+
+    [[nodiscard]] std::size_t Size() const { return m_Entries.size(); }
+    [[nodiscard]] std::uint64_t GetHits() const { return m_Hits; }
+    [[nodiscard]] std::uint64_t GetMisses() const { return m_Misses; }
+
+private:
+    struct Key
+    {
+        std::string text;
+        float scale;
+        float maxWidth;
+    };
+
+    struct KeyView
+    {
+        std::string_view text;
+        float scale;
+        float maxWidth;
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(const KeyView &key) const;
+        std::size_t operator()(const Key &key) const { return (*this)(KeyView{key.text, key.scale, key.maxWidth}); }
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+        static KeyView View(const Key &key) { return {key.text, key.scale, key.maxWidth}; }
+        static KeyView View(const KeyView &key) { return key; }
+        template<typename A, typename B>
+        bool operator()(const A &a, const B &b) const
+        {
+            const KeyView x = View(a);
+            const KeyView y = View(b);
+            return x.text == y.text && x.scale == y.scale && x.maxWidth == y.maxWidth;
+        }
+    };
+
+    struct Entry
+    {
+        TextLayout layout;
+        std::uint64_t lastUsed = 0;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash, KeyEqual> m_Entries;
+    std::uint64_t m_Clock = 0;
+    std::uint64_t m_Hits = 0;
+    std::uint64_t m_Misses = 0;
+};
@@ -0,0 +1,64 @@
+#include "TextMeshCache.h"
+
+#include <bit>
+#include <functional>
+
+std::size_t TextMeshCache::KeyHash::operator()(const KeyView &key) const
+{
+    std::size_t hash = std::hash<std::string_view>{}(key.text);
+    hash ^= std::hash<std::uint32_t>{}(std::bit_cast<std::uint32_t>(key.scale)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<std::uint32_t>{}(std::bit_cast<std::uint32_t>(key.outlineSize)) + 0x9e3779b9 + (hash << 6) +
+            (hash >> 2);
+    return hash;
+}
+
+const TextMeshCache::TextMesh *TextMeshCache::Find(std::string_view text, float scale, float outlineSize)
+{
+    auto it = m_Entries.find(KeyView{text, scale, outlineSize});
+    if (it == m_Entries.end())
+    {
+        ++m_Misses;
+        return nullptr;
+    }
+    ++m_Hits;
+    it->second.lastUsed = m_Frame;
+    return &it->second.mesh;
+}
+
+TextMeshCache::TextMesh &TextMeshCache::Insert(std::string_view text, float scale, float outlineSize)
+{
+    auto it = m_Entries.find(KeyView{text, scale, outlineSize});
+    if (it == m_Entries.end())
+    {
+        if (m_Entries.size() >= MAX_ENTRIES)
+            EvictLeastRecentlyUsed();
+        it = m_Entries.emplace(Key{std::string(text), scale, outlineSize}, Entry{}).first;
+    }
+    it->second.mesh.vertices.clear();
+    it->second.mesh.outlineVertexCount = 0;
+    it->second.lastUsed = m_Frame;
+    return it->second.mesh;
+}
+
+void TextMeshCache::NextFrame()
+{
+    ++m_Frame;
+    std::erase_if(m_Entries, [this](const auto &entry) { return m_Frame - entry.second.lastUsed > MAX_IDLE_FRAMES; });
+}
+
+void TextMeshCache::Clear()
+{
+    m_Entries.clear();
+}
+
+void TextMeshCache::EvictLeastRecentlyUsed()
+{
+    auto oldest = m_Entries.begin();
+    for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+        if (it->second.lastUsed < oldest->second.lastUsed)
+            oldest = it;
+    }
+    if (oldest != m_Entries.end())
+        m_Entries.erase(oldest);
+}
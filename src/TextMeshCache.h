@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class TextMeshCache
+ * @brief Glyph quads of recently drawn strings, built once and reused.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Dialogue, labels and HUD text mostly repeat from frame to frame. The
+ * renderers keep the quads of each (text, scale, outline) they draw,
+ * relative to the text origin, and move them into place through the model
+ * matrix. A repeated string then costs a copy into the vertex stream
+ * instead of a glyph walk:
+ *
+ * @code{.cpp}
+ * const TextMesh *mesh = m_TextMeshes.Find(text, scale, outlineSize);
+ * if (!mesh)
+ * {
+ *     TextMesh &built = m_TextMeshes.Insert(text, scale, outlineSize);
+ *     BuildTextMesh(text, scale, outlineSize, built);
+ *     mesh = &built;
+ * }
+ * @endcode
+ *
+ * @par Eviction
+ * NextFrame() advances the cache clock once per frame. Strings not drawn
+ * for MAX_IDLE_FRAMES are dropped, and at MAX_ENTRIES Insert() drops the
+ * least recently drawn one, so text that changes every frame (timers,
+ * counters) cycles through a bounded set of entries.
+ *
+ * @par Invalidation
+ * Meshes hold atlas UVs; Clear() the cache whenever the font is reloaded.
+ *
+ * @par Thread Safety
+ * Not thread-safe; owned by one renderer.
+ */
+class TextMeshCache
+{
+public:
+    static constexpr std::size_t MAX_ENTRIES = 256;
+    static constexpr std::uint64_t MAX_IDLE_FRAMES = 120;
+
+    /// @brief One text vertex, laid out like both backends' text vertices.
+    struct Vertex
+    {
+        float x, y;  ///< Offset from the text origin in pixels
+        float u, v;  ///< Font atlas UV
+    };
+
+    /// @brief Prebuilt geometry of one string.
+    struct TextMesh
+    {
+        std::vector<Vertex> vertices;
+        std::size_t outlineVertexCount = 0;  ///< Leading vertices that form the outline
+    };
+
+    /// @brief Cached mesh for the key, or nullptr. Marks the entry as drawn this frame.
+    [[nodiscard]] const TextMesh *Find(std::string_view text, float scale, float outlineSize);
+
+    /**
+     * @brief Add an empty entry for the key and return it for the caller to fill.
+     *
+     * The reference stays valid until the next Insert(), NextFrame() or
+     * Clear().
+     */
+    TextMesh &Insert(std::string_view text, float scale, float outlineSize);
+
+    /// @brief Advance the clock and drop entries idle for MAX_IDLE_FRAMES.
+    void NextFrame();
+
+    void Clear();
+
+    [[nodiscard]] std::size_t Size() const { return m_Entries.size(); }
+    [[nodiscard]] std::uint64_t GetHits() const { return m_Hits; }
+    [[nodiscard]] std::uint64_t GetMisses() const { return m_Misses; }
+
+private:
+    struct Key
+    {
+        std::string text;
+        float scale;
+        float outlineSize;
+    };
+
+    struct KeyView
+    {
+        std::string_view text;
+        float scale;
+        float outlineSize;
+    };
+
+    struct KeyHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(const KeyView &key) const;
+        std::size_t operator()(const Key &key) const { return (*this)(KeyView{key.text, key.scale, key.outlineSize}); }
+    };
+
+    struct KeyEqual
+    {
+        using is_transparent = void;
+        static KeyView View(const Key &key) { return {key.text, key.scale, key.outlineSize}; }
+        static KeyView View(const KeyView &key) { return key; }
+        template<typename A, typename B>
+        bool operator()(const A &a, const B &b) const
+        {
+            const KeyView x = View(a);
+            const KeyView y = View(b);
+            return x.text == y.text && x.scale == y.scale && x.outlineSize == y.outlineSize;
+        }
+    };
+
+    struct Entry
+    {
+        TextMesh mesh;
+        std::uint64_t lastUsed = 0;
+    };
+
+    void EvictLeastRecentlyUsed();
+
+    std::unordered_map<Key, Entry, KeyHash, KeyEqual> m_Entries;
+    std::uint64_t m_Frame = 0;
+    std::uint64_t m_Hits = 0;
+    std::uint64_t m_Misses = 0;
+};
@@ -1,7 +1,12 @@
 #include "Texture.h"
+#include "ImageCache.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <cstring>
+#include <mutex>
+#include <unordered_set>
 #include <utility>
 
 // stb_image is a header-only library - this define tells it to include the implementation
@@ -13,6 +18,32 @@
 #include <vulkan/vulkan.h>
 
 std::uint64_t Texture::s_CurrentOpenGLContextGeneration = 0;
+std::uint64_t Texture::s_UseFrame = 1;
+
+namespace
+{
+// Textures can be created and destroyed on the render thread and loader threads
+std::atomic<std::int64_t> s_OpenGLTextureBytes{0};
+std::atomic<std::int64_t> s_VulkanTextureBytes{0};
+
+std::int64_t PixelBytes(int width, int height, int channels)
+{
+    return static_cast<std::int64_t>(width) * height * channels;
+}
+
+struct UploadStore
+{
+    std::mutex mutex;
+    std::unordered_set<Texture *> textures;
+};
+
+// Never destroyed, so textures living in statics can untrack during exit
+UploadStore &Uploads()
+{
+    static UploadStore *store = new UploadStore();
+    return *store;
+}
+}
 
 Texture::Texture()
     : m_Width(0)                              // Image width in pixels (0 until loaded)
@@ -46,6 +77,9 @@ Texture::Texture(Texture &&other) noexcept
     , m_VulkanImageView(other.m_VulkanImageView)
     , m_VulkanSampler(other.m_VulkanSampler)
     , m_VulkanDevice(other.m_VulkanDevice)
+    , m_VulkanMemoryBytes(other.m_VulkanMemoryBytes)
+    , m_MemoryTag(other.m_MemoryTag)
+    , m_LastUsedFrame(other.m_LastUsedFrame)
 {
     // Null out the source object's resources so its destructor won't free them.
     // We now own these resources exclusively.
@@ -58,6 +92,13 @@ Texture::Texture(Texture &&other) noexcept
     other.m_VulkanImageView = VK_NULL_HANDLE;
     other.m_VulkanSampler = VK_NULL_HANDLE;
     other.m_VulkanDevice = VK_NULL_HANDLE;
+    other.m_VulkanMemoryBytes = 0;
+
+    if (other.m_Tracked)
+    {
+        other.UntrackUpload();
+        TrackUpload();
+    }
 }
 
 // Move assignment - same idea as move constructor but we might already own resources.
@@ -68,15 +109,7 @@ Texture &Texture::operator=(Texture &&other) noexcept
     {
         // First, clean up any resources we currently own
         // Check for valid GL context - during shutdown the context may already be gone
-        GLFWwindow *currentContext = glfwGetCurrentContext();
-        if (m_OpenGLID != 0 && currentContext != nullptr &&
-            m_OpenGLContextGeneration == s_CurrentOpenGLContextGeneration)
-        {
-            glDeleteTextures(1, &m_OpenGLID);
-        }
-        m_OpenGLID = 0;
-        m_OpenGLContextTag = nullptr;
-        m_OpenGLContextGeneration = 0;
+        DestroyOpenGLTexture();
         if (m_VulkanDevice != VK_NULL_HANDLE)
         {
             DestroyVulkanTexture(m_VulkanDevice);
@@ -96,6 +129,8 @@ Texture &Texture::operator=(Texture &&other) noexcept
         m_VulkanImageView = other.m_VulkanImageView;
         m_VulkanSampler = other.m_VulkanSampler;
         m_VulkanDevice = other.m_VulkanDevice;
+        m_VulkanMemoryBytes = other.m_VulkanMemoryBytes;
+        m_LastUsedFrame = other.m_LastUsedFrame;  // m_MemoryTag stays with this object
 
         // Null out the source so its destructor doesn't double-free
         other.m_Width = other.m_Height = other.m_Channels = 0;
@@ -107,6 +142,14 @@ Texture &Texture::operator=(Texture &&other) noexcept
         other.m_VulkanImageView = VK_NULL_HANDLE;
         other.m_VulkanSampler = VK_NULL_HANDLE;
         other.m_VulkanDevice = VK_NULL_HANDLE;
+        other.m_VulkanMemoryBytes = 0;
+
+        UntrackUpload();
+        if (other.m_Tracked)
+        {
+            other.UntrackUpload();
+            TrackUpload();
+        }
     }
     return *this;
 }
@@ -115,16 +158,8 @@ Texture::~Texture()
 {
     // OpenGL textures must be deleted while the GL context is still valid.
     // During application shutdown, GLFW may destroy the context before our
-    // destructor runs, so we check glfwGetCurrentContext() to avoid crashes.
-    GLFWwindow *currentContext = glfwGetCurrentContext();
-    if (m_OpenGLID != 0 && currentContext != nullptr &&
-        m_OpenGLContextGeneration == s_CurrentOpenGLContextGeneration)
-    {
-        glDeleteTextures(1, &m_OpenGLID);
-    }
-    m_OpenGLID = 0;
-    m_OpenGLContextTag = nullptr;
-    m_OpenGLContextGeneration = 0;
+    // destructor runs, so DestroyOpenGLTexture() checks glfwGetCurrentContext() to avoid crashes.
+    DestroyOpenGLTexture();
 
     // Vulkan resources must be destroyed in a specific order and require the device handle
     if (m_VulkanDevice != VK_NULL_HANDLE)
@@ -134,38 +169,36 @@ Texture::~Texture()
 
     // Free CPU-side image data last
     m_ImageData.clear();
+    UntrackUpload();
 }
 
 bool Texture::LoadFromFile(const std::string &path)
 {
     // stb_image loads images with (0,0) at the top-left by default.
-    // OpenGL expects (0,0) at the bottom-left, so we flip vertically.
-    stbi_set_flip_vertically_on_load(true);
-
-    // stb_load returns the actual channel count in m_Channels.
-    // The last param (0) means "give me whatever channels the file has".
-    unsigned char *data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_Channels, 0);
-    if (!data)
+    // OpenGL expects (0,0) at the bottom-left, so we ask for flipped rows.
+    // The cache returns the decoded pixels from disk when the file is unchanged.
+    ImageCache::Image image;
+    if (!ImageCache::Load(path, true, image))
     {
         std::cerr << "Failed to load texture: " << path << std::endl;
         return false;
     }
 
-    m_ImageData.clear();
+    m_Width = image.width;
+    m_Height = image.height;
+    m_Channels = image.channels;
 
     // Keep a CPU copy of the image data. This allows us to:
     // 1. Recreate the OpenGL texture after a context switch
     // 2. Create a Vulkan texture later (deferred creation)
     // 3. Support multiple graphics backends from the same source
-    size_t dataSize = m_Width * m_Height * m_Channels;
-    m_ImageData.resize(dataSize);
-    memcpy(m_ImageData.data(), data, dataSize);
+    m_ImageData = std::move(image.pixels);
 
     // Create OpenGL texture immediately only if a context is active.
     // In Vulkan mode there is no GL context; keep CPU data and upload later.
     if (glfwGetCurrentContext() != nullptr)
     {
-        CreateOpenGLTexture(data, true);
+        CreateOpenGLTexture(m_ImageData.data(), true);
     }
     else
     {
@@ -178,8 +211,6 @@ bool Texture::LoadFromFile(const std::string &path)
     // command pool, and queue handles that we don't have access to here.
     // Call CreateVulkanTexture() later once those are available.
 
-    // Free stb_image's allocation - we have our own copy now
-    stbi_image_free(data);
     return true;
 }
 
@@ -241,6 +272,70 @@ bool Texture::LoadFromData(unsigned char *data, int width, int height, int chann
     return true;
 }
 
+bool Texture::AdoptPixels(std::vector<unsigned char> &&pixels, int width, int height, int channels)
+{
+    if (width <= 0 || height <= 0 || channels <= 0 ||
+        pixels.size() != static_cast<size_t>(PixelBytes(width, height, channels)))
+    {
+        std::cerr << "Invalid data for texture loading" << std::endl;
+        return false;
+    }
+
+    // The old GPU copy has the old size; the next UploadTexture() creates a new one
+    DestroyOpenGLTexture();
+    if (m_VulkanDevice != VK_NULL_HANDLE)
+    {
+        DestroyVulkanTexture(m_VulkanDevice);
+    }
+
+    m_Width = width;
+    m_Height = height;
+    m_Channels = channels;
+    m_ImageData = std::move(pixels);
+    return true;
+}
+
+void Texture::DestroyOpenGLTexture()
+{
+    if (m_OpenGLID != 0 && glfwGetCurrentContext() != nullptr &&
+        m_OpenGLContextGeneration == s_CurrentOpenGLContextGeneration)
+    {
+        glDeleteTextures(1, &m_OpenGLID);
+        s_OpenGLTextureBytes.fetch_sub(PixelBytes(m_Width, m_Height, m_Channels), std::memory_order_relaxed);
+    }
+    m_OpenGLID = 0;
+    m_OpenGLContextTag = nullptr;
+    m_OpenGLContextGeneration = 0;
+}
+
+bool Texture::UpdateOpenGLRegion(int x, int y, int width, int height)
+{
+    if (m_OpenGLID == 0 || m_OpenGLContextGeneration != s_CurrentOpenGLContextGeneration ||
+        x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > m_Width || y + height > m_Height ||
+        m_ImageData.size() != static_cast<size_t>(PixelBytes(m_Width, m_Height, m_Channels)))
+    {
+        return false;
+    }
+
+    GLenum format = GL_RGBA;
+    if (m_Channels == 1)
+        format = GL_RED;
+    else if (m_Channels == 3)
+        format = GL_RGB;
+
+    // Read the rectangle straight out of the full-width CPU copy
+    const size_t first = (static_cast<size_t>(y) * static_cast<size_t>(m_Width) + static_cast<size_t>(x)) *
+                         static_cast<size_t>(m_Channels);
+    glBindTexture(GL_TEXTURE_2D, m_OpenGLID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_Width);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, format, GL_UNSIGNED_BYTE, m_ImageData.data() + first);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return true;
+}
+
 void Texture::CreateOpenGLTexture(unsigned char *data, bool flipY)
 {
     // Generate a new texture object and bind it for configuration
@@ -269,6 +364,7 @@ void Texture::CreateOpenGLTexture(unsigned char *data, bool flipY)
     // - type: GL_UNSIGNED_BYTE (8 bits per channel)
     // - data: pointer to pixel data
     glTexImage2D(GL_TEXTURE_2D, 0, format, m_Width, m_Height, 0, format, GL_UNSIGNED_BYTE, data);
+    s_OpenGLTextureBytes.fetch_add(PixelBytes(m_Width, m_Height, m_Channels), std::memory_order_relaxed);
 
     // Texture wrapping - clamp to edge prevents sampling artifacts at borders
     // This is important for sprite sheets where we don't want neighboring tiles bleeding in
@@ -282,6 +378,34 @@ void Texture::CreateOpenGLTexture(unsigned char *data, bool flipY)
 
     // Unbind to prevent accidental modification
     glBindTexture(GL_TEXTURE_2D, 0);
+    TrackUpload();
+}
+
+void Texture::TrackUpload()
+{
+    if (m_Tracked)
+        return;
+    UploadStore &store = Uploads();
+    std::lock_guard<std::mutex> lock(store.mutex);
+    store.textures.insert(this);
+    m_Tracked = true;
+}
+
+void Texture::UntrackUpload()
+{
+    if (!m_Tracked)
+        return;
+    UploadStore &store = Uploads();
+    std::lock_guard<std::mutex> lock(store.mutex);
+    store.textures.erase(this);
+    m_Tracked = false;
+}
+
+std::vector<Texture *> Texture::GetUploadedTextures()
+{
+    UploadStore &store = Uploads();
+    std::lock_guard<std::mutex> lock(store.mutex);
+    return std::vector<Texture *>(store.textures.begin(), store.textures.end());
 }
 
 void Texture::Bind(unsigned int slot) const
@@ -326,6 +450,7 @@ void Texture::RecreateOpenGLTexture()
         m_OpenGLContextGeneration == s_CurrentOpenGLContextGeneration)
     {
         glDeleteTextures(1, &m_OpenGLID);
+        s_OpenGLTextureBytes.fetch_sub(PixelBytes(m_Width, m_Height, m_Channels), std::memory_order_relaxed);
     }
     m_OpenGLID = 0;
     m_OpenGLContextTag = nullptr;
@@ -343,6 +468,8 @@ void Texture::AdvanceOpenGLContextGeneration()
     {
         s_CurrentOpenGLContextGeneration = 1;
     }
+    // Textures of the old context are never deleted through this class again
+    s_OpenGLTextureBytes.store(0, std::memory_order_relaxed);
 }
 
 std::uint64_t Texture::GetCurrentOpenGLContextGeneration()
@@ -350,15 +477,30 @@ std::uint64_t Texture::GetCurrentOpenGLContextGeneration()
     return s_CurrentOpenGLContextGeneration;
 }
 
-void Texture::CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue)
+std::size_t Texture::GetOpenGLTextureBytes()
 {
-    // Vulkan texture creation is more complex than OpenGL because we must:
-    // 1. Create the image object (describes the texture properties)
-    // 2. Allocate GPU memory for the image
-    // 3. Create an image view (how shaders see the image)
-    // 4. Create a sampler (how to filter/wrap the texture)
-    // 5. Upload pixel data via a staging buffer
+    return static_cast<std::size_t>(std::max<std::int64_t>(0, s_OpenGLTextureBytes.load(std::memory_order_relaxed)));
+}
+
+std::size_t Texture::GetVulkanTextureBytes()
+{
+    return static_cast<std::size_t>(std::max<std::int64_t>(0, s_VulkanTextureBytes.load(std::memory_order_relaxed)));
+}
 
+std::size_t Texture::GetGpuBytes() const
+{
+    std::size_t bytes = static_cast<std::size_t>(m_VulkanMemoryBytes);
+    // Same rule as s_OpenGLTextureBytes: names of an earlier context are not counted
+    if (m_OpenGLID != 0 && m_OpenGLContextGeneration == s_CurrentOpenGLContextGeneration)
+    {
+        bytes += static_cast<std::size_t>(PixelBytes(m_Width, m_Height, m_Channels));
+    }
+    return bytes;
+}
+
+void Texture::CreateVulkanImage(VkDevice device, VkPhysicalDevice physicalDevice,
+                                const std::vector<uint32_t> &queueFamilies)
+{
     if (m_ImageData.empty())
     {
         std::cerr << "Cannot create Vulkan texture: no image data" << std::endl;
@@ -390,7 +532,18 @@ void Texture::CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevi
     // TRANSFER_DST: we'll copy data into this image
     // SAMPLED: shaders will sample from this image
     imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;  // Only one queue family uses this
+    // Images written on a dedicated transfer queue and sampled on the graphics
+    // queue are shared concurrently, which avoids queue ownership transfers
+    if (queueFamilies.size() > 1)
+    {
+        imageInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        imageInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilies.size());
+        imageInfo.pQueueFamilyIndices = queueFamilies.data();
+    }
+    else
+    {
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;  // Only one queue family uses this
+    }
     imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;  // No multisampling
 
     if (vkCreateImage(device, &imageInfo, nullptr, &m_VulkanImage) != VK_SUCCESS)
@@ -436,6 +589,9 @@ void Texture::CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevi
 
     // Bind memory to image - now the image has backing storage
     vkBindImageMemory(device, m_VulkanImage, m_VulkanImageMemory, 0);
+    s_VulkanTextureBytes.fetch_add(static_cast<std::int64_t>(memRequirements.size), std::memory_order_relaxed);
+    m_VulkanMemoryBytes = memRequirements.size;
+    TrackUpload();
 
     // Step 3: Create image view - this is what shaders actually reference
     VkImageViewCreateInfo viewInfo{};
@@ -477,6 +633,33 @@ void Texture::CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevi
     {
         throw std::runtime_error("Failed to create Vulkan sampler!");
     }
+}
+
+VkDeviceSize Texture::GetVulkanUploadSize() const
+{
+    return static_cast<VkDeviceSize>(m_Width) * m_Height * m_Channels;
+}
+
+void Texture::CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue)
+{
+    // Vulkan texture creation is more complex than OpenGL because we must:
+    // 1. Create the image object (describes the texture properties)
+    // 2. Allocate GPU memory for the image
+    // 3. Create an image view (how shaders see the image)
+    // 4. Create a sampler (how to filter/wrap the texture)
+    // 5. Upload pixel data via a staging buffer
+
+    if (m_ImageData.empty())
+    {
+        std::cerr << "Cannot create Vulkan texture: no image data" << std::endl;
+        return;
+    }
+
+    CreateVulkanImage(device, physicalDevice);
+    if (m_VulkanImage == VK_NULL_HANDLE)
+    {
+        return;
+    }
 
     // Step 5: Upload pixel data using a staging buffer
     // We can't write directly to device-local memory, so we:
@@ -672,6 +855,13 @@ void Texture::DestroyVulkanTexture(VkDevice device)
     // Image depends on memory
     if (m_VulkanImage != VK_NULL_HANDLE)
     {
+        if (m_VulkanImageMemory != VK_NULL_HANDLE)
+        {
+            VkMemoryRequirements memRequirements;
+            vkGetImageMemoryRequirements(device, m_VulkanImage, &memRequirements);
+            s_VulkanTextureBytes.fetch_sub(static_cast<std::int64_t>(memRequirements.size),
+                                           std::memory_order_relaxed);
+        }
         vkDestroyImage(device, m_VulkanImage, nullptr);
         m_VulkanImage = VK_NULL_HANDLE;
     }
@@ -681,4 +871,5 @@ void Texture::DestroyVulkanTexture(VkDevice device)
         vkFreeMemory(device, m_VulkanImageMemory, nullptr);
         m_VulkanImageMemory = VK_NULL_HANDLE;
     }
+    m_VulkanMemoryBytes = 0;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "MemoryTracker.h"
+
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -40,6 +42,19 @@
  * - Vulkan texture creation is deferred (requires device handles)
  * - Enables runtime renderer switching
  *
+ * @par Uploaded Textures
+ * Every texture that has had a GPU copy, on either backend, is listed in a
+ * process-wide store until it is destroyed. A renderer switch re-creates
+ * the GPU copies of GetUploadedTextures() from their CPU buffers in one
+ * IRenderer::UploadTextures() pass, without asking each subsystem for its
+ * textures or touching the disk. Moving a texture moves its entry.
+ *
+ * @par Memory Accounting
+ * GetCpuBytes() and GetGpuBytes() report what one texture holds, and its
+ * memory tag names the subsystem MemoryTracker charges it to. MarkUsed()
+ * stamps the texture with the current use frame (AdvanceUseFrame()) so
+ * SpriteSheetRegistry can find sheets nothing has drawn for a while.
+ *
  * @par Coordinate System
  * OpenGL and Vulkan have different texture coordinate conventions:
  * @code
@@ -192,6 +207,22 @@ public:
      */
     bool LoadFromData(unsigned char *data, int width, int height, int channels, bool flipY = true);
 
+    /**
+     * @brief Take over decoded pixels without creating any GPU texture.
+     *
+     * Used by AsyncTextureLoader to replace a placeholder once its image
+     * has been decoded. GPU resources the texture already had are dropped
+     * (hand it to IRenderer::ReleaseTexture() first while a frame may still
+     * draw it); IRenderer::UploadTexture() creates the new ones.
+     *
+     * @param pixels   Row-major pixels in upload order (already flipped).
+     * @param width    Image width in pixels (must be > 0).
+     * @param height   Image height in pixels (must be > 0).
+     * @param channels Number of color channels (1, 3, or 4).
+     * @return false on invalid parameters; the texture is left unchanged.
+     */
+    bool AdoptPixels(std::vector<unsigned char> &&pixels, int width, int height, int channels);
+
     /// @}
 
     /// @name OpenGL Operations
@@ -234,6 +265,24 @@ public:
      */
     void RecreateOpenGLTexture();
 
+    /**
+     * @brief Delete the OpenGL texture if it belongs to the current context.
+     *
+     * Names left behind by an earlier context are only forgotten. Safe to
+     * call multiple times; the CPU copy is kept.
+     */
+    void DestroyOpenGLTexture();
+
+    /**
+     * @brief Copy a rectangle of m_ImageData into the existing OpenGL texture.
+     *
+     * @param x, y          First texel, in m_ImageData row order.
+     * @param width, height Rectangle size in texels.
+     * @return false if there is no OpenGL texture in the current context or
+     *         the rectangle is outside the image.
+     */
+    bool UpdateOpenGLRegion(int x, int y, int width, int height);
+
     /**
      * @brief Advance global OpenGL context generation after creating a new GL context.
      */
@@ -244,6 +293,64 @@ public:
      */
     static std::uint64_t GetCurrentOpenGLContextGeneration();
 
+    /**
+     * @brief Pixel bytes of all live textures in the current OpenGL context.
+     *
+     * Counted as width * height * channels at upload; textures left behind
+     * by an earlier context are dropped when the generation advances.
+     */
+    static std::size_t GetOpenGLTextureBytes();
+
+    /// @brief Device memory bound to all live Vulkan texture images.
+    static std::size_t GetVulkanTextureBytes();
+
+    /**
+     * @brief Every live texture that has had a GPU copy on any backend.
+     *
+     * Textures stay listed after the renderer that uploaded them is shut
+     * down, so the next one can upload them again. Order is unspecified.
+     */
+    static std::vector<Texture *> GetUploadedTextures();
+
+    /// @}
+
+    /// @name Memory Accounting
+    /// @{
+
+    /**
+     * @brief Charge this texture to @p tag in MemoryTracker::Collect().
+     *
+     * The tag belongs to the object, not its pixels: move-assigning another
+     * texture into a tagged member keeps the member's tag.
+     */
+    void SetMemoryTag(MemoryTracker::Subsystem tag) { m_MemoryTag = tag; }
+
+    /// @brief Subsystem this texture is charged to (Other unless tagged).
+    MemoryTracker::Subsystem GetMemoryTag() const { return m_MemoryTag; }
+
+    /// @brief Bytes reserved by the CPU pixel buffer.
+    std::size_t GetCpuBytes() const { return m_ImageData.capacity(); }
+
+    /**
+     * @brief GPU bytes held by this texture.
+     *
+     * Texels of the OpenGL copy, if it belongs to the current context, plus
+     * the device memory bound to the Vulkan image.
+     */
+    std::size_t GetGpuBytes() const;
+
+    /// @brief Record that the texture is drawn in the current use frame.
+    void MarkUsed() const { m_LastUsedFrame = s_UseFrame; }
+
+    /// @brief Use frame of the last MarkUsed() (0 = never).
+    std::uint64_t GetLastUsedFrame() const { return m_LastUsedFrame; }
+
+    /// @brief Start the next use frame; the game calls this once per frame.
+    static void AdvanceUseFrame() { ++s_UseFrame; }
+
+    /// @brief Current use frame (starts at 1).
+    static std::uint64_t GetUseFrame() { return s_UseFrame; }
+
     /// @}
 
     /// @name Vulkan Operations
@@ -263,6 +370,13 @@ public:
      */
     VkSampler GetVulkanSampler() const { return m_VulkanSampler; }
 
+    /**
+     * @brief Get the device that owns the Vulkan resources.
+     *
+     * @return VkDevice handle (VK_NULL_HANDLE if not created).
+     */
+    VkDevice GetVulkanDevice() const { return m_VulkanDevice; }
+
     /**
      * @brief Create Vulkan texture resources.
      *
@@ -285,6 +399,29 @@ public:
      */
     void CreateVulkanTexture(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue);
 
+    /**
+     * @brief Create the Vulkan image, memory, view and sampler without uploading.
+     *
+     * Steps 1-4 of CreateVulkanTexture(). The image is left in
+     * VK_IMAGE_LAYOUT_UNDEFINED; VulkanUploadManager records the copy and
+     * layout transitions itself so uploads can be batched.
+     *
+     * @param device         Vulkan logical device.
+     * @param physicalDevice Vulkan physical device (for memory type queries).
+     * @param queueFamilies  Queue families accessing the image. More than one
+     *                       creates it with VK_SHARING_MODE_CONCURRENT.
+     *
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    void CreateVulkanImage(VkDevice device, VkPhysicalDevice physicalDevice,
+                           const std::vector<uint32_t> &queueFamilies = {});
+
+    /**
+     * @brief Size of the pixel data copied by a Vulkan upload.
+     * @return Width * height * channels, in bytes.
+     */
+    VkDeviceSize GetVulkanUploadSize() const;
+
     /**
      * @brief Destroy Vulkan texture resources.
      *
@@ -339,6 +476,7 @@ public:
     VkImageView m_VulkanImageView{VK_NULL_HANDLE};       ///< Image view for shader sampling
     VkSampler m_VulkanSampler{VK_NULL_HANDLE};           ///< Sampler with filtering settings
     VkDevice m_VulkanDevice{VK_NULL_HANDLE};             ///< Cached device handle for cleanup
+    VkDeviceSize m_VulkanMemoryBytes{0};                 ///< Size of m_VulkanImageMemory
 
     /// @}
 
@@ -368,7 +506,18 @@ private:
      */
     void CreateOpenGLTexture(unsigned char *data, bool flipY);
 
+    /// @brief Add this texture to the uploaded-texture store (once).
+    void TrackUpload();
+
+    /// @brief Remove this texture from the uploaded-texture store, if listed.
+    void UntrackUpload();
+
     static std::uint64_t s_CurrentOpenGLContextGeneration;
+    static std::uint64_t s_UseFrame;
+
+    bool m_Tracked{false};  ///< Listed by GetUploadedTextures()
+    MemoryTracker::Subsystem m_MemoryTag{MemoryTracker::Subsystem::Other};
+    mutable std::uint64_t m_LastUsedFrame{0};  ///< See MarkUsed()
 
     /// @}
 };
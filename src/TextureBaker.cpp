@@ -0,0 +1,53 @@
+#include "TextureBaker.h"
+#include "JobSystem.h"
+
+#include <atomic>
+#include <iostream>
+
+void TextureBaker::AddGenerated(std::string name, std::uint64_t paramsHash, Generator generate,
+                                ImageCache::Image &out)
+{
+    m_Tasks.push_back({std::move(name), paramsHash, std::move(generate), false, &out});
+}
+
+void TextureBaker::AddFile(std::string path, bool flipY, ImageCache::Image &out)
+{
+    m_Tasks.push_back({std::move(path), 0, {}, flipY, &out});
+}
+
+int TextureBaker::Run(JobSystem *jobs)
+{
+    std::atomic<int> failed{0};
+    auto runTasks = [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Task &task = m_Tasks[i];
+            const bool ok = task.generate
+                                ? ImageCache::LoadGenerated(task.key, task.paramsHash, task.generate, *task.out)
+                                : ImageCache::Load(task.key, task.flipY, *task.out);
+            if (!ok)
+            {
+                *task.out = ImageCache::Image{};
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // One image per chunk: tasks differ in cost by orders of magnitude
+    if (jobs)
+        jobs->ParallelFor(m_Tasks.size(), 1, runTasks);
+    else
+        runTasks(0, m_Tasks.size());
+
+    // Report on the calling thread so messages from different tasks do not interleave
+    for (const Task &task : m_Tasks)
+    {
+        if (task.out->pixels.empty())
+            std::cerr << "Failed to " << (task.generate ? "generate texture: " : "load texture: ") << task.key
+                      << std::endl;
+    }
+
+    m_Tasks.clear();
+    return failed.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ImageCache.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @class TextureBaker
+ * @brief Produces the pixels of a batch of startup textures in parallel.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Systems queue every texture they need before the first frame, either a
+ * file decode (AddFile()) or a procedural generator (AddGenerated()), and
+ * Run() executes the whole batch as one task per image on a JobSystem.
+ * Both kinds go through ImageCache, so an unchanged file or an unchanged
+ * set of generator parameters loads pre-baked pixels instead of decoding or
+ * generating them.
+ *
+ * Only CPU pixels are produced. Creating the Texture objects
+ * (Texture::LoadFromData()) touches the graphics context and stays on the
+ * calling thread after Run() returns.
+ *
+ * @par Example
+ * @code{.cpp}
+ * ImageCache::Image star, sheet;
+ * TextureBaker baker;
+ * baker.AddGenerated("sky.star", ImageCache::HashParams({1, 64}), GenerateStar, star);
+ * baker.AddFile("assets/sheet.png", true, sheet);
+ * baker.Run(&jobs);
+ * @endcode
+ *
+ * @par Thread Safety
+ * Generators run concurrently with each other and must only write the
+ * Image they are given. Add*() and Run() are called from one thread.
+ *
+ * @see ImageCache::LoadGenerated(), JobSystem::ParallelFor()
+ */
+class TextureBaker
+{
+public:
+    using Generator = std::function<void(ImageCache::Image &)>;
+
+    /**
+     * @brief Queue a procedural image.
+     * @param name       Cache key, unique per generator (e.g. "sky.star").
+     * @param paramsHash ImageCache::HashParams() of the generator revision and sizes.
+     * @param generate   Fills the image on a cache miss.
+     * @param out        Receives the pixels; must outlive Run().
+     */
+    void AddGenerated(std::string name, std::uint64_t paramsHash, Generator generate, ImageCache::Image &out);
+
+    /// @brief Queue a file decode through ImageCache::Load(); @p out must outlive Run().
+    void AddFile(std::string path, bool flipY, ImageCache::Image &out);
+
+    /**
+     * @brief Produce every queued image, then clear the queue.
+     * @param jobs Worker pool, or nullptr to run every task on this thread.
+     * @return Number of tasks that failed (their Image is left empty).
+     */
+    int Run(JobSystem *jobs);
+
+private:
+    struct Task
+    {
+        std::string key;            ///< Generator name or file path
+        std::uint64_t paramsHash;   ///< Generated tasks only
+        Generator generate;         ///< Empty for file tasks
+        bool flipY;                 ///< File tasks only
+        ImageCache::Image *out;
+    };
+
+    std::vector<Task> m_Tasks;
+};
@@ -1,15 +1,23 @@
 #include "Tilemap.h"
 #include "NonPlayerCharacter.h"
+#include "BinaryMap.h"
+#include "ImageCache.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 
 #include <iostream>
 #include <algorithm>
+#include <bit>
 #include <random>
 #include <vector>
 #include <cmath>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <functional>
+#include <future>
+#include <thread>
 #include <cstring>
 #include <json.hpp>
 #include <glad/glad.h>
@@ -27,20 +35,20 @@ Tilemap::Tilemap()
     , m_TilesetWidth(0)
     , m_TilesetHeight(0)
     , m_TilesPerRow(0)
-    , m_TilesetData(nullptr)
     , m_TilesetDataWidth(0)
     , m_TilesetDataHeight(0)
-    , m_TilesetChannels(0)
-    , m_TilesetDataFromStbi(false)
     , m_TransparencyCacheBuilt(false)
     , m_AnimationTime(0.0f)
+    , m_ChunksX(0)
+    , m_ChunksY(0)
+    , m_ChunkRenderer(nullptr)
 {
-    // Allocate storage for all layers using row-major layout: size = width * height
-    const size_t mapSize = m_MapWidth * m_MapHeight;
+    m_TilesetTexture.SetMemoryTag(MemoryTracker::Subsystem::Tileset);
 
     // Collision and navigation maps
     m_CollisionMap.Resize(m_MapWidth, m_MapHeight);
     m_NavigationMap.Resize(m_MapWidth, m_MapHeight);
+    ResetBlockRevisions();
 
     // Initialize 10 dynamic layers with proper render order:
     // Background layers (rendered before player/NPCs):
@@ -70,90 +78,139 @@ Tilemap::Tilemap()
     // Resize all layers to map size
     for (auto &layer : m_Layers)
     {
-        layer.resize(mapSize);
+        layer.resize(m_MapWidth, m_MapHeight);
     }
 
-    // Initialize animation map (all tiles start with no animation)
-    m_TileAnimationMap.assign(mapSize, -1);
-
     // Defer map generation until tileset is loaded
     // GenerateDefaultMap() will be called from SetTilemapSize() after LoadCombinedTilesets()
 }
 
-Tilemap::~Tilemap()
+Tilemap::~Tilemap() = default;
+
+/// Key that names the same file however the path was spelled
+static std::string TilesetKey(const std::string &path)
+{
+    std::error_code error;
+    const std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    return (error ? std::filesystem::path(path) : absolute).lexically_normal().generic_string();
+}
+
+/// True if no pixel of a tile counts as visible. RGBA tiles are visible where
+/// alpha > 0, RGB tiles where a pixel is neither pure black nor pure white.
+static bool IsTilePixelsTransparent(const unsigned char *pixels, size_t stride, int channels,
+                                    int tileWidth, int tileHeight)
+{
+    for (int y = 0; y < tileHeight; ++y)
+    {
+        const unsigned char *row = pixels + static_cast<size_t>(y) * stride;
+
+        // Branch-free OR reductions over a whole row so the compiler can vectorize them
+        unsigned visible = 0;
+        if (channels == 4)
+        {
+            for (int x = 0; x < tileWidth; ++x)
+                visible |= row[x * 4 + 3];
+        }
+        else if (channels == 3)
+        {
+            for (int x = 0; x < tileWidth; ++x)
+            {
+                const uint32_t rgb = row[x * 3] | (row[x * 3 + 1] << 8) | (static_cast<uint32_t>(row[x * 3 + 2]) << 16);
+                visible |= static_cast<unsigned>((rgb != 0) & (rgb != 0xFFFFFFu));
+            }
+        }
+        if (visible)
+            return false;
+    }
+    return true;
+}
+
+/// True if every pixel of a tile is visible, by the same rules as IsTilePixelsTransparent()
+/// except that RGBA pixels must have alpha = 255 (blended pixels let the layer below through)
+static bool IsTilePixelsOpaque(const unsigned char *pixels, size_t stride, int channels,
+                               int tileWidth, int tileHeight)
 {
-    if (m_TilesetData)
+    for (int y = 0; y < tileHeight; ++y)
     {
-        if (m_TilesetDataFromStbi)
-            stbi_image_free(m_TilesetData);
+        const unsigned char *row = pixels + static_cast<size_t>(y) * stride;
+
+        // AND reductions, same layout as the transparency scan
+        unsigned solid = 1;
+        if (channels == 4)
+        {
+            for (int x = 0; x < tileWidth; ++x)
+                solid &= static_cast<unsigned>(row[x * 4 + 3] == 0xFF);
+        }
+        else if (channels == 3)
+        {
+            for (int x = 0; x < tileWidth; ++x)
+            {
+                const uint32_t rgb = row[x * 3] | (row[x * 3 + 1] << 8) | (static_cast<uint32_t>(row[x * 3 + 2]) << 16);
+                solid &= static_cast<unsigned>((rgb != 0) & (rgb != 0xFFFFFFu));
+            }
+        }
         else
-            delete[] m_TilesetData;
-        m_TilesetData = nullptr;
+        {
+            solid = 0;
+        }
+        if (!solid)
+            return false;
     }
+    return true;
 }
 
-void Tilemap::BuildTransparencyCache()
+void Tilemap::BuildTransparencyCache(const unsigned char *pixels, int channels)
 {
-    if (!m_TilesetData || m_TilesetChannels == 0)
+    if (!pixels || channels == 0)
     {
         m_TransparencyCacheBuilt = false;
         return;
     }
 
-    int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    int dataTilesPerCol = m_TilesetDataHeight / m_TileHeight;
-    int totalTiles = dataTilesPerRow * dataTilesPerCol;
-
-    m_TileTransparencyCache.resize(totalTiles, true);
-
-    for (int tileID = 0; tileID < totalTiles; ++tileID)
+    const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
+    const int dataTilesPerCol = m_TilesetDataHeight / m_TileHeight;
+    const int totalTiles = dataTilesPerRow * dataTilesPerCol;
+    const size_t stride = static_cast<size_t>(m_TilesetDataWidth) * static_cast<size_t>(channels);
+
+    m_TileTransparencyCache.assign(static_cast<size_t>(totalTiles), 1);
+    m_TileOpaqueCache.assign(static_cast<size_t>(totalTiles), 0);
+
+    // Tile rows are independent, split them into one band per hardware thread
+    const int workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, std::max(1, dataTilesPerCol));
+    const int rowsPerWorker = (dataTilesPerCol + workers - 1) / workers;
+    std::vector<std::future<void>> bands;
+    for (int firstRow = 0; firstRow < dataTilesPerCol; firstRow += rowsPerWorker)
     {
-        int tilesetX = (tileID % dataTilesPerRow) * m_TileWidth;
-        int tilesetY = (tileID / dataTilesPerRow) * m_TileHeight;
-
-        bool isTransparent = true;
-
-        // Scan pixels in this tile
-        for (int y = 0; y < m_TileHeight && isTransparent; ++y)
+        const int lastRow = std::min(dataTilesPerCol, firstRow + rowsPerWorker);
+        bands.push_back(std::async(std::launch::async, [=, this]()
         {
-            for (int x = 0; x < m_TileWidth && isTransparent; ++x)
+            for (int tileRow = firstRow; tileRow < lastRow; ++tileRow)
             {
-                int px = tilesetX + x;
-                int py = tilesetY + y;
-
-                if (px >= m_TilesetDataWidth || py >= m_TilesetDataHeight)
-                    continue;
-
-                int index = (py * m_TilesetDataWidth + px) * m_TilesetChannels;
-
-                if (m_TilesetChannels == 4)
-                {
-                    unsigned char alpha = m_TilesetData[index + 3];
-                    if (alpha > 0)
-                        isTransparent = false;
-                }
-                else if (m_TilesetChannels == 3)
+                for (int tileCol = 0; tileCol < dataTilesPerRow; ++tileCol)
                 {
-                    unsigned char r = m_TilesetData[index];
-                    unsigned char g = m_TilesetData[index + 1];
-                    unsigned char b = m_TilesetData[index + 2];
-                    bool isPureBlack = (r == 0 && g == 0 && b == 0);
-                    bool isPureWhite = (r == 255 && g == 255 && b == 255);
-                    if (!isPureBlack && !isPureWhite)
-                        isTransparent = false;
+                    const unsigned char *tile = pixels + static_cast<size_t>(tileRow * m_TileHeight) * stride +
+                                                static_cast<size_t>(tileCol * m_TileWidth * channels);
+                    const size_t tileID = static_cast<size_t>(tileRow * dataTilesPerRow + tileCol);
+                    m_TileTransparencyCache[tileID] =
+                        IsTilePixelsTransparent(tile, stride, channels, m_TileWidth, m_TileHeight) ? 1 : 0;
+                    m_TileOpaqueCache[tileID] =
+                        IsTilePixelsOpaque(tile, stride, channels, m_TileWidth, m_TileHeight) ? 1 : 0;
                 }
             }
-        }
-
-        m_TileTransparencyCache[tileID] = isTransparent;
+        }));
     }
+    for (auto &band : bands)
+        band.get();
 
     m_TransparencyCacheBuilt = true;
+    m_OccludersDirty = true;
     std::cout << "Built transparency cache for " << totalTiles << " tiles" << std::endl;
 }
 
 bool Tilemap::LoadCombinedTilesets(const std::vector<std::string> &paths, int tileWidth, int tileHeight)
 {
+    ReleaseChunkMeshes();
+
     if (paths.empty())
     {
         std::cerr << "ERROR: No tileset paths provided!" << std::endl;
@@ -163,130 +220,98 @@ bool Tilemap::LoadCombinedTilesets(const std::vector<std::string> &paths, int ti
     m_TileWidth = tileWidth;
     m_TileHeight = tileHeight;
 
-    // Load all tilesets as raw data
-    stbi_set_flip_vertically_on_load(false);
-
-    struct TilesetData
+    // Read the headers first so the combined layout is known before decoding
+    struct TilesetInfo
     {
-        unsigned char *data;
         int width;
         int height;
         int channels;
+        int offsetY;  ///< First row in the combined image
     };
 
-    std::vector<TilesetData> tilesets;
-    tilesets.reserve(paths.size());
-
-    // Load all tilesets
+    std::vector<TilesetInfo> tilesets(paths.size());
+    int combinedWidth = 0;
+    int combinedHeight = 0;
     for (size_t i = 0; i < paths.size(); ++i)
     {
-        int width, height, channels;
-        unsigned char *data = stbi_load(paths[i].c_str(), &width, &height, &channels, 0);
-        if (!data)
+        TilesetInfo &ts = tilesets[i];
+        if (!stbi_info(paths[i].c_str(), &ts.width, &ts.height, &ts.channels))
         {
             std::cerr << "ERROR: Could not load tileset " << (i + 1) << ": " << paths[i] << std::endl;
-            // Clean up already loaded tilesets
-            for (auto &ts : tilesets)
-            {
-                stbi_image_free(ts.data);
-            }
             return false;
         }
-        tilesets.push_back({data, width, height, channels});
-    }
-
-    // Verify at least one tileset was loaded
-    if (tilesets.empty())
-    {
-        std::cerr << "ERROR: No tilesets were loaded!" << std::endl;
-        return false;
+        ts.offsetY = combinedHeight;
+        combinedWidth = std::max(combinedWidth, ts.width);
+        combinedHeight += ts.height;
     }
 
     // Verify all tilesets have same channels
-    int channels = tilesets[0].channels;
+    const int channels = tilesets[0].channels;
     for (size_t i = 1; i < tilesets.size(); ++i)
     {
         if (tilesets[i].channels != channels)
         {
             std::cerr << "ERROR: Tilesets must have the same number of channels! Tileset 1: " << channels
                       << ", Tileset " << (i + 1) << ": " << tilesets[i].channels << std::endl;
-            // Clean up
-            for (auto &ts : tilesets)
-            {
-                stbi_image_free(ts.data);
-            }
             return false;
         }
     }
 
-    // Find maximum width for the combined tileset
-    int combinedWidth = tilesets[0].width;
-    int combinedHeight = 0;
-    for (const auto &ts : tilesets)
-    {
-        combinedWidth = std::max(combinedWidth, ts.width);
-        combinedHeight += ts.height;
-    }
-
-    // Allocate combined data
-    unsigned char *combinedData = new unsigned char[combinedWidth * combinedHeight * channels];
-
-    // Initialize combined data to transparent (0)
-    memset(combinedData, 0, combinedWidth * combinedHeight * channels);
+    // Stack tilesets vertically; narrower ones keep transparent (zero) padding
+    const size_t combinedStride = static_cast<size_t>(combinedWidth) * static_cast<size_t>(channels);
+    std::vector<unsigned char> combinedData(combinedStride * static_cast<size_t>(combinedHeight), 0);
 
-    // Copy each tileset vertically, stacking them
-    int currentY = 0;
-    for (size_t i = 0; i < tilesets.size(); ++i)
+    // Decode every tileset on its own thread, each straight into its rows of the combined image
+    std::vector<std::future<bool>> decodes;
+    decodes.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
     {
-        const auto &ts = tilesets[i];
-        for (int y = 0; y < ts.height; ++y)
+        decodes.push_back(std::async(std::launch::async, [&, i]()
         {
-            // Calculate offsets with explicit bounds check
-            size_t destOffset = static_cast<size_t>(currentY + y) * static_cast<size_t>(combinedWidth) * static_cast<size_t>(channels);
-            size_t srcOffset = static_cast<size_t>(y) * static_cast<size_t>(ts.width) * static_cast<size_t>(channels);
-            size_t copySize = static_cast<size_t>(ts.width) * static_cast<size_t>(channels);
-            size_t destSize = static_cast<size_t>(combinedWidth) * static_cast<size_t>(combinedHeight) * static_cast<size_t>(channels);
-
-            // Verify bounds before copy
-            if (destOffset + copySize <= destSize)
+            const TilesetInfo &ts = tilesets[i];
+            ImageCache::Image image;
+            if (!ImageCache::Load(paths[i], false, image))
+                return false;
+            if (image.width != ts.width || image.height != ts.height || image.channels != channels)
+                return false;
+
+            const unsigned char *data = image.pixels.data();
+            const size_t srcStride = static_cast<size_t>(image.width) * static_cast<size_t>(channels);
+            unsigned char *dest = combinedData.data() + static_cast<size_t>(ts.offsetY) * combinedStride;
+            if (srcStride == combinedStride)
             {
-                memcpy(combinedData + destOffset, ts.data + srcOffset, copySize);
+                std::memcpy(dest, data, srcStride * static_cast<size_t>(image.height));
             }
-            // Rest of the row is already transparent from memset
-        }
-        currentY += ts.height;
+            else
+            {
+                for (int y = 0; y < image.height; ++y)
+                    std::memcpy(dest + y * combinedStride, data + y * srcStride, srcStride);
+            }
+            return true;
+        }));
     }
 
-    // Create OpenGL texture from combined data
-    // Flip vertically for OpenGL (origin at bottom-left)
-    unsigned char *flippedData = new unsigned char[combinedWidth * combinedHeight * channels];
-    for (int y = 0; y < combinedHeight; ++y)
+    bool decoded = true;
+    for (size_t i = 0; i < decodes.size(); ++i)
     {
-        int srcY = combinedHeight - 1 - y;
-        memcpy(flippedData + y * combinedWidth * channels,
-               combinedData + srcY * combinedWidth * channels,
-               combinedWidth * channels);
+        if (!decodes[i].get())
+        {
+            std::cerr << "ERROR: Could not load tileset " << (i + 1) << ": " << paths[i] << std::endl;
+            decoded = false;
+        }
     }
+    if (!decoded)
+        return false;
 
-    // Load combined texture
-    if (!m_TilesetTexture.LoadFromData(flippedData, combinedWidth, combinedHeight, channels, false))
+    // Flip vertically for OpenGL (origin at bottom-left); the texture keeps its own copy
+    if (!m_TilesetTexture.LoadFromData(combinedData.data(), combinedWidth, combinedHeight, channels, true))
     {
         std::cerr << "ERROR: Failed to create combined texture!" << std::endl;
-        delete[] combinedData;
-        delete[] flippedData;
-        for (auto &ts : tilesets)
-        {
-            stbi_image_free(ts.data);
-        }
         return false;
     }
 
-    // Store combined data for transparency checking (don't flip for data checking)
-    m_TilesetData = combinedData;
-    m_TilesetDataFromStbi = false;  // Allocated with new[], must use delete[]
     m_TilesetDataWidth = combinedWidth;
     m_TilesetDataHeight = combinedHeight;
-    m_TilesetChannels = channels;
 
     m_TilesetWidth = combinedWidth;
     m_TilesetHeight = combinedHeight;
@@ -318,23 +343,124 @@ bool Tilemap::LoadCombinedTilesets(const std::vector<std::string> &paths, int ti
     std::cout << "Tiles per row: " << m_TilesPerRow << std::endl;
     std::cout << "Total tiles: " << (m_TilesetDataWidth / m_TileWidth) * (m_TilesetDataHeight / m_TileHeight) << std::endl;
 
-    // Clean up temporary data
-    delete[] flippedData;
-    for (auto &ts : tilesets)
+    m_TilesetSources.clear();
+    for (size_t i = 0; i < tilesets.size(); ++i)
+    {
+        m_TilesetSources.push_back({paths[i], TilesetKey(paths[i]), tilesets[i].offsetY,
+                                    tilesets[i].width, tilesets[i].height});
+    }
+
+    // Only the per-tile transparency bits outlive this call, the pixels are released here
+    BuildTransparencyCache(combinedData.data(), channels);
+    ++m_TilesetRevision;
+
+    return true;
+}
+
+int Tilemap::FindTileset(const std::string &path) const
+{
+    const std::string key = TilesetKey(path);
+    for (size_t i = 0; i < m_TilesetSources.size(); ++i)
+    {
+        if (m_TilesetSources[i].key == key)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+bool Tilemap::PatchTileset(int index, const unsigned char *pixels, int width, int height, int channels,
+                           IRenderer *renderer)
+{
+    if (index < 0 || static_cast<size_t>(index) >= m_TilesetSources.size() || !pixels)
+        return false;
+
+    const TilesetSource &source = m_TilesetSources[static_cast<size_t>(index)];
+    Texture &texture = m_TilesetTexture;
+    const size_t combinedStride = static_cast<size_t>(texture.GetWidth()) * static_cast<size_t>(channels);
+    if (width != source.width || height != source.height || channels != texture.GetChannels() ||
+        texture.m_ImageData.size() != combinedStride * static_cast<size_t>(texture.GetHeight()))
+    {
+        return false;
+    }
+
+    // The CPU copy is stored flipped: top-down row y lives at stored row (height - 1 - y)
+    const int combinedHeight = texture.GetHeight();
+    const size_t srcStride = static_cast<size_t>(width) * static_cast<size_t>(channels);
+    for (int y = 0; y < height; ++y)
+    {
+        const size_t storedRow = static_cast<size_t>(combinedHeight - 1 - (source.offsetY + y));
+        std::memcpy(texture.m_ImageData.data() + storedRow * combinedStride,
+                    pixels + static_cast<size_t>(y) * srcStride, srcStride);
+    }
+
+    const int storedTop = combinedHeight - source.offsetY - height;
+    if (!renderer || !renderer->UpdateTextureRegion(texture, 0, storedTop, width, height))
     {
-        stbi_image_free(ts.data);
+        if (renderer)
+        {
+            // ReleaseTexture() may take the GPU handles and the CPU copy along
+            std::vector<unsigned char> copy = texture.m_ImageData;
+            ReleaseChunkMeshes();
+            renderer->ReleaseTexture(texture);
+            texture.AdoptPixels(std::move(copy), m_TilesetDataWidth, m_TilesetDataHeight, channels);
+            renderer->UploadTexture(texture);
+        }
+    }
+
+    // Re-check only the tile rows this image overlaps; stored rows of a tile
+    // are contiguous, just in reverse order, which the scan does not care about
+    bool transparencyChanged = false;
+    if (m_TransparencyCacheBuilt)
+    {
+        const int tilesPerRow = m_TilesetDataWidth / m_TileWidth;
+        const int tilesPerCol = m_TilesetDataHeight / m_TileHeight;
+        const int firstRow = source.offsetY / m_TileHeight;
+        const int lastRow = std::min(tilesPerCol, (source.offsetY + height + m_TileHeight - 1) / m_TileHeight);
+        const int lastCol = std::min(tilesPerRow, (width + m_TileWidth - 1) / m_TileWidth);
+        for (int tileRow = firstRow; tileRow < lastRow; ++tileRow)
+        {
+            const size_t storedRow = static_cast<size_t>(combinedHeight - (tileRow + 1) * m_TileHeight);
+            for (int tileCol = 0; tileCol < lastCol; ++tileCol)
+            {
+                const unsigned char *tile = texture.m_ImageData.data() + storedRow * combinedStride +
+                                            static_cast<size_t>(tileCol * m_TileWidth * channels);
+                const size_t tileID = static_cast<size_t>(tileRow * tilesPerRow + tileCol);
+                const uint8_t transparent =
+                    IsTilePixelsTransparent(tile, combinedStride, channels, m_TileWidth, m_TileHeight) ? 1 : 0;
+                const uint8_t opaque =
+                    IsTilePixelsOpaque(tile, combinedStride, channels, m_TileWidth, m_TileHeight) ? 1 : 0;
+                transparencyChanged |= m_TileTransparencyCache[tileID] != transparent ||
+                                       m_TileOpaqueCache[tileID] != opaque;
+                m_TileTransparencyCache[tileID] = transparent;
+                m_TileOpaqueCache[tileID] = opaque;
+            }
+        }
     }
 
-    // Build transparency cache for all tiles
-    BuildTransparencyCache();
+    // Chunk meshes skip transparent and covered tiles, so only a changed bit invalidates them
+    if (transparencyChanged)
+    {
+        m_OccludersDirty = true;
+        for (TileChunk &chunk : m_Chunks)
+        {
+            chunk.dirty[0] = true;
+            chunk.dirty[1] = true;
+        }
+    }
+    ++m_TilesetRevision;
 
+    std::cout << "Patched tileset " << (index + 1) << " (" << width << "x" << height << ")"
+              << (transparencyChanged ? ", tile transparency changed" : "") << ": " << source.path << std::endl;
     return true;
 }
 
 void Tilemap::SetTilemapSize(int width, int height, bool generateMap)
 {
+    ReleaseChunkMeshes();
     m_MapWidth = width;
     m_MapHeight = height;
+    m_YSortIndexDirty = true;
+    MarkStructuresDirty();
 
     const size_t mapSize = static_cast<size_t>(m_MapWidth) * static_cast<size_t>(m_MapHeight);
 
@@ -361,16 +487,20 @@ void Tilemap::SetTilemapSize(int width, int height, bool generateMap)
     // Resize all layer data arrays
     for (auto &layer : m_Layers)
     {
-        layer.resize(mapSize);
+        layer.resize(m_MapWidth, m_MapHeight);
     }
 
     m_CollisionMap.Resize(m_MapWidth, m_MapHeight);
     m_NavigationMap.Resize(m_MapWidth, m_MapHeight);
+    ResetNavigationHistory();
     m_CornerCutBlocked.assign(mapSize, 0); // All corners allow cutting by default
+    ResetBlockRevisions();
 
-    // Initialize animation map
-    m_TileAnimationMap.assign(mapSize, -1);
+    // Animation frames and cell lists are rebuilt on the next UpdateAnimations()
     m_AnimationTime = 0.0f;
+    m_AnimationFrames.clear();
+    m_AnimatedCellsDirty = true;
+    m_OccludersDirty = true;
 
     if (generateMap && m_TilesetWidth > 0 && m_TilesetHeight > 0)
         GenerateDefaultMap();
@@ -378,7 +508,11 @@ void Tilemap::SetTilemapSize(int width, int height, bool generateMap)
 
 void Tilemap::SetTileCollision(int x, int y, bool hasCollision)
 {
+    if (x < 0 || y < 0 || x >= m_MapWidth || y >= m_MapHeight || m_CollisionMap.HasCollision(x, y) == hasCollision)
+        return;
     m_CollisionMap.SetCollision(x, y, hasCollision);
+    RecordNavigationChange(x, y);
+    StampBlock(x, y);
 }
 
 bool Tilemap::GetTileCollision(int x, int y) const
@@ -399,6 +533,7 @@ void Tilemap::SetCornerCutBlocked(int x, int y, Corner corner, bool blocked)
         m_CornerCutBlocked[idx] |= bit;
     else
         m_CornerCutBlocked[idx] &= ~bit;
+    StampBlock(x, y);
 }
 
 bool Tilemap::IsCornerCutBlocked(int x, int y, Corner corner) const
@@ -415,7 +550,29 @@ bool Tilemap::IsCornerCutBlocked(int x, int y, Corner corner) const
 
 void Tilemap::SetNavigation(int x, int y, bool walkable)
 {
+    if (x < 0 || y < 0 || x >= m_MapWidth || y >= m_MapHeight || m_NavigationMap.GetNavigation(x, y) == walkable)
+        return;
     m_NavigationMap.SetNavigation(x, y, walkable);
+    RecordNavigationChange(x, y);
+    StampBlock(x, y);
+}
+
+void Tilemap::RecordNavigationChange(int x, int y)
+{
+    // Past the limit a full rebuild is cheaper than replaying every edit
+    if (m_NavigationHistory.size() >= NAVIGATION_HISTORY_LIMIT)
+    {
+        ResetNavigationHistory();
+        return;
+    }
+    m_NavigationHistory.emplace_back(x, y);
+    ++m_NavigationVersion;
+}
+
+void Tilemap::ResetNavigationHistory()
+{
+    m_NavigationHistory.clear();
+    m_NavigationHistoryBase = ++m_NavigationVersion;
 }
 
 bool Tilemap::GetNavigation(int x, int y) const
@@ -425,58 +582,103 @@ bool Tilemap::GetNavigation(int x, int y) const
 
 bool Tilemap::IsTileTransparent(int tileID) const
 {
-    // Use cached result if available (massive performance improvement)
-    if (m_TransparencyCacheBuilt && tileID >= 0 &&
-        tileID < static_cast<int>(m_TileTransparencyCache.size()))
+    // Tiles outside the tileset, or any tile before a tileset is loaded, draw nothing
+    if (!m_TransparencyCacheBuilt || tileID < 0 || tileID >= static_cast<int>(m_TileTransparencyCache.size()))
+        return true;
+    return m_TileTransparencyCache[tileID] != 0;
+}
+
+bool Tilemap::IsTileOpaque(int tileID) const
+{
+    if (!m_TransparencyCacheBuilt || tileID < 0 || tileID >= static_cast<int>(m_TileOpaqueCache.size()))
+        return false;
+    return m_TileOpaqueCache[tileID] != 0;
+}
+
+void Tilemap::SetTileLight(int tileID, glm::vec3 color, float radius)
+{
+    if (tileID < 0)
+        return;
+
+    auto it = std::find_if(m_TileLights.begin(), m_TileLights.end(),
+                           [tileID](const TileLight &light) { return light.tileId == tileID; });
+    if (radius <= 0.0f)
     {
-        return m_TileTransparencyCache[tileID];
+        if (it != m_TileLights.end())
+            m_TileLights.erase(it);
     }
-
-    // Fallback to pixel scanning if cache not available
-    if (!m_TilesetData || tileID < 0 || m_TilesetChannels == 0)
+    else if (it != m_TileLights.end())
     {
-        return true; // Treat as transparent if we can't check
+        it->color = color;
+        it->radius = radius;
     }
+    else
+    {
+        m_TileLights.push_back({tileID, color, radius});
+    }
+    RebuildTileLightIndex();
+}
 
-    int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    int tilesetX = (tileID % dataTilesPerRow) * m_TileWidth;
-    int tilesetY = (tileID / dataTilesPerRow) * m_TileHeight;
+const TileLight *Tilemap::GetTileLight(int tileID) const
+{
+    if (tileID < 0 || tileID >= static_cast<int>(m_TileLightIndex.size()) || m_TileLightIndex[tileID] < 0)
+        return nullptr;
+    return &m_TileLights[m_TileLightIndex[tileID]];
+}
 
-    if (tilesetX + m_TileWidth > m_TilesetDataWidth ||
-        tilesetY + m_TileHeight > m_TilesetDataHeight)
+void Tilemap::RebuildTileLightIndex()
+{
+    m_TileLightIndex.clear();
+    m_MaxTileLightRadius = 0.0f;
+    for (size_t i = 0; i < m_TileLights.size(); ++i)
     {
-        return true;
+        const TileLight &light = m_TileLights[i];
+        if (light.tileId >= static_cast<int>(m_TileLightIndex.size()))
+            m_TileLightIndex.resize(light.tileId + 1, -1);
+        m_TileLightIndex[light.tileId] = static_cast<int>(i);
+        m_MaxTileLightRadius = std::max(m_MaxTileLightRadius, light.radius);
     }
+}
 
-    for (int y = 0; y < m_TileHeight; ++y)
+void Tilemap::CollectTileLights(glm::vec2 cameraPos, glm::vec2 viewSize, std::vector<IRenderer::Light> &lights) const
+{
+    if (m_TileLights.empty() || m_TileWidth <= 0 || m_TileHeight <= 0)
+        return;
+    WILD_PROFILE_ZONE("Tile Lights");
+
+    // Cells just off screen still light its edge
+    const int x0 = std::max(0, static_cast<int>(std::floor((cameraPos.x - m_MaxTileLightRadius) / m_TileWidth)));
+    const int y0 = std::max(0, static_cast<int>(std::floor((cameraPos.y - m_MaxTileLightRadius) / m_TileHeight)));
+    const int x1 = std::min(m_MapWidth - 1, static_cast<int>(std::floor(
+                                                (cameraPos.x + viewSize.x + m_MaxTileLightRadius) / m_TileWidth)));
+    const int y1 = std::min(m_MapHeight - 1, static_cast<int>(std::floor(
+                                                 (cameraPos.y + viewSize.y + m_MaxTileLightRadius) / m_TileHeight)));
+
+    const glm::vec2 halfTile(m_TileWidth * 0.5f, m_TileHeight * 0.5f);
+    for (const TileLayer &layer : m_Layers)
     {
-        for (int x = 0; x < m_TileWidth; ++x)
+        for (int y = y0; y <= y1; ++y)
         {
-            int px = tilesetX + x;
-            int py = tilesetY + y;
-            if (px >= m_TilesetDataWidth || py >= m_TilesetDataHeight)
-                continue;
-
-            int index = (py * m_TilesetDataWidth + px) * m_TilesetChannels;
-            if (index >= 0 && index < m_TilesetDataWidth * m_TilesetDataHeight * m_TilesetChannels)
+            for (int x = x0; x <= x1; ++x)
             {
-                if (m_TilesetChannels == 4)
-                {
-                    if (m_TilesetData[index + 3] > 0)
-                        return false;
-                }
-                else if (m_TilesetChannels == 3)
-                {
-                    unsigned char r = m_TilesetData[index];
-                    unsigned char g = m_TilesetData[index + 1];
-                    unsigned char b = m_TilesetData[index + 2];
-                    if (!(r == 0 && g == 0 && b == 0) && !(r == 255 && g == 255 && b == 255))
-                        return false;
-                }
+                const PackedTile cell = layer.GetCell(x, y);
+                int tileID = cell.GetTileId();
+                const int animId = cell.GetAnimation();
+                if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+                    tileID = GetAnimationFrame(animId);
+
+                const TileLight *tileLight = GetTileLight(tileID);
+                if (!tileLight)
+                    continue;
+                IRenderer::Light light;
+                light.position = glm::vec2(static_cast<float>(x * m_TileWidth), static_cast<float>(y * m_TileHeight)) +
+                                 halfTile - cameraPos;
+                light.radius = tileLight->radius;
+                light.color = tileLight->color;
+                lights.push_back(light);
             }
         }
     }
-    return true;
 }
 
 int Tilemap::GetElevation(int x, int y) const
@@ -501,6 +703,7 @@ void Tilemap::SetElevation(int x, int y, int elevation)
         return;
 
     m_Elevation[index] = elevation;
+    StampBlock(x, y);
 }
 
 float Tilemap::GetElevationAtWorldPos(float worldX, float worldY) const
@@ -526,8 +729,7 @@ bool Tilemap::GetNoProjection(int x, int y, int layer) const
     if (layerIdx >= m_Layers.size())
         return false;
 
-    size_t index = static_cast<size_t>(y * m_MapWidth + x);
-    return m_Layers[layerIdx].noProjection[index];
+    return m_Layers[layerIdx].GetNoProjection(x, y);
 }
 
 bool Tilemap::FindNoProjectionStructureBounds(int tileX, int tileY,
@@ -537,69 +739,68 @@ bool Tilemap::FindNoProjectionStructureBounds(int tileX, int tileY,
     if (tileX < 0 || tileX >= m_MapWidth || tileY < 0 || tileY >= m_MapHeight)
         return false;
 
-    // Check if this tile has noProjection in ANY layer
-    size_t idx = static_cast<size_t>(tileY * m_MapWidth + tileX);
-    bool hasNoProj = false;
-    for (size_t li = 0; li < m_Layers.size(); ++li)
+    auto isNoProjAnyLayer = [this](int x, int y)
     {
-        if (idx < m_Layers[li].noProjection.size() && m_Layers[li].noProjection[idx])
+        for (const TileLayer &layer : m_Layers)
         {
-            hasNoProj = true;
-            break;
+            if (layer.GetNoProjection(x, y))
+                return true;
         }
-    }
-    if (!hasNoProj)
         return false;
+    };
 
-    // Flood-fill to find all connected noProjection tiles (same as RenderLayerNoProjection)
-    std::vector<bool> processed(static_cast<size_t>(m_MapWidth * m_MapHeight), false);
-    std::vector<std::pair<int, int>> stack;
-    stack.push_back({tileX, tileY});
-
-    outMinX = tileX;
-    outMaxX = tileX;
-    outMinY = tileY;
-    outMaxY = tileY;
+    if (m_NoProjComponentsDirty)
+    {
+        m_NoProjComponentIds.Resize(m_MapWidth, m_MapHeight);
+        m_NoProjComponentBounds.clear();
+        m_NoProjComponentsDirty = false;
+    }
 
-    while (!stack.empty())
+    // Components are labelled on first query and reused until noProjection changes
+    int component = m_NoProjComponentIds.Get(tileX, tileY);
+    if (component < 0)
     {
-        auto [cx, cy] = stack.back();
-        stack.pop_back();
+        if (!isNoProjAnyLayer(tileX, tileY))
+            return false;
 
-        if (cx < 0 || cx >= m_MapWidth || cy < 0 || cy >= m_MapHeight)
-            continue;
+        component = static_cast<int>(m_NoProjComponentBounds.size());
+        std::array<int, 4> bounds = {tileX, tileX, tileY, tileY};
 
-        size_t cIdx = static_cast<size_t>(cy * m_MapWidth + cx);
-        if (processed[cIdx])
-            continue;
+        // Flood-fill to find all connected noProjection tiles (4-way connectivity)
+        std::vector<std::pair<int, int>> stack;
+        stack.push_back({tileX, tileY});
+        m_NoProjComponentIds.Set(tileX, tileY, component);
 
-        // Check if this tile is no-projection in ANY layer
-        bool isNoProj = false;
-        for (size_t li = 0; li < m_Layers.size(); ++li)
+        while (!stack.empty())
         {
-            if (cIdx < m_Layers[li].noProjection.size() && m_Layers[li].noProjection[cIdx])
+            auto [cx, cy] = stack.back();
+            stack.pop_back();
+
+            bounds[0] = std::min(bounds[0], cx);
+            bounds[1] = std::max(bounds[1], cx);
+            bounds[2] = std::min(bounds[2], cy);
+            bounds[3] = std::max(bounds[3], cy);
+
+            const std::pair<int, int> neighbors[] = {{cx - 1, cy}, {cx + 1, cy}, {cx, cy - 1}, {cx, cy + 1}};
+            for (const auto &[nx, ny] : neighbors)
             {
-                isNoProj = true;
-                break;
+                if (nx < 0 || nx >= m_MapWidth || ny < 0 || ny >= m_MapHeight)
+                    continue;
+                if (m_NoProjComponentIds.Get(nx, ny) >= 0 || !isNoProjAnyLayer(nx, ny))
+                    continue;
+                m_NoProjComponentIds.Set(nx, ny, component);
+                stack.push_back({nx, ny});
             }
         }
-        if (!isNoProj)
-            continue;
 
-        processed[cIdx] = true;
-
-        outMinX = std::min(outMinX, cx);
-        outMaxX = std::max(outMaxX, cx);
-        outMinY = std::min(outMinY, cy);
-        outMaxY = std::max(outMaxY, cy);
-
-        // 4-way connectivity
-        stack.push_back({cx - 1, cy});
-        stack.push_back({cx + 1, cy});
-        stack.push_back({cx, cy - 1});
-        stack.push_back({cx, cy + 1});
+        m_NoProjComponentBounds.push_back(bounds);
     }
 
+    const std::array<int, 4> &bounds = m_NoProjComponentBounds[component];
+    outMinX = bounds[0];
+    outMaxX = bounds[1];
+    outMinY = bounds[2];
+    outMaxY = bounds[3];
     return true;
 }
 
@@ -607,6 +808,7 @@ int Tilemap::AddNoProjectionStructure(glm::vec2 leftAnchor, glm::vec2 rightAncho
 {
     int id = static_cast<int>(m_NoProjectionStructures.size());
     m_NoProjectionStructures.emplace_back(id, leftAnchor, rightAnchor, name);
+    m_StructureIndexDirty = true;  // Cells may reference the new ID already
     return id;
 }
 
@@ -625,13 +827,12 @@ void Tilemap::RemoveNoProjectionStructure(int id)
     // Clear structureId from all tiles that referenced this structure
     for (auto& layer : m_Layers)
     {
-        for (size_t i = 0; i < layer.structureId.size(); ++i)
+        layer.structureIds.TransformNonEmpty([id](int32_t structId) -> int32_t
         {
-            if (layer.structureId[i] == id)
-                layer.structureId[i] = -1;
-            else if (layer.structureId[i] > id)
-                layer.structureId[i]--;  // Shift down IDs above removed one
-        }
+            if (structId == id)
+                return -1;
+            return structId > id ? structId - 1 : structId;  // Shift down IDs above removed one
+        });
     }
 
     // Remove the structure
@@ -642,6 +843,20 @@ void Tilemap::RemoveNoProjectionStructure(int id)
     {
         m_NoProjectionStructures[i].id = static_cast<int>(i);
     }
+    m_StructureIndexDirty = true;
+}
+
+int Tilemap::InsertNoProjectionStructure(const NoProjectionStructure& structure)
+{
+    const int count = static_cast<int>(m_NoProjectionStructures.size());
+    const int id = std::clamp(structure.id, 0, count);
+    m_NoProjectionStructures.insert(m_NoProjectionStructures.begin() + id, structure);
+    for (size_t i = static_cast<size_t>(id); i < m_NoProjectionStructures.size(); ++i)
+    {
+        m_NoProjectionStructures[i].id = static_cast<int>(i);
+    }
+    m_StructureIndexDirty = true;
+    return id;
 }
 
 int Tilemap::GetTileStructureId(int x, int y, int layer) const
@@ -653,11 +868,7 @@ int Tilemap::GetTileStructureId(int x, int y, int layer) const
     if (layerIdx >= m_Layers.size())
         return -1;
 
-    size_t index = static_cast<size_t>(y * m_MapWidth + x);
-    if (index >= m_Layers[layerIdx].structureId.size())
-        return -1;
-
-    return m_Layers[layerIdx].structureId[index];
+    return m_Layers[layerIdx].GetStructureId(x, y);
 }
 
 void Tilemap::SetTileStructureId(int x, int y, int layer, int structId)
@@ -669,140 +880,271 @@ void Tilemap::SetTileStructureId(int x, int y, int layer, int structId)
     if (layerIdx >= m_Layers.size())
         return;
 
-    size_t index = static_cast<size_t>(y * m_MapWidth + x);
-    if (index >= m_Layers[layerIdx].structureId.size())
-        return;
+    m_Layers[layerIdx].SetStructureId(x, y, structId);
+    UpdateStructureCell(x, y);
+    StampBlock(x, y);
+}
 
-    m_Layers[layerIdx].structureId[index] = structId;
+/// Row-major order of (x, y) cells, matching the old per-frame scan
+static bool RowMajorLess(const std::pair<int, int> &a, const std::pair<int, int> &b)
+{
+    return std::tie(a.second, a.first) < std::tie(b.second, b.first);
 }
 
-const std::vector<Tilemap::YSortPlusTile>& Tilemap::GetVisibleYSortPlusTiles(glm::vec2 cullCam, glm::vec2 cullSize) const
+void Tilemap::StructureMembers::RecomputeBounds()
 {
-    m_YSortPlusTilesCache.clear();
+    minX = minY = INT_MAX;
+    maxX = maxY = INT_MIN;
+    for (const auto &[x, y] : tiles)
+    {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+}
 
-    int x0, y0, x1, y1;
-    ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
+void Tilemap::RebuildStructureIndex() const
+{
+    m_StructureIndex.assign(m_NoProjectionStructures.size(), {});
+    const int structureCount = static_cast<int>(m_StructureIndex.size());
 
-    // Helper to check if a tile at (x,y,layer) is Y-sorted and non-empty using dynamic layers
-    auto isYSortPlusTile = [this](int x, int y, size_t layerIdx) -> bool
+    for (const TileLayer &layer : m_Layers)
     {
-        if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
-            return false;
-        if (layerIdx >= m_Layers.size())
-            return false;
-        size_t index = static_cast<size_t>(y * m_MapWidth + x);
-        const TileLayer &layer = m_Layers[layerIdx];
-        if (index >= layer.ySortPlus.size())
-            return false;
-        if (!layer.ySortPlus[index])
-            return false;
-        // Check for animation before checking base tile
-        int tileID = layer.tiles[index];
-        if (index < layer.animationMap.size())
+        const int group = layer.isBackground ? 0 : 1;
+        layer.structureIds.ForEachNonEmpty([&](int x, int y, int32_t structId)
         {
-            int animId = layer.animationMap[index];
-            if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-            {
-                tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-            }
-        }
-        if (tileID < 0)
-            return false;
-        return true;
-    };
+            const PackedTile cell = layer.GetCell(x, y);
+            if (structId < 0 || structId >= structureCount || !cell.IsNoProjection() || cell.IsYSortPlus())
+                return;
+            m_StructureIndex[structId][group].tiles.push_back({x, y});
+        });
+    }
 
-    // Check all dynamic layers for Y-sorted tiles
-    for (size_t layerIdx = 0; layerIdx < m_Layers.size(); ++layerIdx)
+    // Several layers of a group may hold the same cell
+    for (auto &groups : m_StructureIndex)
     {
-        const TileLayer &layer = m_Layers[layerIdx];
-
-        for (int y = y0; y <= y1; ++y)
+        for (StructureMembers &members : groups)
         {
-            for (int x = x0; x <= x1; ++x)
-            {
-                size_t index = static_cast<size_t>(y * m_MapWidth + x);
-                if (index >= layer.ySortPlus.size())
-                    continue;
-
-                if (!layer.ySortPlus[index])
-                    continue;
-
-                // Check for animation before checking base tile
-                int tileID = layer.tiles[index];
-                if (index < layer.animationMap.size())
-                {
-                    int animId = layer.animationMap[index];
-                    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                    {
-                        tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                    }
-                }
-                if (tileID < 0)
-                    continue;
-
-                // Find the bottom-most Y-sorted tile in this column (same x, same layer)
-                // This groups vertically stacked tiles to sort together
-                int bottomY = y;
-                while (isYSortPlusTile(x, bottomY + 1, layerIdx))
-                {
-                    bottomY++;
-                }
-
-                YSortPlusTile tile;
-                tile.x = x;
-                tile.y = y;
-                tile.layer = static_cast<int>(layerIdx); // Store dynamic layer index
-                // Use bottom tile's anchorY so entire vertical stack sorts together
-                tile.anchorY = static_cast<float>((bottomY + 1) * m_TileHeight);
-                // Check if this tile has no-projection flag
-                tile.noProjection = layer.noProjection[index];
-                // Use bottom tile's ySortMinus flag so entire vertical stack sorts consistently
-                size_t bottomIndex = static_cast<size_t>(bottomY * m_MapWidth + x);
-                tile.ySortMinus = layer.ySortMinus[bottomIndex];
-                m_YSortPlusTilesCache.push_back(tile);
-            }
+            std::sort(members.tiles.begin(), members.tiles.end(), RowMajorLess);
+            members.tiles.erase(std::unique(members.tiles.begin(), members.tiles.end()), members.tiles.end());
+            members.RecomputeBounds();
         }
     }
-
-    return m_YSortPlusTilesCache;
+    m_StructureIndexDirty = false;
 }
 
-void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm::vec2 cameraPos, int useNoProjection)
+void Tilemap::UpdateStructureCell(int x, int y)
 {
-    if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
-        return;
-
-    size_t layerIdx = static_cast<size_t>(layer);
-    if (layerIdx >= m_Layers.size())
-        return;
-
-    size_t index = static_cast<size_t>(y * m_MapWidth + x);
-    const TileLayer &tileLayer = m_Layers[layerIdx];
-
-    if (index >= tileLayer.tiles.size())
+    if (m_StructureIndexDirty || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight || DeferToBulkRebuild())
         return;
 
-    int tileID = tileLayer.tiles[index];
-    float rotation = tileLayer.rotation[index];
-
-    // Check for animated tile before skip check
-    if (index < tileLayer.animationMap.size())
+    const std::pair<int, int> key{x, y};
+    for (auto &groups : m_StructureIndex)
     {
-        int animId = tileLayer.animationMap[index];
-        if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+        for (StructureMembers &members : groups)
         {
-            tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
+            if (x < members.minX || x > members.maxX || y < members.minY || y > members.maxY)
+                continue;
+            auto it = std::lower_bound(members.tiles.begin(), members.tiles.end(), key, RowMajorLess);
+            if (it == members.tiles.end() || *it != key)
+                continue;
+            members.tiles.erase(it);
+            if (x == members.minX || x == members.maxX || y == members.minY || y == members.maxY)
+                members.RecomputeBounds();
         }
     }
 
-    if (tileID < 0)
-        return;
+    for (const TileLayer &layer : m_Layers)
+    {
+        const int structId = layer.GetStructureId(x, y);
+        const PackedTile cell = layer.GetCell(x, y);
+        if (structId < 0 || structId >= static_cast<int>(m_StructureIndex.size()) ||
+            !cell.IsNoProjection() || cell.IsYSortPlus())
+        {
+            continue;
+        }
+
+        StructureMembers &members = m_StructureIndex[structId][layer.isBackground ? 0 : 1];
+        auto it = std::lower_bound(members.tiles.begin(), members.tiles.end(), key, RowMajorLess);
+        if (it != members.tiles.end() && *it == key)
+            continue;
+        members.tiles.insert(it, key);
+        members.minX = std::min(members.minX, x);
+        members.maxX = std::max(members.maxX, x);
+        members.minY = std::min(members.minY, y);
+        members.maxY = std::max(members.maxY, y);
+    }
+}
+
+void Tilemap::MarkStructuresDirty()
+{
+    m_StructureIndexDirty = true;
+    m_NoProjComponentsDirty = true;
+}
+
+void Tilemap::MarkDerivedDataDirty()
+{
+    m_YSortIndexDirty = true;
+    m_AnimatedCellsDirty = true;
+    m_OccludersDirty = true;
+    MarkStructuresDirty();
+}
+
+bool Tilemap::IsYSortIndexCell(int x, int y, size_t layerIdx) const
+{
+    const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
+    if (!cell.IsYSortPlus())
+        return false;
+    // Animated cells are indexed by definition; their current frame is checked per query
+    const int animId = cell.GetAnimation();
+    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+        return true;
+    return cell.GetTileId() >= 0;
+}
+
+void Tilemap::RebuildYSortIndex() const
+{
+    m_YSortRows.assign(static_cast<size_t>(std::max(0, m_MapHeight)), {});
+    m_YSortMaxRun = 1;
+
+    for (size_t layerIdx = 0; layerIdx < m_Layers.size(); ++layerIdx)
+    {
+        m_Layers[layerIdx].cells.ForEachNonEmpty([&](int x, int y, PackedTile)
+        {
+            if (!IsYSortIndexCell(x, y, layerIdx))
+                return;
+            int bottomY = y;
+            while (IsYSortIndexCell(x, bottomY + 1, layerIdx))
+                bottomY++;
+            m_YSortRows[bottomY].push_back({x, y, static_cast<int>(layerIdx)});
+            m_YSortMaxRun = std::max(m_YSortMaxRun, bottomY - y + 1);
+        });
+    }
+
+    for (auto &row : m_YSortRows)
+        std::sort(row.begin(), row.end());
+    m_YSortIndexDirty = false;
+}
+
+void Tilemap::UpdateYSortColumn(int x, int y, size_t layerIdx)
+{
+    if (m_YSortIndexDirty || layerIdx >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight ||
+        DeferToBulkRebuild())
+        return;
+
+    // Every cell whose anchor the edit can change lies in [top, bottom]:
+    // the run ending just above y, the cell itself and the run starting below it
+    int top = y;
+    while (top > 0 && IsYSortIndexCell(x, top - 1, layerIdx))
+        top--;
+    int bottom = y;
+    while (bottom + 1 < m_MapHeight && IsYSortIndexCell(x, bottom + 1, layerIdx))
+        bottom++;
+
+    const int layer = static_cast<int>(layerIdx);
+    for (int row = top; row <= bottom; ++row)
+    {
+        std::erase_if(m_YSortRows[row], [&](const YSortIndexEntry &e)
+                      { return e.x == x && e.layer == layer && e.y >= top && e.y <= bottom; });
+    }
+
+    for (int runStart = top; runStart <= bottom;)
+    {
+        if (!IsYSortIndexCell(x, runStart, layerIdx))
+        {
+            runStart++;
+            continue;
+        }
+        int runEnd = runStart;
+        while (runEnd + 1 <= bottom && IsYSortIndexCell(x, runEnd + 1, layerIdx))
+            runEnd++;
+
+        auto &row = m_YSortRows[runEnd];
+        for (int cy = runStart; cy <= runEnd; ++cy)
+        {
+            const YSortIndexEntry entry{x, cy, layer};
+            row.insert(std::lower_bound(row.begin(), row.end(), entry), entry);
+        }
+        m_YSortMaxRun = std::max(m_YSortMaxRun, runEnd - runStart + 1);
+        runStart = runEnd + 1;
+    }
+}
+
+const std::vector<Tilemap::YSortPlusTile>& Tilemap::GetVisibleYSortPlusTiles(glm::vec2 cullCam, glm::vec2 cullSize) const
+{
+    WILD_PROFILE_ZONE("Tilemap Y-Sort Collect");
+    m_YSortPlusTilesCache.clear();
+    if (m_YSortIndexDirty)
+        RebuildYSortIndex();
+
+    int x0, y0, x1, y1;
+    ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
+
+    // A visible cell's run can end up to m_YSortMaxRun - 1 rows below the view
+    const int lastRow = std::min(static_cast<int>(m_YSortRows.size()) - 1, y1 + m_YSortMaxRun - 1);
+    for (int anchorRow = y0; anchorRow <= lastRow; ++anchorRow)
+    {
+        for (const YSortIndexEntry &entry : m_YSortRows[anchorRow])
+        {
+            if (entry.x < x0 || entry.x > x1 || entry.y < y0 || entry.y > y1)
+                continue;
+
+            const TileLayer &layer = m_Layers[entry.layer];
+            const PackedTile cell = layer.GetCell(entry.x, entry.y);
+            const int animId = cell.GetAnimation();
+            if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()) &&
+                GetAnimationFrame(animId) < 0)
+            {
+                continue;
+            }
+
+            YSortPlusTile tile;
+            tile.x = entry.x;
+            tile.y = entry.y;
+            tile.layer = entry.layer;
+            // The whole vertical run sorts at its bottom edge
+            tile.anchorY = static_cast<float>((anchorRow + 1) * m_TileHeight);
+            tile.noProjection = cell.IsNoProjection();
+            // Use the bottom tile's ySortMinus flag so the run sorts consistently
+            tile.ySortMinus = layer.GetYSortMinus(entry.x, anchorRow);
+            m_YSortPlusTilesCache.push_back(tile);
+        }
+    }
+
+    return m_YSortPlusTilesCache;
+}
+
+void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm::vec2 cameraPos, int useNoProjection)
+{
+    if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
+        return;
+
+    size_t layerIdx = static_cast<size_t>(layer);
+    if (layerIdx >= m_Layers.size())
+        return;
+
+    const TileLayer &tileLayer = m_Layers[layerIdx];
+    const PackedTile cell = tileLayer.GetCell(x, y);
+
+    int tileID = cell.GetTileId();
+    float rotation = cell.GetRotation();
+
+    // Check for animated tile before skip check
+    int animId = cell.GetAnimation();
+    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+    {
+        tileID = GetAnimationFrame(animId);
+    }
+
+    if (tileID < 0)
+        return;
 
     if (IsTileTransparent(tileID))
         return;
 
     // Determine no-projection mode: -1=auto (from layer), 0=force off, 1=force on
-    bool isNoProjection = (useNoProjection == -1) ? tileLayer.noProjection[index] : (useNoProjection == 1);
+    bool isNoProjection = (useNoProjection == -1) ? cell.IsNoProjection() : (useNoProjection == 1);
 
     int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
     int tilesetX = (tileID % dataTilesPerRow) * m_TileWidth;
@@ -826,11 +1168,12 @@ void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm
 
             renderer.DrawSpriteRegion(m_TilesetTexture, screenPos, renderSize,
                                       texCoord, texSize, rotation, glm::vec3(1.0f), flipY);
+            ++m_DrawnTiles;
         }
         else
         {
             // 3D mode: use structure-based rendering if tile has structure ID
-            int structId = (index < tileLayer.structureId.size()) ? tileLayer.structureId[index] : -1;
+            int structId = tileLayer.GetStructureId(x, y);
 
             if (structId >= 0 && structId < static_cast<int>(m_NoProjectionStructures.size()))
             {
@@ -845,21 +1188,18 @@ void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm
                     return;
 
                 // Find structure bounds by scanning for tiles with same structId
+                // (only chunks that hold structure tiles are visited)
                 int minX = x, maxX = x, minY = y, maxY = y;
-                for (int sy = 0; sy < m_MapHeight; ++sy)
+                tileLayer.structureIds.ForEachNonEmpty([&](int sx, int sy, int32_t sid)
                 {
-                    for (int sx = 0; sx < m_MapWidth; ++sx)
+                    if (sid == structId)
                     {
-                        size_t sIdx = static_cast<size_t>(sy * m_MapWidth + sx);
-                        if (sIdx < tileLayer.structureId.size() && tileLayer.structureId[sIdx] == structId)
-                        {
-                            minX = std::min(minX, sx);
-                            maxX = std::max(maxX, sx);
-                            minY = std::min(minY, sy);
-                            maxY = std::max(maxY, sy);
-                        }
+                        minX = std::min(minX, sx);
+                        maxX = std::max(maxX, sx);
+                        minY = std::min(minY, sy);
+                        maxY = std::max(maxY, sy);
                     }
-                }
+                });
 
                 // Structure dimensions in tiles
                 int structureWidthTiles = maxX - minX + 1;
@@ -923,6 +1263,7 @@ void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm
 
                 // Render the tile as a warped quad (no additional perspective applied)
                 renderer.DrawWarpedQuad(m_TilesetTexture, corners, texCoord, texSize, glm::vec3(1.0f), flipY);
+                ++m_DrawnTiles;
             }
             else
             {
@@ -935,6 +1276,7 @@ void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm
                 renderer.SuspendPerspective(true);
                 renderer.DrawSpriteRegion(m_TilesetTexture, screenPos, renderSize,
                                           texCoord, texSize, rotation, glm::vec3(1.0f), flipY);
+                ++m_DrawnTiles;
                 renderer.SuspendPerspective(false);
             }
         }
@@ -949,6 +1291,7 @@ void Tilemap::RenderSingleTile(IRenderer &renderer, int x, int y, int layer, glm
         glm::vec2 renderSize(static_cast<float>(m_TileWidth), static_cast<float>(m_TileHeight));
         renderer.DrawSpriteRegion(m_TilesetTexture, screenPos, renderSize,
                                   texCoord, texSize, rotation, glm::vec3(1.0f), flipY);
+        ++m_DrawnTiles;
     }
 }
 
@@ -974,79 +1317,91 @@ int Tilemap::GetLayerTile(int x, int y, size_t layer) const
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return -1;
-    return m_Layers[layer].tiles[static_cast<size_t>(y * m_MapWidth + x)];
+    return m_Layers[layer].GetTile(x, y);
 }
 
 void Tilemap::SetLayerTile(int x, int y, size_t layer, int tileID)
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return;
-    m_Layers[layer].tiles[static_cast<size_t>(y * m_MapWidth + x)] = tileID;
+    m_Layers[layer].SetTile(x, y, tileID);
+    MarkChunkDirty(x, y);
+    UpdateYSortColumn(x, y, layer);
+    UpdateOccluders(x, y);
 }
 
 float Tilemap::GetLayerRotation(int x, int y, size_t layer) const
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return 0.0f;
-    return m_Layers[layer].rotation[static_cast<size_t>(y * m_MapWidth + x)];
+    return m_Layers[layer].GetRotation(x, y);
 }
 
 void Tilemap::SetLayerRotation(int x, int y, size_t layer, float rotation)
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return;
-    // Normalize rotation to [0, 360) range
-    rotation = std::fmod(rotation, 360.0f);
-    if (rotation < 0.0f)
-        rotation += 360.0f;
-    m_Layers[layer].rotation[static_cast<size_t>(y * m_MapWidth + x)] = rotation;
+    // Stored as a quarter-turn count, which also wraps into [0, 360)
+    m_Layers[layer].SetRotation(x, y, rotation);
+    MarkChunkDirty(x, y);
+    UpdateOccluders(x, y);
 }
 
 bool Tilemap::GetLayerNoProjection(int x, int y, size_t layer) const
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return false;
-    return m_Layers[layer].noProjection[static_cast<size_t>(y * m_MapWidth + x)];
+    return m_Layers[layer].GetNoProjection(x, y);
 }
 
 void Tilemap::SetLayerNoProjection(int x, int y, size_t layer, bool noProjection)
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return;
-    m_Layers[layer].noProjection[static_cast<size_t>(y * m_MapWidth + x)] = noProjection;
+    m_Layers[layer].SetNoProjection(x, y, noProjection);
+    MarkChunkDirty(x, y);
+    UpdateStructureCell(x, y);
+    UpdateOccluders(x, y);
+    m_NoProjComponentsDirty = true;
 }
 
 bool Tilemap::GetLayerYSortPlus(int x, int y, size_t layer) const
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return false;
-    return m_Layers[layer].ySortPlus[static_cast<size_t>(y * m_MapWidth + x)];
+    return m_Layers[layer].GetYSortPlus(x, y);
 }
 
 void Tilemap::SetLayerYSortPlus(int x, int y, size_t layer, bool ySortPlus)
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return;
-    m_Layers[layer].ySortPlus[static_cast<size_t>(y * m_MapWidth + x)] = ySortPlus;
+    m_Layers[layer].SetYSortPlus(x, y, ySortPlus);
+    MarkChunkDirty(x, y);
+    UpdateYSortColumn(x, y, layer);
+    UpdateStructureCell(x, y);
+    UpdateOccluders(x, y);
 }
 
 bool Tilemap::GetLayerYSortMinus(int x, int y, size_t layer) const
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return false;
-    return m_Layers[layer].ySortMinus[static_cast<size_t>(y * m_MapWidth + x)];
+    return m_Layers[layer].GetYSortMinus(x, y);
 }
 
 void Tilemap::SetLayerYSortMinus(int x, int y, size_t layer, bool ySortMinus)
 {
     if (layer >= m_Layers.size() || x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
         return;
-    m_Layers[layer].ySortMinus[static_cast<size_t>(y * m_MapWidth + x)] = ySortMinus;
+    // ySortMinus is read live by GetVisibleYSortPlusTiles(), the index needs no update
+    m_Layers[layer].SetYSortMinus(x, y, ySortMinus);
+    StampBlock(x, y);
 }
 
-std::vector<size_t> Tilemap::GetLayerRenderOrder() const
+FrameVector<size_t> Tilemap::GetLayerRenderOrder() const
 {
-    std::vector<size_t> indices(m_Layers.size());
+    FrameVector<size_t> indices(m_Layers.size(), &FrameArena::ThisThread());
     for (size_t i = 0; i < m_Layers.size(); ++i)
     {
         indices[i] = i;
@@ -1059,50 +1414,183 @@ std::vector<size_t> Tilemap::GetLayerRenderOrder() const
 void Tilemap::RenderBackgroundLayers(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
                                      glm::vec2 cullCam, glm::vec2 cullSize)
 {
-    // Single-pass rendering: iterate visible tiles once, render all background layers per tile
-    auto order = GetLayerRenderOrder();
+    WILD_PROFILE_ZONE("Tilemap Background");
+    RenderLayerGroup(renderer, true, renderCam, cullCam, cullSize);
+}
 
-    // Collect background layer indices in render order
-    std::vector<size_t> bgLayers;
-    bgLayers.reserve(m_Layers.size());
-    for (size_t idx : order)
+void Tilemap::RenderForegroundLayers(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
+                                     glm::vec2 cullCam, glm::vec2 cullSize)
+{
+    WILD_PROFILE_ZONE("Tilemap Foreground");
+    RenderLayerGroup(renderer, false, renderCam, cullCam, cullSize);
+}
+
+int Tilemap::ResolveProjectedTile(PackedTile cell) const
+{
+    int tileID = cell.GetTileId();
+    if (tileID < 0)
+        return -1;
+
+    // Skip if no-projection or Y-sorted (rendered separately)
+    if (cell.IsNoProjection() || cell.IsYSortPlus())
+        return -1;
+
+    // Apply animated tile frame if present
+    int animId = cell.GetAnimation();
+    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
     {
-        if (m_Layers[idx].isBackground)
+        tileID = GetAnimationFrame(animId);
+    }
+    if (tileID < 0)
+        return -1;
+
+    // Skip transparent tiles
+    if (m_TransparencyCacheBuilt && tileID < static_cast<int>(m_TileTransparencyCache.size()) &&
+        m_TileTransparencyCache[tileID])
+        return -1;
+
+    return tileID;
+}
+
+const Tilemap::ProjectedGrid &Tilemap::UpdateProjectedGrid(IRenderer &renderer, glm::vec2 renderCam,
+                                                          int x0, int y0, int x1, int y1)
+{
+    ProjectedGrid &grid = m_ProjectedGrid;
+    const IRenderer::PerspectiveState perspective = renderer.GetPerspectiveState();
+    const int columns = x1 - x0 + 2;
+    const int rows = y1 - y0 + 2;
+    if (grid.x0 == x0 && grid.y0 == y0 && grid.columns == columns && grid.rows == rows &&
+        grid.renderCam == renderCam && grid.perspective.enabled == perspective.enabled &&
+        grid.perspective.mode == perspective.mode && grid.perspective.horizonY == perspective.horizonY &&
+        grid.perspective.horizonScale == perspective.horizonScale &&
+        grid.perspective.viewWidth == perspective.viewWidth &&
+        grid.perspective.viewHeight == perspective.viewHeight &&
+        grid.perspective.sphereRadius == perspective.sphereRadius)
+    {
+        return grid;
+    }
+
+    WILD_PROFILE_ZONE("Tilemap Project Grid");
+    grid.x0 = x0;
+    grid.y0 = y0;
+    grid.columns = columns;
+    grid.rows = rows;
+    grid.renderCam = renderCam;
+    grid.perspective = perspective;
+
+    const size_t count = static_cast<size_t>(columns) * static_cast<size_t>(rows);
+    grid.x.resize(count);
+    grid.y.resize(count);
+    for (int row = 0; row < rows; ++row)
+    {
+        // Same double-precision camera offset as the flat per-tile path
+        const float cornerY = static_cast<float>(static_cast<double>(y0 + row) * m_TileHeight -
+                                                 static_cast<double>(renderCam.y));
+        const size_t rowStart = static_cast<size_t>(row) * columns;
+        for (int column = 0; column < columns; ++column)
         {
-            bgLayers.push_back(idx);
+            grid.x[rowStart + column] = static_cast<float>(static_cast<double>(x0 + column) * m_TileWidth -
+                                                           static_cast<double>(renderCam.x));
+            grid.y[rowStart + column] = cornerY;
         }
     }
-    if (bgLayers.empty())
+    renderer.ProjectPoints(grid.x.data(), grid.y.data(), count);
+    return grid;
+}
+
+bool Tilemap::IsOccludingCell(PackedTile cell) const
+{
+    // Animated cells change frame without an edit, so they never hide anything
+    const int animId = cell.GetAnimation();
+    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+        return false;
+
+    const int tileID = ResolveProjectedTile(cell);
+    if (tileID < 0 || !IsTileOpaque(tileID))
+        return false;
+
+    // A quarter turn of a non-square tile leaves part of the cell uncovered
+    const int turns = static_cast<int>(std::lround(cell.GetRotation() / 90.0f));
+    return m_TileWidth == m_TileHeight || (turns & 1) == 0;
+}
+
+std::span<const size_t> Tilemap::GetVisibleLayers(std::span<const size_t> layers, int group, int x, int y) const
+{
+    const uint8_t occluder = m_Occluders[group].Get(x, y);
+    if (occluder == NO_OCCLUDER)
+        return layers;
+    for (size_t i = 0; i < layers.size(); ++i)
+    {
+        if (layers[i] == occluder)
+            return layers.subspan(i);
+    }
+    return layers;
+}
+
+void Tilemap::RebuildOccluders()
+{
+    WILD_PROFILE_ZONE("Tilemap Occluders");
+    m_OccludersDirty = false;
+    for (auto &occluders : m_Occluders)
+        occluders.Resize(m_MapWidth, m_MapHeight);
+
+    // Chunk meshes leave out covered layers, so they must follow
+    for (TileChunk &chunk : m_Chunks)
+    {
+        chunk.dirty[0] = true;
+        chunk.dirty[1] = true;
+    }
+
+    // Layer indices must fit a byte; with more layers nothing is culled
+    if (m_Layers.size() >= NO_OCCLUDER)
         return;
 
-    // Compute visible tile range once
-    int x0, y0, x1, y1;
-    ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
+    // Walking up the render order lets a higher opaque cell overwrite a lower one
+    for (size_t layerIdx : GetLayerRenderOrder())
+    {
+        auto &occluders = m_Occluders[m_Layers[layerIdx].isBackground ? 0 : 1];
+        m_Layers[layerIdx].cells.ForEachNonEmpty([&](int x, int y, PackedTile cell)
+        {
+            if (IsOccludingCell(cell))
+                occluders.Set(x, y, static_cast<uint8_t>(layerIdx));
+        });
+    }
+}
+
+void Tilemap::UpdateOccluders(int x, int y)
+{
+    // A pending rebuild covers this cell as well
+    if (m_OccludersDirty || m_Layers.size() >= NO_OCCLUDER || DeferToBulkRebuild())
+        return;
 
-    // Pre-compute constants
+    uint8_t occluders[2] = {NO_OCCLUDER, NO_OCCLUDER};
+    for (size_t layerIdx : GetLayerRenderOrder())
+    {
+        if (IsOccludingCell(m_Layers[layerIdx].GetCell(x, y)))
+            occluders[m_Layers[layerIdx].isBackground ? 0 : 1] = static_cast<uint8_t>(layerIdx);
+    }
+    m_Occluders[0].Set(x, y, occluders[0]);
+    m_Occluders[1].Set(x, y, occluders[1]);
+}
+
+void Tilemap::RenderTileRange(IRenderer &renderer, int group, std::span<const size_t> layers, glm::vec2 renderCam,
+                              int x0, int y0, int x1, int y1, const ProjectedGrid *grid)
+{
     const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    const int mapWidth = m_MapWidth;
     const float tileWf = static_cast<float>(m_TileWidth);
     const float tileHf = static_cast<float>(m_TileHeight);
     const glm::vec2 texSize(tileWf, tileHf);
-    const float seamFix = renderer.GetPerspectiveState().enabled ? 0.1f : 0.0f;
-    const glm::vec2 tileRenderSize(tileWf + seamFix, tileHf + seamFix);
     const bool flipY = renderer.RequiresYFlip();
     const glm::vec3 white(1.0f);
-    const bool hasTransparencyCache = m_TransparencyCacheBuilt;
-    const std::vector<bool> &transparencyCache = m_TileTransparencyCache;
-    const int transparencyCacheSize = static_cast<int>(transparencyCache.size());
 
     // Single pass over visible tiles
     for (int y = y0; y <= y1; ++y)
     {
-        const int rowOffset = y * mapWidth;
         const double tilePosYd = static_cast<double>(y) * m_TileHeight - static_cast<double>(renderCam.y);
         const float tilePosY = static_cast<float>(tilePosYd);
 
         for (int x = x0; x <= x1; ++x)
         {
-            const size_t idx = static_cast<size_t>(rowOffset + x);
             const double tilePosXd = static_cast<double>(x) * m_TileWidth - static_cast<double>(renderCam.x);
             const float tilePosX = static_cast<float>(tilePosXd);
 
@@ -1111,161 +1599,424 @@ void Tilemap::RenderBackgroundLayers(IRenderer &renderer, glm::vec2 renderCam, g
             if (renderer.IsPointBehindSphere(tileCenter))
                 continue;
 
-            // Render all background layers at this position (in render order)
-            for (size_t layerIdx : bgLayers)
+            // [TL, TR, BR, BL], read once for every layer of this cell
+            glm::vec2 lattice[4];
+            if (grid)
             {
-                const TileLayer &layer = m_Layers[layerIdx];
-
-                int tileID = layer.tiles[idx];
+                lattice[0] = grid->Corner(x, y);
+                lattice[1] = grid->Corner(x + 1, y);
+                lattice[2] = grid->Corner(x + 1, y + 1);
+                lattice[3] = grid->Corner(x, y + 1);
+            }
 
+            // Render the layers at this position (in render order) not covered by an opaque tile
+            for (size_t layerIdx : GetVisibleLayers(layers, group, x, y))
+            {
+                const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
+                const int tileID = ResolveProjectedTile(cell);
                 if (tileID < 0)
                     continue;
 
-                // Skip if no-projection or Y-sorted (rendered separately)
-                if (layer.noProjection[idx] || layer.ySortPlus[idx])
-                    continue;
+                const glm::vec2 texCoord(static_cast<float>((tileID % dataTilesPerRow) * m_TileWidth),
+                                         static_cast<float>((tileID / dataTilesPerRow) * m_TileHeight));
 
-                // Apply animated tile frame if present
-                if (idx < layer.animationMap.size())
+                if (grid)
                 {
-                    int animId = layer.animationMap[idx];
-                    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                    {
-                        tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                    }
+                    // A quarter turn moves each texture corner one lattice corner clockwise
+                    const int turns = static_cast<int>(std::lround(cell.GetRotation() / 90.0f)) & 3;
+                    const glm::vec2 corners[4] = {lattice[turns], lattice[(turns + 1) & 3],
+                                                  lattice[(turns + 2) & 3], lattice[(turns + 3) & 3]};
+                    renderer.DrawWarpedQuad(m_TilesetTexture, corners, texCoord, texSize, white, flipY);
                 }
-
-                if (tileID < 0)
-                    continue;
-
-                // Skip transparent tiles
-                if (hasTransparencyCache && tileID < transparencyCacheSize && transparencyCache[tileID])
-                    continue;
-
-                const int tilesetX = (tileID % dataTilesPerRow) * m_TileWidth;
-                const int tilesetY = (tileID / dataTilesPerRow) * m_TileHeight;
-
-                renderer.DrawSpriteRegion(m_TilesetTexture,
-                                          glm::vec2(tilePosX, tilePosY),
-                                          tileRenderSize,
-                                          glm::vec2(static_cast<float>(tilesetX), static_cast<float>(tilesetY)),
-                                          texSize,
-                                          layer.rotation[idx],
-                                          white, flipY);
+                else
+                {
+                    renderer.DrawSpriteRegion(m_TilesetTexture, glm::vec2(tilePosX, tilePosY), texSize, texCoord,
+                                              texSize, cell.GetRotation(), white, flipY);
+                }
+                ++m_DrawnTiles;
             }
         }
     }
 }
 
-void Tilemap::RenderForegroundLayers(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
-                                     glm::vec2 cullCam, glm::vec2 cullSize)
+void Tilemap::RenderLayerGroup(IRenderer &renderer, bool background, glm::vec2 renderCam,
+                               glm::vec2 cullCam, glm::vec2 cullSize)
 {
-    // Single-pass rendering: iterate visible tiles once, render all foreground layers per tile
+    // Single-pass rendering: iterate visible tiles once, render all layers of the group per tile
     auto order = GetLayerRenderOrder();
 
-    // Collect foreground layer indices in render order
-    std::vector<size_t> fgLayers;
-    fgLayers.reserve(m_Layers.size());
+    // Collect layer indices of this group in render order
+    FrameVector<size_t> groupLayers(&FrameArena::ThisThread());
+    groupLayers.reserve(m_Layers.size());
     for (size_t idx : order)
     {
-        if (!m_Layers[idx].isBackground)
+        if (m_Layers[idx].isBackground == background)
         {
-            fgLayers.push_back(idx);
+            groupLayers.push_back(idx);
         }
     }
-    if (fgLayers.empty())
+    if (groupLayers.empty())
         return;
 
     // Compute visible tile range once
     int x0, y0, x1, y1;
     ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
+    if (x1 < x0 || y1 < y0)
+        return;
 
-    // Pre-compute constants
-    const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    const int mapWidth = m_MapWidth;
-    const float tileWf = static_cast<float>(m_TileWidth);
-    const float tileHf = static_cast<float>(m_TileHeight);
-    const glm::vec2 texSize(tileWf, tileHf);
-    const float seamFix = renderer.GetPerspectiveState().enabled ? 0.1f : 0.0f;
-    const glm::vec2 tileRenderSize(tileWf + seamFix, tileHf + seamFix);
-    const bool flipY = renderer.RequiresYFlip();
-    const glm::vec3 white(1.0f);
-    const bool hasTransparencyCache = m_TransparencyCacheBuilt;
-    const std::vector<bool> &transparencyCache = m_TileTransparencyCache;
-    const int transparencyCacheSize = static_cast<int>(transparencyCache.size());
+    if (m_OccludersDirty)
+        RebuildOccluders();
+    const int group = background ? 0 : 1;
 
-    // Single pass over visible tiles
-    for (int y = y0; y <= y1; ++y)
+    // Cached meshes hold flat positions, so they only work if nothing is
+    // projected on the CPU (perspective off, or applied by sprite.vert).
+    // Otherwise every layer reads its corners from the shared lattice.
+    if (renderer.GetPerspectiveState().enabled && !renderer.IsGpuProjectionEnabled())
     {
-        const int rowOffset = y * mapWidth;
-        const double tilePosYd = static_cast<double>(y) * m_TileHeight - static_cast<double>(renderCam.y);
-        const float tilePosY = static_cast<float>(tilePosYd);
+        const ProjectedGrid &grid = UpdateProjectedGrid(renderer, renderCam, x0, y0, x1, y1);
+        RenderTileRange(renderer, group, groupLayers, renderCam, x0, y0, x1, y1, &grid);
+        return;
+    }
 
-        for (int x = x0; x <= x1; ++x)
+    if (m_ChunkRenderer != &renderer)
+    {
+        ReleaseChunkMeshes();
+        m_ChunkRenderer = &renderer;
+    }
+    if (m_Chunks.empty())
+    {
+        m_ChunksX = (m_MapWidth + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        m_ChunksY = (m_MapHeight + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        m_Chunks.resize(static_cast<size_t>(m_ChunksX) * static_cast<size_t>(m_ChunksY));
+    }
+
+    const double tileWd = static_cast<double>(m_TileWidth);
+    const double tileHd = static_cast<double>(m_TileHeight);
+
+    for (int cy = y0 / CHUNK_SIZE; cy <= y1 / CHUNK_SIZE; ++cy)
+    {
+        for (int cx = x0 / CHUNK_SIZE; cx <= x1 / CHUNK_SIZE; ++cx)
         {
-            const size_t idx = static_cast<size_t>(rowOffset + x);
-            const double tilePosXd = static_cast<double>(x) * m_TileWidth - static_cast<double>(renderCam.x);
-            const float tilePosX = static_cast<float>(tilePosXd);
+            TileChunk &chunk = m_Chunks[static_cast<size_t>(cy * m_ChunksX + cx)];
+            const int tx0 = cx * CHUNK_SIZE;
+            const int ty0 = cy * CHUNK_SIZE;
+            const int tx1 = std::min(tx0 + CHUNK_SIZE, m_MapWidth) - 1;
+            const int ty1 = std::min(ty0 + CHUNK_SIZE, m_MapHeight) - 1;
+
+            // Same double-precision camera offset as the per-tile path
+            const glm::vec2 origin(static_cast<float>(tx0 * tileWd - static_cast<double>(renderCam.x)),
+                                   static_cast<float>(ty0 * tileHd - static_cast<double>(renderCam.y)));
+            const glm::vec2 extent(static_cast<float>((tx1 - tx0 + 1) * tileWd),
+                                   static_cast<float>((ty1 - ty0 + 1) * tileHd));
+
+            // Chunks crossing the globe limb need the per-tile back-face cull
+            if (renderer.IsPointBehindSphere(origin) ||
+                renderer.IsPointBehindSphere(origin + glm::vec2(extent.x, 0.0f)) ||
+                renderer.IsPointBehindSphere(origin + glm::vec2(0.0f, extent.y)) ||
+                renderer.IsPointBehindSphere(origin + extent))
+            {
+                RenderTileRange(renderer, group, groupLayers, renderCam,
+                                std::max(x0, tx0), std::max(y0, ty0),
+                                std::min(x1, tx1), std::min(y1, ty1));
+                continue;
+            }
 
-            // Skip tiles behind the sphere (when full globe is visible)
-            glm::vec2 tileCenter(tilePosX + tileWf * 0.5f, tilePosY + tileHf * 0.5f);
-            if (renderer.IsPointBehindSphere(tileCenter))
+            if (chunk.dirty[group])
+            {
+                RebuildChunk(renderer, chunk, group, groupLayers, tx0, ty0, tx1, ty1);
+            }
+            if (chunk.animationStale[group])
+            {
+                PatchChunkAnimations(renderer, chunk, group);
+            }
+            if (chunk.unsupported[group])
+            {
+                // Backend could not build a mesh, keep drawing this chunk per tile
+                RenderTileRange(renderer, group, groupLayers, renderCam,
+                                std::max(x0, tx0), std::max(y0, ty0),
+                                std::min(x1, tx1), std::min(y1, ty1));
                 continue;
+            }
+            renderer.DrawStaticMesh(chunk.mesh[group], origin);
+            m_DrawnTiles += chunk.quadCount[group];
 
-            // Render all foreground layers at this position (in render order)
-            for (size_t layerIdx : fgLayers)
+            // Without in-place mesh updates animated cells are drawn on top every frame
+            for (int cellIdx : chunk.animatedCells[group])
             {
-                const TileLayer &layer = m_Layers[layerIdx];
+                const int x = cellIdx % m_MapWidth;
+                const int y = cellIdx / m_MapWidth;
+                if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+                {
+                    RenderTileRange(renderer, group, groupLayers, renderCam, x, y, x, y);
+                }
+            }
+        }
+    }
+}
 
-                int tileID = layer.tiles[idx];
+void Tilemap::RebuildChunk(IRenderer &renderer, TileChunk &chunk, int group, std::span<const size_t> layers,
+                           int tx0, int ty0, int tx1, int ty1)
+{
+    renderer.DestroyStaticMesh(chunk.mesh[group]);
+    chunk.mesh[group] = IRenderer::INVALID_STATIC_MESH;
+    chunk.quadCount[group] = 0;
+    chunk.animatedCells[group].clear();
+    chunk.animatedQuads[group].clear();
+    chunk.animationStale[group] = false;
+    chunk.dirty[group] = false;
+    chunk.unsupported[group] = false;
 
-                if (tileID < 0)
-                    continue;
+    const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
+    const glm::vec2 texSize(static_cast<float>(m_TileWidth), static_cast<float>(m_TileHeight));
+    const bool bakeAnimations = renderer.SupportsStaticMeshUpdates();
 
-                // Skip if no-projection or Y-sorted (rendered separately)
-                if (layer.noProjection[idx] || layer.ySortPlus[idx])
-                    continue;
+    std::vector<IRenderer::StaticQuad> quads;
+    quads.reserve(static_cast<size_t>((tx1 - tx0 + 1) * (ty1 - ty0 + 1)));
+
+    auto makeQuad = [&](int x, int y, int tileID, float rotation)
+    {
+        IRenderer::StaticQuad quad;
+        quad.position = glm::vec2(static_cast<float>((x - tx0) * m_TileWidth),
+                                  static_cast<float>((y - ty0) * m_TileHeight));
+        quad.size = tileID >= 0 ? texSize : glm::vec2(0.0f);
+        tileID = std::max(tileID, 0);
+        quad.texCoord = glm::vec2(static_cast<float>((tileID % dataTilesPerRow) * m_TileWidth),
+                                  static_cast<float>((tileID / dataTilesPerRow) * m_TileHeight));
+        quad.texSize = texSize;
+        quad.rotation = rotation;
+        return quad;
+    };
+
+    for (int y = ty0; y <= ty1; ++y)
+    {
+        for (int x = tx0; x <= tx1; ++x)
+        {
+            const size_t idx = static_cast<size_t>(y * m_MapWidth + x);
 
-                // Check for animated tile
-                if (idx < layer.animationMap.size())
+            // Without in-place updates, keep animated cells out of the mesh; all
+            // their layers are drawn per tile so the layer order inside the cell is preserved
+            if (!bakeAnimations)
+            {
+                bool animated = false;
+                for (size_t layerIdx : GetVisibleLayers(layers, group, x, y))
                 {
-                    int animId = layer.animationMap[idx];
-                    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
+                    const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
+                    if (cell.GetAnimation() >= 0 && cell.GetTileId() >= 0)
                     {
-                        tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
+                        animated = true;
+                        break;
                     }
                 }
-
-                if (tileID < 0)
+                if (animated)
+                {
+                    chunk.animatedCells[group].push_back(static_cast<int>(idx));
                     continue;
+                }
+            }
 
-                // Skip transparent tiles
-                if (hasTransparencyCache && tileID < transparencyCacheSize && transparencyCache[tileID])
-                    continue;
+            for (size_t layerIdx : GetVisibleLayers(layers, group, x, y))
+            {
+                const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
+                const int tileID = ResolveProjectedTile(cell);
 
-                const int tilesetX = (tileID % dataTilesPerRow) * m_TileWidth;
-                const int tilesetY = (tileID / dataTilesPerRow) * m_TileHeight;
+                // Animated quads keep their slot while the frame is hidden so later frames can fill it
+                const int animId = cell.GetAnimation();
+                if (bakeAnimations && animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()) &&
+                    cell.GetTileId() >= 0 && !cell.IsNoProjection() && !cell.IsYSortPlus())
+                {
+                    const IRenderer::StaticQuad quad = makeQuad(x, y, tileID, cell.GetRotation());
+                    chunk.animatedQuads[group].push_back({quad, static_cast<uint32_t>(quads.size()), animId, tileID});
+                    quads.push_back(quad);
+                    continue;
+                }
 
-                renderer.DrawSpriteRegion(m_TilesetTexture,
-                                          glm::vec2(tilePosX, tilePosY),
-                                          tileRenderSize,
-                                          glm::vec2(static_cast<float>(tilesetX), static_cast<float>(tilesetY)),
-                                          texSize,
-                                          layer.rotation[idx],
-                                          white, flipY);
+                if (tileID < 0)
+                    continue;
+                quads.push_back(makeQuad(x, y, tileID, cell.GetRotation()));
             }
         }
     }
+
+    if (!quads.empty())
+    {
+        chunk.mesh[group] = renderer.CreateStaticMesh(m_TilesetTexture, quads.data(), quads.size(),
+                                                      renderer.RequiresYFlip());
+        chunk.unsupported[group] = (chunk.mesh[group] == IRenderer::INVALID_STATIC_MESH);
+        chunk.quadCount[group] = quads.size();
+    }
 }
 
-void Tilemap::RenderBackgroundLayersNoProjection(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
-                                                 glm::vec2 cullCam, glm::vec2 cullSize)
+void Tilemap::PatchChunkAnimations(IRenderer &renderer, TileChunk &chunk, int group)
 {
-    // Single-pass NoProjection rendering for all background layers
-    auto order = GetLayerRenderOrder();
+    chunk.animationStale[group] = false;
+    if (chunk.mesh[group] == IRenderer::INVALID_STATIC_MESH)
+        return;
 
-    // Collect background layer indices in render order
-    std::vector<size_t> bgLayers;
+    const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
+    const glm::vec2 tileSize(static_cast<float>(m_TileWidth), static_cast<float>(m_TileHeight));
+    const bool flipY = renderer.RequiresYFlip();
+
+    // Changed quads are uploaded in runs of consecutive mesh slots
+    std::vector<IRenderer::StaticQuad> run;
+    size_t runStart = 0;
+    auto flush = [&]()
+    {
+        if (!run.empty())
+            renderer.UpdateStaticMesh(chunk.mesh[group], runStart, run.data(), run.size(), flipY);
+        run.clear();
+    };
+
+    for (AnimatedQuad &baked : chunk.animatedQuads[group])
+    {
+        int tileID = GetAnimationFrame(baked.animId);
+        // Same transparency test as ResolveProjectedTile()
+        if (tileID >= 0 && m_TransparencyCacheBuilt && tileID < static_cast<int>(m_TileTransparencyCache.size()) &&
+            m_TileTransparencyCache[tileID])
+        {
+            tileID = -1;
+        }
+        if (tileID == baked.tileID)
+            continue;
+
+        baked.tileID = tileID;
+        baked.quad.size = tileID >= 0 ? tileSize : glm::vec2(0.0f);
+        if (tileID >= 0)
+        {
+            baked.quad.texCoord = glm::vec2(static_cast<float>((tileID % dataTilesPerRow) * m_TileWidth),
+                                            static_cast<float>((tileID / dataTilesPerRow) * m_TileHeight));
+        }
+
+        if (!run.empty() && baked.quadIndex != runStart + run.size())
+            flush();
+        if (run.empty())
+            runStart = baked.quadIndex;
+        run.push_back(baked.quad);
+    }
+    flush();
+}
+
+void Tilemap::UpdateAnimations(float deltaTime)
+{
+    m_AnimationTime += deltaTime;
+    if (m_AnimatedCellsDirty)
+        RebuildAnimatedCells();
+
+    m_AnimationFrames.resize(m_AnimatedTiles.size(), -1);
+    for (size_t animId = 0; animId < m_AnimatedTiles.size(); ++animId)
+    {
+        const int frame = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
+        if (frame == m_AnimationFrames[animId])
+            continue;
+        m_AnimationFrames[animId] = frame;
+
+        // Only chunks holding this animation need their baked quads patched
+        if (m_Chunks.empty())
+            continue;
+        for (const AnimatedCell &cell : m_AnimatedCells[animId])
+        {
+            TileChunk &chunk = m_Chunks[static_cast<size_t>((cell.y / CHUNK_SIZE) * m_ChunksX + cell.x / CHUNK_SIZE)];
+            chunk.animationStale[m_Layers[cell.layer].isBackground ? 0 : 1] = true;
+        }
+    }
+}
+
+void Tilemap::RebuildAnimatedCells()
+{
+    m_AnimatedCells.assign(m_AnimatedTiles.size(), {});
+    for (size_t layerIdx = 0; layerIdx < m_Layers.size(); ++layerIdx)
+    {
+        m_Layers[layerIdx].cells.ForEachNonEmpty([&](int x, int y, PackedTile cell)
+        {
+            const int animId = cell.GetAnimation();
+            if (animId >= 0 && animId < static_cast<int>(m_AnimatedCells.size()))
+                m_AnimatedCells[animId].push_back({x, y, static_cast<int>(layerIdx)});
+        });
+    }
+    m_AnimatedCellsDirty = false;
+}
+
+void Tilemap::MoveAnimatedCell(int x, int y, int layer, int oldAnimId, int newAnimId)
+{
+    if (m_AnimatedCellsDirty || oldAnimId == newAnimId || DeferToBulkRebuild())
+        return;
+
+    const int count = static_cast<int>(m_AnimatedCells.size());
+    if (oldAnimId >= 0 && oldAnimId < count)
+    {
+        std::erase_if(m_AnimatedCells[oldAnimId], [&](const AnimatedCell &cell)
+                      { return cell.x == x && cell.y == y && cell.layer == layer; });
+    }
+    if (newAnimId >= 0 && newAnimId < count)
+        m_AnimatedCells[newAnimId].push_back({x, y, layer});
+}
+
+void Tilemap::MarkChunkDirty(int x, int y)
+{
+    StampBlock(x, y);
+    if (m_Chunks.empty())
+        return;
+
+    TileChunk &chunk = m_Chunks[static_cast<size_t>((y / CHUNK_SIZE) * m_ChunksX + x / CHUNK_SIZE)];
+    chunk.dirty[0] = true;
+    chunk.dirty[1] = true;
+}
+
+void Tilemap::StampBlock(int x, int y)
+{
+    const size_t idx = static_cast<size_t>((y / REVISION_BLOCK_SIZE) * m_RevisionBlocksX + x / REVISION_BLOCK_SIZE);
+    if (idx < m_BlockRevisions.size())
+        m_BlockRevisions[idx] = ++m_RevisionCounter;
+}
+
+void Tilemap::ResetBlockRevisions()
+{
+    m_RevisionBlocksX = (m_MapWidth + REVISION_BLOCK_SIZE - 1) / REVISION_BLOCK_SIZE;
+    const int blocksY = (m_MapHeight + REVISION_BLOCK_SIZE - 1) / REVISION_BLOCK_SIZE;
+    m_BlockRevisions.assign(static_cast<size_t>(m_RevisionBlocksX) * static_cast<size_t>(blocksY),
+                            ++m_RevisionCounter);
+}
+
+void Tilemap::StampZoneBlock(const ParticleZone &zone)
+{
+    const int tileX = static_cast<int>(std::floor(zone.position.x / m_TileWidth));
+    const int tileY = static_cast<int>(std::floor(zone.position.y / m_TileHeight));
+    if (tileX >= 0 && tileY >= 0)
+        StampBlock(tileX, tileY);
+}
+
+uint64_t Tilemap::GetBlockRevision(int blockX, int blockY) const
+{
+    if (blockX < 0 || blockY < 0 || blockX >= m_RevisionBlocksX)
+        return 0;
+    const size_t idx = static_cast<size_t>(blockY * m_RevisionBlocksX + blockX);
+    return idx < m_BlockRevisions.size() ? m_BlockRevisions[idx] : 0;
+}
+
+void Tilemap::ReleaseChunkMeshes()
+{
+    if (m_ChunkRenderer)
+    {
+        for (TileChunk &chunk : m_Chunks)
+        {
+            m_ChunkRenderer->DestroyStaticMesh(chunk.mesh[0]);
+            m_ChunkRenderer->DestroyStaticMesh(chunk.mesh[1]);
+        }
+    }
+    m_Chunks.clear();
+    m_ChunksX = 0;
+    m_ChunksY = 0;
+    m_ChunkRenderer = nullptr;
+}
+
+void Tilemap::RenderBackgroundLayersNoProjection(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
+                                                 glm::vec2 cullCam, glm::vec2 cullSize)
+{
+    WILD_PROFILE_ZONE("Tilemap Background Upright");
+    // Single-pass NoProjection rendering for all background layers
+    auto order = GetLayerRenderOrder();
+
+    // Collect background layer indices in render order
+    FrameVector<size_t> bgLayers(&FrameArena::ThisThread());
     bgLayers.reserve(m_Layers.size());
     for (size_t idx : order)
     {
@@ -1281,7 +2032,6 @@ void Tilemap::RenderBackgroundLayersNoProjection(IRenderer &renderer, glm::vec2
     ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
 
     const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    const int mapWidth = m_MapWidth;
     const float tileWf = static_cast<float>(m_TileWidth);
     const float tileHf = static_cast<float>(m_TileHeight);
     const bool flipY = renderer.RequiresYFlip();
@@ -1293,34 +2043,29 @@ void Tilemap::RenderBackgroundLayersNoProjection(IRenderer &renderer, glm::vec2
         // 2D mode: single-pass all background layers
         for (int y = y0; y <= y1; ++y)
         {
-            const int rowOffset = y * mapWidth;
             const float tilePosY = y * tileHf - renderCam.y;
 
             for (int x = x0; x <= x1; ++x)
             {
-                const size_t idx = static_cast<size_t>(rowOffset + x);
                 const float tilePosX = x * tileWf - renderCam.x;
 
                 for (size_t layerIdx : bgLayers)
                 {
-                    const TileLayer &layer = m_Layers[layerIdx];
+                    const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
 
-                    int tileID = layer.tiles[idx];
+                    int tileID = cell.GetTileId();
 
                     if (tileID < 0)
                         continue;
 
-                    if (!layer.noProjection[idx] || layer.ySortPlus[idx])
+                    if (!cell.IsNoProjection() || cell.IsYSortPlus())
                         continue;
 
                     // Apply animated tile frame if present
-                    if (idx < layer.animationMap.size())
+                    int animId = cell.GetAnimation();
+                    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
                     {
-                        int animId = layer.animationMap[idx];
-                        if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                        {
-                            tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                        }
+                        tileID = GetAnimationFrame(animId);
                     }
 
                     if (IsTileTransparent(tileID))
@@ -1334,241 +2079,27 @@ void Tilemap::RenderBackgroundLayersNoProjection(IRenderer &renderer, glm::vec2
                                               glm::vec2(tileWf, tileHf),
                                               glm::vec2(static_cast<float>(tilesetX), static_cast<float>(tilesetY)),
                                               glm::vec2(tileWf, tileHf),
-                                              layer.rotation[idx], white, flipY);
+                                              cell.GetRotation(), white, flipY);
+                    ++m_DrawnTiles;
                 }
             }
         }
         return;
     }
 
-    // 3D mode: structure-based rendering with shared processed array
-    // Reuse member vectors to avoid allocation
-    size_t mapSize = static_cast<size_t>(m_MapWidth * m_MapHeight);
-    m_ProcessedCache.assign(mapSize, false);
-    auto& processed = m_ProcessedCache;
-    m_RenderedStructuresCache.assign(m_NoProjectionStructures.size(), false);
-    auto& renderedStructures = m_RenderedStructuresCache;
-
-    for (int y = y0; y <= y1; ++y)
-    {
-        for (int x = x0; x <= x1; ++x)
-        {
-            size_t idx = static_cast<size_t>(y * m_MapWidth + x);
-
-            if (processed[idx])
-                continue;
-
-            // Check if ANY background layer has noProjection at this position
-            bool hasNoProj = false;
-            int foundStructId = -1;
-            for (size_t layerIdx : bgLayers)
-            {
-                if (m_Layers[layerIdx].noProjection[idx] && !m_Layers[layerIdx].ySortPlus[idx])
-                {
-                    hasNoProj = true;
-                    // Check for defined structure
-                    if (idx < m_Layers[layerIdx].structureId.size() && m_Layers[layerIdx].structureId[idx] >= 0)
-                    {
-                        foundStructId = m_Layers[layerIdx].structureId[idx];
-                    }
-                    break;
-                }
-            }
-            if (!hasNoProj)
-                continue;
-
-            if (foundStructId >= 0 && foundStructId < static_cast<int>(m_NoProjectionStructures.size()))
-            {
-                // Skip if this structure was already rendered
-                if (renderedStructures[foundStructId])
-                {
-                    processed[idx] = true;
-                    continue;
-                }
-                renderedStructures[foundStructId] = true;
-
-                // Use defined structure with manual anchors
-                const NoProjectionStructure& structDef = m_NoProjectionStructures[foundStructId];
-
-                // Check if structure anchor is behind the sphere
-                float anchorCenterX = (structDef.leftAnchor.x + structDef.rightAnchor.x) * 0.5f - renderCam.x;
-                float anchorCenterY = std::max(structDef.leftAnchor.y, structDef.rightAnchor.y) - renderCam.y;
-                if (renderer.IsPointBehindSphere(glm::vec2(anchorCenterX, anchorCenterY)))
-                {
-                    processed[idx] = true;
-                    continue;
-                }
-
-                // Collect all tiles belonging to this structure
-                std::vector<std::pair<int, int>> structureTiles;
-                int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
-
-                for (int sy = y0; sy <= y1; ++sy)
-                {
-                    for (int sx = x0; sx <= x1; ++sx)
-                    {
-                        size_t sIdx = static_cast<size_t>(sy * m_MapWidth + sx);
-                        bool hasTileInStruct = false;
-                        for (size_t layerIdx : bgLayers)
-                        {
-                            if (!m_Layers[layerIdx].noProjection[sIdx] || m_Layers[layerIdx].ySortPlus[sIdx])
-                                continue;
-                            int sid = (sIdx < m_Layers[layerIdx].structureId.size()) ? m_Layers[layerIdx].structureId[sIdx] : -1;
-                            if (sid == foundStructId)
-                            {
-                                hasTileInStruct = true;
-                                break;
-                            }
-                        }
-                        if (!hasTileInStruct)
-                            continue;
-
-                        processed[sIdx] = true;
-                        structureTiles.push_back({sx, sy});
-
-                        minX = std::min(minX, sx);
-                        maxX = std::max(maxX, sx);
-                        minY = std::min(minY, sy);
-                        maxY = std::max(maxY, sy);
-                    }
-                }
-
-                if (structureTiles.empty())
-                    continue;
-
-                // Use defined anchors for projection (world coordinates)
-                glm::vec2 leftAnchor = structDef.leftAnchor;
-                glm::vec2 rightAnchor = structDef.rightAnchor;
-
-                // Bottom edge Y position from anchors (use the lower Y, which is higher world value)
-                float bottomWorldY = std::max(leftAnchor.y, rightAnchor.y);
-                float bottomScreenY = bottomWorldY - renderCam.y + 1.0f;  // +1px offset
-
-                auto perspState = renderer.GetPerspectiveState();
-
-                // Anchor X positions for projection (world coordinates)
-                float anchorMinX = std::min(leftAnchor.x, rightAnchor.x);
-                float anchorMaxX = std::max(leftAnchor.x, rightAnchor.x);
-                float structureWorldWidth = anchorMaxX - anchorMinX;
-
-                // Project anchor center to get actual on-screen Y with sphere curvature
-                // On wide screens, sphere edges curve upward, so use projected Y for viewport check
-                float anchorCenterScreenX = (anchorMinX + anchorMaxX) * 0.5f - renderCam.x;
-                glm::vec2 projectedAnchor = renderer.ProjectPoint(glm::vec2(anchorCenterScreenX, bottomScreenY));
-                float projectedAnchorY = projectedAnchor.y;
-
-                // Calculate projection blend factor - fade out projection when anchor is outside viewport
-                float projectionBlend = 1.0f;
-                float fadeMargin = perspState.viewHeight * 0.25f;
-                if (projectedAnchorY < 0.0f)
-                {
-                    projectionBlend = 1.0f + (projectedAnchorY / fadeMargin);
-                    projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
-                }
-                else if (projectedAnchorY > perspState.viewHeight)
-                {
-                    float distOutside = projectedAnchorY - perspState.viewHeight;
-                    projectionBlend = 1.0f - (distOutside / fadeMargin);
-                    projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
-                }
-
-                float t = (bottomScreenY - perspState.horizonY) / (perspState.viewHeight - perspState.horizonY);
-                t = std::max(0.0f, std::min(1.0f, t));
-                float rawVanishScale = perspState.horizonScale + (1.0f - perspState.horizonScale) * t;
-                float vanishScale = 1.0f + (rawVanishScale - 1.0f) * projectionBlend;
-                float scaledTileH = tileHf * vanishScale;
-
-                // Structure width based on tile extent (uses minX/maxX from structureTiles)
-                int structureWidthTiles = maxX - minX + 1;
-                if (structureWidthTiles < 1) structureWidthTiles = 1;
-
-                std::vector<float> projectedEdgeX(structureWidthTiles + 1);
-                for (int i = 0; i <= structureWidthTiles; ++i)
-                {
-                    float edgeScreenX = anchorMinX + (i * structureWorldWidth / structureWidthTiles) - renderCam.x;
-                    glm::vec2 projected = renderer.ProjectPoint(glm::vec2(edgeScreenX, bottomScreenY));
-                    projectedEdgeX[i] = edgeScreenX + (projected.x - edgeScreenX) * projectionBlend;
-                }
-
-                renderer.SuspendPerspective(true);
-
-                for (const auto &[tx, ty] : structureTiles)
-                {
-                    size_t tIdx = static_cast<size_t>(ty * m_MapWidth + tx);
-
-                    for (size_t layerIdx : bgLayers)
-                    {
-                        const TileLayer &layer = m_Layers[layerIdx];
-
-                        if (!layer.noProjection[tIdx] || layer.ySortPlus[tIdx])
-                            continue;
-
-                        int tid = layer.tiles[tIdx];
-                        if (tid < 0)
-                            continue;
-
-                        if (tIdx < layer.animationMap.size())
-                        {
-                            int animId = layer.animationMap[tIdx];
-                            if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                            {
-                                tid = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                            }
-                        }
-
-                        if (IsTileTransparent(tid))
-                            continue;
-
-                        // X position: use pre-computed edge positions (no gaps)
-                        // Map tile column (tx) to structure column index based on tile extent
-                        int edgeIdx = tx - minX;
-                        if (edgeIdx < 0 || edgeIdx >= static_cast<int>(projectedEdgeX.size()) - 1)
-                            continue;
-
-                        float finalX = projectedEdgeX[edgeIdx];
-                        float scaledTileW = projectedEdgeX[edgeIdx + 1] - projectedEdgeX[edgeIdx] + .5f;
-
-                        // Y position: project this tile's bottom edge for base alignment, then stack up
-                        float tileBottomScreenY = bottomWorldY - renderCam.y + 1.0f;
-                        float tileScreenX = static_cast<float>(tx * m_TileWidth) - renderCam.x;
-                        glm::vec2 projectedTileBase = renderer.ProjectPoint(glm::vec2(tileScreenX, tileBottomScreenY));
-                        float blendedBaseY = tileBottomScreenY + (projectedTileBase.y - tileBottomScreenY) * projectionBlend;
-
-                        // Calculate tile offset from bottom of structure using world Y
-                        int bottomTileY = static_cast<int>(bottomWorldY / static_cast<float>(m_TileHeight));
-                        int tileOffsetY = ty - bottomTileY;  // Rows above bottom (negative)
-                        float finalY = blendedBaseY + tileOffsetY * scaledTileH;
-
-                        int tsX = (tid % dataTilesPerRow) * m_TileWidth;
-                        int tsY = (tid / dataTilesPerRow) * m_TileHeight;
-
-                        renderer.DrawSpriteRegion(m_TilesetTexture, glm::vec2(finalX, finalY),
-                                                  glm::vec2(scaledTileW, scaledTileH),
-                                                  glm::vec2(static_cast<float>(tsX), static_cast<float>(tsY)),
-                                                  glm::vec2(tileWf, tileHf),
-                                                  layer.rotation[tIdx], white, flipY);
-                    }
-                }
-
-                renderer.SuspendPerspective(false);
-            }
-            else
-            {
-                // No defined structure - skip (requires structure assignment for no-projection)
-                processed[idx] = true;
-            }
-        }
-    }
+    // 3D mode: each defined structure is projected as a unit from its anchors
+    RenderNoProjectionStructures(renderer, renderCam, bgLayers, 0, x0, y0, x1, y1);
 }
 
 void Tilemap::RenderForegroundLayersNoProjection(IRenderer &renderer, glm::vec2 renderCam, glm::vec2 renderSize,
                                                  glm::vec2 cullCam, glm::vec2 cullSize)
 {
+    WILD_PROFILE_ZONE("Tilemap Foreground Upright");
     // Single-pass NoProjection rendering for all foreground layers
     auto order = GetLayerRenderOrder();
 
     // Collect foreground layer indices in render order
-    std::vector<size_t> fgLayers;
+    FrameVector<size_t> fgLayers(&FrameArena::ThisThread());
     fgLayers.reserve(m_Layers.size());
     for (size_t idx : order)
     {
@@ -1584,7 +2115,6 @@ void Tilemap::RenderForegroundLayersNoProjection(IRenderer &renderer, glm::vec2
     ComputeTileRange(m_MapWidth, m_MapHeight, m_TileWidth, m_TileHeight, cullCam, cullSize, x0, y0, x1, y1);
 
     const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
-    const int mapWidth = m_MapWidth;
     const float tileWf = static_cast<float>(m_TileWidth);
     const float tileHf = static_cast<float>(m_TileHeight);
     const bool flipY = renderer.RequiresYFlip();
@@ -1596,34 +2126,29 @@ void Tilemap::RenderForegroundLayersNoProjection(IRenderer &renderer, glm::vec2
         // 2D mode: single-pass all foreground layers
         for (int y = y0; y <= y1; ++y)
         {
-            const int rowOffset = y * mapWidth;
             const float tilePosY = y * tileHf - renderCam.y;
 
             for (int x = x0; x <= x1; ++x)
             {
-                const size_t idx = static_cast<size_t>(rowOffset + x);
                 const float tilePosX = x * tileWf - renderCam.x;
 
                 for (size_t layerIdx : fgLayers)
                 {
-                    const TileLayer &layer = m_Layers[layerIdx];
+                    const PackedTile cell = m_Layers[layerIdx].GetCell(x, y);
 
-                    int tileID = layer.tiles[idx];
+                    int tileID = cell.GetTileId();
 
                     if (tileID < 0)
                         continue;
 
-                    if (!layer.noProjection[idx] || layer.ySortPlus[idx])
+                    if (!cell.IsNoProjection() || cell.IsYSortPlus())
                         continue;
 
                     // Apply animated tile frame if present
-                    if (idx < layer.animationMap.size())
+                    int animId = cell.GetAnimation();
+                    if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
                     {
-                        int animId = layer.animationMap[idx];
-                        if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                        {
-                            tileID = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                        }
+                        tileID = GetAnimationFrame(animId);
                     }
 
                     if (IsTileTransparent(tileID))
@@ -1637,233 +2162,189 @@ void Tilemap::RenderForegroundLayersNoProjection(IRenderer &renderer, glm::vec2
                                               glm::vec2(tileWf, tileHf),
                                               glm::vec2(static_cast<float>(tilesetX), static_cast<float>(tilesetY)),
                                               glm::vec2(tileWf, tileHf),
-                                              layer.rotation[idx], white, flipY);
+                                              cell.GetRotation(), white, flipY);
+                    ++m_DrawnTiles;
                 }
             }
         }
         return;
     }
 
-    // 3D mode: structure-based rendering with shared processed array
-    // Reuse member vectors to avoid allocation
-    size_t mapSize = static_cast<size_t>(m_MapWidth * m_MapHeight);
-    m_ProcessedCache.assign(mapSize, false);
-    auto& processed = m_ProcessedCache;
-    m_RenderedStructuresCache.assign(m_NoProjectionStructures.size(), false);
-    auto& renderedStructures = m_RenderedStructuresCache;
+    // 3D mode: each defined structure is projected as a unit from its anchors
+    RenderNoProjectionStructures(renderer, renderCam, fgLayers, 1, x0, y0, x1, y1);
+}
 
-    for (int y = y0; y <= y1; ++y)
-    {
-        for (int x = x0; x <= x1; ++x)
-        {
-            size_t idx = static_cast<size_t>(y * m_MapWidth + x);
+void Tilemap::RenderNoProjectionStructures(IRenderer &renderer, glm::vec2 renderCam, std::span<const size_t> layers,
+                                           int group, int x0, int y0, int x1, int y1)
+{
+    if (m_StructureIndexDirty || m_StructureIndex.size() != m_NoProjectionStructures.size())
+        RebuildStructureIndex();
 
-            if (processed[idx])
-                continue;
+    const int dataTilesPerRow = m_TilesetDataWidth / m_TileWidth;
+    const float tileWf = static_cast<float>(m_TileWidth);
+    const float tileHf = static_cast<float>(m_TileHeight);
+    const bool flipY = renderer.RequiresYFlip();
+    const glm::vec3 white(1.0f);
+
+    // Structures reaching the view, drawn in the row-major order of their first visible cell
+    auto &visible = m_VisibleStructuresCache;
+    visible.clear();
+    for (size_t id = 0; id < m_StructureIndex.size(); ++id)
+    {
+        const StructureMembers &members = m_StructureIndex[id][group];
+        if (members.tiles.empty() || members.maxX < x0 || members.minX > x1 || members.maxY < y0 || members.minY > y1)
+            continue;
 
-            // Check if ANY foreground layer has noProjection at this position
-            bool hasNoProj = false;
-            int foundStructId = -1;
-            for (size_t layerIdx : fgLayers)
+        auto first = std::lower_bound(members.tiles.begin(), members.tiles.end(), std::pair<int, int>{x0, y0},
+                                      RowMajorLess);
+        for (; first != members.tiles.end() && first->second <= y1; ++first)
+        {
+            if (first->first >= x0 && first->first <= x1)
             {
-                if (m_Layers[layerIdx].noProjection[idx] && !m_Layers[layerIdx].ySortPlus[idx])
-                {
-                    hasNoProj = true;
-                    if (idx < m_Layers[layerIdx].structureId.size() && m_Layers[layerIdx].structureId[idx] >= 0)
-                    {
-                        foundStructId = m_Layers[layerIdx].structureId[idx];
-                    }
-                    break;
-                }
+                visible.push_back({first->second * m_MapWidth + first->first, static_cast<int>(id)});
+                break;
             }
-            if (!hasNoProj)
-                continue;
+        }
+    }
+    std::sort(visible.begin(), visible.end());
 
-            if (foundStructId >= 0 && foundStructId < static_cast<int>(m_NoProjectionStructures.size()))
-            {
-                if (renderedStructures[foundStructId])
-                {
-                    processed[idx] = true;
-                    continue;
-                }
-                renderedStructures[foundStructId] = true;
+    for (const auto &[firstCell, id] : visible)
+    {
+        const StructureMembers &members = m_StructureIndex[id][group];
+        const NoProjectionStructure& structDef = m_NoProjectionStructures[id];
 
-                const NoProjectionStructure& structDef = m_NoProjectionStructures[foundStructId];
+        // Check if structure anchor is behind the sphere
+        float anchorCenterX = (structDef.leftAnchor.x + structDef.rightAnchor.x) * 0.5f - renderCam.x;
+        float anchorCenterY = std::max(structDef.leftAnchor.y, structDef.rightAnchor.y) - renderCam.y;
+        if (renderer.IsPointBehindSphere(glm::vec2(anchorCenterX, anchorCenterY)))
+            continue;
 
-                // Check if structure anchor is behind the sphere
-                float anchorCenterX = (structDef.leftAnchor.x + structDef.rightAnchor.x) * 0.5f - renderCam.x;
-                float anchorCenterY = std::max(structDef.leftAnchor.y, structDef.rightAnchor.y) - renderCam.y;
-                if (renderer.IsPointBehindSphere(glm::vec2(anchorCenterX, anchorCenterY)))
-                {
-                    processed[idx] = true;
-                    continue;
-                }
+        // Use defined anchors for projection (world coordinates)
+        glm::vec2 leftAnchor = structDef.leftAnchor;
+        glm::vec2 rightAnchor = structDef.rightAnchor;
 
-                std::vector<std::pair<int, int>> structureTiles;
-                int minX = INT_MAX, maxX = INT_MIN, minY = INT_MAX, maxY = INT_MIN;
+        // Bottom edge Y position from anchors (use the lower Y, which is higher world value)
+        float bottomWorldY = std::max(leftAnchor.y, rightAnchor.y);
+        float bottomScreenY = bottomWorldY - renderCam.y + 1.0f;  // +1px offset
 
-                for (int sy = y0; sy <= y1; ++sy)
-                {
-                    for (int sx = x0; sx <= x1; ++sx)
-                    {
-                        size_t sIdx = static_cast<size_t>(sy * m_MapWidth + sx);
-                        bool hasTileInStruct = false;
-                        for (size_t layerIdx : fgLayers)
-                        {
-                            if (!m_Layers[layerIdx].noProjection[sIdx] || m_Layers[layerIdx].ySortPlus[sIdx])
-                                continue;
-                            int sid = (sIdx < m_Layers[layerIdx].structureId.size()) ? m_Layers[layerIdx].structureId[sIdx] : -1;
-                            if (sid == foundStructId)
-                            {
-                                hasTileInStruct = true;
-                                break;
-                            }
-                        }
-                        if (!hasTileInStruct)
-                            continue;
+        auto perspState = renderer.GetPerspectiveState();
 
-                        processed[sIdx] = true;
-                        structureTiles.push_back({sx, sy});
+        // Anchor X positions for projection (world coordinates)
+        float anchorMinX = std::min(leftAnchor.x, rightAnchor.x);
+        float anchorMaxX = std::max(leftAnchor.x, rightAnchor.x);
+        float structureWorldWidth = anchorMaxX - anchorMinX;
 
-                        minX = std::min(minX, sx);
-                        maxX = std::max(maxX, sx);
-                        minY = std::min(minY, sy);
-                        maxY = std::max(maxY, sy);
-                    }
-                }
+        // Project anchor center to get actual on-screen Y with sphere curvature
+        // On wide screens, sphere edges curve upward, so use projected Y for viewport check
+        float anchorCenterScreenX = (anchorMinX + anchorMaxX) * 0.5f - renderCam.x;
+        glm::vec2 projectedAnchor = renderer.ProjectPoint(glm::vec2(anchorCenterScreenX, bottomScreenY));
+        float projectedAnchorY = projectedAnchor.y;
 
-                if (structureTiles.empty())
-                    continue;
+        // Calculate projection blend factor - fade out projection when anchor is outside viewport
+        float projectionBlend = 1.0f;
+        float fadeMargin = perspState.viewHeight * 0.25f;
+        if (projectedAnchorY < 0.0f)
+        {
+            projectionBlend = 1.0f + (projectedAnchorY / fadeMargin);
+            projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
+        }
+        else if (projectedAnchorY > perspState.viewHeight)
+        {
+            float distOutside = projectedAnchorY - perspState.viewHeight;
+            projectionBlend = 1.0f - (distOutside / fadeMargin);
+            projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
+        }
 
-                // Use defined anchors for projection (world coordinates)
-                glm::vec2 leftAnchor = structDef.leftAnchor;
-                glm::vec2 rightAnchor = structDef.rightAnchor;
+        float t = (bottomScreenY - perspState.horizonY) / (perspState.viewHeight - perspState.horizonY);
+        t = std::max(0.0f, std::min(1.0f, t));
+        float rawVanishScale = perspState.horizonScale + (1.0f - perspState.horizonScale) * t;
+        float vanishScale = 1.0f + (rawVanishScale - 1.0f) * projectionBlend;
+        float scaledTileH = tileHf * vanishScale;
 
-                // Bottom edge Y position from anchors (use the lower Y, which is higher world value)
-                float bottomWorldY = std::max(leftAnchor.y, rightAnchor.y);
-                float bottomScreenY = bottomWorldY - renderCam.y + 1.0f;  // +1px offset
+        // Structure width based on the tile extent of the whole structure
+        int structureWidthTiles = members.maxX - members.minX + 1;
+        if (structureWidthTiles < 1) structureWidthTiles = 1;
 
-                auto perspState = renderer.GetPerspectiveState();
+        std::vector<float> projectedEdgeX(structureWidthTiles + 1);
+        for (int i = 0; i <= structureWidthTiles; ++i)
+        {
+            float edgeScreenX = anchorMinX + (i * structureWorldWidth / structureWidthTiles) - renderCam.x;
+            glm::vec2 projected = renderer.ProjectPoint(glm::vec2(edgeScreenX, bottomScreenY));
+            projectedEdgeX[i] = edgeScreenX + (projected.x - edgeScreenX) * projectionBlend;
+        }
 
-                // Anchor X positions for projection (world coordinates)
-                float anchorMinX = std::min(leftAnchor.x, rightAnchor.x);
-                float anchorMaxX = std::max(leftAnchor.x, rightAnchor.x);
-                float structureWorldWidth = anchorMaxX - anchorMinX;
+        renderer.SuspendPerspective(true);
 
-                // Project anchor center to get actual on-screen Y with sphere curvature
-                // On wide screens, sphere edges curve upward, so use projected Y for viewport check
-                float anchorCenterScreenX = (anchorMinX + anchorMaxX) * 0.5f - renderCam.x;
-                glm::vec2 projectedAnchor = renderer.ProjectPoint(glm::vec2(anchorCenterScreenX, bottomScreenY));
-                float projectedAnchorY = projectedAnchor.y;
+        // Only visible member cells are drawn; the list is row-major, so rows y0..y1 are one range
+        auto rowBegin = std::lower_bound(members.tiles.begin(), members.tiles.end(), std::pair<int, int>{x0, y0},
+                                         RowMajorLess);
+        auto rowEnd = std::upper_bound(rowBegin, members.tiles.end(), std::pair<int, int>{x1, y1}, RowMajorLess);
+        for (auto it = rowBegin; it != rowEnd; ++it)
+        {
+            const auto [tx, ty] = *it;
+            if (tx < x0 || tx > x1)
+                continue;
 
-                // Calculate projection blend factor - fade out projection when anchor is outside viewport
-                float projectionBlend = 1.0f;
-                float fadeMargin = perspState.viewHeight * 0.25f;
-                if (projectedAnchorY < 0.0f)
-                {
-                    projectionBlend = 1.0f + (projectedAnchorY / fadeMargin);
-                    projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
-                }
-                else if (projectedAnchorY > perspState.viewHeight)
-                {
-                    float distOutside = projectedAnchorY - perspState.viewHeight;
-                    projectionBlend = 1.0f - (distOutside / fadeMargin);
-                    projectionBlend = std::max(0.0f, std::min(1.0f, projectionBlend));
-                }
+            for (size_t layerIdx : layers)
+            {
+                const PackedTile cell = m_Layers[layerIdx].GetCell(tx, ty);
 
-                float t = (bottomScreenY - perspState.horizonY) / (perspState.viewHeight - perspState.horizonY);
-                t = std::max(0.0f, std::min(1.0f, t));
-                float rawVanishScale = perspState.horizonScale + (1.0f - perspState.horizonScale) * t;
-                float vanishScale = 1.0f + (rawVanishScale - 1.0f) * projectionBlend;
-                float scaledTileH = tileHf * vanishScale;
+                if (!cell.IsNoProjection() || cell.IsYSortPlus())
+                    continue;
 
-                // Structure width based on tile extent (uses minX/maxX from structureTiles)
-                int structureWidthTiles = maxX - minX + 1;
-                if (structureWidthTiles < 1) structureWidthTiles = 1;
+                int tid = cell.GetTileId();
+                if (tid < 0)
+                    continue;
 
-                std::vector<float> projectedEdgeX(structureWidthTiles + 1);
-                for (int i = 0; i <= structureWidthTiles; ++i)
+                int animId = cell.GetAnimation();
+                if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
                 {
-                    float edgeScreenX = anchorMinX + (i * structureWorldWidth / structureWidthTiles) - renderCam.x;
-                    glm::vec2 projected = renderer.ProjectPoint(glm::vec2(edgeScreenX, bottomScreenY));
-                    projectedEdgeX[i] = edgeScreenX + (projected.x - edgeScreenX) * projectionBlend;
+                    tid = GetAnimationFrame(animId);
                 }
 
-                renderer.SuspendPerspective(true);
-
-                for (const auto &[tx, ty] : structureTiles)
-                {
-                    size_t tIdx = static_cast<size_t>(ty * m_MapWidth + tx);
-
-                    for (size_t layerIdx : fgLayers)
-                    {
-                        const TileLayer &layer = m_Layers[layerIdx];
-
-                        if (!layer.noProjection[tIdx] || layer.ySortPlus[tIdx])
-                            continue;
-
-                        int tid = layer.tiles[tIdx];
-                        if (tid < 0)
-                            continue;
-
-                        if (tIdx < layer.animationMap.size())
-                        {
-                            int animId = layer.animationMap[tIdx];
-                            if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()))
-                            {
-                                tid = m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
-                            }
-                        }
+                if (IsTileTransparent(tid))
+                    continue;
 
-                        if (IsTileTransparent(tid))
-                            continue;
-
-                        // X position: use pre-computed edge positions (no gaps)
-                        // Map tile column (tx) to structure column index based on tile extent
-                        int edgeIdx = tx - minX;
-                        if (edgeIdx < 0 || edgeIdx >= static_cast<int>(projectedEdgeX.size()) - 1)
-                            continue;
-
-                        float finalX = projectedEdgeX[edgeIdx];
-                        float scaledTileW = projectedEdgeX[edgeIdx + 1] - projectedEdgeX[edgeIdx] + .5f;
-
-                        // Y position: project this tile's bottom edge for base alignment, then stack up
-                        float tileBottomScreenY = bottomWorldY - renderCam.y + 1.0f;
-                        float tileScreenX = static_cast<float>(tx * m_TileWidth) - renderCam.x;
-                        glm::vec2 projectedTileBase = renderer.ProjectPoint(glm::vec2(tileScreenX, tileBottomScreenY));
-                        float blendedBaseY = tileBottomScreenY + (projectedTileBase.y - tileBottomScreenY) * projectionBlend;
-
-                        // Calculate tile offset from bottom of structure using world Y
-                        int bottomTileY = static_cast<int>(bottomWorldY / static_cast<float>(m_TileHeight));
-                        int tileOffsetY = ty - bottomTileY;  // Rows above bottom (negative)
-                        float finalY = blendedBaseY + tileOffsetY * scaledTileH;
-
-                        int tsX = (tid % dataTilesPerRow) * m_TileWidth;
-                        int tsY = (tid / dataTilesPerRow) * m_TileHeight;
-
-                        renderer.DrawSpriteRegion(m_TilesetTexture, glm::vec2(finalX, finalY),
-                                                  glm::vec2(scaledTileW, scaledTileH),
-                                                  glm::vec2(static_cast<float>(tsX), static_cast<float>(tsY)),
-                                                  glm::vec2(tileWf, tileHf),
-                                                  layer.rotation[tIdx], white, flipY);
-                    }
-                }
+                // X position: use pre-computed edge positions (no gaps)
+                // Map tile column (tx) to structure column index based on tile extent
+                int edgeIdx = tx - members.minX;
+                if (edgeIdx < 0 || edgeIdx >= static_cast<int>(projectedEdgeX.size()) - 1)
+                    continue;
 
-                renderer.SuspendPerspective(false);
-            }
-            else
-            {
-                // No defined structure - skip (requires structure assignment for no-projection)
-                processed[idx] = true;
+                float finalX = projectedEdgeX[edgeIdx];
+                float scaledTileW = projectedEdgeX[edgeIdx + 1] - projectedEdgeX[edgeIdx] + .5f;
+
+                // Y position: project this tile's bottom edge for base alignment, then stack up
+                float tileBottomScreenY = bottomWorldY - renderCam.y + 1.0f;
+                float tileScreenX = static_cast<float>(tx * m_TileWidth) - renderCam.x;
+                glm::vec2 projectedTileBase = renderer.ProjectPoint(glm::vec2(tileScreenX, tileBottomScreenY));
+                float blendedBaseY = tileBottomScreenY + (projectedTileBase.y - tileBottomScreenY) * projectionBlend;
+
+                // Calculate tile offset from bottom of structure using world Y
+                int bottomTileY = static_cast<int>(bottomWorldY / static_cast<float>(m_TileHeight));
+                int tileOffsetY = ty - bottomTileY;  // Rows above bottom (negative)
+                float finalY = blendedBaseY + tileOffsetY * scaledTileH;
+
+                int tsX = (tid % dataTilesPerRow) * m_TileWidth;
+                int tsY = (tid / dataTilesPerRow) * m_TileHeight;
+
+                renderer.DrawSpriteRegion(m_TilesetTexture, glm::vec2(finalX, finalY),
+                                          glm::vec2(scaledTileW, scaledTileH),
+                                          glm::vec2(static_cast<float>(tsX), static_cast<float>(tsY)),
+                                          glm::vec2(tileWf, tileHf),
+                                          cell.GetRotation(), white, flipY);
+                ++m_DrawnTiles;
             }
         }
+
+        renderer.SuspendPerspective(false);
     }
 }
 
 void Tilemap::GenerateDefaultMap()
 {
     // Validate tileset is loaded
-    if (!m_TilesetData || m_TilesetDataWidth == 0 || m_TilesetDataHeight == 0)
+    if (!m_TransparencyCacheBuilt || m_TilesetDataWidth == 0 || m_TilesetDataHeight == 0)
     {
         std::cerr << "ERROR: Cannot generate map - tileset data not loaded!" << std::endl;
         return;
@@ -1930,7 +2411,7 @@ std::vector<int> Tilemap::GetValidTileIDs() const
 {
     std::vector<int> validTileIDs;
 
-    if (!m_TilesetData || m_TilesetDataWidth == 0 || m_TilesetDataHeight == 0)
+    if (!m_TransparencyCacheBuilt || m_TilesetDataWidth == 0 || m_TilesetDataHeight == 0)
     {
         return validTileIDs;
     }
@@ -2092,15 +2573,232 @@ static nlohmann::json SerializeConsequences(const std::vector<DialogueConsequenc
     return arr;
 }
 
-bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPlayerCharacter> *npcs,
-                            int playerTileX, int playerTileY, int characterType) const
+static nlohmann::json SerializeAnimatedTiles(const std::vector<AnimatedTile> &animatedTiles)
 {
-    using json = nlohmann::json;
-
-    json j;
-
-    // Map dimensions
-    j["width"] = m_MapWidth;
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto &anim : animatedTiles)
+    {
+        nlohmann::json animJson;
+        animJson["frames"] = anim.frames;
+        animJson["frameDuration"] = anim.frameDuration;
+        arr.push_back(animJson);
+    }
+    return arr;
+}
+
+static void ParseAnimatedTiles(const nlohmann::json &arr, std::vector<AnimatedTile> &animatedTiles)
+{
+    animatedTiles.clear();
+    for (const auto &animJson : arr)
+    {
+        AnimatedTile anim;
+        if (animJson.contains("frames") && animJson["frames"].is_array())
+        {
+            anim.frames = animJson["frames"].get<std::vector<int>>();
+        }
+        anim.frameDuration = animJson.value("frameDuration", 0.2f);
+        animatedTiles.push_back(anim);
+    }
+}
+
+static nlohmann::json SerializeTileLights(const std::vector<TileLight> &tileLights)
+{
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto &light : tileLights)
+    {
+        nlohmann::json lightJson;
+        lightJson["tileId"] = light.tileId;
+        lightJson["color"] = {light.color.r, light.color.g, light.color.b};
+        lightJson["radius"] = light.radius;
+        arr.push_back(lightJson);
+    }
+    return arr;
+}
+
+static void ParseTileLights(const nlohmann::json &arr, std::vector<TileLight> &tileLights)
+{
+    tileLights.clear();
+    for (const auto &lightJson : arr)
+    {
+        TileLight light{lightJson.value("tileId", -1), glm::vec3(1.0f), lightJson.value("radius", 0.0f)};
+        if (lightJson.contains("color") && lightJson["color"].is_array() && lightJson["color"].size() == 3)
+        {
+            light.color = glm::vec3(lightJson["color"][0].get<float>(), lightJson["color"][1].get<float>(),
+                                    lightJson["color"][2].get<float>());
+        }
+        if (light.tileId >= 0 && light.radius > 0.0f)
+            tileLights.push_back(light);
+    }
+}
+
+static nlohmann::json SerializeStructures(const std::vector<NoProjectionStructure> &structures)
+{
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto &s : structures)
+    {
+        nlohmann::json structJson;
+        structJson["id"] = s.id;
+        if (!s.name.empty())
+        {
+            structJson["name"] = s.name;
+        }
+        structJson["leftAnchor"] = {s.leftAnchor.x, s.leftAnchor.y};
+        structJson["rightAnchor"] = {s.rightAnchor.x, s.rightAnchor.y};
+        arr.push_back(structJson);
+    }
+    return arr;
+}
+
+static void ParseStructures(const nlohmann::json &arr, std::vector<NoProjectionStructure> &structures)
+{
+    structures.clear();
+    for (const auto &structJson : arr)
+    {
+        NoProjectionStructure s;
+        s.id = structJson.value("id", static_cast<int>(structures.size()));
+        s.name = structJson.value("name", "");
+        if (structJson.contains("leftAnchor") && structJson["leftAnchor"].is_array() && structJson["leftAnchor"].size() >= 2)
+        {
+            s.leftAnchor.x = structJson["leftAnchor"][0].get<float>();
+            s.leftAnchor.y = structJson["leftAnchor"][1].get<float>();
+        }
+        if (structJson.contains("rightAnchor") && structJson["rightAnchor"].is_array() && structJson["rightAnchor"].size() >= 2)
+        {
+            s.rightAnchor.x = structJson["rightAnchor"][0].get<float>();
+            s.rightAnchor.y = structJson["rightAnchor"][1].get<float>();
+        }
+        structures.push_back(s);
+    }
+}
+
+static nlohmann::json SerializeNpc(const NonPlayerCharacter &npc)
+{
+    using json = nlohmann::json;
+
+    json npcObj;
+    npcObj["type"] = npc.GetType();
+    npcObj["tileX"] = npc.GetTileX();
+    npcObj["tileY"] = npc.GetTileY();
+    if (!npc.GetName().empty())
+    {
+        npcObj["name"] = npc.GetName();
+    }
+    if (!npc.GetDialogue().empty())
+    {
+        npcObj["dialogue"] = npc.GetDialogue();
+    }
+    // Save dialogue tree (simplified format)
+    if (npc.HasDialogueTree())
+    {
+        const DialogueTree &tree = npc.GetDialogueTree();
+        json treeJson;
+        if (tree.startNodeId != "start")
+            treeJson["start"] = tree.startNodeId;
+
+        // Find default speaker (most common speaker in nodes)
+        std::string defaultSpeaker = npc.GetName();
+        if (!tree.nodes.empty())
+            defaultSpeaker = tree.nodes.begin()->second.speaker;
+        if (!defaultSpeaker.empty())
+            treeJson["speaker"] = defaultSpeaker;
+
+        json nodesObj = json::object();
+        for (const auto &[nodeId, node] : tree.nodes)
+        {
+            json nodeJson;
+            if (node.speaker != defaultSpeaker)
+                nodeJson["speaker"] = node.speaker;
+            nodeJson["text"] = node.text;
+
+            json choicesArr = json::array();
+            for (const auto &opt : node.options)
+            {
+                json choiceJson;
+                choiceJson["text"] = opt.text;
+                if (!opt.nextNodeId.empty())
+                    choiceJson["goto"] = opt.nextNodeId;
+                std::string whenStr = SerializeConditions(opt.conditions);
+                if (!whenStr.empty())
+                    choiceJson["when"] = whenStr;
+                if (!opt.consequences.empty())
+                    choiceJson["do"] = SerializeConsequences(opt.consequences);
+                choicesArr.push_back(choiceJson);
+            }
+            nodeJson["choices"] = choicesArr;
+            nodesObj[nodeId] = nodeJson;
+        }
+        treeJson["nodes"] = nodesObj;
+        npcObj["dialogueTree"] = treeJson;
+    }
+    return npcObj;
+}
+
+static bool LoadNpc(const nlohmann::json &npcJson, int tileWidth, NonPlayerCharacter &npc)
+{
+    std::string type = npcJson.value("type", "");
+    int tileX = npcJson.value("tileX", 0);
+    int tileY = npcJson.value("tileY", 0);
+    std::string name = npcJson.value("name", "");
+    std::string dialogue = npcJson.value("dialogue", "");
+
+    if (type.empty() || !npc.Load("assets/non-player/" + type + ".png"))
+        return false;
+
+    npc.SetTilePosition(tileX, tileY, tileWidth);
+    if (!name.empty())
+        npc.SetName(name);
+    if (!dialogue.empty())
+        npc.SetDialogue(dialogue);
+
+    // Load dialogue tree (simplified format)
+    if (npcJson.contains("dialogueTree") && npcJson["dialogueTree"].is_object())
+    {
+        const auto &treeJson = npcJson["dialogueTree"];
+        DialogueTree tree;
+        tree.id = treeJson.value("id", npc.GetType());
+        tree.startNodeId = treeJson.value("start", "start");
+        std::string defaultSpeaker = treeJson.value("speaker", npc.GetName());
+
+        if (treeJson.contains("nodes") && treeJson["nodes"].is_object())
+        {
+            for (auto &[nodeId, nodeJson] : treeJson["nodes"].items())
+            {
+                DialogueNode node;
+                node.id = nodeId;
+                node.speaker = nodeJson.value("speaker", defaultSpeaker);
+                node.text = nodeJson.value("text", "");
+
+                if (nodeJson.contains("choices") && nodeJson["choices"].is_array())
+                {
+                    for (const auto &choiceJson : nodeJson["choices"])
+                    {
+                        DialogueOption opt;
+                        opt.text = choiceJson.value("text", "");
+                        opt.nextNodeId = choiceJson.value("goto", "");
+                        opt.conditions = ParseConditionString(choiceJson.value("when", ""));
+                        if (choiceJson.contains("do"))
+                            opt.consequences = ParseConsequenceArray(choiceJson["do"]);
+                        node.options.push_back(opt);
+                    }
+                }
+                tree.nodes[node.id] = node;
+            }
+        }
+        npc.SetDialogueTree(tree);
+    }
+
+    return true;
+}
+
+bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPlayerCharacter> *npcs,
+                            int playerTileX, int playerTileY, int characterType) const
+{
+    using json = nlohmann::json;
+
+    json j;
+
+    // Map dimensions
+    j["width"] = m_MapWidth;
     j["height"] = m_MapHeight;
     j["tileWidth"] = m_TileWidth;
     j["tileHeight"] = m_TileHeight;
@@ -2139,70 +2837,40 @@ bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPl
         layerJson["renderOrder"] = layer.renderOrder;
         layerJson["isBackground"] = layer.isBackground;
 
-        // Tiles (sparse)
+        // One pass over the allocated chunks fills every sparse per-tile field:
+        //   tiles, rotation:                     objects keyed by flat index
+        //   noProjection, ySortPlus, ySortMinus: arrays of flat indices
         json tilesObj = json::object();
-        for (size_t i = 0; i < layer.tiles.size(); ++i)
-        {
-            if (layer.tiles[i] != -1)
-            {
-                tilesObj[std::to_string(i)] = layer.tiles[i];
-            }
-        }
-        layerJson["tiles"] = tilesObj;
-
-        // Rotation (sparse)
         json rotObj = json::object();
-        for (size_t i = 0; i < layer.rotation.size(); ++i)
-        {
-            if (layer.rotation[i] != 0.0f)
-            {
-                rotObj[std::to_string(i)] = layer.rotation[i];
-            }
-        }
-        layerJson["rotation"] = rotObj;
-
-        // NoProjection (array of indices)
         json noProjArr = json::array();
-        for (size_t i = 0; i < layer.noProjection.size(); ++i)
-        {
-            if (layer.noProjection[i])
-            {
-                noProjArr.push_back(static_cast<int>(i));
-            }
-        }
-        layerJson["noProjection"] = noProjArr;
-
-        // YSortPlus (array of indices)
         json ySortPlusArr = json::array();
-        for (size_t i = 0; i < layer.ySortPlus.size(); ++i)
-        {
-            if (layer.ySortPlus[i])
-            {
-                ySortPlusArr.push_back(static_cast<int>(i));
-            }
-        }
-        layerJson["ySortPlus"] = ySortPlusArr;
-
-        // YSortMinus (array of indices for Y-sorted tiles where player renders behind)
         json ySortMinusArr = json::array();
-        for (size_t i = 0; i < layer.ySortMinus.size(); ++i)
+        layer.cells.ForEachNonEmpty([&](int x, int y, PackedTile cell)
         {
-            if (layer.ySortMinus[i])
-            {
-                ySortMinusArr.push_back(static_cast<int>(i));
-            }
-        }
+            const int i = y * m_MapWidth + x;
+            if (cell.GetTileId() != -1)
+                tilesObj[std::to_string(i)] = cell.GetTileId();
+            if (cell.GetRotationQuadrant() != 0)
+                rotObj[std::to_string(i)] = cell.GetRotation();
+            if (cell.IsNoProjection())
+                noProjArr.push_back(i);
+            if (cell.IsYSortPlus())
+                ySortPlusArr.push_back(i);
+            if (cell.IsYSortMinus())
+                ySortMinusArr.push_back(i);
+        });
+        layerJson["tiles"] = tilesObj;
+        layerJson["rotation"] = rotObj;
+        layerJson["noProjection"] = noProjArr;
+        layerJson["ySortPlus"] = ySortPlusArr;
         layerJson["ySortMinus"] = ySortMinusArr;
 
         // StructureId (sparse - only save non-default values)
         json structIdObj = json::object();
-        for (size_t i = 0; i < layer.structureId.size(); ++i)
+        layer.structureIds.ForEachNonEmpty([&](int x, int y, int32_t structId)
         {
-            if (layer.structureId[i] >= 0)
-            {
-                structIdObj[std::to_string(i)] = layer.structureId[i];
-            }
-        }
+            structIdObj[std::to_string(y * m_MapWidth + x)] = structId;
+        });
         if (!structIdObj.empty())
         {
             layerJson["structureId"] = structIdObj;
@@ -2215,20 +2883,7 @@ bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPl
     // No-Projection Structures (manually defined with anchors)
     if (!m_NoProjectionStructures.empty())
     {
-        json structuresArray = json::array();
-        for (const auto &s : m_NoProjectionStructures)
-        {
-            json structJson;
-            structJson["id"] = s.id;
-            if (!s.name.empty())
-            {
-                structJson["name"] = s.name;
-            }
-            structJson["leftAnchor"] = {s.leftAnchor.x, s.leftAnchor.y};
-            structJson["rightAnchor"] = {s.rightAnchor.x, s.rightAnchor.y};
-            structuresArray.push_back(structJson);
-        }
-        j["noProjectionStructures"] = structuresArray;
+        j["noProjectionStructures"] = SerializeStructures(m_NoProjectionStructures);
     }
 
     // Particle Zones
@@ -2254,62 +2909,7 @@ bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPl
         std::cout << "Saving " << npcs->size() << " NPCs to " << filename << std::endl;
         for (const auto &npc : *npcs)
         {
-            json npcObj;
-            npcObj["type"] = npc.GetType();
-            npcObj["tileX"] = npc.GetTileX();
-            npcObj["tileY"] = npc.GetTileY();
-            if (!npc.GetName().empty())
-            {
-                npcObj["name"] = npc.GetName();
-            }
-            if (!npc.GetDialogue().empty())
-            {
-                npcObj["dialogue"] = npc.GetDialogue();
-            }
-            // Save dialogue tree (simplified format)
-            if (npc.HasDialogueTree())
-            {
-                const DialogueTree &tree = npc.GetDialogueTree();
-                json treeJson;
-                if (tree.startNodeId != "start")
-                    treeJson["start"] = tree.startNodeId;
-
-                // Find default speaker (most common speaker in nodes)
-                std::string defaultSpeaker = npc.GetName();
-                if (!tree.nodes.empty())
-                    defaultSpeaker = tree.nodes.begin()->second.speaker;
-                if (!defaultSpeaker.empty())
-                    treeJson["speaker"] = defaultSpeaker;
-
-                json nodesObj = json::object();
-                for (const auto &[nodeId, node] : tree.nodes)
-                {
-                    json nodeJson;
-                    if (node.speaker != defaultSpeaker)
-                        nodeJson["speaker"] = node.speaker;
-                    nodeJson["text"] = node.text;
-
-                    json choicesArr = json::array();
-                    for (const auto &opt : node.options)
-                    {
-                        json choiceJson;
-                        choiceJson["text"] = opt.text;
-                        if (!opt.nextNodeId.empty())
-                            choiceJson["goto"] = opt.nextNodeId;
-                        std::string whenStr = SerializeConditions(opt.conditions);
-                        if (!whenStr.empty())
-                            choiceJson["when"] = whenStr;
-                        if (!opt.consequences.empty())
-                            choiceJson["do"] = SerializeConsequences(opt.consequences);
-                        choicesArr.push_back(choiceJson);
-                    }
-                    nodeJson["choices"] = choicesArr;
-                    nodesObj[nodeId] = nodeJson;
-                }
-                treeJson["nodes"] = nodesObj;
-                npcObj["dialogueTree"] = treeJson;
-            }
-            npcsArray.push_back(npcObj);
+            npcsArray.push_back(SerializeNpc(npc));
             std::cout << "  Saved NPC: " << npc.GetType() << " at (" << npc.GetTileX() << ", " << npc.GetTileY() << ")" << std::endl;
         }
     }
@@ -2333,29 +2933,23 @@ bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPl
     }
 
     // Animated Tiles - save animation definitions and placements
-    json animatedTilesArray = json::array();
-    for (const auto &anim : m_AnimatedTiles)
-    {
-        json animJson;
-        animJson["frames"] = anim.frames;
-        animJson["frameDuration"] = anim.frameDuration;
-        animatedTilesArray.push_back(animJson);
-    }
-    j["animatedTiles"] = animatedTilesArray;
+    j["animatedTiles"] = SerializeAnimatedTiles(m_AnimatedTiles);
+
+    // Tile Lights - emissive tile definitions for the light map
+    j["tileLights"] = SerializeTileLights(m_TileLights);
 
     // Animation Map - save per-layer animation maps (sparse format)
     json layerAnimMaps = json::array();
     for (size_t layerIdx = 0; layerIdx < m_Layers.size(); ++layerIdx)
     {
         json layerAnimObj = json::object();
-        const auto &animMap = m_Layers[layerIdx].animationMap;
-        for (size_t i = 0; i < animMap.size(); ++i)
+        m_Layers[layerIdx].cells.ForEachNonEmpty([&](int x, int y, PackedTile cell)
         {
-            if (animMap[i] >= 0)
+            if (cell.GetAnimation() >= 0)
             {
-                layerAnimObj[std::to_string(i)] = animMap[i];
+                layerAnimObj[std::to_string(y * m_MapWidth + x)] = cell.GetAnimation();
             }
-        }
+        });
         layerAnimMaps.push_back(layerAnimObj);
     }
     j["layerAnimationMaps"] = layerAnimMaps;
@@ -2391,6 +2985,8 @@ bool Tilemap::SaveMapToJSON(const std::string &filename, const std::vector<NonPl
 bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayerCharacter> *npcs,
                               int *playerTileX, int *playerTileY, int *characterType)
 {
+    ReleaseChunkMeshes();
+
     using json = nlohmann::json;
 
     std::ifstream file(filename);
@@ -2533,7 +3129,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
             layer.name = layerJson.value("name", "");
             layer.renderOrder = layerJson.value("renderOrder", 0);
             layer.isBackground = layerJson.value("isBackground", true);
-            layer.resize(mapSize);
+            layer.resize(width, height);
 
             // Load tiles (sparse object)
             if (layerJson.contains("tiles") && layerJson["tiles"].is_object())
@@ -2545,7 +3141,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(std::stoi(key));
                         if (index < mapSize)
                         {
-                            layer.tiles[index] = value.get<int>();
+                            layer.SetTile(static_cast<int>(index % width), static_cast<int>(index / width), value.get<int>());
                         }
                         else
                         {
@@ -2568,7 +3164,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(std::stoi(key));
                         if (index < mapSize)
                         {
-                            layer.rotation[index] = value.get<float>();
+                            layer.SetRotation(static_cast<int>(index % width), static_cast<int>(index / width), value.get<float>());
                         }
                     }
                     catch (...)
@@ -2587,7 +3183,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(idx.get<int>());
                         if (index < mapSize)
                         {
-                            layer.noProjection[index] = true;
+                            layer.SetNoProjection(static_cast<int>(index % width), static_cast<int>(index / width), true);
                         }
                     }
                     catch (...)
@@ -2607,7 +3203,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(idx.get<int>());
                         if (index < mapSize)
                         {
-                            layer.ySortPlus[index] = true;
+                            layer.SetYSortPlus(static_cast<int>(index % width), static_cast<int>(index / width), true);
                         }
                     }
                     catch (...)
@@ -2626,7 +3222,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(idx.get<int>());
                         if (index < mapSize)
                         {
-                            layer.ySortMinus[index] = true;
+                            layer.SetYSortMinus(static_cast<int>(index % width), static_cast<int>(index / width), true);
                         }
                     }
                     catch (...)
@@ -2645,7 +3241,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
                         size_t index = static_cast<size_t>(std::stoi(key));
                         if (index < mapSize)
                         {
-                            layer.structureId[index] = value.get<int>();
+                            layer.SetStructureId(static_cast<int>(index % width), static_cast<int>(index / width), value.get<int>());
                         }
                     }
                     catch (...)
@@ -2668,6 +3264,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
 
     // Load Particle Zones
     m_ParticleZones.clear();
+    ++m_ParticleZoneRevision;
     if (j.contains("particleZones") && j["particleZones"].is_array())
     {
         for (const auto &zoneJson : j["particleZones"])
@@ -2689,23 +3286,7 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
     m_NoProjectionStructures.clear();
     if (j.contains("noProjectionStructures") && j["noProjectionStructures"].is_array())
     {
-        for (const auto &structJson : j["noProjectionStructures"])
-        {
-            NoProjectionStructure s;
-            s.id = structJson.value("id", static_cast<int>(m_NoProjectionStructures.size()));
-            s.name = structJson.value("name", "");
-            if (structJson.contains("leftAnchor") && structJson["leftAnchor"].is_array() && structJson["leftAnchor"].size() >= 2)
-            {
-                s.leftAnchor.x = structJson["leftAnchor"][0].get<float>();
-                s.leftAnchor.y = structJson["leftAnchor"][1].get<float>();
-            }
-            if (structJson.contains("rightAnchor") && structJson["rightAnchor"].is_array() && structJson["rightAnchor"].size() >= 2)
-            {
-                s.rightAnchor.x = structJson["rightAnchor"][0].get<float>();
-                s.rightAnchor.y = structJson["rightAnchor"][1].get<float>();
-            }
-            m_NoProjectionStructures.push_back(s);
-        }
+        ParseStructures(j["noProjectionStructures"], m_NoProjectionStructures);
         std::cout << "Loaded " << m_NoProjectionStructures.size() << " no-projection structures" << std::endl;
     }
 
@@ -2715,63 +3296,9 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
         npcs->clear();
         for (const auto &npcJson : j["npcs"])
         {
-            std::string type = npcJson.value("type", "");
-            int tileX = npcJson.value("tileX", 0);
-            int tileY = npcJson.value("tileY", 0);
-            std::string name = npcJson.value("name", "");
-            std::string dialogue = npcJson.value("dialogue", "");
-
-            if (!type.empty())
-            {
-                NonPlayerCharacter npc;
-                if (npc.Load("assets/non-player/" + type + ".png"))
-                {
-                    npc.SetTilePosition(tileX, tileY, tileWidth);
-                    if (!name.empty())
-                        npc.SetName(name);
-                    if (!dialogue.empty())
-                        npc.SetDialogue(dialogue);
-
-                    // Load dialogue tree (simplified format)
-                    if (npcJson.contains("dialogueTree") && npcJson["dialogueTree"].is_object())
-                    {
-                        const auto &treeJson = npcJson["dialogueTree"];
-                        DialogueTree tree;
-                        tree.id = treeJson.value("id", npc.GetType());
-                        tree.startNodeId = treeJson.value("start", "start");
-                        std::string defaultSpeaker = treeJson.value("speaker", npc.GetName());
-
-                        if (treeJson.contains("nodes") && treeJson["nodes"].is_object())
-                        {
-                            for (auto &[nodeId, nodeJson] : treeJson["nodes"].items())
-                            {
-                                DialogueNode node;
-                                node.id = nodeId;
-                                node.speaker = nodeJson.value("speaker", defaultSpeaker);
-                                node.text = nodeJson.value("text", "");
-
-                                if (nodeJson.contains("choices") && nodeJson["choices"].is_array())
-                                {
-                                    for (const auto &choiceJson : nodeJson["choices"])
-                                    {
-                                        DialogueOption opt;
-                                        opt.text = choiceJson.value("text", "");
-                                        opt.nextNodeId = choiceJson.value("goto", "");
-                                        opt.conditions = ParseConditionString(choiceJson.value("when", ""));
-                                        if (choiceJson.contains("do"))
-                                            opt.consequences = ParseConsequenceArray(choiceJson["do"]);
-                                        node.options.push_back(opt);
-                                    }
-                                }
-                                tree.nodes[node.id] = node;
-                            }
-                        }
-                        npc.SetDialogueTree(tree);
-                    }
-
-                    npcs->emplace_back(std::move(npc));
-                }
-            }
+            NonPlayerCharacter npc;
+            if (LoadNpc(npcJson, tileWidth, npc))
+                npcs->emplace_back(std::move(npc));
         }
         std::cout << "NPCs loaded: " << npcs->size() << std::endl;
     }
@@ -2791,20 +3318,18 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
     // Load animated tile definitions
     if (j.contains("animatedTiles") && j["animatedTiles"].is_array())
     {
-        m_AnimatedTiles.clear();
-        for (const auto &animJson : j["animatedTiles"])
-        {
-            AnimatedTile anim;
-            if (animJson.contains("frames") && animJson["frames"].is_array())
-            {
-                anim.frames = animJson["frames"].get<std::vector<int>>();
-            }
-            anim.frameDuration = animJson.value("frameDuration", 0.2f);
-            m_AnimatedTiles.push_back(anim);
-        }
+        ParseAnimatedTiles(j["animatedTiles"], m_AnimatedTiles);
         std::cout << "Loaded " << m_AnimatedTiles.size() << " animated tile definitions" << std::endl;
     }
 
+    // Load emissive tile definitions
+    m_TileLights.clear();
+    if (j.contains("tileLights") && j["tileLights"].is_array())
+    {
+        ParseTileLights(j["tileLights"], m_TileLights);
+    }
+    RebuildTileLightIndex();
+
     // Load per-layer animation maps (new format)
     size_t mapSize = static_cast<size_t>(m_MapWidth * m_MapHeight);
     if (j.contains("layerAnimationMaps") && j["layerAnimationMaps"].is_array())
@@ -2814,17 +3339,14 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
         {
             if (layerAnimMaps[layerIdx].is_object())
             {
-                auto &animMap = m_Layers[layerIdx].animationMap;
-                if (animMap.size() != mapSize)
-                {
-                    animMap.assign(mapSize, -1);
-                }
+                TileLayer &layer = m_Layers[layerIdx];
                 for (auto &[key, value] : layerAnimMaps[layerIdx].items())
                 {
                     size_t idx = static_cast<size_t>(std::stoi(key));
-                    if (idx < animMap.size())
+                    if (idx < mapSize)
                     {
-                        animMap[idx] = value.get<int>();
+                        layer.SetAnimation(static_cast<int>(idx % m_MapWidth), static_cast<int>(idx / m_MapWidth),
+                                           value.get<int>());
                     }
                 }
             }
@@ -2834,17 +3356,14 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
     // Backwards compatibility: load old "animationMap" format into layer 0
     else if (j.contains("animationMap") && j["animationMap"].is_object())
     {
-        auto &animMap = m_Layers[0].animationMap;
-        if (animMap.size() != mapSize)
-        {
-            animMap.assign(mapSize, -1);
-        }
+        TileLayer &layer = m_Layers[0];
         for (auto &[key, value] : j["animationMap"].items())
         {
             size_t idx = static_cast<size_t>(std::stoi(key));
-            if (idx < animMap.size())
+            if (idx < mapSize)
             {
-                animMap[idx] = value.get<int>();
+                layer.SetAnimation(static_cast<int>(idx % m_MapWidth), static_cast<int>(idx / m_MapWidth),
+                                   value.get<int>());
             }
         }
         std::cout << "Loaded animation map placements (legacy format -> layer 0)" << std::endl;
@@ -2873,11 +3392,11 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
     int animatedTileCount = 0;
     for (const auto &layer : m_Layers)
     {
-        for (int a : layer.animationMap)
+        layer.cells.ForEachNonEmpty([&](int, int, PackedTile cell)
         {
-            if (a >= 0)
+            if (cell.GetAnimation() >= 0)
                 animatedTileCount++;
-        }
+        });
     }
     std::cout << "[DEBUG] Animation state after load: "
               << m_AnimatedTiles.size() << " definitions, "
@@ -2892,3 +3411,949 @@ bool Tilemap::LoadMapFromJSON(const std::string &filename, std::vector<NonPlayer
     std::cout << "Map loaded from " << filename << " (" << width << "x" << height << ")" << std::endl;
     return true;
 }
+
+static_assert(ChunkedGrid<PackedTile>::CHUNK_CELLS == BINARY_MAP_CHUNK_CELLS, "Binary map chunks must match ChunkedGrid");
+static_assert(sizeof(PackedTile) == sizeof(uint32_t) && sizeof(int) == sizeof(int32_t));
+
+bool Tilemap::SaveMapToBinary(const std::string &filename, const std::vector<NonPlayerCharacter> *npcs,
+                              int playerTileX, int playerTileY, int characterType) const
+{
+    BinaryMapWriter writer;
+
+    // Tile layers: the non-empty chunks of each grid, verbatim
+    std::vector<BinaryMapLayer> layers;
+    std::vector<uint32_t> chunkIndex;
+    std::vector<uint32_t> chunkCells;
+    std::vector<uint32_t> structureIndex;
+    std::vector<int32_t> structureIds;
+    for (size_t li = 0; li < m_Layers.size(); ++li)
+    {
+        const TileLayer &layer = m_Layers[li];
+        layers.push_back({writer.AddString(layer.name), static_cast<uint32_t>(layer.name.size()),
+                          layer.renderOrder, layer.isBackground ? 1u : 0u});
+
+        chunkIndex.clear();
+        chunkCells.clear();
+        structureIndex.clear();
+        structureIds.clear();
+        const int chunksX = layer.cells.GetChunksX();
+        for (int cy = 0; cy < layer.cells.GetChunksY(); ++cy)
+        {
+            for (int cx = 0; cx < chunksX; ++cx)
+            {
+                const auto index = static_cast<uint32_t>(cy * chunksX + cx);
+                if (const auto *cells = layer.cells.GetChunk(cx, cy))
+                {
+                    chunkIndex.push_back(index);
+                    for (PackedTile cell : *cells)
+                        chunkCells.push_back(cell.bits);
+                }
+                if (const auto *ids = layer.structureIds.GetChunk(cx, cy))
+                {
+                    structureIndex.push_back(index);
+                    structureIds.insert(structureIds.end(), ids->begin(), ids->end());
+                }
+            }
+        }
+
+        const auto layerIndex = static_cast<uint32_t>(li);
+        writer.AddSection<uint32_t>(BinaryMapSectionType::LayerChunkIndex, layerIndex, chunkIndex);
+        writer.AddSection<uint32_t>(BinaryMapSectionType::LayerChunkCells, layerIndex, chunkCells);
+        if (!structureIndex.empty())
+        {
+            writer.AddSection<uint32_t>(BinaryMapSectionType::StructureChunkIndex, layerIndex, structureIndex);
+            writer.AddSection<int32_t>(BinaryMapSectionType::StructureChunkIds, layerIndex, structureIds);
+        }
+    }
+    writer.AddSection<BinaryMapLayer>(BinaryMapSectionType::Layers, 0, layers);
+
+    // Dense per-tile data; BitVector words already use the section bit order
+    writer.AddSection<uint64_t>(BinaryMapSectionType::Collision, 0, m_CollisionMap.GetData().Words());
+    writer.AddSection<uint64_t>(BinaryMapSectionType::Navigation, 0, m_NavigationMap.GetData().Words());
+    writer.AddSection<uint8_t>(BinaryMapSectionType::CornerCutBlocked, 0, m_CornerCutBlocked);
+    writer.AddBytes(BinaryMapSectionType::Elevation, 0, m_Elevation.data(), m_Elevation.size() * sizeof(int32_t));
+
+    std::vector<BinaryMapZone> zones;
+    for (const auto &zone : m_ParticleZones)
+    {
+        zones.push_back({zone.position.x, zone.position.y, zone.size.x, zone.size.y,
+                         static_cast<uint32_t>(zone.type), zone.enabled ? uint8_t(1) : uint8_t(0),
+                         zone.noProjection ? uint8_t(1) : uint8_t(0), {}});
+    }
+    writer.AddSection<BinaryMapZone>(BinaryMapSectionType::ParticleZones, 0, zones);
+
+    std::vector<BinaryMapStructure> structures;
+    for (const auto &s : m_NoProjectionStructures)
+    {
+        structures.push_back({s.id, s.leftAnchor.x, s.leftAnchor.y, s.rightAnchor.x, s.rightAnchor.y,
+                              writer.AddString(s.name), static_cast<uint32_t>(s.name.size())});
+    }
+    writer.AddSection<BinaryMapStructure>(BinaryMapSectionType::Structures, 0, structures);
+
+    std::vector<BinaryMapAnimation> animations;
+    std::vector<int32_t> frames;
+    for (const auto &anim : m_AnimatedTiles)
+    {
+        animations.push_back({anim.frameDuration, static_cast<uint32_t>(frames.size()),
+                              static_cast<uint32_t>(anim.frames.size())});
+        frames.insert(frames.end(), anim.frames.begin(), anim.frames.end());
+    }
+    writer.AddSection<BinaryMapAnimation>(BinaryMapSectionType::Animations, 0, animations);
+    writer.AddSection<int32_t>(BinaryMapSectionType::AnimationFrames, 0, frames);
+
+    // NPCs carry nested dialogue trees, so they stay JSON inside the binary file
+    if (npcs && !npcs->empty())
+    {
+        nlohmann::json npcsArr = nlohmann::json::array();
+        for (const auto &npc : *npcs)
+            npcsArr.push_back(SerializeNpc(npc));
+        const std::string text = npcsArr.dump();
+        writer.AddBytes(BinaryMapSectionType::Npcs, 0, text.data(), text.size());
+    }
+
+    BinaryMapHeader header{};
+    header.width = m_MapWidth;
+    header.height = m_MapHeight;
+    header.tileWidth = m_TileWidth;
+    header.tileHeight = m_TileHeight;
+    header.playerTileX = (playerTileX >= 0 && playerTileY >= 0) ? playerTileX : -1;
+    header.playerTileY = (playerTileX >= 0 && playerTileY >= 0) ? playerTileY : -1;
+    header.characterType = characterType;
+    if (!writer.Write(filename, header))
+    {
+        return false;
+    }
+
+    std::cout << "Map saved to " << filename << " (binary)" << std::endl;
+    return true;
+}
+
+bool Tilemap::LoadMapFromBinary(const std::string &filename, std::vector<NonPlayerCharacter> *npcs,
+                                int *playerTileX, int *playerTileY, int *characterType)
+{
+    BinaryMapView view;
+    if (!view.Open(filename))
+    {
+        return false;
+    }
+
+    ReleaseChunkMeshes();
+
+    const BinaryMapHeader &header = view.GetHeader();
+    m_TileWidth = header.tileWidth;
+    m_TileHeight = header.tileHeight;
+    SetTilemapSize(header.width, header.height, false);
+
+    auto layers = view.GetSection<BinaryMapLayer>(BinaryMapSectionType::Layers);
+    if (!layers.empty())
+    {
+        m_Layers.clear();
+        for (const BinaryMapLayer &info : layers)
+        {
+            m_Layers.emplace_back(std::string(view.GetString(info.nameOffset, info.nameLength)),
+                                  info.renderOrder, info.isBackground != 0);
+            m_Layers.back().resize(m_MapWidth, m_MapHeight);
+        }
+    }
+
+    // Copy each stored chunk straight out of the mapping
+    auto loadChunks = [&](auto &grid, std::span<const uint32_t> index, const auto *cells, size_t cellCount)
+    {
+        const size_t chunkCount = std::min(index.size(), cellCount / BINARY_MAP_CHUNK_CELLS);
+        const int chunksX = grid.GetChunksX();
+        for (size_t k = 0; k < chunkCount; ++k)
+        {
+            grid.SetChunk(static_cast<int>(index[k] % chunksX), static_cast<int>(index[k] / chunksX),
+                          cells + k * BINARY_MAP_CHUNK_CELLS);
+        }
+    };
+    for (size_t li = 0; li < m_Layers.size(); ++li)
+    {
+        const auto layerIndex = static_cast<uint32_t>(li);
+        TileLayer &layer = m_Layers[li];
+
+        auto cells = view.GetSection<PackedTile>(BinaryMapSectionType::LayerChunkCells, layerIndex);
+        loadChunks(layer.cells, view.GetSection<uint32_t>(BinaryMapSectionType::LayerChunkIndex, layerIndex),
+                   cells.data(), cells.size());
+
+        auto ids = view.GetSection<int32_t>(BinaryMapSectionType::StructureChunkIds, layerIndex);
+        loadChunks(layer.structureIds,
+                   view.GetSection<uint32_t>(BinaryMapSectionType::StructureChunkIndex, layerIndex),
+                   ids.data(), ids.size());
+    }
+
+    const size_t tileCount = static_cast<size_t>(m_MapWidth) * static_cast<size_t>(m_MapHeight);
+    BitVector<> bits;
+    bits.AssignWords(view.GetSection<uint64_t>(BinaryMapSectionType::Collision), tileCount);
+    m_CollisionMap.SetData(bits, m_MapWidth, m_MapHeight);
+    bits.AssignWords(view.GetSection<uint64_t>(BinaryMapSectionType::Navigation), tileCount);
+    m_NavigationMap.SetData(bits, m_MapWidth, m_MapHeight);
+    ResetNavigationHistory();
+
+    auto corners = view.GetSection<uint8_t>(BinaryMapSectionType::CornerCutBlocked);
+    std::copy_n(corners.begin(), std::min(corners.size(), tileCount), m_CornerCutBlocked.begin());
+    auto elevation = view.GetSection<int32_t>(BinaryMapSectionType::Elevation);
+    std::copy_n(elevation.begin(), std::min(elevation.size(), tileCount), m_Elevation.begin());
+
+    m_ParticleZones.clear();
+    ++m_ParticleZoneRevision;
+    for (const BinaryMapZone &z : view.GetSection<BinaryMapZone>(BinaryMapSectionType::ParticleZones))
+    {
+        ParticleZone zone(glm::vec2(z.x, z.y), glm::vec2(z.width, z.height), static_cast<ParticleType>(z.type));
+        zone.enabled = z.enabled != 0;
+        zone.noProjection = z.noProjection != 0;
+        m_ParticleZones.push_back(zone);
+    }
+
+    m_NoProjectionStructures.clear();
+    for (const BinaryMapStructure &s : view.GetSection<BinaryMapStructure>(BinaryMapSectionType::Structures))
+    {
+        m_NoProjectionStructures.emplace_back(s.id, glm::vec2(s.leftX, s.leftY), glm::vec2(s.rightX, s.rightY),
+                                              std::string(view.GetString(s.nameOffset, s.nameLength)));
+    }
+
+    m_AnimatedTiles.clear();
+    auto frames = view.GetSection<int32_t>(BinaryMapSectionType::AnimationFrames);
+    for (const BinaryMapAnimation &a : view.GetSection<BinaryMapAnimation>(BinaryMapSectionType::Animations))
+    {
+        if (uint64_t(a.firstFrame) + a.frameCount > frames.size())
+            continue;
+        auto animFrames = frames.subspan(a.firstFrame, a.frameCount);
+        m_AnimatedTiles.emplace_back(std::vector<int>(animFrames.begin(), animFrames.end()), a.frameDuration);
+    }
+
+    if (npcs)
+    {
+        npcs->clear();
+        auto text = view.GetSection<char>(BinaryMapSectionType::Npcs);
+        if (!text.empty())
+        {
+            try
+            {
+                for (const auto &npcJson : nlohmann::json::parse(text.begin(), text.end()))
+                {
+                    NonPlayerCharacter npc;
+                    if (LoadNpc(npcJson, m_TileWidth, npc))
+                        npcs->emplace_back(std::move(npc));
+                }
+            }
+            catch (const nlohmann::json::exception &e)
+            {
+                std::cerr << "ERROR: Invalid NPC data in " << filename << ": " << e.what() << std::endl;
+            }
+        }
+    }
+
+    if (playerTileX)
+        *playerTileX = header.playerTileX;
+    if (playerTileY)
+        *playerTileY = header.playerTileY;
+    if (characterType)
+        *characterType = header.characterType;
+
+    std::cout << "Map loaded from " << filename << " (" << m_MapWidth << "x" << m_MapHeight << ", binary)"
+              << std::endl;
+    return true;
+}
+
+bool Tilemap::ConvertMapFile(const std::string &source, const std::string &destination)
+{
+    auto isJson = [](const std::string &path) { return std::filesystem::path(path).extension() == ".json"; };
+
+    Tilemap tilemap;
+    std::vector<NonPlayerCharacter> npcs;
+    int playerTileX = -1;
+    int playerTileY = -1;
+    int characterType = -1;
+    bool loaded = isJson(source)
+                      ? tilemap.LoadMapFromJSON(source, &npcs, &playerTileX, &playerTileY, &characterType)
+                      : tilemap.LoadMapFromBinary(source, &npcs, &playerTileX, &playerTileY, &characterType);
+    if (!loaded)
+    {
+        std::cerr << "ERROR: Could not load " << source << " for conversion" << std::endl;
+        return false;
+    }
+
+    return isJson(destination)
+               ? tilemap.SaveMapToJSON(destination, &npcs, playerTileX, playerTileY, characterType)
+               : tilemap.SaveMapToBinary(destination, &npcs, playerTileX, playerTileY, characterType);
+}
+
+static void ComputeRegionBounds(int mapWidth, int mapHeight, int regionX, int regionY, int regionSize,
+                                int &x0, int &y0, int &width, int &height)
+{
+    x0 = regionX * regionSize;
+    y0 = regionY * regionSize;
+    width = std::clamp(mapWidth - x0, 0, regionSize);
+    height = std::clamp(mapHeight - y0, 0, regionSize);
+}
+
+// NPCs belong to the region that spawned them, wherever they walked to;
+// ones placed since the world was loaded belong to the region they stand in
+static bool NpcBelongsToRegion(const NonPlayerCharacter &npc, int regionX, int regionY,
+                               int x0, int y0, int x1, int y1)
+{
+    const glm::ivec2 home = npc.GetHomeRegion();
+    if (home.x >= 0)
+        return home == glm::ivec2(regionX, regionY);
+    return npc.GetTileX() >= x0 && npc.GetTileX() < x1 && npc.GetTileY() >= y0 && npc.GetTileY() < y1;
+}
+
+bool Tilemap::SaveWorldRegions(const std::string &directory, int regionSize,
+                               const std::vector<NonPlayerCharacter> *npcs,
+                               int playerTileX, int playerTileY, int characterType) const
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        std::cerr << "ERROR: Could not create world directory " << directory << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // Regions cover whole render chunks so loading one never splits a chunk mesh
+    WorldManifest manifest;
+    manifest.directory = directory;
+    manifest.regionSize = ((std::max(regionSize, 1) + CHUNK_SIZE - 1) / CHUNK_SIZE) * CHUNK_SIZE;
+    manifest.regionsX = (m_MapWidth + manifest.regionSize - 1) / manifest.regionSize;
+    manifest.regionsY = (m_MapHeight + manifest.regionSize - 1) / manifest.regionSize;
+    manifest.present.assign(static_cast<size_t>(manifest.regionsX) * manifest.regionsY, 0);
+
+    bool success = true;
+    int written = 0;
+    MapRegion region;
+    for (int ry = 0; ry < manifest.regionsY; ++ry)
+    {
+        for (int rx = 0; rx < manifest.regionsX; ++rx)
+        {
+            ExtractRegion(rx, ry, manifest.regionSize, npcs, region);
+            if (region.IsEmpty())
+                continue;
+
+            manifest.present[static_cast<size_t>(ry) * manifest.regionsX + rx] = 1;
+            success = region.Write(manifest.GetRegionPath(rx, ry)) && success;
+            written++;
+        }
+    }
+    success = SaveWorldManifest(manifest, playerTileX, playerTileY, characterType) && success;
+
+    std::cout << "World saved to " << directory << " (" << written << " of "
+              << manifest.regionsX * manifest.regionsY << " regions, "
+              << manifest.regionSize << "x" << manifest.regionSize << " tiles each)" << std::endl;
+    return success;
+}
+
+bool Tilemap::SaveWorldManifest(const WorldManifest &manifest, int playerTileX, int playerTileY,
+                                int characterType) const
+{
+    using json = nlohmann::json;
+
+    json j;
+    j["width"] = m_MapWidth;
+    j["height"] = m_MapHeight;
+    j["tileWidth"] = m_TileWidth;
+    j["tileHeight"] = m_TileHeight;
+    j["regionSize"] = manifest.regionSize;
+
+    // Layer definitions (content lives in the region files)
+    json layersArr = json::array();
+    for (const auto &layer : m_Layers)
+    {
+        json layerJson;
+        layerJson["name"] = layer.name;
+        layerJson["renderOrder"] = layer.renderOrder;
+        layerJson["isBackground"] = layer.isBackground;
+        layersArr.push_back(layerJson);
+    }
+    j["layers"] = layersArr;
+
+    j["animatedTiles"] = SerializeAnimatedTiles(m_AnimatedTiles);
+    j["tileLights"] = SerializeTileLights(m_TileLights);
+    j["noProjectionStructures"] = SerializeStructures(m_NoProjectionStructures);
+
+    if (playerTileX >= 0 && playerTileY >= 0)
+    {
+        json playerObj;
+        playerObj["tileX"] = playerTileX;
+        playerObj["tileY"] = playerTileY;
+        if (characterType >= 0)
+        {
+            playerObj["characterType"] = characterType;
+        }
+        j["player"] = playerObj;
+    }
+    else
+    {
+        j["player"] = nullptr;
+    }
+
+    // Non-empty regions as [regionX, regionY] pairs
+    json regionsArr = json::array();
+    for (int ry = 0; ry < manifest.regionsY; ++ry)
+    {
+        for (int rx = 0; rx < manifest.regionsX; ++rx)
+        {
+            if (manifest.HasRegion(rx, ry))
+                regionsArr.push_back({rx, ry});
+        }
+    }
+    j["regions"] = regionsArr;
+
+    std::ofstream file(manifest.GetManifestPath());
+    if (!file.is_open())
+    {
+        std::cerr << "ERROR: Could not open file for writing: " << manifest.GetManifestPath() << std::endl;
+        return false;
+    }
+    file << j.dump(2);
+    return file.good();
+}
+
+bool Tilemap::LoadWorldManifest(const std::string &directory, WorldManifest &manifest,
+                                int *playerTileX, int *playerTileY, int *characterType)
+{
+    using json = nlohmann::json;
+
+    manifest = WorldManifest();
+    manifest.directory = directory;
+
+    std::ifstream file(manifest.GetManifestPath());
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    json j;
+    try
+    {
+        file >> j;
+    }
+    catch (const json::parse_error &e)
+    {
+        std::cerr << "ERROR: Failed to parse JSON: " << e.what() << std::endl;
+        return false;
+    }
+
+    int width = j.value("width", 0);
+    int height = j.value("height", 0);
+    manifest.regionSize = j.value("regionSize", 0);
+    if (width <= 0 || height <= 0)
+    {
+        std::cerr << "ERROR: Invalid map dimensions in " << manifest.GetManifestPath() << std::endl;
+        return false;
+    }
+    if (manifest.regionSize <= 0 || manifest.regionSize % CHUNK_SIZE != 0)
+    {
+        std::cerr << "ERROR: Region size must be a positive multiple of " << CHUNK_SIZE << " in "
+                  << manifest.GetManifestPath() << std::endl;
+        return false;
+    }
+
+    ReleaseChunkMeshes();
+    m_TileWidth = j.value("tileWidth", 16);
+    m_TileHeight = j.value("tileHeight", 16);
+    SetTilemapSize(width, height, false);
+
+    if (j.contains("layers") && j["layers"].is_array())
+    {
+        m_Layers.clear();
+        for (const auto &layerJson : j["layers"])
+        {
+            m_Layers.emplace_back(layerJson.value("name", ""), layerJson.value("renderOrder", 0),
+                                  layerJson.value("isBackground", true));
+            m_Layers.back().resize(width, height);
+        }
+    }
+
+    m_ParticleZones.clear();
+    ++m_ParticleZoneRevision;
+    m_AnimatedTiles.clear();
+    if (j.contains("animatedTiles") && j["animatedTiles"].is_array())
+    {
+        ParseAnimatedTiles(j["animatedTiles"], m_AnimatedTiles);
+    }
+    m_TileLights.clear();
+    if (j.contains("tileLights") && j["tileLights"].is_array())
+    {
+        ParseTileLights(j["tileLights"], m_TileLights);
+    }
+    RebuildTileLightIndex();
+    m_NoProjectionStructures.clear();
+    if (j.contains("noProjectionStructures") && j["noProjectionStructures"].is_array())
+    {
+        ParseStructures(j["noProjectionStructures"], m_NoProjectionStructures);
+    }
+
+    if (j.contains("player") && !j["player"].is_null())
+    {
+        const auto &player = j["player"];
+        if (playerTileX)
+            *playerTileX = player.value("tileX", -1);
+        if (playerTileY)
+            *playerTileY = player.value("tileY", -1);
+        if (characterType)
+            *characterType = player.value("characterType", -1);
+    }
+
+    manifest.regionsX = (width + manifest.regionSize - 1) / manifest.regionSize;
+    manifest.regionsY = (height + manifest.regionSize - 1) / manifest.regionSize;
+    manifest.present.assign(static_cast<size_t>(manifest.regionsX) * manifest.regionsY, 0);
+    if (j.contains("regions") && j["regions"].is_array())
+    {
+        for (const auto &r : j["regions"])
+        {
+            if (!r.is_array() || r.size() < 2)
+                continue;
+            int rx = r[0].get<int>();
+            int ry = r[1].get<int>();
+            if (rx >= 0 && rx < manifest.regionsX && ry >= 0 && ry < manifest.regionsY)
+                manifest.present[static_cast<size_t>(ry) * manifest.regionsX + rx] = 1;
+        }
+    }
+
+    std::cout << "World manifest loaded from " << directory << " (" << width << "x" << height << ", "
+              << manifest.regionsX << "x" << manifest.regionsY << " regions)" << std::endl;
+    return true;
+}
+
+void Tilemap::ExtractRegion(int regionX, int regionY, int regionSize,
+                            const std::vector<NonPlayerCharacter> *npcs, MapRegion &out) const
+{
+    out = MapRegion();
+    out.regionX = regionX;
+    out.regionY = regionY;
+    ComputeRegionBounds(m_MapWidth, m_MapHeight, regionX, regionY, regionSize,
+                        out.originX, out.originY, out.width, out.height);
+    const int x0 = out.originX;
+    const int y0 = out.originY;
+    const int x1 = x0 + out.width;
+    const int y1 = y0 + out.height;
+    auto localIndex = [&](int x, int y)
+    {
+        return static_cast<uint32_t>((y - y0) * out.width + (x - x0));
+    };
+
+    out.layers.resize(m_Layers.size());
+    for (size_t li = 0; li < m_Layers.size(); ++li)
+    {
+        const TileLayer &layer = m_Layers[li];
+        MapRegion::Layer &dst = out.layers[li];
+        for (int y = y0; y < y1; ++y)
+        {
+            for (int x = x0; x < x1; ++x)
+            {
+                const PackedTile cell = layer.GetCell(x, y);
+                if (cell.bits != 0)
+                    dst.cells.emplace_back(localIndex(x, y), cell.bits);
+                const int structId = layer.GetStructureId(x, y);
+                if (structId >= 0)
+                    dst.structureIds.emplace_back(localIndex(x, y), structId);
+            }
+        }
+    }
+
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            const uint32_t index = localIndex(x, y);
+            if (GetTileCollision(x, y))
+                out.collision.push_back(index);
+            if (GetNavigation(x, y))
+                out.navigation.push_back(index);
+            if (int elev = GetElevation(x, y))
+                out.elevation.emplace_back(index, elev);
+            if (uint8_t mask = m_CornerCutBlocked[static_cast<size_t>(y) * m_MapWidth + x])
+                out.cornerCutBlocked.emplace_back(index, mask);
+        }
+    }
+
+    // Zones belong to the region holding their top-left corner
+    for (const auto &zone : m_ParticleZones)
+    {
+        int tileX = static_cast<int>(std::floor(zone.position.x / m_TileWidth));
+        int tileY = static_cast<int>(std::floor(zone.position.y / m_TileHeight));
+        if (tileX >= x0 && tileX < x1 && tileY >= y0 && tileY < y1)
+            out.particleZones.push_back(zone);
+    }
+
+    if (npcs)
+    {
+        nlohmann::json npcsArr = nlohmann::json::array();
+        for (const auto &npc : *npcs)
+        {
+            if (NpcBelongsToRegion(npc, regionX, regionY, x0, y0, x1, y1))
+                npcsArr.push_back(SerializeNpc(npc));
+        }
+        if (!npcsArr.empty())
+            out.npcs = npcsArr.dump();
+    }
+}
+
+void Tilemap::ApplyRegion(const MapRegion &region, std::vector<NonPlayerCharacter> *npcs)
+{
+    const size_t cellCount = static_cast<size_t>(region.width) * static_cast<size_t>(region.height);
+    auto toWorld = [&](uint32_t index, int &x, int &y)
+    {
+        if (index >= cellCount)
+            return false;
+        x = region.originX + static_cast<int>(index % region.width);
+        y = region.originY + static_cast<int>(index / region.width);
+        return x < m_MapWidth && y < m_MapHeight;
+    };
+
+    int x, y;
+    const size_t layerCount = std::min(region.layers.size(), m_Layers.size());
+    for (size_t li = 0; li < layerCount; ++li)
+    {
+        TileLayer &layer = m_Layers[li];
+        for (const auto &[index, bits] : region.layers[li].cells)
+        {
+            if (toWorld(index, x, y))
+                layer.cells.Set(x, y, PackedTile{bits});
+        }
+        for (const auto &[index, structId] : region.layers[li].structureIds)
+        {
+            if (toWorld(index, x, y))
+                layer.SetStructureId(x, y, structId);
+        }
+    }
+
+    for (uint32_t index : region.collision)
+    {
+        if (toWorld(index, x, y))
+            SetTileCollision(x, y, true);
+    }
+    for (uint32_t index : region.navigation)
+    {
+        if (toWorld(index, x, y))
+            SetNavigation(x, y, true);
+    }
+    for (const auto &[index, elev] : region.elevation)
+    {
+        if (toWorld(index, x, y))
+            SetElevation(x, y, elev);
+    }
+    for (const auto &[index, mask] : region.cornerCutBlocked)
+    {
+        if (toWorld(index, x, y))
+            m_CornerCutBlocked[static_cast<size_t>(y) * m_MapWidth + x] = mask;
+    }
+
+    m_ParticleZones.insert(m_ParticleZones.end(), region.particleZones.begin(), region.particleZones.end());
+    ++m_ParticleZoneRevision;
+    MarkDerivedDataDirty();
+
+    if (npcs && !region.npcs.empty())
+    {
+        try
+        {
+            for (const auto &npcJson : nlohmann::json::parse(region.npcs))
+            {
+                NonPlayerCharacter npc;
+                if (LoadNpc(npcJson, m_TileWidth, npc))
+                {
+                    npc.SetHomeRegion(glm::ivec2(region.regionX, region.regionY));
+                    npcs->emplace_back(std::move(npc));
+                }
+            }
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            std::cerr << "ERROR: Invalid NPC data in region (" << region.regionX << ", " << region.regionY
+                      << "): " << e.what() << std::endl;
+        }
+    }
+
+    MarkRectDirty(region.originX, region.originY, region.width, region.height);
+}
+
+void Tilemap::UnloadRegion(int regionX, int regionY, int regionSize,
+                           std::vector<NonPlayerCharacter> *npcs, std::vector<int> *removedZones)
+{
+    int x0, y0, width, height;
+    ComputeRegionBounds(m_MapWidth, m_MapHeight, regionX, regionY, regionSize, x0, y0, width, height);
+    const int x1 = x0 + width;
+    const int y1 = y0 + height;
+
+    // Clearing cells releases their chunks, so an evicted region costs no tile memory
+    for (size_t li = 0; li < m_Layers.size(); ++li)
+        FillLayerRect(li, x0, y0, width, height, PackedTile{});
+    FillCollisionRect(x0, y0, width, height, false);
+    FillNavigationRect(x0, y0, width, height, false);
+    FillElevationRect(x0, y0, width, height, 0);
+    for (int y = y0; y < y1; ++y)
+        std::fill_n(m_CornerCutBlocked.begin() + static_cast<std::ptrdiff_t>(y) * m_MapWidth + x0, width, uint8_t{0});
+
+    // Walk backwards so reported indices stay valid for OnZoneRemoved() calls in order
+    for (int i = static_cast<int>(m_ParticleZones.size()) - 1; i >= 0; --i)
+    {
+        const ParticleZone &zone = m_ParticleZones[i];
+        int tileX = static_cast<int>(std::floor(zone.position.x / m_TileWidth));
+        int tileY = static_cast<int>(std::floor(zone.position.y / m_TileHeight));
+        if (tileX >= x0 && tileX < x1 && tileY >= y0 && tileY < y1)
+        {
+            m_ParticleZones.erase(m_ParticleZones.begin() + i);
+            ++m_ParticleZoneRevision;
+            if (removedZones)
+                removedZones->push_back(i);
+        }
+    }
+
+    if (npcs)
+    {
+        std::erase_if(*npcs, [&](const NonPlayerCharacter &npc)
+                      { return NpcBelongsToRegion(npc, regionX, regionY, x0, y0, x1, y1); });
+    }
+}
+
+uint64_t Tilemap::GetRegionRevision(int regionX, int regionY, int regionSize) const
+{
+    // Regions are whole chunks, so no revision block straddles two of them
+    static_assert(CHUNK_SIZE % REVISION_BLOCK_SIZE == 0);
+
+    int x0, y0, width, height;
+    ComputeRegionBounds(m_MapWidth, m_MapHeight, regionX, regionY, regionSize, x0, y0, width, height);
+    uint64_t revision = 0;
+    for (int by = y0 / REVISION_BLOCK_SIZE; by * REVISION_BLOCK_SIZE < y0 + height; ++by)
+    {
+        for (int bx = x0 / REVISION_BLOCK_SIZE; bx * REVISION_BLOCK_SIZE < x0 + width; ++bx)
+            revision = std::max(revision, GetBlockRevision(bx, by));
+    }
+    return revision;
+}
+
+void Tilemap::BeginBulkEdit()
+{
+    if (m_BulkEditDepth++ == 0)
+        m_BulkEditUpdates = 0;
+}
+
+void Tilemap::EndBulkEdit()
+{
+    if (m_BulkEditDepth > 0)
+        --m_BulkEditDepth;
+}
+
+bool Tilemap::DeferToBulkRebuild()
+{
+    if (m_BulkEditDepth == 0 || ++m_BulkEditUpdates <= BULK_EDIT_INCREMENTAL_UPDATES)
+        return false;
+
+    // One rebuild on next use now beats thousands more incremental updates
+    MarkDerivedDataDirty();
+    return true;
+}
+
+bool Tilemap::ClipToMap(int &x, int &y, int &width, int &height) const
+{
+    const int x1 = std::min(x + width, m_MapWidth);
+    const int y1 = std::min(y + height, m_MapHeight);
+    x = std::max(x, 0);
+    y = std::max(y, 0);
+    width = x1 - x;
+    height = y1 - y;
+    return width > 0 && height > 0;
+}
+
+void Tilemap::MarkRectDirty(int x, int y, int width, int height)
+{
+    if (!ClipToMap(x, y, width, height))
+        return;
+    for (int cy = y - y % CHUNK_SIZE; cy < y + height; cy += CHUNK_SIZE)
+    {
+        for (int cx = x - x % CHUNK_SIZE; cx < x + width; cx += CHUNK_SIZE)
+        {
+            MarkChunkDirty(cx, cy);
+        }
+    }
+}
+
+void Tilemap::StampRect(int x, int y, int width, int height)
+{
+    if (!ClipToMap(x, y, width, height))
+        return;
+    for (int by = y - y % REVISION_BLOCK_SIZE; by < y + height; by += REVISION_BLOCK_SIZE)
+    {
+        for (int bx = x - x % REVISION_BLOCK_SIZE; bx < x + width; bx += REVISION_BLOCK_SIZE)
+        {
+            StampBlock(bx, by);
+        }
+    }
+}
+
+void Tilemap::ForEachRowBand(int y, int width, int height, const std::function<void(int, int)> &fn)
+{
+    // Bands are lock-free only because each covers whole rows of layer chunks,
+    // so their height comes from the grid rather than the mesh cache's CHUNK_SIZE
+    constexpr int BAND_ROWS = ChunkedGrid<PackedTile>::CHUNK_SIZE;
+    static_assert(BAND_ROWS == ChunkedGrid<int32_t, -1>::CHUNK_SIZE, "Structure IDs must share the cell chunking");
+
+    const int firstBand = y / BAND_ROWS;
+    const size_t bandCount = static_cast<size_t>((y + height - 1) / BAND_ROWS - firstBand + 1);
+    auto runBands = [&](size_t begin, size_t end)
+    {
+        for (size_t band = begin; band < end; ++band)
+        {
+            const int bandY = (firstBand + static_cast<int>(band)) * BAND_ROWS;
+            fn(std::max(y, bandY), std::min(y + height, bandY + BAND_ROWS));
+        }
+    };
+
+    const size_t cells = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (m_Jobs && m_Jobs->GetWorkerCount() > 0 && bandCount > 1 && cells >= PARALLEL_EDIT_MIN_CELLS)
+        m_Jobs->ParallelFor(bandCount, 1, runBands);
+    else
+        runBands(0, bandCount);
+}
+
+void Tilemap::FillLayerRect(size_t layerIdx, int x, int y, int width, int height, PackedTile cell, int structureId)
+{
+    WILD_PROFILE_ZONE("Tilemap Fill Rect");
+    if (layerIdx >= m_Layers.size() || !ClipToMap(x, y, width, height))
+        return;
+
+    TileLayer &layer = m_Layers[layerIdx];
+    ForEachRowBand(y, width, height, [&](int rowBegin, int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            layer.cells.FillSpan(row, x, x + width, cell);
+            layer.structureIds.FillSpan(row, x, x + width, structureId);
+        }
+    });
+
+    MarkDerivedDataDirty();
+    MarkRectDirty(x, y, width, height);
+}
+
+void Tilemap::CopyLayerRect(size_t srcLayer, int srcX, int srcY, size_t dstLayer, int dstX, int dstY,
+                            int width, int height)
+{
+    WILD_PROFILE_ZONE("Tilemap Copy Rect");
+    if (srcLayer >= m_Layers.size() || dstLayer >= m_Layers.size())
+        return;
+
+    // Clip the destination and move the source corner along with it
+    int x = dstX, y = dstY;
+    if (!ClipToMap(x, y, width, height))
+        return;
+    srcX += x - dstX;
+    srcY += y - dstY;
+
+    const TileLayer &source = m_Layers[srcLayer];
+    TileLayer &target = m_Layers[dstLayer];
+    const size_t stride = static_cast<size_t>(width);
+    std::vector<PackedTile> cells(stride * static_cast<size_t>(height));
+    std::vector<int32_t> structureIds(cells.size());
+
+    // Stage the whole source first so overlapping rectangles copy correctly
+    ForEachRowBand(y, width, height, [&](int rowBegin, int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            const size_t offset = static_cast<size_t>(row - y) * stride;
+            source.cells.ReadSpan(srcY + row - y, srcX, srcX + width, cells.data() + offset);
+            source.structureIds.ReadSpan(srcY + row - y, srcX, srcX + width, structureIds.data() + offset);
+        }
+    });
+    ForEachRowBand(y, width, height, [&](int rowBegin, int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            const size_t offset = static_cast<size_t>(row - y) * stride;
+            target.cells.WriteSpan(row, x, x + width, cells.data() + offset);
+            target.structureIds.WriteSpan(row, x, x + width, structureIds.data() + offset);
+        }
+    });
+
+    MarkDerivedDataDirty();
+    MarkRectDirty(x, y, width, height);
+}
+
+void Tilemap::FillCollisionRect(int x, int y, int width, int height, bool hasCollision)
+{
+    if (!ClipToMap(x, y, width, height))
+        return;
+
+    // Bit-packed rows share words across cells, so this stays on one thread
+    const bool recordChanges = static_cast<size_t>(width) * static_cast<size_t>(height) <= NAVIGATION_HISTORY_LIMIT;
+    bool changed = false;
+    for (int row = y; row < y + height; ++row)
+    {
+        for (int col = x; col < x + width; ++col)
+        {
+            if (m_CollisionMap.HasCollision(col, row) == hasCollision)
+                continue;
+            m_CollisionMap.SetCollision(col, row, hasCollision);
+            changed = true;
+            if (recordChanges)
+                RecordNavigationChange(col, row);
+        }
+    }
+
+    if (!changed)
+        return;
+    if (!recordChanges)
+        ResetNavigationHistory();
+    StampRect(x, y, width, height);
+}
+
+void Tilemap::FillNavigationRect(int x, int y, int width, int height, bool walkable)
+{
+    if (!ClipToMap(x, y, width, height))
+        return;
+
+    const bool recordChanges = static_cast<size_t>(width) * static_cast<size_t>(height) <= NAVIGATION_HISTORY_LIMIT;
+    bool changed = false;
+    for (int row = y; row < y + height; ++row)
+    {
+        for (int col = x; col < x + width; ++col)
+        {
+            if (m_NavigationMap.GetNavigation(col, row) == walkable)
+                continue;
+            m_NavigationMap.SetNavigation(col, row, walkable);
+            changed = true;
+            if (recordChanges)
+                RecordNavigationChange(col, row);
+        }
+    }
+
+    if (!changed)
+        return;
+    if (!recordChanges)
+        ResetNavigationHistory();
+    StampRect(x, y, width, height);
+}
+
+void Tilemap::FillElevationRect(int x, int y, int width, int height, int elevation)
+{
+    if (!ClipToMap(x, y, width, height) || m_Elevation.size() < static_cast<size_t>(m_MapWidth) * m_MapHeight)
+        return;
+
+    ForEachRowBand(y, width, height, [&](int rowBegin, int rowEnd)
+    {
+        for (int row = rowBegin; row < rowEnd; ++row)
+            std::fill_n(m_Elevation.begin() + static_cast<std::ptrdiff_t>(row) * m_MapWidth + x, width, elevation);
+    });
+    StampRect(x, y, width, height);
+}
+
+size_t Tilemap::GetMemoryBytes() const
+{
+    size_t bytes = MemoryTracker::CapacityBytes(m_Layers, m_Elevation, m_CornerCutBlocked, m_NavigationHistory,
+                                                m_Chunks, m_YSortRows, m_StructureIndex, m_BlockRevisions);
+    for (const TileLayer &layer : m_Layers)
+        bytes += layer.cells.GetMemoryBytes() + layer.structureIds.GetMemoryBytes();
+    for (const auto &occluders : m_Occluders)
+        bytes += occluders.GetMemoryBytes();
+    for (const TileChunk &chunk : m_Chunks)
+    {
+        for (int group = 0; group < 2; ++group)
+            bytes += MemoryTracker::CapacityBytes(chunk.animatedCells[group], chunk.animatedQuads[group]);
+    }
+    for (const auto &row : m_YSortRows)
+        bytes += MemoryTracker::CapacityBytes(row);
+    bytes += m_CollisionMap.GetData().Words().size_bytes() + m_NavigationMap.GetData().Words().size_bytes();
+    return bytes;
+}
@@ -5,16 +5,26 @@
 #include "CollisionMap.h"
 #include "NavigationMap.h"
 #include "ColumnProxy.h"
+#include "ChunkedGrid.h"
+#include "MapRegion.h"
 #include "ParticleSystem.h"
+#include "FrameArena.h"
 
+#include <array>
+#include <climits>
+#include <functional>
+#include <span>
 #include <vector>
 #include <string>
+#include <tuple>
 #include <iostream>
 #include <cstdint>
+#include <cmath>
 #include <glm/glm.hpp>
 
 // Forward declaration
 class NonPlayerCharacter;
+class JobSystem;
 
 /**
  * @struct Tile
@@ -51,49 +61,171 @@ struct NoProjectionStructure
         : id(structId), name(n), leftAnchor(left), rightAnchor(right) {}
 };
 
+/**
+ * @struct PackedTile
+ * @brief One tile layer cell packed into 32 bits.
+ * @author Alex (https://github.com/lextpf)
+ *
+ * Everything the render loops read per tile sits in one word, so a cell
+ * costs 4 bytes and one load instead of seven parallel arrays.
+ *
+ * | Bits  | Field        | Encoding                                  |
+ * |-------|--------------|-------------------------------------------|
+ * | 0-15  | Tile ID      | ID + 1, 0 = empty (IDs 0..MAX_TILE_ID)    |
+ * | 16-17 | Rotation     | Quarter turns clockwise (0, 90, 180, 270) |
+ * | 18    | noProjection | Bypass 3D projection                      |
+ * | 19    | ySortPlus    | Sort with entities by Y                   |
+ * | 20    | ySortMinus   | Player renders behind at the same Y       |
+ * | 21-31 | Animation    | ID + 1, 0 = not animated                  |
+ *
+ * The all-zero word is an empty, unflagged, unrotated cell.
+ */
+struct PackedTile
+{
+    uint32_t bits = 0;  ///< Packed fields, see table above
+
+    static constexpr int MAX_TILE_ID = 0xFFFE;           ///< Largest storable tile ID
+    static constexpr int MAX_ANIMATION_ID = (1 << 11) - 2;  ///< Largest storable animation ID
+    static constexpr uint32_t NO_PROJECTION_BIT = 1u << 18;
+    static constexpr uint32_t Y_SORT_PLUS_BIT = 1u << 19;
+    static constexpr uint32_t Y_SORT_MINUS_BIT = 1u << 20;
+
+    int GetTileId() const { return static_cast<int>(bits & TILE_MASK) - 1; }
+    int GetRotationQuadrant() const { return static_cast<int>((bits >> ROTATION_SHIFT) & 3u); }
+    float GetRotation() const { return 90.0f * static_cast<float>(GetRotationQuadrant()); }
+    bool IsNoProjection() const { return (bits & NO_PROJECTION_BIT) != 0; }
+    bool IsYSortPlus() const { return (bits & Y_SORT_PLUS_BIT) != 0; }
+    bool IsYSortMinus() const { return (bits & Y_SORT_MINUS_BIT) != 0; }
+    int GetAnimation() const { return static_cast<int>(bits >> ANIMATION_SHIFT) - 1; }
+
+    /// Store a tile ID; negative or out-of-range IDs store an empty tile
+    void SetTileId(int tileID)
+    {
+        uint32_t field = (tileID >= 0 && tileID <= MAX_TILE_ID) ? static_cast<uint32_t>(tileID + 1) : 0u;
+        bits = (bits & ~TILE_MASK) | field;
+    }
+
+    /// Store a rotation, rounded to the nearest quarter turn (any multiple of 360 wraps)
+    void SetRotation(float degrees)
+    {
+        int quadrant = static_cast<int>(std::lround(degrees / 90.0f)) % 4;
+        if (quadrant < 0)
+            quadrant += 4;
+        bits = (bits & ~(3u << ROTATION_SHIFT)) | (static_cast<uint32_t>(quadrant) << ROTATION_SHIFT);
+    }
+
+    void SetFlag(uint32_t flagBit, bool value) { bits = value ? (bits | flagBit) : (bits & ~flagBit); }
+
+    /// Store an animation ID; negative or out-of-range IDs clear it
+    void SetAnimation(int animId)
+    {
+        uint32_t field = (animId >= 0 && animId <= MAX_ANIMATION_ID) ? static_cast<uint32_t>(animId + 1) : 0u;
+        bits = (bits & ((1u << ANIMATION_SHIFT) - 1u)) | (field << ANIMATION_SHIFT);
+    }
+
+    friend constexpr bool operator==(PackedTile, PackedTile) = default;
+
+    static constexpr uint32_t TILE_MASK = 0xFFFFu;
+    static constexpr int ROTATION_SHIFT = 16;
+    static constexpr int ANIMATION_SHIFT = 21;
+};
+static_assert(sizeof(PackedTile) == 4, "PackedTile must stay one 32-bit word");
+
 /**
  * @struct TileLayer
  * @brief Represents a single tile layer with all associated data.
  * @author Alex (https://github.com/lextpf)
  *
- * Each layer contains tile IDs, rotation values, and per-tile flags.
+ * Each layer contains tile IDs, rotation values, and per-tile flags, packed
+ * per cell into a sparse chunked grid (see PackedTile, ChunkedGrid).
  * Layers are rendered in order based on their renderOrder value.
+ *
+ * @par Memory
+ * Only 32x32 chunks holding at least one non-empty cell are allocated
+ * (4 KB each), so memory tracks content: a 2048x2048 map with 10 layers
+ * costs at most 160 MB fully painted, and a few MB when mostly empty.
+ * Structure IDs are rare and live in their own sparse grid.
  */
 struct TileLayer
 {
-    std::string name;                  ///< Human-readable layer name
-    std::vector<int> tiles;            ///< Tile IDs in row-major order (-1 = empty)
-    std::vector<float> rotation;       ///< Rotation in degrees per tile
-    std::vector<bool> noProjection;    ///< Tiles that bypass 3D projection
-    std::vector<int> structureId;      ///< Per-tile structure ID (-1 = auto flood-fill, 0+ = belongs to structure)
-    std::vector<bool> ySortPlus;       ///< Tiles that sort with entities by Y position (Y-sort+1: player in front at same Y)
-    std::vector<bool> ySortMinus;      ///< When true, player renders behind tile at same Y (Y-sort-1: tile in front)
-    std::vector<int> animationMap;     ///< Per-tile animation ID (-1 = not animated)
-    int renderOrder;                   ///< Lower = rendered first (background), higher = later (foreground)
-    bool isBackground;                 ///< true = before player/NPCs, false = after
+    std::string name;                       ///< Human-readable layer name
+    ChunkedGrid<PackedTile> cells;          ///< Tile ID, rotation, flags and animation per tile
+    ChunkedGrid<int32_t, -1> structureIds;  ///< Per-tile structure ID (-1 = auto flood-fill, 0+ = belongs to structure)
+    int renderOrder;                        ///< Lower = rendered first (background), higher = later (foreground)
+    bool isBackground;                      ///< true = before player/NPCs, false = after
 
     TileLayer() : renderOrder(0), isBackground(true) {}
     TileLayer(const std::string& n, int order, bool bg)
         : name(n), renderOrder(order), isBackground(bg) {}
 
-    void resize(size_t size) {
-        tiles.resize(size, -1);
-        rotation.resize(size, 0.0f);
-        noProjection.resize(size, false);
-        structureId.resize(size, -1);
-        ySortPlus.resize(size, false);
-        ySortMinus.resize(size, false);
-        animationMap.resize(size, -1);
+    /// Resize to width x height tiles, clearing all data
+    void resize(int width, int height) {
+        cells.Resize(width, height);
+        structureIds.Resize(width, height);
     }
 
+    /// Clear all data, keeping the dimensions
     void clear() {
-        std::fill(tiles.begin(), tiles.end(), -1);
-        std::fill(rotation.begin(), rotation.end(), 0.0f);
-        std::fill(noProjection.begin(), noProjection.end(), false);
-        std::fill(structureId.begin(), structureId.end(), -1);
-        std::fill(ySortPlus.begin(), ySortPlus.end(), false);
-        std::fill(ySortMinus.begin(), ySortMinus.end(), false);
-        std::fill(animationMap.begin(), animationMap.end(), -1);
+        cells.Clear();
+        structureIds.Clear();
+    }
+
+    /// @name Per-Tile Access (out-of-bounds reads return empty values, writes are ignored)
+    /// @{
+    PackedTile GetCell(int x, int y) const { return cells.Get(x, y); }
+    int GetTile(int x, int y) const { return cells.Get(x, y).GetTileId(); }
+    float GetRotation(int x, int y) const { return cells.Get(x, y).GetRotation(); }
+    bool GetNoProjection(int x, int y) const { return cells.Get(x, y).IsNoProjection(); }
+    bool GetYSortPlus(int x, int y) const { return cells.Get(x, y).IsYSortPlus(); }
+    bool GetYSortMinus(int x, int y) const { return cells.Get(x, y).IsYSortMinus(); }
+    int GetAnimation(int x, int y) const { return cells.Get(x, y).GetAnimation(); }
+    int GetStructureId(int x, int y) const { return structureIds.Get(x, y); }
+
+    void SetTile(int x, int y, int tileID) { UpdateCell(x, y, [=](PackedTile &c) { c.SetTileId(tileID); }); }
+    void SetRotation(int x, int y, float degrees) { UpdateCell(x, y, [=](PackedTile &c) { c.SetRotation(degrees); }); }
+    void SetNoProjection(int x, int y, bool v) { UpdateCell(x, y, [=](PackedTile &c) { c.SetFlag(PackedTile::NO_PROJECTION_BIT, v); }); }
+    void SetYSortPlus(int x, int y, bool v) { UpdateCell(x, y, [=](PackedTile &c) { c.SetFlag(PackedTile::Y_SORT_PLUS_BIT, v); }); }
+    void SetYSortMinus(int x, int y, bool v) { UpdateCell(x, y, [=](PackedTile &c) { c.SetFlag(PackedTile::Y_SORT_MINUS_BIT, v); }); }
+    void SetAnimation(int x, int y, int animId) { UpdateCell(x, y, [=](PackedTile &c) { c.SetAnimation(animId); }); }
+    void SetStructureId(int x, int y, int structId) { structureIds.Set(x, y, structId); }
+    /// @}
+
+    /// @name Flat Tile ID Access
+    /// Row-major tile IDs (index = y * width + x), for ColumnProxy.
+    /// @{
+    class TileRef
+    {
+    public:
+        TileRef(TileLayer &layer, size_t index) : m_Layer(layer), m_Index(index) {}
+        TileRef &operator=(int tileID)
+        {
+            const int width = m_Layer.cells.GetWidth();
+            m_Layer.SetTile(static_cast<int>(m_Index % width), static_cast<int>(m_Index / width), tileID);
+            return *this;
+        }
+        operator int() const { return static_cast<const TileLayer &>(m_Layer)[m_Index]; }
+
+    private:
+        TileLayer &m_Layer;
+        size_t m_Index;
+    };
+
+    size_t size() const { return static_cast<size_t>(cells.GetWidth()) * static_cast<size_t>(cells.GetHeight()); }
+    int operator[](size_t index) const
+    {
+        const int width = cells.GetWidth();
+        return width > 0 ? GetTile(static_cast<int>(index % width), static_cast<int>(index / width)) : -1;
+    }
+    TileRef operator[](size_t index) { return TileRef(*this, index); }
+    /// @}
+
+private:
+    template<typename Fn>
+    void UpdateCell(int x, int y, Fn &&fn)
+    {
+        PackedTile cell = cells.Get(x, y);
+        fn(cell);
+        cells.Set(x, y, cell);
     }
 };
 
@@ -120,6 +252,18 @@ struct AnimatedTile
     }
 };
 
+/**
+ * @struct TileLight
+ * @brief Light given off by every cell showing a tile (torches, windows, lava).
+ * @author Alex (https://github.com/lextpf)
+ */
+struct TileLight
+{
+    int tileId;         ///< Tileset tile ID
+    glm::vec3 color;    ///< Light added at the tile center
+    float radius;       ///< Reach in pixels
+};
+
 /**
  * @class Tilemap
  * @brief Multi-layer tile-based world with collision and navigation.
@@ -248,6 +392,19 @@ struct AnimatedTile
  * @endcode
  *
  * This significantly reduces file size for large, sparse maps.
+ *
+ * @par Bulk Edits
+ * Per-cell setters refresh the derived data (Y-sort index, structure index,
+ * occluders, animated cells, chunk meshes) incrementally, which adds up
+ * over a flood fill of thousands of cells. Edits inside BeginBulkEdit() /
+ * EndBulkEdit() fall back to one lazy rebuild once they grow large, and
+ * the rectangle operations (FillLayerRect(), CopyLayerRect(), ...) write
+ * whole rows, split into chunk bands across the JobSystem:
+ * @code
+ *   rows  0..31  -> worker 0      each band only touches its own row of
+ *   rows 32..63  -> worker 1      chunks, so bands never share a chunk
+ *   rows 64..95  -> worker 2
+ * @endcode
  * 
  * @see CollisionMap, NavigationMap, ColumnProxy
  */
@@ -276,6 +433,35 @@ public:
      */
     bool LoadCombinedTilesets(const std::vector<std::string> &paths, int tileWidth = 16, int tileHeight = 16);
 
+    /**
+     * @brief Find the tileset loaded from @p path.
+     *
+     * Paths are compared after making them absolute, so "assets/x.png"
+     * and "../build/../assets/x.png" name the same file.
+     *
+     * @return Index into the last LoadCombinedTilesets() list, or -1.
+     */
+    int FindTileset(const std::string &path) const;
+
+    /**
+     * @brief Replace one tileset's pixels in place after its file changed.
+     *
+     * Rewrites that tileset's rows of the combined texture's CPU copy,
+     * uploads just that rectangle (IRenderer::UpdateTextureRegion(), or a
+     * full re-upload where the backend cannot patch) and re-checks the
+     * transparency of the tile IDs it covers. Chunks are rebuilt only if a
+     * tile became empty or stopped being empty.
+     *
+     * @param index    Tileset index from FindTileset().
+     * @param pixels   Decoded image, top row first (not flipped).
+     * @param width, height, channels Its layout; must match the loaded tileset.
+     * @param renderer Renderer the texture was uploaded to, or nullptr.
+     * @return False if the image no longer fits its slot. A tileset's size
+     *         decides the IDs of every tile after it, so that takes a restart.
+     */
+    bool PatchTileset(int index, const unsigned char *pixels, int width, int height, int channels,
+                      IRenderer *renderer);
+
     /**
      * @brief Set the tilemap dimensions.
      * 
@@ -332,6 +518,18 @@ public:
      * @return true if corner cutting is blocked at this corner.
      */
     bool IsCornerCutBlocked(int x, int y, Corner corner) const;
+
+    /**
+     * @brief All four corner-cut flags of a tile in one read.
+     * @return Bit `1 << Corner` set per blocked corner; 0 out of bounds.
+     */
+    uint8_t GetCornerCutMask(int x, int y) const
+    {
+        if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight)
+            return 0;
+        const size_t idx = static_cast<size_t>(y) * static_cast<size_t>(m_MapWidth) + static_cast<size_t>(x);
+        return idx < m_CornerCutBlocked.size() ? m_CornerCutBlocked[idx] : 0;
+    }
     /** @} */
 
     /**
@@ -369,13 +567,13 @@ public:
      * 
      * @return Reference to CollisionMap.
      */
-    CollisionMap<std::vector> &GetCollisionMap() { return m_CollisionMap; }
+    CollisionMap<BitVector> &GetCollisionMap() { return m_CollisionMap; }
 
     /**
      * @brief Get read-only reference to the collision map.
      * @return Const reference to CollisionMap.
      */
-    const CollisionMap<std::vector> &GetCollisionMap() const { return m_CollisionMap; }
+    const CollisionMap<BitVector> &GetCollisionMap() const { return m_CollisionMap; }
     /** @} */
 
     /**
@@ -410,13 +608,45 @@ public:
      * @brief Get mutable reference to the navigation map.
      * @return Reference to NavigationMap.
      */
-    NavigationMap<std::vector> &GetNavigationMap() { return m_NavigationMap; }
+    NavigationMap<BitVector> &GetNavigationMap() { return m_NavigationMap; }
 
     /**
      * @brief Get read-only reference to the navigation map.
      * @return Const reference to NavigationMap.
      */
-    const NavigationMap<std::vector> &GetNavigationMap() const { return m_NavigationMap; }
+    const NavigationMap<BitVector> &GetNavigationMap() const { return m_NavigationMap; }
+
+    /**
+     * @brief Counter bumped by every change that affects NPC walkability.
+     *
+     * Covers SetNavigation(), SetTileCollision() (a solid tile blocks NPCs
+     * even where navigation is set) and whole-map loads or resizes. Caches
+     * derived from walkability compare it to decide whether they are stale.
+     */
+    uint64_t GetNavigationVersion() const { return m_NavigationVersion; }
+
+    /**
+     * @brief Visit the cells whose walkability may have changed after @p version.
+     *
+     * Calls @p fn(x, y) once per recorded change, oldest first; a cell edited
+     * twice is reported twice.
+     *
+     * @return `false` if the history does not reach back to @p version
+     *         (map load, resize or more than NAVIGATION_HISTORY_LIMIT edits);
+     *         the caller must then treat every cell as changed.
+     */
+    template<typename Fn>
+    bool ForEachNavigationChangeSince(uint64_t version, Fn &&fn) const
+    {
+        if (version < m_NavigationHistoryBase || version > m_NavigationVersion)
+            return false;
+        for (size_t i = static_cast<size_t>(version - m_NavigationHistoryBase); i < m_NavigationHistory.size(); ++i)
+            fn(m_NavigationHistory[i].x, m_NavigationHistory[i].y);
+        return true;
+    }
+
+    /// @brief Edits kept for ForEachNavigationChangeSince() before the history resets.
+    static constexpr size_t NAVIGATION_HISTORY_LIMIT = 4096;
     /** @} */
 
     /**
@@ -432,6 +662,7 @@ public:
     inline int GetTilesPerRow() const { return m_TilesPerRow; }                   ///< Tiles per row in tileset
     inline int GetTilesetDataWidth() const { return m_TilesetDataWidth; }         ///< Tileset image width
     inline int GetTilesetDataHeight() const { return m_TilesetDataHeight; }       ///< Tileset image height
+    inline uint64_t GetTilesetRevision() const { return m_TilesetRevision; }      ///< Bumped on every tileset load or patch
     /** @} */
 
     /**
@@ -483,8 +714,43 @@ public:
     void RenderForegroundLayersNoProjection(IRenderer& renderer, glm::vec2 renderCam, glm::vec2 renderSize,
                                             glm::vec2 cullCam, glm::vec2 cullSize);
 
-    /// Get sorted indices for rendering (by renderOrder)
-    std::vector<size_t> GetLayerRenderOrder() const;
+    /// Tile quads submitted by the render functions since the last reset (chunk meshes count all their quads)
+    size_t GetDrawnTileCount() const { return m_DrawnTiles; }
+
+    /// Start a new count for GetDrawnTileCount() (once per frame)
+    void ResetDrawnTileCount() { m_DrawnTiles = 0; }
+
+    /// Heap bytes of the layers, per-tile maps and render caches (the tileset texture is reported on its own)
+    size_t GetMemoryBytes() const;
+
+    /// Get sorted indices for rendering (by renderOrder), valid until the frame arena resets
+    FrameVector<size_t> GetLayerRenderOrder() const;
+
+    /**
+     * @brief Destroy cached chunk meshes held by the renderer that built them.
+     *
+     * Must be called before that renderer is destroyed (e.g. on a renderer
+     * switch). Chunks are rebuilt lazily on the next RenderBackgroundLayers()
+     * or RenderForegroundLayers() call.
+     */
+    void ReleaseChunkMeshes();
+
+    /// Edge length in tiles of the blocks GetBlockRevision() tracks
+    static constexpr int REVISION_BLOCK_SIZE = 32;
+
+    /**
+     * @brief Stamp of the last change to any cell in a block of tiles.
+     *
+     * Block (@p blockX, @p blockY) starts at tile (blockX, blockY) *
+     * REVISION_BLOCK_SIZE. Per-cell setters (tiles, flags, animations,
+     * structure IDs, collision, navigation, elevation, corner cutting),
+     * particle zone adds and removes, region streaming and whole-map loads
+     * or resizes stamp the blocks they touch from one map-wide counter. A stamp is never reused, so the
+     * largest stamp over a group of blocks changes whenever any of them does.
+     *
+     * @return 0 for blocks outside the map.
+     */
+    uint64_t GetBlockRevision(int blockX, int blockY) const;
     /** @} */
 
     /**
@@ -550,6 +816,17 @@ public:
      */
     void RemoveNoProjectionStructure(int id);
 
+    /**
+     * @brief Put a structure back at index @p structure.id (editor undo).
+     *
+     * Shifts the IDs of later structures up by one. Unlike
+     * RemoveNoProjectionStructure() this leaves tile assignments alone;
+     * the caller restores them.
+     * @param structure Structure to insert; its ID is clamped to the list size.
+     * @return The ID it was stored under.
+     */
+    int InsertNoProjectionStructure(const NoProjectionStructure& structure);
+
     /**
      * @brief Get the structure ID assigned to a tile.
      * @param x Tile X coordinate.
@@ -636,6 +913,11 @@ public:
 
     /**
      * @brief Collect all visible Y-sort-plus tiles for rendering.
+     *
+     * Reads the persistent Y-sort index, so the cost follows the number of
+     * Y-sort tiles near the view, not the number of visible cells. Tiles come
+     * back sorted by anchorY; equal anchors keep layer, row, column order.
+     *
      * @param cullCam Camera position for culling.
      * @param cullSize Visible area size for culling.
      * @return Vector of Y-sort-plus tiles within visible range.
@@ -709,6 +991,222 @@ public:
      */
     bool LoadMapFromJSON(const std::string &filename, std::vector<class NonPlayerCharacter> *npcs = nullptr,
                          int *playerTileX = nullptr, int *playerTileY = nullptr, int *characterType = nullptr);
+
+    /**
+     * @brief Save map to a binary `.wmap` file.
+     *
+     * Stores the same content as SaveMapToJSON() in the fixed-layout format
+     * described in BinaryMap.h. Tile layers are written as their raw chunks.
+     *
+     * @param filename Output file path.
+     * @param npcs Optional NPC list to save.
+     * @param playerTileX Player tile X (-1 to skip).
+     * @param playerTileY Player tile Y (-1 to skip).
+     * @param characterType Player's character type (-1 to skip).
+     * @return `true` if saved successfully.
+     */
+    bool SaveMapToBinary(const std::string &filename, const std::vector<class NonPlayerCharacter> *npcs = nullptr,
+                         int playerTileX = -1, int playerTileY = -1, int characterType = -1) const;
+
+    /**
+     * @brief Load map from a binary `.wmap` file.
+     *
+     * The file is memory-mapped; layer chunks are copied straight from the
+     * mapping and dense sections are read in place, with no per-tile parsing.
+     *
+     * @param filename Input file path.
+     * @param npcs Optional output for loaded NPCs.
+     * @param playerTileX Optional output for player X coordinate.
+     * @param playerTileY Optional output for player Y coordinate.
+     * @param characterType Optional output for player's character type.
+     * @return `true` if loaded successfully.
+     */
+    bool LoadMapFromBinary(const std::string &filename, std::vector<class NonPlayerCharacter> *npcs = nullptr,
+                           int *playerTileX = nullptr, int *playerTileY = nullptr, int *characterType = nullptr);
+
+    /**
+     * @brief Convert a map file between JSON and binary.
+     *
+     * The direction follows the extensions: `.json` is read or written as
+     * JSON, anything else as binary. NPCs and the player spawn are preserved.
+     *
+     * @param source Input map file.
+     * @param destination Output map file.
+     * @return `true` if converted successfully.
+     */
+    static bool ConvertMapFile(const std::string &source, const std::string &destination);
+    /** @} */
+
+    /**
+     * @name World Streaming
+     * @brief Region files for worlds that are loaded piecewise (see WorldStreamer).
+     * @{
+     */
+    /**
+     * @brief Split the whole map into a streamed world directory.
+     *
+     * Writes one region file per non-empty region plus world.json,
+     * creating the directory if needed.
+     *
+     * @param directory Output world directory.
+     * @param regionSize Region edge in tiles (rounded up to a multiple of CHUNK_SIZE).
+     * @param npcs Optional NPC list to distribute over the regions.
+     * @param playerTileX Player tile X (-1 to skip).
+     * @param playerTileY Player tile Y (-1 to skip).
+     * @param characterType Player's character type (-1 to skip).
+     * @return `true` if every file was written.
+     */
+    bool SaveWorldRegions(const std::string &directory, int regionSize,
+                          const std::vector<class NonPlayerCharacter> *npcs = nullptr,
+                          int playerTileX = -1, int playerTileY = -1, int characterType = -1) const;
+
+    /**
+     * @brief Write world.json for @p manifest; region files are written separately.
+     * @return `true` if saved successfully.
+     */
+    bool SaveWorldManifest(const WorldManifest &manifest, int playerTileX = -1, int playerTileY = -1,
+                           int characterType = -1) const;
+
+    /**
+     * @brief Open a streamed world directory.
+     *
+     * Sizes the map to the full world and restores layer definitions,
+     * animation and structure tables. No region content is loaded; it
+     * arrives through ApplyRegion().
+     *
+     * @param directory World directory containing world.json.
+     * @param manifest Filled with the region layout.
+     * @param playerTileX Optional output for player X coordinate.
+     * @param playerTileY Optional output for player Y coordinate.
+     * @param characterType Optional output for player's character type.
+     * @return `true` if the manifest was read.
+     */
+    bool LoadWorldManifest(const std::string &directory, WorldManifest &manifest,
+                           int *playerTileX = nullptr, int *playerTileY = nullptr, int *characterType = nullptr);
+
+    /**
+     * @brief Copy the current content of one region into @p out.
+     *
+     * NPCs are assigned to their home region, or by tile position if they
+     * have none (e.g. placed in the editor).
+     */
+    void ExtractRegion(int regionX, int regionY, int regionSize,
+                       const std::vector<class NonPlayerCharacter> *npcs, MapRegion &out) const;
+
+    /**
+     * @brief Make a loaded region resident.
+     *
+     * Writes its tiles, collision, navigation, elevation and corner masks,
+     * appends its particle zones and spawns its NPCs with the region as home.
+     */
+    void ApplyRegion(const MapRegion &region, std::vector<class NonPlayerCharacter> *npcs = nullptr);
+
+    /**
+     * @brief Evict a region, clearing everything ApplyRegion() wrote.
+     *
+     * @param regionX Region column.
+     * @param regionY Region row.
+     * @param regionSize Region edge in tiles.
+     * @param npcs Optional NPC list; NPCs whose home is this region are removed.
+     * @param removedZones Optional output: indices of removed particle zones, highest first,
+     *                     in the order they must be passed to ParticleSystem::OnZoneRemoved().
+     */
+    void UnloadRegion(int regionX, int regionY, int regionSize,
+                      std::vector<class NonPlayerCharacter> *npcs = nullptr,
+                      std::vector<int> *removedZones = nullptr);
+
+    /**
+     * @brief Largest GetBlockRevision() over the blocks of one region.
+     *
+     * Changes whenever anything ExtractRegion() copies out of the tilemap
+     * changes (NPCs aside), so comparing it against the value taken when the
+     * region was last read or written tells whether it has unsaved edits.
+     */
+    uint64_t GetRegionRevision(int regionX, int regionY, int regionSize) const;
+    /** @} */
+
+    /**
+     * @name Bulk Editing
+     * @brief Edits over many cells that refresh derived data once per operation.
+     * @{
+     */
+    /// @brief Worker threads for large rectangle edits (nullptr = run on the caller).
+    void SetJobSystem(JobSystem *jobs) { m_Jobs = jobs; }
+
+    /**
+     * @brief Start a group of per-cell edits, such as one flood fill. Nestable.
+     *
+     * The first BULK_EDIT_INCREMENTAL_UPDATES derived-data updates inside
+     * the group stay incremental, so small edits remain cheap. Past that the
+     * derived caches are flagged for one rebuild on next use and the rest
+     * of the group skips its per-cell updates.
+     */
+    void BeginBulkEdit();
+
+    /// @brief End the group opened by the matching BeginBulkEdit().
+    void EndBulkEdit();
+
+    /// @brief BeginBulkEdit() for the lifetime of the scope.
+    class BulkEditScope
+    {
+    public:
+        explicit BulkEditScope(Tilemap &tilemap) : m_Tilemap(tilemap) { m_Tilemap.BeginBulkEdit(); }
+        ~BulkEditScope() { m_Tilemap.EndBulkEdit(); }
+
+        BulkEditScope(const BulkEditScope &) = delete;
+        BulkEditScope &operator=(const BulkEditScope &) = delete;
+
+    private:
+        Tilemap &m_Tilemap;
+    };
+
+    /**
+     * @brief Overwrite a rectangle of one layer, cells and structure IDs.
+     *
+     * Rows are written as spans, in parallel chunk bands when the rectangle
+     * has at least PARALLEL_EDIT_MIN_CELLS cells. Derived data is flagged
+     * for one rebuild, as after ApplyRegion(). The rectangle is clipped to
+     * the map.
+     *
+     * @param layer       Layer index (0-based).
+     * @param x, y        Top-left tile.
+     * @param width       Columns to fill.
+     * @param height      Rows to fill.
+     * @param cell        Value of every cell (PackedTile{} clears).
+     * @param structureId Structure ID of every cell (-1 = none).
+     */
+    void FillLayerRect(size_t layer, int x, int y, int width, int height, PackedTile cell, int structureId = -1);
+
+    /**
+     * @brief Copy a rectangle of cells and structure IDs between or within layers.
+     *
+     * The source is read completely before anything is written, so the
+     * rectangles may overlap. Source cells outside the map copy as empty;
+     * destination cells outside it are dropped. Parallel and invalidated
+     * like FillLayerRect().
+     */
+    void CopyLayerRect(size_t srcLayer, int srcX, int srcY, size_t dstLayer, int dstX, int dstY,
+                       int width, int height);
+
+    /**
+     * @brief SetTileCollision() over a rectangle.
+     *
+     * Changed cells go into the navigation history; a rectangle larger than
+     * NAVIGATION_HISTORY_LIMIT resets it once instead.
+     */
+    void FillCollisionRect(int x, int y, int width, int height, bool hasCollision);
+
+    /// @brief SetNavigation() over a rectangle, history handled like FillCollisionRect().
+    void FillNavigationRect(int x, int y, int width, int height, bool walkable);
+
+    /// @brief SetElevation() over a rectangle, rows in parallel like FillLayerRect().
+    void FillElevationRect(int x, int y, int width, int height, int elevation);
+
+    /// @brief Incremental derived-data updates a bulk edit does before switching to a rebuild.
+    static constexpr size_t BULK_EDIT_INCREMENTAL_UPDATES = 1024;
+
+    /// @brief Rectangle edits smaller than this run on the calling thread.
+    static constexpr size_t PARALLEL_EDIT_MIN_CELLS = 64 * 64;
     /** @} */
 
     /**
@@ -735,6 +1233,51 @@ public:
      * @return `true` if tile is completely transparent.
      */
     bool IsTileTransparent(int tileID) const;
+
+    /**
+     * @brief Check if a tile covers its whole cell.
+     *
+     * A tile is opaque if every pixel is visible (alpha = 255, or for RGB
+     * tilesets neither pure black nor pure white). Layers beneath an opaque
+     * tile are skipped by the tile passes.
+     *
+     * @param tileID Tile ID to check.
+     * @return `true` if no pixel of the tile lets anything through.
+     */
+    bool IsTileOpaque(int tileID) const;
+    /** @} */
+
+    /**
+     * @name Tile Lights
+     * @brief Tiles flagged as emissive for the light map.
+     * @{
+     */
+
+    /**
+     * @brief Make a tile ID emit light, or stop it.
+     * @param tileID Tile ID to flag.
+     * @param color  Light added at the tile center.
+     * @param radius Reach in pixels (<= 0 removes the light).
+     */
+    void SetTileLight(int tileID, glm::vec3 color, float radius);
+
+    /// @brief Light of a tile ID, or nullptr if it emits none.
+    const TileLight* GetTileLight(int tileID) const;
+
+    /// @brief Every emissive tile definition.
+    const std::vector<TileLight>& GetTileLights() const { return m_TileLights; }
+
+    /**
+     * @brief Append one light per visible cell showing an emissive tile.
+     *
+     * Animated cells count with their current frame. Positions are the tile
+     * centers relative to @p cameraPos, as expected by IRenderer::SetLightMap().
+     *
+     * @param cameraPos Camera position (top-left of the view).
+     * @param viewSize  View size; cells whose light cannot reach it are skipped.
+     * @param lights    Receives the lights.
+     */
+    void CollectTileLights(glm::vec2 cameraPos, glm::vec2 viewSize, std::vector<IRenderer::Light>& lights) const;
     /** @} */
 
     /**
@@ -751,15 +1294,33 @@ public:
 
     /**
      * @brief Get mutable access to particle zones.
+     *
+     * Counts as a change to the zones (see GetParticleZoneRevision()).
+     *
      * @return Pointer to the particle zones vector.
      */
-    std::vector<ParticleZone>* GetParticleZonesMutable() { return &m_ParticleZones; }
+    std::vector<ParticleZone>* GetParticleZonesMutable() {
+        ++m_ParticleZoneRevision;
+        return &m_ParticleZones;
+    }
+
+    /**
+     * @brief Counter bumped whenever the zone list may have changed.
+     *
+     * Loads, region streaming, add/remove and mutable access all bump it,
+     * so ParticleSystem only rebuilds its zone index when this differs.
+     */
+    std::uint64_t GetParticleZoneRevision() const { return m_ParticleZoneRevision; }
 
     /**
      * @brief Add a new particle zone.
      * @param zone The zone to add.
      */
-    void AddParticleZone(const ParticleZone& zone) { m_ParticleZones.push_back(zone); }
+    void AddParticleZone(const ParticleZone& zone) {
+        m_ParticleZones.push_back(zone);
+        ++m_ParticleZoneRevision;
+        StampZoneBlock(zone);
+    }
 
     /**
      * @brief Remove a particle zone by index.
@@ -767,7 +1328,9 @@ public:
      */
     void RemoveParticleZone(size_t index) {
         if (index < m_ParticleZones.size()) {
+            StampZoneBlock(m_ParticleZones[index]);
             m_ParticleZones.erase(m_ParticleZones.begin() + index);
+            ++m_ParticleZoneRevision;
         }
     }
 
@@ -784,6 +1347,9 @@ public:
      */
     int AddAnimatedTile(const AnimatedTile& anim) {
         m_AnimatedTiles.push_back(anim);
+        m_YSortIndexDirty = true;  // Cells may reference the new ID already
+        m_AnimatedCellsDirty = true;
+        m_OccludersDirty = true;   // A cell that was static may now animate
         int id = static_cast<int>(m_AnimatedTiles.size() - 1);
         std::cout << "[DEBUG] Added animation #" << id << " with " << anim.frames.size()
                   << " frames, duration=" << anim.frameDuration << "s" << std::endl;
@@ -813,23 +1379,23 @@ public:
     void SetTileAnimation(int x, int y, int layer, int animId) {
         if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight) return;
         if (layer < 0 || layer >= static_cast<int>(m_Layers.size())) return;
-        size_t idx = static_cast<size_t>(y * m_MapWidth + x);
-        if (idx < m_Layers[layer].animationMap.size()) {
-            m_Layers[layer].animationMap[idx] = animId;
-            std::cout << "[DEBUG] SetTileAnimation at (" << x << "," << y << ") layer " << layer
-                      << " idx=" << idx << " animId=" << animId << std::endl;
-
-            // Also set the first frame of the animation on the specified layer
-            // so there's a tile to render (the animation check happens after tile existence check)
-            if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()) &&
-                !m_AnimatedTiles[animId].frames.empty()) {
-                int firstFrame = m_AnimatedTiles[animId].frames[0];
-                m_Layers[layer].tiles[idx] = firstFrame;
-                std::cout << "[DEBUG]   Placed first frame " << firstFrame << " on layer " << layer << std::endl;
-            }
-        } else {
-            std::cout << "[DEBUG] SetTileAnimation FAILED: idx " << idx << " >= layer animationMap size" << std::endl;
+        MoveAnimatedCell(x, y, layer, m_Layers[layer].GetAnimation(x, y), animId);
+        m_Layers[layer].SetAnimation(x, y, animId);
+        MarkChunkDirty(x, y);
+        UpdateYSortColumn(x, y, static_cast<size_t>(layer));
+        std::cout << "[DEBUG] SetTileAnimation at (" << x << "," << y << ") layer " << layer
+                  << " animId=" << animId << std::endl;
+
+        // Also set the first frame of the animation on the specified layer
+        // so there's a tile to render (the animation check happens after tile existence check)
+        if (animId >= 0 && animId < static_cast<int>(m_AnimatedTiles.size()) &&
+            !m_AnimatedTiles[animId].frames.empty()) {
+            int firstFrame = m_AnimatedTiles[animId].frames[0];
+            m_Layers[layer].SetTile(x, y, firstFrame);
+            UpdateYSortColumn(x, y, static_cast<size_t>(layer));
+            std::cout << "[DEBUG]   Placed first frame " << firstFrame << " on layer " << layer << std::endl;
         }
+        UpdateOccluders(x, y);
     }
 
     /**
@@ -842,38 +1408,19 @@ public:
     int GetTileAnimation(int x, int y, int layer) const {
         if (x < 0 || x >= m_MapWidth || y < 0 || y >= m_MapHeight) return -1;
         if (layer < 0 || layer >= static_cast<int>(m_Layers.size())) return -1;
-        size_t idx = static_cast<size_t>(y * m_MapWidth + x);
-        if (idx >= m_Layers[layer].animationMap.size()) return -1;
-        return m_Layers[layer].animationMap[idx];
+        return m_Layers[layer].GetAnimation(x, y);
     }
 
     /**
-     * @brief Update animation timer.
+     * @brief Advance the animation timer and resolve each animation's frame.
+     *
+     * Frames are evaluated once per animation here; renderers only look
+     * them up. Chunks holding cells of an animation whose frame changed are
+     * flagged so their baked quads get patched on the next draw.
+     *
      * @param deltaTime Time since last update.
      */
-    void UpdateAnimations(float deltaTime) {
-        m_AnimationTime += deltaTime;
-        // Debug: print animation time every ~2 seconds
-        static float debugTimer = 0.0f;
-        debugTimer += deltaTime;
-        if (debugTimer > 2.0f) {
-            debugTimer = 0.0f;
-            if (!m_AnimatedTiles.empty()) {
-                int count = 0;
-                for (const auto& layer : m_Layers) {
-                    for (int a : layer.animationMap) if (a >= 0) count++;
-                }
-
-                // Show detailed info for first animation
-                const auto& anim = m_AnimatedTiles[0];
-                int currentFrame = anim.GetFrameAtTime(m_AnimationTime);
-                /*std::cout << "[DEBUG] AnimTime=" << m_AnimationTime
-                          << " Anim0: " << anim.frames.size() << " frames, "
-                          << anim.frameDuration << "s/frame, currentTileID=" << currentFrame
-                          << " MapEntries=" << count << std::endl;*/
-            }
-        }
-    }
+    void UpdateAnimations(float deltaTime);
 
     /** @} */
 
@@ -916,9 +1463,9 @@ public:
      * @param x Tile column.
      * @return ColumnProxy for row access.
      */
-    ColumnProxy<std::vector<int>, int, -1> operator[](int x)
+    ColumnProxy<TileLayer, int, -1> operator[](int x)
     {
-        return ColumnProxy<std::vector<int>, int, -1>(&m_Layers[0].tiles, &m_MapWidth, &m_MapHeight, x);
+        return ColumnProxy<TileLayer, int, -1>(&m_Layers[0], &m_MapWidth, &m_MapHeight, x);
     }
 
     /**
@@ -931,9 +1478,9 @@ public:
      * @param x Tile column.
      * @return ColumnProxy for read-only access.
      */
-    ColumnProxy<std::vector<int>, int, -1> operator[](int x) const
+    ColumnProxy<TileLayer, int, -1> operator[](int x) const
     {
-        return ColumnProxy<std::vector<int>, int, -1>(&m_Layers[0].tiles, &m_MapWidth, &m_MapHeight, x);
+        return ColumnProxy<TileLayer, int, -1>(&m_Layers[0], &m_MapWidth, &m_MapHeight, x);
     }
     /** @} */
 
@@ -944,12 +1491,22 @@ private:
     int m_TileWidth, m_TileHeight;                ///< Tile dimensions in pixels
     int m_TilesetWidth, m_TilesetHeight;          ///< Tileset dimensions in tiles
     int m_TilesPerRow;                            ///< Tiles per row in tileset
-    unsigned char *m_TilesetData;                 ///< Raw image data for transparency checks
-    int m_TilesetDataWidth, m_TilesetDataHeight;  ///< Raw image dimensions
-    int m_TilesetChannels;                        ///< Number of color channels (3=RGB, 4=RGBA)
-    bool m_TilesetDataFromStbi;                   ///< True if allocated by stbi_load, false if by new[]
-    std::vector<bool> m_TileTransparencyCache;    ///< Cached transparency results per tile ID
+    int m_TilesetDataWidth, m_TilesetDataHeight;  ///< Combined image dimensions in pixels
+    std::vector<uint8_t> m_TileTransparencyCache; ///< 1 = tile fully transparent, per tile ID
+    std::vector<uint8_t> m_TileOpaqueCache;       ///< 1 = tile fully opaque, per tile ID
     bool m_TransparencyCacheBuilt;                ///< Whether the cache has been built
+    uint64_t m_TilesetRevision = 0;               ///< Bumped by LoadCombinedTilesets() and PatchTileset()
+
+    /// Where one source image sits in the combined tileset
+    struct TilesetSource
+    {
+        std::string path;   ///< As passed to LoadCombinedTilesets()
+        std::string key;    ///< Absolute, normalized path for FindTileset()
+        int offsetY;        ///< First row in the combined image (top-down)
+        int width;
+        int height;
+    };
+    std::vector<TilesetSource> m_TilesetSources;  ///< In load order
     /// @}
 
     /// @name Map Dimensions
@@ -964,9 +1521,12 @@ private:
 
     /// @name Collision and Navigation
     /// @{
-    CollisionMap<std::vector> m_CollisionMap;      ///< Collision flags
-    NavigationMap<std::vector> m_NavigationMap;    ///< NPC walkability flags
+    CollisionMap<BitVector> m_CollisionMap;      ///< Collision flags
+    NavigationMap<BitVector> m_NavigationMap;    ///< NPC walkability flags
     std::vector<uint8_t> m_CornerCutBlocked;       ///< Per-tile corner cut disable mask (4 bits per tile)
+    uint64_t m_NavigationVersion = 0;              ///< See GetNavigationVersion()
+    uint64_t m_NavigationHistoryBase = 0;          ///< Version before m_NavigationHistory[0]
+    std::vector<glm::ivec2> m_NavigationHistory;   ///< Cells changed since m_NavigationHistoryBase
     /// @}
 
     /// @name Elevation Data
@@ -974,16 +1534,43 @@ private:
     std::vector<int> m_Elevation;  ///< Per-tile elevation in pixels (0 = ground)
     /// @}
 
+    /// @name Bulk Editing
+    /// @{
+    JobSystem *m_Jobs = nullptr;        ///< See SetJobSystem()
+    int m_BulkEditDepth = 0;            ///< Open BeginBulkEdit() calls
+    size_t m_BulkEditUpdates = 0;       ///< Incremental updates in the open bulk edit
+    /// @}
+
+    /// @name Tile Lights
+    /// @{
+    std::vector<TileLight> m_TileLights;        ///< Emissive tile definitions
+    std::vector<int> m_TileLightIndex;          ///< m_TileLights index per tile ID, -1 = none
+    float m_MaxTileLightRadius = 0.0f;          ///< Cull margin for CollectTileLights()
+
+    /// Rebuild m_TileLightIndex and m_MaxTileLightRadius from m_TileLights
+    void RebuildTileLightIndex();
+    /// @}
+
     /// @name Particle Zones
     /// @{
     std::vector<ParticleZone> m_ParticleZones;  ///< Placeable particle emitter zones
+    std::uint64_t m_ParticleZoneRevision = 0;   ///< Bumped on every zone list change
     /// @}
 
     /// @name Animated Tiles
     /// @{
     std::vector<AnimatedTile> m_AnimatedTiles;  ///< Animation definitions
-    std::vector<int> m_TileAnimationMap;        ///< Per-tile animation ID (-1 = not animated)
     float m_AnimationTime;                      ///< Global animation timer
+
+    /// Cell using an animation (x, y, 0-based layer)
+    struct AnimatedCell
+    {
+        int x, y;
+        int layer;
+    };
+    std::vector<int> m_AnimationFrames;                     ///< Current frame tile ID per animation
+    std::vector<std::vector<AnimatedCell>> m_AnimatedCells;  ///< Cells per animation ID
+    bool m_AnimatedCellsDirty = true;                        ///< Rebuild m_AnimatedCells before use
     /// @}
 
     /// @name No-Projection Structures
@@ -994,8 +1581,144 @@ private:
     /// @name Render Cache (reused each frame to avoid allocations)
     /// @{
     mutable std::vector<YSortPlusTile> m_YSortPlusTilesCache;  ///< Cached Y-sort tiles (reused each frame)
-    mutable std::vector<bool> m_ProcessedCache;                ///< Cached processed flags (reused each frame)
-    mutable std::vector<bool> m_RenderedStructuresCache;       ///< Cached structure flags (reused each frame)
+    mutable std::vector<std::pair<int, int>> m_VisibleStructuresCache;  ///< (first visible cell, structure ID) pairs
+    /// @}
+
+    /**
+     * @name Y-Sort Index
+     * @brief Persistent list of Y-sort-plus cells, bucketed by anchor row.
+     *
+     * A vertical run of Y-sort-plus cells in one layer sorts as a unit at the
+     * bottom of the run, so each cell is stored in the bucket of its run's
+     * bottom row. Walking buckets top to bottom therefore yields anchorY
+     * order directly. Single-cell edits patch the affected column run; bulk
+     * changes (load, resize, region streaming) set m_YSortIndexDirty and the
+     * index is rebuilt on the next query.
+     * @{
+     */
+    struct YSortIndexEntry
+    {
+        int x, y;   ///< Tile coordinates
+        int layer;  ///< Layer index (0-based)
+
+        /// Bucket order: layer, then row, then column (the order of the old full scan)
+        bool operator<(const YSortIndexEntry &o) const
+        {
+            return std::tie(layer, y, x) < std::tie(o.layer, o.y, o.x);
+        }
+    };
+    mutable std::vector<std::vector<YSortIndexEntry>> m_YSortRows;  ///< Per anchor row, sorted by (layer, y, x)
+    mutable int m_YSortMaxRun = 1;         ///< Upper bound on run height, limits the rows a query scans
+    mutable bool m_YSortIndexDirty = true;
+    /// @}
+
+    /**
+     * @name Structure Index
+     * @brief Persistent member lists of the defined no-projection structures.
+     *
+     * A cell belongs to structure S in a layer group (background or
+     * foreground) when a layer of that group marks it noProjection, not
+     * Y-sort-plus, with structure ID S. Renderers walk only the structures
+     * whose bounds reach the view instead of rescanning the view once per
+     * structure. Single-cell edits patch the lists in place; ID renumbering
+     * and bulk changes set m_StructureIndexDirty for a lazy rebuild.
+     * @{
+     */
+    struct StructureMembers
+    {
+        std::vector<std::pair<int, int>> tiles;  ///< Member cells (x, y), row-major
+        int minX = INT_MAX, maxX = INT_MIN;      ///< Tile bounds (empty while tiles is empty)
+        int minY = INT_MAX, maxY = INT_MIN;
+
+        void RecomputeBounds();
+    };
+    mutable std::vector<std::array<StructureMembers, 2>> m_StructureIndex;  ///< [structure][0 = background, 1 = foreground]
+    mutable bool m_StructureIndexDirty = true;
+
+    /// Flood-fill components of cells that are noProjection in any layer (for particle bounds)
+    mutable ChunkedGrid<int32_t, -1> m_NoProjComponentIds;
+    mutable std::vector<std::array<int, 4>> m_NoProjComponentBounds;  ///< minX, maxX, minY, maxY per component
+    mutable bool m_NoProjComponentsDirty = true;
+    /// @}
+
+    /// @name Static Chunk Cache
+    /// @{
+
+    /// Chunk edge length in tiles
+    static constexpr int CHUNK_SIZE = 32;
+
+    /// Animated cell baked into a chunk mesh, rewritten in place when its frame changes
+    struct AnimatedQuad
+    {
+        IRenderer::StaticQuad quad;  ///< Geometry as last uploaded
+        uint32_t quadIndex;          ///< Index in the chunk mesh
+        int animId;                  ///< Animation driving this quad
+        int tileID;                  ///< Frame currently in the mesh (-1 = hidden)
+    };
+
+    /**
+     * @brief Cached geometry for a CHUNK_SIZE x CHUNK_SIZE block of tiles.
+     *
+     * Index 0 holds the background layer group, index 1 the foreground group.
+     * Vertices are relative to the chunk's top-left tile so a single draw with
+     * a camera offset replaces one DrawSpriteRegion() per tile and layer.
+     */
+    struct TileChunk
+    {
+        int mesh[2] = {IRenderer::INVALID_STATIC_MESH, IRenderer::INVALID_STATIC_MESH};
+        std::vector<int> animatedCells[2];  ///< Map indices drawn per tile each frame (no in-place updates)
+        std::vector<AnimatedQuad> animatedQuads[2];  ///< Animated cells baked into the mesh
+        bool animationStale[2] = {false, false};     ///< A baked animation changed frame
+        bool dirty[2] = {true, true};       ///< Rebuild before next draw
+        bool unsupported[2] = {false, false};  ///< Renderer returned no mesh, draw per tile
+        size_t quadCount[2] = {0, 0};       ///< Quads in the mesh
+    };
+
+    std::vector<TileChunk> m_Chunks;  ///< Row-major chunk grid (built lazily)
+
+    /**
+     * @brief Projected tile corners of the visible range, shared by all layers.
+     *
+     * Corner (x, y) is the top-left of tile (x, y), so tiles x0..x1 need
+     * x1 - x0 + 2 corners per row. Neighbouring tiles read the same corner
+     * and meet without gaps. Only used while the CPU projects; both layer
+     * groups see the same range, camera and projection, so the lattice is
+     * projected once per frame.
+     */
+    struct ProjectedGrid
+    {
+        int x0 = 0, y0 = 0;                     ///< Tile whose top-left is corner 0
+        int columns = 0, rows = 0;              ///< Corners per row, corner rows
+        glm::vec2 renderCam{0.0f};              ///< Camera the corners are relative to
+        IRenderer::PerspectiveState perspective;  ///< Projection the corners went through
+        std::vector<float> x, y;                ///< Projected corners, row-major
+
+        glm::vec2 Corner(int tx, int ty) const
+        {
+            const size_t i = static_cast<size_t>(ty - y0) * columns + static_cast<size_t>(tx - x0);
+            return glm::vec2(x[i], y[i]);
+        }
+    };
+    ProjectedGrid m_ProjectedGrid;
+
+    /// m_Occluders value of a cell with no opaque tile in the group
+    static constexpr uint8_t NO_OCCLUDER = 0xFF;
+
+    /**
+     * Per layer group (0 = background, 1 = foreground), the highest layer in
+     * render order whose cell is a static opaque tile. The tile passes start
+     * drawing a cell at that layer, since everything below is covered.
+     * Kept up to date by the per-cell setters, rebuilt after bulk changes.
+     */
+    ChunkedGrid<uint8_t, NO_OCCLUDER> m_Occluders[2];
+    bool m_OccludersDirty = true;  ///< Rebuild m_Occluders before the next tile pass
+    int m_ChunksX, m_ChunksY;         ///< Chunk grid dimensions
+    IRenderer *m_ChunkRenderer;       ///< Renderer owning the chunk meshes
+    size_t m_DrawnTiles = 0;          ///< See GetDrawnTileCount()
+
+    std::vector<uint64_t> m_BlockRevisions;  ///< Row-major, see GetBlockRevision()
+    int m_RevisionBlocksX = 0;               ///< Blocks per map row
+    uint64_t m_RevisionCounter = 0;          ///< Last stamp handed out
     /// @}
 
     /**
@@ -1009,8 +1732,130 @@ private:
     /**
      * @brief Build the transparency cache for all tiles.
      *
-     * Pre-computes transparency for every tile ID to avoid expensive
-     * per-pixel checks during rendering. Called on tileset load.
+     * Pre-computes transparency for every tile ID from the combined image
+     * (top-down rows) so the pixels need not be kept after loading. Tile
+     * rows are scanned in parallel. Called on tileset load.
+     *
+     * @param pixels   Combined tileset pixels, m_TilesetDataWidth wide.
+     * @param channels Channels per pixel (3 = RGB, 4 = RGBA).
      */
-    void BuildTransparencyCache();
+    void BuildTransparencyCache(const unsigned char *pixels, int channels);
+
+    /// Tile drawn for a cell by the projected passes (animation applied), or -1 if skipped
+    int ResolveProjectedTile(PackedTile cell) const;
+
+    /// Shared body of RenderBackgroundLayers() / RenderForegroundLayers()
+    void RenderLayerGroup(IRenderer &renderer, bool background, glm::vec2 renderCam,
+                          glm::vec2 cullCam, glm::vec2 cullSize);
+
+    /**
+     * @brief Draw an inclusive tile range, one quad per tile and layer.
+     *
+     * With @p grid the corners come pre-projected from the shared lattice
+     * and are drawn as warped quads; without it each tile goes through
+     * DrawSpriteRegion() and is projected by the renderer (or not at all).
+     * Layers of @p group hidden under a cell's occluder are skipped.
+     */
+    void RenderTileRange(IRenderer &renderer, int group, std::span<const size_t> layers, glm::vec2 renderCam,
+                         int x0, int y0, int x1, int y1, const ProjectedGrid *grid = nullptr);
+
+    /// True if a cell hides every layer beneath it (static, opaque, drawn by the tile passes)
+    bool IsOccludingCell(PackedTile cell) const;
+
+    /// Tail of @p layers (render order) that is not hidden under the cell's occluder
+    std::span<const size_t> GetVisibleLayers(std::span<const size_t> layers, int group, int x, int y) const;
+
+    /// Recompute m_Occluders for every cell
+    void RebuildOccluders();
+
+    /// Recompute m_Occluders for tile (x, y) after one of its cells changed
+    void UpdateOccluders(int x, int y);
+
+    /// Reproject m_ProjectedGrid unless range, camera and projection are unchanged
+    const ProjectedGrid &UpdateProjectedGrid(IRenderer &renderer, glm::vec2 renderCam,
+                                             int x0, int y0, int x1, int y1);
+
+    /// Rebuild one layer group of a chunk from the current layer data
+    void RebuildChunk(IRenderer &renderer, TileChunk &chunk, int group, std::span<const size_t> layers,
+                      int tx0, int ty0, int tx1, int ty1);
+
+    /// Flag the chunk containing tile (x, y) for rebuild and stamp its block
+    void MarkChunkDirty(int x, int y);
+
+    /// Give the block holding tile (x, y) a new revision stamp
+    void StampBlock(int x, int y);
+
+    /// StampBlock() the tile holding a particle zone's top-left corner (the one UnloadRegion() goes by)
+    void StampZoneBlock(const ParticleZone &zone);
+
+    /// Size the block grid to the map and stamp every block
+    void ResetBlockRevisions();
+
+    /// Append (x, y) to the walkability history and bump the version
+    void RecordNavigationChange(int x, int y);
+
+    /// Drop the walkability history so every consumer rebuilds from scratch
+    void ResetNavigationHistory();
+
+    /// Rewrite the baked animated quads of a chunk whose frame changed
+    void PatchChunkAnimations(IRenderer &renderer, TileChunk &chunk, int group);
+
+    /// Current frame tile ID of an animation (evaluated in UpdateAnimations())
+    int GetAnimationFrame(int animId) const
+    {
+        if (animId < static_cast<int>(m_AnimationFrames.size()))
+            return m_AnimationFrames[animId];
+        return m_AnimatedTiles[animId].GetFrameAtTime(m_AnimationTime);
+    }
+
+    /// Rebuild m_AnimatedCells from the tile layers
+    void RebuildAnimatedCells();
+
+    /// Move (x, y, layer) from one animation's cell list to another's (-1 = none)
+    void MoveAnimatedCell(int x, int y, int layer, int oldAnimId, int newAnimId);
+
+    /// True if (x, y) on layerIdx currently belongs in the Y-sort index
+    bool IsYSortIndexCell(int x, int y, size_t layerIdx) const;
+
+    /// Rebuild the whole Y-sort index from the tile layers
+    void RebuildYSortIndex() const;
+
+    /// Re-index the Y-sort run(s) touching (x, y) in one column after an edit
+    void UpdateYSortColumn(int x, int y, size_t layerIdx);
+
+    /// Rebuild the whole structure index from the structure ID grids
+    void RebuildStructureIndex() const;
+
+    /// Re-evaluate the structure membership of (x, y) after an edit
+    void UpdateStructureCell(int x, int y);
+
+    /// Invalidate every structure-derived cache after a bulk change
+    void MarkStructuresDirty();
+
+    /// Flag the Y-sort index, animated cells, occluders and structure caches for rebuild
+    void MarkDerivedDataDirty();
+
+    /// Count one incremental update; true once the open bulk edit has switched to a rebuild
+    bool DeferToBulkRebuild();
+
+    /// MarkChunkDirty() every chunk overlapping a rectangle
+    void MarkRectDirty(int x, int y, int width, int height);
+
+    /// StampBlock() every block overlapping a rectangle (data the chunk meshes do not draw)
+    void StampRect(int x, int y, int width, int height);
+
+    /// Clip a rectangle to the map; false if nothing is left
+    bool ClipToMap(int &x, int &y, int &width, int &height) const;
+
+    /**
+     * @brief Run @p fn(rowBegin, rowEnd) over rows [y, y + height) in bands aligned to the layer chunks.
+     *
+     * Bands run on m_Jobs when the rectangle has PARALLEL_EDIT_MIN_CELLS
+     * cells; @p fn must then only write rows of its own band.
+     */
+    void ForEachRowBand(int y, int width, int height, const std::function<void(int, int)> &fn);
+
+    /// Draw the defined structures of one layer group in 3D mode
+    void RenderNoProjectionStructures(IRenderer &renderer, glm::vec2 renderCam, std::span<const size_t> layers,
+                                      int group, int x0, int y0, int x1, int y1);
 };
@@ -0,0 +1,362 @@
+#include "VulkanCommandRecorder.h"
+#include "VulkanCommon.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+VulkanCommandRecorder::~VulkanCommandRecorder()
+{
+    Shutdown();
+}
+
+void VulkanCommandRecorder::Init(VkDevice device, uint32_t queueFamily, uint32_t frameSlots,
+                                 VkPipelineLayout layout, VkShaderStageFlags pushStages, uint32_t pushConstantSize)
+{
+    m_Device = device;
+    m_Layout = layout;
+    m_PushStages = pushStages;
+    m_PushConstantSize = pushConstantSize;
+    m_FrameSlots = frameSlots;
+
+    // Secondaries live for one frame, so pools are reset as a whole instead
+    // of buffer by buffer
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = queueFamily;
+
+    m_LanePools.resize(static_cast<size_t>(frameSlots) * MAX_LANES);
+    for (LanePool &lane : m_LanePools)
+    {
+        VK_CHECK(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &lane.pool));
+    }
+}
+
+void VulkanCommandRecorder::Shutdown()
+{
+    if (m_Device == VK_NULL_HANDLE)
+        return;
+
+    // Destroying a pool frees the buffers allocated from it
+    for (LanePool &lane : m_LanePools)
+    {
+        if (lane.pool != VK_NULL_HANDLE)
+        {
+            vkDestroyCommandPool(m_Device, lane.pool, nullptr);
+        }
+    }
+    m_LanePools.clear();
+    BeginFrame();
+    m_Device = VK_NULL_HANDLE;
+}
+
+void VulkanCommandRecorder::BeginFrame()
+{
+    m_Commands.clear();
+    m_PushData.clear();
+    m_Segments.clear();
+    m_Passes.clear();
+    m_DrawCount = 0;
+    m_PassOpen = false;
+}
+
+void VulkanCommandRecorder::BeginPass(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent,
+                                      const VkViewport &viewport)
+{
+    if (m_PassOpen)
+    {
+        EndPass();
+    }
+
+    Pass pass;
+    pass.renderPass = renderPass;
+    pass.framebuffer = framebuffer;
+    pass.extent = extent;
+    pass.firstSegment = m_Segments.size();
+    pass.endSegment = m_Segments.size();
+    m_Passes.push_back(pass);
+    m_PassOpen = true;
+    OpenSegment(viewport);
+}
+
+void VulkanCommandRecorder::EndPass()
+{
+    if (!m_PassOpen)
+        return;
+
+    m_Passes.back().endSegment = m_Segments.size();
+    m_PassOpen = false;
+}
+
+void VulkanCommandRecorder::OpenSegment(const VkViewport &viewport)
+{
+    Segment segment;
+    segment.pass = m_Passes.size() - 1;
+    segment.viewport = viewport;
+    segment.firstCommand = m_Commands.size();
+    segment.endCommand = m_Commands.size();
+    m_Segments.push_back(segment);
+}
+
+void VulkanCommandRecorder::SetViewport(const VkViewport &viewport)
+{
+    if (!m_PassOpen)
+        return;
+
+    // An empty segment just takes the new viewport instead of leaving a gap
+    Segment &current = m_Segments.back();
+    if (current.endCommand == current.firstCommand)
+    {
+        current.viewport = viewport;
+        return;
+    }
+    OpenSegment(viewport);
+}
+
+void VulkanCommandRecorder::Split()
+{
+    if (!m_PassOpen)
+        return;
+
+    const Segment &current = m_Segments.back();
+    if (current.endCommand != current.firstCommand)
+    {
+        OpenSegment(current.viewport);
+    }
+}
+
+bool VulkanCommandRecorder::Draw(VkPipeline pipeline, VkDescriptorSet descriptorSet, VkBuffer vertexBuffer,
+                                 uint32_t firstVertex, uint32_t vertexCount, const void *pushConstants)
+{
+    if (!m_PassOpen)
+        return false;
+
+    if (m_Segments.back().drawCount >= MAX_SEGMENT_DRAWS)
+    {
+        Split();
+    }
+
+    Command command;
+    command.pipeline = pipeline;
+    command.descriptorSet = descriptorSet;
+    command.vertexBuffer = vertexBuffer;
+    command.first = firstVertex;
+    command.count = vertexCount;
+    command.pushOffset = m_PushData.size();
+    const unsigned char *bytes = static_cast<const unsigned char *>(pushConstants);
+    m_PushData.insert(m_PushData.end(), bytes, bytes + m_PushConstantSize);
+    m_Commands.push_back(command);
+
+    Segment &segment = m_Segments.back();
+    segment.endCommand = m_Commands.size();
+    ++segment.drawCount;
+    ++m_DrawCount;
+    return true;
+}
+
+void VulkanCommandRecorder::WriteTimestamp(VkPipelineStageFlagBits stage, VkQueryPool pool, uint32_t query)
+{
+    if (!m_PassOpen)
+        return;
+
+    Command command;
+    command.queryPool = pool;
+    command.stage = stage;
+    command.first = query;
+    m_Commands.push_back(command);
+    m_Segments.back().endCommand = m_Commands.size();
+}
+
+void VulkanCommandRecorder::EncodeSegment(VkCommandBuffer commandBuffer, const Segment &segment) const
+{
+    const Pass &pass = m_Passes[segment.pass];
+    vkCmdSetViewport(commandBuffer, 0, 1, &segment.viewport);
+
+    // Scissor stays the full target so an overhanging viewport is clipped, not rejected
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = pass.extent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    // Every segment starts from nothing bound, so only changes are written.
+    // All pipelines share m_Layout, so sets and push constants survive a
+    // pipeline switch.
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkDescriptorSet boundSet = VK_NULL_HANDLE;
+    VkBuffer boundBuffer = VK_NULL_HANDLE;
+    const unsigned char *pushed = nullptr;
+    for (size_t i = segment.firstCommand; i < segment.endCommand; ++i)
+    {
+        const Command &command = m_Commands[i];
+        if (command.pipeline == VK_NULL_HANDLE)
+        {
+            vkCmdWriteTimestamp(commandBuffer, command.stage, command.queryPool, command.first);
+            continue;
+        }
+
+        if (command.pipeline != boundPipeline)
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, command.pipeline);
+            boundPipeline = command.pipeline;
+        }
+        const unsigned char *push = m_PushData.data() + command.pushOffset;
+        if (!pushed || std::memcmp(push, pushed, m_PushConstantSize) != 0)
+        {
+            vkCmdPushConstants(commandBuffer, m_Layout, m_PushStages, 0, m_PushConstantSize, push);
+            pushed = push;
+        }
+        if (command.descriptorSet != boundSet)
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_Layout, 0, 1,
+                                    &command.descriptorSet, 0, nullptr);
+            boundSet = command.descriptorSet;
+        }
+        if (command.vertexBuffer != boundBuffer)
+        {
+            VkDeviceSize offsets[] = {0};
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &command.vertexBuffer, offsets);
+            boundBuffer = command.vertexBuffer;
+        }
+        vkCmdDraw(commandBuffer, command.count, 1, command.first, 0);
+    }
+}
+
+bool VulkanCommandRecorder::EncodeSecondary(LanePool &lane, Segment &segment)
+{
+    WILD_PROFILE_ZONE("Encode Secondary");
+    if (lane.used == lane.buffers.size())
+    {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = lane.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+        VkCommandBuffer buffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(m_Device, &allocInfo, &buffer) != VK_SUCCESS)
+            return false;
+        lane.buffers.push_back(buffer);
+    }
+    VkCommandBuffer commandBuffer = lane.buffers[lane.used++];
+
+    const Pass &pass = m_Passes[segment.pass];
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = pass.renderPass;
+    inheritance.subpass = 0;
+    inheritance.framebuffer = pass.framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritance;
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+        return false;
+
+    EncodeSegment(commandBuffer, segment);
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+        return false;
+
+    segment.secondary = commandBuffer;
+    return true;
+}
+
+void VulkanCommandRecorder::Encode(VkCommandBuffer primary, uint32_t frameSlot, JobSystem *jobs)
+{
+    WILD_PROFILE_ZONE("Encode Commands");
+    EndPass();
+    m_SecondaryCount = 0;
+
+    // Segments that ended up empty (a split right before EndPass()) are skipped
+    std::vector<size_t> &work = m_Work;
+    work.clear();
+    for (size_t i = 0; i < m_Segments.size(); ++i)
+    {
+        if (m_Segments[i].endCommand != m_Segments[i].firstCommand)
+            work.push_back(i);
+    }
+
+    const unsigned workers = jobs ? jobs->GetWorkerCount() : 0;
+    const bool parallel = workers > 0 && m_DrawCount >= PARALLEL_MIN_DRAWS && frameSlot < m_FrameSlots;
+    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
+
+    auto beginPass = [&](const Pass &pass, VkSubpassContents contents)
+    {
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = pass.renderPass;
+        renderPassInfo.framebuffer = pass.framebuffer;
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = pass.extent;
+        renderPassInfo.clearValueCount = 1;
+        renderPassInfo.pClearValues = &clearColor;
+        vkCmdBeginRenderPass(primary, &renderPassInfo, contents);
+    };
+
+    if (!parallel)
+    {
+        for (const Pass &pass : m_Passes)
+        {
+            beginPass(pass, VK_SUBPASS_CONTENTS_INLINE);
+            for (size_t i = pass.firstSegment; i < pass.endSegment; ++i)
+            {
+                if (m_Segments[i].endCommand != m_Segments[i].firstCommand)
+                    EncodeSegment(primary, m_Segments[i]);
+            }
+            vkCmdEndRenderPass(primary);
+        }
+        return;
+    }
+
+    // The slot's previous secondaries finished with its fence
+    LanePool *pools = &m_LanePools[static_cast<size_t>(frameSlot) * MAX_LANES];
+    const size_t lanes = std::min<size_t>({static_cast<size_t>(workers) + 1, MAX_LANES, work.size()});
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        vkResetCommandPool(m_Device, pools[lane].pool, 0);
+        pools[lane].used = 0;
+        pools[lane].failed = false;
+    }
+
+    // Lane L takes every lanes-th segment, so neighbouring segments (often
+    // similar in size) land on different threads
+    jobs->ParallelFor(lanes, 1, [&](size_t begin, size_t end)
+    {
+        for (size_t lane = begin; lane < end; ++lane)
+        {
+            for (size_t w = lane; w < work.size() && !pools[lane].failed; w += lanes)
+            {
+                pools[lane].failed = !EncodeSecondary(pools[lane], m_Segments[work[w]]);
+            }
+        }
+    });
+
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        if (pools[lane].failed)
+        {
+            std::cerr << "Error: Failed to encode secondary command buffer on lane " << lane
+                      << ", its draws are dropped this frame" << std::endl;
+        }
+    }
+
+    for (const Pass &pass : m_Passes)
+    {
+        beginPass(pass, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        m_Execute.clear();
+        for (size_t i = pass.firstSegment; i < pass.endSegment; ++i)
+        {
+            if (m_Segments[i].secondary != VK_NULL_HANDLE)
+                m_Execute.push_back(m_Segments[i].secondary);
+        }
+        if (!m_Execute.empty())
+        {
+            vkCmdExecuteCommands(primary, static_cast<uint32_t>(m_Execute.size()), m_Execute.data());
+        }
+        vkCmdEndRenderPass(primary);
+        m_SecondaryCount += m_Execute.size();
+    }
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @class VulkanCommandRecorder
+ * @brief Deferred draw list encoded into secondary command buffers in parallel.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * VulkanRenderer used to write every bind and draw straight into the
+ * frame's primary command buffer, so encoding cost grew with the frame on
+ * one thread. Draws are now appended here as small records and turned into
+ * Vulkan commands once, at the end of the frame:
+ *
+ * @code
+ *   BeginPass() --> Draw() Draw() | Split() | Draw() ... --> EndPass() --> ... --> Encode()
+ *                   [ segment 0 ]           [ segment 1 ]                            |
+ *                                                                  segments are encoded on
+ *   primary:  BeginRenderPass(SECONDARY) -> vkCmdExecuteCommands(0, 1, ...) -> EndRenderPass
+ * @endcode
+ *
+ * @par Segments
+ * A segment is a run of draws that can be encoded on its own: it sets its
+ * own viewport and scissor and rebinds whatever it uses. The renderer
+ * splits at GPU timer boundaries, which already bracket the independent
+ * passes (sky, tile layers, Y-sorted sprites, particles, UI), and segments
+ * are also split every MAX_SEGMENT_DRAWS draws so one long pass still
+ * spreads over several workers.
+ *
+ * @par Lanes
+ * Encode() runs one job per lane. A lane owns one command pool per frame
+ * slot and encodes segments lane, lane + lanes, ... into secondary buffers
+ * allocated from it, so no pool is ever touched by two threads. Pools are
+ * reset wholesale when their frame slot comes round again. The primary
+ * then executes the secondaries in recording order.
+ *
+ * @par Small Frames
+ * Without a JobSystem, without workers or below PARALLEL_MIN_DRAWS draws,
+ * Encode() writes the same commands inline into the primary buffer, which
+ * is cheaper than waking workers for a title screen.
+ *
+ * @par Thread Safety
+ * Recording calls and Encode() must come from one thread (the render
+ * thread). Encode() uses the JobSystem internally and returns when every
+ * lane has finished.
+ *
+ * @see VulkanRenderer::EndFrame(), JobSystem::ParallelFor()
+ */
+class VulkanCommandRecorder
+{
+public:
+    /// @brief Draws after which a segment is closed and the next one started.
+    static constexpr size_t MAX_SEGMENT_DRAWS = 256;
+
+    /// @brief Frames with fewer draws are encoded inline into the primary buffer.
+    static constexpr size_t PARALLEL_MIN_DRAWS = 128;
+
+    /// @brief Most encoding lanes (and command pools per frame slot).
+    static constexpr uint32_t MAX_LANES = 8;
+
+    VulkanCommandRecorder() = default;
+    ~VulkanCommandRecorder();
+
+    VulkanCommandRecorder(const VulkanCommandRecorder &) = delete;
+    VulkanCommandRecorder &operator=(const VulkanCommandRecorder &) = delete;
+
+    /**
+     * @brief Create the per-lane command pools.
+     *
+     * @param device           Vulkan logical device.
+     * @param queueFamily      Family the primary buffers are submitted to.
+     * @param frameSlots       Frames in flight; each gets its own pools.
+     * @param layout           Pipeline layout every recorded draw uses.
+     * @param pushStages       Stages the push constant block is visible to.
+     * @param pushConstantSize Bytes copied per Draw() from its push constants.
+     *
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    void Init(VkDevice device, uint32_t queueFamily, uint32_t frameSlots, VkPipelineLayout layout,
+              VkShaderStageFlags pushStages, uint32_t pushConstantSize);
+
+    /// @brief Destroy the command pools. The device must be idle.
+    void Shutdown();
+
+    /// @brief Forget everything recorded for the previous frame.
+    void BeginFrame();
+
+    /**
+     * @brief Open a render pass instance; later draws go into it.
+     *
+     * The scissor of every segment in the pass covers @p extent.
+     *
+     * @param viewport Viewport of the first segment.
+     */
+    void BeginPass(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent,
+                   const VkViewport &viewport);
+
+    /// @brief Close the open render pass instance.
+    void EndPass();
+
+    /// @brief True between BeginPass() and EndPass().
+    bool IsPassOpen() const { return m_PassOpen; }
+
+    /// @brief Start a new segment that uses @p viewport.
+    void SetViewport(const VkViewport &viewport);
+
+    /// @brief Close the current segment if it has anything in it.
+    void Split();
+
+    /**
+     * @brief Record one non-indexed draw.
+     *
+     * @param pushConstants pushConstantSize bytes, copied.
+     * @return False (nothing recorded) when no pass is open.
+     */
+    bool Draw(VkPipeline pipeline, VkDescriptorSet descriptorSet, VkBuffer vertexBuffer,
+              uint32_t firstVertex, uint32_t vertexCount, const void *pushConstants);
+
+    /// @brief Record a vkCmdWriteTimestamp in draw order.
+    void WriteTimestamp(VkPipelineStageFlagBits stage, VkQueryPool pool, uint32_t query);
+
+    /**
+     * @brief Write every recorded pass into @p primary.
+     *
+     * @p primary must be recording and outside a render pass. The pools of
+     * @p frameSlot are reset first, so its previous submission must have
+     * finished.
+     *
+     * @param jobs Worker threads for the secondaries, or nullptr to encode inline.
+     */
+    void Encode(VkCommandBuffer primary, uint32_t frameSlot, JobSystem *jobs);
+
+    /// @brief Draws recorded since BeginFrame().
+    size_t GetDrawCount() const { return m_DrawCount; }
+
+    /// @brief Secondary command buffers the last Encode() executed (0 when inline).
+    size_t GetSecondaryCount() const { return m_SecondaryCount; }
+
+private:
+    /// @brief One recorded command.
+    struct Command
+    {
+        VkPipeline pipeline = VK_NULL_HANDLE;          ///< VK_NULL_HANDLE for a timestamp.
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VkQueryPool queryPool = VK_NULL_HANDLE;        ///< Timestamps only.
+        VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        uint32_t first = 0;                            ///< First vertex, or query index.
+        uint32_t count = 0;                            ///< Vertex count.
+        size_t pushOffset = 0;                         ///< Into m_PushData.
+    };
+
+    /// @brief Commands [firstCommand, endCommand) with their dynamic state.
+    struct Segment
+    {
+        size_t pass = 0;
+        VkViewport viewport{};
+        size_t firstCommand = 0;
+        size_t endCommand = 0;
+        size_t drawCount = 0;
+        VkCommandBuffer secondary = VK_NULL_HANDLE;    ///< Set by Encode().
+    };
+
+    struct Pass
+    {
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        VkExtent2D extent{};
+        size_t firstSegment = 0;
+        size_t endSegment = 0;
+    };
+
+    /// @brief A command pool owned by one lane for one frame slot.
+    struct LanePool
+    {
+        VkCommandPool pool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> buffers;          ///< Allocated so far, reused after reset.
+        size_t used = 0;
+        bool failed = false;                           ///< An encode on this lane hit a Vulkan error.
+    };
+
+    /// @brief Open a new empty segment in the open pass.
+    void OpenSegment(const VkViewport &viewport);
+
+    /// @brief Write @p segment's dynamic state and commands into @p commandBuffer.
+    void EncodeSegment(VkCommandBuffer commandBuffer, const Segment &segment) const;
+
+    /// @brief Encode @p segment into a secondary from @p lane; false on a Vulkan error.
+    bool EncodeSecondary(LanePool &lane, Segment &segment);
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkPipelineLayout m_Layout = VK_NULL_HANDLE;
+    VkShaderStageFlags m_PushStages = 0;
+    uint32_t m_PushConstantSize = 0;
+    uint32_t m_FrameSlots = 0;
+    std::vector<LanePool> m_LanePools;                 ///< frameSlot * MAX_LANES + lane.
+
+    /// @name Current Frame
+    /// @{
+    std::vector<Command> m_Commands;
+    std::vector<unsigned char> m_PushData;             ///< m_PushConstantSize bytes per draw.
+    std::vector<Segment> m_Segments;
+    std::vector<Pass> m_Passes;
+    std::vector<size_t> m_Work;                        ///< Non-empty segments, in order.
+    std::vector<VkCommandBuffer> m_Execute;            ///< Scratch for vkCmdExecuteCommands().
+    size_t m_DrawCount = 0;
+    size_t m_SecondaryCount = 0;
+    bool m_PassOpen = false;
+    /// @}
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+// Private helpers shared by the Vulkan backend's translation units.
+// Not part of any public interface; include it from .cpp files only.
+
+#include <vulkan/vulkan.h>
+
+#include <iostream>
+#include <stdexcept>
+
+/// Log the file, line and VkResult of a failed call and throw std::runtime_error
+#define VK_CHECK(x)                                                                                         \
+    do                                                                                                      \
+    {                                                                                                       \
+        VkResult result = x;                                                                                \
+        if (result != VK_SUCCESS)                                                                           \
+        {                                                                                                   \
+            std::cerr << "Vulkan error at " << __FILE__ << ":" << __LINE__ << " - " << result << std::endl; \
+            throw std::runtime_error("Vulkan operation failed");                                            \
+        }                                                                                                   \
+    } while (0)
@@ -1,4 +1,5 @@
 #include "VulkanRenderer.h"
+#include "VulkanCommon.h"
 #include "VulkanShader.h"
 #include "Texture.h"
 
@@ -44,38 +45,30 @@ static bool LoadVulkanLibrary()
 #define VK_USE_PLATFORM_WIN32_KHR
 #endif
 
-// Helper macros
-#define VK_CHECK(x)                                                                                          \
-    do                                                                                                       \
-    {                                                                                                        \
-        VkResult result = x;                                                                                 \
-        if (result != VK_SUCCESS)                                                                            \
-        {                                                                                                    \
-            std::cerr << "Vulkan error at " << __FILE__ << ":" << __LINE__ << " - " << result << std::endl;  \
-            throw std::runtime_error("Vulkan operation failed");                                             \
-        }                                                                                                    \
-    } while (0)
-
 VulkanRenderer::VulkanRenderer(GLFWwindow *window)
     : m_Instance(VK_NULL_HANDLE)
     , m_PhysicalDevice(VK_NULL_HANDLE)
     , m_Device(VK_NULL_HANDLE)
     , m_GraphicsQueue(VK_NULL_HANDLE)
     , m_PresentQueue(VK_NULL_HANDLE)
+    , m_TransferQueue(VK_NULL_HANDLE)
     , m_Surface(VK_NULL_HANDLE)
     , m_Swapchain(VK_NULL_HANDLE)
     , m_RenderPass(VK_NULL_HANDLE)
     , m_PipelineLayout(VK_NULL_HANDLE)
     , m_GraphicsPipeline(VK_NULL_HANDLE)
+    , m_AdditivePipeline(VK_NULL_HANDLE)
+    , m_PipelineCache(VK_NULL_HANDLE)
+    , m_PipelineCacheLoadedSize(0)
     , m_CommandPool(VK_NULL_HANDLE)
     , m_CurrentFrame(0)
     , m_ImageIndex(0)
     , m_Window(window)
     , m_GraphicsFamily(UINT32_MAX)
     , m_PresentFamily(UINT32_MAX)
-    , m_VertexBuffers{VK_NULL_HANDLE, VK_NULL_HANDLE}
-    , m_VertexBufferMemories{VK_NULL_HANDLE, VK_NULL_HANDLE}
-    , m_VertexBuffersMapped{nullptr, nullptr}
+    , m_VertexBuffers{}
+    , m_VertexBufferMemories{}
+    , m_VertexBuffersMapped{}
     , m_IndexBuffer(VK_NULL_HANDLE)
     , m_IndexBufferMemory(VK_NULL_HANDLE)
     , m_VertexBufferSize(0)
@@ -138,12 +131,15 @@ void VulkanRenderer::Init()
         std::cout << "Image views created" << std::endl;
         std::cout.flush();
         CreateRenderPass();
+        CreateLowResRenderPass();
         std::cout << "Init() step 7 complete: Render pass created" << std::endl;
         std::cout.flush();
 
         std::cout << "Init() step 8: Creating graphics pipeline..." << std::endl;
         std::cout.flush();
+        LoadPipelineCache();
         CreateGraphicsPipeline();
+        SavePipelineCache();
         std::cout << "Init() step 8 complete: Graphics pipeline created" << std::endl;
         std::cout.flush();
         CreateFramebuffers();
@@ -152,6 +148,8 @@ void VulkanRenderer::Init()
         CreateCommandPool();
         std::cout << "Command pool created" << std::endl;
         std::cout.flush();
+        m_Uploads.Init(m_Device, m_PhysicalDevice, m_GraphicsFamily, m_TransferFamily, m_TransferQueue,
+                       MAX_FRAMES_IN_FLIGHT);
         CreateBuffers();
         std::cout << "Buffers created" << std::endl;
         std::cout.flush();
@@ -168,11 +166,15 @@ void VulkanRenderer::Init()
         std::cout << "Font loading complete (Vulkan)" << std::endl;
         std::cout.flush();
         CreateCommandBuffers();
+        m_Recorder.Init(m_Device, m_GraphicsFamily, MAX_FRAMES_IN_FLIGHT, m_PipelineLayout,
+                        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                        static_cast<uint32_t>(sizeof(SpritePushConstants)));
         std::cout << "Command buffers created" << std::endl;
         std::cout.flush();
         CreateSyncObjects();
         std::cout << "Sync objects created" << std::endl;
         std::cout.flush();
+        CreateTimestampPool();
         std::cout << "Vulkan renderer initialized successfully!" << std::endl;
         std::cout.flush();
     }
@@ -212,6 +214,27 @@ void VulkanRenderer::Shutdown()
             }
         }
 
+        // Device is idle, static meshes (live or retired) can be freed directly
+        for (StaticMesh &mesh : m_StaticMeshes)
+        {
+            FreeStaticMeshBuffers(mesh);
+        }
+        m_StaticMeshes.clear();
+        m_FreeStaticMeshes.clear();
+        for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        {
+            for (StaticMesh &mesh : m_RetiredStaticMeshes[i])
+            {
+                FreeStaticMeshBuffers(mesh);
+            }
+            m_RetiredStaticMeshes[i].clear();
+            FreeRetiredTextures(i);
+        }
+
+        // Device is idle, so every upload batch has completed
+        m_Uploads.Shutdown();
+        m_Recorder.Shutdown();
+
         // Cleanup uploaded textures (Texture objects that hold Vulkan resources)
         // This must happen before destroying the device
         for (Texture *tex : m_UploadedTextures)
@@ -272,33 +295,41 @@ void VulkanRenderer::Shutdown()
             vkFreeMemory(m_Device, m_WhiteTextureImageMemory, nullptr);
         }
 
-        // Cleanup glyph textures
-        // Skip glyphs that use the white texture as fallback (avoid double-destroy)
-        for (auto &[c, glyph] : m_Glyphs)
+        // Cleanup font atlas
+        if (m_FontAtlas)
         {
-            if (glyph.imageView != VK_NULL_HANDLE && glyph.imageView != m_WhiteTextureImageView)
-            {
-                vkDestroyImageView(m_Device, glyph.imageView, nullptr);
-            }
-            if (glyph.image != VK_NULL_HANDLE)
-            {
-                vkDestroyImage(m_Device, glyph.image, nullptr);
-            }
-            if (glyph.memory != VK_NULL_HANDLE)
-            {
-                vkFreeMemory(m_Device, glyph.memory, nullptr);
-            }
+            m_FontAtlas->DestroyVulkanTexture(m_Device);
+            m_FontAtlas.reset();
+        }
+        m_Glyphs.Clear();
+        m_TextMeshes.Clear();
+
+        // Cleanup low-res target (its descriptor set goes with the pool below)
+        DestroyLowResTarget();
+        m_LowResDescriptorSet = VK_NULL_HANDLE;
+        if (m_LowResRenderPass != VK_NULL_HANDLE)
+        {
+            vkDestroyRenderPass(m_Device, m_LowResRenderPass, nullptr);
+            m_LowResRenderPass = VK_NULL_HANDLE;
         }
-        m_Glyphs.clear();
 
         // Cleanup descriptor set cache (descriptor sets are freed when pool is destroyed)
-        m_DescriptorSetCache.clear();
+        m_DescriptorSetCache.Clear();
+        m_TransientDescriptorSets.clear();
 
-        // Cleanup descriptor pool
+        // Cleanup descriptor pools
         if (m_DescriptorPool != VK_NULL_HANDLE)
         {
             vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr);
         }
+        for (VkDescriptorPool &pool : m_TransientDescriptorPools)
+        {
+            if (pool != VK_NULL_HANDLE)
+            {
+                vkDestroyDescriptorPool(m_Device, pool, nullptr);
+                pool = VK_NULL_HANDLE;
+            }
+        }
         if (m_DescriptorSetLayout != VK_NULL_HANDLE)
         {
             vkDestroyDescriptorSetLayout(m_Device, m_DescriptorSetLayout, nullptr);
@@ -322,6 +353,17 @@ void VulkanRenderer::Shutdown()
             vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
         }
 
+        if (m_TimestampPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(m_Device, m_TimestampPool, nullptr);
+            m_TimestampPool = VK_NULL_HANDLE;
+        }
+        for (GpuTimerFrame &frame : m_GpuTimerFrames)
+        {
+            frame.Reset();
+        }
+        m_GpuTimerResults.clear();
+
         for (auto framebuffer : m_SwapchainFramebuffers)
         {
             vkDestroyFramebuffer(m_Device, framebuffer, nullptr);
@@ -331,6 +373,15 @@ void VulkanRenderer::Shutdown()
         {
             vkDestroyPipeline(m_Device, m_GraphicsPipeline, nullptr);
         }
+        if (m_AdditivePipeline != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(m_Device, m_AdditivePipeline, nullptr);
+        }
+        if (m_PipelineCache != VK_NULL_HANDLE)
+        {
+            vkDestroyPipelineCache(m_Device, m_PipelineCache, nullptr);
+            m_PipelineCache = VK_NULL_HANDLE;
+        }
         if (m_PipelineLayout != VK_NULL_HANDLE)
         {
             vkDestroyPipelineLayout(m_Device, m_PipelineLayout, nullptr);
@@ -605,6 +656,20 @@ void VulkanRenderer::PickPhysicalDevice()
         if (m_GraphicsFamily != UINT32_MAX && m_PresentFamily != UINT32_MAX)
         {
             m_PhysicalDevice = device;
+
+            // Prefer a transfer-only family (DMA engine) so texture uploads
+            // overlap rendering; otherwise upload on the graphics queue
+            m_TransferFamily = m_GraphicsFamily;
+            for (uint32_t family = 0; family < queueFamilyCount; ++family)
+            {
+                VkQueueFlags flags = queueFamilies[family].queueFlags;
+                if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) &&
+                    !(flags & VK_QUEUE_COMPUTE_BIT) && queueFamilies[family].queueCount > 0)
+                {
+                    m_TransferFamily = family;
+                    break;
+                }
+            }
             break;
         }
     }
@@ -618,7 +683,7 @@ void VulkanRenderer::PickPhysicalDevice()
 void VulkanRenderer::CreateLogicalDevice()
 {
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
-    std::set<uint32_t> uniqueQueueFamilies = {m_GraphicsFamily, m_PresentFamily};
+    std::set<uint32_t> uniqueQueueFamilies = {m_GraphicsFamily, m_PresentFamily, m_TransferFamily};
 
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies)
@@ -655,6 +720,7 @@ void VulkanRenderer::CreateLogicalDevice()
 
     vkGetDeviceQueue(m_Device, m_GraphicsFamily, 0, &m_GraphicsQueue);
     vkGetDeviceQueue(m_Device, m_PresentFamily, 0, &m_PresentQueue);
+    vkGetDeviceQueue(m_Device, m_TransferFamily, 0, &m_TransferQueue);
 }
 
 void VulkanRenderer::CreateSwapchain()
@@ -684,15 +750,27 @@ void VulkanRenderer::CreateSwapchain()
     std::vector<VkPresentModeKHR> presentModes(presentModeCount);
     vkGetPhysicalDeviceSurfacePresentModesKHR(m_PhysicalDevice, m_Surface, &presentModeCount, presentModes.data());
 
+    // FIFO is the only mode every surface has to support
+    VkPresentModeKHR wantedMode = VK_PRESENT_MODE_FIFO_KHR;
+    if (m_RequestedPresentMode == PresentMode::Mailbox)
+    {
+        wantedMode = VK_PRESENT_MODE_MAILBOX_KHR;
+    }
+    else if (m_RequestedPresentMode == PresentMode::Immediate)
+    {
+        wantedMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+    }
+
     VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR;
     for (const auto &availablePresentMode : presentModes)
     {
-        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+        if (availablePresentMode == wantedMode)
         {
             presentMode = availablePresentMode;
             break;
         }
     }
+    m_PresentMode = presentMode;
 
     if (capabilities.currentExtent.width != UINT32_MAX)
     {
@@ -831,6 +909,53 @@ void VulkanRenderer::CreateGraphicsPipeline()
 
     // Note: Shader stage info will be created after shader modules are loaded
 
+    // Push constant range for matrices and uniforms
+    // Vertex shader: mat4 projection (offset 0, 64 bytes), mat4 model (offset 64, 64 bytes) = 128 bytes total
+    // Fragment shader: vec3 spriteColor (offset 128, 12 bytes), bool useColorOnly (offset 140, 4 bytes), vec4 colorOnly (offset 144, 16 bytes) = 32 bytes
+    // Total: 160 bytes (vec3 is 12 bytes, but vec4 needs 16-byte alignment, so we use 160 total)
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(SpritePushConstants); // 128 for matrices, 64 for fragment params, 32 for GPU perspective
+
+    // Descriptor set layout for textures
+    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
+    samplerLayoutBinding.binding = 0;
+    samplerLayoutBinding.descriptorCount = 1;
+    samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    samplerLayoutBinding.pImmutableSamplers = nullptr;
+    samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &samplerLayoutBinding;
+
+    VK_CHECK(vkCreateDescriptorSetLayout(m_Device, &layoutInfo, nullptr, &m_DescriptorSetLayout));
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    VK_CHECK(vkCreatePipelineLayout(m_Device, &pipelineLayoutInfo, nullptr, &m_PipelineLayout));
+
+    VkPipeline pipelines[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    if (!BuildSpritePipelines(pipelines))
+    {
+        throw std::runtime_error("Failed to create graphics pipeline!");
+    }
+    m_GraphicsPipeline = pipelines[0];
+    m_AdditivePipeline = pipelines[1];
+
+    std::cout << "CreateGraphicsPipeline() complete!" << std::endl;
+    std::cout.flush();
+}
+
+bool VulkanRenderer::BuildSpritePipelines(VkPipeline outPipelines[2])
+{
     // Vertex input
     VkVertexInputBindingDescription bindingDescription{};
     bindingDescription.binding = 0;
@@ -900,8 +1025,10 @@ void VulkanRenderer::CreateGraphicsPipeline()
     colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
     colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
     colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    // Alpha accumulates "over" so a target cleared to alpha 1 stays opaque;
+    // the low-res pass samples it back with this same pipeline
     colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
     colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
 
     VkPipelineColorBlendStateCreateInfo colorBlending{};
@@ -910,48 +1037,23 @@ void VulkanRenderer::CreateGraphicsPipeline()
     colorBlending.attachmentCount = 1;
     colorBlending.pAttachments = &colorBlendAttachment;
 
-    // Push constant range for matrices and uniforms
-    // Vertex shader: mat4 projection (offset 0, 64 bytes), mat4 model (offset 64, 64 bytes) = 128 bytes total
-    // Fragment shader: vec3 spriteColor (offset 128, 12 bytes), bool useColorOnly (offset 140, 4 bytes), vec4 colorOnly (offset 144, 16 bytes) = 32 bytes
-    // Total: 160 bytes (vec3 is 12 bytes, but vec4 needs 16-byte alignment, so we use 160 total)
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-    pushConstantRange.offset = 0;
-    pushConstantRange.size = 192; // 128 for vertex (2 mat4), 64 for fragment (vec3 + float + vec4 + float + padding + vec3)
-
-    // Descriptor set layout for textures
-    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-    samplerLayoutBinding.binding = 0;
-    samplerLayoutBinding.descriptorCount = 1;
-    samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    samplerLayoutBinding.pImmutableSamplers = nullptr;
-    samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-    VkDescriptorSetLayoutCreateInfo layoutInfo{};
-    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = 1;
-    layoutInfo.pBindings = &samplerLayoutBinding;
-
-    VK_CHECK(vkCreateDescriptorSetLayout(m_Device, &layoutInfo, nullptr, &m_DescriptorSetLayout));
-
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &m_DescriptorSetLayout;
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    // Additive variant (particles, glows): src * alpha + dst, matching
+    // glBlendFunc(GL_SRC_ALPHA, GL_ONE) in the OpenGL renderer
+    VkPipelineColorBlendAttachmentState additiveBlendAttachment = colorBlendAttachment;
+    additiveBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
 
-    VK_CHECK(vkCreatePipelineLayout(m_Device, &pipelineLayoutInfo, nullptr, &m_PipelineLayout));
+    VkPipelineColorBlendStateCreateInfo additiveBlending = colorBlending;
+    additiveBlending.pAttachments = &additiveBlendAttachment;
 
-    std::cout << "CreateGraphicsPipeline() step 2: Loading shaders..." << std::endl;
+    std::cout << "BuildSpritePipelines() step 2: Loading shaders..." << std::endl;
     std::cout.flush();
 
     // Load shaders
     std::vector<uint32_t> vertShaderCode = VulkanShader::GetVertexShaderSPIRV();
     std::vector<uint32_t> fragShaderCode = VulkanShader::GetFragmentShaderSPIRV();
 
-    std::cout << "CreateGraphicsPipeline() step 2: Vertex shader size: " << vertShaderCode.size() << " words" << std::endl;
-    std::cout << "CreateGraphicsPipeline() step 2: Fragment shader size: " << fragShaderCode.size() << " words" << std::endl;
+    std::cout << "BuildSpritePipelines() step 2: Vertex shader size: " << vertShaderCode.size() << " words" << std::endl;
+    std::cout << "BuildSpritePipelines() step 2: Fragment shader size: " << fragShaderCode.size() << " words" << std::endl;
     std::cout.flush();
 
     if (vertShaderCode.empty() || fragShaderCode.empty())
@@ -960,19 +1062,18 @@ void VulkanRenderer::CreateGraphicsPipeline()
         std::cerr << "Please compile shaders: glslangValidator -V shaders/sprite.vert -o shaders/sprite.vert.spv" << std::endl;
         std::cerr << "                      glslangValidator -V shaders/sprite.frag -o shaders/sprite.frag.spv" << std::endl;
         std::cerr << "Or run: compile-shaders.bat" << std::endl;
-        // Don't continue without shaders - throw exception
-        throw std::runtime_error("Vulkan shaders not found. Please compile shaders first.");
+        return false;
     }
 
-    std::cout << "CreateGraphicsPipeline() step 3: Creating shader modules..." << std::endl;
+    std::cout << "BuildSpritePipelines() step 3: Creating shader modules..." << std::endl;
     std::cout.flush();
 
     VkShaderModule vertShaderModule = VulkanShader::CreateShaderModule(m_Device, vertShaderCode);
-    std::cout << "CreateGraphicsPipeline() step 3: Vertex shader module created" << std::endl;
+    std::cout << "BuildSpritePipelines() step 3: Vertex shader module created" << std::endl;
     std::cout.flush();
 
     VkShaderModule fragShaderModule = VulkanShader::CreateShaderModule(m_Device, fragShaderCode);
-    std::cout << "CreateGraphicsPipeline() step 3: Fragment shader module created" << std::endl;
+    std::cout << "BuildSpritePipelines() step 3: Fragment shader module created" << std::endl;
     std::cout.flush();
 
     // Create shader stage info AFTER modules are created
@@ -990,7 +1091,7 @@ void VulkanRenderer::CreateGraphicsPipeline()
 
     VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
-    std::cout << "CreateGraphicsPipeline() step 3: Shader stages configured" << std::endl;
+    std::cout << "BuildSpritePipelines() step 3: Shader stages configured" << std::endl;
     std::cout.flush();
 
     // Enable dynamic viewport and scissor for Y-flip support
@@ -1018,7 +1119,14 @@ void VulkanRenderer::CreateGraphicsPipeline()
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-    std::cout << "CreateGraphicsPipeline() step 4: Validating pipeline state..." << std::endl;
+    // Build every blend variant up front so no draw ever waits on a compile
+    VkGraphicsPipelineCreateInfo additiveInfo = pipelineInfo;
+    additiveInfo.pColorBlendState = &additiveBlending;
+
+    VkGraphicsPipelineCreateInfo pipelineInfos[] = {pipelineInfo, additiveInfo};
+    VkPipeline pipelines[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+
+    std::cout << "BuildSpritePipelines() step 4: Validating pipeline state..." << std::endl;
     std::cout << "  - Device: " << (void *)m_Device << std::endl;
     std::cout << "  - RenderPass: " << (void *)m_RenderPass << std::endl;
     std::cout << "  - PipelineLayout: " << (void *)m_PipelineLayout << std::endl;
@@ -1027,12 +1135,18 @@ void VulkanRenderer::CreateGraphicsPipeline()
     std::cout << "  - Swapchain extent: " << m_SwapchainExtent.width << "x" << m_SwapchainExtent.height << std::endl;
     std::cout.flush();
 
-    std::cout << "CreateGraphicsPipeline() step 5: Calling vkCreateGraphicsPipelines()..." << std::endl;
+    std::cout << "BuildSpritePipelines() step 5: Calling vkCreateGraphicsPipelines()..." << std::endl;
     std::cout.flush();
 
-    VkResult pipelineResult = vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline);
+    VkResult pipelineResult = vkCreateGraphicsPipelines(m_Device, m_PipelineCache, 2, pipelineInfos, nullptr, pipelines);
     if (pipelineResult != VK_SUCCESS)
     {
+        for (VkPipeline pipeline : pipelines)
+        {
+            if (pipeline != VK_NULL_HANDLE)
+                vkDestroyPipeline(m_Device, pipeline, nullptr);
+        }
+
         std::cerr << "ERROR: vkCreateGraphicsPipelines failed with result: " << pipelineResult << std::endl;
         std::cerr.flush();
 
@@ -1055,18 +1169,166 @@ void VulkanRenderer::CreateGraphicsPipeline()
 
         vkDestroyShaderModule(m_Device, fragShaderModule, nullptr);
         vkDestroyShaderModule(m_Device, vertShaderModule, nullptr);
-        throw std::runtime_error("Failed to create graphics pipeline!");
+        return false;
     }
 
-    std::cout << "CreateGraphicsPipeline() step 4: Graphics pipeline created successfully" << std::endl;
+    outPipelines[0] = pipelines[0];
+    outPipelines[1] = pipelines[1];
+
+    std::cout << "BuildSpritePipelines() step 4: Graphics pipeline created successfully" << std::endl;
     std::cout.flush();
 
-    std::cout << "CreateGraphicsPipeline() step 5: Cleaning up shader modules..." << std::endl;
+    std::cout << "BuildSpritePipelines() step 5: Cleaning up shader modules..." << std::endl;
     std::cout.flush();
     vkDestroyShaderModule(m_Device, fragShaderModule, nullptr);
     vkDestroyShaderModule(m_Device, vertShaderModule, nullptr);
-    std::cout << "CreateGraphicsPipeline() complete!" << std::endl;
-    std::cout.flush();
+    return true;
+}
+
+namespace
+{
+// Prefix of the pipeline cache file. The driver validates its own header
+// too, but checking the key here lets a driver update or GPU swap fall back
+// to a cold cache instead of handing the driver foreign data
+struct PipelineCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t fileVersion;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+};
+
+constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x43505657; // "WVPC"
+constexpr uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+PipelineCacheFileHeader MakePipelineCacheHeader(VkPhysicalDevice physicalDevice)
+{
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    PipelineCacheFileHeader header{};
+    header.magic = PIPELINE_CACHE_MAGIC;
+    header.fileVersion = PIPELINE_CACHE_FILE_VERSION;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    return header;
+}
+} // namespace
+
+void VulkanRenderer::LoadPipelineCache()
+{
+    const PipelineCacheFileHeader expected = MakePipelineCacheHeader(m_PhysicalDevice);
+
+    std::vector<char> data;
+    std::ifstream file(PIPELINE_CACHE_PATH, std::ios::binary);
+    PipelineCacheFileHeader header{};
+    if (file && file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        bool matches = header.magic == expected.magic &&
+                       header.fileVersion == expected.fileVersion &&
+                       header.vendorID == expected.vendorID &&
+                       header.deviceID == expected.deviceID &&
+                       header.driverVersion == expected.driverVersion &&
+                       std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+        if (matches && header.dataSize > 0 && header.dataSize < (64ull << 20))
+        {
+            data.resize(static_cast<size_t>(header.dataSize));
+            if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+            {
+                data.clear();
+            }
+        }
+        else if (!matches)
+        {
+            std::cout << "Pipeline cache was written by another device or driver, rebuilding" << std::endl;
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    VkResult result = vkCreatePipelineCache(m_Device, &cacheInfo, nullptr, &m_PipelineCache);
+    if (result != VK_SUCCESS && !data.empty())
+    {
+        // Corrupt data, start from an empty cache
+        data.clear();
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        result = vkCreatePipelineCache(m_Device, &cacheInfo, nullptr, &m_PipelineCache);
+    }
+    if (result != VK_SUCCESS)
+    {
+        // Pipelines still build without a cache, just slower
+        std::cerr << "Warning: vkCreatePipelineCache failed: " << result << std::endl;
+        m_PipelineCache = VK_NULL_HANDLE;
+    }
+
+    m_PipelineCacheLoadedSize = data.size();
+    if (!data.empty())
+    {
+        std::cout << "Loaded pipeline cache (" << data.size() << " bytes)" << std::endl;
+    }
+}
+
+void VulkanRenderer::SavePipelineCache()
+{
+    if (m_PipelineCache == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, nullptr) != VK_SUCCESS || size == 0)
+    {
+        return;
+    }
+    // A warm start that compiled nothing new returns the data it was seeded with
+    if (size == m_PipelineCacheLoadedSize)
+    {
+        return;
+    }
+
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(m_Device, m_PipelineCache, &size, data.data()) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    PipelineCacheFileHeader header = MakePipelineCacheHeader(m_PhysicalDevice);
+    header.dataSize = size;
+
+    // Write to a temporary file first so a crash mid-write never leaves a
+    // truncated cache behind
+    const std::filesystem::path path(PIPELINE_CACHE_PATH);
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file ||
+            !file.write(reinterpret_cast<const char *>(&header), sizeof(header)) ||
+            !file.write(data.data(), static_cast<std::streamsize>(size)))
+        {
+            std::cerr << "Warning: Failed to write pipeline cache " << tempPath << std::endl;
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::cerr << "Warning: Failed to replace pipeline cache: " << error.message() << std::endl;
+        std::filesystem::remove(tempPath, error);
+        return;
+    }
+    m_PipelineCacheLoadedSize = size;
 }
 
 void VulkanRenderer::CreateFramebuffers()
@@ -1102,7 +1364,8 @@ void VulkanRenderer::CreateCommandPool()
 
 void VulkanRenderer::CreateCommandBuffers()
 {
-    m_CommandBuffers.resize(m_SwapchainFramebuffers.size());
+    // Indexed by frame slot, not by swapchain image
+    m_CommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
 
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
@@ -1115,9 +1378,10 @@ void VulkanRenderer::CreateCommandBuffers()
 
 void VulkanRenderer::CreateSyncObjects()
 {
-    m_ImageAvailableSemaphores.resize(2);
-    m_RenderFinishedSemaphores.resize(2);
-    m_InFlightFences.resize(2);
+    // Created for every slot so SetFramesInFlight() never allocates
+    m_ImageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    m_RenderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+    m_InFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
 
     VkSemaphoreCreateInfo semaphoreInfo{};
     semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
@@ -1126,7 +1390,7 @@ void VulkanRenderer::CreateSyncObjects()
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    for (size_t i = 0; i < 2; i++)
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
     {
         VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_ImageAvailableSemaphores[i]));
         VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_RenderFinishedSemaphores[i]));
@@ -1234,6 +1498,11 @@ void VulkanRenderer::BeginFrame()
     m_BatchDescriptorSet = VK_NULL_HANDLE;
     m_BatchStartVertex = 0;
     m_DrawCallCount = 0;
+    m_RenderStats.Reset();
+    m_GpuTimersRecording = false;
+    m_TextMeshes.NextFrame();
+    m_DescriptorSetCache.NextFrame();
+    m_Recorder.BeginFrame();
 
     if (m_Device == VK_NULL_HANDLE || m_Swapchain == VK_NULL_HANDLE)
     {
@@ -1248,6 +1517,10 @@ void VulkanRenderer::BeginFrame()
     }
 
     vkWaitForFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame], VK_TRUE, UINT64_MAX);
+    CompleteFrameSlot(m_CurrentFrame);
+
+    // Timestamps written by this slot's last submission are final now
+    ResolveGpuTimers();
 
     VkResult result = vkAcquireNextImageKHR(m_Device, m_Swapchain, UINT64_MAX, m_ImageAvailableSemaphores[m_CurrentFrame], VK_NULL_HANDLE, &m_ImageIndex);
 
@@ -1262,14 +1535,8 @@ void VulkanRenderer::BeginFrame()
         return; // Don't throw, just return
     }
 
-    if (m_ImageIndex >= m_CommandBuffers.size())
-    {
-        std::cerr << "Error: ImageIndex out of bounds! ImageIndex=" << m_ImageIndex
-                  << ", CommandBufferCount=" << m_CommandBuffers.size() << std::endl;
-        return;
-    }
-
     vkResetFences(m_Device, 1, &m_InFlightFences[m_CurrentFrame]);
+    m_FrameOpen = true;
 
     if (m_CurrentFrame >= m_CommandBuffers.size())
     {
@@ -1278,6 +1545,8 @@ void VulkanRenderer::BeginFrame()
     }
 
     vkResetCommandBuffer(m_CommandBuffers[m_CurrentFrame], 0);
+    m_RenderPassOpen = false;
+    m_LowResActive = false;
 
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -1289,6 +1558,15 @@ void VulkanRenderer::BeginFrame()
         return;
     }
 
+    // Query resets are not allowed inside a render pass
+    if (m_TimestampPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(m_CommandBuffers[m_CurrentFrame], m_TimestampPool,
+                            static_cast<uint32_t>(m_CurrentFrame) * GpuTimerFrame::MAX_QUERIES,
+                            GpuTimerFrame::MAX_QUERIES);
+        m_GpuTimersRecording = true;
+    }
+
     if (m_ImageIndex >= m_SwapchainFramebuffers.size())
     {
         std::cerr << "Error: ImageIndex out of bounds for framebuffers! ImageIndex=" << m_ImageIndex
@@ -1296,46 +1574,32 @@ void VulkanRenderer::BeginFrame()
         return;
     }
 
-    VkRenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = m_RenderPass;
-    renderPassInfo.framebuffer = m_SwapchainFramebuffers[m_ImageIndex];
-    renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = m_SwapchainExtent;
-
-    VkClearValue clearColor = {{{0.0f, 0.0f, 0.0f, 1.0f}}};
-    renderPassInfo.clearValueCount = 1;
-    renderPassInfo.pClearValues = &clearColor;
+    BeginRenderPass(m_RenderPass, m_SwapchainFramebuffers[m_ImageIndex], m_SwapchainExtent);
 
-    vkCmdBeginRenderPass(m_CommandBuffers[m_CurrentFrame], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-    if (m_GraphicsPipeline != VK_NULL_HANDLE)
-    {
-        vkCmdBindPipeline(m_CommandBuffers[m_CurrentFrame], VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline);
-
-        // Set dynamic viewport with Y-flip for Vulkan coordinate system
-        // This uses VK_KHR_maintenance1 behavior (core in Vulkan 1.1+)
-        // Negative height flips Y to match OpenGL's coordinate system
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = static_cast<float>(m_SwapchainExtent.height);
-        viewport.width = static_cast<float>(m_SwapchainExtent.width);
-        viewport.height = -static_cast<float>(m_SwapchainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        vkCmdSetViewport(m_CommandBuffers[m_CurrentFrame], 0, 1, &viewport);
-
-        VkRect2D scissor{};
-        scissor.offset = {0, 0};
-        scissor.extent = m_SwapchainExtent;
-        vkCmdSetScissor(m_CommandBuffers[m_CurrentFrame], 0, 1, &scissor);
-    }
-    else
+    if (m_GraphicsPipeline == VK_NULL_HANDLE)
     {
         std::cerr << "Warning: Graphics pipeline is null, cannot bind!" << std::endl;
     }
 }
 
+void VulkanRenderer::BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent)
+{
+    // Set dynamic viewport with Y-flip for Vulkan coordinate system
+    // This uses VK_KHR_maintenance1 behavior (core in Vulkan 1.1+)
+    // Negative height flips Y to match OpenGL's coordinate system
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = static_cast<float>(extent.height);
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = -static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    // Begun in the primary buffer by m_Recorder.Encode(); the scissor covers the extent
+    m_Recorder.BeginPass(renderPass, framebuffer, extent, viewport);
+    m_RenderPassOpen = true;
+}
+
 void VulkanRenderer::EndFrame()
 {
     if (m_Device == VK_NULL_HANDLE)
@@ -1352,8 +1616,28 @@ void VulkanRenderer::EndFrame()
 
     // Flush any remaining batched sprites before ending the frame
     FlushSpriteBatch();
+    m_GpuTimersRecording = false;
+
+    // A low-res pass left open still has to reach the swapchain image
+    if (m_LowResActive)
+    {
+        EndLowResPass(0, 0, static_cast<int>(m_SwapchainExtent.width), static_cast<int>(m_SwapchainExtent.height));
+    }
+
+    if (m_RenderPassOpen)
+    {
+        m_Recorder.EndPass();
+        m_RenderPassOpen = false;
+    }
 
-    vkCmdEndRenderPass(m_CommandBuffers[m_CurrentFrame]);
+    // Every pass recorded this frame goes into the primary buffer now,
+    // through secondaries encoded on the job system when the frame is big
+    m_Recorder.Encode(m_CommandBuffers[m_CurrentFrame], static_cast<uint32_t>(m_CurrentFrame), m_Jobs);
+
+    m_RenderStats.framesInFlight = static_cast<uint32_t>(m_FramesInFlight);
+    m_RenderStats.secondaryCommandBuffers = static_cast<uint32_t>(m_Recorder.GetSecondaryCount());
+    m_RenderStats.descriptorSetsCached = static_cast<uint32_t>(m_DescriptorSetCache.Size());
+    m_RenderStats.descriptorSetCapacity = static_cast<uint32_t>(m_DescriptorSetCache.GetCapacity());
 
     VkResult endResult = vkEndCommandBuffer(m_CommandBuffers[m_CurrentFrame]);
     if (endResult != VK_SUCCESS)
@@ -1370,14 +1654,21 @@ void VulkanRenderer::EndFrame()
         return;
     }
 
+    // Textures queued this frame (or since the last submit) start copying now,
+    // the draws sampling them wait on the batch semaphores below
+    m_Uploads.Submit();
+
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    VkSemaphore waitSemaphores[] = {m_ImageAvailableSemaphores[m_CurrentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
+    m_FrameWaitSemaphores.clear();
+    m_FrameWaitSemaphores.push_back(m_ImageAvailableSemaphores[m_CurrentFrame]);
+    m_Uploads.TakeWaitSemaphores(static_cast<uint32_t>(m_CurrentFrame), m_FrameWaitSemaphores);
+    m_FrameWaitStages.assign(m_FrameWaitSemaphores.size(), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    m_FrameWaitStages[0] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(m_FrameWaitSemaphores.size());
+    submitInfo.pWaitSemaphores = m_FrameWaitSemaphores.data();
+    submitInfo.pWaitDstStageMask = m_FrameWaitStages.data();
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &m_CommandBuffers[m_CurrentFrame];
 
@@ -1386,6 +1677,7 @@ void VulkanRenderer::EndFrame()
     submitInfo.pSignalSemaphores = signalSemaphores;
 
     VkResult submitResult = vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, m_InFlightFences[m_CurrentFrame]);
+    m_FrameOpen = false;
     if (submitResult != VK_SUCCESS)
     {
         std::cerr << "Error: Failed to submit command buffer! Result: " << submitResult << std::endl;
@@ -1414,90 +1706,389 @@ void VulkanRenderer::EndFrame()
         std::cerr << "Error: Failed to present swapchain image! Result: " << presentResult << std::endl;
     }
 
-    m_CurrentFrame = (m_CurrentFrame + 1) % 2;
+    m_CurrentFrame = (m_CurrentFrame + 1) % m_FramesInFlight;
 }
 
-void VulkanRenderer::SetViewport(int x, int y, int width, int height)
+void VulkanRenderer::CreateTimestampPool()
 {
-    (void)x;
-    (void)y; // Suppress unused parameter warnings
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
 
-    // Check if size has changed
-    if (width != static_cast<int>(m_SwapchainExtent.width) ||
-        height != static_cast<int>(m_SwapchainExtent.height))
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &familyCount, families.data());
+
+    uint32_t validBits = m_GraphicsFamily < familyCount ? families[m_GraphicsFamily].timestampValidBits : 0;
+    if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
     {
-        m_FramebufferResized = true;
+        std::cout << "GPU timers unavailable: graphics queue has no timestamp support" << std::endl;
+        return;
     }
-}
+    m_TimestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+    m_TimestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
 
-void VulkanRenderer::Clear(float r, float g, float b, float a)
-{
-    // Clear is handled in BeginFrame via render pass
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_FRAMES_IN_FLIGHT * GpuTimerFrame::MAX_QUERIES;
+    VK_CHECK(vkCreateQueryPool(m_Device, &poolInfo, nullptr, &m_TimestampPool));
 }
 
-void VulkanRenderer::BuildQuadVertices(SpriteVertex outVertices[6],
-                                       const glm::vec2 corners[4],
-                                       const glm::vec2 texCoords[4])
+void VulkanRenderer::ResolveGpuTimers()
 {
-    outVertices[0] = {corners[0].x, corners[0].y, texCoords[0].x, texCoords[0].y};
-    outVertices[1] = {corners[2].x, corners[2].y, texCoords[2].x, texCoords[2].y};
-    outVertices[2] = {corners[3].x, corners[3].y, texCoords[3].x, texCoords[3].y};
-    outVertices[3] = {corners[0].x, corners[0].y, texCoords[0].x, texCoords[0].y};
-    outVertices[4] = {corners[1].x, corners[1].y, texCoords[1].x, texCoords[1].y};
-    outVertices[5] = {corners[2].x, corners[2].y, texCoords[2].x, texCoords[2].y};
+    GpuTimerFrame &frame = m_GpuTimerFrames[m_CurrentFrame];
+    const uint32_t count = frame.GetQueryCount();
+    if (count > 0 && m_TimestampPool != VK_NULL_HANDLE)
+    {
+        // Called after this slot's fence wait, so the results are ready and
+        // no wait flag is needed
+        uint64_t timestamps[GpuTimerFrame::MAX_QUERIES];
+        VkResult result = vkGetQueryPoolResults(m_Device, m_TimestampPool,
+                                                static_cast<uint32_t>(m_CurrentFrame) * GpuTimerFrame::MAX_QUERIES,
+                                                count, sizeof(timestamps), timestamps, sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result == VK_SUCCESS)
+        {
+            frame.Resolve(timestamps, m_TimestampPeriod, m_TimestampMask, m_GpuTimerResults);
+        }
+    }
+    frame.Reset();
 }
 
-bool VulkanRenderer::SubmitQuad(VkDescriptorSet descriptorSet,
-                                const SpriteVertex vertices[6],
-                                glm::vec3 spriteColor, float spriteAlpha,
-                                bool useColorOnly, glm::vec4 colorOnly)
+void VulkanRenderer::BeginGpuTimer(const char *name)
 {
-    uint32_t maxVertices = static_cast<uint32_t>(m_VertexBufferSize / sizeof(SpriteVertex));
-    if (m_CurrentVertexCount + 6 > maxVertices)
-        return false;
+    if (!m_GpuTimersRecording)
+        return;
 
-    SpriteVertex *mapped = static_cast<SpriteVertex *>(m_VertexBuffersMapped[m_CurrentFrame]);
-    memcpy(&mapped[m_CurrentVertexCount], vertices, sizeof(SpriteVertex) * 6);
+    FlushSpriteBatch();
 
-    struct CombinedPushConstants
+    // Timed regions are the frame's independent passes, so each starts a
+    // segment that can be encoded on its own thread
+    m_Recorder.Split();
+    uint32_t query = m_GpuTimerFrames[m_CurrentFrame].Begin(name);
+    if (query != GpuTimerFrame::NO_QUERY)
     {
-        glm::mat4 projection;
-        glm::mat4 model;
-        glm::vec3 spriteColor;
-        float useColorOnly;
-        glm::vec4 colorOnly;
-        float spriteAlpha;
-        float _padding[3];
-        glm::vec3 ambientColor;
-        float _padding2;
-    } pc;
+        m_Recorder.WriteTimestamp(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_TimestampPool,
+                                  static_cast<uint32_t>(m_CurrentFrame) * GpuTimerFrame::MAX_QUERIES + query);
+    }
+}
 
-    pc.projection = m_Projection;
-    pc.model = glm::mat4(1.0f);
-    pc.spriteColor = spriteColor;
-    pc.useColorOnly = useColorOnly ? 1.0f : 0.0f;
-    pc.colorOnly = colorOnly;
-    pc.spriteAlpha = spriteAlpha;
-    pc.ambientColor = m_AmbientColor;
+void VulkanRenderer::EndGpuTimer()
+{
+    if (!m_GpuTimersRecording)
+        return;
 
-    VkCommandBuffer commandBuffer = m_CommandBuffers[m_CurrentFrame];
+    FlushSpriteBatch();
+    uint32_t query = m_GpuTimerFrames[m_CurrentFrame].End();
+    if (query != GpuTimerFrame::NO_QUERY)
+    {
+        m_Recorder.WriteTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimestampPool,
+                                  static_cast<uint32_t>(m_CurrentFrame) * GpuTimerFrame::MAX_QUERIES + query);
+    }
+    m_Recorder.Split();
+}
 
-    vkCmdPushConstants(commandBuffer, m_PipelineLayout,
-                       VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                       0, 192, &pc);
+void VulkanRenderer::CreateLowResRenderPass()
+{
+    // Same attachment format and sample count as m_RenderPass, which is all
+    // render pass compatibility requires, so the existing pipelines draw here
+    VkAttachmentDescription colorAttachment{};
+    colorAttachment.format = m_SwapchainImageFormat;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    VkAttachmentReference colorAttachmentRef{};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass{};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
 
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout,
-                            0, 1, &descriptorSet, 0, nullptr);
+    // The one image is shared by both frames in flight: writes wait for the
+    // previous frame's upscale to finish sampling it, and the upscale waits
+    // for this frame's writes
+    VkSubpassDependency dependencies[2]{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[0].srcAccessMask = 0;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VertexBuffers[m_CurrentFrame], offsets);
+    VkRenderPassCreateInfo renderPassInfo{};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = 1;
+    renderPassInfo.pAttachments = &colorAttachment;
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 2;
+    renderPassInfo.pDependencies = dependencies;
 
-    vkCmdDraw(commandBuffer, 6, 1, m_CurrentVertexCount, 0);
-    ++m_DrawCallCount;
+    VK_CHECK(vkCreateRenderPass(m_Device, &renderPassInfo, nullptr, &m_LowResRenderPass));
+}
+
+void VulkanRenderer::CreateLowResTarget(uint32_t width, uint32_t height)
+{
+    // Earlier frames may still sample the old image; resizes are rare
+    vkDeviceWaitIdle(m_Device);
+    DestroyLowResTarget();
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = {width, height, 1};
+    imageInfo.mipLevels = 1;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = m_SwapchainImageFormat;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VK_CHECK(vkCreateImage(m_Device, &imageInfo, nullptr, &m_LowResImage));
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(m_Device, m_LowResImage, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    VK_CHECK(vkAllocateMemory(m_Device, &allocInfo, nullptr, &m_LowResMemory));
+    VK_CHECK(vkBindImageMemory(m_Device, m_LowResImage, m_LowResMemory, 0));
+
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = m_LowResImage;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = m_SwapchainImageFormat;
+    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+    VK_CHECK(vkCreateImageView(m_Device, &viewInfo, nullptr, &m_LowResImageView));
+
+    VkFramebufferCreateInfo framebufferInfo{};
+    framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    framebufferInfo.renderPass = m_LowResRenderPass;
+    framebufferInfo.attachmentCount = 1;
+    framebufferInfo.pAttachments = &m_LowResImageView;
+    framebufferInfo.width = width;
+    framebufferInfo.height = height;
+    framebufferInfo.layers = 1;
+    VK_CHECK(vkCreateFramebuffer(m_Device, &framebufferInfo, nullptr, &m_LowResFramebuffer));
+
+    // One set for the lifetime of the renderer, pointed at each new view
+    // (GetOrCreateDescriptorSet() would key stale entries by recycled handles)
+    if (m_LowResDescriptorSet == VK_NULL_HANDLE)
+    {
+        VkDescriptorSetAllocateInfo setInfo{};
+        setInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        setInfo.descriptorPool = m_DescriptorPool;
+        setInfo.descriptorSetCount = 1;
+        setInfo.pSetLayouts = &m_DescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(m_Device, &setInfo, &m_LowResDescriptorSet));
+    }
+
+    VkDescriptorImageInfo descriptorImage{};
+    descriptorImage.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    descriptorImage.imageView = m_LowResImageView;
+    descriptorImage.sampler = m_TextureSampler; // Nearest filtering
+
+    VkWriteDescriptorSet descriptorWrite{};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = m_LowResDescriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pImageInfo = &descriptorImage;
+    vkUpdateDescriptorSets(m_Device, 1, &descriptorWrite, 0, nullptr);
+
+    m_LowResWidth = width;
+    m_LowResHeight = height;
+}
+
+void VulkanRenderer::DestroyLowResTarget()
+{
+    if (m_LowResFramebuffer != VK_NULL_HANDLE)
+    {
+        vkDestroyFramebuffer(m_Device, m_LowResFramebuffer, nullptr);
+        m_LowResFramebuffer = VK_NULL_HANDLE;
+    }
+    if (m_LowResImageView != VK_NULL_HANDLE)
+    {
+        vkDestroyImageView(m_Device, m_LowResImageView, nullptr);
+        m_LowResImageView = VK_NULL_HANDLE;
+    }
+    if (m_LowResImage != VK_NULL_HANDLE)
+    {
+        vkDestroyImage(m_Device, m_LowResImage, nullptr);
+        m_LowResImage = VK_NULL_HANDLE;
+    }
+    if (m_LowResMemory != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(m_Device, m_LowResMemory, nullptr);
+        m_LowResMemory = VK_NULL_HANDLE;
+    }
+    m_LowResWidth = 0;
+    m_LowResHeight = 0;
+}
+
+bool VulkanRenderer::BeginLowResPass(int width, int height)
+{
+    if (!m_RenderPassOpen || m_LowResActive || m_LowResRenderPass == VK_NULL_HANDLE || width <= 0 || height <= 0)
+        return false;
+
+    FlushSpriteBatch();
+
+    if (m_LowResFramebuffer == VK_NULL_HANDLE ||
+        static_cast<uint32_t>(width) != m_LowResWidth || static_cast<uint32_t>(height) != m_LowResHeight)
+    {
+        try
+        {
+            CreateLowResTarget(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Low-res target unavailable, drawing at window resolution: " << e.what() << std::endl;
+            DestroyLowResTarget();
+            return false;
+        }
+    }
+
+    // Nothing has been drawn into the swapchain pass yet; it is restarted
+    // (and cleared again) by EndLowResPass()
+    m_Recorder.EndPass();
+    BeginRenderPass(m_LowResRenderPass, m_LowResFramebuffer, {m_LowResWidth, m_LowResHeight});
+    m_LowResActive = true;
+    return true;
+}
+
+void VulkanRenderer::EndLowResPass(int x, int y, int width, int height)
+{
+    if (!m_LowResActive)
+        return;
+
+    FlushSpriteBatch();
+
+    m_Recorder.EndPass();
+    BeginRenderPass(m_RenderPass, m_SwapchainFramebuffers[m_ImageIndex], m_SwapchainExtent);
+    m_LowResActive = false;
+
+    // Viewport = destination rectangle (bottom-left origin like OpenGL,
+    // Y-flipped like every other viewport here). Scissor stays the full
+    // swapchain so an overhanging rectangle is clipped, not rejected.
+    VkViewport viewport{};
+    viewport.x = static_cast<float>(x);
+    viewport.y = static_cast<float>(static_cast<int>(m_SwapchainExtent.height) - y);
+    viewport.width = static_cast<float>(width);
+    viewport.height = -static_cast<float>(height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    m_Recorder.SetViewport(viewport);
+
+    // One opaque quad over the whole viewport. The target's alpha is 1
+    // everywhere (see the alpha blend factors), so alpha blending is a copy.
+    const glm::vec2 corners[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    const glm::vec2 texCoords[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    SpriteVertex vertices[6];
+    BuildQuadVertices(vertices, corners, texCoords);
+
+    const glm::mat4 savedProjection = m_Projection;
+    const glm::vec3 savedAmbient = m_AmbientColor;
+    m_Projection = glm::ortho(0.0f, 1.0f, 1.0f, 0.0f, -1.0f, 1.0f);
+    m_AmbientColor = glm::vec3(1.0f);
+    SubmitQuad(m_LowResDescriptorSet, vertices, glm::vec3(1.0f), 1.0f, false, glm::vec4(0.0f), false);
+    m_Projection = savedProjection;
+    m_AmbientColor = savedAmbient;
+}
+
+void VulkanRenderer::SetViewport(int x, int y, int width, int height)
+{
+    (void)x;
+    (void)y; // Suppress unused parameter warnings
+
+    // Check if size has changed
+    if (width != static_cast<int>(m_SwapchainExtent.width) ||
+        height != static_cast<int>(m_SwapchainExtent.height))
+    {
+        m_FramebufferResized = true;
+    }
+}
+
+void VulkanRenderer::Clear(float r, float g, float b, float a)
+{
+    // Clear is handled in BeginFrame via render pass
+}
+
+void VulkanRenderer::BuildQuadVertices(SpriteVertex outVertices[6],
+                                       const glm::vec2 corners[4],
+                                       const glm::vec2 texCoords[4])
+{
+    outVertices[0] = {corners[0].x, corners[0].y, texCoords[0].x, texCoords[0].y};
+    outVertices[1] = {corners[2].x, corners[2].y, texCoords[2].x, texCoords[2].y};
+    outVertices[2] = {corners[3].x, corners[3].y, texCoords[3].x, texCoords[3].y};
+    outVertices[3] = {corners[0].x, corners[0].y, texCoords[0].x, texCoords[0].y};
+    outVertices[4] = {corners[1].x, corners[1].y, texCoords[1].x, texCoords[1].y};
+    outVertices[5] = {corners[2].x, corners[2].y, texCoords[2].x, texCoords[2].y};
+}
+
+bool VulkanRenderer::SubmitQuad(VkDescriptorSet descriptorSet,
+                                const SpriteVertex vertices[6],
+                                glm::vec3 spriteColor, float spriteAlpha,
+                                bool useColorOnly, glm::vec4 colorOnly,
+                                bool applyPerspective, bool additive)
+{
+    uint32_t maxVertices = static_cast<uint32_t>(m_VertexBufferSize / sizeof(SpriteVertex));
+    if (m_CurrentVertexCount + 6 > maxVertices)
+        return false;
+
+    SpriteVertex *mapped = static_cast<SpriteVertex *>(m_VertexBuffersMapped[m_CurrentFrame]);
+    memcpy(&mapped[m_CurrentVertexCount], vertices, sizeof(SpriteVertex) * 6);
+
+    SpritePushConstants pc{};
+    pc.projection = m_Projection;
+    pc.model = glm::mat4(1.0f);
+    pc.spriteColor = spriteColor;
+    pc.useColorOnly = useColorOnly ? 1.0f : 0.0f;
+    pc.colorOnly = colorOnly;
+    pc.spriteAlpha = spriteAlpha;
+    pc.ambientColor = m_AmbientColor;
+    GetShaderPerspective(applyPerspective, pc.perspParams0, pc.perspParams1);
+
+    RecordDraw(additive && m_AdditivePipeline != VK_NULL_HANDLE ? m_AdditivePipeline : m_GraphicsPipeline,
+               descriptorSet, m_VertexBuffers[m_CurrentFrame], m_CurrentVertexCount, 6, pc);
     m_CurrentVertexCount += 6;
     return true;
 }
 
+void VulkanRenderer::RecordDraw(VkPipeline pipeline, VkDescriptorSet descriptorSet, VkBuffer vertexBuffer,
+                                uint32_t firstVertex, uint32_t vertexCount, const SpritePushConstants &pushConstants)
+{
+    // Both pipeline variants share m_PipelineLayout, so the recorder only
+    // rebinds what changes from one draw to the next
+    if (!m_Recorder.Draw(pipeline, descriptorSet, vertexBuffer, firstVertex, vertexCount, &pushConstants))
+        return;
+    ++m_DrawCallCount;
+    m_RenderStats.vertices += vertexCount;
+}
+
 void VulkanRenderer::DrawSprite(const Texture &texture, glm::vec2 position, glm::vec2 size,
                                 float rotation, glm::vec3 color)
 {
@@ -1639,9 +2230,6 @@ void VulkanRenderer::DrawSpriteRegion(const Texture &texture, glm::vec2 position
 void VulkanRenderer::DrawSpriteAlpha(const Texture &texture, glm::vec2 position, glm::vec2 size,
                                      float rotation, glm::vec4 color, bool additive)
 {
-    // Note: additive blending not yet fully implemented in Vulkan renderer
-    (void)additive;
-
     if (m_GraphicsPipeline == VK_NULL_HANDLE || m_DescriptorSetLayout == VK_NULL_HANDLE)
         return;
 
@@ -1696,7 +2284,8 @@ void VulkanRenderer::DrawSpriteAlpha(const Texture &texture, glm::vec2 position,
 
     SpriteVertex vertices[6];
     BuildQuadVertices(vertices, corners, texCoords);
-    SubmitQuad(descriptorSet, vertices, glm::vec3(color.r, color.g, color.b), color.a);
+    SubmitQuad(descriptorSet, vertices, glm::vec3(color.r, color.g, color.b), color.a,
+               false, glm::vec4(0.0f), true, additive);
 }
 
 void VulkanRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position, glm::vec2 size,
@@ -1704,7 +2293,6 @@ void VulkanRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position,
                                      glm::vec4 color, bool additive)
 {
     // Atlas version with custom UV coordinates
-    (void)additive;
 
     if (m_GraphicsPipeline == VK_NULL_HANDLE || m_DescriptorSetLayout == VK_NULL_HANDLE)
         return;
@@ -1763,13 +2351,12 @@ void VulkanRenderer::DrawSpriteAtlas(const Texture &texture, glm::vec2 position,
 
     SpriteVertex vertices[6];
     BuildQuadVertices(vertices, corners, texCoords);
-    SubmitQuad(descriptorSet, vertices, glm::vec3(color.r, color.g, color.b), color.a);
+    SubmitQuad(descriptorSet, vertices, glm::vec3(color.r, color.g, color.b), color.a,
+               false, glm::vec4(0.0f), true, additive);
 }
 
 void VulkanRenderer::DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::vec4 color, bool additive)
 {
-    // Note: additive blending not yet implemented in Vulkan renderer
-    (void)additive;
     if (m_GraphicsPipeline == VK_NULL_HANDLE || m_DescriptorSetLayout == VK_NULL_HANDLE)
     {
         return; // Pipeline not ready
@@ -1800,7 +2387,7 @@ void VulkanRenderer::DrawColoredRect(glm::vec2 position, glm::vec2 size, glm::ve
 
     SpriteVertex vertices[6];
     BuildQuadVertices(vertices, corners, texCoords);
-    SubmitQuad(descriptorSet, vertices, glm::vec3(1.0f), 1.0f, true, color);
+    SubmitQuad(descriptorSet, vertices, glm::vec3(1.0f), 1.0f, true, color, true, additive);
 }
 
 void VulkanRenderer::DrawWarpedQuad(const Texture& texture, const glm::vec2 corners[4],
@@ -1857,24 +2444,73 @@ void VulkanRenderer::DrawWarpedQuad(const Texture& texture, const glm::vec2 corn
         {u0, v0}  // BL
     };
 
+    // Corners are already projected, keep sprite.vert from projecting them again
     SpriteVertex vertices[6];
     BuildQuadVertices(vertices, corners, texCoords);
-    SubmitQuad(descriptorSet, vertices, color, 1.0f);
+    SubmitQuad(descriptorSet, vertices, color, 1.0f, false, glm::vec4(0.0f), false);
 }
 
 VkDescriptorSet VulkanRenderer::GetOrCreateDescriptorSet(VkImageView imageView)
 {
     // Check cache first
-    auto it = m_DescriptorSetCache.find(imageView);
-    if (it != m_DescriptorSetCache.end())
+    if (VkDescriptorSet *cached = m_DescriptorSetCache.Find(imageView))
+    {
+        return *cached;
+    }
+    auto transient = m_TransientDescriptorSets.find(imageView);
+    if (transient != m_TransientDescriptorSets.end())
+    {
+        return transient->second;
+    }
+
+    // Make room by dropping the least recently used set. Earlier frames still
+    // in flight may bind it, this one has not, so it goes with this slot
+    if (m_DescriptorSetCache.Full())
+    {
+        VkImageView evictedView = VK_NULL_HANDLE;
+        VkDescriptorSet evictedSet = VK_NULL_HANDLE;
+        if (m_DescriptorSetCache.EvictOldest(evictedView, evictedSet))
+        {
+            m_RetiredDescriptorSets[m_CurrentFrame].push_back(evictedSet);
+            ++m_RenderStats.descriptorSetsEvicted;
+        }
+    }
+
+    if (!m_DescriptorSetCache.Full())
+    {
+        VkDescriptorSet descriptorSet = AllocateTextureDescriptorSet(m_DescriptorPool, imageView);
+        if (descriptorSet != VK_NULL_HANDLE)
+        {
+            m_DescriptorSetCache.Insert(imageView, descriptorSet);
+            ++m_RenderStats.descriptorSetsCreated;
+            return descriptorSet;
+        }
+    }
+
+    // Every cached set is bound this frame (or the pool is still full of
+    // retired ones), so this set only has to last until the slot's fence
+    VkDescriptorSet descriptorSet = AllocateTextureDescriptorSet(m_TransientDescriptorPools[m_CurrentFrame], imageView);
+    if (descriptorSet == VK_NULL_HANDLE)
     {
-        return it->second;
+        std::cerr << "Warning: Descriptor pools exhausted (" << m_DescriptorSetCache.Size() << " cached, "
+                  << m_TransientDescriptorSets.size() << " transient this frame)" << std::endl;
+        return VK_NULL_HANDLE;
+    }
+    m_TransientDescriptorSets.emplace(imageView, descriptorSet);
+    ++m_RenderStats.transientDescriptorSets;
+    return descriptorSet;
+}
+
+VkDescriptorSet VulkanRenderer::AllocateTextureDescriptorSet(VkDescriptorPool pool, VkImageView imageView)
+{
+    if (pool == VK_NULL_HANDLE)
+    {
+        return VK_NULL_HANDLE;
     }
 
-    // Allocate new descriptor set
     VkDescriptorSetAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = m_DescriptorPool;
+    allocInfo.descriptorPool = pool;
     allocInfo.descriptorSetCount = 1;
     allocInfo.pSetLayouts = &m_DescriptorSetLayout;
 
@@ -1882,8 +2518,6 @@ VkDescriptorSet VulkanRenderer::GetOrCreateDescriptorSet(VkImageView imageView)
     VkResult result = vkAllocateDescriptorSets(m_Device, &allocInfo, &descriptorSet);
     if (result != VK_SUCCESS)
     {
-        // Descriptor pool exhausted
-        std::cerr << "Warning: Descriptor pool exhausted. Consider increasing pool size." << std::endl;
         return VK_NULL_HANDLE;
     }
 
@@ -1904,12 +2538,124 @@ VkDescriptorSet VulkanRenderer::GetOrCreateDescriptorSet(VkImageView imageView)
 
     vkUpdateDescriptorSets(m_Device, 1, &descriptorWrite, 0, nullptr);
 
-    // Cache the descriptor set
-    m_DescriptorSetCache[imageView] = descriptorSet;
-
     return descriptorSet;
 }
 
+int VulkanRenderer::CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY)
+{
+    if (m_Device == VK_NULL_HANDLE || count == 0)
+    {
+        return INVALID_STATIC_MESH;
+    }
+
+    std::vector<float> vertices;
+    BuildStaticMeshVertices(texture, quads, count, flipY, vertices);
+    if (vertices.empty())
+    {
+        return INVALID_STATIC_MESH;
+    }
+    static_assert(sizeof(SpriteVertex) == 4 * sizeof(float), "Static mesh vertices must match SpriteVertex");
+
+    StaticMesh mesh;
+    mesh.vertexCount = static_cast<uint32_t>(vertices.size() / 4);
+    mesh.texture = &texture;
+
+    // Written once, so host-visible memory is enough and avoids a staging copy
+    VkDeviceSize bufferSize = vertices.size() * sizeof(float);
+    CreateBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                 mesh.buffer, mesh.memory);
+
+    void *data = nullptr;
+    VK_CHECK(vkMapMemory(m_Device, mesh.memory, 0, bufferSize, 0, &data));
+    memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
+    vkUnmapMemory(m_Device, mesh.memory);
+
+    if (!m_FreeStaticMeshes.empty())
+    {
+        int handle = m_FreeStaticMeshes.back();
+        m_FreeStaticMeshes.pop_back();
+        m_StaticMeshes[handle] = mesh;
+        return handle;
+    }
+    m_StaticMeshes.push_back(mesh);
+    return static_cast<int>(m_StaticMeshes.size() - 1);
+}
+
+void VulkanRenderer::DrawStaticMesh(int mesh, glm::vec2 origin)
+{
+    if (mesh < 0 || mesh >= static_cast<int>(m_StaticMeshes.size()) ||
+        m_StaticMeshes[mesh].buffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+    if (m_CommandBuffers.empty() || m_CurrentFrame >= m_CommandBuffers.size())
+    {
+        return;
+    }
+    const StaticMesh &staticMesh = m_StaticMeshes[mesh];
+
+    VkImageView imageView = m_WhiteTextureImageView;
+#ifdef USE_VULKAN
+    if (staticMesh.texture->GetVulkanImageView() == VK_NULL_HANDLE)
+    {
+        UploadTexture(*staticMesh.texture);
+    }
+    if (staticMesh.texture->GetVulkanImageView() != VK_NULL_HANDLE)
+    {
+        imageView = staticMesh.texture->GetVulkanImageView();
+    }
+#endif
+    VkDescriptorSet descriptorSet = GetOrCreateDescriptorSet(imageView);
+    if (descriptorSet == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // Keep draw order with anything already batched
+    FlushSpriteBatch();
+
+    SpritePushConstants pc{};
+    pc.projection = m_Projection;
+    pc.model = glm::translate(glm::mat4(1.0f), glm::vec3(origin, 0.0f));
+    pc.spriteColor = glm::vec3(1.0f);
+    pc.useColorOnly = 0.0f;
+    pc.colorOnly = glm::vec4(0.0f);
+    pc.spriteAlpha = 1.0f;
+    pc.ambientColor = m_AmbientColor;
+    GetShaderPerspective(true, pc.perspParams0, pc.perspParams1);
+
+    RecordDraw(m_GraphicsPipeline, descriptorSet, staticMesh.buffer, 0, staticMesh.vertexCount, pc);
+}
+
+void VulkanRenderer::DestroyStaticMesh(int mesh)
+{
+    if (mesh < 0 || mesh >= static_cast<int>(m_StaticMeshes.size()) ||
+        m_StaticMeshes[mesh].buffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // The current frame may have recorded a draw with this buffer already
+    m_RetiredStaticMeshes[m_CurrentFrame].push_back(m_StaticMeshes[mesh]);
+    m_StaticMeshes[mesh] = StaticMesh{};
+    m_FreeStaticMeshes.push_back(mesh);
+}
+
+void VulkanRenderer::FreeStaticMeshBuffers(StaticMesh &mesh)
+{
+    if (mesh.buffer != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(m_Device, mesh.buffer, nullptr);
+        mesh.buffer = VK_NULL_HANDLE;
+    }
+    if (mesh.memory != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(m_Device, mesh.memory, nullptr);
+        mesh.memory = VK_NULL_HANDLE;
+    }
+}
+
 void VulkanRenderer::FlushSpriteBatch()
 {
     // Nothing to flush if no vertices accumulated
@@ -1923,21 +2669,8 @@ void VulkanRenderer::FlushSpriteBatch()
     if (m_CommandBuffers.empty() || m_CurrentFrame >= m_CommandBuffers.size())
         return;
 
-    VkCommandBuffer commandBuffer = m_CommandBuffers[m_CurrentFrame];
-
     // Push constants - identity model since vertices are pre-transformed
-    struct CombinedPushConstants
-    {
-        glm::mat4 projection;   // 0-63
-        glm::mat4 model;        // 64-127
-        glm::vec3 spriteColor;  // 128-139
-        float useColorOnly;     // 140-143
-        glm::vec4 colorOnly;    // 144-159
-        float spriteAlpha;      // 160-163
-        float _padding[3];      // 164-175 (padding to align ambientColor)
-        glm::vec3 ambientColor; // 176-187
-        float _padding2;        // 188-191 (padding to 192)
-    } pushConstants;
+    SpritePushConstants pushConstants{};
 
     pushConstants.projection = m_Projection;
     pushConstants.model = glm::mat4(1.0f);       // Identity - vertices already transformed
@@ -1946,22 +2679,12 @@ void VulkanRenderer::FlushSpriteBatch()
     pushConstants.colorOnly = glm::vec4(0.0f);
     pushConstants.spriteAlpha = 1.0f; // Full opacity for sprites
     pushConstants.ambientColor = m_AmbientColor;
-
-    vkCmdPushConstants(commandBuffer, m_PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                       0, 192, &pushConstants);
-
-    // Bind descriptor set for batch texture
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout,
-                            0, 1, &m_BatchDescriptorSet, 0, nullptr);
-
-    // Bind vertex buffer
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VertexBuffers[m_CurrentFrame], offsets);
+    GetShaderPerspective(true, pushConstants.perspParams0, pushConstants.perspParams1);
 
     // Draw all accumulated vertices in one call
     uint32_t vertexCount = m_CurrentVertexCount - m_BatchStartVertex;
-    vkCmdDraw(commandBuffer, vertexCount, 1, m_BatchStartVertex, 0);
-    ++m_DrawCallCount;
+    RecordDraw(m_GraphicsPipeline, m_BatchDescriptorSet, m_VertexBuffers[m_CurrentFrame], m_BatchStartVertex,
+               vertexCount, pushConstants);
 
     // Reset batch - start new batch at current position
     m_BatchStartVertex = m_CurrentVertexCount;
@@ -2000,10 +2723,19 @@ glm::mat4 VulkanRenderer::CalculateModelMatrix(glm::vec2 position, glm::vec2 siz
 
 void VulkanRenderer::UploadTexture(const Texture &texture)
 {
-    // Call CreateVulkanTexture on the texture to upload it to the GPU
+    // Queue the texture on the upload manager instead of a blocking one-shot copy
     // Cast away const since we're modifying Vulkan state, not logical texture state
     Texture *texPtr = const_cast<Texture *>(&texture);
-    texPtr->CreateVulkanTexture(m_Device, m_PhysicalDevice, m_CommandPool, m_GraphicsQueue);
+
+    // Shared sheets are handed over once per owner; only the first creates the image
+    if (texture.GetVulkanImageView() != VK_NULL_HANDLE && texture.GetVulkanDevice() == m_Device)
+    {
+        return;
+    }
+
+    // Image and view exist immediately, the copy runs asynchronously and the
+    // frame that draws it waits on the upload batch (see VulkanUploadManager)
+    m_Uploads.QueueTexture(*texPtr);
 
     // Track for cleanup during shutdown
     // Check if already tracked to avoid duplicates
@@ -2014,17 +2746,227 @@ void VulkanRenderer::UploadTexture(const Texture &texture)
     }
 }
 
-float VulkanRenderer::GetTextAscent(float scale) const
+void VulkanRenderer::UploadTextures(const std::vector<Texture *> &textures, JobSystem *jobs)
 {
-    // Find the maximum bearing.y (ascent) across all loaded glyphs
-    int maxAscent = 0;
-    for (const auto &pair : m_Glyphs)
+    std::vector<Texture *> missing;
+    missing.reserve(textures.size());
+    for (Texture *texture : textures)
+    {
+        if (texture->m_ImageData.empty() ||
+            (texture->GetVulkanImageView() != VK_NULL_HANDLE && texture->GetVulkanDevice() == m_Device))
+        {
+            continue;
+        }
+        missing.push_back(texture);
+    }
+
+    // One batch for all of them; pixels are staged on the job workers
+    m_Uploads.QueueTextures(missing, jobs);
+
+    for (Texture *texture : missing)
+    {
+        if (texture->GetVulkanImageView() != VK_NULL_HANDLE &&
+            std::find(m_UploadedTextures.begin(), m_UploadedTextures.end(), texture) == m_UploadedTextures.end())
+        {
+            m_UploadedTextures.push_back(texture);
+        }
+    }
+}
+
+void VulkanRenderer::ReleaseTexture(Texture &texture)
+{
+    m_TextureCache.erase(&texture);
+    auto tracked = std::find(m_UploadedTextures.begin(), m_UploadedTextures.end(), &texture);
+    if (tracked != m_UploadedTextures.end())
+    {
+        m_UploadedTextures.erase(tracked);
+    }
+
+    VkImageView imageView = texture.GetVulkanImageView();
+    if (imageView == VK_NULL_HANDLE || texture.GetVulkanDevice() != m_Device)
+    {
+        return;
+    }
+
+    // The current frame may have recorded a draw with this texture already
+    RetiredTexture retired{std::move(texture), VK_NULL_HANDLE};
+    m_DescriptorSetCache.Erase(imageView, retired.descriptorSet);
+    // A transient set dies with its pool; only the recyclable handle goes now
+    m_TransientDescriptorSets.erase(imageView);
+    m_RetiredTextures[m_CurrentFrame].push_back(std::move(retired));
+}
+
+void VulkanRenderer::FreeRetiredTextures(int frame)
+{
+    for (RetiredTexture &retired : m_RetiredTextures[frame])
+    {
+        if (retired.descriptorSet != VK_NULL_HANDLE)
+        {
+            vkFreeDescriptorSets(m_Device, m_DescriptorPool, 1, &retired.descriptorSet);
+        }
+    }
+    // Texture destructors release the Vulkan image, memory, view and sampler
+    m_RetiredTextures[frame].clear();
+
+    std::vector<VkDescriptorSet> &evicted = m_RetiredDescriptorSets[frame];
+    if (!evicted.empty())
+    {
+        vkFreeDescriptorSets(m_Device, m_DescriptorPool, static_cast<uint32_t>(evicted.size()), evicted.data());
+        evicted.clear();
+    }
+
+    for (VkPipeline pipeline : m_RetiredPipelines[frame])
+    {
+        vkDestroyPipeline(m_Device, pipeline, nullptr);
+    }
+    m_RetiredPipelines[frame].clear();
+}
+
+void VulkanRenderer::CompleteFrameSlot(size_t frame)
+{
+    // Semaphores this frame slot waited on can be reused, finished uploads retired
+    m_Uploads.OnFrameSlotComplete(static_cast<uint32_t>(frame));
+
+    // The GPU is done with this frame slot, so meshes retired from it can go
+    for (StaticMesh &mesh : m_RetiredStaticMeshes[frame])
+    {
+        FreeStaticMeshBuffers(mesh);
+    }
+    m_RetiredStaticMeshes[frame].clear();
+    FreeRetiredTextures(static_cast<int>(frame));
+
+    // Every transient set this slot handed out goes at once; the map only
+    // ever holds the current frame's, which are from this pool
+    if (m_TransientDescriptorPools[frame] != VK_NULL_HANDLE)
+    {
+        vkResetDescriptorPool(m_Device, m_TransientDescriptorPools[frame], 0);
+    }
+    m_TransientDescriptorSets.clear();
+}
+
+bool VulkanRenderer::UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height)
+{
+    if (texture.GetVulkanImageView() == VK_NULL_HANDLE || texture.GetVulkanDevice() != m_Device)
+    {
+        return false;
+    }
+
+    // On the graphics queue the copy's barrier waits for earlier draws; a
+    // transfer-only queue is not ordered against them, so wait for every
+    // submitted frame that may still sample the texels being replaced
+    if (m_Uploads.HasDedicatedTransferQueue())
+    {
+        for (size_t frame = 0; frame < m_InFlightFences.size(); ++frame)
+        {
+            if (m_FrameOpen && frame == m_CurrentFrame)
+            {
+                continue;  // Reset and not yet submitted
+            }
+            vkWaitForFences(m_Device, 1, &m_InFlightFences[frame], VK_TRUE, UINT64_MAX);
+        }
+    }
+    return m_Uploads.QueueTextureRegion(const_cast<Texture &>(texture), x, y, width, height);
+}
+
+bool VulkanRenderer::ReloadShaders()
+{
+    VkPipeline pipelines[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
+    try
+    {
+        if (!BuildSpritePipelines(pipelines))
+        {
+            return false;
+        }
+    }
+    catch (const std::runtime_error &e)
+    {
+        // Module creation throws; the running pipelines are untouched
+        std::cerr << "Shader reload failed: " << e.what() << std::endl;
+        return false;
+    }
+
+    // Between frames the last submitted one may still use the old pair; its
+    // slot is waited on when it comes round again. An open frame has
+    // recorded draws with them that are only encoded at EndFrame()
+    const size_t slot = m_FrameOpen ? m_CurrentFrame : GetLastSubmittedSlot();
+    m_RetiredPipelines[slot].push_back(m_GraphicsPipeline);
+    m_RetiredPipelines[slot].push_back(m_AdditivePipeline);
+
+    m_GraphicsPipeline = pipelines[0];
+    m_AdditivePipeline = pipelines[1];
+    std::cout << "Reloaded sprite pipelines" << std::endl;
+    return true;
+}
+
+bool VulkanRenderer::SetPresentMode(PresentMode mode)
+{
+    if (m_FrameOpen)
+    {
+        std::cerr << "Error: SetPresentMode called inside a frame" << std::endl;
+        return false;
+    }
+
+    m_RequestedPresentMode = mode;
+    if (m_Swapchain == VK_NULL_HANDLE)
+    {
+        return true; // Picked up by Init()
+    }
+    RecreateSwapchain();
+
+    const char *name = "FIFO";
+    if (m_PresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+    {
+        name = "MAILBOX";
+    }
+    else if (m_PresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR)
+    {
+        name = "IMMEDIATE";
+    }
+    std::cout << "Vulkan present mode: " << name << std::endl;
+    return true;
+}
+
+bool VulkanRenderer::SetFramesInFlight(int count)
+{
+    if (count < 1 || count > MAX_FRAMES_IN_FLIGHT)
+    {
+        std::cerr << "Error: frames in flight must be 1-" << MAX_FRAMES_IN_FLIGHT << ", got " << count << std::endl;
+        return false;
+    }
+    if (m_FrameOpen)
+    {
+        std::cerr << "Error: SetFramesInFlight called inside a frame" << std::endl;
+        return false;
+    }
+    if (static_cast<size_t>(count) == m_FramesInFlight)
+    {
+        return true;
+    }
+
+    // Slots are renumbered from 0, so everything they still hold has to be
+    // finished and released first
+    if (m_Device != VK_NULL_HANDLE)
     {
-        if (pair.second.bearing.y > maxAscent)
+        vkDeviceWaitIdle(m_Device);
+        for (size_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; ++frame)
         {
-            maxAscent = pair.second.bearing.y;
+            CompleteFrameSlot(frame);
+            m_GpuTimerFrames[frame].Reset();
         }
     }
+
+    m_FramesInFlight = static_cast<size_t>(count);
+    m_CurrentFrame = 0;
+    std::cout << "Vulkan frames in flight: " << count << std::endl;
+    return true;
+}
+
+float VulkanRenderer::GetTextAscent(float scale) const
+{
+    // Find the maximum bearing.y (ascent) across all loaded glyphs
+    int maxAscent = 0;
+    m_Glyphs.ForEach([&maxAscent](char, const Glyph &glyph)
+                     { maxAscent = std::max(maxAscent, glyph.bearing.y); });
     // If no glyphs loaded, use font size as fallback
     if (maxAscent == 0)
     {
@@ -2033,9 +2975,9 @@ float VulkanRenderer::GetTextAscent(float scale) const
     return static_cast<float>(maxAscent) * scale;
 }
 
-float VulkanRenderer::GetTextWidth(const std::string &text, float scale) const
+float VulkanRenderer::GetTextWidth(std::string_view text, float scale) const
 {
-    if (m_Glyphs.empty() || text.empty())
+    if (m_Glyphs.Empty() || text.empty())
     {
         return 0.0f;
     }
@@ -2043,10 +2985,9 @@ float VulkanRenderer::GetTextWidth(const std::string &text, float scale) const
     float width = 0.0f;
     for (char c : text)
     {
-        auto it = m_Glyphs.find(c);
-        if (it != m_Glyphs.end())
+        if (const Glyph *glyph = m_Glyphs.Find(c))
         {
-            width += it->second.advance * scale;
+            width += glyph->advance * scale;
         }
     }
     return width;
@@ -2055,32 +2996,78 @@ float VulkanRenderer::GetTextWidth(const std::string &text, float scale) const
 #ifdef DrawText
 #undef DrawText
 #endif
-void VulkanRenderer::DrawText(const std::string &text, glm::vec2 position, float scale, glm::vec3 color,
+void VulkanRenderer::DrawText(std::string_view text, glm::vec2 position, float scale, glm::vec3 color,
                               float outlineSize, float alpha)
 {
-    if (m_Glyphs.empty() || text.empty())
+    if (m_Glyphs.Empty() || text.empty() || !m_FontAtlas)
+    {
+        return;
+    }
+    if (m_CommandBuffers.empty() || m_CurrentFrame >= m_CommandBuffers.size())
+    {
+        return;
+    }
+
+    VkDescriptorSet descriptorSet = GetOrCreateDescriptorSet(m_FontAtlas->GetVulkanImageView());
+    if (descriptorSet == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    const TextMeshCache::TextMesh *mesh = m_TextMeshes.Find(text, scale, outlineSize);
+    if (!mesh)
+    {
+        TextMeshCache::TextMesh &built = m_TextMeshes.Insert(text, scale, outlineSize);
+        BuildTextMesh(text, scale, outlineSize, built);
+        mesh = &built;
+    }
+
+    // Outline and main quads are one draw; the outline samples the black atlas copy
+    const uint32_t maxVertices = static_cast<uint32_t>(m_VertexBufferSize / sizeof(SpriteVertex));
+    const uint32_t vertexCount = static_cast<uint32_t>(mesh->vertices.size());
+    if (vertexCount == 0 || m_CurrentVertexCount + vertexCount > maxVertices)
     {
         return;
     }
 
+    static_assert(sizeof(SpriteVertex) == sizeof(TextMeshCache::Vertex), "Text meshes are copied as sprite vertices");
+    SpriteVertex *mapped = static_cast<SpriteVertex *>(m_VertexBuffersMapped[m_CurrentFrame]);
+    const uint32_t firstVertex = m_CurrentVertexCount;
+    memcpy(&mapped[firstVertex], mesh->vertices.data(), vertexCount * sizeof(SpriteVertex));
+
+    // Push constants (same layout as sprites, perspective left at zero)
+    SpritePushConstants pushConstants{};
+    pushConstants.projection = m_Projection;
+    pushConstants.model = glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f)); // Meshes are built at the origin
+    pushConstants.spriteColor = color;
+    pushConstants.useColorOnly = 0.0f;
+    pushConstants.colorOnly = glm::vec4(0.0f);
+    pushConstants.spriteAlpha = alpha;            // Text transparency from parameter
+    pushConstants.ambientColor = glm::vec3(1.0f); // Text not affected by ambient lighting
+
+    RecordDraw(m_GraphicsPipeline, descriptorSet, m_VertexBuffers[m_CurrentFrame], firstVertex, vertexCount,
+               pushConstants);
+
+    m_CurrentVertexCount += vertexCount;
+}
+
+void VulkanRenderer::BuildTextMesh(std::string_view text, float scale, float outlineSize,
+                                   TextMeshCache::TextMesh &mesh) const
+{
     // Estimate line height from first glyph
     float lineHeight = 24.0f;
     for (const char c : text)
     {
         if (c == '\n')
             continue;
-        auto it = m_Glyphs.find(c);
-        if (it != m_Glyphs.end())
+        if (const Glyph *glyph = m_Glyphs.Find(c))
         {
-            lineHeight = static_cast<float>(it->second.size.y) * scale;
+            lineHeight = static_cast<float>(glyph->size.y) * scale;
             break;
         }
     }
 
-    VkCommandBuffer commandBuffer = m_CommandBuffers[m_CurrentFrame];
-
-    // Helper lambda to render text at a given position with a given color
-    auto renderTextPass = [&, alpha](glm::vec2 basePos, glm::vec3 passColor)
+    auto buildTextVertices = [&](glm::vec2 basePos, float vOffset)
     {
         float x = basePos.x;
         float y = basePos.y;
@@ -2094,93 +3081,36 @@ void VulkanRenderer::DrawText(const std::string &text, glm::vec2 position, float
                 continue;
             }
 
-            auto it = m_Glyphs.find(c);
-            if (it == m_Glyphs.end())
+            const Glyph *found = m_Glyphs.Find(c);
+            if (!found)
             {
                 continue;
             }
-            const Glyph &glyph = it->second;
-
-            float xpos = x + glyph.bearing.x * scale;
-            float ypos = y - glyph.bearing.y * scale;
-            float w = glyph.size.x * scale;
-            float h = glyph.size.y * scale;
+            const Glyph &glyph = *found;
 
-            struct Vertex
+            // Zero-sized glyphs (space) only advance the cursor
+            if (glyph.size.x > 0 && glyph.size.y > 0)
             {
-                float pos[2];
-                float tex[2];
-            };
-
-            Vertex vertices[6] = {
-                {0.0f, 0.0f, 0.0f, 0.0f}, // Top-left
-                {1.0f, 1.0f, 1.0f, 1.0f}, // Bottom-right
-                {0.0f, 1.0f, 0.0f, 1.0f}, // Bottom-left
-                {0.0f, 0.0f, 0.0f, 0.0f}, // Top-left
-                {1.0f, 0.0f, 1.0f, 0.0f}, // Top-right
-                {1.0f, 1.0f, 1.0f, 1.0f}  // Bottom-right
-            };
-
-            // Capacity check per glyph
-            uint32_t maxVerts = static_cast<uint32_t>(m_VertexBufferSize / sizeof(Vertex));
-            if (m_CurrentVertexCount + 6 > maxVerts)
-            {
-                return;
+                float xpos = x + glyph.bearing.x * scale;
+                float ypos = y - glyph.bearing.y * scale;
+                float w = glyph.size.x * scale;
+                float h = glyph.size.y * scale;
+                float v0 = glyph.v0 + vOffset;
+                float v1 = glyph.v1 + vOffset;
+
+                mesh.vertices.push_back({xpos, ypos, glyph.u0, v0});         // TL
+                mesh.vertices.push_back({xpos + w, ypos + h, glyph.u1, v1}); // BR
+                mesh.vertices.push_back({xpos, ypos + h, glyph.u0, v1});     // BL
+                mesh.vertices.push_back({xpos, ypos, glyph.u0, v0});         // TL
+                mesh.vertices.push_back({xpos + w, ypos, glyph.u1, v0});     // TR
+                mesh.vertices.push_back({xpos + w, ypos + h, glyph.u1, v1}); // BR
             }
 
-            // Copy vertex data into mapped buffer - use current frame's buffer
-            VkDeviceSize vertexDataSize = sizeof(vertices);
-            Vertex *mappedVertices = static_cast<Vertex *>(m_VertexBuffersMapped[m_CurrentFrame]);
-            memcpy(&mappedVertices[m_CurrentVertexCount], vertices, vertexDataSize);
-
-            // Push constants (same layout as sprites)
-            struct CombinedPushConstants
-            {
-                glm::mat4 projection;
-                glm::mat4 model;
-                glm::vec3 spriteColor;
-                float useColorOnly;
-                glm::vec4 colorOnly;
-                float spriteAlpha;
-                float _padding[3];
-                glm::vec3 ambientColor;
-                float _padding2;
-            } pushConstants;
-
-            pushConstants.projection = m_Projection;
-            pushConstants.model = CalculateModelMatrix(glm::vec2(xpos, ypos), glm::vec2(w, h), 0.0f);
-            pushConstants.spriteColor = passColor;
-            pushConstants.useColorOnly = 0.0f;
-            pushConstants.colorOnly = glm::vec4(0.0f);
-            pushConstants.spriteAlpha = alpha;            // Text transparency from parameter
-            pushConstants.ambientColor = glm::vec3(1.0f); // Text not affected by ambient lighting
-
-            vkCmdPushConstants(commandBuffer, m_PipelineLayout,
-                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                               0, 192, &pushConstants);
-
-            // Bind descriptor set for this glyph texture
-            VkDescriptorSet descriptorSet = GetOrCreateDescriptorSet(glyph.imageView);
-            if (descriptorSet == VK_NULL_HANDLE)
-            {
-                x += (glyph.advance >> 6) * scale;
-                continue;
-            }
-            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_PipelineLayout,
-                                    0, 1, &descriptorSet, 0, nullptr);
-
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(commandBuffer, 0, 1, &m_VertexBuffers[m_CurrentFrame], offsets);
-            vkCmdDraw(commandBuffer, 6, 1, m_CurrentVertexCount, 0);
-            ++m_DrawCallCount;
-
-            m_CurrentVertexCount += 6;
             x += (glyph.advance >> 6) * scale;
         }
     };
 
-    // Render outline first (black, in 4 cardinal directions for performance)
-    glm::vec3 outlineColor(0.0f, 0.0f, 0.0f);
+    // Outline first (black atlas copy, in 4 cardinal directions for performance)
     float outlineOffset = 2.0f * scale * outlineSize; // Outline thickness (scaled by outlineSize parameter)
 
     static const int outlineDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
@@ -2188,147 +3118,12 @@ void VulkanRenderer::DrawText(const std::string &text, glm::vec2 position, float
     {
         int dx = outlineDirections[dir][0];
         int dy = outlineDirections[dir][1];
-        glm::vec2 offsetPos = position + glm::vec2(dx * outlineOffset, dy * outlineOffset);
-        renderTextPass(offsetPos, outlineColor);
-    }
-
-    // Render main text on top
-    renderTextPass(position, color);
-}
-
-void VulkanRenderer::CreateGlyphTexture(int width, int height, const std::vector<unsigned char> &rgbaData, Glyph &outGlyph)
-{
-    if (width <= 0 || height <= 0)
-    {
-        // Fallback handled by caller (white texture)
-        outGlyph.image = VK_NULL_HANDLE;
-        outGlyph.memory = VK_NULL_HANDLE;
-        outGlyph.imageView = m_WhiteTextureImageView;
-        return;
+        buildTextVertices(glm::vec2(dx * outlineOffset, dy * outlineOffset), FONT_ATLAS_OUTLINE_V);
     }
+    mesh.outlineVertexCount = mesh.vertices.size();
 
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = static_cast<uint32_t>(width);
-    imageInfo.extent.height = static_cast<uint32_t>(height);
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-
-    VK_CHECK(vkCreateImage(m_Device, &imageInfo, nullptr, &outGlyph.image));
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(m_Device, outGlyph.image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-    VK_CHECK(vkAllocateMemory(m_Device, &allocInfo, nullptr, &outGlyph.memory));
-    vkBindImageMemory(m_Device, outGlyph.image, outGlyph.memory, 0);
-
-    // Create staging buffer
-    VkDeviceSize imageSize = static_cast<VkDeviceSize>(width * height * 4);
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingMemory;
-    CreateBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                 stagingBuffer, stagingMemory);
-
-    void *dataPtr = nullptr;
-    vkMapMemory(m_Device, stagingMemory, 0, imageSize, 0, &dataPtr);
-    memcpy(dataPtr, rgbaData.data(), static_cast<size_t>(imageSize));
-    vkUnmapMemory(m_Device, stagingMemory);
-
-    // One-time command buffer for upload
-    VkCommandBufferAllocateInfo cmdAllocInfo{};
-    cmdAllocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    cmdAllocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    cmdAllocInfo.commandPool = m_CommandPool;
-    cmdAllocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer commandBuffer;
-    VK_CHECK(vkAllocateCommandBuffers(m_Device, &cmdAllocInfo, &commandBuffer));
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo));
-
-    // Transition to transfer dst
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = outGlyph.image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = 0;
-    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    // Copy buffer to image
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1};
-    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, outGlyph.image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-    // Transition to shader read
-    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-    VK_CHECK(vkEndCommandBuffer(commandBuffer));
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    VK_CHECK(vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE));
-    VK_CHECK(vkQueueWaitIdle(m_GraphicsQueue));
-
-    vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
-    vkDestroyBuffer(m_Device, stagingBuffer, nullptr);
-    vkFreeMemory(m_Device, stagingMemory, nullptr);
-
-    // Create image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = outGlyph.image;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-    VK_CHECK(vkCreateImageView(m_Device, &viewInfo, nullptr, &outGlyph.imageView));
+    // Main text on top (white atlas copy, tinted by spriteColor)
+    buildTextVertices(glm::vec2(0.0f), 0.0f);
 }
 
 void VulkanRenderer::LoadFont()
@@ -2348,6 +3143,16 @@ void VulkanRenderer::LoadFont()
 #endif
     };
 
+    const int ATLAS_MAX_WIDTH = 512; // Row width limit before wrapping
+    const int PADDING = 2;           // Gap between glyphs to prevent bleeding
+
+    // Cache glyph bitmaps from the first pass (FreeType reuses its buffer)
+    struct GlyphBitmap
+    {
+        int x = 0, y = 0;
+        std::vector<unsigned char> pixels;
+    };
+
     bool loaded = false;
     for (const auto &fontPath : fontCandidates)
     {
@@ -2361,8 +3166,14 @@ void VulkanRenderer::LoadFont()
 
         FT_Set_Pixel_Sizes(m_Face, 0, 24);
 
-        m_Glyphs.clear();
+        m_Glyphs.Clear();
+        std::map<char, GlyphBitmap> bitmaps;
 
+        // Pass 1: rasterize and shelf-pack, left to right wrapping into rows
+        int atlasWidth = 0;
+        int packedHeight = 0;
+        int rowHeight = 0;
+        int currentX = 0;
         for (unsigned char c = 0; c < 128; c++)
         {
             if (FT_Load_Char(m_Face, c, FT_LOAD_RENDER))
@@ -2370,42 +3181,108 @@ void VulkanRenderer::LoadFont()
                 continue;
             }
 
-            int width = m_Face->glyph->bitmap.width;
-            int height = m_Face->glyph->bitmap.rows;
+            const FT_Bitmap &bitmap = m_Face->glyph->bitmap;
+            int width = static_cast<int>(bitmap.width);
+            int height = static_cast<int>(bitmap.rows);
 
             Glyph glyph;
             glyph.size = glm::ivec2(width, height);
             glyph.bearing = glm::ivec2(m_Face->glyph->bitmap_left, m_Face->glyph->bitmap_top);
             glyph.advance = static_cast<unsigned int>(m_Face->glyph->advance.x);
+            m_Glyphs.Insert(static_cast<char>(c), glyph);
 
-            // Some glyphs (e.g., space) have zero-sized bitmaps. Reuse white texture to avoid invalid images.
+            // Some glyphs (e.g., space) have zero-sized bitmaps and take no atlas space
             if (width == 0 || height == 0)
             {
-                glyph.imageView = m_WhiteTextureImageView;
-                glyph.image = VK_NULL_HANDLE;
-                glyph.memory = VK_NULL_HANDLE;
-                m_Glyphs.insert({static_cast<char>(c), glyph});
                 continue;
             }
 
-            std::vector<unsigned char> rgbaData(static_cast<size_t>(width * height * 4));
-            for (int i = 0; i < width * height; i++)
+            if (currentX + width + PADDING > ATLAS_MAX_WIDTH)
             {
-                unsigned char value = m_Face->glyph->bitmap.buffer[i];
-                rgbaData[i * 4 + 0] = 255;
-                rgbaData[i * 4 + 1] = 255;
-                rgbaData[i * 4 + 2] = 255;
-                rgbaData[i * 4 + 3] = value;
+                packedHeight += rowHeight + PADDING;
+                currentX = 0;
+                rowHeight = 0;
             }
 
-            CreateGlyphTexture(width, height, rgbaData, glyph);
-            m_Glyphs.insert({static_cast<char>(c), glyph});
+            GlyphBitmap &entry = bitmaps[static_cast<char>(c)];
+            entry.x = currentX;
+            entry.y = packedHeight;
+            entry.pixels.resize(static_cast<size_t>(width * height));
+            for (int row = 0; row < height; row++)
+            {
+                memcpy(&entry.pixels[static_cast<size_t>(row * width)],
+                       bitmap.buffer + row * bitmap.pitch, static_cast<size_t>(width));
+            }
+
+            currentX += width + PADDING;
+            rowHeight = std::max(rowHeight, height);
+            atlasWidth = std::max(atlasWidth, currentX);
         }
+        packedHeight += rowHeight;
 
         FT_Done_Face(m_Face);
         m_Face = nullptr;
+
+        if (bitmaps.empty())
+        {
+            m_Glyphs.Clear();
+            continue;
+        }
+
+        // Round up to power of 2, then double the height for the outline copy
+        auto nextPow2 = [](int v)
+        {
+            int p = 1;
+            while (p < v)
+                p <<= 1;
+            return p;
+        };
+        atlasWidth = nextPow2(atlasWidth);
+        const int halfHeight = nextPow2(packedHeight);
+        const int atlasHeight = halfHeight * 2;
+
+        // Pass 2: white glyphs in the top half, black copies in the bottom half,
+        // both with alpha = coverage
+        std::vector<unsigned char> atlasData(static_cast<size_t>(atlasWidth * atlasHeight * 4), 0);
+        for (auto &[c, entry] : bitmaps)
+        {
+            Glyph &glyph = *m_Glyphs.Find(c);
+            int width = glyph.size.x;
+            int height = glyph.size.y;
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    unsigned char value = entry.pixels[static_cast<size_t>(y * width + x)];
+                    size_t white = static_cast<size_t>(((entry.y + y) * atlasWidth + entry.x + x) * 4);
+                    size_t black = white + static_cast<size_t>(halfHeight * atlasWidth * 4);
+                    atlasData[white + 0] = 255;
+                    atlasData[white + 1] = 255;
+                    atlasData[white + 2] = 255;
+                    atlasData[white + 3] = value;
+                    atlasData[black + 3] = value;
+                }
+            }
+
+            glyph.u0 = static_cast<float>(entry.x) / atlasWidth;
+            glyph.v0 = static_cast<float>(entry.y) / atlasHeight;
+            glyph.u1 = static_cast<float>(entry.x + width) / atlasWidth;
+            glyph.v1 = static_cast<float>(entry.y + height) / atlasHeight;
+        }
+
+        m_FontAtlas = std::make_unique<Texture>();
+        if (!m_FontAtlas->LoadFromData(atlasData.data(), atlasWidth, atlasHeight, 4, false))
+        {
+            m_FontAtlas.reset();
+            m_Glyphs.Clear();
+            continue;
+        }
+        m_Uploads.QueueTexture(*m_FontAtlas);
+        m_TextMeshes.Clear();
+
         loaded = true;
-        std::cout << "Loaded font for Vulkan text: " << fontPath << " (" << m_Glyphs.size() << " glyphs)" << std::endl;
+        std::cout << "Loaded font for Vulkan text: " << fontPath << " (atlas " << atlasWidth << "x" << atlasHeight
+                  << ", " << m_Glyphs.Size() << " glyphs)" << std::endl;
         break;
     }
 
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "FrameLruCache.h"
 #include "IRenderer.h"
+#include "VulkanCommandRecorder.h"
+#include "VulkanUploadManager.h"
+#include "GlyphTable.h"
+#include "TextMeshCache.h"
 
 #include <vulkan/vulkan.h>
 #include <vector>
@@ -48,7 +53,9 @@ struct GLFWwindow;
  * | VkCommandBuffer      | Recorded GPU commands                |
  *
  * @par Synchronization
- * Uses double-buffering with semaphores and fences:
+ * Up to MAX_FRAMES_IN_FLIGHT frames, each with its own semaphores, fence,
+ * command buffer and vertex buffer; SetFramesInFlight() picks how many are
+ * used (two by default):
  * @code
  *   Frame N:   [Record Cmds] --> [Submit] ---> [Present]
  *                                   |              |
@@ -57,6 +64,13 @@ struct GLFWwindow;
  *   Frame N+1: [Wait Fence] --> [Record] ----> [Submit] --> ...
  * @endcode
  *
+ * @section vk_recording Command Recording
+ * Draw calls append records to VulkanCommandRecorder instead of writing
+ * into the primary command buffer. EndFrame() encodes them, per segment,
+ * into secondary command buffers on the JobSystem given to SetJobSystem()
+ * and executes those in order from the primary; small frames are encoded
+ * inline. Render passes and timestamps keep their recorded order.
+ *
  * @section vk_batching Sprite Batching
  * Sprites are batched into a persistent mapped vertex buffer to minimize
  * CPU-GPU synchronization. Per-frame buffers avoid write hazards:
@@ -67,19 +81,42 @@ struct GLFWwindow;
  *   Frame 1: Write to m_VertexBuffers[1], GPU reads m_VertexBuffers[0]
  * @endcode
  *
+ * @section vk_descriptors Descriptor Sets
+ * Each texture's set lives in m_DescriptorSetCache, a FrameLruCache of at
+ * most DESCRIPTOR_CACHE_CAPACITY sets keyed by image view. A miss on a full
+ * cache evicts the least recently used set, which is freed once the frames
+ * that may still bind it have finished. When every cached set was used this
+ * frame, the new one comes from the frame slot's transient pool instead,
+ * which is reset wholesale after that slot's fence wait. RenderStats
+ * reports the cache level, creations, evictions and transient sets.
+ *
+ * @section vk_present Presentation
+ * SetPresentMode() recreates the swapchain with FIFO, MAILBOX or IMMEDIATE
+ * (MAILBOX by default), falling back to FIFO when the surface lacks the
+ * requested mode.
+ *
  * @section vk_textures Texture Management
- * Textures are uploaded via staging buffers and cached by Texture pointer:
- * 1. Create staging buffer (host-visible memory)
- * 2. Copy pixel data to staging buffer
- * 3. Record copy command to device-local VkImage
- * 4. Transition image layout to SHADER_READ_ONLY
- * 5. Create VkImageView and cache descriptor set
+ * Textures are uploaded through VulkanUploadManager and cached by Texture pointer:
+ * 1. Create device-local VkImage and VkImageView
+ * 2. Copy pixel data into the shared staging ring
+ * 3. Record the copy into the pending upload batch (transfer queue if available)
+ * 4. Submit the batch at EndFrame(); the frame waits on its semaphore
+ * 5. Cache descriptor set on first draw
+ *
+ * No upload waits for the queue to go idle; staging space is reclaimed
+ * when a batch's fence signals.
+ *
+ * @section vk_pipelines Pipelines
+ * The alpha and additive blend variants are created together in
+ * CreateGraphicsPipeline(), so no pipeline is ever compiled mid-frame.
+ * Both go through a VkPipelineCache that is saved to PIPELINE_CACHE_PATH
+ * and reused on the next launch when the device UUID, vendor, device ID
+ * and driver version all match.
  *
  * @section vk_limitations Current Limitations
- * - Single graphics pipeline (no compute shaders)
+ * - Graphics pipelines only (no compute shaders)
  * - No dynamic descriptor indexing
- * - Fixed descriptor pool size
- * - Synchronous texture uploads
+ * - One combined image sampler per descriptor set
  *
  * @see IRenderer Base interface with method documentation
  * @see OpenGLRenderer Alternative OpenGL implementation
@@ -93,6 +130,7 @@ public:
 
     void Init() override;
     void Shutdown() override;
+    void SetJobSystem(JobSystem *jobs) override { m_Jobs = jobs; }
 
     void BeginFrame() override;
     void EndFrame() override;
@@ -112,18 +150,29 @@ public:
                         glm::vec2 texCoord, glm::vec2 texSize,
                         glm::vec3 color = glm::vec3(1.0f), bool flipY = true) override;
 
+    int CreateStaticMesh(const Texture &texture, const StaticQuad *quads, size_t count, bool flipY) override;
+    void DrawStaticMesh(int mesh, glm::vec2 origin) override;
+    void DestroyStaticMesh(int mesh) override;
+
     void SetProjection(glm::mat4 projection) override { m_Projection = projection; }
     void SetViewport(int x, int y, int width, int height) override;
     void Clear(float r, float g, float b, float a) override;
 
     void UploadTexture(const Texture &texture) override;
+    void UploadTextures(const std::vector<Texture *> &textures, JobSystem *jobs) override;
+    void ReleaseTexture(Texture &texture) override;
+    bool UpdateTextureRegion(const Texture &texture, int x, int y, int width, int height) override;
+    bool ReloadShaders() override;
 
-    void DrawText(const std::string &text, glm::vec2 position, float scale = 1.0f,
+    bool SetPresentMode(PresentMode mode) override;
+    bool SetFramesInFlight(int count) override;
+
+    void DrawText(std::string_view text, glm::vec2 position, float scale = 1.0f,
                   glm::vec3 color = glm::vec3(1.0f), float outlineSize = 1.0f,
                   float alpha = 0.85f) override;
 
     float GetTextAscent(float scale = 1.0f) const override;
-    float GetTextWidth(const std::string& text, float scale = 1.0f) const override;
+    float GetTextWidth(std::string_view text, float scale = 1.0f) const override;
 
     /// @brief Vulkan uses same Y-flip convention as OpenGL for UV compatibility.
     bool RequiresYFlip() const override { return true; }
@@ -132,6 +181,15 @@ public:
 
     int GetDrawCallCount() const override { return m_DrawCallCount; }
 
+    /// @brief Record a timestamp and start a new recording segment.
+    void BeginGpuTimer(const char *name) override;
+    void EndGpuTimer() override;
+
+    /// @brief Split the frame's render pass around an offscreen target pass.
+    bool BeginLowResPass(int width, int height) override;
+    /// @brief Resume the swapchain pass and draw the target as one nearest-sampled quad.
+    void EndLowResPass(int x, int y, int width, int height) override;
+
 private:
     /// @name Sprite Helpers
     /// @{
@@ -141,6 +199,27 @@ private:
         float tex[2];
     };
 
+    /**
+     * @brief Push constant block shared by sprite.vert and sprite.frag.
+     *
+     * Layout must match the explicit offsets in both shaders.
+     */
+    struct SpritePushConstants
+    {
+        glm::mat4 projection;    ///< 0-63: orthographic projection.
+        glm::mat4 model;         ///< 64-127: per-draw model matrix.
+        glm::vec3 spriteColor;   ///< 128-139: tint color.
+        float useColorOnly;      ///< 140-143: solid color mode flag.
+        glm::vec4 colorOnly;     ///< 144-159: solid RGBA color.
+        float spriteAlpha;       ///< 160-163: alpha multiplier.
+        float _padding[3];       ///< 164-175: align ambientColor.
+        glm::vec3 ambientColor;  ///< 176-187: day/night ambient.
+        float _padding2;         ///< 188-191: align perspective block.
+        glm::vec4 perspParams0;  ///< 192-207: GPU perspective center/horizon.
+        glm::vec4 perspParams1;  ///< 208-223: GPU perspective scales/flags.
+    };
+    static_assert(sizeof(SpritePushConstants) == 224, "Push constant layout must match sprite shaders");
+
     static void BuildQuadVertices(SpriteVertex outVertices[6],
                                   const glm::vec2 corners[4],
                                   const glm::vec2 texCoords[4]);
@@ -149,7 +228,13 @@ private:
                     const SpriteVertex vertices[6],
                     glm::vec3 spriteColor, float spriteAlpha,
                     bool useColorOnly = false,
-                    glm::vec4 colorOnly = glm::vec4(0.0f));
+                    glm::vec4 colorOnly = glm::vec4(0.0f),
+                    bool applyPerspective = true,
+                    bool additive = false);
+
+    /// @brief Record a draw with m_Recorder and count it.
+    void RecordDraw(VkPipeline pipeline, VkDescriptorSet descriptorSet, VkBuffer vertexBuffer,
+                    uint32_t firstVertex, uint32_t vertexCount, const SpritePushConstants &pushConstants);
     /// @}
 
     /// @name Performance Metrics
@@ -161,20 +246,33 @@ private:
     /// @name Text Rendering (FreeType)
     /// @{
 
+    /**
+     * @brief Glyph metrics and UV rectangle in the font atlas.
+     *
+     * The atlas holds every glyph twice: white in the top half and black
+     * in the bottom half (same layout, V offset by FONT_ATLAS_OUTLINE_V).
+     * Outline quads sample the black copy, so the spriteColor tint leaves
+     * them black and a whole string, outline included, is a single draw.
+     */
     struct Glyph
     {
-        VkImage image{VK_NULL_HANDLE};
-        VkDeviceMemory memory{VK_NULL_HANDLE};
-        VkImageView imageView{VK_NULL_HANDLE};
         glm::ivec2 size{0, 0};
         glm::ivec2 bearing{0, 0};
         unsigned int advance{0};
+        float u0{0.0f}, v0{0.0f}, u1{0.0f}, v1{0.0f};  ///< White glyph in the atlas.
     };
 
+    /// @brief V offset from a glyph's white copy to its black outline copy.
+    static constexpr float FONT_ATLAS_OUTLINE_V = 0.5f;
+
     void LoadFont();
-    void CreateGlyphTexture(int width, int height, const std::vector<unsigned char> &rgbaData, Glyph &outGlyph);
 
-    std::map<char, Glyph> m_Glyphs;      ///< Cached glyph textures.
+    /// @brief Append the outline and main quads of @p text at the origin to @p mesh.
+    void BuildTextMesh(std::string_view text, float scale, float outlineSize, TextMeshCache::TextMesh &mesh) const;
+
+    GlyphTable<Glyph> m_Glyphs;              ///< Glyph lookup table.
+    TextMeshCache m_TextMeshes;              ///< Quads of recently drawn strings, placed by the model matrix.
+    std::unique_ptr<Texture> m_FontAtlas;    ///< Packed glyphs, uploaded via m_Uploads.
 
 #ifdef USE_FREETYPE
     FT_Library m_FreeType{nullptr};
@@ -190,6 +288,7 @@ private:
     VkDevice m_Device;                   ///< Logical device for commands.
     VkQueue m_GraphicsQueue;             ///< Queue for draw commands.
     VkQueue m_PresentQueue;              ///< Queue for presentation.
+    VkQueue m_TransferQueue;             ///< Queue for texture uploads (may equal graphics).
     /// @}
 
     /// @name Surface and Swapchain
@@ -201,19 +300,34 @@ private:
     std::vector<VkFramebuffer> m_SwapchainFramebuffers;
     VkExtent2D m_SwapchainExtent;                     ///< Swapchain dimensions.
     VkFormat m_SwapchainImageFormat;                  ///< Pixel format.
+    PresentMode m_RequestedPresentMode{PresentMode::Mailbox};
+    VkPresentModeKHR m_PresentMode{VK_PRESENT_MODE_FIFO_KHR};  ///< Mode the swapchain was created with.
     /// @}
 
     /// @name Render Pass and Pipeline
     /// @{
     VkRenderPass m_RenderPass;           ///< Defines attachment usage.
     VkPipelineLayout m_PipelineLayout;   ///< Descriptor/push constant layout.
-    VkPipeline m_GraphicsPipeline;       ///< Compiled shader + state.
+    VkPipeline m_GraphicsPipeline;       ///< Compiled shader + state, alpha blending.
+    VkPipeline m_AdditivePipeline;       ///< Same state with additive blending.
+    /// @}
+
+    /// @name Pipeline Cache
+    /// @{
+    /// @brief Cache file, written next to the executable like the shader binaries.
+    static constexpr const char *PIPELINE_CACHE_PATH = "vulkan_pipeline_cache.bin";
+    VkPipelineCache m_PipelineCache;     ///< Driver cache shared by all pipeline builds.
+    size_t m_PipelineCacheLoadedSize;    ///< Bytes accepted from disk (0 = cold start).
+    void LoadPipelineCache();            ///< Create m_PipelineCache, seeded from disk if valid.
+    void SavePipelineCache();            ///< Write m_PipelineCache to disk if it changed.
     /// @}
 
     /// @name Command Recording
     /// @{
     VkCommandPool m_CommandPool;                   ///< Command buffer allocator.
     std::vector<VkCommandBuffer> m_CommandBuffers; ///< Per-frame command buffers.
+    VulkanCommandRecorder m_Recorder;              ///< This frame's draws, encoded at EndFrame().
+    JobSystem *m_Jobs = nullptr;                   ///< Encodes secondaries (nullptr = inline).
     /// @}
 
     /// @name Synchronization
@@ -225,16 +339,17 @@ private:
 
     /// @name Frame State
     /// @{
-    size_t m_CurrentFrame;    ///< Current frame index (0 or 1).
+    size_t m_CurrentFrame;    ///< Current frame slot, below m_FramesInFlight.
+    size_t m_FramesInFlight{2};  ///< Slots in use, 1 to MAX_FRAMES_IN_FLIGHT.
     uint32_t m_ImageIndex;    ///< Acquired swapchain image index.
     GLFWwindow *m_Window;     ///< GLFW window reference.
     glm::mat4 m_Projection;   ///< Current orthographic projection.
     /// @}
 
 
-    /// @name Vertex Buffers (Double-Buffered)
+    /// @name Vertex Buffers (One per Frame Slot)
     /// @{
-    static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+    static constexpr int MAX_FRAMES_IN_FLIGHT = 3;
     VkBuffer m_VertexBuffers[MAX_FRAMES_IN_FLIGHT];
     VkDeviceMemory m_VertexBufferMemories[MAX_FRAMES_IN_FLIGHT];
     void *m_VertexBuffersMapped[MAX_FRAMES_IN_FLIGHT];  ///< Persistent mapping.
@@ -244,6 +359,63 @@ private:
     uint32_t m_CurrentVertexCount;
     /// @}
 
+    /// @name GPU Timers
+    /// @{
+    /// Timestamp queries, GpuTimerFrame::MAX_QUERIES per frame in flight.
+    /// Each frame's block is read back after its in-flight fence signals.
+    VkQueryPool m_TimestampPool{VK_NULL_HANDLE};
+    GpuTimerFrame m_GpuTimerFrames[MAX_FRAMES_IN_FLIGHT];
+    double m_TimestampPeriod{1.0};         ///< Nanoseconds per timestamp tick.
+    uint64_t m_TimestampMask{~0ull};       ///< Valid bits of the graphics queue's timestamps.
+    bool m_GpuTimersRecording{false};      ///< Current command buffer has reset its query block.
+    void CreateTimestampPool();            ///< No-op when the graphics queue has no timestamps.
+    void ResolveGpuTimers();               ///< Read back m_CurrentFrame's finished block.
+    /// @}
+
+    /// @name Low-Resolution Pass
+    /// @{
+    /// Offscreen color target in the swapchain format. m_LowResRenderPass is
+    /// compatible with m_RenderPass, so both pipelines draw into it unchanged.
+    VkRenderPass m_LowResRenderPass{VK_NULL_HANDLE};  ///< Clears, ends in SHADER_READ_ONLY_OPTIMAL.
+    VkImage m_LowResImage{VK_NULL_HANDLE};
+    VkDeviceMemory m_LowResMemory{VK_NULL_HANDLE};
+    VkImageView m_LowResImageView{VK_NULL_HANDLE};
+    VkFramebuffer m_LowResFramebuffer{VK_NULL_HANDLE};
+    VkDescriptorSet m_LowResDescriptorSet{VK_NULL_HANDLE};  ///< Rewritten when the target is recreated.
+    uint32_t m_LowResWidth{0};
+    uint32_t m_LowResHeight{0};
+    bool m_LowResActive{false};            ///< The offscreen pass is open.
+    bool m_RenderPassOpen{false};          ///< A render pass is open in the current command buffer.
+    bool m_FrameOpen{false};               ///< Between BeginFrame()'s fence reset and the submit.
+    void CreateLowResRenderPass();
+    void CreateLowResTarget(uint32_t width, uint32_t height);  ///< Waits for the device to go idle.
+    void DestroyLowResTarget();
+    /// @brief Record @p renderPass on @p framebuffer with a Y-flipped viewport covering it.
+    void BeginRenderPass(VkRenderPass renderPass, VkFramebuffer framebuffer, VkExtent2D extent);
+    /// @}
+
+    /// @name Static Meshes
+    /// @{
+
+    /// @brief Host-visible vertex buffer created by CreateStaticMesh().
+    struct StaticMesh
+    {
+        VkBuffer buffer = VK_NULL_HANDLE;        ///< SpriteVertex triangle list.
+        VkDeviceMemory memory = VK_NULL_HANDLE;  ///< Backing allocation.
+        uint32_t vertexCount = 0;                ///< 6 per quad.
+        const Texture *texture = nullptr;        ///< Sampled texture.
+    };
+
+    std::vector<StaticMesh> m_StaticMeshes;  ///< Indexed by mesh handle.
+    std::vector<int> m_FreeStaticMeshes;     ///< Recycled handles.
+
+    /// Meshes destroyed while a frame may still read them, freed once that
+    /// frame's fence has signaled in BeginFrame().
+    std::vector<StaticMesh> m_RetiredStaticMeshes[MAX_FRAMES_IN_FLIGHT];
+
+    void FreeStaticMeshBuffers(StaticMesh &mesh);
+    /// @}
+
     /// @name Sprite Batching
     /// @{
     VkImageView m_BatchImageView;           ///< Current batched texture.
@@ -252,19 +424,34 @@ private:
     void FlushSpriteBatch();                ///< Submit batch to GPU.
     /// @}
 
-    /// @name Staging Buffer
+    /// @name Texture Uploads
     /// @{
-    VkBuffer m_StagingBuffer;
-    VkDeviceMemory m_StagingBufferMemory;
-    void *m_StagingBufferMapped;
+    VulkanUploadManager m_Uploads;          ///< Staging ring + async upload batches.
+    std::vector<VkSemaphore> m_FrameWaitSemaphores;     ///< Scratch wait list for EndFrame().
+    std::vector<VkPipelineStageFlags> m_FrameWaitStages;///< Stages matching m_FrameWaitSemaphores.
     /// @}
 
     /// @name Descriptors
     /// @{
-    VkDescriptorPool m_DescriptorPool;
+    /// @brief Texture sets kept in m_DescriptorSetCache.
+    static constexpr size_t DESCRIPTOR_CACHE_CAPACITY = 512;
+    /// @brief Sets each frame slot's transient pool holds.
+    static constexpr uint32_t TRANSIENT_DESCRIPTOR_SETS = 256;
+
+    VkDescriptorPool m_DescriptorPool;       ///< Cached, retired and fixed sets (individually freed).
     VkDescriptorSetLayout m_DescriptorSetLayout;
     VkSampler m_TextureSampler;              ///< Shared texture sampler.
-    std::unordered_map<VkImageView, VkDescriptorSet> m_DescriptorSetCache;
+    FrameLruCache<VkImageView, VkDescriptorSet> m_DescriptorSetCache{DESCRIPTOR_CACHE_CAPACITY};
+
+    /// Overflow when the cache cannot evict, reset after each slot's fence wait.
+    VkDescriptorPool m_TransientDescriptorPools[MAX_FRAMES_IN_FLIGHT]{};
+    std::unordered_map<VkImageView, VkDescriptorSet> m_TransientDescriptorSets;  ///< This frame's, by view.
+
+    /// Evicted cache entries, freed once the frames that may bind them have finished.
+    std::vector<VkDescriptorSet> m_RetiredDescriptorSets[MAX_FRAMES_IN_FLIGHT];
+
+    /// @brief Allocate a set from @p pool pointing at @p imageView, or VK_NULL_HANDLE.
+    VkDescriptorSet AllocateTextureDescriptorSet(VkDescriptorPool pool, VkImageView imageView);
     /// @}
 
     /// @name White Texture (for colored rects)
@@ -286,6 +473,28 @@ private:
     };
     std::unordered_map<const Texture*, TextureResources> m_TextureCache;
     std::vector<Texture*> m_UploadedTextures;
+
+    /// A released texture's GPU resources and descriptor set, kept until the
+    /// frame that may still sample them has finished.
+    struct RetiredTexture
+    {
+        Texture texture;                                ///< Owns the Vulkan image, memory, view and sampler.
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE; ///< From m_DescriptorSetCache, if one was made.
+    };
+    std::vector<RetiredTexture> m_RetiredTextures[MAX_FRAMES_IN_FLIGHT];
+
+    /// Pipelines replaced by ReloadShaders(), destroyed once the frames that
+    /// may have bound them have finished.
+    std::vector<VkPipeline> m_RetiredPipelines[MAX_FRAMES_IN_FLIGHT];
+
+    /// Free the textures, descriptor sets and pipelines retired into slot @p frame
+    void FreeRetiredTextures(int frame);
+
+    /// @brief Release everything slot @p frame held; its fence must have signaled.
+    void CompleteFrameSlot(size_t frame);
+
+    /// @brief Slot of the most recent submission (call between frames).
+    size_t GetLastSubmittedSlot() const { return (m_CurrentFrame + m_FramesInFlight - 1) % m_FramesInFlight; }
     /// @}
 
     /// @name Initialization Helpers
@@ -298,6 +507,9 @@ private:
     void CreateImageViews();
     void CreateRenderPass();
     void CreateGraphicsPipeline();
+
+    /// @brief Compile the alpha and additive sprite pipelines from the SPIR-V files; false on failure.
+    bool BuildSpritePipelines(VkPipeline outPipelines[2]);
     void CreateFramebuffers();
     void CreateCommandPool();
     void CreateCommandBuffers();
@@ -332,6 +544,7 @@ private:
     /// @{
     uint32_t m_GraphicsFamily;
     uint32_t m_PresentFamily;
+    uint32_t m_TransferFamily = UINT32_MAX;  ///< Transfer-only family, or m_GraphicsFamily if none.
     /// @}
 
     /// @name Validation and Extensions
@@ -1,19 +1,32 @@
 #include "VulkanRenderer.h"
+#include "VulkanCommon.h"
 
 #include <iostream>
 #include <stdexcept>
 #include <cstring>
 
-#define VK_CHECK(x)                                                                                         \
-    do                                                                                                      \
-    {                                                                                                       \
-        VkResult result = x;                                                                                \
-        if (result != VK_SUCCESS)                                                                           \
-        {                                                                                                   \
-            std::cerr << "Vulkan error at " << __FILE__ << ":" << __LINE__ << " - " << result << std::endl; \
-            throw std::runtime_error("Vulkan operation failed");                                            \
-        }                                                                                                   \
-    } while (0)
+// Submit a one-shot command buffer and wait on its own fence. Unlike
+// vkQueueWaitIdle this does not also wait for frames still in flight
+static void SubmitAndWait(VkDevice device, VkQueue queue, VkCommandBuffer commandBuffer)
+{
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence = VK_NULL_HANDLE;
+    VK_CHECK(vkCreateFence(device, &fenceInfo, nullptr, &fence));
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+
+    VkResult result = vkQueueSubmit(queue, 1, &submitInfo, fence);
+    if (result == VK_SUCCESS)
+    {
+        result = vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+    }
+    vkDestroyFence(device, fence, nullptr);
+    VK_CHECK(result);
+}
 
 uint32_t VulkanRenderer::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
 {
@@ -74,13 +87,7 @@ void VulkanRenderer::CopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDevice
     vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
     vkEndCommandBuffer(commandBuffer);
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(m_GraphicsQueue);
+    SubmitAndWait(m_Device, m_GraphicsQueue, commandBuffer);
 
     vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
 }
@@ -130,19 +137,31 @@ void VulkanRenderer::CreateBuffers()
 
 void VulkanRenderer::CreateDescriptorPool()
 {
+    // The cache at capacity, as many evicted or released sets waiting for
+    // their frame slot again, and the low-res target's fixed set
+    const uint32_t persistentSets = static_cast<uint32_t>(DESCRIPTOR_CACHE_CAPACITY) * 2 + 16;
+
     VkDescriptorPoolSize poolSize{};
     poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    // Allocate enough for many textures (1000 should be plenty for most games)
-    poolSize.descriptorCount = 1000;
+    poolSize.descriptorCount = persistentSets;
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 1;
     poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1000;                                            // Allow up to 1000 descriptor sets
+    poolInfo.maxSets = persistentSets;
     poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // Allow freeing individual sets
 
     VK_CHECK(vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &m_DescriptorPool));
+
+    // Transient pools are only ever reset whole, so no free flag
+    poolSize.descriptorCount = TRANSIENT_DESCRIPTOR_SETS;
+    poolInfo.maxSets = TRANSIENT_DESCRIPTOR_SETS;
+    poolInfo.flags = 0;
+    for (VkDescriptorPool &pool : m_TransientDescriptorPools)
+    {
+        VK_CHECK(vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &pool));
+    }
 }
 
 void VulkanRenderer::CreateWhiteTexture()
@@ -285,13 +304,7 @@ void VulkanRenderer::CreateWhiteTexture()
     vkEndCommandBuffer(commandBuffer);
 
     // Submit
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-
-    vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(m_GraphicsQueue);
+    SubmitAndWait(m_Device, m_GraphicsQueue, commandBuffer);
 
     vkFreeCommandBuffers(m_Device, m_CommandPool, 1, &commandBuffer);
     vkDestroyBuffer(m_Device, stagingBuffer, nullptr);
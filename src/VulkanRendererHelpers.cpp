@@ -1,21 +1,11 @@
 #include "VulkanRenderer.h"
+#include "VulkanCommon.h"
 #include "Texture.h"
 
 #include <iostream>
 #include <cstring>
 #include <stdexcept>
 
-#define VK_CHECK(x)                                                                                          \
-    do                                                                                                       \
-    {                                                                                                        \
-        VkResult result = x;                                                                                 \
-        if (result != VK_SUCCESS)                                                                            \
-        {                                                                                                    \
-            std::cerr << "Vulkan error at " << __FILE__ << ":" << __LINE__ << " - " << result << std::endl;  \
-            throw std::runtime_error("Vulkan operation failed");                                             \
-        }                                                                                                    \
-    } while (0)
-
 void VulkanRenderer::TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout)
 {
     VkCommandBuffer commandBuffer = m_CommandBuffers[m_CurrentFrame];
@@ -0,0 +1,624 @@
+#include "VulkanUploadManager.h"
+#include "VulkanCommon.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Texture.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+VulkanUploadManager::~VulkanUploadManager()
+{
+    Shutdown();
+}
+
+void VulkanUploadManager::Init(VkDevice device, VkPhysicalDevice physicalDevice,
+                               uint32_t graphicsFamily, uint32_t transferFamily, VkQueue transferQueue,
+                               uint32_t frameSlots)
+{
+    m_Device = device;
+    m_PhysicalDevice = physicalDevice;
+    m_GraphicsFamily = graphicsFamily;
+    m_TransferFamily = transferFamily;
+    m_TransferQueue = transferQueue;
+    m_QueueFamilies.clear();
+    m_QueueFamilies.push_back(graphicsFamily);
+    if (transferFamily != graphicsFamily)
+    {
+        m_QueueFamilies.push_back(transferFamily);
+    }
+    m_WaitedBySlot.assign(frameSlots, {});
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = transferFamily;
+    VK_CHECK(vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_CommandPool));
+
+    // One persistently mapped ring replaces a staging buffer per texture
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = STAGING_RING_SIZE;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    VK_CHECK(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &m_RingBuffer));
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(m_Device, m_RingBuffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits,
+                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    VK_CHECK(vkAllocateMemory(m_Device, &allocInfo, nullptr, &m_RingMemory));
+    VK_CHECK(vkBindBufferMemory(m_Device, m_RingBuffer, m_RingMemory, 0));
+
+    void *mapped = nullptr;
+    VK_CHECK(vkMapMemory(m_Device, m_RingMemory, 0, STAGING_RING_SIZE, 0, &mapped));
+    m_RingMapped = static_cast<unsigned char *>(mapped);
+    m_RingHead = 0;
+    m_RingTail = 0;
+
+    std::cout << "Vulkan uploads: " << (HasDedicatedTransferQueue() ? "dedicated transfer queue" : "graphics queue")
+              << ", " << (STAGING_RING_SIZE / (1024 * 1024)) << " MB staging ring" << std::endl;
+}
+
+void VulkanUploadManager::Shutdown()
+{
+    if (m_Device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    // Caller guarantees the device is idle, so every batch is complete
+    if (m_PendingOpen)
+    {
+        vkEndCommandBuffer(m_Pending.commandBuffer);
+        ReleaseBatch(m_Pending);
+        m_FreeBatches.push_back(std::move(m_Pending));
+        m_Pending = Batch{};
+        m_PendingOpen = false;
+    }
+    while (!m_InFlight.empty())
+    {
+        ReleaseBatch(m_InFlight.front());
+        m_FreeBatches.push_back(std::move(m_InFlight.front()));
+        m_InFlight.pop_front();
+    }
+    for (Batch &batch : m_FreeBatches)
+    {
+        if (batch.fence != VK_NULL_HANDLE)
+        {
+            vkDestroyFence(m_Device, batch.fence, nullptr);
+        }
+    }
+    m_FreeBatches.clear();
+
+    for (VkSemaphore semaphore : m_Signaled)
+    {
+        vkDestroySemaphore(m_Device, semaphore, nullptr);
+    }
+    for (std::vector<VkSemaphore> &slot : m_WaitedBySlot)
+    {
+        for (VkSemaphore semaphore : slot)
+        {
+            vkDestroySemaphore(m_Device, semaphore, nullptr);
+        }
+    }
+    for (VkSemaphore semaphore : m_FreeSemaphores)
+    {
+        vkDestroySemaphore(m_Device, semaphore, nullptr);
+    }
+    m_Signaled.clear();
+    m_WaitedBySlot.clear();
+    m_FreeSemaphores.clear();
+
+    // Destroying the pool frees every command buffer allocated from it
+    if (m_CommandPool != VK_NULL_HANDLE)
+    {
+        vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+        m_CommandPool = VK_NULL_HANDLE;
+    }
+    if (m_RingMapped)
+    {
+        vkUnmapMemory(m_Device, m_RingMemory);
+        m_RingMapped = nullptr;
+    }
+    if (m_RingBuffer != VK_NULL_HANDLE)
+    {
+        vkDestroyBuffer(m_Device, m_RingBuffer, nullptr);
+        m_RingBuffer = VK_NULL_HANDLE;
+    }
+    if (m_RingMemory != VK_NULL_HANDLE)
+    {
+        vkFreeMemory(m_Device, m_RingMemory, nullptr);
+        m_RingMemory = VK_NULL_HANDLE;
+    }
+
+    m_Device = VK_NULL_HANDLE;
+}
+
+void VulkanUploadManager::QueueTexture(Texture &texture)
+{
+    QueueTextures({&texture}, nullptr);
+}
+
+void VulkanUploadManager::QueueTextures(const std::vector<Texture *> &textures, JobSystem *jobs)
+{
+    // Staging written by the host must be complete before its batch is
+    // submitted, so pending copies run whenever staging might submit
+    struct Copy
+    {
+        unsigned char *staging;
+        const unsigned char *pixels;
+        size_t size;
+        VkBuffer buffer;  ///< Dedicated buffer to unmap afterwards, on its first piece only
+    };
+    std::vector<Copy> copies;
+
+    auto runCopies = [&]()
+    {
+        if (copies.empty())
+            return;
+        WILD_PROFILE_ZONE("Stage Textures");
+        auto copyRange = [&copies](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                std::memcpy(copies[i].staging, copies[i].pixels, copies[i].size);
+        };
+        if (jobs && copies.size() > 1)
+            jobs->ParallelFor(copies.size(), 1, copyRange);
+        else
+            copyRange(0, copies.size());
+
+        for (const Copy &copy : copies)
+        {
+            if (copy.buffer != VK_NULL_HANDLE)
+                FinishStaging(copy.buffer);
+        }
+        copies.clear();
+    };
+
+    for (Texture *texture : textures)
+    {
+        if (texture->m_ImageData.empty())
+        {
+            std::cerr << "Cannot create Vulkan texture: no image data" << std::endl;
+            continue;
+        }
+
+        texture->CreateVulkanImage(m_Device, m_PhysicalDevice, m_QueueFamilies);
+        if (texture->m_VulkanImage == VK_NULL_HANDLE)
+        {
+            continue;
+        }
+
+        const VkDeviceSize size = texture->GetVulkanUploadSize();
+        const VkDeviceSize texelSize = static_cast<VkDeviceSize>(texture->GetChannels());
+        if (!CanStageWithoutWaiting(size, texelSize))
+        {
+            runCopies();
+        }
+
+        VkBuffer source = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+        unsigned char *staging = Stage(size, texelSize, source, offset);
+        const unsigned char *pixels = texture->m_ImageData.data();
+        for (size_t done = 0; done < static_cast<size_t>(size); done += STAGING_COPY_GRAIN)
+        {
+            const size_t piece = std::min(STAGING_COPY_GRAIN, static_cast<size_t>(size) - done);
+            copies.push_back({staging + done, pixels + done, piece, done == 0 ? source : VK_NULL_HANDLE});
+        }
+
+        const VkExtent3D extent{static_cast<uint32_t>(texture->GetWidth()),
+                                static_cast<uint32_t>(texture->GetHeight()), 1};
+        RecordImageCopy(m_Pending.commandBuffer, *texture, source, offset, {0, 0, 0}, extent, false);
+        ++m_Pending.textureCount;
+    }
+    runCopies();
+}
+
+bool VulkanUploadManager::QueueTextureRegion(Texture &texture, int x, int y, int width, int height)
+{
+    const int channels = texture.GetChannels();
+    const size_t expected = static_cast<size_t>(texture.GetWidth()) * static_cast<size_t>(texture.GetHeight()) *
+                            static_cast<size_t>(channels);
+    if (texture.m_VulkanImage == VK_NULL_HANDLE || texture.m_VulkanDevice != m_Device ||
+        x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > texture.GetWidth() || y + height > texture.GetHeight() ||
+        texture.m_ImageData.size() != expected)
+    {
+        return false;
+    }
+
+    // Only the rectangle is staged, packed row after row
+    const size_t rowBytes = static_cast<size_t>(width) * static_cast<size_t>(channels);
+    const size_t srcStride = static_cast<size_t>(texture.GetWidth()) * static_cast<size_t>(channels);
+    const VkDeviceSize size = static_cast<VkDeviceSize>(rowBytes) * static_cast<VkDeviceSize>(height);
+
+    VkBuffer source = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    unsigned char *staging = Stage(size, static_cast<VkDeviceSize>(channels), source, offset);
+    const unsigned char *pixels = texture.m_ImageData.data() + static_cast<size_t>(y) * srcStride +
+                                  static_cast<size_t>(x) * static_cast<size_t>(channels);
+    for (int row = 0; row < height; ++row)
+    {
+        std::memcpy(staging + static_cast<size_t>(row) * rowBytes, pixels + static_cast<size_t>(row) * srcStride,
+                    rowBytes);
+    }
+    FinishStaging(source);
+
+    RecordImageCopy(m_Pending.commandBuffer, texture, source, offset, {x, y, 0},
+                    {static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1}, true);
+    ++m_Pending.textureCount;
+    return true;
+}
+
+void VulkanUploadManager::Submit()
+{
+    if (!m_PendingOpen)
+    {
+        return;
+    }
+
+    VK_CHECK(vkEndCommandBuffer(m_Pending.commandBuffer));
+
+    VkSemaphore signal = AcquireSemaphore();
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &m_Pending.commandBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &signal;
+
+    VK_CHECK(vkQueueSubmit(m_TransferQueue, 1, &submitInfo, m_Pending.fence));
+
+    m_Pending.ringEnd = m_RingHead;
+    m_InFlight.push_back(std::move(m_Pending));
+    m_Pending = Batch{};
+    m_PendingOpen = false;
+    m_Signaled.push_back(signal);
+}
+
+void VulkanUploadManager::TakeWaitSemaphores(uint32_t frameSlot, std::vector<VkSemaphore> &out)
+{
+    if (m_Signaled.empty() || frameSlot >= m_WaitedBySlot.size())
+    {
+        return;
+    }
+    out.insert(out.end(), m_Signaled.begin(), m_Signaled.end());
+    std::vector<VkSemaphore> &waited = m_WaitedBySlot[frameSlot];
+    waited.insert(waited.end(), m_Signaled.begin(), m_Signaled.end());
+    m_Signaled.clear();
+}
+
+void VulkanUploadManager::OnFrameSlotComplete(uint32_t frameSlot)
+{
+    if (frameSlot < m_WaitedBySlot.size())
+    {
+        // The submission that waited on these has finished, so the wait
+        // operations completed and the semaphores are unsignaled again
+        std::vector<VkSemaphore> &waited = m_WaitedBySlot[frameSlot];
+        m_FreeSemaphores.insert(m_FreeSemaphores.end(), waited.begin(), waited.end());
+        waited.clear();
+    }
+    RetireBatches(false);
+}
+
+void VulkanUploadManager::BeginBatch()
+{
+    if (m_PendingOpen)
+    {
+        return;
+    }
+
+    if (!m_FreeBatches.empty())
+    {
+        m_Pending = std::move(m_FreeBatches.back());
+        m_FreeBatches.pop_back();
+    }
+    else
+    {
+        m_Pending = Batch{};
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = m_CommandPool;
+        allocInfo.commandBufferCount = 1;
+        VK_CHECK(vkAllocateCommandBuffers(m_Device, &allocInfo, &m_Pending.commandBuffer));
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        VK_CHECK(vkCreateFence(m_Device, &fenceInfo, nullptr, &m_Pending.fence));
+    }
+
+    VK_CHECK(vkResetCommandBuffer(m_Pending.commandBuffer, 0));
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(m_Pending.commandBuffer, &beginInfo));
+    m_PendingOpen = true;
+}
+
+bool VulkanUploadManager::AllocateStaging(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset)
+{
+    if (size > STAGING_RING_SIZE)
+    {
+        return false;
+    }
+
+    while (!TryAllocate(size, alignment, outOffset))
+    {
+        // Space held by the batch being recorded only frees after it is submitted
+        if (m_PendingOpen && m_InFlight.empty())
+        {
+            Submit();
+        }
+        if (m_InFlight.empty())
+        {
+            return false;
+        }
+        RetireBatches(true);
+    }
+    return true;
+}
+
+bool VulkanUploadManager::TryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset)
+{
+    VkDeviceSize padding = 0;
+    if (!FindSpace(size, alignment, outOffset, padding))
+    {
+        return false;
+    }
+    m_RingHead += padding + size;
+    return true;
+}
+
+bool VulkanUploadManager::FindSpace(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset,
+                                    VkDeviceSize &outPadding) const
+{
+    const VkDeviceSize used = m_RingHead - m_RingTail;
+    const VkDeviceSize start = m_RingHead % STAGING_RING_SIZE;
+
+    VkDeviceSize aligned = (start + alignment - 1) / alignment * alignment;
+    if (aligned + size > STAGING_RING_SIZE)
+    {
+        // Skip the tail end of the ring and wrap to offset 0
+        aligned = 0;
+    }
+    const VkDeviceSize padding = (aligned >= start) ? aligned - start : STAGING_RING_SIZE - start;
+
+    if (used + padding + size > STAGING_RING_SIZE)
+    {
+        return false;
+    }
+
+    outOffset = aligned;
+    outPadding = padding;
+    return true;
+}
+
+bool VulkanUploadManager::CanStageWithoutWaiting(VkDeviceSize size, VkDeviceSize texelSize) const
+{
+    if (size > STAGING_RING_SIZE / 2)
+    {
+        return true;  // Dedicated buffer, the ring is not touched
+    }
+    VkDeviceSize offset = 0;
+    VkDeviceSize padding = 0;
+    return FindSpace(size, StagingAlignment(texelSize), offset, padding);
+}
+
+VkDeviceSize VulkanUploadManager::StagingAlignment(VkDeviceSize texelSize)
+{
+    // bufferOffset must be a multiple of both 4 and the texel size
+    return (texelSize % 4 == 0) ? texelSize : texelSize * 4;
+}
+
+void VulkanUploadManager::RetireBatches(bool waitOldest)
+{
+    if (waitOldest && !m_InFlight.empty())
+    {
+        // Only reached when the ring is full; blocks on one batch, not the queue
+        VK_CHECK(vkWaitForFences(m_Device, 1, &m_InFlight.front().fence, VK_TRUE, UINT64_MAX));
+    }
+
+    while (!m_InFlight.empty() && vkGetFenceStatus(m_Device, m_InFlight.front().fence) == VK_SUCCESS)
+    {
+        Batch batch = std::move(m_InFlight.front());
+        m_InFlight.pop_front();
+        m_RingTail = batch.ringEnd;
+        ReleaseBatch(batch);
+        VK_CHECK(vkResetFences(m_Device, 1, &batch.fence));
+        m_FreeBatches.push_back(std::move(batch));
+    }
+}
+
+void VulkanUploadManager::ReleaseBatch(Batch &batch)
+{
+    for (size_t i = 0; i < batch.dedicatedBuffers.size(); ++i)
+    {
+        vkDestroyBuffer(m_Device, batch.dedicatedBuffers[i], nullptr);
+        vkFreeMemory(m_Device, batch.dedicatedMemory[i], nullptr);
+    }
+    batch.dedicatedBuffers.clear();
+    batch.dedicatedMemory.clear();
+    batch.textureCount = 0;
+    batch.ringEnd = 0;
+}
+
+unsigned char *VulkanUploadManager::Stage(VkDeviceSize size, VkDeviceSize texelSize, VkBuffer &outBuffer,
+                                          VkDeviceSize &outOffset)
+{
+    const VkDeviceSize alignment = StagingAlignment(texelSize);
+
+    if (size <= STAGING_RING_SIZE / 2 && AllocateStaging(size, alignment, outOffset))
+    {
+        BeginBatch();
+        outBuffer = m_RingBuffer;
+        return m_RingMapped + outOffset;
+    }
+
+    // Too large to share the ring, give it its own staging buffer
+    BeginBatch();
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VK_CHECK(vkCreateBuffer(m_Device, &bufferInfo, nullptr, &buffer));
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(m_Device, buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits,
+                                               VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &memory) != VK_SUCCESS)
+    {
+        vkDestroyBuffer(m_Device, buffer, nullptr);
+        throw std::runtime_error("Failed to allocate staging buffer memory!");
+    }
+    VK_CHECK(vkBindBufferMemory(m_Device, buffer, memory, 0));
+
+    void *data = nullptr;
+    VK_CHECK(vkMapMemory(m_Device, memory, 0, size, 0, &data));
+
+    m_Pending.dedicatedBuffers.push_back(buffer);
+    m_Pending.dedicatedMemory.push_back(memory);
+    outBuffer = buffer;
+    outOffset = 0;
+    return static_cast<unsigned char *>(data);
+}
+
+void VulkanUploadManager::FinishStaging(VkBuffer buffer)
+{
+    // The ring stays mapped; dedicated buffers are written once, and
+    // QueueTextures() may stage several before writing any of them
+    if (buffer == m_RingBuffer)
+    {
+        return;
+    }
+    for (size_t i = m_Pending.dedicatedBuffers.size(); i-- > 0;)
+    {
+        if (m_Pending.dedicatedBuffers[i] == buffer)
+        {
+            vkUnmapMemory(m_Device, m_Pending.dedicatedMemory[i]);
+            return;
+        }
+    }
+}
+
+void VulkanUploadManager::RecordImageCopy(VkCommandBuffer commandBuffer, Texture &texture,
+                                          VkBuffer source, VkDeviceSize offset,
+                                          VkOffset3D imageOffset, VkExtent3D imageExtent, bool preserve)
+{
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    // A partial copy keeps the texels around it, so the image leaves its sampled layout
+    barrier.oldLayout = preserve ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = texture.m_VulkanImage;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    // A partial copy follows earlier copies into the same image, and on the
+    // graphics queue earlier draws reading it; a transfer-only queue has no
+    // fragment stage and relies on the caller having waited for those draws
+    VkPipelineStageFlags srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    if (preserve)
+    {
+        srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        if (!HasDedicatedTransferQueue())
+        {
+            srcStage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        }
+    }
+
+    vkCmdPipelineBarrier(commandBuffer, srcStage, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = offset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = imageOffset;
+    region.imageExtent = imageExtent;
+
+    vkCmdCopyBufferToImage(commandBuffer, source, texture.m_VulkanImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    // A transfer-only queue has no fragment stage; the semaphore the frame
+    // waits on orders the shader reads instead
+    VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    if (HasDedicatedTransferQueue())
+    {
+        dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        barrier.dstAccessMask = 0;
+    }
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+VkSemaphore VulkanUploadManager::AcquireSemaphore()
+{
+    if (!m_FreeSemaphores.empty())
+    {
+        VkSemaphore semaphore = m_FreeSemaphores.back();
+        m_FreeSemaphores.pop_back();
+        return semaphore;
+    }
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &semaphore));
+    return semaphore;
+}
+
+uint32_t VulkanUploadManager::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const
+{
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+    {
+        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties)
+        {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class JobSystem;
+class Texture;
+
+/**
+ * @class VulkanUploadManager
+ * @brief Batched, fence-tracked texture uploads for the Vulkan renderer.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup Rendering
+ *
+ * Replaces the one-shot "submit and vkQueueWaitIdle" upload with a staging
+ * ring and batches that complete asynchronously:
+ *
+ * @code
+ *   QueueTexture() --> [pending batch] --Submit()--> [in flight] --fence--> retired
+ *        |                                  |
+ *   pixels copied into                signals a semaphore the next
+ *   the staging ring                  graphics submission waits on
+ * @endcode
+ *
+ * @par Queues
+ * A queue family with transfer but no graphics support (the DMA engine on
+ * most discrete GPUs) is used when the device exposes one. Images are then
+ * created with VK_SHARING_MODE_CONCURRENT across both families so no queue
+ * ownership transfer is needed. Without one, uploads go to the graphics queue.
+ *
+ * @par Visibility
+ * Each submitted batch signals a binary semaphore. The renderer adds these
+ * to the wait list of its next frame submission (fragment shader stage), so
+ * a texture can be drawn in the same frame it was queued without the CPU
+ * ever waiting on the GPU.
+ *
+ * @par Staging Ring
+ * Pixels are copied into one persistently mapped, host-coherent buffer of
+ * STAGING_RING_SIZE bytes. Space is reclaimed in submission order when a
+ * batch's fence signals. The CPU only blocks when the ring is full, and then
+ * only on the oldest batch. Textures larger than half the ring get a
+ * dedicated staging buffer freed with their batch.
+ *
+ * @par Thread Safety
+ * Not thread-safe. Call from the render thread only.
+ *
+ * @see VulkanRenderer::UploadTexture(), Texture::CreateVulkanImage()
+ */
+class VulkanUploadManager
+{
+public:
+    /// @brief Bytes of host-visible staging memory shared by all batches.
+    static constexpr VkDeviceSize STAGING_RING_SIZE = 32ull * 1024ull * 1024ull;
+
+    /// @brief Largest piece of one texture QueueTextures() hands to a single job.
+    static constexpr size_t STAGING_COPY_GRAIN = 1024 * 1024;
+
+    VulkanUploadManager() = default;
+    ~VulkanUploadManager();
+
+    VulkanUploadManager(const VulkanUploadManager &) = delete;
+    VulkanUploadManager &operator=(const VulkanUploadManager &) = delete;
+
+    /**
+     * @brief Create the staging ring, command pool and sync objects.
+     *
+     * @param device         Vulkan logical device.
+     * @param physicalDevice Vulkan physical device (for memory type queries).
+     * @param graphicsFamily Family that samples the uploaded images.
+     * @param transferFamily Family of @p transferQueue (same as graphics when
+     *                       there is no dedicated transfer queue).
+     * @param transferQueue  Queue the copies are submitted to.
+     * @param frameSlots     Frames in flight (see TakeWaitSemaphores()).
+     *
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    void Init(VkDevice device, VkPhysicalDevice physicalDevice,
+              uint32_t graphicsFamily, uint32_t transferFamily, VkQueue transferQueue,
+              uint32_t frameSlots);
+
+    /**
+     * @brief Destroy all resources. The device must be idle.
+     *
+     * Textures queued but never submitted keep their (uninitialized) images;
+     * they are destroyed with the texture as usual.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Create @p texture's Vulkan image and stage its pixels.
+     *
+     * The copy is recorded into the pending batch and reaches the GPU on the
+     * next Submit(). The image view is valid immediately, so draws can be
+     * recorded right away.
+     *
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    void QueueTexture(Texture &texture);
+
+    /**
+     * @brief QueueTexture() for many textures, copying their pixels in parallel.
+     *
+     * Images are created and copies recorded on the calling thread; the
+     * pixel copies into staging memory run on @p jobs, in pieces of at
+     * most STAGING_COPY_GRAIN bytes so one large atlas does not serialize
+     * them. All copies land in as few batches as the ring allows.
+     *
+     * @param jobs Worker threads for the copies, or nullptr to copy inline.
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    void QueueTextures(const std::vector<Texture *> &textures, JobSystem *jobs);
+
+    /**
+     * @brief Stage a rectangle of @p texture's pixels into its existing image.
+     *
+     * Only the rectangle is copied to the staging ring. The image goes from
+     * SHADER_READ_ONLY to TRANSFER_DST and back around the copy, keeping the
+     * texels outside it. With a dedicated transfer queue nothing orders the
+     * copy after frames already submitted, so the caller waits for those.
+     *
+     * @param x, y          First texel, in m_ImageData row order.
+     * @param width, height Rectangle size in texels.
+     * @return False if the texture has no image on this device or the
+     *         rectangle is outside it.
+     * @throws std::runtime_error on Vulkan API failures.
+     */
+    bool QueueTextureRegion(Texture &texture, int x, int y, int width, int height);
+
+    /// @brief Submit the pending batch, if any.
+    void Submit();
+
+    /**
+     * @brief Hand over semaphores the next graphics submission must wait on.
+     *
+     * Appends the semaphores of every batch submitted since the last call.
+     * They are recycled by OnFrameSlotComplete() for the same slot.
+     *
+     * @param frameSlot Frame-in-flight index of the consuming submission.
+     * @param out       Receives the semaphores (existing entries are kept).
+     */
+    void TakeWaitSemaphores(uint32_t frameSlot, std::vector<VkSemaphore> &out);
+
+    /**
+     * @brief Reclaim resources once frame slot @p frameSlot has finished.
+     *
+     * Call after waiting on that slot's in-flight fence. Recycles the
+     * semaphores it waited on and retires every batch whose fence signaled.
+     */
+    void OnFrameSlotComplete(uint32_t frameSlot);
+
+    /// @brief Queue families images are shared between (one or two entries).
+    const std::vector<uint32_t> &GetQueueFamilies() const { return m_QueueFamilies; }
+
+    /// @brief True when copies run on a transfer-only queue family.
+    bool HasDedicatedTransferQueue() const { return m_TransferFamily != m_GraphicsFamily; }
+
+    /// @brief Batches submitted but not yet retired (for diagnostics).
+    size_t GetInFlightBatchCount() const { return m_InFlight.size(); }
+
+private:
+    /// @brief Commands and staging space for one submission.
+    struct Batch
+    {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;  ///< Recorded copies.
+        VkFence fence = VK_NULL_HANDLE;                  ///< Signals when the copies finish.
+        VkDeviceSize ringEnd = 0;                        ///< m_RingHead when submitted.
+        std::vector<VkBuffer> dedicatedBuffers;          ///< Oversized staging, freed on retire.
+        std::vector<VkDeviceMemory> dedicatedMemory;     ///< Backing for dedicatedBuffers.
+        uint32_t textureCount = 0;                       ///< Copies recorded.
+    };
+
+    /// @brief Open the pending batch if none is being recorded.
+    void BeginBatch();
+
+    /**
+     * @brief Reserve @p size bytes of the ring, retiring old batches if needed.
+     * @return False if the ring can never fit @p size.
+     */
+    bool AllocateStaging(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset);
+
+    /// @brief Try to place an allocation without waiting.
+    bool TryAllocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset);
+
+    /// @brief Where TryAllocate() would place @p size bytes, without taking them.
+    bool FindSpace(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &outOffset, VkDeviceSize &outPadding) const;
+
+    /// @brief True if Stage() can return @p size bytes without submitting or waiting on a batch.
+    bool CanStageWithoutWaiting(VkDeviceSize size, VkDeviceSize texelSize) const;
+
+    /// @brief Retire finished batches; with @p waitOldest, block on the oldest first.
+    void RetireBatches(bool waitOldest);
+
+    /// @brief Free a retired batch's staging and recycle its command buffer and fence.
+    void ReleaseBatch(Batch &batch);
+
+    /**
+     * @brief Reserve @p size staging bytes in the pending batch.
+     *
+     * Uses the ring, or a dedicated buffer for large copies.
+     * @return Mapped destination; call FinishStaging() once written.
+     */
+    unsigned char *Stage(VkDeviceSize size, VkDeviceSize texelSize, VkBuffer &outBuffer, VkDeviceSize &outOffset);
+
+    /// @brief Unmap the dedicated buffer Stage() returned, if it was one.
+    void FinishStaging(VkBuffer buffer);
+
+    /// @brief bufferOffset alignment for texels of @p texelSize bytes.
+    static VkDeviceSize StagingAlignment(VkDeviceSize texelSize);
+
+    /**
+     * @brief Record layout transitions and the buffer-to-image copy.
+     *
+     * @param preserve Keep the image's contents (partial update of a sampled
+     *                 image) instead of starting from UNDEFINED.
+     */
+    void RecordImageCopy(VkCommandBuffer commandBuffer, Texture &texture,
+                         VkBuffer source, VkDeviceSize offset,
+                         VkOffset3D imageOffset, VkExtent3D imageExtent, bool preserve);
+
+    VkSemaphore AcquireSemaphore();
+    uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+
+    VkDevice m_Device = VK_NULL_HANDLE;
+    VkPhysicalDevice m_PhysicalDevice = VK_NULL_HANDLE;
+    VkQueue m_TransferQueue = VK_NULL_HANDLE;
+    uint32_t m_GraphicsFamily = UINT32_MAX;
+    uint32_t m_TransferFamily = UINT32_MAX;
+    std::vector<uint32_t> m_QueueFamilies;
+
+    VkCommandPool m_CommandPool = VK_NULL_HANDLE;  ///< Transfer-family pool for batch commands.
+
+    /// @name Staging Ring
+    /// @{
+    VkBuffer m_RingBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_RingMemory = VK_NULL_HANDLE;
+    unsigned char *m_RingMapped = nullptr;
+    // Monotonic byte counters; the ring offset is counter % STAGING_RING_SIZE
+    VkDeviceSize m_RingHead = 0;  ///< Bytes ever allocated, including wrap padding.
+    VkDeviceSize m_RingTail = 0;  ///< Bytes released by retired batches.
+    /// @}
+
+    /// @name Batches
+    /// @{
+    Batch m_Pending;                 ///< Batch being recorded.
+    bool m_PendingOpen = false;      ///< m_Pending has a begun command buffer.
+    std::deque<Batch> m_InFlight;    ///< Submitted, oldest first.
+    std::vector<Batch> m_FreeBatches;///< Recycled command buffers and fences.
+    /// @}
+
+    /// @name Semaphores
+    /// @{
+    std::vector<VkSemaphore> m_Signaled;                  ///< Submitted, not yet waited on.
+    std::vector<std::vector<VkSemaphore>> m_WaitedBySlot; ///< Waited by each frame slot.
+    std::vector<VkSemaphore> m_FreeSemaphores;            ///< Ready for reuse.
+    /// @}
+};
@@ -0,0 +1,346 @@
+#include "WorldStreamer.h"
+#include "Tilemap.h"
+#include "NonPlayerCharacter.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+
+WorldStreamer::WorldStreamer() = default;
+
+WorldStreamer::~WorldStreamer()
+{
+    Close();
+}
+
+bool WorldStreamer::Open(const std::string &directory, Tilemap &tilemap, int *playerTileX, int *playerTileY,
+                         int *characterType)
+{
+    Close();
+
+    if (!tilemap.LoadWorldManifest(directory, m_Manifest, playerTileX, playerTileY, characterType))
+    {
+        return false;
+    }
+
+    m_States.assign(static_cast<size_t>(m_Manifest.regionsX) * m_Manifest.regionsY, RegionState::Unloaded);
+    m_SaveStates.assign(m_States.size(), RegionSaveState());
+    m_TileWidth = tilemap.GetTileWidth();
+    m_TileHeight = tilemap.GetTileHeight();
+    m_MapWidth = tilemap.GetMapWidth();
+    m_MapHeight = tilemap.GetMapHeight();
+
+    m_StopWorker = false;
+    m_Worker = std::thread(&WorldStreamer::WorkerMain, this);
+    m_Active = true;
+    return true;
+}
+
+void WorldStreamer::Close()
+{
+    if (m_Worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopWorker = true;
+        }
+        m_WakeWorker.notify_all();
+        m_Worker.join();
+    }
+
+    m_Requests.clear();
+    m_Completed.clear();
+    m_States.clear();
+    m_SaveStates.clear();
+    m_Manifest = WorldManifest();
+    m_Active = false;
+}
+
+void WorldStreamer::SetLoadRadius(int tiles)
+{
+    m_LoadRadius = std::max(0, tiles);
+    m_EvictRadius = std::max(m_EvictRadius, m_LoadRadius);
+}
+
+void WorldStreamer::SetEvictRadius(int tiles)
+{
+    m_EvictRadius = std::max(tiles, m_LoadRadius);
+}
+
+void WorldStreamer::LoadAround(glm::vec2 focusWorldPos, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs)
+{
+    if (!m_Active)
+        return;
+
+    int focusX = static_cast<int>(std::floor(focusWorldPos.x / m_TileWidth));
+    int focusY = static_cast<int>(std::floor(focusWorldPos.y / m_TileHeight));
+    for (int ry = 0; ry < m_Manifest.regionsY; ++ry)
+    {
+        for (int rx = 0; rx < m_Manifest.regionsX; ++rx)
+        {
+            RegionState &state = m_States[RegionIndex(rx, ry)];
+            if (state != RegionState::Unloaded || !m_Manifest.HasRegion(rx, ry) ||
+                DistanceToRegion(focusX, focusY, rx, ry) > m_LoadRadius)
+            {
+                continue;
+            }
+
+            LoadResult result;
+            result.regionX = rx;
+            result.regionY = ry;
+            result.ok = MapRegion::Read(m_Manifest.GetRegionPath(rx, ry), result.region);
+            Apply(result, tilemap, npcs);
+        }
+    }
+}
+
+void WorldStreamer::Update(glm::vec2 focusWorldPos, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs,
+                           ParticleSystem *particles, bool allowEvict)
+{
+    if (!m_Active)
+        return;
+
+    // Apply finished loads first so a region evicted below never comes back stale
+    std::vector<LoadResult> completed;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        const size_t count = std::min(m_Completed.size(), static_cast<size_t>(MAX_APPLIES_PER_UPDATE));
+        completed.assign(std::make_move_iterator(m_Completed.begin()),
+                         std::make_move_iterator(m_Completed.begin() + count));
+        m_Completed.erase(m_Completed.begin(), m_Completed.begin() + count);
+    }
+    for (LoadResult &result : completed)
+    {
+        Apply(result, tilemap, npcs);
+    }
+
+    const int focusX = static_cast<int>(std::floor(focusWorldPos.x / m_TileWidth));
+    const int focusY = static_cast<int>(std::floor(focusWorldPos.y / m_TileHeight));
+    const int regionSize = m_Manifest.regionSize;
+
+    // Only regions overlapping the load square can be within the load radius
+    const int rx0 = std::max(0, (focusX - m_LoadRadius) / regionSize);
+    const int ry0 = std::max(0, (focusY - m_LoadRadius) / regionSize);
+    const int rx1 = std::min(m_Manifest.regionsX - 1, (focusX + m_LoadRadius) / regionSize);
+    const int ry1 = std::min(m_Manifest.regionsY - 1, (focusY + m_LoadRadius) / regionSize);
+    for (int ry = ry0; ry <= ry1; ++ry)
+    {
+        for (int rx = rx0; rx <= rx1; ++rx)
+        {
+            if (m_States[RegionIndex(rx, ry)] == RegionState::Unloaded && m_Manifest.HasRegion(rx, ry) &&
+                DistanceToRegion(focusX, focusY, rx, ry) <= m_LoadRadius)
+            {
+                Request(rx, ry);
+            }
+        }
+    }
+
+    if (!allowEvict)
+        return;
+
+    std::vector<int> removedZones;
+    for (int ry = 0; ry < m_Manifest.regionsY; ++ry)
+    {
+        for (int rx = 0; rx < m_Manifest.regionsX; ++rx)
+        {
+            const size_t index = RegionIndex(rx, ry);
+            RegionState &state = m_States[index];
+            if (state != RegionState::Resident || DistanceToRegion(focusX, focusY, rx, ry) <= m_EvictRadius)
+                continue;
+
+            // Unloading discards the region's cells, so edits have to reach disk first. The file is
+            // kept even if the region is now empty: world.json still lists it until the next save.
+            if (m_SaveStates[index].writeFailed ||
+                (IsRegionDirty(tilemap, npcs, rx, ry) && !WriteRegion(tilemap, npcs, rx, ry, false)))
+            {
+                continue;
+            }
+
+            removedZones.clear();
+            tilemap.UnloadRegion(rx, ry, regionSize, &npcs, &removedZones);
+            if (particles)
+            {
+                // Indices arrive highest first, so each stays valid after the previous removal
+                for (int zoneIndex : removedZones)
+                    particles->OnZoneRemoved(zoneIndex);
+            }
+            state = RegionState::Unloaded;
+        }
+    }
+}
+
+bool WorldStreamer::SaveResident(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs,
+                                 int playerTileX, int playerTileY, int characterType)
+{
+    if (!m_Active)
+        return false;
+
+    bool success = true;
+    int written = 0;
+    for (int ry = 0; ry < m_Manifest.regionsY; ++ry)
+    {
+        for (int rx = 0; rx < m_Manifest.regionsX; ++rx)
+        {
+            const size_t index = RegionIndex(rx, ry);
+            if (m_States[index] != RegionState::Resident)
+                continue;
+
+            success = WriteRegion(tilemap, npcs, rx, ry, true) && success;
+            if (m_Manifest.present[index])
+                written++;
+        }
+    }
+    success = tilemap.SaveWorldManifest(m_Manifest, playerTileX, playerTileY, characterType) && success;
+
+    std::cout << "World saved to " << m_Manifest.directory << " (" << written << " resident regions)" << std::endl;
+    return success;
+}
+
+int WorldStreamer::GetResidentCount() const
+{
+    return static_cast<int>(std::count(m_States.begin(), m_States.end(), RegionState::Resident));
+}
+
+int WorldStreamer::GetPendingCount() const
+{
+    return static_cast<int>(std::count(m_States.begin(), m_States.end(), RegionState::Pending));
+}
+
+bool WorldStreamer::IsRegionDirty(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX,
+                                  int regionY) const
+{
+    const size_t index = RegionIndex(regionX, regionY);
+    if (index >= m_States.size() || m_States[index] != RegionState::Resident)
+        return false;
+
+    const RegionSaveState &saved = m_SaveStates[index];
+    if (tilemap.GetRegionRevision(regionX, regionY, m_Manifest.regionSize) != saved.revision)
+        return true;
+
+    // NPCs placed since the world was loaded have no home yet and belong to the region they stand in
+    const int x0 = regionX * m_Manifest.regionSize;
+    const int y0 = regionY * m_Manifest.regionSize;
+    for (const NonPlayerCharacter &npc : npcs)
+    {
+        if (npc.GetHomeRegion().x < 0 && npc.GetTileX() >= x0 && npc.GetTileX() < x0 + m_Manifest.regionSize &&
+            npc.GetTileY() >= y0 && npc.GetTileY() < y0 + m_Manifest.regionSize)
+        {
+            return true;
+        }
+    }
+    return CountHomeNpcs(npcs, regionX, regionY) != saved.npcCount;
+}
+
+void WorldStreamer::WorkerMain()
+{
+    WILD_PROFILE_THREAD("World Streamer");
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    for (;;)
+    {
+        m_WakeWorker.wait(lock, [this] { return m_StopWorker || !m_Requests.empty(); });
+        if (m_StopWorker)
+            return;
+
+        const glm::ivec2 request = m_Requests.front();
+        m_Requests.pop_front();
+        const std::string path = m_Manifest.GetRegionPath(request.x, request.y);
+
+        // File I/O and parsing run unlocked; only the queues are shared
+        lock.unlock();
+        LoadResult result;
+        result.regionX = request.x;
+        result.regionY = request.y;
+        {
+            WILD_PROFILE_ZONE("Read Region");
+            result.ok = MapRegion::Read(path, result.region);
+        }
+        lock.lock();
+
+        m_Completed.push_back(std::move(result));
+    }
+}
+
+void WorldStreamer::Request(int regionX, int regionY)
+{
+    m_States[RegionIndex(regionX, regionY)] = RegionState::Pending;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requests.emplace_back(regionX, regionY);
+    }
+    m_WakeWorker.notify_one();
+}
+
+void WorldStreamer::Apply(LoadResult &result, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs)
+{
+    RegionState &state = m_States[RegionIndex(result.regionX, result.regionY)];
+    if (!result.ok)
+    {
+        std::cerr << "ERROR: Failed to stream region (" << result.regionX << ", " << result.regionY << ")"
+                  << std::endl;
+        state = RegionState::Failed;
+        return;
+    }
+
+    tilemap.ApplyRegion(result.region, &npcs);
+    state = RegionState::Resident;
+    MarkSaved(tilemap, npcs, result.regionX, result.regionY);
+}
+
+bool WorldStreamer::WriteRegion(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX,
+                                int regionY, bool removeIfEmpty)
+{
+    const size_t index = RegionIndex(regionX, regionY);
+    MapRegion region;
+    tilemap.ExtractRegion(regionX, regionY, m_Manifest.regionSize, &npcs, region);
+    const std::string path = m_Manifest.GetRegionPath(regionX, regionY);
+    if (removeIfEmpty && region.IsEmpty())
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        m_Manifest.present[index] = 0;
+        MarkSaved(tilemap, npcs, regionX, regionY);
+        return true;
+    }
+
+    if (!region.Write(path))
+    {
+        std::cerr << "ERROR: Failed to write back region (" << regionX << ", " << regionY
+                  << "); keeping it resident" << std::endl;
+        m_SaveStates[index].writeFailed = true;
+        return false;
+    }
+    m_Manifest.present[index] = 1;
+    MarkSaved(tilemap, npcs, regionX, regionY);
+    return true;
+}
+
+void WorldStreamer::MarkSaved(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX,
+                              int regionY)
+{
+    RegionSaveState &saved = m_SaveStates[RegionIndex(regionX, regionY)];
+    saved.revision = tilemap.GetRegionRevision(regionX, regionY, m_Manifest.regionSize);
+    saved.npcCount = CountHomeNpcs(npcs, regionX, regionY);
+    saved.writeFailed = false;
+}
+
+int WorldStreamer::CountHomeNpcs(const std::vector<NonPlayerCharacter> &npcs, int regionX, int regionY) const
+{
+    const glm::ivec2 region(regionX, regionY);
+    return static_cast<int>(std::count_if(npcs.begin(), npcs.end(), [region](const NonPlayerCharacter &npc)
+                                          { return npc.GetHomeRegion() == region; }));
+}
+
+int WorldStreamer::DistanceToRegion(int tileX, int tileY, int regionX, int regionY) const
+{
+    // Chebyshev distance to the nearest tile of the region; 0 when inside
+    const int x0 = regionX * m_Manifest.regionSize;
+    const int y0 = regionY * m_Manifest.regionSize;
+    const int x1 = std::min(x0 + m_Manifest.regionSize, m_MapWidth) - 1;
+    const int y1 = std::min(y0 + m_Manifest.regionSize, m_MapHeight) - 1;
+    const int dx = std::max({x0 - tileX, 0, tileX - x1});
+    const int dy = std::max({y0 - tileY, 0, tileY - y1});
+    return std::max(dx, dy);
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include "MapRegion.h"
+
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Tilemap;
+class NonPlayerCharacter;
+class ParticleSystem;
+
+/**
+ * @class WorldStreamer
+ * @brief Loads and evicts world regions around a focus point.
+ * @author Alex (https://github.com/lextpf)
+ * @ingroup World
+ *
+ * Keeps only the regions near the camera resident in the Tilemap. Region
+ * files are read and parsed on a worker thread; the main thread applies
+ * finished regions in Update(), so the Tilemap itself is never touched
+ * off-thread.
+ *
+ * @par Radii
+ * Distances are measured in tiles from the focus tile to the nearest tile of
+ * a region. Regions within the load radius are requested; resident regions
+ * beyond the evict radius are unloaded. The evict radius is kept larger than
+ * the load radius so a region at the boundary does not thrash.
+ *
+ * @par Region Lifecycle
+ * @code
+ *   Unloaded --Request--> Pending --Apply--> Resident --Evict--> Unloaded
+ * @endcode
+ * A region that fails to load is marked Failed and not requested again
+ * until the world is reopened.
+ *
+ * @par Editing
+ * Each region remembers Tilemap::GetRegionRevision() and the number of NPCs
+ * it owns from when it was last read or written. A region whose revision
+ * moved, whose NPC count changed, or which has NPCs placed since loading
+ * has unsaved edits; eviction writes it back before unloading it and keeps
+ * it resident if the write fails. SaveResident() writes every resident
+ * region. Game still pauses eviction while the editor is active so a region
+ * being edited is not rewritten on every pass over the evict radius.
+ *
+ * @see MapRegion, WorldManifest, Tilemap::ApplyRegion()
+ */
+class WorldStreamer
+{
+public:
+    /// @brief Regions applied per Update() at most, to spread apply cost over frames.
+    static constexpr int MAX_APPLIES_PER_UPDATE = 2;
+
+    WorldStreamer();
+    ~WorldStreamer();
+
+    WorldStreamer(const WorldStreamer &) = delete;
+    WorldStreamer &operator=(const WorldStreamer &) = delete;
+
+    /**
+     * @brief Open a world directory and start the worker thread.
+     *
+     * Loads the manifest into @p tilemap (size, layers, animation and structure
+     * tables). No region is loaded yet; call LoadAround() for the initial view.
+     *
+     * @param directory     World directory containing world.json.
+     * @param tilemap       Tilemap to stream into (cleared by this call).
+     * @param playerTileX   Receives the saved player tile X, if any.
+     * @param playerTileY   Receives the saved player tile Y, if any.
+     * @param characterType Receives the saved character type, if any.
+     * @return `true` if the manifest was loaded.
+     */
+    bool Open(const std::string &directory, Tilemap &tilemap, int *playerTileX = nullptr,
+              int *playerTileY = nullptr, int *characterType = nullptr);
+
+    /// @brief Stop the worker and forget all region state. Resident data stays in the Tilemap.
+    void Close();
+
+    /// @brief `true` between a successful Open() and Close().
+    bool IsActive() const { return m_Active; }
+
+    /// @brief Manifest of the open world.
+    const WorldManifest &GetManifest() const { return m_Manifest; }
+
+    /// @name Radii
+    /// @{
+    void SetLoadRadius(int tiles);
+    int GetLoadRadius() const { return m_LoadRadius; }
+    void SetEvictRadius(int tiles);
+    int GetEvictRadius() const { return m_EvictRadius; }
+    /// @}
+
+    /**
+     * @brief Synchronously load every region within the load radius.
+     *
+     * Used at startup so the first frame is not drawn over empty regions.
+     *
+     * @param focusWorldPos Focus point in world pixels.
+     * @param tilemap       Tilemap to load into.
+     * @param npcs          Receives NPCs of the loaded regions.
+     */
+    void LoadAround(glm::vec2 focusWorldPos, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs);
+
+    /**
+     * @brief Request, apply and evict regions for the current focus point.
+     *
+     * @param focusWorldPos Focus point in world pixels (usually the view center).
+     * @param tilemap       Tilemap to stream into.
+     * @param npcs          NPC list regions add to and remove from.
+     * @param particles     Notified of removed particle zones (may be nullptr).
+     * @param allowEvict    `false` keeps every resident region (editor mode).
+     */
+    void Update(glm::vec2 focusWorldPos, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs,
+                ParticleSystem *particles, bool allowEvict);
+
+    /**
+     * @brief Write all resident regions and the manifest back to disk.
+     *
+     * Resident regions that became empty lose their file.
+     *
+     * @return `true` if every file was written.
+     */
+    bool SaveResident(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs,
+                      int playerTileX, int playerTileY, int characterType);
+
+    /// @name Statistics
+    /// @{
+    int GetResidentCount() const;
+    int GetPendingCount() const;
+    /// @}
+
+    /// @brief `true` if resident region (@p regionX, @p regionY) has edits not yet on disk.
+    bool IsRegionDirty(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX,
+                       int regionY) const;
+
+private:
+    enum class RegionState : uint8_t
+    {
+        Unloaded,
+        Pending,
+        Resident,
+        Failed
+    };
+
+    /// What a region looked like when it was last read or written
+    struct RegionSaveState
+    {
+        uint64_t revision = 0;     ///< Tilemap::GetRegionRevision()
+        int npcCount = 0;          ///< NPCs whose home is the region
+        bool writeFailed = false;  ///< Last write-back failed; not evicted until a save succeeds
+    };
+
+    struct LoadResult
+    {
+        int regionX = 0;
+        int regionY = 0;
+        bool ok = false;
+        MapRegion region;
+    };
+
+    void WorkerMain();
+    void Request(int regionX, int regionY);
+    void Apply(LoadResult &result, Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs);
+    bool WriteRegion(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX,
+                     int regionY, bool removeIfEmpty);
+    void MarkSaved(const Tilemap &tilemap, const std::vector<NonPlayerCharacter> &npcs, int regionX, int regionY);
+    int CountHomeNpcs(const std::vector<NonPlayerCharacter> &npcs, int regionX, int regionY) const;
+    int DistanceToRegion(int tileX, int tileY, int regionX, int regionY) const;
+    size_t RegionIndex(int regionX, int regionY) const
+    {
+        return static_cast<size_t>(regionY) * m_Manifest.regionsX + regionX;
+    }
+
+    WorldManifest m_Manifest;
+    std::vector<RegionState> m_States;  ///< Row-major, one per region
+    std::vector<RegionSaveState> m_SaveStates;  ///< Row-major, meaningful for resident regions
+    int m_TileWidth = 16;
+    int m_TileHeight = 16;
+    int m_MapWidth = 0;
+    int m_MapHeight = 0;
+    int m_LoadRadius = 48;
+    int m_EvictRadius = 80;
+    bool m_Active = false;
+
+    /// @name Worker Thread
+    /// @{
+    std::thread m_Worker;
+    std::mutex m_Mutex;                    ///< Guards everything in this group
+    std::condition_variable m_WakeWorker;
+    std::deque<glm::ivec2> m_Requests;     ///< Regions waiting to be read
+    std::vector<LoadResult> m_Completed;   ///< Parsed regions waiting to be applied
+    bool m_StopWorker = false;
+    /// @}
+};
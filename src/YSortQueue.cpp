@@ -0,0 +1,85 @@
+#include "YSortQueue.h"
+
+#include <bit>
+#include <cstring>
+#include <utility>
+
+void YSortQueue::Reserve(std::size_t count)
+{
+    m_Keys.reserve(count);
+    m_Scratch.reserve(count);
+}
+
+std::uint32_t YSortQueue::OrderedBits(float value)
+{
+    // -0 and +0 compare equal as floats; give them one key
+    if (value == 0.0f)
+        value = 0.0f;
+
+    // Positive floats order like their bits once the sign bit is set;
+    // negative ones order in reverse, so flip all of their bits
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+bool YSortQueue::Add(float sortY, std::uint8_t rank)
+{
+    const std::size_t index = m_Keys.size();
+    if (index >= MAX_ITEMS)
+        return false;
+
+    m_Keys.push_back((static_cast<std::uint64_t>(OrderedBits(sortY)) << 32) |
+                     (static_cast<std::uint64_t>(rank) << 24) | static_cast<std::uint64_t>(index));
+    return true;
+}
+
+void YSortQueue::Sort()
+{
+    const std::size_t count = m_Keys.size();
+    if (count < 2)
+        return;
+
+    // Digits that are identical in every key cannot reorder anything. The
+    // index digits never need a pass: keys start out in insertion order and
+    // every pass is stable, so ties on (Y, rank) stay in that order
+    std::uint64_t anyOne = 0;
+    std::uint64_t allOne = ~std::uint64_t{0};
+    for (std::uint64_t key : m_Keys)
+    {
+        anyOne |= key;
+        allOne &= key;
+    }
+    const std::uint64_t varying = (anyOne & ~allOne) & ~std::uint64_t{MAX_ITEMS - 1};
+    if (varying == 0)
+        return;
+
+    m_Scratch.resize(count);
+    std::uint64_t *src = m_Keys.data();
+    std::uint64_t *dst = m_Scratch.data();
+
+    for (int shift = 24; shift < 64; shift += 8)
+    {
+        if (((varying >> shift) & 0xFF) == 0)
+            continue;
+
+        std::size_t offsets[256] = {};
+        for (std::size_t i = 0; i < count; ++i)
+            ++offsets[(src[i] >> shift) & 0xFF];
+
+        std::size_t sum = 0;
+        for (std::size_t &offset : offsets)
+        {
+            const std::size_t n = offset;
+            offset = sum;
+            sum += n;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+            dst[offsets[(src[i] >> shift) & 0xFF]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    if (src != m_Keys.data())
+        std::memcpy(m_Keys.data(), src, count * sizeof(std::uint64_t));
+}
@@ -26,8 +26,10 @@
  *      License:      MIT
  */
 #include "Game.h"
+#include "Tilemap.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 
@@ -57,7 +59,19 @@ void CrashHandler(int sig)
 
 #endif // _WIN32
 
-int main()
+/// @brief Parse a `--renderer` value (opengl or vulkan).
+static bool ParseRendererName(const char *name, RendererAPI &api)
+{
+    if (std::strcmp(name, "opengl") == 0)
+        api = RendererAPI::OpenGL;
+    else if (std::strcmp(name, "vulkan") == 0)
+        api = RendererAPI::Vulkan;
+    else
+        return false;
+    return true;
+}
+
+int main(int argc, char *argv[])
 {
     // ------------------------------------------------------------------------
     // Windows: Install Crash Handlers
@@ -105,12 +119,151 @@ int main()
     }
 #endif
 
+    // ------------------------------------------------------------------------
+    // Map Conversion (wild --convert-map <source> <destination>)
+    // ------------------------------------------------------------------------
+    if (argc >= 2 && std::strcmp(argv[1], "--convert-map") == 0)
+    {
+        if (argc != 4)
+        {
+            std::cerr << "Usage: " << argv[0] << " --convert-map <source> <destination>" << std::endl;
+            return 1;
+        }
+        bool converted = Tilemap::ConvertMapFile(argv[2], argv[3]);
+        logFile << "Map conversion " << argv[2] << " -> " << argv[3] << (converted ? " succeeded" : " failed") << std::endl;
+        return converted ? 0 : 1;
+    }
+
+    // ------------------------------------------------------------------------
+    // Profiler Capture (wild --trace <file> [frames])
+    // ------------------------------------------------------------------------
+    const char *tracePath = nullptr;
+    int traceFrames = 0;
+    if (argc >= 2 && std::strcmp(argv[1], "--trace") == 0)
+    {
+        if (argc < 3 || argc > 4)
+        {
+            std::cerr << "Usage: " << argv[0] << " --trace <file> [frames]" << std::endl;
+            return 1;
+        }
+        tracePath = argv[2];
+        traceFrames = argc == 4 ? std::atoi(argv[3]) : 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Benchmark (wild --benchmark <map> <script> [options])
+    // ------------------------------------------------------------------------
+    bool benchmark = false;
+    Game::BenchmarkOptions benchmarkOptions;
+    if (argc >= 2 && std::strcmp(argv[1], "--benchmark") == 0)
+    {
+        bool valid = argc >= 4;
+        if (valid)
+        {
+            benchmarkOptions.mapPath = argv[2];
+            benchmarkOptions.scriptPath = argv[3];
+        }
+        for (int i = 4; valid && i < argc; ++i)
+        {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--hidden") == 0)
+            {
+                benchmarkOptions.hiddenWindow = true;
+            }
+            else if (std::strcmp(argv[i], "--renderer") == 0 && hasValue)
+            {
+                valid = ParseRendererName(argv[++i], benchmarkOptions.renderer);
+            }
+            else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+            {
+                benchmarkOptions.frames = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+            {
+                benchmarkOptions.outputPath = argv[++i];
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+        if (!valid)
+        {
+            std::cerr << "Usage: " << argv[0] << " --benchmark <map> <script> [--renderer opengl|vulkan]"
+                      << " [--hidden] [--frames N] [--out report.json]" << std::endl;
+            return 1;
+        }
+        benchmark = true;
+    }
+
+    // ------------------------------------------------------------------------
+    // Input Recording (wild --record <file>) and Replay (wild --replay <file> [options])
+    // ------------------------------------------------------------------------
+    const char *recordPath = nullptr;
+    if (argc >= 2 && std::strcmp(argv[1], "--record") == 0)
+    {
+        if (argc != 3)
+        {
+            std::cerr << "Usage: " << argv[0] << " --record <file>" << std::endl;
+            return 1;
+        }
+        recordPath = argv[2];
+    }
+
+    bool replay = false;
+    Game::ReplayOptions replayOptions;
+    if (argc >= 2 && std::strcmp(argv[1], "--replay") == 0)
+    {
+        bool valid = argc >= 3;
+        if (valid)
+        {
+            replayOptions.logPath = argv[2];
+        }
+        for (int i = 3; valid && i < argc; ++i)
+        {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--hidden") == 0)
+            {
+                replayOptions.hiddenWindow = true;
+            }
+            else if (std::strcmp(argv[i], "--renderer") == 0 && hasValue)
+            {
+                valid = ParseRendererName(argv[++i], replayOptions.renderer);
+            }
+            else if (std::strcmp(argv[i], "--out") == 0 && hasValue)
+            {
+                replayOptions.outputPath = argv[++i];
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+        if (!valid)
+        {
+            std::cerr << "Usage: " << argv[0] << " --replay <file> [--renderer opengl|vulkan] [--hidden]"
+                      << " [--out report.json]" << std::endl;
+            return 1;
+        }
+        replay = true;
+    }
+
     std::cout << "=== Game Starting ===" << std::endl;
 
     // ------------------------------------------------------------------------
     // Game Initialization and Execution
     // ------------------------------------------------------------------------
     Game game;
+    if (benchmark && !game.ConfigureBenchmark(benchmarkOptions))
+    {
+        logFile << "ERROR: benchmark script " << benchmarkOptions.scriptPath << " not loaded" << std::endl;
+        return 1;
+    }
+    if (replay && !game.ConfigureReplay(replayOptions))
+    {
+        logFile << "ERROR: input log " << replayOptions.logPath << " not loaded" << std::endl;
+        return 1;
+    }
 
     try
     {
@@ -123,16 +276,43 @@ int main()
             logFile << "ERROR: Initialize() returned false" << std::endl;
             logFile.close();
 
-            std::cin.get();
+            // Scripted runs must not wait for a keypress
+            if (!benchmark && !replay)
+                std::cin.get();
             return -1;
         }
 
         std::cout << "Game initialized successfully!" << std::endl;
 
+        // Benchmarks run unpaced and exit when done
+        if (benchmark)
+        {
+            const bool completed = game.RunBenchmark();
+            logFile << "Benchmark " << (completed ? "completed: " : "failed: ") << benchmarkOptions.outputPath
+                    << std::endl;
+            game.Shutdown();
+            return completed ? 0 : 1;
+        }
+        if (replay)
+        {
+            const bool completed = game.RunReplay();
+            logFile << "Replay " << (completed ? "completed: " : "failed: ") << replayOptions.outputPath << std::endl;
+            game.Shutdown();
+            return completed ? 0 : 1;
+        }
+
         // Run the main game loop
         try
         {
             game.SetTargetFps(500.0f);
+            if (tracePath)
+            {
+                game.StartProfilerCapture(tracePath, traceFrames);
+            }
+            if (recordPath && !game.StartInputRecording(recordPath))
+            {
+                logFile << "ERROR: input log " << recordPath << " not created" << std::endl;
+            }
             game.Run();
         }
         catch (const std::exception &e)
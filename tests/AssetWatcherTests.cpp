@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "../src/AssetWatcher.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+/// Scratch directory removed again after each test
+class AssetWatcherTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() /
+                 ("wild_asset_watcher_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root / "tiles");
+        m_Watcher.SetRoots({m_Root.generic_string()});
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    std::string Write(const std::string &name, const std::string &contents)
+    {
+        const fs::path path = m_Root / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.generic_string();
+    }
+
+    /// Move the mtime forward so a same-size rewrite is still a change
+    void Touch(const std::string &path)
+    {
+        fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(2));
+    }
+
+    fs::path m_Root;
+    AssetWatcher m_Watcher;
+};
+}  // namespace
+
+TEST_F(AssetWatcherTest, BaselineScanReportsNothing)
+{
+    Write("tiles/a.png", "aaaa");
+    m_Watcher.Poll();
+    m_Watcher.Poll();
+    EXPECT_TRUE(m_Watcher.TakeChanges().empty());
+}
+
+TEST_F(AssetWatcherTest, ChangeIsReportedOnceItSettles)
+{
+    const std::string path = Write("tiles/a.png", "aaaa");
+    m_Watcher.Poll();
+
+    Write("tiles/a.png", "bbbbbb");
+    m_Watcher.Poll();
+    EXPECT_TRUE(m_Watcher.TakeChanges().empty());
+
+    m_Watcher.Poll();
+    EXPECT_EQ(m_Watcher.TakeChanges(), std::vector<std::string>{path});
+
+    m_Watcher.Poll();
+    EXPECT_TRUE(m_Watcher.TakeChanges().empty());
+}
+
+TEST_F(AssetWatcherTest, FileStillBeingWrittenIsDeferred)
+{
+    const std::string path = Write("tiles/a.png", "aaaa");
+    m_Watcher.Poll();
+
+    Write("tiles/a.png", "aaaab");
+    m_Watcher.Poll();
+    Write("tiles/a.png", "aaaabb");
+    m_Watcher.Poll();
+    EXPECT_TRUE(m_Watcher.TakeChanges().empty());
+
+    m_Watcher.Poll();
+    EXPECT_EQ(m_Watcher.TakeChanges(), std::vector<std::string>{path});
+}
+
+TEST_F(AssetWatcherTest, SameSizeRewriteIsSeenThroughTheModificationTime)
+{
+    const std::string path = Write("tiles/a.png", "aaaa");
+    m_Watcher.Poll();
+
+    Write("tiles/a.png", "bbbb");
+    Touch(path);
+    m_Watcher.Poll();
+    m_Watcher.Poll();
+    EXPECT_EQ(m_Watcher.TakeChanges(), std::vector<std::string>{path});
+}
+
+TEST_F(AssetWatcherTest, NewFilesCountAndDeletedOnesAreForgotten)
+{
+    const std::string kept = Write("tiles/a.png", "aaaa");
+    const std::string removed = Write("b.frag", "void main() {}");
+    m_Watcher.Poll();
+
+    fs::remove(removed);
+    const std::string added = Write("tiles/c.png", "cc");
+    m_Watcher.Poll();
+    m_Watcher.Poll();
+    EXPECT_EQ(m_Watcher.TakeChanges(), std::vector<std::string>{added});
+    (void)kept;
+}
+
+TEST_F(AssetWatcherTest, MissingRootIsSkipped)
+{
+    m_Watcher.SetRoots({(m_Root / "missing").generic_string(), m_Root.generic_string()});
+    const std::string path = Write("tiles/a.png", "aaaa");
+    m_Watcher.Poll();
+    Write("tiles/a.png", "aaaaaa");
+    m_Watcher.Poll();
+    m_Watcher.Poll();
+    EXPECT_EQ(m_Watcher.TakeChanges(), std::vector<std::string>{path});
+}
+
+TEST_F(AssetWatcherTest, WorkerReportsChanges)
+{
+    const std::string path = Write("tiles/a.png", "aaaa");
+    m_Watcher.Start({m_Root.generic_string()}, std::chrono::milliseconds(5));
+    EXPECT_TRUE(m_Watcher.IsRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    Write("tiles/a.png", "bbbbbbbb");
+    std::vector<std::string> changes;
+    for (int i = 0; i < 200 && changes.empty(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        changes = m_Watcher.TakeChanges();
+    }
+    m_Watcher.Stop();
+    EXPECT_FALSE(m_Watcher.IsRunning());
+    EXPECT_EQ(changes, std::vector<std::string>{path});
+}
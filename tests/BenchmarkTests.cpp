@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../src/BenchmarkReport.h"
+#include "../src/BenchmarkScript.h"
+
+#include <sstream>
+
+TEST(BenchmarkReportTest, SummarizeUsesNearestRankP99)
+{
+    std::vector<double> values;
+    for (int i = 1; i <= 200; ++i)
+        values.push_back(static_cast<double>(i));
+
+    const BenchmarkReport::Summary summary = BenchmarkReport::Summarize(values);
+    EXPECT_EQ(summary.count, 200u);
+    EXPECT_DOUBLE_EQ(summary.min, 1.0);
+    EXPECT_DOUBLE_EQ(summary.max, 200.0);
+    EXPECT_DOUBLE_EQ(summary.avg, 100.5);
+    EXPECT_DOUBLE_EQ(summary.p99, 198.0);
+
+    // With fewer than 100 frames the worst one is the p99
+    const BenchmarkReport::Summary few = BenchmarkReport::Summarize({3.0, 1.0, 2.0});
+    EXPECT_DOUBLE_EQ(few.p99, 3.0);
+    EXPECT_EQ(BenchmarkReport::Summarize({}).count, 0u);
+}
+
+TEST(BenchmarkReportTest, GpuSummarySkipsFramesWithoutTimings)
+{
+    BenchmarkReport report;
+    for (int i = 0; i < 4; ++i)
+    {
+        PerfHud::FrameSample sample;
+        sample.cpuMs = 2.0f;
+        sample.gpuMs = i < 2 ? 0.0f : 4.0f;
+        sample.drawCalls = 10 + i;
+        report.AddFrame(sample);
+    }
+
+    EXPECT_EQ(report.GetCpuSummary().count, 4u);
+    EXPECT_EQ(report.GetGpuSummary().count, 2u);
+    EXPECT_DOUBLE_EQ(report.GetGpuSummary().avg, 4.0);
+    EXPECT_DOUBLE_EQ(report.GetDrawCallSummary().max, 13.0);
+
+    std::ostringstream out;
+    report.WriteJson(out, BenchmarkReport::RunInfo{});
+    EXPECT_NE(out.str().find("\"gpuMs\""), std::string::npos);
+    EXPECT_NE(out.str().find("\"flushesPerFrame\""), std::string::npos);
+}
+
+TEST(BenchmarkScriptTest, ParsesDefaultsAndInheritsZoom)
+{
+    BenchmarkScript script;
+    ASSERT_TRUE(script.Parse(R"({
+        // comments are allowed
+        "seed": 7,
+        "path": [
+            { "time": 0, "tile": [0, 0], "zoom": 2.0 },
+            { "time": 4, "tile": [8, 0] }
+        ]
+    })"));
+
+    EXPECT_EQ(script.GetSeed(), 7u);
+    EXPECT_EQ(script.GetFrames(), 600);
+    EXPECT_FLOAT_EQ(script.GetStep(), 1.0f / 60.0f);
+    ASSERT_EQ(script.GetWaypoints().size(), 2u);
+    EXPECT_FLOAT_EQ(script.GetWaypoints()[1].zoom, 2.0f);
+    EXPECT_FLOAT_EQ(script.GetDuration(), 4.0f);
+}
+
+TEST(BenchmarkScriptTest, RejectsInvalidScripts)
+{
+    BenchmarkScript script;
+    EXPECT_FALSE(script.Parse("not json"));
+    EXPECT_FALSE(script.Parse(R"({ "path": [] })"));
+    EXPECT_FALSE(script.Parse(R"({ "path": [{ "time": 2, "tile": [0, 0] }, { "time": 1, "tile": [1, 0] }] })"));
+    EXPECT_FALSE(script.Parse(R"({ "frames": 0, "path": [{ "time": 0, "tile": [0, 0] }] })"));
+}
+
+TEST(BenchmarkScriptTest, SampleInterpolatesClampsAndLoops)
+{
+    BenchmarkScript script;
+    ASSERT_TRUE(script.Parse(R"({
+        "path": [
+            { "time": 0, "tile": [0, 0], "zoom": 1.0 },
+            { "time": 2, "tile": [10, 0], "zoom": 2.0 }
+        ]
+    })"));
+
+    const BenchmarkScript::Pose mid = script.Sample(1.0f);
+    EXPECT_FLOAT_EQ(mid.tile.x, 5.0f);
+    EXPECT_FLOAT_EQ(mid.zoom, 1.5f);
+    EXPECT_FLOAT_EQ(mid.direction.x, 1.0f);
+
+    EXPECT_FLOAT_EQ(script.Sample(-1.0f).tile.x, 0.0f);
+    const BenchmarkScript::Pose end = script.Sample(5.0f);
+    EXPECT_FLOAT_EQ(end.tile.x, 10.0f);
+    EXPECT_FLOAT_EQ(end.direction.x, 0.0f);
+
+    BenchmarkScript looping;
+    ASSERT_TRUE(looping.Parse(R"({
+        "loop": true,
+        "path": [{ "time": 0, "tile": [0, 0] }, { "time": 2, "tile": [10, 0] }]
+    })"));
+    EXPECT_FLOAT_EQ(looping.Sample(3.0f).tile.x, 5.0f);
+}
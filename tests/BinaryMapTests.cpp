@@ -0,0 +1,278 @@
+#include <gtest/gtest.h>
+#include "../src/BinaryMap.h"
+#include "../src/Tilemap.h"
+#include "../src/NonPlayerCharacter.h"
+
+#include <json.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr int GROUND = 0;
+constexpr int DECOR = 1;
+
+/// Map that sets at least one of every field the binary format stores
+void BuildSampleMap(Tilemap &tilemap)
+{
+    tilemap.SetTilemapSize(70, 40, false);
+
+    // Cells in three different chunks, with rotation, flags and structure IDs
+    tilemap.SetLayerTile(1, 2, GROUND, 5);
+    tilemap.SetLayerTile(40, 3, GROUND, 6);
+    tilemap.SetLayerRotation(40, 3, GROUND, 90.0f);
+    tilemap.SetLayerTile(65, 35, DECOR, 7);
+    tilemap.SetLayerNoProjection(65, 35, DECOR, true);
+
+    const int structure = tilemap.AddNoProjectionStructure(glm::vec2(16.0f, 32.0f), glm::vec2(48.0f, 32.0f), "Hut");
+    tilemap.SetTileStructureId(65, 35, DECOR, structure);
+
+    const int animation = tilemap.AddAnimatedTile(AnimatedTile({8, 9, 10}, 0.25f));
+    tilemap.SetLayerTile(2, 2, GROUND, 8);
+    tilemap.SetTileAnimation(2, 2, GROUND, animation);
+
+    tilemap.SetTileCollision(3, 4, true);
+    tilemap.SetTileCollision(69, 39, true);
+    tilemap.SetNavigation(5, 6, true);
+    tilemap.SetNavigation(33, 33, true);
+    tilemap.SetCornerCutBlocked(3, 4, Tilemap::CORNER_TR, true);
+    tilemap.SetElevation(7, 8, 3);
+    tilemap.SetElevation(50, 20, -2);
+
+    ParticleZone zone(glm::vec2(32.0f, 48.0f), glm::vec2(64.0f, 16.0f), ParticleType::Firefly);
+    zone.noProjection = true;
+    tilemap.AddParticleZone(zone);
+}
+
+nlohmann::json ReadJson(const fs::path &path)
+{
+    std::ifstream file(path);
+    return nlohmann::json::parse(file);
+}
+
+std::vector<char> ReadBytes(const fs::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteBytes(const fs::path &path, const std::vector<char> &bytes)
+{
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+BinaryMapHeader &HeaderOf(std::vector<char> &bytes)
+{
+    return *reinterpret_cast<BinaryMapHeader *>(bytes.data());
+}
+
+BinaryMapSection &SectionOf(std::vector<char> &bytes, size_t index)
+{
+    return reinterpret_cast<BinaryMapSection *>(bytes.data() + sizeof(BinaryMapHeader))[index];
+}
+
+/// Scratch directory with a valid sample map in `sample.wmap`
+class BinaryMapTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() /
+                 ("wild_binary_map_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root);
+
+        Tilemap tilemap;
+        BuildSampleMap(tilemap);
+        ASSERT_TRUE(tilemap.SaveMapToBinary(Path("sample.wmap")));
+    }
+
+    void TearDown() override { fs::remove_all(m_Root); }
+
+    std::string Path(const std::string &name) const { return (m_Root / name).generic_string(); }
+
+    /// Copy of sample.wmap after @p corrupt has edited its bytes
+    template<typename F>
+    std::string Corrupted(F corrupt)
+    {
+        std::vector<char> bytes = ReadBytes(Path("sample.wmap"));
+        corrupt(bytes);
+        WriteBytes(Path("corrupt.wmap"), bytes);
+        return Path("corrupt.wmap");
+    }
+
+    fs::path m_Root;
+};
+}  // namespace
+
+TEST_F(BinaryMapTest, JsonRoundTripsThroughBinary)
+{
+    Tilemap source;
+    BuildSampleMap(source);
+    const std::vector<NonPlayerCharacter> noNpcs;
+    ASSERT_TRUE(source.SaveMapToJSON(Path("before.json"), &noNpcs, 12, 13, 1));
+
+    ASSERT_TRUE(Tilemap::ConvertMapFile(Path("before.json"), Path("converted.wmap")));
+    ASSERT_TRUE(Tilemap::ConvertMapFile(Path("converted.wmap"), Path("after.json")));
+    EXPECT_EQ(ReadJson(Path("before.json")), ReadJson(Path("after.json")));
+
+    Tilemap loaded;
+    std::vector<NonPlayerCharacter> npcs;
+    int playerX = -1, playerY = -1, characterType = -1;
+    ASSERT_TRUE(loaded.LoadMapFromBinary(Path("converted.wmap"), &npcs, &playerX, &playerY, &characterType));
+    EXPECT_EQ(loaded.GetMapWidth(), 70);
+    EXPECT_EQ(loaded.GetMapHeight(), 40);
+    EXPECT_EQ(playerX, 12);
+    EXPECT_EQ(playerY, 13);
+    EXPECT_EQ(characterType, 1);
+
+    EXPECT_EQ(loaded.GetLayerTile(1, 2, GROUND), 5);
+    EXPECT_EQ(loaded.GetLayerTile(40, 3, GROUND), 6);
+    EXPECT_FLOAT_EQ(loaded.GetLayerRotation(40, 3, GROUND), 90.0f);
+    EXPECT_EQ(loaded.GetLayerTile(65, 35, DECOR), 7);
+    EXPECT_TRUE(loaded.GetLayerNoProjection(65, 35, DECOR));
+    EXPECT_EQ(loaded.GetTileStructureId(65, 35, DECOR), 0);
+    EXPECT_EQ(loaded.GetLayerTile(0, 0, GROUND), -1);
+
+    EXPECT_TRUE(loaded.GetTileCollision(3, 4));
+    EXPECT_TRUE(loaded.GetTileCollision(69, 39));
+    EXPECT_FALSE(loaded.GetTileCollision(4, 4));
+    EXPECT_TRUE(loaded.GetNavigation(5, 6));
+    EXPECT_TRUE(loaded.GetNavigation(33, 33));
+    EXPECT_FALSE(loaded.GetNavigation(6, 6));
+    EXPECT_TRUE(loaded.IsCornerCutBlocked(3, 4, Tilemap::CORNER_TR));
+    EXPECT_FALSE(loaded.IsCornerCutBlocked(3, 4, Tilemap::CORNER_TL));
+    EXPECT_EQ(loaded.GetElevation(7, 8), 3);
+    EXPECT_EQ(loaded.GetElevation(50, 20), -2);
+
+    ASSERT_EQ(loaded.GetParticleZones()->size(), 1u);
+    const ParticleZone &zone = loaded.GetParticleZones()->front();
+    EXPECT_EQ(zone.position, glm::vec2(32.0f, 48.0f));
+    EXPECT_EQ(zone.size, glm::vec2(64.0f, 16.0f));
+    EXPECT_EQ(zone.type, ParticleType::Firefly);
+    EXPECT_TRUE(zone.noProjection);
+
+    ASSERT_EQ(loaded.GetNoProjectionStructureCount(), 1u);
+    const NoProjectionStructure *structure = loaded.GetNoProjectionStructure(0);
+    ASSERT_NE(structure, nullptr);
+    EXPECT_EQ(structure->name, "Hut");
+    EXPECT_EQ(structure->leftAnchor, glm::vec2(16.0f, 32.0f));
+    EXPECT_EQ(structure->rightAnchor, glm::vec2(48.0f, 32.0f));
+
+    EXPECT_EQ(loaded.GetTileAnimation(2, 2, GROUND), 0);
+    const AnimatedTile *animation = loaded.GetAnimatedTile(0);
+    ASSERT_NE(animation, nullptr);
+    EXPECT_EQ(animation->frames, (std::vector<int>{8, 9, 10}));
+    EXPECT_FLOAT_EQ(animation->frameDuration, 0.25f);
+}
+
+TEST_F(BinaryMapTest, ValidFileOpens)
+{
+    BinaryMapView view;
+    ASSERT_TRUE(view.Open(Path("sample.wmap")));
+    EXPECT_EQ(view.GetHeader().width, 70);
+    EXPECT_EQ(view.GetHeader().height, 40);
+    EXPECT_FALSE(view.GetSection<BinaryMapLayer>(BinaryMapSectionType::Layers).empty());
+}
+
+TEST_F(BinaryMapTest, RejectsBadMagic)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { HeaderOf(bytes).magic ^= 1u; })));
+}
+
+TEST_F(BinaryMapTest, RejectsOtherVersion)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { HeaderOf(bytes).version = BINARY_MAP_VERSION + 1; })));
+}
+
+TEST_F(BinaryMapTest, RejectsFileShorterThanHeader)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { bytes.resize(sizeof(BinaryMapHeader) - 1); })));
+}
+
+TEST_F(BinaryMapTest, RejectsOversizedDimensions)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes)
+                                     { HeaderOf(bytes).width = BINARY_MAP_MAX_DIMENSION + 1; })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes)
+                                     { HeaderOf(bytes).height = BINARY_MAP_MAX_DIMENSION + 1; })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { HeaderOf(bytes).width = 0; })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { HeaderOf(bytes).tileWidth = 0; })));
+}
+
+TEST_F(BinaryMapTest, RejectsTruncatedSectionTable)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { HeaderOf(bytes).sectionCount = 0x10000000u; })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes)
+                                     { bytes.resize(sizeof(BinaryMapHeader) + sizeof(BinaryMapSection)); })));
+}
+
+TEST_F(BinaryMapTest, RejectsMisalignedSection)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { SectionOf(bytes, 0).offset += 4; })));
+}
+
+TEST_F(BinaryMapTest, RejectsOutOfBoundsSection)
+{
+    BinaryMapView view;
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes)
+                                     { SectionOf(bytes, 0).size = bytes.size(); })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes)
+                                     { SectionOf(bytes, 0).offset = (bytes.size() + 15) & ~size_t{15}; })));
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { SectionOf(bytes, 0).size = ~uint64_t{0}; })));
+    // Overlapping the header or the table
+    EXPECT_FALSE(view.Open(Corrupted([](std::vector<char> &bytes) { SectionOf(bytes, 0).offset = 0; })));
+}
+
+TEST_F(BinaryMapTest, OutOfRangeChunkIndicesAreSkipped)
+{
+    // 40x40 tiles is 2x2 chunks; indices 4 and 0xFFFFFFFF are outside it
+    BinaryMapWriter writer;
+    const BinaryMapLayer layer{writer.AddString("Ground"), 6, 0, 1};
+    writer.AddSection(BinaryMapSectionType::Layers, 0, std::span<const BinaryMapLayer>(&layer, 1));
+
+    const std::vector<uint32_t> index = {4, 0xFFFFFFFFu, 3};
+    std::vector<PackedTile> cells(index.size() * BINARY_MAP_CHUNK_CELLS);
+    for (size_t k = 0; k < index.size(); ++k)
+        cells[k * BINARY_MAP_CHUNK_CELLS].SetTileId(static_cast<int>(k) + 1);
+    writer.AddSection(BinaryMapSectionType::LayerChunkIndex, 0, std::span<const uint32_t>(index));
+    writer.AddSection(BinaryMapSectionType::LayerChunkCells, 0, std::span<const PackedTile>(cells));
+
+    BinaryMapHeader header{};
+    header.width = 40;
+    header.height = 40;
+    header.tileWidth = 16;
+    header.tileHeight = 16;
+    header.playerTileX = -1;
+    header.playerTileY = -1;
+    header.characterType = -1;
+    ASSERT_TRUE(writer.Write(Path("chunks.wmap"), header));
+
+    Tilemap tilemap;
+    ASSERT_TRUE(tilemap.LoadMapFromBinary(Path("chunks.wmap")));
+    ASSERT_EQ(tilemap.GetLayerCount(), 1u);
+    EXPECT_EQ(tilemap.GetLayerTile(32, 32, 0), 3);
+    for (int y = 0; y < 40; ++y)
+    {
+        for (int x = 0; x < 40; ++x)
+        {
+            if (x != 32 || y != 32)
+            {
+                ASSERT_EQ(tilemap.GetLayerTile(x, y, 0), -1) << x << ", " << y;
+            }
+        }
+    }
+}
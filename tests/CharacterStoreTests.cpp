@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "../src/CharacterStore.h"
+#include "../src/NonPlayerCharacter.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+TEST(CharacterStoreTest, AllocateReusesReleasedSlots)
+{
+    CharacterStore store;
+    const CharacterStore::Slot first = store.Allocate();
+    const CharacterStore::Slot second = store.Allocate();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(store.GetLiveCount(), 2u);
+
+    store.Release(first);
+    EXPECT_FALSE(store.IsLive(first));
+    EXPECT_EQ(store.GetLiveCount(), 1u);
+
+    // The freed row comes back before the arrays grow
+    EXPECT_EQ(store.Allocate(), first);
+    EXPECT_EQ(store.GetSlotCount(), 2u);
+    EXPECT_TRUE(store.IsLive(first));
+    EXPECT_GT(store.GetMemoryBytes(), 0u);
+}
+
+TEST(CharacterStoreTest, AllocatedRowsStartFromNpcDefaults)
+{
+    CharacterStore store;
+    const CharacterStore::Slot slot = store.Allocate();
+    store.SetPosition(slot, {5.0f, 6.0f});
+    store.m_WaitTimer[slot] = 1.0f;
+    store.m_Stopped[slot] = 1;
+    store.m_Frame[slot] = 2;
+    store.Release(slot);
+
+    ASSERT_EQ(store.Allocate(), slot);
+    EXPECT_EQ(store.GetPosition(slot), glm::vec2(0.0f));
+    EXPECT_EQ(store.m_WaitTimer[slot], 0.0f);
+    EXPECT_EQ(store.m_Stopped[slot], 0);
+    EXPECT_EQ(store.m_Frame[slot], 0);
+    EXPECT_EQ(store.m_Direction[slot], CharacterDirection::DOWN);
+    EXPECT_EQ(store.m_Speed[slot], CharacterStore::DEFAULT_SPEED);
+    EXPECT_EQ(store.m_ElevationProgress[slot], 1.0f);
+    EXPECT_EQ(store.m_SimLod[slot], SimLod::Full);
+}
+
+TEST(CharacterStoreTest, StopOverlappingUsesFeetAnchoredHitboxes)
+{
+    // 16x16 hitboxes: x +/- 8, from y - 16 down to y
+    CharacterStore store;
+    const glm::vec2 positions[] = {
+        {100.0f, 100.0f},  // Same spot as the box
+        {115.0f, 100.0f},  // Overlaps by 1 px horizontally
+        {116.0f, 100.0f},  // Edges only touch
+        {100.0f, 115.0f},  // Overlaps by 1 px vertically
+        {100.0f, 116.0f},  // Edges only touch
+    };
+    for (const glm::vec2 &position : positions)
+    {
+        const CharacterStore::Slot slot = store.Allocate();
+        store.SetPosition(slot, position);
+        store.m_Stopped[slot] = 1;  // Cleared again where there is no overlap
+    }
+
+    store.StopOverlapping({92.0f, 84.0f}, {108.0f, 100.0f}, 8.0f, 16.0f);
+    EXPECT_EQ(store.m_Stopped, (std::vector<std::uint8_t>{1, 1, 0, 1, 0}));
+}
+
+TEST(CharacterStoreTest, InterpolatedRenderBlendsAndRestores)
+{
+    CharacterStore store;
+    const CharacterStore::Slot walker = store.Allocate();
+    const CharacterStore::Slot teleported = store.Allocate();
+    store.SetPosition(walker, {0.0f, 0.0f});
+    store.SetPosition(teleported, {0.0f, 0.0f});
+    store.StorePreviousPositions();
+
+    store.SetPosition(walker, {10.0f, 0.0f});
+    store.SetPosition(teleported, {500.0f, 0.0f});
+    store.BeginInterpolatedRender(0.5f);
+    EXPECT_EQ(store.GetPosition(walker), glm::vec2(5.0f, 0.0f));
+    EXPECT_EQ(store.GetPosition(teleported), glm::vec2(500.0f, 0.0f));
+
+    store.EndInterpolatedRender();
+    EXPECT_EQ(store.GetPosition(walker), glm::vec2(10.0f, 0.0f));
+}
+
+TEST(CharacterStoreTest, NpcStateLivesInItsRow)
+{
+    CharacterStore &store = CharacterStore::Npcs();
+    NonPlayerCharacter npc;
+    const CharacterStore::Slot slot = npc.GetSlot();
+    ASSERT_TRUE(store.IsLive(slot));
+    EXPECT_EQ(store.GetOwner(slot), &npc);
+
+    npc.SetTilePosition(2, 3, 16);
+    npc.SetStopped(true);
+    EXPECT_EQ(store.GetPosition(slot), glm::vec2(40.0f, 64.0f));
+    EXPECT_EQ(npc.GetTargetTile(), glm::ivec2(2, 3));
+    EXPECT_EQ(store.m_Stopped[slot], 1);
+    EXPECT_EQ(npc.GetSpeed(), CharacterStore::DEFAULT_SPEED);
+}
+
+TEST(CharacterStoreTest, MovedNpcKeepsItsRow)
+{
+    CharacterStore &store = CharacterStore::Npcs();
+    std::vector<NonPlayerCharacter> npcs;
+    npcs.emplace_back().SetPosition({1.0f, 2.0f});
+    const CharacterStore::Slot slot = npcs[0].GetSlot();
+
+    // Growing the vector moves the NPC; the row follows it
+    for (int i = 0; i < 8; ++i)
+        npcs.emplace_back();
+    EXPECT_EQ(npcs[0].GetSlot(), slot);
+    EXPECT_EQ(store.GetOwner(slot), &npcs[0]);
+    EXPECT_EQ(npcs[0].GetPosition(), glm::vec2(1.0f, 2.0f));
+
+    // Erasing move-assigns the later NPCs down and releases the erased row
+    const CharacterStore::Slot erased = npcs[0].GetSlot();
+    const CharacterStore::Slot shifted = npcs[1].GetSlot();
+    const std::size_t liveBefore = store.GetLiveCount();
+    npcs.erase(npcs.begin());
+    EXPECT_EQ(store.GetLiveCount(), liveBefore - 1);
+    EXPECT_FALSE(store.IsLive(erased));
+    EXPECT_EQ(npcs[0].GetSlot(), shifted);
+    EXPECT_EQ(store.GetOwner(shifted), &npcs[0]);
+}
+
+TEST(CharacterStoreTest, DestroyedNpcReleasesItsRow)
+{
+    CharacterStore &store = CharacterStore::Npcs();
+    const std::size_t liveBefore = store.GetLiveCount();
+    CharacterStore::Slot slot;
+    {
+        NonPlayerCharacter npc;
+        slot = npc.GetSlot();
+        EXPECT_EQ(store.GetLiveCount(), liveBefore + 1);
+    }
+    EXPECT_EQ(store.GetLiveCount(), liveBefore);
+    EXPECT_FALSE(store.IsLive(slot));
+}
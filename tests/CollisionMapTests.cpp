@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "../src/BitVector.h"
 #include "../src/CollisionMap.h"
 
 #include <vector>
@@ -222,3 +223,93 @@ TEST_F(CollisionMapTest, SingleCellMap)
     EXPECT_TRUE(single.HasCollision(0, 0));
     EXPECT_EQ(single.GetCollisionCount(), 1);
 }
+
+// --- Rectangle Queries ---
+
+TEST_F(CollisionMapTest, AnyCollisionInRect)
+{
+    map.SetCollision(4, 6, true);
+    EXPECT_TRUE(map.AnyCollisionInRect(3, 5, 5, 7));
+    EXPECT_FALSE(map.AnyCollisionInRect(0, 0, 3, 9));
+    EXPECT_TRUE(map.AnyCollisionInRect(-5, -5, 20, 20));
+    EXPECT_FALSE(map.AnyCollisionInRect(5, 5, 4, 4));
+}
+
+TEST_F(CollisionMapTest, CountCollisionsInRect)
+{
+    map.SetCollision(0, 0, true);
+    map.SetCollision(9, 0, true);
+    map.SetCollision(5, 5, true);
+    EXPECT_EQ(map.CountCollisionsInRect(0, 0, 9, 0), 2);
+    EXPECT_EQ(map.CountCollisionsInRect(0, 0, 9, 9), 3);
+    EXPECT_EQ(map.CountCollisionsInRect(1, 1, 4, 4), 0);
+}
+
+// --- BitVector Storage ---
+
+class BitVectorCollisionMapTest : public ::testing::Test
+{
+protected:
+    CollisionMap<BitVector> map;
+
+    void SetUp() override
+    {
+        map.Resize(100, 3);
+    }
+};
+
+TEST_F(BitVectorCollisionMapTest, MatchesVectorBool)
+{
+    CollisionMap<std::vector> reference;
+    reference.Resize(100, 3);
+    for (int i = 0; i < 300; i += 7)
+    {
+        map.SetCollision(i % 100, i / 100, true);
+        reference.SetCollision(i % 100, i / 100, true);
+    }
+    map[63][1] = true;
+    reference[63][1] = true;
+
+    EXPECT_EQ(map.GetCollisionCount(), reference.GetCollisionCount());
+    EXPECT_EQ(map.GetCollisionIndices(), reference.GetCollisionIndices());
+    for (int x0 = 0; x0 < 100; x0 += 13)
+    {
+        for (int x1 = x0; x1 < 100; x1 += 17)
+        {
+            EXPECT_EQ(map.CountCollisionsInRect(x0, 0, x1, 2), reference.CountCollisionsInRect(x0, 0, x1, 2));
+            EXPECT_EQ(map.AnyCollisionInRect(x0, 1, x1, 1), reference.AnyCollisionInRect(x0, 1, x1, 1));
+        }
+    }
+}
+
+TEST_F(BitVectorCollisionMapTest, RectQueriesSpanWordBoundaries)
+{
+    map.SetCollision(63, 0, true);
+    map.SetCollision(64, 0, true);
+    map.SetCollision(99, 0, true);
+    map.SetCollision(0, 1, true);
+    EXPECT_EQ(map.CountCollisionsInRect(60, 0, 70, 0), 2);
+    EXPECT_EQ(map.CountCollisionsInRect(0, 0, 99, 1), 4);
+    EXPECT_FALSE(map.AnyCollisionInRect(1, 1, 99, 2));
+    EXPECT_TRUE(map.AnyCollisionInRect(99, 0, 99, 0));
+}
+
+TEST_F(BitVectorCollisionMapTest, ForEachCollisionInRect)
+{
+    map.SetCollision(2, 0, true);
+    map.SetCollision(70, 1, true);
+    map.SetCollision(80, 2, true);
+    std::vector<std::pair<int, int>> visited;
+    map.ForEachCollisionInRect(0, 0, 75, 2, [&](int x, int y) { visited.emplace_back(x, y); });
+    EXPECT_EQ(visited, (std::vector<std::pair<int, int>>{{2, 0}, {70, 1}}));
+}
+
+TEST_F(BitVectorCollisionMapTest, ClearAndCopy)
+{
+    map.SetCollision(50, 2, true);
+    CollisionMap<BitVector> copy(map);
+    map.Clear();
+    EXPECT_EQ(map.GetCollisionCount(), 0);
+    EXPECT_TRUE(copy.HasCollision(50, 2));
+    EXPECT_EQ(copy.GetCollisionCount(), 1);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "../src/CompiledDialogue.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+DialogueTree MakeElderTree()
+{
+    DialogueTree tree("elder", "greeting");
+
+    DialogueNode greeting("greeting", "Elder", "Welcome.");
+    DialogueOption ask("Any work?", "quest");
+    ask.conditions.push_back({DialogueCondition::Type::FLAG_NOT_SET, "accepted_wolf_quest"});
+    greeting.options.push_back(ask);
+    DialogueOption mood("How are you?", "");
+    mood.conditions.push_back({DialogueCondition::Type::FLAG_EQUALS, "mood", "grumpy"});
+    greeting.options.push_back(mood);
+    greeting.options.push_back({"Goodbye", ""});
+    tree.AddNode(greeting);
+
+    DialogueNode quest("quest", "Elder", "Wolves took the sheep.");
+    DialogueOption accept("I'll help.", "missing");
+    accept.consequences.push_back({DialogueConsequence::Type::SET_FLAG_VALUE, "accepted_wolf_quest", "Hunt wolves"});
+    quest.options.push_back(accept);
+    tree.AddNode(quest);
+    return tree;
+}
+}  // namespace
+
+TEST(CompiledDialogueTest, LinksNodesByIndex)
+{
+    auto dialogue = CompiledDialogue::Compile(MakeElderTree());
+    ASSERT_NE(dialogue->GetStartNode(), nullptr);
+    EXPECT_EQ(dialogue->GetNodeCount(), 2u);
+
+    const CompiledDialogue::Node &start = *dialogue->GetStartNode();
+    EXPECT_EQ(start.id, "greeting");
+    ASSERT_EQ(dialogue->GetOptions(start).size(), 3u);
+
+    const CompiledDialogue::Option &ask = dialogue->GetOptions(start)[0];
+    const CompiledDialogue::Node *quest = dialogue->GetNext(ask);
+    ASSERT_NE(quest, nullptr);
+    EXPECT_EQ(quest->text, "Wolves took the sheep.");
+    EXPECT_EQ(dialogue->GetNext(dialogue->GetOptions(start)[2]), nullptr);
+
+    // A goto naming a missing node ends the conversation
+    const CompiledDialogue::Option &accept = dialogue->GetOptions(*quest)[0];
+    EXPECT_EQ(dialogue->GetNext(accept), nullptr);
+    EXPECT_TRUE(accept.givesQuest);
+    EXPECT_FALSE(ask.givesQuest);
+}
+
+TEST(CompiledDialogueTest, ConditionsUseBoundFlags)
+{
+    auto dialogue = CompiledDialogue::Compile(MakeElderTree());
+    EXPECT_EQ(dialogue->GetFlagKeys(), (std::vector<std::string>{"accepted_wolf_quest", "mood"}));
+
+    GameStateManager state;
+    const auto flags = dialogue->BindFlags(state);
+    ASSERT_EQ(flags.size(), 2u);
+    EXPECT_EQ(flags[0], state.Find("accepted_wolf_quest"));
+
+    const auto options = dialogue->GetOptions(*dialogue->GetStartNode());
+    EXPECT_TRUE(dialogue->IsVisible(options[0], state, flags));
+    EXPECT_FALSE(dialogue->IsVisible(options[1], state, flags));
+    EXPECT_TRUE(dialogue->IsVisible(options[2], state, flags));
+
+    state.SetFlagValue("accepted_wolf_quest", "Hunt wolves");
+    state.SetFlagValue("mood", "grumpy");
+    EXPECT_FALSE(dialogue->IsVisible(options[0], state, flags));
+    EXPECT_TRUE(dialogue->IsVisible(options[1], state, flags));
+}
+
+TEST(CompiledDialogueTest, ShareReusesEqualTrees)
+{
+    const DialogueTree tree = MakeElderTree();
+    auto first = CompiledDialogue::Share(tree);
+    auto second = CompiledDialogue::Share(tree);
+    EXPECT_EQ(first, second);
+
+    DialogueTree changed = tree;
+    changed.nodes["greeting"].text = "Go away.";
+    auto third = CompiledDialogue::Share(changed);
+    EXPECT_NE(third, first);
+    EXPECT_EQ(third->GetStartNode()->text, "Go away.");
+    EXPECT_EQ(first->GetStartNode()->text, "Welcome.");
+
+    EXPECT_EQ(CompiledDialogue::Share(DialogueTree{}), nullptr);
+}
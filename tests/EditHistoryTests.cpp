@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "../src/EditHistory.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using Field = EditHistory::Field;
+
+/// One layer of tiles plus a structure list, edited through the history
+struct FakeMap : EditHistory::Target
+{
+    std::vector<std::int32_t> tiles = std::vector<std::int32_t>(64, -1);
+    std::vector<int> structures;  // Structure IDs in list order
+    std::vector<char> log;        // 'c' cell, 'i' insert, 'r' remove
+    int cellWrites = 0;
+
+    void Paint(EditHistory &history, std::uint32_t cell, std::int32_t value)
+    {
+        history.Record(Field::Tile, 0, cell, tiles[cell], value);
+        tiles[cell] = value;
+    }
+
+    void SetCell(Field, int, std::uint32_t cell, std::int32_t value) override
+    {
+        tiles[cell] = value;
+        ++cellWrites;
+        log.push_back('c');
+    }
+
+    void InsertStructure(const EditHistory::StructureChange &change) override
+    {
+        structures.insert(structures.begin() + change.id, change.id);
+        log.push_back('i');
+    }
+
+    void RemoveStructure(std::int32_t id) override
+    {
+        structures.erase(structures.begin() + id);
+        log.push_back('r');
+    }
+};
+}  // namespace
+
+TEST(EditHistoryTest, StrokeUndoesAndRedoesAsOneStep)
+{
+    EditHistory history;
+    FakeMap map;
+    for (std::uint32_t cell = 0; cell < 8; ++cell)
+        map.Paint(history, cell, 5);
+    EXPECT_TRUE(history.Commit());
+    EXPECT_FALSE(history.Commit());
+
+    ASSERT_TRUE(history.Undo(map));
+    EXPECT_EQ(map.tiles, std::vector<std::int32_t>(64, -1));
+    EXPECT_FALSE(history.Undo(map));
+
+    ASSERT_TRUE(history.Redo(map));
+    for (std::uint32_t cell = 0; cell < 8; ++cell)
+        EXPECT_EQ(map.tiles[cell], 5);
+    EXPECT_EQ(history.GetUndoCount(), 1u);
+}
+
+TEST(EditHistoryTest, RepeatedWritesCollapse)
+{
+    EditHistory history;
+    FakeMap map;
+    map.Paint(history, 3, 1);
+    map.Paint(history, 3, 2);
+    map.Paint(history, 4, 7);
+    map.Paint(history, 4, -1);  // Back where it started
+    history.Commit();
+
+    map.cellWrites = 0;
+    ASSERT_TRUE(history.Undo(map));
+    EXPECT_EQ(map.tiles[3], -1);
+    EXPECT_EQ(map.cellWrites, 1);
+}
+
+TEST(EditHistoryTest, UniformFillIsOneRunOfConstantSize)
+{
+    EditHistory history;
+    FakeMap map;
+    map.tiles.assign(4096, -1);
+    // Scattered order, as a flood fill writes it
+    for (std::uint32_t i = 0; i < 4096; ++i)
+        map.Paint(history, (i * 2654435761u) % 4096, 9);
+    history.Commit();
+
+    EditHistory single;
+    FakeMap other;
+    other.Paint(single, 0, 9);
+    single.Commit();
+    EXPECT_EQ(history.GetMemoryBytes(), single.GetMemoryBytes());
+
+    ASSERT_TRUE(history.Undo(map));
+    EXPECT_EQ(map.tiles, std::vector<std::int32_t>(4096, -1));
+}
+
+TEST(EditHistoryTest, NewEditClearsRedo)
+{
+    EditHistory history;
+    FakeMap map;
+    map.Paint(history, 0, 1);
+    history.Commit();
+    history.Undo(map);
+    EXPECT_EQ(history.GetRedoCount(), 1u);
+
+    map.Paint(history, 1, 2);
+    EXPECT_FALSE(history.Redo(map));
+    EXPECT_EQ(history.GetRedoCount(), 0u);
+    EXPECT_EQ(map.tiles[0], -1);
+    EXPECT_EQ(map.tiles[1], 2);
+}
+
+TEST(EditHistoryTest, BudgetDropsOldestSteps)
+{
+    EditHistory history;
+    FakeMap map;
+    for (std::uint32_t cell = 0; cell < 10; ++cell)
+    {
+        // One step per cell
+        map.Paint(history, cell, static_cast<std::int32_t>(cell));
+        history.Commit();
+    }
+    const std::size_t perStroke = history.GetMemoryBytes() / 10;
+    history.SetBudget(perStroke * 3);
+    EXPECT_EQ(history.GetUndoCount(), 3u);
+    EXPECT_LE(history.GetMemoryBytes(), perStroke * 3);
+
+    while (history.Undo(map))
+    {
+    }
+    EXPECT_EQ(map.tiles[6], 6);
+    EXPECT_EQ(map.tiles[7], -1);
+}
+
+TEST(EditHistoryTest, StructuresRevertBeforeCells)
+{
+    EditHistory history;
+    FakeMap map;
+    map.structures = {0, 1, 2};
+
+    // Remove structure 1; cells that referenced old IDs are renumbered
+    history.RecordStructure({false, 1, {0, 0}, {16, 16}, "tower"});
+    map.structures.erase(map.structures.begin() + 1);
+    map.Paint(history, 0, 1);
+    history.Commit();
+
+    ASSERT_TRUE(history.Undo(map));
+    EXPECT_EQ(map.structures, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(map.log, (std::vector<char>{'i', 'c'}));
+
+    map.log.clear();
+    ASSERT_TRUE(history.Redo(map));
+    EXPECT_EQ(map.structures, (std::vector<int>{0, 2}));
+    EXPECT_EQ(map.log, (std::vector<char>{'r', 'c'}));
+}
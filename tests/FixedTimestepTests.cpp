@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../src/FixedTimestep.h"
+
+TEST(FixedTimestepTest, AccumulatesPartialFrames)
+{
+    FixedTimestep timestep;
+    timestep.SetStep(0.01f);
+
+    EXPECT_EQ(timestep.Advance(0.004f), 0);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.4f, 1e-4f);
+    EXPECT_EQ(timestep.Advance(0.004f), 0);
+    EXPECT_EQ(timestep.Advance(0.004f), 1);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.2f, 1e-4f);
+}
+
+TEST(FixedTimestepTest, SlowFramesRunSeveralSteps)
+{
+    FixedTimestep timestep;
+    timestep.SetStep(0.01f);
+    EXPECT_EQ(timestep.Advance(0.035f), 3);
+    EXPECT_NEAR(timestep.GetAlpha(), 0.5f, 1e-4f);
+}
+
+TEST(FixedTimestepTest, ExactStepsDoNotDrift)
+{
+    // 1/60 is not representable; a thousand exact frames must still give a thousand steps
+    FixedTimestep timestep;
+    int total = 0;
+    for (int i = 0; i < 1000; ++i)
+        total += timestep.Advance(FixedTimestep::DEFAULT_STEP);
+    EXPECT_EQ(total, 1000);
+    EXPECT_LT(timestep.GetAlpha(), 0.01f);
+}
+
+TEST(FixedTimestepTest, StepLimitDropsExcessTime)
+{
+    FixedTimestep timestep;
+    timestep.SetStep(0.01f);
+    timestep.SetMaxSteps(4);
+    EXPECT_EQ(timestep.Advance(0.1f), 4);
+    EXPECT_EQ(timestep.GetDroppedSteps(), 6);
+    EXPECT_LT(timestep.GetAlpha(), 1.0f);
+
+    // The dropped time does not come back on the next frame
+    EXPECT_EQ(timestep.Advance(0.0f), 0);
+}
+
+TEST(FixedTimestepTest, ResetAndNegativeTime)
+{
+    FixedTimestep timestep;
+    timestep.SetStep(0.01f);
+    timestep.Advance(0.005f);
+    timestep.Reset();
+    EXPECT_FLOAT_EQ(timestep.GetAlpha(), 0.0f);
+    EXPECT_EQ(timestep.Advance(-1.0f), 0);
+    EXPECT_FLOAT_EQ(timestep.GetAlpha(), 0.0f);
+}
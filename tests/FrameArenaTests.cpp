@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../src/FrameArena.h"
+
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+
+namespace
+{
+// Upstream that counts what the arena asks of the heap
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    int allocations = 0;
+    int live = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+    {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+void FillFrame(FrameArena &arena, std::size_t elements)
+{
+    FrameVector<std::uint32_t> values(&arena);
+    for (std::size_t i = 0; i < elements; ++i)
+        values.push_back(static_cast<std::uint32_t>(i));
+    FrameString text("a string too long for the small buffer", &arena);
+    text += " and then some";
+}
+}
+
+TEST(FrameArenaTest, AllocationsRespectAlignment)
+{
+    FrameArena arena(1024);
+    EXPECT_NE(arena.allocate(1, 1), nullptr);
+    for (std::size_t alignment : {2u, 4u, 8u, 16u, 64u})
+    {
+        void *p = arena.allocate(3, alignment);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignment, 0u) << "alignment " << alignment;
+    }
+    // Overflow chunks keep the requested alignment as well
+    void *big = arena.allocate(4096, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % 64, 0u);
+    EXPECT_EQ(arena.GetOverflowCount(), 1u);
+}
+
+TEST(FrameArenaTest, ResetRewindsTheBlock)
+{
+    FrameArena arena(1024);
+    void *first = arena.allocate(100, 8);
+    EXPECT_GE(arena.GetUsedBytes(), 100u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsedBytes(), 0u);
+    EXPECT_GE(arena.GetPeakBytes(), 100u);
+    EXPECT_EQ(arena.allocate(100, 8), first);
+}
+
+TEST(FrameArenaTest, GrowsUntilFramesStopTouchingUpstream)
+{
+    CountingResource upstream;
+    {
+        FrameArena arena(256, &upstream);
+        EXPECT_EQ(upstream.allocations, 1);
+
+        FillFrame(arena, 1000);
+        EXPECT_GT(arena.GetOverflowCount(), 0u);
+        arena.Reset();
+        EXPECT_GE(arena.GetCapacity(), arena.GetPeakBytes());
+
+        // The same work now fits the block
+        const int before = upstream.allocations;
+        const std::size_t overflows = arena.GetOverflowCount();
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            FillFrame(arena, 1000);
+            arena.Reset();
+        }
+        EXPECT_EQ(upstream.allocations, before);
+        EXPECT_EQ(arena.GetOverflowCount(), overflows);
+        EXPECT_EQ(upstream.live, 1);
+    }
+    EXPECT_EQ(upstream.live, 0);
+}
+
+TEST(FrameArenaTest, EachThreadHasItsOwnArena)
+{
+    FrameArena *main = &FrameArena::ThisThread();
+    FrameArena *worker = nullptr;
+    std::thread([&] { worker = &FrameArena::ThisThread(); }).join();
+    EXPECT_NE(main, worker);
+    EXPECT_EQ(main, &FrameArena::ThisThread());
+}
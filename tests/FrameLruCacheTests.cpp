@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../src/FrameLruCache.h"
+
+#include <vector>
+
+TEST(FrameLruCacheTest, FindReturnsInsertedValue)
+{
+    FrameLruCache<int, int> cache(4);
+    EXPECT_TRUE(cache.Insert(1, 10));
+    EXPECT_FALSE(cache.Insert(1, 11));
+    ASSERT_NE(cache.Find(1), nullptr);
+    EXPECT_EQ(*cache.Find(1), 10);
+    EXPECT_EQ(cache.Find(2), nullptr);
+}
+
+TEST(FrameLruCacheTest, InsertStopsAtCapacity)
+{
+    FrameLruCache<int, int> cache(2);
+    EXPECT_TRUE(cache.Insert(1, 10));
+    EXPECT_TRUE(cache.Insert(2, 20));
+    EXPECT_TRUE(cache.Full());
+    EXPECT_FALSE(cache.Insert(3, 30));
+    EXPECT_EQ(cache.Size(), 2u);
+}
+
+TEST(FrameLruCacheTest, EntriesUsedThisFrameAreNotEvicted)
+{
+    FrameLruCache<int, int> cache(2);
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+
+    int key = 0, value = 0;
+    EXPECT_FALSE(cache.EvictOldest(key, value));
+
+    cache.NextFrame();
+    EXPECT_TRUE(cache.EvictOldest(key, value));
+    EXPECT_EQ(key, 1);
+    EXPECT_EQ(value, 10);
+}
+
+TEST(FrameLruCacheTest, FindMovesEntryToTheFront)
+{
+    FrameLruCache<int, int> cache(3);
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+    cache.Insert(3, 30);
+    cache.NextFrame();
+
+    // 1 is the oldest until it is used again
+    cache.Find(1);
+    cache.NextFrame();
+
+    int key = 0, value = 0;
+    ASSERT_TRUE(cache.EvictOldest(key, value));
+    EXPECT_EQ(key, 2);
+    ASSERT_TRUE(cache.EvictOldest(key, value));
+    EXPECT_EQ(key, 3);
+    ASSERT_TRUE(cache.EvictOldest(key, value));
+    EXPECT_EQ(key, 1);
+    EXPECT_FALSE(cache.EvictOldest(key, value));
+}
+
+TEST(FrameLruCacheTest, OldEntriesGoWhileFreshOnesStay)
+{
+    FrameLruCache<int, int> cache(2);
+    cache.Insert(1, 10);
+    cache.NextFrame();
+    cache.Insert(2, 20);
+
+    int key = 0, value = 0;
+    ASSERT_TRUE(cache.EvictOldest(key, value));
+    EXPECT_EQ(key, 1);
+    EXPECT_FALSE(cache.EvictOldest(key, value));
+    EXPECT_NE(cache.Find(2), nullptr);
+}
+
+TEST(FrameLruCacheTest, EraseRemovesRegardlessOfAge)
+{
+    FrameLruCache<int, int> cache(2);
+    cache.Insert(1, 10);
+    int value = 0;
+    EXPECT_TRUE(cache.Erase(1, value));
+    EXPECT_EQ(value, 10);
+    EXPECT_FALSE(cache.Erase(1, value));
+    EXPECT_EQ(cache.Size(), 0u);
+    EXPECT_TRUE(cache.Insert(1, 11));
+}
+
+TEST(FrameLruCacheTest, ForEachVisitsMostRecentFirst)
+{
+    FrameLruCache<int, int> cache(3);
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+    cache.Insert(3, 30);
+    cache.Find(1);
+
+    std::vector<int> keys;
+    cache.ForEach([&](int key, int) { keys.push_back(key); });
+    EXPECT_EQ(keys, (std::vector<int>{1, 3, 2}));
+
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0u);
+}
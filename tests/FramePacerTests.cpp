@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "../src/FramePacer.h"
+
+#include <chrono>
+#include <thread>
+
+TEST(FramePacerTest, DisabledPacingReturnsImmediately)
+{
+    FramePacer pacer;
+    EXPECT_EQ(pacer.GetInterval(), 0.0);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+        pacer.WaitForNextFrame();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_LT(elapsed, 0.05);
+    EXPECT_EQ(pacer.GetStats().frames, 0);
+}
+
+TEST(FramePacerTest, RefreshAlignmentRoundsUpToWholePeriods)
+{
+    EXPECT_DOUBLE_EQ(FramePacer::ComputeInterval(500.0f, 144.0, false), 1.0 / 500.0);
+    EXPECT_DOUBLE_EQ(FramePacer::ComputeInterval(500.0f, 144.0, true), 1.0 / 144.0);
+    EXPECT_DOUBLE_EQ(FramePacer::ComputeInterval(50.0f, 144.0, true), 3.0 / 144.0);
+    // Near-miss caps stay at one refresh instead of skipping to two
+    EXPECT_DOUBLE_EQ(FramePacer::ComputeInterval(60.0f, 59.94, true), 1.0 / 59.94);
+    // Unknown refresh rate leaves the cap as is
+    EXPECT_DOUBLE_EQ(FramePacer::ComputeInterval(90.0f, 0.0, true), 1.0 / 90.0);
+    EXPECT_EQ(FramePacer::ComputeInterval(0.0f, 60.0, true), 0.0);
+}
+
+TEST(FramePacerTest, PacesToTheTargetRate)
+{
+    FramePacer pacer;
+    pacer.SetTargetFps(200.0f);
+
+    constexpr int FRAMES = 40;
+    pacer.WaitForNextFrame();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; ++i)
+        pacer.WaitForNextFrame();
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Deadlines never come early; a loaded machine may run late but not drift much
+    EXPECT_GE(elapsed, FRAMES * 0.005 - 1e-3);
+    EXPECT_LT(elapsed, FRAMES * 0.005 * 1.5);
+
+    const FramePacer::Stats stats = pacer.GetStats();
+    EXPECT_EQ(stats.frames + stats.missed, FRAMES + 1);
+    EXPECT_GE(stats.meanError, 0.0);
+    EXPECT_GE(stats.maxError, stats.meanError);
+}
+
+TEST(FramePacerTest, OverrunFramesCountAsMissed)
+{
+    FramePacer pacer;
+    pacer.SetTargetFps(1000.0f);
+    pacer.WaitForNextFrame();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    pacer.WaitForNextFrame();
+    EXPECT_EQ(pacer.GetStats().missed, 1);
+
+    pacer.ResetStats();
+    EXPECT_EQ(pacer.GetStats().missed, 0);
+    EXPECT_EQ(pacer.GetStats().frames, 0);
+}
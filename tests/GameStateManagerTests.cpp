@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../src/GameStateManager.h"
+
+#include <string>
+#include <vector>
+
+TEST(GameStateManagerTest, InternedIdsAreStable)
+{
+    GameStateManager state;
+    EXPECT_EQ(state.Find("talked_to_elder"), GameStateManager::INVALID_FLAG);
+
+    const GameStateManager::FlagId elder = state.Intern("talked_to_elder");
+    EXPECT_EQ(state.Intern("talked_to_elder"), elder);
+    EXPECT_EQ(state.Find("talked_to_elder"), elder);
+    EXPECT_EQ(state.GetFlagName(elder), "talked_to_elder");
+    EXPECT_FALSE(state.HasFlag(elder));
+
+    state.SetFlag(elder);
+    state.Clear();
+    EXPECT_EQ(state.Find("talked_to_elder"), elder);
+    EXPECT_FALSE(state.HasFlag(elder));
+}
+
+TEST(GameStateManagerTest, TypedValuesReadAsText)
+{
+    GameStateManager state;
+    state.SetFlag("door_open");
+    state.SetFlagInt("wolves_killed", 12);
+    state.SetFlagValue("mood", "grumpy");
+    state.ClearFlag("lamp_lit");
+
+    EXPECT_EQ(state.GetFlagValue("door_open"), "true");
+    EXPECT_EQ(state.GetFlagValue("wolves_killed"), "12");
+    EXPECT_EQ(state.GetFlagValue("mood"), "grumpy");
+    EXPECT_EQ(state.GetFlagValue("missing"), "");
+    EXPECT_EQ(state.GetFlagInt("wolves_killed"), 12);
+
+    // Cleared flags still exist, like the string-only storage did
+    EXPECT_TRUE(state.HasFlag("lamp_lit"));
+    EXPECT_FALSE(state.GetFlag("lamp_lit"));
+
+    EXPECT_TRUE(state.FlagEquals(state.Find("wolves_killed"), "12"));
+    EXPECT_FALSE(state.FlagEquals(state.Find("wolves_killed"), "012"));
+    EXPECT_TRUE(state.FlagEquals(state.Find("door_open"), "true"));
+    EXPECT_TRUE(state.FlagEquals(GameStateManager::INVALID_FLAG, ""));
+
+    state.SetFlagValue("legacy", "1");
+    EXPECT_TRUE(state.GetFlag("legacy"));
+    EXPECT_EQ(state.GetFlagInt("legacy"), 1);
+}
+
+TEST(GameStateManagerTest, EvaluatesConditions)
+{
+    GameStateManager state;
+    state.SetFlagValue("mood", "grumpy");
+
+    using Type = DialogueCondition::Type;
+    EXPECT_TRUE(state.EvaluateCondition({Type::FLAG_SET, "mood"}));
+    EXPECT_FALSE(state.EvaluateCondition({Type::FLAG_NOT_SET, "mood"}));
+    EXPECT_TRUE(state.EvaluateCondition({Type::FLAG_EQUALS, "mood", "grumpy"}));
+    EXPECT_FALSE(state.EvaluateCondition({Type::FLAG_EQUALS, "mood", "happy"}));
+    EXPECT_TRUE(state.EvaluateCondition({Type::FLAG_NOT_SET, "never_seen"}));
+    // Checking a name does not intern it
+    EXPECT_EQ(state.Find("never_seen"), GameStateManager::INVALID_FLAG);
+}
+
+TEST(GameStateManagerTest, QuestIndexFollowsFlags)
+{
+    GameStateManager state;
+    const std::uint64_t start = state.GetVersion();
+
+    state.SetFlagValue("accepted_ufo_quest", "Find Anna's brother!");
+    state.SetFlag("accepted_wolf_quest");
+    state.SetFlag("accepted_nothing");  // Not a quest name
+    EXPECT_EQ(state.GetActiveQuests(), (std::vector<std::string>{"ufo_quest", "wolf_quest"}));
+    EXPECT_EQ(state.GetQuestDescription("ufo_quest"), "Find Anna's brother!");
+    EXPECT_EQ(state.GetQuestDescription("wolf_quest"), "");
+
+    state.SetFlag("completed_ufo_quest", true);
+    EXPECT_EQ(state.GetActiveQuests(), (std::vector<std::string>{"wolf_quest"}));
+
+    // Completion set before acceptance keeps the quest inactive
+    state.SetFlag("completed_bear_quest");
+    state.SetFlagValue("accepted_bear_quest", "Scare the bear");
+    EXPECT_EQ(state.GetActiveQuests(), (std::vector<std::string>{"wolf_quest"}));
+
+    state.SetFlagValue("accepted_wolf_quest", "false");
+    EXPECT_TRUE(state.GetActiveQuests().empty());
+    EXPECT_GT(state.GetVersion(), start);
+}
+
+TEST(GameStateManagerTest, VersionChangesOnlyWithValues)
+{
+    GameStateManager state;
+    state.SetFlag("door_open");
+    const std::uint64_t version = state.GetVersion();
+
+    state.SetFlag("door_open");
+    state.Intern("unused_name");
+    EXPECT_EQ(state.GetVersion(), version);
+
+    state.SetFlag("door_open", false);
+    EXPECT_EQ(state.GetVersion(), version + 1);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "../src/InputState.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+std::string TempLogPath(const char *name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+}  // namespace
+
+TEST(InputStateTest, AdvanceLatchesLiveState)
+{
+    InputState input;
+    input.OnKey(87, true);
+    input.OnMouseButton(1, true);
+    input.OnCursorPos(12.5, 40.0);
+    input.OnScroll(1.0);
+    EXPECT_FALSE(input.IsKeyDown(87));
+
+    ASSERT_TRUE(input.Advance());
+    EXPECT_TRUE(input.IsKeyDown(87));
+    EXPECT_TRUE(input.IsMouseButtonDown(1));
+    EXPECT_FALSE(input.IsMouseButtonDown(0));
+    double x = 0.0;
+    double y = 0.0;
+    input.GetCursorPos(x, y);
+    EXPECT_DOUBLE_EQ(x, 12.5);
+    EXPECT_DOUBLE_EQ(y, 40.0);
+    ASSERT_EQ(input.GetScrollEvents().size(), 1u);
+
+    // Scroll events belong to one step; held keys stay down
+    input.OnKey(-1, true);
+    input.OnKey(InputState::KEY_COUNT, true);
+    ASSERT_TRUE(input.Advance());
+    EXPECT_TRUE(input.IsKeyDown(87));
+    EXPECT_TRUE(input.GetScrollEvents().empty());
+}
+
+TEST(InputStateTest, EncodesOnlyChanges)
+{
+    InputState::Frame previous;
+    InputState::Frame frame;
+    std::vector<std::uint8_t> out;
+    InputState::EncodeFrame(previous, frame, out);
+    EXPECT_EQ(out.size(), 1u);
+
+    frame.keys.set(65);
+    frame.keys.set(340);
+    frame.cursorX = 3.0f;
+    frame.scroll = {-1.0f, 2.0f};
+    out.clear();
+    InputState::EncodeFrame(previous, frame, out);
+
+    InputState::Frame decoded;
+    const std::uint8_t *data = out.data();
+    ASSERT_TRUE(InputState::DecodeFrame(data, out.data() + out.size(), decoded));
+    EXPECT_EQ(data, out.data() + out.size());
+    EXPECT_EQ(decoded.keys, frame.keys);
+    EXPECT_EQ(decoded.cursorX, 3.0f);
+    EXPECT_EQ(decoded.scroll, frame.scroll);
+
+    // Truncated record
+    data = out.data();
+    EXPECT_FALSE(InputState::DecodeFrame(data, out.data() + out.size() - 1, decoded));
+}
+
+TEST(InputStateTest, ReplayReproducesRecording)
+{
+    const std::string path = TempLogPath("wild_input_roundtrip.winp");
+    InputState::LogHeader header;
+    header.seed = 1234;
+    header.step = 1.0f / 120.0f;
+    header.timeOfDay = 18.5f;
+    header.windowWidth = 1280;
+    header.windowHeight = 720;
+
+    std::vector<InputState::Frame> recorded;
+    {
+        InputState input;
+        ASSERT_TRUE(input.StartRecording(path, header));
+        for (int step = 0; step < 300; ++step)
+        {
+            if (step % 7 == 0)
+                input.OnKey(32 + step % 50, (step / 7) % 2 == 0);
+            if (step % 11 == 0)
+                input.OnMouseButton(0, (step / 11) % 2 == 0);
+            input.OnCursorPos(step * 0.3, 500.0 - step);
+            if (step % 13 == 0)
+                input.OnScroll(step % 2 ? 1.0 : -1.0);
+            ASSERT_TRUE(input.Advance());
+            recorded.push_back(input.GetFrame());
+        }
+        ASSERT_TRUE(input.StopRecording());
+    }
+
+    InputState replay;
+    ASSERT_TRUE(replay.StartReplay(path));
+    EXPECT_EQ(replay.GetLogHeader().seed, 1234u);
+    EXPECT_FLOAT_EQ(replay.GetLogHeader().step, 1.0f / 120.0f);
+    EXPECT_EQ(replay.GetLogHeader().windowHeight, 720);
+    ASSERT_EQ(replay.GetReplayStepCount(), recorded.size());
+
+    for (const InputState::Frame &expected : recorded)
+    {
+        // Live events don't leak into a replay
+        replay.OnKey(90, true);
+        ASSERT_TRUE(replay.Advance());
+        const InputState::Frame &frame = replay.GetFrame();
+        EXPECT_EQ(frame.keys, expected.keys);
+        EXPECT_EQ(frame.mouseButtons, expected.mouseButtons);
+        EXPECT_EQ(frame.cursorX, expected.cursorX);
+        EXPECT_EQ(frame.cursorY, expected.cursorY);
+        EXPECT_EQ(frame.scroll, expected.scroll);
+    }
+    EXPECT_FALSE(replay.Advance());
+    EXPECT_EQ(replay.GetStepIndex(), recorded.size());
+
+    std::remove(path.c_str());
+}
+
+TEST(InputStateTest, RejectsCorruptLogs)
+{
+    const std::string path = TempLogPath("wild_input_corrupt.winp");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a log";
+    }
+    InputState input;
+    EXPECT_FALSE(input.StartReplay(path));
+
+    // Valid header, then a record naming a key past GLFW_KEY_LAST
+    std::vector<std::uint8_t> data;
+    InputState::EncodeHeader(InputState::LogHeader{}, data);
+    data.insert(data.end(), {0x01, 0x01, 0x00, 0xFF, 0xFF});
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+    EXPECT_FALSE(input.StartReplay(path));
+    EXPECT_FALSE(input.IsReplaying());
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "../src/JobSystem.h"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST(JobSystemTest, EveryItemRunsExactlyOnce)
+{
+    JobSystem jobs(3);
+    std::vector<int> hits(10007, 0);
+    jobs.ParallelFor(hits.size(), 64, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            ++hits[i];
+    });
+    for (size_t i = 0; i < hits.size(); ++i)
+        ASSERT_EQ(hits[i], 1) << "item " << i;
+}
+
+TEST(JobSystemTest, ChunksRespectGrainSize)
+{
+    JobSystem jobs(2);
+    std::atomic<size_t> chunks{0};
+    std::atomic<bool> oversized{false};
+    jobs.ParallelFor(1000, 100, [&](size_t begin, size_t end)
+    {
+        if (end - begin > 100)
+            oversized = true;
+        ++chunks;
+    });
+    EXPECT_FALSE(oversized);
+    EXPECT_EQ(chunks.load(), 10u);
+}
+
+TEST(JobSystemTest, SmallLoopRunsInlineOnCaller)
+{
+    JobSystem jobs(4);
+    const std::thread::id caller = std::this_thread::get_id();
+    std::thread::id ran;
+    jobs.ParallelFor(10, 64, [&](size_t begin, size_t end)
+    {
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 10u);
+        ran = std::this_thread::get_id();
+    });
+    EXPECT_EQ(ran, caller);
+}
+
+TEST(JobSystemTest, NoWorkersStillCompletes)
+{
+    JobSystem jobs(0);
+    EXPECT_EQ(jobs.GetWorkerCount(), 0u);
+    std::vector<int> values(500);
+    jobs.ParallelFor(values.size(), 7, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+            values[i] = static_cast<int>(i);
+    });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 499 * 500 / 2);
+}
+
+TEST(JobSystemTest, RepeatedJobsReuseWorkers)
+{
+    JobSystem jobs(3);
+    std::atomic<long> total{0};
+    for (int frame = 0; frame < 200; ++frame)
+    {
+        jobs.ParallelFor(256, 16, [&](size_t begin, size_t end)
+        {
+            total += static_cast<long>(end - begin);
+        });
+    }
+    EXPECT_EQ(total.load(), 200 * 256);
+}
+
+TEST(JobSystemTest, EmptyRangeDoesNothing)
+{
+    JobSystem jobs(2);
+    bool called = false;
+    jobs.ParallelFor(0, 16, [&](size_t, size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../src/MemoryTracker.h"
+#include "../src/Texture.h"
+
+#include <vector>
+
+namespace
+{
+using Subsystem = MemoryTracker::Subsystem;
+
+MemoryTracker::Usage At(const MemoryTracker::Report &report, Subsystem subsystem)
+{
+    return report[static_cast<std::size_t>(subsystem)];
+}
+
+/// Reported bytes start at zero in every test and are cleared afterwards
+class MemoryTrackerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { Clear(); }
+    void TearDown() override { Clear(); }
+
+    static void Clear()
+    {
+        for (std::size_t i = 0; i < MemoryTracker::SUBSYSTEM_COUNT; ++i)
+        {
+            MemoryTracker::SetCpuBytes(static_cast<Subsystem>(i), 0);
+        }
+    }
+};
+}  // namespace
+
+TEST_F(MemoryTrackerTest, CollectReportsCpuBytesPerSubsystem)
+{
+    // Without a renderer no texture is uploaded, so only reported bytes count
+    ASSERT_TRUE(Texture::GetUploadedTextures().empty());
+
+    MemoryTracker::SetCpuBytes(Subsystem::Tilemap, 1000);
+    MemoryTracker::SetCpuBytes(Subsystem::Particles, 300);
+    MemoryTracker::SetCpuBytes(Subsystem::Editor, 24);
+    const MemoryTracker::Report report = MemoryTracker::Collect();
+
+    EXPECT_EQ(At(report, Subsystem::Tilemap).cpuBytes, 1000u);
+    EXPECT_EQ(At(report, Subsystem::Particles).cpuBytes, 300u);
+    EXPECT_EQ(At(report, Subsystem::Editor).cpuBytes, 24u);
+    EXPECT_EQ(At(report, Subsystem::Sky).cpuBytes, 0u);
+    EXPECT_EQ(At(report, Subsystem::Characters).gpuBytes, 0u);
+}
+
+TEST_F(MemoryTrackerTest, SetCpuBytesReplacesEarlierValue)
+{
+    MemoryTracker::SetCpuBytes(Subsystem::Sky, 500);
+    MemoryTracker::SetCpuBytes(Subsystem::Sky, 64);
+    EXPECT_EQ(At(MemoryTracker::Collect(), Subsystem::Sky).cpuBytes, 64u);
+}
+
+TEST_F(MemoryTrackerTest, TotalSumsEverySubsystem)
+{
+    MemoryTracker::Report report{};
+    report[static_cast<std::size_t>(Subsystem::Tilemap)] = {100, 0};
+    report[static_cast<std::size_t>(Subsystem::Tileset)] = {10, 40};
+    report[static_cast<std::size_t>(Subsystem::Other)] = {1, 2};
+
+    const MemoryTracker::Usage total = MemoryTracker::GetTotal(report);
+    EXPECT_EQ(total.cpuBytes, 111u);
+    EXPECT_EQ(total.gpuBytes, 42u);
+}
+
+TEST_F(MemoryTrackerTest, CapacityBytesCountsReservedElements)
+{
+    std::vector<int> ints;
+    ints.reserve(10);
+    std::vector<double> doubles(3);
+    EXPECT_EQ(MemoryTracker::CapacityBytes(ints, doubles),
+              ints.capacity() * sizeof(int) + doubles.capacity() * sizeof(double));
+}
+
+TEST_F(MemoryTrackerTest, NamesEachSubsystem)
+{
+    EXPECT_STREQ(MemoryTracker::GetName(Subsystem::Tilemap), "Tilemap");
+    EXPECT_STREQ(MemoryTracker::GetName(Subsystem::Characters), "Characters");
+    EXPECT_STREQ(MemoryTracker::GetName(Subsystem::Other), "Other");
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../src/ParticleKernels.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+struct KernelData
+{
+    std::vector<float> lifetime, positionX, positionY, velocityX, velocityY, size;
+
+    explicit KernelData(size_t count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-200.0f, 1200.0f);
+        std::uniform_real_distribution<float> velocity(-80.0f, 80.0f);
+        std::uniform_real_distribution<float> unit(0.0f, 8.0f);
+        for (size_t i = 0; i < count; ++i)
+        {
+            lifetime.push_back(unit(rng));
+            positionX.push_back(position(rng));
+            positionY.push_back(position(rng));
+            velocityX.push_back(velocity(rng));
+            velocityY.push_back(velocity(rng));
+            size.push_back(unit(rng));
+        }
+    }
+};
+
+// Restores the automatic choice so other tests see the default
+struct IsaGuard
+{
+    ~IsaGuard() { ParticleKernels::SetIsa(ParticleKernels::GetBestIsa()); }
+};
+
+const ParticleKernels::Isa kAllIsas[] = {ParticleKernels::Isa::Scalar, ParticleKernels::Isa::SSE2,
+                                         ParticleKernels::Isa::AVX2, ParticleKernels::Isa::NEON};
+}  // namespace
+
+TEST(ParticleKernelsTest, UnsupportedIsaFallsBackToScalar)
+{
+    IsaGuard guard;
+    EXPECT_TRUE(ParticleKernels::IsSupported(ParticleKernels::Isa::Scalar));
+    EXPECT_TRUE(ParticleKernels::IsSupported(ParticleKernels::GetBestIsa()));
+    for (ParticleKernels::Isa isa : kAllIsas)
+    {
+        ParticleKernels::SetIsa(isa);
+        ParticleKernels::Isa expected = ParticleKernels::IsSupported(isa) ? isa : ParticleKernels::Isa::Scalar;
+        EXPECT_EQ(ParticleKernels::GetIsa(), expected);
+    }
+}
+
+TEST(ParticleKernelsTest, IntegrateMatchesScalarExactly)
+{
+    IsaGuard guard;
+    // Sizes cover empty input, partial vectors, and a scalar tail after full ones
+    for (size_t count = 0; count < 38; ++count)
+    {
+        KernelData reference(count, 7);
+        ParticleKernels::SetIsa(ParticleKernels::Isa::Scalar);
+        ParticleKernels::Integrate(reference.lifetime.data(), reference.positionX.data(),
+                                   reference.positionY.data(), reference.velocityX.data(),
+                                   reference.velocityY.data(), count, 0.016f);
+
+        for (ParticleKernels::Isa isa : kAllIsas)
+        {
+            if (!ParticleKernels::IsSupported(isa))
+                continue;
+            KernelData data(count, 7);
+            ParticleKernels::SetIsa(isa);
+            ParticleKernels::Integrate(data.lifetime.data(), data.positionX.data(), data.positionY.data(),
+                                       data.velocityX.data(), data.velocityY.data(), count, 0.016f);
+            EXPECT_EQ(data.lifetime, reference.lifetime) << ParticleKernels::GetIsaName(isa);
+            EXPECT_EQ(data.positionX, reference.positionX) << ParticleKernels::GetIsaName(isa);
+            EXPECT_EQ(data.positionY, reference.positionY) << ParticleKernels::GetIsaName(isa);
+        }
+    }
+}
+
+TEST(ParticleKernelsTest, CullMatchesScalarExactly)
+{
+    IsaGuard guard;
+    const glm::vec2 viewMin(0.0f, 0.0f);
+    const glm::vec2 viewMax(960.0f, 540.0f);
+    for (size_t count = 0; count < 38; ++count)
+    {
+        KernelData data(count, 11);
+        std::vector<uint8_t> reference(count, 2);
+        ParticleKernels::SetIsa(ParticleKernels::Isa::Scalar);
+        ParticleKernels::Cull(data.positionX.data(), data.positionY.data(), data.size.data(), count, viewMin,
+                              viewMax, 2.0f, 50.0f, reference.data());
+
+        for (ParticleKernels::Isa isa : kAllIsas)
+        {
+            if (!ParticleKernels::IsSupported(isa))
+                continue;
+            std::vector<uint8_t> visible(count, 2);
+            ParticleKernels::SetIsa(isa);
+            ParticleKernels::Cull(data.positionX.data(), data.positionY.data(), data.size.data(), count,
+                                  viewMin, viewMax, 2.0f, 50.0f, visible.data());
+            EXPECT_EQ(visible, reference) << ParticleKernels::GetIsaName(isa);
+        }
+    }
+}
+
+TEST(ParticleKernelsTest, CullPaddingIsInclusive)
+{
+    IsaGuard guard;
+    // Eight particles so the widest path handles them without a tail
+    const float x[8] = {-14.0f, -14.5f, 110.0f, 110.5f, 50.0f, 50.0f, 50.0f, 50.0f};
+    const float y[8] = {50.0f, 50.0f, 50.0f, 50.0f, -14.0f, -14.5f, 110.0f, 110.5f};
+    const float size[8] = {2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f};
+    const uint8_t expected[8] = {1, 0, 1, 0, 1, 0, 1, 0};
+
+    for (ParticleKernels::Isa isa : kAllIsas)
+    {
+        if (!ParticleKernels::IsSupported(isa))
+            continue;
+        ParticleKernels::SetIsa(isa);
+        uint8_t visible[8] = {};
+        // Padding per side: 2 * 2 + 10 = 14
+        ParticleKernels::Cull(x, y, size, 8, glm::vec2(0.0f), glm::vec2(96.0f), 2.0f, 10.0f, visible);
+        for (int i = 0; i < 8; ++i)
+        {
+            EXPECT_EQ(visible[i], expected[i]) << ParticleKernels::GetIsaName(isa) << " particle " << i;
+        }
+    }
+}
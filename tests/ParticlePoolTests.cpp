@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "../src/MemoryTracker.h"
+#include "../src/ParticlePool.h"
+
+namespace
+{
+Particle MakeParticle(int zoneIndex, float x)
+{
+    Particle p{};
+    p.position = glm::vec2(x, 0.0f);
+    p.lifetime = 1.0f;
+    p.maxLifetime = 1.0f;
+    p.zoneIndex = zoneIndex;
+    p.type = ParticleType::Rain;
+    return p;
+}
+}  // namespace
+
+TEST(ParticlePoolTest, AddStopsAtCapacity)
+{
+    ParticlePool pool(2);
+    EXPECT_TRUE(pool.Add(MakeParticle(0, 1.0f)));
+    EXPECT_TRUE(pool.Add(MakeParticle(0, 2.0f)));
+    EXPECT_TRUE(pool.IsFull());
+    EXPECT_FALSE(pool.Add(MakeParticle(0, 3.0f)));
+    EXPECT_EQ(pool.Size(), 2u);
+    EXPECT_EQ(pool.GetZoneCount(0), 2u);
+}
+
+TEST(ParticlePoolTest, RemoveSwapsLastIntoHole)
+{
+    ParticlePool pool(8);
+    pool.Add(MakeParticle(0, 1.0f));
+    pool.Add(MakeParticle(1, 2.0f));
+    pool.Add(MakeParticle(2, 3.0f));
+
+    pool.Remove(0);
+    ASSERT_EQ(pool.Size(), 2u);
+    EXPECT_FLOAT_EQ(pool.m_PositionX[0], 3.0f);
+    EXPECT_EQ(pool.m_ZoneIndex[0], 2);
+    EXPECT_FLOAT_EQ(pool.m_PositionX[1], 2.0f);
+    EXPECT_EQ(pool.GetZoneCount(0), 0u);
+    EXPECT_EQ(pool.GetZoneCount(2), 1u);
+
+    // Removing the last entry just shrinks the pool
+    pool.Remove(1);
+    ASSERT_EQ(pool.Size(), 1u);
+    EXPECT_FLOAT_EQ(pool.Get(0).position.x, 3.0f);
+}
+
+TEST(ParticlePoolTest, RemoveZoneRenumbersHigherZones)
+{
+    ParticlePool pool(8);
+    pool.Add(MakeParticle(0, 1.0f));
+    pool.Add(MakeParticle(1, 2.0f));
+    pool.Add(MakeParticle(2, 3.0f));
+    pool.Add(MakeParticle(1, 4.0f));
+    pool.Add(MakeParticle(2, 5.0f));
+
+    pool.RemoveZone(1);
+    ASSERT_EQ(pool.Size(), 3u);
+    for (size_t i = 0; i < pool.Size(); ++i)
+    {
+        // Old zone 2 particles (x = 3, 5) now belong to zone 1
+        EXPECT_EQ(pool.m_ZoneIndex[i], pool.m_PositionX[i] == 1.0f ? 0 : 1);
+    }
+    EXPECT_EQ(pool.GetZoneCount(0), 1u);
+    EXPECT_EQ(pool.GetZoneCount(1), 2u);
+    EXPECT_EQ(pool.GetZoneCount(2), 0u);
+}
+
+TEST(ParticlePoolTest, ShrinkingCapacityKeepsCountsExact)
+{
+    ParticlePool pool(4);
+    for (int i = 0; i < 4; ++i)
+        pool.Add(MakeParticle(i % 2, static_cast<float>(i)));
+
+    pool.SetCapacity(1);
+    EXPECT_EQ(pool.Size(), 1u);
+    EXPECT_EQ(pool.GetZoneCount(0) + pool.GetZoneCount(1), 1u);
+
+    pool.Clear();
+    EXPECT_TRUE(pool.Empty());
+    EXPECT_EQ(pool.GetZoneCount(0), 0u);
+}
+
+TEST(ParticlePoolTest, MemoryBytesFollowCapacity)
+{
+    ParticlePool pool(100);
+    const std::size_t small = pool.GetMemoryBytes();
+    EXPECT_GE(small, 100 * (sizeof(float) * 9 + sizeof(glm::vec4)));
+
+    pool.SetCapacity(1000);
+    EXPECT_GT(pool.GetMemoryBytes(), small * 9);
+    EXPECT_EQ(MemoryTracker::CapacityBytes(pool.m_PositionX, pool.m_Color),
+              pool.m_PositionX.capacity() * sizeof(float) + pool.m_Color.capacity() * sizeof(glm::vec4));
+}
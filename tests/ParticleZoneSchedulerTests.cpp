@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/ParticleZoneScheduler.h"
+
+using State = ParticleZoneScheduler::State;
+
+namespace
+{
+ParticleZoneScheduler::Zone MakeZone(float x, float y, float w, float h, float priority = 1.0f)
+{
+    ParticleZoneScheduler::Zone zone;
+    zone.position = glm::vec2(x, y);
+    zone.size = glm::vec2(w, h);
+    zone.priority = priority;
+    return zone;
+}
+}  // namespace
+
+class ParticleZoneSchedulerTest : public ::testing::Test
+{
+protected:
+    ParticleZoneScheduler scheduler;
+
+    void SetUp() override
+    {
+        scheduler.SetCellSize(128.0f);
+        scheduler.SetActiveMargin(32.0f);
+        scheduler.SetDecimatedDistance(100.0f);
+        scheduler.SetDecimatedRate(0.5f);
+    }
+
+    void View(float x, float y, std::size_t budget = 1000, std::size_t cap = 1000)
+    {
+        scheduler.Schedule({x, y}, {x + 320.0f, y + 240.0f}, budget, cap);
+    }
+};
+
+TEST_F(ParticleZoneSchedulerTest, ClassifiesByDistanceToView)
+{
+    scheduler.SetZones({
+        MakeZone(100.0f, 100.0f, 32.0f, 32.0f),    // Inside
+        MakeZone(-60.0f, 100.0f, 32.0f, 32.0f),    // Ends in the margin
+        MakeZone(-150.0f, 100.0f, 32.0f, 32.0f),   // Decimated band
+        MakeZone(2000.0f, 2000.0f, 32.0f, 32.0f),  // Far away
+    });
+    View(0.0f, 0.0f);
+
+    EXPECT_EQ(scheduler.GetPlan(0).state, State::Active);
+    EXPECT_EQ(scheduler.GetPlan(1).state, State::Active);
+    EXPECT_EQ(scheduler.GetPlan(2).state, State::Decimated);
+    EXPECT_EQ(scheduler.GetPlan(3).state, State::Paused);
+    EXPECT_EQ(scheduler.GetScheduledZones(), (std::vector<std::uint32_t>{0, 1, 2}));
+    EXPECT_FLOAT_EQ(scheduler.GetSpawnScale(State::Decimated), 0.5f);
+}
+
+TEST_F(ParticleZoneSchedulerTest, DisabledZonesArePaused)
+{
+    auto zone = MakeZone(100.0f, 100.0f, 32.0f, 32.0f);
+    zone.enabled = false;
+    scheduler.SetZones({zone});
+    View(0.0f, 0.0f);
+    EXPECT_EQ(scheduler.GetPlan(0).state, State::Paused);
+    EXPECT_TRUE(scheduler.GetScheduledZones().empty());
+}
+
+TEST_F(ParticleZoneSchedulerTest, LargeZonesAreFoundWithoutBucketing)
+{
+    // 20000 px square covers far more than MAX_ZONE_CELLS cells
+    scheduler.SetZones({MakeZone(-10000.0f, -10000.0f, 20000.0f, 20000.0f), MakeZone(5000.0f, 5000.0f, 16.0f, 16.0f)});
+    View(0.0f, 0.0f);
+    EXPECT_EQ(scheduler.GetPlan(0).state, State::Active);
+    EXPECT_EQ(scheduler.GetPlan(1).state, State::Paused);
+}
+
+TEST_F(ParticleZoneSchedulerTest, ResumedOnlyOnTheFrameAZoneWakesUp)
+{
+    scheduler.SetZones({MakeZone(100.0f, 100.0f, 32.0f, 32.0f)});
+    View(0.0f, 0.0f);
+    EXPECT_TRUE(scheduler.GetPlan(0).resumed);
+    View(0.0f, 0.0f);
+    EXPECT_FALSE(scheduler.GetPlan(0).resumed);
+
+    View(5000.0f, 0.0f);
+    EXPECT_EQ(scheduler.GetPlan(0).state, State::Paused);
+    EXPECT_EQ(scheduler.GetPlan(0).budget, 0u);
+
+    View(0.0f, 0.0f);
+    EXPECT_TRUE(scheduler.GetPlan(0).resumed);
+}
+
+TEST_F(ParticleZoneSchedulerTest, RebuildKeepsPlansOfExistingZones)
+{
+    scheduler.SetZones({MakeZone(100.0f, 100.0f, 32.0f, 32.0f)});
+    View(0.0f, 0.0f);
+    scheduler.SetZones({MakeZone(100.0f, 100.0f, 32.0f, 32.0f), MakeZone(150.0f, 100.0f, 32.0f, 32.0f)});
+    View(0.0f, 0.0f);
+    EXPECT_FALSE(scheduler.GetPlan(0).resumed);
+    EXPECT_TRUE(scheduler.GetPlan(1).resumed);
+}
+
+TEST_F(ParticleZoneSchedulerTest, BudgetSplitByVisibleAreaAndPriority)
+{
+    scheduler.SetZones({
+        MakeZone(0.0f, 0.0f, 100.0f, 100.0f),
+        MakeZone(100.0f, 0.0f, 100.0f, 100.0f, 3.0f),
+    });
+    View(0.0f, 0.0f, 400);
+    EXPECT_EQ(scheduler.GetPlan(0).budget, 100u);
+    EXPECT_EQ(scheduler.GetPlan(1).budget, 300u);
+}
+
+TEST_F(ParticleZoneSchedulerTest, CappedZonesPassTheirShareOn)
+{
+    scheduler.SetZones({
+        MakeZone(0.0f, 0.0f, 200.0f, 200.0f),
+        MakeZone(200.0f, 0.0f, 20.0f, 20.0f),
+        MakeZone(200.0f, 100.0f, 20.0f, 20.0f),
+    });
+    View(0.0f, 0.0f, 300, 100);
+    EXPECT_EQ(scheduler.GetPlan(0).budget, 100u);
+    EXPECT_EQ(scheduler.GetPlan(1).budget, 100u);
+    EXPECT_EQ(scheduler.GetPlan(2).budget, 100u);
+
+    View(0.0f, 0.0f, 120, 100);
+    EXPECT_EQ(scheduler.GetPlan(0).budget, 100u);
+    EXPECT_EQ(scheduler.GetPlan(1).budget + scheduler.GetPlan(2).budget, 20u);
+}
+
+TEST_F(ParticleZoneSchedulerTest, DecimatedZonesGetAReducedCap)
+{
+    scheduler.SetZones({MakeZone(-150.0f, 100.0f, 32.0f, 32.0f)});
+    View(0.0f, 0.0f, 1000, 40);
+    EXPECT_EQ(scheduler.GetPlan(0).state, State::Decimated);
+    EXPECT_EQ(scheduler.GetPlan(0).budget, 20u);
+}
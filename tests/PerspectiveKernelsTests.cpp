@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "../src/PerspectiveKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+constexpr double VIEW_WIDTH = 480.0;
+constexpr double VIEW_HEIGHT = 270.0;
+constexpr int TILE_SIZE = 16;
+
+enum class Mode
+{
+    Vanishing,
+    Globe,
+    Fisheye
+};
+
+const Mode kAllModes[] = {Mode::Vanishing, Mode::Globe, Mode::Fisheye};
+
+const PerspectiveKernels::Isa kAllIsas[] = {PerspectiveKernels::Isa::Scalar, PerspectiveKernels::Isa::SSE2,
+                                            PerspectiveKernels::Isa::AVX2, PerspectiveKernels::Isa::NEON};
+
+// Same ranges the game feeds in: horizon above the view, radius a few screens wide
+perspectiveTransform::Params MakeParams(Mode mode)
+{
+    perspectiveTransform::Params params{};
+    params.applyGlobe = mode != Mode::Vanishing;
+    params.applyVanishing = mode != Mode::Globe;
+    params.centerX = VIEW_WIDTH * 0.5;
+    params.centerY = VIEW_HEIGHT * 0.5;
+    params.horizonY = -VIEW_HEIGHT * 0.5;
+    params.screenHeight = VIEW_HEIGHT;
+    params.horizonScale = 0.6;
+    params.sphereRadius = 400.0;
+    return params;
+}
+
+// Restores the automatic choice so other tests see the default
+struct IsaGuard
+{
+    ~IsaGuard() { PerspectiveKernels::SetIsa(ParticleKernels::GetBestIsa()); }
+};
+
+/// Tile grid corners over the expanded 3D viewport, plus the screen center
+void MakeGrid(std::vector<float> &x, std::vector<float> &y)
+{
+    x.clear();
+    y.clear();
+    for (int row = -8; row <= 26; ++row)
+    {
+        for (int column = -15; column <= 45; ++column)
+        {
+            // Odd offsets keep points off the tile lattice
+            x.push_back(static_cast<float>(column * TILE_SIZE) + 0.37f);
+            y.push_back(static_cast<float>(row * TILE_SIZE) - 0.21f);
+        }
+    }
+    x.push_back(static_cast<float>(VIEW_WIDTH * 0.5));
+    y.push_back(static_cast<float>(VIEW_HEIGHT * 0.5));
+}
+
+/// Tile index + 1 at each pixel center covered by a projected tile, 0 elsewhere
+using Projector = void (*)(glm::vec2 corners[4], const perspectiveTransform::Params &p);
+
+std::vector<std::uint16_t> RasterizeTiles(Projector project, const perspectiveTransform::Params &params)
+{
+    const int width = static_cast<int>(VIEW_WIDTH);
+    const int height = static_cast<int>(VIEW_HEIGHT);
+    std::vector<std::uint16_t> image(static_cast<size_t>(width) * height, 0);
+    const int columns = width / TILE_SIZE;
+    const int rows = height / TILE_SIZE + 1;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            const float x0 = static_cast<float>(column * TILE_SIZE);
+            const float y0 = static_cast<float>(row * TILE_SIZE);
+            glm::vec2 corners[4] = {glm::vec2(x0, y0), glm::vec2(x0 + TILE_SIZE, y0),
+                                    glm::vec2(x0 + TILE_SIZE, y0 + TILE_SIZE), glm::vec2(x0, y0 + TILE_SIZE)};
+            project(corners, params);
+
+            float minX = corners[0].x, maxX = corners[0].x, minY = corners[0].y, maxY = corners[0].y;
+            for (const glm::vec2 &corner : corners)
+            {
+                minX = std::min(minX, corner.x);
+                maxX = std::max(maxX, corner.x);
+                minY = std::min(minY, corner.y);
+                maxY = std::max(maxY, corner.y);
+            }
+            const int px0 = std::max(0, static_cast<int>(std::floor(minX)));
+            const int px1 = std::min(width - 1, static_cast<int>(std::ceil(maxX)));
+            const int py0 = std::max(0, static_cast<int>(std::floor(minY)));
+            const int py1 = std::min(height - 1, static_cast<int>(std::ceil(maxY)));
+            for (int py = py0; py <= py1; ++py)
+            {
+                for (int px = px0; px <= px1; ++px)
+                {
+                    // Inside the convex quad when on the same side of all four edges
+                    const float sx = static_cast<float>(px) + 0.5f;
+                    const float sy = static_cast<float>(py) + 0.5f;
+                    bool inside = true;
+                    for (int e = 0; e < 4 && inside; ++e)
+                    {
+                        const glm::vec2 a = corners[e];
+                        const glm::vec2 b = corners[(e + 1) % 4];
+                        inside = (b.x - a.x) * (sy - a.y) - (b.y - a.y) * (sx - a.x) >= 0.0f;
+                    }
+                    if (inside)
+                        image[static_cast<size_t>(py) * width + px] =
+                            static_cast<std::uint16_t>(row * columns + column + 1);
+                }
+            }
+        }
+    }
+    return image;
+}
+}  // namespace
+
+TEST(PerspectiveKernelsTest, UnsupportedIsaFallsBackToScalar)
+{
+    IsaGuard guard;
+    for (PerspectiveKernels::Isa isa : kAllIsas)
+    {
+        PerspectiveKernels::SetIsa(isa);
+        const PerspectiveKernels::Isa expected =
+            ParticleKernels::IsSupported(isa) ? isa : PerspectiveKernels::Isa::Scalar;
+        EXPECT_EQ(PerspectiveKernels::GetIsa(), expected);
+    }
+}
+
+TEST(PerspectiveKernelsTest, MatchesDoublePrecisionPathWithinTolerance)
+{
+    IsaGuard guard;
+    std::vector<float> sourceX, sourceY;
+    MakeGrid(sourceX, sourceY);
+
+    for (Mode mode : kAllModes)
+    {
+        const perspectiveTransform::Params params = MakeParams(mode);
+        for (PerspectiveKernels::Isa isa : kAllIsas)
+        {
+            if (!ParticleKernels::IsSupported(isa))
+                continue;
+            PerspectiveKernels::SetIsa(isa);
+            std::vector<float> x = sourceX, y = sourceY;
+            PerspectiveKernels::TransformPoints(x.data(), y.data(), x.size(), params);
+
+            double worst = 0.0;
+            for (size_t i = 0; i < x.size(); ++i)
+            {
+                double refX = sourceX[i], refY = sourceY[i];
+                perspectiveTransform::TransformPoint(refX, refY, params);
+                worst = std::max({worst, std::abs(x[i] - refX), std::abs(y[i] - refY)});
+            }
+            EXPECT_LT(worst, PerspectiveKernels::TOLERANCE)
+                << ParticleKernels::GetIsaName(isa) << " mode " << static_cast<int>(mode);
+        }
+    }
+}
+
+TEST(PerspectiveKernelsTest, VectorPathsMatchScalarOnEveryTailLength)
+{
+    IsaGuard guard;
+    std::vector<float> sourceX, sourceY;
+    MakeGrid(sourceX, sourceY);
+    const perspectiveTransform::Params params = MakeParams(Mode::Fisheye);
+
+    // Sizes cover empty input, partial vectors, and a scalar tail after full ones
+    for (size_t count = 0; count < 38; ++count)
+    {
+        std::vector<float> refX(sourceX.begin(), sourceX.begin() + count);
+        std::vector<float> refY(sourceY.begin(), sourceY.begin() + count);
+        PerspectiveKernels::SetIsa(PerspectiveKernels::Isa::Scalar);
+        PerspectiveKernels::TransformPoints(refX.data(), refY.data(), count, params);
+
+        for (PerspectiveKernels::Isa isa : kAllIsas)
+        {
+            if (!ParticleKernels::IsSupported(isa))
+                continue;
+            std::vector<float> x(sourceX.begin(), sourceX.begin() + count);
+            std::vector<float> y(sourceY.begin(), sourceY.begin() + count);
+            PerspectiveKernels::SetIsa(isa);
+            PerspectiveKernels::TransformPoints(x.data(), y.data(), count, params);
+            for (size_t i = 0; i < count; ++i)
+            {
+                EXPECT_NEAR(x[i], refX[i], 1e-4f) << ParticleKernels::GetIsaName(isa) << " point " << i;
+                EXPECT_NEAR(y[i], refY[i], 1e-4f) << ParticleKernels::GetIsaName(isa) << " point " << i;
+            }
+        }
+    }
+}
+
+TEST(PerspectiveKernelsTest, CenterAndDisabledStepsAreLeftAlone)
+{
+    IsaGuard guard;
+    perspectiveTransform::Params params = MakeParams(Mode::Globe);
+    float x[5] = {240.0f, 240.0005f, 10.0f, 10.0f, 10.0f};
+    float y[5] = {135.0f, 135.0f, 20.0f, 20.0f, 20.0f};
+    PerspectiveKernels::TransformPoints(x, y, 5, params);
+    EXPECT_EQ(x[0], 240.0f);
+    EXPECT_EQ(y[0], 135.0f);
+    EXPECT_EQ(x[1], 240.0005f);
+
+    // A horizon at the bottom edge turns vanishing off, like TransformPoint()
+    params = MakeParams(Mode::Vanishing);
+    params.horizonY = params.screenHeight;
+    float vx[1] = {10.0f}, vy[1] = {20.0f};
+    PerspectiveKernels::TransformPoints(vx, vy, 1, params);
+    EXPECT_EQ(vx[0], 10.0f);
+    EXPECT_EQ(vy[0], 20.0f);
+}
+
+TEST(PerspectiveKernelsTest, WarpedTileGridMatchesDoublePrecisionImage)
+{
+    IsaGuard guard;
+    for (Mode mode : kAllModes)
+    {
+        const perspectiveTransform::Params params = MakeParams(mode);
+        // The golden image is rendered through the double-precision path
+        const std::vector<std::uint16_t> golden = RasterizeTiles(perspectiveTransform::TransformCorners, params);
+        ASSERT_GT(std::count_if(golden.begin(), golden.end(), [](std::uint16_t v) { return v != 0; }), 0);
+
+        for (PerspectiveKernels::Isa isa : kAllIsas)
+        {
+            if (!ParticleKernels::IsSupported(isa))
+                continue;
+            PerspectiveKernels::SetIsa(isa);
+            const std::vector<std::uint16_t> image = RasterizeTiles(PerspectiveKernels::TransformCorners, params);
+
+            // Only pixel centers lying within TOLERANCE of a tile edge may change owner
+            size_t differing = 0;
+            for (size_t i = 0; i < image.size(); ++i)
+                differing += image[i] != golden[i];
+            EXPECT_LE(differing, image.size() / 10000)
+                << ParticleKernels::GetIsaName(isa) << " mode " << static_cast<int>(mode);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "../src/Profiler.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+size_t CountOccurrences(const std::string &text, const std::string &needle)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1))
+        ++count;
+    return count;
+}
+}
+
+TEST(ProfilerTest, ZonesOutsideACaptureAreNotRecorded)
+{
+    Profiler::BeginCapture();
+    Profiler::EndCapture();
+    {
+        Profiler::Scope zone("Idle");
+    }
+    EXPECT_EQ(Profiler::GetEventCount(), 0u);
+}
+
+TEST(ProfilerTest, NestedZonesExportAsCompleteEvents)
+{
+    Profiler::BeginCapture();
+    {
+        Profiler::Scope outer("Outer");
+        {
+            Profiler::Scope inner("Inner \"quoted\"");
+        }
+    }
+    Profiler::EndCapture();
+    EXPECT_EQ(Profiler::GetEventCount(), 2u);
+
+    std::ostringstream out;
+    Profiler::WriteChromeTrace(out);
+    const std::string json = out.str();
+    EXPECT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 2u);
+    EXPECT_NE(json.find("\"name\":\"Outer\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Inner \\\"quoted\\\"\""), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+}
+
+TEST(ProfilerTest, ThreadsRecordIntoSeparateNamedTracks)
+{
+    Profiler::BeginCapture();
+    std::thread worker([]
+    {
+        Profiler::SetThreadName("Test Worker");
+        for (int i = 0; i < 100; ++i)
+        {
+            Profiler::Scope zone("Work");
+        }
+    });
+    {
+        Profiler::Scope zone("Main");
+    }
+    worker.join();
+    Profiler::EndCapture();
+
+    EXPECT_EQ(Profiler::GetEventCount(), 101u);
+    EXPECT_EQ(Profiler::GetDroppedCount(), 0u);
+
+    std::ostringstream out;
+    Profiler::WriteChromeTrace(out);
+    EXPECT_NE(out.str().find("\"args\":{\"name\":\"Test Worker\"}"), std::string::npos);
+    EXPECT_EQ(CountOccurrences(out.str(), "\"name\":\"Work\""), 100u);
+}
+
+TEST(ProfilerTest, NewCaptureDiscardsThePreviousOne)
+{
+    Profiler::BeginCapture();
+    {
+        Profiler::Scope zone("First");
+    }
+    Profiler::EndCapture();
+
+    Profiler::BeginCapture();
+    Profiler::EndCapture();
+    EXPECT_EQ(Profiler::GetEventCount(), 0u);
+
+    std::ostringstream out;
+    Profiler::WriteChromeTrace(out);
+    EXPECT_EQ(out.str().find("First"), std::string::npos);
+}
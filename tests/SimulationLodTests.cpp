@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include "../src/SimulationLod.h"
+
+class SimulationLodTest : public ::testing::Test
+{
+protected:
+    SimulationLod lod;
+
+    void SetUp() override
+    {
+        lod.SetFullMargin(32.0f);
+        lod.SetReducedDistance(100.0f);
+        lod.BeginFrame({0.0f, 0.0f}, {320.0f, 240.0f});
+    }
+};
+
+TEST_F(SimulationLodTest, ClassifiesByDistanceToView)
+{
+    EXPECT_EQ(lod.Classify({160.0f, 120.0f}), SimLod::Full);
+    EXPECT_EQ(lod.Classify({-32.0f, 120.0f}), SimLod::Full);
+    EXPECT_EQ(lod.Classify({352.0f, 272.0f}), SimLod::Full);
+    EXPECT_EQ(lod.Classify({-40.0f, 120.0f}), SimLod::Reduced);
+    EXPECT_EQ(lod.Classify({160.0f, 240.0f + 132.0f}), SimLod::Reduced);
+    EXPECT_EQ(lod.Classify({160.0f, 240.0f + 133.0f}), SimLod::Dormant);
+    EXPECT_EQ(lod.Classify({-1000.0f, -1000.0f}), SimLod::Dormant);
+}
+
+TEST_F(SimulationLodTest, DisabledIsAlwaysFull)
+{
+    lod.SetEnabled(false);
+    EXPECT_EQ(lod.Classify({-1000.0f, -1000.0f}), SimLod::Full);
+}
+
+TEST_F(SimulationLodTest, FullIsAlwaysDue)
+{
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        EXPECT_TRUE(lod.IsDue(SimLod::Full, 5));
+        lod.BeginFrame({0.0f, 0.0f}, {320.0f, 240.0f});
+    }
+}
+
+TEST_F(SimulationLodTest, ReducedSlotsAreStaggeredOncePerInterval)
+{
+    lod.SetReducedInterval(4);
+    for (size_t slot = 0; slot < 8; ++slot)
+    {
+        int dueFrames = 0;
+        for (int frame = 0; frame < 4; ++frame)
+        {
+            dueFrames += lod.IsDue(SimLod::Reduced, slot) ? 1 : 0;
+            lod.BeginFrame({0.0f, 0.0f}, {320.0f, 240.0f});
+        }
+        EXPECT_EQ(dueFrames, 1) << "slot " << slot;
+    }
+
+    // Consecutive slots fall on different frames
+    int dueNow = 0;
+    for (size_t slot = 0; slot < 4; ++slot)
+        dueNow += lod.IsDue(SimLod::Reduced, slot) ? 1 : 0;
+    EXPECT_EQ(dueNow, 1);
+}
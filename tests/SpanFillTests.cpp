@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "../src/ChunkedGrid.h"
+#include "../src/SpanFill.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+/// Flood fill over '#' cells of an ASCII grid
+std::vector<CellSpan> Fill(const std::vector<std::string> &rows, int x, int y)
+{
+    const int width = static_cast<int>(rows[0].size());
+    const int height = static_cast<int>(rows.size());
+    return ScanlineFloodFill(width, height, x, y, [&](int cx, int cy) { return rows[cy][cx] == '#'; });
+}
+} // namespace
+
+TEST(SpanFillTest, NonMatchingStartFillsNothing)
+{
+    EXPECT_TRUE(Fill({"#.", ".#"}, 1, 0).empty());
+    EXPECT_TRUE(Fill({"#.", ".#"}, -1, 0).empty());
+    EXPECT_TRUE(Fill({"#.", ".#"}, 0, 2).empty());
+}
+
+TEST(SpanFillTest, RectangleIsOneSpanPerRow)
+{
+    const auto spans = Fill({"....", ".##.", ".##.", "...."}, 2, 2);
+    EXPECT_EQ(spans, (std::vector<CellSpan>{{1, 1, 3}, {2, 1, 3}}));
+    EXPECT_EQ(CountSpanCells(spans), 4u);
+}
+
+TEST(SpanFillTest, DiagonalCellsAreNotConnected)
+{
+    const auto spans = Fill({"#.", ".#"}, 0, 0);
+    EXPECT_EQ(spans, (std::vector<CellSpan>{{0, 0, 1}}));
+}
+
+TEST(SpanFillTest, FollowsConcaveShapes)
+{
+    // A U shape reached from its right arm has to come back up the left one
+    const std::vector<std::string> rows = {
+        "#...#",
+        "#...#",
+        "#####",
+        ".....",
+    };
+    const auto spans = Fill(rows, 4, 0);
+    EXPECT_EQ(spans, (std::vector<CellSpan>{{0, 0, 1}, {0, 4, 5}, {1, 0, 1}, {1, 4, 5}, {2, 0, 5}}));
+    EXPECT_EQ(CountSpanCells(spans), 9u);
+}
+
+TEST(SpanFillTest, MatchesPerCellFloodFill)
+{
+    const std::vector<std::string> rows = {
+        "##.####.",
+        "#..#..#.",
+        "####.##.",
+        "...#...#",
+        "######.#",
+    };
+    const int width = static_cast<int>(rows[0].size());
+    const int height = static_cast<int>(rows.size());
+
+    // Reference: plain stack-based fill over single cells
+    std::vector<bool> expected(static_cast<size_t>(width * height), false);
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    while (!stack.empty())
+    {
+        auto [x, y] = stack.back();
+        stack.pop_back();
+        if (x < 0 || x >= width || y < 0 || y >= height || expected[y * width + x] || rows[y][x] != '#')
+            continue;
+        expected[y * width + x] = true;
+        stack.insert(stack.end(), {{x - 1, y}, {x + 1, y}, {x, y - 1}, {x, y + 1}});
+    }
+
+    std::vector<bool> filled(expected.size(), false);
+    for (const CellSpan &span : Fill(rows, 0, 0))
+    {
+        for (int x = span.x0; x < span.x1; ++x)
+        {
+            EXPECT_FALSE(filled[span.y * width + x]) << "cell visited twice";
+            filled[span.y * width + x] = true;
+        }
+    }
+    EXPECT_EQ(filled, expected);
+}
+
+TEST(ChunkedGridSpanTest, FillSpanCrossesChunksAndFreesThem)
+{
+    ChunkedGrid<int> grid;
+    grid.Resize(100, 40);
+
+    grid.FillSpan(33, -4, 70, 7);
+    EXPECT_EQ(grid.Get(0, 33), 7);
+    EXPECT_EQ(grid.Get(69, 33), 7);
+    EXPECT_EQ(grid.Get(70, 33), 0);
+    EXPECT_EQ(grid.Get(0, 32), 0);
+    EXPECT_EQ(grid.GetAllocatedChunkCount(), 3u);
+
+    grid.FillSpan(33, 0, 40, 0);
+    EXPECT_EQ(grid.GetAllocatedChunkCount(), 2u);
+    grid.Set(69, 33, 0);
+    EXPECT_EQ(grid.GetAllocatedChunkCount(), 2u);
+    grid.FillSpan(33, 40, 100, 0);
+    EXPECT_EQ(grid.GetAllocatedChunkCount(), 0u);
+}
+
+TEST(ChunkedGridSpanTest, WriteSpanRoundTripsThroughReadSpan)
+{
+    ChunkedGrid<int, -1> grid;
+    grid.Resize(50, 10);
+
+    std::vector<int> values(60);
+    for (int i = 0; i < 60; ++i)
+        values[i] = (i % 3 == 0) ? -1 : i;
+    grid.WriteSpan(5, -5, 55, values.data());
+
+    std::vector<int> read(60, 123);
+    grid.ReadSpan(5, -5, 55, read.data());
+    for (int i = 0; i < 60; ++i)
+    {
+        const int x = i - 5;
+        EXPECT_EQ(read[i], (x < 0 || x >= 50) ? -1 : values[i]) << "x = " << x;
+        EXPECT_EQ(grid.Get(x, 5), (x < 0 || x >= 50) ? -1 : values[i]);
+    }
+
+    // Clearing through WriteSpan releases the chunks again
+    std::vector<int> empty(50, -1);
+    grid.WriteSpan(5, 0, 50, empty.data());
+    EXPECT_EQ(grid.GetAllocatedChunkCount(), 0u);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "../src/SpatialHash.h"
+
+#include <algorithm>
+#include <vector>
+
+class SpatialHashTest : public ::testing::Test
+{
+protected:
+    SpatialHash grid{16.0f};
+
+    std::vector<SpatialHash::Id> QueryBox(glm::vec2 min, glm::vec2 max) const
+    {
+        std::vector<SpatialHash::Id> ids;
+        grid.ForEachInBox(min, max, [&](SpatialHash::Id id, glm::vec2) { ids.push_back(id); });
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+};
+
+TEST_F(SpatialHashTest, EmptyGridFindsNothing)
+{
+    EXPECT_EQ(grid.Size(), 0u);
+    EXPECT_TRUE(QueryBox({-100.0f, -100.0f}, {100.0f, 100.0f}).empty());
+}
+
+TEST_F(SpatialHashTest, BoxQueryIsInclusiveAndExact)
+{
+    grid.Insert(0, {8.0f, 8.0f});
+    grid.Insert(1, {24.0f, 8.0f});
+    grid.Insert(2, {40.0f, 40.0f});
+
+    EXPECT_EQ(QueryBox({0.0f, 0.0f}, {24.0f, 8.0f}), (std::vector<SpatialHash::Id>{0, 1}));
+    EXPECT_EQ(QueryBox({9.0f, 0.0f}, {23.0f, 16.0f}), (std::vector<SpatialHash::Id>{}));
+    EXPECT_EQ(QueryBox({30.0f, 30.0f}, {50.0f, 50.0f}), (std::vector<SpatialHash::Id>{2}));
+}
+
+TEST_F(SpatialHashTest, NegativeCoordinates)
+{
+    grid.Insert(3, {-5.0f, -20.0f});
+    EXPECT_EQ(QueryBox({-8.0f, -24.0f}, {0.0f, 0.0f}), (std::vector<SpatialHash::Id>{3}));
+    EXPECT_TRUE(QueryBox({0.0f, 0.0f}, {16.0f, 16.0f}).empty());
+}
+
+TEST_F(SpatialHashTest, MoveAcrossCells)
+{
+    grid.Insert(0, {8.0f, 8.0f});
+    grid.Insert(1, {9.0f, 9.0f});
+
+    grid.Move(0, {100.0f, 100.0f});
+    EXPECT_EQ(grid.Size(), 2u);
+    EXPECT_EQ(QueryBox({0.0f, 0.0f}, {15.0f, 15.0f}), (std::vector<SpatialHash::Id>{1}));
+    EXPECT_EQ(QueryBox({96.0f, 96.0f}, {111.0f, 111.0f}), (std::vector<SpatialHash::Id>{0}));
+
+    // Moving inside a cell still updates the stored position
+    grid.Move(1, {2.0f, 3.0f});
+    EXPECT_EQ(grid.GetPosition(1), glm::vec2(2.0f, 3.0f));
+    EXPECT_TRUE(QueryBox({5.0f, 5.0f}, {15.0f, 15.0f}).empty());
+}
+
+TEST_F(SpatialHashTest, RemoveAndTruncate)
+{
+    for (SpatialHash::Id id = 0; id < 6; ++id)
+        grid.Insert(id, {4.0f, 4.0f});
+
+    grid.Remove(1);
+    grid.Remove(1);
+    EXPECT_EQ(grid.Size(), 5u);
+    EXPECT_FALSE(grid.Contains(1));
+    EXPECT_EQ(QueryBox({0.0f, 0.0f}, {8.0f, 8.0f}), (std::vector<SpatialHash::Id>{0, 2, 3, 4, 5}));
+
+    grid.Truncate(3);
+    EXPECT_EQ(grid.Size(), 2u);
+    EXPECT_EQ(QueryBox({0.0f, 0.0f}, {8.0f, 8.0f}), (std::vector<SpatialHash::Id>{0, 2}));
+}
+
+TEST_F(SpatialHashTest, RadiusAndAnyQueries)
+{
+    grid.Insert(0, {0.0f, 0.0f});
+    grid.Insert(1, {30.0f, 0.0f});
+    grid.Insert(2, {30.0f, 30.0f});
+
+    std::vector<SpatialHash::Id> ids;
+    grid.ForEachInRadius({0.0f, 0.0f}, 32.0f, [&](SpatialHash::Id id, glm::vec2) { ids.push_back(id); });
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<SpatialHash::Id>{0, 1}));
+
+    EXPECT_TRUE(grid.AnyInBox({20.0f, -5.0f}, {40.0f, 40.0f}, [](SpatialHash::Id id, glm::vec2) { return id == 2; }));
+    EXPECT_FALSE(grid.AnyInBox({20.0f, -5.0f}, {40.0f, 5.0f}, [](SpatialHash::Id id, glm::vec2) { return id == 2; }));
+}
+
+TEST_F(SpatialHashTest, SetCellSizeKeepsEntries)
+{
+    grid.Insert(0, {8.0f, 8.0f});
+    grid.Insert(1, {70.0f, 70.0f});
+    grid.SetCellSize(64.0f);
+    EXPECT_EQ(QueryBox({0.0f, 0.0f}, {100.0f, 100.0f}), (std::vector<SpatialHash::Id>{0, 1}));
+    EXPECT_EQ(QueryBox({64.0f, 64.0f}, {100.0f, 100.0f}), (std::vector<SpatialHash::Id>{1}));
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "../src/SpriteSheetRegistry.h"
+#include "../src/ImageCache.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr int SHEET_SIZE = 4;
+constexpr std::size_t SHEET_BYTES = SHEET_SIZE * SHEET_SIZE * 4;
+constexpr std::uint64_t IDLE_FRAMES = 3;
+
+/// Texels of @p sheet, standing in for the GPU copy a renderer would hold
+std::size_t TexelBytes(const Texture &sheet)
+{
+    return static_cast<std::size_t>(sheet.GetWidth()) * sheet.GetHeight() * sheet.GetChannels();
+}
+
+void AdvanceFrames(std::uint64_t frames)
+{
+    for (std::uint64_t i = 0; i < frames; ++i)
+    {
+        Texture::AdvanceUseFrame();
+    }
+}
+
+/// Sheets written as uncompressed TGA files, loaded without a renderer or loader
+class SpriteSheetRegistryTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() /
+                 ("wild_sprite_sheets_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(m_Root);
+        fs::create_directories(m_Root);
+        m_CacheDirectory = ImageCache::GetDirectory();
+        ImageCache::SetDirectory("");
+    }
+
+    void TearDown() override
+    {
+        SpriteSheetRegistry::SetBudget(0);
+        ImageCache::SetDirectory(m_CacheDirectory);
+        fs::remove_all(m_Root);
+    }
+
+    /// Write a SHEET_SIZE x SHEET_SIZE RGBA sheet and return its path
+    std::string WriteSheet(const std::string &name)
+    {
+        const std::string path = (m_Root / (name + ".tga")).generic_string();
+        unsigned char header[18] = {};
+        header[2] = 2;  // Uncompressed true-color
+        header[12] = SHEET_SIZE;
+        header[14] = SHEET_SIZE;
+        header[16] = 32;
+        header[17] = 8;  // Alpha bits
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        for (std::size_t i = 0; i < SHEET_BYTES; ++i)
+        {
+            file.put(static_cast<char>(0xFF));
+        }
+        return path;
+    }
+
+    /// Evict against a measured use of @p sheets full sheets
+    static void UpdateWith(std::size_t sheets)
+    {
+        SpriteSheetRegistry::Update(sheets * SHEET_BYTES, TexelBytes);
+    }
+
+    fs::path m_Root;
+    std::string m_CacheDirectory;
+};
+}  // namespace
+
+TEST_F(SpriteSheetRegistryTest, AcquireSharesOneSheetPerFile)
+{
+    const std::string path = WriteSheet("villager");
+    SpriteSheetRegistry::Handle first = SpriteSheetRegistry::Acquire(path);
+    SpriteSheetRegistry::Handle second = SpriteSheetRegistry::Acquire(path);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->GetWidth(), SHEET_SIZE);
+    EXPECT_EQ(first->GetLastUsedFrame(), Texture::GetUseFrame());
+    EXPECT_EQ(first->GetMemoryTag(), MemoryTracker::Subsystem::Characters);
+}
+
+TEST_F(SpriteSheetRegistryTest, NoBudgetNeverEvicts)
+{
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(WriteSheet("villager"));
+    ASSERT_NE(sheet, nullptr);
+
+    SpriteSheetRegistry::SetBudget(0, IDLE_FRAMES);
+    AdvanceFrames(IDLE_FRAMES);
+    UpdateWith(100);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 0u);
+    EXPECT_EQ(sheet->GetWidth(), SHEET_SIZE);
+}
+
+TEST_F(SpriteSheetRegistryTest, IdleSheetIsEvictedOverBudget)
+{
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(WriteSheet("villager"));
+    ASSERT_NE(sheet, nullptr);
+    SpriteSheetRegistry::SetBudget(1, IDLE_FRAMES);
+    EXPECT_EQ(SpriteSheetRegistry::GetBudget(), 1u);
+
+    // One frame short of idle: kept
+    AdvanceFrames(IDLE_FRAMES - 1);
+    UpdateWith(1);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 0u);
+
+    // Idle long enough: shrunk to the placeholder, handle still valid
+    Texture::AdvanceUseFrame();
+    UpdateWith(1);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 1u);
+    EXPECT_EQ(sheet->GetWidth(), 1);
+    EXPECT_EQ(sheet->GetHeight(), 1);
+    EXPECT_EQ(SpriteSheetRegistry::GetLoadedCount(), 1u);
+}
+
+TEST_F(SpriteSheetRegistryTest, DrawnSheetIsKept)
+{
+    SpriteSheetRegistry::Handle idle = SpriteSheetRegistry::Acquire(WriteSheet("idle"));
+    SpriteSheetRegistry::Handle drawn = SpriteSheetRegistry::Acquire(WriteSheet("drawn"));
+    ASSERT_NE(idle, nullptr);
+    ASSERT_NE(drawn, nullptr);
+    SpriteSheetRegistry::SetBudget(1, IDLE_FRAMES);
+
+    for (std::uint64_t i = 0; i < IDLE_FRAMES; ++i)
+    {
+        drawn->MarkUsed();
+        Texture::AdvanceUseFrame();
+    }
+    UpdateWith(2);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 1u);
+    EXPECT_EQ(idle->GetWidth(), 1);
+    EXPECT_EQ(drawn->GetWidth(), SHEET_SIZE);
+}
+
+TEST_F(SpriteSheetRegistryTest, UnderBudgetKeepsIdleSheets)
+{
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(WriteSheet("villager"));
+    ASSERT_NE(sheet, nullptr);
+
+    SpriteSheetRegistry::SetBudget(SHEET_BYTES, IDLE_FRAMES);
+    AdvanceFrames(IDLE_FRAMES);
+    UpdateWith(1);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 0u);
+    EXPECT_EQ(sheet->GetWidth(), SHEET_SIZE);
+}
+
+TEST_F(SpriteSheetRegistryTest, EvictionStopsOnceUnderBudget)
+{
+    SpriteSheetRegistry::Handle oldest = SpriteSheetRegistry::Acquire(WriteSheet("oldest"));
+    Texture::AdvanceUseFrame();
+    SpriteSheetRegistry::Handle newer = SpriteSheetRegistry::Acquire(WriteSheet("newer"));
+    ASSERT_NE(oldest, nullptr);
+    ASSERT_NE(newer, nullptr);
+
+    // Both idle, one sheet over budget: only the longest idle goes
+    SpriteSheetRegistry::SetBudget(SHEET_BYTES, IDLE_FRAMES);
+    AdvanceFrames(IDLE_FRAMES);
+    UpdateWith(2);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 1u);
+    EXPECT_EQ(oldest->GetWidth(), 1);
+    EXPECT_EQ(newer->GetWidth(), SHEET_SIZE);
+}
+
+TEST_F(SpriteSheetRegistryTest, EvictedSheetReloadsWhenDrawn)
+{
+    SpriteSheetRegistry::Handle sheet = SpriteSheetRegistry::Acquire(WriteSheet("villager"));
+    ASSERT_NE(sheet, nullptr);
+    SpriteSheetRegistry::SetBudget(1, IDLE_FRAMES);
+    AdvanceFrames(IDLE_FRAMES);
+    UpdateWith(1);
+    ASSERT_EQ(SpriteSheetRegistry::GetEvictedCount(), 1u);
+
+    // Not drawn again: stays evicted
+    Texture::AdvanceUseFrame();
+    UpdateWith(0);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 1u);
+
+    // Drawn on a later frame: the next Update() brings the pixels back
+    sheet->MarkUsed();
+    UpdateWith(0);
+    EXPECT_EQ(SpriteSheetRegistry::GetEvictedCount(), 0u);
+    EXPECT_EQ(sheet->GetWidth(), SHEET_SIZE);
+    EXPECT_EQ(sheet->GetHeight(), SHEET_SIZE);
+}
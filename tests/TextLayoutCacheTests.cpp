@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "../src/TextLayoutCache.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Every character is 1 pixel wide
+float MeasureChars(std::string_view s)
+{
+    return static_cast<float>(s.size());
+}
+}
+
+TEST(TextLayoutCacheTest, WrapsOnSpacesAndNewlines)
+{
+    TextLayoutCache::TextLayout layout;
+    TextLayoutCache::WrapInto("the quick brown fox\njumps  over", 10.0f, MeasureChars, layout);
+
+    EXPECT_EQ(layout.lines, (std::vector<std::string>{"the quick", "brown fox", "jumps over"}));
+    EXPECT_EQ(layout.lineWidths, (std::vector<float>{9.0f, 9.0f, 10.0f}));
+    EXPECT_FLOAT_EQ(layout.width, 10.0f);
+}
+
+TEST(TextLayoutCacheTest, LongWordsGetTheirOwnLine)
+{
+    TextLayoutCache::TextLayout layout;
+    TextLayoutCache::WrapInto("a extraordinarily b", 5.0f, MeasureChars, layout);
+
+    EXPECT_EQ(layout.lines, (std::vector<std::string>{"a", "extraordinarily", "b"}));
+    EXPECT_FLOAT_EQ(layout.width, 15.0f);
+}
+
+TEST(TextLayoutCacheTest, RepeatedWrapsMeasureOnce)
+{
+    TextLayoutCache cache;
+    int measured = 0;
+    auto measure = [&](std::string_view s)
+    {
+        ++measured;
+        return MeasureChars(s);
+    };
+
+    const TextLayoutCache::TextLayout &first = cache.Wrap("hello there world", 1.0f, 11.0f, measure);
+    const int afterFirst = measured;
+    EXPECT_GT(afterFirst, 0);
+
+    const TextLayoutCache::TextLayout &second = cache.Wrap("hello there world", 1.0f, 11.0f, measure);
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(measured, afterFirst);
+    EXPECT_EQ(cache.GetHits(), 1u);
+
+    // Scale and width are part of the key
+    cache.Wrap("hello there world", 2.0f, 11.0f, measure);
+    cache.Wrap("hello there world", 1.0f, 20.0f, measure);
+    EXPECT_EQ(cache.Size(), 3u);
+    EXPECT_EQ(cache.GetMisses(), 3u);
+}
+
+TEST(TextLayoutCacheTest, EvictsTheLeastRecentlyUsedLayout)
+{
+    TextLayoutCache cache;
+    for (std::size_t i = 0; i < TextLayoutCache::MAX_ENTRIES; ++i)
+        cache.Wrap("line " + std::to_string(i), 1.0f, 100.0f, MeasureChars);
+
+    // Touch the oldest so the second oldest goes instead
+    cache.Wrap("line 0", 1.0f, 100.0f, MeasureChars);
+    cache.Wrap("one more", 1.0f, 100.0f, MeasureChars);
+    EXPECT_EQ(cache.Size(), TextLayoutCache::MAX_ENTRIES);
+
+    const std::uint64_t misses = cache.GetMisses();
+    cache.Wrap("line 0", 1.0f, 100.0f, MeasureChars);
+    EXPECT_EQ(cache.GetMisses(), misses);
+    cache.Wrap("line 1", 1.0f, 100.0f, MeasureChars);
+    EXPECT_EQ(cache.GetMisses(), misses + 1);
+}
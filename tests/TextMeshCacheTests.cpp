@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "../src/GlyphTable.h"
+#include "../src/TextMeshCache.h"
+
+#include <string>
+
+TEST(TextMeshCacheTest, FindsWhatWasInserted)
+{
+    TextMeshCache cache;
+    EXPECT_EQ(cache.Find("Continue", 0.2f, 1.0f), nullptr);
+
+    TextMeshCache::TextMesh &mesh = cache.Insert("Continue", 0.2f, 1.0f);
+    mesh.vertices.push_back({1.0f, 2.0f, 0.0f, 0.0f});
+    mesh.outlineVertexCount = 0;
+
+    const TextMeshCache::TextMesh *found = cache.Find("Continue", 0.2f, 1.0f);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->vertices.size(), 1u);
+    EXPECT_EQ(cache.Find("Continue", 0.2f, 0.5f), nullptr);
+    EXPECT_EQ(cache.Find("Continue", 0.25f, 1.0f), nullptr);
+    EXPECT_EQ(cache.GetHits(), 1u);
+    EXPECT_EQ(cache.GetMisses(), 3u);
+}
+
+TEST(TextMeshCacheTest, DropsStringsNotDrawnForAWhile)
+{
+    TextMeshCache cache;
+    cache.Insert("label", 1.0f, 1.0f);
+    cache.Insert("timer 00:01", 1.0f, 1.0f);
+
+    for (std::uint64_t frame = 0; frame < TextMeshCache::MAX_IDLE_FRAMES; ++frame)
+    {
+        cache.NextFrame();
+        EXPECT_NE(cache.Find("label", 1.0f, 1.0f), nullptr);
+    }
+    EXPECT_EQ(cache.Size(), 2u);
+    cache.NextFrame();
+    EXPECT_EQ(cache.Size(), 1u);
+    EXPECT_EQ(cache.Find("timer 00:01", 1.0f, 1.0f), nullptr);
+}
+
+TEST(TextMeshCacheTest, StaysBoundedUnderChangingText)
+{
+    TextMeshCache cache;
+    for (std::size_t i = 0; i < TextMeshCache::MAX_ENTRIES * 3; ++i)
+        cache.Insert("frame " + std::to_string(i), 1.0f, 1.0f);
+    EXPECT_EQ(cache.Size(), TextMeshCache::MAX_ENTRIES);
+}
+
+TEST(GlyphTableTest, LooksUpAsciiOnly)
+{
+    GlyphTable<int> table;
+    EXPECT_TRUE(table.Empty());
+    table.Insert('A', 65);
+    table.Insert(static_cast<char>(200), 1);
+
+    ASSERT_NE(table.Find('A'), nullptr);
+    EXPECT_EQ(*table.Find('A'), 65);
+    EXPECT_EQ(table.Find('B'), nullptr);
+    EXPECT_EQ(table.Find(static_cast<char>(200)), nullptr);
+    EXPECT_EQ(table.Size(), 1u);
+
+    table.Clear();
+    EXPECT_EQ(table.Find('A'), nullptr);
+}
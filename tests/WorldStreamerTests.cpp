@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "../src/WorldStreamer.h"
+#include "../src/Tilemap.h"
+#include "../src/NonPlayerCharacter.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace fs = std::filesystem;
+
+constexpr int REGION_SIZE = 32;
+constexpr int GROUND = 0;
+
+/// Tile (x, y) as a world position at its center
+glm::vec2 TileCenter(const Tilemap &tilemap, int x, int y)
+{
+    return glm::vec2((x + 0.5f) * tilemap.GetTileWidth(), (y + 0.5f) * tilemap.GetTileHeight());
+}
+
+/// Two-region world on disk, opened into a fresh tilemap per test
+class WorldStreamerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_Root = fs::temp_directory_path() /
+                 ("wild_world_streamer_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(m_Root);
+
+        // Regions (0, 0) and (1, 0), one painted tile each so both get a file
+        Tilemap source;
+        source.SetTilemapSize(2 * REGION_SIZE, REGION_SIZE, false);
+        source.SetLayerTile(4, 4, GROUND, 1);
+        source.SetLayerTile(REGION_SIZE + 4, 4, GROUND, 2);
+        ASSERT_TRUE(source.SaveWorldRegions(m_Root.generic_string(), REGION_SIZE));
+    }
+
+    void TearDown() override
+    {
+        m_Streamer.Close();
+        fs::remove_all(m_Root);
+    }
+
+    /// Open the world and make both regions resident
+    void OpenBoth(Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs)
+    {
+        ASSERT_TRUE(m_Streamer.Open(m_Root.generic_string(), tilemap));
+        m_Streamer.SetLoadRadius(2 * REGION_SIZE);
+        m_Streamer.LoadAround(TileCenter(tilemap, 4, 4), tilemap, npcs);
+        ASSERT_EQ(m_Streamer.GetResidentCount(), 2);
+    }
+
+    /// Shrink the radii so only region (0, 0) stays within the evict radius of tile (4, 4)
+    void EvictFarRegion(Tilemap &tilemap, std::vector<NonPlayerCharacter> &npcs)
+    {
+        m_Streamer.SetLoadRadius(4);
+        m_Streamer.SetEvictRadius(8);
+        m_Streamer.Update(TileCenter(tilemap, 4, 4), tilemap, npcs, nullptr, true);
+    }
+
+    fs::path m_Root;
+    WorldStreamer m_Streamer;
+};
+}  // namespace
+
+TEST_F(WorldStreamerTest, LoadedRegionsAreClean)
+{
+    Tilemap tilemap;
+    std::vector<NonPlayerCharacter> npcs;
+    OpenBoth(tilemap, npcs);
+
+    EXPECT_FALSE(m_Streamer.IsRegionDirty(tilemap, npcs, 0, 0));
+    EXPECT_FALSE(m_Streamer.IsRegionDirty(tilemap, npcs, 1, 0));
+}
+
+TEST_F(WorldStreamerTest, EditMarksOnlyItsRegionDirty)
+{
+    Tilemap tilemap;
+    std::vector<NonPlayerCharacter> npcs;
+    OpenBoth(tilemap, npcs);
+
+    tilemap.SetTileCollision(REGION_SIZE + 10, 10, true);
+    EXPECT_FALSE(m_Streamer.IsRegionDirty(tilemap, npcs, 0, 0));
+    EXPECT_TRUE(m_Streamer.IsRegionDirty(tilemap, npcs, 1, 0));
+}
+
+TEST_F(WorldStreamerTest, EvictedEditedRegionIsWrittenBack)
+{
+    {
+        Tilemap tilemap;
+        std::vector<NonPlayerCharacter> npcs;
+        OpenBoth(tilemap, npcs);
+
+        // Edit both regions; only (1, 0) is evicted, (0, 0) stays resident and unsaved
+        tilemap.SetLayerTile(8, 8, GROUND, 3);
+        tilemap.SetLayerTile(REGION_SIZE + 8, 8, GROUND, 4);
+        tilemap.SetElevation(REGION_SIZE + 9, 9, 5);
+        EvictFarRegion(tilemap, npcs);
+
+        EXPECT_EQ(m_Streamer.GetResidentCount(), 1);
+        EXPECT_EQ(tilemap.GetLayerTile(REGION_SIZE + 8, 8, GROUND), -1);
+        EXPECT_EQ(tilemap.GetLayerTile(8, 8, GROUND), 3);
+        EXPECT_TRUE(m_Streamer.IsRegionDirty(tilemap, npcs, 0, 0));
+        m_Streamer.Close();
+    }
+
+    // Reopen without saving: the evicted region's edits are on disk, the resident one's are not
+    Tilemap tilemap;
+    std::vector<NonPlayerCharacter> npcs;
+    OpenBoth(tilemap, npcs);
+    EXPECT_EQ(tilemap.GetLayerTile(REGION_SIZE + 4, 4, GROUND), 2);
+    EXPECT_EQ(tilemap.GetLayerTile(REGION_SIZE + 8, 8, GROUND), 4);
+    EXPECT_EQ(tilemap.GetElevation(REGION_SIZE + 9, 9), 5);
+    EXPECT_EQ(tilemap.GetLayerTile(4, 4, GROUND), 1);
+    EXPECT_EQ(tilemap.GetLayerTile(8, 8, GROUND), -1);
+}
+
+TEST_F(WorldStreamerTest, ReloadedRegionIsCleanAfterWriteBack)
+{
+    Tilemap tilemap;
+    std::vector<NonPlayerCharacter> npcs;
+    OpenBoth(tilemap, npcs);
+
+    tilemap.SetLayerTile(REGION_SIZE + 8, 8, GROUND, 4);
+    EvictFarRegion(tilemap, npcs);
+    ASSERT_EQ(m_Streamer.GetResidentCount(), 1);
+
+    // Walking back loads the written file, which matches the tilemap again
+    m_Streamer.SetLoadRadius(2 * REGION_SIZE);
+    m_Streamer.LoadAround(TileCenter(tilemap, 4, 4), tilemap, npcs);
+    EXPECT_EQ(m_Streamer.GetResidentCount(), 2);
+    EXPECT_EQ(tilemap.GetLayerTile(REGION_SIZE + 8, 8, GROUND), 4);
+    EXPECT_FALSE(m_Streamer.IsRegionDirty(tilemap, npcs, 1, 0));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../src/YSortQueue.h"
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+std::vector<std::uint32_t> SortedIndices(YSortQueue &queue)
+{
+    queue.Sort();
+    std::vector<std::uint32_t> order;
+    for (std::size_t i = 0; i < queue.Size(); ++i)
+        order.push_back(queue.IndexAt(i));
+    return order;
+}
+}
+
+TEST(YSortQueueTest, OrderedBitsPreservesFloatOrder)
+{
+    const float values[] = {-1e6f, -17.5f, -1.0f, -0.25f, 0.0f, 0.25f, 1.0f, 17.5f, 1e6f};
+    for (std::size_t i = 1; i < std::size(values); ++i)
+        EXPECT_LT(YSortQueue::OrderedBits(values[i - 1]), YSortQueue::OrderedBits(values[i]));
+    EXPECT_EQ(YSortQueue::OrderedBits(-0.0f), YSortQueue::OrderedBits(0.0f));
+}
+
+TEST(YSortQueueTest, SortsByYThenRankThenInsertion)
+{
+    YSortQueue queue;
+    queue.Add(32.0f, 0);   // 0
+    queue.Add(16.0f, 2);   // 1
+    queue.Add(16.0f, 1);   // 2
+    queue.Add(-8.0f, 5);   // 3
+    queue.Add(16.0f, 1);   // 4
+    queue.Add(16.5f, 0);   // 5
+
+    EXPECT_EQ(SortedIndices(queue), (std::vector<std::uint32_t>{3, 2, 4, 1, 5, 0}));
+}
+
+TEST(YSortQueueTest, MatchesStableSortOnRandomInput)
+{
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> y(-500.0f, 3000.0f);
+    std::uniform_int_distribution<int> rank(0, 5);
+
+    YSortQueue queue;
+    std::vector<std::tuple<float, int, std::uint32_t>> expected;
+    for (std::uint32_t i = 0; i < 2000; ++i)
+    {
+        // Snap some positions to a tile grid so equal Y values are common
+        const float sortY = (i % 3 == 0) ? static_cast<float>(static_cast<int>(y(rng)) / 16 * 16) : y(rng);
+        const int r = rank(rng);
+        queue.Add(sortY, static_cast<std::uint8_t>(r));
+        expected.emplace_back(sortY, r, i);
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto &a, const auto &b)
+    {
+        return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+    });
+
+    const std::vector<std::uint32_t> order = SortedIndices(queue);
+    ASSERT_EQ(order.size(), expected.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        EXPECT_EQ(order[i], std::get<2>(expected[i])) << "at " << i;
+}
+
+TEST(YSortQueueTest, ClearKeepsWorkingAcrossFrames)
+{
+    YSortQueue queue;
+    queue.Add(5.0f, 0);
+    queue.Add(1.0f, 0);
+    EXPECT_EQ(SortedIndices(queue), (std::vector<std::uint32_t>{1, 0}));
+
+    queue.Clear();
+    EXPECT_EQ(queue.Size(), 0u);
+    queue.Add(2.0f, 0);
+    queue.Add(2.0f, 0);
+    queue.Add(1.0f, 3);
+    EXPECT_EQ(SortedIndices(queue), (std::vector<std::uint32_t>{2, 0, 1}));
+}